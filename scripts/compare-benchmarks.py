@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""Compare two mlpack_bench JSON outputs and flag regressions.
+
+Usage:
+  mlpack_bench --output baseline.json        # on the old revision
+  mlpack_bench --output candidate.json       # on the new revision
+  ./scripts/compare-benchmarks.py baseline.json candidate.json
+
+Exits nonzero if any benchmark's median regressed by more than the
+threshold (and more than its run-to-run noise), so this can gate upgrades
+in CI.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return {b["name"]: b for b in data["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="JSON output of the old run")
+    parser.add_argument("candidate", help="JSON output of the new run")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="regression threshold in percent (default 5)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    candidate = load(args.candidate)
+
+    names = sorted(set(baseline) | set(candidate))
+    width = max(len(n) for n in names) if names else 4
+    print("%-*s %14s %14s %9s" % (width, "name", "baseline(ns)",
+                                  "candidate(ns)", "delta"))
+
+    regressions = []
+    for name in names:
+        if name not in baseline or name not in candidate:
+            which = "baseline" if name not in baseline else "candidate"
+            print("%-*s  (missing in %s)" % (width, name, which))
+            continue
+
+        old = baseline[name]
+        new = candidate[name]
+        delta = 100.0 * (new["median_ns"] - old["median_ns"]) / old["median_ns"]
+
+        # Only call it a regression if the change also exceeds the combined
+        # noise of the two runs, so a noisy benchmark doesn't fail the gate.
+        noise = 100.0 * (old["stddev_ns"] + new["stddev_ns"]) / old["median_ns"]
+        flag = ""
+        if delta > args.threshold and delta > noise:
+            flag = "  <-- REGRESSION"
+            regressions.append(name)
+        elif delta < -args.threshold:
+            flag = "  (improved)"
+
+        print("%-*s %14.1f %14.1f %+8.1f%%%s"
+              % (width, name, old["median_ns"], new["median_ns"], delta, flag))
+
+    if regressions:
+        print("\n%d benchmark(s) regressed more than %.1f%%: %s"
+              % (len(regressions), args.threshold, ", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
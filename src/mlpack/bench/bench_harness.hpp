@@ -0,0 +1,228 @@
+/**
+ * @file bench/bench_harness.hpp
+ *
+ * A small microbenchmark harness for mlpack's hot kernels.  Each benchmark
+ * registers itself with MLPACK_BENCHMARK() and times a closure through
+ * Runner::Run(); the harness calibrates how many iterations make one sample
+ * long enough to be measurable, collects several samples after a warmup, and
+ * reports min/median/mean/stddev per iteration so run-to-run noise is
+ * visible in the output rather than hidden by a single number.
+ *
+ * Results are emitted as JSON (see main.cpp) so runs can be diffed with
+ * scripts/compare-benchmarks.py.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCH_BENCH_HARNESS_HPP
+#define MLPACK_BENCH_BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace bench {
+
+/**
+ * The measurements of one benchmark: per-iteration times (in nanoseconds)
+ * for each sample, plus summary statistics.
+ */
+struct BenchmarkResult
+{
+  //! The name of the benchmark.
+  std::string name;
+  //! How many iterations made up one sample.
+  uint64_t iterations;
+  //! Per-iteration time of each sample, in nanoseconds.
+  std::vector<double> samples;
+
+  //! Get the fastest sample (least affected by interference).
+  double Min() const
+  {
+    double min = samples.empty() ? 0.0 : samples[0];
+    for (size_t i = 1; i < samples.size(); ++i)
+      min = std::min(min, samples[i]);
+    return min;
+  }
+
+  //! Get the median sample.
+  double Median() const
+  {
+    if (samples.empty())
+      return 0.0;
+    std::vector<double> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    const size_t mid = sorted.size() / 2;
+    return (sorted.size() % 2 == 1) ? sorted[mid] :
+        0.5 * (sorted[mid - 1] + sorted[mid]);
+  }
+
+  //! Get the mean of the samples.
+  double Mean() const
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i)
+      sum += samples[i];
+    return samples.empty() ? 0.0 : sum / samples.size();
+  }
+
+  //! Get the sample standard deviation.
+  double StdDev() const
+  {
+    if (samples.size() < 2)
+      return 0.0;
+    const double mean = Mean();
+    double sum = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i)
+      sum += (samples[i] - mean) * (samples[i] - mean);
+    return std::sqrt(sum / (samples.size() - 1));
+  }
+};
+
+/**
+ * Passed to every benchmark function; the benchmark performs its setup, then
+ * hands the code under measurement to Run().
+ */
+class Runner
+{
+ public:
+  /**
+   * Create a runner.
+   *
+   * @param samples Number of timed samples to collect.
+   * @param minSampleSeconds Calibrate iterations so one sample takes at
+   *     least this long.
+   */
+  Runner(const size_t samples, const double minSampleSeconds) :
+      samples(samples),
+      minSampleSeconds(minSampleSeconds),
+      iterations(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Time the given closure: calibrate the iteration count, run one untimed
+   * warmup sample, then collect the configured number of timed samples.
+   * Call this exactly once per benchmark.
+   *
+   * @param work The code under measurement.
+   */
+  void Run(const std::function<void()>& work)
+  {
+    // Calibrate: double the iteration count until one sample is long enough
+    // for the clock resolution not to matter.
+    iterations = 1;
+    while (true)
+    {
+      const double elapsed = TimeSample(work, iterations);
+      if (elapsed >= minSampleSeconds || iterations >= (uint64_t(1) << 30))
+        break;
+      iterations *= 2;
+    }
+
+    // Warmup sample (caches, branch predictors, lazy allocations).
+    TimeSample(work, iterations);
+
+    sampleTimes.clear();
+    for (size_t s = 0; s < samples; ++s)
+    {
+      const double elapsed = TimeSample(work, iterations);
+      sampleTimes.push_back(1e9 * elapsed / (double) iterations);
+    }
+  }
+
+  //! Get the calibrated iteration count.
+  uint64_t Iterations() const { return iterations; }
+
+  //! Get the per-iteration time of each sample, in nanoseconds.
+  const std::vector<double>& SampleTimes() const { return sampleTimes; }
+
+  /**
+   * Keep the optimizer from discarding a computed value.  Use this on the
+   * result of the measured kernel so the loop isn't optimized away.
+   */
+  template<typename T>
+  static void DoNotOptimize(const T& value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g" (value) : "memory");
+#else
+    volatile T sink = value;
+    (void) sink;
+#endif
+  }
+
+ private:
+  //! Run the closure the given number of times and return elapsed seconds.
+  double TimeSample(const std::function<void()>& work,
+                    const uint64_t iterations)
+  {
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i)
+      work();
+    return std::chrono::duration_cast<std::chrono::duration<double>>(
+        std::chrono::steady_clock::now() - start).count();
+  }
+
+  //! Number of timed samples to collect.
+  size_t samples;
+  //! Minimum duration of one sample, in seconds.
+  double minSampleSeconds;
+  //! Calibrated iteration count.
+  uint64_t iterations;
+  //! Per-iteration time of each sample, in nanoseconds.
+  std::vector<double> sampleTimes;
+};
+
+/**
+ * The registry of all benchmarks; use the MLPACK_BENCHMARK macro rather than
+ * calling Register() directly.
+ */
+class Registry
+{
+ public:
+  typedef void (*FunctionType)(Runner&);
+
+  //! Get the list of registered benchmarks (name, function).
+  static std::vector<std::pair<std::string, FunctionType>>& Benchmarks()
+  {
+    static std::vector<std::pair<std::string, FunctionType>> benchmarks;
+    return benchmarks;
+  }
+
+  //! Register a benchmark (returns a dummy so it can run at static init).
+  static bool Register(const std::string& name, FunctionType function)
+  {
+    Benchmarks().push_back(std::make_pair(name, function));
+    return true;
+  }
+};
+
+} // namespace bench
+} // namespace mlpack
+
+/**
+ * Define and register a benchmark:
+ *
+ * @code
+ * MLPACK_BENCHMARK(LMetricEvaluate)
+ * {
+ *   // Setup (untimed)...
+ *   runner.Run([&]() { ... });  // Code under measurement.
+ * }
+ * @endcode
+ */
+#define MLPACK_BENCHMARK(Name) \
+    static void BenchImpl##Name(mlpack::bench::Runner& runner); \
+    static const bool benchRegistered##Name = \
+        mlpack::bench::Registry::Register(#Name, BenchImpl##Name); \
+    static void BenchImpl##Name(mlpack::bench::Runner& runner)
+
+#endif // MLPACK_BENCH_BENCH_HARNESS_HPP
@@ -0,0 +1,79 @@
+/**
+ * @file bench/core_bench.cpp
+ *
+ * Microbenchmarks for core hot kernels: LMetric::Evaluate() and
+ * HRectBound::MinDistance().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_harness.hpp"
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace mlpack::metric;
+
+MLPACK_BENCHMARK(LMetricEvaluateEuclidean)
+{
+  const arma::mat a(100, 1000, arma::fill::randu);
+  const arma::mat b(100, 1000, arma::fill::randu);
+
+  runner.Run([&]()
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.n_cols; ++i)
+      sum += EuclideanDistance::Evaluate(a.col(i), b.col(i));
+    Runner::DoNotOptimize(sum);
+  });
+}
+
+MLPACK_BENCHMARK(LMetricEvaluateManhattan)
+{
+  const arma::mat a(100, 1000, arma::fill::randu);
+  const arma::mat b(100, 1000, arma::fill::randu);
+
+  runner.Run([&]()
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.n_cols; ++i)
+      sum += ManhattanDistance::Evaluate(a.col(i), b.col(i));
+    Runner::DoNotOptimize(sum);
+  });
+}
+
+MLPACK_BENCHMARK(HRectBoundMinDistancePoint)
+{
+  const arma::mat points(20, 1000, arma::fill::randu);
+
+  bound::HRectBound<EuclideanDistance> bound(20);
+  bound |= arma::mat(20, 50, arma::fill::randu) * 0.25;
+
+  runner.Run([&]()
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < points.n_cols; ++i)
+      sum += bound.MinDistance(points.col(i));
+    Runner::DoNotOptimize(sum);
+  });
+}
+
+MLPACK_BENCHMARK(HRectBoundMinDistanceBound)
+{
+  bound::HRectBound<EuclideanDistance> boundA(20);
+  bound::HRectBound<EuclideanDistance> boundB(20);
+  boundA |= arma::mat(20, 50, arma::fill::randu) * 0.25;
+  boundB |= arma::mat(20, 50, arma::fill::randu) * 0.25 + 0.5;
+
+  runner.Run([&]()
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < 1000; ++i)
+      sum += boundA.MinDistance(boundB);
+    Runner::DoNotOptimize(sum);
+  });
+}
@@ -0,0 +1,124 @@
+/**
+ * @file bench/main.cpp
+ *
+ * Driver for the mlpack microbenchmark suite.  Runs every registered
+ * benchmark (optionally filtered by a name substring) and emits the results
+ * as JSON, which scripts/compare-benchmarks.py can diff between two runs.
+ *
+ * Usage:
+ *   mlpack_bench [--filter SUBSTRING] [--samples N] [--output FILE]
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_harness.hpp"
+
+#include <mlpack/core.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+//! Render one result as a JSON object.
+static void PrintResult(std::ostream& stream, const BenchmarkResult& result)
+{
+  stream << "    {\n";
+  stream << "      \"name\": \"" << result.name << "\",\n";
+  stream << "      \"iterations\": " << result.iterations << ",\n";
+  stream << "      \"min_ns\": " << result.Min() << ",\n";
+  stream << "      \"median_ns\": " << result.Median() << ",\n";
+  stream << "      \"mean_ns\": " << result.Mean() << ",\n";
+  stream << "      \"stddev_ns\": " << result.StdDev() << ",\n";
+  stream << "      \"samples_ns\": [";
+  for (size_t i = 0; i < result.samples.size(); ++i)
+    stream << (i == 0 ? "" : ", ") << result.samples[i];
+  stream << "]\n";
+  stream << "    }";
+}
+
+int main(int argc, char** argv)
+{
+  std::string filter = "";
+  std::string outputFile = "";
+  size_t samples = 10;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    if (arg == "--filter" && i + 1 < argc)
+      filter = argv[++i];
+    else if (arg == "--samples" && i + 1 < argc)
+      samples = (size_t) atoi(argv[++i]);
+    else if (arg == "--output" && i + 1 < argc)
+      outputFile = argv[++i];
+    else
+    {
+      std::cerr << "Usage: " << argv[0]
+          << " [--filter SUBSTRING] [--samples N] [--output FILE]"
+          << std::endl;
+      return 1;
+    }
+  }
+
+  const std::vector<std::pair<std::string, Registry::FunctionType>>&
+      benchmarks = Registry::Benchmarks();
+
+  std::ostringstream json;
+  json << "{\n  \"benchmarks\": [\n";
+
+  bool first = true;
+  for (size_t i = 0; i < benchmarks.size(); ++i)
+  {
+    if (!filter.empty() &&
+        benchmarks[i].first.find(filter) == std::string::npos)
+      continue;
+
+    // Fix the seed so every benchmark sees the same data in every run.
+    math::RandomSeed(42);
+
+    std::cerr << "Running " << benchmarks[i].first << "..." << std::endl;
+
+    Runner runner(samples, 0.05 /* seconds per sample */);
+    benchmarks[i].second(runner);
+
+    BenchmarkResult result;
+    result.name = benchmarks[i].first;
+    result.iterations = runner.Iterations();
+    result.samples = runner.SampleTimes();
+
+    std::cerr << "  median " << result.Median() << "ns, stddev "
+        << result.StdDev() << "ns (" << result.iterations
+        << " iterations/sample)" << std::endl;
+
+    if (!first)
+      json << ",\n";
+    first = false;
+    PrintResult(json, result);
+  }
+
+  json << "\n  ]\n}\n";
+
+  if (outputFile.empty())
+  {
+    std::cout << json.str();
+  }
+  else
+  {
+    std::ofstream out(outputFile.c_str());
+    if (!out.is_open())
+    {
+      std::cerr << "Cannot open output file '" << outputFile << "'!"
+          << std::endl;
+      return 1;
+    }
+    out << json.str();
+  }
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file bench/methods_bench.cpp
+ *
+ * Microbenchmarks for method-level hot kernels: NaiveKMeans::Iterate(),
+ * DecisionTree split search, and FFN::Predict().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_harness.hpp"
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans/naive_kmeans.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/init_rules/gaussian_init.hpp>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+MLPACK_BENCHMARK(NaiveKMeansIterate)
+{
+  const arma::mat data(10, 10000, arma::fill::randu);
+  metric::EuclideanDistance metric;
+  kmeans::NaiveKMeans<metric::EuclideanDistance, arma::mat>
+      naive(data, metric);
+
+  const arma::mat centroids(10, 25, arma::fill::randu);
+  arma::mat newCentroids(10, 25);
+  arma::Col<size_t> counts(25);
+
+  runner.Run([&]()
+  {
+    Runner::DoNotOptimize(naive.Iterate(centroids, newCentroids, counts));
+  });
+}
+
+MLPACK_BENCHMARK(DecisionTreeSplitSearch)
+{
+  // A small tree over random data: nearly all of the training time is the
+  // best-split search, which is what this benchmark tracks.
+  const arma::mat data(10, 2000, arma::fill::randu);
+  arma::Row<size_t> labels(2000);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = math::RandInt(0, 5);
+
+  runner.Run([&]()
+  {
+    tree::DecisionTree<> tree(data, labels, 5, 10 /* minimumLeafSize */);
+    Runner::DoNotOptimize(tree.NumChildren());
+  });
+}
+
+MLPACK_BENCHMARK(FFNPredict)
+{
+  // A two-hidden-layer network; the weights are only initialized, not
+  // trained, since Predict() cost doesn't depend on the weight values.
+  ann::FFN<ann::NegativeLogLikelihood<>, ann::GaussianInitialization> model;
+  model.Add<ann::Linear<>>(50, 128);
+  model.Add<ann::ReLULayer<>>();
+  model.Add<ann::Linear<>>(128, 128);
+  model.Add<ann::ReLULayer<>>();
+  model.Add<ann::Linear<>>(128, 10);
+  model.Add<ann::LogSoftMax<>>();
+
+  const arma::mat data(50, 1000, arma::fill::randu);
+  arma::mat predictions;
+
+  // Force parameter initialization outside the timed region.
+  model.Predict(data, predictions);
+
+  runner.Run([&]()
+  {
+    model.Predict(data, predictions);
+    Runner::DoNotOptimize(predictions.n_elem);
+  });
+}
@@ -13,6 +13,7 @@
 #define MLPACK_BINDINGS_CLI_DELETE_ALLOCATED_MEMORY_HPP
 
 #include <mlpack/core/util/param_data.hpp>
+#include "model_cache.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -41,9 +42,14 @@ void DeleteAllocatedMemoryImpl(
     const typename std::enable_if<!arma::is_arma_type<T>::value>::type* = 0,
     const typename std::enable_if<data::HasSerialize<T>::value>::type* = 0)
 {
-  // Delete the allocated memory (hopefully we actually own it).
+  // Delete the allocated memory (hopefully we actually own it).  In server
+  // mode, resident input models belong to the cache and must survive this
+  // request.
   typedef std::tuple<T*, std::string> TupleType;
-  delete std::get<0>(*ANY_CAST<TupleType>(&d.value));
+  T* model = std::get<0>(*ANY_CAST<TupleType>(&d.value));
+  if (ModelCache::Active() && ModelCache::Owns(model))
+    return;
+  delete model;
 }
 
 template<typename T>
@@ -14,6 +14,7 @@
 #define MLPACK_BINDINGS_CLI_END_PROGRAM_HPP
 
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/profiler.hpp>
 
 namespace mlpack {
 namespace bindings {
@@ -77,6 +78,13 @@ inline void EndProgram(util::Params& params, util::Timers& timers)
     {
       Log::Info << "  " << it2.first << ": " << timers.Print(it2.second);
     }
+
+#if defined(MLPACK_ENABLE_PROFILING)
+    // In profiling builds, also print the hierarchical profiling report.
+    const std::string report = util::Profiler::Report();
+    if (!report.empty())
+      Log::Info << std::endl << report;
+#endif
   }
 
   // Lastly clean up any memory.  If we are holding any pointers, then we "own"
@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "parameter_type.hpp"
+#include "model_cache.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -120,8 +121,16 @@ T*& GetParam(
   const std::string& value = std::get<1>(*tuple);
   if (d.input && !d.loaded)
   {
-    T* model = new T();
-    data::Load(value, "model", *model, true);
+    // In server mode the model may already be resident from an earlier
+    // request; only load it the first time its file is named.
+    T* model = ModelCache::Active() ? ModelCache::Get<T>(value) : NULL;
+    if (model == NULL)
+    {
+      model = new T();
+      data::Load(value, "model", *model, true);
+      if (ModelCache::Active())
+        ModelCache::Put(value, model);
+    }
     d.loaded = true;
     std::get<0>(*tuple) = model;
   }
@@ -83,6 +83,7 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 #include <mlpack/core/util/timers.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/server_mode.hpp>
 
 // Forward definition of the binding function.
 void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
@@ -90,6 +91,11 @@ void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
 // Define the main function that will be used by this binding.
 int main(int argc, char** argv)
 {
+  // In server mode, the program answers repeated requests from stdin instead
+  // of running once; see server_mode.hpp.
+  if (mlpack::bindings::cli::ServerModeRequested(argc, argv))
+    return mlpack::bindings::cli::RunServerMode(argc, argv, &BINDING_FUNCTION);
+
   // Parse the command-line options; put them into CLI.
   mlpack::util::Params params =
       mlpack::bindings::cli::ParseCommandLine(argc, argv);
@@ -118,5 +124,9 @@ PARAM_GLOBAL(bool, "verbose", "Display informational messages and the full "
     false, true, false, false);
 PARAM_GLOBAL(bool, "version", "Display the version of mlpack.", "V", "bool",
     false, true, false, false);
+PARAM_GLOBAL(bool, "server", "Run as a persistent server: read one request "
+    "(a set of additional command-line options) per line from stdin, keeping "
+    "loaded models resident between requests.", "", "bool", false, true, false,
+    false);
 
 #endif
@@ -0,0 +1,128 @@
+/**
+ * @file bindings/cli/model_cache.hpp
+ * @author Ryan Curtin
+ *
+ * A process-wide cache of deserialized models, used by the server mode of
+ * command-line programs (see server_mode.hpp).  Deserializing a large model
+ * can take far longer than the query it answers, so when a program serves
+ * repeated requests we keep each input model resident and hand the same
+ * pointer to every request that names the same file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_MODEL_CACHE_HPP
+#define MLPACK_BINDINGS_CLI_MODEL_CACHE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * The cache of loaded models for server mode.  The cache is inactive (and
+ * costs nothing) in a regular one-shot program run; RunServerMode() activates
+ * it.  Models are keyed by filename, and the stored type is checked with
+ * typeid so a filename reused with a different model type is reloaded rather
+ * than mis-cast.
+ */
+class ModelCache
+{
+ public:
+  //! Get whether the cache is active (true only in server mode).
+  static bool& Active()
+  {
+    static bool active = false;
+    return active;
+  }
+
+  /**
+   * Get the cached model loaded from the given file, or NULL if the file has
+   * not been loaded (or was loaded as a different type).
+   */
+  template<typename T>
+  static T* Get(const std::string& filename)
+  {
+    std::map<std::string, Entry>& cache = Cache();
+    std::map<std::string, Entry>::const_iterator it = cache.find(filename);
+    if (it == cache.end() || it->second.typeName != typeid(T).name())
+      return NULL;
+    return (T*) it->second.model;
+  }
+
+  /**
+   * Store a model loaded from the given file, taking ownership of it.  If an
+   * entry for the filename already exists (e.g. it held a different type),
+   * the old model is deleted.
+   */
+  template<typename T>
+  static void Put(const std::string& filename, T* model)
+  {
+    std::map<std::string, Entry>& cache = Cache();
+    std::map<std::string, Entry>::iterator it = cache.find(filename);
+    if (it != cache.end())
+    {
+      it->second.deleter(it->second.model);
+      cache.erase(it);
+    }
+
+    Entry entry;
+    entry.model = model;
+    entry.typeName = typeid(T).name();
+    entry.deleter = &DeleteAs<T>;
+    cache[filename] = entry;
+  }
+
+  /**
+   * Return whether the cache owns the given pointer; EndProgram() must not
+   * delete a model that later requests will reuse.
+   */
+  static bool Owns(const void* model)
+  {
+    const std::map<std::string, Entry>& cache = Cache();
+    std::map<std::string, Entry>::const_iterator it;
+    for (it = cache.begin(); it != cache.end(); ++it)
+      if (it->second.model == model)
+        return true;
+    return false;
+  }
+
+  //! Delete all cached models.
+  static void Clear()
+  {
+    std::map<std::string, Entry>& cache = Cache();
+    std::map<std::string, Entry>::iterator it;
+    for (it = cache.begin(); it != cache.end(); ++it)
+      it->second.deleter(it->second.model);
+    cache.clear();
+  }
+
+ private:
+  //! One cached model, with enough type information to delete it safely.
+  struct Entry
+  {
+    void* model;
+    std::string typeName;
+    void (*deleter)(void*);
+  };
+
+  //! Get the cache map (filename -> model).
+  static std::map<std::string, Entry>& Cache()
+  {
+    static std::map<std::string, Entry> cache;
+    return cache;
+  }
+
+  //! Delete a type-erased pointer as its real type.
+  template<typename T>
+  static void DeleteAs(void* model) { delete (T*) model; }
+};
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
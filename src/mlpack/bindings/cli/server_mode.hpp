@@ -0,0 +1,171 @@
+/**
+ * @file bindings/cli/server_mode.hpp
+ * @author Ryan Curtin
+ *
+ * Persistent server mode for command-line binding programs.  A normal run
+ * loads its input models, answers one batch, and exits, so a pipeline that
+ * calls the same program repeatedly pays model deserialization on every
+ * invocation.  With --server the program instead reads one request per line
+ * from stdin, where each line holds additional command-line options for that
+ * request; options given on the original command line act as defaults for
+ * every request.  Input models are kept resident between requests (see
+ * model_cache.hpp), so only the first request that names a model file pays
+ * for loading it.
+ *
+ * Example session:
+ *
+ * @code
+ * $ mlpack_knn -m large_model.bin --server
+ * --query q1.csv -k 5 --neighbors_file n1.csv
+ * OK
+ * --query q2.csv -k 10 --neighbors_file n2.csv
+ * OK
+ * exit
+ * @endcode
+ *
+ * After each request the program prints "OK" (or "ERROR <message>") on a line
+ * of its own to stdout, so a driving process can frame responses.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVER_MODE_HPP
+#define MLPACK_BINDINGS_CLI_SERVER_MODE_HPP
+
+#include <mlpack/core/util/io.hpp>
+#include "model_cache.hpp"
+#include "parse_command_line.hpp"
+#include "end_program.hpp"
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Return whether --server was given on the command line.  This is checked
+ * before regular option parsing, since server mode changes how the rest of
+ * the arguments are interpreted (they become per-request defaults).
+ */
+inline bool ServerModeRequested(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+    if (std::string(argv[i]) == "--server")
+      return true;
+  return false;
+}
+
+/**
+ * Split a request line into command-line style tokens.  Tokens are separated
+ * by whitespace; double quotes group a token that contains spaces (e.g. a
+ * filename).
+ */
+inline std::vector<std::string> TokenizeRequestLine(const std::string& line)
+{
+  std::vector<std::string> tokens;
+  std::string current;
+  bool inQuotes = false;
+  for (size_t i = 0; i < line.length(); ++i)
+  {
+    const char c = line[i];
+    if (c == '"')
+    {
+      inQuotes = !inQuotes;
+    }
+    else if ((c == ' ' || c == '\t' || c == '\r') && !inQuotes)
+    {
+      if (!current.empty())
+      {
+        tokens.push_back(current);
+        current.clear();
+      }
+    }
+    else
+    {
+      current += c;
+    }
+  }
+  if (!current.empty())
+    tokens.push_back(current);
+  return tokens;
+}
+
+/**
+ * Run the binding as a persistent server: read a request per line from stdin,
+ * answer it with the given binding function, and keep input models resident
+ * across requests.  Returns the program's exit code.
+ *
+ * @param argc Number of arguments on the original command line.
+ * @param argv Arguments on the original command line; all options except
+ *     --server itself become defaults for every request.
+ * @param bindingFunction The binding to run for each request.
+ */
+inline int RunServerMode(int argc,
+                         char** argv,
+                         void (*bindingFunction)(util::Params&, util::Timers&))
+{
+  // Collect the default options from the startup command line.
+  std::vector<std::string> baseArgs;
+  for (int i = 1; i < argc; ++i)
+    if (std::string(argv[i]) != "--server")
+      baseArgs.push_back(argv[i]);
+
+  ModelCache::Active() = true;
+
+  std::cerr << "mlpack server mode: reading one request per line from stdin; "
+      << "send 'exit' (or EOF) to stop." << std::endl;
+
+  std::string line;
+  while (std::getline(std::cin, line))
+  {
+    const std::vector<std::string> tokens = TokenizeRequestLine(line);
+    if (tokens.empty())
+      continue;
+    if (tokens.size() == 1 && (tokens[0] == "exit" || tokens[0] == "quit"))
+      break;
+
+    // Build the argument vector for this request: program name, then the
+    // startup defaults, then the request's own options.
+    std::vector<std::string> args;
+    args.push_back(argv[0]);
+    args.insert(args.end(), baseArgs.begin(), baseArgs.end());
+    args.insert(args.end(), tokens.begin(), tokens.end());
+
+    std::vector<char*> requestArgv(args.size());
+    for (size_t i = 0; i < args.size(); ++i)
+      requestArgv[i] = const_cast<char*>(args[i].c_str());
+
+    try
+    {
+      util::Params params = ParseCommandLine((int) requestArgv.size(),
+          requestArgv.data());
+      util::Timers timers;
+      timers.Enabled() = true;
+
+      timers.Start("total_time");
+      bindingFunction(params, timers);
+      timers.Stop("total_time");
+
+      EndProgram(params, timers);
+
+      std::cout << "OK" << std::endl;
+    }
+    catch (std::exception& e)
+    {
+      // A failed request (bad option, missing file, ...) must not take the
+      // server down; report it and wait for the next request.
+      std::cout << "ERROR " << e.what() << std::endl;
+    }
+  }
+
+  ModelCache::Clear();
+  ModelCache::Active() = false;
+  return 0;
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
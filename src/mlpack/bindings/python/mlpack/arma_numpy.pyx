@@ -36,6 +36,9 @@ cdef extern from "numpy/arrayobject.h":
   numpy.npy_intp* PyArray_SHAPE(numpy.ndarray arr)
   int PyArray_FLAGS(numpy.ndarray arr)
 
+cdef extern from "<mlpack/core/util/params.hpp>" namespace "mlpack::util::Params":
+  void ReportConversionCopy(const char* description, size_t bytes) except +
+
 cdef extern from "<mlpack/bindings/python/mlpack/arma_util.hpp>":
   void SetMemState[T](T& m, int state)
   size_t GetMemState[T](T& m)
@@ -53,8 +56,14 @@ cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # If needed, make a copy where we own the memory.  A borrowed buffer only
+    # forces a copy when we mean to take ownership of it.
+    if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+      ReportConversionCopy("numpy array is not C-contiguous", X.nbytes)
+    else:
+      ReportConversionCopy("numpy array does not own its memory but "
+          "ownership transfer was requested", X.nbytes)
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -75,9 +84,14 @@ cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # If needed, make a copy where we own the memory.  A borrowed buffer only
+    # forces a copy when we mean to take ownership of it.
+    if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+      ReportConversionCopy("numpy array is not C-contiguous", X.nbytes)
+    else:
+      ReportConversionCopy("numpy array does not own its memory but "
+          "ownership transfer was requested", X.nbytes)
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -141,9 +155,14 @@ cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # If needed, make a copy where we own the memory.  A borrowed buffer only
+    # forces a copy when we mean to take ownership of it.
+    if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+      ReportConversionCopy("numpy array is not C-contiguous", X.nbytes)
+    else:
+      ReportConversionCopy("numpy array does not own its memory but "
+          "ownership transfer was requested", X.nbytes)
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -165,9 +184,14 @@ cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # If needed, make a copy where we own the memory.  A borrowed buffer only
+    # forces a copy when we mean to take ownership of it.
+    if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+      ReportConversionCopy("numpy array is not C-contiguous", X.nbytes)
+    else:
+      ReportConversionCopy("numpy array does not own its memory but "
+          "ownership transfer was requested", X.nbytes)
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -228,9 +252,14 @@ cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # If needed, make a copy where we own the memory.  A borrowed buffer only
+    # forces a copy when we mean to take ownership of it.
+    if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+      ReportConversionCopy("numpy array is not C-contiguous", X.nbytes)
+    else:
+      ReportConversionCopy("numpy array does not own its memory but "
+          "ownership transfer was requested", X.nbytes)
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -252,9 +281,14 @@ cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # If needed, make a copy where we own the memory.  A borrowed buffer only
+    # forces a copy when we mean to take ownership of it.
+    if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+      ReportConversionCopy("numpy array is not C-contiguous", X.nbytes)
+    else:
+      ReportConversionCopy("numpy array does not own its memory but "
+          "ownership transfer was requested", X.nbytes)
     X = X.copy(order="C")
     takeOwnership = True
 
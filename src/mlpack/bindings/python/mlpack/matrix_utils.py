@@ -12,7 +12,9 @@ terms of the 3-clause BSD license.  You should have received a copy of the
 http://www.opensource.org/licenses/BSD-3-Clause for more information.
 """
 import numpy as np
+import os
 import pandas as pd
+import warnings
 # The CategoricalDtype class has moved multiple times, so this insanity is
 # necessary to import the right version.
 if int(pd.__version__.split('.')[0]) > 0 or \
@@ -37,6 +39,24 @@ try:
 except:
   buffer = memoryview
 
+def _report_hidden_copy(reason, nbytes):
+  """
+  Report a conversion copy that the caller did not ask for.  Controlled by the
+  MLPACK_REQUIRE_ZERO_COPY environment variable: unset means silent, 'warn'
+  prints a warning, and 'fail' raises, so callers can guarantee
+  constant-overhead calls.  (The same variable controls the C++ side of the
+  binding glue; see mlpack::util::Params::ZeroCopyEnforcement().)
+  """
+  mode = os.environ.get('MLPACK_REQUIRE_ZERO_COPY', '')
+  if mode == '':
+    return
+  message = "zero-copy handoff violated: %s (%d bytes copied); pass the " \
+      "data in the expected layout to avoid the copy" % (reason, nbytes)
+  if mode == 'fail':
+    raise RuntimeError(message)
+  warnings.warn(message, RuntimeWarning)
+
+
 def to_matrix(x, dtype=np.double, copy=False):
   """
   Given some array-like X, return a numpy ndarray of the same type.
@@ -54,6 +74,9 @@ def to_matrix(x, dtype=np.double, copy=False):
       return x, False
   elif (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.f_contiguous):
     # A copy is always necessary here.
+    if not copy:
+      _report_hidden_copy("numpy array is F-contiguous (column-major)",
+          x.nbytes)
     return x.copy("C"), True
   else:
     if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
@@ -66,8 +89,14 @@ def to_matrix(x, dtype=np.double, copy=False):
             False
       else:
         # We have to make a copy or change the dtype, so just do this directly.
+        if not copy:
+          _report_hidden_copy("pandas data has dtype %s or a layout that "
+              "cannot be viewed as %s" % (y.dtype, np.dtype(dtype)), y.nbytes)
         return np.array(y, dtype=dtype, order='C', copy=True), True
     else:
+      if not copy and isinstance(x, np.ndarray):
+        _report_hidden_copy("numpy array has dtype %s but %s is required"
+            % (x.dtype, np.dtype(dtype)), x.nbytes)
       return np.array(x, copy=True, dtype=dtype, order='C'), True
 
 
@@ -13,6 +13,7 @@
 #define MLPACK_BINDINGS_PYTHON_MLPACK_SERIALIZATION_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/util/shared_memory.hpp>
 
 namespace mlpack {
 namespace bindings {
@@ -58,6 +59,31 @@ void SerializeInJSON(T* t, const std::string& str, const std::string& name)
   b(cereal::make_nvp(name.c_str(), *t));
 }
 
+/**
+ * Serialize the model into the named shared-memory segment, so that another
+ * process on the same machine (e.g. a C++ service, via
+ * util::AdoptFromSharedMemory()) can pick it up without a disk round trip.
+ */
+template<typename T>
+void SerializeOutToSharedMemory(T* t,
+                                const std::string& segmentName,
+                                const std::string& name)
+{
+  util::OfferToSharedMemory(*t, segmentName, name);
+}
+
+/**
+ * Deserialize the model from the named shared-memory segment; the payload is
+ * read straight out of the mapping.
+ */
+template<typename T>
+void SerializeInFromSharedMemory(T* t,
+                                 const std::string& segmentName,
+                                 const std::string& name)
+{
+  util::AdoptFromSharedMemory(*t, segmentName, name);
+}
+
 } // namespace python
 } // namespace bindings
 } // namespace mlpack
@@ -14,4 +14,8 @@ cdef extern from "serialization.hpp" namespace "mlpack::bindings::python" nogil:
   void SerializeIn[T](T* t, string str, string name) nogil
   string SerializeOutJSON[T](T* t, string name) nogil
   void SerializeInJSON[T](T* t, string str, string name) nogil
+  void SerializeOutToSharedMemory[T](T* t, string segmentName,
+                                     string name) except +
+  void SerializeInFromSharedMemory[T](T* t, string segmentName,
+                                      string name) except +
   
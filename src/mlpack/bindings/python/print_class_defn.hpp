@@ -94,6 +94,14 @@ void PrintClassDefn(
    *     params_str = process_params_in(self, params_dic)
    *     self._set_cpp_params(params_str)
    *
+   *   def to_shared_memory(self, name):
+   *     SerializeOutToSharedMemory(self.modelptr, name.encode("utf-8"),
+   *         "<ModelType>")
+   *
+   *   def from_shared_memory(self, name):
+   *     SerializeInFromSharedMemory(self.modelptr, name.encode("utf-8"),
+   *         "<ModelType>")
+   *
    * @endcode
    */
   std::cout << "cdef class " << strippedType << "Type:" << std::endl;
@@ -138,6 +146,14 @@ void PrintClassDefn(
   std::cout << "    self._set_cpp_params(params_str.encode(\"utf-8\"))"
       << std::endl;
   std::cout << std::endl;
+  std::cout << "  def to_shared_memory(self, name):" << std::endl;
+  std::cout << "    SerializeOutToSharedMemory(self.modelptr, "
+      << "name.encode(\"utf-8\"), \"" << printedType << "\")" << std::endl;
+  std::cout << std::endl;
+  std::cout << "  def from_shared_memory(self, name):" << std::endl;
+  std::cout << "    SerializeInFromSharedMemory(self.modelptr, "
+      << "name.encode(\"utf-8\"), \"" << printedType << "\")" << std::endl;
+  std::cout << std::endl;
 }
 
 /**
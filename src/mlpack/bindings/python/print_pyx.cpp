@@ -87,6 +87,8 @@ void PrintPYX(const util::BindingDetails& doc,
       << "process_params_in" << endl;
   cout << "from serialization cimport SerializeIn, SerializeOut, "
       << "SerializeOutJSON, SerializeInJSON" << endl;
+  cout << "from serialization cimport SerializeOutToSharedMemory, "
+      << "SerializeInFromSharedMemory" << endl;
   cout << endl;
   cout << "import numpy as np" << endl;
   cout << "cimport numpy as np" << endl;
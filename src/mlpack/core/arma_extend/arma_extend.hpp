@@ -14,6 +14,15 @@
 #define ARMA_EXTRA_MAT_PROTO mlpack/core/arma_extend/Mat_extra_bones.hpp
 #define ARMA_EXTRA_SPMAT_PROTO mlpack/core/arma_extend/SpMat_extra_bones.hpp
 
+// Optionally route all Armadillo buffer allocations through the mlpack
+// memory tracker (see core/util/memory_tracker.hpp).  The hooks must be
+// defined before <armadillo> is included.
+#if defined(MLPACK_ENABLE_MEMORY_TRACKING)
+  #include <mlpack/core/util/memory_tracker.hpp>
+  #define ARMA_ALIEN_MEM_ALLOC_FUNCTION mlpack::util::MemoryTracker::Allocate
+  #define ARMA_ALIEN_MEM_FREE_FUNCTION mlpack::util::MemoryTracker::Free
+#endif
+
 #include <armadillo>
 
 #endif
@@ -17,6 +17,7 @@
 #include <cereal/archives/json.hpp>
 
 #include <mlpack/core/cereal/array_wrapper.hpp>
+#include <mlpack/core/data/mapped_model.hpp>
 
 #include <armadillo>
 
@@ -83,6 +84,89 @@ void serialize(Archive& ar, arma::Mat<eT>& mat)
     ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
 }
 
+// Overload for the binary output archive: the matrix memory is written as a
+// single block (byte-identical to the element loop above), and when a
+// mapped-model save is active (see core/data/mapped_model.hpp), the payload
+// is padded so that it begins on a page boundary.
+template<typename eT>
+void serialize(cereal::BinaryOutputArchive& ar, arma::Mat<eT>& mat)
+{
+  arma::uword n_rows = mat.n_rows;
+  arma::uword n_cols = mat.n_cols;
+  arma::uword vec_state = mat.vec_state;
+
+  ar(CEREAL_NVP(n_rows));
+  ar(CEREAL_NVP(n_cols));
+  ar(CEREAL_NVP(vec_state));
+
+  mlpack::data::MappedModelContext& ctx =
+      mlpack::data::MappedModelContext::Get();
+  if (ctx.saveStream != NULL)
+  {
+    // Pad so the matrix memory starts page-aligned in the file.  The pad
+    // length is recomputed from the stream position at load time, so it does
+    // not need to be stored.
+    const size_t pad = mlpack::data::MappedModelContext::Padding(
+        (size_t) ctx.saveStream->tellp());
+    if (pad > 0)
+    {
+      const std::vector<char> zeros(pad, 0);
+      ar(cereal::binary_data(zeros.data(), pad));
+    }
+  }
+
+  ar(cereal::binary_data((void*) mat.mem, mat.n_elem * sizeof(eT)));
+}
+
+// Overload for the binary input archive.  During a mapped-model load, dense
+// (non-vector) matrices are not read at all: the matrix is rebound as a
+// read-only non-owning alias over the file mapping and the stream is seeked
+// past the payload.
+template<typename eT>
+void serialize(cereal::BinaryInputArchive& ar, arma::Mat<eT>& mat)
+{
+  arma::uword n_rows;
+  arma::uword n_cols;
+  arma::uword vec_state;
+
+  ar(CEREAL_NVP(n_rows));
+  ar(CEREAL_NVP(n_cols));
+  ar(CEREAL_NVP(vec_state));
+
+  mlpack::data::MappedModelContext& ctx =
+      mlpack::data::MappedModelContext::Get();
+  if (ctx.loadStream != NULL)
+  {
+    // Skip the alignment padding written by SaveMappedModel().
+    const size_t position = (size_t) ctx.loadStream->tellg();
+    const size_t pad = mlpack::data::MappedModelContext::Padding(position);
+    const size_t bytes = n_rows * n_cols * sizeof(eT);
+
+    // Only genuine matrices can be rebound; Col and Row objects (vec_state
+    // != 0) also reach this overload, and rebinding them as a Mat would be
+    // undefined behavior, so they take the eager path below.
+    if (ctx.base != NULL && vec_state == 0)
+    {
+      // Rebind the matrix as a strict alias over the mapping, in place.
+      eT* payload = (eT*) (ctx.base + position + pad);
+      mat.~Mat();
+      new (&mat) arma::Mat<eT>(payload, n_rows, n_cols, false, true);
+
+      ctx.loadStream->seekg(position + pad + bytes);
+      return;
+    }
+
+    // Eager fallback (no mapping available, or vector type): skip the pad,
+    // then fall through to the normal copying read.
+    if (pad > 0)
+      ctx.loadStream->seekg(position + pad);
+  }
+
+  mat.set_size(n_rows, n_cols);
+  arma::access::rw(mat.vec_state) = vec_state;
+  ar(cereal::binary_data((void*) mat.memptr(), mat.n_elem * sizeof(eT)));
+}
+
 // Add a serialization function for armadillo Cube
 template<typename Archive, typename eT>
 void serialize(Archive& ar, arma::Cube<eT>& cube)
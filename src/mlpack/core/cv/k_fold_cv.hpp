@@ -168,6 +168,13 @@ class KFoldCV
           const WeightsType& weights,
           const bool shuffle = true);
 
+  /**
+   * Copy another KFoldCV object.  The copy gets its own copy of the data and
+   * starts without a trained model, so copies can run Evaluate()
+   * concurrently (as the parallel hyper-parameter search strategies do).
+   */
+  KFoldCV(const KFoldCV& other);
+
   /**
    * Run k-fold cross-validation.
    *
@@ -180,6 +187,29 @@ class KFoldCV
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get whether the folds are trained and evaluated in parallel.
+  bool Parallel() const { return parallel; }
+  //! Modify whether the folds are trained and evaluated in parallel.  Folds
+  //! are independent, so with OpenMP enabled they can run concurrently; this
+  //! is off by default since each concurrent fold may hold its own copy of
+  //! the training data (see MemoryBudget()).
+  bool& Parallel() { return parallel; }
+
+  //! Get the cap on the number of concurrently trained folds (0 means no
+  //! cap beyond the number of available threads).
+  size_t MaxConcurrentFolds() const { return maxConcurrentFolds; }
+  //! Modify the cap on the number of concurrently trained folds.
+  size_t& MaxConcurrentFolds() { return maxConcurrentFolds; }
+
+  //! Get the memory budget, in bytes, for concurrent folds (0 means no
+  //! budget).
+  size_t MemoryBudget() const { return memoryBudget; }
+  //! Modify the memory budget, in bytes, for concurrent folds.  When set,
+  //! the number of concurrent folds is capped so that one training-subset
+  //! copy per concurrent fold fits in the budget; this guards against
+  //! algorithms that copy their training data internally.
+  size_t& MemoryBudget() { return memoryBudget; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -225,6 +255,15 @@ class KFoldCV
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! Whether to train and evaluate the folds in parallel.
+  bool parallel;
+
+  //! A cap on the number of concurrently trained folds (0 means no cap).
+  size_t maxConcurrentFolds;
+
+  //! A memory budget, in bytes, for concurrent folds (0 means no budget).
+  size_t memoryBudget;
+
   /**
    * Assert the k parameter and data consistency and initialize fields required
    * for running k-fold cross-validation.
@@ -270,6 +309,13 @@ class KFoldCV
            typename = void>
   double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
+  /**
+   * Calculate how many folds may be trained concurrently, given the number
+   * of available threads, the MaxConcurrentFolds() cap, and the
+   * MemoryBudget() (assuming one training-subset copy per concurrent fold).
+   */
+  inline size_t NumConcurrentFolds() const;
+
   /**
    * Calculate the index of the first column of the ith validation subset.
    *
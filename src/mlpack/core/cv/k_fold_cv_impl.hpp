@@ -135,7 +135,10 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallel(false),
+    maxConcurrentFolds(0),
+    memoryBudget(0)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -166,7 +169,10 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallel(false),
+    maxConcurrentFolds(0),
+    memoryBudget(0)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -179,6 +185,28 @@ KFoldCV<MLAlgorithm,
     Shuffle();
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+KFoldCV<MLAlgorithm,
+        Metric,
+        MatType,
+        PredictionsType,
+        WeightsType>::KFoldCV(const KFoldCV& other) :
+    base(other.base),
+    k(other.k),
+    xs(other.xs),
+    ys(other.ys),
+    weights(other.weights),
+    lastBinSize(other.lastBinSize),
+    binSize(other.binSize),
+    parallel(other.parallel),
+    maxConcurrentFolds(other.maxConcurrentFolds),
+    memoryBudget(other.memoryBudget)
+{ /* The model pointer is deliberately left empty. */ }
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -246,8 +274,13 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
+  // The folds are independent, so they may run concurrently; with a single
+  // thread (or parallel mode off) this degenerates to the sequential loop.
+  const size_t numThreads = parallel ? NumConcurrentFolds() : 1;
+
   size_t numInvalidScores = 0;
-  for (size_t i = 0; i < k; ++i)
+  #pragma omp parallel for schedule(dynamic) num_threads((int) numThreads)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
         GetTrainingSubset(ys, i), args...);
@@ -255,13 +288,19 @@ double KFoldCV<MLAlgorithm,
         GetValidationSubset(ys, i));
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
-      ++numInvalidScores;
-      Log::Warn << "KFoldCV::TrainAndEvaluate(): fold " << i << " returned "
-          << "a score of " << evaluations(i) << "; ignoring when computing "
-          << "the average score." << std::endl;
+      #pragma omp critical (KFoldCVTrainAndEvaluate)
+      {
+        ++numInvalidScores;
+        Log::Warn << "KFoldCV::TrainAndEvaluate(): fold " << i << " returned "
+            << "a score of " << evaluations(i) << "; ignoring when computing "
+            << "the average score." << std::endl;
+      }
     }
-    if (i == k - 1)
+    if (i == (omp_size_t) (k - 1))
+    {
+      #pragma omp critical (KFoldCVTrainAndEvaluate)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
   }
 
   if (numInvalidScores == k)
@@ -288,7 +327,12 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // The folds are independent, so they may run concurrently; with a single
+  // thread (or parallel mode off) this degenerates to the sequential loop.
+  const size_t numThreads = parallel ? NumConcurrentFolds() : 1;
+
+  #pragma omp parallel for schedule(dynamic) num_threads((int) numThreads)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model = (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
@@ -297,8 +341,11 @@ double KFoldCV<MLAlgorithm,
             args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) (k - 1))
+    {
+      #pragma omp critical (KFoldCVTrainAndEvaluateWeighted)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
   }
 
   return arma::mean(evaluations);
@@ -316,14 +363,20 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
+  const size_t origSize = (k - 1) * binSize + lastBinSize;
 
-  // Now shuffle the data.
-  math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
+  // Shuffle the original-size prefix of the extended matrices in place
+  // (through non-owning aliases), then refresh the duplicated first k - 2
+  // bins; this avoids reallocating and recopying the extended matrices.
+  MatType xsView(xs.memptr(), xs.n_rows, origSize, false, true);
+  PredictionsType ysView(ys.memptr(), ys.n_rows, origSize, false, true);
+  math::ShuffleData(xsView, ysView, xsView, ysView);
 
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
+  if (k > 2)
+  {
+    xs.cols(origSize, xs.n_cols - 1) = xs.cols(0, xs.n_cols - origSize - 1);
+    ys.cols(origSize, ys.n_cols - 1) = ys.cols(0, ys.n_cols - origSize - 1);
+  }
 }
 
 template<typename MLAlgorithm,
@@ -338,22 +391,68 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  WeightsType weightsOrig;
-  if (weights.n_elem > 0)
-    weightsOrig = weights.cols(0, (k - 1) * binSize + lastBinSize - 1);
+  const size_t origSize = (k - 1) * binSize + lastBinSize;
+
+  // Shuffle the original-size prefix of the extended matrices in place
+  // (through non-owning aliases), then refresh the duplicated first k - 2
+  // bins; this avoids reallocating and recopying the extended matrices.
+  MatType xsView(xs.memptr(), xs.n_rows, origSize, false, true);
+  PredictionsType ysView(ys.memptr(), ys.n_rows, origSize, false, true);
 
-  // Now shuffle the data.
   if (weights.n_elem > 0)
-    math::ShuffleData(xsOrig, ysOrig, weightsOrig, xsOrig, ysOrig, weightsOrig);
+  {
+    WeightsType weightsView(weights.memptr(), weights.n_rows, origSize,
+        false, true);
+    math::ShuffleData(xsView, ysView, weightsView, xsView, ysView,
+        weightsView);
+  }
   else
-    math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
+    math::ShuffleData(xsView, ysView, xsView, ysView);
 
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
-  if (weights.n_elem > 0)
-    InitKFoldCVMat(weightsOrig, weights);
+  if (k > 2)
+  {
+    xs.cols(origSize, xs.n_cols - 1) = xs.cols(0, xs.n_cols - origSize - 1);
+    ys.cols(origSize, ys.n_cols - 1) = ys.cols(0, ys.n_cols - origSize - 1);
+    if (weights.n_elem > 0)
+      weights.cols(origSize, weights.n_cols - 1) =
+          weights.cols(0, weights.n_cols - origSize - 1);
+  }
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+size_t KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::NumConcurrentFolds() const
+{
+  size_t numThreads = k;
+  #ifdef HAS_OPENMP
+  numThreads = std::min(numThreads, (size_t) omp_get_max_threads());
+  #else
+  numThreads = 1;
+  #endif
+
+  if (maxConcurrentFolds > 0)
+    numThreads = std::min(numThreads, maxConcurrentFolds);
+
+  if (memoryBudget > 0)
+  {
+    // Assume each concurrent fold holds one copy of its training subset
+    // (the largest subset is the one that includes the last bin).
+    const size_t perFoldBytes = xs.n_rows *
+        (lastBinSize + (k - 2) * binSize) *
+        sizeof(typename MatType::elem_type);
+    if (perFoldBytes > 0)
+      numThreads = std::min(numThreads,
+          std::max((size_t) 1, memoryBudget / perFoldBytes));
+  }
+
+  return std::max((size_t) 1, numThreads);
 }
 
 template<typename MLAlgorithm,
@@ -0,0 +1,143 @@
+/**
+ * @file core/cv/metrics/classification_metrics.hpp
+ *
+ * A composite classification metric that derives accuracy, precision, recall,
+ * F1 and the Matthews correlation coefficient from a single confusion matrix
+ * pass over the predictions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_CLASSIFICATION_METRICS_HPP
+#define MLPACK_CORE_CV_METRICS_CLASSIFICATION_METRICS_HPP
+
+#include <type_traits>
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/cv/metrics/average_strategy.hpp>
+
+namespace mlpack {
+namespace cv {
+
+/**
+ * ClassificationMetrics computes all of the common classification metrics at
+ * once.  The individual metric classes (Accuracy, Precision, Recall, F1) each
+ * rescan the predicted and ground truth labels, so evaluating several of them
+ * makes as many passes over the same arrays.  This class instead accumulates
+ * the confusion matrix once (data::ConfusionMatrix(), which counts in
+ * parallel) and derives every metric from its entries, so arbitrarily many
+ * statistics cost a single pass over the predictions.
+ *
+ * The derived values match the corresponding metric classes: for Binary the
+ * positives are assumed to have labels equal to PositiveClass, for Micro the
+ * precision, recall and F1 all reduce to accuracy, and for Macro the
+ * per-class values are averaged.  The Matthews correlation coefficient is
+ * computed with the multiclass generalization (which reduces to the usual
+ * formula for two classes) under every strategy, and is defined as zero when
+ * its denominator vanishes.
+ *
+ * Evaluate() returns the F1 value of the summary, so the class can also be
+ * used directly as the metric of SimpleCV, KFoldCV or the hyper-parameter
+ * tuner.
+ *
+ * @tparam AS An average strategy.
+ * @tparam PositiveClass In the case of binary classification (AS = Binary)
+ *     positives are assumed to have labels equal to this value.
+ */
+template<AverageStrategy AS, size_t PositiveClass = 1>
+class ClassificationMetrics
+{
+ public:
+  //! All metrics derived from one confusion matrix pass.
+  struct Summary
+  {
+    //! The proportion of correctly labeled items.
+    double accuracy;
+    //! The proportion of true positives among positive predictions.
+    double precision;
+    //! The proportion of true positives among positive instances.
+    double recall;
+    //! The harmonic mean of precision and recall.
+    double f1;
+    //! The Matthews correlation coefficient.
+    double mcc;
+  };
+
+  /**
+   * Calculate all metrics for the given predictions in one pass.
+   *
+   * @param predictedLabels Labels predicted by a classification model.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  static Summary Measure(const arma::Row<size_t>& predictedLabels,
+                         const arma::Row<size_t>& labels);
+
+  /**
+   * Run classification and calculate all metrics in one pass.
+   *
+   * @param model A classification model.
+   * @param data Column-major data containing test items.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  template<typename MLAlgorithm, typename DataType>
+  static Summary Measure(MLAlgorithm& model,
+                         const DataType& data,
+                         const arma::Row<size_t>& labels);
+
+  /**
+   * Run classification and calculate F1 (from the one-pass summary).
+   *
+   * @param model A classification model.
+   * @param data Column-major data containing test items.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  template<typename MLAlgorithm, typename DataType>
+  static double Evaluate(MLAlgorithm& model,
+                         const DataType& data,
+                         const arma::Row<size_t>& labels);
+
+  /**
+   * Information for hyper-parameter tuning code. It indicates that we want
+   * to maximize the metric.
+   */
+  static const bool NeedsMinimization = false;
+
+ private:
+  /**
+   * Derive the metrics for binary classification.
+   */
+  template<AverageStrategy _AS, typename = std::enable_if_t<_AS == Binary>>
+  static Summary FromConfusionMatrix(const arma::mat& confusion);
+
+  /**
+   * Derive the microaveraged metrics.
+   */
+  template<AverageStrategy _AS,
+           typename = std::enable_if_t<_AS == Micro>,
+           typename = void>
+  static Summary FromConfusionMatrix(const arma::mat& confusion);
+
+  /**
+   * Derive the macroaveraged metrics.
+   */
+  template<AverageStrategy _AS,
+           typename = std::enable_if_t<_AS == Macro>,
+           typename = void,
+           typename = void>
+  static Summary FromConfusionMatrix(const arma::mat& confusion);
+
+  /**
+   * The multiclass Matthews correlation coefficient of a confusion matrix.
+   */
+  static double MatthewsCoefficient(const arma::mat& confusion);
+};
+
+} // namespace cv
+} // namespace mlpack
+
+// Include implementation.
+#include "classification_metrics_impl.hpp"
+
+#endif
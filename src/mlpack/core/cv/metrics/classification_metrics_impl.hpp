@@ -0,0 +1,153 @@
+/**
+ * @file core/cv/metrics/classification_metrics_impl.hpp
+ *
+ * Implementation of the class ClassificationMetrics.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_CLASSIFICATION_METRICS_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_CLASSIFICATION_METRICS_IMPL_HPP
+
+#include <mlpack/core/data/confusion_matrix.hpp>
+
+namespace mlpack {
+namespace cv {
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+typename ClassificationMetrics<AS, PC>::Summary
+ClassificationMetrics<AS, PC>::Measure(
+    const arma::Row<size_t>& predictedLabels,
+    const arma::Row<size_t>& labels)
+{
+  util::CheckSameSizes(predictedLabels, labels,
+      "ClassificationMetrics::Measure()");
+
+  // Cover every class that occurs in either the predictions or the ground
+  // truth (and the positive class, so the binary formulas can index it).
+  size_t numClasses = std::max(arma::max(labels),
+      arma::max(predictedLabels)) + 1;
+  if (AS == Binary)
+    numClasses = std::max(numClasses, PC + 1);
+
+  arma::mat confusion;
+  data::ConfusionMatrix(predictedLabels, labels, confusion, numClasses);
+
+  return FromConfusionMatrix<AS>(confusion);
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+template<typename MLAlgorithm, typename DataType>
+typename ClassificationMetrics<AS, PC>::Summary
+ClassificationMetrics<AS, PC>::Measure(MLAlgorithm& model,
+                                       const DataType& data,
+                                       const arma::Row<size_t>& labels)
+{
+  util::CheckSameSizes(data, labels, "ClassificationMetrics::Measure()");
+
+  arma::Row<size_t> predictedLabels;
+  model.Classify(data, predictedLabels);
+
+  return Measure(predictedLabels, labels);
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+template<typename MLAlgorithm, typename DataType>
+double ClassificationMetrics<AS, PC>::Evaluate(MLAlgorithm& model,
+                                               const DataType& data,
+                                               const arma::Row<size_t>& labels)
+{
+  return Measure(model, data, labels).f1;
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+template<AverageStrategy _AS, typename>
+typename ClassificationMetrics<AS, PC>::Summary
+ClassificationMetrics<AS, PC>::FromConfusionMatrix(const arma::mat& confusion)
+{
+  Summary summary;
+  summary.accuracy = arma::trace(confusion) / arma::accu(confusion);
+
+  // Rows of the confusion matrix are predicted classes and columns are actual
+  // classes.
+  const double tp = confusion(PC, PC);
+  summary.precision = tp / arma::accu(confusion.row(PC));
+  summary.recall = tp / arma::accu(confusion.col(PC));
+  summary.f1 = (summary.precision + summary.recall == 0.0) ? 0.0 :
+      2.0 * summary.precision * summary.recall /
+      (summary.precision + summary.recall);
+  summary.mcc = MatthewsCoefficient(confusion);
+
+  return summary;
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+template<AverageStrategy _AS, typename, typename>
+typename ClassificationMetrics<AS, PC>::Summary
+ClassificationMetrics<AS, PC>::FromConfusionMatrix(const arma::mat& confusion)
+{
+  Summary summary;
+  summary.accuracy = arma::trace(confusion) / arma::accu(confusion);
+
+  // Microaveraged precision, recall and F1 all reduce to accuracy.
+  summary.precision = summary.accuracy;
+  summary.recall = summary.accuracy;
+  summary.f1 = summary.accuracy;
+  summary.mcc = MatthewsCoefficient(confusion);
+
+  return summary;
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+template<AverageStrategy _AS, typename, typename, typename>
+typename ClassificationMetrics<AS, PC>::Summary
+ClassificationMetrics<AS, PC>::FromConfusionMatrix(const arma::mat& confusion)
+{
+  Summary summary;
+  summary.accuracy = arma::trace(confusion) / arma::accu(confusion);
+
+  const arma::vec truePositives = confusion.diag();
+  const arma::vec predictedCounts = arma::sum(confusion, 1);
+  const arma::vec actualCounts = arma::sum(confusion, 0).t();
+
+  const arma::vec precisions = truePositives / predictedCounts;
+  const arma::vec recalls = truePositives / actualCounts;
+  arma::vec f1s(confusion.n_rows);
+  for (size_t c = 0; c < confusion.n_rows; ++c)
+  {
+    f1s(c) = (precisions(c) + recalls(c) == 0.0) ? 0.0 :
+        2.0 * precisions(c) * recalls(c) / (precisions(c) + recalls(c));
+  }
+
+  summary.precision = arma::mean(precisions);
+  summary.recall = arma::mean(recalls);
+  summary.f1 = arma::mean(f1s);
+  summary.mcc = MatthewsCoefficient(confusion);
+
+  return summary;
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+double ClassificationMetrics<AS, PC>::MatthewsCoefficient(
+    const arma::mat& confusion)
+{
+  const double total = arma::accu(confusion);
+  const double correct = arma::trace(confusion);
+  const arma::vec predictedCounts = arma::sum(confusion, 1);
+  const arma::vec actualCounts = arma::sum(confusion, 0).t();
+
+  const double covariance = correct * total -
+      arma::dot(predictedCounts, actualCounts);
+  const double denominator = std::sqrt(
+      (total * total - arma::dot(predictedCounts, predictedCounts)) *
+      (total * total - arma::dot(actualCounts, actualCounts)));
+
+  return (denominator == 0.0) ? 0.0 : covariance / denominator;
+}
+
+} // namespace cv
+} // namespace mlpack
+
+#endif
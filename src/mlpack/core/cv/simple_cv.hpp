@@ -205,6 +205,14 @@ class SimpleCV
    * @param args Arguments for the given MLAlgorithm taken by its constructor
    *     (in addition to the passed ones in the SimpleCV constructor).
    */
+  /**
+   * Copy another SimpleCV object.  The copy gets its own copy of the data
+   * (with the training and validation views rebuilt against it) and starts
+   * without a trained model, so copies can run Evaluate() concurrently (as
+   * the parallel hyper-parameter search strategies do).
+   */
+  SimpleCV(const SimpleCV& other);
+
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs&... args);
 
@@ -0,0 +1,277 @@
+/**
+ * @file core/data/binary_dataset.hpp
+ * @author Ryan Curtin
+ *
+ * A native mlpack columnar binary dataset format.  Each dimension of the
+ * dataset is stored as a contiguous on-disk block with an offset table, so a
+ * subset of dimensions can be loaded without deserializing the rest, and
+ * DatasetMapper metadata can be carried inline with the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BINARY_DATASET_HPP
+#define MLPACK_CORE_DATA_BINARY_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <cereal/archives/binary.hpp>
+
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+//! File layout constants for the mlpack binary dataset format.
+namespace binary_dataset {
+
+//! Magic bytes identifying an mlpack binary dataset file.
+static const char magic[4] = { 'M', 'L', 'D', 'S' };
+//! Current version of the format.
+static const uint64_t version = 1;
+//! Flag bit: DatasetMapper metadata is stored inline after the data blocks.
+static const uint64_t hasMapperFlag = 1;
+
+} // namespace binary_dataset
+
+/**
+ * Save the given matrix to the given file in the mlpack binary dataset
+ * format.  Each dimension (matrix row) is written as one contiguous block,
+ * with a block offset table in the header; this allows LoadBinaryDataset() to
+ * read any range of dimensions without touching the rest of the file.
+ *
+ * If info is non-NULL, the DatasetMapper is serialized inline after the data
+ * blocks, so categorical mappings travel with the dataset.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save (column-major; each column is a point).
+ * @param info DatasetMapper to store inline, or NULL for none.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of the save.
+ */
+template<typename eT, typename PolicyType = IncrementPolicy>
+bool SaveBinaryDataset(const std::string& filename,
+                       const arma::Mat<eT>& matrix,
+                       const DatasetMapper<PolicyType>* info = NULL,
+                       const bool fatal = false)
+{
+  std::ofstream f(filename, std::ios::binary);
+  if (!f.is_open())
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for writing. "
+          << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for writing. "
+          << std::endl;
+    return false;
+  }
+
+  const uint64_t rows = matrix.n_rows;
+  const uint64_t cols = matrix.n_cols;
+  const uint64_t elemSize = sizeof(eT);
+  const uint64_t flags = (info != NULL) ? binary_dataset::hasMapperFlag : 0;
+
+  f.write(binary_dataset::magic, 4);
+  f.write((const char*) &binary_dataset::version, sizeof(uint64_t));
+  f.write((const char*) &elemSize, sizeof(uint64_t));
+  f.write((const char*) &rows, sizeof(uint64_t));
+  f.write((const char*) &cols, sizeof(uint64_t));
+  f.write((const char*) &flags, sizeof(uint64_t));
+
+  // Write the offset table: one offset per dimension block, plus one more
+  // marking the end of the last block (which is also where any inline
+  // metadata begins).  With uncompressed fixed-size blocks these offsets are
+  // regular, but the table keeps the format self-describing so per-block
+  // compression can be added without a layout change.
+  const uint64_t tableStart = 4 + 5 * sizeof(uint64_t);
+  const uint64_t dataStart = tableStart + (rows + 1) * sizeof(uint64_t);
+  for (uint64_t i = 0; i <= rows; ++i)
+  {
+    const uint64_t offset = dataStart + i * cols * elemSize;
+    f.write((const char*) &offset, sizeof(uint64_t));
+  }
+
+  // Write each dimension as one contiguous block.
+  arma::Row<eT> dimBuffer;
+  for (uint64_t i = 0; i < rows; ++i)
+  {
+    dimBuffer = matrix.row(i);
+    f.write((const char*) dimBuffer.memptr(), cols * elemSize);
+  }
+
+  // Serialize the DatasetMapper inline, if we were given one.
+  if (info != NULL)
+  {
+    cereal::BinaryOutputArchive ar(f);
+    ar(cereal::make_nvp("info", const_cast<DatasetMapper<PolicyType>&>(*info)));
+  }
+
+  return f.good();
+}
+
+/**
+ * Load a range of dimensions from a file in the mlpack binary dataset format.
+ * Only the blocks for dimensions [beginDim, endDim] are read; the rest of the
+ * file is skipped via the header's offset table.  If info is non-NULL and the
+ * file carries inline DatasetMapper metadata, it is deserialized into *info.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load into; will have (endDim - beginDim + 1) rows.
+ * @param beginDim First dimension to load.
+ * @param endDim Last dimension to load, inclusive.
+ * @param info DatasetMapper to load inline metadata into, or NULL.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT, typename PolicyType = IncrementPolicy>
+bool LoadBinaryDataset(const std::string& filename,
+                       arma::Mat<eT>& matrix,
+                       const size_t beginDim,
+                       const size_t endDim,
+                       DatasetMapper<PolicyType>* info = NULL,
+                       const bool fatal = false)
+{
+  std::ostream& stream = fatal ? Log::Fatal : Log::Warn;
+
+  std::ifstream f(filename, std::ios::binary);
+  if (!f.is_open())
+  {
+    stream << "Cannot open file '" << filename << "' for reading. "
+        << std::endl;
+    return false;
+  }
+
+  char magic[4];
+  uint64_t version, elemSize, rows, cols, flags;
+  f.read(magic, 4);
+  f.read((char*) &version, sizeof(uint64_t));
+  f.read((char*) &elemSize, sizeof(uint64_t));
+  f.read((char*) &rows, sizeof(uint64_t));
+  f.read((char*) &cols, sizeof(uint64_t));
+  f.read((char*) &flags, sizeof(uint64_t));
+
+  if (!f.good() || std::memcmp(magic, binary_dataset::magic, 4) != 0)
+  {
+    stream << "File '" << filename << "' is not an mlpack binary dataset! "
+        << std::endl;
+    return false;
+  }
+
+  if (version != binary_dataset::version)
+  {
+    stream << "File '" << filename << "' has unsupported binary dataset "
+        << "version " << version << "!" << std::endl;
+    return false;
+  }
+
+  if (elemSize != sizeof(eT))
+  {
+    stream << "File '" << filename << "' holds " << elemSize << "-byte "
+        << "elements, but " << sizeof(eT) << "-byte elements were requested! "
+        << std::endl;
+    return false;
+  }
+
+  if (beginDim > endDim || endDim >= rows)
+  {
+    stream << "Requested dimensions [" << beginDim << ", " << endDim << "] "
+        << "are out of range for a dataset with " << rows << " dimensions! "
+        << std::endl;
+    return false;
+  }
+
+  // Read the offset table entries we need.
+  const uint64_t tableStart = 4 + 5 * sizeof(uint64_t);
+  std::vector<uint64_t> offsets(endDim - beginDim + 2);
+  f.seekg(tableStart + beginDim * sizeof(uint64_t));
+  f.read((char*) offsets.data(), offsets.size() * sizeof(uint64_t));
+
+  // Read only the blocks for the requested dimensions.
+  matrix.set_size(endDim - beginDim + 1, cols);
+  arma::Row<eT> dimBuffer(cols);
+  for (size_t i = beginDim; i <= endDim; ++i)
+  {
+    f.seekg(offsets[i - beginDim]);
+    f.read((char*) dimBuffer.memptr(), cols * sizeof(eT));
+    matrix.row(i - beginDim) = dimBuffer;
+  }
+
+  // Deserialize inline metadata, if present and requested.
+  if (info != NULL && (flags & binary_dataset::hasMapperFlag))
+  {
+    // The metadata section starts at the end of the last data block.
+    uint64_t metadataStart;
+    f.seekg(tableStart + rows * sizeof(uint64_t));
+    f.read((char*) &metadataStart, sizeof(uint64_t));
+    f.seekg(metadataStart);
+
+    try
+    {
+      cereal::BinaryInputArchive ar(f);
+      ar(cereal::make_nvp("info", *info));
+    }
+    catch (cereal::Exception& e)
+    {
+      stream << "Cannot load DatasetMapper metadata from '" << filename
+          << "': " << e.what() << std::endl;
+      return false;
+    }
+  }
+
+  return f.good();
+}
+
+/**
+ * Load a full matrix from a file in the mlpack binary dataset format.  If
+ * info is non-NULL and the file carries inline DatasetMapper metadata, it is
+ * deserialized into *info.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load contents of file into.
+ * @param info DatasetMapper to load inline metadata into, or NULL.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT, typename PolicyType = IncrementPolicy>
+bool LoadBinaryDataset(const std::string& filename,
+                       arma::Mat<eT>& matrix,
+                       DatasetMapper<PolicyType>* info = NULL,
+                       const bool fatal = false)
+{
+  // Peek at the header to find the number of dimensions.
+  std::ifstream f(filename, std::ios::binary);
+  if (!f.is_open())
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for reading. "
+          << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for reading. "
+          << std::endl;
+    return false;
+  }
+
+  char magic[4];
+  uint64_t version, elemSize, rows;
+  f.read(magic, 4);
+  f.read((char*) &version, sizeof(uint64_t));
+  f.read((char*) &elemSize, sizeof(uint64_t));
+  f.read((char*) &rows, sizeof(uint64_t));
+  f.close();
+
+  if (rows == 0)
+  {
+    matrix.set_size(0, 0);
+    return true;
+  }
+
+  return LoadBinaryDataset(filename, matrix, 0, rows - 1, info, fatal);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
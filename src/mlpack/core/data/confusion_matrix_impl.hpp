@@ -52,12 +52,28 @@ void ConfusionMatrix(const arma::Row<size_t> predictors,
                      arma::Mat<eT>& output,
                      const size_t numClasses)
 {
-  // Loop over the actual labels and predicted labels and add the count.
-  output = arma::zeros<arma::Mat<eT> >(numClasses, numClasses);
-  for (size_t i = 0; i < predictors.n_elem; ++i)
+  // Loop over the actual labels and predicted labels and add the count.  The
+  // counts are accumulated into one matrix per thread and then summed, so the
+  // loop can run in parallel without synchronization.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+  numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  arma::Mat<eT> threadCounts(numClasses * numClasses, numThreads,
+      arma::fill::zeros);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) predictors.n_elem; ++i)
   {
-    output.at(predictors[i], responses[i])++;
+    size_t t = 0;
+    #ifdef HAS_OPENMP
+    t = (size_t) omp_get_thread_num();
+    #endif
+    threadCounts.at(predictors[i] + numClasses * responses[i], t)++;
   }
+
+  output = arma::reshape(arma::sum(threadCounts, 1), numClasses, numClasses);
 }
 
 } // namespace data
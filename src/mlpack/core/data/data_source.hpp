@@ -0,0 +1,254 @@
+/**
+ * @file core/data/data_source.hpp
+ * @author Ryan Curtin
+ *
+ * A streaming data source that yields fixed-size column batches of a
+ * larger-than-RAM dataset from disk, with double-buffered asynchronous
+ * prefetch, plus an adapter for training incremental learners on batches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_DATA_SOURCE_HPP
+#define MLPACK_CORE_DATA_DATA_SOURCE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+
+#include <future>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * StreamingDataSource reads fixed-size column batches of a dataset stored as
+ * a raw binary column-major file (the same layout used by MMapMatrix), so
+ * that SGD-style learners can train on datasets far larger than RAM.  Because
+ * the file is column-major, each batch of points is one contiguous read.
+ *
+ * The source is double-buffered: while the caller trains on the current
+ * batch, the next batch is read from disk on a background thread, so I/O
+ * overlaps with computation.
+ *
+ * Optionally, a second raw binary file holding one label (of type eT) per
+ * point can be given; its batches are yielded alongside the data batches.
+ *
+ * @code
+ * data::StreamingDataSource<double> source("data.bin", 100, 1000000000,
+ *     "labels.bin", 10000);
+ * arma::mat batch;
+ * arma::Row<double> labels;
+ * while (source.NextBatch(batch, labels)) { ... }
+ * @endcode
+ */
+template<typename eT = double>
+class StreamingDataSource
+{
+ public:
+  /**
+   * Construct the source on the given raw binary column-major data file.
+   *
+   * @param dataFile Name of raw binary column-major data file.
+   * @param rows Number of rows (dimensions) in the on-disk dataset.
+   * @param cols Number of columns (points) in the on-disk dataset.
+   * @param labelsFile Optional raw binary file of one eT label per point.
+   * @param batchSize Number of points per batch (default 10000).
+   */
+  StreamingDataSource(const std::string& dataFile,
+                      const size_t rows,
+                      const size_t cols,
+                      const std::string& labelsFile = "",
+                      const size_t batchSize = 10000) :
+      dataFile(dataFile),
+      labelsFile(labelsFile),
+      rows(rows),
+      cols(cols),
+      batchSize(batchSize),
+      nextCol(0),
+      cur(0)
+  {
+    dataStream.open(dataFile, std::ios::binary);
+    if (!dataStream.is_open())
+      Log::Fatal << "Cannot open data file '" << dataFile << "'!" << std::endl;
+
+    if (!labelsFile.empty())
+    {
+      labelStream.open(labelsFile, std::ios::binary);
+      if (!labelStream.is_open())
+        Log::Fatal << "Cannot open labels file '" << labelsFile << "'!"
+            << std::endl;
+    }
+
+    // Start prefetching the first batch immediately.
+    StartPrefetch();
+  }
+
+  //! The prefetch thread holds references into this object; no copies.
+  StreamingDataSource(const StreamingDataSource&) = delete;
+  StreamingDataSource& operator=(const StreamingDataSource&) = delete;
+
+  ~StreamingDataSource()
+  {
+    if (prefetch.valid())
+      prefetch.wait();
+  }
+
+  /**
+   * Get the next batch of points (and labels, if a labels file was given).
+   * Returns false when the dataset is exhausted; call Reset() to rewind for
+   * another epoch.  The outputs are swapped in from the prefetch buffer, so
+   * no copy of the batch data is made.
+   *
+   * @param batch Matrix to store the batch in.
+   * @param labels Row to store the corresponding labels in.
+   * @return True if a (non-empty) batch was produced.
+   */
+  bool NextBatch(arma::Mat<eT>& batch, arma::Row<eT>& labels)
+  {
+    if (!prefetch.valid())
+      return false;
+
+    // Wait for the background read of the current batch to finish.
+    prefetch.wait();
+
+    if (buffers[cur].n_cols == 0)
+      return false;
+
+    batch.swap(buffers[cur]);
+    labels.swap(labelBuffers[cur]);
+
+    // Kick off the read of the following batch into the other buffer.
+    cur = 1 - cur;
+    StartPrefetch();
+
+    return true;
+  }
+
+  //! Get the next batch when no labels are needed.
+  bool NextBatch(arma::Mat<eT>& batch)
+  {
+    arma::Row<eT> unusedLabels;
+    return NextBatch(batch, unusedLabels);
+  }
+
+  //! Rewind to the beginning of the dataset (e.g. for the next epoch).
+  void Reset()
+  {
+    if (prefetch.valid())
+      prefetch.wait();
+
+    nextCol = 0;
+    dataStream.clear();
+    if (!labelsFile.empty())
+      labelStream.clear();
+
+    StartPrefetch();
+  }
+
+  //! Get the number of dimensions in the dataset.
+  size_t Rows() const { return rows; }
+  //! Get the total number of points in the dataset.
+  size_t Cols() const { return cols; }
+  //! Get the number of points per batch.
+  size_t BatchSize() const { return batchSize; }
+
+ private:
+  //! Launch an asynchronous read of the next batch into buffers[cur].
+  void StartPrefetch()
+  {
+    const size_t slot = cur;
+    const size_t startCol = nextCol;
+    const size_t thisBatch = std::min(batchSize, cols - startCol);
+    nextCol += thisBatch;
+
+    prefetch = std::async(std::launch::async, [this, slot, startCol,
+                                               thisBatch]()
+    {
+      buffers[slot].set_size(rows, thisBatch);
+      if (thisBatch == 0)
+        return;
+
+      // A column range of a column-major file is one contiguous read.
+      dataStream.seekg(startCol * rows * sizeof(eT));
+      dataStream.read((char*) buffers[slot].memptr(),
+          thisBatch * rows * sizeof(eT));
+
+      if (!labelsFile.empty())
+      {
+        labelBuffers[slot].set_size(thisBatch);
+        labelStream.seekg(startCol * sizeof(eT));
+        labelStream.read((char*) labelBuffers[slot].memptr(),
+            thisBatch * sizeof(eT));
+      }
+    });
+  }
+
+  //! Convenience accessor (keeps the constructor readable).
+  std::ifstream& labelsStream() { return labelStream; }
+
+  //! Name of the data file.
+  std::string dataFile;
+  //! Name of the labels file (empty if none).
+  std::string labelsFile;
+  //! Open stream on the data file.
+  std::ifstream dataStream;
+  //! Open stream on the labels file.
+  std::ifstream labelStream;
+
+  //! Number of dimensions in the dataset.
+  size_t rows;
+  //! Number of points in the dataset.
+  size_t cols;
+  //! Number of points per batch.
+  size_t batchSize;
+  //! First column of the next batch to be prefetched.
+  size_t nextCol;
+
+  //! Double buffers for batches; cur indexes the one being prefetched.
+  arma::Mat<eT> buffers[2];
+  arma::Row<eT> labelBuffers[2];
+  size_t cur;
+
+  //! Handle on the in-flight background read.
+  std::future<void> prefetch;
+};
+
+/**
+ * Train the given model on a stream of batches from the given source.  The
+ * model's Train() method is called once per batch, with the batch, the labels
+ * (converted to arma::Row<size_t>), and any extra arguments; learners whose
+ * Train() continues optimization from the current parameters (e.g.
+ * LogisticRegression, SoftmaxRegression, LinearSVM) thereby train on the full
+ * dataset without it ever being materialized in memory.
+ *
+ * @param model Model to train incrementally.
+ * @param source Streaming source of batches.
+ * @param epochs Number of passes over the dataset (default 1).
+ * @param args Extra arguments forwarded to each Train() call.
+ */
+template<typename ModelType, typename eT, typename... TrainArgs>
+void StreamingTrain(ModelType& model,
+                    StreamingDataSource<eT>& source,
+                    const size_t epochs,
+                    TrainArgs&&... args)
+{
+  arma::Mat<eT> batch;
+  arma::Row<eT> labels;
+  for (size_t epoch = 0; epoch < epochs; ++epoch)
+  {
+    while (source.NextBatch(batch, labels))
+    {
+      const arma::Row<size_t> intLabels =
+          arma::conv_to<arma::Row<size_t>>::from(labels);
+      model.Train(batch, intLabels, args...);
+    }
+    source.Reset();
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
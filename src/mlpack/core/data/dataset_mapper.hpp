@@ -87,6 +87,27 @@ class DatasetMapper
   T MapString(const InputType& input,
               const size_t dimension);
 
+  /**
+   * Map an entire chunk of inputs belonging to one dimension in a single
+   * call.  This is equivalent to (but faster than) calling MapString() on
+   * each token in turn: the policy's first pass is run over the whole chunk
+   * before any mapping happens, so a chunk that turns a dimension categorical
+   * is handled consistently, and new strings are assigned stable incremental
+   * IDs in chunk order.  This is the intended entry point for incrementally
+   * mapping daily deltas with an existing (possibly deserialized) mapper:
+   * previously-assigned IDs are never changed.
+   *
+   * @tparam T Numeric type to map to (int/double/float/etc.).
+   * @param tokens Chunk of inputs to map, all from the given dimension.
+   * @param dimension Index of the dimension the tokens belong to.
+   * @param output Vector to store the mapped values in (resized to
+   *     tokens.size()).
+   */
+  template<typename T>
+  void MapTokens(const std::vector<InputType>& tokens,
+                 const size_t dimension,
+                 arma::Col<T>& output);
+
   /**
    * Return the input that corresponds to a given value in a given dimension.
    * If the value is not a valid mapping in the given dimension, a
@@ -89,6 +89,29 @@ inline T DatasetMapper<PolicyType, InputType>::MapString(
   return policy.template MapString<MapType, T>(input, dimension, maps, types);
 }
 
+// Map a whole chunk of tokens from one dimension at once.
+template<typename PolicyType, typename InputType>
+template<typename T>
+inline void DatasetMapper<PolicyType, InputType>::MapTokens(
+    const std::vector<InputType>& tokens,
+    const size_t dimension,
+    arma::Col<T>& output)
+{
+  // Run the policy's first pass over the whole chunk before mapping anything,
+  // so that a token late in the chunk which makes this dimension categorical
+  // is seen before any earlier token is mapped.
+  for (size_t i = 0; i < tokens.size(); ++i)
+    CallMapFirstPass<PolicyType, InputType, T>(policy, tokens[i], dimension,
+        types);
+
+  output.set_size(tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    output[i] = policy.template MapString<MapType, T>(tokens[i], dimension,
+        maps, types);
+  }
+}
+
 /**
  * A safe version of isnan() that only gets called when the type has a NaN at
  * all.  This is a workaround for Visual Studio, which doesn't seem to support
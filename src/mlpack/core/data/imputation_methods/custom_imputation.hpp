@@ -71,6 +71,39 @@ class CustomImputation
     }
   }
 
+  /**
+   * Impute all of the given dimensions in one fused pass over the input,
+   * with the points processed in parallel; the custom value needs no
+   * statistics, so the missing entries are rewritten in place during the
+   * scan itself.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues The value to replace, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) points; ++i)
+    {
+      for (size_t d = 0; d < numDims; ++d)
+      {
+        T& value = columnMajor ? input(dimensions[d], i)
+                               : input(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+          value = customValue;
+      }
+    }
+  }
+
  private:
   //! A user-defined value that the user wants to replace missing values with.
   T customValue;
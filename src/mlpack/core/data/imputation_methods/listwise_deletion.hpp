@@ -66,6 +66,49 @@ class ListwiseDeletion
       input = input.rows(arma::uvec(colsToKeep));
     }
   }
+
+  /**
+   * Remove every case that has a missing value in any of the given
+   * dimensions, scanning the input once instead of once per dimension.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues The missing value, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to check.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+    std::vector<arma::uword> colsToKeep;
+
+    for (size_t i = 0; i < points; ++i)
+    {
+      bool keep = true;
+      for (size_t d = 0; d < numDims; ++d)
+      {
+        const T value = columnMajor ? input(dimensions[d], i)
+                                    : input(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+        {
+          keep = false;
+          break;
+        }
+      }
+
+      if (keep)
+        colsToKeep.push_back(i);
+    }
+
+    if (columnMajor)
+      input = input.cols(arma::uvec(colsToKeep));
+    else
+      input = input.rows(arma::uvec(colsToKeep));
+  }
 }; // class ListwiseDeletion
 
 } // namespace data
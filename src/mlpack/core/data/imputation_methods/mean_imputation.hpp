@@ -96,6 +96,181 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Impute all of the given dimensions in one fused pass over the input.
+   * The sums and counts of every dimension are accumulated per thread while
+   * the points are scanned in parallel, so the input is read once no matter
+   * how many dimensions are imputed; the missing entries found during the
+   * scan are then rewritten with their dimension's mean.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues The value to replace, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    size_t numThreads = 1;
+    #ifdef HAS_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+    #endif
+
+    // Per-thread partial sums and counts of the valid elements of each
+    // dimension, and per-thread lists of (dimension slot, point) pairs where
+    // a missing entry was seen.
+    arma::mat threadSums(numDims, numThreads, arma::fill::zeros);
+    arma::Mat<size_t> threadCounts(numDims, numThreads, arma::fill::zeros);
+    std::vector<std::vector<std::pair<size_t, size_t>>>
+        threadTargets(numThreads);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) points; ++i)
+    {
+      size_t t = 0;
+      #ifdef HAS_OPENMP
+      t = (size_t) omp_get_thread_num();
+      #endif
+      for (size_t d = 0; d < numDims; ++d)
+      {
+        const T value = columnMajor ? input(dimensions[d], i)
+                                    : input(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+        {
+          threadTargets[t].emplace_back(d, (size_t) i);
+        }
+        else
+        {
+          threadSums(d, t) += value;
+          threadCounts(d, t)++;
+        }
+      }
+    }
+
+    arma::vec means(numDims);
+    for (size_t d = 0; d < numDims; ++d)
+    {
+      const size_t elems = arma::accu(threadCounts.row(d));
+      if (elems == 0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in dimension " << dimensions[d] << std::endl;
+
+      means[d] = arma::accu(threadSums.row(d)) / elems;
+    }
+
+    // Only the missing entries found during the scan need to be rewritten.
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      for (const std::pair<size_t, size_t>& target : threadTargets[t])
+      {
+        if (columnMajor)
+          input(dimensions[target.first], target.second) =
+              means[target.first];
+        else
+          input(target.second, dimensions[target.first]) =
+              means[target.first];
+      }
+    }
+  }
+
+  /**
+   * Add the valid elements of the given chunk to the running per-dimension
+   * statistics, for imputing a dataset that arrives as a stream of chunks
+   * (e.g. from a StreamingDataSource).  Accumulate() every chunk first, then
+   * Apply() each chunk to rewrite its missing entries with the means of the
+   * full dataset; the same dimensions must be given to every call.
+   *
+   * @param chunk Chunk of the dataset.
+   * @param mappedValues The value to replace, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the chunk is columnMajor or not.
+   */
+  void Accumulate(const arma::Mat<T>& chunk,
+                  const std::vector<T>& mappedValues,
+                  const std::vector<size_t>& dimensions,
+                  const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    if (runningSums.n_elem != numDims)
+    {
+      runningSums.zeros(numDims);
+      runningCounts.zeros(numDims);
+    }
+
+    const size_t points = columnMajor ? chunk.n_cols : chunk.n_rows;
+    for (size_t i = 0; i < points; ++i)
+    {
+      for (size_t d = 0; d < numDims; ++d)
+      {
+        const T value = columnMajor ? chunk(dimensions[d], i)
+                                    : chunk(i, dimensions[d]);
+        if (!(value == mappedValues[d] || std::isnan(value)))
+        {
+          runningSums[d] += value;
+          runningCounts[d]++;
+        }
+      }
+    }
+  }
+
+  /**
+   * Rewrite the missing entries of the given chunk in place with the means
+   * of the statistics gathered by Accumulate().
+   *
+   * @param chunk Chunk of the dataset.
+   * @param mappedValues The value to replace, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the chunk is columnMajor or not.
+   */
+  void Apply(arma::Mat<T>& chunk,
+             const std::vector<T>& mappedValues,
+             const std::vector<size_t>& dimensions,
+             const bool columnMajor = true) const
+  {
+    const size_t numDims = dimensions.size();
+    arma::vec means(numDims);
+    for (size_t d = 0; d < numDims; ++d)
+    {
+      if (runningSums.n_elem != numDims || runningCounts[d] == 0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "accumulated for dimension " << dimensions[d] << std::endl;
+
+      means[d] = runningSums[d] / runningCounts[d];
+    }
+
+    const size_t points = columnMajor ? chunk.n_cols : chunk.n_rows;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) points; ++i)
+    {
+      for (size_t d = 0; d < numDims; ++d)
+      {
+        T& value = columnMajor ? chunk(dimensions[d], i)
+                               : chunk(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+          value = means[d];
+      }
+    }
+  }
+
+  //! Discard the statistics gathered by Accumulate().
+  void Reset()
+  {
+    runningSums.reset();
+    runningCounts.reset();
+  }
+
+ private:
+  //! Running per-dimension sums of the chunks seen by Accumulate().
+  arma::vec runningSums;
+  //! Running per-dimension counts of the chunks seen by Accumulate().
+  arma::Col<size_t> runningCounts;
 }; // class MeanImputation
 
 } // namespace data
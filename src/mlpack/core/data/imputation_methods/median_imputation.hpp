@@ -85,6 +85,84 @@ class MedianImputation
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Impute all of the given dimensions in one fused pass over the input.
+   * The valid elements of every dimension are collected per thread while the
+   * points are scanned in parallel, so the input is read once no matter how
+   * many dimensions are imputed; the missing entries found during the scan
+   * are then rewritten with their dimension's median.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues The value to replace, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    size_t numThreads = 1;
+    #ifdef HAS_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+    #endif
+
+    // Per-thread valid elements of each dimension, and per-thread lists of
+    // (dimension slot, point) pairs where a missing entry was seen.
+    std::vector<std::vector<std::vector<double>>> threadElems(numThreads,
+        std::vector<std::vector<double>>(numDims));
+    std::vector<std::vector<std::pair<size_t, size_t>>>
+        threadTargets(numThreads);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) points; ++i)
+    {
+      size_t t = 0;
+      #ifdef HAS_OPENMP
+      t = (size_t) omp_get_thread_num();
+      #endif
+      for (size_t d = 0; d < numDims; ++d)
+      {
+        const T value = columnMajor ? input(dimensions[d], i)
+                                    : input(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+          threadTargets[t].emplace_back(d, (size_t) i);
+        else
+          threadElems[t][d].push_back(value);
+      }
+    }
+
+    arma::vec medians(numDims);
+    for (size_t d = 0; d < numDims; ++d)
+    {
+      std::vector<double> elemsToKeep;
+      for (size_t t = 0; t < numThreads; ++t)
+      {
+        elemsToKeep.insert(elemsToKeep.end(), threadElems[t][d].begin(),
+            threadElems[t][d].end());
+      }
+      medians[d] = arma::median(arma::vec(elemsToKeep));
+    }
+
+    // Only the missing entries found during the scan need to be rewritten.
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      for (const std::pair<size_t, size_t>& target : threadTargets[t])
+      {
+        if (columnMajor)
+          input(dimensions[target.first], target.second) =
+              medians[target.first];
+        else
+          input(target.second, dimensions[target.first]) =
+              medians[target.first];
+      }
+    }
+  }
 }; // class MedianImputation
 
 } // namespace data
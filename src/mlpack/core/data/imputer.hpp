@@ -65,6 +65,29 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Impute all of the given dimensions with one fused pass over the input,
+  * instead of one full scan per dimension.  The strategy computes the
+  * statistics of every dimension at once while the points are scanned in
+  * parallel, then rewrites the missing entries in place.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation.
+  */
+  void Impute(arma::Mat<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      mappedValues[d] =
+          static_cast<T>(mapper.UnmapValue(missingValue, dimensions[d]));
+    }
+    strategy.Impute(input, mappedValues, dimensions, columnMajor);
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
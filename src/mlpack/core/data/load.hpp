@@ -23,6 +23,8 @@
 #include "image_info.hpp"
 #include "load_csv.hpp"
 #include "load_arff.hpp"
+#include "mmap_matrix.hpp"
+#include "binary_dataset.hpp"
 #include "detect_file_type.hpp"
 
 namespace mlpack {
@@ -76,6 +78,37 @@ bool Load(const std::string& filename,
           const bool transpose = true,
           const FileType inputLoadType = FileType::AutoDetect);
 
+/**
+ * Loads a matrix from file and applies an elementwise transform to every
+ * value, fusing the transform into the load so the matrix is not traversed
+ * in a separate pass afterwards.  For CSV data the transform is applied by
+ * the parser as each value is converted; for all other formats the matrix is
+ * loaded as usual and transformed in place in one parallel pass, still
+ * without a second copy of the data.
+ *
+ * The transform must implement TransformElement(dimension, value), like the
+ * scalers and the transforms defined alongside data::LoadCSV
+ * (data::BinarizeTransform, data::ClampTransform, data::Log1pTransform); an
+ * arbitrary elementwise callable can be adapted with
+ * data::MakeElementTransform().  The dimension passed is the matrix row
+ * index after any transpose.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load contents of file into.
+ * @param transform Elementwise transform to apply to each value.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, transpose the matrix after loading (default true).
+ * @param inputLoadType Used to determine the type of file to load (default arma::auto_detect).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT, typename TransformType>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          const TransformType& transform,
+          const bool fatal = false,
+          const bool transpose = true,
+          const FileType inputLoadType = FileType::AutoDetect);
+
 /**
  * Loads a sparse matrix from file, using arma::coord_ascii format.  This
  * will transpose the matrix at load time (unless the transpose parameter is set
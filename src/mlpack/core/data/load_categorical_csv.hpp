@@ -30,6 +30,90 @@ void LoadCSV::LoadCategoricalCSV(arma::Mat<eT> &inout,
     NonTransposeParse(inout, infoSet);
 }
 
+template<typename eT, typename PolicyType>
+void LoadCSV::LoadOneHotCSV(arma::Mat<eT> &inout,
+                            DatasetMapper<PolicyType> &infoSet)
+{
+  CheckOpen();
+
+  // Take the first pass through the file; this builds the categorical
+  // mappings in infoSet and gives us the un-encoded matrix size.
+  size_t rows, cols;
+  InitializeTransposeMapper<eT>(rows, cols, infoSet);
+
+  // Compute the offset of each input dimension in the one-hot encoded
+  // output; a categorical dimension expands to one row per category.
+  arma::Col<size_t> dimensionOffsets(rows + 1);
+  dimensionOffsets[0] = 0;
+  for (size_t d = 0; d < rows; ++d)
+  {
+    const size_t width = (infoSet.Type(d) == Datatype::categorical) ?
+        infoSet.NumMappings(d) : 1;
+    dimensionOffsets[d + 1] = dimensionOffsets[d] + width;
+  }
+
+  // The encoded matrix is mostly zeros, so zero it once up front and only
+  // write the nonzero entries during the parse.
+  inout.zeros(dimensionOffsets[rows], cols);
+
+  // Initialize auxiliary variables.
+  size_t row = 0;
+  size_t col = 0;
+  std::string line;
+  inFile.clear();
+  inFile.seekg(0, std::ios::beg);
+
+  while (std::getline(inFile, line))
+  {
+    // Remove whitespaces from either side.
+    Trim(line);
+    // Reset the row we are looking at.  (Remember this is transposed.)
+    row = 0;
+    std::stringstream lineStream;
+    std::string token;
+    lineStream.clear();
+    lineStream.str(line);
+
+    while (lineStream.good())
+    {
+      std::getline(lineStream, token, delim);
+      // Remove whitespaces from either side.
+      Trim(token);
+
+      if (token[0] == '"' && token[token.size() - 1] != '"')
+      {
+        // First part of the string.
+        std::string tok = token;
+        while (token[token.size() - 1] != '"')
+        {
+          tok += delim;
+          std::getline(lineStream, token, delim);
+          tok += token;
+        }
+        token = tok;
+      }
+
+      const eT mapped = infoSet.template MapString<eT>(std::move(token), row);
+      if (infoSet.Type(row) == Datatype::categorical)
+        inout(dimensionOffsets[row] + (size_t) mapped, col) = eT(1);
+      else
+        inout(dimensionOffsets[row], col) = mapped;
+      row++;
+    }
+
+    // Make sure we got the right number of rows.
+    if (row != rows)
+    {
+      std::ostringstream oss;
+      oss << "LoadCSV::LoadOneHotCSV(): wrong number of dimensions (" << row
+          << ") on line " << col << "; should be " << rows << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+    // Increment the column index.
+    ++col;
+  }
+}
+
 inline void LoadCSV::CategoricalMatSize(
     std::stringstream& lineStream, size_t& col, const char delim)
 {
@@ -55,6 +55,84 @@
 namespace mlpack {
 namespace data {
 
+/**
+ * A no-op scaler used by the unscaled LoadNumericCSV() overload; see the
+ * scaler overload of LoadNumericCSV() for the fused load-scale path.
+ */
+struct IdentityElementScaler
+{
+  //! Return the value unchanged.
+  double TransformElement(const size_t /* dimension */,
+                          const double value) const { return value; }
+};
+
+/**
+ * Elementwise transforms for the fused load-transform overload of
+ * data::Load().  Each implements the same TransformElement(dimension, value)
+ * contract as the scalers, so they can be applied to every value as it is
+ * parsed instead of in a separate pass over the loaded matrix.
+ */
+
+//! Set values greater than the threshold to 1 and all others to 0 (the
+//! fused equivalent of data::Binarize()).
+struct BinarizeTransform
+{
+  BinarizeTransform(const double threshold) : threshold(threshold) { }
+
+  double TransformElement(const size_t /* dimension */,
+                          const double value) const
+  { return (value > threshold) ? 1.0 : 0.0; }
+
+  //! The binarization threshold.
+  double threshold;
+};
+
+//! Clamp values into the range [lo, hi].
+struct ClampTransform
+{
+  ClampTransform(const double lo, const double hi) : lo(lo), hi(hi) { }
+
+  double TransformElement(const size_t /* dimension */,
+                          const double value) const
+  { return (value < lo) ? lo : ((value > hi) ? hi : value); }
+
+  //! The bounds of the clamping range.
+  double lo, hi;
+};
+
+//! Apply log(1 + x) to each value.
+struct Log1pTransform
+{
+  double TransformElement(const size_t /* dimension */,
+                          const double value) const
+  { return std::log1p(value); }
+};
+
+/**
+ * Adapt an arbitrary elementwise callable (e.g. a lambda taking and
+ * returning a double) to the TransformElement() contract, so user-supplied
+ * transforms can be fused into loading with MakeElementTransform().
+ */
+template<typename FunctionType>
+struct ElementTransform
+{
+  ElementTransform(FunctionType function) : function(std::move(function)) { }
+
+  double TransformElement(const size_t /* dimension */,
+                          const double value) const
+  { return function(value); }
+
+  //! The wrapped elementwise function.
+  FunctionType function;
+};
+
+//! Convenience function to wrap a callable in an ElementTransform.
+template<typename FunctionType>
+ElementTransform<FunctionType> MakeElementTransform(FunctionType function)
+{
+  return ElementTransform<FunctionType>(std::move(function));
+}
+
 /**
  * Load the csv file. This class contains functions
  * to load numeric and categorical data.
@@ -114,6 +192,23 @@ class LoadCSV
   template<typename eT>
   bool LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f);
 
+  /**
+  * Overload of the above which applies a fitted scaler to every value as it
+  * is parsed, fusing the loading and scaling passes so the matrix is only
+  * traversed once.  The scaler must implement
+  * TransformElement(dimension, value) (e.g. data::StandardScaler or
+  * data::MinMaxScaler); the dimension passed is the CSV column index, which
+  * becomes the matrix row (the feature dimension) after the transpose
+  * applied by data::Load().
+  *
+  * @param x Matrix in which data will be loaded.
+  * @param f File stream to access the data file.
+  * @param scaler Fitted scaler to apply to each value while parsing.
+  */
+  template<typename eT, typename ScalerType>
+  bool LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f,
+                      const ScalerType& scaler);
+
   /**
   * Converts the given string token to assigned datatype and assigns
   * this value to the given address. The address here will be a
@@ -155,6 +250,22 @@ class LoadCSV
                           DatasetMapper<PolicyType> &infoSet,
                           const bool transpose = true);
 
+  /**
+  * Load the file into the given matrix with the given DatasetMapper object,
+  * one-hot encoding every categorical dimension as it is parsed.  The
+  * mapped-integer intermediate matrix is never materialized: the mappings
+  * built during the first pass determine the encoded row of each categorical
+  * value, and the parse writes the ones directly into the (zeroed) expanded
+  * matrix.  Only the transposed (column-major points) layout is supported.
+  * Throws exceptions on errors.
+  *
+  * @param inout Matrix to load the one-hot encoded data into.
+  * @param infoSet DatasetMapper to use while loading.
+  */
+  template<typename eT, typename PolicyType>
+  void LoadOneHotCSV(arma::Mat<eT> &inout,
+                     DatasetMapper<PolicyType> &infoSet);
+
   /**
   * Peek at the file to determine the number of rows and columns in the matrix,
   * assuming a non-transposed matrix.  This will also take a first pass over
@@ -76,17 +76,64 @@ bool Load(const std::vector<std::string>& files,
       info.Width() * info.Height() * info.Channels(), files.size());
   tmpMatrix.col(0) = img;
 
-  for (size_t i = 1; i < files.size() ; ++i)
+  // Decode the remaining files in parallel.  Each iteration decodes into a
+  // thread-local matrix, and only an image whose dimensions match the first
+  // image of the batch is copied into its column of the output; failures are
+  // recorded per file instead of aborting the whole batch.  Decoding into
+  // the column directly is not an option: LoadImage() assigns a freshly
+  // sized matrix, which would make Armadillo throw out of the OpenMP region
+  // (and so call std::terminate()) for any image of a different size.  Each
+  // thread uses a private ImageInfo so that dimension queries from STB do
+  // not race on the caller's info object.
+  size_t failures = 0;
+
+  #pragma omp parallel for reduction(+: failures)
+  for (omp_size_t i = 1; i < (omp_size_t) files.size(); ++i)
   {
-    arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
-        false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
-
-    if (!status)
-      return false;
+    arma::Mat<unsigned char> colImg;
+    ImageInfo colInfo = info;
+    // Errors are reported as warnings here even in fatal mode; Log::Fatal
+    // throws, and an exception must not propagate out of the OpenMP region.
+    if (!LoadImage(files[i], colImg, colInfo, false))
+    {
+      ++failures;
+    }
+    else if (colInfo.Width() != info.Width() ||
+             colInfo.Height() != info.Height() ||
+             colInfo.Channels() != info.Channels())
+    {
+      #pragma omp critical
+      Log::Warn << "Load(): image '" << files[i] << "' has dimensions "
+          << colInfo.Width() << "x" << colInfo.Height() << "x"
+          << colInfo.Channels() << ", but the first image in the batch has "
+          << "dimensions " << info.Width() << "x" << info.Height() << "x"
+          << info.Channels() << "!" << std::endl;
+      ++failures;
+    }
+    else
+    {
+      tmpMatrix.col(i) = colImg;
+    }
   }
 
+  // Successfully decoded columns are returned even if some files failed;
+  // columns for failed files hold no meaningful data.
   matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
+
+  if (failures > 0)
+  {
+    std::ostringstream oss;
+    oss << "Load(): failed to load " << failures << " of " << files.size()
+        << " images in batch." << std::endl;
+
+    if (fatal)
+      Log::Fatal << oss.str();
+    else
+      Log::Warn << oss.str();
+
+    return false;
+  }
+
   return true;
 }
 
@@ -200,6 +200,104 @@ bool Load(const std::string& filename,
   return success;
 }
 
+// Load with a fused elementwise transform.
+template<typename eT, typename TransformType>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          const TransformType& transform,
+          const bool fatal,
+          const bool transpose,
+          const FileType inputLoadType)
+{
+  FileType loadType = inputLoadType;
+  if (loadType == FileType::AutoDetect)
+  {
+    // Open the stream ourselves to auto-detect the type, like the plain
+    // overload does.
+    std::fstream stream;
+#ifdef  _WIN32 // Always open in binary mode on Windows.
+    stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+#else
+    stream.open(filename.c_str(), std::fstream::in);
+#endif
+    if (!stream.is_open())
+    {
+      if (fatal)
+        Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+      else
+        Log::Warn << "Cannot open file '" << filename << "'; load failed."
+            << std::endl;
+
+      return false;
+    }
+
+    loadType = AutoDetect(stream, filename);
+  }
+
+  if (loadType == FileType::CSVASCII)
+  {
+    // The CSV parser applies the transform to each value as it is parsed.
+    Timer::Start("loading_data");
+
+    std::fstream stream;
+#ifdef  _WIN32 // Always open in binary mode on Windows.
+    stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+#else
+    stream.open(filename.c_str(), std::fstream::in);
+#endif
+    if (!stream.is_open())
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+      else
+        Log::Warn << "Cannot open file '" << filename << "'; load failed."
+            << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Loading '" << filename << "' as CSV data.  " << std::flush;
+
+    LoadCSV loader;
+    bool success = loader.LoadNumericCSV(matrix, stream, transform);
+
+    if (!success)
+    {
+      Log::Info << std::endl;
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << "Loading from '" << filename << "' failed." << std::endl;
+      else
+        Log::Warn << "Loading from '" << filename << "' failed." << std::endl;
+
+      return false;
+    }
+    else
+      Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
+          << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
+
+    if (transpose)
+      success = inplace_transpose(matrix, fatal);
+
+    Timer::Stop("loading_data");
+    return success;
+  }
+
+  // All other formats: load as usual, then apply the transform in place with
+  // one parallel pass (still no second copy of the matrix).
+  if (!Load(filename, matrix, fatal, transpose, loadType))
+    return false;
+
+  eT* ptr = matrix.memptr();
+  const size_t rows = matrix.n_rows;
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) matrix.n_elem; ++i)
+    ptr[i] = (eT) transform.TransformElement((size_t) i % rows, (double) ptr[i]);
+
+  return true;
+}
+
 // Load with mappings.  Unfortunately we have to implement this ourselves.
 template<typename eT, typename PolicyType>
 bool Load(const std::string& filename,
@@ -17,6 +17,103 @@
 namespace mlpack{
 namespace data{
 
+#ifndef MLPACK_NO_FAST_NUMBER_PARSE
+/**
+ * Fast decimal parser for the common case of plain decimal tokens
+ * (e.g. "3.25", "-1e5", "0.001").  Returns false—leaving val untouched—for
+ * anything it cannot convert with full strtod() accuracy, in which case the
+ * caller falls back to strtod().  The fast path is restricted to at most 15
+ * mantissa digits and a decimal exponent of magnitude at most 22; within
+ * those bounds, one multiplication or division by an exact power of ten is
+ * correctly rounded, so results are bit-identical to strtod().
+ *
+ * Define MLPACK_NO_FAST_NUMBER_PARSE to always use strtod() instead.
+ */
+inline bool FastDecimalParse(const char* str, const size_t len, double& val)
+{
+  size_t i = 0;
+  bool neg = false;
+  if (len > 0 && (str[0] == '+' || str[0] == '-'))
+  {
+    neg = (str[0] == '-');
+    ++i;
+  }
+
+  uint64_t mantissa = 0;
+  size_t digits = 0;
+  int exponent = 0;
+  bool anyDigits = false;
+
+  for (; i < len && str[i] >= '0' && str[i] <= '9'; ++i)
+  {
+    mantissa = mantissa * 10 + (uint64_t) (str[i] - '0');
+    ++digits;
+    anyDigits = true;
+  }
+
+  if (i < len && str[i] == '.')
+  {
+    ++i;
+    for (; i < len && str[i] >= '0' && str[i] <= '9'; ++i)
+    {
+      mantissa = mantissa * 10 + (uint64_t) (str[i] - '0');
+      ++digits;
+      --exponent;
+      anyDigits = true;
+    }
+  }
+
+  // Too many digits for the mantissa to be exactly representable.
+  if (!anyDigits || digits > 15)
+    return false;
+
+  if (i < len && (str[i] == 'e' || str[i] == 'E'))
+  {
+    ++i;
+    bool expNeg = false;
+    if (i < len && (str[i] == '+' || str[i] == '-'))
+    {
+      expNeg = (str[i] == '-');
+      ++i;
+    }
+
+    int exp = 0;
+    bool anyExpDigits = false;
+    for (; i < len && str[i] >= '0' && str[i] <= '9'; ++i)
+    {
+      exp = exp * 10 + (str[i] - '0');
+      if (exp > 1000) // Out of the fast path's range anyway.
+        return false;
+      anyExpDigits = true;
+    }
+    if (!anyExpDigits)
+      return false;
+
+    exponent += expNeg ? -exp : exp;
+  }
+
+  // Reject trailing garbage and exponents outside the exactly-representable
+  // power-of-ten table.
+  if (i != len || exponent > 22 || exponent < -22)
+    return false;
+
+  static const double pow10[] =
+  {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  double d = (double) mantissa;
+  if (exponent >= 0)
+    d *= pow10[exponent];
+  else
+    d /= pow10[-exponent];
+
+  val = neg ? -d : d;
+  return true;
+}
+#endif
+
 template<typename eT>
 bool LoadCSV::ConvertToken(eT& val,
                            const std::string& token)
@@ -69,6 +166,16 @@ bool LoadCSV::ConvertToken(eT& val,
   // it will convert all negative numbers to 0.
   if (std::is_floating_point<eT>::value)
   {
+#ifndef MLPACK_NO_FAST_NUMBER_PARSE
+    // Try the fast decimal path first; it covers the overwhelming majority of
+    // tokens in numeric CSV files and avoids the cost of strtod().
+    double fastVal;
+    if (FastDecimalParse(str, N, fastVal))
+    {
+      val = eT(fastVal);
+      return true;
+    }
+#endif
     val = eT(std::strtod(str, &endptr));
   }
   else if (std::is_integral<eT>::value)
@@ -101,34 +208,75 @@ bool LoadCSV::ConvertToken(eT& val,
 
 template<typename eT>
 bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
+{
+  return LoadNumericCSV(x, f, IdentityElementScaler());
+}
+
+template<typename eT, typename ScalerType>
+bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x,
+                             std::fstream& f,
+                             const ScalerType& scaler)
 {
   bool loadOkay = f.good();
   f.clear();
   std::pair<size_t, size_t> mat_size = GetMatrixSize<true>(f);
   x.zeros(mat_size.first, mat_size.second);
-  size_t row = 0;
 
-  std::string lineString;
-  std::stringstream lineStream;
-  std::string token;
+  // Read the rest of the file into memory in one shot, so that each line can
+  // be parsed independently.  Lines are newline-aligned chunks of the buffer,
+  // and every line maps to exactly one row of the output matrix, so the parse
+  // below can run on an OpenMP team with no synchronization on the matrix.
+  const std::fstream::pos_type pos = f.tellg();
+  f.seekg(0, std::ios::end);
+  const size_t length = (size_t) (f.tellg() - pos);
+  f.seekg(pos);
+
+  std::string buffer(length, '\0');
+  f.read(&buffer[0], length);
 
-  while (f.good())
+  // Collect the offset and length of every line in the buffer.
+  std::vector<std::pair<size_t, size_t>> lines;
+  lines.reserve(mat_size.first);
+  size_t start = 0;
+  while (start < length && lines.size() < mat_size.first)
   {
-    // Parse the file line by line.
-    std::getline(f, lineString);
+    size_t end = buffer.find('\n', start);
+    if (end == std::string::npos)
+      end = length;
 
-    if (lineString.size() == 0)
+    size_t lineLen = end - start;
+    // Strip any carriage return left by Windows line endings.
+    if (lineLen > 0 && buffer[start + lineLen - 1] == '\r')
+      --lineLen;
+
+    if (lineLen == 0)
       break;
 
-    lineStream.clear();
-    lineStream.str(lineString);
+    lines.push_back(std::make_pair(start, lineLen));
+    start = end + 1;
+  }
 
-    size_t col = 0;
+  bool parseOkay = true;
 
-    while (lineStream.good())
+  // Each iteration parses one full line into one row of the matrix; when
+  // OpenMP is enabled, lines are distributed across the thread team.
+  #pragma omp parallel for reduction(&&: parseOkay)
+  for (omp_size_t row = 0; row < (omp_size_t) lines.size(); ++row)
+  {
+    const char* line = buffer.data() + lines[row].first;
+    const size_t lineLen = lines[row].second;
+
+    size_t col = 0;
+    size_t fieldStart = 0;
+    bool moreFields = true;
+    while (moreFields && parseOkay)
     {
-      // Parse each line.
-      std::getline(lineStream, token, ',');
+      size_t fieldEnd = fieldStart;
+      while (fieldEnd < lineLen && line[fieldEnd] != ',')
+        ++fieldEnd;
+      moreFields = (fieldEnd < lineLen);
+
+      const std::string token(line + fieldStart, fieldEnd - fieldStart);
 
       // This will handle loading of both dense and sparse.
       // Initialize tmp_val of type eT with value 0.
@@ -136,21 +284,25 @@ bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
 
       if (ConvertToken<eT>(tmpVal, token))
       {
-        x.at(row, col) = tmpVal;
+        // The CSV column is the feature dimension after the final transpose.
+        x.at(row, col) = (eT) scaler.TransformElement(col, (double) tmpVal);
         ++col;
       }
       else
       {
         // Printing failed token and it's location.
+        #pragma omp critical
         Log::Warn << "Failed to convert token " << token << ", at row " << row
             << ", column " << col << " of matrix!";
 
-        return false;
+        parseOkay = false;
       }
+
+      fieldStart = fieldEnd + 1;
     }
-    ++row;
   }
-  return loadOkay;
+
+  return loadOkay && parseOkay;
 }
 
 inline void LoadCSV::NumericMatSize(std::stringstream& lineStream,
@@ -0,0 +1,231 @@
+/**
+ * @file core/data/mapped_model.hpp
+ * @author Ryan Curtin
+ *
+ * Lazy memory-mapped model serialization.  SaveMappedModel() writes a model
+ * through cereal's binary archive with every dense matrix payload padded to a
+ * page boundary; LoadMappedModel() memory-maps the file and deserializes the
+ * model with each large matrix constructed as a non-owning alias over the
+ * mapping, so no parameter data is copied at load time and workers on one
+ * host share the pages.
+ *
+ * This header is deliberately free of other mlpack includes: it is consumed
+ * by the Armadillo serialization shims in core/arma_extend, which are pulled
+ * in very early via prereqs.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_MODEL_HPP
+#define MLPACK_CORE_DATA_MAPPED_MODEL_HPP
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/cereal.hpp>
+
+#include <fstream>
+#include <string>
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Thread-local state consulted by the arma::Mat cereal shims.  While
+ * SaveMappedModel() or LoadMappedModel() is active, the relevant stream (and,
+ * when loading, the base address of the file mapping) is published here so
+ * that matrix payloads can be page-aligned and aliased instead of copied.
+ */
+class MappedModelContext
+{
+ public:
+  //! Payloads are aligned to this boundary in mapped-model files.
+  static const size_t pageSize = 4096;
+
+  //! Get the context for this thread.
+  static MappedModelContext& Get()
+  {
+    static thread_local MappedModelContext ctx;
+    return ctx;
+  }
+
+  //! Non-NULL while a mapped-model save is in progress.
+  std::ostream* saveStream;
+  //! Non-NULL while a mapped-model load is in progress.
+  std::istream* loadStream;
+  //! Base address of the mapped model file (NULL if mapping unavailable).
+  const unsigned char* base;
+
+  //! Bytes of padding needed so that the stream position lands on a page
+  //! boundary.
+  static size_t Padding(const size_t position)
+  {
+    return (pageSize - (position % pageSize)) % pageSize;
+  }
+
+ private:
+  MappedModelContext() : saveStream(NULL), loadStream(NULL), base(NULL) { }
+};
+
+/**
+ * MappedModelRegion owns the memory mapping of a model file loaded with
+ * LoadMappedModel().  Matrices in the loaded model alias this mapping
+ * directly, so the region must outlive the model.
+ */
+class MappedModelRegion
+{
+ public:
+  MappedModelRegion() : base(NULL), length(0) { }
+
+  MappedModelRegion(const MappedModelRegion&) = delete;
+  MappedModelRegion& operator=(const MappedModelRegion&) = delete;
+
+  ~MappedModelRegion() { Close(); }
+
+  //! Map the given file read-only; returns false if mapping is unavailable.
+  bool Open(const std::string& filename)
+  {
+    Close();
+#ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+      close(fd);
+      return false;
+    }
+
+    void* map = mmap(NULL, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+      return false;
+
+    base = (const unsigned char*) map;
+    length = fileStat.st_size;
+    return true;
+#else
+    (void) filename;
+    return false;
+#endif
+  }
+
+  //! Release the mapping; all aliasing matrices become invalid.
+  void Close()
+  {
+#ifndef _WIN32
+    if (base != NULL)
+      munmap((void*) base, length);
+#endif
+    base = NULL;
+    length = 0;
+  }
+
+  //! Get the base address of the mapping (NULL if not open).
+  const unsigned char* Base() const { return base; }
+  //! Get the length of the mapping, in bytes.
+  size_t Length() const { return length; }
+
+ private:
+  const unsigned char* base;
+  size_t length;
+};
+
+/**
+ * Save a model to the given file with page-aligned dense matrix payloads, so
+ * that it can later be loaded lazily with LoadMappedModel().  The file is a
+ * regular cereal binary archive apart from the alignment padding.
+ *
+ * @param filename Name of file to save the model to.
+ * @param t Model to save.
+ * @param name Name of the serialized object (default "model").
+ * @return Boolean value indicating success or failure of the save.
+ */
+template<typename T>
+bool SaveMappedModel(const std::string& filename,
+                     T& t,
+                     const std::string& name = "model")
+{
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs.is_open())
+    return false;
+
+  MappedModelContext& ctx = MappedModelContext::Get();
+  ctx.saveStream = &ofs;
+  bool success = true;
+  try
+  {
+    cereal::BinaryOutputArchive ar(ofs);
+    ar(cereal::make_nvp(name.c_str(), t));
+  }
+  catch (cereal::Exception&)
+  {
+    success = false;
+  }
+  ctx.saveStream = NULL;
+
+  return success && ofs.good();
+}
+
+/**
+ * Load a model saved with SaveMappedModel().  The file is memory-mapped, and
+ * each dense (non-vector) matrix in the model is constructed as a read-only
+ * non-owning alias over the mapping instead of being copied, so load time is
+ * independent of parameter size and concurrent workers share one physical
+ * copy of the parameters.  The given region owns the mapping and must
+ * outlive the model.
+ *
+ * If the platform does not support memory mapping, the model is loaded
+ * eagerly (with copies) instead, and true is still returned on success.
+ *
+ * @param filename Name of file to load the model from.
+ * @param t Model to load into.
+ * @param region Region object that will own the file mapping.
+ * @param name Name of the serialized object (default "model").
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename T>
+bool LoadMappedModel(const std::string& filename,
+                     T& t,
+                     MappedModelRegion& region,
+                     const std::string& name = "model")
+{
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs.is_open())
+    return false;
+
+  // If the mapping fails, fall back to an eager (copying) load.
+  region.Open(filename);
+
+  MappedModelContext& ctx = MappedModelContext::Get();
+  ctx.loadStream = &ifs;
+  ctx.base = region.Base();
+  bool success = true;
+  try
+  {
+    cereal::BinaryInputArchive ar(ifs);
+    ar(cereal::make_nvp(name.c_str(), t));
+  }
+  catch (cereal::Exception&)
+  {
+    success = false;
+  }
+  ctx.loadStream = NULL;
+  ctx.base = NULL;
+
+  return success;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
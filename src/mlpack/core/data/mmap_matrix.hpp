@@ -0,0 +1,238 @@
+/**
+ * @file core/data/mmap_matrix.hpp
+ * @author Ryan Curtin
+ *
+ * Defines MMapMatrix, a zero-copy loader that memory-maps a raw binary
+ * column-major file and exposes it as a non-owning arma::Mat alias.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MMAP_MATRIX_HPP
+#define MLPACK_CORE_DATA_MMAP_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * MMapMatrix memory-maps a raw binary file containing the elements of a
+ * column-major matrix, and provides access to the data as an arma::Mat alias
+ * that does not own (or copy) the underlying memory.  This makes opening very
+ * large on-disk datasets effectively free: no data is read until it is
+ * touched, the kernel pages elements in on demand, and multiple processes
+ * mapping the same file share one physical copy of the data.
+ *
+ * The file must contain exactly rows * cols elements of type eT with no
+ * header, in column-major order---the same layout written by
+ * arma::Mat<eT>::save(arma::raw_binary) for an un-transposed matrix.
+ *
+ * The mapping is read-only; attempts to modify the aliased matrix will fault.
+ * The MMapMatrix object must outlive any aliases retrieved via Matrix().
+ *
+ * @code
+ * data::MMapMatrix<double> m("dataset.bin", 10, 50000000);
+ * arma::mat dataset = m.Matrix(); // No copy is made.
+ * @endcode
+ *
+ * On platforms without POSIX mmap() support (i.e. Windows), Open() will fail
+ * and report that memory mapping is unavailable.
+ */
+template<typename eT = double>
+class MMapMatrix
+{
+ public:
+  //! Construct an empty MMapMatrix; call Open() before use.
+  MMapMatrix() : mapping(NULL), mapLength(0), rows(0), cols(0) { }
+
+  /**
+   * Construct an MMapMatrix by mapping the given file.  If the file cannot be
+   * mapped and fatal is true, a std::runtime_error is thrown; otherwise a
+   * warning is issued and the object is left empty.
+   *
+   * @param filename Name of raw binary column-major file to map.
+   * @param rows Number of rows (dimensions) in the on-disk matrix.
+   * @param cols Number of columns (points) in the on-disk matrix.
+   * @param fatal If an error should be reported as fatal (default false).
+   */
+  MMapMatrix(const std::string& filename,
+             const size_t rows,
+             const size_t cols,
+             const bool fatal = false) :
+      mapping(NULL), mapLength(0), rows(0), cols(0)
+  {
+    Open(filename, rows, cols, fatal);
+  }
+
+  //! MMapMatrix cannot be copied: the mapping has a single owner.
+  MMapMatrix(const MMapMatrix&) = delete;
+  MMapMatrix& operator=(const MMapMatrix&) = delete;
+
+  //! Take ownership of another MMapMatrix's mapping.
+  MMapMatrix(MMapMatrix&& other) :
+      mapping(other.mapping),
+      mapLength(other.mapLength),
+      rows(other.rows),
+      cols(other.cols)
+  {
+    other.mapping = NULL;
+    other.mapLength = 0;
+    other.rows = 0;
+    other.cols = 0;
+  }
+
+  //! Take ownership of another MMapMatrix's mapping.
+  MMapMatrix& operator=(MMapMatrix&& other)
+  {
+    if (this != &other)
+    {
+      Close();
+      mapping = other.mapping;
+      mapLength = other.mapLength;
+      rows = other.rows;
+      cols = other.cols;
+      other.mapping = NULL;
+      other.mapLength = 0;
+      other.rows = 0;
+      other.cols = 0;
+    }
+    return *this;
+  }
+
+  //! Unmap the file (if one is mapped).
+  ~MMapMatrix() { Close(); }
+
+  /**
+   * Map the given raw binary column-major file.  Any existing mapping is
+   * released first.
+   *
+   * @param filename Name of raw binary column-major file to map.
+   * @param rowsIn Number of rows (dimensions) in the on-disk matrix.
+   * @param colsIn Number of columns (points) in the on-disk matrix.
+   * @param fatal If an error should be reported as fatal (default false).
+   * @return Boolean value indicating success or failure of the mapping.
+   */
+  bool Open(const std::string& filename,
+            const size_t rowsIn,
+            const size_t colsIn,
+            const bool fatal = false)
+  {
+    Close();
+
+    std::ostream& stream = fatal ? Log::Fatal : Log::Warn;
+
+#ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      stream << "Cannot open file '" << filename << "' for memory mapping. "
+          << std::endl;
+      return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+      close(fd);
+      stream << "Cannot stat file '" << filename << "'. " << std::endl;
+      return false;
+    }
+
+    const size_t expected = rowsIn * colsIn * sizeof(eT);
+    if ((size_t) fileStat.st_size < expected)
+    {
+      close(fd);
+      stream << "File '" << filename << "' has size " << fileStat.st_size
+          << " bytes, but " << expected << " bytes are required for a "
+          << rowsIn << " x " << colsIn << " matrix of "
+          << sizeof(eT) << "-byte elements!" << std::endl;
+      return false;
+    }
+
+    void* map = mmap(NULL, expected, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping holds its own reference to the file, so the descriptor can
+    // be closed immediately regardless of whether mmap() succeeded.
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+      stream << "mmap() failed for file '" << filename << "'. " << std::endl;
+      return false;
+    }
+
+    // Sequential first-touch is the common access pattern for training.
+    #ifdef MADV_SEQUENTIAL
+    madvise(map, expected, MADV_SEQUENTIAL);
+    #endif
+
+    mapping = (eT*) map;
+    mapLength = expected;
+    rows = rowsIn;
+    cols = colsIn;
+    return true;
+#else
+    (void) rowsIn;
+    (void) colsIn;
+    stream << "Cannot memory-map file '" << filename << "': memory mapping is "
+        << "not available on this platform. " << std::endl;
+    return false;
+#endif
+  }
+
+  //! Release the mapping, if any.  Aliases become invalid.
+  void Close()
+  {
+#ifndef _WIN32
+    if (mapping != NULL)
+      munmap((void*) mapping, mapLength);
+#endif
+    mapping = NULL;
+    mapLength = 0;
+    rows = 0;
+    cols = 0;
+  }
+
+  /**
+   * Get a non-owning, strict arma::Mat alias over the mapped file.  No data is
+   * copied; the returned matrix is read-only and is only valid while this
+   * MMapMatrix remains open.
+   */
+  arma::Mat<eT> Matrix() const
+  {
+    // Use the advanced constructor, like math::MakeAlias().
+    return arma::Mat<eT>(const_cast<eT*>(mapping), rows, cols, false, true);
+  }
+
+  //! Return whether a file is currently mapped.
+  bool IsOpen() const { return mapping != NULL; }
+
+  //! Get the number of rows in the mapped matrix.
+  size_t Rows() const { return rows; }
+  //! Get the number of columns in the mapped matrix.
+  size_t Cols() const { return cols; }
+
+ private:
+  //! Pointer to the mapped region (NULL if no file is mapped).
+  eT* mapping;
+  //! Length of the mapped region, in bytes.
+  size_t mapLength;
+  //! Number of rows in the mapped matrix.
+  size_t rows;
+  //! Number of columns in the mapped matrix.
+  size_t cols;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -124,15 +124,17 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   // Now, initialize the output matrix to the right size.
   output.zeros(dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
 
-  // Finally, one-hot encode the matrix.
-  for (size_t col = 0; col < input.n_cols; ++col)
+  // Finally, one-hot encode the matrix.  Every column writes a disjoint set
+  // of output elements, so the columns can be filled in parallel.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
   {
     for (size_t row = 0; row < input.n_rows; ++row)
     {
       const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
       if (mappings.count(row) != 0)
       {
-        output(dimOffset + mappings[row][input(row, col)], col) = eT(1);
+        output(dimOffset + mappings.at(row).at(input(row, col)), col) = eT(1);
       }
       else
       {
@@ -143,6 +145,107 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   }
 }
 
+/**
+ * Overloaded function for the above function, which writes into a sparse
+ * destination matrix.  The one-hot encoded matrix is mostly zeros, so for
+ * dimensionalities in the hundreds or more the sparse representation avoids
+ * allocating (and traversing) the dense zero block entirely; the nonzero
+ * entries are assembled in parallel and handed to the batch-insertion
+ * constructor.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = arma::SpMat<eT>(input);
+    return;
+  }
+
+  // First, develop the mappings and dimension offsets, exactly as in the
+  // dense overload.
+  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    dimensionOffsets[indices[i]] = 0;
+    mappings.insert(
+        std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
+  }
+
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (mappings.count(row) != 0)
+      {
+        // We have to one-hot encode this point.
+        if (mappings[row].count(input(row, col)) == 0)
+          mappings[row][input(row, col)] = dimensionOffsets[row]++;
+      }
+    }
+  }
+
+  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
+    dimensionOffsets[i] += dimensionOffsets[i - 1];
+
+  // Count the entries contributed by each column: an encoded dimension
+  // contributes exactly one, and a passthrough dimension contributes its
+  // value if it is nonzero.
+  arma::Col<size_t> columnCounts(input.n_cols, arma::fill::zeros);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (mappings.count(row) != 0 || input(row, col) != eT(0))
+        ++columnCounts[col];
+    }
+  }
+
+  arma::Col<size_t> columnOffsets(input.n_cols + 1);
+  columnOffsets[0] = 0;
+  for (size_t col = 0; col < input.n_cols; ++col)
+    columnOffsets[col + 1] = columnOffsets[col] + columnCounts[col];
+
+  // Assemble the nonzero entries in parallel; each column fills its own
+  // slice of the location and value arrays.
+  arma::umat locations(2, columnOffsets[input.n_cols]);
+  arma::Col<eT> values(columnOffsets[input.n_cols]);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
+  {
+    size_t pos = columnOffsets[col];
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
+      if (mappings.count(row) != 0)
+      {
+        locations(0, pos) = dimOffset + mappings.at(row).at(input(row, col));
+        locations(1, pos) = col;
+        values[pos++] = eT(1);
+      }
+      else if (input(row, col) != eT(0))
+      {
+        locations(0, pos) = dimOffset;
+        locations(1, pos) = col;
+        values[pos++] = input(row, col);
+      }
+    }
+  }
+
+  // The locations are already sorted in column-major order.
+  output = arma::SpMat<eT>(locations, values,
+      dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols, false);
+}
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
@@ -169,6 +272,31 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+/**
+ * Overloaded function for the above function, which writes into a sparse
+ * destination matrix.  All dimensions marked `Datatype::categorical` in the
+ * data::DatasetInfo are encoded.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    {
+      indices.push_back(i);
+    }
+  }
+  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -66,15 +66,46 @@ class MinMaxScaler
   }
 
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the min max and scale.  The
+   * minimum and maximum are found in one pass over the data, accumulated
+   * per thread and then merged.
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    const size_t dims = input.n_rows;
+
+    size_t numThreads = 1;
+    #ifdef HAS_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+    #endif
+
+    arma::mat threadMin(dims, numThreads);
+    arma::mat threadMax(dims, numThreads);
+    threadMin.fill(std::numeric_limits<double>::max());
+    threadMax.fill(std::numeric_limits<double>::lowest());
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    {
+      size_t t = 0;
+      #ifdef HAS_OPENMP
+      t = (size_t) omp_get_thread_num();
+      #endif
+      for (size_t d = 0; d < dims; ++d)
+      {
+        const double value = input(d, i);
+        if (value < threadMin(d, t))
+          threadMin(d, t) = value;
+        if (value > threadMax(d, t))
+          threadMax(d, t) = value;
+      }
+    }
+
+    itemMin = arma::min(threadMin, 1);
+    itemMax = arma::max(threadMax, 1);
     scale = itemMax - itemMin;
     // Handle zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -86,7 +117,8 @@ class MinMaxScaler
   }
 
   /**
-   * Function to scale features.
+   * Function to scale features.  The input and output matrices may be the
+   * same object; columns are processed in parallel.
    *
    * @param input Dataset to scale features.
    * @param output Output matrix with scaled features.
@@ -100,11 +132,42 @@ class MinMaxScaler
           " refer to the documentation.");
     }
     output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + scalerowmin;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    {
+      for (size_t d = 0; d < input.n_rows; ++d)
+        output(d, i) = input(d, i) * scale[d] + scalerowmin[d];
+    }
+  }
+
+  /**
+   * Function to scale features in place, without allocating a second
+   * matrix.
+   *
+   * @param inout Dataset to scale in place.
+   */
+  template<typename MatType>
+  void Transform(MatType& inout)
+  {
+    Transform(inout, inout);
   }
 
   /**
-   * Function to retrieve original dataset.
+   * Function to scale a single value of the given dimension.  This is the
+   * hook used by the fused load-scale path (LoadCSV::LoadNumericCSV()) to
+   * scale values as they are parsed.
+   *
+   * @param dimension Dimension of the value.
+   * @param value Value to scale.
+   */
+  double TransformElement(const size_t dimension, const double value) const
+  {
+    return value * scale[dimension] + scalerowmin[dimension];
+  }
+
+  /**
+   * Function to retrieve original dataset.  The input and output matrices
+   * may be the same object; columns are processed in parallel.
    *
    * @param input Scaled dataset.
    * @param output Output matrix with original Dataset.
@@ -113,7 +176,24 @@ class MinMaxScaler
   void InverseTransform(const MatType& input, MatType& output)
   {
     output.copy_size(input);
-    output = (input.each_col() - scalerowmin).each_col() / scale;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    {
+      for (size_t d = 0; d < input.n_rows; ++d)
+        output(d, i) = (input(d, i) - scalerowmin[d]) / scale[d];
+    }
+  }
+
+  /**
+   * Function to retrieve the original dataset in place, without allocating
+   * a second matrix.
+   *
+   * @param inout Scaled dataset to restore in place.
+   */
+  template<typename MatType>
+  void InverseTransform(MatType& inout)
+  {
+    InverseTransform(inout, inout);
   }
 
   //! Get the Min row vector.
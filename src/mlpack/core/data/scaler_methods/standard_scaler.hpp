@@ -48,22 +48,71 @@ class StandardScaler
 {
  public:
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the mean and standard deviation.
+   * The statistics are computed in one pass over the data with Welford's
+   * update, accumulated per thread and then merged, so the input is read
+   * only once.
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    const size_t dims = input.n_rows;
+    itemMean.zeros(dims);
+
+    size_t numThreads = 1;
+    #ifdef HAS_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+    #endif
+
+    // Per-thread running means and sums of squared deviations.
+    arma::mat threadMeans(dims, numThreads, arma::fill::zeros);
+    arma::mat threadM2(dims, numThreads, arma::fill::zeros);
+    arma::Col<size_t> threadCounts(numThreads, arma::fill::zeros);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    {
+      size_t t = 0;
+      #ifdef HAS_OPENMP
+      t = (size_t) omp_get_thread_num();
+      #endif
+      const double count = (double) ++threadCounts[t];
+      for (size_t d = 0; d < dims; ++d)
+      {
+        const double value = input(d, i);
+        const double delta = value - threadMeans(d, t);
+        threadMeans(d, t) += delta / count;
+        threadM2(d, t) += delta * (value - threadMeans(d, t));
+      }
+    }
+
+    // Merge the per-thread statistics (Chan et al.'s combination rule).
+    arma::vec m2(dims, arma::fill::zeros);
+    size_t count = 0;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      if (threadCounts[t] == 0)
+        continue;
+
+      const double na = (double) count;
+      const double nb = (double) threadCounts[t];
+      const arma::vec delta = threadMeans.col(t) - itemMean;
+      itemMean += delta * (nb / (na + nb));
+      m2 += threadM2.col(t) + (delta % delta) * (na * nb / (na + nb));
+      count += threadCounts[t];
+    }
+
+    itemStdDev = arma::sqrt(m2 / (double) std::max(count, (size_t) 1));
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
   }
 
   /**
-   * Function to scale features.
+   * Function to scale features.  The input and output matrices may be the
+   * same object; columns are processed in parallel.
    *
    * @param input Dataset to scale features.
    * @param output Output matrix with scaled features.
@@ -77,11 +126,42 @@ class StandardScaler
         " refer to the documentation.");
     }
     output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / itemStdDev;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    {
+      for (size_t d = 0; d < input.n_rows; ++d)
+        output(d, i) = (input(d, i) - itemMean[d]) / itemStdDev[d];
+    }
+  }
+
+  /**
+   * Function to scale features in place, without allocating a second
+   * matrix.
+   *
+   * @param inout Dataset to scale in place.
+   */
+  template<typename MatType>
+  void Transform(MatType& inout)
+  {
+    Transform(inout, inout);
   }
 
   /**
-   * Function to retrieve original dataset.
+   * Function to scale a single value of the given dimension.  This is the
+   * hook used by the fused load-scale path (LoadCSV::LoadNumericCSV()) to
+   * scale values as they are parsed.
+   *
+   * @param dimension Dimension of the value.
+   * @param value Value to scale.
+   */
+  double TransformElement(const size_t dimension, const double value) const
+  {
+    return (value - itemMean[dimension]) / itemStdDev[dimension];
+  }
+
+  /**
+   * Function to retrieve original dataset.  The input and output matrices
+   * may be the same object; columns are processed in parallel.
    *
    * @param input Scaled dataset.
    * @param output Output matrix with original Dataset.
@@ -90,7 +170,24 @@ class StandardScaler
   void InverseTransform(const MatType& input, MatType& output)
   {
     output.copy_size(input);
-    output = (input.each_col() % itemStdDev).each_col() + itemMean;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    {
+      for (size_t d = 0; d < input.n_rows; ++d)
+        output(d, i) = input(d, i) * itemStdDev[d] + itemMean[d];
+    }
+  }
+
+  /**
+   * Function to retrieve the original dataset in place, without allocating
+   * a second matrix.
+   *
+   * @param inout Scaled dataset to restore in place.
+   */
+  template<typename MatType>
+  void InverseTransform(MatType& inout)
+  {
+    InverseTransform(inout, inout);
   }
 
   //! Get the mean row vector.
@@ -14,10 +14,133 @@
 #define MLPACK_CORE_DATA_SPLIT_DATA_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace data {
 
+/**
+ * Rebind `out` as a strict non-owning alias of the given memory.  Armadillo's
+ * advanced constructor cannot rebind an already-constructed object, so the
+ * alias is constructed in place over it.
+ */
+template<typename T>
+void MakeColsAlias(arma::Mat<T>& out,
+                   T* mem,
+                   const size_t rows,
+                   const size_t cols)
+{
+  out.~Mat();
+  new (&out) arma::Mat<T>(mem, rows, cols, false, true);
+}
+
+//! Rebind `out` as a strict non-owning alias of the given memory.
+template<typename U>
+void MakeElemsAlias(arma::Row<U>& out, U* mem, const size_t elems)
+{
+  out.~Row();
+  new (&out) arma::Row<U>(mem, elems, false, true);
+}
+
+/**
+ * Given an input dataset, split into a training set and test set without
+ * copying the data.  If shuffleData is true, the columns of the input are
+ * shuffled in place (Fisher-Yates on columns); then non-owning strict aliases
+ * over the train and test column ranges are returned, in the style of
+ * math::MakeAlias().  If shuffleData is false, no data is moved at all.
+ *
+ * The returned matrices alias the input's memory: they are valid only as
+ * long as the input is alive and unmodified, and writing to them writes to
+ * the input.  Peak memory use is that of the input alone, which makes this
+ * the right overload for datasets that fill most of RAM.
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::mat trainData, testData;
+ * SplitInPlace(input, trainData, testData, 0.3);
+ * @endcode
+ *
+ * @param input Input dataset to split; shuffled in place if shuffleData.
+ * @param trainData Alias of the training columns of input.
+ * @param testData Alias of the test columns of input.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and
+ *     1).
+ * @param shuffleData If true, the columns of input are shuffled in place
+ *     before splitting. (Default true.)
+ */
+template<typename T>
+void SplitInPlace(arma::Mat<T>& input,
+                  arma::Mat<T>& trainData,
+                  arma::Mat<T>& testData,
+                  const double testRatio,
+                  const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
+  const size_t trainSize = input.n_cols - testSize;
+
+  if (shuffleData)
+  {
+    // In-place Fisher-Yates shuffle of the columns.
+    for (size_t i = input.n_cols - 1; i > 0; --i)
+      input.swap_cols(i, (arma::uword) math::RandInt(i + 1));
+  }
+
+  // Hand back non-owning strict aliases over the two column ranges.
+  MakeColsAlias(trainData, input.memptr(), input.n_rows, trainSize);
+  MakeColsAlias(testData, input.memptr() + trainSize * input.n_rows,
+      input.n_rows, testSize);
+}
+
+/**
+ * Given an input dataset and labels, split into a training set and test set
+ * without copying the data.  Works like the unlabeled SplitInPlace()
+ * overload, but the same in-place column permutation is applied to the
+ * labels, and aliases over the label ranges are returned as well.
+ *
+ * @param input Input dataset to split; shuffled in place if shuffleData.
+ * @param inputLabel Input labels to split; shuffled in place in lockstep.
+ * @param trainData Alias of the training columns of input.
+ * @param testData Alias of the test columns of input.
+ * @param trainLabel Alias of the training labels.
+ * @param testLabel Alias of the test labels.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and
+ *     1).
+ * @param shuffleData If true, the columns of input (and labels) are shuffled
+ *     in place before splitting. (Default true.)
+ */
+template<typename T, typename U>
+void SplitInPlace(arma::Mat<T>& input,
+                  arma::Row<U>& inputLabel,
+                  arma::Mat<T>& trainData,
+                  arma::Mat<T>& testData,
+                  arma::Row<U>& trainLabel,
+                  arma::Row<U>& testLabel,
+                  const double testRatio,
+                  const bool shuffleData = true)
+{
+  util::CheckSameSizes(input, inputLabel, "data::SplitInPlace()");
+
+  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
+  const size_t trainSize = input.n_cols - testSize;
+
+  if (shuffleData)
+  {
+    // Apply one in-place Fisher-Yates column permutation to both objects.
+    for (size_t i = input.n_cols - 1; i > 0; --i)
+    {
+      const arma::uword j = (arma::uword) math::RandInt(i + 1);
+      input.swap_cols(i, j);
+      inputLabel.swap_cols(i, j);
+    }
+  }
+
+  MakeColsAlias(trainData, input.memptr(), input.n_rows, trainSize);
+  MakeColsAlias(testData, input.memptr() + trainSize * input.n_rows,
+      input.n_rows, testSize);
+  MakeElemsAlias(trainLabel, inputLabel.memptr(), trainSize);
+  MakeElemsAlias(testLabel, inputLabel.memptr() + trainSize, testSize);
+}
+
 /**
  * This helper function splits any `input` data into training and testing parts.
  * In order to shuffle the input data before spliting, an array of shuffled
@@ -37,18 +160,19 @@ void SplitHelper(const InputType& input,
   train.set_size(input.n_rows, trainSize);
   test.set_size(input.n_rows, testSize);
 
-  // Shuffling and spliting simultaneously.
+  // Shuffling and spliting simultaneously, with the parallel gather shared
+  // with math::ShuffleData().
   if (!order.is_empty())
   {
     if (trainSize > 0)
     {
-      for (size_t i = 0; i < trainSize; ++i)
-        train.col(i) = input.col(order(i));
+      math::ApplyColumnPermutation(input, order.subvec(0, trainSize - 1),
+          train);
     }
     if (trainSize < input.n_cols)
     {
-      for (size_t i = trainSize; i < input.n_cols; ++i)
-        test.col(i - trainSize) = input.col(order(i));
+      math::ApplyColumnPermutation(input,
+          order.subvec(trainSize, input.n_cols - 1), test);
     }
   }
   // Spliting only.
@@ -105,55 +105,107 @@ EncodeHelper(const std::vector<std::string>& input,
              const TokenizerType& tokenizer,
              PolicyType& policy)
 {
-  size_t numColumns = 0;
+  using TokenType = typename std::remove_reference<
+      typename DictionaryType::TokenType>::type;
 
   policy.Reset();
 
-  // The first pass adds the extracted tokens to the dictionary.
-  for (size_t i = 0; i < input.size(); ++i)
-  {
-    STRING_VIEW strView(input[i]);
-    auto token = tokenizer(strView);
+  // Tokenization and dictionary construction run in parallel over contiguous
+  // document shards, each shard building a thread-local dictionary.  The
+  // token IDs of every document are retained, so the policy preprocessing and
+  // the final encoding pass never re-tokenize the corpus.
+  std::vector<std::vector<size_t>> tokenIds(input.size());
+
+#ifdef HAS_OPENMP
+  const size_t numShards = std::min((size_t) omp_get_max_threads(),
+      std::max<size_t>(input.size(), 1));
+#else
+  const size_t numShards = 1;
+#endif
+  const size_t shardSize = (input.size() + numShards - 1) / numShards;
 
-    static_assert(
-        std::is_same<typename std::remove_reference<decltype(token)>::type,
-                     typename std::remove_reference<typename DictionaryType::
-                        TokenType>::type>::value,
-        "The dictionary token type doesn't match the return value type "
-        "of the tokenizer.");
+  // Thread-local dictionaries, plus a log of the order in which each shard
+  // first saw its tokens (the maps themselves do not preserve that order).
+  std::vector<std::unordered_map<TokenType, size_t>> shardDicts(numShards);
+  std::vector<std::vector<TokenType>> shardLogs(numShards);
 
-    size_t numTokens = 0;
+  #pragma omp parallel for
+  for (omp_size_t shard = 0; shard < (omp_size_t) numShards; ++shard)
+  {
+    std::unordered_map<TokenType, size_t>& dict = shardDicts[shard];
+    std::vector<TokenType>& log = shardLogs[shard];
 
-    while (!tokenizer.IsTokenEmpty(token))
+    const size_t begin = shard * shardSize;
+    const size_t end = std::min(input.size(), begin + shardSize);
+    for (size_t i = begin; i < end; ++i)
     {
-      if (!dictionary.HasToken(token))
-        dictionary.AddToken(std::move(token));
-
-      policy.PreprocessToken(i, numTokens, dictionary.Value(token));
-
-      token = tokenizer(strView);
-      numTokens++;
+      STRING_VIEW strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       TokenType>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        auto it = dict.find(token);
+        if (it == dict.end())
+        {
+          const size_t localId = dict.size();
+          it = dict.emplace(token, localId).first;
+          log.push_back(token);
+        }
+
+        tokenIds[i].push_back(it->second);
+        token = tokenizer(strView);
+      }
     }
-
-    numColumns = std::max(numColumns, numTokens);
   }
 
-  policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
-
-  // The second pass writes the encoded values to the output.
-  for (size_t i = 0; i < input.size(); ++i)
+  // Merge the shard dictionaries into the main dictionary in shard order.  A
+  // token's first occurrence lies in the earliest shard that logged it, and
+  // each log preserves first-occurrence order within its shard, so the IDs
+  // assigned here are identical to those of a fully sequential pass.
+  std::vector<std::vector<size_t>> remaps(numShards);
+  for (size_t shard = 0; shard < numShards; ++shard)
   {
-    STRING_VIEW strView(input[i]);
-    auto token = tokenizer(strView);
-    size_t numTokens = 0;
-
-    while (!tokenizer.IsTokenEmpty(token))
+    remaps[shard].resize(shardLogs[shard].size());
+    for (size_t j = 0; j < shardLogs[shard].size(); ++j)
     {
-      policy.Encode(output, dictionary.Value(token), i, numTokens);
-      token = tokenizer(strView);
-      numTokens++;
+      TokenType& token = shardLogs[shard][j];
+      remaps[shard][j] = dictionary.HasToken(token) ?
+          dictionary.Value(token) : dictionary.AddToken(std::move(token));
     }
   }
+
+  // Translate shard-local token IDs to dictionary IDs.
+  size_t numColumns = 0;
+  #pragma omp parallel for reduction(max: numColumns)
+  for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+  {
+    const size_t shard = i / shardSize;
+    for (size_t j = 0; j < tokenIds[i].size(); ++j)
+      tokenIds[i][j] = remaps[shard][tokenIds[i][j]];
+
+    numColumns = std::max(numColumns, tokenIds[i].size());
+  }
+
+  // The policy accumulates its statistics sequentially, exactly as in a
+  // sequential encode, but from the stored IDs rather than a re-tokenize.
+  for (size_t i = 0; i < input.size(); ++i)
+    for (size_t j = 0; j < tokenIds[i].size(); ++j)
+      policy.PreprocessToken(i, j, tokenIds[i][j]);
+
+  policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
+
+  // The final pass writes the encoded values to the output; each document
+  // touches only its own row, so this parallelizes cleanly.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+    for (size_t j = 0; j < tokenIds[i].size(); ++j)
+      policy.Encode(output, tokenIds[i][j], i, j);
 }
 
 template<typename EncodingPolicyType, typename DictionaryType>
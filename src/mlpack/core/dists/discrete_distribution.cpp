@@ -21,33 +21,97 @@ using namespace mlpack::distribution;
  */
 arma::vec DiscreteDistribution::Random() const
 {
+  // Build the alias tables if the probabilities have changed since the last
+  // draw; this is O(n) once and makes every draw O(1).
+  if (aliasStale)
+    BuildAliasTables();
+
   size_t dimension = probabilities.size();
   arma::vec result(dimension);
 
   for (size_t d = 0; d < dimension; d++)
   {
-    // Generate a random number.
-    double randObs = math::Random();
+    // Pick a bin uniformly, then flip the (biased) coin for that bin: on
+    // success the bin itself is the outcome, otherwise its alias is.
+    const size_t bin = math::RandInt(0, probabilities[d].n_elem);
+
+    if (math::Random() < aliasProbabilities[d][bin])
+      result[d] = bin;
+    else
+      result[d] = aliasTables[d][bin];
+  }
+
+  return result;
+}
 
-    double sumProb = 0;
+/**
+ * Build the alias tables for each dimension using Vose's algorithm.
+ */
+void DiscreteDistribution::BuildAliasTables() const
+{
+  aliasTables.resize(probabilities.size());
+  aliasProbabilities.resize(probabilities.size());
 
-    for (size_t obs = 0; obs < probabilities[d].n_elem; obs++)
+  for (size_t d = 0; d < probabilities.size(); d++)
+  {
+    const size_t n = probabilities[d].n_elem;
+    aliasTables[d].set_size(n);
+    aliasProbabilities[d].set_size(n);
+    if (n == 0)
+      continue;
+
+    // Scale the probabilities so that they average to 1.
+    const double sum = accu(probabilities[d]);
+    arma::vec scaled = (sum > 0) ?
+        arma::vec(probabilities[d] * (n / sum)) :
+        arma::vec(n, arma::fill::ones);
+
+    // Partition the bins into those with less and more than average mass.
+    std::vector<size_t> small, large;
+    for (size_t i = 0; i < n; ++i)
     {
-      if ((sumProb += probabilities[d][obs]) >= randObs)
+      if (scaled[i] < 1.0)
+        small.push_back(i);
+      else
+        large.push_back(i);
+    }
+
+    // Pair each underfull bin with an overfull one; the overfull bin donates
+    // the missing mass and becomes the underfull bin's alias.
+    while (!small.empty() && !large.empty())
+    {
+      const size_t s = small.back();
+      small.pop_back();
+      const size_t l = large.back();
+
+      aliasProbabilities[d][s] = scaled[s];
+      aliasTables[d][s] = l;
+
+      scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+      if (scaled[l] < 1.0)
       {
-        result[d] = obs;
-        break;
+        large.pop_back();
+        small.push_back(l);
       }
     }
 
-    if (sumProb > 1.0)
+    // Any leftover bins (numerical leftovers of either sign) get probability
+    // one, so their alias is never used.
+    while (!large.empty())
     {
-      // This shouldn't happen.
-      result[d] = probabilities[d].n_elem - 1;
+      aliasProbabilities[d][large.back()] = 1.0;
+      aliasTables[d][large.back()] = large.back();
+      large.pop_back();
+    }
+    while (!small.empty())
+    {
+      aliasProbabilities[d][small.back()] = 1.0;
+      aliasTables[d][small.back()] = small.back();
+      small.pop_back();
     }
   }
 
-  return result;
+  aliasStale = false;
 }
 
 /**
@@ -101,6 +165,9 @@ void DiscreteDistribution::Train(const arma::mat& observations)
     else // Force normalization.
       probabilities[i].fill(1.0 / probabilities[i].n_elem);
   }
+
+  // The probabilities changed, so the sampling tables must be rebuilt.
+  aliasStale = true;
 }
 
 /**
@@ -157,4 +224,7 @@ void DiscreteDistribution::Train(const arma::mat& observations,
     else // Force normalization.
       probabilities[i].fill(1.0 / probabilities[i].n_elem);
   }
+
+  // The probabilities changed, so the sampling tables must be rebuilt.
+  aliasStale = true;
 }
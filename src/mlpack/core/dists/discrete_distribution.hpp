@@ -203,6 +203,11 @@ class DiscreteDistribution
    * observation) according to the probability distribution defined by this
    * object.
    *
+   * Sampling uses the alias method (Vose's algorithm): an O(n) table is built
+   * lazily the first time Random() is called after the probabilities change,
+   * and every subsequent draw costs O(1) instead of a linear scan of the
+   * probability vector.
+   *
    * @return Random observation.
    */
   arma::vec Random() const;
@@ -229,7 +234,13 @@ class DiscreteDistribution
              const arma::vec& probabilities);
 
   //! Return the vector of probabilities for the given dimension.
-  arma::vec& Probabilities(const size_t dim = 0) { return probabilities[dim]; }
+  arma::vec& Probabilities(const size_t dim = 0)
+  {
+    // The probabilities may be modified through the returned reference, so
+    // the sampling tables have to be rebuilt before the next draw.
+    aliasStale = true;
+    return probabilities[dim];
+  }
   //! Modify the vector of probabilities for the given dimension.
   const arma::vec& Probabilities(const size_t dim = 0) const
   { return probabilities[dim]; }
@@ -241,12 +252,30 @@ class DiscreteDistribution
   void serialize(Archive& ar, const uint32_t /* version */)
   {
     ar(CEREAL_NVP(probabilities));
+
+    // The sampling tables are not serialized; rebuild them on the next draw.
+    if (cereal::is_loading<Archive>())
+      aliasStale = true;
   }
 
  private:
+  /**
+   * Build the alias tables for each dimension using Vose's algorithm, so that
+   * Random() can sample in O(1) per draw.
+   */
+  void BuildAliasTables() const;
+
   //! The probabilities for each dimension; each arma::vec represents the
   //! probabilities for the observations in each dimension.
   std::vector<arma::vec> probabilities;
+
+  //! Alias table for each dimension; aliasTables[d][i] holds the alternative
+  //! outcome drawn when the coin flip against aliasProbabilities[d][i] fails.
+  mutable std::vector<arma::Col<size_t>> aliasTables;
+  //! Acceptance probability for each alias table entry.
+  mutable std::vector<arma::vec> aliasProbabilities;
+  //! Whether the alias tables need rebuilding before the next draw.
+  mutable bool aliasStale = true;
 };
 
 } // namespace distribution
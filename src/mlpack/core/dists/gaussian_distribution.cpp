@@ -70,10 +70,12 @@ void GaussianDistribution::FactorCovariance()
 
 double GaussianDistribution::LogProbability(const arma::vec& observation) const
 {
+  // As in the batch overload, the quadratic form is computed with one
+  // triangular solve against the Cholesky factor.
   const size_t k = observation.n_elem;
-  const arma::vec diff = mean - observation;
-  const arma::vec v = (diff.t() * invCov * diff);
-  return -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * v(0);
+  const arma::vec z = arma::solve(arma::trimatl(covLower),
+      observation - mean);
+  return -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * arma::dot(z, z);
 }
 
 arma::vec GaussianDistribution::Random() const
@@ -0,0 +1,261 @@
+/**
+ * @file core/dists/sparse_discrete_distribution.cpp
+ *
+ * Implementation of the sparse discrete distribution.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "sparse_discrete_distribution.hpp"
+
+#include <algorithm>
+
+using namespace mlpack;
+using namespace mlpack::distribution;
+
+SparseDiscreteDistribution::SparseDiscreteDistribution(
+    const arma::Col<size_t>& numObservations,
+    const size_t maxSymbols) :
+    maxSymbols(maxSymbols),
+    smoothing(1e-8)
+{
+  for (size_t i = 0; i < numObservations.n_elem; ++i)
+  {
+    const size_t numObs = size_t(numObservations[i]);
+    if (numObs <= 0)
+    {
+      std::ostringstream oss;
+      oss << "number of observations for dimension " << i << " is 0, but "
+          << "must be greater than 0";
+      throw std::invalid_argument(oss.str());
+    }
+    this->numObservations.push_back(numObs);
+    storedProbabilities.emplace_back();
+    tailProbabilities.push_back(1.0 / numObs);
+  }
+}
+
+SparseDiscreteDistribution::SparseDiscreteDistribution(
+    const std::vector<arma::vec>& probabilities) :
+    maxSymbols(0),
+    smoothing(1e-8)
+{
+  // The nonzero entries are treated as weighted counts; Estimate() takes
+  // care of the normalization and of reserving the smoothing mass for the
+  // zero entries.
+  std::vector<std::unordered_map<size_t, double>> counts(probabilities.size());
+  for (size_t i = 0; i < probabilities.size(); ++i)
+  {
+    numObservations.push_back(probabilities[i].n_elem);
+    storedProbabilities.emplace_back();
+    tailProbabilities.push_back(0.0);
+
+    for (size_t obs = 0; obs < probabilities[i].n_elem; ++obs)
+      if (probabilities[i][obs] > 0)
+        counts[i][obs] = probabilities[i][obs];
+  }
+
+  Estimate(counts);
+}
+
+double SparseDiscreteDistribution::Probability(
+    const arma::vec& observation) const
+{
+  double probability = 1.0;
+  // Ensure the observation has the same dimension as the distribution.
+  if (observation.n_elem != storedProbabilities.size())
+  {
+    Log::Fatal << "SparseDiscreteDistribution::Probability(): observation has "
+        << "incorrect dimension " << observation.n_elem << " but should have"
+        << " dimension " << storedProbabilities.size() << "!" << std::endl;
+  }
+
+  for (size_t dimension = 0; dimension < observation.n_elem; dimension++)
+  {
+    // Adding 0.5 helps ensure that we cast the floating point to a size_t
+    // correctly.
+    const size_t obs = size_t(observation(dimension) + 0.5);
+
+    // Ensure that the observation is within the bounds.
+    if (obs >= numObservations[dimension])
+    {
+      Log::Fatal << "SparseDiscreteDistribution::Probability(): received "
+          << "observation " << obs << "; observation must be in [0, "
+          << numObservations[dimension] << "] for this distribution."
+          << std::endl;
+    }
+
+    const std::unordered_map<size_t, double>& stored =
+        storedProbabilities[dimension];
+    const std::unordered_map<size_t, double>::const_iterator it =
+        stored.find(obs);
+    probability *= (it != stored.end()) ? it->second
+                                        : tailProbabilities[dimension];
+  }
+
+  return probability;
+}
+
+arma::vec SparseDiscreteDistribution::Random() const
+{
+  arma::vec result(storedProbabilities.size());
+
+  for (size_t d = 0; d < storedProbabilities.size(); ++d)
+  {
+    const std::unordered_map<size_t, double>& stored = storedProbabilities[d];
+    const size_t numObs = numObservations[d];
+    double randObs = math::Random();
+
+    // Walk the stored symbols first; each one carries its own probability.
+    bool found = false;
+    for (std::unordered_map<size_t, double>::const_iterator it =
+         stored.begin(); it != stored.end(); ++it)
+    {
+      if (randObs < it->second)
+      {
+        result[d] = it->first;
+        found = true;
+        break;
+      }
+      randObs -= it->second;
+    }
+    if (found)
+      continue;
+
+    // The draw fell into the tail, which is uniform over the unstored
+    // symbols.  When the stored symbols are a small fraction of the
+    // vocabulary (the intended use), rejection sampling terminates almost
+    // immediately; otherwise the tail symbol is located by counting.
+    if (stored.size() < numObs / 2)
+    {
+      size_t obs;
+      do
+      {
+        obs = math::RandInt(0, numObs);
+      } while (stored.count(obs) > 0);
+      result[d] = obs;
+    }
+    else
+    {
+      size_t remaining = math::RandInt(0, numObs - stored.size());
+      result[d] = numObs - 1; // Fallback for rounding issues.
+      for (size_t obs = 0; obs < numObs; ++obs)
+      {
+        if (stored.count(obs) > 0)
+          continue;
+        if (remaining == 0)
+        {
+          result[d] = obs;
+          break;
+        }
+        --remaining;
+      }
+    }
+  }
+
+  return result;
+}
+
+void SparseDiscreteDistribution::Train(const arma::mat& observations)
+{
+  Train(observations, arma::ones<arma::vec>(observations.n_cols));
+}
+
+void SparseDiscreteDistribution::Train(const arma::mat& observations,
+                                       const arma::vec& probabilities)
+{
+  // Make sure the observations have the same dimension as the distribution.
+  if (observations.n_rows != storedProbabilities.size())
+  {
+    Log::Fatal << "SparseDiscreteDistribution::Train(): observation "
+        << "dimension " << observations.n_rows << " does not match "
+        << "distribution dimension " << storedProbabilities.size() << "!"
+        << std::endl;
+  }
+
+  // Accumulate the weighted counts of the observed symbols only.
+  std::vector<std::unordered_map<size_t, double>> counts(
+      storedProbabilities.size());
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    for (size_t d = 0; d < observations.n_rows; ++d)
+    {
+      // Adding 0.5 helps ensure that we cast the floating point to a size_t
+      // correctly.
+      const size_t obs = size_t(observations(d, i) + 0.5);
+      if (obs >= numObservations[d])
+      {
+        Log::Fatal << "SparseDiscreteDistribution::Train(): received "
+            << "observation " << obs << "; observation must be in [0, "
+            << numObservations[d] << "] for this distribution." << std::endl;
+      }
+      counts[d][obs] += probabilities[i];
+    }
+  }
+
+  Estimate(counts);
+}
+
+void SparseDiscreteDistribution::Estimate(
+    std::vector<std::unordered_map<size_t, double>>& counts)
+{
+  for (size_t d = 0; d < storedProbabilities.size(); ++d)
+  {
+    std::unordered_map<size_t, double>& stored = storedProbabilities[d];
+    const size_t numObs = numObservations[d];
+    stored.clear();
+
+    double total = 0;
+    for (std::unordered_map<size_t, double>::const_iterator it =
+         counts[d].begin(); it != counts[d].end(); ++it)
+      total += it->second;
+
+    // No mass at all: fall back to the uniform distribution, represented
+    // entirely by the tail.
+    if (total <= 0)
+    {
+      tailProbabilities[d] = 1.0 / numObs;
+      continue;
+    }
+
+    // Cap the stored symbols to the heaviest maxSymbols; the mass of the
+    // dropped symbols joins the smoothed tail.
+    std::vector<std::pair<size_t, double>> kept(counts[d].begin(),
+                                                counts[d].end());
+    if (maxSymbols > 0 && kept.size() > maxSymbols)
+    {
+      std::nth_element(kept.begin(), kept.begin() + maxSymbols - 1,
+          kept.end(),
+          [](const std::pair<size_t, double>& a,
+             const std::pair<size_t, double>& b)
+          { return a.second > b.second; });
+      kept.resize(maxSymbols);
+    }
+
+    double keptMass = 0;
+    for (size_t i = 0; i < kept.size(); ++i)
+      keptMass += kept[i].second / total;
+
+    const size_t tailCount = numObs - kept.size();
+    if (tailCount == 0)
+    {
+      // Every symbol is stored; no tail to smooth.
+      for (size_t i = 0; i < kept.size(); ++i)
+        stored[kept[i].first] = kept[i].second / total;
+      tailProbabilities[d] = 0.0;
+    }
+    else
+    {
+      // The tail receives the mass of the dropped symbols, but never less
+      // than the smoothing mass, so unseen symbols keep a nonzero
+      // probability.
+      const double tailMass = std::max(1.0 - keptMass, smoothing);
+      for (size_t i = 0; i < kept.size(); ++i)
+        stored[kept[i].first] = (kept[i].second / total) *
+            (1.0 - tailMass) / keptMass;
+      tailProbabilities[d] = tailMass / tailCount;
+    }
+  }
+}
@@ -0,0 +1,259 @@
+/**
+ * @file core/dists/sparse_discrete_distribution.hpp
+ *
+ * Implementation of the sparse discrete distribution, which only stores the
+ * probabilities of observed (or top-k) symbols and smooths the remaining
+ * probability mass over the unstored tail.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTIONS_SPARSE_DISCRETE_DISTRIBUTION_HPP
+#define MLPACK_CORE_DISTRIBUTIONS_SPARSE_DISCRETE_DISTRIBUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include <unordered_map>
+
+namespace mlpack {
+namespace distribution /** Probability distributions. */ {
+
+/**
+ * A discrete distribution over a very large number of possible observations,
+ * of which only a few ever occur.  Instead of a dense probability vector per
+ * dimension (as DiscreteDistribution keeps), only the probabilities of the
+ * stored symbols are held in a hash table, and every unstored symbol shares
+ * the remaining probability mass uniformly.  This makes the distribution
+ * usable as the EmissionDistribution of an HMM over vocabularies with
+ * millions of symbols, where a dense vector per state is infeasible.
+ *
+ * Training only touches the observed symbols, and the number of stored
+ * symbols per dimension can be capped (top-k by probability mass); the mass
+ * of the dropped symbols joins the smoothed tail.  A configurable smoothing
+ * mass guarantees that unseen symbols keep a nonzero probability, so
+ * likelihood computations do not collapse to zero on new data.
+ *
+ * As with DiscreteDistribution, observations are passed as arma::vec and
+ * converted back to size_t internally.
+ */
+class SparseDiscreteDistribution
+{
+ public:
+  /**
+   * Default constructor, which creates a distribution over a single possible
+   * observation.
+   */
+  SparseDiscreteDistribution() :
+      numObservations(1, 1),
+      maxSymbols(0),
+      smoothing(1e-8),
+      storedProbabilities(1),
+      tailProbabilities(1, 1.0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Define the sparse discrete distribution as having numObservations
+   * possible observations, uniformly distributed.  No per-symbol storage is
+   * allocated: the uniform distribution is represented entirely by the tail.
+   *
+   * @param numObservations Number of possible observations this distribution
+   *    can have.
+   * @param maxSymbols Maximum number of symbols to store per dimension after
+   *    training (0 means no limit; every observed symbol is stored).
+   */
+  SparseDiscreteDistribution(const size_t numObservations,
+                             const size_t maxSymbols = 0) :
+      numObservations(1, numObservations),
+      maxSymbols(maxSymbols),
+      smoothing(1e-8),
+      storedProbabilities(1),
+      tailProbabilities(1, 1.0 / numObservations)
+  {
+    if (numObservations == 0)
+    {
+      throw std::invalid_argument("number of observations is 0, but must be "
+          "greater than 0");
+    }
+  }
+
+  /**
+   * Define the multidimensional sparse discrete distribution as having the
+   * given number of possible observations in each dimension, uniformly
+   * distributed.
+   *
+   * @param numObservations Number of possible observations, per dimension.
+   * @param maxSymbols Maximum number of symbols to store per dimension after
+   *    training (0 means no limit; every observed symbol is stored).
+   */
+  SparseDiscreteDistribution(const arma::Col<size_t>& numObservations,
+                             const size_t maxSymbols = 0);
+
+  /**
+   * Define the multidimensional sparse discrete distribution as having the
+   * given probabilities for each observation; only the nonzero entries are
+   * stored.  This mirrors the dense DiscreteDistribution constructor and is
+   * mostly useful for setting known parameters.
+   *
+   * @param probabilities Probabilities of each possible observation.
+   */
+  SparseDiscreteDistribution(const std::vector<arma::vec>& probabilities);
+
+  /**
+   * Get the dimensionality of the distribution.
+   */
+  size_t Dimensionality() const { return storedProbabilities.size(); }
+
+  /**
+   * Return the probability of the given observation.  A stored symbol costs
+   * one hash lookup per dimension; any other symbol gets the tail
+   * probability.
+   *
+   * @param observation Observation to return the probability of.
+   * @return Probability of the given observation.
+   */
+  double Probability(const arma::vec& observation) const;
+
+  /**
+   * Return the log probability of the given observation.
+   *
+   * @param observation Observation to return the log probability of.
+   * @return Log probability of the given observation.
+   */
+  double LogProbability(const arma::vec& observation) const
+  {
+    return log(Probability(observation));
+  }
+
+  /**
+   * Calculates the probability of each data point (column) in the given
+   * matrix.
+   *
+   * @param x List of observations.
+   * @param probabilities Output probabilities for each input observation.
+   */
+  void Probability(const arma::mat& x, arma::vec& probabilities) const
+  {
+    probabilities.set_size(x.n_cols);
+    for (size_t i = 0; i < x.n_cols; ++i)
+      probabilities(i) = Probability(x.unsafe_col(i));
+  }
+
+  /**
+   * Returns the log probability of each data point (column) in the given
+   * matrix.
+   *
+   * @param x List of observations.
+   * @param logProbabilities Output log-probabilities for each input
+   *   observation.
+   */
+  void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
+  {
+    logProbabilities.set_size(x.n_cols);
+    for (size_t i = 0; i < x.n_cols; ++i)
+      logProbabilities(i) = log(Probability(x.unsafe_col(i)));
+  }
+
+  /**
+   * Return a randomly generated observation (one observation) according to
+   * the probability distribution defined by this object.  A draw costs time
+   * proportional to the number of stored symbols, not to the number of
+   * possible observations.
+   *
+   * @return Random observation.
+   */
+  arma::vec Random() const;
+
+  /**
+   * Estimate the probability distribution directly from the given
+   * observations.  Only the observed symbols are touched, so training cost
+   * is proportional to the number of distinct observed symbols rather than
+   * to the number of possible observations.
+   *
+   * @param observations List of observations.
+   */
+  void Train(const arma::mat& observations);
+
+  /**
+   * Estimate the probability distribution from the given observations, taking
+   * into account the probability of each observation actually being from this
+   * distribution.
+   *
+   * @param observations List of observations.
+   * @param probabilities List of probabilities that each observation is
+   *     actually from this distribution.
+   */
+  void Train(const arma::mat& observations,
+             const arma::vec& probabilities);
+
+  //! Return the number of possible observations for the given dimension.
+  size_t NumObservations(const size_t dim = 0) const
+  { return numObservations[dim]; }
+
+  //! Return the maximum number of stored symbols per dimension (0 = no
+  //! limit).
+  size_t MaxSymbols() const { return maxSymbols; }
+  //! Modify the maximum number of stored symbols per dimension (0 = no
+  //! limit).  Takes effect on the next call to Train().
+  size_t& MaxSymbols() { return maxSymbols; }
+
+  //! Return the probability mass reserved for the unstored tail.
+  double Smoothing() const { return smoothing; }
+  //! Modify the probability mass reserved for the unstored tail.  Takes
+  //! effect on the next call to Train().
+  double& Smoothing() { return smoothing; }
+
+  //! Return the stored symbol probabilities for the given dimension.
+  const std::unordered_map<size_t, double>& StoredProbabilities(
+      const size_t dim = 0) const { return storedProbabilities[dim]; }
+
+  //! Return the probability of each unstored symbol for the given dimension.
+  double TailProbability(const size_t dim = 0) const
+  { return tailProbabilities[dim]; }
+
+  /**
+   * Serialize the distribution.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numObservations));
+    ar(CEREAL_NVP(maxSymbols));
+    ar(CEREAL_NVP(smoothing));
+    ar(CEREAL_NVP(storedProbabilities));
+    ar(CEREAL_NVP(tailProbabilities));
+  }
+
+ private:
+  /**
+   * Turn per-dimension weighted symbol counts into the stored top-k
+   * probabilities and the smoothed tail.
+   *
+   * @param counts Weighted counts of the observed symbols, per dimension.
+   */
+  void Estimate(std::vector<std::unordered_map<size_t, double>>& counts);
+
+  //! The number of possible observations, per dimension.
+  std::vector<size_t> numObservations;
+
+  //! Maximum number of stored symbols per dimension (0 = no limit).
+  size_t maxSymbols;
+
+  //! Probability mass reserved for the unstored tail, so that unseen symbols
+  //! keep a nonzero probability.
+  double smoothing;
+
+  //! The stored symbol probabilities, per dimension.
+  std::vector<std::unordered_map<size_t, double>> storedProbabilities;
+
+  //! The probability of each unstored symbol, per dimension.
+  std::vector<double> tailProbabilities;
+};
+
+} // namespace distribution
+} // namespace mlpack
+
+#endif
@@ -65,6 +65,14 @@ class CVFunction
              const double minDelta,
              const BoundArgs&... args);
 
+  /**
+   * Copy another CVFunction object.  The copy gets its own copy of the
+   * cross-validation object and fresh best-model tracking, so copies may be
+   * used concurrently from different threads (as the parallel search
+   * strategies do).
+   */
+  CVFunction(const CVFunction& other);
+
   /**
    * Run cross-validation with the bound and passed parameters.
    *
@@ -86,6 +94,15 @@ class CVFunction
   //! Access and modify the best model so far.
   MLAlgorithm& BestModel() { return bestModel; }
 
+  //! Get whether evaluations are memoized by parameter values.
+  bool CacheEvaluations() const { return cacheEvaluations; }
+  //! Modify whether evaluations are memoized by parameter values.  Since
+  //! every non-fixed parameter is a training argument, the parameter vector
+  //! fully determines the trained model, so repeated evaluations of the same
+  //! configuration (gradient baselines, duplicate random-search samples) can
+  //! reuse the previous objective instead of retraining.
+  bool& CacheEvaluations() { return cacheEvaluations; }
+
  private:
   //! The type of tuples of BoundArgs.
   using BoundArgsTupleType = std::tuple<BoundArgs...>;
@@ -104,6 +121,10 @@ class CVFunction
            bool BoundArgsIndexInRange = (BoundArgIndex < BoundArgsAmount)>
   struct UseBoundArg;
 
+  //! An owned copy of a cross-validation object (set by the copy
+  //! constructor; empty when this object references an external one).
+  std::unique_ptr<CVType> ownedCv;
+
   //! A reference to the cross-validation object.
   CVType& cv;
 
@@ -125,6 +146,12 @@ class CVFunction
   //! Minimum absolute increase of arguments for calculation of gradient.
   double minDelta;
 
+  //! Whether to memoize evaluations by parameter values.
+  bool cacheEvaluations;
+
+  //! Memoized objective values, keyed on the parameter values.
+  std::map<std::vector<double>, double> cache;
+
   /**
    * Collect all arguments and run cross-validation.
    */
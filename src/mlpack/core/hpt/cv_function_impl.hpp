@@ -55,9 +55,27 @@ CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::CVFunction(
     boundArgs(args...),
     bestObjective(std::numeric_limits<double>::max()),
     relativeDelta(relativeDelta),
-    minDelta(minDelta)
+    minDelta(minDelta),
+    cacheEvaluations(false)
 { /* Nothing left to do. */ }
 
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::CVFunction(
+    const CVFunction& other) :
+    ownedCv(new CVType(other.cv)),
+    cv(*ownedCv),
+    datasetInfo(other.datasetInfo),
+    boundArgs(other.boundArgs),
+    bestObjective(std::numeric_limits<double>::max()),
+    relativeDelta(other.relativeDelta),
+    minDelta(other.minDelta),
+    cacheEvaluations(other.cacheEvaluations),
+    cache(other.cache)
+{ /* The copy starts with fresh best-model tracking. */ }
+
 template<typename CVType,
          typename MLAlgorithm,
          size_t TotalArgs,
@@ -65,6 +83,19 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
+  if (cacheEvaluations)
+  {
+    const std::vector<double> key(parameters.begin(), parameters.end());
+    const typename std::map<std::vector<double>, double>::const_iterator it =
+        cache.find(key);
+    if (it != cache.end())
+      return it->second;
+
+    const double objective = Evaluate<0, 0>(parameters);
+    cache[key] = objective;
+    return objective;
+  }
+
   return Evaluate<0, 0>(parameters);
 }
 
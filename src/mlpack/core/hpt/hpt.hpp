@@ -14,6 +14,7 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/hpt/deduce_hp_types.hpp>
+#include <mlpack/core/hpt/parallel_search.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -131,6 +132,22 @@ class HyperParameterTuner
    */
   double& RelativeDelta() { return relativeDelta; }
 
+  /**
+   * Get whether cross-validation results are memoized by configuration, so
+   * that evaluating the same set of hyper-parameter values twice (as
+   * gradient-based optimization and random search may do) reuses the
+   * previous result instead of retraining.  The default value is false.
+   */
+  bool CacheEvaluations() const { return cacheEvaluations; }
+
+  /**
+   * Modify whether cross-validation results are memoized by configuration
+   * (see the documentation for the corresponding getter).  Enable this only
+   * when retraining with identical hyper-parameters is deterministic enough
+   * for its score to be reused.
+   */
+  bool& CacheEvaluations() { return cacheEvaluations; }
+
   /**
    * Get minimum increase of arguments for calculation of partial derivatives
    * (by the definition) in gradient-based optimization. This value is going to
@@ -230,6 +247,9 @@ class HyperParameterTuner
    */
   double minDelta;
 
+  //! Whether to memoize cross-validation results by configuration.
+  bool cacheEvaluations;
+
   /**
    * A type function to check whether the element I of the tuple type is a
    * PreFixedArg.
@@ -0,0 +1,128 @@
+/**
+ * @file core/hpt/parallel_search.hpp
+ *
+ * Parallel grid search and random search strategies for hyper-parameter
+ * tuning.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_SEARCH_HPP
+#define MLPACK_CORE_HPT_PARALLEL_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include <atomic>
+#include <chrono>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * ParallelGridSearch is a drop-in replacement for ens::GridSearch as the
+ * OptimizerType of HyperParameterTuner.  It evaluates the same grid of
+ * configurations, but distributes them over an OpenMP thread team: each
+ * thread works on its own copy of the passed function (and therefore, for
+ * CVFunction, on its own copy of the cross-validation object), so candidate
+ * evaluations are completely independent and the whole machine is used.
+ *
+ * @code
+ * HyperParameterTuner<LinearRegression, MSE, SimpleCV, ParallelGridSearch>
+ *     hpt(validationSize, data, responses);
+ * std::tie(bestLambda) = hpt.Optimize(lambdas);
+ * @endcode
+ *
+ * All hyper-parameters to optimize should be passed as collections of
+ * values; starting values for gradient-based optimization are not supported.
+ */
+class ParallelGridSearch
+{
+ public:
+  /**
+   * Evaluate every configuration of the grid and store the best one.
+   *
+   * @param function The function to optimize; it should be copy
+   *     constructible, and expose BestModel() (CVFunction does both).
+   * @param bestParameters Matrix to store the best configuration into.
+   * @param categoricalDimensions Whether each dimension is categorical.
+   * @param numCategories Number of values in each categorical dimension.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  std::vector<bool>& categoricalDimensions,
+                  arma::Row<size_t>& numCategories);
+};
+
+/**
+ * RandomSearch samples configurations of the grid uniformly at random
+ * instead of sweeping all of them, and evaluates the samples over an OpenMP
+ * thread team the same way ParallelGridSearch does.  The search stops after
+ * MaxTrials() evaluations, or earlier once the wall-clock TimeBudget() is
+ * spent; this bounds the cost of sweeps whose full grid is too large to
+ * enumerate.
+ *
+ * @code
+ * HyperParameterTuner<LinearSVM<>, Accuracy, SimpleCV, RandomSearch>
+ *     hpt(validationSize, data, labels, numClasses);
+ * // Try up to 200 configurations within a budget of one hour.
+ * hpt.Optimizer() = RandomSearch(200, 3600.0);
+ * @endcode
+ */
+class RandomSearch
+{
+ public:
+  /**
+   * Construct a random search strategy.
+   *
+   * @param maxTrials Maximum number of configurations to evaluate.
+   * @param timeBudget Wall-clock budget in seconds (0 means no budget).
+   */
+  RandomSearch(const size_t maxTrials = 100, const double timeBudget = 0.0) :
+      maxTrials(maxTrials), timeBudget(timeBudget)
+  { /* Nothing left to do. */ }
+
+  //! Get the maximum number of configurations to evaluate.
+  size_t MaxTrials() const { return maxTrials; }
+  //! Modify the maximum number of configurations to evaluate.
+  size_t& MaxTrials() { return maxTrials; }
+
+  //! Get the wall-clock budget in seconds (0 means no budget).
+  double TimeBudget() const { return timeBudget; }
+  //! Modify the wall-clock budget in seconds.
+  double& TimeBudget() { return timeBudget; }
+
+  /**
+   * Evaluate randomly sampled configurations until the trial or wall-clock
+   * budget is spent, and store the best one.
+   *
+   * @param function The function to optimize; it should be copy
+   *     constructible, and expose BestModel() (CVFunction does both).
+   * @param bestParameters Matrix to store the best configuration into.
+   * @param categoricalDimensions Whether each dimension is categorical.
+   * @param numCategories Number of values in each categorical dimension.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  std::vector<bool>& categoricalDimensions,
+                  arma::Row<size_t>& numCategories);
+
+ private:
+  //! Maximum number of configurations to evaluate.
+  size_t maxTrials;
+
+  //! Wall-clock budget in seconds (0 means no budget).
+  double timeBudget;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_search_impl.hpp"
+
+#endif
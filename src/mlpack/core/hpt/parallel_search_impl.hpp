@@ -0,0 +1,152 @@
+/**
+ * @file core/hpt/parallel_search_impl.hpp
+ *
+ * Implementation of the parallel grid search and random search strategies.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_SEARCH_IMPL_HPP
+#define MLPACK_CORE_HPT_PARALLEL_SEARCH_IMPL_HPP
+
+#include "parallel_search.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+template<typename FunctionType>
+double ParallelGridSearch::Optimize(FunctionType& function,
+                                    arma::mat& bestParameters,
+                                    std::vector<bool>& categoricalDimensions,
+                                    arma::Row<size_t>& numCategories)
+{
+  size_t totalConfigurations = 1;
+  for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+  {
+    if (!categoricalDimensions[d])
+      throw std::invalid_argument("ParallelGridSearch::Optimize(): all "
+          "hyper-parameters should be passed as collections of values");
+    totalConfigurations *= numCategories[d];
+  }
+
+  double bestObjective = std::numeric_limits<double>::max();
+
+  #pragma omp parallel
+  {
+    // Each thread works on its own copy of the function, so evaluations
+    // don't share any cross-validation state.
+    FunctionType localFunction(function);
+    double localBest = std::numeric_limits<double>::max();
+    arma::mat localBestParameters;
+    arma::mat parameters(categoricalDimensions.size(), 1);
+
+    #pragma omp for schedule(dynamic) nowait
+    for (omp_size_t t = 0; t < (omp_size_t) totalConfigurations; ++t)
+    {
+      // Decode the flat configuration index into one value index per
+      // dimension (mixed-radix decomposition).
+      size_t remainder = (size_t) t;
+      for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+      {
+        parameters(d) = (double) (remainder % numCategories[d]);
+        remainder /= numCategories[d];
+      }
+
+      const double objective = localFunction.Evaluate(parameters);
+      if (objective < localBest)
+      {
+        localBest = objective;
+        localBestParameters = parameters;
+      }
+    }
+
+    // localFunction tracks the model corresponding to localBest, so the
+    // winning thread can hand its model back to the caller's function.
+    #pragma omp critical (ParallelSearchMerge)
+    {
+      if (localBest < bestObjective)
+      {
+        bestObjective = localBest;
+        bestParameters = localBestParameters;
+        function.BestModel() = std::move(localFunction.BestModel());
+      }
+    }
+  }
+
+  return bestObjective;
+}
+
+template<typename FunctionType>
+double RandomSearch::Optimize(FunctionType& function,
+                              arma::mat& bestParameters,
+                              std::vector<bool>& categoricalDimensions,
+                              arma::Row<size_t>& numCategories)
+{
+  for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+  {
+    if (!categoricalDimensions[d])
+      throw std::invalid_argument("RandomSearch::Optimize(): all "
+          "hyper-parameters should be passed as collections of values");
+  }
+
+  double bestObjective = std::numeric_limits<double>::max();
+
+  std::atomic<size_t> trialCounter(0);
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  #pragma omp parallel
+  {
+    // Each thread works on its own copy of the function, so evaluations
+    // don't share any cross-validation state.
+    FunctionType localFunction(function);
+    double localBest = std::numeric_limits<double>::max();
+    arma::mat localBestParameters;
+    arma::mat parameters(categoricalDimensions.size(), 1);
+
+    while (true)
+    {
+      // Claim the next trial; stop once the trial or wall-clock budget is
+      // spent.
+      const size_t trial = trialCounter++;
+      if (trial >= maxTrials)
+        break;
+      if (timeBudget > 0.0)
+      {
+        const double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= timeBudget)
+          break;
+      }
+
+      for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+        parameters(d) = (double) math::RandInt(0, (int) numCategories[d]);
+
+      const double objective = localFunction.Evaluate(parameters);
+      if (objective < localBest)
+      {
+        localBest = objective;
+        localBestParameters = parameters;
+      }
+    }
+
+    #pragma omp critical (ParallelSearchMerge)
+    {
+      if (localBest < bestObjective)
+      {
+        bestObjective = localBest;
+        bestParameters = localBestParameters;
+        function.BestModel() = std::move(localFunction.BestModel());
+      }
+    }
+  }
+
+  return bestObjective;
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
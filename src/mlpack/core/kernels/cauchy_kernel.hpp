@@ -68,6 +68,30 @@ class CauchyKernel
         std::pow(metric::EuclideanDistance::Evaluate(a, b) / bandwidth, 2)));
   }
 
+  /**
+   * Batch evaluation of the Cauchy kernel for two blocks of points, using
+   * one matrix product plus rank-one corrections for all pairwise squared
+   * distances.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store kernel values into; entry (i, j) is set
+   *     to K(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  void Evaluate(const MatTypeA& queries,
+                const MatTypeB& references,
+                arma::mat& results) const
+  {
+    results = arma::trans(queries) * references;
+    results *= -2.0;
+    results.each_col() += arma::trans(arma::sum(arma::square(queries), 0));
+    results.each_row() += arma::sum(arma::square(references), 0);
+
+    results = 1.0 / (1.0 + arma::clamp(results, 0.0, arma::datum::inf) /
+        (bandwidth * bandwidth));
+  }
+
   /**
    * Serialize the kernel.
    */
@@ -89,6 +113,10 @@ class KernelTraits<CauchyKernel>
  public:
   //! The Cauchy kernel is normalized: K(x, x) = 1 for all x.
   static const bool IsNormalized = true;
+  //! The Cauchy kernel is not a dot-product kernel.
+  static const bool IsDotProduct = false;
+  //! The Cauchy kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
 };
 
 } // namespace kernel
@@ -41,6 +41,22 @@ class CosineDistance
   template<typename VecTypeA, typename VecTypeB>
   static double Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Batch computation of the cosine distance between two blocks of points;
+   * all dot products come from one matrix product, which is then normalized
+   * row- and column-wise.  Pairs involving a zero vector evaluate to 0, as
+   * in the pairwise overload.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store distances into; entry (i, j) is set to
+   *     d(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(const MatTypeA& queries,
+                       const MatTypeB& references,
+                       arma::mat& results);
+
   //! Serialize the class (there's nothing to save).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -56,6 +72,10 @@ class KernelTraits<CosineDistance>
 
   //! The cosine kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The cosine kernel is a normalized dot product.
+  static const bool IsDotProduct = true;
+  //! The cosine kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
 };
 
 } // namespace kernel
@@ -32,6 +32,24 @@ double CosineDistance::Evaluate(const VecTypeA& a, const VecTypeB& b)
     return dot(a, b) / denominator;
 }
 
+template<typename MatTypeA, typename MatTypeB>
+void CosineDistance::Evaluate(const MatTypeA& queries,
+                              const MatTypeB& references,
+                              arma::mat& results)
+{
+  // Replacing zero norms with one before the division makes pairs involving
+  // a zero vector evaluate to 0 / 1 = 0, matching the pairwise overload.
+  arma::vec queryNorms =
+      arma::trans(arma::sqrt(arma::sum(arma::square(queries), 0)));
+  arma::rowvec refNorms = arma::sqrt(arma::sum(arma::square(references), 0));
+  queryNorms.replace(0.0, 1.0);
+  refNorms.replace(0.0, 1.0);
+
+  results = arma::trans(queries) * references;
+  results.each_col() /= queryNorms;
+  results.each_row() /= refNorms;
+}
+
 } // namespace kernel
 } // namespace mlpack
 
@@ -57,6 +57,21 @@ class EpanechnikovKernel
    */
   double Evaluate(const double distance) const;
 
+  /**
+   * Batch evaluation of the Epanechnikov kernel for two blocks of points,
+   * using one matrix product plus rank-one corrections for all pairwise
+   * squared distances.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store kernel values into; entry (i, j) is set
+   *     to K(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  void Evaluate(const MatTypeA& queries,
+                const MatTypeB& references,
+                arma::mat& results) const;
+
   /**
    * Evaluate the Gradient of Epanechnikov kernel
    * given that the distance between the two
@@ -111,6 +126,10 @@ class KernelTraits<EpanechnikovKernel>
   static const bool IsNormalized = true;
   //! The Epanechnikov kernel includes a squared distance.
   static const bool UsesSquaredDistance = true;
+  //! The Epanechnikov kernel is not a dot-product kernel.
+  static const bool IsDotProduct = false;
+  //! The Epanechnikov kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
 };
 
 } // namespace kernel
@@ -29,6 +29,19 @@ inline double EpanechnikovKernel::Evaluate(const VecTypeA& a, const VecTypeB& b)
       * inverseBandwidthSquared);
 }
 
+template<typename MatTypeA, typename MatTypeB>
+inline void EpanechnikovKernel::Evaluate(const MatTypeA& queries,
+                                         const MatTypeB& references,
+                                         arma::mat& results) const
+{
+  results = arma::trans(queries) * references;
+  results *= -2.0;
+  results.each_col() += arma::trans(arma::sum(arma::square(queries), 0));
+  results.each_row() += arma::sum(arma::square(references), 0);
+
+  results = arma::clamp(1.0 - results * inverseBandwidthSquared, 0.0, 1.0);
+}
+
 /**
  * Obtains the convolution integral [integral of K(||x-a||) K(||b-x||) dx]
  * for the two vectors.
@@ -72,6 +72,15 @@ namespace kernel {
  * generalization, mlpack methods expect all kernels to require state and hence
  * must store instantiated kernel functions; this is why a default constructor
  * is necessary.
+ *
+ * @note
+ * Optionally, a kernel may provide a batched overload
+ * `Evaluate(queries, references, results)` that fills the kernel matrix of
+ * two blocks of points (one point per column) in a single call, and advertise
+ * it by setting `SupportsBatchEvaluation = true` in its KernelTraits
+ * specialization.  Base cases that evaluate many pairs against each other
+ * check this trait and replace per-pair evaluation with the batched one; see
+ * GaussianKernel for an example.
  */
 class ExampleKernel
 {
@@ -0,0 +1,142 @@
+/**
+ * @file core/kernels/gram_matrix.hpp
+ *
+ * Tiled, parallel construction of kernel (Gram) matrices.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_GRAM_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_GRAM_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+//! Evaluate one tile of a kernel matrix with the batched kernel API.
+template<typename KernelType, typename MatTypeA, typename MatTypeB>
+inline void EvaluateKernelTile(KernelType& kernel,
+                               const MatTypeA& queries,
+                               const MatTypeB& references,
+                               arma::mat& tile,
+                               const std::true_type& /* batched */)
+{
+  kernel.Evaluate(queries, references, tile);
+}
+
+//! Evaluate one tile of a kernel matrix pair by pair, for kernels without a
+//! batched evaluation.
+template<typename KernelType, typename MatTypeA, typename MatTypeB>
+inline void EvaluateKernelTile(KernelType& kernel,
+                               const MatTypeA& queries,
+                               const MatTypeB& references,
+                               arma::mat& tile,
+                               const std::false_type& /* batched */)
+{
+  tile.set_size(queries.n_cols, references.n_cols);
+  for (size_t j = 0; j < references.n_cols; ++j)
+    for (size_t i = 0; i < queries.n_cols; ++i)
+      tile(i, j) = kernel.Evaluate(queries.col(i), references.col(j));
+}
+
+/**
+ * Compute the symmetric kernel matrix of one set of points, so that entry
+ * (i, j) is K(data.col(i), data.col(j)).  The matrix is assembled tile by
+ * tile: only the tiles of the upper triangle are evaluated (the mirrored
+ * tile is a transposed copy), the tiles are processed in parallel, and each
+ * tile goes through the batched kernel API when the kernel advertises one
+ * via KernelTraits (see SupportsBatchEvaluation).
+ *
+ * @param data Matrix of points (one point per column).
+ * @param kernelMatrix Matrix to store the kernel matrix into.
+ * @param kernel Instantiated kernel to evaluate.
+ * @param blockSize Number of points per tile side (default 256).
+ */
+template<typename KernelType>
+void ComputeKernelMatrix(const arma::mat& data,
+                         arma::mat& kernelMatrix,
+                         KernelType& kernel,
+                         const size_t blockSize = 256)
+{
+  kernelMatrix.set_size(data.n_cols, data.n_cols);
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  // Flatten the upper-triangular tile indices, so a single loop can be
+  // parallelized over all tiles.
+  std::vector<std::pair<size_t, size_t> > tiles;
+  for (size_t bi = 0; bi < numBlocks; ++bi)
+    for (size_t bj = bi; bj < numBlocks; ++bj)
+      tiles.push_back(std::make_pair(bi, bj));
+
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) tiles.size(); ++t)
+  {
+    const size_t iFirst = tiles[t].first * blockSize;
+    const size_t iLast = std::min(iFirst + blockSize,
+        (size_t) data.n_cols) - 1;
+    const size_t jFirst = tiles[t].second * blockSize;
+    const size_t jLast = std::min(jFirst + blockSize,
+        (size_t) data.n_cols) - 1;
+
+    arma::mat tile;
+    EvaluateKernelTile(kernel, data.cols(iFirst, iLast),
+        data.cols(jFirst, jLast), tile, std::integral_constant<bool,
+        KernelTraits<KernelType>::SupportsBatchEvaluation>());
+
+    kernelMatrix.submat(iFirst, jFirst, iLast, jLast) = tile;
+    if (iFirst != jFirst)
+      kernelMatrix.submat(jFirst, iFirst, jLast, iLast) = tile.t();
+  }
+}
+
+/**
+ * Compute the rectangular kernel matrix between two sets of points, so that
+ * entry (i, j) is K(queries.col(i), references.col(j)).  The matrix is
+ * assembled tile by tile in parallel, with each tile going through the
+ * batched kernel API when the kernel advertises one via KernelTraits.
+ *
+ * @param queries Matrix of query points (one point per column).
+ * @param references Matrix of reference points (one point per column).
+ * @param kernelMatrix Matrix to store the kernel matrix into.
+ * @param kernel Instantiated kernel to evaluate.
+ * @param blockSize Number of points per tile side (default 256).
+ */
+template<typename KernelType>
+void ComputeKernelMatrix(const arma::mat& queries,
+                         const arma::mat& references,
+                         arma::mat& kernelMatrix,
+                         KernelType& kernel,
+                         const size_t blockSize = 256)
+{
+  kernelMatrix.set_size(queries.n_cols, references.n_cols);
+  const size_t numQueryBlocks = (queries.n_cols + blockSize - 1) / blockSize;
+  const size_t numRefBlocks = (references.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) (numQueryBlocks * numRefBlocks);
+      ++t)
+  {
+    const size_t iFirst = (t / numRefBlocks) * blockSize;
+    const size_t iLast = std::min(iFirst + blockSize,
+        (size_t) queries.n_cols) - 1;
+    const size_t jFirst = (t % numRefBlocks) * blockSize;
+    const size_t jLast = std::min(jFirst + blockSize,
+        (size_t) references.n_cols) - 1;
+
+    arma::mat tile;
+    EvaluateKernelTile(kernel, queries.cols(iFirst, iLast),
+        references.cols(jFirst, jLast), tile, std::integral_constant<bool,
+        KernelTraits<KernelType>::SupportsBatchEvaluation>());
+
+    kernelMatrix.submat(iFirst, jFirst, iLast, jLast) = tile;
+  }
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
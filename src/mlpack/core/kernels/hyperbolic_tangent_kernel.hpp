@@ -62,6 +62,25 @@ class HyperbolicTangentKernel
     return tanh(scale * arma::dot(a, b) + offset);
   }
 
+  /**
+   * Batch evaluation of the hyperbolic tangent kernel for two blocks of
+   * points; all dot products come from one matrix product, and tanh runs
+   * over the whole block at once.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store kernel values into; entry (i, j) is set
+   *     to K(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  void Evaluate(const MatTypeA& queries,
+                const MatTypeB& references,
+                arma::mat& results) const
+  {
+    results = arma::tanh(scale * (arma::trans(queries) * references) +
+        offset);
+  }
+
   //! Get scale factor.
   double Scale() const { return scale; }
   //! Modify scale factor.
@@ -85,6 +104,22 @@ class HyperbolicTangentKernel
   double offset;
 };
 
+//! Kernel traits for the hyperbolic tangent kernel.
+template<>
+class KernelTraits<HyperbolicTangentKernel>
+{
+ public:
+  //! The hyperbolic tangent kernel is not normalized: K(x, x) depends on x.
+  static const bool IsNormalized = false;
+  //! The hyperbolic tangent kernel doesn't include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The hyperbolic tangent kernel is a function of the dot product, not the
+  //! dot product itself.
+  static const bool IsDotProduct = false;
+  //! The hyperbolic tangent kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
+};
+
 } // namespace kernel
 } // namespace mlpack
 
@@ -36,6 +36,23 @@ class KernelTraits
    * If true, then the kernel include a squared distance, ||x - y||^2 .
    */
   static const bool UsesSquaredDistance = false;
+
+  /**
+   * If true, then the kernel is a (possibly normalized) dot product:
+   * K(x, y) = (x^T y) / (sqrt(K(x, x)) * sqrt(K(y, y))).  For such kernels,
+   * batch evaluation over blocks of points can be formulated as a matrix
+   * multiplication.
+   */
+  static const bool IsDotProduct = false;
+
+  /**
+   * If true, then the kernel provides a batched
+   * Evaluate(queries, references, results) overload that fills the kernel
+   * matrix of two blocks of points in one call.  Base cases that evaluate
+   * many pairs against each other can detect this and replace per-pair
+   * evaluation with the batched one.
+   */
+  static const bool SupportsBatchEvaluation = false;
 };
 
 } // namespace kernel
@@ -64,6 +64,33 @@ class LaplacianKernel
     return exp(-metric::EuclideanDistance::Evaluate(a, b) / bandwidth);
   }
 
+  /**
+   * Batch evaluation of the Laplacian kernel for two blocks of points; the
+   * distances between all pairs are obtained from one matrix product plus
+   * rank-one corrections, and the exponential runs over the whole block at
+   * once.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store kernel values into; entry (i, j) is set
+   *     to K(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  void Evaluate(const MatTypeA& queries,
+                const MatTypeB& references,
+                arma::mat& results) const
+  {
+    results = arma::trans(queries) * references;
+    results *= -2.0;
+    results.each_col() += arma::trans(arma::sum(arma::square(queries), 0));
+    results.each_row() += arma::sum(arma::square(references), 0);
+
+    // The clamp protects the square root against tiny negative squared
+    // distances produced by rounding.
+    results = arma::exp(-arma::sqrt(arma::clamp(results, 0.0,
+        arma::datum::inf)) / bandwidth);
+  }
+
   /**
    * Evaluation of the Laplacian kernel given the distance between two points.
    *
@@ -117,6 +144,10 @@ class KernelTraits<LaplacianKernel>
   static const bool IsNormalized = true;
   //! The Laplacian kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The Laplacian kernel is not a dot-product kernel.
+  static const bool IsDotProduct = false;
+  //! The Laplacian kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
 };
 
 } // namespace kernel
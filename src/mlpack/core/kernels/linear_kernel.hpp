@@ -15,6 +15,7 @@
 #define MLPACK_CORE_KERNELS_LINEAR_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 namespace kernel {
@@ -55,11 +56,43 @@ class LinearKernel
     return arma::dot(a, b);
   }
 
+  /**
+   * Batch evaluation of the linear kernel for two blocks of points; the
+   * kernel matrix is just the matrix product of the blocks.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store kernel values into; entry (i, j) is set
+   *     to K(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(const MatTypeA& queries,
+                       const MatTypeB& references,
+                       arma::mat& results)
+  {
+    results = arma::trans(queries) * references;
+  }
+
   //! Serialize the kernel (it has no members... do nothing).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
 };
 
+//! Kernel traits for the linear kernel.
+template<>
+class KernelTraits<LinearKernel>
+{
+ public:
+  //! The linear kernel is not normalized: K(x, x) = ||x||^2.
+  static const bool IsNormalized = false;
+  //! The linear kernel doesn't include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The linear kernel is a dot product.
+  static const bool IsDotProduct = true;
+  //! The linear kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
+};
+
 } // namespace kernel
 } // namespace mlpack
 
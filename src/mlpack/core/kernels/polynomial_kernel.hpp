@@ -57,6 +57,24 @@ class PolynomialKernel
     return pow((arma::dot(a, b) + offset), degree);
   }
 
+  /**
+   * Batch evaluation of the polynomial kernel for two blocks of points; all
+   * dot products come from one matrix product, and the offset and power are
+   * applied elementwise to the whole block.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store kernel values into; entry (i, j) is set
+   *     to K(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  void Evaluate(const MatTypeA& queries,
+                const MatTypeB& references,
+                arma::mat& results) const
+  {
+    results = arma::pow(arma::trans(queries) * references + offset, degree);
+  }
+
   //! Get the degree of the polynomial.
   const double& Degree() const { return degree; }
   //! Modify the degree of the polynomial.
@@ -82,6 +100,22 @@ class PolynomialKernel
   double offset;
 };
 
+//! Kernel traits for the polynomial kernel.
+template<>
+class KernelTraits<PolynomialKernel>
+{
+ public:
+  //! The polynomial kernel is not normalized: K(x, x) depends on x.
+  static const bool IsNormalized = false;
+  //! The polynomial kernel doesn't include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The polynomial kernel is a function of the dot product, not the dot
+  //! product itself.
+  static const bool IsDotProduct = false;
+  //! The polynomial kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
+};
+
 } // namespace kernel
 } // namespace mlpack
 
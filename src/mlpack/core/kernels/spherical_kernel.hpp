@@ -46,6 +46,29 @@ class SphericalKernel
         (metric::SquaredEuclideanDistance::Evaluate(a, b) <= bandwidthSquared) ?
         1.0 : 0.0;
   }
+  /**
+   * Batch evaluation of the spherical kernel for two blocks of points, using
+   * one matrix product plus rank-one corrections for all pairwise squared
+   * distances.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store kernel values into; entry (i, j) is set
+   *     to K(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  void Evaluate(const MatTypeA& queries,
+                const MatTypeB& references,
+                arma::mat& results) const
+  {
+    results = arma::trans(queries) * references;
+    results *= -2.0;
+    results.each_col() += arma::trans(arma::sum(arma::square(queries), 0));
+    results.each_row() += arma::sum(arma::square(references), 0);
+
+    results = arma::conv_to<arma::mat>::from(results <= bandwidthSquared);
+  }
+
   /**
    * Obtains the convolution integral [integral K(||x-a||)K(||b-x||)dx]
    * for the two vectors.
@@ -123,6 +146,10 @@ class KernelTraits<SphericalKernel>
   static const bool IsNormalized = true;
   //! The spherical kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The spherical kernel is not a dot-product kernel.
+  static const bool IsDotProduct = false;
+  //! The spherical kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
 };
 
 } // namespace kernel
@@ -52,6 +52,32 @@ class TriangularKernel
         bandwidth));
   }
 
+  /**
+   * Batch evaluation of the triangular kernel for two blocks of points,
+   * using one matrix product plus rank-one corrections for all pairwise
+   * squared distances.
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param references Matrix of reference points (one point per column).
+   * @param results Matrix to store kernel values into; entry (i, j) is set
+   *     to K(queries.col(i), references.col(j)).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  void Evaluate(const MatTypeA& queries,
+                const MatTypeB& references,
+                arma::mat& results) const
+  {
+    results = arma::trans(queries) * references;
+    results *= -2.0;
+    results.each_col() += arma::trans(arma::sum(arma::square(queries), 0));
+    results.each_row() += arma::sum(arma::square(references), 0);
+
+    // The inner clamp protects the square root against tiny negative squared
+    // distances produced by rounding.
+    results = arma::clamp(1.0 - arma::sqrt(arma::clamp(results, 0.0,
+        arma::datum::inf)) / bandwidth, 0.0, 1.0);
+  }
+
   /**
    * Evaluate the triangular kernel given that the distance between the two
    * points is known.
@@ -112,6 +138,10 @@ class KernelTraits<TriangularKernel>
   static const bool IsNormalized = true;
   //! The triangular kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The triangular kernel is not a dot-product kernel.
+  static const bool IsDotProduct = false;
+  //! The triangular kernel provides a batched evaluation.
+  static const bool SupportsBatchEvaluation = true;
 };
 
 } // namespace kernel
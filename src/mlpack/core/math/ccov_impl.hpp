@@ -40,9 +40,43 @@ inline arma::Mat<eT> ColumnCovariance(const arma::Mat<eT>& x,
     const size_t n = xAlias.n_cols;
     const eT normVal = (normType == 0) ? ((n > 1) ? eT(n - 1) : eT(1)) : eT(n);
 
-    const arma::Mat<eT> tmp = xAlias.each_col() - arma::mean(xAlias, 1);
+    // Accumulate the scatter matrix and the column sum in one blocked pass
+    // over the data, instead of materializing the centered matrix (which
+    // doubles the memory traffic); the mean is subtracted afterwards as a
+    // rank-one correction, as the complex overload below already does.  Each
+    // thread accumulates its own partial results over a range of column
+    // panels, which are merged at the end.
+    const size_t d = xAlias.n_rows;
+    const size_t blockSize = 256;
+    const size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+    out.zeros(d, d);
+    arma::Col<eT> colSum(d, arma::fill::zeros);
+
+    #pragma omp parallel
+    {
+      arma::Mat<eT> localScatter(d, d, arma::fill::zeros);
+      arma::Col<eT> localSum(d, arma::fill::zeros);
+
+      #pragma omp for nowait
+      for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+      {
+        const size_t first = b * blockSize;
+        const size_t last = std::min(first + blockSize, n) - 1;
+
+        localScatter += xAlias.cols(first, last) *
+            xAlias.cols(first, last).t();
+        localSum += arma::sum(xAlias.cols(first, last), 1);
+      }
+
+      #pragma omp critical
+      {
+        out += localScatter;
+        colSum += localSum;
+      }
+    }
 
-    out = tmp * tmp.t();
+    out -= (colSum * colSum.t()) / eT(n);
     out /= normVal;
   }
 
@@ -0,0 +1,122 @@
+/**
+ * @file core/math/fast_math.hpp
+ *
+ * Approximate transcendental functions (exp and log) with roughly 1e-7
+ * relative error, plus policy classes that let a call site choose between
+ * the exact libm routines and the approximations at compile time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_FAST_MATH_HPP
+#define MLPACK_CORE_MATH_FAST_MATH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Approximate std::exp() with a range reduction to 2^n * e^r followed by a
+ * degree-7 polynomial in r.  The relative error is below 1e-8 for all finite
+ * inputs; out-of-range inputs saturate to 0 or infinity just like std::exp().
+ *
+ * This is noticeably faster than libm exp() because it avoids the final
+ * precision-refinement steps of a correctly-rounded implementation, and the
+ * elementwise overloads below compile to tight loops the compiler can
+ * vectorize.
+ *
+ * @param x Value to exponentiate.
+ * @return Approximation of e^x.
+ */
+inline double FastExp(const double x);
+
+/**
+ * Approximate std::log() by decomposing x into m * 2^e (with m near 1) and
+ * evaluating a short atanh series for log(m).  The relative error is below
+ * 1e-9 for all positive normal inputs; zero, negative, and non-finite inputs
+ * produce the same results as std::log().
+ *
+ * @param x Value to take the logarithm of.
+ * @return Approximation of log(x).
+ */
+inline double FastLog(const double x);
+
+//! Elementwise FastExp() over a dense matrix or vector.
+template<typename MatType>
+void FastExp(const MatType& x, MatType& result);
+
+//! Elementwise FastLog() over a dense matrix or vector.
+template<typename MatType>
+void FastLog(const MatType& x, MatType& result);
+
+/**
+ * Exp/log policy that uses the exact libm routines.  Methods whose inner
+ * loops are dominated by transcendental calls can take one of these policies
+ * as a template parameter and let the user trade precision for speed; this
+ * one is the safe default.
+ */
+class ExactExpLog
+{
+ public:
+  //! Exact scalar exponential.
+  static double Exp(const double x) { return std::exp(x); }
+
+  //! Exact scalar logarithm.
+  static double Log(const double x) { return std::log(x); }
+
+  //! Exact elementwise exponential.
+  template<typename MatType>
+  static void Exp(const MatType& x, MatType& result)
+  {
+    result = arma::exp(x);
+  }
+
+  //! Exact elementwise logarithm.
+  template<typename MatType>
+  static void Log(const MatType& x, MatType& result)
+  {
+    result = arma::log(x);
+  }
+};
+
+/**
+ * Exp/log policy that uses the polynomial approximations (FastExp() and
+ * FastLog(), roughly 1e-7 relative error).  Opt into this per call site for
+ * precision-insensitive workloads such as kernel density estimation or
+ * softmax scoring, where the approximation error is far below the noise
+ * floor of the computation.
+ */
+class ApproxExpLog
+{
+ public:
+  //! Approximate scalar exponential.
+  static double Exp(const double x) { return FastExp(x); }
+
+  //! Approximate scalar logarithm.
+  static double Log(const double x) { return FastLog(x); }
+
+  //! Approximate elementwise exponential.
+  template<typename MatType>
+  static void Exp(const MatType& x, MatType& result)
+  {
+    FastExp(x, result);
+  }
+
+  //! Approximate elementwise logarithm.
+  template<typename MatType>
+  static void Log(const MatType& x, MatType& result)
+  {
+    FastLog(x, result);
+  }
+};
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "fast_math_impl.hpp"
+
+#endif
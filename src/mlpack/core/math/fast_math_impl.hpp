@@ -0,0 +1,120 @@
+/**
+ * @file core/math/fast_math_impl.hpp
+ *
+ * Implementation of the approximate exp and log routines.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_FAST_MATH_IMPL_HPP
+#define MLPACK_CORE_MATH_FAST_MATH_IMPL_HPP
+
+#include "fast_math.hpp"
+
+#include <cstring>
+
+namespace mlpack {
+namespace math {
+
+inline double FastExp(const double x)
+{
+  // Saturate out-of-range inputs the same way std::exp() does (the bit
+  // reconstruction below would otherwise wrap the exponent field).
+  if (x > 709.0)
+    return std::numeric_limits<double>::infinity();
+  if (x < -708.0)
+    return 0.0;
+
+  // Reduce to e^x = 2^n * e^r with r in [-ln(2) / 2, ln(2) / 2].  The
+  // subtraction uses a two-term representation of ln(2) so that r keeps full
+  // precision even for large n.
+  const double log2e = 1.4426950408889634074;
+  const double ln2Hi = 6.93147180369123816490e-01;
+  const double ln2Lo = 1.90821492927058770002e-10;
+
+  const double nFloat = std::floor(x * log2e + 0.5);
+  const double r = (x - nFloat * ln2Hi) - nFloat * ln2Lo;
+
+  // Degree-7 Taylor polynomial for e^r; the truncation error on the reduced
+  // range is below 6e-9.
+  double p = 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  // Build 2^n directly from its IEEE-754 bit pattern and apply it.
+  const int64_t n = (int64_t) nFloat;
+  const uint64_t scaleBits = (uint64_t) (n + 1023) << 52;
+  double scale;
+  memcpy(&scale, &scaleBits, sizeof(scale));
+
+  return p * scale;
+}
+
+inline double FastLog(const double x)
+{
+  // Defer zero, negative, denormal, and non-finite inputs to libm so the
+  // edge-case behavior matches std::log() exactly.
+  if (!(x >= std::numeric_limits<double>::min()) ||
+      x == std::numeric_limits<double>::infinity())
+    return std::log(x);
+
+  // Decompose x = m * 2^e with m in [sqrt(2) / 2, sqrt(2)), which centers
+  // the series argument around zero.
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  int64_t e = (int64_t) ((bits >> 52) & 0x7FF) - 1023;
+  const uint64_t mBits = (bits & 0x000FFFFFFFFFFFFFULL) |
+      0x3FF0000000000000ULL;
+  double m;
+  memcpy(&m, &mBits, sizeof(m));
+  if (m > 1.4142135623730951)
+  {
+    m *= 0.5;
+    ++e;
+  }
+
+  // log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1); |s| < 0.1716, so five
+  // series terms leave a truncation error below 1e-9.
+  const double s = (m - 1.0) / (m + 1.0);
+  const double s2 = s * s;
+  double p = 1.0 / 9.0;
+  p = p * s2 + 1.0 / 7.0;
+  p = p * s2 + 1.0 / 5.0;
+  p = p * s2 + 1.0 / 3.0;
+  p = p * s2 + 1.0;
+
+  const double ln2 = 0.69314718055994530942;
+  return (double) e * ln2 + 2.0 * s * p;
+}
+
+template<typename MatType>
+void FastExp(const MatType& x, MatType& result)
+{
+  result.set_size(x.n_rows, x.n_cols);
+  const typename MatType::elem_type* in = x.memptr();
+  typename MatType::elem_type* out = result.memptr();
+  for (size_t i = 0; i < x.n_elem; ++i)
+    out[i] = FastExp(in[i]);
+}
+
+template<typename MatType>
+void FastLog(const MatType& x, MatType& result)
+{
+  result.set_size(x.n_rows, x.n_cols);
+  const typename MatType::elem_type* in = x.memptr();
+  typename MatType::elem_type* out = result.memptr();
+  for (size_t i = 0; i < x.n_elem; ++i)
+    out[i] = FastLog(in[i]);
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
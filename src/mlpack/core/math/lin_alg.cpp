@@ -12,6 +12,7 @@
 #include "lin_alg.hpp"
 #include <mlpack/core.hpp>
 #include <mlpack/core/math/random.hpp>
+#include <mlpack/core/util/simd_support.hpp>
 
 using namespace mlpack;
 using namespace math;
@@ -21,6 +22,7 @@ using namespace math;
  * is ignored in the power operation and then re-added.  Useful for
  * eigenvalues.
  */
+MLPACK_TARGET_CLONES
 void mlpack::math::VectorPower(arma::vec& vec, const double power)
 {
   for (size_t i = 0; i < vec.n_elem; ++i)
@@ -40,6 +42,7 @@ void mlpack::math::VectorPower(arma::vec& vec, const double power)
  * @param x Input matrix
  * @param xCentered Matrix to write centered output into
  */
+MLPACK_TARGET_CLONES
 void mlpack::math::Center(const arma::mat& x, arma::mat& xCentered)
 {
   // Get the mean of the elements in each row.
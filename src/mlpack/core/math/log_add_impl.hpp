@@ -62,11 +62,20 @@ T LogAdd(T x, T y)
 template<typename T>
 typename T::elem_type AccuLog(const T& x)
 {
-  typename T::elem_type maxVal = max(x);
-  if (maxVal == -std::numeric_limits<typename T::elem_type>::infinity())
+  typedef typename T::elem_type ElemType;
+
+  const ElemType maxVal = max(x);
+  if (maxVal == -std::numeric_limits<ElemType>::infinity())
     return maxVal;
 
-  return maxVal + log(sum(exp(x - maxVal)));;
+  // Accumulate the shifted exponentials in one tight pass; keeping the loop
+  // free of Armadillo expression temporaries lets it compile to vector
+  // instructions.
+  ElemType sum = 0;
+  for (size_t i = 0; i < x.n_elem; ++i)
+    sum += std::exp(x[i] - maxVal);
+
+  return maxVal + std::log(sum);
 }
 
 /**
@@ -77,28 +86,43 @@ typename T::elem_type AccuLog(const T& x)
 template<typename T, bool InPlace>
 void LogSumExp(const T& x, arma::Col<typename T::elem_type>& y)
 {
-  arma::Col<typename T::elem_type> maxs;
+  typedef typename T::elem_type ElemType;
 
+  arma::Col<ElemType> maxs;
   if (InPlace)
   {
-    // Compute the maximum in each column (treating y as a column too).
+    // Compute the maximum in each row (treating y as a column too).
     maxs = max(max(x, 1), y);
-
-    y = maxs + log(sum(exp(x - repmat(maxs, 1, x.n_cols)), 1) +
-        exp(y - maxs));
   }
   else
   {
-    // Compute the maximum element in each column.
+    // Compute the maximum element in each row.
     maxs = max(x, 1);
-
-    y = maxs + log(sum(exp(x - repmat(maxs, 1, x.n_cols)), 1));
   }
 
+  // Accumulate the shifted exponentials with one column-major sweep, instead
+  // of materializing the repmat() intermediate; the inner loop is contiguous
+  // and compiles to vector instructions.
+  arma::Col<ElemType> sums(x.n_rows, arma::fill::zeros);
+  for (size_t j = 0; j < x.n_cols; ++j)
+    for (size_t i = 0; i < x.n_rows; ++i)
+      sums[i] += std::exp(x(i, j) - maxs[i]);
+
+  if (InPlace)
+    sums += exp(y - maxs);
+
+  y = maxs + log(sums);
+
+  // A -inf maximum means the whole row (and, for the in-place variant, the
+  // old y value) is -inf; the shifted sums are NaN there and the result must
+  // be -inf.
   if (maxs.has_inf())
   {
-    y.replace(-std::numeric_limits<typename T::elem_type>::quiet_NaN(),
-              -std::numeric_limits<typename T::elem_type>::infinity());
+    for (size_t i = 0; i < y.n_elem; ++i)
+    {
+      if (maxs[i] == -std::numeric_limits<ElemType>::infinity())
+        y[i] = -std::numeric_limits<ElemType>::infinity();
+    }
   }
 }
 
@@ -110,28 +134,47 @@ void LogSumExp(const T& x, arma::Col<typename T::elem_type>& y)
 template<typename T, bool InPlace>
 void LogSumExpT(const T& x, arma::Col<typename T::elem_type>& y)
 {
-  arma::Row<typename T::elem_type> maxs;
+  typedef typename T::elem_type ElemType;
 
+  arma::Row<ElemType> maxs;
   if (InPlace)
   {
-    // Compute the maximum element in each column.
+    // Compute the maximum element in each column (including the old y).
     maxs = max(max(x, 0), y.t());
-
-    y = maxs.t() + log(sum(exp(x - repmat(maxs, x.n_rows, 1)), 0) +
-        exp(y.t() - maxs)).t();
   }
   else
   {
     // Compute the maximum element in each column.
-    arma::Row<typename T::elem_type> maxs = max(x, 0);
+    maxs = max(x, 0);
+  }
 
-    y = (maxs + log(sum(exp(x - repmat(maxs, x.n_rows, 1)), 0))).t();
+  // Each column is contiguous, so its shifted exponentials are accumulated
+  // in one tight pass that compiles to vector instructions, instead of
+  // materializing the repmat() intermediate.
+  arma::Row<ElemType> sums(x.n_cols);
+  for (size_t j = 0; j < x.n_cols; ++j)
+  {
+    ElemType sum = 0;
+    for (size_t i = 0; i < x.n_rows; ++i)
+      sum += std::exp(x(i, j) - maxs[j]);
+    sums[j] = sum;
   }
 
+  if (InPlace)
+    sums += exp(y.t() - maxs);
+
+  y = (maxs + log(sums)).t();
+
+  // A -inf maximum means the whole column (and, for the in-place variant,
+  // the old y value) is -inf; the shifted sums are NaN there and the result
+  // must be -inf.
   if (maxs.has_inf())
   {
-    y.replace(-std::numeric_limits<typename T::elem_type>::quiet_NaN(),
-              -std::numeric_limits<typename T::elem_type>::infinity());
+    for (size_t i = 0; i < y.n_elem; ++i)
+    {
+      if (maxs[i] == -std::numeric_limits<ElemType>::infinity())
+        y[i] = -std::numeric_limits<ElemType>::infinity();
+    }
   }
 }
 
@@ -56,24 +56,32 @@ CubeType MultiplyCube2Cube(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // The slices are independent, so the per-slice multiplications run in
+  // parallel; each multiplies the slice views in place, with any transpose
+  // folded into the multiplication instead of materializing a transposed
+  // copy.
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = arma::trans(cubeB.slice(i) * cubeA.slice(i));
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
+      z.slice(i) = cubeA.slice(i).t() * cubeB.slice(i).t();
   }
   else if (bTranspose && !aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * cubeB.slice(i).t();
   }
   else if (aTranspose && !bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i).t() * cubeB.slice(i);
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * cubeB.slice(i);
   }
   return z;
@@ -112,27 +120,45 @@ CubeType MultiplyMat2Cube(const MatType& matA,
       Log::Fatal << "Matrix multiplication invalid!" << std::endl;
   }
 
+  typedef typename CubeType::elem_type ElemType;
+
   CubeType z(rows, cols, slices);
 
-  if (aTranspose && bTranspose)
-  {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = arma::trans(cubeB.slice(i) * matA);
-  }
-  else if (bTranspose)
-  {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA * cubeB.slice(i).t();
-  }
-  else if (aTranspose)
-  {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA.t() * cubeB.slice(i);
+  if (bTranspose)
+  {
+    // The transposed slices of B are not contiguous across the batch, so
+    // these cases stay per-slice multiplications, run in parallel with the
+    // transpose folded into each multiplication.
+    if (aTranspose)
+    {
+      #pragma omp parallel for
+      for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
+        z.slice(i) = matA.t() * cubeB.slice(i).t();
+    }
+    else
+    {
+      #pragma omp parallel for
+      for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
+        z.slice(i) = matA * cubeB.slice(i).t();
+    }
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA * cubeB.slice(i);
+    // The slices of a cube are laid out back to back in memory, so all the
+    // per-slice products against the shared left operand collapse into a
+    // single multiplication of matA with B viewed as one
+    // (n_rows x n_cols * n_slices) matrix, aliasing the cube memory without
+    // any slice copies.
+    const arma::Mat<ElemType> bFlat(
+        const_cast<ElemType*>(cubeB.memptr()), cubeB.n_rows,
+        cubeB.n_cols * cubeB.n_slices, false, true);
+    arma::Mat<ElemType> zFlat(z.memptr(), z.n_rows, z.n_cols * z.n_slices,
+        false, true);
+
+    if (aTranspose)
+      zFlat = matA.t() * bFlat;
+    else
+      zFlat = matA * bFlat;
   }
   return z;
 }
@@ -170,24 +196,32 @@ CubeType MultiplyCube2Mat(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // The left operand varies per slice here, so no flattened single
+  // multiplication exists; the independent per-slice multiplications run in
+  // parallel instead, with any transpose folded into the multiplication
+  // rather than materialized.
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = arma::trans(matB * cubeA.slice(i));
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
+      z.slice(i) = cubeA.slice(i).t() * matB.t();
   }
   else if (bTranspose && !aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * matB.t();
   }
   else if (aTranspose && !bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i).t() * matB;
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * matB;
   }
   return z;
@@ -13,8 +13,14 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/mlpack_export.hpp>
+#include <atomic>
 #include <random>
 
+// Use OpenMP if compiled with -DHAS_OPENMP.
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace math /** Miscellaneous math routines. */ {
 
@@ -29,6 +35,77 @@ extern MLPACK_EXPORT std::mt19937 randGen;
 extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
 // Global normal distribution.
 extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
+// Master seed from which the per-thread random streams are derived.
+extern MLPACK_EXPORT size_t randMasterSeed;
+// Bumped on every reseed, so live per-thread streams reseed themselves.
+extern MLPACK_EXPORT std::atomic<size_t> randSeedEpoch;
+
+/**
+ * Mix a master seed and a stream index into a well-separated stream seed,
+ * using the SplitMix64 finalizer.  Streams derived from the same master seed
+ * and different indices are statistically independent, and the derivation is
+ * deterministic, so parallel runs with the same master seed are reproducible.
+ */
+inline uint32_t DeriveStreamSeed(const size_t masterSeed,
+                                 const size_t streamIndex)
+{
+  uint64_t z = (uint64_t) masterSeed +
+      0x9E3779B97F4A7C15ULL * (uint64_t) (streamIndex + 1);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= (z >> 31);
+  return (uint32_t) (z ^ (z >> 32));
+}
+
+/**
+ * Get (a mutable reference to) the calling thread's random stream index.
+ * Stream 0 means "no registered stream": such callers fall back to the
+ * OpenMP thread number, so OpenMP teams keep their per-thread streams
+ * without registration.  Threads that draw random numbers outside an OpenMP
+ * team---the util::ThreadPool workers register their worker index here---
+ * must set a nonzero stream index, or they would all share the global
+ * generator and race on it.
+ */
+inline size_t& RandStreamId()
+{
+  static thread_local size_t streamId = 0;
+  return streamId;
+}
+
+/**
+ * Get the calling thread's random generator.  Thread 0 of a parallel region
+ * (and any caller outside a parallel region) keeps using the global randGen,
+ * so single-threaded sequences are unchanged; every other thread gets its own
+ * generator, seeded deterministically from the master seed and its stream
+ * index (the registered RandStreamId(), or the OpenMP thread number), so
+ * parallel algorithms draw from independent streams without contention on
+ * the global generator.
+ */
+inline std::mt19937& RandGen()
+{
+  size_t threadId = RandStreamId();
+  #ifdef HAS_OPENMP
+    if (threadId == 0)
+      threadId = (size_t) omp_get_thread_num();
+  #endif
+
+  if (threadId == 0)
+    return randGen;
+
+  static thread_local std::mt19937 threadGen;
+  static thread_local size_t threadEpoch =
+      std::numeric_limits<size_t>::max();
+
+  // Reseed if RandomSeed() has been called since the last draw.
+  const size_t epoch = randSeedEpoch.load(std::memory_order_relaxed);
+  if (threadEpoch != epoch)
+  {
+    threadGen.seed(DeriveStreamSeed(randMasterSeed, threadId));
+    threadEpoch = epoch;
+  }
+
+  return threadGen;
+}
 
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
@@ -41,6 +118,8 @@ inline void RandomSeed(const size_t seed)
 {
   #if (!defined(BINDING_TYPE) || BINDING_TYPE != BINDING_TYPE_TEST)
     randGen.seed((uint32_t) seed);
+    randMasterSeed = seed;
+    ++randSeedEpoch;
     #if (BINDING_TYPE == BINDING_TYPE_R)
       // To suppress Found 'srand', possibly from 'srand' (C).
       (void) seed;
@@ -65,6 +144,8 @@ inline void FixedRandomSeed()
 {
   const static size_t seed = rand();
   randGen.seed((uint32_t) seed);
+  randMasterSeed = seed;
+  ++randSeedEpoch;
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
@@ -72,6 +153,8 @@ inline void FixedRandomSeed()
 inline void CustomRandomSeed(const size_t seed)
 {
   randGen.seed((uint32_t) seed);
+  randMasterSeed = seed;
+  ++randSeedEpoch;
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
@@ -82,7 +165,8 @@ inline void CustomRandomSeed(const size_t seed)
  */
 inline double Random()
 {
-  return randUniformDist(randGen);
+  static thread_local std::uniform_real_distribution<> dist(0.0, 1.0);
+  return dist(RandGen());
 }
 
 /**
@@ -90,7 +174,8 @@ inline double Random()
  */
 inline double Random(const double lo, const double hi)
 {
-  return lo + (hi - lo) * randUniformDist(randGen);
+  static thread_local std::uniform_real_distribution<> dist(0.0, 1.0);
+  return lo + (hi - lo) * dist(RandGen());
 }
 
 /**
@@ -109,7 +194,8 @@ inline double RandBernoulli(const double input)
  */
 inline int RandInt(const int hiExclusive)
 {
-  return (int) std::floor((double) hiExclusive * randUniformDist(randGen));
+  static thread_local std::uniform_real_distribution<> dist(0.0, 1.0);
+  return (int) std::floor((double) hiExclusive * dist(RandGen()));
 }
 
 /**
@@ -117,8 +203,9 @@ inline int RandInt(const int hiExclusive)
  */
 inline int RandInt(const int lo, const int hiExclusive)
 {
+  static thread_local std::uniform_real_distribution<> dist(0.0, 1.0);
   return lo + (int) std::floor((double) (hiExclusive - lo)
-                               * randUniformDist(randGen));
+                               * dist(RandGen()));
 }
 
 /**
@@ -126,7 +213,8 @@ inline int RandInt(const int lo, const int hiExclusive)
  */
 inline double RandNormal()
 {
-  return randNormalDist(randGen);
+  static thread_local std::normal_distribution<> dist(0.0, 1.0);
+  return dist(RandGen());
 }
 
 /**
@@ -138,7 +226,8 @@ inline double RandNormal()
  */
 inline double RandNormal(const double mean, const double variance)
 {
-  return variance * randNormalDist(randGen) + mean;
+  static thread_local std::normal_distribution<> dist(0.0, 1.0);
+  return variance * dist(RandGen()) + mean;
 }
 
 /**
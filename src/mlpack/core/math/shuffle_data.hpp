@@ -17,6 +17,85 @@
 namespace mlpack {
 namespace math {
 
+/**
+ * Apply a column permutation as a parallel gather, so that
+ * `output.col(i) = input.col(ordering[i])`.  The columns are copied in
+ * blocks, one contiguous output range per thread.  `input` and `output` must
+ * be distinct objects; use ApplyColumnPermutationInPlace() to permute a
+ * matrix without the second copy.  `ordering` may select a subset of the
+ * input columns, in which case `output` has `ordering.n_elem` columns.
+ */
+template<typename MatType>
+void ApplyColumnPermutation(const MatType& input,
+                            const arma::uvec& ordering,
+                            MatType& output)
+{
+  output.set_size(input.n_rows, ordering.n_elem);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) ordering.n_elem; ++i)
+    output.col(i) = input.col(ordering[i]);
+}
+
+/**
+ * Apply a column permutation in place, so that afterwards
+ * `matrix.col(i)` holds what `matrix.col(ordering[i])` held before.  The
+ * permutation is decomposed into its cycles first, and the cycles are then
+ * walked in parallel, each with a single column buffer, so no full copy of
+ * the matrix is ever made.
+ */
+template<typename MatType>
+void ApplyColumnPermutationInPlace(MatType& matrix,
+                                   const arma::uvec& ordering)
+{
+  // Decompose the permutation into its cycles; each cycle touches a disjoint
+  // set of columns, so the cycles can be walked in parallel afterwards.
+  std::vector<bool> visited(ordering.n_elem, false);
+  std::vector<size_t> cycleStarts;
+  for (size_t s = 0; s < ordering.n_elem; ++s)
+  {
+    if (visited[s])
+      continue;
+
+    if (ordering[s] != s)
+      cycleStarts.push_back(s);
+
+    size_t j = s;
+    do
+    {
+      visited[j] = true;
+      j = ordering[j];
+    } while (j != s);
+  }
+
+  #pragma omp parallel
+  {
+    // One column buffer per thread, reused across cycles.
+    arma::Col<typename MatType::elem_type> buffer(matrix.n_rows);
+
+    #pragma omp for
+    for (omp_size_t c = 0; c < (omp_size_t) cycleStarts.size(); ++c)
+    {
+      const size_t s = cycleStarts[c];
+      buffer = matrix.col(s);
+
+      size_t j = s;
+      while (true)
+      {
+        const size_t next = ordering[j];
+        if (next == s)
+        {
+          matrix.col(j) = buffer;
+          break;
+        }
+
+        matrix.col(j) = matrix.col(next);
+        j = next;
+      }
+    }
+  }
+}
+
 /**
  * Shuffle a dataset and associated labels (or responses).  It is expected that
  * inputPoints and inputLabels have the same number of columns (so, be sure that
@@ -36,8 +115,15 @@ void ShuffleData(const MatType& inputPoints,
   arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
       inputPoints.n_cols - 1, inputPoints.n_cols));
 
-  outputPoints = inputPoints.cols(ordering);
-  outputLabels = inputLabels.cols(ordering);
+  if (&inputPoints == &outputPoints)
+    ApplyColumnPermutationInPlace(outputPoints, ordering);
+  else
+    ApplyColumnPermutation(inputPoints, ordering, outputPoints);
+
+  if (&inputLabels == &outputLabels)
+    ApplyColumnPermutationInPlace(outputLabels, ordering);
+  else
+    ApplyColumnPermutation(inputLabels, ordering, outputLabels);
 }
 
 /**
@@ -125,7 +211,10 @@ void ShuffleData(const MatType& inputPoints,
       inputPoints.n_slices);
   outputLabelsPtr->set_size(inputLabels.n_rows, inputLabels.n_cols,
       inputLabels.n_slices);
-  for (size_t i = 0; i < ordering.n_elem; ++i)
+  // The ordering is a permutation, so each iteration writes to a different
+  // tube and the scatter can run in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) ordering.n_elem; ++i)
   {
     outputPointsPtr->tube(0, ordering[i], outputPointsPtr->n_rows - 1,
         ordering[i]) = inputPoints.tube(0, i, inputPoints.n_rows - 1, i);
@@ -170,9 +259,20 @@ void ShuffleData(const MatType& inputPoints,
   arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
       inputPoints.n_cols - 1, inputPoints.n_cols));
 
-  outputPoints = inputPoints.cols(ordering);
-  outputLabels = inputLabels.cols(ordering);
-  outputWeights = inputWeights.cols(ordering);
+  if (&inputPoints == &outputPoints)
+    ApplyColumnPermutationInPlace(outputPoints, ordering);
+  else
+    ApplyColumnPermutation(inputPoints, ordering, outputPoints);
+
+  if (&inputLabels == &outputLabels)
+    ApplyColumnPermutationInPlace(outputLabels, ordering);
+  else
+    ApplyColumnPermutation(inputLabels, ordering, outputLabels);
+
+  if (&inputWeights == &outputWeights)
+    ApplyColumnPermutationInPlace(outputWeights, ordering);
+  else
+    ApplyColumnPermutation(inputWeights, ordering, outputWeights);
 }
 
 /**
@@ -83,6 +83,50 @@ class LMetric
   static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
                                                const VecTypeB& b);
 
+  /**
+   * Computes the distances between one point and every column of a matrix
+   * block in a single call.  For the L1, L2 and squared L2 specializations
+   * the whole block is processed with one vectorized sweep instead of one
+   * expression per pair, which is considerably faster for the tight
+   * point-against-block loops of the tree base cases and of NaiveKMeans.
+   *
+   * @tparam VecType Type of the point (generally arma::vec).
+   * @tparam MatType Type of the matrix block.
+   * @param point The query point.
+   * @param block Matrix block; one distance is computed per column.
+   * @param results Vector of distances, one per column of the block.
+   */
+  template<typename VecType, typename MatType>
+  static void Evaluate(const VecType& point,
+                       const MatType& block,
+                       arma::Col<typename VecType::elem_type>& results);
+
+  /**
+   * Computes the distance between two points, abandoning the evaluation early
+   * once the distance is known to exceed the given bound.  The per-dimension
+   * contributions of an LMetric are nonnegative, so the running power sum only
+   * grows; it is checked against the bound after each block of dimensions and
+   * the remaining dimensions are skipped once it passes the bound.  This is a
+   * large win for high-dimensional exact nearest neighbor search, where most
+   * candidates can be discarded after a small prefix of the dimensions.
+   *
+   * If the distance is within the bound, the exact distance is returned
+   * (identically to Evaluate() up to floating-point summation order).
+   * Otherwise some value greater than the bound is returned that is a lower
+   * bound on the true distance.
+   *
+   * @param a First vector.
+   * @param b Second vector.
+   * @param bound Distance above which to abandon the evaluation.
+   * @return Distance between vectors a and b, or a lower bound on it that
+   *     exceeds bound.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type EvaluateEarlyAbandon(
+      const VecTypeA& a,
+      const VecTypeB& b,
+      const typename VecTypeA::elem_type bound);
+
   //! Serialize the metric (nothing to do).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
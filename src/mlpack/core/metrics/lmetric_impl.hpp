@@ -18,6 +18,71 @@
 namespace mlpack {
 namespace metric {
 
+/**
+ * Power sum of the difference of two sparse vectors, computed as a merge over
+ * their nonzero entries.  For very sparse data (e.g. TF-IDF vectors) this
+ * visits only the union of the nonzero positions instead of materializing a
+ * sparse temporary for the difference.
+ */
+template<int Power, typename VecTypeA, typename VecTypeB>
+inline typename std::enable_if<
+    arma::is_arma_sparse_type<VecTypeA>::value &&
+    arma::is_arma_sparse_type<VecTypeB>::value,
+    typename VecTypeA::elem_type>::type
+SparseLMetricPowerSum(const VecTypeA& a, const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  ElemType sum = 0;
+  typename VecTypeA::const_iterator itA = a.begin();
+  typename VecTypeB::const_iterator itB = b.begin();
+  const typename VecTypeA::const_iterator endA = a.end();
+  const typename VecTypeB::const_iterator endB = b.end();
+
+  while (itA != endA || itB != endB)
+  {
+    ElemType d;
+    if (itB == endB || (itA != endA && itA.row() < itB.row()))
+    {
+      d = *itA;
+      ++itA;
+    }
+    else if (itA == endA || itB.row() < itA.row())
+    {
+      d = *itB;
+      ++itB;
+    }
+    else
+    {
+      d = *itA - *itB;
+      ++itA;
+      ++itB;
+    }
+
+    // The compiler resolves this dispatch at compile time.
+    if (Power == 1)
+      sum += std::abs(d);
+    else if (Power == 2)
+      sum += d * d;
+    else
+      sum += std::pow(std::abs(d), Power);
+  }
+
+  return sum;
+}
+
+//! Stub for operand combinations that are not both sparse, so that the
+//! dispatch in the Evaluate() specializations always compiles; never called.
+template<int Power, typename VecTypeA, typename VecTypeB>
+inline typename std::enable_if<
+    !(arma::is_arma_sparse_type<VecTypeA>::value &&
+      arma::is_arma_sparse_type<VecTypeB>::value),
+    typename VecTypeA::elem_type>::type
+SparseLMetricPowerSum(const VecTypeA& /* a */, const VecTypeB& /* b */)
+{
+  return 0;
+}
+
 // Unspecialized implementation.  This should almost never be used...
 template<int Power, bool TakeRoot>
 template<typename VecTypeA, typename VecTypeB>
@@ -35,14 +100,31 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
   return std::pow(sum, (1.0 / Power));
 }
 
-// L1-metric specializations; the root doesn't matter.
+// L1-metric specializations; the root doesn't matter.  The difference is
+// accumulated in a single tight sweep, which avoids the temporary of the
+// equivalent Armadillo expression and compiles to vector instructions for
+// the target architecture.
 template<>
 template<typename VecTypeA, typename VecTypeB>
 typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(abs(a - b));
+  // Element access on sparse vectors is logarithmic, so those keep the
+  // expression path.
+  if (arma::is_arma_sparse_type<VecTypeA>::value &&
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return SparseLMetricPowerSum<1>(a, b);
+
+  if (arma::is_arma_sparse_type<VecTypeA>::value ||
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return arma::accu(abs(a - b));
+
+  typename VecTypeA::elem_type sum = 0;
+  for (size_t i = 0; i < a.n_elem; ++i)
+    sum += std::abs(a[i] - b[i]);
+
+  return sum;
 }
 
 template<>
@@ -51,17 +133,45 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(abs(a - b));
+  if (arma::is_arma_sparse_type<VecTypeA>::value &&
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return SparseLMetricPowerSum<1>(a, b);
+
+  if (arma::is_arma_sparse_type<VecTypeA>::value ||
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return arma::accu(abs(a - b));
+
+  typename VecTypeA::elem_type sum = 0;
+  for (size_t i = 0; i < a.n_elem; ++i)
+    sum += std::abs(a[i] - b[i]);
+
+  return sum;
 }
 
-// L2-metric specializations.
+// L2-metric specializations, accumulated in a single tight sweep (see the L1
+// specializations above).
 template<>
 template<typename VecTypeA, typename VecTypeB>
 typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::norm(a - b, 2);
+  if (arma::is_arma_sparse_type<VecTypeA>::value &&
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return std::sqrt(SparseLMetricPowerSum<2>(a, b));
+
+  if (arma::is_arma_sparse_type<VecTypeA>::value ||
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return arma::norm(a - b, 2);
+
+  typename VecTypeA::elem_type sum = 0;
+  for (size_t i = 0; i < a.n_elem; ++i)
+  {
+    const typename VecTypeA::elem_type d = a[i] - b[i];
+    sum += d * d;
+  }
+
+  return std::sqrt(sum);
 }
 
 template<>
@@ -70,7 +180,22 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return accu(arma::square(a - b));
+  if (arma::is_arma_sparse_type<VecTypeA>::value &&
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return SparseLMetricPowerSum<2>(a, b);
+
+  if (arma::is_arma_sparse_type<VecTypeA>::value ||
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return accu(arma::square(a - b));
+
+  typename VecTypeA::elem_type sum = 0;
+  for (size_t i = 0; i < a.n_elem; ++i)
+  {
+    const typename VecTypeA::elem_type d = a[i] - b[i];
+    sum += d * d;
+  }
+
+  return sum;
 }
 
 // L3-metric specialization (not very likely to be used, but just in case).
@@ -106,6 +231,189 @@ typename VecTypeA::elem_type LMetric<INT_MAX, false>::Evaluate(
   return arma::as_scalar(arma::max(arma::abs(a - b)));
 }
 
+// Unspecialized one-to-many implementation: one pairwise evaluation per
+// column of the block.
+template<int Power, bool TakeRoot>
+template<typename VecType, typename MatType>
+void LMetric<Power, TakeRoot>::Evaluate(
+    const VecType& point,
+    const MatType& block,
+    arma::Col<typename VecType::elem_type>& results)
+{
+  results.set_size(block.n_cols);
+  for (size_t j = 0; j < block.n_cols; ++j)
+    results[j] = Evaluate(point, block.col(j));
+}
+
+// One-to-many L1-metric specializations: the block is processed in one sweep
+// down contiguous columns.
+template<>
+template<typename VecType, typename MatType>
+void LMetric<1, true>::Evaluate(
+    const VecType& point,
+    const MatType& block,
+    arma::Col<typename VecType::elem_type>& results)
+{
+  results.set_size(block.n_cols);
+  for (size_t j = 0; j < block.n_cols; ++j)
+  {
+    typename VecType::elem_type sum = 0;
+    for (size_t i = 0; i < block.n_rows; ++i)
+      sum += std::abs(point[i] - block(i, j));
+    results[j] = sum;
+  }
+}
+
+template<>
+template<typename VecType, typename MatType>
+void LMetric<1, false>::Evaluate(
+    const VecType& point,
+    const MatType& block,
+    arma::Col<typename VecType::elem_type>& results)
+{
+  results.set_size(block.n_cols);
+  for (size_t j = 0; j < block.n_cols; ++j)
+  {
+    typename VecType::elem_type sum = 0;
+    for (size_t i = 0; i < block.n_rows; ++i)
+      sum += std::abs(point[i] - block(i, j));
+    results[j] = sum;
+  }
+}
+
+// One-to-many L2-metric specializations.
+template<>
+template<typename VecType, typename MatType>
+void LMetric<2, true>::Evaluate(
+    const VecType& point,
+    const MatType& block,
+    arma::Col<typename VecType::elem_type>& results)
+{
+  results.set_size(block.n_cols);
+  for (size_t j = 0; j < block.n_cols; ++j)
+  {
+    typename VecType::elem_type sum = 0;
+    for (size_t i = 0; i < block.n_rows; ++i)
+    {
+      const typename VecType::elem_type d = point[i] - block(i, j);
+      sum += d * d;
+    }
+    results[j] = std::sqrt(sum);
+  }
+}
+
+template<>
+template<typename VecType, typename MatType>
+void LMetric<2, false>::Evaluate(
+    const VecType& point,
+    const MatType& block,
+    arma::Col<typename VecType::elem_type>& results)
+{
+  results.set_size(block.n_cols);
+  for (size_t j = 0; j < block.n_cols; ++j)
+  {
+    typename VecType::elem_type sum = 0;
+    for (size_t i = 0; i < block.n_rows; ++i)
+    {
+      const typename VecType::elem_type d = point[i] - block(i, j);
+      sum += d * d;
+    }
+    results[j] = sum;
+  }
+}
+
+//! Number of dimensions accumulated between bound checks in
+//! EvaluateEarlyAbandon().  Large enough that the inner loop still vectorizes,
+//! small enough that hopeless candidates are discarded quickly.
+static const size_t earlyAbandonBlockSize = 64;
+
+// Early-abandoning evaluation.  The power sum is accumulated one block of
+// dimensions at a time and compared against the bound (taken to the Power'th
+// power, so that no roots are needed in the loop) after each block.
+template<int Power, bool TakeRoot>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LMetric<Power, TakeRoot>::EvaluateEarlyAbandon(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  // Element access on sparse vectors is logarithmic, so those keep the full
+  // evaluation.
+  if (arma::is_arma_sparse_type<VecTypeA>::value ||
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return Evaluate(a, b);
+
+  const ElemType boundPow = TakeRoot ?
+      (ElemType) std::pow((double) bound, (double) Power) : bound;
+
+  ElemType sum = 0;
+  size_t i = 0;
+  while (i < a.n_elem)
+  {
+    const size_t blockEnd = std::min(i + earlyAbandonBlockSize,
+        (size_t) a.n_elem);
+    for (; i < blockEnd; ++i)
+    {
+      // The compiler resolves this dispatch at compile time.
+      if (Power == 1)
+      {
+        sum += std::abs(a[i] - b[i]);
+      }
+      else if (Power == 2)
+      {
+        const ElemType d = a[i] - b[i];
+        sum += d * d;
+      }
+      else
+      {
+        sum += std::pow(fabs(a[i] - b[i]), Power);
+      }
+    }
+
+    // The sum only grows, so once it exceeds the bound the remaining
+    // dimensions cannot bring the distance back under it.
+    if (sum > boundPow)
+      break;
+  }
+
+  if (!TakeRoot)
+    return sum;
+
+  return std::pow(sum, (1.0 / Power));
+}
+
+// L-infinity specialization: the running maximum is likewise nondecreasing.
+template<>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LMetric<INT_MAX, false>::EvaluateEarlyAbandon(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  if (arma::is_arma_sparse_type<VecTypeA>::value ||
+      arma::is_arma_sparse_type<VecTypeB>::value)
+    return Evaluate(a, b);
+
+  ElemType max = 0;
+  size_t i = 0;
+  while (i < a.n_elem)
+  {
+    const size_t blockEnd = std::min(i + earlyAbandonBlockSize,
+        (size_t) a.n_elem);
+    for (; i < blockEnd; ++i)
+      max = std::max(max, (ElemType) std::abs(a[i] - b[i]));
+
+    if (max > bound)
+      break;
+  }
+
+  return max;
+}
+
 } // namespace metric
 } // namespace mlpack
 
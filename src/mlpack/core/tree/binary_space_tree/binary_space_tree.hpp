@@ -564,6 +564,36 @@ class BinarySpaceTree
    */
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
+
+  /**
+   * Save the tree to the given stream in a flat, sectioned binary format:
+   * a fixed-size header, then the node structure (indices and distances) in
+   * breadth-first order, then all bounds in one contiguous block, then the
+   * dataset as one raw column-major block.  Unlike serialize(), which walks
+   * the node graph through cereal one node at a time, every section is
+   * written (and read back by LoadFlat()) with a single bulk transfer, so
+   * loading a large tree is limited by I/O bandwidth rather than archive
+   * overhead.
+   *
+   * This format requires rectangle-type bounds (bounds accessed per
+   * dimension with Lo()/Hi(), as in HRectBound) and a dense dataset matrix.
+   * Node statistics are not stored; they are reconstructed on load the same
+   * way a fresh tree build would construct them.  Must be called on the root
+   * of the tree, with a stream opened in binary mode.
+   *
+   * @param os Stream to write the tree to.
+   */
+  void SaveFlat(std::ostream& os) const;
+
+  /**
+   * Load a tree previously written by SaveFlat(), returning the newly
+   * allocated root (the caller takes ownership; the tree owns its dataset).
+   * Throws a std::runtime_error if the stream does not hold a compatible
+   * flat tree (wrong magic, element type, or truncated sections).
+   *
+   * @param is Stream to read the tree from (opened in binary mode).
+   */
+  static BinarySpaceTree* LoadFlat(std::istream& is);
 };
 
 } // namespace tree
@@ -15,11 +15,16 @@
 #include "binary_space_tree.hpp"
 
 #include <mlpack/core/util/log.hpp>
+#include <algorithm>
 #include <queue>
 
 namespace mlpack {
 namespace tree {
 
+//! Subtrees with fewer points than this are built serially: below this size,
+//! OpenMP task overhead outweighs the benefit of another worker.
+static const size_t minParallelBuildSize = 8192;
+
 // Each of these overloads is kept as a separate function to keep the overhead
 // from the two std::vectors out, if possible.
 template<typename MetricType,
@@ -904,10 +909,31 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+  // Each child operates on a disjoint column range of the dataset, so large
+  // subtrees can be built concurrently as OpenMP tasks; the root establishes
+  // the thread team that the subtree tasks run on.
+  auto buildChildren = [&]()
+  {
+    #pragma omp task default(shared) \
+        if (splitCol - begin >= minParallelBuildSize)
+    left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
+        maxLeafSize);
+
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        splitter, maxLeafSize);
+    #pragma omp taskwait
+  };
+
+  if (parent == NULL)
+  {
+    #pragma omp parallel if (count >= minParallelBuildSize)
+    #pragma omp single nowait
+    buildChildren();
+  }
+  else
+  {
+    buildChildren();
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -972,10 +998,31 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  // The children write to disjoint ranges of both the dataset and the
+  // oldFromNew mapping, so subtree construction parallelizes as in the
+  // mapping-free overload above.
+  auto buildChildren = [&]()
+  {
+    #pragma omp task default(shared) \
+        if (splitCol - begin >= minParallelBuildSize)
+    left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
+        splitter, maxLeafSize);
+
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        oldFromNew, splitter, maxLeafSize);
+    #pragma omp taskwait
+  };
+
+  if (parent == NULL)
+  {
+    #pragma omp parallel if (count >= minParallelBuildSize)
+    #pragma omp single nowait
+    buildChildren();
+  }
+  else
+  {
+    buildChildren();
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -1002,8 +1049,42 @@ template<typename BoundType2>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 UpdateBound(BoundType2& boundToUpdate)
 {
-  if (count > 0)
-    boundToUpdate |= dataset->cols(begin, begin + count - 1);
+  if (count == 0)
+    return;
+
+#ifdef HAS_OPENMP
+  // For the top levels of a large build, the bound scan is a significant
+  // sequential cost, so compute per-thread partial bounds over column chunks
+  // and merge them.  Inside subtree tasks this region is nested and runs on
+  // one thread, which is the behavior we want there anyway.
+  if (count >= minParallelBuildSize && !omp_in_parallel())
+  {
+    // Snapshot the initial state so no thread reads boundToUpdate while
+    // another merges into it.
+    const BoundType2 initialBound = boundToUpdate;
+
+    #pragma omp parallel
+    {
+      const size_t numThreads = (size_t) omp_get_num_threads();
+      const size_t tid = (size_t) omp_get_thread_num();
+      const size_t chunk = (count + numThreads - 1) / numThreads;
+      const size_t chunkBegin = begin + tid * chunk;
+      const size_t chunkEnd = std::min(begin + count, chunkBegin + chunk);
+
+      if (chunkBegin < chunkEnd)
+      {
+        BoundType2 localBound = initialBound;
+        localBound |= dataset->cols(chunkBegin, chunkEnd - 1);
+
+        #pragma omp critical (BinarySpaceTreeBoundUpdate)
+        boundToUpdate |= localBound;
+      }
+    }
+    return;
+  }
+#endif
+
+  boundToUpdate |= dataset->cols(begin, begin + count - 1);
 }
 
 template<typename MetricType,
@@ -1136,6 +1217,173 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   }
 }
 
+//! The magic bytes identifying a flat tree file (version 1).
+static const char flatTreeMagic[8] =
+    { 'm', 'l', 'p', 'k', 'b', 's', 'p', '1' };
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    SaveFlat(std::ostream& os) const
+{
+  // Enumerate the nodes in breadth-first order, recording the index each
+  // child will get (0 means "no child"; the root is index 0, so it can never
+  // be a child).
+  std::vector<const BinarySpaceTree*> order(1, this);
+  std::vector<uint64_t> leftIndices, rightIndices;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    const BinarySpaceTree* node = order[i];
+    leftIndices.push_back((node->left != NULL) ? (uint64_t) order.size() : 0);
+    if (node->left != NULL)
+      order.push_back(node->left);
+    rightIndices.push_back((node->right != NULL) ? (uint64_t) order.size() :
+        0);
+    if (node->right != NULL)
+      order.push_back(node->right);
+  }
+
+  const uint64_t numNodes = (uint64_t) order.size();
+  const uint64_t dims = (uint64_t) bound.Dim();
+  const uint64_t elemSize = (uint64_t) sizeof(ElemType);
+  const uint64_t numPoints = (uint64_t) dataset->n_cols;
+
+  // Gather each section into one contiguous buffer, so that the file is laid
+  // out (and later read back) as a few large sequential blocks.
+  std::vector<uint64_t> nodeInfo(4 * numNodes);
+  std::vector<ElemType> nodeDistances(4 * numNodes);
+  std::vector<ElemType> bounds(2 * dims * numNodes);
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    const BinarySpaceTree* node = order[i];
+    nodeInfo[4 * i + 0] = (uint64_t) node->begin;
+    nodeInfo[4 * i + 1] = (uint64_t) node->count;
+    nodeInfo[4 * i + 2] = leftIndices[i];
+    nodeInfo[4 * i + 3] = rightIndices[i];
+
+    nodeDistances[4 * i + 0] = node->parentDistance;
+    nodeDistances[4 * i + 1] = node->furthestDescendantDistance;
+    nodeDistances[4 * i + 2] = node->minimumBoundDistance;
+    nodeDistances[4 * i + 3] = node->bound.MinWidth();
+
+    for (size_t d = 0; d < dims; ++d)
+    {
+      bounds[2 * dims * i + d] = node->bound[d].Lo();
+      bounds[2 * dims * i + dims + d] = node->bound[d].Hi();
+    }
+  }
+
+  os.write(flatTreeMagic, sizeof(flatTreeMagic));
+  os.write((const char*) &elemSize, sizeof(elemSize));
+  os.write((const char*) &dims, sizeof(dims));
+  os.write((const char*) &numNodes, sizeof(numNodes));
+  os.write((const char*) &numPoints, sizeof(numPoints));
+
+  os.write((const char*) nodeInfo.data(),
+      nodeInfo.size() * sizeof(uint64_t));
+  os.write((const char*) nodeDistances.data(),
+      nodeDistances.size() * sizeof(ElemType));
+  os.write((const char*) bounds.data(), bounds.size() * sizeof(ElemType));
+  os.write((const char*) dataset->memptr(),
+      dataset->n_elem * sizeof(ElemType));
+
+  if (!os)
+    throw std::runtime_error("BinarySpaceTree::SaveFlat(): write failed!");
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    LoadFlat(std::istream& is)
+{
+  char magic[8];
+  uint64_t elemSize, dims, numNodes, numPoints;
+  is.read(magic, sizeof(magic));
+  is.read((char*) &elemSize, sizeof(elemSize));
+  is.read((char*) &dims, sizeof(dims));
+  is.read((char*) &numNodes, sizeof(numNodes));
+  is.read((char*) &numPoints, sizeof(numPoints));
+  if (!is || !std::equal(magic, magic + sizeof(magic), flatTreeMagic))
+  {
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): stream does not "
+        "hold a flat tree!");
+  }
+  if (elemSize != (uint64_t) sizeof(ElemType))
+  {
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): element type size "
+        "mismatch!");
+  }
+
+  // Read every section with one bulk transfer each, before any node is
+  // allocated, so a truncated file cannot leak a half-built tree.
+  std::vector<uint64_t> nodeInfo(4 * numNodes);
+  std::vector<ElemType> nodeDistances(4 * numNodes);
+  std::vector<ElemType> bounds(2 * dims * numNodes);
+  MatType data(dims, numPoints);
+  is.read((char*) nodeInfo.data(), nodeInfo.size() * sizeof(uint64_t));
+  is.read((char*) nodeDistances.data(),
+      nodeDistances.size() * sizeof(ElemType));
+  is.read((char*) bounds.data(), bounds.size() * sizeof(ElemType));
+  is.read((char*) data.memptr(), data.n_elem * sizeof(ElemType));
+  if (!is)
+  {
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): truncated flat "
+        "tree!");
+  }
+
+  MatType* dataset = new MatType(std::move(data));
+
+  // Allocate all of the nodes, then wire up the structure.
+  std::vector<BinarySpaceTree*> nodes(numNodes);
+  for (size_t i = 0; i < numNodes; ++i)
+    nodes[i] = new BinarySpaceTree();
+
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    BinarySpaceTree* node = nodes[i];
+    node->begin = (size_t) nodeInfo[4 * i + 0];
+    node->count = (size_t) nodeInfo[4 * i + 1];
+    const size_t leftIndex = (size_t) nodeInfo[4 * i + 2];
+    const size_t rightIndex = (size_t) nodeInfo[4 * i + 3];
+    node->left = (leftIndex != 0) ? nodes[leftIndex] : NULL;
+    node->right = (rightIndex != 0) ? nodes[rightIndex] : NULL;
+    if (node->left != NULL)
+      node->left->parent = node;
+    if (node->right != NULL)
+      node->right->parent = node;
+
+    node->parentDistance = nodeDistances[4 * i + 0];
+    node->furthestDescendantDistance = nodeDistances[4 * i + 1];
+    node->minimumBoundDistance = nodeDistances[4 * i + 2];
+
+    node->bound = BoundType<MetricType>((size_t) dims);
+    for (size_t d = 0; d < dims; ++d)
+    {
+      node->bound[d].Lo() = bounds[2 * dims * i + d];
+      node->bound[d].Hi() = bounds[2 * dims * i + dims + d];
+    }
+    node->bound.MinWidth() = nodeDistances[4 * i + 3];
+
+    node->dataset = dataset;
+  }
+
+  // Statistics are not stored in the file; rebuild them the same way a
+  // fresh tree build would.
+  for (size_t i = 0; i < numNodes; ++i)
+    nodes[i]->stat = StatisticType(*nodes[i]);
+
+  return nodes[0];
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,371 @@
+/**
+ * @file core/tree/binary_space_tree/flat_tree.hpp
+ * @author Ryan Curtin
+ *
+ * A frozen, cache-friendly repacking of a built BinarySpaceTree.  Nodes are
+ * laid out contiguously in depth-first order with children addressed by
+ * index, and the rectangular bounds live in two dense structure-of-arrays
+ * matrices, so traversal streams through memory instead of chasing
+ * heap-scattered node pointers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * FlatTree is a read-only "frozen" form of a built BinarySpaceTree with
+ * rectangular bounds (i.e. KDTree or similar).  Freezing copies the tree
+ * structure into flat arrays:
+ *
+ *  - per-node begin/count/children records, contiguous in depth-first order,
+ *    with the left child always immediately following its parent (so the
+ *    common descend-left step touches the next cache line);
+ *  - the bound hyperrectangles in two (dimensions x numNodes) matrices of
+ *    lower and upper bounds; and
+ *  - the leaf points, copied into per-leaf contiguous blocks padded to a
+ *    fixed block width, so the base case runs a dense blocked distance
+ *    kernel that the compiler can vectorize.  Padding columns are filled
+ *    with infinite coordinates and so can never enter the result lists.
+ *
+ * Each packed leaf column carries its result index.  If the tree was built
+ * with an oldFromNew mapping, passing that mapping to the constructor makes
+ * the search emit original dataset indices directly, removing the usual
+ * unmapping pass over the results.
+ *
+ * The frozen form is self-contained (the packed blocks are copies), and
+ * provides a single-tree k-NN search for the tree's metric that visits
+ * children in best-first order with standard bound pruning; the hot loop is
+ * index arithmetic over the flat arrays, with no pointer chasing.
+ *
+ * @code
+ * KDTree<> tree(dataset);
+ * FlatTree<KDTree<>> frozen(tree);
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * frozen.Search(querySet, 3, neighbors, distances);
+ * @endcode
+ *
+ * @tparam TreeType Type of the (bound-rectangular) tree to freeze.
+ * @tparam MetricType Metric the tree was built with (default Euclidean).
+ */
+template<typename TreeType, typename MetricType = metric::LMetric<2, true>>
+class FlatTree
+{
+ public:
+  //! The type of element held by the tree's dataset.
+  typedef typename TreeType::Mat MatType;
+  typedef typename MatType::elem_type ElemType;
+
+  //! Number of columns each leaf block is padded to a multiple of.
+  static const size_t BlockWidth = 8;
+
+  /**
+   * Freeze the given built tree.  The tree itself is not modified and is not
+   * needed afterwards; search results are indices into the tree's reordered
+   * dataset, exactly as for the tree itself.
+   *
+   * @param tree Built tree to freeze.
+   */
+  FlatTree(const TreeType& tree) :
+      dataset(tree.Dataset()),
+      numNodes(0)
+  {
+    Build(tree, NULL);
+  }
+
+  /**
+   * Freeze the given built tree, emitting results in original (pre-build)
+   * dataset indices.  Pass the oldFromNew mapping that the tree produced at
+   * build time; the packed leaf columns then carry original indices, so
+   * searches need no unmapping pass.
+   *
+   * @param tree Built tree to freeze.
+   * @param oldFromNew Mapping from reordered to original point indices.
+   */
+  FlatTree(const TreeType& tree, const std::vector<size_t>& oldFromNew) :
+      dataset(tree.Dataset()),
+      numNodes(0)
+  {
+    Build(tree, &oldFromNew);
+  }
+
+  /**
+   * Search for the k nearest neighbors of every column of the given query
+   * set.  Indices returned are into the tree's (reordered) dataset, or into
+   * the original dataset if an oldFromNew mapping was given at construction.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to find.
+   * @param neighbors Matrix to store neighbor indices in (k x numQueries).
+   * @param distances Matrix to store neighbor distances in (k x numQueries).
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances) const
+  {
+    neighbors.set_size(k, querySet.n_cols);
+    distances.set_size(k, querySet.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
+      SearchSingle(querySet.colptr(q), k, neighbors.colptr(q),
+          distances.colptr(q));
+  }
+
+  //! Get the number of nodes in the frozen tree.
+  size_t NumNodes() const { return numNodes; }
+
+ private:
+  //! Size the arrays, copy the node records, and pack the leaf blocks.
+  void Build(const TreeType& tree, const std::vector<size_t>* oldFromNew)
+  {
+    // Count the nodes so the arrays can be sized exactly.
+    size_t count = 0;
+    CountNodes(tree, count);
+
+    begins.resize(count);
+    counts.resize(count);
+    lefts.resize(count);
+    rights.resize(count);
+    leafOffsets.resize(count);
+    loBounds.set_size(dataset.n_rows, count);
+    hiBounds.set_size(dataset.n_rows, count);
+
+    BuildRecords(tree);
+    PackLeaves(oldFromNew);
+  }
+
+  //! Count the nodes of the subtree rooted at the given node.
+  void CountNodes(const TreeType& node, size_t& count) const
+  {
+    ++count;
+    for (size_t i = 0; i < node.NumChildren(); ++i)
+      CountNodes(node.Child(i), count);
+  }
+
+  //! Copy each leaf's points into a contiguous block padded to a multiple of
+  //! BlockWidth columns, recording each column's result index.
+  void PackLeaves(const std::vector<size_t>* oldFromNew)
+  {
+    // Size the packed storage: every leaf is padded up to BlockWidth.
+    size_t paddedTotal = 0;
+    for (size_t node = 0; node < numNodes; ++node)
+      if (lefts[node] == node)
+        paddedTotal += PaddedCount(node);
+
+    // Padding columns get infinite coordinates: their distance to any query
+    // is infinite, so they can never displace a real candidate.
+    leafPoints.set_size(dataset.n_rows, paddedTotal);
+    leafPoints.fill(std::numeric_limits<ElemType>::infinity());
+    pointIds.assign(paddedTotal, SIZE_MAX);
+
+    size_t offset = 0;
+    for (size_t node = 0; node < numNodes; ++node)
+    {
+      if (lefts[node] != node)
+        continue;
+
+      leafOffsets[node] = offset;
+      for (size_t j = 0; j < counts[node]; ++j)
+      {
+        const size_t point = begins[node] + j;
+        leafPoints.col(offset + j) = dataset.col(point);
+        pointIds[offset + j] = oldFromNew ? (*oldFromNew)[point] : point;
+      }
+
+      offset += PaddedCount(node);
+    }
+  }
+
+  //! The number of packed columns of a leaf, padded to BlockWidth.
+  size_t PaddedCount(const size_t node) const
+  {
+    return ((counts[node] + BlockWidth - 1) / BlockWidth) * BlockWidth;
+  }
+
+  //! Copy the subtree rooted at `node` into the arrays, returning its index.
+  size_t BuildRecords(const TreeType& node)
+  {
+    const size_t index = numNodes++;
+
+    begins[index] = node.Begin();
+    counts[index] = node.Count();
+
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      loBounds(d, index) = node.Bound()[d].Lo();
+      hiBounds(d, index) = node.Bound()[d].Hi();
+    }
+
+    if (node.NumChildren() == 2)
+    {
+      // Depth-first order: the left child lands at index + 1.
+      lefts[index] = BuildRecords(node.Child(0));
+      rights[index] = BuildRecords(node.Child(1));
+    }
+    else
+    {
+      lefts[index] = index; // Self-reference marks a leaf.
+      rights[index] = index;
+    }
+
+    return index;
+  }
+
+  //! Minimum metric distance from the query point to the node's bound.
+  ElemType MinDistance(const ElemType* query, const size_t node) const
+  {
+    const ElemType* lo = loBounds.colptr(node);
+    const ElemType* hi = hiBounds.colptr(node);
+
+    // Per-dimension clamp-and-accumulate; dense and branch-light so the
+    // compiler can vectorize it.
+    ElemType sum = 0;
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      const ElemType v = query[d];
+      const ElemType excess = std::max(lo[d] - v, (ElemType) 0) +
+          std::max(v - hi[d], (ElemType) 0);
+      sum += std::pow(excess, MetricType::Power);
+    }
+
+    if (MetricType::TakeRoot)
+      return (ElemType) std::pow(sum, 1.0 / MetricType::Power);
+    return sum;
+  }
+
+  //! Recursive best-first descent for one query point.
+  void SearchSingle(const ElemType* query,
+                    const size_t k,
+                    size_t* neighbors,
+                    ElemType* distances) const
+  {
+    // Fixed-size candidate list, kept sorted (k is small in practice).
+    for (size_t i = 0; i < k; ++i)
+    {
+      neighbors[i] = SIZE_MAX;
+      distances[i] = std::numeric_limits<ElemType>::max();
+    }
+
+    RecurseSingle(query, k, neighbors, distances, 0);
+  }
+
+  void RecurseSingle(const ElemType* query,
+                     const size_t k,
+                     size_t* neighbors,
+                     ElemType* distances,
+                     const size_t node) const
+  {
+    if (lefts[node] == node)
+    {
+      // Leaf: run the blocked base-case kernel over the packed point block.
+      // Distances for a whole block of BlockWidth columns are computed in a
+      // dense, branch-free loop before any of them touch the candidate list;
+      // padding columns come out infinite and are rejected like any other
+      // too-distant point.
+      const size_t dims = dataset.n_rows;
+      const size_t padded = PaddedCount(node);
+      ElemType blockDist[BlockWidth];
+      for (size_t block = 0; block < padded; block += BlockWidth)
+      {
+        const ElemType* points = leafPoints.colptr(leafOffsets[node] + block);
+
+        for (size_t j = 0; j < BlockWidth; ++j)
+        {
+          const ElemType* p = points + j * dims;
+          ElemType sum = 0;
+          for (size_t d = 0; d < dims; ++d)
+          {
+            const ElemType diff = p[d] - query[d];
+            if (MetricType::Power == 1)
+              sum += std::fabs(diff);
+            else if (MetricType::Power == 2)
+              sum += diff * diff;
+            else
+              sum += std::pow(std::fabs(diff), (ElemType) MetricType::Power);
+          }
+
+          if (MetricType::Power != 1 && MetricType::TakeRoot)
+            blockDist[j] = (ElemType) std::pow((double) sum,
+                1.0 / (double) MetricType::Power);
+          else
+            blockDist[j] = sum;
+        }
+
+        for (size_t j = 0; j < BlockWidth; ++j)
+        {
+          const ElemType dist = blockDist[j];
+          if (dist < distances[k - 1])
+          {
+            // Insert into the sorted candidate list.
+            size_t i = k - 1;
+            while (i > 0 && distances[i - 1] > dist)
+            {
+              distances[i] = distances[i - 1];
+              neighbors[i] = neighbors[i - 1];
+              --i;
+            }
+            distances[i] = dist;
+            neighbors[i] = pointIds[leafOffsets[node] + block + j];
+          }
+        }
+      }
+      return;
+    }
+
+    // Visit the nearer child first; prune with the flat bound arrays.
+    const size_t left = lefts[node];
+    const size_t right = rights[node];
+    const ElemType leftDist = MinDistance(query, left);
+    const ElemType rightDist = MinDistance(query, right);
+
+    const size_t first = (leftDist <= rightDist) ? left : right;
+    const size_t second = (leftDist <= rightDist) ? right : left;
+    const ElemType firstDist = std::min(leftDist, rightDist);
+    const ElemType secondDist = std::max(leftDist, rightDist);
+
+    if (firstDist < distances[k - 1])
+      RecurseSingle(query, k, neighbors, distances, first);
+    if (secondDist < distances[k - 1])
+      RecurseSingle(query, k, neighbors, distances, second);
+  }
+
+  //! The tree's (reordered) dataset.
+  const MatType& dataset;
+
+  //! Number of nodes in the frozen tree.
+  size_t numNodes;
+  //! Index of the first point of each node.
+  std::vector<size_t> begins;
+  //! Number of points held by each node.
+  std::vector<size_t> counts;
+  //! Index of each node's left child (self-index for leaves).
+  std::vector<size_t> lefts;
+  //! Index of each node's right child (self-index for leaves).
+  std::vector<size_t> rights;
+  //! Offset of each leaf's packed point block in leafPoints.
+  std::vector<size_t> leafOffsets;
+  //! The leaf points, one padded contiguous block per leaf.
+  arma::Mat<ElemType> leafPoints;
+  //! The result index carried by each packed column (SIZE_MAX for padding).
+  std::vector<size_t> pointIds;
+  //! Lower bound of each node, one column per node.
+  arma::Mat<ElemType> loBounds;
+  //! Upper bound of each node, one column per node.
+  arma::Mat<ElemType> hiBounds;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,7 @@
 #define MLPACK_CORE_TREE_BINARY_SPACE_TREE_MEAN_SPLIT_IMPL_HPP
 
 #include "mean_split.hpp"
+#include "split_statistics_scan.hpp"
 
 namespace mlpack {
 namespace tree {
@@ -25,6 +26,8 @@ bool MeanSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
                                               const size_t count,
                                               SplitInfo& splitInfo)
 {
+  typedef typename MatType::elem_type ElemType;
+
   double maxWidth = -1;
 
   splitInfo.splitDimension = data.n_rows; // Indicate invalid.
@@ -43,28 +46,27 @@ bool MeanSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
         splitInfo.splitDimension = d;
       }
     }
+
+    if (maxWidth == 0) // All these points are the same.  We can't split.
+      return false;
+
+    // Split in the mean of that dimension.
+    splitInfo.splitVal = 0.0;
+    for (size_t i = begin; i < begin + count; ++i)
+      splitInfo.splitVal += data(splitInfo.splitDimension, i);
+    splitInfo.splitVal /= count;
   }
   else
   {
-    // We must individually calculate bounding boxes.
-    math::Range* ranges = new math::Range[data.n_rows];
-    for (size_t i = begin; i < begin + count; ++i)
-    {
-      // Expand each dimension as necessary.
-      for (size_t d = 0; d < data.n_rows; ++d)
-      {
-        const double val = data(d, i);
-        if (val < ranges[d].Lo())
-          ranges[d].Lo() = val;
-        if (val > ranges[d].Hi())
-          ranges[d].Hi() = val;
-      }
-    }
+    // We must calculate the bounding box ourselves; gather the per-dimension
+    // extrema and sums in one fused pass so the mean needs no second sweep.
+    arma::Col<ElemType> mins, maxs, sums;
+    SplitStatisticsScan(data, begin, count, mins, maxs, sums);
 
     // Now, which is the widest?
     for (size_t d = 0; d < data.n_rows; d++)
     {
-      const double width = ranges[d].Width();
+      const double width = (double) (maxs[d] - mins[d]);
       if (width > maxWidth)
       {
         maxWidth = width;
@@ -72,17 +74,12 @@ bool MeanSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
       }
     }
 
-    delete[] ranges;
-  }
-
-  if (maxWidth == 0) // All these points are the same.  We can't split.
-    return false;
+    if (maxWidth == 0) // All these points are the same.  We can't split.
+      return false;
 
-  // Split in the mean of that dimension.
-  splitInfo.splitVal = 0.0;
-  for (size_t i = begin; i < begin + count; ++i)
-    splitInfo.splitVal += data(splitInfo.splitDimension, i);
-  splitInfo.splitVal /= count;
+    // Split in the mean of that dimension.
+    splitInfo.splitVal = (double) sums[splitInfo.splitDimension] / count;
+  }
 
   Log::Assert(splitInfo.splitVal >= bound[splitInfo.splitDimension].Lo());
   Log::Assert(splitInfo.splitVal <= bound[splitInfo.splitDimension].Hi());
@@ -74,8 +74,8 @@ class MidpointSplit
                              const size_t count,
                              const SplitInfo& splitInfo)
   {
-    return split::PerformSplit<MatType, MidpointSplit>(data, begin, count,
-        splitInfo);
+    return split::PerformThreeWaySplit<MatType, MidpointSplit>(data, begin,
+        count, splitInfo);
   }
 
   /**
@@ -99,8 +99,8 @@ class MidpointSplit
                              const SplitInfo& splitInfo,
                              std::vector<size_t>& oldFromNew)
   {
-    return split::PerformSplit<MatType, MidpointSplit>(data, begin, count,
-        splitInfo, oldFromNew);
+    return split::PerformThreeWaySplit<MatType, MidpointSplit>(data, begin,
+        count, splitInfo, oldFromNew);
   }
 
   /**
@@ -115,6 +115,26 @@ class MidpointSplit
   {
     return point[splitInfo.splitDimension] < splitInfo.splitVal;
   }
+
+  /**
+   * Classify a point relative to the split plane: negative for the left
+   * subtree, zero for a point lying exactly on the split value, and positive
+   * for the right subtree.  Used by the three-way partition, which assigns
+   * the on-plane points to whichever child balances the split.
+   *
+   * @param point The point that is being classified.
+   * @param splitInfo An information about the split.
+   */
+  template<typename VecType>
+  static int ClassifyPoint(const VecType& point, const SplitInfo& splitInfo)
+  {
+    const double val = point[splitInfo.splitDimension];
+    if (val < splitInfo.splitVal)
+      return -1;
+    else if (val > splitInfo.splitVal)
+      return 1;
+    return 0;
+  }
 };
 
 } // namespace tree
@@ -15,6 +15,7 @@
 #define MLPACK_CORE_TREE_BINARY_SPACE_TREE_MIDPOINT_SPLIT_IMPL_HPP
 
 #include "midpoint_split.hpp"
+#include "split_statistics_scan.hpp"
 #include <mlpack/core/tree/bounds.hpp>
 
 namespace mlpack {
@@ -50,35 +51,23 @@ bool MidpointSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
   }
   else
   {
-    // We must individually calculate bounding boxes.
-    math::Range* ranges = new math::Range[data.n_rows];
-    for (size_t i = begin; i < begin + count; ++i)
-    {
-      // Expand each dimension as necessary.
-      for (size_t d = 0; d < data.n_rows; ++d)
-      {
-        const double val = data(d, i);
-        if (val < ranges[d].Lo())
-          ranges[d].Lo() = val;
-        if (val > ranges[d].Hi())
-          ranges[d].Hi() = val;
-      }
-    }
+    // We must calculate the bounding box ourselves; gather the per-dimension
+    // extrema in one fused pass over the points.
+    arma::Col<typename MatType::elem_type> mins, maxs;
+    SplitStatisticsScan(data, begin, count, mins, maxs);
 
     // Now, which is the widest?
     for (size_t d = 0; d < data.n_rows; d++)
     {
-      const double width = ranges[d].Width();
+      const double width = (double) (maxs[d] - mins[d]);
       if (width > maxWidth)
       {
         maxWidth = width;
         splitInfo.splitDimension = d;
         // Split in the midpoint of that dimension.
-        splitInfo.splitVal = ranges[d].Mid();
+        splitInfo.splitVal = 0.5 * ((double) mins[d] + (double) maxs[d]);
       }
     }
-
-    delete[] ranges;
   }
 
   if (maxWidth <= 0) // All these points are the same.  We can't split.
@@ -0,0 +1,107 @@
+/**
+ * @file core/tree/binary_space_tree/split_statistics_scan.hpp
+ * @author Ryan Curtin
+ *
+ * A fused single-pass statistics scan shared by the binary space tree split
+ * policies.  Finding the split dimension and the split value previously cost
+ * one pass over the node's points per statistic (bounding box, then mean);
+ * tree construction on large datasets spends most of its time in these scans,
+ * so this scan gathers the per-dimension minimum, maximum and (optionally)
+ * sum in a single sweep.  The data is column-major, so the sweep touches each
+ * point's contiguous column exactly once while the per-dimension accumulators
+ * stay resident in cache.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_STATISTICS_SCAN_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_STATISTICS_SCAN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Gather the per-dimension minimum and maximum of the points in columns
+ * [begin, begin + count) in one pass.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node; must be positive.
+ * @param mins Vector to fill with the per-dimension minima.
+ * @param maxs Vector to fill with the per-dimension maxima.
+ */
+template<typename MatType>
+inline void SplitStatisticsScan(const MatType& data,
+                                const size_t begin,
+                                const size_t count,
+                                arma::Col<typename MatType::elem_type>& mins,
+                                arma::Col<typename MatType::elem_type>& maxs)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  mins = arma::Col<ElemType>(data.col(begin));
+  maxs = mins;
+
+  for (size_t i = begin + 1; i < begin + count; ++i)
+  {
+    for (size_t d = 0; d < data.n_rows; ++d)
+    {
+      const ElemType val = data(d, i);
+      if (val < mins[d])
+        mins[d] = val;
+      else if (val > maxs[d])
+        maxs[d] = val;
+    }
+  }
+}
+
+/**
+ * Gather the per-dimension minimum, maximum and sum of the points in columns
+ * [begin, begin + count) in one pass, so that a mean-based split needs no
+ * second sweep over the points.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node; must be positive.
+ * @param mins Vector to fill with the per-dimension minima.
+ * @param maxs Vector to fill with the per-dimension maxima.
+ * @param sums Vector to fill with the per-dimension sums.
+ */
+template<typename MatType>
+inline void SplitStatisticsScan(const MatType& data,
+                                const size_t begin,
+                                const size_t count,
+                                arma::Col<typename MatType::elem_type>& mins,
+                                arma::Col<typename MatType::elem_type>& maxs,
+                                arma::Col<typename MatType::elem_type>& sums)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  mins = arma::Col<ElemType>(data.col(begin));
+  maxs = mins;
+  sums = mins;
+
+  for (size_t i = begin + 1; i < begin + count; ++i)
+  {
+    for (size_t d = 0; d < data.n_rows; ++d)
+    {
+      const ElemType val = data(d, i);
+      if (val < mins[d])
+        mins[d] = val;
+      else if (val > maxs[d])
+        maxs[d] = val;
+      sums[d] += val;
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
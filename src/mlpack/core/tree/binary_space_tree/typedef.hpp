@@ -79,6 +79,26 @@ using MeanSplitKDTree = BinarySpaceTree<MetricType,
                                         bound::HRectBound,
                                         MeanSplit>;
 
+/**
+ * A kd-tree with compact per-node bounds.  This is the same as the KDTree,
+ * but the per-dimension bound limits are stored in single precision with
+ * outward rounding (see CompactHRectBound), halving the memory consumed by
+ * the bounds.  For deep trees on high-dimensional data the bounds dominate
+ * the size of the tree, so this trades a bound that is looser by at most one
+ * single-precision ulp per side---and thus possibly a few extra base
+ * cases---for a much smaller, more cache-resident tree.
+ *
+ * This template typedef satisfies the TreeType policy API.
+ *
+ * @see @ref trees, BinarySpaceTree, KDTree, bound::CompactHRectBound
+ */
+template<typename MetricType, typename StatisticType, typename MatType>
+using CompactKDTree = BinarySpaceTree<MetricType,
+                                      StatisticType,
+                                      MatType,
+                                      bound::CompactHRectBound,
+                                      MidpointSplit>;
+
 /**
  * A midpoint-split ball tree.  This tree holds its points only in the leaves,
  * similar to the KDTree and MeanSplitKDTree.  However, the bounding shape of
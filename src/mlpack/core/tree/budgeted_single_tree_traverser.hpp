@@ -0,0 +1,116 @@
+/**
+ * @file core/tree/budgeted_single_tree_traverser.hpp
+ *
+ * A best-first single-tree traverser with a per-query node-visit budget.
+ * Unexplored siblings are kept in a priority frontier (ordered by score), and
+ * a query can later be resumed with additional budget, reusing the frontier
+ * left over from its previous traversal.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BUDGETED_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BUDGETED_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <queue>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The BudgetedSingleTreeTraverser traverses the tree in best-first order:
+ * instead of recursing, it keeps a priority frontier of unexplored nodes,
+ * ordered by the score the rule set assigns to them, and repeatedly expands
+ * the best-scored node.  Each call is limited to a given number of node
+ * visits, so the traversal can be stopped early; the frontier is kept between
+ * calls, so the same query can be resumed with more budget and will continue
+ * exactly where it left off instead of restarting from the root.
+ *
+ * With an unlimited budget this performs an exact pruning traversal, like
+ * SingleTreeTraverser; with a small budget it behaves like a defeatist search
+ * with a little backtracking.  This makes the budget a smooth dial between
+ * the latency of GreedySingleTreeTraverser and the recall of a full search.
+ *
+ * @tparam TreeType The tree type to traverse.
+ * @tparam RuleType The rule set to use; it must implement BaseCase(), Score()
+ *      and Rescore().
+ */
+template<typename TreeType, typename RuleType>
+class BudgetedSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the budgeted single tree traverser with the given rule set.
+   */
+  BudgetedSingleTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the tree for the given query point, visiting at most nodeBudget
+   * nodes.  Any previous frontier is discarded and the traversal starts over
+   * from referenceNode.  If the budget runs out before the frontier is empty,
+   * the remaining frontier is kept so that Resume() can continue the
+   * traversal later.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceNode The tree node to start the traversal at.
+   * @param nodeBudget Maximum number of nodes to visit (defaults to no
+   *     limit, which gives an exact pruning traversal).
+   */
+  void Traverse(const size_t queryIndex,
+                TreeType& referenceNode,
+                const size_t nodeBudget = std::numeric_limits<size_t>::max());
+
+  /**
+   * Continue the traversal started by the last call to Traverse(), visiting
+   * at most nodeBudget further nodes.  The frontier left over from the
+   * previous call is reused, so no work is repeated.  This has no effect if
+   * the frontier is exhausted (i.e. the previous traversal completed).
+   *
+   * @param nodeBudget Maximum number of further nodes to visit.
+   */
+  void Resume(const size_t nodeBudget);
+
+  //! Return true if the frontier is empty, i.e. the current query's
+  //! traversal has completed and resuming it cannot improve the results.
+  bool Exhausted() const { return frontier.empty(); }
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+
+  //! Get the number of nodes visited (expanded off the frontier).
+  size_t NumVisited() const { return numVisited; }
+
+ private:
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+
+  //! The number of nodes which have been expanded off the frontier.
+  size_t numVisited;
+
+  //! The query point the current frontier belongs to.
+  size_t currentQuery;
+
+  //! Convenience typedef for a scored frontier entry.
+  typedef std::pair<double, TreeType*> FrontierEntry;
+
+  //! The priority frontier of unexplored nodes; the node with the lowest
+  //! (best) score is expanded first.
+  std::priority_queue<FrontierEntry, std::vector<FrontierEntry>,
+      std::greater<FrontierEntry> > frontier;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "budgeted_single_tree_traverser_impl.hpp"
+
+#endif
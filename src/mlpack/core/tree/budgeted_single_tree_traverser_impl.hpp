@@ -0,0 +1,88 @@
+/**
+ * @file core/tree/budgeted_single_tree_traverser_impl.hpp
+ *
+ * Implementation of the best-first single-tree traverser with a per-query
+ * node-visit budget and a resumable frontier.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BUDGETED_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BUDGETED_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "budgeted_single_tree_traverser.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+BudgetedSingleTreeTraverser<TreeType, RuleType>::BudgetedSingleTreeTraverser(
+    RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    numVisited(0),
+    currentQuery(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void BudgetedSingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const size_t queryIndex,
+    TreeType& referenceNode,
+    const size_t nodeBudget)
+{
+  // Discard any frontier left over from a previous query and start over from
+  // the given root.
+  currentQuery = queryIndex;
+  frontier = std::priority_queue<FrontierEntry, std::vector<FrontierEntry>,
+      std::greater<FrontierEntry> >();
+  frontier.push(std::make_pair(0.0, &referenceNode));
+
+  Resume(nodeBudget);
+}
+
+template<typename TreeType, typename RuleType>
+void BudgetedSingleTreeTraverser<TreeType, RuleType>::Resume(
+    const size_t nodeBudget)
+{
+  size_t budget = nodeBudget;
+  while (budget > 0 && !frontier.empty())
+  {
+    const FrontierEntry entry = frontier.top();
+    frontier.pop();
+    TreeType& node = *entry.second;
+
+    // The best candidate bound may have tightened since this node was scored,
+    // so check whether the node can now be pruned.  Pruned nodes do not
+    // consume any budget.
+    if (rule.Rescore(currentQuery, node, entry.first) == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    --budget;
+    ++numVisited;
+
+    // Run the base case for all the points held in this node.
+    for (size_t i = 0; i < node.NumPoints(); ++i)
+      rule.BaseCase(currentQuery, node.Point(i));
+
+    // Score the children and add the unprunable ones to the frontier.
+    for (size_t i = 0; i < node.NumChildren(); ++i)
+    {
+      const double score = rule.Score(currentQuery, node.Child(i));
+      if (score == DBL_MAX)
+        ++numPrunes;
+      else
+        frontier.push(std::make_pair(score, &node.Child(i)));
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,271 @@
+/**
+ * @file core/tree/compact_hrectbound.hpp
+ *
+ * This file describes the interface for the CompactHRectBound class, a
+ * hyperrectangle bound that stores its per-dimension limits in single
+ * precision regardless of the element type of the data.  For deep trees the
+ * per-node bound dominates tree memory, so halving the storage of every
+ * bound roughly halves the size of the tree itself and keeps far more of it
+ * resident in cache during traversal.
+ *
+ * The narrowed limits are rounded outward (the lower limit down, the upper
+ * limit up), so the compact bound always encloses the exact bound: minimum
+ * distances it reports are never overestimates and maximum distances are
+ * never underestimates, and pruning therefore remains correct.  The price is
+ * a bound that is up to one single-precision ulp looser per side, which may
+ * cost a handful of extra base cases.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_COMPACT_HRECTBOUND_HPP
+#define MLPACK_CORE_TREE_COMPACT_HRECTBOUND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/range.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include "bound_traits.hpp"
+#include "hrectbound.hpp"
+
+namespace mlpack {
+namespace bound {
+
+/**
+ * Compact hyper-rectangle bound for an L-metric.  This behaves like
+ * HRectBound but stores the per-dimension limits as single-precision floats
+ * (8 bytes per dimension instead of 16), rounded outward so that the bound
+ * conservatively encloses the points it was grown with.  Distance
+ * computations widen the stored limits back to ElemType, so results differ
+ * from HRectBound by at most the outward rounding slack.
+ *
+ * Use it by passing it as the bound policy of a BinarySpaceTree (see the
+ * CompactKDTree typedef).  Unlike HRectBound, the per-dimension ranges are
+ * not stored as RangeType objects, so operator[] returns the dequantized
+ * range by value and the ranges cannot be modified in place; grow the bound
+ * with operator|=() instead.
+ *
+ * @tparam MetricType Type of metric to use; must be of type LMetric.
+ * @tparam ElemType Element type of the data (double/float/etc.).
+ */
+template<typename MetricType = metric::LMetric<2, true>,
+         typename ElemType = double>
+class CompactHRectBound
+{
+  // It is required that CompactHRectBound have an LMetric as the given
+  // MetricType.
+  static_assert(meta::IsLMetric<MetricType>::Value == true,
+      "CompactHRectBound can only be used with the LMetric<> metric type.");
+
+ public:
+  /**
+   * Empty constructor; creates a bound of dimensionality 0.
+   */
+  CompactHRectBound();
+
+  /**
+   * Initializes to specified dimensionality with each dimension the empty
+   * set.
+   *
+   * @param dimension Dimensionality of bound.
+   */
+  CompactHRectBound(const size_t dimension);
+
+  //! Copy constructor; necessary to prevent memory leaks.
+  CompactHRectBound(const CompactHRectBound& other);
+
+  //! Same as copy constructor; necessary to prevent memory leaks.
+  CompactHRectBound& operator=(const CompactHRectBound& other);
+
+  //! Move constructor: take possession of another bound's information.
+  CompactHRectBound(CompactHRectBound&& other);
+
+  //! Move assignment operator.
+  CompactHRectBound& operator=(CompactHRectBound&& other);
+
+  //! Destructor: clean up memory.
+  ~CompactHRectBound();
+
+  /**
+   * Resets all dimensions to the empty set (so that this bound contains
+   * nothing).
+   */
+  void Clear();
+
+  //! Gets the dimensionality.
+  size_t Dim() const { return dim; }
+
+  //! Get the dequantized range for a particular dimension.  No bounds
+  //! checking.  The range is returned by value; the stored limits cannot be
+  //! modified through it.
+  math::RangeType<ElemType> operator[](const size_t i) const
+  {
+    return math::RangeType<ElemType>((ElemType) lo[i], (ElemType) hi[i]);
+  }
+
+  //! Get the minimum width of the bound.
+  ElemType MinWidth() const { return minWidth; }
+  //! Modify the minimum width of the bound.
+  ElemType& MinWidth() { return minWidth; }
+
+  //! Get the instantiated metric associated with the bound.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the instantiated metric associated with the bound.
+  MetricType& Metric() { return metric; }
+
+  /**
+   * Calculates the center of the range, placing it into the given vector.
+   *
+   * @param center Vector which the center will be written to.
+   */
+  void Center(arma::Col<ElemType>& center) const;
+
+  /**
+   * Calculates minimum bound-to-point distance.
+   *
+   * @param point Point to which the minimum distance is requested.
+   */
+  template<typename VecType>
+  ElemType MinDistance(const VecType& point,
+                       typename std::enable_if_t<IsVector<VecType>::value>* = 0)
+      const;
+
+  /**
+   * Calculates minimum bound-to-bound distance.
+   *
+   * @param other Bound to which the minimum distance is requested.
+   */
+  ElemType MinDistance(const CompactHRectBound& other) const;
+
+  /**
+   * Calculates maximum bound-to-point distance.
+   *
+   * @param point Point to which the maximum distance is requested.
+   */
+  template<typename VecType>
+  ElemType MaxDistance(const VecType& point,
+                       typename std::enable_if_t<IsVector<VecType>::value>* = 0)
+      const;
+
+  /**
+   * Computes maximum distance.
+   *
+   * @param other Bound to which the maximum distance is requested.
+   */
+  ElemType MaxDistance(const CompactHRectBound& other) const;
+
+  /**
+   * Calculates minimum and maximum bound-to-bound distance.
+   *
+   * @param other Bound to which the minimum and maximum distances are
+   *     requested.
+   */
+  math::RangeType<ElemType> RangeDistance(const CompactHRectBound& other)
+      const;
+
+  /**
+   * Calculates minimum and maximum bound-to-point distance.
+   *
+   * @param point Point to which the minimum and maximum distances are
+   *     requested.
+   */
+  template<typename VecType>
+  math::RangeType<ElemType> RangeDistance(
+      const VecType& point,
+      typename std::enable_if_t<IsVector<VecType>::value>* = 0) const;
+
+  /**
+   * Expands this region to include new points.
+   *
+   * @tparam MatType Type of matrix; could be Mat, SpMat, a subview, or just a
+   *   vector.
+   * @param data Data points to expand this region to include.
+   */
+  template<typename MatType>
+  CompactHRectBound& operator|=(const MatType& data);
+
+  /**
+   * Expands this region to encompass another bound.
+   */
+  CompactHRectBound& operator|=(const CompactHRectBound& other);
+
+  /**
+   * Determines if a point is within this bound.
+   *
+   * @param point Point to check the condition.
+   */
+  template<typename VecType>
+  bool Contains(const VecType& point) const;
+
+  /**
+   * Returns the diameter of the hyperrectangle (that is, the longest
+   * diagonal).
+   */
+  ElemType Diameter() const;
+
+  /**
+   * Serialize the bound object.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  /**
+   * Narrow a lower limit to single precision, rounding toward negative
+   * infinity so that the stored limit never exceeds the exact one.
+   */
+  static float NarrowLo(const ElemType value)
+  {
+    float narrowed = (float) value;
+    if ((ElemType) narrowed > value)
+      narrowed = std::nextafterf(narrowed,
+          -std::numeric_limits<float>::infinity());
+    return narrowed;
+  }
+
+  /**
+   * Narrow an upper limit to single precision, rounding toward positive
+   * infinity so that the stored limit is never below the exact one.
+   */
+  static float NarrowHi(const ElemType value)
+  {
+    float narrowed = (float) value;
+    if ((ElemType) narrowed < value)
+      narrowed = std::nextafterf(narrowed,
+          std::numeric_limits<float>::infinity());
+    return narrowed;
+  }
+
+  //! Recompute the cached minimum width from the stored limits.
+  void RecalculateMinWidth();
+
+  //! The dimensionality of the bound.
+  size_t dim;
+  //! The narrowed limits: lower limits in [0, dim), upper limits in
+  //! [dim, 2 * dim).
+  float* lo;
+  //! Pointer into the same allocation as lo, at the upper limits.
+  float* hi;
+  //! Cached minimum width of bound.
+  ElemType minWidth;
+  //! Instantiated metric (likely has size 0).
+  MetricType metric;
+};
+
+// A specialization of BoundTraits for this class.
+template<typename MetricType, typename ElemType>
+struct BoundTraits<CompactHRectBound<MetricType, ElemType>>
+{
+  //! The bounds are tight up to the outward rounding of the narrowed limits
+  //! (at most one single-precision ulp per side), which is close enough for
+  //! the split policies that consult bound widths.
+  const static bool HasTightBounds = true;
+};
+
+} // namespace bound
+} // namespace mlpack
+
+#include "compact_hrectbound_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_COMPACT_HRECTBOUND_HPP
@@ -0,0 +1,639 @@
+/**
+ * @file core/tree/compact_hrectbound_impl.hpp
+ *
+ * Implementation of the compact hyper-rectangle bound policy class.  The
+ * distance kernels mirror HRectBound's, but read the narrowed
+ * single-precision limits and widen them back to ElemType.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_COMPACT_HRECTBOUND_IMPL_HPP
+#define MLPACK_CORE_TREE_COMPACT_HRECTBOUND_IMPL_HPP
+
+#include <math.h>
+
+// In case it has not been included yet.
+#include "compact_hrectbound.hpp"
+
+namespace mlpack {
+namespace bound {
+
+/**
+ * Empty constructor.
+ */
+template<typename MetricType, typename ElemType>
+inline CompactHRectBound<MetricType, ElemType>::CompactHRectBound() :
+    dim(0),
+    lo(NULL),
+    hi(NULL),
+    minWidth(0)
+{ /* Nothing to do. */ }
+
+/**
+ * Initializes to specified dimensionality with each dimension the empty
+ * set.
+ */
+template<typename MetricType, typename ElemType>
+inline CompactHRectBound<MetricType, ElemType>::CompactHRectBound(
+    const size_t dimension) :
+    dim(dimension),
+    lo(new float[2 * dim]),
+    hi(lo + dim),
+    minWidth(0)
+{
+  Clear();
+}
+
+/**
+ * Copy constructor necessary to prevent memory leaks.
+ */
+template<typename MetricType, typename ElemType>
+inline CompactHRectBound<MetricType, ElemType>::CompactHRectBound(
+    const CompactHRectBound<MetricType, ElemType>& other) :
+    dim(other.dim),
+    lo(new float[2 * dim]),
+    hi(lo + dim),
+    minWidth(other.minWidth)
+{
+  std::copy(other.lo, other.lo + 2 * dim, lo);
+}
+
+/**
+ * Same as the copy constructor.
+ */
+template<typename MetricType, typename ElemType>
+inline CompactHRectBound<MetricType, ElemType>&
+CompactHRectBound<MetricType, ElemType>::operator=(
+    const CompactHRectBound<MetricType, ElemType>& other)
+{
+  if (this == &other)
+    return *this;
+
+  if (dim != other.dim)
+  {
+    // Reallocation is necessary.
+    if (lo)
+      delete[] lo;
+
+    dim = other.dim;
+    lo = new float[2 * dim];
+    hi = lo + dim;
+  }
+
+  std::copy(other.lo, other.lo + 2 * dim, lo);
+  minWidth = other.minWidth;
+
+  return *this;
+}
+
+/**
+ * Move constructor: take possession of another bound's information.
+ */
+template<typename MetricType, typename ElemType>
+inline CompactHRectBound<MetricType, ElemType>::CompactHRectBound(
+    CompactHRectBound<MetricType, ElemType>&& other) :
+    dim(other.dim),
+    lo(other.lo),
+    hi(other.hi),
+    minWidth(other.minWidth)
+{
+  // Fix the other bound.
+  other.dim = 0;
+  other.lo = NULL;
+  other.hi = NULL;
+  other.minWidth = 0.0;
+}
+
+/**
+ * Move assignment operator.
+ */
+template<typename MetricType, typename ElemType>
+inline CompactHRectBound<MetricType, ElemType>&
+CompactHRectBound<MetricType, ElemType>::operator=(
+    CompactHRectBound<MetricType, ElemType>&& other)
+{
+  if (this != &other)
+  {
+    if (lo)
+      delete[] lo;
+
+    dim = other.dim;
+    lo = other.lo;
+    hi = other.hi;
+    minWidth = other.minWidth;
+    other.dim = 0;
+    other.lo = nullptr;
+    other.hi = nullptr;
+    other.minWidth = 0.0;
+  }
+  return *this;
+}
+
+/**
+ * Destructor: clean up memory.
+ */
+template<typename MetricType, typename ElemType>
+inline CompactHRectBound<MetricType, ElemType>::~CompactHRectBound()
+{
+  if (lo)
+    delete[] lo;
+}
+
+/**
+ * Resets all dimensions to the empty set.
+ */
+template<typename MetricType, typename ElemType>
+inline void CompactHRectBound<MetricType, ElemType>::Clear()
+{
+  for (size_t i = 0; i < dim; ++i)
+  {
+    lo[i] = std::numeric_limits<float>::max();
+    hi[i] = -std::numeric_limits<float>::max();
+  }
+  minWidth = 0;
+}
+
+/**
+ * Recompute the cached minimum width from the stored limits.
+ */
+template<typename MetricType, typename ElemType>
+inline void CompactHRectBound<MetricType, ElemType>::RecalculateMinWidth()
+{
+  minWidth = std::numeric_limits<ElemType>::max();
+  for (size_t i = 0; i < dim; ++i)
+  {
+    const ElemType width = (ElemType) hi[i] - (ElemType) lo[i];
+    if (width < minWidth)
+      minWidth = width;
+  }
+}
+
+/**
+ * Calculates the centroid of the range, placing it into the given vector.
+ */
+template<typename MetricType, typename ElemType>
+inline void CompactHRectBound<MetricType, ElemType>::Center(
+    arma::Col<ElemType>& center) const
+{
+  // Set size correctly if necessary.
+  if (!(center.n_elem == dim))
+    center.set_size(dim);
+
+  for (size_t i = 0; i < dim; ++i)
+    center(i) = 0.5 * ((ElemType) lo[i] + (ElemType) hi[i]);
+}
+
+/**
+ * Calculates minimum bound-to-point squared distance.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline ElemType CompactHRectBound<MetricType, ElemType>::MinDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  ElemType sum = 0;
+
+  ElemType lower, higher;
+  for (size_t d = 0; d < dim; d++)
+  {
+    lower = (ElemType) lo[d] - point[d];
+    higher = point[d] - (ElemType) hi[d];
+
+    // Since only one of 'lower' or 'higher' is negative, if we add each's
+    // absolute value to itself and then sum those two, our result is the
+    // nonnegative half of the equation times two; then we raise to power Power.
+    if (MetricType::Power == 1)
+      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+    else if (MetricType::Power == 2)
+    {
+      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      sum += dist * dist;
+    }
+    else
+    {
+      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
+          (ElemType) MetricType::Power);
+    }
+  }
+
+  // Now take the Power'th root (but make sure our result is squared if it needs
+  // to be); then cancel out the constant of 2 (which may have been squared now)
+  // that was introduced earlier.  The compiler should optimize out the if
+  // statement entirely.
+  if (MetricType::Power == 1)
+    return sum * 0.5;
+  else if (MetricType::Power == 2)
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(sum) * 0.5;
+    else
+      return sum * 0.25;
+  }
+  else
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) pow((double) sum,
+          1.0 / (double) MetricType::Power) / 2.0;
+    else
+      return sum / pow(2.0, MetricType::Power);
+  }
+}
+
+/**
+ * Calculates minimum bound-to-bound squared distance.
+ */
+template<typename MetricType, typename ElemType>
+ElemType CompactHRectBound<MetricType, ElemType>::MinDistance(
+    const CompactHRectBound& other) const
+{
+  Log::Assert(dim == other.dim);
+
+  ElemType sum = 0;
+
+  ElemType lower, higher;
+  for (size_t d = 0; d < dim; d++)
+  {
+    lower = (ElemType) other.lo[d] - (ElemType) hi[d];
+    higher = (ElemType) lo[d] - (ElemType) other.hi[d];
+    // We invoke the following:
+    //   x + fabs(x) = max(x * 2, 0)
+    //   (x * 2)^2 / 4 = x^2
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+    else if (MetricType::Power == 2)
+    {
+      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      sum += dist * dist;
+    }
+    else
+    {
+      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
+          (ElemType) MetricType::Power);
+    }
+  }
+
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::Power == 1)
+    return sum * 0.5;
+  else if (MetricType::Power == 2)
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(sum) * 0.5;
+    else
+      return sum * 0.25;
+  }
+  else
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) pow((double) sum,
+          1.0 / (double) MetricType::Power) / 2.0;
+    else
+      return sum / pow(2.0, MetricType::Power);
+  }
+}
+
+/**
+ * Calculates maximum bound-to-point squared distance.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline ElemType CompactHRectBound<MetricType, ElemType>::MaxDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  ElemType sum = 0;
+
+  Log::Assert(point.n_elem == dim);
+
+  for (size_t d = 0; d < dim; d++)
+  {
+    ElemType v = std::max(fabs(point[d] - (ElemType) lo[d]),
+        fabs((ElemType) hi[d] - point[d]));
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += v; // v is non-negative.
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) MetricType::Power);
+  }
+
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return sum;
+    else if (MetricType::Power == 2)
+      return (ElemType) std::sqrt(sum);
+    else
+      return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
+  }
+  else
+    return sum;
+}
+
+/**
+ * Computes maximum distance.
+ */
+template<typename MetricType, typename ElemType>
+inline ElemType CompactHRectBound<MetricType, ElemType>::MaxDistance(
+    const CompactHRectBound& other) const
+{
+  ElemType sum = 0;
+
+  Log::Assert(dim == other.dim);
+
+  ElemType v;
+  for (size_t d = 0; d < dim; d++)
+  {
+    v = std::max(fabs((ElemType) other.hi[d] - (ElemType) lo[d]),
+        fabs((ElemType) hi[d] - (ElemType) other.lo[d]));
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += v; // v is non-negative.
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) MetricType::Power);
+  }
+
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return sum;
+    else if (MetricType::Power == 2)
+      return (ElemType) std::sqrt(sum);
+    else
+      return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
+  }
+  else
+    return sum;
+}
+
+/**
+ * Calculates minimum and maximum bound-to-bound squared distance.
+ */
+template<typename MetricType, typename ElemType>
+inline math::RangeType<ElemType>
+CompactHRectBound<MetricType, ElemType>::RangeDistance(
+    const CompactHRectBound& other) const
+{
+  ElemType loSum = 0;
+  ElemType hiSum = 0;
+
+  Log::Assert(dim == other.dim);
+
+  ElemType v1, v2, vLo, vHi;
+  for (size_t d = 0; d < dim; d++)
+  {
+    v1 = (ElemType) other.lo[d] - (ElemType) hi[d];
+    v2 = (ElemType) lo[d] - (ElemType) other.hi[d];
+    // One of v1 or v2 is negative.
+    if (v1 >= v2)
+    {
+      vHi = -v2; // Make it nonnegative.
+      vLo = (v1 > 0) ? v1 : 0; // Force to be 0 if negative.
+    }
+    else
+    {
+      vHi = -v1; // Make it nonnegative.
+      vLo = (v2 > 0) ? v2 : 0; // Force to be 0 if negative.
+    }
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+    {
+      loSum += vLo; // vLo is non-negative.
+      hiSum += vHi; // vHi is non-negative.
+    }
+    else if (MetricType::Power == 2)
+    {
+      loSum += vLo * vLo;
+      hiSum += vHi * vHi;
+    }
+    else
+    {
+      loSum += std::pow(vLo, (ElemType) MetricType::Power);
+      hiSum += std::pow(vHi, (ElemType) MetricType::Power);
+    }
+  }
+
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return math::RangeType<ElemType>(loSum, hiSum);
+    else if (MetricType::Power == 2)
+      return math::RangeType<ElemType>((ElemType) std::sqrt(loSum),
+                                       (ElemType) std::sqrt(hiSum));
+    else
+    {
+      return math::RangeType<ElemType>(
+          (ElemType) pow((double) loSum, 1.0 / (double) MetricType::Power),
+          (ElemType) pow((double) hiSum, 1.0 / (double) MetricType::Power));
+    }
+  }
+  else
+    return math::RangeType<ElemType>(loSum, hiSum);
+}
+
+/**
+ * Calculates minimum and maximum bound-to-point squared distance.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline math::RangeType<ElemType>
+CompactHRectBound<MetricType, ElemType>::RangeDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  ElemType loSum = 0;
+  ElemType hiSum = 0;
+
+  Log::Assert(point.n_elem == dim);
+
+  ElemType v1, v2, vLo, vHi;
+  for (size_t d = 0; d < dim; d++)
+  {
+    v1 = (ElemType) lo[d] - point[d]; // Negative if point[d] > lo.
+    v2 = point[d] - (ElemType) hi[d]; // Negative if point[d] < hi.
+    // One of v1 or v2 (or both) is negative.
+    if (v1 >= 0) // point[d] <= lo[d].
+    {
+      vHi = -v2; // v2 will be larger but must be negated.
+      vLo = v1;
+    }
+    else // point[d] is between lo and hi, or greater than hi.
+    {
+      if (v2 >= 0)
+      {
+        vHi = -v1; // v1 will be larger, but must be negated.
+        vLo = v2;
+      }
+      else
+      {
+        vHi = -std::min(v1, v2); // Both are negative, but we need the larger.
+        vLo = 0;
+      }
+    }
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+    {
+      loSum += vLo; // vLo is non-negative.
+      hiSum += vHi; // vHi is non-negative.
+    }
+    else if (MetricType::Power == 2)
+    {
+      loSum += vLo * vLo;
+      hiSum += vHi * vHi;
+    }
+    else
+    {
+      loSum += std::pow(vLo, (ElemType) MetricType::Power);
+      hiSum += std::pow(vHi, (ElemType) MetricType::Power);
+    }
+  }
+
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return math::RangeType<ElemType>(loSum, hiSum);
+    else if (MetricType::Power == 2)
+      return math::RangeType<ElemType>((ElemType) std::sqrt(loSum),
+                                       (ElemType) std::sqrt(hiSum));
+    else
+    {
+      return math::RangeType<ElemType>(
+          (ElemType) pow((double) loSum, 1.0 / (double) MetricType::Power),
+          (ElemType) pow((double) hiSum, 1.0 / (double) MetricType::Power));
+    }
+  }
+  else
+    return math::RangeType<ElemType>(loSum, hiSum);
+}
+
+/**
+ * Expands this region to include new points.
+ */
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline CompactHRectBound<MetricType, ElemType>&
+CompactHRectBound<MetricType, ElemType>::operator|=(const MatType& data)
+{
+  Log::Assert(data.n_rows == dim);
+
+  arma::Col<ElemType> mins(min(data, 1));
+  arma::Col<ElemType> maxs(max(data, 1));
+
+  for (size_t i = 0; i < dim; ++i)
+  {
+    const float newLo = NarrowLo(mins[i]);
+    const float newHi = NarrowHi(maxs[i]);
+    if (newLo < lo[i])
+      lo[i] = newLo;
+    if (newHi > hi[i])
+      hi[i] = newHi;
+  }
+
+  RecalculateMinWidth();
+
+  return *this;
+}
+
+/**
+ * Expands this region to encompass another bound.
+ */
+template<typename MetricType, typename ElemType>
+inline CompactHRectBound<MetricType, ElemType>&
+CompactHRectBound<MetricType, ElemType>::operator|=(
+    const CompactHRectBound& other)
+{
+  assert(other.dim == dim);
+
+  for (size_t i = 0; i < dim; ++i)
+  {
+    if (other.lo[i] < lo[i])
+      lo[i] = other.lo[i];
+    if (other.hi[i] > hi[i])
+      hi[i] = other.hi[i];
+  }
+
+  RecalculateMinWidth();
+
+  return *this;
+}
+
+/**
+ * Determines if a point is within this bound.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline bool CompactHRectBound<MetricType, ElemType>::Contains(
+    const VecType& point) const
+{
+  for (size_t i = 0; i < point.n_elem; ++i)
+  {
+    if (point(i) < (ElemType) lo[i] || point(i) > (ElemType) hi[i])
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Returns the diameter of the hyperrectangle (that is, the longest diagonal).
+ */
+template<typename MetricType, typename ElemType>
+inline ElemType CompactHRectBound<MetricType, ElemType>::Diameter() const
+{
+  ElemType d = 0;
+  for (size_t i = 0; i < dim; ++i)
+    d += std::pow((ElemType) hi[i] - (ElemType) lo[i],
+        (ElemType) MetricType::Power);
+
+  if (MetricType::TakeRoot)
+    return (ElemType) std::pow((double) d, 1.0 / (double) MetricType::Power);
+  else
+    return d;
+}
+
+//! Serialize the bound object.
+template<typename MetricType, typename ElemType>
+template<typename Archive>
+void CompactHRectBound<MetricType, ElemType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  size_t oldDim = dim;
+  ar(CEREAL_NVP(dim));
+
+  if (cereal::is_loading<Archive>() && oldDim != dim)
+  {
+    if (lo)
+      delete[] lo;
+    lo = new float[2 * dim];
+    hi = lo + dim;
+  }
+
+  for (size_t i = 0; i < 2 * dim; ++i)
+    ar(cereal::make_nvp("limit", lo[i]));
+
+  ar(CEREAL_NVP(minWidth));
+  ar(CEREAL_NVP(metric));
+}
+
+} // namespace bound
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_COMPACT_HRECTBOUND_IMPL_HPP
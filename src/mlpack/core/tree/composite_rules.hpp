@@ -0,0 +1,216 @@
+/**
+ * @file core/tree/composite_rules.hpp
+ * @author Ryan Curtin
+ *
+ * A rule adapter that fuses two rule sets into a single dual-tree traversal,
+ * so that several analytics over the same pair of trees can share one pass
+ * through memory instead of re-faulting the nodes once per algorithm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_COMPOSITE_RULES_HPP
+#define MLPACK_CORE_TREE_COMPOSITE_RULES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The CompositeRules class wraps two rule sets and presents them to a
+ * dual-tree traverser as one.  Score() returns the weakest prune: a node
+ * combination is pruned only when every wrapped rule prunes it, and otherwise
+ * the best (lowest) score among the rules that want to keep recursing is
+ * returned so that recursion priority still reflects the most eager rule.
+ * BaseCase() dispatches only to the rules that are still active on the
+ * current recursion path.
+ *
+ * Once a rule prunes a node combination it is marked inactive for the whole
+ * subtree below that combination: it receives no further Score() or
+ * BaseCase() calls there.  This matters for rules that fold a contribution
+ * into their prune (for instance, KDE adds an approximated kernel sum when it
+ * prunes); dispatching base cases to such a rule after it pruned would count
+ * that contribution twice.  The activity flags travel inside the composite's
+ * TraversalInfoType, so correct scoping relies on the traverser saving and
+ * restoring TraversalInfo() around recursion, as the depth-first dual-tree
+ * traversers of BinarySpaceTree and Octree do.  The adapter is not suitable
+ * for single-tree traversals, which do not restore traversal information
+ * between sibling recursions.
+ *
+ * Both rule sets must be instantiated against the same tree type, and the
+ * tree's StatisticType must satisfy the requirements of every fused rule.
+ * (For example, NeighborSearchStat provides everything RangeSearchRules
+ * needs, so k-NN and range search can share a tree built with it.)  More
+ * than two rule sets can be fused by nesting, since CompositeRules itself
+ * satisfies the rule interface:
+ *
+ * @code
+ * NeighborSearchRules<...> knnRules(...);
+ * RangeSearchRules<...> rangeRules(...);
+ * CompositeRules<NeighborSearchRules<...>, RangeSearchRules<...>>
+ *     composite(knnRules, rangeRules);
+ *
+ * TreeType::DualTreeTraverser<decltype(composite)> traverser(composite);
+ * traverser.Traverse(queryTree, referenceTree);
+ * // Results are extracted from knnRules and rangeRules as usual.
+ * @endcode
+ *
+ * @tparam RuleTypeA First rule set to fuse.
+ * @tparam RuleTypeB Second rule set to fuse.
+ */
+template<typename RuleTypeA, typename RuleTypeB>
+class CompositeRules
+{
+ public:
+  /**
+   * Construct the composite from two instantiated rule sets.  The composite
+   * holds references, so the rules must outlive it; results are read from the
+   * wrapped rules directly after the traversal.
+   *
+   * @param rulesA First rule set.
+   * @param rulesB Second rule set.
+   */
+  CompositeRules(RuleTypeA& rulesA, RuleTypeB& rulesB);
+
+  /**
+   * Traversal information for the composite.  This carries each wrapped
+   * rule's own traversal information plus a flag per rule recording whether
+   * that rule is still active on the current recursion path.  Rules start
+   * active and become inactive for a subtree when they prune its root
+   * combination.
+   */
+  class TraversalInfoType
+  {
+   public:
+    //! Create the traversal info with both rules active.
+    TraversalInfoType() : activeA(true), activeB(true) { }
+
+    //! Get the first rule's traversal information.
+    const typename RuleTypeA::TraversalInfoType& InfoA() const
+    { return infoA; }
+    //! Modify the first rule's traversal information.
+    typename RuleTypeA::TraversalInfoType& InfoA() { return infoA; }
+
+    //! Get the second rule's traversal information.
+    const typename RuleTypeB::TraversalInfoType& InfoB() const
+    { return infoB; }
+    //! Modify the second rule's traversal information.
+    typename RuleTypeB::TraversalInfoType& InfoB() { return infoB; }
+
+    //! Get whether the first rule is active on this path.
+    bool ActiveA() const { return activeA; }
+    //! Modify whether the first rule is active on this path.
+    bool& ActiveA() { return activeA; }
+
+    //! Get whether the second rule is active on this path.
+    bool ActiveB() const { return activeB; }
+    //! Modify whether the second rule is active on this path.
+    bool& ActiveB() { return activeB; }
+
+   private:
+    //! The first rule's traversal information for this path.
+    typename RuleTypeA::TraversalInfoType infoA;
+    //! The second rule's traversal information for this path.
+    typename RuleTypeB::TraversalInfoType infoB;
+    //! Whether the first rule is still active on this path.
+    bool activeA;
+    //! Whether the second rule is still active on this path.
+    bool activeB;
+  };
+
+  /**
+   * Compute the base case for the given point combination, dispatching to
+   * each rule that is still active on the current path.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceIndex Index of reference point.
+   */
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  /**
+   * Score the given query point and reference node with every active rule.
+   * Returns DBL_MAX only if every rule prunes; a rule that prunes is marked
+   * inactive for the subtree below the reference node.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   */
+  template<typename TreeType>
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  /**
+   * Re-evaluate the score of the given query point and reference node.  See
+   * the dual-tree Rescore() for the semantics.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   * @param oldScore Old score produced by Score() (or Rescore()).
+   */
+  template<typename TreeType>
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore);
+
+  /**
+   * Score the given node combination with every active rule.  Returns
+   * DBL_MAX only if every rule prunes; a rule that prunes is marked inactive
+   * for the subtree below this combination.
+   *
+   * @param queryNode Candidate query node to recurse into.
+   * @param referenceNode Candidate reference node to recurse into.
+   */
+  template<typename TreeType>
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  /**
+   * Re-evaluate the score of the given node combination.  The traverser may
+   * call this before restoring the combination's traversal information, so
+   * the per-rule scores are not available; each rule is therefore handed the
+   * composite score, which is a lower bound on its own score, making any
+   * prune it reports valid.  The combination is pruned only when every rule
+   * prunes it.
+   *
+   * @param queryNode Candidate query node to recurse into.
+   * @param referenceNode Candidate reference node to recurse into.
+   * @param oldScore Old score produced by Score() (or Rescore()).
+   */
+  template<typename TreeType>
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore);
+
+  //! Get the traversal info.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+  //! Modify the traversal info.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the first wrapped rule set.
+  const RuleTypeA& RulesA() const { return rulesA; }
+  //! Modify the first wrapped rule set.
+  RuleTypeA& RulesA() { return rulesA; }
+
+  //! Get the second wrapped rule set.
+  const RuleTypeB& RulesB() const { return rulesB; }
+  //! Modify the second wrapped rule set.
+  RuleTypeB& RulesB() { return rulesB; }
+
+ private:
+  //! The first wrapped rule set.
+  RuleTypeA& rulesA;
+  //! The second wrapped rule set.
+  RuleTypeB& rulesB;
+
+  //! Traversal info for the current path, including per-rule activity.
+  TraversalInfoType traversalInfo;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "composite_rules_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_COMPOSITE_RULES_HPP
@@ -0,0 +1,172 @@
+/**
+ * @file core/tree/composite_rules_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the CompositeRules adapter, which fuses two rule sets
+ * into a single dual-tree traversal.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_COMPOSITE_RULES_IMPL_HPP
+#define MLPACK_CORE_TREE_COMPOSITE_RULES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "composite_rules.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename RuleTypeA, typename RuleTypeB>
+CompositeRules<RuleTypeA, RuleTypeB>::CompositeRules(RuleTypeA& rulesA,
+                                                     RuleTypeB& rulesB) :
+    rulesA(rulesA),
+    rulesB(rulesB)
+{ /* Nothing to do. */ }
+
+template<typename RuleTypeA, typename RuleTypeB>
+double CompositeRules<RuleTypeA, RuleTypeB>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // Dispatch to each rule that is still active on this path, keeping its own
+  // traversal information in sync so that caching inside the rule (e.g. for
+  // trees where the first point is the centroid) keeps working.
+  double result = 0.0;
+
+  if (traversalInfo.ActiveA())
+  {
+    rulesA.TraversalInfo() = traversalInfo.InfoA();
+    result = rulesA.BaseCase(queryIndex, referenceIndex);
+    traversalInfo.InfoA() = rulesA.TraversalInfo();
+  }
+
+  if (traversalInfo.ActiveB())
+  {
+    rulesB.TraversalInfo() = traversalInfo.InfoB();
+    const double resultB = rulesB.BaseCase(queryIndex, referenceIndex);
+    traversalInfo.InfoB() = rulesB.TraversalInfo();
+
+    if (!traversalInfo.ActiveA())
+      result = resultB;
+  }
+
+  return result;
+}
+
+template<typename RuleTypeA, typename RuleTypeB>
+template<typename TreeType>
+double CompositeRules<RuleTypeA, RuleTypeB>::Score(const size_t queryIndex,
+                                                   TreeType& referenceNode)
+{
+  double score = DBL_MAX;
+
+  if (traversalInfo.ActiveA())
+  {
+    rulesA.TraversalInfo() = traversalInfo.InfoA();
+    const double scoreA = rulesA.Score(queryIndex, referenceNode);
+    traversalInfo.InfoA() = rulesA.TraversalInfo();
+
+    if (scoreA == DBL_MAX)
+      traversalInfo.ActiveA() = false; // The rule pruned this subtree.
+    else
+      score = std::min(score, scoreA);
+  }
+
+  if (traversalInfo.ActiveB())
+  {
+    rulesB.TraversalInfo() = traversalInfo.InfoB();
+    const double scoreB = rulesB.Score(queryIndex, referenceNode);
+    traversalInfo.InfoB() = rulesB.TraversalInfo();
+
+    if (scoreB == DBL_MAX)
+      traversalInfo.ActiveB() = false; // The rule pruned this subtree.
+    else
+      score = std::min(score, scoreB);
+  }
+
+  // DBL_MAX (a prune) is returned only when every wrapped rule has pruned.
+  return score;
+}
+
+template<typename RuleTypeA, typename RuleTypeB>
+template<typename TreeType>
+double CompositeRules<RuleTypeA, RuleTypeB>::Rescore(
+    const size_t queryIndex,
+    TreeType& referenceNode,
+    const double oldScore)
+{
+  // See the dual-tree Rescore() for why each rule sees the composite score.
+  const double rescoreA = rulesA.Rescore(queryIndex, referenceNode, oldScore);
+  const double rescoreB = rulesB.Rescore(queryIndex, referenceNode, oldScore);
+
+  if (rescoreA == DBL_MAX && rescoreB == DBL_MAX)
+    return DBL_MAX;
+
+  return oldScore;
+}
+
+template<typename RuleTypeA, typename RuleTypeB>
+template<typename TreeType>
+double CompositeRules<RuleTypeA, RuleTypeB>::Score(TreeType& queryNode,
+                                                   TreeType& referenceNode)
+{
+  double score = DBL_MAX;
+
+  if (traversalInfo.ActiveA())
+  {
+    rulesA.TraversalInfo() = traversalInfo.InfoA();
+    const double scoreA = rulesA.Score(queryNode, referenceNode);
+    traversalInfo.InfoA() = rulesA.TraversalInfo();
+
+    if (scoreA == DBL_MAX)
+      traversalInfo.ActiveA() = false; // The rule pruned this subtree.
+    else
+      score = std::min(score, scoreA);
+  }
+
+  if (traversalInfo.ActiveB())
+  {
+    rulesB.TraversalInfo() = traversalInfo.InfoB();
+    const double scoreB = rulesB.Score(queryNode, referenceNode);
+    traversalInfo.InfoB() = rulesB.TraversalInfo();
+
+    if (scoreB == DBL_MAX)
+      traversalInfo.ActiveB() = false; // The rule pruned this subtree.
+    else
+      score = std::min(score, scoreB);
+  }
+
+  // DBL_MAX (a prune) is returned only when every wrapped rule has pruned.
+  return score;
+}
+
+template<typename RuleTypeA, typename RuleTypeB>
+template<typename TreeType>
+double CompositeRules<RuleTypeA, RuleTypeB>::Rescore(TreeType& queryNode,
+                                                     TreeType& referenceNode,
+                                                     const double oldScore)
+{
+  // The traversal information for this combination may not have been restored
+  // yet, so we cannot consult the activity flags or per-rule scores here.
+  // The composite score is a lower bound on every rule's own score, so a
+  // prune a rule reports against it would also be valid against its true
+  // score.  A rule that is inactive for this combination may keep the
+  // recursion alive needlessly, but the restored activity flags will stop it
+  // from receiving any deeper Score() or BaseCase() calls, so results remain
+  // correct.
+  const double rescoreA = rulesA.Rescore(queryNode, referenceNode, oldScore);
+  const double rescoreB = rulesB.Rescore(queryNode, referenceNode, oldScore);
+
+  if (rescoreA == DBL_MAX && rescoreB == DBL_MAX)
+    return DBL_MAX;
+
+  return oldScore;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_COMPOSITE_RULES_IMPL_HPP
@@ -29,8 +29,10 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   indices.resize(numColumns);
   l2NormsSquared.zeros(numColumns);
 
-  // Set indices and calculate squared norms of the columns.
-  for (size_t i = 0; i < numColumns; ++i)
+  // Set indices and calculate squared norms of the columns; the columns are
+  // independent, so the norm passes are distributed across the OpenMP team.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     indices[i] = i;
     double l2Norm = arma::norm(dataset.col(i), 2);
@@ -430,7 +432,10 @@ double CosineTree::MonteCarloError(CosineTree* node,
     projectionSize = treeQueue.size();
 
   // For each sample, calculate the weighted projection onto the current basis.
-  for (size_t i = 0; i < numSamples; ++i)
+  // The samples are independent, so they are distributed across the OpenMP
+  // team; the priority queue is only read.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numSamples; ++i)
   {
     // Initialize projection as a vector of zeros.
     arma::vec projection;
@@ -536,9 +541,16 @@ void CosineTree::CosineNodeSplit()
       rightIndices.push_back(i);
   }
 
-  // Split the node into left and right children.
-  left = new CosineTree(*this, leftIndices);
-  right = new CosineTree(*this, rightIndices);
+  // Split the node into left and right children.  The two subtree expansions
+  // (centroid, length-squared distribution and split point sampling) are
+  // independent, so they proceed concurrently.
+  #pragma omp parallel sections
+  {
+    #pragma omp section
+    left = new CosineTree(*this, leftIndices);
+    #pragma omp section
+    right = new CosineTree(*this, rightIndices);
+  }
 }
 
 void CosineTree::ColumnSamplesLS(std::vector<size_t>& sampledIndices,
@@ -633,7 +645,10 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; ++i)
+  // The column-distance computations are independent, so they are
+  // distributed across the OpenMP team.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
     // between two vectors.
@@ -655,10 +670,20 @@ void CosineTree::CalculateCentroid()
   // Initialize centroid as vector of zeros.
   centroid.zeros(dataset->n_rows);
 
-  // Calculate centroid of columns in the node.
-  for (size_t i = 0; i < numColumns; ++i)
+  // Calculate centroid of columns in the node; each thread accumulates a
+  // partial sum of its share of the columns.
+  #pragma omp parallel
   {
-    centroid += dataset->col(indices[i]);
+    arma::vec localCentroid(dataset->n_rows, arma::fill::zeros);
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
+    {
+      localCentroid += dataset->col(indices[i]);
+    }
+
+    #pragma omp critical
+    centroid += localCentroid;
   }
   centroid /= numColumns;
 }
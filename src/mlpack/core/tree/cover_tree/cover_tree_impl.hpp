@@ -21,6 +21,13 @@
 namespace mlpack {
 namespace tree {
 
+//! The minimum point set size for which the distance computations of the
+//! descendant-distribution step are parallelized.  At the top scales the sets
+//! cover nearly the whole dataset, which is where almost all build time goes;
+//! deeper in the recursion the sets are small and the threads are better left
+//! alone.
+static const size_t minParallelDistanceComps = 10000;
+
 // Build the statistics, bottom-up.
 template<typename TreeType, typename StatisticType>
 void BuildStatistics(TreeType* node)
@@ -1392,9 +1399,11 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
                      const size_t pointSetSize)
 {
   // For each point, rebuild the distances.  The indices do not need to be
-  // modified.
+  // modified.  Each iteration writes only its own element of the output, so
+  // the large point sets of the top scales can be computed in parallel.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  #pragma omp parallel for if (pointSetSize >= minParallelDistanceComps)
+  for (omp_size_t i = 0; i < (omp_size_t) pointSetSize; ++i)
   {
     distances[i] = metric->Evaluate(dataset->col(pointIndex),
         dataset->col(indices[i]));
@@ -143,6 +143,21 @@ class HRectBound
    */
   ElemType MinDistance(const HRectBound& other) const;
 
+  /**
+   * Calculates the minimum bound-to-point distance for every column of the
+   * given matrix of points at once, writing one distance per column into the
+   * output vector.  The ranges are unpacked into dense lower/upper arrays so
+   * the per-point clamp arithmetic runs over contiguous memory and can be
+   * vectorized by the compiler; results are identical to calling
+   * MinDistance() on each column.
+   *
+   * @param points Dense matrix of points (one point per column).
+   * @param distances Vector the minimum distances will be written to; it will
+   *     be sized to points.n_cols.
+   */
+  void MinDistances(const arma::Mat<ElemType>& points,
+                    arma::Col<ElemType>& distances) const;
+
   /**
    * Calculates maximum bound-to-point squared distance.
    *
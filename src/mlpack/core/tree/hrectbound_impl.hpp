@@ -301,6 +301,63 @@ ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
   }
 }
 
+/**
+ * Calculates minimum bound-to-point distances for a whole block of points.
+ */
+template<typename MetricType, typename ElemType>
+inline void HRectBound<MetricType, ElemType>::MinDistances(
+    const arma::Mat<ElemType>& points,
+    arma::Col<ElemType>& distances) const
+{
+  Log::Assert(points.n_rows == dim);
+
+  distances.set_size(points.n_cols);
+
+  // Unpack the ranges into dense lower/upper arrays once; the hot loop below
+  // then streams over three contiguous arrays per point, with no branches
+  // besides the clamps, so the compiler can vectorize it.
+  arma::Col<ElemType> lo(dim), hi(dim);
+  for (size_t d = 0; d < dim; ++d)
+  {
+    lo[d] = bounds[d].Lo();
+    hi[d] = bounds[d].Hi();
+  }
+
+  const ElemType* loMem = lo.memptr();
+  const ElemType* hiMem = hi.memptr();
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const ElemType* point = points.colptr(i);
+
+    ElemType sum = 0;
+    for (size_t d = 0; d < dim; ++d)
+    {
+      // The distance contribution of this dimension is how far the point
+      // sticks out of the range; at most one of the two clamps is nonzero.
+      const ElemType excess = std::max(loMem[d] - point[d], (ElemType) 0) +
+          std::max(point[d] - hiMem[d], (ElemType) 0);
+
+      // The compiler should optimize out this if statement entirely.
+      if (MetricType::Power == 1)
+        sum += excess;
+      else if (MetricType::Power == 2)
+        sum += excess * excess;
+      else
+        sum += std::pow(excess, (ElemType) MetricType::Power);
+    }
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      distances[i] = sum;
+    else if (MetricType::Power == 2)
+      distances[i] = MetricType::TakeRoot ? (ElemType) std::sqrt(sum) : sum;
+    else
+      distances[i] = MetricType::TakeRoot ?
+          (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power) : sum;
+  }
+}
+
 /**
  * Calculates maximum bound-to-point squared distance.
  */
@@ -400,6 +400,29 @@ class Octree
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
 
+  /**
+   * Build an octree over the given dataset by Morton-code sorting instead of
+   * recursive in-place partitioning.  The points are sorted once by their
+   * 63-bit Morton (Z-curve) codes -- a parallel radix sort running at memory
+   * bandwidth -- after which every node's children are contiguous runs of
+   * equal code prefixes and the tree is assembled by linear scans, with no
+   * further data movement.  The split planes follow the same center/width
+   * convention as the recursive build, so the resulting tree partitions
+   * space the same way (up to floating-point rounding of points exactly on
+   * a split plane, and with subdivision stopping at the Morton grid
+   * resolution of 63 / dimensions bits per dimension).
+   *
+   * The caller owns the returned tree.  The dataset dimensionality must be
+   * at most 63.
+   *
+   * @param data Dataset to build the tree on.
+   * @param oldFromNew Mapping from sorted to original point indices.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  static Octree* BuildMorton(const MatType& data,
+                             std::vector<size_t>& oldFromNew,
+                             const size_t maxLeafSize = 20);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -439,6 +462,39 @@ class Octree
                  std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize);
 
+  /**
+   * Attach children to this node from a Morton-sorted dataset.  codes holds
+   * the Morton code of each (sorted) dataset column; the children of this
+   * node are the maximal runs of columns sharing this level's code digit.
+   *
+   * @param codes Morton code of each column of the sorted dataset.
+   * @param level Depth of this node (0 for the root).
+   * @param bitsPerDim Bits of Morton resolution per dimension.
+   * @param center Center of the node.
+   * @param width Width of the current node.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void AssembleMorton(const std::vector<uint64_t>& codes,
+                      const size_t level,
+                      const size_t bitsPerDim,
+                      const arma::vec& center,
+                      const double width,
+                      const size_t maxLeafSize);
+
+  //! Rebuild the statistics of the subtree below this node, bottom-up.
+  void RecomputeStatistics();
+
+  /**
+   * Stable LSD radix sort of (Morton code, column index) pairs over the low
+   * keyBits bits, with per-pass histograms and scatters parallelized over
+   * contiguous chunks.
+   *
+   * @param codes Pairs to sort; sorted in place.
+   * @param keyBits Number of significant low bits in the keys.
+   */
+  static void MortonSort(std::vector<std::pair<uint64_t, size_t>>& codes,
+                         const size_t keyBits);
+
   /**
    * This is used for sorting points while splitting.
    */
@@ -973,6 +973,225 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
   }
 }
 
+//! Build the tree by Morton-code sorting.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>*
+Octree<MetricType, StatisticType, MatType>::BuildMorton(
+    const MatType& data,
+    std::vector<size_t>& oldFromNew,
+    const size_t maxLeafSize)
+{
+  const size_t dims = data.n_rows;
+  if (dims == 0 || dims > 63)
+  {
+    Log::Fatal << "Octree::BuildMorton(): Morton codes require between 1 and "
+        << "63 dimensions, but the dataset has " << dims << "!" << std::endl;
+  }
+  const size_t bitsPerDim = 63 / dims;
+
+  // Compute the root center and width exactly as the recursive build does.
+  bound::HRectBound<MetricType> rootBound(dims);
+  if (data.n_cols > 0)
+    rootBound |= data;
+  arma::vec center;
+  rootBound.Center(center);
+
+  double maxWidth = 0.0;
+  for (size_t d = 0; d < dims; ++d)
+    if (rootBound[d].Hi() - rootBound[d].Lo() > maxWidth)
+      maxWidth = rootBound[d].Hi() - rootBound[d].Lo();
+
+  // Degenerate inputs (no points, or all points identical) have no Morton
+  // structure to exploit; the recursive constructor handles them directly.
+  if (data.n_cols == 0 || maxWidth == 0.0)
+  {
+    oldFromNew.resize(data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+      oldFromNew[i] = i;
+    return new Octree(data, maxLeafSize);
+  }
+
+  // The split planes of the recursive build lie at center at the top level,
+  // then center +/- width / 2, and so on: the planes of a regular grid over
+  // the cube [center - width, center + width].  Quantizing each coordinate
+  // onto that grid makes bit (bitsPerDim - 1 - level) of the cell index the
+  // left/right decision at that level.
+  const double cubeWidth = 2.0 * maxWidth;
+  const uint64_t maxCell = ((uint64_t) 1 << bitsPerDim) - 1;
+
+  std::vector<std::pair<uint64_t, size_t>> codes(data.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    uint64_t code = 0;
+    // Interleave one digit of each dimension per level, most significant
+    // level first; within a digit, bit d corresponds to dimension d, the
+    // same convention as the child indexing of SplitNode().
+    for (size_t level = 0; level < bitsPerDim; ++level)
+    {
+      uint64_t digit = 0;
+      for (size_t d = 0; d < dims; ++d)
+      {
+        const double x = data(d, i);
+        double cell = std::floor((x - (center[d] - maxWidth)) / cubeWidth *
+            (double) (maxCell + 1));
+        cell = std::max(cell, 0.0);
+        cell = std::min(cell, (double) maxCell);
+        digit |= (((uint64_t) cell >> (bitsPerDim - 1 - level)) & 1) << d;
+      }
+      code = (code << dims) | digit;
+    }
+    codes[i] = std::make_pair(code, (size_t) i);
+  }
+
+  MortonSort(codes, bitsPerDim * dims);
+
+  // Gather the points into sorted order and record the mapping.
+  MatType sorted(dims, data.n_cols);
+  oldFromNew.resize(data.n_cols);
+  std::vector<uint64_t> sortedCodes(data.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    sorted.col(i) = data.col(codes[i].second);
+    oldFromNew[i] = codes[i].second;
+    sortedCodes[i] = codes[i].first;
+  }
+
+  // Create the root as a single unsplit node over the sorted data, then
+  // attach children by scanning the sorted codes; no points move again.
+  Octree* root = new Octree(std::move(sorted), data.n_cols);
+  root->AssembleMorton(sortedCodes, 0, bitsPerDim, center, maxWidth,
+      maxLeafSize);
+
+  // The nodes computed their statistics before their children were attached.
+  root->RecomputeStatistics();
+
+  return root;
+}
+
+//! Attach children from the Morton-sorted dataset.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::AssembleMorton(
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const arma::vec& center,
+    const double width,
+    const size_t maxLeafSize)
+{
+  // Leave an oversized leaf when the Morton resolution is exhausted (e.g.
+  // many duplicate points); the recursive build would keep splitting, but
+  // there is no more code structure to split on.
+  if (count <= maxLeafSize || level >= bitsPerDim)
+    return;
+
+  const size_t dims = dataset->n_rows;
+  const size_t shift = (bitsPerDim - 1 - level) * dims;
+  const uint64_t mask = ((uint64_t) 1 << dims) - 1;
+  const double childWidth = width / 2.0;
+
+  arma::vec childCenter(dims);
+  size_t start = begin;
+  while (start < begin + count)
+  {
+    // The child is the maximal run of columns sharing this level's digit.
+    const uint64_t digit = (codes[start] >> shift) & mask;
+    size_t end = start + 1;
+    while (end < begin + count && ((codes[end] >> shift) & mask) == digit)
+      ++end;
+
+    for (size_t d = 0; d < dims; ++d)
+    {
+      if (((digit >> d) & 1) == 0)
+        childCenter[d] = center[d] - childWidth;
+      else
+        childCenter[d] = center[d] + childWidth;
+    }
+
+    // Construct the child unsplit, then attach its children the same way.
+    Octree* child = new Octree(this, start, end - start, childCenter,
+        childWidth, dataset->n_cols);
+    children.push_back(child);
+    child->AssembleMorton(codes, level + 1, bitsPerDim, childCenter,
+        childWidth, maxLeafSize);
+
+    start = end;
+  }
+}
+
+//! Rebuild the statistics bottom-up.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::RecomputeStatistics()
+{
+  for (size_t i = 0; i < children.size(); ++i)
+    children[i]->RecomputeStatistics();
+  stat = StatisticType(*this);
+}
+
+//! Parallel stable LSD radix sort of the Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::MortonSort(
+    std::vector<std::pair<uint64_t, size_t>>& codes,
+    const size_t keyBits)
+{
+  const size_t n = codes.size();
+  std::vector<std::pair<uint64_t, size_t>> buffer(n);
+
+#ifdef HAS_OPENMP
+  const size_t numChunks = std::max(1, omp_get_max_threads());
+#else
+  const size_t numChunks = 1;
+#endif
+  const size_t chunkSize = (n + numChunks - 1) / numChunks;
+
+  const size_t passes = (keyBits + 7) / 8;
+  std::vector<size_t> histograms(numChunks * 256);
+
+  for (size_t pass = 0; pass < passes; ++pass)
+  {
+    const size_t shift = 8 * pass;
+
+    // Per-chunk histograms of this pass's byte.
+    std::fill(histograms.begin(), histograms.end(), 0);
+    #pragma omp parallel for
+    for (omp_size_t chunk = 0; chunk < (omp_size_t) numChunks; ++chunk)
+    {
+      size_t* histogram = &histograms[chunk * 256];
+      const size_t chunkBegin = chunk * chunkSize;
+      const size_t chunkEnd = std::min(n, chunkBegin + chunkSize);
+      for (size_t i = chunkBegin; i < chunkEnd; ++i)
+        ++histogram[(codes[i].first >> shift) & 0xff];
+    }
+
+    // Exclusive prefix sum in (byte value, chunk) order, so that equal bytes
+    // keep their chunk order and the sort stays stable.
+    size_t total = 0;
+    for (size_t byte = 0; byte < 256; ++byte)
+    {
+      for (size_t chunk = 0; chunk < numChunks; ++chunk)
+      {
+        const size_t count = histograms[chunk * 256 + byte];
+        histograms[chunk * 256 + byte] = total;
+        total += count;
+      }
+    }
+
+    // Scatter; each chunk writes through its own cursors.
+    #pragma omp parallel for
+    for (omp_size_t chunk = 0; chunk < (omp_size_t) numChunks; ++chunk)
+    {
+      size_t* cursors = &histograms[chunk * 256];
+      const size_t chunkBegin = chunk * chunkSize;
+      const size_t chunkEnd = std::min(n, chunkBegin + chunkSize);
+      for (size_t i = chunkBegin; i < chunkEnd; ++i)
+        buffer[cursors[(codes[i].first >> shift) & 0xff]++] = codes[i];
+    }
+
+    codes.swap(buffer);
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,103 @@
+/**
+ * @file core/tree/parallel_dual_tree_traverser.hpp
+ * @author Ryan Curtin
+ *
+ * A generic engine that runs a dual-tree traversal on multiple threads by
+ * splitting the query tree into independent subtrees and handing each
+ * (query subtree, reference root) combination to the tree's own depth-first
+ * DualTreeTraverser.  Any RuleType usable with the underlying traverser can
+ * be used here, as long as separate rule instances may safely run over
+ * disjoint query point ranges at the same time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The ParallelDualTreeTraverser runs a dual-tree algorithm over several
+ * threads.  It expands the query tree breadth-first into a frontier of
+ * disjoint subtrees (several per thread, so that dynamic scheduling can
+ * balance uneven subtree costs), then traverses each (query subtree,
+ * reference root) combination with TreeType's own DualTreeTraverser.  Each
+ * worker thread uses its own RuleType instance, so the rules never share
+ * mutable traversal state; since the query subtrees partition the query
+ * points, each query point's results end up in exactly one rule instance.
+ *
+ * The caller supplies one rule per thread (all constructed over the full
+ * query set) and afterwards collects results from all of them;
+ * QueryAssignments() reports which rule instance handled which query subtree
+ * for callers that need to gather per-query results from the right instance.
+ *
+ * If OpenMP is not available, the frontier is traversed sequentially with the
+ * first rule instance and the results match a plain dual-tree traversal.
+ *
+ * @tparam TreeType The tree type to be traversed; it must define a nested
+ *     DualTreeTraverser class template.
+ * @tparam RuleType The rule set to use for the traversal.
+ */
+template<typename TreeType, typename RuleType>
+class ParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel traverser with one rule instance per worker
+   * thread.  The vector must hold at least one rule and must outlive the
+   * traverser.
+   *
+   * @param rules One rule instance for each thread that may run.
+   */
+  ParallelDualTreeTraverser(std::vector<RuleType>& rules);
+
+  /**
+   * Traverse the two trees, distributing disjoint query subtrees over the
+   * available threads.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Get the number of prunes, summed over all worker traversals.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Get the number of visited combinations, summed over all workers.
+  size_t NumVisited() const { return numVisited; }
+  //! Get the number of scored combinations, summed over all workers.
+  size_t NumScores() const { return numScores; }
+  //! Get the number of base cases, summed over all workers.
+  size_t NumBaseCases() const { return numBaseCases; }
+
+  //! Get the (query subtree, rule index) assignments of the last traversal.
+  //! The subtrees partition the query points of the traversed query node.
+  const std::vector<std::pair<TreeType*, size_t>>& QueryAssignments() const
+  { return assignments; }
+
+ private:
+  //! The per-thread rule instances.
+  std::vector<RuleType>& rules;
+
+  //! Statistics summed over all worker traversals.
+  size_t numPrunes;
+  size_t numVisited;
+  size_t numScores;
+  size_t numBaseCases;
+
+  //! Which rule instance traversed which query subtree, for result gathering.
+  std::vector<std::pair<TreeType*, size_t>> assignments;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_dual_tree_traverser_impl.hpp"
+
+#endif
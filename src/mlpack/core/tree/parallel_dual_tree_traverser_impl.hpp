@@ -0,0 +1,125 @@
+/**
+ * @file core/tree/parallel_dual_tree_traverser_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the generic parallel dual-tree traversal engine.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_dual_tree_traverser.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+ParallelDualTreeTraverser<TreeType, RuleType>::ParallelDualTreeTraverser(
+    std::vector<RuleType>& rules) :
+    rules(rules),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{
+  Log::Assert(rules.size() > 0);
+}
+
+template<typename TreeType, typename RuleType>
+void ParallelDualTreeTraverser<TreeType, RuleType>::Traverse(
+    TreeType& queryNode,
+    TreeType& referenceNode)
+{
+  assignments.clear();
+
+#ifdef HAS_OPENMP
+  const size_t numThreads = std::min(rules.size(),
+      (size_t) omp_get_max_threads());
+#else
+  const size_t numThreads = 1;
+#endif
+
+  // Expand the query tree breadth-first into a frontier of disjoint subtrees.
+  // Several subtrees per thread are generated so that dynamic scheduling can
+  // balance subtrees of very different cost; always splitting the node with
+  // the most descendants keeps the frontier roughly even.
+  const size_t targetTasks = 4 * numThreads;
+  std::vector<TreeType*> frontier;
+  frontier.push_back(&queryNode);
+  while (frontier.size() < targetTasks)
+  {
+    // Find the expandable frontier node with the most descendants.
+    size_t largest = frontier.size();
+    for (size_t i = 0; i < frontier.size(); ++i)
+    {
+      if (frontier[i]->NumChildren() > 0 &&
+          (largest == frontier.size() ||
+           frontier[i]->NumDescendants() >
+               frontier[largest]->NumDescendants()))
+        largest = i;
+    }
+
+    if (largest == frontier.size())
+      break; // All frontier nodes are leaves.
+
+    TreeType* node = frontier[largest];
+    frontier[largest] = &node->Child(0);
+    for (size_t c = 1; c < node->NumChildren(); ++c)
+      frontier.push_back(&node->Child(c));
+  }
+
+  assignments.resize(frontier.size());
+
+  // Each task scores its (query subtree, reference root) combination first --
+  // the depth-first traverser only scores the root combination itself -- and
+  // then runs the tree's own dual-tree traverser with the thread's rule
+  // instance.
+  size_t prunes = 0;
+  size_t visited = 0;
+  size_t scores = 0;
+  size_t baseCases = 0;
+
+  #pragma omp parallel for schedule(dynamic) \
+      reduction(+: prunes, visited, scores, baseCases)
+  for (omp_size_t i = 0; i < (omp_size_t) frontier.size(); ++i)
+  {
+#ifdef HAS_OPENMP
+    const size_t thread = (size_t) omp_get_thread_num();
+#else
+    const size_t thread = 0;
+#endif
+    RuleType& rule = rules[thread];
+    assignments[i] = std::make_pair(frontier[i], thread);
+
+    const double score = rule.Score(*frontier[i], referenceNode);
+    ++scores;
+    if (score == DBL_MAX)
+    {
+      ++prunes;
+      continue;
+    }
+
+    typename TreeType::template DualTreeTraverser<RuleType> traverser(rule);
+    traverser.Traverse(*frontier[i], referenceNode);
+
+    prunes += traverser.NumPrunes();
+    visited += traverser.NumVisited();
+    scores += traverser.NumScores();
+    baseCases += traverser.NumBaseCases();
+  }
+
+  numPrunes += prunes;
+  numVisited += visited;
+  numScores += scores;
+  numBaseCases += baseCases;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -152,6 +152,127 @@ size_t PerformSplit(MatType& data,
   return left;
 }
 
+/**
+ * This function rearranges the points with an in-place three-way (Dutch
+ * national flag) partition, using SplitType::ClassifyPoint() to place each
+ * point left of, on, or right of the split plane.  The run of points lying
+ * exactly on the split value is then assigned to whichever side brings the
+ * split closest to the median, so duplicate-heavy data cannot degenerate the
+ * tree; points on the split plane belong to either child equally well, since
+ * the child bounds are recomputed from the points afterwards.  Each point is
+ * classified exactly once and only misplaced points are swapped.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ */
+template<typename MatType, typename SplitType>
+size_t PerformThreeWaySplit(MatType& data,
+                            const size_t begin,
+                            const size_t count,
+                            const typename SplitType::SplitInfo& splitInfo)
+{
+  // Invariant: [begin, lt) is left of the plane, [lt, i) is on the plane,
+  // [i, gt) is unclassified, and [gt, begin + count) is right of the plane.
+  size_t lt = begin;
+  size_t i = begin;
+  size_t gt = begin + count;
+
+  while (i < gt)
+  {
+    const int c = SplitType::ClassifyPoint(data.col(i), splitInfo);
+    if (c < 0)
+    {
+      if (i != lt)
+        data.swap_cols(i, lt);
+      ++lt;
+      ++i;
+    }
+    else if (c > 0)
+    {
+      --gt;
+      data.swap_cols(i, gt);
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  // Assign the on-plane run to balance the children.
+  const size_t half = count / 2;
+  const size_t countLt = lt - begin;
+  const size_t countEq = gt - lt;
+  if (countLt >= half)
+    return lt;
+  else if (countLt + countEq <= half)
+    return gt;
+  return begin + half;
+}
+
+/**
+ * Identical to PerformThreeWaySplit() above, but also keeps the old-from-new
+ * index mapping in sync with the swaps.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ * @param oldFromNew Vector which will be filled with the old positions for
+ *    each new point.
+ */
+template<typename MatType, typename SplitType>
+size_t PerformThreeWaySplit(MatType& data,
+                            const size_t begin,
+                            const size_t count,
+                            const typename SplitType::SplitInfo& splitInfo,
+                            std::vector<size_t>& oldFromNew)
+{
+  // Invariant: [begin, lt) is left of the plane, [lt, i) is on the plane,
+  // [i, gt) is unclassified, and [gt, begin + count) is right of the plane.
+  size_t lt = begin;
+  size_t i = begin;
+  size_t gt = begin + count;
+
+  while (i < gt)
+  {
+    const int c = SplitType::ClassifyPoint(data.col(i), splitInfo);
+    if (c < 0)
+    {
+      if (i != lt)
+      {
+        data.swap_cols(i, lt);
+        std::swap(oldFromNew[i], oldFromNew[lt]);
+      }
+      ++lt;
+      ++i;
+    }
+    else if (c > 0)
+    {
+      --gt;
+      data.swap_cols(i, gt);
+      std::swap(oldFromNew[i], oldFromNew[gt]);
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  // Assign the on-plane run to balance the children.
+  const size_t half = count / 2;
+  const size_t countLt = lt - begin;
+  const size_t countEq = gt - lt;
+  if (countLt >= half)
+    return lt;
+  else if (countLt + countEq <= half)
+    return gt;
+  return begin + half;
+}
+
 } // namespace split
 } // namespace tree
 } // namespace mlpack
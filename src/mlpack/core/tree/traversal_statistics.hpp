@@ -0,0 +1,123 @@
+/**
+ * @file core/tree/traversal_statistics.hpp
+ * @author Ryan Curtin
+ *
+ * Opt-in instrumentation counters for tree traversals.  Rule classes take a
+ * statistics type as a template parameter; the default NullTraversalStatistics
+ * compiles to nothing, and TraversalStatistics records how a traversal spent
+ * its time -- scores, prunes by reason, base cases, and bound tightenings --
+ * so a latency regression can be attributed to worse pruning or to slower
+ * base cases.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Traversal instrumentation counters.  A rule class instantiated with this
+ * type counts, over the lifetime of the rule object (i.e. one Search() call):
+ *
+ *  - scores: node (or point-node) combinations evaluated by Score();
+ *  - score prunes: combinations Score() pruned outright;
+ *  - rescore prunes: combinations pruned later by Rescore(), after another
+ *    recursion tightened the bounds;
+ *  - base cases: point-to-point distance evaluations; and
+ *  - bound tightenings: base cases that improved a result candidate list.
+ *
+ * To instrument a search, instantiate the rule type with this class as its
+ * statistics parameter, run a traverser over it, and read the counters:
+ *
+ * @code
+ * NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType,
+ *     TraversalStatistics> rules(referenceSet, querySet, k, metric);
+ * typename TreeType::template SingleTreeTraverser<decltype(rules)> t(rules);
+ * for (size_t i = 0; i < querySet.n_cols; ++i)
+ *   t.Traverse(i, referenceTree);
+ * Log::Info << rules.TraversalStats().NumScorePrunes() << " prunes.\n";
+ * @endcode
+ */
+class TraversalStatistics
+{
+ public:
+  //! Initialize all counters to zero.
+  TraversalStatistics() { Reset(); }
+
+  //! Count one Score() evaluation.
+  void CountScore() { ++numScores; }
+  //! Count one combination pruned by Score().
+  void CountScorePrune() { ++numScorePrunes; }
+  //! Count one combination pruned by Rescore().
+  void CountRescorePrune() { ++numRescorePrunes; }
+  //! Count one base case (point-to-point) evaluation.
+  void CountBaseCase() { ++numBaseCases; }
+  //! Count one base case that improved the results.
+  void CountBoundTightening() { ++numBoundTightenings; }
+
+  //! Get the number of Score() evaluations.
+  size_t NumScores() const { return numScores; }
+  //! Get the number of combinations pruned by Score().
+  size_t NumScorePrunes() const { return numScorePrunes; }
+  //! Get the number of combinations pruned by Rescore().
+  size_t NumRescorePrunes() const { return numRescorePrunes; }
+  //! Get the number of base case evaluations.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Get the number of base cases that improved the results.
+  size_t NumBoundTightenings() const { return numBoundTightenings; }
+
+  //! Reset all counters to zero.
+  void Reset()
+  {
+    numScores = 0;
+    numScorePrunes = 0;
+    numRescorePrunes = 0;
+    numBaseCases = 0;
+    numBoundTightenings = 0;
+  }
+
+  //! Fold another set of counters into this one (e.g. from per-thread rules).
+  void Merge(const TraversalStatistics& other)
+  {
+    numScores += other.numScores;
+    numScorePrunes += other.numScorePrunes;
+    numRescorePrunes += other.numRescorePrunes;
+    numBaseCases += other.numBaseCases;
+    numBoundTightenings += other.numBoundTightenings;
+  }
+
+ private:
+  size_t numScores;
+  size_t numScorePrunes;
+  size_t numRescorePrunes;
+  size_t numBaseCases;
+  size_t numBoundTightenings;
+};
+
+/**
+ * The default statistics type for rule classes: every method is an empty
+ * inline, so instrumentation costs nothing when it is not requested.
+ */
+class NullTraversalStatistics
+{
+ public:
+  void CountScore() { }
+  void CountScorePrune() { }
+  void CountRescorePrune() { }
+  void CountBaseCase() { }
+  void CountBoundTightening() { }
+  void Reset() { }
+  void Merge(const NullTraversalStatistics& /* other */) { }
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ * @file core/util/deterministic_mode.cpp
+ *
+ * Implementation of the process-wide determinism policy flag.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "deterministic_mode.hpp"
+
+namespace mlpack {
+namespace util {
+
+namespace {
+
+//! The process-wide flag; off by default.
+bool deterministicMode = false;
+
+} // namespace
+
+bool DeterministicMode()
+{
+  return deterministicMode;
+}
+
+void DeterministicMode(const bool value)
+{
+  deterministicMode = value;
+}
+
+} // namespace util
+} // namespace mlpack
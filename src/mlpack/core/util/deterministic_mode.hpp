@@ -0,0 +1,72 @@
+/**
+ * @file core/util/deterministic_mode.hpp
+ *
+ * A process-wide determinism policy for mlpack's parallel algorithms.  When
+ * enabled, parallel regions that honor the policy assign work to a fixed set
+ * of chunks (independent of the number of threads and of the run-to-run
+ * schedule) and combine the per-chunk partial results in a fixed pairwise
+ * order, so floating-point results are bitwise reproducible from run to run
+ * at a small throughput cost.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_DETERMINISTIC_MODE_HPP
+#define MLPACK_CORE_UTIL_DETERMINISTIC_MODE_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * Get whether the deterministic parallel mode is enabled.  The default is
+ * false.
+ */
+bool DeterministicMode();
+
+/**
+ * Enable or disable the deterministic parallel mode for the whole process.
+ * This should not be called concurrently with running algorithms.
+ *
+ * @param value Whether parallel algorithms should produce bitwise
+ *     reproducible results.
+ */
+void DeterministicMode(const bool value);
+
+/**
+ * The number of work chunks that determinism-aware parallel regions split
+ * their input into when the deterministic mode is enabled.  The chunk count
+ * is a fixed constant (rather than the thread count) so that the partial
+ * results — and therefore the reduced result — do not depend on how many
+ * threads the run happened to use.
+ */
+static const size_t deterministicChunks = 64;
+
+/**
+ * Reduce a sequence of per-chunk partial results in a fixed pairwise (tree)
+ * order, leaving the combined result in partials[0].  Because the
+ * combination order depends only on the number of partials, the result is
+ * bitwise reproducible no matter which threads produced the partials, and
+ * the pairwise tree keeps the floating-point error growth logarithmic in the
+ * number of chunks.
+ *
+ * @param partials Per-chunk partial results; any type with operator+=.
+ */
+template<typename T>
+void PairwiseReduce(std::vector<T>& partials)
+{
+  for (size_t stride = 1; stride < partials.size(); stride *= 2)
+  {
+    for (size_t i = 0; i + stride < partials.size(); i += 2 * stride)
+      partials[i] += partials[i + stride];
+  }
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_DETERMINISTIC_MODE_HPP
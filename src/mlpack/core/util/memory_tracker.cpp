@@ -0,0 +1,303 @@
+/**
+ * @file core/util/memory_tracker.cpp
+ *
+ * Implementation of the opt-in memory instrumentation layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "memory_tracker.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+namespace {
+
+//! Counters for one subsystem tag.
+struct TagStats
+{
+  uint64_t allocations;
+  uint64_t bytesAllocated;
+  uint64_t currentBytes;
+  uint64_t peakBytes;
+
+  TagStats() : allocations(0), bytesAllocated(0), currentBytes(0),
+      peakBytes(0) { }
+};
+
+//! The high-water mark of one timer scope.
+struct ScopeStats
+{
+  uint64_t startBytes;
+  uint64_t peakBytes;
+
+  ScopeStats() : startBytes(0), peakBytes(0) { }
+};
+
+//! All shared tracking state, guarded by one mutex (the tracking path is a
+//! diagnostic tool, so simplicity beats lock-freedom here).
+struct TrackerState
+{
+  std::mutex mutex;
+  uint64_t currentBytes;
+  uint64_t peakBytes;
+  std::map<std::string, TagStats> tags;
+  //! Timer scopes currently running; their peaks advance on every
+  //! allocation.
+  std::map<std::string, ScopeStats> activeScopes;
+  //! Timer scopes that have finished, keyed by name (peaks are merged when
+  //! a scope runs more than once).
+  std::map<std::string, ScopeStats> completedScopes;
+
+  TrackerState() : currentBytes(0), peakBytes(0) { }
+};
+
+TrackerState& GetState()
+{
+  static TrackerState state;
+  return state;
+}
+
+std::atomic<bool>& GetEnabledFlag()
+{
+  static std::atomic<bool> enabled(false);
+  return enabled;
+}
+
+//! The calling thread's stack of subsystem tags.
+std::vector<std::string>& GetTagStack()
+{
+  static thread_local std::vector<std::string> tagStack;
+  return tagStack;
+}
+
+//! Read a VmRSS/VmHWM-style field (given in kB) from /proc/self/status;
+//! returns 0 on platforms without procfs.
+uint64_t ReadProcStatusField(const std::string& field)
+{
+  std::ifstream status("/proc/self/status");
+  if (!status.is_open())
+    return 0;
+
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, field.length(), field) == 0)
+    {
+      std::istringstream iss(line.substr(field.length() + 1));
+      uint64_t kb = 0;
+      iss >> kb;
+      return kb * 1024;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace
+
+void* MemoryTracker::Allocate(const size_t bytes)
+{
+  void* mem = std::malloc(bytes);
+  if (mem == NULL && bytes > 0)
+    throw std::bad_alloc();
+
+  if (GetEnabledFlag())
+  {
+    TrackerState& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    state.currentBytes += bytes;
+    if (state.currentBytes > state.peakBytes)
+      state.peakBytes = state.currentBytes;
+
+    const std::vector<std::string>& tagStack = GetTagStack();
+    if (!tagStack.empty())
+    {
+      TagStats& tag = state.tags[tagStack.back()];
+      ++tag.allocations;
+      tag.bytesAllocated += bytes;
+      tag.currentBytes += bytes;
+      if (tag.currentBytes > tag.peakBytes)
+        tag.peakBytes = tag.currentBytes;
+    }
+
+    for (std::map<std::string, ScopeStats>::iterator it =
+        state.activeScopes.begin(); it != state.activeScopes.end(); ++it)
+    {
+      if (state.currentBytes > it->second.peakBytes)
+        it->second.peakBytes = state.currentBytes;
+    }
+  }
+
+  return mem;
+}
+
+void MemoryTracker::Free(void* mem, const size_t bytes)
+{
+  if (GetEnabledFlag())
+  {
+    TrackerState& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    state.currentBytes -= std::min((uint64_t) bytes, state.currentBytes);
+
+    const std::vector<std::string>& tagStack = GetTagStack();
+    if (!tagStack.empty())
+    {
+      TagStats& tag = state.tags[tagStack.back()];
+      tag.currentBytes -= std::min((uint64_t) bytes, tag.currentBytes);
+    }
+  }
+
+  std::free(mem);
+}
+
+bool MemoryTracker::Enabled()
+{
+  return GetEnabledFlag();
+}
+
+std::atomic<bool>& MemoryTracker::EnabledFlag()
+{
+  return GetEnabledFlag();
+}
+
+void MemoryTracker::PushTag(const std::string& tag)
+{
+  GetTagStack().push_back(tag);
+}
+
+void MemoryTracker::PopTag()
+{
+  if (!GetTagStack().empty())
+    GetTagStack().pop_back();
+}
+
+void MemoryTracker::TimerScopeStart(const std::string& name)
+{
+  if (!GetEnabledFlag())
+    return;
+
+  TrackerState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+
+  ScopeStats& scope = state.activeScopes[name];
+  scope.startBytes = state.currentBytes;
+  scope.peakBytes = state.currentBytes;
+}
+
+void MemoryTracker::TimerScopeStop(const std::string& name)
+{
+  if (!GetEnabledFlag())
+    return;
+
+  TrackerState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+
+  const std::map<std::string, ScopeStats>::iterator it =
+      state.activeScopes.find(name);
+  if (it == state.activeScopes.end())
+    return;
+
+  ScopeStats& completed = state.completedScopes[name];
+  if (completed.peakBytes == 0 || it->second.peakBytes > completed.peakBytes)
+  {
+    completed.startBytes = it->second.startBytes;
+    completed.peakBytes = it->second.peakBytes;
+  }
+  state.activeScopes.erase(it);
+}
+
+uint64_t MemoryTracker::CurrentBytes()
+{
+  TrackerState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.currentBytes;
+}
+
+uint64_t MemoryTracker::PeakBytes()
+{
+  TrackerState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.peakBytes;
+}
+
+uint64_t MemoryTracker::CurrentRSS()
+{
+  return ReadProcStatusField("VmRSS:");
+}
+
+uint64_t MemoryTracker::PeakRSS()
+{
+  return ReadProcStatusField("VmHWM:");
+}
+
+std::string MemoryTracker::Dump()
+{
+  // Take the RSS probes before locking (they don't need the state).
+  const uint64_t currentRSS = CurrentRSS();
+  const uint64_t peakRSS = PeakRSS();
+
+  TrackerState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+
+  std::ostringstream oss;
+  oss << "{\n";
+  oss << "  \"current_bytes\": " << state.currentBytes << ",\n";
+  oss << "  \"peak_bytes\": " << state.peakBytes << ",\n";
+  oss << "  \"current_rss_bytes\": " << currentRSS << ",\n";
+  oss << "  \"peak_rss_bytes\": " << peakRSS << ",\n";
+
+  oss << "  \"tags\": {";
+  for (std::map<std::string, TagStats>::const_iterator it =
+      state.tags.begin(); it != state.tags.end(); ++it)
+  {
+    oss << (it == state.tags.begin() ? "\n" : ",\n");
+    oss << "    \"" << it->first << "\": { \"allocations\": "
+        << it->second.allocations << ", \"bytes_allocated\": "
+        << it->second.bytesAllocated << ", \"current_bytes\": "
+        << it->second.currentBytes << ", \"peak_bytes\": "
+        << it->second.peakBytes << " }";
+  }
+  oss << (state.tags.empty() ? "},\n" : "\n  },\n");
+
+  oss << "  \"timer_scopes\": {";
+  for (std::map<std::string, ScopeStats>::const_iterator it =
+      state.completedScopes.begin(); it != state.completedScopes.end(); ++it)
+  {
+    oss << (it == state.completedScopes.begin() ? "\n" : ",\n");
+    oss << "    \"" << it->first << "\": { \"start_bytes\": "
+        << it->second.startBytes << ", \"peak_bytes\": "
+        << it->second.peakBytes << " }";
+  }
+  oss << (state.completedScopes.empty() ? "}\n" : "\n  }\n");
+
+  oss << "}\n";
+  return oss.str();
+}
+
+void MemoryTracker::Clear()
+{
+  TrackerState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+
+  state.currentBytes = 0;
+  state.peakBytes = 0;
+  state.tags.clear();
+  state.activeScopes.clear();
+  state.completedScopes.clear();
+}
+
+} // namespace util
+} // namespace mlpack
@@ -0,0 +1,131 @@
+/**
+ * @file core/util/memory_tracker.hpp
+ *
+ * Opt-in tracking of Armadillo buffer allocations: per-tag counters, a
+ * high-water mark per timer scope, and a machine-readable dump.
+ *
+ * When mlpack is compiled with MLPACK_ENABLE_MEMORY_TRACKING, every
+ * Armadillo buffer allocation and deallocation is routed through
+ * MemoryTracker (via Armadillo's alien-memory hooks, see arma_extend.hpp).
+ * Accounting itself is additionally gated at runtime on
+ * MemoryTracker::Enabled(), so even a tracking build costs one branch per
+ * allocation until tracking is switched on.  Without the compile-time flag
+ * this header adds nothing to the allocation path at all.
+ *
+ * Typical use:
+ *
+ * @code
+ * util::MemoryTracker::Enabled() = true;
+ * {
+ *   util::MemoryTracker::ScopedTag tag("KFoldCV");
+ *   cv.Evaluate(...);  // Allocations are attributed to "KFoldCV".
+ * }
+ * Log::Info << util::MemoryTracker::Dump();  // Machine-readable (JSON).
+ * @endcode
+ *
+ * Timer scopes integrate automatically: while tracking is enabled, every
+ * Timer::Start()/Timer::Stop() pair also records the allocated-bytes
+ * high-water mark reached within that interval, so the dump shows which
+ * timed phase drove peak memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_MEMORY_TRACKER_HPP
+#define MLPACK_CORE_UTIL_MEMORY_TRACKER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The memory-instrumentation backend.  All methods are safe to call from
+ * multiple threads.
+ */
+class MemoryTracker
+{
+ public:
+  /**
+   * Allocate a buffer of the given size and account for it.  This is the
+   * Armadillo alien-memory allocation hook; it throws std::bad_alloc on
+   * failure, like operator new.
+   */
+  static void* Allocate(const size_t bytes);
+
+  /**
+   * Free a buffer previously returned by Allocate() and account for it.
+   * This is the Armadillo alien-memory deallocation hook.
+   */
+  static void Free(void* mem, const size_t bytes);
+
+  //! Get whether allocation accounting is active (default false).
+  static bool Enabled();
+  //! Modify whether allocation accounting is active.
+  static std::atomic<bool>& EnabledFlag();
+
+  /**
+   * Push a subsystem tag for the calling thread; until the matching
+   * PopTag(), allocations made by this thread are attributed to the tag.
+   * Tags nest, and the innermost tag wins.  Prefer ScopedTag.
+   */
+  static void PushTag(const std::string& tag);
+
+  //! Pop the innermost subsystem tag of the calling thread.
+  static void PopTag();
+
+  //! Called by Timers::Start(): begin tracking a high-water mark for the
+  //! named timer scope.
+  static void TimerScopeStart(const std::string& name);
+
+  //! Called by Timers::Stop(): finish tracking the named timer scope and
+  //! record its high-water mark.
+  static void TimerScopeStop(const std::string& name);
+
+  //! Get the number of currently allocated (tracked) bytes.
+  static uint64_t CurrentBytes();
+
+  //! Get the highest number of simultaneously allocated (tracked) bytes.
+  static uint64_t PeakBytes();
+
+  //! Get the process' current resident set size in bytes, as reported by
+  //! the operating system (0 if unavailable on this platform).
+  static uint64_t CurrentRSS();
+
+  //! Get the process' peak resident set size in bytes, as reported by the
+  //! operating system (0 if unavailable on this platform).
+  static uint64_t PeakRSS();
+
+  /**
+   * Render all recorded statistics as JSON: global counters, OS-reported
+   * RSS, per-tag counters, and the high-water mark of each completed timer
+   * scope.
+   */
+  static std::string Dump();
+
+  //! Discard all recorded statistics (the enabled flag is not changed).
+  static void Clear();
+
+  /**
+   * An RAII subsystem tag: allocations made by the constructing thread
+   * while this object is alive are attributed to the given tag.
+   */
+  class ScopedTag
+  {
+   public:
+    //! Attribute subsequent allocations of this thread to the given tag.
+    explicit ScopedTag(const std::string& tag) { PushTag(tag); }
+    //! Restore the previous tag.
+    ~ScopedTag() { PopTag(); }
+  };
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_MEMORY_TRACKER_HPP
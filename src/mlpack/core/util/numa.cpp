@@ -0,0 +1,131 @@
+/**
+ * @file core/util/numa.cpp
+ *
+ * Implementation of NUMA node discovery and thread pinning.  The Linux
+ * implementation reads the node topology from sysfs
+ * (/sys/devices/system/node/) and pins through the pthread affinity
+ * interface; no libnuma dependency is needed.  On other platforms the
+ * machine is a single node and pinning is declined.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "numa.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+namespace mlpack {
+namespace util {
+
+namespace {
+
+#ifdef __linux__
+
+/**
+ * Read the CPU list of the given node from sysfs into a cpu_set_t.  The
+ * cpulist file holds comma-separated CPU ranges like "0-15,32-47".
+ *
+ * @return true if the node exists and has at least one CPU.
+ */
+bool ReadNodeCpuSet(const size_t node, cpu_set_t& cpus)
+{
+  std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) +
+      "/cpulist");
+  if (!file.is_open())
+    return false;
+
+  CPU_ZERO(&cpus);
+  bool any = false;
+  std::string range;
+  while (std::getline(file, range, ','))
+  {
+    long first = -1;
+    long last = -1;
+    const size_t dash = range.find('-');
+    std::istringstream(range.substr(0, dash)) >> first;
+    if (dash == std::string::npos)
+      last = first;
+    else
+      std::istringstream(range.substr(dash + 1)) >> last;
+
+    for (long cpu = first; cpu >= 0 && cpu <= last && cpu < CPU_SETSIZE;
+        ++cpu)
+    {
+      CPU_SET((int) cpu, &cpus);
+      any = true;
+    }
+  }
+
+  return any;
+}
+
+#endif
+
+} // namespace
+
+size_t NumNumaNodes()
+{
+#ifdef __linux__
+  static const size_t numNodes = []() -> size_t
+  {
+    size_t count = 0;
+    while (true)
+    {
+      std::ifstream file("/sys/devices/system/node/node" +
+          std::to_string(count) + "/cpulist");
+      if (!file.is_open())
+        break;
+      ++count;
+    }
+    return (count == 0) ? 1 : count;
+  }();
+  return numNodes;
+#else
+  return 1;
+#endif
+}
+
+size_t NumaNodeOfThread(const size_t thread, const size_t numThreads)
+{
+  const size_t numNodes = NumNumaNodes();
+  if (numThreads == 0)
+    return 0;
+  return std::min(numNodes - 1, (thread * numNodes) / numThreads);
+}
+
+bool PinThreadToNumaNode(const size_t node)
+{
+#ifdef __linux__
+  return PinThreadToNumaNode(pthread_self(), node);
+#else
+  (void) node;
+  return false;
+#endif
+}
+
+bool PinThreadToNumaNode(std::thread::native_handle_type handle,
+                         const size_t node)
+{
+#ifdef __linux__
+  cpu_set_t cpus;
+  if (!ReadNodeCpuSet(node, cpus))
+    return false;
+  return pthread_setaffinity_np(handle, sizeof(cpu_set_t), &cpus) == 0;
+#else
+  (void) handle;
+  (void) node;
+  return false;
+#endif
+}
+
+} // namespace util
+} // namespace mlpack
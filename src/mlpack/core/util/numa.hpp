@@ -0,0 +1,174 @@
+/**
+ * @file core/util/numa.hpp
+ *
+ * NUMA (non-uniform memory access) support for large-matrix training.  On a
+ * multi-socket machine the operating system places each memory page on the
+ * NUMA node of the thread that first writes it ("first touch"), so a big
+ * matrix filled by a single thread lands entirely on one node and every
+ * other socket reads it through the interconnect at a fraction of local
+ * bandwidth.  The helpers here make the placement deliberate: a matrix can
+ * be first-touched in the same contiguous column shards that a static
+ * OpenMP schedule later hands to each thread, or interleaved page-by-page
+ * across the nodes, and threads can be pinned to a node so the shards stay
+ * local.
+ *
+ * Node discovery and pinning are implemented for Linux (via sysfs and the
+ * pthread affinity interface); on other platforms the machine is reported
+ * as a single node and pinning requests are declined, so calling code needs
+ * no platform checks of its own.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_NUMA_HPP
+#define MLPACK_CORE_UTIL_NUMA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <thread>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace util {
+
+/**
+ * Get the number of NUMA nodes of the machine.  The probe runs once and the
+ * result is cached.  On platforms without node discovery (everything but
+ * Linux) this returns 1.
+ */
+size_t NumNumaNodes();
+
+/**
+ * Map a thread of a team to a NUMA node: the team is split into one
+ * contiguous block of threads per node, matching the contiguous column
+ * shards of a static schedule, so neighbouring threads (which process
+ * neighbouring shards) share a node.
+ *
+ * @param thread Index of the thread within the team.
+ * @param numThreads Size of the team.
+ */
+size_t NumaNodeOfThread(const size_t thread, const size_t numThreads);
+
+/**
+ * Pin the calling thread to the CPUs of the given NUMA node.
+ *
+ * @param node The node to pin to.
+ * @return true if the thread was pinned; false if the node does not exist
+ *     or the platform does not support pinning.
+ */
+bool PinThreadToNumaNode(const size_t node);
+
+/**
+ * Pin the given thread to the CPUs of the given NUMA node.
+ *
+ * @param handle Native handle of the thread to pin.
+ * @param node The node to pin to.
+ * @return true if the thread was pinned; false if the node does not exist
+ *     or the platform does not support pinning.
+ */
+bool PinThreadToNumaNode(std::thread::native_handle_type handle,
+                         const size_t node);
+
+/**
+ * Compute the contiguous column shard that the given member of a team owns.
+ * This is the one partition shared by the first-touch helpers and by
+ * schedule(static) loops, so the thread that touched a shard's pages is the
+ * thread that later reads them.
+ *
+ * @param totalCols Number of columns being partitioned.
+ * @param shard Index of the shard (i.e. of the thread).
+ * @param numShards Number of shards (i.e. size of the team).
+ * @param begin Set to the first column of the shard.
+ * @param end Set to one past the last column of the shard.
+ */
+inline void ColumnShard(const size_t totalCols,
+                        const size_t shard,
+                        const size_t numShards,
+                        size_t& begin,
+                        size_t& end)
+{
+  begin = (totalCols * shard) / numShards;
+  end = (totalCols * (shard + 1)) / numShards;
+}
+
+/**
+ * Allocate a matrix and first-touch it in contiguous column shards, one per
+ * thread, so that each shard's pages land on the NUMA node of the thread
+ * that touched them.  A later parallel loop over the columns with
+ * schedule(static)---or with ColumnShard()---then reads node-local memory.
+ * The matrix is zero-filled; load the data into it afterwards (the pages
+ * keep their placement once touched).
+ *
+ * @param matrix Matrix to allocate and touch.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ */
+template<typename eT>
+void ShardedFirstTouch(arma::Mat<eT>& matrix,
+                       const size_t rows,
+                       const size_t cols)
+{
+  matrix.set_size(rows, cols);
+  if (matrix.n_elem == 0)
+    return;
+
+  #pragma omp parallel
+  {
+    size_t numThreads = 1;
+    size_t thread = 0;
+    #ifdef HAS_OPENMP
+    numThreads = (size_t) omp_get_num_threads();
+    thread = (size_t) omp_get_thread_num();
+    #endif
+
+    size_t begin, end;
+    ColumnShard(cols, thread, numThreads, begin, end);
+    if (begin < end)
+      matrix.cols(begin, end - 1).zeros();
+  }
+}
+
+/**
+ * Allocate a matrix and first-touch it one page at a time, round-robin
+ * across the threads, so the pages end up spread evenly over the NUMA
+ * nodes.  Use this for matrices accessed with no exploitable thread-to-
+ * column affinity (dynamic schedules, random access): no node is local, but
+ * none is a bottleneck either.  The matrix is zero-filled.
+ *
+ * @param matrix Matrix to allocate and touch.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ */
+template<typename eT>
+void InterleavedFirstTouch(arma::Mat<eT>& matrix,
+                           const size_t rows,
+                           const size_t cols)
+{
+  matrix.set_size(rows, cols);
+  if (matrix.n_elem == 0)
+    return;
+
+  // Columns per 4 KiB page (at least one, for very tall matrices).
+  const size_t pageBytes = 4096;
+  const size_t colBytes = std::max<size_t>(rows * sizeof(eT), 1);
+  const size_t colsPerPage = std::max<size_t>(pageBytes / colBytes, 1);
+  const size_t groups = (cols + colsPerPage - 1) / colsPerPage;
+
+  #pragma omp parallel for schedule(static, 1)
+  for (omp_size_t g = 0; g < (omp_size_t) groups; ++g)
+  {
+    const size_t begin = (size_t) g * colsPerPage;
+    const size_t end = std::min(cols, begin + colsPerPage);
+    matrix.cols(begin, end - 1).zeros();
+  }
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_NUMA_HPP
@@ -7,6 +7,9 @@
 #include "params.hpp"
 #include <mlpack/core/data/dataset_mapper.hpp>
 
+#include <cstdlib>
+#include <sstream>
+
 namespace mlpack {
 namespace util {
 
@@ -108,6 +111,47 @@ void Params::SetPassed(const std::string& name)
   parameters[name].wasPassed = true;
 }
 
+/**
+ * Get or set the zero-copy enforcement mode.  The initial value is taken
+ * from the MLPACK_REQUIRE_ZERO_COPY environment variable.
+ */
+Params::ZeroCopyMode& Params::ZeroCopyEnforcement()
+{
+  static ZeroCopyMode mode = []()
+  {
+    const char* env = getenv("MLPACK_REQUIRE_ZERO_COPY");
+    if (env == NULL)
+      return ZERO_COPY_OFF;
+    const std::string value(env);
+    if (value == "fail")
+      return ZERO_COPY_FAIL;
+    else if (value == "warn")
+      return ZERO_COPY_WARN;
+    return ZERO_COPY_OFF;
+  }();
+  return mode;
+}
+
+/**
+ * Called by the binding glue whenever a matrix conversion has to copy.
+ */
+void Params::ReportConversionCopy(const std::string& description,
+                                  const size_t bytes)
+{
+  if (ZeroCopyEnforcement() == ZERO_COPY_OFF)
+    return;
+
+  std::ostringstream oss;
+  oss << "zero-copy handoff violated: " << description << " (" << bytes
+      << " bytes copied); pass the data in the expected layout to avoid the "
+      << "copy";
+
+  if (ZeroCopyEnforcement() == ZERO_COPY_FAIL)
+    throw std::runtime_error(oss.str());
+
+  Log::Warn << oss.str() << "." << std::endl;
+}
+
 /**
  * Check all input matrices for NaN and inf values, and throw an exception if
  * any are found.
@@ -116,6 +116,39 @@ class Params
    */
   void CheckInputMatrices();
 
+  /**
+   * How strictly the binding layer enforces zero-copy matrix handoffs.  The
+   * language glue (e.g. the numpy conversions of the Python bindings)
+   * silently copies when a passed matrix has the wrong memory order or does
+   * not own its memory; on large data those hidden copies dominate the call.
+   */
+  enum ZeroCopyMode
+  {
+    //! Hidden conversion copies are allowed silently (the default).
+    ZERO_COPY_OFF,
+    //! Hidden conversion copies print a warning with the size and reason.
+    ZERO_COPY_WARN,
+    //! Hidden conversion copies throw std::runtime_error.
+    ZERO_COPY_FAIL
+  };
+
+  /**
+   * Get or set the zero-copy enforcement mode.  The initial value is taken
+   * from the MLPACK_REQUIRE_ZERO_COPY environment variable ("warn" or
+   * "fail"), so strict mode can be enabled without any API changes.
+   */
+  static ZeroCopyMode& ZeroCopyEnforcement();
+
+  /**
+   * Called by the binding glue whenever a matrix conversion has to copy.
+   * Depending on ZeroCopyEnforcement() this does nothing, warns, or throws.
+   *
+   * @param description What was copied and why.
+   * @param bytes Size of the copy.
+   */
+  static void ReportConversionCopy(const std::string& description,
+                                   const size_t bytes);
+
  private:
   //! Convenience map from alias values to names.
   std::map<char, std::string> aliases;
@@ -0,0 +1,224 @@
+/**
+ * @file core/util/profiler.cpp
+ *
+ * Implementation of the hierarchical self-profiler.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "profiler.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+namespace mlpack {
+namespace util {
+
+namespace {
+
+//! A scope tree merged across threads, keyed by scope name per level.
+struct MergedNode
+{
+  uint64_t totalNanoseconds;
+  uint64_t calls;
+  std::map<std::string, MergedNode> children;
+
+  MergedNode() : totalNanoseconds(0), calls(0) { }
+};
+
+//! The call tree of one thread.
+struct ThreadState
+{
+  Profiler::Node root;
+  Profiler::Node* current;
+
+  ThreadState();
+  ~ThreadState();
+};
+
+//! The registry of the trees of all live threads, plus the merged trees of
+//! threads that have already exited.
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<ThreadState*> states;
+  MergedNode retired;
+};
+
+Registry& GetRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+void FreeChildren(Profiler::Node& node)
+{
+  for (size_t i = 0; i < node.children.size(); ++i)
+  {
+    FreeChildren(*node.children[i]);
+    delete node.children[i];
+  }
+  node.children.clear();
+}
+
+void MergeTree(const Profiler::Node& node, MergedNode& merged)
+{
+  merged.totalNanoseconds += node.totalNanoseconds;
+  merged.calls += node.calls;
+  for (size_t i = 0; i < node.children.size(); ++i)
+  {
+    MergeTree(*node.children[i],
+        merged.children[node.children[i]->name]);
+  }
+}
+
+void MergeMerged(const MergedNode& from, MergedNode& into)
+{
+  into.totalNanoseconds += from.totalNanoseconds;
+  into.calls += from.calls;
+  for (std::map<std::string, MergedNode>::const_iterator it =
+      from.children.begin(); it != from.children.end(); ++it)
+    MergeMerged(it->second, into.children[it->first]);
+}
+
+void PrintNode(std::ostringstream& oss,
+               const std::string& name,
+               const MergedNode& node,
+               const uint64_t parentNanoseconds,
+               const size_t depth)
+{
+  oss << std::string(2 * (depth + 1), ' ') << name << ": "
+      << std::fixed << std::setprecision(3)
+      << (double) node.totalNanoseconds / 1e6 << "ms ("
+      << node.calls << (node.calls == 1 ? " call" : " calls");
+  if (parentNanoseconds > 0)
+  {
+    oss << ", " << std::setprecision(1)
+        << 100.0 * (double) node.totalNanoseconds /
+        (double) parentNanoseconds << "% of parent";
+  }
+  oss << ")" << std::endl;
+
+  for (std::map<std::string, MergedNode>::const_iterator it =
+      node.children.begin(); it != node.children.end(); ++it)
+    PrintNode(oss, it->first, it->second, node.totalNanoseconds, depth + 1);
+}
+
+ThreadState::ThreadState()
+{
+  root.name = "";
+  root.totalNanoseconds = 0;
+  root.calls = 0;
+  root.parent = NULL;
+  current = &root;
+
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.states.push_back(this);
+}
+
+ThreadState::~ThreadState()
+{
+  // Fold this thread's measurements into the retired aggregate, so the
+  // report still covers threads that have finished.
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (size_t i = 0; i < root.children.size(); ++i)
+    MergeTree(*root.children[i], registry.retired.children[
+        root.children[i]->name]);
+  FreeChildren(root);
+  for (size_t i = 0; i < registry.states.size(); ++i)
+  {
+    if (registry.states[i] == this)
+    {
+      registry.states.erase(registry.states.begin() + i);
+      break;
+    }
+  }
+}
+
+ThreadState& GetThreadState()
+{
+  static thread_local ThreadState state;
+  return state;
+}
+
+} // namespace
+
+Profiler::Node* Profiler::EnterScope(const char* name)
+{
+  ThreadState& state = GetThreadState();
+  Node* current = state.current;
+
+  // Scopes have few distinct children, so a linear scan beats a map here.
+  for (size_t i = 0; i < current->children.size(); ++i)
+  {
+    if (current->children[i]->name == name)
+    {
+      state.current = current->children[i];
+      return state.current;
+    }
+  }
+
+  Node* child = new Node();
+  child->name = name;
+  child->totalNanoseconds = 0;
+  child->calls = 0;
+  child->parent = current;
+  current->children.push_back(child);
+  state.current = child;
+  return child;
+}
+
+void Profiler::ExitScope(Node* node, const uint64_t elapsedNanoseconds)
+{
+  node->totalNanoseconds += elapsedNanoseconds;
+  ++node->calls;
+  GetThreadState().current = node->parent;
+}
+
+std::string Profiler::Report()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  MergedNode merged;
+  MergeMerged(registry.retired, merged);
+  for (size_t i = 0; i < registry.states.size(); ++i)
+  {
+    for (size_t j = 0; j < registry.states[i]->root.children.size(); ++j)
+    {
+      MergeTree(*registry.states[i]->root.children[j],
+          merged.children[registry.states[i]->root.children[j]->name]);
+    }
+  }
+
+  std::ostringstream oss;
+  if (merged.children.empty())
+    return oss.str();
+
+  oss << "Profiling report:" << std::endl;
+  for (std::map<std::string, MergedNode>::const_iterator it =
+      merged.children.begin(); it != merged.children.end(); ++it)
+    PrintNode(oss, it->first, it->second, 0, 0);
+
+  return oss.str();
+}
+
+void Profiler::Clear()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  registry.retired = MergedNode();
+  for (size_t i = 0; i < registry.states.size(); ++i)
+  {
+    FreeChildren(registry.states[i]->root);
+    registry.states[i]->current = &registry.states[i]->root;
+  }
+}
+
+} // namespace util
+} // namespace mlpack
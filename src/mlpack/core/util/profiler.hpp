@@ -0,0 +1,154 @@
+/**
+ * @file core/util/profiler.hpp
+ *
+ * A hierarchical, low-overhead self-profiler.  Unlike the flat Timers map,
+ * scopes nest: every thread keeps its own call tree, so entering and leaving
+ * a scope touches only thread-local state (no mutex, no map lookup on the
+ * hot path), and the report shows how the time of a parent scope splits
+ * among its children.
+ *
+ * Instrument code with the MLPACK_PROFILE_SCOPE macro:
+ *
+ * @code
+ * void SplitNode(...)
+ * {
+ *   MLPACK_PROFILE_SCOPE("tree_building");
+ *   ...
+ *   {
+ *     MLPACK_PROFILE_SCOPE("mean_split");  // Attributed to tree_building.
+ *     ...
+ *   }
+ * }
+ * @endcode
+ *
+ * The macro expands to nothing unless MLPACK_ENABLE_PROFILING is defined, so
+ * instrumentation can be left in hot loops at zero cost in regular builds.
+ * The CLI bindings print the merged report at program end when --verbose is
+ * given (in profiling builds).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROFILER_HPP
+#define MLPACK_CORE_UTIL_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The profiler backend: per-thread call trees plus a merged report.  Use the
+ * MLPACK_PROFILE_SCOPE macro (or the ScopedProfile class directly) rather
+ * than calling EnterScope()/ExitScope() by hand.
+ */
+class Profiler
+{
+ public:
+  /**
+   * One scope in a thread's call tree.  A node is identified by its name and
+   * its position in the tree, so the same scope name under different parents
+   * is reported separately.
+   */
+  struct Node
+  {
+    //! The name of the scope.
+    std::string name;
+    //! Total time spent in the scope (including children), in nanoseconds.
+    uint64_t totalNanoseconds;
+    //! How many times the scope was entered.
+    uint64_t calls;
+    //! The enclosing scope (NULL for a thread's root).
+    Node* parent;
+    //! The scopes entered from this one.
+    std::vector<Node*> children;
+  };
+
+  /**
+   * Enter a scope with the given name: find or create the corresponding
+   * child of the calling thread's current node and make it current.  Only
+   * thread-local state is touched (a mutex is taken once per thread, when
+   * the thread's tree is first created).
+   *
+   * @param name Name of the scope (should be a string literal).
+   * @return The node for the entered scope.
+   */
+  static Node* EnterScope(const char* name);
+
+  /**
+   * Leave a scope previously entered with EnterScope(), adding the given
+   * elapsed time to it.
+   *
+   * @param node The node returned by the matching EnterScope() call.
+   * @param elapsedNanoseconds Time spent in the scope.
+   */
+  static void ExitScope(Node* node, const uint64_t elapsedNanoseconds);
+
+  /**
+   * Merge the call trees of all threads (including threads that have already
+   * exited) and render them as an indented report, with each scope's total
+   * time, call count, and share of its parent's time.  Don't call this while
+   * scopes are being timed on other threads.
+   */
+  static std::string Report();
+
+  /**
+   * Discard all recorded measurements.  Don't call this while scopes are
+   * being timed.
+   */
+  static void Clear();
+};
+
+/**
+ * A scoped timer for the profiler: enters a scope on construction and leaves
+ * it on destruction.  Use through MLPACK_PROFILE_SCOPE.
+ */
+class ScopedProfile
+{
+ public:
+  //! Enter the scope with the given name (should be a string literal).
+  explicit ScopedProfile(const char* name) :
+      node(Profiler::EnterScope(name)),
+      start(std::chrono::steady_clock::now())
+  { /* Nothing left to do. */ }
+
+  //! Leave the scope.
+  ~ScopedProfile()
+  {
+    const uint64_t elapsed = (uint64_t)
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    Profiler::ExitScope(node, elapsed);
+  }
+
+ private:
+  //! The node of the entered scope.
+  Profiler::Node* node;
+
+  //! When the scope was entered.
+  std::chrono::steady_clock::time_point start;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#if defined(MLPACK_ENABLE_PROFILING)
+  #define MLPACK_PROFILE_CONCAT_IMPL(a, b) a##b
+  #define MLPACK_PROFILE_CONCAT(a, b) MLPACK_PROFILE_CONCAT_IMPL(a, b)
+  //! Time the enclosing scope under the given name (profiling builds only).
+  #define MLPACK_PROFILE_SCOPE(name) \
+      mlpack::util::ScopedProfile \
+      MLPACK_PROFILE_CONCAT(mlpackProfileScope, __LINE__)(name)
+#else
+  //! Expands to nothing; define MLPACK_ENABLE_PROFILING to enable.
+  #define MLPACK_PROFILE_SCOPE(name)
+#endif
+
+#endif // MLPACK_CORE_UTIL_PROFILER_HPP
@@ -0,0 +1,182 @@
+/**
+ * @file core/util/shared_memory.cpp
+ *
+ * Implementation of the POSIX shared-memory segment functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "shared_memory.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__) || defined(__APPLE__)
+  #define MLPACK_HAS_POSIX_SHM
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace util {
+
+namespace {
+
+//! The magic bytes identifying an mlpack segment.
+const char shmMagic[8] = { 'M', 'L', 'P', 'K', 'S', 'H', 'M', '\0' };
+
+//! The current layout version.
+const uint32_t shmVersion = 1;
+
+//! shm_open() requires the name to start with a slash.
+std::string NormalizeName(const std::string& name)
+{
+  if (!name.empty() && name[0] == '/')
+    return name;
+  return "/" + name;
+}
+
+} // namespace
+
+void WriteSharedMemory(const std::string& name, const std::string& payload)
+{
+#ifdef MLPACK_HAS_POSIX_SHM
+  const std::string shmName = NormalizeName(name);
+  const size_t totalSize = sizeof(SharedMemoryHeader) + payload.size();
+
+  // Replace any stale segment of the same name, so the size is exact.
+  shm_unlink(shmName.c_str());
+  const int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR,
+      S_IRUSR | S_IWUSR);
+  if (fd < 0)
+  {
+    throw std::runtime_error("WriteSharedMemory(): cannot create segment '" +
+        shmName + "'!");
+  }
+
+  if (ftruncate(fd, (off_t) totalSize) != 0)
+  {
+    close(fd);
+    shm_unlink(shmName.c_str());
+    throw std::runtime_error("WriteSharedMemory(): cannot size segment '" +
+        shmName + "' to " + std::to_string(totalSize) + " bytes!");
+  }
+
+  void* mapping = mmap(NULL, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+      fd, 0);
+  close(fd); // The mapping keeps the segment open.
+  if (mapping == MAP_FAILED)
+  {
+    shm_unlink(shmName.c_str());
+    throw std::runtime_error("WriteSharedMemory(): cannot map segment '" +
+        shmName + "'!");
+  }
+
+  SharedMemoryHeader header;
+  std::memcpy(header.magic, shmMagic, sizeof(shmMagic));
+  header.version = shmVersion;
+  header.reserved = 0;
+  header.payloadBytes = (uint64_t) payload.size();
+
+  std::memcpy(mapping, &header, sizeof(SharedMemoryHeader));
+  std::memcpy((char*) mapping + sizeof(SharedMemoryHeader), payload.data(),
+      payload.size());
+  munmap(mapping, totalSize);
+#else
+  (void) payload;
+  throw std::runtime_error("WriteSharedMemory(): POSIX shared memory is not "
+      "available on this platform (segment '" + name + "')!");
+#endif
+}
+
+bool RemoveSharedMemory(const std::string& name)
+{
+#ifdef MLPACK_HAS_POSIX_SHM
+  return (shm_unlink(NormalizeName(name).c_str()) == 0);
+#else
+  (void) name;
+  return false;
+#endif
+}
+
+SharedMemoryView::SharedMemoryView(const std::string& name) :
+    mapping(NULL),
+    mappingSize(0),
+    payload(NULL),
+    payloadSize(0)
+{
+#ifdef MLPACK_HAS_POSIX_SHM
+  const std::string shmName = NormalizeName(name);
+  const int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+  {
+    throw std::runtime_error("SharedMemoryView(): segment '" + shmName +
+        "' does not exist!");
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      (size_t) info.st_size < sizeof(SharedMemoryHeader))
+  {
+    close(fd);
+    throw std::runtime_error("SharedMemoryView(): segment '" + shmName +
+        "' is too small to hold an mlpack header!");
+  }
+  mappingSize = (size_t) info.st_size;
+
+  mapping = mmap(NULL, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    mapping = NULL;
+    throw std::runtime_error("SharedMemoryView(): cannot map segment '" +
+        shmName + "'!");
+  }
+
+  SharedMemoryHeader header;
+  std::memcpy(&header, mapping, sizeof(SharedMemoryHeader));
+  if (std::memcmp(header.magic, shmMagic, sizeof(shmMagic)) != 0)
+  {
+    munmap(mapping, mappingSize);
+    mapping = NULL;
+    throw std::runtime_error("SharedMemoryView(): segment '" + shmName +
+        "' is not an mlpack shared-memory segment!");
+  }
+  if (header.version != shmVersion)
+  {
+    munmap(mapping, mappingSize);
+    mapping = NULL;
+    throw std::runtime_error("SharedMemoryView(): segment '" + shmName +
+        "' has unknown layout version " + std::to_string(header.version) +
+        "!");
+  }
+  if (sizeof(SharedMemoryHeader) + header.payloadBytes > mappingSize)
+  {
+    munmap(mapping, mappingSize);
+    mapping = NULL;
+    throw std::runtime_error("SharedMemoryView(): segment '" + shmName +
+        "' is truncated!");
+  }
+
+  payload = (const char*) mapping + sizeof(SharedMemoryHeader);
+  payloadSize = (size_t) header.payloadBytes;
+#else
+  throw std::runtime_error("SharedMemoryView(): POSIX shared memory is not "
+      "available on this platform (segment '" + name + "')!");
+#endif
+}
+
+SharedMemoryView::~SharedMemoryView()
+{
+#ifdef MLPACK_HAS_POSIX_SHM
+  if (mapping != NULL)
+    munmap(mapping, mappingSize);
+#endif
+}
+
+} // namespace util
+} // namespace mlpack
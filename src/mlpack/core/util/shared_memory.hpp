@@ -0,0 +1,184 @@
+/**
+ * @file core/util/shared_memory.hpp
+ *
+ * In-memory model handoff between processes through POSIX shared memory.
+ * Moving a model from a training process (say, the Python bindings) into a
+ * C++ service normally means a save-to-disk/load round trip; instead, the
+ * producer writes the serialized model into a named shared-memory segment
+ * and the consumer maps the segment and deserializes straight out of the
+ * mapping, with no file and no intermediate copy of the payload.
+ *
+ * Each segment starts with a fixed, versioned header (SharedMemoryHeader)
+ * so that a consumer built from a different mlpack version can recognize
+ * the layout or refuse it cleanly; the serialized payload follows the
+ * header immediately.
+ *
+ * The facility is implemented for POSIX platforms (shm_open/mmap); on other
+ * platforms every function throws std::runtime_error.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_SHARED_MEMORY_HPP
+#define MLPACK_CORE_UTIL_SHARED_MEMORY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <streambuf>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The fixed header at the start of every mlpack shared-memory segment.  The
+ * layout is a stable ABI: fields are fixed-width, in this order, with no
+ * padding surprises (the struct is 24 bytes on every platform), and new
+ * fields may only ever be added by incrementing the version.
+ */
+struct SharedMemoryHeader
+{
+  //! Identifies an mlpack segment: "MLPKSHM" and a terminating zero.
+  char magic[8];
+  //! Layout version of the header and payload framing; currently 1.
+  uint32_t version;
+  //! Reserved; written as zero.
+  uint32_t reserved;
+  //! Number of payload bytes following the header.
+  uint64_t payloadBytes;
+};
+
+/**
+ * Create (or replace) the named shared-memory segment and fill it with the
+ * given payload, preceded by the standard header.  The segment persists
+ * after the writing process exits, until RemoveSharedMemory() is called.
+ *
+ * @param name Name of the segment (a leading '/' is added if missing).
+ * @param payload Bytes to store.
+ * @throws std::runtime_error if the segment cannot be created or the
+ *     platform has no POSIX shared memory.
+ */
+void WriteSharedMemory(const std::string& name, const std::string& payload);
+
+/**
+ * Remove the named shared-memory segment.  Existing mappings stay valid
+ * until they are closed.
+ *
+ * @param name Name of the segment.
+ * @return true if the segment existed and was removed.
+ */
+bool RemoveSharedMemory(const std::string& name);
+
+/**
+ * A read-only, zero-copy view of a shared-memory segment written by
+ * WriteSharedMemory().  The constructor maps the segment and validates the
+ * header; Data() and Size() expose the payload in place, and the mapping is
+ * released on destruction.
+ */
+class SharedMemoryView
+{
+ public:
+  /**
+   * Map the named segment and validate its header.
+   *
+   * @param name Name of the segment.
+   * @throws std::runtime_error if the segment does not exist, is not an
+   *     mlpack segment, or has an unknown layout version.
+   */
+  SharedMemoryView(const std::string& name);
+
+  //! Unmap the segment.
+  ~SharedMemoryView();
+
+  //! The view cannot be copied (the mapping is owned).
+  SharedMemoryView(const SharedMemoryView&) = delete;
+  //! The view cannot be assigned.
+  SharedMemoryView& operator=(const SharedMemoryView&) = delete;
+
+  //! Get the payload bytes, valid for the lifetime of the view.
+  const char* Data() const { return payload; }
+  //! Get the number of payload bytes.
+  size_t Size() const { return payloadSize; }
+
+ private:
+  //! Base address of the whole mapping (header included).
+  void* mapping;
+  //! Size of the whole mapping in bytes.
+  size_t mappingSize;
+  //! The payload, just past the header.
+  const char* payload;
+  //! Number of payload bytes.
+  size_t payloadSize;
+};
+
+/**
+ * A read-only streambuf over a buffer that is owned elsewhere, so cereal
+ * archives can deserialize straight out of a SharedMemoryView without
+ * copying the payload into a string first.
+ */
+class ViewStreamBuf : public std::streambuf
+{
+ public:
+  ViewStreamBuf(const char* data, const size_t size)
+  {
+    // The streambuf interface takes non-const pointers, but a read-only
+    // buffer is never written through them.
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+/**
+ * Adopt a serializable object from the named shared-memory segment: the
+ * segment is mapped and the cereal binary archive is read in place, so the
+ * payload is never copied.
+ *
+ * @param t Object to deserialize into.
+ * @param segmentName Name of the segment.
+ * @param name Name of the structure inside the archive (the same name that
+ *     was used when serializing).
+ * @throws std::runtime_error if the segment is missing or malformed.
+ */
+template<typename T>
+void AdoptFromSharedMemory(T& t,
+                           const std::string& segmentName,
+                           const std::string& name)
+{
+  SharedMemoryView view(segmentName);
+  ViewStreamBuf buffer(view.Data(), view.Size());
+  std::istream stream(&buffer);
+  cereal::BinaryInputArchive ar(stream);
+  ar(cereal::make_nvp(name.c_str(), t));
+}
+
+/**
+ * Serialize an object into the named shared-memory segment as a cereal
+ * binary archive, ready to be adopted by another process with
+ * AdoptFromSharedMemory().
+ *
+ * @param t Object to serialize.
+ * @param segmentName Name of the segment.
+ * @param name Name of the structure inside the archive.
+ * @throws std::runtime_error if the segment cannot be created.
+ */
+template<typename T>
+void OfferToSharedMemory(const T& t,
+                         const std::string& segmentName,
+                         const std::string& name)
+{
+  std::ostringstream oss;
+  {
+    cereal::BinaryOutputArchive ar(oss);
+    ar(cereal::make_nvp(name.c_str(), const_cast<T&>(t)));
+  }
+  WriteSharedMemory(segmentName, oss.str());
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_SHARED_MEMORY_HPP
@@ -0,0 +1,55 @@
+/**
+ * @file core/util/simd_support.cpp
+ *
+ * Implementation of the runtime SIMD capability probe.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "simd_support.hpp"
+
+namespace mlpack {
+namespace util {
+
+namespace {
+
+SimdLevel ProbeSimdLevel()
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  // __builtin_cpu_supports() reads CPUID once at program startup, so these
+  // checks are just flag tests.
+  if (__builtin_cpu_supports("avx512f"))
+    return SIMD_AVX512;
+  if (__builtin_cpu_supports("avx2"))
+    return SIMD_AVX2;
+  if (__builtin_cpu_supports("avx"))
+    return SIMD_AVX;
+#endif
+  return SIMD_BASELINE;
+}
+
+} // namespace
+
+SimdLevel HighestSimdLevel()
+{
+  // C++11 guarantees thread-safe initialization of function-local statics,
+  // so the probe runs exactly once.
+  static const SimdLevel level = ProbeSimdLevel();
+  return level;
+}
+
+std::string SimdLevelName(const SimdLevel level)
+{
+  switch (level)
+  {
+    case SIMD_AVX:    return "AVX";
+    case SIMD_AVX2:   return "AVX2";
+    case SIMD_AVX512: return "AVX-512";
+    default:          return "baseline";
+  }
+}
+
+} // namespace util
+} // namespace mlpack
@@ -0,0 +1,75 @@
+/**
+ * @file core/util/simd_support.hpp
+ *
+ * Runtime SIMD capability detection and single-binary function
+ * multiversioning support.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_SIMD_SUPPORT_HPP
+#define MLPACK_CORE_UTIL_SIMD_SUPPORT_HPP
+
+#include <string>
+
+/**
+ * MLPACK_TARGET_CLONES marks an out-of-line, non-template function for
+ * compiler-generated function multiversioning: the compiler emits one body
+ * per listed instruction set and the dynamic loader resolves the widest one
+ * the CPU supports the first time the function is called.  This lets a
+ * single shipped binary, built for baseline x86-64, still use AVX2 or
+ * AVX-512 loops on machines that have them.
+ *
+ * Only GCC >= 6 and Clang >= 14 on x86-64 ELF targets support the
+ * target_clones attribute; everywhere else the macro expands to nothing and
+ * the baseline body is used.  Note that the attribute cannot be applied to
+ * templates, so mlpack's header-only template kernels (LMetric, the kernel
+ * classes, log_add) are vectorized for whatever the including translation
+ * unit is compiled with; use this macro when hoisting a hot loop into a
+ * compiled translation unit.
+ */
+#if defined(__ELF__) && defined(__x86_64__) && \
+    ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6) || \
+     (defined(__clang__) && __clang_major__ >= 14))
+  #define MLPACK_TARGET_CLONES \
+      __attribute__((target_clones("default", "avx2", "avx512f")))
+#else
+  #define MLPACK_TARGET_CLONES
+#endif
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The SIMD instruction set families that the dispatch framework
+ * distinguishes, in increasing order of width, so levels can be compared
+ * with the usual relational operators.
+ */
+enum SimdLevel
+{
+  SIMD_BASELINE = 0, //!< Whatever the binary was compiled for.
+  SIMD_AVX      = 1, //!< 256-bit AVX.
+  SIMD_AVX2     = 2, //!< AVX2 (including FMA-capable machines).
+  SIMD_AVX512   = 3  //!< AVX-512 Foundation.
+};
+
+/**
+ * Probe the CPU for the widest SIMD instruction set it supports.  The probe
+ * runs once and the result is cached, so this is cheap enough to call from
+ * dispatch points.  On non-x86 targets or compilers without a CPU probe this
+ * returns SIMD_BASELINE.
+ */
+SimdLevel HighestSimdLevel();
+
+/**
+ * Return a human-readable name for the given SIMD level (for use by
+ * --version and diagnostic output).
+ */
+std::string SimdLevelName(const SimdLevel level);
+
+} // namespace util
+} // namespace mlpack
+
+#endif
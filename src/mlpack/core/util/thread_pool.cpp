@@ -0,0 +1,230 @@
+/**
+ * @file core/util/thread_pool.cpp
+ *
+ * Implementation of the process-wide thread pool and task groups.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "thread_pool.hpp"
+#include "numa.hpp"
+
+#include <mlpack/core/math/random.hpp>
+
+#include <cstdlib>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace util {
+
+namespace {
+
+//! Set for the lifetime of each worker thread; tasks submitted from a thread
+//! where this is set run inline instead of being queued.
+thread_local bool insideWorker = false;
+
+} // namespace
+
+ThreadPool& ThreadPool::Get()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::ThreadPool() : shutdown(false)
+{
+  const size_t numThreads = DefaultNumThreads();
+  workers.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i)
+    workers.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    shutdown = true;
+  }
+  taskSignal.notify_all();
+  for (size_t i = 0; i < workers.size(); ++i)
+    workers[i].join();
+}
+
+size_t ThreadPool::DefaultNumThreads()
+{
+#ifdef HAS_OPENMP
+  // Follow the OpenMP configuration (OMP_NUM_THREADS, omp_set_num_threads()),
+  // so OpenMP regions and pool tasks share one per-core thread budget.
+  return (size_t) omp_get_max_threads();
+#else
+  const char* env = std::getenv("OMP_NUM_THREADS");
+  if (env != NULL)
+  {
+    const int requested = std::atoi(env);
+    if (requested > 0)
+      return (size_t) requested;
+  }
+
+  const size_t numCores = (size_t) std::thread::hardware_concurrency();
+  return (numCores == 0) ? 1 : numCores;
+#endif
+}
+
+void ThreadPool::Resize(const size_t numThreads)
+{
+  // Stop the current workers; they drain the queue before exiting.
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    shutdown = true;
+  }
+  taskSignal.notify_all();
+  for (size_t i = 0; i < workers.size(); ++i)
+    workers[i].join();
+  workers.clear();
+
+  shutdown = false;
+  workers.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i)
+    workers.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+}
+
+bool ThreadPool::InWorker()
+{
+  return insideWorker;
+}
+
+bool ThreadPool::PinWorkersToNumaNodes()
+{
+  if (NumNumaNodes() <= 1 || workers.empty())
+    return false;
+
+  bool allPinned = true;
+  for (size_t i = 0; i < workers.size(); ++i)
+  {
+    const size_t node = NumaNodeOfThread(i, workers.size());
+    if (!PinThreadToNumaNode(workers[i].native_handle(), node))
+      allPinned = false;
+  }
+  return allPinned;
+}
+
+void ThreadPool::Enqueue(TaskGroup* group, std::function<void()> function)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    Task task;
+    task.group = group;
+    task.function = std::move(function);
+    tasks.push_back(std::move(task));
+  }
+  taskSignal.notify_one();
+}
+
+bool ThreadPool::TryRunOneTask()
+{
+  Task task;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tasks.empty())
+      return false;
+    task = std::move(tasks.front());
+    tasks.pop_front();
+  }
+
+  RunTask(task);
+  return true;
+}
+
+void ThreadPool::RunTask(Task& task)
+{
+  std::exception_ptr taskException;
+  try
+  {
+    task.function();
+  }
+  catch (...)
+  {
+    taskException = std::current_exception();
+  }
+  task.group->Finished(taskException);
+}
+
+void ThreadPool::WorkerLoop(const size_t workerIndex)
+{
+  insideWorker = true;
+
+  // Register this worker's random stream.  Stream 0 is the global generator
+  // (reserved for the main thread), so workers use their index plus one;
+  // math::RandGen() then hands every worker its own deterministically seeded
+  // generator, the same way it does for OpenMP team threads.
+  math::RandStreamId() = workerIndex + 1;
+
+  while (true)
+  {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (!shutdown && tasks.empty())
+        taskSignal.wait(lock);
+      if (tasks.empty())
+        return; // Shutting down and nothing left to drain.
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+
+    RunTask(task);
+  }
+}
+
+void TaskGroup::Wait()
+{
+  WaitInternal();
+
+  std::exception_ptr toRethrow;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    toRethrow = exception;
+    exception = std::exception_ptr();
+  }
+  if (toRethrow)
+    std::rethrow_exception(toRethrow);
+}
+
+void TaskGroup::WaitInternal()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (outstanding == 0)
+        return;
+    }
+
+    // Help drain the queue instead of blocking; the task we pick up may
+    // belong to any group.
+    if (pool.TryRunOneTask())
+      continue;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (outstanding > 0)
+      doneSignal.wait(lock);
+  }
+}
+
+void TaskGroup::Finished(std::exception_ptr taskException)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  --outstanding;
+  if (taskException && !exception)
+    exception = taskException;
+  if (outstanding == 0)
+    doneSignal.notify_all();
+}
+
+} // namespace util
+} // namespace mlpack
@@ -0,0 +1,277 @@
+/**
+ * @file core/util/thread_pool.hpp
+ *
+ * A process-wide thread pool with task groups, shared by all mlpack
+ * algorithms that spawn their own tasks.  Each algorithm opening its own
+ * parallel region works fine in isolation, but when parallel features are
+ * composed---say, parallel cross-validation over parallel forest
+ * training---every level multiplies the thread count and the machine ends up
+ * oversubscribed.  The pool keeps a single set of workers, one per core, and
+ * throttles nesting: a task submitted from inside a pool worker runs inline
+ * on that worker instead of being queued, so composed parallel sections
+ * still use exactly one thread per core.
+ *
+ * The pool sizes itself from the OpenMP configuration (OMP_NUM_THREADS /
+ * omp_get_max_threads()) when mlpack is built with OpenMP, so code that
+ * still uses '#pragma omp' regions and code that submits to the pool share
+ * one thread budget and can be migrated independently.
+ *
+ * Typical use:
+ *
+ * @code
+ * util::TaskGroup group;
+ * for (size_t i = 0; i < numShards; ++i)
+ *   group.Run([&, i]() { ProcessShard(i); });
+ * group.Wait();
+ * @endcode
+ *
+ * or, for simple index loops, util::ParallelFor().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_THREAD_POOL_HPP
+#define MLPACK_CORE_UTIL_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+class TaskGroup;
+
+/**
+ * The process-wide worker pool.  Tasks are not submitted to the pool
+ * directly; create a TaskGroup and Run() tasks on it, so that there is
+ * something to Wait() on.
+ */
+class ThreadPool
+{
+ public:
+  /**
+   * Get the process-wide pool.  It is created on first use, with one worker
+   * per core (following the OpenMP thread settings when mlpack is built with
+   * OpenMP).
+   */
+  static ThreadPool& Get();
+
+  //! Get the number of worker threads.
+  size_t NumThreads() const { return workers.size(); }
+
+  /**
+   * Change the number of worker threads.  With zero workers every task runs
+   * inline in the submitting thread, which is useful for debugging.  Do not
+   * call this while tasks are pending; queued tasks are drained before the
+   * old workers exit.
+   *
+   * @param numThreads New number of worker threads.
+   */
+  void Resize(const size_t numThreads);
+
+  //! Report whether the calling thread is one of the pool's workers (and
+  //! thus whether a task submitted here would run inline).
+  static bool InWorker();
+
+  /**
+   * Pin the workers to the machine's NUMA nodes, one contiguous block of
+   * workers per node (the same thread-to-node map as
+   * util::NumaNodeOfThread()), so that workers read the column shards they
+   * first-touched (see util::ShardedFirstTouch()) from local memory.
+   *
+   * @return true if every worker was pinned; false on single-node machines,
+   *     on platforms without pinning support, or when the pool has no
+   *     workers.
+   */
+  bool PinWorkersToNumaNodes();
+
+ private:
+  //! Create the pool with the default number of workers.  (Use Get().)
+  ThreadPool();
+  //! Drain the queue and join the workers.
+  ~ThreadPool();
+
+  //! The pool cannot be copied.
+  ThreadPool(const ThreadPool&) = delete;
+  //! The pool cannot be assigned.
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  //! A queued task and the group that is waiting on it.
+  struct Task
+  {
+    //! The group the task belongs to.
+    TaskGroup* group;
+    //! The work itself.
+    std::function<void()> function;
+  };
+
+  //! Compute the default number of workers from the OpenMP settings (or the
+  //! hardware concurrency when mlpack is built without OpenMP).
+  static size_t DefaultNumThreads();
+
+  //! Queue a task for the given group.  (The group has already counted it.)
+  void Enqueue(TaskGroup* group, std::function<void()> function);
+
+  /**
+   * Run one queued task, if any, in the calling thread.  Waiting task groups
+   * use this to help drain the queue instead of blocking idle.
+   *
+   * @return true if a task was run.
+   */
+  bool TryRunOneTask();
+
+  //! Run the given task and report its completion to its group.
+  void RunTask(Task& task);
+
+  //! The main loop of each worker thread.  The worker index registers the
+  //! thread's random stream (math::RandStreamId()), so tasks that draw
+  //! random numbers get independent per-worker streams instead of all
+  //! racing on the global generator (pool workers are not OpenMP team
+  //! threads, so the OpenMP thread number cannot distinguish them).
+  void WorkerLoop(const size_t workerIndex);
+
+  //! Tasks waiting to be picked up by a worker.
+  std::deque<Task> tasks;
+  //! Guards the task queue and the shutdown flag.
+  std::mutex mutex;
+  //! Signalled when a task is queued or shutdown begins.
+  std::condition_variable taskSignal;
+  //! Set when the workers should exit (after draining the queue).
+  bool shutdown;
+  //! The worker threads.
+  std::vector<std::thread> workers;
+
+  //! TaskGroup submits and steals through the private interface.
+  friend class TaskGroup;
+};
+
+/**
+ * A group of tasks submitted to the pool that can be waited on together.
+ * Run() hands a task to the pool---or runs it inline when called from a pool
+ * worker or when the pool has no workers---and Wait() blocks until every
+ * task of the group has finished, helping to drain the queue in the
+ * meantime.  If a task threw, Wait() rethrows the first such exception in
+ * the waiting thread.
+ */
+class TaskGroup
+{
+ public:
+  //! Create a task group on the process-wide pool.
+  TaskGroup() : pool(ThreadPool::Get()), outstanding(0) { }
+
+  //! Create a task group on the given pool.
+  explicit TaskGroup(ThreadPool& pool) : pool(pool), outstanding(0) { }
+
+  //! Wait for any remaining tasks; exceptions they threw are discarded, so
+  //! call Wait() explicitly if you need to observe them.
+  ~TaskGroup() { WaitInternal(); }
+
+  /**
+   * Submit a task.  When called from a pool worker thread (i.e. from inside
+   * another task) the task runs inline immediately, so nested parallel
+   * sections do not oversubscribe the machine.
+   *
+   * @param function The task; it is invoked with no arguments.
+   */
+  template<typename FunctionType>
+  void Run(FunctionType function)
+  {
+    if (pool.NumThreads() == 0 || ThreadPool::InWorker())
+    {
+      function();
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++outstanding;
+    }
+    pool.Enqueue(this, std::function<void()>(std::move(function)));
+  }
+
+  /**
+   * Block until every task of this group has finished.  The waiting thread
+   * runs queued tasks while it waits instead of sitting idle.  If any task
+   * of the group threw, the first captured exception is rethrown here.
+   */
+  void Wait();
+
+ private:
+  //! Wait for the tasks without rethrowing a captured exception.
+  void WaitInternal();
+
+  //! Called by the pool when one task of this group has finished, possibly
+  //! with a captured exception.
+  void Finished(std::exception_ptr taskException);
+
+  //! The pool the tasks are submitted to.
+  ThreadPool& pool;
+  //! How many submitted tasks have not finished yet.
+  size_t outstanding;
+  //! The first exception thrown by a task, if any.
+  std::exception_ptr exception;
+  //! Guards the count and the exception.
+  std::mutex mutex;
+  //! Signalled when the last outstanding task finishes.
+  std::condition_variable doneSignal;
+
+  friend class ThreadPool;
+};
+
+/**
+ * Apply the given function to every index in [begin, end), in parallel on
+ * the process-wide pool.  The range is split into one contiguous chunk per
+ * worker; when called from inside a pool task (or when the pool has no
+ * workers) the whole loop runs serially in the calling thread.  This is the
+ * drop-in replacement for a '#pragma omp parallel for' loop.
+ *
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param function Called once per index, with the index as its argument.
+ */
+template<typename FunctionType>
+void ParallelFor(const size_t begin, const size_t end, FunctionType function)
+{
+  if (begin >= end)
+    return;
+
+  ThreadPool& pool = ThreadPool::Get();
+  const size_t range = end - begin;
+  const size_t numChunks = std::min(std::max<size_t>(pool.NumThreads(), 1),
+      range);
+  if (numChunks <= 1 || ThreadPool::InWorker())
+  {
+    for (size_t i = begin; i < end; ++i)
+      function(i);
+    return;
+  }
+
+  const size_t chunkSize = (range + numChunks - 1) / numChunks;
+  TaskGroup group(pool);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    const size_t chunkBegin = begin + c * chunkSize;
+    const size_t chunkEnd = std::min(chunkBegin + chunkSize, end);
+    group.Run([&function, chunkBegin, chunkEnd]()
+    {
+      for (size_t i = chunkBegin; i < chunkEnd; ++i)
+        function(i);
+    });
+  }
+  group.Wait();
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_THREAD_POOL_HPP
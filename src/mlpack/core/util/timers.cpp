@@ -14,6 +14,7 @@
 #include "timers.hpp"
 #include "io.hpp"
 #include "log.hpp"
+#include "memory_tracker.hpp"
 
 #include <map>
 #include <string>
@@ -198,6 +199,10 @@ void Timers::Start(const string& timerName,
   }
 
   timerStartTime[threadId][timerName] = currTime;
+
+  // If memory tracking is active, also track this scope's allocation
+  // high-water mark.
+  MemoryTracker::TimerScopeStart(timerName);
 }
 
 void Timers::Stop(const string& timerName,
@@ -228,4 +233,8 @@ void Timers::Stop(const string& timerName,
   timerStartTime[threadId].erase(timerName);
   if (timerStartTime[threadId].empty())
     timerStartTime.erase(threadId);
+
+  // If memory tracking is active, record this scope's allocation high-water
+  // mark.
+  MemoryTracker::TimerScopeStop(timerName);
 }
@@ -0,0 +1,106 @@
+/**
+ * @file core/util/training_session.hpp
+ *
+ * A small helper that owns an ensmallen optimizer across repeated Train()
+ * calls on the same model, so that hyperparameter sweeps and warm retrains
+ * reuse one optimizer object instead of constructing a fresh one per call.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_TRAINING_SESSION_HPP
+#define MLPACK_CORE_UTIL_TRAINING_SESSION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * A TrainingSession binds a model to an instantiated optimizer and forwards
+ * Train() calls to the model, passing the session's optimizer every time.
+ * The optimizer is constructed once and lives as long as the session, so
+ * repeated retrains on the same architecture keep its configuration (and any
+ * state the optimizer retains between Optimize() calls) instead of
+ * re-creating it per call, and the model's own reusable training state (for
+ * example the layer workspaces of an FFN) is warm across calls because the
+ * same model object is used throughout.
+ *
+ * The model is held by reference and must outlive the session.  Any mlpack
+ * model whose Train() signature is
+ * Train(predictors, responses, optimizer, callbacks...) can be used, e.g.:
+ *
+ * @code
+ * FFN<> network = BuildNetwork();
+ * util::TrainingSession<FFN<>, ens::Adam> session(network);
+ * session.Optimizer().StepSize() = 0.01;
+ * for (size_t trial = 0; trial < 10; ++trial)
+ *   session.Train(predictors, responses);
+ * @endcode
+ *
+ * @tparam ModelType The model to be trained.
+ * @tparam OptimizerType The ensmallen optimizer to own.
+ */
+template<typename ModelType, typename OptimizerType>
+class TrainingSession
+{
+ public:
+  /**
+   * Create the session for the given model.  The optimizer is copied into
+   * the session; configure it afterwards through Optimizer() if needed.
+   *
+   * @param model The model to train; held by reference.
+   * @param optimizer The optimizer to use for all Train() calls.
+   */
+  TrainingSession(ModelType& model,
+                  OptimizerType optimizer = OptimizerType()) :
+      model(model),
+      optimizer(std::move(optimizer))
+  { /* Nothing to do. */ }
+
+  /**
+   * Train the session's model on the given data with the session's
+   * optimizer.
+   *
+   * @param predictors Input training variables.
+   * @param responses Outputs corresponding to the input variables.
+   * @param callbacks Callback functions for the ensmallen optimizer.
+   * @return The final objective of the trained model.
+   */
+  template<typename PredictorsType,
+           typename ResponsesType,
+           typename... CallbackTypes>
+  double Train(PredictorsType&& predictors,
+               ResponsesType&& responses,
+               CallbackTypes&&... callbacks)
+  {
+    return model.Train(std::forward<PredictorsType>(predictors),
+        std::forward<ResponsesType>(responses), optimizer,
+        std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  //! Get the model being trained.
+  const ModelType& Model() const { return model; }
+  //! Modify the model being trained.
+  ModelType& Model() { return model; }
+
+  //! Get the session's optimizer.
+  const OptimizerType& Optimizer() const { return optimizer; }
+  //! Modify the session's optimizer (e.g. to adjust hyperparameters between
+  //! Train() calls).
+  OptimizerType& Optimizer() { return optimizer; }
+
+ private:
+  //! The model being trained.
+  ModelType& model;
+
+  //! The optimizer reused by every Train() call.
+  OptimizerType optimizer;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -144,13 +144,15 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // Now from predictedLabels, build ht, the weak hypothesis
     // buildClassificationMatrix(ht, predictedLabels);
 
-    // Now, calculate alpha(t) using ht.
+    // Now, calculate alpha(t) using ht.  The column sums of D were already
+    // computed as the weak learner's weights, so reuse them instead of
+    // summing every column of D again.
     for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
     {
       if (predictedLabels(j) == labels(j))
-        rt += arma::accu(D.col(j));
+        rt += weights(j);
       else
-        rt -= arma::accu(D.col(j));
+        rt -= weights(j);
     }
 
     if ((i > 0) && (std::abs(rt - crt) < tolerance))
@@ -174,42 +176,23 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
+    // Now start modifying the weights.  The same scale factor applies to a
+    // whole column of D, so the update collapses into one elementwise product.
+    const double expo = exp(alphat);
+    arma::rowvec scales(D.n_cols);
     for (size_t j = 0; j < D.n_cols; ++j)
-    {
-      const double expo = exp(alphat);
-      if (predictedLabels(j) == labels(j))
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) /= expo;
-          zt += D(k, j); // * exp(-1 * alphat * yt(j,k) * ht(j,k));
-
-          // Add to the final hypothesis matrix.
-          // sumFinalH(k, j) += (alphat * ht(k, j));
-          if (k == labels(j))
-            sumFinalH(k, j) += (alphat); // * ht(k, j));
-          else
-            sumFinalH(k, j) -= (alphat);
-        }
-      }
-      else
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) *= expo;
-          zt += D(k, j);
-
-          // Add to the final hypothesis matrix.
-          if (k == labels(j))
-            sumFinalH(k, j) += alphat; // * ht(k, j));
-          else
-            sumFinalH(k, j) -= alphat;
-        }
-      }
-    }
+      scales(j) = (predictedLabels(j) == labels(j)) ? (1.0 / expo) : expo;
+    D.each_row() %= scales;
+
+    // We calculate zt, the normalization constant.
+    zt = arma::accu(D);
+
+    // Add to the final hypothesis matrix: alphat at the correct label of each
+    // point, and -alphat everywhere else.  (The update is the same whether or
+    // not the weak learner got the point right.)
+    sumFinalH -= alphat;
+    for (size_t j = 0; j < D.n_cols; ++j)
+      sumFinalH(labels(j), j) += 2.0 * alphat;
 
     // Normalize D.
     D /= zt;
@@ -243,26 +226,37 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
     arma::Row<size_t>& predictedLabels,
     arma::mat& probabilities)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
-
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
+  // Each thread accumulates the weighted votes of its share of the weak
+  // learners into a private matrix, then folds them into the shared totals.
+  #pragma omp parallel default(shared)
   {
-    wl[i].Classify(test, tempPredictedLabels);
+    arma::Row<size_t> tempPredictedLabels(test.n_cols);
+    arma::mat threadProbabilities(numClasses, test.n_cols, arma::fill::zeros);
 
-    for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
-      probabilities(tempPredictedLabels(j), j) += alpha[i];
-  }
+    #pragma omp for nowait
+    for (omp_size_t i = 0; i < (omp_size_t) wl.size(); ++i)
+    {
+      wl[i].Classify(test, tempPredictedLabels);
 
-  arma::colvec pRow;
-  arma::uword maxIndex = 0;
+      for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
+        threadProbabilities(tempPredictedLabels(j), j) += alpha[i];
+    }
+
+    #pragma omp critical(AdaBoostClassifyMerge)
+    probabilities += threadProbabilities;
+  }
 
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
+  // The columns are independent, so normalization and the argmax can also be
+  // done in parallel.
+  #pragma omp parallel for default(shared)
+  for (omp_size_t i = 0; i < (omp_size_t) predictedLabels.n_cols; ++i)
   {
     probabilities.col(i) /= arma::accu(probabilities.col(i));
-    pRow = probabilities.unsafe_col(i);
+    arma::colvec pRow = probabilities.unsafe_col(i);
+    arma::uword maxIndex = 0;
     pRow.max(maxIndex);
     predictedLabels(i) = maxIndex;
   }
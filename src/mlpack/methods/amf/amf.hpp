@@ -23,6 +23,7 @@
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/update_rules/svd_batch_learning.hpp>
+#include <mlpack/methods/amf/update_rules/svd_hogwild_learning.hpp>
 #include <mlpack/methods/amf/update_rules/svd_incomplete_incremental_learning.hpp>
 #include <mlpack/methods/amf/update_rules/svd_complete_incremental_learning.hpp>
 
@@ -157,6 +158,18 @@ using SVDBatchFactorizer = amf::AMF<
     amf::RandomAcolInitialization<>,
     amf::SVDBatchLearning>;
 
+/**
+ * SVDHogwildFactorizer factorizes given matrix V into two matrices W and H by
+ * lock-free parallel stochastic gradient descent over the nonzero entries.
+ *
+ * @see SVDHogwildLearning
+ */
+template<typename MatType = arma::sp_mat>
+using SVDHogwildFactorizer = amf::AMF<
+    amf::SimpleResidueTermination,
+    amf::RandomAcolInitialization<>,
+    amf::SVDHogwildLearning>;
+
 /**
  * SVDIncompleteIncrementalFactorizer factorizes given matrix V into two
  * matrices W and H by incomplete incremental gradient descent. SVD incomplete
@@ -0,0 +1,152 @@
+/**
+ * @file methods/amf/termination_policies/reconstruction_residue_termination.hpp
+ *
+ * Termination policy used in AMF (Alternating Matrix Factorization) that
+ * terminates on the actual reconstruction residual.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_RECONSTRUCTION_RESIDUE_TERMINATION_HPP
+#define MLPACK_METHODS_AMF_RECONSTRUCTION_RESIDUE_TERMINATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements a termination policy driven by the relative
+ * reconstruction residual \f$ ||V - WH||_F / ||V||_F \f$, rather than by the
+ * drift of the iterates (see SimpleResidueTermination).  Termination happens
+ * as soon as the residual drops below the given threshold, when the residual
+ * stops improving, or when the iteration limit is reached.
+ *
+ * Because the residual is evaluated against the input matrix itself, this
+ * policy is well suited to warm-started factorizations (see
+ * GivenInitialization): if the given factors already reconstruct the updated
+ * matrix within tolerance, the factorization terminates after a single
+ * iteration instead of running until the iterates stop moving.
+ *
+ * @see AMF, GivenInitialization
+ */
+template<typename MatType>
+class ReconstructionResidueTermination
+{
+ public:
+  /**
+   * Construct the ReconstructionResidueTermination object with the given
+   * residual threshold and maximum number of iterations.
+   *
+   * @param minResidue Relative reconstruction residual for termination.
+   * @param maxIterations Maximum number of iterations.
+   * @param minImprovement Minimum improvement of the residual between
+   *     subsequent iterations; if the residual improves less than this,
+   *     the factorization has stalled and is terminated.
+   */
+  ReconstructionResidueTermination(const double minResidue = 1e-5,
+                                   const size_t maxIterations = 10000,
+                                   const double minImprovement = 1e-8) :
+      minResidue(minResidue),
+      maxIterations(maxIterations),
+      minImprovement(minImprovement),
+      V(NULL),
+      residue(DBL_MAX),
+      lastResidue(DBL_MAX),
+      normV(0.0),
+      iteration(0)
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Initializes the termination policy before starting the factorization.
+   *
+   * @param V Input matrix being factorized.
+   */
+  void Initialize(const MatType& V)
+  {
+    this->V = &V;
+    residue = DBL_MAX;
+    lastResidue = DBL_MAX;
+    normV = arma::norm(V, "fro");
+    iteration = 0;
+  }
+
+  /**
+   * Check if termination criterion is met.
+   *
+   * @param W Basis matrix of output.
+   * @param H Encoding matrix of output.
+   */
+  bool IsConverged(arma::mat& W, arma::mat& H)
+  {
+    // Compute the reconstruction residual column by column, so the full
+    // (possibly very large) W * H is never formed.
+    double squaredError = 0.0;
+    for (size_t j = 0; j < H.n_cols; ++j)
+    {
+      arma::vec difference = W * H.col(j);
+      difference -= V->col(j);
+      squaredError += arma::dot(difference, difference);
+    }
+
+    lastResidue = residue;
+    residue = std::sqrt(squaredError) / normV;
+
+    iteration++;
+    Log::Info << "Iteration " << iteration << "; reconstruction residue "
+        << residue << ".\n";
+
+    // Check if termination criterion is met.  If maxIterations == 0, there is
+    // no iteration limit.
+    return (residue < minResidue ||
+        (lastResidue - residue) < minImprovement ||
+        iteration == maxIterations);
+  }
+
+  //! Get current value of the reconstruction residue.
+  const double& Index() const { return residue; }
+
+  //! Get current iteration count.
+  const size_t& Iteration() const { return iteration; }
+
+  //! Access max iteration count.
+  const size_t& MaxIterations() const { return maxIterations; }
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Access minimum residue value.
+  const double& MinResidue() const { return minResidue; }
+  double& MinResidue() { return minResidue; }
+
+  //! Access minimum improvement value.
+  const double& MinImprovement() const { return minImprovement; }
+  double& MinImprovement() { return minImprovement; }
+
+ private:
+  //! Residue threshold.
+  double minResidue;
+  //! Iteration threshold.
+  size_t maxIterations;
+  //! Minimum improvement of the residual between iterations.
+  double minImprovement;
+
+  //! Pointer to the matrix being factorized.
+  const MatType* V;
+
+  //! Current value of the reconstruction residue.
+  double residue;
+  //! Value of the reconstruction residue of the previous iteration.
+  double lastResidue;
+  //! Frobenius norm of the matrix being factorized.
+  double normV;
+  //! Current iteration count.
+  size_t iteration;
+};
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,286 @@
+/**
+ * @file methods/amf/termination_policies/sampled_residue_termination.hpp
+ *
+ * Termination policy used in AMF (Alternating Matrix Factorization) which
+ * estimates the reconstruction residue on a fixed sample of the observed
+ * entries instead of scanning the whole input matrix every iteration.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef _MLPACK_METHODS_AMF_SAMPLED_RESIDUE_TERMINATION_HPP_INCLUDED
+#define _MLPACK_METHODS_AMF_SAMPLED_RESIDUE_TERMINATION_HPP_INCLUDED
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements a sampled residue termination policy.  Like
+ * SimpleToleranceTermination, the algorithm terminates when the relative
+ * decrease of the RMSE over the observed (nonzero) entries drops below the
+ * tolerance, but the RMSE is estimated each iteration on a fixed reservoir
+ * sample of the observed entries, so the per-iteration check costs
+ * O(sampleSize * rank) instead of a pass over the whole input matrix.
+ *
+ * The sampled estimate comes with a standard error; as long as even the
+ * estimate minus its confidence margin shows a relative decrease of at least
+ * the tolerance, the algorithm is clearly not converged and nothing else is
+ * computed.  Only when the sampled decrease gets within the margin of the
+ * tolerance is the exact residue over all observed entries computed, and
+ * convergence is declared only from two consecutive exact checks, so the
+ * sampling noise can delay termination but never cause a premature one.
+ *
+ * @see AMF, SimpleToleranceTermination
+ */
+template<class MatType>
+class SampledResidueTermination
+{
+ public:
+  /**
+   * Construct the SampledResidueTermination object.
+   *
+   * @param tolerance Minimum relative decrease of the residue per iteration.
+   * @param maxIterations Maximum number of iterations (0 means no limit).
+   * @param sampleSize Number of observed entries to keep in the reservoir.
+   * @param confidence Number of standard errors of slack given to the
+   *     sampled estimate before the exact check is escalated to.
+   */
+  SampledResidueTermination(const double tolerance = 1e-5,
+                            const size_t maxIterations = 10000,
+                            const size_t sampleSize = 10000,
+                            const double confidence = 2.0) :
+      tolerance(tolerance),
+      maxIterations(maxIterations),
+      sampleSize(sampleSize),
+      confidence(confidence),
+      V(nullptr),
+      iteration(0),
+      residue(DBL_MAX),
+      residueOld(DBL_MAX),
+      exactResidueOld(DBL_MAX),
+      haveExactOld(false)
+  { }
+
+  /**
+   * Initializes the termination policy before starting the factorization;
+   * this draws the reservoir sample of the observed entries.
+   *
+   * @param V Input matrix to be factorized.
+   */
+  void Initialize(const MatType& V)
+  {
+    this->V = &V;
+    iteration = 0;
+    residue = DBL_MAX;
+    residueOld = DBL_MAX;
+    exactResidueOld = DBL_MAX;
+    haveExactOld = false;
+
+    // Reservoir-sample the observed entries (algorithm R): the k'th observed
+    // entry replaces a random reservoir slot with probability
+    // sampleSize / k.
+    sampleRows.set_size(sampleSize);
+    sampleCols.set_size(sampleSize);
+    sampleValues.set_size(sampleSize);
+    size_t seen = 0;
+    ForEachObserved(V, [&](const size_t row, const size_t col,
+                           const double value)
+    {
+      if (seen < sampleSize)
+      {
+        sampleRows[seen] = row;
+        sampleCols[seen] = col;
+        sampleValues[seen] = value;
+      }
+      else
+      {
+        const size_t slot = (size_t) math::RandInt((int) (seen + 1));
+        if (slot < sampleSize)
+        {
+          sampleRows[slot] = row;
+          sampleCols[slot] = col;
+          sampleValues[slot] = value;
+        }
+      }
+      ++seen;
+    });
+
+    // The matrix may have fewer observed entries than the reservoir size.
+    if (seen < sampleSize)
+    {
+      sampleRows.resize(seen);
+      sampleCols.resize(seen);
+      sampleValues.resize(seen);
+    }
+  }
+
+  /**
+   * Check if the termination criterion is met.
+   *
+   * @param W Basis matrix of output.
+   * @param H Encoding matrix of output.
+   */
+  bool IsConverged(arma::mat& W, arma::mat& H)
+  {
+    // Estimate the residue on the reservoir, along with the variance of the
+    // squared errors for the confidence margin.
+    const size_t n = sampleValues.n_elem;
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (size_t k = 0; k < n; ++k)
+    {
+      const double error = sampleValues[k] -
+          arma::dot(W.row(sampleRows[k]), H.col(sampleCols[k]));
+      const double sq = error * error;
+      sum += sq;
+      sumSq += sq * sq;
+    }
+
+    residueOld = residue;
+    const double mean = (n > 0) ? (sum / n) : 0.0;
+    residue = std::sqrt(mean);
+
+    // Standard error of the residue, by the delta method:
+    // se(sqrt(m)) = se(m) / (2 sqrt(m)).
+    double standardError = 0.0;
+    if (n > 0 && residue > 0.0)
+    {
+      const double meanVariance = std::max(sumSq / n - mean * mean, 0.0) / n;
+      standardError = std::sqrt(meanVariance) / (2.0 * residue);
+    }
+
+    ++iteration;
+    Log::Info << "Iteration " << iteration << "; sampled residue " << residue
+        << " (se " << standardError << ").\n";
+
+    // Even if the residue is larger than estimated by the confidence margin,
+    // is the relative decrease still clearly above the tolerance?  Then the
+    // algorithm is not converged and the exact check is skipped.
+    bool converged = false;
+    const double conservativeDecrease = (residueOld == DBL_MAX) ? DBL_MAX :
+        (residueOld - (residue + confidence * standardError)) / residueOld;
+    if (conservativeDecrease < tolerance)
+    {
+      // Near the threshold: escalate to the exact residue over all observed
+      // entries.  Convergence needs two consecutive exact checks, so a single
+      // noisy escalation cannot terminate the algorithm early.
+      const double exactResidue = ExactResidue(W, H);
+      if (haveExactOld)
+        converged = ((exactResidueOld - exactResidue) / exactResidueOld) <
+            tolerance;
+
+      exactResidueOld = exactResidue;
+      haveExactOld = true;
+      residue = exactResidue;
+      Log::Info << "Iteration " << iteration << "; exact residue "
+          << exactResidue << ".\n";
+    }
+    else
+    {
+      haveExactOld = false;
+    }
+
+    // If maxIterations == 0, there is no iteration limit.
+    return (converged || iteration == maxIterations);
+  }
+
+  //! Get current value of residue.
+  const double& Index() const { return residue; }
+
+  //! Get current iteration count.
+  const size_t& Iteration() const { return iteration; }
+
+  //! Access max iteration count.
+  const size_t& MaxIterations() const { return maxIterations; }
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Access tolerance value.
+  const double& Tolerance() const { return tolerance; }
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of entries in the reservoir.
+  size_t SampleSize() const { return sampleValues.n_elem; }
+
+ private:
+  /**
+   * Apply the given function to every observed (nonzero) entry of a sparse
+   * matrix, visiting only the stored nonzeros.
+   */
+  template<typename eT, typename FunctionType>
+  static void ForEachObserved(const arma::SpMat<eT>& V, FunctionType function)
+  {
+    for (typename arma::SpMat<eT>::const_iterator it = V.begin();
+        it != V.end(); ++it)
+      function(it.row(), it.col(), (double) *it);
+  }
+
+  /**
+   * Apply the given function to every observed (nonzero) entry of a dense
+   * matrix.
+   */
+  template<typename eT, typename FunctionType>
+  static void ForEachObserved(const arma::Mat<eT>& V, FunctionType function)
+  {
+    for (size_t j = 0; j < V.n_cols; ++j)
+      for (size_t i = 0; i < V.n_rows; ++i)
+        if (V(i, j) != eT(0))
+          function(i, j, (double) V(i, j));
+  }
+
+  /**
+   * Compute the exact RMSE over all observed entries, without materializing
+   * W * H.
+   */
+  double ExactResidue(const arma::mat& W, const arma::mat& H) const
+  {
+    double sum = 0.0;
+    size_t count = 0;
+    ForEachObserved(*V, [&](const size_t row, const size_t col,
+                            const double value)
+    {
+      const double error = value - arma::dot(W.row(row), H.col(col));
+      sum += error * error;
+      ++count;
+    });
+
+    return (count > 0) ? std::sqrt(sum / count) : 0.0;
+  }
+
+  //! Residue decrease tolerance.
+  double tolerance;
+  //! Iteration threshold.
+  size_t maxIterations;
+  //! Requested reservoir size.
+  size_t sampleSize;
+  //! Number of standard errors of slack before escalating.
+  double confidence;
+
+  //! Pointer to the input matrix.
+  const MatType* V;
+
+  //! Row, column, and value of each reservoir entry.
+  arma::uvec sampleRows;
+  arma::uvec sampleCols;
+  arma::vec sampleValues;
+
+  //! Current iteration count.
+  size_t iteration;
+  //! Current (sampled or, after an escalation, exact) residue.
+  double residue;
+  //! Sampled residue of the previous iteration.
+  double residueOld;
+  //! Exact residue of the last escalated iteration.
+  double exactResidueOld;
+  //! True if the previous iteration also computed the exact residue.
+  bool haveExactOld;
+}; // class SampledResidueTermination
+
+} // namespace amf
+} // namespace mlpack
+
+#endif // _MLPACK_METHODS_AMF_SAMPLED_RESIDUE_TERMINATION_HPP_INCLUDED
@@ -0,0 +1,211 @@
+/**
+ * @file methods/amf/update_rules/nmf_mult_dist_delta.hpp
+ *
+ * Delta-aware multiplicative distance update rules for the Non-negative
+ * Matrix Factorization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_NMF_MULT_DIST_DELTA_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_NMF_MULT_DIST_DELTA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * Delta-aware variant of the multiplicative distance update rules (see
+ * NMFMultiplicativeDistanceUpdate), meant for refactorizing slowly-changing
+ * matrices from warm-started factors: only the rows of W and the columns of H
+ * whose input entries changed since the previous factorization are
+ * recomputed, so one iteration costs proportional to the drift of the input
+ * instead of its size.  The changed coordinates can be computed from the old
+ * and new input matrices with FindChangedEntries().
+ *
+ * Restricting the updates to the changed coordinates is an approximation: a
+ * changed entry also couples to the untouched rows and columns through the
+ * factors.  With warm-started factors and small drift the coupling is weak,
+ * and the reconstruction quality can be monitored with a residual-driven
+ * termination policy (see ReconstructionResidueTermination).  When the
+ * changed coordinate sets are empty, the full multiplicative updates are
+ * applied.
+ *
+ * @see NMFMultiplicativeDistanceUpdate, GivenInitialization
+ */
+class NMFMultiplicativeDistanceDeltaUpdate
+{
+ public:
+  //! Construct the rule updating all rows and columns.
+  NMFMultiplicativeDistanceDeltaUpdate() { }
+
+  /**
+   * Construct the rule updating only the given rows of W and columns of H.
+   *
+   * @param changedRows Rows of the input whose entries changed.
+   * @param changedCols Columns of the input whose entries changed.
+   */
+  NMFMultiplicativeDistanceDeltaUpdate(const arma::uvec& changedRows,
+                                       const arma::uvec& changedCols) :
+      changedRows(changedRows),
+      changedCols(changedCols)
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Initialize the factorization.  This update rule takes its information
+   * from the constructor, so the input parameters are ignored.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& /* dataset */, const size_t /* rank */)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Compute the coordinates at which two matrices of the same size differ.
+   *
+   * @param oldV Input matrix of the previous factorization.
+   * @param newV Input matrix to be refactorized.
+   * @param changedRows Rows at which any entry differs.
+   * @param changedCols Columns at which any entry differs.
+   */
+  template<typename MatType>
+  static void FindChangedEntries(const MatType& oldV,
+                                 const MatType& newV,
+                                 arma::uvec& changedRows,
+                                 arma::uvec& changedCols)
+  {
+    if (oldV.n_rows != newV.n_rows || oldV.n_cols != newV.n_cols)
+    {
+      throw std::invalid_argument("NMFMultiplicativeDistanceDeltaUpdate::"
+          "FindChangedEntries(): matrices must have the same size!");
+    }
+
+    std::vector<bool> rowChanged(oldV.n_rows, false);
+    std::vector<bool> colChanged(oldV.n_cols, false);
+
+    for (size_t j = 0; j < oldV.n_cols; ++j)
+    {
+      for (size_t i = 0; i < oldV.n_rows; ++i)
+      {
+        if (oldV(i, j) != newV(i, j))
+        {
+          rowChanged[i] = true;
+          colChanged[j] = true;
+        }
+      }
+    }
+
+    changedRows = Collect(rowChanged);
+    changedCols = Collect(colChanged);
+  }
+
+  /**
+   * The update rule for the basis matrix W; only the changed rows are
+   * recomputed with the multiplicative distance formula.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& V,
+                      arma::mat& W,
+                      const arma::mat& H)
+  {
+    if (changedRows.n_elem == 0)
+    {
+      W = (W % (V * H.t())) / (W * H * H.t());
+      return;
+    }
+
+    // The rank x rank Gram matrix is shared by all row updates.
+    const arma::mat hht = H * H.t();
+
+    #pragma omp parallel for
+    for (omp_size_t k = 0; k < (omp_size_t) changedRows.n_elem; ++k)
+    {
+      const arma::uword r = changedRows(k);
+      const arma::rowvec numerator(V.row(r) * H.t());
+      W.row(r) = (W.row(r) % numerator) / (W.row(r) * hht);
+    }
+  }
+
+  /**
+   * The update rule for the encoding matrix H; only the changed columns are
+   * recomputed with the multiplicative distance formula.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& V,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    if (changedCols.n_elem == 0)
+    {
+      H = (H % (W.t() * V)) / (W.t() * W * H);
+      return;
+    }
+
+    // The rank x rank Gram matrix is shared by all column updates.
+    const arma::mat wtw = W.t() * W;
+
+    #pragma omp parallel for
+    for (omp_size_t k = 0; k < (omp_size_t) changedCols.n_elem; ++k)
+    {
+      const arma::uword c = changedCols(k);
+      const arma::vec numerator(W.t() * V.col(c));
+      H.col(c) = (H.col(c) % numerator) / (wtw * H.col(c));
+    }
+  }
+
+  //! Get the rows of W recomputed by the updates.
+  const arma::uvec& ChangedRows() const { return changedRows; }
+  //! Modify the rows of W recomputed by the updates.
+  arma::uvec& ChangedRows() { return changedRows; }
+
+  //! Get the columns of H recomputed by the updates.
+  const arma::uvec& ChangedCols() const { return changedCols; }
+  //! Modify the columns of H recomputed by the updates.
+  arma::uvec& ChangedCols() { return changedCols; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(changedRows));
+    ar(CEREAL_NVP(changedCols));
+  }
+
+ private:
+  //! Gather the indices of the set flags.
+  static arma::uvec Collect(const std::vector<bool>& changed)
+  {
+    std::vector<arma::uword> collected;
+    for (size_t i = 0; i < changed.size(); ++i)
+    {
+      if (changed[i])
+        collected.push_back(i);
+    }
+
+    return arma::uvec(collected);
+  }
+
+  //! Rows of W recomputed by the updates; empty means all rows.
+  arma::uvec changedRows;
+  //! Columns of H recomputed by the updates; empty means all columns.
+  arma::uvec changedCols;
+};
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
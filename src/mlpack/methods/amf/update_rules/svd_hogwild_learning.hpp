@@ -0,0 +1,229 @@
+/**
+ * @file methods/amf/update_rules/svd_hogwild_learning.hpp
+ *
+ * Lock-free parallel SGD (Hogwild) update rule used in AMF (Alternating
+ * Matrix Factorization).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_SVD_HOGWILD_LEARNING_HPP
+#define MLPACK_METHODS_AMF_SVD_HOGWILD_LEARNING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack
+{
+namespace amf
+{
+
+/**
+ * This class computes SVD of a sparse matrix by stochastic gradient descent
+ * over the nonzero entries, run lock-free across an OpenMP team in the
+ * Hogwild style:
+ *
+ * @code
+ * @inproceedings{recht2011hogwild,
+ *   title     = {Hogwild!: A lock-free approach to parallelizing stochastic
+ *                gradient descent},
+ *   author    = {Recht, Benjamin and Re, Christopher and Wright, Stephen
+ *                and Niu, Feng},
+ *   booktitle = {Advances in Neural Information Processing Systems},
+ *   pages     = {693--701},
+ *   year      = {2011}
+ * }
+ * @endcode
+ *
+ * The nonzero coordinates are collected once at initialization and visited
+ * in a freshly shuffled order each iteration.  The threads update the factor
+ * rows without locks or atomics; two threads only collide when they process
+ * ratings of the same item (or user) at the same instant, which is rare at
+ * typical rating-matrix sparsity, and such benign races merely make the
+ * update approximate, as in the reference above.
+ *
+ * @see SVDBatchLearning
+ */
+class SVDHogwildLearning
+{
+ public:
+  /**
+   * Initialize the parameters of SVDHogwildLearning.
+   *
+   * @param u Step size of the stochastic updates.
+   * @param kw Regularization constant for W matrix.
+   * @param kh Regularization constant for H matrix.
+   */
+  SVDHogwildLearning(double u = 0.002,
+                     double kw = 0,
+                     double kh = 0)
+          : u(u), kw(kw), kh(kh)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Initialize parameters before factorization.  This function must be
+   * called before a new factorization.  It collects the coordinates and
+   * values of the nonzero entries, so the SGD passes can shard them across
+   * threads without touching the matrix structure again.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) of factorization
+   */
+  template<typename MatType>
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    std::vector<arma::uword> entryRows;
+    std::vector<arma::uword> entryCols;
+    std::vector<double> entryValues;
+
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+    {
+      for (size_t i = 0; i < dataset.n_rows; ++i)
+      {
+        const double value = dataset(i, j);
+        if (value != 0)
+        {
+          entryRows.push_back(i);
+          entryCols.push_back(j);
+          entryValues.push_back(value);
+        }
+      }
+    }
+
+    StoreEntries(entryRows, entryCols, entryValues);
+  }
+
+  /**
+   * Initialize parameters before factorization of a sparse matrix; the
+   * nonzero entries are read straight from the CSC arrays.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) of factorization
+   */
+  void Initialize(const arma::sp_mat& dataset, const size_t /* rank */)
+  {
+    rows.set_size(dataset.n_nonzero);
+    cols.set_size(dataset.n_nonzero);
+    values.set_size(dataset.n_nonzero);
+
+    for (arma::uword j = 0; j < dataset.n_cols; ++j)
+    {
+      for (arma::uword pos = dataset.col_ptrs[j];
+           pos < dataset.col_ptrs[j + 1]; ++pos)
+      {
+        rows(pos) = dataset.row_indices[pos];
+        cols(pos) = j;
+        values(pos) = dataset.values[pos];
+      }
+    }
+
+    visitOrder = (values.n_elem > 0) ? arma::linspace<arma::uvec>(0,
+        values.n_elem - 1, values.n_elem) : arma::uvec();
+  }
+
+  /**
+   * The update rule for the basis matrix W: one stochastic pass over the
+   * shuffled nonzero entries, sharded across the OpenMP team.
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& /* V */,
+                      arma::mat& W,
+                      const arma::mat& H)
+  {
+    // A fresh visiting order each epoch.
+    visitOrder = arma::shuffle(visitOrder);
+
+    #pragma omp parallel for
+    for (omp_size_t k = 0; k < (omp_size_t) visitOrder.n_elem; ++k)
+    {
+      const arma::uword i = rows(visitOrder(k));
+      const arma::uword j = cols(visitOrder(k));
+
+      const double error = values(visitOrder(k)) -
+          arma::dot(W.row(i), H.col(j));
+      W.row(i) += u * (error * H.col(j).t() - kw * W.row(i));
+    }
+  }
+
+  /**
+   * The update rule for the encoding matrix H: one stochastic pass over the
+   * shuffled nonzero entries, sharded across the OpenMP team.
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& /* V */,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    visitOrder = arma::shuffle(visitOrder);
+
+    #pragma omp parallel for
+    for (omp_size_t k = 0; k < (omp_size_t) visitOrder.n_elem; ++k)
+    {
+      const arma::uword i = rows(visitOrder(k));
+      const arma::uword j = cols(visitOrder(k));
+
+      const double error = values(visitOrder(k)) -
+          arma::dot(W.row(i), H.col(j));
+      H.col(j) += u * (error * W.row(i).t() - kh * H.col(j));
+    }
+  }
+
+  //! Get the step size.
+  double StepSize() const { return u; }
+  //! Modify the step size.
+  double& StepSize() { return u; }
+
+  //! Serialize the SVDHogwildLearning object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(u));
+    ar(CEREAL_NVP(kw));
+    ar(CEREAL_NVP(kh));
+  }
+
+ private:
+  //! Store the collected nonzero entries of a dense input.
+  void StoreEntries(const std::vector<arma::uword>& entryRows,
+                    const std::vector<arma::uword>& entryCols,
+                    const std::vector<double>& entryValues)
+  {
+    rows = arma::uvec(entryRows);
+    cols = arma::uvec(entryCols);
+    values = arma::vec(entryValues);
+    visitOrder = (values.n_elem > 0) ? arma::linspace<arma::uvec>(0,
+        values.n_elem - 1, values.n_elem) : arma::uvec();
+  }
+
+  //! Step size of the stochastic updates.
+  double u;
+  //! Regularization parameter for the W matrix.
+  double kw;
+  //! Regularization parameter for the H matrix.
+  double kh;
+
+  //! Row coordinate of each nonzero entry.
+  arma::uvec rows;
+  //! Column coordinate of each nonzero entry.
+  arma::uvec cols;
+  //! Value of each nonzero entry.
+  arma::vec values;
+  //! Shuffled visiting order of the entries.
+  arma::uvec visitOrder;
+};
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
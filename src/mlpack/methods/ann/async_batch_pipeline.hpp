@@ -0,0 +1,226 @@
+/**
+ * @file methods/ann/async_batch_pipeline.hpp
+ *
+ * Definition of the AsyncBatchPipeline class, an ensmallen-compatible
+ * separable function that feeds a network from a user-supplied batch
+ * producer.  A background thread runs the producer (loading, augmentation,
+ * scaling) for the next batch into one of a pair of buffers while the
+ * optimizer consumes the other, so data preparation overlaps with the
+ * compute-bound forward and backward passes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ASYNC_BATCH_PIPELINE_HPP
+#define MLPACK_METHODS_ANN_ASYNC_BATCH_PIPELINE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * An asynchronous, double-buffered batch pipeline around a network.
+ *
+ * The pipeline exposes the separable function API that ensmallen's SGD-style
+ * optimizers expect (NumFunctions(), Shuffle(), Evaluate() and
+ * EvaluateWithGradient() over a range of points), but instead of holding one
+ * monolithic predictors matrix it pulls batches on demand from a
+ * user-supplied producer callable.  Whenever a batch is consumed, the
+ * producer is invoked for the next batch in visitation order on a background
+ * thread, writing into the buffer that is not currently in use; when the
+ * optimizer asks for that batch, the buffers are swapped and the prepared
+ * data is used without any copy.  A batch requested out of prefetch order is
+ * produced synchronously, so any visitation order is correct — sequential
+ * visitation is merely fastest.
+ *
+ * The pipeline presents numBatches * batchSize separable functions, so the
+ * optimizer should be configured with the same batch size:
+ *
+ * @code
+ * FFN<> model;
+ * ...
+ * AsyncBatchPipeline<FFN<>, ProducerType> pipeline(model, producer,
+ *     numBatches, batchSize);
+ * ens::SGD<> optimizer(0.01, batchSize, maxIterations);
+ * optimizer.Optimize(pipeline, model.Parameters());
+ * @endcode
+ *
+ * @tparam ModelType The type of the network to train; it must provide
+ *     Parameters(), Evaluate(predictors, responses), Forward(inputs,
+ *     results) and Backward(inputs, targets, gradients).
+ * @tparam ProducerType A callable with signature void(const size_t batch,
+ *     arma::mat& predictors, arma::mat& responses) that fills the given
+ *     buffers with the data of the given batch.  It is invoked from a
+ *     background thread, so it must not touch the model.
+ */
+template<typename ModelType, typename ProducerType>
+class AsyncBatchPipeline
+{
+ public:
+  /**
+   * Construct the pipeline around the given network and start the producer
+   * thread.  The model and the producer must outlive the pipeline.
+   *
+   * @param model The network to evaluate batches against.
+   * @param producer The callable that materializes a batch.
+   * @param numBatches Number of batches the producer can provide.
+   * @param batchSize Number of points in each batch.
+   */
+  AsyncBatchPipeline(ModelType& model,
+                     ProducerType producer,
+                     const size_t numBatches,
+                     const size_t batchSize);
+
+  //! Stop the producer thread and clean up.
+  ~AsyncBatchPipeline();
+
+  //! The pipeline owns a thread and cannot be copied.
+  AsyncBatchPipeline(const AsyncBatchPipeline&) = delete;
+  //! The pipeline owns a thread and cannot be copied.
+  AsyncBatchPipeline& operator=(const AsyncBatchPipeline&) = delete;
+
+  /**
+   * Evaluate the network on the batch containing the given range of points.
+   *
+   * @param parameters Matrix model parameters.
+   * @param begin Index of the starting point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize);
+
+  /**
+   * Evaluate the network on the batch containing the given range of points
+   * and compute the gradient of the objective with respect to the
+   * parameters.
+   *
+   * @param parameters Matrix model parameters.
+   * @param begin Index of the starting point of the batch.
+   * @param gradient Matrix to output gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              const size_t begin,
+                              arma::mat& gradient,
+                              const size_t batchSize);
+
+  /**
+   * Compute the gradient of the objective on the batch containing the given
+   * range of points.  This just calls EvaluateWithGradient() and discards
+   * the objective.
+   *
+   * @param parameters Matrix model parameters.
+   * @param begin Index of the starting point of the batch.
+   * @param gradient Matrix to output gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize);
+
+  /**
+   * Shuffle the order in which the batches are visited.  This may be called
+   * by the optimizer.  Points are permuted at batch granularity, since the
+   * producer is the only party that can see inside a batch.
+   */
+  void Shuffle();
+
+  //! Return the number of separable functions (batches times batch size).
+  size_t NumFunctions() const { return numBatches * batchSize; }
+
+  //! Get the wrapped network.
+  const ModelType& Model() const { return model; }
+  //! Modify the wrapped network.
+  ModelType& Model() { return model; }
+
+  //! Get the number of batches served from the prefetched buffer.
+  size_t PrefetchHits() const { return prefetchHits; }
+  //! Get the number of batches that had to be produced synchronously.
+  size_t PrefetchMisses() const { return prefetchMisses; }
+
+ private:
+  //! One side of the double buffer.
+  struct Buffer
+  {
+    //! The producer batch index the buffers hold, or numBatches if none.
+    size_t batch;
+    //! Whether the buffers hold a fully produced batch.
+    bool ready;
+    //! The predictors of the held batch.
+    arma::mat predictors;
+    //! The responses of the held batch.
+    arma::mat responses;
+  };
+
+  /**
+   * Make the batch at the given visitation position available in the front
+   * buffer (swapping in the prefetched buffer or producing synchronously as
+   * needed) and schedule the prefetch of the following batch.
+   *
+   * @param position Position of the batch in the current visitation order.
+   * @return The front buffer, holding the requested batch.
+   */
+  const Buffer& FetchBatch(const size_t position);
+
+  //! Copy the optimizer iterate into the network if they are not aliases.
+  void SyncParameters(const arma::mat& parameters);
+
+  //! The producer thread main loop: produce each requested batch into the
+  //! back buffer.
+  void ProducerLoop();
+
+  //! The network batches are evaluated against.
+  ModelType& model;
+  //! The callable that materializes a batch.
+  ProducerType producer;
+  //! Number of batches the producer can provide.
+  size_t numBatches;
+  //! Number of points in each batch.
+  size_t batchSize;
+
+  //! The current batch visitation order (position -> producer batch index).
+  arma::uvec batchOrder;
+
+  //! The double buffer; buffers[front] is owned by the consumer, the other
+  //! side by the producer thread while a prefetch is pending.
+  Buffer buffers[2];
+  //! Index of the consumer-owned buffer.
+  size_t front;
+
+  //! Guards the buffer metadata and the request state.
+  std::mutex mutex;
+  //! Signaled when a prefetch request is posted (or on shutdown).
+  std::condition_variable produceSignal;
+  //! Signaled when a prefetch request has been completed.
+  std::condition_variable readySignal;
+  //! The producer batch index of the pending prefetch request.
+  size_t requestedBatch;
+  //! Whether a prefetch request is pending or in flight.
+  bool requestPending;
+  //! Whether the producer thread should terminate.
+  bool shutdown;
+  //! The background thread running ProducerLoop().
+  std::thread producerThread;
+
+  //! Number of batches served from the prefetched buffer.
+  size_t prefetchHits;
+  //! Number of batches that had to be produced synchronously.
+  size_t prefetchMisses;
+}; // class AsyncBatchPipeline
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "async_batch_pipeline_impl.hpp"
+
+#endif
@@ -0,0 +1,196 @@
+/**
+ * @file methods/ann/async_batch_pipeline_impl.hpp
+ *
+ * Implementation of the AsyncBatchPipeline class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ASYNC_BATCH_PIPELINE_IMPL_HPP
+#define MLPACK_METHODS_ANN_ASYNC_BATCH_PIPELINE_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "async_batch_pipeline.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename ModelType, typename ProducerType>
+AsyncBatchPipeline<ModelType, ProducerType>::AsyncBatchPipeline(
+    ModelType& model,
+    ProducerType producer,
+    const size_t numBatches,
+    const size_t batchSize) :
+    model(model),
+    producer(std::move(producer)),
+    numBatches(numBatches),
+    batchSize(batchSize),
+    front(0),
+    requestedBatch(0),
+    requestPending(false),
+    shutdown(false),
+    prefetchHits(0),
+    prefetchMisses(0)
+{
+  if (numBatches == 0 || batchSize == 0)
+  {
+    throw std::invalid_argument("AsyncBatchPipeline::AsyncBatchPipeline(): "
+        "numBatches and batchSize must be positive!");
+  }
+
+  batchOrder = arma::linspace<arma::uvec>(0, numBatches - 1, numBatches);
+
+  // numBatches is not a valid batch index, so it marks an empty buffer.
+  buffers[0].batch = buffers[1].batch = numBatches;
+  buffers[0].ready = buffers[1].ready = false;
+
+  producerThread = std::thread([this]() { ProducerLoop(); });
+}
+
+template<typename ModelType, typename ProducerType>
+AsyncBatchPipeline<ModelType, ProducerType>::~AsyncBatchPipeline()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    shutdown = true;
+  }
+  produceSignal.notify_one();
+  if (producerThread.joinable())
+    producerThread.join();
+}
+
+template<typename ModelType, typename ProducerType>
+void AsyncBatchPipeline<ModelType, ProducerType>::ProducerLoop()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true)
+  {
+    produceSignal.wait(lock, [this]() { return requestPending || shutdown; });
+    if (shutdown)
+      return;
+
+    // The consumer does not touch the back buffer (or flip the buffers)
+    // while a request is pending, so the producer can be run unlocked.
+    const size_t batch = requestedBatch;
+    Buffer& back = buffers[1 - front];
+    lock.unlock();
+    producer(batch, back.predictors, back.responses);
+    lock.lock();
+
+    back.batch = batch;
+    back.ready = true;
+    requestPending = false;
+    readySignal.notify_one();
+  }
+}
+
+template<typename ModelType, typename ProducerType>
+const typename AsyncBatchPipeline<ModelType, ProducerType>::Buffer&
+AsyncBatchPipeline<ModelType, ProducerType>::FetchBatch(const size_t position)
+{
+  const size_t batch = batchOrder[position % numBatches];
+
+  std::unique_lock<std::mutex> lock(mutex);
+  // Wait for any prefetch in flight; the back buffer may hold our batch.
+  readySignal.wait(lock, [this]() { return !requestPending; });
+
+  if (!buffers[front].ready || buffers[front].batch != batch)
+  {
+    if (buffers[1 - front].ready && buffers[1 - front].batch == batch)
+    {
+      // The prefetched buffer becomes the front buffer.
+      front = 1 - front;
+      ++prefetchHits;
+    }
+    else
+    {
+      // The batch was requested out of prefetch order; produce it
+      // synchronously into the front buffer.
+      ++prefetchMisses;
+      Buffer& target = buffers[front];
+      lock.unlock();
+      producer(batch, target.predictors, target.responses);
+      lock.lock();
+      target.batch = batch;
+      target.ready = true;
+    }
+  }
+
+  // Kick off the prefetch of the next batch in visitation order while the
+  // caller consumes this one.
+  const size_t next = batchOrder[(position + 1) % numBatches];
+  if (next != batch &&
+      !(buffers[1 - front].ready && buffers[1 - front].batch == next))
+  {
+    buffers[1 - front].ready = false;
+    requestedBatch = next;
+    requestPending = true;
+    produceSignal.notify_one();
+  }
+
+  return buffers[front];
+}
+
+template<typename ModelType, typename ProducerType>
+void AsyncBatchPipeline<ModelType, ProducerType>::SyncParameters(
+    const arma::mat& parameters)
+{
+  // When the optimizer iterate is the network's own parameter matrix (the
+  // usual case), there is nothing to do.
+  if (parameters.memptr() != model.Parameters().memptr())
+    model.Parameters() = parameters;
+}
+
+template<typename ModelType, typename ProducerType>
+double AsyncBatchPipeline<ModelType, ProducerType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t /* batchSize */)
+{
+  const Buffer& buffer = FetchBatch(begin / batchSize);
+  SyncParameters(parameters);
+  return model.Evaluate(buffer.predictors, buffer.responses);
+}
+
+template<typename ModelType, typename ProducerType>
+double AsyncBatchPipeline<ModelType, ProducerType>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t /* batchSize */)
+{
+  const Buffer& buffer = FetchBatch(begin / batchSize);
+  SyncParameters(parameters);
+
+  arma::mat results;
+  model.Forward(buffer.predictors, results);
+  return model.Backward(buffer.predictors, buffer.responses, gradient);
+}
+
+template<typename ModelType, typename ProducerType>
+void AsyncBatchPipeline<ModelType, ProducerType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize)
+{
+  this->EvaluateWithGradient(parameters, begin, gradient, batchSize);
+}
+
+template<typename ModelType, typename ProducerType>
+void AsyncBatchPipeline<ModelType, ProducerType>::Shuffle()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  // The buffers are tagged with producer batch indices, so a prefetched
+  // batch stays valid across a reordering; only the visitation order
+  // changes.
+  readySignal.wait(lock, [this]() { return !requestPending; });
+  batchOrder = arma::shuffle(batchOrder);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -378,10 +378,12 @@ class BRNN
   //! Locally-stored output parameter visitor.
   OutputParameterVisitor outputParameterVisitor;
 
-  //! All output parameters for the backward pass (BBTT) for forward RNN.
+  //! Persistent workspace of output parameters for the backward pass (BBTT)
+  //! for forward RNN; entries are overwritten in place across evaluations.
   std::vector<arma::mat> forwardRNNOutputParameter;
 
-  //! All output parameters for the backward pass (BBTT) for backward RNN.
+  //! Persistent workspace of output parameters for the backward pass (BBTT)
+  //! for backward RNN; entries are overwritten in place across evaluations.
   std::vector<arma::mat> backwardRNNOutputParameter;
 
   //! Locally-stored weight size visitor.
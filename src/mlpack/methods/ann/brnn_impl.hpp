@@ -17,7 +17,9 @@
 #include "brnn.hpp"
 
 #include "visitor/load_output_parameter_visitor.hpp"
+#include "visitor/restore_output_parameter_visitor.hpp"
 #include "visitor/save_output_parameter_visitor.hpp"
+#include "visitor/store_output_parameter_visitor.hpp"
 #include "visitor/forward_visitor.hpp"
 #include "visitor/backward_visitor.hpp"
 #include "visitor/reset_cell_visitor.hpp"
@@ -414,6 +416,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
   // Forward propogation from both directions.
   std::vector<arma::mat> results1, results2;
+  size_t forwardPosition = 0, backwardPosition = 0;
   for (size_t seqNum = 0; seqNum < rho; ++seqNum)
   {
     forwardRNN.Forward(arma::mat(
@@ -423,12 +426,16 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
         predictors.slice(rho - seqNum - 1).colptr(begin),
         predictors.n_rows, batchSize, false, true));
 
+    // Overwrite the persistent workspaces in place; after the first
+    // evaluation no per-timestep allocations happen here.
     for (size_t l = 0; l < networkSize; ++l)
     {
-      boost::apply_visitor(SaveOutputParameterVisitor(
-          forwardRNNOutputParameter), forwardRNN.network[l]);
-      boost::apply_visitor(SaveOutputParameterVisitor(
-          backwardRNNOutputParameter), backwardRNN.network[l]);
+      boost::apply_visitor(StoreOutputParameterVisitor(
+          forwardRNNOutputParameter, forwardPosition),
+          forwardRNN.network[l]);
+      boost::apply_visitor(StoreOutputParameterVisitor(
+          backwardRNNOutputParameter, backwardPosition),
+          backwardRNN.network[l]);
     }
     boost::apply_visitor(SaveOutputParameterVisitor(results1),
         forwardRNN.network.back());
@@ -521,8 +528,8 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     forwardGradient.zeros();
     for (size_t l = 0; l < networkSize; ++l)
     {
-      boost::apply_visitor(LoadOutputParameterVisitor(
-          forwardRNNOutputParameter),
+      boost::apply_visitor(RestoreOutputParameterVisitor(
+          forwardRNNOutputParameter, forwardPosition),
           forwardRNN.network[networkSize - 1 - l]);
     }
     boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
@@ -560,8 +567,8 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     backwardGradient.zeros();
     for (size_t l = 0; l < networkSize; ++l)
     {
-      boost::apply_visitor(LoadOutputParameterVisitor(
-          backwardRNNOutputParameter),
+      boost::apply_visitor(RestoreOutputParameterVisitor(
+          backwardRNNOutputParameter, backwardPosition),
           backwardRNN.network[networkSize - 1 - l]);
     }
     boost::apply_visitor(BackwardVisitor(
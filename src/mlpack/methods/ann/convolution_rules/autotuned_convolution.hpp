@@ -0,0 +1,232 @@
+/**
+ * @file methods/ann/convolution_rules/autotuned_convolution.hpp
+ *
+ * Implementation of a convolution rule that benchmarks the available rules
+ * for the actual shapes and binds the fastest one.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_AUTOTUNED_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_AUTOTUNED_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+#include "fft_convolution.hpp"
+#include "svd_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution with whichever rule is fastest
+ * for the given shapes.  The crossover between the naive, FFT and SVD rules
+ * depends on the input and kernel dimensions, so a hard-coded choice loses
+ * on some architectures; this rule times the candidates the first time a
+ * shape combination is seen and caches the winner, keyed by the input and
+ * filter dimensions.  Since the shapes of a convolutional layer are fixed
+ * after setup, every later call dispatches straight to the bound rule.
+ *
+ * The cache is per thread, so no locking is needed on the hot path; each
+ * thread tunes a shape at most once.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class AutotunedConvolution
+{
+ public:
+  /*
+   * Perform a convolution, using the rule that was measured to be fastest
+   * for the given input and filter shapes.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Mat<eT>& output)
+  {
+    typedef std::tuple<size_t, size_t, size_t, size_t> ShapeKey;
+    static thread_local std::map<ShapeKey, size_t> ruleCache;
+
+    const ShapeKey key(input.n_rows, input.n_cols,
+        filter.n_rows, filter.n_cols);
+    typename std::map<ShapeKey, size_t>::iterator it = ruleCache.find(key);
+    if (it == ruleCache.end())
+      it = ruleCache.insert(std::make_pair(key, Tune(input, filter))).first;
+
+    Apply(it->second, input, filter, output);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output)
+  {
+    arma::Mat<eT> convOutput;
+    AutotunedConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      AutotunedConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i));
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output)
+  {
+    arma::Mat<eT> convOutput;
+    AutotunedConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      AutotunedConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i));
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output)
+  {
+    arma::Mat<eT> convOutput;
+    AutotunedConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      AutotunedConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i));
+    }
+  }
+
+ private:
+  //! The candidate rules, in the order used by Apply() and Tune().
+  enum Rule
+  {
+    NAIVE_RULE = 0,
+    FFT_RULE = 1,
+    SVD_RULE = 2
+  };
+
+  /*
+   * Run the given candidate rule.  The FFT rule needs an even last input
+   * dimension, so the padded variant is selected at runtime for odd widths.
+   */
+  template<typename eT>
+  static void Apply(const size_t rule,
+                    const arma::Mat<eT>& input,
+                    const arma::Mat<eT>& filter,
+                    arma::Mat<eT>& output)
+  {
+    switch (rule)
+    {
+      case FFT_RULE:
+        if (input.n_cols % 2 == 0)
+          FFTConvolution<BorderMode, false>::Convolution(input, filter,
+              output);
+        else
+          FFTConvolution<BorderMode, true>::Convolution(input, filter,
+              output);
+        break;
+      case SVD_RULE:
+        SVDConvolution<BorderMode>::Convolution(input, filter, output);
+        break;
+      default:
+        NaiveConvolution<BorderMode>::Convolution(input, filter, output);
+        break;
+    }
+  }
+
+  /*
+   * Time each applicable candidate rule for the given shapes and return the
+   * fastest one.  Every candidate runs a few repetitions to reduce timer
+   * noise; the cost is paid once per shape combination and thread.
+   */
+  template<typename eT>
+  static size_t Tune(const arma::Mat<eT>& input, const arma::Mat<eT>& filter)
+  {
+    // In valid mode the FFT rule requires the filter to fit into the input.
+    const bool fftApplicable =
+        !std::is_same<BorderMode, ValidConvolution>::value ||
+        (filter.n_rows <= input.n_rows && filter.n_cols <= input.n_cols);
+
+    const size_t repetitions = 3;
+    arma::Mat<eT> candidateOutput;
+    arma::wall_clock timer;
+
+    size_t bestRule = NAIVE_RULE;
+    double bestTime = std::numeric_limits<double>::max();
+    for (size_t rule = NAIVE_RULE; rule <= SVD_RULE; ++rule)
+    {
+      if (rule == FFT_RULE && !fftApplicable)
+        continue;
+
+      timer.tic();
+      for (size_t i = 0; i < repetitions; ++i)
+        Apply(rule, input, filter, candidateOutput);
+      const double time = timer.toc();
+
+      if (time < bestTime)
+      {
+        bestTime = time;
+        bestRule = rule;
+      }
+    }
+
+    return bestRule;
+  }
+};  // class AutotunedConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
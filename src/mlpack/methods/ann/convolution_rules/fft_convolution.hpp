@@ -55,16 +55,23 @@ class FFTConvolution
               const arma::Mat<eT>& filter,
               arma::Mat<eT>& output)
   {
-    arma::Mat<eT> inputPadded = input;
-    arma::Mat<eT> filterPadded = filter;
+    // The padded scratch matrices are cached per thread, so repeated calls
+    // with the same shapes (every minibatch of a convolutional layer) reuse
+    // the allocations instead of building fresh buffers.
+    static thread_local arma::Mat<eT> inputPadded;
+    static thread_local arma::Mat<eT> filterPadded;
+    static thread_local arma::Mat<eT> temp;
+
+    inputPadded = input;
 
     if (padLastDim)
       inputPadded.resize(inputPadded.n_rows, inputPadded.n_cols + 1);
 
     // Pad filter and input to the output shape.
-    filterPadded.resize(inputPadded.n_rows, inputPadded.n_cols);
+    filterPadded.zeros(inputPadded.n_rows, inputPadded.n_cols);
+    filterPadded.submat(0, 0, filter.n_rows - 1, filter.n_cols - 1) = filter;
 
-    arma::Mat<eT> temp = arma::real(ifft2(arma::fft2(inputPadded) % arma::fft2(
+    temp = arma::real(ifft2(arma::fft2(inputPadded) % arma::fft2(
         filterPadded)));
 
     // Extract the region of interest. We don't need to handle the padLastDim in
@@ -99,18 +106,24 @@ class FFTConvolution
     if (padLastDim)
         outputCols++;
 
+    // The padded scratch matrices are cached per thread, so repeated calls
+    // with the same shapes (every minibatch of a convolutional layer) reuse
+    // the allocations instead of building fresh buffers.
+    static thread_local arma::Mat<eT> inputPadded;
+    static thread_local arma::Mat<eT> filterPadded;
+    static thread_local arma::Mat<eT> temp;
+
     // Pad filter and input to the working output shape.
-    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(outputRows,
-        outputCols);
+    inputPadded.zeros(outputRows, outputCols);
     inputPadded.submat(filter.n_rows - 1, filter.n_cols - 1,
           filter.n_rows - 1 + input.n_rows - 1,
           filter.n_cols - 1 + input.n_cols - 1) = input;
 
-    arma::Mat<eT> filterPadded = filter;
-    filterPadded.resize(outputRows, outputCols);
+    filterPadded.zeros(outputRows, outputCols);
+    filterPadded.submat(0, 0, filter.n_rows - 1, filter.n_cols - 1) = filter;
 
     // Perform FFT and IFFT
-    arma::Mat<eT> temp = arma::real(ifft2(arma::fft2(inputPadded) % arma::fft2(
+    temp = arma::real(ifft2(arma::fft2(inputPadded) % arma::fft2(
         filterPadded)));
 
     // Extract the region of interest. We don't need to handle the padLastDim
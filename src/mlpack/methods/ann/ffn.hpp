@@ -17,11 +17,14 @@
 
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
+#include "visitor/freeze_visitor.hpp"
 #include "visitor/output_height_visitor.hpp"
 #include "visitor/output_parameter_visitor.hpp"
 #include "visitor/output_width_visitor.hpp"
 #include "visitor/reset_visitor.hpp"
 #include "visitor/weight_size_visitor.hpp"
+#include "visitor/workspace_set_visitor.hpp"
+#include "visitor/workspace_size_visitor.hpp"
 #include "visitor/copy_visitor.hpp"
 #include "visitor/loss_visitor.hpp"
 
@@ -168,13 +171,31 @@ class FFN
    * reflect the output of the given output layer as returned by the
    * output layer function.
    *
+   * The predictors are passed through the network in batches; consecutive
+   * batches of the same size reuse the layer output buffers, so no per-point
+   * temporaries are allocated.
+   *
    * If you want to pass in a parameter and discard the original parameter
    * object, be sure to use std::move to avoid unnecessary copy.
    *
    * @param predictors Input predictors.
    * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Number of points to predict at a time.
+   */
+  void Predict(arma::mat predictors,
+               arma::mat& results,
+               const size_t batchSize = 128);
+
+  /**
+   * Prepare the network for inference only.  The network is put into
+   * deterministic mode and the state that is only needed for the backward
+   * pass---the per-layer delta and gradient buffers and any retained training
+   * data---is released, roughly halving the memory held by the network.  Only
+   * the forward-pass functions (Predict(), Forward() and Evaluate()) should
+   * be called afterwards; calling Train() again is safe and rebuilds the
+   * released state on demand.
    */
-  void Predict(arma::mat predictors, arma::mat& results);
+  void Freeze();
 
   /**
    * Evaluate the feedforward network with the given predictors and responses.
@@ -324,6 +345,25 @@ class FFN
   //! Modify the matrix of data points (predictors).
   arma::mat& Predictors() { return predictors; }
 
+  //! Get the number of threads used to evaluate a minibatch gradient during
+  //! training.
+  size_t TrainingThreads() const { return trainingThreads; }
+  //! Modify the number of threads used to evaluate a minibatch gradient during
+  //! training.  If this is greater than one, each minibatch is split across an
+  //! OpenMP team: every extra thread works on its own replica of the layer
+  //! state and the thread gradients are reduced before the optimizer step.
+  //! Only useful for losses that sum over the batch (e.g.
+  //! NegativeLogLikelihood); no effect if mlpack is built without OpenMP.
+  size_t& TrainingThreads() { return trainingThreads; }
+
+  //! Return the current size (in elements) of the contiguous workspace block
+  //! that backs the layer output and delta buffers.
+  size_t WorkspaceSize() const { return workspace.n_elem; }
+
+  //! Return the high-water mark (in elements) of the layer workspace over all
+  //! training and inference passes so far.
+  size_t WorkspacePeak() const { return workspacePeak; }
+
   /**
    * Reset the module infomration (weights/parameters).
    */
@@ -426,6 +466,28 @@ class FFN
    */
   void ResetGradients(arma::mat& gradient);
 
+  /**
+   * Gather the output and delta buffers of all layers into one contiguous
+   * workspace block and update the workspace high-water mark.  The buffer
+   * shapes only become known during the forward and backward passes, so this
+   * is called after a pass rather than at ResetParameters() time.  The shape
+   * and contents of every buffer are preserved; a buffer that a layer resizes
+   * afterwards (e.g. for a different batch size) falls back to its own memory
+   * until the workspace is rebuilt.  Does nothing if the total buffer size is
+   * unchanged.
+   */
+  void ResetWorkspace();
+
+  /**
+   * Rebuild the layer state replicas used for data-parallel minibatch
+   * training.  Each replica copies the network modules and aliases its
+   * weights into its own parameter matrix, like the serialization loading
+   * path does.
+   *
+   * @param count The number of replicas to build.
+   */
+  void ResetReplicas(const size_t count);
+
   /**
    * Swap the content of this network with given network.
    *
@@ -506,6 +568,20 @@ class FFN
   //! Locally-stored gradient parameter.
   arma::mat gradient;
 
+  //! The contiguous block backing the layer output and delta buffers (see
+  //! ResetWorkspace()).
+  arma::mat workspace;
+
+  //! The high-water mark (in elements) of the layer workspace.
+  size_t workspacePeak;
+
+  //! The number of threads used to evaluate a minibatch gradient.
+  size_t trainingThreads;
+
+  //! The layer state replicas used for data-parallel minibatch training;
+  //! thread t > 0 works on replicas[t - 1], thread 0 works on this network.
+  std::vector<FFN*> replicas;
+
   //! Locally-stored copy visitor
   CopyVisitor<CustomLayers...> copyVisitor;
 
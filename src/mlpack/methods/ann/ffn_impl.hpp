@@ -39,7 +39,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(false)
+    deterministic(false),
+    workspacePeak(0),
+    trainingThreads(1)
 {
   /* Nothing to do here. */
 }
@@ -48,6 +50,9 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::~FFN()
 {
+  for (size_t i = 0; i < replicas.size(); ++i)
+    delete replicas[i];
+
   std::for_each(network.begin(), network.end(),
       boost::apply_visitor(deleteVisitor));
 }
@@ -221,7 +226,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
-    arma::mat predictors, arma::mat& results)
+    arma::mat predictors, arma::mat& results, const size_t batchSize)
 {
   CheckInputShape<std::vector<LayerTypes<CustomLayers...> > >(
       network, predictors.n_rows, "FFN<>::Predict()");
@@ -235,24 +240,60 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
     ResetDeterministic();
   }
 
-  arma::mat resultsTemp;
-  Forward(arma::mat(predictors.colptr(0), predictors.n_rows, 1, false, true));
-  resultsTemp = boost::apply_visitor(outputParameterVisitor,
-      network.back()).col(0);
-
-  results = arma::mat(resultsTemp.n_elem, predictors.n_cols);
-  results.col(0) = resultsTemp.col(0);
-
-  for (size_t i = 1; i < predictors.n_cols; ++i)
+  // Pass the data through the network in batches; since every batch except
+  // possibly the last has the same size, the layer output buffers keep their
+  // shape and are reused across batches.
+  for (size_t begin = 0; begin < predictors.n_cols; begin += batchSize)
   {
-    Forward(arma::mat(predictors.colptr(i), predictors.n_rows, 1, false, true));
+    const size_t effectiveBatchSize = std::min(batchSize,
+        predictors.n_cols - begin);
 
-    resultsTemp = boost::apply_visitor(outputParameterVisitor,
+    Forward(arma::mat(predictors.colptr(begin), predictors.n_rows,
+        effectiveBatchSize, false, true));
+    const arma::mat& output = boost::apply_visitor(outputParameterVisitor,
         network.back());
-    results.col(i) = resultsTemp.col(0);
+
+    // The output dimensionality and the layer buffer shapes are only known
+    // after the first forward pass.
+    if (begin == 0)
+    {
+      ResetWorkspace();
+      results.set_size(output.n_rows, predictors.n_cols);
+    }
+
+    results.cols(begin, begin + effectiveBatchSize - 1) = output;
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Freeze()
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  // Inference is always deterministic.
+  deterministic = true;
+  ResetDeterministic();
+
+  // Release the backward-pass state of every layer; it is rebuilt on demand
+  // if the network is trained again afterwards.
+  FreezeVisitor freezeVisitor;
+  std::for_each(network.begin(), network.end(),
+      boost::apply_visitor(freezeVisitor));
+
+  // Neither the retained training data nor the error of the last backward
+  // pass are needed for inference.
+  predictors.clear();
+  responses.clear();
+  error.clear();
+  numFunctions = 0;
+
+  // The delta buffers are gone; shrink the workspace to what the forward
+  // pass needs.
+  ResetWorkspace();
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -374,6 +415,74 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
+  // Split the minibatch across the thread team if data-parallel training is
+  // enabled; each thread needs at least two points for this to pay off.
+  if (trainingThreads > 1 && batchSize >= 2 * trainingThreads)
+  {
+    const size_t threads = trainingThreads;
+    if (replicas.size() != threads - 1)
+      ResetReplicas(threads - 1);
+
+    // Broadcast the current weights to every replica.
+    for (size_t t = 0; t < replicas.size(); ++t)
+      replicas[t]->parameter = parameter;
+
+    const size_t chunkSize = (batchSize + threads - 1) / threads;
+    std::vector<arma::mat> threadGradients(threads);
+    double res = 0;
+
+    #pragma omp parallel for reduction(+:res) num_threads(threads)
+    for (omp_size_t t = 0; t < (omp_size_t) threads; ++t)
+    {
+      const size_t chunkBegin = begin + t * chunkSize;
+      if (chunkBegin >= begin + batchSize)
+        continue;
+      const size_t chunkCols = std::min(chunkSize,
+          begin + batchSize - chunkBegin);
+
+      FFN* model = (t == 0) ? this : replicas[t - 1];
+      const arma::mat chunkPredictors(predictors.colptr(chunkBegin),
+          predictors.n_rows, chunkCols, false, true);
+      const arma::mat chunkResponses(responses.colptr(chunkBegin),
+          responses.n_rows, chunkCols, false, true);
+
+      threadGradients[t] = arma::zeros<arma::mat>(parameter.n_rows,
+          parameter.n_cols);
+
+      model->Forward(chunkPredictors);
+      res += model->outputLayer.Forward(boost::apply_visitor(
+          outputParameterVisitor, model->network.back()), chunkResponses);
+
+      for (size_t i = 0; i < model->network.size(); ++i)
+        res += boost::apply_visitor(lossVisitor, model->network[i]);
+
+      model->outputLayer.Backward(boost::apply_visitor(
+          outputParameterVisitor, model->network.back()), chunkResponses,
+          model->error);
+
+      model->Backward();
+      model->ResetGradients(threadGradients[t]);
+      model->Gradient(chunkPredictors);
+    }
+
+    // Tree-reduce the thread gradients before the optimizer step.
+    for (size_t stride = 1; stride < threads; stride *= 2)
+    {
+      #pragma omp parallel for
+      for (omp_size_t t = 0; t < (omp_size_t) (threads - stride);
+          t += (omp_size_t) (2 * stride))
+      {
+        if (!threadGradients[t + stride].is_empty())
+          threadGradients[t] += threadGradients[t + stride];
+      }
+    }
+    gradient = threadGradients[0];
+
+    ResetWorkspace();
+
+    return res;
+  }
+
   Forward(predictors.cols(begin, begin + batchSize - 1));
   double res = outputLayer.Forward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
@@ -393,6 +502,10 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   ResetGradients(gradient);
   Gradient(predictors.cols(begin, begin + batchSize - 1));
 
+  // Every layer buffer now has the shape of this batch; keep the buffers in
+  // one contiguous workspace (a no-op unless a shape changed).
+  ResetWorkspace();
+
   return res;
 }
 
@@ -421,12 +534,56 @@ void FFN<OutputLayerType, InitializationRuleType,
 {
   ResetDeterministic();
 
+  // The network structure or weights may have changed, so any layer state
+  // replicas are stale; they are rebuilt on demand.
+  ResetReplicas(0);
+
   // Reset the network parameter with the given initialization rule.
   NetworkInitialization<InitializationRuleType,
                         CustomLayers...> networkInit(initializeRule);
   networkInit.Initialize(network, parameter);
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetReplicas(const size_t count)
+{
+  for (size_t i = 0; i < replicas.size(); ++i)
+    delete replicas[i];
+  replicas.clear();
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    FFN* replica = new FFN(outputLayer, initializeRule);
+    replica->width = width;
+    replica->height = height;
+    replica->reset = reset;
+    replica->parameter = parameter;
+    replica->deterministic = deterministic;
+
+    for (size_t j = 0; j < network.size(); ++j)
+    {
+      replica->network.push_back(boost::apply_visitor(copyVisitor,
+          network[j]));
+    }
+
+    // Alias the replica weights into its own parameter matrix, like the
+    // serialization loading path does.
+    size_t offset = 0;
+    for (size_t j = 0; j < replica->network.size(); ++j)
+    {
+      offset += boost::apply_visitor(WeightSetVisitor(replica->parameter,
+          offset), replica->network[j]);
+
+      boost::apply_visitor(resetVisitor, replica->network[j]);
+    }
+
+    replica->ResetDeterministic();
+    replicas.push_back(replica);
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType,
@@ -450,6 +607,40 @@ void FFN<OutputLayerType, InitializationRuleType,
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetWorkspace()
+{
+  size_t totalSize = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+    totalSize += boost::apply_visitor(WorkspaceSizeVisitor(), network[i]);
+
+  // The buffers are already backed by the workspace unless their total size
+  // changed.
+  if (totalSize == workspace.n_elem)
+    return;
+
+  // The buffers may alias the current workspace, so it has to stay alive
+  // until their contents have been moved into the new block.
+  arma::mat newWorkspace(totalSize, 1);
+  size_t offset = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    offset += boost::apply_visitor(WorkspaceSetVisitor(newWorkspace, offset),
+        network[i]);
+  }
+  workspace = std::move(newWorkspace);
+
+  if (workspace.n_elem > workspacePeak)
+  {
+    workspacePeak = workspace.n_elem;
+    Log::Info << "FFN::ResetWorkspace(): layer workspace high-water mark is "
+        << workspacePeak << " elements ("
+        << workspacePeak * sizeof(double) << " bytes)." << std::endl;
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename InputType>
@@ -607,6 +798,10 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(inputParameter, network.inputParameter);
   std::swap(outputParameter, network.outputParameter);
   std::swap(gradient, network.gradient);
+  std::swap(workspace, network.workspace);
+  std::swap(workspacePeak, network.workspacePeak);
+  std::swap(trainingThreads, network.trainingThreads);
+  std::swap(replicas, network.replicas);
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -627,9 +822,13 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
-    gradient(network.gradient)
+    gradient(network.gradient),
+    workspacePeak(network.workspacePeak),
+    trainingThreads(network.trainingThreads)
 {
-  // Build new layers according to source network
+  // Build new layers according to source network; their buffers are gathered
+  // into a new workspace, and any layer state replicas are rebuilt, on the
+  // first pass.
   for (size_t i = 0; i < network.network.size(); ++i)
   {
     this->network.push_back(boost::apply_visitor(copyVisitor,
@@ -656,9 +855,14 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
-    gradient(std::move(network.gradient))
+    gradient(std::move(network.gradient)),
+    workspace(std::move(network.workspace)),
+    workspacePeak(network.workspacePeak),
+    trainingThreads(network.trainingThreads),
+    replicas(std::move(network.replicas))
 {
   this->network = std::move(network.network);
+  network.replicas.clear();
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
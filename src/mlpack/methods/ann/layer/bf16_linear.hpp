@@ -0,0 +1,163 @@
+/**
+ * @file methods/ann/layer/bf16_linear.hpp
+ *
+ * Definition of the Bf16Linear layer class, a bfloat16-storage inference-only
+ * variant of the Linear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_BF16_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_BF16_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the Bf16Linear layer class, an inference-only variant of
+ * the Linear layer that stores its weights in bfloat16 (the upper sixteen
+ * bits of an IEEE single-precision float, rounded to nearest even).  This
+ * halves the weight storage and memory traffic compared to single precision
+ * while keeping the full float32 exponent range, so—unlike the int8
+ * QuantizedLinear layer—no per-channel scales are needed and the accuracy
+ * loss is limited to dropping sixteen mantissa bits.
+ *
+ * During the forward pass, row panels of the weight matrix are expanded into
+ * a small reusable single-precision buffer and multiplied with the input by
+ * the ordinary (vectorized) float GEMM, so accumulation happens in float32
+ * and the dominant memory traffic is the 16-bit weight reads: the expanded
+ * panel stays cache-resident across the multiply.
+ *
+ * The layer holds no trainable parameters and does not implement Backward()
+ * or Gradient(); like QuantizedLinear, it is meant to be built from a trained
+ * Linear layer at model conversion time, and is the option of choice for
+ * layers that cannot tolerate full int8 quantization:
+ *
+ * @code
+ * // model is a trained FFN with a Linear<> layer at position 0.
+ * Bf16Linear<> converted(linearLayer.Weight(), linearLayer.Bias());
+ * @endcode
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class Bf16Linear
+{
+ public:
+  //! Create the Bf16Linear object.
+  Bf16Linear();
+
+  /**
+   * Create the Bf16Linear layer from trained floating-point weights.
+   *
+   * @param weight The trained weight matrix (outSize x inSize).
+   * @param bias The trained bias vector (outSize x 1).
+   */
+  Bf16Linear(const arma::mat& weight, const arma::mat& bias);
+
+  /**
+   * Convert the given trained weights into the bfloat16 representation,
+   * rounding each weight to the nearest bfloat16 value (ties to even).  The
+   * bias is kept in floating point.
+   *
+   * @param weight The trained weight matrix (outSize x inSize).
+   * @param bias The trained bias vector (outSize x 1).
+   */
+  void Convert(const arma::mat& weight, const arma::mat& bias);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.  Row panels of the
+   * bfloat16 weights are expanded to float32 and multiplied with the input
+   * using float32 accumulation.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  //! Get the input parameter.
+  InputDataType const& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the bfloat16 weight matrix (as the raw 16-bit patterns).
+  arma::Mat<arma::u16> const& Bf16Weight() const { return bf16Weight; }
+
+  //! Get the bias of the layer.
+  arma::vec const& Bias() const { return bias; }
+
+  //! Get the input size.
+  size_t InputSize() const { return inSize; }
+
+  //! Get the output size.
+  size_t OutputSize() const { return outSize; }
+
+  //! Get the shape of the input.
+  size_t InputShape() const
+  {
+    return inSize;
+  }
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Round a single-precision value to the nearest bfloat16 bit pattern
+  //! (ties to even).
+  static arma::u16 FloatToBf16(const float value);
+
+  //! Expand a bfloat16 bit pattern back to single precision.
+  static float Bf16ToFloat(const arma::u16 value);
+
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored bfloat16 weight matrix (outSize x inSize).
+  arma::Mat<arma::u16> bf16Weight;
+
+  //! Locally-stored bias term parameters (kept in floating point).
+  arma::vec bias;
+
+  //! Reusable single-precision panel the weights are expanded into.
+  arma::fmat panel;
+
+  //! Reusable single-precision output buffer.
+  arma::fmat floatOutput;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class Bf16Linear
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "bf16_linear_impl.hpp"
+
+#endif
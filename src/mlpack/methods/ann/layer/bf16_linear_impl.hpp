@@ -0,0 +1,138 @@
+/**
+ * @file methods/ann/layer/bf16_linear_impl.hpp
+ *
+ * Implementation of the Bf16Linear layer class, a bfloat16-storage
+ * inference-only variant of the Linear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_BF16_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_BF16_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "bf16_linear.hpp"
+
+#include <cstring>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+Bf16Linear<InputDataType, OutputDataType>::Bf16Linear() :
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+Bf16Linear<InputDataType, OutputDataType>::Bf16Linear(
+    const arma::mat& weight,
+    const arma::mat& bias) :
+    inSize(0),
+    outSize(0)
+{
+  Convert(weight, bias);
+}
+
+template<typename InputDataType, typename OutputDataType>
+arma::u16 Bf16Linear<InputDataType, OutputDataType>::FloatToBf16(
+    const float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  // Round to the nearest bfloat16 value, breaking ties towards the value
+  // with an even (zero) last mantissa bit.  NaNs are unaffected because the
+  // carry cannot propagate out of an all-ones exponent's mantissa without
+  // leaving the payload nonzero.
+  bits += 0x7FFFu + ((bits >> 16) & 1u);
+  return (arma::u16) (bits >> 16);
+}
+
+template<typename InputDataType, typename OutputDataType>
+float Bf16Linear<InputDataType, OutputDataType>::Bf16ToFloat(
+    const arma::u16 value)
+{
+  const uint32_t bits = ((uint32_t) value) << 16;
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+template<typename InputDataType, typename OutputDataType>
+void Bf16Linear<InputDataType, OutputDataType>::Convert(
+    const arma::mat& weight,
+    const arma::mat& bias)
+{
+  if (weight.n_rows != bias.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "Bf16Linear::Convert(): weight matrix has " << weight.n_rows
+        << " rows, but bias has " << bias.n_elem << " elements!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  inSize = weight.n_cols;
+  outSize = weight.n_rows;
+
+  bf16Weight.set_size(outSize, inSize);
+  for (size_t k = 0; k < inSize; ++k)
+    for (size_t r = 0; r < outSize; ++r)
+      bf16Weight(r, k) = FloatToBf16((float) weight(r, k));
+
+  this->bias = arma::vectorise(bias);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void Bf16Linear<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input,
+    arma::Mat<eT>& output)
+{
+  // Accumulation happens in single precision, so convert the input once up
+  // front.
+  const arma::fmat floatInput = arma::conv_to<arma::fmat>::from(input);
+  floatOutput.set_size(outSize, input.n_cols);
+
+  // Expand row panels of the bfloat16 weights into a small reusable float
+  // buffer and multiply each panel with the full input using the ordinary
+  // (vectorized) float GEMM.  The panel stays cache-resident across its
+  // multiply, so the dominant weight traffic is the 16-bit reads.
+  const size_t panelRows = 32;
+  for (size_t r = 0; r < outSize; r += panelRows)
+  {
+    const size_t rows = std::min(panelRows, outSize - r);
+    panel.set_size(rows, inSize);
+    for (size_t k = 0; k < inSize; ++k)
+    {
+      const arma::u16* weightCol = bf16Weight.colptr(k);
+      float* panelCol = panel.colptr(k);
+      for (size_t i = 0; i < rows; ++i)
+        panelCol[i] = Bf16ToFloat(weightCol[r + i]);
+    }
+
+    floatOutput.rows(r, r + rows - 1) = panel * floatInput;
+  }
+
+  floatOutput.each_col() += arma::conv_to<arma::fvec>::from(bias);
+  output = arma::conv_to<arma::Mat<eT> >::from(floatOutput);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void Bf16Linear<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(bf16Weight));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
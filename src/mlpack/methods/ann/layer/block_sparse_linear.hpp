@@ -0,0 +1,203 @@
+/**
+ * @file methods/ann/layer/block_sparse_linear.hpp
+ *
+ * Definition of the BlockSparseLinear layer class, a block-sparse
+ * inference-only variant of the Linear layer for structurally pruned models.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_BLOCK_SPARSE_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_BLOCK_SPARSE_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the BlockSparseLinear layer class, an inference-only
+ * variant of the Linear layer for weight matrices that have been structurally
+ * pruned: the weight matrix is tiled into square blocks, only the nonzero
+ * blocks are stored, and the forward pass multiplies only those blocks.  A
+ * dense GEMM gains nothing from zeros, so on a model pruned to high block
+ * sparsity this converts the zeroed weights into a proportional reduction in
+ * both multiply work and weight memory traffic, while each surviving block is
+ * still multiplied by the ordinary (vectorized) dense kernel.
+ *
+ * The static Prune() pass performs the structured pruning itself, zeroing
+ * every block whose Frobenius norm falls below a threshold; the layer is then
+ * built from the pruned weights at model conversion time, like the
+ * QuantizedLinear and Bf16Linear layers:
+ *
+ * @code
+ * // model is a trained FFN with a Linear<> layer; weight is its weight
+ * // matrix and bias its bias.
+ * BlockSparseLinear<>::Prune(weight, 16, threshold);
+ * BlockSparseLinear<> converted(weight, bias, 16);
+ * @endcode
+ *
+ * The layer holds no trainable parameters and does not implement Backward()
+ * or Gradient().  Blocks at the right and bottom edges of a weight matrix
+ * whose dimensions are not multiples of the block size are simply smaller;
+ * they are pruned and stored like any other block.
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class BlockSparseLinear
+{
+ public:
+  //! Create the BlockSparseLinear object.
+  BlockSparseLinear();
+
+  /**
+   * Create the BlockSparseLinear layer from trained (and typically pruned)
+   * floating-point weights.
+   *
+   * @param weight The trained weight matrix (outSize x inSize).
+   * @param bias The trained bias vector (outSize x 1).
+   * @param blockSize Side length of the square weight blocks.
+   */
+  BlockSparseLinear(const arma::mat& weight,
+                    const arma::mat& bias,
+                    const size_t blockSize);
+
+  /**
+   * Structured pruning pass: zero every blockSize x blockSize block of the
+   * given weight matrix whose Frobenius norm is below the given threshold.
+   * The weights are modified in place, so the pruned model can be fine-tuned
+   * or evaluated densely before conversion.
+   *
+   * @param weight The weight matrix to prune (modified in place).
+   * @param blockSize Side length of the square weight blocks.
+   * @param threshold Blocks with Frobenius norm below this are zeroed.
+   * @return The number of blocks that were zeroed.
+   */
+  static size_t Prune(arma::mat& weight,
+                      const size_t blockSize,
+                      const double threshold);
+
+  /**
+   * Store the nonzero blocks of the given trained weights.  Blocks that are
+   * exactly zero (as produced by Prune()) are dropped.
+   *
+   * @param weight The trained weight matrix (outSize x inSize).
+   * @param bias The trained bias vector (outSize x 1).
+   * @param blockSize Side length of the square weight blocks.
+   */
+  void Convert(const arma::mat& weight,
+               const arma::mat& bias,
+               const size_t blockSize);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.  Only the stored
+   * (nonzero) weight blocks are multiplied; empty blocks are skipped
+   * entirely.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  //! Get the input parameter.
+  InputDataType const& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the bias of the layer.
+  arma::vec const& Bias() const { return bias; }
+
+  //! Get the side length of the square weight blocks.
+  size_t BlockSize() const { return blockSize; }
+
+  //! Get the number of stored (nonzero) weight blocks.
+  size_t NumNonzeroBlocks() const { return blocks.size(); }
+
+  //! Get the total number of blocks the weight matrix is tiled into.
+  size_t NumBlocks() const { return numBlockRows * numBlockCols; }
+
+  //! Get the fraction of blocks that are empty (and therefore skipped).
+  double BlockSparsity() const
+  {
+    return (NumBlocks() == 0) ? 0.0 :
+        1.0 - ((double) blocks.size() / (double) NumBlocks());
+  }
+
+  //! Get the input size.
+  size_t InputSize() const { return inSize; }
+
+  //! Get the output size.
+  size_t OutputSize() const { return outSize; }
+
+  //! Get the shape of the input.
+  size_t InputShape() const
+  {
+    return inSize;
+  }
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Side length of the square weight blocks.
+  size_t blockSize;
+
+  //! Number of block rows the weight matrix is tiled into.
+  size_t numBlockRows;
+
+  //! Number of block columns the weight matrix is tiled into.
+  size_t numBlockCols;
+
+  //! Offsets into blockRows/blocks for each block column (CSC-style, length
+  //! numBlockCols + 1), so all blocks touching one input panel are multiplied
+  //! while that panel is cache-resident.
+  std::vector<size_t> colOffsets;
+
+  //! Block row index of each stored block, grouped by block column.
+  std::vector<size_t> blockRows;
+
+  //! The stored (nonzero) weight blocks, grouped by block column.
+  std::vector<arma::mat> blocks;
+
+  //! Locally-stored bias term parameters.
+  arma::vec bias;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class BlockSparseLinear
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "block_sparse_linear_impl.hpp"
+
+#endif
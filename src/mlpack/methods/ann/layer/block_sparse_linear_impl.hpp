@@ -0,0 +1,177 @@
+/**
+ * @file methods/ann/layer/block_sparse_linear_impl.hpp
+ *
+ * Implementation of the BlockSparseLinear layer class, a block-sparse
+ * inference-only variant of the Linear layer for structurally pruned models.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_BLOCK_SPARSE_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_BLOCK_SPARSE_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "block_sparse_linear.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+BlockSparseLinear<InputDataType, OutputDataType>::BlockSparseLinear() :
+    inSize(0),
+    outSize(0),
+    blockSize(0),
+    numBlockRows(0),
+    numBlockCols(0)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+BlockSparseLinear<InputDataType, OutputDataType>::BlockSparseLinear(
+    const arma::mat& weight,
+    const arma::mat& bias,
+    const size_t blockSize) :
+    inSize(0),
+    outSize(0),
+    blockSize(0),
+    numBlockRows(0),
+    numBlockCols(0)
+{
+  Convert(weight, bias, blockSize);
+}
+
+template<typename InputDataType, typename OutputDataType>
+size_t BlockSparseLinear<InputDataType, OutputDataType>::Prune(
+    arma::mat& weight,
+    const size_t blockSize,
+    const double threshold)
+{
+  if (blockSize == 0)
+    throw std::invalid_argument("BlockSparseLinear::Prune(): block size must "
+        "be greater than 0!");
+
+  size_t numPruned = 0;
+  for (size_t c = 0; c < weight.n_cols; c += blockSize)
+  {
+    const size_t cols = std::min(blockSize, (size_t) weight.n_cols - c);
+    for (size_t r = 0; r < weight.n_rows; r += blockSize)
+    {
+      const size_t rows = std::min(blockSize, (size_t) weight.n_rows - r);
+      if (arma::norm(weight.submat(r, c, r + rows - 1, c + cols - 1), "fro") <
+          threshold)
+      {
+        weight.submat(r, c, r + rows - 1, c + cols - 1).zeros();
+        ++numPruned;
+      }
+    }
+  }
+
+  return numPruned;
+}
+
+template<typename InputDataType, typename OutputDataType>
+void BlockSparseLinear<InputDataType, OutputDataType>::Convert(
+    const arma::mat& weight,
+    const arma::mat& bias,
+    const size_t blockSize)
+{
+  if (blockSize == 0)
+  {
+    throw std::invalid_argument("BlockSparseLinear::Convert(): block size "
+        "must be greater than 0!");
+  }
+
+  if (weight.n_rows != bias.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "BlockSparseLinear::Convert(): weight matrix has " << weight.n_rows
+        << " rows, but bias has " << bias.n_elem << " elements!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  inSize = weight.n_cols;
+  outSize = weight.n_rows;
+  this->blockSize = blockSize;
+  numBlockRows = (outSize + blockSize - 1) / blockSize;
+  numBlockCols = (inSize + blockSize - 1) / blockSize;
+
+  colOffsets.assign(numBlockCols + 1, 0);
+  blockRows.clear();
+  blocks.clear();
+
+  // Store the nonzero blocks grouped by block column, so the forward pass
+  // reuses each input panel across all blocks touching it.
+  for (size_t bc = 0; bc < numBlockCols; ++bc)
+  {
+    const size_t c = bc * blockSize;
+    const size_t cols = std::min(blockSize, inSize - c);
+    for (size_t br = 0; br < numBlockRows; ++br)
+    {
+      const size_t r = br * blockSize;
+      const size_t rows = std::min(blockSize, outSize - r);
+      const arma::mat block = weight.submat(r, c, r + rows - 1, c + cols - 1);
+      if (!block.is_zero())
+      {
+        blockRows.push_back(br);
+        blocks.push_back(block);
+      }
+    }
+    colOffsets[bc + 1] = blocks.size();
+  }
+
+  this->bias = arma::vectorise(bias);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void BlockSparseLinear<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input,
+    arma::Mat<eT>& output)
+{
+  output.zeros(outSize, input.n_cols);
+
+  // Multiply only the stored blocks; block columns with no surviving blocks
+  // never touch their input panel at all.
+  for (size_t bc = 0; bc < numBlockCols; ++bc)
+  {
+    if (colOffsets[bc] == colOffsets[bc + 1])
+      continue;
+
+    const size_t c = bc * blockSize;
+    const size_t cols = std::min(blockSize, inSize - c);
+    const arma::Mat<eT> inputPanel = input.rows(c, c + cols - 1);
+
+    for (size_t i = colOffsets[bc]; i < colOffsets[bc + 1]; ++i)
+    {
+      const size_t r = blockRows[i] * blockSize;
+      output.rows(r, r + blocks[i].n_rows - 1) +=
+          arma::conv_to<arma::Mat<eT>>::from(blocks[i]) * inputPanel;
+    }
+  }
+
+  output.each_col() += arma::conv_to<arma::Col<eT>>::from(bias);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void BlockSparseLinear<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(blockSize));
+  ar(CEREAL_NVP(numBlockRows));
+  ar(CEREAL_NVP(numBlockCols));
+  ar(CEREAL_NVP(colOffsets));
+  ar(CEREAL_NVP(blockRows));
+  ar(CEREAL_NVP(blocks));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
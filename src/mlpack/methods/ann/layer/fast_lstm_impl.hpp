@@ -198,44 +198,42 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
       forwardStep, forwardStep + batchStep);
   gate.cols(forwardStep, forwardStep + batchStep).each_col() += input2GateBias;
 
-  arma::subview<double> sigmoidOut = gateActivation.cols(forwardStep,
-      forwardStep + batchStep);
-  FastSigmoid(
-      gate.submat(0, forwardStep, 3 * outSize - 1, forwardStep + batchStep),
-      sigmoidOut);
-
-  stateActivation.cols(forwardStep, forwardStep + batchStep) = arma::tanh(
-      gate.submat(3 * outSize, forwardStep, 4 * outSize - 1,
-      forwardStep + batchStep));
-
-  // Update the cell: cmul1 + cmul2
-  // where cmul1 is input gate * hidden state and
+  // Apply the gate activations and update the cell and the output in one
+  // in-place pass over the batch, instead of one temporary per gate:
+  // the cell is cmul1 + cmul2, where cmul1 is input gate * hidden state and
   // cmul2 is forget gate * cell (prevCell).
-  if (forwardStep == 0)
+  for (size_t offset = forwardStep; offset <= forwardStep + batchStep; ++offset)
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep);
+    const ElemType* gatePtr = gate.colptr(offset);
+    ElemType* gateActivationPtr = gateActivation.colptr(offset);
+    ElemType* stateActivationPtr = stateActivation.colptr(offset);
+    ElemType* cellPtr = cell.colptr(offset);
+    const ElemType* prevCellPtr = (forwardStep > 0) ?
+        cell.colptr(offset - batchSize) : NULL;
+    ElemType* cellActivationPtr = cellActivation.colptr(offset);
+    ElemType* outPtr = outParameter.colptr(offset + batchSize);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      const ElemType inputGate = FastSigmoid(gatePtr[i]);
+      const ElemType outputGate = FastSigmoid(gatePtr[i + outSize]);
+      const ElemType forgetGate = FastSigmoid(gatePtr[i + 2 * outSize]);
+      const ElemType state = std::tanh(gatePtr[i + 3 * outSize]);
+
+      gateActivationPtr[i] = inputGate;
+      gateActivationPtr[i + outSize] = outputGate;
+      gateActivationPtr[i + 2 * outSize] = forgetGate;
+      stateActivationPtr[i] = state;
+
+      const ElemType cellValue = (prevCellPtr == NULL) ?
+          inputGate * state : inputGate * state + forgetGate * prevCellPtr[i];
+      cellPtr[i] = cellValue;
+
+      const ElemType cellActivationValue = std::tanh(cellValue);
+      cellActivationPtr[i] = cellActivationValue;
+      outPtr[i] = cellActivationValue * outputGate;
+    }
   }
-  else
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep) +
-        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
-        forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
-  }
-
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
-
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) = cellActivation.cols(
-      forwardStep, forwardStep + batchStep) % gateActivation.submat(
-      outSize, forwardStep, 2 * outSize - 1, forwardStep + batchStep);
 
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
@@ -0,0 +1,153 @@
+/**
+ * @file methods/ann/layer/fused_elementwise.hpp
+ *
+ * Definition of the FusedElementwise layer class, a composite layer that
+ * applies a chain of elementwise operations in a single pass over the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FUSED_ELEMENTWISE_HPP
+#define MLPACK_METHODS_ANN_LAYER_FUSED_ELEMENTWISE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the FusedElementwise layer class, an inference-only
+ * composite layer that replaces a chain of elementwise layers with one pass
+ * over the activations.  Each output element is computed as
+ *
+ *   f(x_d) = max(scale_d * x_d + shift_d, 0)       (ReLU enabled)
+ *   f(x_d) = scale_d * x_d + shift_d               (ReLU disabled)
+ *
+ * where d indexes the input dimension, so a BatchNorm -> ReLULayer ->
+ * Dropout segment (in deterministic mode a batch normalization is exactly a
+ * per-dimension affine transform and a dropout is the identity) reads and
+ * writes each activation once instead of three times.
+ *
+ * Use FromBatchNorm() to build the fused layer from a trained BatchNorm
+ * layer at model conversion time:
+ *
+ * @code
+ * // bn is a trained BatchNorm<> layer followed by a ReLU and a Dropout.
+ * FusedElementwise<> fused = FusedElementwise<>::FromBatchNorm(bn, true);
+ * @endcode
+ *
+ * Like QuantizedLinear, this layer is meant for inference: it does not
+ * implement Backward() or Gradient(), and it never updates running
+ * statistics.
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class FusedElementwise
+{
+ public:
+  //! Create the FusedElementwise object.
+  FusedElementwise();
+
+  /**
+   * Create the FusedElementwise layer from a per-dimension affine transform
+   * and an optional trailing ReLU.
+   *
+   * @param scale Per-dimension multiplicative factors.
+   * @param shift Per-dimension additive terms; must match scale in length.
+   * @param applyReLU Whether to clamp negative results to zero.
+   */
+  FusedElementwise(const arma::vec& scale,
+                   const arma::vec& shift,
+                   const bool applyReLU);
+
+  /**
+   * Build a FusedElementwise layer from a trained BatchNorm layer, folding
+   * its deterministic-mode normalization (using the running mean and
+   * variance) and its gamma/beta parameters into one affine transform.  A
+   * Dropout layer following the chain needs no folding: in deterministic
+   * mode it is the identity.
+   *
+   * @param batchNorm The trained BatchNorm layer to fold.
+   * @param applyReLU Whether the chain contains a trailing ReLU.
+   */
+  template<typename BatchNormType>
+  static FusedElementwise FromBatchNorm(const BatchNormType& batchNorm,
+                                        const bool applyReLU);
+
+  /**
+   * Ordinary feed forward pass of a neural network; applies the fused
+   * affine transform and optional ReLU in a single pass over the input.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  //! Get the input parameter.
+  InputDataType const& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the per-dimension multiplicative factors.
+  arma::vec const& Scale() const { return scale; }
+
+  //! Get the per-dimension additive terms.
+  arma::vec const& Shift() const { return shift; }
+
+  //! Get whether a ReLU is applied after the affine transform.
+  bool ApplyReLU() const { return applyReLU; }
+
+  //! Get the input size.
+  size_t InputSize() const { return scale.n_elem; }
+
+  //! Get the shape of the input.
+  size_t InputShape() const
+  {
+    return scale.n_elem;
+  }
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored per-dimension multiplicative factors.
+  arma::vec scale;
+
+  //! Locally-stored per-dimension additive terms.
+  arma::vec shift;
+
+  //! Whether negative results are clamped to zero.
+  bool applyReLU;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class FusedElementwise
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "fused_elementwise_impl.hpp"
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file methods/ann/layer/fused_elementwise_impl.hpp
+ *
+ * Implementation of the FusedElementwise layer class, a composite layer that
+ * applies a chain of elementwise operations in a single pass over the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FUSED_ELEMENTWISE_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_FUSED_ELEMENTWISE_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "fused_elementwise.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+FusedElementwise<InputDataType, OutputDataType>::FusedElementwise() :
+    applyReLU(false)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+FusedElementwise<InputDataType, OutputDataType>::FusedElementwise(
+    const arma::vec& scale,
+    const arma::vec& shift,
+    const bool applyReLU) :
+    scale(scale),
+    shift(shift),
+    applyReLU(applyReLU)
+{
+  if (scale.n_elem != shift.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "FusedElementwise::FusedElementwise(): scale has " << scale.n_elem
+        << " elements, but shift has " << shift.n_elem << " elements!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename BatchNormType>
+FusedElementwise<InputDataType, OutputDataType>
+FusedElementwise<InputDataType, OutputDataType>::FromBatchNorm(
+    const BatchNormType& batchNorm,
+    const bool applyReLU)
+{
+  const size_t size = batchNorm.InputSize();
+
+  // The batch normalization parameters are stored as gamma followed by beta.
+  const arma::vec gamma = arma::vec(batchNorm.Parameters().memptr(), size);
+  const arma::vec beta = arma::vec(batchNorm.Parameters().memptr() + size,
+      size);
+  const arma::vec mean = arma::vectorise(batchNorm.TrainingMean());
+  const arma::vec variance = arma::vectorise(batchNorm.TrainingVariance());
+
+  // In deterministic mode the normalization is the per-dimension affine
+  // transform gamma * (x - mean) / sqrt(variance + eps) + beta; fold it into
+  // a single scale and shift.
+  const arma::vec scale = gamma / arma::sqrt(variance + batchNorm.Epsilon());
+  const arma::vec shift = beta - scale % mean;
+
+  return FusedElementwise(scale, shift, applyReLU);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void FusedElementwise<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input,
+    arma::Mat<eT>& output)
+{
+  output.set_size(input.n_rows, input.n_cols);
+
+  // Apply the whole chain in one sweep: every activation is read and written
+  // exactly once.
+  const size_t rows = input.n_rows;
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    const eT* inputCol = input.colptr(j);
+    eT* outputCol = output.colptr(j);
+    for (size_t r = 0; r < rows; ++r)
+    {
+      const eT value = (eT) scale[r] * inputCol[r] + (eT) shift[r];
+      outputCol[r] = (applyReLU && value < (eT) 0) ? (eT) 0 : value;
+    }
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void FusedElementwise<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(scale));
+  ar(CEREAL_NVP(shift));
+  ar(CEREAL_NVP(applyReLU));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -20,8 +20,10 @@
 #include "atrous_convolution.hpp"
 #include "base_layer.hpp"
 #include "batch_norm.hpp"
+#include "bf16_linear.hpp"
 #include "bicubic_interpolation.hpp"
 #include "bilinear_interpolation.hpp"
+#include "block_sparse_linear.hpp"
 #include "c_relu.hpp"
 #include "celu.hpp"
 #include "concat_performance.hpp"
@@ -35,6 +37,7 @@
 #include "fast_lstm.hpp"
 #include "flatten_t_swish.hpp"
 #include "flexible_relu.hpp"
+#include "fused_elementwise.hpp"
 #include "glimpse.hpp"
 #include "gru.hpp"
 #include "hard_tanh.hpp"
@@ -64,6 +67,7 @@
 #include "parametric_relu.hpp"
 #include "pixel_shuffle.hpp"
 #include "positional_encoding.hpp"
+#include "quantized_linear.hpp"
 #include "recurrent_attention.hpp"
 #include "recurrent.hpp"
 #include "reinforce_normal.hpp"
@@ -113,7 +113,6 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Forward(
     const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
   typedef typename arma::Mat<eT> MatType;
-  typedef typename arma::Cube<eT> CubeType;
 
   if (input.n_rows % inSize != 0)
   {
@@ -126,17 +125,19 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Forward(
 
   output.set_size(outSize * nPoints, batchSize);
 
-  const CubeType inputTemp(const_cast<MatType&>(input).memptr(), inSize,
-      nPoints, batchSize, false, false);
-
-  for (size_t i = 0; i < batchSize; ++i)
-  {
-    // Shape of weight : (outSize, inSize).
-    // Shape of inputTemp : (inSize, nPoints, batchSize).
-    MatType z = weight * inputTemp.slice(i);
-    z.each_col() += bias;
-    output.col(i) = arma::vectorise(z);
-  }
+  // The (inSize, nPoints, batchSize) cube is contiguous in memory, so all of
+  // the points of all of the batch items can be viewed as the columns of one
+  // (inSize, nPoints * batchSize) matrix, and the whole forward pass is a
+  // single large matrix product straight into the output memory instead of
+  // one small product and temporary per slice.
+  const MatType inputMat(const_cast<MatType&>(input).memptr(), inSize,
+      nPoints * batchSize, false, false);
+  MatType outputMat(output.memptr(), outSize, nPoints * batchSize, false,
+      false);
+
+  // Shape of weight : (outSize, inSize).
+  outputMat = weight * inputMat;
+  outputMat.each_col() += bias;
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -148,7 +149,6 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Backward(
     arma::Mat<eT>& g)
 {
   typedef typename arma::Mat<eT> MatType;
-  typedef typename arma::Cube<eT> CubeType;
 
   if (gy.n_rows % outSize != 0)
   {
@@ -159,17 +159,17 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Backward(
   const size_t nPoints = gy.n_rows / outSize;
   const size_t batchSize = gy.n_cols;
 
-  const CubeType gyTemp(const_cast<MatType&>(gy).memptr(), outSize,
-      nPoints, batchSize, false, false);
-
   g.set_size(inSize * nPoints, batchSize);
 
-  for (size_t i = 0; i < gyTemp.n_slices; ++i)
-  {
-    // Shape of weight : (outSize, inSize).
-    // Shape of gyTemp : (outSize, nPoints, batchSize).
-    g.col(i) = arma::vectorise(weight.t() * gyTemp.slice(i));
-  }
+  // As in Forward(), the per-slice products share the same weight operand,
+  // so the whole backward pass is one matrix product over a flat view of the
+  // propagated error, written straight into the output gradient memory.
+  const MatType gyMat(const_cast<MatType&>(gy).memptr(), outSize,
+      nPoints * batchSize, false, false);
+  MatType gMat(g.memptr(), inSize, nPoints * batchSize, false, false);
+
+  // Shape of weight : (outSize, inSize).
+  gMat = weight.t() * gyMat;
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -181,7 +181,6 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Gradient(
     arma::Mat<eT>& gradient)
 {
   typedef typename arma::Mat<eT> MatType;
-  typedef typename arma::Cube<eT> CubeType;
 
   if (error.n_rows % outSize != 0)
     Log::Fatal << "Propagated error matrix has invalid dimension!" << std::endl;
@@ -189,26 +188,23 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Gradient(
   const size_t nPoints = input.n_rows / inSize;
   const size_t batchSize = input.n_cols;
 
-  const CubeType inputTemp(const_cast<MatType&>(input).memptr(), inSize,
-      nPoints, batchSize, false, false);
-  const CubeType errorTemp(const_cast<MatType&>(error).memptr(), outSize,
-      nPoints, batchSize, false, false);
-
-  CubeType dW(outSize, inSize, batchSize);
-  for (size_t i = 0; i < batchSize; ++i)
-  {
-    // Shape of errorTemp : (outSize, nPoints, batchSize).
-    // Shape of inputTemp : (inSize, nPoints, batchSize).
-    dW.slice(i) = errorTemp.slice(i) * inputTemp.slice(i).t();
-  }
-
   gradient.set_size(arma::size(weights));
 
-  gradient.submat(0, 0, weight.n_elem - 1, 0)
-      = arma::vectorise(arma::sum(dW, 2));
+  // The sum over slices of errorTemp.slice(i) * inputTemp.slice(i).t() is
+  // exactly the product of the flat (outSize, nPoints * batchSize) error
+  // view with the transposed flat input view, so the weight gradient is one
+  // matrix product (tiled internally by the GEMM backend), accumulated
+  // straight into the gradient memory with no per-slice temporaries.
+  const MatType inputMat(const_cast<MatType&>(input).memptr(), inSize,
+      nPoints * batchSize, false, false);
+  const MatType errorMat(const_cast<MatType&>(error).memptr(), outSize,
+      nPoints * batchSize, false, false);
+
+  MatType dW(gradient.memptr(), outSize, inSize, false, false);
+  dW = errorMat * inputMat.t();
 
   gradient.submat(weight.n_elem, 0, weights.n_elem - 1, 0)
-      = arma::vectorise(arma::sum(arma::sum(errorTemp, 2), 1));
+      = arma::sum(errorMat, 1);
 
   regularizer.Evaluate(weights, gradient);
 }
@@ -271,35 +271,19 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   forgetGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
       input2GateForgetBias;
 
-  if (forwardStep > 0)
+  if (forwardStep > 0 && useCellState)
   {
-    if (useCellState)
+    if (!cellState.is_empty())
     {
-      if (!cellState.is_empty())
-      {
-        cell.cols(forwardStep - batchSize,
-            forwardStep - batchSize + batchStep) = cellState;
-      }
-      else
-      {
-        throw std::runtime_error("Cell parameter is empty.");
-      }
+      cell.cols(forwardStep - batchSize,
+          forwardStep - batchSize + batchStep) = cellState;
+    }
+    else
+    {
+      throw std::runtime_error("Cell parameter is empty.");
     }
-    inputGate.cols(forwardStep, forwardStep + batchStep) +=
-        arma::repmat(cell2GateInputWeight, 1, batchSize) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
-
-    forgetGate.cols(forwardStep, forwardStep + batchStep) +=
-        arma::repmat(cell2GateForgetWeight, 1, batchSize) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
   }
 
-  inputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-inputGate.cols(forwardStep, forwardStep + batchStep)));
-
-  forgetGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-forgetGate.cols(forwardStep, forwardStep + batchStep)));
-
   hiddenLayer.cols(forwardStep, forwardStep + batchStep) = input2HiddenWeight *
       input + output2HiddenWeight * outParameter.cols(
       forwardStep, forwardStep + batchStep);
@@ -307,42 +291,71 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   hiddenLayer.cols(forwardStep, forwardStep + batchStep).each_col() +=
       input2HiddenBias;
 
-  hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(hiddenLayer.cols(forwardStep, forwardStep + batchStep));
-
-  if (forwardStep == 0)
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
-  }
-  else
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        forgetGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep)
-        + inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
-  }
-
+  // The peephole contribution of the output gate depends on the updated cell
+  // and is therefore added in the fused pass below.
   outputGate.cols(forwardStep, forwardStep + batchStep) = input2GateOutputWeight
       * input + output2GateOutputWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep) + cell.cols(forwardStep,
-      forwardStep + batchStep).each_col() % cell2GateOutputWeight;
+      forwardStep, forwardStep + batchStep);
 
   outputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
       input2GateOutputBias;
 
-  outputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-outputGate.cols(forwardStep, forwardStep + batchStep)));
-
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
+  // Apply the peephole connections and the gate activations and update the
+  // cell and the output in one in-place pass over the batch, instead of one
+  // temporary per gate.
+  typedef typename OutputDataType::elem_type ElemType;
+  const ElemType* cell2GateInputPtr = cell2GateInputWeight.memptr();
+  const ElemType* cell2GateForgetPtr = cell2GateForgetWeight.memptr();
+  const ElemType* cell2GateOutputPtr = cell2GateOutputWeight.memptr();
+  for (size_t offset = forwardStep; offset <= forwardStep + batchStep; ++offset)
+  {
+    ElemType* inputGatePtr = inputGate.colptr(offset);
+    ElemType* forgetGatePtr = forgetGate.colptr(offset);
+    const ElemType* hiddenLayerPtr = hiddenLayer.colptr(offset);
+    ElemType* outputGatePtr = outputGate.colptr(offset);
+    ElemType* inputGateActivationPtr = inputGateActivation.colptr(offset);
+    ElemType* forgetGateActivationPtr = forgetGateActivation.colptr(offset);
+    ElemType* hiddenLayerActivationPtr = hiddenLayerActivation.colptr(offset);
+    ElemType* outputGateActivationPtr = outputGateActivation.colptr(offset);
+    ElemType* cellPtr = cell.colptr(offset);
+    const ElemType* prevCellPtr = (forwardStep > 0) ?
+        cell.colptr(offset - batchSize) : NULL;
+    ElemType* cellActivationPtr = cellActivation.colptr(offset);
+    ElemType* outPtr = outParameter.colptr(offset + batchSize);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      if (prevCellPtr != NULL)
+      {
+        inputGatePtr[i] += cell2GateInputPtr[i] * prevCellPtr[i];
+        forgetGatePtr[i] += cell2GateForgetPtr[i] * prevCellPtr[i];
+      }
 
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) =
-      cellActivation.cols(forwardStep, forwardStep + batchStep) %
-      outputGateActivation.cols(forwardStep, forwardStep + batchStep);
+      const ElemType inputGateValue =
+          1.0 / (1.0 + std::exp(-inputGatePtr[i]));
+      const ElemType forgetGateValue =
+          1.0 / (1.0 + std::exp(-forgetGatePtr[i]));
+      const ElemType hiddenValue = std::tanh(hiddenLayerPtr[i]);
+
+      inputGateActivationPtr[i] = inputGateValue;
+      forgetGateActivationPtr[i] = forgetGateValue;
+      hiddenLayerActivationPtr[i] = hiddenValue;
+
+      const ElemType cellValue = (prevCellPtr == NULL) ?
+          inputGateValue * hiddenValue :
+          forgetGateValue * prevCellPtr[i] + inputGateValue * hiddenValue;
+      cellPtr[i] = cellValue;
+
+      outputGatePtr[i] += cell2GateOutputPtr[i] * cellValue;
+      const ElemType outputGateValue =
+          1.0 / (1.0 + std::exp(-outputGatePtr[i]));
+      outputGateActivationPtr[i] = outputGateValue;
+
+      const ElemType cellActivationValue = std::tanh(cellValue);
+      cellActivationPtr[i] = cellActivationValue;
+      outPtr[i] = cellActivationValue * outputGateValue;
+    }
+  }
 
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
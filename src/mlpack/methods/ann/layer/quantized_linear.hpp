@@ -0,0 +1,161 @@
+/**
+ * @file methods/ann/layer/quantized_linear.hpp
+ *
+ * Definition of the QuantizedLinear layer class, an int8 inference-only
+ * variant of the Linear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the QuantizedLinear layer class, an inference-only int8
+ * version of the Linear layer for post-training quantization.  The trained
+ * floating-point weight matrix is stored as int8 with a symmetric per-output
+ * channel (per-row) scale, which reduces the weight storage by a factor of 8
+ * compared to double precision.  During the forward pass, the input is
+ * quantized dynamically per column, the matrix product is accumulated in
+ * int32, and the result is dequantized and shifted by the (floating-point)
+ * bias, so the output at the layer boundary is a regular floating-point
+ * matrix that any downstream layer can consume.
+ *
+ * The layer holds no trainable parameters and does not implement Backward()
+ * or Gradient(); it is meant to be built from a trained Linear layer for
+ * serving, e.g. inside a StaticNetwork:
+ *
+ * @code
+ * // model is a trained FFN with a Linear<> layer at position 0.
+ * QuantizedLinear<> quantized(linearLayer.Weight(), linearLayer.Bias());
+ * @endcode
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class QuantizedLinear
+{
+ public:
+  //! Create the QuantizedLinear object.
+  QuantizedLinear();
+
+  /**
+   * Create the QuantizedLinear layer from trained floating-point weights.
+   *
+   * @param weight The trained weight matrix (outSize x inSize).
+   * @param bias The trained bias vector (outSize x 1).
+   */
+  QuantizedLinear(const arma::mat& weight, const arma::mat& bias);
+
+  /**
+   * Quantize the given trained weights into the int8 representation.  Each
+   * row of the weight matrix (one output channel) gets its own symmetric
+   * scale, so channels with small weight magnitudes do not lose precision to
+   * channels with large ones.
+   *
+   * @param weight The trained weight matrix (outSize x inSize).
+   * @param bias The trained bias vector (outSize x 1).
+   */
+  void Quantize(const arma::mat& weight, const arma::mat& bias);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.  The input is
+   * quantized per column, multiplied in int8 with int32 accumulation, and the
+   * result is dequantized into the output matrix.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  //! Get the input parameter.
+  InputDataType const& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the quantized weight matrix.
+  arma::Mat<arma::s8> const& QuantizedWeight() const
+  {
+    return quantizedWeight;
+  }
+
+  //! Get the per-output-channel dequantization scales.
+  arma::vec const& Scales() const { return scales; }
+
+  //! Get the bias of the layer.
+  arma::vec const& Bias() const { return bias; }
+
+  //! Get the input size.
+  size_t InputSize() const { return inSize; }
+
+  //! Get the output size.
+  size_t OutputSize() const { return outSize; }
+
+  //! Get the shape of the input.
+  size_t InputShape() const
+  {
+    return inSize;
+  }
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored int8 weight matrix (outSize x inSize).
+  arma::Mat<arma::s8> quantizedWeight;
+
+  //! Locally-stored per-output-channel dequantization scales.
+  arma::vec scales;
+
+  //! Locally-stored bias term parameters (kept in floating point).
+  arma::vec bias;
+
+  //! Reusable buffer for the quantized input column.
+  arma::Col<arma::s8> quantizedInput;
+
+  //! Reusable int32 accumulator for one output column.
+  arma::Col<arma::s32> accumulator;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class QuantizedLinear
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_linear_impl.hpp"
+
+#endif
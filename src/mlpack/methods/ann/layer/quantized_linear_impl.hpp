@@ -0,0 +1,150 @@
+/**
+ * @file methods/ann/layer/quantized_linear_impl.hpp
+ *
+ * Implementation of the QuantizedLinear layer class, an int8 inference-only
+ * variant of the Linear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_linear.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+QuantizedLinear<InputDataType, OutputDataType>::QuantizedLinear() :
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+QuantizedLinear<InputDataType, OutputDataType>::QuantizedLinear(
+    const arma::mat& weight, const arma::mat& bias) :
+    inSize(0),
+    outSize(0)
+{
+  Quantize(weight, bias);
+}
+
+template<typename InputDataType, typename OutputDataType>
+void QuantizedLinear<InputDataType, OutputDataType>::Quantize(
+    const arma::mat& weight, const arma::mat& bias)
+{
+  if (weight.n_rows != bias.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "QuantizedLinear::Quantize(): the weight matrix has "
+        << weight.n_rows << " rows, but the bias has " << bias.n_elem
+        << " elements!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  inSize = weight.n_cols;
+  outSize = weight.n_rows;
+  this->bias = arma::vectorise(bias);
+
+  quantizedWeight.set_size(outSize, inSize);
+  scales.set_size(outSize);
+  for (size_t c = 0; c < outSize; ++c)
+  {
+    // A symmetric scale per output channel: the largest magnitude of the row
+    // maps to 127.  An all-zero row gets scale 1 to avoid division by zero.
+    const double rowMax = arma::abs(weight.row(c)).max();
+    scales(c) = (rowMax > 0) ? rowMax / 127.0 : 1.0;
+
+    for (size_t k = 0; k < inSize; ++k)
+    {
+      quantizedWeight(c, k) = (arma::s8) std::floor(
+          weight(c, k) / scales(c) + 0.5);
+    }
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void QuantizedLinear<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  output.set_size(outSize, input.n_cols);
+  quantizedInput.set_size(inSize);
+  accumulator.set_size(outSize);
+
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    const eT* inputPtr = input.colptr(j);
+    eT* outputPtr = output.colptr(j);
+
+    // The input is quantized dynamically: each column gets its own symmetric
+    // scale from its largest magnitude.
+    eT inputMax = 0;
+    for (size_t k = 0; k < inSize; ++k)
+    {
+      const eT magnitude = (inputPtr[k] < 0) ? -inputPtr[k] : inputPtr[k];
+      if (magnitude > inputMax)
+        inputMax = magnitude;
+    }
+
+    if (inputMax == 0)
+    {
+      // A zero input column contributes only the bias.
+      for (size_t c = 0; c < outSize; ++c)
+        outputPtr[c] = (eT) bias(c);
+      continue;
+    }
+
+    const eT inputScale = inputMax / 127;
+    for (size_t k = 0; k < inSize; ++k)
+    {
+      quantizedInput(k) = (arma::s8) std::floor(
+          inputPtr[k] / inputScale + (eT) 0.5);
+    }
+
+    // Accumulate the int8 product in int32; the weight matrix is traversed
+    // column by column so the inner loop runs down contiguous memory.
+    accumulator.zeros();
+    arma::s32* accumulatorPtr = accumulator.memptr();
+    for (size_t k = 0; k < inSize; ++k)
+    {
+      const arma::s32 inputValue = quantizedInput(k);
+      if (inputValue == 0)
+        continue;
+
+      const arma::s8* weightPtr = quantizedWeight.colptr(k);
+      for (size_t c = 0; c < outSize; ++c)
+        accumulatorPtr[c] += weightPtr[c] * inputValue;
+    }
+
+    // Dequantize and add the bias.
+    for (size_t c = 0; c < outSize; ++c)
+    {
+      outputPtr[c] = (eT) (scales(c) * inputScale * accumulatorPtr[c] +
+          bias(c));
+    }
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void QuantizedLinear<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(quantizedWeight));
+  ar(CEREAL_NVP(scales));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
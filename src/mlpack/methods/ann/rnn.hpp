@@ -418,7 +418,8 @@ class RNN
   //! Locally-stored output parameter visitor.
   OutputParameterVisitor outputParameterVisitor;
 
-  //! List of all module parameters for the backward pass (BBTT).
+  //! Persistent workspace of all module parameters for the backward pass
+  //! (BBTT); entries are overwritten in place across evaluations.
   std::vector<arma::mat> moduleOutputParameter;
 
   //! Locally-stored weight size visitor.
@@ -16,7 +16,9 @@
 #include "rnn.hpp"
 
 #include "visitor/load_output_parameter_visitor.hpp"
+#include "visitor/restore_output_parameter_visitor.hpp"
 #include "visitor/save_output_parameter_visitor.hpp"
+#include "visitor/store_output_parameter_visitor.hpp"
 #include "visitor/forward_visitor.hpp"
 #include "visitor/backward_visitor.hpp"
 #include "visitor/reset_cell_visitor.hpp"
@@ -387,6 +389,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
   double performance = 0;
   size_t responseSeq = 0;
+  size_t workspacePosition = 0;
   const size_t effectiveRho = std::min(rho, size_t(responses.size()));
 
   for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
@@ -400,10 +403,12 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
       responseSeq = seqNum;
     }
 
+    // Overwrite the persistent workspace in place; after the first
+    // evaluation no per-timestep allocations happen here.
     for (size_t l = 0; l < network.size(); ++l)
     {
-      boost::apply_visitor(SaveOutputParameterVisitor(moduleOutputParameter),
-          network[l]);
+      boost::apply_visitor(StoreOutputParameterVisitor(moduleOutputParameter,
+          workspacePosition), network[l]);
     }
 
     performance += outputLayer.Forward(boost::apply_visitor(
@@ -432,7 +437,8 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     currentGradient.zeros();
     for (size_t l = 0; l < network.size(); ++l)
     {
-      boost::apply_visitor(LoadOutputParameterVisitor(moduleOutputParameter),
+      boost::apply_visitor(RestoreOutputParameterVisitor(
+          moduleOutputParameter, workspacePosition),
           network[network.size() - 1 - l]);
     }
 
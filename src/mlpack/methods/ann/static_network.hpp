@@ -0,0 +1,219 @@
+/**
+ * @file methods/ann/static_network.hpp
+ *
+ * Definition of the StaticNetwork class, a sequential network whose layer
+ * types are fixed at compile time so the forward pass can be fully inlined.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_NETWORK_HPP
+#define MLPACK_METHODS_ANN_STATIC_NETWORK_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+#include <tuple>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of a sequential network whose layer types are part of the
+ * type, so every Forward() call is resolved at compile time.  Unlike FFN,
+ * which dispatches through a boost::variant visitor for each layer, the
+ * compiler can inline the whole forward pass, which pays off for small-batch
+ * low-latency inference where the per-layer dispatch dominates.  The per-layer
+ * output buffers are members, so repeated calls with the same batch size do
+ * not allocate.
+ *
+ * The network is inference-only and is meant to be used for serving a fixed
+ * architecture that was trained with FFN: build a StaticNetwork with the same
+ * layers in the same order and hand it the trained parameter vector, which
+ * uses the same packed layout.  For example:
+ *
+ * @code
+ * StaticNetwork<Linear<>, SigmoidLayer<>, Linear<>, LogSoftMax<> > network(
+ *     Linear<>(10, 8), SigmoidLayer<>(), Linear<>(8, 3), LogSoftMax<>());
+ * network.Parameters(model.Parameters());  // model is the trained FFN.
+ * network.Predict(predictors, results);
+ * @endcode
+ *
+ * Layers with sub-modules (e.g. Sequential) are not supported, and layers
+ * that depend on the input width and height being set (e.g. Convolution) have
+ * to be configured by hand; the intended use is stacks of fully-connected and
+ * activation layers.
+ *
+ * @tparam LayerTypes The types of the layers, in forward order.
+ */
+template<typename... LayerTypes>
+class StaticNetwork
+{
+ public:
+  static_assert(sizeof...(LayerTypes) > 0,
+      "StaticNetwork must have at least one layer.");
+
+  /**
+   * Create the StaticNetwork object from the given layer instances.  The
+   * layers are put into deterministic (inference) mode, and their weight
+   * aliases are set up, so the parameters can be filled in afterwards.
+   *
+   * @param layers The layer instances, in forward order.
+   */
+  StaticNetwork(LayerTypes... layers);
+
+  //! Return the total number of weight elements of the network.
+  size_t WeightSize() const;
+
+  /**
+   * Set the network weights from a packed parameter vector.  The layout is
+   * the one produced by FFN::Parameters() for the same architecture: the
+   * parameters of each layer, in forward order.
+   *
+   * @param parameters The packed parameter vector; its values are copied.
+   */
+  void Parameters(const arma::mat& parameters);
+
+  /**
+   * Perform a forward pass through the network.  The whole pass is resolved
+   * at compile time, so there is no per-layer dispatch.
+   *
+   * @param input The input data.
+   * @param output The predicted results.
+   */
+  template<typename InputType, typename OutputType>
+  void Forward(const InputType& input, OutputType& output);
+
+  /**
+   * Predict the responses to a given set of predictors, passing the data
+   * through the network in batches.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Number of points to predict at a time.
+   */
+  void Predict(const arma::mat& predictors,
+               arma::mat& results,
+               const size_t batchSize = 128);
+
+  //! Get the I-th layer of the network.
+  template<size_t I>
+  const typename std::tuple_element<I, std::tuple<LayerTypes...> >::type&
+  Layer() const { return std::get<I>(network); }
+  //! Modify the I-th layer of the network.
+  template<size_t I>
+  typename std::tuple_element<I, std::tuple<LayerTypes...> >::type&
+  Layer() { return std::get<I>(network); }
+
+ private:
+  /**
+   * Run the forward pass from layer I on; each step feeds the output buffer
+   * of the previous layer to the next one.
+   */
+  template<size_t I, typename InputType>
+  typename std::enable_if<(I < sizeof...(LayerTypes)), void>::type
+  ForwardStep(const InputType& input);
+
+  //! End of the forward recursion.
+  template<size_t I, typename InputType>
+  typename std::enable_if<(I == sizeof...(LayerTypes)), void>::type
+  ForwardStep(const InputType& input);
+
+  //! Distribute the packed parameter vector from layer I on.
+  template<size_t I>
+  typename std::enable_if<(I < sizeof...(LayerTypes)), void>::type
+  SetParametersStep(const arma::vec& parameters, const size_t offset);
+
+  //! End of the parameter distribution recursion.
+  template<size_t I>
+  typename std::enable_if<(I == sizeof...(LayerTypes)), void>::type
+  SetParametersStep(const arma::vec& parameters, const size_t offset);
+
+  //! Sum the weight sizes from layer I on.
+  template<size_t I>
+  typename std::enable_if<(I < sizeof...(LayerTypes)), size_t>::type
+  WeightSizeStep() const;
+
+  //! End of the weight size recursion.
+  template<size_t I>
+  typename std::enable_if<(I == sizeof...(LayerTypes)), size_t>::type
+  WeightSizeStep() const;
+
+  //! Set up the weight aliases and the deterministic mode from layer I on.
+  template<size_t I>
+  typename std::enable_if<(I < sizeof...(LayerTypes)), void>::type
+  InitializeStep();
+
+  //! End of the initialization recursion.
+  template<size_t I>
+  typename std::enable_if<(I == sizeof...(LayerTypes)), void>::type
+  InitializeStep();
+
+  //! Copy the given parameter slice into the weights of a layer that has
+  //! parameters and return the number of consumed elements.
+  template<typename T>
+  typename std::enable_if<
+      HasParametersCheck<T, arma::mat&(T::*)()>::value, size_t>::type
+  SetLayerParameters(T& layer, const arma::vec& parameters,
+                     const size_t offset);
+
+  //! Nothing to copy for a layer without parameters.
+  template<typename T>
+  typename std::enable_if<
+      !HasParametersCheck<T, arma::mat&(T::*)()>::value, size_t>::type
+  SetLayerParameters(T& layer, const arma::vec& parameters,
+                     const size_t offset);
+
+  //! Return the weight size of a layer that has parameters.
+  template<typename T>
+  typename std::enable_if<
+      HasParametersCheck<T, arma::mat&(T::*)()>::value, size_t>::type
+  LayerWeightSize(const T& layer) const;
+
+  //! A layer without parameters has no weights.
+  template<typename T>
+  typename std::enable_if<
+      !HasParametersCheck<T, arma::mat&(T::*)()>::value, size_t>::type
+  LayerWeightSize(const T& layer) const;
+
+  //! Execute the Reset() function of a layer that implements it.
+  template<typename T>
+  typename std::enable_if<
+      HasResetCheck<T, void(T::*)()>::value, void>::type
+  ResetLayer(T& layer);
+
+  //! Nothing to reset otherwise.
+  template<typename T>
+  typename std::enable_if<
+      !HasResetCheck<T, void(T::*)()>::value, void>::type
+  ResetLayer(T& layer);
+
+  //! Put a layer that has a Deterministic() function into inference mode.
+  template<typename T>
+  typename std::enable_if<
+      HasDeterministicCheck<T, bool&(T::*)(void)>::value, void>::type
+  SetLayerDeterministic(T& layer);
+
+  //! Nothing to set otherwise.
+  template<typename T>
+  typename std::enable_if<
+      !HasDeterministicCheck<T, bool&(T::*)(void)>::value, void>::type
+  SetLayerDeterministic(T& layer);
+
+  //! The layers of the network.
+  std::tuple<LayerTypes...> network;
+
+  //! The output buffer of each layer; reused across forward passes.
+  arma::mat outputs[sizeof...(LayerTypes)];
+}; // class StaticNetwork
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "static_network_impl.hpp"
+
+#endif
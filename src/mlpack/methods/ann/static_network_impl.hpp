@@ -0,0 +1,236 @@
+/**
+ * @file methods/ann/static_network_impl.hpp
+ *
+ * Implementation of the StaticNetwork class, a sequential network whose layer
+ * types are fixed at compile time so the forward pass can be fully inlined.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_NETWORK_IMPL_HPP
+#define MLPACK_METHODS_ANN_STATIC_NETWORK_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "static_network.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename... LayerTypes>
+StaticNetwork<LayerTypes...>::StaticNetwork(LayerTypes... layers) :
+    network(std::move(layers)...)
+{
+  InitializeStep<0>();
+}
+
+template<typename... LayerTypes>
+size_t StaticNetwork<LayerTypes...>::WeightSize() const
+{
+  return WeightSizeStep<0>();
+}
+
+template<typename... LayerTypes>
+void StaticNetwork<LayerTypes...>::Parameters(const arma::mat& parameters)
+{
+  if (parameters.n_elem != WeightSize())
+  {
+    std::ostringstream oss;
+    oss << "StaticNetwork::Parameters(): the given vector has "
+        << parameters.n_elem << " elements, but the network has "
+        << WeightSize() << " weights!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const arma::vec parameterVec = arma::vectorise(parameters);
+  SetParametersStep<0>(parameterVec, 0);
+}
+
+template<typename... LayerTypes>
+template<typename InputType, typename OutputType>
+void StaticNetwork<LayerTypes...>::Forward(
+    const InputType& input, OutputType& output)
+{
+  ForwardStep<0>(input);
+  output = outputs[sizeof...(LayerTypes) - 1];
+}
+
+template<typename... LayerTypes>
+void StaticNetwork<LayerTypes...>::Predict(
+    const arma::mat& predictors, arma::mat& results, const size_t batchSize)
+{
+  for (size_t begin = 0; begin < predictors.n_cols; begin += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        predictors.n_cols - begin);
+
+    ForwardStep<0>(arma::mat(
+        const_cast<double*>(predictors.colptr(begin)), predictors.n_rows,
+        effectiveBatchSize, false, true));
+    const arma::mat& output = outputs[sizeof...(LayerTypes) - 1];
+
+    // The output dimensionality is only known after the first forward pass.
+    if (begin == 0)
+      results.set_size(output.n_rows, predictors.n_cols);
+
+    results.cols(begin, begin + effectiveBatchSize - 1) = output;
+  }
+}
+
+template<typename... LayerTypes>
+template<size_t I, typename InputType>
+typename std::enable_if<(I < sizeof...(LayerTypes)), void>::type
+StaticNetwork<LayerTypes...>::ForwardStep(const InputType& input)
+{
+  std::get<I>(network).Forward(input, outputs[I]);
+  ForwardStep<I + 1>(outputs[I]);
+}
+
+template<typename... LayerTypes>
+template<size_t I, typename InputType>
+typename std::enable_if<(I == sizeof...(LayerTypes)), void>::type
+StaticNetwork<LayerTypes...>::ForwardStep(const InputType& /* input */)
+{
+  /* Nothing to do here. */
+}
+
+template<typename... LayerTypes>
+template<size_t I>
+typename std::enable_if<(I < sizeof...(LayerTypes)), void>::type
+StaticNetwork<LayerTypes...>::SetParametersStep(
+    const arma::vec& parameters, const size_t offset)
+{
+  const size_t used = SetLayerParameters(std::get<I>(network), parameters,
+      offset);
+  SetParametersStep<I + 1>(parameters, offset + used);
+}
+
+template<typename... LayerTypes>
+template<size_t I>
+typename std::enable_if<(I == sizeof...(LayerTypes)), void>::type
+StaticNetwork<LayerTypes...>::SetParametersStep(
+    const arma::vec& /* parameters */, const size_t /* offset */)
+{
+  /* Nothing to do here. */
+}
+
+template<typename... LayerTypes>
+template<size_t I>
+typename std::enable_if<(I < sizeof...(LayerTypes)), size_t>::type
+StaticNetwork<LayerTypes...>::WeightSizeStep() const
+{
+  return LayerWeightSize(std::get<I>(network)) + WeightSizeStep<I + 1>();
+}
+
+template<typename... LayerTypes>
+template<size_t I>
+typename std::enable_if<(I == sizeof...(LayerTypes)), size_t>::type
+StaticNetwork<LayerTypes...>::WeightSizeStep() const
+{
+  return 0;
+}
+
+template<typename... LayerTypes>
+template<size_t I>
+typename std::enable_if<(I < sizeof...(LayerTypes)), void>::type
+StaticNetwork<LayerTypes...>::InitializeStep()
+{
+  ResetLayer(std::get<I>(network));
+  SetLayerDeterministic(std::get<I>(network));
+  InitializeStep<I + 1>();
+}
+
+template<typename... LayerTypes>
+template<size_t I>
+typename std::enable_if<(I == sizeof...(LayerTypes)), void>::type
+StaticNetwork<LayerTypes...>::InitializeStep()
+{
+  /* Nothing to do here. */
+}
+
+template<typename... LayerTypes>
+template<typename T>
+typename std::enable_if<
+    HasParametersCheck<T, arma::mat&(T::*)()>::value, size_t>::type
+StaticNetwork<LayerTypes...>::SetLayerParameters(
+    T& layer, const arma::vec& parameters, const size_t offset)
+{
+  const size_t size = layer.Parameters().n_elem;
+  layer.Parameters() = arma::reshape(
+      parameters.subvec(offset, offset + size - 1),
+      layer.Parameters().n_rows, layer.Parameters().n_cols);
+  ResetLayer(layer);
+
+  return size;
+}
+
+template<typename... LayerTypes>
+template<typename T>
+typename std::enable_if<
+    !HasParametersCheck<T, arma::mat&(T::*)()>::value, size_t>::type
+StaticNetwork<LayerTypes...>::SetLayerParameters(
+    T& /* layer */, const arma::vec& /* parameters */,
+    const size_t /* offset */)
+{
+  return 0;
+}
+
+template<typename... LayerTypes>
+template<typename T>
+typename std::enable_if<
+    HasParametersCheck<T, arma::mat&(T::*)()>::value, size_t>::type
+StaticNetwork<LayerTypes...>::LayerWeightSize(const T& layer) const
+{
+  return layer.Parameters().n_elem;
+}
+
+template<typename... LayerTypes>
+template<typename T>
+typename std::enable_if<
+    !HasParametersCheck<T, arma::mat&(T::*)()>::value, size_t>::type
+StaticNetwork<LayerTypes...>::LayerWeightSize(const T& /* layer */) const
+{
+  return 0;
+}
+
+template<typename... LayerTypes>
+template<typename T>
+typename std::enable_if<
+    HasResetCheck<T, void(T::*)()>::value, void>::type
+StaticNetwork<LayerTypes...>::ResetLayer(T& layer)
+{
+  layer.Reset();
+}
+
+template<typename... LayerTypes>
+template<typename T>
+typename std::enable_if<
+    !HasResetCheck<T, void(T::*)()>::value, void>::type
+StaticNetwork<LayerTypes...>::ResetLayer(T& /* layer */)
+{
+  /* Nothing to do here. */
+}
+
+template<typename... LayerTypes>
+template<typename T>
+typename std::enable_if<
+    HasDeterministicCheck<T, bool&(T::*)(void)>::value, void>::type
+StaticNetwork<LayerTypes...>::SetLayerDeterministic(T& layer)
+{
+  layer.Deterministic() = true;
+}
+
+template<typename... LayerTypes>
+template<typename T>
+typename std::enable_if<
+    !HasDeterministicCheck<T, bool&(T::*)(void)>::value, void>::type
+StaticNetwork<LayerTypes...>::SetLayerDeterministic(T& /* layer */)
+{
+  /* Nothing to do here. */
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
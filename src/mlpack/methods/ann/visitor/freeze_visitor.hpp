@@ -0,0 +1,74 @@
+/**
+ * @file methods/ann/visitor/freeze_visitor.hpp
+ *
+ * This file provides an abstraction to release the backward-pass state
+ * (delta and gradient buffers) of different layers and automatically directs
+ * any parameter to the right layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_FREEZE_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_FREEZE_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * FreezeVisitor releases the delta and gradient buffers of the given module,
+ * which are only needed for the backward pass.  The buffers are rebuilt on
+ * demand if the module is trained again afterwards.
+ */
+class FreezeVisitor : public boost::static_visitor<void>
+{
+ public:
+  //! Release the backward-pass state of the given module.
+  template<typename LayerType>
+  void operator()(LayerType* layer) const;
+
+  void operator()(MoreTypes layer) const;
+
+ private:
+  //! Release the gradient buffer and recurse into the sub-modules.
+  template<typename T>
+  typename std::enable_if<
+      HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      HasModelCheck<T>::value, void>::type
+  LayerFreeze(T* layer) const;
+
+  //! Recurse into the sub-modules.
+  template<typename T>
+  typename std::enable_if<
+      !HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      HasModelCheck<T>::value, void>::type
+  LayerFreeze(T* layer) const;
+
+  //! Release the gradient buffer.
+  template<typename T>
+  typename std::enable_if<
+      HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      !HasModelCheck<T>::value, void>::type
+  LayerFreeze(T* layer) const;
+
+  //! Do nothing beyond releasing the delta buffer.
+  template<typename T>
+  typename std::enable_if<
+      !HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      !HasModelCheck<T>::value, void>::type
+  LayerFreeze(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "freeze_visitor_impl.hpp"
+
+#endif
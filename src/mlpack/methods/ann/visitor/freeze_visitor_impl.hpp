@@ -0,0 +1,80 @@
+/**
+ * @file methods/ann/visitor/freeze_visitor_impl.hpp
+ *
+ * Implementation of the backward-pass state release layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_FREEZE_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_FREEZE_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "freeze_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! FreezeVisitor visitor class.
+template<typename LayerType>
+inline void FreezeVisitor::operator()(LayerType* layer) const
+{
+  layer->Delta().clear();
+  LayerFreeze(layer);
+}
+
+inline void FreezeVisitor::operator()(MoreTypes layer) const
+{
+  layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    HasModelCheck<T>::value, void>::type
+FreezeVisitor::LayerFreeze(T* layer) const
+{
+  layer->Gradient().clear();
+
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(FreezeVisitor(), layer->Model()[i]);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    HasModelCheck<T>::value, void>::type
+FreezeVisitor::LayerFreeze(T* layer) const
+{
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(FreezeVisitor(), layer->Model()[i]);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    !HasModelCheck<T>::value, void>::type
+FreezeVisitor::LayerFreeze(T* layer) const
+{
+  layer->Gradient().clear();
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    !HasModelCheck<T>::value, void>::type
+FreezeVisitor::LayerFreeze(T* /* layer */) const
+{
+  /* Nothing to do here. */
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
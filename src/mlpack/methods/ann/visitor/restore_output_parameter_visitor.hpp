@@ -0,0 +1,71 @@
+/**
+ * @file methods/ann/visitor/restore_output_parameter_visitor.hpp
+ *
+ * This file provides an abstraction for the OutputParameter() function for
+ * different layers and automatically directs any parameter to the right layer
+ * type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_RESTORE_OUTPUT_PARAMETER_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_RESTORE_OUTPUT_PARAMETER_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * RestoreOutputParameterVisitor restores the output parameter from the given
+ * workspace, moving the position backwards.  Unlike
+ * LoadOutputParameterVisitor, the workspace entries are left in place rather
+ * than popped, so the matrices stay allocated for the next pass written by
+ * StoreOutputParameterVisitor.
+ */
+class RestoreOutputParameterVisitor : public boost::static_visitor<void>
+{
+ public:
+  //! Restore the output parameter from the given workspace.
+  RestoreOutputParameterVisitor(std::vector<arma::mat>& parameter,
+                                size_t& position);
+
+  //! Restore the output parameter.
+  template<typename LayerType>
+  void operator()(LayerType* layer) const;
+
+  void operator()(MoreTypes layer) const;
+
+ private:
+  //! The workspace holding the stored parameters.
+  std::vector<arma::mat>& parameter;
+
+  //! The position one past the next entry to restore.
+  size_t& position;
+
+  //! Restore the output parameter for a module which doesn't implement the
+  //! Model() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasModelCheck<T>::value, void>::type
+  OutputParameter(T* layer) const;
+
+  //! Restore the output parameter for a module which implements the Model()
+  //! function.
+  template<typename T>
+  typename std::enable_if<
+      HasModelCheck<T>::value, void>::type
+  OutputParameter(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "restore_output_parameter_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file methods/ann/visitor/restore_output_parameter_visitor_impl.hpp
+ *
+ * Implementation of the OutputParameter() function layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_RESTORE_OUTPUT_PARAMETER_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_RESTORE_OUTPUT_PARAMETER_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "restore_output_parameter_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! RestoreOutputParameterVisitor visitor class.
+inline RestoreOutputParameterVisitor::RestoreOutputParameterVisitor(
+    std::vector<arma::mat>& parameter, size_t& position) :
+    parameter(parameter),
+    position(position)
+{
+  /* Nothing to do here. */
+}
+
+template<typename LayerType>
+inline void RestoreOutputParameterVisitor::operator()(LayerType* layer) const
+{
+  OutputParameter(layer);
+}
+
+inline void RestoreOutputParameterVisitor::operator()(MoreTypes layer) const
+{
+  layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasModelCheck<T>::value, void>::type
+RestoreOutputParameterVisitor::OutputParameter(T* layer) const
+{
+  layer->OutputParameter() = parameter[--position];
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasModelCheck<T>::value, void>::type
+RestoreOutputParameterVisitor::OutputParameter(T* layer) const
+{
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(RestoreOutputParameterVisitor(parameter, position),
+        layer->Model()[layer->Model().size() - i - 1]);
+  }
+
+  layer->OutputParameter() = parameter[--position];
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file methods/ann/visitor/store_output_parameter_visitor_impl.hpp
+ *
+ * Implementation of the OutputParameter() function layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_STORE_OUTPUT_PARAMETER_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_STORE_OUTPUT_PARAMETER_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "store_output_parameter_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! StoreOutputParameterVisitor visitor class.
+inline StoreOutputParameterVisitor::StoreOutputParameterVisitor(
+    std::vector<arma::mat>& parameter, size_t& position) :
+    parameter(parameter),
+    position(position)
+{
+  /* Nothing to do here. */
+}
+
+template<typename LayerType>
+inline void StoreOutputParameterVisitor::operator()(LayerType* layer) const
+{
+  OutputParameter(layer);
+}
+
+inline void StoreOutputParameterVisitor::operator()(MoreTypes layer) const
+{
+  layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasModelCheck<T>::value, void>::type
+StoreOutputParameterVisitor::OutputParameter(T* layer) const
+{
+  // Overwriting an existing entry of matching size reuses its memory.
+  if (position < parameter.size())
+    parameter[position] = layer->OutputParameter();
+  else
+    parameter.push_back(layer->OutputParameter());
+
+  ++position;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasModelCheck<T>::value, void>::type
+StoreOutputParameterVisitor::OutputParameter(T* layer) const
+{
+  // Overwriting an existing entry of matching size reuses its memory.
+  if (position < parameter.size())
+    parameter[position] = layer->OutputParameter();
+  else
+    parameter.push_back(layer->OutputParameter());
+
+  ++position;
+
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(StoreOutputParameterVisitor(parameter, position),
+        layer->Model()[i]);
+  }
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
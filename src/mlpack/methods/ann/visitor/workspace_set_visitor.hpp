@@ -0,0 +1,72 @@
+/**
+ * @file methods/ann/visitor/workspace_set_visitor.hpp
+ *
+ * This file provides an abstraction to move the output and delta buffers of
+ * different layers into a shared workspace block and automatically directs
+ * any parameter to the right layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_WORKSPACE_SET_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_WORKSPACE_SET_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * WorkspaceSetVisitor updates the output parameter and delta buffers of the
+ * given module (and of its sub-modules) to alias consecutive slices of the
+ * given workspace matrix, starting at the given offset.  The shape and the
+ * contents of each buffer are preserved; a buffer that the layer resizes
+ * afterwards detaches from the workspace and falls back to its own memory.
+ */
+class WorkspaceSetVisitor : public boost::static_visitor<size_t>
+{
+ public:
+  //! Update the buffers of the given module and return the consumed size.
+  WorkspaceSetVisitor(arma::mat& workspace, const size_t offset = 0);
+
+  //! Update the buffers of the given module.
+  template<typename LayerType>
+  size_t operator()(LayerType* layer) const;
+
+  size_t operator()(MoreTypes layer) const;
+
+ private:
+  //! Move the given buffer into the workspace at the given relative offset.
+  size_t SetBuffer(arma::mat& buffer, const size_t bufferOffset) const;
+
+  //! Update the buffers of the sub-modules.
+  template<typename T>
+  typename std::enable_if<
+      HasModelCheck<T>::value, size_t>::type
+  LayerWorkspace(T* layer, const size_t layerOffset) const;
+
+  //! Do not need to update anything.
+  template<typename T>
+  typename std::enable_if<
+      !HasModelCheck<T>::value, size_t>::type
+  LayerWorkspace(T* layer, const size_t layerOffset) const;
+
+  //! The workspace matrix the buffers are moved into.
+  arma::mat& workspace;
+
+  //! The offset (in elements) the first buffer is placed at.
+  const size_t offset;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "workspace_set_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,85 @@
+/**
+ * @file methods/ann/visitor/workspace_set_visitor_impl.hpp
+ *
+ * Implementation of the buffer placement function layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_WORKSPACE_SET_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_WORKSPACE_SET_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "workspace_set_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! WorkspaceSetVisitor visitor class.
+inline WorkspaceSetVisitor::WorkspaceSetVisitor(arma::mat& workspace,
+                                                const size_t offset) :
+    workspace(workspace),
+    offset(offset)
+{
+  /* Nothing to do here. */
+}
+
+template<typename LayerType>
+inline size_t WorkspaceSetVisitor::operator()(LayerType* layer) const
+{
+  size_t used = SetBuffer(layer->OutputParameter(), 0);
+  used += SetBuffer(layer->Delta(), used);
+  return used + LayerWorkspace(layer, used);
+}
+
+inline size_t WorkspaceSetVisitor::operator()(MoreTypes layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+inline size_t WorkspaceSetVisitor::SetBuffer(arma::mat& buffer,
+                                             const size_t bufferOffset) const
+{
+  if (buffer.n_elem == 0)
+    return 0;
+
+  // Copy the current contents into the workspace slice before handing the
+  // aliased slice to the layer.
+  arma::mat alias(workspace.memptr() + offset + bufferOffset, buffer.n_rows,
+      buffer.n_cols, false, false);
+  alias = buffer;
+  buffer = std::move(alias);
+
+  return buffer.n_elem;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasModelCheck<T>::value, size_t>::type
+WorkspaceSetVisitor::LayerWorkspace(T* layer, const size_t layerOffset) const
+{
+  size_t modelOffset = 0;
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    modelOffset += boost::apply_visitor(WorkspaceSetVisitor(workspace,
+        offset + layerOffset + modelOffset), layer->Model()[i]);
+  }
+
+  return modelOffset;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasModelCheck<T>::value, size_t>::type
+WorkspaceSetVisitor::LayerWorkspace(T* /* layer */,
+                                    const size_t /* layerOffset */) const
+{
+  return 0;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
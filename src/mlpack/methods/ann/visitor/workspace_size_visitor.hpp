@@ -0,0 +1,59 @@
+/**
+ * @file methods/ann/visitor/workspace_size_visitor.hpp
+ *
+ * This file provides an abstraction to measure the size of the output and
+ * delta buffers of different layers and automatically directs any parameter
+ * to the right layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_WORKSPACE_SIZE_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_WORKSPACE_SIZE_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * WorkspaceSizeVisitor returns the number of elements held in the output
+ * parameter and delta buffers of the given module, including any sub-modules.
+ * The traversal order matches WorkspaceSetVisitor, so the returned size is
+ * exactly the workspace that WorkspaceSetVisitor consumes.
+ */
+class WorkspaceSizeVisitor : public boost::static_visitor<size_t>
+{
+ public:
+  //! Return the buffer size (in elements) of the given module.
+  template<typename LayerType>
+  size_t operator()(LayerType* layer) const;
+
+  size_t operator()(MoreTypes layer) const;
+
+ private:
+  //! Add up the buffer sizes of the sub-modules.
+  template<typename T>
+  typename std::enable_if<
+      HasModelCheck<T>::value, size_t>::type
+  LayerSize(T* layer) const;
+
+  //! Do not need to add anything.
+  template<typename T>
+  typename std::enable_if<
+      !HasModelCheck<T>::value, size_t>::type
+  LayerSize(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "workspace_size_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file methods/ann/visitor/workspace_size_visitor_impl.hpp
+ *
+ * Implementation of the buffer size function layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_WORKSPACE_SIZE_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_WORKSPACE_SIZE_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "workspace_size_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! WorkspaceSizeVisitor visitor class.
+template<typename LayerType>
+inline size_t WorkspaceSizeVisitor::operator()(LayerType* layer) const
+{
+  return layer->OutputParameter().n_elem + layer->Delta().n_elem +
+      LayerSize(layer);
+}
+
+inline size_t WorkspaceSizeVisitor::operator()(MoreTypes layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasModelCheck<T>::value, size_t>::type
+WorkspaceSizeVisitor::LayerSize(T* layer) const
+{
+  size_t modelSize = 0;
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    modelSize += boost::apply_visitor(WorkspaceSizeVisitor(),
+        layer->Model()[i]);
+  }
+
+  return modelSize;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasModelCheck<T>::value, size_t>::type
+WorkspaceSizeVisitor::LayerSize(T* /* layer */) const
+{
+  return 0;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
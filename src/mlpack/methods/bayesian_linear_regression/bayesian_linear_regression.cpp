@@ -16,6 +16,70 @@
 using namespace mlpack;
 using namespace mlpack::regression;
 
+namespace {
+
+/**
+ * Rank-1 update of an upper-triangular Cholesky factor:
+ * R'^T R' = R^T R + x x^T, computed in O(P^2) with Givens rotations.  x is
+ * taken by value because it is overwritten during the sweep.
+ */
+void CholUpdate(arma::mat& matR, arma::colvec x)
+{
+  const size_t n = x.n_elem;
+  for (size_t k = 0; k < n; ++k)
+  {
+    const double r = std::sqrt(matR(k, k) * matR(k, k) + x[k] * x[k]);
+    if (r == 0.0)
+      continue;
+
+    const double c = matR(k, k) / r;
+    const double s = x[k] / r;
+    matR(k, k) = r;
+    for (size_t j = k + 1; j < n; ++j)
+    {
+      const double rkj = matR(k, j);
+      matR(k, j) = c * rkj + s * x[j];
+      x[j] = c * x[j] - s * rkj;
+    }
+  }
+}
+
+/**
+ * Rank-1 downdate of an upper-triangular Cholesky factor:
+ * R'^T R' = R^T R - x x^T.  Returns false if the downdated matrix would not
+ * be positive semidefinite, which means x was not part of the factored sum.
+ */
+bool CholDowndate(arma::mat& matR, arma::colvec x)
+{
+  const size_t n = x.n_elem;
+  for (size_t k = 0; k < n; ++k)
+  {
+    if (matR(k, k) == 0.0)
+    {
+      if (x[k] != 0.0)
+        return false;
+      continue;
+    }
+
+    const double d2 = matR(k, k) * matR(k, k) - x[k] * x[k];
+    if (d2 <= 0.0)
+      return false;
+
+    const double r = std::sqrt(d2);
+    const double c = r / matR(k, k);
+    const double s = x[k] / matR(k, k);
+    matR(k, k) = r;
+    for (size_t j = k + 1; j < n; ++j)
+    {
+      matR(k, j) = (matR(k, j) - s * x[j]) / c;
+      x[j] = c * x[j] - s * matR(k, j);
+    }
+  }
+  return true;
+}
+
+} // namespace
+
 BayesianLinearRegression::BayesianLinearRegression(const bool centerData,
                                                    const bool scaleData,
                                                    const size_t maxIterations,
@@ -27,7 +91,10 @@ BayesianLinearRegression::BayesianLinearRegression(const bool centerData,
   responsesOffset(0.0),
   alpha(0.0),
   beta(0.0),
-  gamma(0.0)
+  gamma(0.0),
+  responsesSum(0.0),
+  responsesSquaredSum(0.0),
+  nPoints(0)
 {/* Nothing to do */}
 
 double BayesianLinearRegression::Train(const arma::mat& data,
@@ -41,12 +108,37 @@ double BayesianLinearRegression::Train(const arma::mat& data,
   // Preprocess the data. Center and scale.
   responsesOffset = CenterScaleData(data, responses, phi, t);
 
-  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phi * phi.t())))
+  const arma::mat gram = arma::symmatu(phi * phi.t());
+  if (!arma::eig_sym(eigVal, eigVec, gram))
   {
     Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
                << "of covariance failed!" << std::endl;
   }
 
+  // Maintain the sufficient statistics of the window so that the model can
+  // later be updated with AddPoint()/RemovePoint() and refit with Retrain().
+  // Centering and scaling change with every point, so the incremental
+  // statistics are only kept for the raw-data configuration.
+  if (!centerData && !scaleData)
+  {
+    if (!arma::chol(matR, gram))
+    {
+      // The Gram matrix is rank-deficient; build the factor by rank-1
+      // updates from zero instead.
+      matR.zeros(data.n_rows, data.n_rows);
+      for (size_t j = 0; j < phi.n_cols; ++j)
+        CholUpdate(matR, phi.col(j));
+    }
+    phiResponses = phi * t.t();
+    responsesSum = accu(t);
+    responsesSquaredSum = dot(t, t);
+    nPoints = data.n_cols;
+  }
+  else
+  {
+    matR.reset();
+  }
+
   // Compute this quantities once and for all.
   const arma::mat eigVecInv = inv(eigVec);
   const arma::colvec eigVecInvPhitT = eigVecInv * phi * t.t();
@@ -86,6 +178,120 @@ double BayesianLinearRegression::Train(const arma::mat& data,
   return RMSE(data, responses);
 }
 
+void BayesianLinearRegression::AddPoint(const arma::colvec& point,
+                                        const double response)
+{
+  if (centerData || scaleData)
+  {
+    Log::Fatal << "BayesianLinearRegression::AddPoint(): incremental updates "
+               << "require centerData and scaleData to be false!" << std::endl;
+  }
+
+  // Start a fresh window if no statistics exist yet (or the dimensionality
+  // changed).
+  if (matR.n_rows != point.n_elem)
+  {
+    matR.zeros(point.n_elem, point.n_elem);
+    phiResponses.zeros(point.n_elem);
+    responsesSum = 0.0;
+    responsesSquaredSum = 0.0;
+    nPoints = 0;
+  }
+
+  CholUpdate(matR, point);
+  phiResponses += response * point;
+  responsesSum += response;
+  responsesSquaredSum += response * response;
+  ++nPoints;
+}
+
+void BayesianLinearRegression::RemovePoint(const arma::colvec& point,
+                                           const double response)
+{
+  if (matR.n_rows != point.n_elem || nPoints == 0)
+  {
+    Log::Fatal << "BayesianLinearRegression::RemovePoint(): no maintained "
+               << "statistics to remove the point from; call Train() or "
+               << "AddPoint() first!" << std::endl;
+  }
+
+  if (!CholDowndate(matR, point))
+  {
+    Log::Fatal << "BayesianLinearRegression::RemovePoint(): downdating the "
+               << "Cholesky factor failed; the point is not part of the "
+               << "current window!" << std::endl;
+  }
+  phiResponses -= response * point;
+  responsesSum -= response;
+  responsesSquaredSum -= response * response;
+  --nPoints;
+}
+
+double BayesianLinearRegression::Retrain()
+{
+  if (matR.n_rows == 0 || nPoints == 0)
+  {
+    Log::Fatal << "BayesianLinearRegression::Retrain(): no maintained "
+               << "statistics to refit from; call Train() or AddPoint() "
+               << "first!" << std::endl;
+  }
+
+  arma::colvec eigVal;
+  arma::mat eigVec;
+  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(matR.t() * matR)))
+  {
+    Log::Fatal << "BayesianLinearRegression::Retrain(): Eigendecomposition "
+               << "of covariance failed!" << std::endl;
+  }
+
+  const arma::colvec eigVecPhitT = eigVec.t() * phiResponses;
+
+  // Warm-start from the previous hyperparameters if a fit exists; after a
+  // small change to the window the loop then converges in very few
+  // iterations.
+  if (beta == 0.0)
+  {
+    const double responsesVar = responsesSquaredSum / nPoints -
+        std::pow(responsesSum / nPoints, 2.0);
+    alpha = 1e-6;
+    beta = 1 / (std::max(responsesVar, 1e-16) * 0.1);
+  }
+
+  unsigned short i = 0;
+  double crit = 1.0, residual = 0.0;
+
+  while ((crit > tolerance) && (i < maxIterations))
+  {
+    double deltaAlpha = -alpha, deltaBeta = -beta;
+
+    // Update the solution.
+    omega = eigVec * diagmat(1 / (eigVal + (alpha / beta))) * eigVecPhitT;
+
+    // Update alpha.
+    gamma = sum(eigVal / (alpha / beta + eigVal));
+    alpha = gamma / dot(omega, omega);
+
+    // Update beta.  The squared residual of the window follows from the
+    // sufficient statistics alone: ||t - omega^T phi||^2 =
+    // t t^T - 2 omega^T (phi t^T) + ||R omega||^2.
+    const arma::colvec rOmega = matR * omega;
+    residual = std::max(responsesSquaredSum - 2.0 * dot(omega, phiResponses) +
+        dot(rOmega, rOmega), 0.0);
+    beta = (nPoints - gamma) / residual;
+
+    // Compute the stopping criterion.
+    deltaAlpha += alpha;
+    deltaBeta += beta;
+    crit = std::abs(deltaAlpha / alpha + deltaBeta / beta);
+    i++;
+  }
+  // Compute the covariance matrix for the uncertainties later.
+  matCovariance = eigVec * diagmat(1 / (beta * eigVal + alpha)) * eigVec.t();
+  responsesOffset = 0.0;
+
+  return std::sqrt(residual / nPoints);
+}
+
 void BayesianLinearRegression::Predict(const arma::mat& points,
                                        arma::rowvec& predictions) const
 {
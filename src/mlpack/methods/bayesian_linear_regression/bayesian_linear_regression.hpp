@@ -129,6 +129,44 @@ class BayesianLinearRegression
   double Train(const arma::mat& data,
                const arma::rowvec& responses);
 
+  /**
+   * Add a single point to the maintained sufficient statistics of the model,
+   * updating the Cholesky factor of the Gram matrix with a rank-1 update in
+   * O(P^2) time.  The model parameters are not refit; call Retrain() once the
+   * window has been updated.  This interface requires centerData and
+   * scaleData to be false, because the offsets of a centered model change
+   * with every point.  If Train() was not called before, the statistics start
+   * from an empty window.
+   *
+   * @param point Data point to add, dim(P).
+   * @param response Target value of the point.
+   */
+  void AddPoint(const arma::colvec& point, const double response);
+
+  /**
+   * Remove a single point from the maintained sufficient statistics,
+   * downdating the Cholesky factor of the Gram matrix in O(P^2) time.  The
+   * point must have been added before (by Train() or AddPoint()); removing a
+   * point that is not part of the window makes the Gram matrix indefinite and
+   * is reported as a fatal error.  The model parameters are not refit; call
+   * Retrain() once the window has been updated.
+   *
+   * @param point Data point to remove, dim(P).
+   * @param response Target value of the point.
+   */
+  void RemovePoint(const arma::colvec& point, const double response);
+
+  /**
+   * Refit the model from the maintained sufficient statistics, without
+   * touching the original data.  The evidence maximization is warm-started
+   * from the current alpha and beta, so after a small change to the window
+   * (a few calls to AddPoint()/RemovePoint()) it typically converges in one
+   * or two iterations.  Train() or AddPoint() must have been called before.
+   *
+   * @return Root mean squared error on the points of the current window.
+   */
+  double Retrain();
+
   /**
    * Predict \f$y_{i}\f$ for each data point in the given data matrix using the
    * currently-trained Bayesian Ridge model.
@@ -282,6 +320,25 @@ class BayesianLinearRegression
   //! Covariance matrix of the solution vector omega.
   arma::mat matCovariance;
 
+  //! Upper-triangular Cholesky factor of the Gram matrix of the current
+  //! window, maintained by AddPoint()/RemovePoint().  Empty if the
+  //! incremental statistics are not available (e.g. the model was trained
+  //! with centering or scaling).  This is rebuildable state and is not
+  //! serialized.
+  arma::mat matR;
+
+  //! Running value of phi * t^T over the current window.
+  arma::colvec phiResponses;
+
+  //! Running sum of the responses of the current window.
+  double responsesSum;
+
+  //! Running sum of the squared responses of the current window.
+  double responsesSquaredSum;
+
+  //! Number of points in the current window.
+  size_t nPoints;
+
   /**
    * Center and scale the data accordind to centerData and scaleData.
    * Allows future modifications of new points.
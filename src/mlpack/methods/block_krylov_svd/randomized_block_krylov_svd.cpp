@@ -65,7 +65,9 @@ void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
   // Create a working matrix using data from writable auxiliary memory
   // (K matrix). Doing so avoids an uncessary copy in upcoming step.
   block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
-  arma::qr_econ(block, R, data * G);
+  arma::mat product, temp;
+  Multiply(data, G, product);
+  arma::qr_econ(block, R, product);
 
   for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
       blockOffset += block.n_elem)
@@ -74,7 +76,11 @@ void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
     blockIteration = arma::mat(K.memptr() + blockOffset, block.n_rows,
         block.n_cols, false, false);
 
-    arma::qr_econ(blockIteration, R, data * (data.t() * block));
+    // The two multiply stages run over block panels in parallel; the QR
+    // factorization of the narrow result stays sequential.
+    MultiplyTranspose(data, block, temp);
+    Multiply(data, temp, product);
+    arma::qr_econ(blockIteration, R, product);
 
     // Update working matrix for the next iteration.
     block = arma::mat(K.memptr() + blockOffset, block.n_rows, block.n_cols,
@@ -83,8 +89,11 @@ void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
 
   arma::qr_econ(Q, R, K);
 
-  // Approximate eigenvalues and eigenvectors using Rayleigh-Ritz method.
-  arma::svd_econ(u, s, v, Q.t() * data);
+  // Approximate eigenvalues and eigenvectors using Rayleigh-Ritz method.  The
+  // projection touches every data column, so it is computed over column
+  // panels of the data in parallel.
+  MultiplyTranspose(Q, data, temp);
+  arma::svd_econ(u, s, v, temp);
 
   // Do economical singular value decomposition and compute only the
   // approximations of the left singular vectors by using the centered data
@@ -92,5 +101,41 @@ void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
   u = Q * u;
 }
 
+void RandomizedBlockKrylovSVD::Multiply(const arma::mat& data,
+                                        const arma::mat& other,
+                                        arma::mat& out)
+{
+  // Panels of 32 columns; each panel is an independent GEMM.
+  const size_t panel = 32;
+  const size_t panels = (other.n_cols + panel - 1) / panel;
+  out.set_size(data.n_rows, other.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) panels; ++b)
+  {
+    const size_t first = b * panel;
+    const size_t last = std::min(first + panel, (size_t) other.n_cols) - 1;
+    out.cols(first, last) = data * other.cols(first, last);
+  }
+}
+
+void RandomizedBlockKrylovSVD::MultiplyTranspose(const arma::mat& data,
+                                                 const arma::mat& other,
+                                                 arma::mat& out)
+{
+  // Panels of 32 columns; each panel is an independent GEMM.
+  const size_t panel = 32;
+  const size_t panels = (other.n_cols + panel - 1) / panel;
+  out.set_size(data.n_cols, other.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) panels; ++b)
+  {
+    const size_t first = b * panel;
+    const size_t last = std::min(first + panel, (size_t) other.n_cols) - 1;
+    out.cols(first, last) = data.t() * other.cols(first, last);
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
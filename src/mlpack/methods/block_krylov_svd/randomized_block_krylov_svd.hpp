@@ -115,6 +115,30 @@ class RandomizedBlockKrylovSVD
   size_t& BlockSize() { return blockSize; }
 
  private:
+  /**
+   * Compute out = data * other over column panels of other, with the
+   * independent panels distributed across the OpenMP team.
+   *
+   * @param data Data matrix.
+   * @param other Matrix to multiply with.
+   * @param out Resulting product.
+   */
+  void Multiply(const arma::mat& data,
+                const arma::mat& other,
+                arma::mat& out);
+
+  /**
+   * Compute out = data^T * other over column panels of other, with the
+   * independent panels distributed across the OpenMP team.
+   *
+   * @param data Data matrix.
+   * @param other Matrix to multiply with.
+   * @param out Resulting product.
+   */
+  void MultiplyTranspose(const arma::mat& data,
+                         const arma::mat& other,
+                         arma::mat& out);
+
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
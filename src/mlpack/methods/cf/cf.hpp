@@ -143,6 +143,60 @@ class CFType
              const double minResidue = 1e-5,
              const bool mit = false);
 
+  /**
+   * Incorporate a new user into the trained model without refactorizing: the
+   * user's latent vector is computed with one regularized least-squares
+   * solve against the fixed item factors and appended to the user matrix H.
+   * The new user gets the next free user ID (the previous number of users).
+   * The given ratings are also appended to the stored rating matrix, and the
+   * model is marked as pending refactorization (see FoldInPending() and
+   * Refactorize()).
+   *
+   * The folded-in vector is an approximation: the item factors are not
+   * updated, so the model should be refactorized in batch once enough users
+   * or items have been folded in.  The ratings are expected on the same
+   * (normalized) scale as the data the model was trained on.
+   *
+   * @param items IDs of the items the new user has rated.
+   * @param ratings The corresponding ratings.
+   * @param lambda Regularization weight of the least-squares solve, scaled
+   *     by the number of given ratings.
+   * @return The ID assigned to the new user.
+   */
+  size_t FoldInUser(const arma::Col<size_t>& items,
+                    const arma::vec& ratings,
+                    const double lambda = 0.06);
+
+  /**
+   * Incorporate a new item into the trained model without refactorizing; the
+   * mirror image of FoldInUser().  The item's latent vector is solved
+   * against the fixed user factors and appended to the item matrix W.
+   *
+   * @param users IDs of the users that have rated the new item.
+   * @param ratings The corresponding ratings.
+   * @param lambda Regularization weight of the least-squares solve, scaled
+   *     by the number of given ratings.
+   * @return The ID assigned to the new item.
+   */
+  size_t FoldInItem(const arma::Col<size_t>& users,
+                    const arma::vec& ratings,
+                    const double lambda = 0.06);
+
+  //! Whether users or items have been folded in since the last (re)training.
+  bool FoldInPending() const { return foldInPending; }
+
+  /**
+   * Refactorize the model in batch over the stored rating matrix, including
+   * all folded-in users and items, and clear the pending flag.
+   *
+   * @param maxIterations Maximum number of iterations.
+   * @param minResidue Residue required to terminate.
+   * @param mit Whether to terminate only when maxIterations is reached.
+   */
+  void Refactorize(const size_t maxIterations = 1000,
+                   const double minResidue = 1e-5,
+                   const bool mit = false);
+
   //! Sets number of users for calculating similarity.
   void NumUsersForSimilarity(const size_t num)
   {
@@ -257,12 +311,92 @@ class CFType
                arma::vec& predictions) const;
 
   /**
-   * Serialize the CFType model to the given archive.
+   * Build the materialized neighbor cache: compute and store the neighborhood
+   * (and similarities) of every user once, so that subsequent calls to
+   * GetRecommendations() and Predict() reduce to a table lookup plus
+   * interpolation instead of a fresh neighbor search.  The cache is
+   * invalidated by Train() and Refactorize(); folded-in users are not covered
+   * until UpdateNeighborCache() or BuildNeighborCache() is called for them,
+   * and queries involving uncovered users fall back to a fresh search.
+   *
+   * It is the caller's responsibility to query with the same
+   * NeighborSearchPolicy the cache was built with; the cached neighborhoods
+   * are served regardless of the policy given at query time.
+   *
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   */
+  template<typename NeighborSearchPolicy = EuclideanSearch>
+  void BuildNeighborCache();
+
+  /**
+   * Incrementally refresh the neighbor cache for the given users only: the
+   * cache is grown to the current number of users and the listed columns are
+   * recomputed, leaving all other cached neighborhoods untouched.  This is
+   * meant to be called after FoldInUser(), with the IDs of the folded-in
+   * users.  If no cache has been built yet, the full cache is built instead.
+   *
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   *
+   * @param users Users whose cached neighborhood should be recomputed.
+   */
+  template<typename NeighborSearchPolicy = EuclideanSearch>
+  void UpdateNeighborCache(const arma::Col<size_t>& users);
+
+  //! Whether a valid neighbor cache is available.
+  bool NeighborCacheValid() const { return neighborCacheValid; }
+
+  /**
+   * Serialize the CFType model to the given archive.  This stores the full
+   * model in the same layout older mlpack versions used, so existing archives
+   * remain loadable; SerializeHot() and SerializeCold() are separate partial
+   * formats, not halves of this one.
    */
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
 
+  /**
+   * Serialize only the serving-time (hot) part of the model: the item-side
+   * factors of the decomposition and the materialized neighbor cache, plus
+   * the scalar parameters.  A serving instance that loads only this part can
+   * answer Predict() and GetRecommendations() calls for cached users without
+   * ever paying for the user factors or the rating data.
+   */
+  template<typename Archive>
+  void SerializeHot(Archive& ar);
+
+  /**
+   * Serialize only the training-tier (cold) part of the model: the user-side
+   * factors of the decomposition, the cleaned rating data and the
+   * normalization state.  Together with the hot part this reconstructs the
+   * full model; on its own it is only useful for continued training.
+   */
+  template<typename Archive>
+  void SerializeCold(Archive& ar);
+
  private:
+  /**
+   * Check whether the neighbor cache is valid and covers all of the given
+   * users (it may not cover users folded in after the cache was built).
+   *
+   * @param users Users to be looked up in the cache.
+   */
+  bool NeighborCacheCovers(const arma::Col<size_t>& users) const
+  {
+    if (!neighborCacheValid ||
+        cachedNeighborhood.n_rows != numUsersForSimilarity)
+      return false;
+
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      if (users(i) >= cachedNeighborhood.n_cols)
+        return false;
+    }
+
+    return true;
+  }
+
   //! Number of users for similarity.
   size_t numUsersForSimilarity;
   //! Rank used for matrix factorization.
@@ -273,6 +407,14 @@ class CFType
   arma::sp_mat cleanedData;
   //! Data normalization object.
   NormalizationType normalization;
+  //! Whether users or items have been folded in since the last training.
+  bool foldInPending = false;
+  //! Whether the materialized neighbor cache is valid.
+  bool neighborCacheValid = false;
+  //! Cached neighborhood of each user (column u holds the neighbors of u).
+  arma::Mat<size_t> cachedNeighborhood;
+  //! Cached similarities corresponding to cachedNeighborhood.
+  arma::mat cachedSimilarities;
 
   //! Candidate represents a possible recommendation (value, item).
   typedef std::pair<double, size_t> Candidate;
@@ -109,6 +109,8 @@ Train(const arma::mat& data,
   // data matrices.
   this->decomposition.Apply(
       normalizedData, cleanedData, rank, maxIterations, minResidue, mit);
+  foldInPending = false;
+  neighborCacheValid = false;
 }
 
 // Train when data is given as sparse matrix of user item table.
@@ -148,6 +150,179 @@ Train(const arma::sp_mat& data,
   // data matrices.
   this->decomposition.Apply(
       data, cleanedData, rank, maxIterations, minResidue, mit);
+  foldInPending = false;
+  neighborCacheValid = false;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+size_t CFType<DecompositionPolicy,
+              NormalizationType>::
+FoldInUser(const arma::Col<size_t>& items,
+           const arma::vec& ratings,
+           const double lambda)
+{
+  if (items.n_elem != ratings.n_elem)
+  {
+    throw std::invalid_argument("CFType::FoldInUser(): number of items and "
+        "number of ratings must be the same!");
+  }
+  if (items.n_elem == 0)
+  {
+    throw std::invalid_argument("CFType::FoldInUser(): at least one rating "
+        "is required to fold in a user!");
+  }
+
+  const arma::mat& w = decomposition.W();
+
+  // Solve the regularized least-squares problem of the new user against the
+  // fixed item factors.
+  arma::mat gram(w.n_cols, w.n_cols, arma::fill::zeros);
+  arma::vec rhs(w.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < items.n_elem; ++i)
+  {
+    if (items(i) >= w.n_rows)
+    {
+      throw std::invalid_argument("CFType::FoldInUser(): item ID out of "
+          "range!");
+    }
+
+    const arma::vec wi = w.row(items(i)).t();
+    gram += wi * wi.t();
+    rhs += ratings(i) * wi;
+  }
+  gram.diag() += lambda * items.n_elem;
+
+  const size_t newUser = decomposition.H().n_cols;
+  decomposition.H().insert_cols(newUser, arma::solve(gram, rhs));
+
+  // Store the ratings, so a later batch refactorization sees the new user.
+  cleanedData.resize(cleanedData.n_rows, newUser + 1);
+  for (size_t i = 0; i < items.n_elem; ++i)
+    cleanedData(items(i), newUser) = ratings(i);
+
+  foldInPending = true;
+  return newUser;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+size_t CFType<DecompositionPolicy,
+              NormalizationType>::
+FoldInItem(const arma::Col<size_t>& users,
+           const arma::vec& ratings,
+           const double lambda)
+{
+  if (users.n_elem != ratings.n_elem)
+  {
+    throw std::invalid_argument("CFType::FoldInItem(): number of users and "
+        "number of ratings must be the same!");
+  }
+  if (users.n_elem == 0)
+  {
+    throw std::invalid_argument("CFType::FoldInItem(): at least one rating "
+        "is required to fold in an item!");
+  }
+
+  const arma::mat& h = decomposition.H();
+
+  // Solve the regularized least-squares problem of the new item against the
+  // fixed user factors.
+  arma::mat gram(h.n_rows, h.n_rows, arma::fill::zeros);
+  arma::vec rhs(h.n_rows, arma::fill::zeros);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (users(i) >= h.n_cols)
+    {
+      throw std::invalid_argument("CFType::FoldInItem(): user ID out of "
+          "range!");
+    }
+
+    gram += h.col(users(i)) * h.col(users(i)).t();
+    rhs += ratings(i) * h.col(users(i));
+  }
+  gram.diag() += lambda * users.n_elem;
+
+  const size_t newItem = decomposition.W().n_rows;
+  decomposition.W().insert_rows(newItem,
+      arma::solve(gram, rhs).t());
+
+  // Store the ratings, so a later batch refactorization sees the new item.
+  cleanedData.resize(newItem + 1, cleanedData.n_cols);
+  for (size_t i = 0; i < users.n_elem; ++i)
+    cleanedData(newItem, users(i)) = ratings(i);
+
+  foldInPending = true;
+  return newItem;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+Refactorize(const size_t maxIterations,
+            const double minResidue,
+            const bool mit)
+{
+  // The stored rating matrix already contains all folded-in users and items
+  // and is already normalized.
+  decomposition.Apply(
+      cleanedData, cleanedData, rank, maxIterations, minResidue, mit);
+  foldInPending = false;
+  neighborCacheValid = false;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+BuildNeighborCache()
+{
+  // Query the neighborhood of every user once; GetRecommendations() and
+  // Predict() will serve lookups from the cached columns.
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+      users, numUsersForSimilarity, cachedNeighborhood, cachedSimilarities);
+
+  neighborCacheValid = true;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+UpdateNeighborCache(const arma::Col<size_t>& users)
+{
+  // Without an existing cache there is nothing to refresh incrementally.
+  if (!neighborCacheValid)
+  {
+    BuildNeighborCache<NeighborSearchPolicy>();
+    return;
+  }
+
+  // Grow the cache to the current number of users (folded-in users may have
+  // been added since the cache was built); the new columns are only valid
+  // once they have been recomputed below.
+  if (cachedNeighborhood.n_cols < cleanedData.n_cols)
+  {
+    cachedNeighborhood.resize(numUsersForSimilarity, cleanedData.n_cols);
+    cachedSimilarities.resize(numUsersForSimilarity, cleanedData.n_cols);
+  }
+
+  arma::Mat<size_t> neighborhood;
+  arma::mat similarities;
+  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+      users, numUsersForSimilarity, neighborhood, similarities);
+
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    cachedNeighborhood.col(users(i)) = neighborhood.col(i);
+    cachedSimilarities.col(users(i)) = similarities.col(i);
+  }
 }
 
 template<typename DecompositionPolicy,
@@ -189,10 +364,23 @@ GetRecommendations(const size_t numRecs,
   // Calculate the neighborhood of the queried users.  Note that the query user
   // is part of the neighborhood---this is intentional.  We want to use the
   // weighted sum of both the query user and the local neighborhood of the
-  // query user.
-  // Calculate the neighborhood of the queried users.
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  // query user.  If a materialized neighbor cache covers all queried users,
+  // the neighborhoods are gathered from it instead of running a fresh search.
+  if (NeighborCacheCovers(users))
+  {
+    neighborhood.set_size(numUsersForSimilarity, users.n_elem);
+    similarities.set_size(numUsersForSimilarity, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      neighborhood.col(i) = cachedNeighborhood.col(users(i));
+      similarities.col(i) = cachedSimilarities.col(users(i));
+    }
+  }
+  else
+  {
+    decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+        users, numUsersForSimilarity, neighborhood, similarities);
+  }
 
   // Generate recommendations for each query user by finding the maximum numRecs
   // elements in the ratings vector.
@@ -293,8 +481,16 @@ Predict(const size_t user, const size_t item) const
   // Calculate the neighborhood of the queried users.
   arma::Col<size_t> users(1);
   users(0) = user;
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  if (NeighborCacheCovers(users))
+  {
+    neighborhood = cachedNeighborhood.col(user);
+    similarities = cachedSimilarities.col(user);
+  }
+  else
+  {
+    decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+        users, numUsersForSimilarity, neighborhood, similarities);
+  }
 
   arma::vec weights(numUsersForSimilarity);
 
@@ -343,9 +539,23 @@ Predict(const arma::Mat<size_t>& combinations,
   // is part of the neighborhood---this is intentional.  We want to use the
   // weighted sum of both the query user and the local neighborhood of the
   // query user.
-  // Calculate the neighborhood of the queried users.
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  // Calculate the neighborhood of the queried users, from the materialized
+  // cache when it covers all of them.
+  if (NeighborCacheCovers(users))
+  {
+    neighborhood.set_size(numUsersForSimilarity, users.n_elem);
+    similarities.set_size(numUsersForSimilarity, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      neighborhood.col(i) = cachedNeighborhood.col(users(i));
+      similarities.col(i) = cachedSimilarities.col(users(i));
+    }
+  }
+  else
+  {
+    decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+        users, numUsersForSimilarity, neighborhood, similarities);
+  }
 
   arma::mat weights(numUsersForSimilarity, users.n_elem);
 
@@ -426,12 +636,48 @@ void CFType<DecompositionPolicy,
 serialize(Archive& ar, const uint32_t /* version */)
 {
   // This model is simple; just serialize all the members. No special handling
-  // required.
+  // required.  The field order here must not change: binary cereal archives
+  // are order-sensitive, so existing archives dictate this layout.  In
+  // particular this is deliberately not SerializeHot() followed by
+  // SerializeCold(): those interleave the members differently, and exist only
+  // as partial entry points for serving-tier handoff.
   ar(CEREAL_NVP(numUsersForSimilarity));
   ar(CEREAL_NVP(rank));
   ar(CEREAL_NVP(decomposition));
   ar(CEREAL_NVP(cleanedData));
   ar(CEREAL_NVP(normalization));
+  ar(CEREAL_NVP(foldInPending));
+  ar(CEREAL_NVP(neighborCacheValid));
+  ar(CEREAL_NVP(cachedNeighborhood));
+  ar(CEREAL_NVP(cachedSimilarities));
+}
+
+//! Serialize the serving-time (hot) part of the model.
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename Archive>
+void CFType<DecompositionPolicy, NormalizationType>::
+SerializeHot(Archive& ar)
+{
+  ar(CEREAL_NVP(numUsersForSimilarity));
+  ar(CEREAL_NVP(rank));
+  decomposition.SerializeHot(ar);
+  ar(CEREAL_NVP(neighborCacheValid));
+  ar(CEREAL_NVP(cachedNeighborhood));
+  ar(CEREAL_NVP(cachedSimilarities));
+}
+
+//! Serialize the training-tier (cold) part of the model.
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename Archive>
+void CFType<DecompositionPolicy, NormalizationType>::
+SerializeCold(Archive& ar)
+{
+  decomposition.SerializeCold(ar);
+  ar(CEREAL_NVP(cleanedData));
+  ar(CEREAL_NVP(normalization));
+  ar(CEREAL_NVP(foldInPending));
 }
 
 } // namespace cf
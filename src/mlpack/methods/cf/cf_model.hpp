@@ -183,6 +183,19 @@ class CFModel
     Z_SCORE_NORMALIZATION
   };
 
+  /**
+   * The parts of the model that can be serialized independently: the full
+   * model, the serving-time (hot) part---item factors, neighbor cache and
+   * scalar parameters---or the training-tier (cold) part---user factors,
+   * rating data and normalization state.
+   */
+  enum SerializationParts
+  {
+    FULL_MODEL,
+    HOT_PART,
+    COLD_PART
+  };
+
  private:
   //! The current decomposition policy type.
   DecompositionTypes decompositionType;
@@ -270,6 +283,31 @@ class CFModel
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
+
+  /**
+   * Serialize only the serving-time (hot) part of the model: the item
+   * factors, the materialized neighbor cache and the scalar parameters.  A
+   * serving instance can load just this part---a small fraction of the full
+   * model when users vastly outnumber items---while the cold part stays on
+   * the training tier.
+   */
+  template<typename Archive>
+  void SerializeHot(Archive& ar);
+
+  /**
+   * Serialize only the training-tier (cold) part of the model: the user
+   * factors, the cleaned rating data and the normalization state.  Loading
+   * the hot and cold parts into the same model (in either order)
+   * reconstructs the full model.
+   */
+  template<typename Archive>
+  void SerializeCold(Archive& ar);
+
+ private:
+  //! Serialize the given part of the model; the full model, the hot part and
+  //! the cold part all share the type header and the wrapper dispatch.
+  template<typename Archive>
+  void SerializePart(Archive& ar, const SerializationParts part);
 };
 
 } // namespace cf
@@ -267,106 +267,138 @@ inline CFWrapperBase* InitializeModel(
   return NULL;
 };
 
+template<typename DecompositionPolicy,
+         typename NormalizationPolicy,
+         typename Archive>
+void SerializePartHelper(Archive& ar,
+                         CFWrapperBase* cf,
+                         const CFModel::SerializationParts part)
+{
+  CFWrapper<DecompositionPolicy, NormalizationPolicy>& typedModel =
+      dynamic_cast<CFWrapper<DecompositionPolicy, NormalizationPolicy>&>(*cf);
+  switch (part)
+  {
+    case CFModel::FULL_MODEL:
+      ar(CEREAL_NVP(typedModel));
+      break;
+
+    case CFModel::HOT_PART:
+      typedModel.CF().SerializeHot(ar);
+      break;
+
+    case CFModel::COLD_PART:
+      typedModel.CF().SerializeCold(ar);
+      break;
+  }
+}
+
 template<typename DecompositionPolicy, typename Archive>
 void SerializeHelper(Archive& ar,
                      CFWrapperBase* cf,
-                     CFModel::NormalizationTypes normalizationType)
+                     CFModel::NormalizationTypes normalizationType,
+                     const CFModel::SerializationParts part)
 {
   switch (normalizationType)
   {
     case CFModel::NO_NORMALIZATION:
-      {
-        CFWrapper<DecompositionPolicy, NoNormalization>& typedModel =
-            dynamic_cast<CFWrapper<DecompositionPolicy,
-                                   NoNormalization>&>(*cf);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      SerializePartHelper<DecompositionPolicy, NoNormalization>(ar, cf, part);
+      break;
 
     case CFModel::ITEM_MEAN_NORMALIZATION:
-      {
-        CFWrapper<DecompositionPolicy, ItemMeanNormalization>& typedModel =
-            dynamic_cast<CFWrapper<DecompositionPolicy,
-                                   ItemMeanNormalization>&>(*cf);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      SerializePartHelper<DecompositionPolicy, ItemMeanNormalization>(ar, cf,
+          part);
+      break;
 
     case CFModel::USER_MEAN_NORMALIZATION:
-      {
-        CFWrapper<DecompositionPolicy, UserMeanNormalization>& typedModel =
-            dynamic_cast<CFWrapper<DecompositionPolicy,
-                                   UserMeanNormalization>&>(*cf);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      SerializePartHelper<DecompositionPolicy, UserMeanNormalization>(ar, cf,
+          part);
+      break;
 
     case CFModel::OVERALL_MEAN_NORMALIZATION:
-      {
-        CFWrapper<DecompositionPolicy, OverallMeanNormalization>& typedModel =
-            dynamic_cast<CFWrapper<DecompositionPolicy,
-                                   OverallMeanNormalization>&>(*cf);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      SerializePartHelper<DecompositionPolicy, OverallMeanNormalization>(ar,
+          cf, part);
+      break;
 
     case CFModel::Z_SCORE_NORMALIZATION:
-      {
-        CFWrapper<DecompositionPolicy, ZScoreNormalization>& typedModel =
-            dynamic_cast<CFWrapper<DecompositionPolicy,
-                                   ZScoreNormalization>&>(*cf);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      SerializePartHelper<DecompositionPolicy, ZScoreNormalization>(ar, cf,
+          part);
+      break;
   }
 }
 
 template<typename Archive>
 void CFModel::serialize(Archive& ar, const uint32_t /* version */)
 {
+  SerializePart(ar, FULL_MODEL);
+}
+
+template<typename Archive>
+void CFModel::SerializeHot(Archive& ar)
+{
+  SerializePart(ar, HOT_PART);
+}
+
+template<typename Archive>
+void CFModel::SerializeCold(Archive& ar)
+{
+  SerializePart(ar, COLD_PART);
+}
+
+template<typename Archive>
+void CFModel::SerializePart(Archive& ar, const SerializationParts part)
+{
+  const DecompositionTypes oldDecompositionType = decompositionType;
+  const NormalizationTypes oldNormalizationType = normalizationType;
   ar(CEREAL_NVP(decompositionType));
   ar(CEREAL_NVP(normalizationType));
 
-  // This should never happen, but just in case, be clean with memory.
+  // When loading, the held wrapper must match the stored types.  A wrapper
+  // that already has the right type is kept as-is, so that the hot and cold
+  // parts of one model can be loaded one after the other into the same
+  // object.
   if (cereal::is_loading<Archive>())
   {
-    delete cf;
-    cf = InitializeModel(decompositionType, normalizationType);
+    if (cf == NULL || decompositionType != oldDecompositionType ||
+        normalizationType != oldNormalizationType)
+    {
+      delete cf;
+      cf = InitializeModel(decompositionType, normalizationType);
+    }
   }
 
   // Avoid polymorphic serialization by determining the type directly.
   switch (decompositionType)
   {
     case NMF:
-      SerializeHelper<NMFPolicy>(ar, cf, normalizationType);
+      SerializeHelper<NMFPolicy>(ar, cf, normalizationType, part);
       break;
 
     case BATCH_SVD:
-      SerializeHelper<BatchSVDPolicy>(ar, cf, normalizationType);
+      SerializeHelper<BatchSVDPolicy>(ar, cf, normalizationType, part);
       break;
 
     case RANDOMIZED_SVD:
-      SerializeHelper<RandomizedSVDPolicy>(ar, cf, normalizationType);
+      SerializeHelper<RandomizedSVDPolicy>(ar, cf, normalizationType, part);
       break;
 
     case REG_SVD:
-      SerializeHelper<RegSVDPolicy>(ar, cf, normalizationType);
+      SerializeHelper<RegSVDPolicy>(ar, cf, normalizationType, part);
       break;
 
     case SVD_COMPLETE:
-      SerializeHelper<SVDCompletePolicy>(ar, cf, normalizationType);
+      SerializeHelper<SVDCompletePolicy>(ar, cf, normalizationType, part);
       break;
 
     case SVD_INCOMPLETE:
-      SerializeHelper<SVDIncompletePolicy>(ar, cf, normalizationType);
+      SerializeHelper<SVDIncompletePolicy>(ar, cf, normalizationType, part);
       break;
 
     case BIAS_SVD:
-      SerializeHelper<BiasSVDPolicy>(ar, cf, normalizationType);
+      SerializeHelper<BiasSVDPolicy>(ar, cf, normalizationType, part);
       break;
 
     case SVD_PLUS_PLUS:
-      SerializeHelper<SVDPlusPlusPolicy>(ar, cf, normalizationType);
+      SerializeHelper<SVDPlusPlusPolicy>(ar, cf, normalizationType, part);
       break;
   }
 }
@@ -148,16 +148,36 @@ class BatchSVDPolicy
 
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
 
   /**
    * Serialization.
    */
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    SerializeHot(ar);
+    SerializeCold(ar);
+  }
+
+  //! Serialize the serving-time (hot) part of the decomposition: the item
+  //! matrix.
+  template<typename Archive>
+  void SerializeHot(Archive& ar)
   {
     ar(CEREAL_NVP(w));
+  }
+
+  //! Serialize the training-tier (cold) part of the decomposition: the user
+  //! matrix.
+  template<typename Archive>
+  void SerializeCold(Archive& ar)
+  {
     ar(CEREAL_NVP(h));
   }
 
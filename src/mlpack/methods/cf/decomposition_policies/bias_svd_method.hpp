@@ -166,6 +166,9 @@ class BiasSVDPolicy
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
   {
+    // The field order matches existing archives and must not change; the
+    // hot/cold split below groups the members differently and is only used
+    // for partial serialization.
     ar(CEREAL_NVP(maxIterations));
     ar(CEREAL_NVP(alpha));
     ar(CEREAL_NVP(lambda));
@@ -175,6 +178,27 @@ class BiasSVDPolicy
     ar(CEREAL_NVP(q));
   }
 
+  //! Serialize the serving-time (hot) part of the decomposition: the
+  //! hyperparameters, the item matrix and the item bias.
+  template<typename Archive>
+  void SerializeHot(Archive& ar)
+  {
+    ar(CEREAL_NVP(maxIterations));
+    ar(CEREAL_NVP(alpha));
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(p));
+  }
+
+  //! Serialize the training-tier (cold) part of the decomposition: the user
+  //! matrix and the user bias.
+  template<typename Archive>
+  void SerializeCold(Archive& ar)
+  {
+    ar(CEREAL_NVP(h));
+    ar(CEREAL_NVP(q));
+  }
+
  private:
   //! Locally stored number of iterations.
   size_t maxIterations;
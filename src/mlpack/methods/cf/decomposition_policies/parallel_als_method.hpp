@@ -0,0 +1,338 @@
+/**
+ * @file methods/cf/decomposition_policies/parallel_als_method.hpp
+ *
+ * Implementation of the parallel ALS method for use in Collaborative
+ * Filtering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_PARALLEL_ALS_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_PARALLEL_ALS_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Implementation of the parallel ALS policy to act as a wrapper when
+ * accessing alternating least squares from within CFType.
+ *
+ * Unlike the AMF-based policies, which update the whole factor matrices with
+ * global (single-threaded) linear algebra, alternating least squares over
+ * the observed ratings decomposes into one independent regularized
+ * least-squares solve per user column and per item row.  This policy solves
+ * those rank x rank systems across an OpenMP team: each thread keeps its own
+ * Gram matrix and right-hand-side buffers, and both factor matrices are kept
+ * with contiguous rank-sized columns so the Gram accumulation runs down
+ * contiguous memory.  The regularization is weighted by the number of
+ * ratings of each user (item), following the ALS-WR scheme.
+ *
+ * For more information, see the following paper.
+ *
+ * @code
+ * @inproceedings{zhou2008large,
+ *   title     = {Large-scale parallel collaborative filtering for the
+ *                Netflix prize},
+ *   author    = {Zhou, Yunhong and Wilkinson, Dennis and Schreiber, Robert
+ *                and Pan, Rong},
+ *   booktitle = {International Conference on Algorithmic Applications in
+ *                Management},
+ *   pages     = {337--348},
+ *   year      = {2008}
+ * }
+ * @endcode
+ *
+ * An example of how to use ParallelALSPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, rating) table.
+ * // Users for whom recommendations are generated.
+ * extern arma::Col<size_t> users;
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<ParallelALSPolicy> cf(data);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ */
+class ParallelALSPolicy
+{
+ public:
+  /**
+   * Construct the parallel ALS policy.
+   *
+   * @param lambda Regularization weight of the least-squares solves; the
+   *     effective weight of each solve is lambda times the number of
+   *     observed ratings of the user (item).
+   */
+  ParallelALSPolicy(const double lambda = 0.06) : lambda(lambda)
+  {
+    /* Nothing to do here. */
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided data set using the
+   * parallel ALS method.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix(cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Maximum number of iterations.
+   * @param minResidue Residue required to terminate.
+   * @param mit Whether to terminate only when maxIterations is reached.
+   */
+  template<typename MatType>
+  void Apply(const MatType& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit)
+  {
+    const size_t numItems = cleanedData.n_rows;
+    const size_t numUsers = cleanedData.n_cols;
+
+    // The transpose gives contiguous access to the ratings of each item.
+    const arma::sp_mat cleanedDataT = cleanedData.t();
+
+    // Both factors are kept with rank-sized columns (wt is the transpose of
+    // the item matrix), so the per-rating Gram updates run down contiguous
+    // memory.
+    arma::mat wt = arma::randu<arma::mat>(rank, numItems);
+    h = arma::randu<arma::mat>(rank, numUsers);
+
+    double lastRmse = std::numeric_limits<double>::max();
+    for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+    {
+      // Solve for all user columns given the item factors, then for all item
+      // columns given the user factors; the solves within each half-sweep
+      // are independent.
+      SolveFactor(cleanedData, wt, h);
+      SolveFactor(cleanedDataT, h, wt);
+
+      if (!mit)
+      {
+        const double rmse = Rmse(cleanedData, wt, h);
+        const double residue = std::abs(lastRmse - rmse);
+        lastRmse = rmse;
+
+        Log::Info << "ParallelALSPolicy::Apply(): iteration " << iteration
+            << "; rmse " << rmse << ", residue " << residue << "."
+            << std::endl;
+
+        if (residue < minResidue)
+          break;
+      }
+    }
+
+    w = wt.t();
+  }
+
+  /**
+   * Return predicted rating given user ID and item ID.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // We want to avoid calculating the full rating matrix, so we will do
+    // nearest neighbor search only on the H matrix, using the observation that
+    // if the rating matrix X = W*H, then d(X.col(i), X.col(j)) = d(W H.col(i),
+    // W H.col(j)).  This can be seen as nearest neighbor search on the H
+    // matrix with the Mahalanobis distance where M^{-1} = W^T W.  So, we'll
+    // decompose M^{-1} = L L^T (the Cholesky decomposition), and then multiply
+    // H by L^T. Then we can perform nearest neighbor search.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  //! Get the regularization weight.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization weight.
+  double& Lambda() { return lambda; }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    SerializeHot(ar);
+    SerializeCold(ar);
+  }
+
+  //! Serialize the serving-time (hot) part of the decomposition: the
+  //! regularization parameter and the item matrix.
+  template<typename Archive>
+  void SerializeHot(Archive& ar)
+  {
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(w));
+  }
+
+  //! Serialize the training-tier (cold) part of the decomposition: the user
+  //! matrix.
+  template<typename Archive>
+  void SerializeCold(Archive& ar)
+  {
+    ar(CEREAL_NVP(h));
+  }
+
+ private:
+  /**
+   * Solve one half-sweep: recompute every column of the factor from the
+   * observed ratings in the corresponding column of the (item x column)
+   * matrix and the fixed other factor.  Each column is an independent
+   * regularized least-squares problem, so the loop is parallelized and each
+   * thread reuses its own Gram matrix and right-hand-side buffers.
+   *
+   * @param ratings Sparse matrix whose column c holds the observed ratings
+   *     of column c of the factor being solved.
+   * @param fixed The fixed factor (rank x ratings.n_rows).
+   * @param factor The factor to recompute (rank x ratings.n_cols).
+   */
+  void SolveFactor(const arma::sp_mat& ratings,
+                   const arma::mat& fixed,
+                   arma::mat& factor)
+  {
+    const size_t rank = fixed.n_rows;
+
+    #pragma omp parallel
+    {
+      // Per-thread scratch, reused across all solves of this half-sweep.
+      arma::mat gram(rank, rank);
+      arma::vec rhs(rank);
+
+      #pragma omp for
+      for (omp_size_t c = 0; c < (omp_size_t) ratings.n_cols; ++c)
+      {
+        const arma::uword colStart = ratings.col_ptrs[c];
+        const arma::uword colEnd = ratings.col_ptrs[c + 1];
+        if (colStart == colEnd)
+        {
+          // No observed ratings; the regularized solution is zero.
+          factor.col(c).zeros();
+          continue;
+        }
+
+        gram.zeros();
+        rhs.zeros();
+        for (arma::uword pos = colStart; pos < colEnd; ++pos)
+        {
+          const arma::uword row = ratings.row_indices[pos];
+          const double rating = ratings.values[pos];
+
+          gram += fixed.col(row) * fixed.col(row).t();
+          rhs += rating * fixed.col(row);
+        }
+
+        // ALS-WR: weight the regularizer by the number of observed ratings.
+        gram.diag() += lambda * (colEnd - colStart);
+
+        factor.col(c) = arma::solve(gram, rhs);
+      }
+    }
+  }
+
+  /**
+   * Compute the root mean squared error over the observed ratings.
+   *
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param wt Transposed item matrix (rank x items).
+   * @param h User matrix (rank x users).
+   */
+  double Rmse(const arma::sp_mat& cleanedData,
+              const arma::mat& wt,
+              const arma::mat& h) const
+  {
+    double squaredError = 0;
+
+    #pragma omp parallel for reduction(+:squaredError)
+    for (omp_size_t c = 0; c < (omp_size_t) cleanedData.n_cols; ++c)
+    {
+      for (arma::uword pos = cleanedData.col_ptrs[c];
+           pos < cleanedData.col_ptrs[c + 1]; ++pos)
+      {
+        const arma::uword row = cleanedData.row_indices[pos];
+        const double error = cleanedData.values[pos] -
+            arma::dot(wt.col(row), h.col(c));
+        squaredError += error * error;
+      }
+    }
+
+    return std::sqrt(squaredError / cleanedData.n_nonzero);
+  }
+
+  //! Regularization weight of the least-squares solves.
+  double lambda;
+
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
@@ -205,6 +205,9 @@ class SVDPlusPlusPolicy
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
   {
+    // The field order matches existing archives and must not change; the
+    // hot/cold split below groups the members differently and is only used
+    // for partial serialization.
     ar(CEREAL_NVP(maxIterations));
     ar(CEREAL_NVP(alpha));
     ar(CEREAL_NVP(lambda));
@@ -216,6 +219,30 @@ class SVDPlusPlusPolicy
     ar(CEREAL_NVP(implicitData));
   }
 
+  //! Serialize the serving-time (hot) part of the decomposition: the
+  //! hyperparameters and the item-side tables (item matrix, item bias and
+  //! item implicit factors).
+  template<typename Archive>
+  void SerializeHot(Archive& ar)
+  {
+    ar(CEREAL_NVP(maxIterations));
+    ar(CEREAL_NVP(alpha));
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(p));
+    ar(CEREAL_NVP(y));
+  }
+
+  //! Serialize the training-tier (cold) part of the decomposition: the user
+  //! matrix, the user bias and the implicit rating data.
+  template<typename Archive>
+  void SerializeCold(Archive& ar)
+  {
+    ar(CEREAL_NVP(h));
+    ar(CEREAL_NVP(q));
+    ar(CEREAL_NVP(implicitData));
+  }
+
  private:
   //! Locally stored number of iterations.
   size_t maxIterations;
@@ -31,7 +31,13 @@ class AllCategoricalSplit
 {
  public:
   // No extra info needed for split.
-  class AuxiliarySplitInfo { };
+  class AuxiliarySplitInfo
+  {
+   public:
+    //! Nothing to serialize.
+    template<typename Archive>
+    void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+  };
 
   /**
    * Check if we can split a node.  If we can split a node in a way that
@@ -57,45 +57,55 @@ double AllCategoricalSplit<FitnessFunction>::SplitIfBetter(
   if (arma::min(counts) < minimumLeafSize)
     return DBL_MAX;
 
-  // Calculate the gain of the split.  First we have to calculate the labels
-  // that would be assigned to each child.
-  arma::uvec childPositions(numCategories, arma::fill::zeros);
-  std::vector<arma::Row<size_t>> childLabels(numCategories);
-  std::vector<arma::Row<double>> childWeights(numCategories);
-
+  // Calculate the gain of the split.  Instead of extracting each child's
+  // labels into its own buffer, we counting-sort the labels into a single
+  // contiguous buffer grouped by category, and evaluate each child's gain on
+  // a view into that buffer.
+  arma::uvec childPositions(numCategories + 1);
+  childPositions[0] = 0;
   for (size_t i = 0; i < numCategories; ++i)
-  {
-    // Labels and weights should have same length.
-    childLabels[i].zeros(counts[i]);
-    if (UseWeights)
-      childWeights[i].zeros(counts[i]);
-  }
+    childPositions[i + 1] = childPositions[i] + counts[i];
 
-  // Extract labels for each child.
+  arma::Row<size_t> sortedLabels(data.n_elem);
+  arma::Row<double> sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(data.n_elem);
+
+  arma::uvec positions = childPositions.subvec(0, numCategories - 1);
   for (size_t i = 0; i < data.n_elem; ++i)
   {
-    const size_t category = (size_t) data[i];
+    const size_t position = positions[(size_t) data[i]]++;
 
+    sortedLabels[position] = labels[i];
     if (UseWeights)
-    {
-      childLabels[category][childPositions[category]] = labels[i];
-      childWeights[category][childPositions[category]++] = weights[i];
-    }
-    else
-    {
-      childLabels[category][childPositions[category]++] = labels[i];
-    }
+      sortedWeights[position] = weights[i];
   }
 
   double overallGain = 0.0;
   for (size_t i = 0; i < counts.n_elem; ++i)
   {
+    if (counts[i] == 0)
+      continue; // An empty child contributes nothing to the gain.
+
     // Calculate the gain of this child.
+    const size_t begin = childPositions[i];
+    const size_t end = childPositions[i + 1] - 1;
     const double childPct = UseWeights ?
         double(childWeightSums[i]) / sumWeight :
         double(counts[i]) / double(data.n_elem);
-    const double childGain = FitnessFunction::template Evaluate<UseWeights>(
-        childLabels[i], numClasses, childWeights[i]);
+
+    double childGain;
+    if (UseWeights)
+    {
+      childGain = FitnessFunction::template Evaluate<UseWeights>(
+          sortedLabels.subvec(begin, end), numClasses,
+          sortedWeights.subvec(begin, end));
+    }
+    else
+    {
+      childGain = FitnessFunction::template Evaluate<UseWeights>(
+          sortedLabels.subvec(begin, end), numClasses, sortedWeights);
+    }
 
     overallGain += childPct * childGain;
   }
@@ -154,45 +164,43 @@ double AllCategoricalSplit<FitnessFunction>::SplitIfBetter(
   if (arma::min(counts) < minimumLeafSize)
     return DBL_MAX;
 
-  // Calculate the gain of the split.  First we have to calculate the labels
-  // that would be assigned to each child.
-  arma::uvec childPositions(numCategories, arma::fill::zeros);
-  std::vector<arma::rowvec> childResponses(numCategories);
-  std::vector<arma::rowvec> childWeights(numCategories);
-
+  // Calculate the gain of the split.  Instead of extracting each child's
+  // responses into its own buffer, we counting-sort the responses into a
+  // single contiguous buffer grouped by category, and evaluate each child's
+  // gain on a range of that buffer.
+  arma::uvec childPositions(numCategories + 1);
+  childPositions[0] = 0;
   for (size_t i = 0; i < numCategories; ++i)
-  {
-    // Responses and weights should have same length.
-    childResponses[i].zeros(counts[i]);
-    if (UseWeights)
-      childWeights[i].zeros(counts[i]);
-  }
+    childPositions[i + 1] = childPositions[i] + counts[i];
 
-  // Extract labels for each child.
+  arma::rowvec sortedResponses(data.n_elem);
+  arma::rowvec sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(data.n_elem);
+
+  arma::uvec positions = childPositions.subvec(0, numCategories - 1);
   for (size_t i = 0; i < data.n_elem; ++i)
   {
-    const size_t category = (size_t) data[i];
+    const size_t position = positions[(size_t) data[i]]++;
 
+    sortedResponses[position] = responses[i];
     if (UseWeights)
-    {
-      childResponses[category][childPositions[category]] = responses[i];
-      childWeights[category][childPositions[category]++] = weights[i];
-    }
-    else
-    {
-      childResponses[category][childPositions[category]++] = responses[i];
-    }
+      sortedWeights[position] = weights[i];
   }
 
   double overallGain = 0.0;
   for (size_t i = 0; i < counts.n_elem; ++i)
   {
+    if (counts[i] == 0)
+      continue; // An empty child contributes nothing to the gain.
+
     // Calculate the gain of this child.
     const double childPct = UseWeights ?
         double(childWeightSums[i]) / sumWeight :
         double(counts[i]) / double(data.n_elem);
     const double childGain = fitnessFunction.template Evaluate<UseWeights>(
-        childResponses[i], childWeights[i]);
+        sortedResponses, sortedWeights, childPositions[i],
+        childPositions[i + 1]);
 
     overallGain += childPct * childGain;
   }
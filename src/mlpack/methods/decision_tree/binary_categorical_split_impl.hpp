@@ -0,0 +1,501 @@
+/**
+ * @file methods/decision_tree/binary_categorical_split_impl.hpp
+ *
+ * Implementation of the BinaryCategoricalSplit categorical split class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BINARY_CATEGORICAL_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_BINARY_CATEGORICAL_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+// Overload used in classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename LabelsType,
+         typename WeightVecType>
+double BinaryCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const LabelsType& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& aux)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+  if (numCategories < 2)
+    return DBL_MAX; // No two-way partition of one category exists.
+
+  // Build the per-category class counts (or class weight sums) with a single
+  // histogram pass over the dimension.
+  arma::mat classCounts(numClasses, numCategories, arma::fill::zeros);
+  arma::Col<size_t> categorySizes(numCategories, arma::fill::zeros);
+  double totalWeight = 0.0;
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    ++categorySizes[category];
+
+    if (UseWeights)
+    {
+      classCounts(labels[i], category) += weights[i];
+      totalWeight += weights[i];
+    }
+    else
+    {
+      classCounts(labels[i], category) += 1.0;
+    }
+  }
+  if (!UseWeights)
+    totalWeight = (double) data.n_elem;
+
+  // Order the categories by their mean label.  For binary labels this is the
+  // proportion of the positive class, and the optimal two-way partition is a
+  // prefix of this order.  Categories that do not occur in this node sort
+  // last, so they percolate to the right child.
+  const arma::vec classValues =
+      arma::linspace<arma::vec>(0, numClasses - 1, numClasses);
+  arma::vec sortKeys(numCategories);
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    const double categoryWeight = arma::accu(classCounts.col(c));
+    sortKeys[c] = (categoryWeight > 0.0) ?
+        arma::dot(classValues, classCounts.col(c)) / categoryWeight : DBL_MAX;
+  }
+  const arma::uvec categoryOrder = arma::sort_index(sortKeys);
+
+  // Scan the prefix partitions of the sorted order, keeping the per-side
+  // class statistics current as whole categories move to the left side.
+  const arma::vec totalCounts = arma::sum(classCounts, 1);
+  typename FitnessFunction::IncrementalEvaluator evaluator(totalCounts,
+      totalWeight);
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0) *
+      totalWeight;
+  bool improved = false;
+  size_t bestPrefix = 0;
+  size_t leftSize = 0;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  for (size_t p = 0; p < numCategories - 1; ++p)
+  {
+    const size_t category = categoryOrder[p];
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      if (classCounts(c, category) > 0.0)
+        evaluator.MoveLeft(c, classCounts(c, category));
+    }
+    leftSize += categorySizes[category];
+
+    // An empty category yields the same partition of points as the previous
+    // prefix, so there is nothing new to evaluate.
+    if (categorySizes[category] == 0)
+      continue;
+
+    if (leftSize < minimum || (data.n_elem - leftSize) < minimum)
+      continue;
+
+    // Calculate the gain of this prefix partition.
+    const double gain = evaluator.LeftTotal() * evaluator.LeftGain() +
+        evaluator.RightTotal() * evaluator.RightGain();
+
+    if (gain > bestFoundGain)
+    {
+      bestFoundGain = gain;
+      bestPrefix = p + 1;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  // This is better, so store the number of children and the direction each
+  // category percolates to.
+  splitInfo.set_size(1);
+  splitInfo[0] = 2;
+  aux.CategoryDirections().zeros(numCategories);
+  for (size_t p = bestPrefix; p < numCategories; ++p)
+    aux.CategoryDirections()[categoryOrder[p]] = 1;
+
+  return bestFoundGain / totalWeight;
+}
+
+// Overload used in regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+BinaryCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& aux,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+  if (numCategories < 2)
+    return DBL_MAX; // No two-way partition of one category exists.
+
+  // Build per-category response sums and sizes with a single histogram pass.
+  arma::Col<size_t> categorySizes(numCategories, arma::fill::zeros);
+  arma::vec categorySums(numCategories, arma::fill::zeros);
+  arma::vec categoryWeights(numCategories, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    const double w = UseWeights ? (double) weights[i] : 1.0;
+    ++categorySizes[category];
+    categorySums[category] += w * responses[i];
+    categoryWeights[category] += w;
+  }
+
+  // Order the categories by their mean response; for squared error the
+  // optimal two-way partition is a prefix of this order.  Categories that do
+  // not occur in this node sort last, so they percolate to the right child.
+  arma::vec sortKeys(numCategories);
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    sortKeys[c] = (categoryWeights[c] > 0.0) ?
+        categorySums[c] / categoryWeights[c] : DBL_MAX;
+  }
+  const arma::uvec categoryOrder = arma::sort_index(sortKeys);
+
+  // Counting sort: lay the responses out grouped by category in sorted order,
+  // so that every prefix partition is a prefix of the sorted arrays.
+  arma::uvec categoryRank(numCategories);
+  for (size_t p = 0; p < numCategories; ++p)
+    categoryRank[categoryOrder[p]] = p;
+
+  arma::uvec categoryOffsets(numCategories + 1);
+  categoryOffsets[0] = 0;
+  for (size_t p = 0; p < numCategories; ++p)
+    categoryOffsets[p + 1] = categoryOffsets[p] + categorySizes[categoryOrder[p]];
+
+  arma::Row<RType> sortedResponses(data.n_elem);
+  arma::Row<WType> sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(data.n_elem);
+
+  arma::uvec positions = categoryOffsets.subvec(0, numCategories - 1);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t pos = positions[categoryRank[(size_t) data[i]]]++;
+    sortedResponses[pos] = responses[i];
+    if (UseWeights)
+      sortedWeights[pos] = weights[i];
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  size_t bestPrefix = 0;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType leftChildWeight = 0.0;
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Loop through the category boundaries, choosing the best one.
+  for (size_t p = 1; p < numCategories; ++p)
+  {
+    if (UseWeights)
+      leftChildWeight += categoryWeights[categoryOrder[p - 1]];
+
+    const size_t index = categoryOffsets[p];
+
+    // An empty category yields the same partition of points as the previous
+    // prefix, so there is nothing new to evaluate.
+    if (index == categoryOffsets[p - 1])
+      continue;
+
+    if (index < minimum || (data.n_elem - index) < minimum)
+      continue;
+
+    // Calculate the gain for the left and right child.
+    const double leftGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, 0, index);
+    const double rightGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, index,
+            data.n_elem);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftChildWeight * leftGain +
+          (totalWeight - leftChildWeight) * rightGain;
+    }
+    else
+    {
+      gain = double(index) * leftGain +
+          double(data.n_elem - index) * rightGain;
+    }
+
+    if (gain > bestFoundGain)
+    {
+      bestFoundGain = gain;
+      bestPrefix = p;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  // This is better, so store the number of children and the direction each
+  // category percolates to.
+  splitInfo = 2;
+  aux.CategoryDirections().zeros(numCategories);
+  for (size_t p = bestPrefix; p < numCategories; ++p)
+    aux.CategoryDirections()[categoryOrder[p]] = 1;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Optimized version for any fitness function that implements
+// BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+BinaryCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& aux,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+  if (numCategories < 2)
+    return DBL_MAX; // No two-way partition of one category exists.
+
+  // Build per-category response sums and sizes with a single histogram pass.
+  arma::Col<size_t> categorySizes(numCategories, arma::fill::zeros);
+  arma::vec categorySums(numCategories, arma::fill::zeros);
+  arma::vec categoryWeights(numCategories, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    const double w = UseWeights ? (double) weights[i] : 1.0;
+    ++categorySizes[category];
+    categorySums[category] += w * responses[i];
+    categoryWeights[category] += w;
+  }
+
+  // Order the categories by their mean response; for squared error the
+  // optimal two-way partition is a prefix of this order.  Categories that do
+  // not occur in this node sort last, so they percolate to the right child.
+  arma::vec sortKeys(numCategories);
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    sortKeys[c] = (categoryWeights[c] > 0.0) ?
+        categorySums[c] / categoryWeights[c] : DBL_MAX;
+  }
+  const arma::uvec categoryOrder = arma::sort_index(sortKeys);
+
+  // Counting sort: lay the responses out grouped by category in sorted order,
+  // so that every prefix partition is a prefix of the sorted arrays.
+  arma::uvec categoryRank(numCategories);
+  for (size_t p = 0; p < numCategories; ++p)
+    categoryRank[categoryOrder[p]] = p;
+
+  arma::uvec categoryOffsets(numCategories + 1);
+  categoryOffsets[0] = 0;
+  for (size_t p = 0; p < numCategories; ++p)
+    categoryOffsets[p + 1] = categoryOffsets[p] + categorySizes[categoryOrder[p]];
+
+  arma::Row<RType> sortedResponses(data.n_elem);
+  arma::Row<WType> sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(data.n_elem);
+
+  arma::uvec positions = categoryOffsets.subvec(0, numCategories - 1);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t pos = positions[categoryRank[(size_t) data[i]]]++;
+    sortedResponses[pos] = responses[i];
+    if (UseWeights)
+      sortedWeights[pos] = weights[i];
+  }
+
+  // Mark which indices of the sorted arrays are category boundaries, and
+  // which prefix each boundary corresponds to.  Coinciding boundaries (from
+  // empty categories) keep the largest prefix, which describes the same
+  // partition of points.
+  arma::uvec prefixAtIndex(data.n_elem + 1, arma::fill::zeros);
+  for (size_t p = 1; p < numCategories; ++p)
+    prefixAtIndex[categoryOffsets[p]] = p;
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  size_t bestPrefix = 0;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType leftChildWeight = 0.0;
+  WType rightChildWeight = 0.0;
+
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+
+    for (size_t i = 0; i < minimum - 1; ++i)
+      leftChildWeight += sortedWeights[i];
+
+    for (size_t i = minimum - 1; i < data.n_elem; ++i)
+      rightChildWeight += sortedWeights[i];
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Initialize and precompute various statistics to efficiently compute gain
+  // values for all candidate boundaries.
+  fitnessFunction.template BinaryScanInitialize<UseWeights>(sortedResponses,
+      sortedWeights, minimum);
+
+  // Loop through all possible split points, evaluating the gain only at
+  // category boundaries.
+  for (size_t index = minimum; index < data.n_elem - minimum + 1; ++index)
+  {
+    if (UseWeights)
+    {
+      leftChildWeight += sortedWeights[index - 1];
+      rightChildWeight -= sortedWeights[index - 1];
+    }
+
+    // Steps through the current index and updates the cached data.
+    fitnessFunction.template BinaryStep<UseWeights>(sortedResponses,
+        sortedWeights, index - 1);
+
+    // Only category boundaries are valid two-way categorical splits.
+    if (prefixAtIndex[index] == 0)
+      continue;
+
+    // Calculate the gain for the left and right child.
+    std::tuple<double, double> binaryGains = fitnessFunction.BinaryGains();
+    const double leftGain = std::get<0>(binaryGains);
+    const double rightGain = std::get<1>(binaryGains);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftChildWeight * leftGain + rightChildWeight * rightGain;
+    }
+    else
+    {
+      gain = double(index) * leftGain +
+          double(data.n_elem - index) * rightGain;
+    }
+
+    if (gain > bestFoundGain)
+    {
+      bestFoundGain = gain;
+      bestPrefix = prefixAtIndex[index];
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  // This is better, so store the number of children and the direction each
+  // category percolates to.
+  splitInfo = 2;
+  aux.CategoryDirections().zeros(numCategories);
+  for (size_t p = bestPrefix; p < numCategories; ++p)
+    aux.CategoryDirections()[categoryOrder[p]] = 1;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+size_t BinaryCategoricalSplit<FitnessFunction>::NumChildren(
+    const double& /* splitInfo */,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  return 2;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t BinaryCategoricalSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const double& /* splitInfo */,
+    const AuxiliarySplitInfo& aux)
+{
+  return (size_t) aux.CategoryDirections()[(size_t) point];
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
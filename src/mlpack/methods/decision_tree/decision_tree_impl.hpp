@@ -839,12 +839,75 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // Gather the candidate dimensions so that they can be searched in
+    // parallel.  Each thread scans its share of the dimensions with its own
+    // scratch split information, and the winning dimension is re-split
+    // afterwards to fill in the real auxiliary information.
+    std::vector<size_t> dimensions;
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    const double nodeGain = bestGain;
+
+    #pragma omp parallel
+    {
+      double threadBestGain = nodeGain;
+      size_t threadBestDim = data.n_rows;
+      arma::vec threadClassProbabilities;
+      typename NumericSplit::AuxiliarySplitInfo threadAux;
+
+      #pragma omp for nowait
+      for (omp_size_t j = 0; j < (omp_size_t) dimensions.size(); ++j)
+      {
+        const size_t i = dimensions[j];
+        const double dimGain = NumericSplitType<FitnessFunction>::template
+            SplitIfBetter<UseWeights>(threadBestGain,
+                                      data.cols(begin,
+                                          begin + count - 1).row(i),
+                                      labels.cols(begin, begin + count - 1),
+                                      numClasses,
+                                      UseWeights ?
+                                          weights.cols(begin,
+                                              begin + count - 1) :
+                                          weights,
+                                      minimumLeafSize,
+                                      minimumGainSplit,
+                                      threadClassProbabilities,
+                                      threadAux);
+
+        // If the splitter did not report that it improved, then move to the
+        // next dimension.
+        if (dimGain == DBL_MAX)
+          continue;
+
+        threadBestDim = i;
+        threadBestGain = dimGain;
+      }
+
+      // Merge the thread-local results; ties are broken towards the smaller
+      // dimension so that the result does not depend on the number of
+      // threads.
+      #pragma omp critical (DecisionTreeSplitDimension)
+      {
+        if (threadBestDim != data.n_rows && ((threadBestGain > bestGain) ||
+            (threadBestGain == bestGain && (bestDim == data.n_rows ||
+             threadBestDim < bestDim))))
+        {
+          bestGain = threadBestGain;
+          bestDim = threadBestDim;
+        }
+      }
+    }
+
+    // Re-split the winning dimension to fill in the real split information.
+    if (bestDim != data.n_rows)
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
-          SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
+      double recomputeGain = nodeGain;
+      NumericSplitType<FitnessFunction>::template
+          SplitIfBetter<UseWeights>(recomputeGain,
+                                    data.cols(begin,
+                                        begin + count - 1).row(bestDim),
                                     labels.cols(begin, begin + count - 1),
                                     numClasses,
                                     UseWeights ?
@@ -854,18 +917,6 @@ double DecisionTree<FitnessFunction,
                                     minimumGainSplit,
                                     classProbabilities,
                                     *this);
-
-      // If the splitter did not report that it improved, then move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
-        continue;
-
-      bestDim = i;
-      bestGain = dimGain;
-
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
     }
   }
 
@@ -1092,6 +1143,10 @@ void DecisionTree<FitnessFunction,
   // Since dimensionType and majorityClass are a union, we only need to serialize one.
   ar(CEREAL_NVP(dimensionType));
   ar(CEREAL_NVP(classProbabilities));
+  // The auxiliary split information may hold state needed to compute
+  // directions (e.g. for BinaryCategoricalSplit).
+  ar(cereal::make_nvp("categoricalSplitAux",
+      static_cast<CategoricalAuxiliarySplitInfo&>(*this)));
 }
 
 template<typename FitnessFunction,
@@ -19,6 +19,7 @@
 #include "best_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "random_binary_numeric_split.hpp"
+#include "histogram_binary_numeric_split.hpp"
 #include "all_dimension_select.hpp"
 #include <type_traits>
 
@@ -1037,6 +1037,10 @@ void DecisionTreeRegressor<FitnessFunction,
   ar(CEREAL_NVP(splitPoint));
   // Since splitPoint and prediction are a union, we only need to serialize one of them.
   ar(CEREAL_NVP(splitPoint));
+  // The auxiliary split information may hold state needed to compute
+  // directions (e.g. for BinaryCategoricalSplit).
+  ar(cereal::make_nvp("categoricalSplitAux",
+      static_cast<CategoricalAuxiliarySplitInfo&>(*this)));
 }
 
 //! Return the number of leaves.
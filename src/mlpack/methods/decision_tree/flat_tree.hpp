@@ -0,0 +1,195 @@
+/**
+ * @file methods/decision_tree/flat_tree.hpp
+ * @author Ryan Curtin
+ *
+ * A flattened, structure-of-arrays representation of a trained decision tree
+ * (and of a forest of such trees), for fast batch inference.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_FLAT_TREE_HPP
+#define MLPACK_METHODS_DECISION_TREE_FLAT_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A FlatTree is a read-only compilation of a trained DecisionTree into
+ * contiguous arrays.  The nodes are laid out in breadth-first order, so the
+ * children of any node are adjacent and each node only stores the index of
+ * its first child; traversal touches a handful of flat arrays instead of
+ * chasing heap-allocated child pointers, and the batch Classify() overloads
+ * advance blocks of points one tree level at a time so the per-level working
+ * set stays in cache.
+ *
+ * The flattened form is a transient acceleration structure: it holds no
+ * training state, it is not serialized, and it must be rebuilt (with
+ * Flatten()) if the source tree is retrained.  It assumes the tree's
+ * AuxiliarySplitInfo types are stateless, which is true of all split types in
+ * mlpack.
+ *
+ * @tparam TreeType Type of the DecisionTree to flatten.
+ */
+template<typename TreeType>
+class FlatTree
+{
+ public:
+  /**
+   * Construct an empty FlatTree; it cannot classify anything until Flatten()
+   * is called.
+   */
+  FlatTree();
+
+  /**
+   * Construct the FlatTree as a compilation of the given trained tree.
+   *
+   * @param tree Trained decision tree to flatten.
+   */
+  FlatTree(const TreeType& tree);
+
+  /**
+   * Flatten the given trained tree, replacing anything already held.
+   *
+   * @param tree Trained decision tree to flatten.
+   */
+  void Flatten(const TreeType& tree);
+
+  /**
+   * Classify the given point and return the predicted class.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given points, using the batched level-wise kernel.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points and also return estimates of the probabilities
+   * for each class in the given matrix, using the batched level-wise kernel.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities This will be filled with class probabilities for
+   *      each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of nodes in the flattened tree.
+  size_t NumNodes() const { return numChildren.n_elem; }
+
+  //! Get the number of classes in the tree.
+  size_t NumClasses() const { return leafProbabilities.n_rows; }
+
+ private:
+  //! The dimension each node splits on (unused for leaves).
+  arma::Col<size_t> splitDimensions;
+  //! The type (numeric or categorical) of each node's split dimension.
+  arma::Col<size_t> dimensionTypes;
+  //! The split information of each node (unused for leaves).
+  arma::vec splitInfos;
+  //! The index of each node's first child; all children are adjacent.
+  arma::Col<size_t> firstChildren;
+  //! The number of children of each node (zero for leaves).
+  arma::Col<size_t> numChildren;
+  //! The majority class of each leaf node.
+  arma::Col<size_t> majorityClasses;
+  //! The class probabilities of each leaf node, one column per node.
+  arma::mat leafProbabilities;
+
+  //! Stateless auxiliary split information passed to CalculateDirection().
+  typename TreeType::NumericSplit::AuxiliarySplitInfo numericAux;
+  typename TreeType::CategoricalSplit::AuxiliarySplitInfo categoricalAux;
+
+  /**
+   * Given a non-leaf node index and the value of the point in the node's
+   * split dimension, calculate the index of the child the point goes to.
+   */
+  template<typename ElemType>
+  size_t CalculateDirection(const size_t node, const ElemType& value) const;
+};
+
+/**
+ * A FlatForest compiles every tree of a trained RandomForest into a FlatTree
+ * and aggregates their votes the same way RandomForest::Classify() does
+ * (averaging the class probabilities of all trees).
+ *
+ * @tparam ForestType Type of the RandomForest to flatten.
+ */
+template<typename ForestType>
+class FlatForest
+{
+ public:
+  /**
+   * Construct an empty FlatForest; it cannot classify anything until
+   * Flatten() is called.
+   */
+  FlatForest() { }
+
+  /**
+   * Construct the FlatForest as a compilation of the given trained forest.
+   *
+   * @param forest Trained random forest to flatten.
+   */
+  FlatForest(const ForestType& forest);
+
+  /**
+   * Flatten the given trained forest, replacing anything already held.
+   *
+   * @param forest Trained random forest to flatten.
+   */
+  void Flatten(const ForestType& forest);
+
+  /**
+   * Classify the given points.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points and also return the class probabilities,
+   * averaged over all trees.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities This will be filled with class probabilities for
+   *      each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees in the flattened forest.
+  size_t NumTrees() const { return trees.size(); }
+
+ private:
+  //! The flattened trees.
+  std::vector<FlatTree<typename ForestType::DecisionTreeType> > trees;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_tree_impl.hpp"
+
+#endif
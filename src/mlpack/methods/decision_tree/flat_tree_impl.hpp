@@ -0,0 +1,257 @@
+/**
+ * @file methods/decision_tree/flat_tree_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the FlatTree and FlatForest classes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_FLAT_TREE_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_FLAT_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType>
+FlatTree<TreeType>::FlatTree()
+{
+  // Nothing to do here.
+}
+
+template<typename TreeType>
+FlatTree<TreeType>::FlatTree(const TreeType& tree)
+{
+  Flatten(tree);
+}
+
+template<typename TreeType>
+void FlatTree<TreeType>::Flatten(const TreeType& tree)
+{
+  // Collect the nodes in breadth-first order; this guarantees that the
+  // children of any node end up adjacent, so each node only needs the index
+  // of its first child.
+  std::vector<const TreeType*> nodes;
+  nodes.push_back(&tree);
+  for (size_t i = 0; i < nodes.size(); ++i)
+    for (size_t c = 0; c < nodes[i]->NumChildren(); ++c)
+      nodes.push_back(&nodes[i]->Child(c));
+
+  const size_t numNodes = nodes.size();
+  splitDimensions.set_size(numNodes);
+  dimensionTypes.set_size(numNodes);
+  splitInfos.set_size(numNodes);
+  firstChildren.zeros(numNodes);
+  numChildren.set_size(numNodes);
+  majorityClasses.zeros(numNodes);
+
+  // The number of classes is the length of any leaf's probability vector.
+  const TreeType* node = &tree;
+  while (node->NumChildren() != 0)
+    node = &node->Child(0);
+  leafProbabilities.zeros(node->ClassProbabilities().n_elem, numNodes);
+
+  size_t nextChild = 1;
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    numChildren[i] = nodes[i]->NumChildren();
+    if (numChildren[i] > 0)
+    {
+      firstChildren[i] = nextChild;
+      nextChild += numChildren[i];
+      splitDimensions[i] = nodes[i]->SplitDimension();
+      dimensionTypes[i] = (size_t) nodes[i]->SplitDimensionType();
+      splitInfos[i] = nodes[i]->ClassProbabilities()[0];
+    }
+    else
+    {
+      splitDimensions[i] = 0;
+      dimensionTypes[i] = (size_t) data::Datatype::numeric;
+      splitInfos[i] = 0.0;
+      leafProbabilities.col(i) = nodes[i]->ClassProbabilities();
+      majorityClasses[i] = nodes[i]->ClassProbabilities().index_max();
+    }
+  }
+}
+
+template<typename TreeType>
+template<typename ElemType>
+size_t FlatTree<TreeType>::CalculateDirection(const size_t node,
+                                              const ElemType& value) const
+{
+  if ((data::Datatype) dimensionTypes[node] == data::Datatype::categorical)
+  {
+    return TreeType::CategoricalSplit::CalculateDirection(value,
+        splitInfos[node], categoricalAux);
+  }
+  else
+  {
+    return TreeType::NumericSplit::CalculateDirection(value, splitInfos[node],
+        numericAux);
+  }
+}
+
+template<typename TreeType>
+template<typename VecType>
+size_t FlatTree<TreeType>::Classify(const VecType& point) const
+{
+  size_t node = 0;
+  while (numChildren[node] > 0)
+  {
+    node = firstChildren[node] +
+        CalculateDirection(node, point[splitDimensions[node]]);
+  }
+
+  return majorityClasses[node];
+}
+
+template<typename TreeType>
+template<typename MatType>
+void FlatTree<TreeType>::Classify(const MatType& data,
+                                  arma::Row<size_t>& predictions) const
+{
+  predictions.set_size(data.n_cols);
+
+  // Process the points in blocks; all points of a block are advanced one tree
+  // level at a time, so the flat node arrays are streamed through once per
+  // level while the block's state stays in cache.
+  const size_t blockSize = 256;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+
+    arma::Col<size_t> nodes(end - begin, arma::fill::zeros);
+    bool anyInternal = (numChildren[0] > 0);
+    while (anyInternal)
+    {
+      anyInternal = false;
+      for (size_t i = begin; i < end; ++i)
+      {
+        const size_t node = nodes[i - begin];
+        if (numChildren[node] == 0)
+          continue;
+
+        anyInternal = true;
+        nodes[i - begin] = firstChildren[node] +
+            CalculateDirection(node, data(splitDimensions[node], i));
+      }
+    }
+
+    for (size_t i = begin; i < end; ++i)
+      predictions[i] = majorityClasses[nodes[i - begin]];
+  }
+}
+
+template<typename TreeType>
+template<typename MatType>
+void FlatTree<TreeType>::Classify(const MatType& data,
+                                  arma::Row<size_t>& predictions,
+                                  arma::mat& probabilities) const
+{
+  predictions.set_size(data.n_cols);
+  probabilities.set_size(NumClasses(), data.n_cols);
+
+  const size_t blockSize = 256;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+
+    arma::Col<size_t> nodes(end - begin, arma::fill::zeros);
+    bool anyInternal = (numChildren[0] > 0);
+    while (anyInternal)
+    {
+      anyInternal = false;
+      for (size_t i = begin; i < end; ++i)
+      {
+        const size_t node = nodes[i - begin];
+        if (numChildren[node] == 0)
+          continue;
+
+        anyInternal = true;
+        nodes[i - begin] = firstChildren[node] +
+            CalculateDirection(node, data(splitDimensions[node], i));
+      }
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      predictions[i] = majorityClasses[nodes[i - begin]];
+      probabilities.col(i) = leafProbabilities.col(nodes[i - begin]);
+    }
+  }
+}
+
+template<typename ForestType>
+FlatForest<ForestType>::FlatForest(const ForestType& forest)
+{
+  Flatten(forest);
+}
+
+template<typename ForestType>
+void FlatForest<ForestType>::Flatten(const ForestType& forest)
+{
+  trees.resize(forest.NumTrees());
+  for (size_t t = 0; t < forest.NumTrees(); ++t)
+    trees[t].Flatten(forest.Tree(t));
+}
+
+template<typename ForestType>
+template<typename MatType>
+void FlatForest<ForestType>::Classify(const MatType& data,
+                                      arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename ForestType>
+template<typename MatType>
+void FlatForest<ForestType>::Classify(const MatType& data,
+                                      arma::Row<size_t>& predictions,
+                                      arma::mat& probabilities) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+    probabilities.clear();
+
+    throw std::invalid_argument("FlatForest::Classify(): no flattened forest "
+        "to classify with!");
+  }
+
+  // Accumulate the per-tree probabilities in the same order as
+  // RandomForest::Classify(), so the aggregated result is identical.
+  probabilities.zeros(trees[0].NumClasses(), data.n_cols);
+  arma::Row<size_t> treePredictions; // Ignored.
+  arma::mat treeProbabilities;
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    trees[t].Classify(data, treePredictions, treeProbabilities);
+    probabilities += treeProbabilities;
+  }
+  probabilities /= trees.size();
+
+  predictions.set_size(data.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    predictions[i] = probabilities.col(i).index_max();
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
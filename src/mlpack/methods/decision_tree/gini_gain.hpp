@@ -207,6 +207,81 @@ class GiniGain
     // distributed, which gives n * (1/n * (1 - 1/n)) = 1 - 1/n.
     return 1.0 - (1.0 / double(numClasses));
   }
+
+  /**
+   * Incremental evaluator for sweeping a split boundary over a sorted
+   * dimension.  The evaluator holds the class counts (or class weight sums)
+   * of the two sides of the boundary, with every point initially on the right
+   * side, plus the sums of squared counts of each side.  Moving a point
+   * across the boundary and evaluating the gain of either side are then both
+   * O(1) operations, instead of the O(numClasses) that a call to
+   * EvaluatePtr() on the updated counts would cost.
+   */
+  class IncrementalEvaluator
+  {
+   public:
+    /**
+     * Construct the evaluator with the class counts (or class weight sums) of
+     * the full set; all points start on the right side of the boundary.
+     */
+    IncrementalEvaluator(const arma::vec& counts, const double totalWeight) :
+        leftCounts(counts.n_elem, arma::fill::zeros),
+        rightCounts(counts),
+        leftTotal(0.0),
+        rightTotal(totalWeight),
+        leftSumSquares(0.0),
+        rightSumSquares(arma::accu(counts % counts))
+    {
+      // Nothing else to do.
+    }
+
+    //! Move weight of the given class from the right to the left side.
+    void MoveLeft(const size_t classIndex, const double weight = 1.0)
+    {
+      // (c + w)^2 = c^2 + w * (2 c + w), so the sums of squares can be kept
+      // current without recomputing them.
+      leftSumSquares += weight * (2.0 * leftCounts[classIndex] + weight);
+      rightSumSquares -= weight * (2.0 * rightCounts[classIndex] - weight);
+
+      leftCounts[classIndex] += weight;
+      rightCounts[classIndex] -= weight;
+      leftTotal += weight;
+      rightTotal -= weight;
+    }
+
+    //! Get the Gini gain of the left side of the boundary.
+    double LeftGain() const
+    {
+      return (leftTotal == 0.0) ? 0.0 :
+          -(1.0 - leftSumSquares / (leftTotal * leftTotal));
+    }
+
+    //! Get the Gini gain of the right side of the boundary.
+    double RightGain() const
+    {
+      return (rightTotal == 0.0) ? 0.0 :
+          -(1.0 - rightSumSquares / (rightTotal * rightTotal));
+    }
+
+    //! Get the total count (or weight) on the left side of the boundary.
+    double LeftTotal() const { return leftTotal; }
+    //! Get the total count (or weight) on the right side of the boundary.
+    double RightTotal() const { return rightTotal; }
+
+   private:
+    //! The class counts of the left side of the boundary.
+    arma::vec leftCounts;
+    //! The class counts of the right side of the boundary.
+    arma::vec rightCounts;
+    //! The total count on the left side.
+    double leftTotal;
+    //! The total count on the right side.
+    double rightTotal;
+    //! The sum of squared class counts of the left side.
+    double leftSumSquares;
+    //! The sum of squared class counts of the right side.
+    double rightSumSquares;
+  };
 };
 
 } // namespace tree
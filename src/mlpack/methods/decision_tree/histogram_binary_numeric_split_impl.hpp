@@ -0,0 +1,372 @@
+/**
+ * @file methods/decision_tree/histogram_binary_numeric_split_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the HistogramBinaryNumericSplit splitting class, which
+ * scans equal-width histogram bin boundaries instead of sorting the dimension.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+// Overload used in classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Find the range of the dimension.  If it is constant, we can't split.
+  const double minValue = (double) data.min();
+  const double maxValue = (double) data.max();
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  const double binWidth = (maxValue - minValue) / (double) NumBins;
+
+  // Accumulate the per-bin class histograms in a single unsorted pass.  The
+  // maximum value of the dimension is clamped into the last bin.
+  arma::Mat<size_t> binClassCounts;
+  arma::mat binClassWeightSums;
+  arma::Col<size_t> binCounts(NumBins, arma::fill::zeros);
+  arma::vec binWeights;
+  double totalWeight = 0.0;
+  if (UseWeights)
+  {
+    binClassWeightSums.zeros(numClasses, NumBins);
+    binWeights.zeros(NumBins);
+  }
+  else
+  {
+    binClassCounts.zeros(numClasses, NumBins);
+  }
+
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t bin = std::min(
+        (size_t) (((double) data[i] - minValue) / binWidth),
+        (size_t) NumBins - 1);
+    ++binCounts[bin];
+    if (UseWeights)
+    {
+      binClassWeightSums(labels[i], bin) += weights[i];
+      binWeights[bin] += weights[i];
+      totalWeight += weights[i];
+    }
+    else
+    {
+      ++binClassCounts(labels[i], bin);
+    }
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // We need running class statistics for the two children; everything starts
+  // in the right child.
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = totalWeight;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, 2);
+    classWeightSums.col(1) = arma::sum(binClassWeightSums, 1);
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    classCounts.zeros(numClasses, 2);
+    classCounts.col(1) = arma::sum(binClassCounts, 1);
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Scan the bin boundaries, choosing the best one.  The candidate threshold
+  // after bin b is the lower edge of bin b + 1.
+  size_t leftCount = 0;
+  for (size_t bin = 0; bin + 1 < NumBins; ++bin)
+  {
+    // Move the bin's statistics into the left child.
+    leftCount += binCounts[bin];
+    if (UseWeights)
+    {
+      classWeightSums.col(0) += binClassWeightSums.col(bin);
+      classWeightSums.col(1) -= binClassWeightSums.col(bin);
+      totalLeftWeight += binWeights[bin];
+      totalRightWeight -= binWeights[bin];
+    }
+    else
+    {
+      classCounts.col(0) += binClassCounts.col(bin);
+      classCounts.col(1) -= binClassCounts.col(bin);
+    }
+
+    // An empty bin does not introduce a new candidate threshold.
+    if (binCounts[bin] == 0)
+      continue;
+
+    // Make sure both children would have enough points.
+    if ((leftCount < minimum) || (data.n_elem - leftCount < minimum))
+      continue;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(classWeightSums.colptr(0),
+            numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(classCounts.colptr(0),
+            numClasses, leftCount);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(classWeightSums.colptr(1),
+            numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(classCounts.colptr(1),
+            numClasses, size_t(data.n_elem - leftCount));
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(leftCount) * leftGain +
+          double(data.n_elem - leftCount) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.  The split value is the lower edge of the next bin.
+      splitInfo.set_size(1);
+      splitInfo[0] = minValue + binWidth * (bin + 1);
+
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = minValue + binWidth * (bin + 1);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Overload used for regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+double HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Find the range of the dimension.  If it is constant, we can't split.
+  const double minValue = (double) data.min();
+  const double maxValue = (double) data.max();
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  const double binWidth = (maxValue - minValue) / (double) NumBins;
+
+  // Assign each point to a bin; the maximum value is clamped into the last
+  // bin.
+  arma::Col<size_t> binIndices(data.n_elem);
+  arma::Col<size_t> binCounts(NumBins, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t bin = std::min(
+        (size_t) (((double) data[i] - minValue) / binWidth),
+        (size_t) NumBins - 1);
+    binIndices[i] = bin;
+    ++binCounts[bin];
+  }
+
+  // Group the responses by bin with a counting sort, so that any contiguous
+  // prefix of the reordered responses corresponds to a union of bins.  This
+  // replaces the O(n log n) comparison sort of the exhaustive splitter.
+  arma::Col<size_t> binCursors(NumBins);
+  size_t offset = 0;
+  for (size_t bin = 0; bin < NumBins; ++bin)
+  {
+    binCursors[bin] = offset;
+    offset += binCounts[bin];
+  }
+
+  arma::Row<RType> binnedResponses(responses.n_elem);
+  arma::Row<WType> binnedWeights;
+  arma::vec binWeights;
+  double totalWeight = 0.0;
+  if (UseWeights)
+  {
+    binnedWeights.set_size(responses.n_elem);
+    binWeights.zeros(NumBins);
+  }
+
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t pos = binCursors[binIndices[i]]++;
+    binnedResponses[pos] = responses[i];
+    if (UseWeights)
+    {
+      binnedWeights[pos] = weights[i];
+      binWeights[binIndices[i]] += weights[i];
+      totalWeight += weights[i];
+    }
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = totalWeight;
+  if (UseWeights)
+    bestFoundGain *= totalWeight;
+  else
+    bestFoundGain *= data.n_elem;
+
+  // Scan the bin boundaries, choosing the best one.  The candidate threshold
+  // after bin b is the lower edge of bin b + 1, and the corresponding split
+  // index in the bin-ordered responses is the number of points to the left.
+  size_t leftCount = 0;
+  for (size_t bin = 0; bin + 1 < NumBins; ++bin)
+  {
+    leftCount += binCounts[bin];
+    if (UseWeights)
+    {
+      totalLeftWeight += binWeights[bin];
+      totalRightWeight -= binWeights[bin];
+    }
+
+    // An empty bin does not introduce a new candidate threshold.
+    if (binCounts[bin] == 0)
+      continue;
+
+    // Make sure both children would have enough points.
+    if ((leftCount < minimum) || (data.n_elem - leftCount < minimum))
+      continue;
+
+    // Calculate the gain for the left and right child.
+    const double leftGain = fitnessFunction.template
+        Evaluate<UseWeights>(binnedResponses, binnedWeights, 0, leftCount);
+    const double rightGain = fitnessFunction.template
+        Evaluate<UseWeights>(binnedResponses, binnedWeights, leftCount,
+            responses.n_elem);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(leftCount) * leftGain +
+          double(data.n_elem - leftCount) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.  The split value is the lower edge of the next bin.
+      splitInfo = minValue + binWidth * (bin + 1);
+
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo = minValue + binWidth * (bin + 1);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramBinaryNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const double& splitInfo,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  // The threshold is a bin edge, and a point whose value equals a bin edge
+  // falls into the bin above it, so the comparison is strict (unlike
+  // BestBinaryNumericSplit, whose threshold lies strictly between two values).
+  if (point < splitInfo)
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
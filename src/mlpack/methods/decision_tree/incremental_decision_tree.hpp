@@ -0,0 +1,190 @@
+/**
+ * @file methods/decision_tree/incremental_decision_tree.hpp
+ * @author Ryan Curtin
+ *
+ * A decision tree wrapper that supports incremental retraining: deltas of
+ * added and removed points are applied to the stored dataset, and only the
+ * subtrees whose split quality degraded beyond a tolerance are rebuilt.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_INCREMENTAL_DECISION_TREE_HPP
+#define MLPACK_METHODS_DECISION_TREE_INCREMENTAL_DECISION_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "decision_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The IncrementalDecisionTree class wraps a DecisionTree together with its
+ * training dataset and per-node sufficient statistics (class histograms of
+ * the points each node covers).  When the training set changes by a small
+ * delta, Update() applies the delta, re-routes the points through the
+ * existing tree, and rebuilds only the subtrees whose fitness degraded by
+ * more than the given tolerance since they were last built.  The cost of an
+ * update is therefore bounded by the amount of drift in the data, not by the
+ * size of the dataset.
+ *
+ * This is useful when a model must be retrained frequently on data that is
+ * mostly unchanged between retrainings.  The wrapper holds a copy of the
+ * training set, so it trades memory for retraining time; if the data changes
+ * completely between retrainings, training a fresh DecisionTree is cheaper.
+ *
+ * Only numeric features are supported (the tree is trained without a
+ * DatasetInfo).
+ *
+ * @tparam FitnessFunction Fitness function to use when training and when
+ *     measuring per-node quality degradation.
+ * @tparam NumericSplitType Technique for splitting numeric features; it must
+ *     have a stateless AuxiliarySplitInfo (true of all of the split types
+ *     bundled with mlpack).
+ * @tparam CategoricalSplitType Technique for splitting categorical features
+ *     (unused, but kept so that DecisionTreeType matches DecisionTree).
+ * @tparam DimensionSelectionType Technique for obtaining the dimensions to
+ *     consider when rebuilding a subtree.
+ */
+template<typename FitnessFunction = GiniGain,
+         template<typename> class NumericSplitType = BestBinaryNumericSplit,
+         template<typename> class CategoricalSplitType = AllCategoricalSplit,
+         typename DimensionSelectionType = AllDimensionSelect>
+class IncrementalDecisionTree
+{
+ public:
+  //! The type of the decision tree that is maintained incrementally.
+  typedef DecisionTree<FitnessFunction, NumericSplitType, CategoricalSplitType,
+      DimensionSelectionType> DecisionTreeType;
+
+  /**
+   * Construct the tree on the given data and labels, storing both so that
+   * later deltas can be applied with Update().
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param maximumDepth Maximum depth for the tree (0 means no limit).
+   * @param rebuildTolerance Amount by which the fitness of a node may degrade
+   *     before its subtree is rebuilt.
+   */
+  IncrementalDecisionTree(arma::mat data,
+                          arma::Row<size_t> labels,
+                          const size_t numClasses,
+                          const size_t minimumLeafSize = 10,
+                          const double minimumGainSplit = 1e-7,
+                          const size_t maximumDepth = 0,
+                          const double rebuildTolerance = 0.05);
+
+  /**
+   * Apply a delta to the training set and retrain the parts of the tree that
+   * the delta degraded.  Points are removed first, then the added points are
+   * appended, so removedIndices are indices into the dataset as it was before
+   * the call.
+   *
+   * @param addedData Points to add to the training set (may be empty).
+   * @param addedLabels Labels of the added points.
+   * @param removedIndices Indices of points to remove from the training set
+   *     (may be empty).
+   */
+  void Update(const arma::mat& addedData,
+              const arma::Row<size_t>& addedLabels,
+              const arma::uvec& removedIndices);
+
+  //! Classify the given point.
+  template<typename VecType>
+  size_t Classify(const VecType& point) const { return tree.Classify(point); }
+
+  //! Classify the given points, filling in predictions.
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const
+  { tree.Classify(data, predictions); }
+
+  //! Get the tree that is maintained incrementally.
+  const DecisionTreeType& Tree() const { return tree; }
+
+  //! Get the number of points currently in the training set.
+  size_t NumPoints() const { return dataset.n_cols; }
+
+ private:
+  /**
+   * The sufficient statistics of one node: the class histogram of the points
+   * the node covers, and the node's fitness when its subtree was last built.
+   * The structure mirrors the topology of the tree.
+   */
+  struct NodeStats
+  {
+    arma::vec classCounts;
+    double quality;
+    std::vector<NodeStats> childStats;
+  };
+
+  //! The tree that is maintained incrementally.
+  DecisionTreeType tree;
+  //! The current training set.
+  arma::mat dataset;
+  //! The labels of the current training set.
+  arma::Row<size_t> labels;
+  //! The number of classes in the dataset.
+  size_t numClasses;
+  //! The minimum leaf size used when (re)building subtrees.
+  size_t minimumLeafSize;
+  //! The minimum gain to split used when (re)building subtrees.
+  double minimumGainSplit;
+  //! The maximum depth used when (re)building subtrees (0 means no limit).
+  size_t maximumDepth;
+  //! The amount of fitness degradation that triggers a subtree rebuild.
+  double rebuildTolerance;
+  //! The statistics of the root node (and, recursively, all other nodes).
+  NodeStats stats;
+
+  //! Compute the direction the given point takes at the given internal node.
+  size_t Direction(const DecisionTreeType& node, const size_t point) const;
+
+  /**
+   * Partition the given points among the children of the given internal node.
+   */
+  void PartitionPoints(const DecisionTreeType& node,
+                       const arma::uvec& points,
+                       std::vector<arma::uvec>& childPoints) const;
+
+  /**
+   * Fill in the statistics of the given node (and, recursively, its subtree)
+   * from the points the node covers.
+   */
+  void BuildStats(const DecisionTreeType& node,
+                  NodeStats& nodeStats,
+                  const arma::uvec& points) const;
+
+  /**
+   * Recompute the quality of the given node from the points it now covers;
+   * rebuild its subtree if the quality degraded beyond the tolerance, and
+   * recurse into the children otherwise.
+   */
+  void UpdateNode(DecisionTreeType& node,
+                  NodeStats& nodeStats,
+                  const arma::uvec& points,
+                  const size_t depth);
+
+  /**
+   * Retrain the subtree rooted at the given node on the points it covers, and
+   * rebuild its statistics.
+   */
+  void RebuildNode(DecisionTreeType& node,
+                   NodeStats& nodeStats,
+                   const arma::uvec& points,
+                   const size_t depth);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_decision_tree_impl.hpp"
+
+#endif
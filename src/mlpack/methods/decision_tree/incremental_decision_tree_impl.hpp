@@ -0,0 +1,251 @@
+/**
+ * @file methods/decision_tree/incremental_decision_tree_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the IncrementalDecisionTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_INCREMENTAL_DECISION_TREE_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_INCREMENTAL_DECISION_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incremental_decision_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType>
+IncrementalDecisionTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType,
+    DimensionSelectionType
+>::IncrementalDecisionTree(arma::mat data,
+                           arma::Row<size_t> labels,
+                           const size_t numClasses,
+                           const size_t minimumLeafSize,
+                           const double minimumGainSplit,
+                           const size_t maximumDepth,
+                           const double rebuildTolerance) :
+    dataset(std::move(data)),
+    labels(std::move(labels)),
+    numClasses(numClasses),
+    minimumLeafSize(minimumLeafSize),
+    minimumGainSplit(minimumGainSplit),
+    maximumDepth(maximumDepth),
+    rebuildTolerance(rebuildTolerance)
+{
+  // Train on a copy, since DecisionTree::Train() rearranges the data it is
+  // given and we need the stored dataset to stay in its original order.
+  tree.Train(dataset, this->labels, numClasses, minimumLeafSize,
+      minimumGainSplit, maximumDepth);
+
+  arma::uvec points = arma::linspace<arma::uvec>(0, dataset.n_cols - 1,
+      dataset.n_cols);
+  BuildStats(tree, stats, points);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType>
+void IncrementalDecisionTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType,
+    DimensionSelectionType
+>::Update(const arma::mat& addedData,
+          const arma::Row<size_t>& addedLabels,
+          const arma::uvec& removedIndices)
+{
+  // Apply the delta to the stored dataset: removals first (from the highest
+  // index down, so that the other indices stay valid), then additions.
+  if (removedIndices.n_elem > 0)
+  {
+    arma::uvec sorted = arma::sort(removedIndices, "descend");
+    for (size_t i = 0; i < sorted.n_elem; ++i)
+    {
+      dataset.shed_col(sorted[i]);
+      labels.shed_col(sorted[i]);
+    }
+  }
+
+  if (addedData.n_cols > 0)
+  {
+    dataset = arma::join_rows(dataset, addedData);
+    labels = arma::join_rows(labels, addedLabels);
+  }
+
+  if (dataset.n_cols == 0)
+    return; // Nothing left to retrain on.
+
+  // Route every point through the tree, rebuilding the subtrees that the
+  // delta degraded.
+  arma::uvec points = arma::linspace<arma::uvec>(0, dataset.n_cols - 1,
+      dataset.n_cols);
+  UpdateNode(tree, stats, points, 0);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType>
+size_t IncrementalDecisionTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType,
+    DimensionSelectionType
+>::Direction(const DecisionTreeType& node, const size_t point) const
+{
+  // The split types bundled with mlpack hold no auxiliary state, so a
+  // default-constructed auxiliary object is interchangeable with the one the
+  // node was trained with.
+  typename DecisionTreeType::NumericSplit::AuxiliarySplitInfo aux;
+  return DecisionTreeType::NumericSplit::CalculateDirection(
+      dataset(node.SplitDimension(), point), node.ClassProbabilities()[0],
+      aux);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType>
+void IncrementalDecisionTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType,
+    DimensionSelectionType
+>::PartitionPoints(const DecisionTreeType& node,
+                   const arma::uvec& points,
+                   std::vector<arma::uvec>& childPoints) const
+{
+  // Count the points going to each child, then fill the index vectors.
+  arma::Col<size_t> counts(node.NumChildren(), arma::fill::zeros);
+  for (size_t i = 0; i < points.n_elem; ++i)
+    ++counts[Direction(node, points[i])];
+
+  childPoints.resize(node.NumChildren());
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    childPoints[i].set_size(counts[i]);
+
+  arma::Col<size_t> positions(node.NumChildren(), arma::fill::zeros);
+  for (size_t i = 0; i < points.n_elem; ++i)
+  {
+    const size_t direction = Direction(node, points[i]);
+    childPoints[direction][positions[direction]++] = points[i];
+  }
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType>
+void IncrementalDecisionTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType,
+    DimensionSelectionType
+>::BuildStats(const DecisionTreeType& node,
+              NodeStats& nodeStats,
+              const arma::uvec& points) const
+{
+  nodeStats.classCounts.zeros(numClasses);
+  for (size_t i = 0; i < points.n_elem; ++i)
+    ++nodeStats.classCounts[labels[points[i]]];
+  nodeStats.quality = FitnessFunction::template EvaluatePtr<false>(
+      nodeStats.classCounts.memptr(), numClasses, (double) points.n_elem);
+
+  nodeStats.childStats.clear();
+  if (node.NumChildren() == 0)
+    return;
+
+  std::vector<arma::uvec> childPoints;
+  PartitionPoints(node, points, childPoints);
+
+  nodeStats.childStats.resize(node.NumChildren());
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    BuildStats(node.Child(i), nodeStats.childStats[i], childPoints[i]);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType>
+void IncrementalDecisionTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType,
+    DimensionSelectionType
+>::UpdateNode(DecisionTreeType& node,
+              NodeStats& nodeStats,
+              const arma::uvec& points,
+              const size_t depth)
+{
+  // Recompute the fitness of this node over the points it now covers.  The
+  // fitness functions return higher-is-better values, so a positive
+  // difference from the stored quality means the node got worse.
+  arma::vec classCounts(numClasses, arma::fill::zeros);
+  for (size_t i = 0; i < points.n_elem; ++i)
+    ++classCounts[labels[points[i]]];
+  const double quality = FitnessFunction::template EvaluatePtr<false>(
+      classCounts.memptr(), numClasses, (double) points.n_elem);
+
+  if (nodeStats.quality - quality > rebuildTolerance)
+  {
+    RebuildNode(node, nodeStats, points, depth);
+    return;
+  }
+
+  // The subtree survives; keep its histogram current but leave the reference
+  // quality alone, so that degradation keeps being measured from the last
+  // rebuild rather than from the last update.
+  nodeStats.classCounts = std::move(classCounts);
+
+  if (node.NumChildren() == 0)
+    return;
+
+  std::vector<arma::uvec> childPoints;
+  PartitionPoints(node, points, childPoints);
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    UpdateNode(node.Child(i), nodeStats.childStats[i], childPoints[i],
+        depth + 1);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType>
+void IncrementalDecisionTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType,
+    DimensionSelectionType
+>::RebuildNode(DecisionTreeType& node,
+               NodeStats& nodeStats,
+               const arma::uvec& points,
+               const size_t depth)
+{
+  arma::mat nodeData = dataset.cols(points);
+  arma::Row<size_t> nodeLabels = labels.cols(points);
+
+  // If there is a depth limit, this subtree only gets the depth that remains
+  // below its position in the tree.
+  const size_t remainingDepth = (maximumDepth == 0) ? 0 :
+      std::max(maximumDepth - depth, (size_t) 1);
+  node.Train(std::move(nodeData), std::move(nodeLabels), numClasses,
+      minimumLeafSize, minimumGainSplit, remainingDepth);
+
+  BuildStats(node, nodeStats, points);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
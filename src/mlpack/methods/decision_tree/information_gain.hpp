@@ -207,6 +207,88 @@ class InformationGain
     // log2(1/n) = -log2(n).  So, the range is log2(n).
     return std::log2(numClasses);
   }
+
+  /**
+   * Incremental evaluator for sweeping a split boundary over a sorted
+   * dimension.  Using sum_i f_i log2(f_i) = (sum_i c_i log2(c_i)) / T
+   * - log2(T), the evaluator keeps the sum of c log2(c) terms of each side of
+   * the boundary current, so moving a point across the boundary costs four
+   * log2() calls and evaluating the gain of either side costs one --
+   * independent of the number of classes.
+   */
+  class IncrementalEvaluator
+  {
+   public:
+    /**
+     * Construct the evaluator with the class counts (or class weight sums) of
+     * the full set; all points start on the right side of the boundary.
+     */
+    IncrementalEvaluator(const arma::vec& counts, const double totalWeight) :
+        leftCounts(counts.n_elem, arma::fill::zeros),
+        rightCounts(counts),
+        leftTotal(0.0),
+        rightTotal(totalWeight),
+        leftSum(0.0),
+        rightSum(0.0)
+    {
+      for (size_t i = 0; i < counts.n_elem; ++i)
+        rightSum += Term(counts[i]);
+    }
+
+    //! Move weight of the given class from the right to the left side.
+    void MoveLeft(const size_t classIndex, const double weight = 1.0)
+    {
+      leftSum -= Term(leftCounts[classIndex]);
+      rightSum -= Term(rightCounts[classIndex]);
+
+      leftCounts[classIndex] += weight;
+      rightCounts[classIndex] -= weight;
+      leftTotal += weight;
+      rightTotal -= weight;
+
+      leftSum += Term(leftCounts[classIndex]);
+      rightSum += Term(rightCounts[classIndex]);
+    }
+
+    //! Get the information gain of the left side of the boundary.
+    double LeftGain() const
+    {
+      return (leftTotal == 0.0) ? 0.0 :
+          (leftSum / leftTotal) - std::log2(leftTotal);
+    }
+
+    //! Get the information gain of the right side of the boundary.
+    double RightGain() const
+    {
+      return (rightTotal == 0.0) ? 0.0 :
+          (rightSum / rightTotal) - std::log2(rightTotal);
+    }
+
+    //! Get the total count (or weight) on the left side of the boundary.
+    double LeftTotal() const { return leftTotal; }
+    //! Get the total count (or weight) on the right side of the boundary.
+    double RightTotal() const { return rightTotal; }
+
+   private:
+    //! Return c * log2(c), the per-class term of the entropy sum.
+    static double Term(const double count)
+    {
+      return (count > 0.0) ? count * std::log2(count) : 0.0;
+    }
+
+    //! The class counts of the left side of the boundary.
+    arma::vec leftCounts;
+    //! The class counts of the right side of the boundary.
+    arma::vec rightCounts;
+    //! The total count on the left side.
+    double leftTotal;
+    //! The total count on the right side.
+    double rightTotal;
+    //! The sum of c log2(c) terms of the left side.
+    double leftSum;
+    //! The sum of c log2(c) terms of the right side.
+    double rightSum;
+  };
 };
 
 } // namespace tree
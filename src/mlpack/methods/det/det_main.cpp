@@ -184,14 +184,12 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     if (params.Has("training_set_estimates"))
     {
       // Compute density estimates for each point in the training set.
-      arma::rowvec trainingDensities(trainingData.n_cols);
+      arma::vec trainingDensities;
       timers.Start("det_estimation_time");
-      for (size_t i = 0; i < trainingData.n_cols; ++i)
-        trainingDensities[i] = tree->ComputeValue(trainingData.unsafe_col(i));
+      tree->ComputeValue(trainingData, trainingDensities);
       timers.Stop("det_estimation_time");
 
-      params.Get<arma::mat>("training_set_estimates") =
-          std::move(trainingDensities);
+      params.Get<arma::mat>("training_set_estimates") = trainingDensities.t();
     }
   }
   else
@@ -208,14 +206,11 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     {
       // Compute test set densities.
       timers.Start("det_test_set_estimation");
-      arma::rowvec testDensities(testData.n_cols);
-
-      for (size_t i = 0; i < testData.n_cols; ++i)
-        testDensities[i] = tree->ComputeValue(testData.unsafe_col(i));
-
+      arma::vec testDensities;
+      tree->ComputeValue(testData, testDensities);
       timers.Stop("det_test_set_estimation");
 
-      params.Get<arma::mat>("test_set_estimates") = std::move(testDensities);
+      params.Get<arma::mat>("test_set_estimates") = testDensities.t();
     }
 
     // Print variable importance.
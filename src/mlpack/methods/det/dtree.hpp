@@ -149,7 +149,9 @@ class DTree
 
   /**
    * Greedily expand the tree.  The points in the dataset will be reordered
-   * during tree growth.
+   * during tree growth.  When OpenMP is enabled, large independent subtrees
+   * are grown concurrently; for dense matrices, each dimension is sorted only
+   * once for the entire build instead of once per node.
    *
    * @param data Dataset to build tree on.
    * @param oldFromNew Mappings from old points to new points.
@@ -182,6 +184,19 @@ class DTree
    */
   double ComputeValue(const VecType& query) const;
 
+  /**
+   * Compute the density estimate of every column of the given query matrix.
+   * Instead of descending the tree once per point, the query points are
+   * recursively partitioned by the tree's splits, so all points destined for
+   * the same subtree are evaluated together while that subtree's nodes are
+   * cache-resident; contiguous chunks of the query set are processed in
+   * parallel.  This should only be called on the root of the tree.
+   *
+   * @param queries Matrix of points to estimate the density of.
+   * @param densities Vector to store the density estimate of each point in.
+   */
+  void ComputeValue(const MatType& queries, arma::vec& densities) const;
+
   /**
    * Index the buckets for possible usage later; this results in every leaf in
    * the tree having a specific tag (accessible with BucketTag()).  This
@@ -336,25 +351,56 @@ class DTree
   // Utility methods.
 
   /**
-   * Find the dimension to split on.
+   * Recursively expand the tree.  If dimOrders and colFromOld are given (see
+   * the public Grow() overload), splits are found from the maintained
+   * per-dimension sorted orders instead of re-sorting at every node, and the
+   * orders are stably partitioned between the children at every split.  Large
+   * independent subtrees are grown concurrently as OpenMP tasks.
+   */
+  double Grow(MatType& data,
+              arma::Col<size_t>& oldFromNew,
+              const bool useVolReg,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              arma::Mat<size_t>* dimOrders,
+              arma::Col<size_t>* colFromOld);
+
+  /**
+   * Find the dimension to split on.  If dimOrders and colFromOld are given,
+   * the split candidates of each dimension are gathered from the presorted
+   * orders instead of re-sorting the dimension's values.
    */
   bool FindSplit(const MatType& data,
                  size_t& splitDim,
                  ElemType& splitValue,
                  double& leftError,
                  double& rightError,
-                 const size_t minLeafSize = 5) const;
+                 const size_t minLeafSize = 5,
+                 const arma::Mat<size_t>* dimOrders = NULL,
+                 const arma::Col<size_t>* colFromOld = NULL) const;
 
   /**
-   * Split the data, returning the number of points left of the split.
+   * Split the data, returning the number of points left of the split.  If
+   * colFromOld is given, it is kept in sync with oldFromNew.
    */
   size_t SplitData(MatType& data,
                    const size_t splitDim,
                    const ElemType splitValue,
-                   arma::Col<size_t>& oldFromNew) const;
+                   arma::Col<size_t>& oldFromNew,
+                   arma::Col<size_t>* colFromOld = NULL) const;
 
   void  FillMinMax(const StatType& mins,
                    const StatType& maxs);
+
+  /**
+   * Evaluate the density of a bucket of query points (given as a range of
+   * column indices) against this subtree, partitioning the bucket by the
+   * split at every internal node.
+   */
+  void ComputeValue(const MatType& queries,
+                    const std::vector<size_t>::iterator begin,
+                    const std::vector<size_t>::iterator end,
+                    arma::vec& densities) const;
 };
 
 } // namespace det
@@ -12,12 +12,17 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include "dtree.hpp"
+#include <algorithm>
 #include <stack>
 #include <vector>
 
 using namespace mlpack;
 using namespace det;
 
+//! Subtrees with fewer points than this are grown serially: below this size,
+//! OpenMP task overhead outweighs the benefit of another worker.
+static const size_t minParallelGrowSize = 8192;
+
 namespace details
 {
 
@@ -147,6 +152,46 @@ void ExtractSplits(std::vector<std::pair<ElemType, size_t>>& splitVec,
   }
 }
 
+/**
+ * Build the per-dimension sorted point orders that let the tree sort every
+ * dimension only once, at the root.  General implementation: no orders are
+ * built and false is returned, so FindSplit() falls back to ExtractSplits()
+ * (which has a specially optimized sparse version).
+ */
+template<typename ElemType, typename MatType>
+bool BuildDimOrders(arma::Mat<size_t>& /* dimOrders */,
+                    const MatType& /* data */,
+                    const arma::Col<size_t>& /* oldFromNew */)
+{
+  return false;
+}
+
+// The dense implementation.  Each row of dimOrders holds the original indices
+// (the values of oldFromNew) of all points, ordered by their value in that
+// dimension.
+template<typename ElemType>
+bool BuildDimOrders(arma::Mat<size_t>& dimOrders,
+                    const arma::Mat<ElemType>& data,
+                    const arma::Col<size_t>& oldFromNew)
+{
+  dimOrders.set_size(data.n_rows, data.n_cols);
+
+#ifdef _WIN32
+  #pragma omp parallel for default(shared)
+  for (intmax_t dim = 0; dim < (intmax_t) data.n_rows; ++dim)
+#else
+  #pragma omp parallel for default(shared)
+  for (size_t dim = 0; dim < data.n_rows; ++dim)
+#endif
+  {
+    const arma::uvec order = arma::stable_sort_index(data.row(dim));
+    for (size_t i = 0; i < order.n_elem; ++i)
+      dimOrders(dim, i) = oldFromNew[order[i]];
+  }
+
+  return true;
+}
+
 } // namespace details
 
 template<typename MatType, typename TagType>
@@ -439,7 +484,10 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
                                         ElemType& splitValue,
                                         double& leftError,
                                         double& rightError,
-                                        const size_t minLeafSize) const
+                                        const size_t minLeafSize,
+                                        const arma::Mat<size_t>* dimOrders,
+                                        const arma::Col<size_t>* colFromOld)
+    const
 {
   typedef std::pair<ElemType, size_t> SplitItem;
 
@@ -488,8 +536,28 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
     // sparse matrices.
 
     std::vector<SplitItem> splitVec;
-    details::ExtractSplits<ElemType>(splitVec, data, dim, start, end,
-        minLeafSize);
+    if (dimOrders != NULL)
+    {
+      // The points of this node are already in sorted order for this
+      // dimension; gather the split candidates without re-sorting.
+      for (size_t i = minLeafSize - 1; i < points - minLeafSize; ++i)
+      {
+        const ElemType cur =
+            data(dim, (*colFromOld)[(*dimOrders)(dim, start + i)]);
+        const ElemType next =
+            data(dim, (*colFromOld)[(*dimOrders)(dim, start + i + 1)]);
+        const ElemType split = (cur + next) / 2.0;
+
+        // Check if we can split here (two points are different).
+        if (split != cur)
+          splitVec.push_back(SplitItem(split, i + 1));
+      }
+    }
+    else
+    {
+      details::ExtractSplits<ElemType>(splitVec, data, dim, start, end,
+          minLeafSize);
+    }
 
     // Iterate on all the splits for this dimension
     for (typename std::vector<SplitItem>::iterator i = splitVec.begin();
@@ -555,7 +623,8 @@ template<typename MatType, typename TagType>
 size_t DTree<MatType, TagType>::SplitData(MatType& data,
                                           const size_t splitDim,
                                           const ElemType splitValue,
-                                          arma::Col<size_t>& oldFromNew) const
+                                          arma::Col<size_t>& oldFromNew,
+                                          arma::Col<size_t>* colFromOld) const
 {
   // Swap all columns such that any columns with value in dimension splitDim
   // less than or equal to splitValue are on the left side, and all others are
@@ -579,6 +648,14 @@ size_t DTree<MatType, TagType>::SplitData(MatType& data,
     const size_t tmp = oldFromNew[left];
     oldFromNew[left] = oldFromNew[right];
     oldFromNew[right] = tmp;
+
+    // Keep the inverse mapping (used by the presorted dimension orders) in
+    // sync.
+    if (colFromOld != NULL)
+    {
+      (*colFromOld)[oldFromNew[left]] = left;
+      (*colFromOld)[oldFromNew[right]] = right;
+    }
   }
 
   // This now refers to the first index of the "right" side.
@@ -592,6 +669,40 @@ double DTree<MatType, TagType>::Grow(MatType& data,
                                      const bool useVolReg,
                                      const size_t maxLeafSize,
                                      const size_t minLeafSize)
+{
+  // For dense data covering the whole matrix, sort every dimension once up
+  // front; the sorted orders are stably partitioned at every split, so no
+  // node ever re-sorts during FindSplit().  For other matrix types (sparse
+  // data has a specially optimized ExtractSplits()) every node extracts its
+  // splits as before.
+  arma::Mat<size_t> dimOrders;
+  if (start == 0 && end == data.n_cols &&
+      details::BuildDimOrders<ElemType>(dimOrders, data, oldFromNew))
+  {
+    // colFromOld is the inverse of oldFromNew: it maps the original index of
+    // a point to the column it currently occupies, and SplitData() keeps it
+    // in sync as columns are swapped.
+    arma::Col<size_t> colFromOld(oldFromNew.n_elem);
+    for (size_t i = 0; i < oldFromNew.n_elem; ++i)
+      colFromOld[oldFromNew[i]] = i;
+
+    return Grow(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize,
+        &dimOrders, &colFromOld);
+  }
+
+  return Grow(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize, NULL,
+      NULL);
+}
+
+// Greedily expand the tree, recursively.
+template<typename MatType, typename TagType>
+double DTree<MatType, TagType>::Grow(MatType& data,
+                                     arma::Col<size_t>& oldFromNew,
+                                     const bool useVolReg,
+                                     const size_t maxLeafSize,
+                                     const size_t minLeafSize,
+                                     arma::Mat<size_t>* dimOrders,
+                                     arma::Col<size_t>* colFromOld)
 {
   Log::Assert(data.n_rows == maxVals.n_elem);
   Log::Assert(data.n_rows == minVals.n_elem);
@@ -614,11 +725,43 @@ double DTree<MatType, TagType>::Grow(MatType& data,
     size_t dim;
     double splitValueTmp;
     double leftError, rightError;
-    if (FindSplit(data, dim, splitValueTmp, leftError, rightError, minLeafSize))
+    if (FindSplit(data, dim, splitValueTmp, leftError, rightError, minLeafSize,
+        dimOrders, colFromOld))
     {
       // Move the data around for the children to have points in a node lie
       // contiguously (to increase efficiency during the training).
-      const size_t splitIndex = SplitData(data, dim, splitValueTmp, oldFromNew);
+      const size_t splitIndex = SplitData(data, dim, splitValueTmp, oldFromNew,
+          colFromOld);
+
+      // Stably partition each dimension's sorted order between the two
+      // children, so that no descendant ever has to re-sort a dimension.
+      if (dimOrders != NULL)
+      {
+#ifdef _WIN32
+        #pragma omp parallel for default(shared)
+        for (intmax_t sortDim = 0; sortDim < (intmax_t) maxVals.n_elem;
+            ++sortDim)
+#else
+        #pragma omp parallel for default(shared)
+        for (size_t sortDim = 0; sortDim < maxVals.n_elem; ++sortDim)
+#endif
+        {
+          arma::Row<size_t> buffer(end - start);
+          size_t posLeft = 0;
+          size_t posRight = splitIndex - start;
+          for (size_t i = start; i < end; ++i)
+          {
+            const size_t oldIndex = (*dimOrders)(sortDim, i);
+            if ((*colFromOld)[oldIndex] < splitIndex)
+              buffer[posLeft++] = oldIndex;
+            else
+              buffer[posRight++] = oldIndex;
+          }
+
+          (*dimOrders)(arma::span(sortDim, sortDim),
+              arma::span(start, end - 1)) = buffer;
+        }
+      }
 
       // Make max and min vals for the children.
       StatType maxValsL(maxVals);
@@ -633,14 +776,35 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       splitValue = splitValueTmp;
       splitDim = dim;
 
-      // Recursively grow the children.
+      // Recursively grow the children.  Each child operates on a disjoint
+      // column range of the dataset (and of the per-dimension orders), so
+      // large subtrees can be grown concurrently as OpenMP tasks; the root
+      // establishes the thread team that the subtree tasks run on.
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+      auto growChildren = [&]()
+      {
+        #pragma omp task default(shared) \
+            if (splitIndex - start >= minParallelGrowSize)
+        leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+            minLeafSize, dimOrders, colFromOld);
+
+        rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+            minLeafSize, dimOrders, colFromOld);
+        #pragma omp taskwait
+      };
+
+      if (root)
+      {
+        #pragma omp parallel if (end - start >= minParallelGrowSize)
+        #pragma omp single nowait
+        growChildren();
+      }
+      else
+      {
+        growChildren();
+      }
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -883,6 +1047,73 @@ double DTree<MatType, TagType>::ComputeValue(const VecType& query) const
       right->ComputeValue(query);
 }
 
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::ComputeValue(const MatType& queries,
+                                           arma::vec& densities) const
+{
+  Log::Assert(queries.n_rows == maxVals.n_elem);
+
+  densities.set_size(queries.n_cols);
+
+  // Process the query set in contiguous chunks, in parallel.  Within a
+  // chunk, the points are recursively partitioned by the tree's splits, so
+  // all points destined for the same subtree are evaluated together while
+  // that subtree's nodes are cache-resident.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+  numThreads = (size_t) omp_get_max_threads();
+  #endif
+  const size_t numChunks = std::min((size_t) queries.n_cols, numThreads * 8);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const size_t chunkBegin = (queries.n_cols * c) / numChunks;
+    const size_t chunkEnd = (queries.n_cols * (c + 1)) / numChunks;
+
+    // Points outside the root's range have density zero and are dropped from
+    // the bucket up front.
+    std::vector<size_t> bucket;
+    bucket.reserve(chunkEnd - chunkBegin);
+    for (size_t i = chunkBegin; i < chunkEnd; ++i)
+    {
+      if (WithinRange(queries.col(i)))
+        bucket.push_back(i);
+      else
+        densities[i] = 0.0;
+    }
+
+    ComputeValue(queries, bucket.begin(), bucket.end(), densities);
+  }
+}
+
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::ComputeValue(
+    const MatType& queries,
+    const std::vector<size_t>::iterator begin,
+    const std::vector<size_t>::iterator end,
+    arma::vec& densities) const
+{
+  if (begin == end)
+    return;
+
+  if (subtreeLeaves == 1)  // If we are a leaf...
+  {
+    const double value = std::exp(std::log(ratio) - logVolume);
+    for (std::vector<size_t>::iterator it = begin; it != end; ++it)
+      densities[*it] = value;
+    return;
+  }
+
+  // Partition the bucket by the split, then evaluate each child's subtree
+  // with its whole group of points at once.
+  const std::vector<size_t>::iterator mid = std::partition(begin, end,
+      [&](const size_t i) { return queries(splitDim, i) <= splitValue; });
+
+  left->ComputeValue(queries, begin, mid, densities);
+  right->ComputeValue(queries, mid, end, densities);
+}
+
 // Index the buckets for possible usage later.
 template<typename MatType, typename TagType>
 TagType DTree<MatType, TagType>::TagTree(const TagType& tag, bool every)
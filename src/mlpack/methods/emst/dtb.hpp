@@ -115,6 +115,11 @@ class DualTreeBoruvka
   //! Total distance of the tree.
   double totalDist;
 
+  //! Number of base cases performed by the last ComputeMST() call.
+  size_t baseCases;
+  //! Number of node combinations scored by the last ComputeMST() call.
+  size_t scores;
+
   //! The instantiated metric.
   MetricType metric;
 
@@ -175,6 +180,13 @@ class DualTreeBoruvka
    */
   void ComputeMST(arma::mat& results);
 
+  //! Get the number of base cases performed by the last ComputeMST() call,
+  //! summed over all Boruvka rounds and threads.
+  size_t BaseCases() const { return baseCases; }
+  //! Get the number of node combinations scored by the last ComputeMST()
+  //! call, summed over all Boruvka rounds and threads.
+  size_t Scores() const { return scores; }
+
  private:
   /**
    * Adds a single edge to the edge list
@@ -186,6 +198,16 @@ class DualTreeBoruvka
    */
   void AddAllEdges();
 
+  /**
+   * Collect a set of disjoint query subtrees that together cover the whole
+   * tree, for use as the units of work of the parallel dual traversal.  The
+   * frontier is grown breadth-first until it holds at least target nodes (or
+   * only leaves remain).
+   */
+  void CollectFrontier(Tree* node,
+                       const size_t target,
+                       std::vector<Tree*>& frontier);
+
   /**
    * Unpermute the edge list and output it to results.
    */
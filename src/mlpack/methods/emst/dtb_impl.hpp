@@ -14,6 +14,8 @@
 
 #include "dtb_rules.hpp"
 
+#include <queue>
+
 namespace mlpack {
 namespace emst {
 
@@ -59,6 +61,8 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     naive(naive),
     connections(dataset.n_cols),
     totalDist(0.0),
+    baseCases(0),
+    scores(0),
     metric(metric)
 {
   edges.reserve(data.n_cols - 1); // Set size.
@@ -84,6 +88,8 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     naive(false),
     connections(data.n_cols),
     totalDist(0.0),
+    baseCases(0),
+    scores(0),
     metric(metric)
 {
   edges.reserve(data.n_cols - 1); // Fill with EdgePairs.
@@ -120,23 +126,102 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     arma::mat& results)
 {
   totalDist = 0; // Reset distance.
+  baseCases = 0; // Reset traversal counters.
+  scores = 0;
+
+  // Each round's component-wise nearest-neighbor searches are independent, so
+  // the traversal work of a round is partitioned over threads.  Every thread
+  // gets its own rule set and its own candidate-edge arrays; the per-thread
+  // candidates are merged by a component-wise minimum after the traversal, so
+  // no synchronization is needed during the search itself.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+  numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  std::vector<arma::vec> threadDistances(numThreads);
+  std::vector<arma::Col<size_t>> threadInComponent(numThreads);
+  std::vector<arma::Col<size_t>> threadOutComponent(numThreads);
 
   typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+  std::vector<RuleType> rules;
+  rules.reserve(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threadDistances[t].set_size(data.n_cols);
+    threadInComponent[t].set_size(data.n_cols);
+    threadOutComponent[t].set_size(data.n_cols);
+
+    rules.push_back(RuleType(data, connections, threadDistances[t],
+        threadInComponent[t], threadOutComponent[t], metric));
+  }
+
+  size_t round = 0;
   while (edges.size() < (data.n_cols - 1))
   {
+    // Advancing the round invalidates the neighbor-distance bounds cached in
+    // every tree node at once (see DTBStat::Round()), so no reset pass over
+    // the tree is needed.
+    ++round;
+    for (size_t t = 0; t < numThreads; ++t)
+      rules[t].Round() = round;
+
+    // Compress the union-find structure so that Find() performs no writes
+    // during the traversal; concurrent component lookups are then safe.
+    connections.Flatten();
+
+    for (size_t t = 0; t < numThreads; ++t)
+      threadDistances[t].fill(DBL_MAX);
+
     if (naive)
     {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
+      // Full O(N^2) traversal; query points are independent.
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+      {
+        size_t threadId = 0;
+        #ifdef HAS_OPENMP
+        threadId = (size_t) omp_get_thread_num();
+        #endif
+
         for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
+          rules[threadId].BaseCase((size_t) i, j);
+      }
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      // Partition the dual traversal into one traversal per query subtree.
+      // Query node statistics are only written by the thread that owns the
+      // subtree; reference nodes are only read.
+      std::vector<Tree*> frontier;
+      CollectFrontier(tree, 4 * numThreads, frontier);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t f = 0; f < (omp_size_t) frontier.size(); ++f)
+      {
+        size_t threadId = 0;
+        #ifdef HAS_OPENMP
+        threadId = (size_t) omp_get_thread_num();
+        #endif
+
+        typename Tree::template DualTreeTraverser<RuleType>
+            traverser(rules[threadId]);
+        traverser.Traverse(*frontier[f], *tree);
+      }
+    }
+
+    // Merge the per-thread candidate edges with a component-wise minimum.
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      for (size_t c = 0; c < data.n_cols; ++c)
+      {
+        if (threadDistances[t][c] < neighborsDistances[c])
+        {
+          neighborsDistances[c] = threadDistances[t][c];
+          neighborsInComponent[c] = threadInComponent[t][c];
+          neighborsOutComponent[c] = threadOutComponent[t][c];
+        }
+      }
     }
 
     AddAllEdges();
@@ -146,12 +231,26 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     Log::Info << edges.size() << " edges found so far." << std::endl;
     if (!naive)
     {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
+      size_t totalBaseCases = 0, totalScores = 0;
+      for (size_t t = 0; t < numThreads; ++t)
+      {
+        totalBaseCases += rules[t].BaseCases();
+        totalScores += rules[t].Scores();
+      }
+      Log::Info << totalBaseCases << " cumulative base cases." << std::endl;
+      Log::Info << totalScores << " cumulative node combinations scored."
           << std::endl;
     }
   }
 
+  // The rule counters accumulate across rounds, so the totals can be taken
+  // once the tree is complete.
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    baseCases += rules[t].BaseCases();
+    scores += rules[t].Scores();
+  }
+
   EmitResults(results);
 
   Log::Info << "Total spanning tree length: " << totalDist << std::endl;
@@ -191,9 +290,16 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
 {
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Candidate edges are stored at the component roots of the traversal, so
+  // it suffices to examine each candidate slot once; slots of non-root points
+  // are never written and keep their DBL_MAX sentinel.  The unions themselves
+  // stay serial: they are a vanishing fraction of the round, and a fixed
+  // order keeps the produced tree deterministic.
+  for (size_t component = 0; component < data.n_cols; ++component)
   {
-    size_t component = connections.Find(i);
+    if (neighborsDistances[component] == DBL_MAX)
+      continue; // Not a component root, or no edge leaves the component.
+
     size_t inEdge = neighborsInComponent[component];
     size_t outEdge = neighborsOutComponent[component];
     if (connections.Find(inEdge) != connections.Find(outEdge))
@@ -207,6 +313,47 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
   }
 }
 
+/**
+ * Collect a set of disjoint query subtrees covering the whole tree.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::CollectFrontier(
+    Tree* node,
+    const size_t target,
+    std::vector<Tree*>& frontier)
+{
+  // Expand nodes breadth-first until the frontier is large enough for decent
+  // load balance (or only leaves remain).
+  std::queue<Tree*> queue;
+  queue.push(node);
+  while (!queue.empty() && (queue.size() + frontier.size()) < target)
+  {
+    Tree* current = queue.front();
+    queue.pop();
+
+    if (current->NumChildren() == 0)
+    {
+      frontier.push_back(current);
+    }
+    else
+    {
+      for (size_t i = 0; i < current->NumChildren(); ++i)
+        queue.push(&current->Child(i));
+    }
+  }
+
+  while (!queue.empty())
+  {
+    frontier.push_back(queue.front());
+    queue.pop();
+  }
+}
+
 /**
  * Unpermute the edge list (if necessary) and output it to results.
  */
@@ -274,10 +421,22 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::CleanupHelper(Tree* tree)
 {
-  // Reset the statistic information.
-  tree->Stat().MaxNeighborDistance() = DBL_MAX;
-  tree->Stat().MinNeighborDistance() = DBL_MAX;
-  tree->Stat().Bound() = DBL_MAX;
+  // The neighbor-distance bounds need no reset here: they are stamped with
+  // the round that wrote them (see DTBStat::Round()) and bounds from earlier
+  // rounds are ignored.
+  //
+  // If every descendant was already in one component, the component can only
+  // have been merged into a larger one since, so the cached ID is refreshed
+  // with a single Find() and the descent is skipped entirely.  The
+  // descendants keep their stale IDs, which is safe: component IDs only ever
+  // merge, so two equal stale IDs still imply the same component and the
+  // same-component prune remains sound.
+  if (tree->Stat().ComponentMembership() >= 0)
+  {
+    tree->Stat().ComponentMembership() =
+        (int) connections.Find((size_t) tree->Stat().ComponentMembership());
+    return;
+  }
 
   // Recurse into all children.
   for (size_t i = 0; i < tree->NumChildren(); ++i)
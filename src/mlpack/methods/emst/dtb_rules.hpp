@@ -16,6 +16,8 @@
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include "dtb_stat.hpp"
+
 namespace mlpack {
 namespace emst {
 
@@ -97,6 +99,13 @@ class DTBRules
   //! Modify the number of node combinations that have been scored.
   size_t& Scores() { return scores; }
 
+  //! Get the current Boruvka round.
+  size_t Round() const { return round; }
+  //! Modify the current Boruvka round.  Node bounds stamped with an earlier
+  //! round are treated as unset, so advancing the round invalidates every
+  //! bound in the tree at once.
+  size_t& Round() { return round; }
+
  private:
   //! The data points.
   const arma::mat& dataSet;
@@ -129,6 +138,8 @@ class DTBRules
   size_t baseCases;
   //! The number of node combinations that have been scored.
   size_t scores;
+  //! The current Boruvka round, used to stamp the node bounds.
+  size_t round;
 }; // class DTBRules
 
 } // namespace emst
@@ -31,7 +31,8 @@ DTBRules(const arma::mat& dataSet,
   neighborsOutComponent(neighborsOutComponent),
   metric(metric),
   baseCases(0),
-  scores(0)
+  scores(0),
+  round(0)
 {
   // Nothing else to do.
 }
@@ -161,14 +162,19 @@ inline double DTBRules<MetricType, TreeType>::CalculateBound(
       bestPointBound = bound;
   }
 
-  // Find the best and worst child bounds.
+  // Find the best and worst child bounds.  Bounds stamped with an earlier
+  // round belong to a previous Boruvka round, where the candidate edges were
+  // different; they are treated as unset.
   for (size_t i = 0; i < queryNode.NumChildren(); ++i)
   {
-    const double maxBound = queryNode.Child(i).Stat().MaxNeighborDistance();
+    const DTBStat& childStat = queryNode.Child(i).Stat();
+    const bool fresh = (childStat.Round() == round);
+
+    const double maxBound = fresh ? childStat.MaxNeighborDistance() : DBL_MAX;
     if (maxBound > worstChildBound)
       worstChildBound = maxBound;
 
-    const double minBound = queryNode.Child(i).Stat().MinNeighborDistance();
+    const double minBound = fresh ? childStat.MinNeighborDistance() : DBL_MAX;
     if (minBound < bestChildBound)
       bestChildBound = minBound;
   }
@@ -180,10 +186,12 @@ inline double DTBRules<MetricType, TreeType>::CalculateBound(
   const double bestAdjustedBound = (bestBound == DBL_MAX) ? DBL_MAX :
       bestBound + 2 * queryNode.FurthestDescendantDistance();
 
-  // Update the relevant quantities in the node.
+  // Update the relevant quantities in the node, stamping them with the
+  // current round.
   queryNode.Stat().MaxNeighborDistance() = worstBound;
   queryNode.Stat().MinNeighborDistance() = bestBound;
   queryNode.Stat().Bound() = std::min(worstBound, bestAdjustedBound);
+  queryNode.Stat().Round() = round;
 
   return queryNode.Stat().Bound();
 }
@@ -41,6 +41,12 @@ class DTBStat
   //! negative.
   int componentMembership;
 
+  //! The Boruvka round in which the neighbor-distance bounds were last
+  //! written.  Bounds written in an earlier round are treated as unset
+  //! (DBL_MAX), so the per-round reset does not require a pass over the whole
+  //! tree.
+  size_t round;
+
  public:
   /**
    * A generic initializer.  Sets the maximum neighbor distance to its default,
@@ -50,7 +56,8 @@ class DTBStat
       maxNeighborDistance(DBL_MAX),
       minNeighborDistance(DBL_MAX),
       bound(DBL_MAX),
-      componentMembership(-1) { }
+      componentMembership(-1),
+      round(0) { }
 
   /**
    * This is called when a node is finished initializing.  We set the maximum
@@ -66,7 +73,8 @@ class DTBStat
       bound(DBL_MAX),
       componentMembership(
           ((node.NumPoints() == 1) && (node.NumChildren() == 0)) ?
-            node.Point(0) : -1) { }
+            node.Point(0) : -1),
+      round(0) { }
 
   //! Get the maximum neighbor distance.
   double MaxNeighborDistance() const { return maxNeighborDistance; }
@@ -87,6 +95,11 @@ class DTBStat
   int ComponentMembership() const { return componentMembership; }
   //! Modify the component membership of this node.
   int& ComponentMembership() { return componentMembership; }
+
+  //! Get the round in which the bounds were last written.
+  size_t Round() const { return round; }
+  //! Modify the round in which the bounds were last written.
+  size_t& Round() { return round; }
 }; // class DTBStat
 
 } // namespace emst
@@ -325,6 +325,17 @@ class FastMKS
   //! The instantiated inner-product metric induced by the given kernel.
   metric::IPMetric<KernelType> metric;
 
+  //! Cached self-kernel values (sqrt(K(r, r)) for each reference point r).
+  //! These are computed once per reference set and handed to the rules at
+  //! search time, instead of being recomputed on every search.
+  arma::vec referenceSelfKernels;
+
+  /**
+   * Return the cached reference self-kernels, computing them first if the
+   * reference set has changed since they were last computed.
+   */
+  const arma::vec& ReferenceSelfKernels();
+
   //! Candidate represents a possible candidate point (value, index).
   typedef std::pair<double, size_t> Candidate;
 
@@ -339,6 +350,24 @@ class FastMKS
   //! Use a priority queue to represent the list of candidate points.
   typedef std::priority_queue<Candidate, std::vector<Candidate>,
       CandidateCmp> CandidateList;
+
+  /**
+   * Perform naive max-kernel search for a dot-product kernel, evaluating the
+   * kernel over blocks of query points as a matrix product so the BLAS does
+   * the bulk of the work.  If sameSet is true, a point is never returned as
+   * its own candidate.
+   *
+   * @param querySet Set of query points.
+   * @param k The number of maximum kernels to find.
+   * @param indices Matrix to store resulting indices of max-kernel search in.
+   * @param kernels Matrix to store resulting max-kernel values in.
+   * @param sameSet If true, the query set is the reference set.
+   */
+  void NaiveDotProductSearch(const MatType& querySet,
+                             const size_t k,
+                             arma::Mat<size_t>& indices,
+                             arma::mat& kernels,
+                             const bool sameSet);
 };
 
 } // namespace fastmks
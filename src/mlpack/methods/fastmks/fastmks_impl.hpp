@@ -234,6 +234,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(const FastMKS& other)
 
   singleMode = other.singleMode;
   naive = other.naive;
+  referenceSelfKernels.reset();
 }
 
 template<typename KernelType,
@@ -253,6 +254,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(FastMKS&& other)
     singleMode = other.singleMode;
     naive = other.naive;
     metric = std::move(other.metric);
+    referenceSelfKernels = std::move(other.referenceSelfKernels);
 
     // Clear information from the other.
     other.referenceSet = nullptr;
@@ -291,6 +293,7 @@ void FastMKS<KernelType, MatType, TreeType>::Train(const MatType& referenceSet)
 
   this->referenceSet = &referenceSet;
   this->setOwner = false;
+  this->referenceSelfKernels.reset();
 
   if (!naive)
   {
@@ -315,6 +318,7 @@ void FastMKS<KernelType, MatType, TreeType>::Train(const MatType& referenceSet,
   this->referenceSet = &referenceSet;
   this->metric = metric::IPMetric<KernelType>(kernel);
   this->setOwner = false;
+  this->referenceSelfKernels.reset();
 
   if (!naive)
   {
@@ -334,6 +338,7 @@ void FastMKS<KernelType, MatType, TreeType>::Train(MatType&& referenceSet)
 {
   if (setOwner)
     delete this->referenceSet;
+  referenceSelfKernels.reset();
 
   if (!naive)
   {
@@ -363,6 +368,7 @@ void FastMKS<KernelType, MatType, TreeType>::Train(MatType&& referenceSet,
     delete this->referenceSet;
 
   this->metric = metric::IPMetric<KernelType>(kernel);
+  this->referenceSelfKernels.reset();
 
   if (!naive)
   {
@@ -396,6 +402,7 @@ void FastMKS<KernelType, MatType, TreeType>::Train(Tree* tree)
   this->referenceSet = &tree->Dataset();
   this->metric = metric::IPMetric<KernelType>(tree->Metric().Kernel());
   this->setOwner = false;
+  this->referenceSelfKernels.reset();
 
   if (treeOwner && referenceTree)
     delete referenceTree;
@@ -439,6 +446,16 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
+    // For dot-product kernels the kernel values between a block of query
+    // points and the whole reference set form a matrix product, so the bulk
+    // of the work can be handed to the BLAS.
+    if (kernel::KernelTraits<KernelType>::IsDotProduct)
+    {
+      NaiveDotProductSearch(querySet, k, indices, kernels,
+          (&querySet == referenceSet));
+      return;
+    }
+
     // Simple double loop.  Stupid, slow, but a good benchmark.
     for (size_t q = 0; q < querySet.n_cols; ++q)
     {
@@ -476,7 +493,8 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
     // Create rules object (this will store the results).  This constructor
     // precalculates each self-kernel value.
     typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, querySet, k, metric.Kernel());
+    RuleType rules(*referenceSet, querySet, k, metric.Kernel(),
+        ReferenceSelfKernels());
 
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
@@ -537,7 +555,8 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   kernels.set_size(k, queryTree->Dataset().n_cols);
 
   typedef FastMKSRules<KernelType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), k, metric.Kernel());
+  RuleType rules(*referenceSet, queryTree->Dataset(), k, metric.Kernel(),
+      ReferenceSelfKernels());
 
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
@@ -566,6 +585,15 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
+    // For dot-product kernels the kernel values between a block of query
+    // points and the whole reference set form a matrix product, so the bulk
+    // of the work can be handed to the BLAS.
+    if (kernel::KernelTraits<KernelType>::IsDotProduct)
+    {
+      NaiveDotProductSearch(*referenceSet, k, indices, kernels, true);
+      return;
+    }
+
     // Simple double loop.  Stupid, slow, but a good benchmark.
     for (size_t q = 0; q < referenceSet->n_cols; ++q)
     {
@@ -606,7 +634,8 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
     // Create rules object (this will store the results).  This constructor
     // precalculates each self-kernel value.
     typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel());
+    RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel(),
+        ReferenceSelfKernels());
 
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
@@ -630,6 +659,108 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   Search(referenceTree, k, indices, kernels);
 }
 
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+const arma::vec&
+FastMKS<KernelType, MatType, TreeType>::ReferenceSelfKernels()
+{
+  // Compute the self-kernels if the cache does not match the current
+  // reference set.  Every path that changes the reference set clears the
+  // cache, so a size match means the cache is valid.
+  if (referenceSelfKernels.n_elem != referenceSet->n_cols)
+  {
+    referenceSelfKernels.set_size(referenceSet->n_cols);
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      referenceSelfKernels[i] = sqrt(metric.Kernel().Evaluate(
+          referenceSet->col(i), referenceSet->col(i)));
+  }
+
+  return referenceSelfKernels;
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::NaiveDotProductSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet)
+{
+  // A normalized dot-product kernel divides the dot product by the norms of
+  // the two points, so precompute the norms.
+  arma::vec refNorms, queryNorms;
+  if (kernel::KernelTraits<KernelType>::IsNormalized)
+  {
+    refNorms.set_size(referenceSet->n_cols);
+    for (size_t r = 0; r < referenceSet->n_cols; ++r)
+      refNorms[r] = arma::norm(referenceSet->col(r), 2);
+
+    if (sameSet)
+    {
+      queryNorms = refNorms;
+    }
+    else
+    {
+      queryNorms.set_size(querySet.n_cols);
+      for (size_t q = 0; q < querySet.n_cols; ++q)
+        queryNorms[q] = arma::norm(querySet.col(q), 2);
+    }
+  }
+
+  // Block over the query set so the kernel matrix stays small enough to fit
+  // in cache.
+  const size_t blockSize = 256;
+  for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize,
+        (size_t) querySet.n_cols) - 1;
+
+    // One GEMM computes every kernel value for this block of queries.
+    const arma::mat kernelBlock(arma::trans(*referenceSet) *
+        querySet.cols(begin, end));
+
+    for (size_t j = 0; j < kernelBlock.n_cols; ++j)
+    {
+      const size_t q = begin + j;
+
+      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+      std::vector<Candidate> cList(k, def);
+      CandidateList pqueue(CandidateCmp(), std::move(cList));
+
+      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+      {
+        if (sameSet && (q == r))
+          continue; // Don't return the point as its own candidate.
+
+        double eval = kernelBlock(r, j);
+        if (kernel::KernelTraits<KernelType>::IsNormalized)
+          eval /= (refNorms[r] * queryNorms[q]);
+
+        if (eval > pqueue.top().first)
+        {
+          Candidate c = std::make_pair(eval, r);
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
+
+      for (size_t j2 = 1; j2 <= k; ++j2)
+      {
+        indices(k - j2, q) = pqueue.top().second;
+        kernels(k - j2, q) = pqueue.top().first;
+        pqueue.pop();
+      }
+    }
+  }
+}
+
 //! Serialize the model.
 template<typename KernelType,
          typename MatType,
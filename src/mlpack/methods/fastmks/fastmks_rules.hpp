@@ -48,6 +48,25 @@ class FastMKSRules
                const size_t k,
                KernelType& kernel);
 
+  /**
+   * Construct the FastMKSRules object with precomputed reference self-kernels
+   * (sqrt(K(r, r)) for each reference point r).  This avoids recomputing the
+   * self-kernels on every search; the FastMKS class caches them at build time.
+   * If the query set is the same object as the reference set, the query
+   * self-kernels are reused too.
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param k Number of candidates to search for.
+   * @param kernel Kernel to run FastMKS with.
+   * @param referenceSelfKernels Cached sqrt(K(r, r)) for each reference point.
+   */
+  FastMKSRules(const typename TreeType::Mat& referenceSet,
+               const typename TreeType::Mat& querySet,
+               const size_t k,
+               KernelType& kernel,
+               const arma::vec& referenceSelfKernels);
+
   /**
    * Store the list of candidates for each query point in the given matrices.
    *
@@ -64,6 +64,58 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
   candidates.swap(tmp);
 }
 
+template<typename KernelType, typename TreeType>
+FastMKSRules<KernelType, TreeType>::FastMKSRules(
+    const typename TreeType::Mat& referenceSet,
+    const typename TreeType::Mat& querySet,
+    const size_t k,
+    KernelType& kernel,
+    const arma::vec& referenceSelfKernels) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    k(k),
+    referenceKernels(referenceSelfKernels),
+    kernel(kernel),
+    lastQueryIndex(-1),
+    lastReferenceIndex(-1),
+    lastKernel(0.0),
+    baseCases(0),
+    scores(0)
+{
+  // The reference self-kernels were computed when the model was built; only
+  // the query self-kernels remain, and in the monochromatic case those are
+  // the reference self-kernels too.
+  if (&querySet == &referenceSet)
+  {
+    queryKernels = referenceKernels;
+  }
+  else
+  {
+    queryKernels.set_size(querySet.n_cols);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      queryKernels[i] = sqrt(kernel.Evaluate(querySet.col(i),
+                                             querySet.col(i)));
+  }
+
+  // Set to invalid memory, so that the first node combination does not try to
+  // dereference null pointers.
+  traversalInfo.LastQueryNode() = (TreeType*) this;
+  traversalInfo.LastReferenceNode() = (TreeType*) this;
+
+  // Let's build the list of candidate points for each query point.
+  // It will be initialized with k candidates: (-DBL_MAX, size_t() - 1)
+  // The list of candidates will be updated when visiting new points with the
+  // BaseCase() method.
+  const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+
+  CandidateList pqueue;
+  pqueue.reserve(k);
+  for (size_t i = 0; i < k; ++i)
+    pqueue.push(def);
+  std::vector<CandidateList> tmp(querySet.n_cols, pqueue);
+  candidates.swap(tmp);
+}
+
 template<typename KernelType, typename TreeType>
 void FastMKSRules<KernelType, TreeType>::GetResults(
     arma::Mat<size_t>& indices,
@@ -87,8 +87,11 @@ Estimate(const arma::mat& observations,
         << "log-likelihood " << l << "." << std::endl;
 
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // component writes to its own column of condLogProb, so the components
+    // can be computed in parallel.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -97,8 +100,9 @@ Estimate(const arma::mat& observations,
       condLogProbAlias += log(weights[i]);
     }
 
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    // Normalize row-wise, in parallel over blocks of observations.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -109,14 +113,18 @@ Estimate(const arma::mat& observations,
 
     // Store the sum of the probability of each state over all the observations.
     arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       probRowSums(i) = mlpack::math::AccuLog(condLogProb.col(i));
     }
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // probabilities.  Each component's sufficient statistics depend only on
+    // its own column of condLogProb and update only its own distribution, so
+    // the M-step is parallelized over components as well.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Don't update if there's no probability of the Gaussian having points.
       if (probRowSums[i] != -std::numeric_limits<double>::infinity())
@@ -192,8 +200,11 @@ Estimate(const arma::mat& observations,
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // component writes to its own column of condLogProb, so the components
+    // can be computed in parallel.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -202,8 +213,9 @@ Estimate(const arma::mat& observations,
       condLogProbAlias += log(weights[i]);
     }
 
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    // Normalize row-wise, in parallel over blocks of observations.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -217,9 +229,12 @@ Estimate(const arma::mat& observations,
     arma::vec probRowSums(dists.size());
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
+    // probabilities.  As in the unprobabilistic version, each component's
+    // sufficient statistics are independent of the others', so the M-step is
+    // parallelized over components.
     arma::vec logProbabilities = arma::log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Calculate the sum of probabilities of points, which is the
       // conditional probability of each point being from Gaussian i
@@ -383,25 +398,34 @@ LogLikelihood(const arma::mat& observations,
 {
   double logLikelihood = 0;
 
-  arma::vec logPhis;
   arma::mat logLikelihoods(dists.size(), observations.n_cols);
 
-  // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
+  // It has to be LogProbability() otherwise Probability() would overflow
+  // easily; each component fills its own row, so this is done in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
   {
+    arma::vec logPhis;
     dists[i].LogProbability(observations, logPhis);
     logLikelihoods.row(i) = log(weights(i)) + trans(logPhis);
   }
+
+  // Accumulate the per-point log-likelihoods in parallel; the outlier
+  // warnings are issued afterwards, outside of the parallel region.
+  arma::vec pointLogLikelihoods(observations.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) observations.n_cols; ++j)
+    pointLogLikelihoods[j] = mlpack::math::AccuLog(logLikelihoods.col(j));
+
   // Now sum over every point.
   for (size_t j = 0; j < observations.n_cols; ++j)
   {
-    if (mlpack::math::AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
+    if (pointLogLikelihoods[j] == -std::numeric_limits<double>::infinity())
     {
       Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
           << "outlier." << std::endl;
     }
-    logLikelihood += mlpack::math::AccuLog(logLikelihoods.col(j));
+    logLikelihood += pointLogLikelihoods[j];
   }
 
   return logLikelihood;
@@ -168,6 +168,35 @@ class HMM
    */
   double Train(const std::vector<arma::mat>& dataSeq);
 
+  /**
+   * Incrementally train the model on a batch of unlabeled sequences, using a
+   * single online EM (stepwise Baum-Welch) update.  Unlike Train(), which
+   * iterates to convergence over one fixed dataset, this method performs one
+   * E-step over the given batch, folds the resulting expected counts into
+   * decayed sufficient statistics maintained across calls, and re-estimates
+   * the model from those statistics.  Memory use is bounded: only the decayed
+   * initial-state and transition counts and a fixed-capacity buffer of recent
+   * observations (with their state responsibilities) are kept between calls,
+   * so the model can track a data stream without retraining from scratch.
+   *
+   * The decay parameter controls how quickly old batches are forgotten: the
+   * accumulated statistics are multiplied by decay before each batch is
+   * absorbed, so decay = 1 weights all batches equally and smaller values
+   * favor recent data.  The size of the emission observation buffer can be
+   * adjusted with IncrementalBufferSize().
+   *
+   * The incremental statistics are reset if the number of states changes, and
+   * are not serialized; a freshly loaded model starts accumulating from its
+   * current parameters.
+   *
+   * @param dataSeq Batch of observation sequences.
+   * @param decay Forgetting factor in (0, 1] applied to the accumulated
+   *      statistics before the batch is absorbed.
+   * @return Log-likelihood of the batch under the model before the update.
+   */
+  double TrainIncremental(const std::vector<arma::mat>& dataSeq,
+                          const double decay = 1.0);
+
   /**
    * Train the model using the given labeled observations; the transition and
    * emission matrices are directly estimated.  Each matrix in the vector of
@@ -269,6 +298,61 @@ class HMM
                 arma::Row<size_t>& stateSequence,
                 const size_t startState = 0) const;
 
+  /**
+   * Generate numSequences random data sequences of the given length in one
+   * call.  Slice s of dataSequences holds the observations of sequence s (one
+   * column per time step), and column t of stateSequences holds the hidden
+   * states of every sequence at time step t.  The outputs are only resized if
+   * they do not already have the right shape, so a preallocated cube can be
+   * reused across calls.
+   *
+   * The hidden states are drawn with the alias-method sampler of
+   * DiscreteDistribution (one sampler per previous state, built once per
+   * call), and the emissions of each time step are drawn grouped by state, so
+   * the parameters of an emission distribution stay hot while all of its
+   * draws for the step are produced.
+   *
+   * @param length Length of each random sequence to generate.
+   * @param numSequences Number of random sequences to generate.
+   * @param dataSequences Cube to store the observations in (dimensionality x
+   *     length x numSequences).
+   * @param stateSequences Matrix to store the hidden states in (numSequences
+   *     x length).
+   * @param startState Hidden state to start each sequence in (default 0).
+   */
+  void Generate(const size_t length,
+                const size_t numSequences,
+                arma::cube& dataSequences,
+                arma::Mat<size_t>& stateSequences,
+                const size_t startState = 0) const;
+
+  /**
+   * Generate numSequences random data sequences of the given length in one
+   * call, and simultaneously compute the log-likelihood of each generated
+   * sequence.  The result is identical to scoring the generated sequences
+   * with LogLikelihood() afterwards, but the emission log-probabilities of a
+   * time step are evaluated for all sequences right after the step is
+   * generated, while the observations are still in cache, and the forward
+   * recursion is carried along for every sequence, so no second pass over the
+   * generated data is needed.
+   *
+   * @param length Length of each random sequence to generate.
+   * @param numSequences Number of random sequences to generate.
+   * @param dataSequences Cube to store the observations in (dimensionality x
+   *     length x numSequences).
+   * @param stateSequences Matrix to store the hidden states in (numSequences
+   *     x length).
+   * @param logLikelihoods Vector to store the log-likelihood of each
+   *     generated sequence in.
+   * @param startState Hidden state to start each sequence in (default 0).
+   */
+  void Generate(const size_t length,
+                const size_t numSequences,
+                arma::cube& dataSequences,
+                arma::Mat<size_t>& stateSequences,
+                arma::vec& logLikelihoods,
+                const size_t startState = 0) const;
+
   /**
    * Compute the most probable hidden state sequence for the given data
    * sequence, using the Viterbi algorithm, returning the log-likelihood of the
@@ -282,6 +366,70 @@ class HMM
   double Predict(const arma::mat& dataSeq,
                  arma::Row<size_t>& stateSeq) const;
 
+  /**
+   * Compute the most probable hidden state sequence for each of the given
+   * data sequences, using the Viterbi algorithm, in parallel across the
+   * sequences.  The log-likelihood of each most probable state sequence is
+   * stored in logLikelihoods.  When every sequence has the same length, the
+   * per-state emission log-probabilities of all sequences are computed in a
+   * single pass over a stacked cube of the observations.
+   *
+   * @param dataSeq Vector of sequences of observations.
+   * @param stateSeqs Vector in which the most probable state sequences will
+   *    be stored.
+   * @param logLikelihoods Vector in which the log-likelihood of each most
+   *    probable state sequence will be stored.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeq,
+               std::vector<arma::Row<size_t>>& stateSeqs,
+               arma::vec& logLikelihoods) const;
+
+  /**
+   * Compute the most probable hidden state sequence for the given data
+   * sequence with a checkpointed Viterbi algorithm, returning the
+   * log-likelihood of the most likely state sequence.
+   *
+   * This produces exactly the same result as Predict(), but instead of
+   * materializing the full states x T backpointer and score matrices, it
+   * stores only the Viterbi scores at roughly every sqrt(T)-th time step and
+   * recomputes each segment during the backtrace.  Memory use drops from
+   * O(states * T) to O(states * sqrt(T)) at the cost of roughly one extra
+   * forward pass, which makes exact decoding feasible for very long
+   * sequences.
+   *
+   * @param dataSeq Sequence of observations.
+   * @param stateSeq Vector in which the most probable state sequence will be
+   *    stored.
+   * @return Log-likelihood of most probable state sequence.
+   */
+  double PredictCheckpointed(const arma::mat& dataSeq,
+                             arma::Row<size_t>& stateSeq) const;
+
+  /**
+   * Compute an approximate most probable hidden state sequence for the given
+   * data sequence with beam-pruned Viterbi, returning the log-likelihood of
+   * the best state sequence found.
+   *
+   * At each time step, only the states whose Viterbi score is within
+   * beamWidth (in log-probability units) of the step's best score are
+   * extended, and only the transitions with nonzero probability out of the
+   * surviving states are evaluated, so the per-step cost scales with the
+   * number of surviving states times their average out-degree rather than
+   * with the square of the number of states.  The result is exact whenever
+   * the true best path never falls out of the beam; a narrow beam trades
+   * accuracy for speed.
+   *
+   * @param dataSeq Sequence of observations.
+   * @param stateSeq Vector in which the most probable state sequence will be
+   *    stored.
+   * @param beamWidth Log-probability margin kept around the per-step best
+   *    score (must be non-negative).
+   * @return Log-likelihood of the best state sequence found.
+   */
+  double PredictBeam(const arma::mat& dataSeq,
+                     arma::Row<size_t>& stateSeq,
+                     const double beamWidth) const;
+
   /**
    * Compute the log-likelihood of the given data sequence.
    *
@@ -290,6 +438,21 @@ class HMM
    */
   double LogLikelihood(const arma::mat& dataSeq) const;
 
+  /**
+   * Compute the log-likelihood of each of the given data sequences, in
+   * parallel across the sequences.  Each thread reuses its forward-pass
+   * workspace between the sequences it scores instead of allocating fresh
+   * matrices per sequence, and when every sequence has the same length the
+   * per-state emission log-probabilities of all sequences are computed in a
+   * single pass over a stacked cube of the observations.
+   *
+   * @param dataSeq Vector of data sequences to evaluate the likelihood of.
+   * @param logLikelihoods Vector in which the log-likelihood of each sequence
+   *    will be stored.
+   */
+  void LogLikelihood(const std::vector<arma::mat>& dataSeq,
+                     arma::vec& logLikelihoods) const;
+
   /**
    * Compute the log of the scaling factor of the given emission probability
    * at time t. To calculate the log-likelihood for the whole sequence,
@@ -426,6 +589,12 @@ class HMM
   //! Modify the tolerance of the Baum-Welch algorithm.
   double& Tolerance() { return tolerance; }
 
+  //! Get the capacity (in observations) of the emission buffer used by
+  //! TrainIncremental().
+  size_t IncrementalBufferSize() const { return incrementalBufferSize; }
+  //! Modify the capacity of the emission buffer used by TrainIncremental().
+  size_t& IncrementalBufferSize() { return incrementalBufferSize; }
+
   /**
    * Load the object.
    */
@@ -493,6 +662,49 @@ class HMM
                 arma::mat& backwardLogProb,
                 arma::mat& logProbs) const;
 
+  /**
+   * Run the Viterbi algorithm over precomputed per-state emission
+   * log-probabilities (one row per time step, one column per state), storing
+   * the most probable state sequence and returning its log-likelihood.  The
+   * log-space transition and initial probabilities must already be up to
+   * date (see ConvertToLogSpace()).
+   *
+   * @param logProbs Emission log-probabilities of every time step.
+   * @param stateSeq Vector in which the most probable state sequence will be
+   *    stored.
+   * @return Log-likelihood of most probable state sequence.
+   */
+  double ViterbiPath(const arma::mat& logProbs,
+                     arma::Row<size_t>& stateSeq) const;
+
+  /**
+   * Run beam-pruned Viterbi over precomputed emission log-probabilities (see
+   * PredictBeam()).  The log-space and sparse transition representations
+   * must already be up to date (see ConvertToLogSpace()).
+   *
+   * @param logProbs Emission log-probabilities of every time step.
+   * @param stateSeq Vector in which the best state sequence found will be
+   *    stored.
+   * @param beamWidth Log-probability margin kept around the per-step best.
+   * @return Log-likelihood of the best state sequence found.
+   */
+  double ViterbiPathBeam(const arma::mat& logProbs,
+                         arma::Row<size_t>& stateSeq,
+                         const double beamWidth) const;
+
+  /**
+   * Compute the per-state emission log-probabilities of a batch of
+   * same-length sequences in a single pass, by stacking the observations
+   * into a cube.  Row t + n * length of the output holds time step t of
+   * sequence n.
+   *
+   * @param dataSeq Vector of same-length sequences of observations.
+   * @param allLogProbs Matrix in which the emission log-probabilities will be
+   *    stored.
+   */
+  void StackedEmissionLogProbs(const std::vector<arma::mat>& dataSeq,
+                               arma::mat& allLogProbs) const;
+
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
 
@@ -539,6 +751,27 @@ class HMM
    * Should be removed in mlpack 4.0.
    */
   mutable bool recalculateTransition;
+
+  //! The nonzero transitions of transitionProxy in compressed sparse column
+  //! form, kept in sync by ConvertToLogSpace(); used by beam-pruned Viterbi
+  //! to touch only the possible successors of the surviving states.
+  mutable arma::sp_mat sparseTransition;
+  //! Log-probabilities of the nonzero transitions, in the same order as the
+  //! value array of sparseTransition.
+  mutable arma::vec sparseLogTransition;
+
+  //! Decayed expected initial-state counts maintained by TrainIncremental().
+  arma::vec incrementalInitial;
+  //! Decayed expected transition counts maintained by TrainIncremental().
+  arma::mat incrementalTransition;
+  //! Bounded buffer of recent observations used to re-estimate the emission
+  //! distributions in TrainIncremental().
+  arma::mat emissionBuffer;
+  //! Decayed state responsibilities for the buffered observations; one vector
+  //! per state.
+  std::vector<arma::vec> emissionBufferProb;
+  //! Capacity (in observations) of the emission buffer.
+  size_t incrementalBufferSize;
 };
 
 } // namespace hmm
@@ -35,7 +35,8 @@ HMM<Distribution>::HMM(const size_t states,
     dimensionality(emissions.Dimensionality()),
     tolerance(tolerance),
     recalculateInitial(false),
-    recalculateTransition(false)
+    recalculateTransition(false),
+    incrementalBufferSize(50000)
 {
   // Normalize the transition probabilities and initial state probabilities.
   initialProxy /= arma::accu(initialProxy);
@@ -62,7 +63,8 @@ HMM<Distribution>::HMM(const arma::vec& initial,
     logInitial(log(initial)),
     tolerance(tolerance),
     recalculateInitial(false),
-    recalculateTransition(false)
+    recalculateTransition(false),
+    incrementalBufferSize(50000)
 {
   // Set the dimensionality, if we can.
   if (emission.size() > 0)
@@ -101,10 +103,14 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   // Maximum iterations?
   size_t iterations = 1000;
 
-  // Find length of all sequences and ensure they are the correct size.
+  // Find length of all sequences and ensure they are the correct size; also
+  // compute where each sequence's observations will start in the emission
+  // list, so that the sequences can be processed in any order.
   size_t totalLength = 0;
+  std::vector<size_t> seqOffsets(dataSeq.size());
   for (size_t seq = 0; seq < dataSeq.size(); seq++)
   {
+    seqOffsets[seq] = totalLength;
     totalLength += dataSeq[seq].n_cols;
 
     if (dataSeq[seq].n_rows != dimensionality)
@@ -133,70 +139,95 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
-
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // The sequences are independent given the current model, so the
+    // forward-backward pass over each sequence is computed in parallel, with
+    // the initial-state and transition statistics accumulated per thread and
+    // merged afterwards.  The emission list and emission probabilities are
+    // written directly: each sequence owns a disjoint range of columns,
+    // starting at its precomputed offset.
+    #pragma omp parallel
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
-          newLogInitial);
-
-      // Define a variable to store the value of log-probability for data.
-      arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
-      // Save the values of log-probability to logProbs.
-      for (size_t i = 0; i < logTransition.n_rows; i++)
+      arma::vec localLogInitial(logTransition.n_rows);
+      localLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat localLogTransition(logTransition.n_rows, logTransition.n_cols);
+      localLogTransition.fill(-std::numeric_limits<double>::infinity());
+      double localLoglik = 0.0;
+
+      // Loop over each sequence.
+      #pragma omp for
+      for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); seq++)
       {
-        // Define alias of desired column.
-        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-        // Use advanced constructor for using logProbs directly.
-        emission[i].LogProbability(dataSeq[seq], alias);
-      }
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
-      {
-        // Assemble temporary vector that's used in log-sum computation.
-        if (t < dataSeq[seq].n_cols - 1)
+        arma::mat stateLogProb;
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+
+        // Add the log-likelihood of this sequence.  This is the E-step.
+        localLoglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+            backwardLog, logScales);
+
+        // Add to estimate of initial probability for state j.
+        math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
+            localLogInitial);
+
+        // Define a variable to store the value of log-probability for data.
+        arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
+        // Save the values of log-probability to logProbs.
+        for (size_t i = 0; i < logTransition.n_rows; i++)
         {
-          // This term is the same across all states, so compute it once and
-          // cache it.
-          const arma::vec tmp = backwardLog.col(t + 1) +
-              logProbs.row(t + 1).t() - logScales[t + 1];
-          arma::vec output;
-          math::LogSumExp(tmp, output);
+          // Define alias of desired column.
+          arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+          // Use advanced constructor for using logProbs directly.
+          emission[i].LogProbability(dataSeq[seq], alias);
+        }
 
-          for (size_t j = 0; j < logTransition.n_cols; ++j)
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+        {
+          // Assemble temporary vector that's used in log-sum computation.
+          if (t < dataSeq[seq].n_cols - 1)
           {
-            // Compute the estimate of T_ij (probability of transition from
-            // state j to state i).  We postpone multiplication of the old T_ij
-            // until later.
-            arma::vec tmp2 = output + forwardLog(j, t);
-            arma::vec alias = newLogTransition.unsafe_col(j);
-            math::LogSumExp<arma::vec, true>(tmp2, alias);
+            // This term is the same across all states, so compute it once and
+            // cache it.
+            const arma::vec tmp = backwardLog.col(t + 1) +
+                logProbs.row(t + 1).t() - logScales[t + 1];
+            arma::vec output;
+            math::LogSumExp(tmp, output);
+
+            for (size_t j = 0; j < logTransition.n_cols; ++j)
+            {
+              // Compute the estimate of T_ij (probability of transition from
+              // state j to state i).  We postpone multiplication of the old
+              // T_ij until later.
+              arma::vec tmp2 = output + forwardLog(j, t);
+              arma::vec alias = localLogTransition.unsafe_col(j);
+              math::LogSumExp<arma::vec, true>(tmp2, alias);
+            }
           }
+
+          // Add to list of emission observations, for Distribution::Train().
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
+            emissionProb[j][seqOffsets[seq] + t] = exp(stateLogProb(j, t));
+          emissionList.col(seqOffsets[seq] + t) = dataSeq[seq].col(t);
         }
+      }
 
-        // Add to list of emission observations, for Distribution::Train().
+      // Merge the per-thread accumulators; the initial-state and transition
+      // statistics are in log-space, so they are combined with log-addition.
+      #pragma omp critical
+      {
+        loglik += localLoglik;
+        math::LogSumExp<arma::vec, true>(localLogInitial, newLogInitial);
         for (size_t j = 0; j < logTransition.n_cols; ++j)
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
-        emissionList.col(sumTime) = dataSeq[seq].col(t);
-        sumTime++;
+          for (size_t i = 0; i < logTransition.n_rows; ++i)
+            newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
+                localLogTransition(i, j));
       }
     }
 
@@ -242,6 +273,156 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   return loglik;
 }
 
+/**
+ * Incrementally train the model on a batch of unlabeled sequences with a
+ * single stepwise Baum-Welch (online EM) update, maintaining decayed
+ * sufficient statistics across calls.
+ */
+template<typename Distribution>
+double HMM<Distribution>::TrainIncremental(
+    const std::vector<arma::mat>& dataSeq,
+    const double decay)
+{
+  // Make sure the logarithmic parameters are up to date before the E-step.
+  ConvertToLogSpace();
+
+  // Validate the batch and find its total length.
+  size_t batchLength = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    batchLength += dataSeq[seq].n_cols;
+
+    if (dataSeq[seq].n_rows != dimensionality)
+      Log::Fatal << "HMM::TrainIncremental(): data sequence " << seq
+          << " has dimensionality " << dataSeq[seq].n_rows << " (expected "
+          << dimensionality << " dimensions)." << std::endl;
+  }
+
+  if (batchLength == 0)
+    return 0.0;
+
+  // (Re)initialize the accumulated statistics if this is the first batch or
+  // if the number of states has changed.
+  if (incrementalTransition.n_rows != logTransition.n_rows ||
+      incrementalTransition.n_cols != logTransition.n_cols)
+  {
+    incrementalInitial.zeros(logTransition.n_rows);
+    incrementalTransition.zeros(logTransition.n_rows, logTransition.n_cols);
+    emissionBuffer.set_size(dimensionality, 0);
+    emissionBufferProb.assign(logTransition.n_rows, arma::vec());
+  }
+
+  // Apply the forgetting factor to everything accumulated so far.
+  incrementalInitial *= decay;
+  incrementalTransition *= decay;
+  for (size_t state = 0; state < emissionBufferProb.size(); ++state)
+    emissionBufferProb[state] *= decay;
+
+  // E-step: one forward-backward pass over each sequence of the batch.  As in
+  // Train(), the multiplication by the old T_ij is postponed, so
+  // newLogTransition accumulates the log-sums of the forward-backward terms
+  // only.
+  double loglik = 0;
+  arma::mat newLogTransition(logTransition.n_rows, logTransition.n_cols);
+  newLogTransition.fill(-std::numeric_limits<double>::infinity());
+
+  // State responsibilities and observations of this batch, used to extend the
+  // emission buffer below.
+  arma::mat batchProb(logTransition.n_rows, batchLength);
+  arma::mat batchObs(dimensionality, batchLength);
+  size_t sumTime = 0;
+
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    arma::mat stateLogProb;
+    arma::mat forwardLog;
+    arma::mat backwardLog;
+    arma::vec logScales;
+
+    loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog, backwardLog,
+        logScales);
+
+    // Accumulate the expected initial-state counts in linear space.
+    incrementalInitial += arma::exp(stateLogProb.col(0));
+
+    // Define a variable to store the value of log-probability for data.
+    arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
+    for (size_t i = 0; i < logTransition.n_rows; i++)
+    {
+      arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+      emission[i].LogProbability(dataSeq[seq], alias);
+    }
+
+    for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+    {
+      if (t < dataSeq[seq].n_cols - 1)
+      {
+        const arma::vec tmp = backwardLog.col(t + 1) +
+            logProbs.row(t + 1).t() - logScales[t + 1];
+        arma::vec output;
+        math::LogSumExp(tmp, output);
+
+        for (size_t j = 0; j < logTransition.n_cols; ++j)
+        {
+          arma::vec tmp2 = output + forwardLog(j, t);
+          arma::vec alias = newLogTransition.unsafe_col(j);
+          math::LogSumExp<arma::vec, true>(tmp2, alias);
+        }
+      }
+
+      batchProb.col(sumTime) = arma::exp(stateLogProb.col(t));
+      batchObs.col(sumTime) = dataSeq[seq].col(t);
+      sumTime++;
+    }
+  }
+
+  // The postponed multiplication by the old T_ij turns the accumulated
+  // log-sums into expected transition counts for the batch.
+  incrementalTransition += arma::exp(logTransition + newLogTransition);
+
+  // M-step: re-estimate the parameters from the decayed statistics.  Any
+  // state with no accumulated evidence keeps its current parameters.
+  const double initialSum = arma::accu(incrementalInitial);
+  if (initialSum > 0)
+    logInitial = arma::log(incrementalInitial / initialSum);
+
+  for (size_t j = 0; j < logTransition.n_cols; ++j)
+  {
+    const double colSum = arma::accu(incrementalTransition.col(j));
+    if (colSum > 0)
+      logTransition.col(j) = arma::log(incrementalTransition.col(j) / colSum);
+  }
+
+  initialProxy = arma::exp(logInitial);
+  transitionProxy = arma::exp(logTransition);
+  recalculateInitial = false;
+  recalculateTransition = false;
+
+  // Append the batch to the bounded emission buffer, dropping the oldest
+  // observations if the buffer overflows.
+  emissionBuffer = arma::join_rows(emissionBuffer, batchObs);
+  for (size_t state = 0; state < emissionBufferProb.size(); ++state)
+  {
+    emissionBufferProb[state] = arma::join_cols(emissionBufferProb[state],
+        arma::vec(batchProb.row(state).t()));
+  }
+
+  if (emissionBuffer.n_cols > incrementalBufferSize)
+  {
+    const size_t excess = emissionBuffer.n_cols - incrementalBufferSize;
+    emissionBuffer.shed_cols(0, excess - 1);
+    for (size_t state = 0; state < emissionBufferProb.size(); ++state)
+      emissionBufferProb[state].shed_rows(0, excess - 1);
+  }
+
+  // Re-estimate the emission distributions from the buffered observations and
+  // their decayed responsibilities.
+  for (size_t state = 0; state < emissionBufferProb.size(); ++state)
+    emission[state].Train(emissionBuffer, emissionBufferProb[state]);
+
+  return loglik;
+}
+
 /**
  * Train the model using the given labeled observations; the transition and
  * emission matrices are directly estimated.
@@ -477,6 +658,182 @@ void HMM<Distribution>::Generate(const size_t length,
   }
 }
 
+/**
+ * Generate numSequences random data sequences of the given length in one
+ * call, drawing the hidden states with alias-method samplers and the
+ * emissions of each time step grouped by state.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Generate(const size_t length,
+                                 const size_t numSequences,
+                                 arma::cube& dataSequences,
+                                 arma::Mat<size_t>& stateSequences,
+                                 const size_t startState) const
+{
+  // Only reallocate the outputs if they do not already have the right shape.
+  if (dataSequences.n_rows != dimensionality ||
+      dataSequences.n_cols != length ||
+      dataSequences.n_slices != numSequences)
+    dataSequences.set_size(dimensionality, length, numSequences);
+  if (stateSequences.n_rows != numSequences ||
+      stateSequences.n_cols != length)
+    stateSequences.set_size(numSequences, length);
+
+  if (length == 0 || numSequences == 0)
+    return;
+
+  const size_t states = transitionProxy.n_rows;
+
+  // One alias-method sampler per previous state, built once from the columns
+  // of the transition matrix; every subsequent state draw is O(1).
+  std::vector<distribution::DiscreteDistribution> transitionSamplers;
+  transitionSamplers.reserve(states);
+  for (size_t j = 0; j < states; ++j)
+  {
+    transitionSamplers.emplace_back(std::vector<arma::vec>{
+        arma::vec(transitionProxy.col(j)) });
+  }
+
+  // Every sequence starts in the given state, so the first time step is a
+  // single state group.
+  for (size_t s = 0; s < numSequences; ++s)
+  {
+    stateSequences(s, 0) = startState;
+    dataSequences.slice(s).col(0) = emission[startState].Random();
+  }
+
+  std::vector<std::vector<size_t>> stateGroups(states);
+  for (size_t t = 1; t < length; ++t)
+  {
+    // First choose the hidden state of every sequence.
+    for (size_t s = 0; s < numSequences; ++s)
+    {
+      const size_t state = (size_t)
+          transitionSamplers[stateSequences(s, t - 1)].Random()[0];
+      stateSequences(s, t) = state;
+      stateGroups[state].push_back(s);
+    }
+
+    // Now choose the emissions, one state group at a time.
+    for (size_t state = 0; state < states; ++state)
+    {
+      for (const size_t s : stateGroups[state])
+        dataSequences.slice(s).col(t) = emission[state].Random();
+      stateGroups[state].clear();
+    }
+  }
+}
+
+/**
+ * Generate numSequences random data sequences of the given length in one
+ * call, and simultaneously compute the log-likelihood of each generated
+ * sequence by carrying the forward recursion along with the generation.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Generate(const size_t length,
+                                 const size_t numSequences,
+                                 arma::cube& dataSequences,
+                                 arma::Mat<size_t>& stateSequences,
+                                 arma::vec& logLikelihoods,
+                                 const size_t startState) const
+{
+  // Only reallocate the outputs if they do not already have the right shape.
+  if (dataSequences.n_rows != dimensionality ||
+      dataSequences.n_cols != length ||
+      dataSequences.n_slices != numSequences)
+    dataSequences.set_size(dimensionality, length, numSequences);
+  if (stateSequences.n_rows != numSequences ||
+      stateSequences.n_cols != length)
+    stateSequences.set_size(numSequences, length);
+  logLikelihoods.zeros(numSequences);
+
+  if (length == 0 || numSequences == 0)
+    return;
+
+  ConvertToLogSpace();
+
+  const size_t states = transitionProxy.n_rows;
+
+  // One alias-method sampler per previous state, built once from the columns
+  // of the transition matrix; every subsequent state draw is O(1).
+  std::vector<distribution::DiscreteDistribution> transitionSamplers;
+  transitionSamplers.reserve(states);
+  for (size_t j = 0; j < states; ++j)
+  {
+    transitionSamplers.emplace_back(std::vector<arma::vec>{
+        arma::vec(transitionProxy.col(j)) });
+  }
+
+  // Workspace for the fused scoring: the observations of the current time
+  // step across all sequences, their per-state emission log-probabilities,
+  // and the forward probabilities of every sequence.
+  arma::mat stepObservations(dimensionality, numSequences);
+  arma::mat emissionLogProbs(numSequences, states);
+  arma::mat forwardLogProb(states, numSequences);
+
+  std::vector<std::vector<size_t>> stateGroups(states);
+  for (size_t t = 0; t < length; ++t)
+  {
+    if (t == 0)
+    {
+      // Every sequence starts in the given state, so the first time step is
+      // a single state group.
+      for (size_t s = 0; s < numSequences; ++s)
+      {
+        stateSequences(s, 0) = startState;
+        dataSequences.slice(s).col(0) = emission[startState].Random();
+      }
+    }
+    else
+    {
+      // First choose the hidden state of every sequence.
+      for (size_t s = 0; s < numSequences; ++s)
+      {
+        const size_t state = (size_t)
+            transitionSamplers[stateSequences(s, t - 1)].Random()[0];
+        stateSequences(s, t) = state;
+        stateGroups[state].push_back(s);
+      }
+
+      // Now choose the emissions, one state group at a time.
+      for (size_t state = 0; state < states; ++state)
+      {
+        for (const size_t s : stateGroups[state])
+          dataSequences.slice(s).col(t) = emission[state].Random();
+        stateGroups[state].clear();
+      }
+    }
+
+    // Score the step while the observations are still in cache: evaluate the
+    // emission log-probabilities of all sequences in one batch per state, and
+    // advance the forward recursion of every sequence.
+    for (size_t s = 0; s < numSequences; ++s)
+      stepObservations.col(s) = dataSequences.slice(s).col(t);
+
+    for (size_t i = 0; i < states; ++i)
+    {
+      arma::vec alias(emissionLogProbs.colptr(i), numSequences, false, true);
+      emission[i].LogProbability(stepObservations, alias);
+    }
+
+    for (size_t s = 0; s < numSequences; ++s)
+    {
+      double logScale;
+      if (t == 0)
+      {
+        forwardLogProb.col(s) = ForwardAtT0(emissionLogProbs.row(s).t(),
+            logScale);
+      }
+      else
+      {
+        forwardLogProb.col(s) = ForwardAtTn(emissionLogProbs.row(s).t(),
+            logScale, forwardLogProb.col(s));
+      }
+      logLikelihoods[s] += logScale;
+    }
+  }
+}
+
 /**
  * Compute the most probable hidden state sequence for the given observation
  * using the Viterbi algorithm. Returns the log-likelihood of the most likely
@@ -485,66 +842,419 @@ void HMM<Distribution>::Generate(const size_t length,
 template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
                                   arma::Row<size_t>& stateSeq) const
+{
+  ConvertToLogSpace();
+
+  // Define a variable to store the value of log-probability for dataSeq.
+  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+
+  // Save the values of log-probability to logProbs.
+  for (size_t i = 0; i < logTransition.n_rows; i++)
+  {
+    // Define alias of desired column.
+    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+    // Use advanced constructor for using logProbs directly.
+    emission[i].LogProbability(dataSeq, alias);
+  }
+
+  return ViterbiPath(logProbs, stateSeq);
+}
+
+/**
+ * Compute an approximate most probable hidden state sequence with
+ * beam-pruned Viterbi.  Returns the log-likelihood of the best sequence
+ * found.
+ */
+template<typename Distribution>
+double HMM<Distribution>::PredictBeam(const arma::mat& dataSeq,
+                                      arma::Row<size_t>& stateSeq,
+                                      const double beamWidth) const
+{
+  if (beamWidth < 0.0)
+  {
+    throw std::invalid_argument("HMM::PredictBeam(): beam width must be "
+        "non-negative!");
+  }
+
+  ConvertToLogSpace();
+
+  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+  for (size_t i = 0; i < logTransition.n_rows; i++)
+  {
+    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+    emission[i].LogProbability(dataSeq, alias);
+  }
+
+  return ViterbiPathBeam(logProbs, stateSeq, beamWidth);
+}
+
+/**
+ * Compute the most probable hidden state sequence for each of the given data
+ * sequences, in parallel across the sequences.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeq,
+                                std::vector<arma::Row<size_t>>& stateSeqs,
+                                arma::vec& logLikelihoods) const
+{
+  stateSeqs.resize(dataSeq.size());
+  logLikelihoods.set_size(dataSeq.size());
+  if (dataSeq.empty())
+    return;
+
+  // Bring the log-space parameters up to date once, before the parallel
+  // region; afterwards they are only read.
+  ConvertToLogSpace();
+
+  const size_t states = logTransition.n_rows;
+
+  // If every sequence has the same length, the emission log-probabilities of
+  // all sequences can be computed in one pass.
+  bool sameLength = true;
+  const size_t length = dataSeq[0].n_cols;
+  for (size_t n = 1; n < dataSeq.size(); ++n)
+  {
+    if (dataSeq[n].n_cols != length)
+    {
+      sameLength = false;
+      break;
+    }
+  }
+
+  if (sameLength && length > 0)
+  {
+    arma::mat allLogProbs;
+    StackedEmissionLogProbs(dataSeq, allLogProbs);
+
+    #pragma omp parallel for default(shared)
+    for (omp_size_t n = 0; n < (omp_size_t) dataSeq.size(); ++n)
+    {
+      const arma::mat seqLogProbs = allLogProbs.rows(n * length,
+          (n + 1) * length - 1);
+      logLikelihoods[n] = ViterbiPath(seqLogProbs, stateSeqs[n]);
+    }
+  }
+  else
+  {
+    #pragma omp parallel default(shared)
+    {
+      // Per-thread emission workspace, reused across sequences.
+      arma::mat logProbs;
+
+      #pragma omp for
+      for (omp_size_t n = 0; n < (omp_size_t) dataSeq.size(); ++n)
+      {
+        logProbs.set_size(dataSeq[n].n_cols, states);
+        for (size_t i = 0; i < states; ++i)
+        {
+          arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+          emission[i].LogProbability(dataSeq[n], alias);
+        }
+
+        logLikelihoods[n] = ViterbiPath(logProbs, stateSeqs[n]);
+      }
+    }
+  }
+}
+
+/**
+ * Run the Viterbi algorithm over precomputed emission log-probabilities.
+ */
+template<typename Distribution>
+double HMM<Distribution>::ViterbiPath(const arma::mat& logProbs,
+                                      arma::Row<size_t>& stateSeq) const
 {
   // This is an implementation of the Viterbi algorithm for finding the most
   // probable sequence of states to produce the observed data sequence.  We
   // don't use log-likelihoods to save that little bit of time, but we'll
   // calculate the log-likelihood at the end of it all.
-  stateSeq.set_size(dataSeq.n_cols);
-  arma::mat logStateProb(logTransition.n_rows, dataSeq.n_cols);
-  arma::mat stateSeqBack(logTransition.n_rows, dataSeq.n_cols);
-
-  ConvertToLogSpace();
+  const size_t length = logProbs.n_rows;
+  stateSeq.set_size(length);
+  arma::mat logStateProb(logTransition.n_rows, length);
+  arma::mat stateSeqBack(logTransition.n_rows, length);
 
   // The calculation of the first state is slightly different; the probability
   // of the first state being state j is the maximum probability that the state
   // came to be j from another state.
-  logStateProb.col(0).zeros();
+  logStateProb.col(0) = logInitial + logProbs.row(0).t();
   for (size_t state = 0; state < logTransition.n_rows; state++)
-  {
-    logStateProb(state, 0) = logInitial[state] +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
     stateSeqBack(state, 0) = state;
-  }
 
   // Store the best first state.
   arma::uword index;
 
-  // Define a variable to store the value of log-probability for dataSeq.
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+  for (size_t t = 1; t < length; t++)
+  {
+    // Assemble the state probability for this element.
+    // Given that we are in state j, we use the state with the highest
+    // probability of being the previous state.  This is a max-plus product of
+    // the transition matrix with the previous scores, computed for all states
+    // at once: scores(j, i) = logStateProb(i, t - 1) + logTransition(j, i).
+    arma::mat scores = logTransition;
+    scores.each_row() += logStateProb.col(t - 1).t();
+
+    const arma::uvec best = arma::index_max(scores, 1);
+    logStateProb.col(t) = arma::max(scores, 1) + logProbs.row(t).t();
+    stateSeqBack.col(t) = arma::conv_to<arma::vec>::from(best);
+  }
 
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
+  // Backtrack to find the most probable state sequence.
+  logStateProb.unsafe_col(length - 1).max(index);
+  stateSeq[length - 1] = index;
+  for (size_t t = 2; t <= length; t++)
   {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
+    stateSeq[length - t] =
+        stateSeqBack(stateSeq[length - t + 1], length - t + 1);
   }
 
-  for (size_t t = 1; t < dataSeq.n_cols; t++)
+  return logStateProb(stateSeq(length - 1), length - 1);
+}
+
+/**
+ * Run beam-pruned Viterbi over precomputed emission log-probabilities.
+ */
+template<typename Distribution>
+double HMM<Distribution>::ViterbiPathBeam(const arma::mat& logProbs,
+                                          arma::Row<size_t>& stateSeq,
+                                          const double beamWidth) const
+{
+  const size_t length = logProbs.n_rows;
+  const size_t states = logTransition.n_rows;
+  stateSeq.set_size(length);
+  if (length == 0)
+    return 0.0;
+
+  arma::mat logStateProb(states, length);
+  arma::mat stateSeqBack(states, length);
+
+  logStateProb.col(0) = logInitial + logProbs.row(0).t();
+  for (size_t state = 0; state < states; state++)
+    stateSeqBack(state, 0) = state;
+
+  // The states whose paths are extended at the next step: those within
+  // beamWidth of the step's best score.
+  std::vector<arma::uword> active;
+  arma::uword index;
+  double best = logStateProb.unsafe_col(0).max(index);
+  for (size_t state = 0; state < states; state++)
   {
-    // Assemble the state probability for this element.
-    // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < logTransition.n_rows; j++)
+    if (logStateProb(state, 0) >= best - beamWidth)
+      active.push_back(state);
+  }
+  if (!std::isfinite(best))
+    active.assign(1, index); // Every path has probability zero already.
+
+  for (size_t t = 1; t < length; t++)
+  {
+    logStateProb.col(t).fill(-std::numeric_limits<double>::infinity());
+
+    // Extend only the surviving states, and only along their transitions
+    // with nonzero probability; the sparse structure gives the possible
+    // successors of state i as the nonzero rows of column i.
+    for (size_t a = 0; a < active.size(); ++a)
+    {
+      const arma::uword i = active[a];
+      const double prev = logStateProb(i, t - 1);
+      for (arma::uword k = sparseTransition.col_ptrs[i];
+           k < sparseTransition.col_ptrs[i + 1]; ++k)
+      {
+        const arma::uword j = sparseTransition.row_indices[k];
+        const double candidate = prev + sparseLogTransition[k];
+        if (candidate > logStateProb(j, t))
+        {
+          logStateProb(j, t) = candidate;
+          stateSeqBack(j, t) = i;
+        }
+      }
+    }
+
+    // Add the emission scores of the reached states and collect the next
+    // beam.
+    for (size_t j = 0; j < states; ++j)
+    {
+      if (logStateProb(j, t) >
+          -std::numeric_limits<double>::infinity())
+        logStateProb(j, t) += logProbs(t, j);
+    }
+
+    best = logStateProb.unsafe_col(t).max(index);
+    active.clear();
+    if (!std::isfinite(best))
+    {
+      // No surviving state can be reached; the best path found so far has
+      // probability zero, like exact Viterbi would report.
+      active.push_back(index);
+      stateSeqBack.col(t).fill((double) index);
+      continue;
+    }
+    for (size_t j = 0; j < states; ++j)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) + logProbs(t, j);
-      stateSeqBack(j, t) = index;
+      if (logStateProb(j, t) >= best - beamWidth)
+        active.push_back(j);
     }
   }
 
-  // Backtrack to find the most probable state sequence.
-  logStateProb.unsafe_col(dataSeq.n_cols - 1).max(index);
-  stateSeq[dataSeq.n_cols - 1] = index;
-  for (size_t t = 2; t <= dataSeq.n_cols; t++)
+  // Backtrack to find the best state sequence found within the beam.
+  logStateProb.unsafe_col(length - 1).max(index);
+  stateSeq[length - 1] = index;
+  for (size_t t = 2; t <= length; t++)
+  {
+    stateSeq[length - t] =
+        stateSeqBack(stateSeq[length - t + 1], length - t + 1);
+  }
+
+  return logStateProb(stateSeq(length - 1), length - 1);
+}
+
+/**
+ * Compute the per-state emission log-probabilities of a batch of same-length
+ * sequences in a single pass.
+ */
+template<typename Distribution>
+void HMM<Distribution>::StackedEmissionLogProbs(
+    const std::vector<arma::mat>& dataSeq,
+    arma::mat& allLogProbs) const
+{
+  const size_t length = dataSeq[0].n_cols;
+  const size_t numSeqs = dataSeq.size();
+
+  // The slices of a cube are contiguous, so the stacked observations can be
+  // viewed as one wide matrix, and each state's emission log-probabilities
+  // computed for every time step of every sequence with a single call.
+  arma::cube stacked(dataSeq[0].n_rows, length, numSeqs);
+  for (size_t n = 0; n < numSeqs; ++n)
+    stacked.slice(n) = dataSeq[n];
+
+  const arma::mat allData(stacked.memptr(), dataSeq[0].n_rows,
+      length * numSeqs, false, true);
+
+  allLogProbs.set_size(length * numSeqs, logTransition.n_rows);
+  #pragma omp parallel for default(shared)
+  for (omp_size_t i = 0; i < (omp_size_t) logTransition.n_rows; ++i)
+  {
+    arma::vec alias(allLogProbs.colptr(i), allLogProbs.n_rows, false, true);
+    emission[i].LogProbability(allData, alias);
+  }
+}
+
+/**
+ * Compute the most probable hidden state sequence for the given observation
+ * using a checkpointed Viterbi algorithm, which stores only O(states *
+ * sqrt(T)) state instead of the full backpointer matrix.  Returns the
+ * log-likelihood of the most likely sequence.
+ */
+template<typename Distribution>
+double HMM<Distribution>::PredictCheckpointed(const arma::mat& dataSeq,
+                                              arma::Row<size_t>& stateSeq)
+    const
+{
+  ConvertToLogSpace();
+
+  const size_t length = dataSeq.n_cols;
+  const size_t states = logTransition.n_rows;
+  stateSeq.set_size(length);
+  if (length == 0)
+    return 0.0;
+
+  // The sequence is split into blocks of roughly sqrt(T) steps.  The forward
+  // pass keeps only the current column of Viterbi scores, saving a checkpoint
+  // of the scores at the last time step before each block; the backtrace then
+  // recomputes one block at a time from its checkpoint, so each time step is
+  // processed at most twice but only one block of backpointers ever exists.
+  const size_t blockSize = std::max((size_t) 1,
+      (size_t) std::ceil(std::sqrt((double) length)));
+  const size_t numBlocks = (length + blockSize - 1) / blockSize;
+
+  // checkpoints.col(0) holds the scores at time 0; checkpoints.col(b) for
+  // b > 0 holds the scores at time b * blockSize - 1.
+  arma::mat checkpoints(states, numBlocks);
+
+  // Calculate the first-state scores, as in Predict().
+  arma::vec logStateProb(states);
+  for (size_t state = 0; state < states; state++)
+  {
+    logStateProb[state] = logInitial[state] +
+        emission[state].LogProbability(dataSeq.unsafe_col(0));
+  }
+  checkpoints.col(0) = logStateProb;
+
+  // Forward pass, block by block; the emission log-probabilities are also
+  // computed one block at a time to keep memory bounded.
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    stateSeq[dataSeq.n_cols - t] =
-        stateSeqBack(stateSeq[dataSeq.n_cols - t + 1], dataSeq.n_cols - t + 1);
+    const size_t blockStart = b * blockSize;
+    const size_t blockEnd = std::min(blockStart + blockSize, length) - 1;
+    const size_t firstStep = std::max(blockStart, (size_t) 1);
+    if (firstStep > blockEnd)
+      continue;
+
+    // Emission log-probabilities for times [firstStep, blockEnd].
+    const arma::mat blockData(dataSeq.cols(firstStep, blockEnd));
+    arma::mat logProbs(blockData.n_cols, states);
+    for (size_t i = 0; i < states; i++)
+    {
+      arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+      emission[i].LogProbability(blockData, alias);
+    }
+
+    for (size_t t = firstStep; t <= blockEnd; ++t)
+    {
+      // Vectorized max-plus step, as in Predict().
+      arma::mat scores = logTransition;
+      scores.each_row() += logStateProb.t();
+      logStateProb = arma::max(scores, 1) + logProbs.row(t - firstStep).t();
+
+      // Checkpoint the scores at the last time step before the next block.
+      if (((t + 1) % blockSize == 0) && (t + 1 < length))
+        checkpoints.col((t + 1) / blockSize) = logStateProb;
+    }
+  }
+
+  // The best final state starts the backtrace.
+  arma::uword index;
+  const double loglik = logStateProb.max(index);
+  stateSeq[length - 1] = index;
+
+  // Backtrace, recomputing one block at a time from its checkpoint.  Block b
+  // recomputes the backpointers for times (checkpointTime, blockEnd] and
+  // fills in the states for [checkpointTime, blockEnd - 1]; the state at
+  // blockEnd is already known (from the final maximization, or from the
+  // following block).
+  for (size_t b = numBlocks; b-- > 0; )
+  {
+    const size_t blockStart = b * blockSize;
+    const size_t blockEnd = std::min(blockStart + blockSize, length) - 1;
+    const size_t checkpointTime = (b == 0) ? 0 : blockStart - 1;
+    if (blockEnd == checkpointTime)
+      continue;
+
+    arma::vec segProb = checkpoints.col(b);
+
+    // Emission log-probabilities for times [checkpointTime + 1, blockEnd].
+    const arma::mat blockData(dataSeq.cols(checkpointTime + 1, blockEnd));
+    arma::mat logProbs(blockData.n_cols, states);
+    for (size_t i = 0; i < states; i++)
+    {
+      arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+      emission[i].LogProbability(blockData, alias);
+    }
+
+    // Recompute the backpointers for this block only.
+    arma::umat back(states, blockData.n_cols);
+    for (size_t t = checkpointTime + 1; t <= blockEnd; ++t)
+    {
+      arma::mat scores = logTransition;
+      scores.each_row() += segProb.t();
+      back.col(t - checkpointTime - 1) = arma::index_max(scores, 1);
+      segProb = arma::max(scores, 1) +
+          logProbs.row(t - checkpointTime - 1).t();
+    }
+
+    for (size_t t = blockEnd; t > checkpointTime; --t)
+      stateSeq[t - 1] = back(stateSeq[t], t - checkpointTime - 1);
   }
 
-  return logStateProb(stateSeq(dataSeq.n_cols - 1), dataSeq.n_cols - 1);
+  return loglik;
 }
 
 /**
@@ -574,6 +1284,84 @@ double HMM<Distribution>::LogLikelihood(const arma::mat& dataSeq) const
   return accu(logScales);
 }
 
+/**
+ * Compute the log-likelihood of each of the given data sequences, in parallel
+ * across the sequences.
+ */
+template<typename Distribution>
+void HMM<Distribution>::LogLikelihood(const std::vector<arma::mat>& dataSeq,
+                                      arma::vec& logLikelihoods) const
+{
+  logLikelihoods.set_size(dataSeq.size());
+  if (dataSeq.empty())
+    return;
+
+  // Bring the log-space parameters up to date once, before the parallel
+  // region; afterwards they are only read.
+  ConvertToLogSpace();
+
+  const size_t states = logTransition.n_rows;
+
+  // If every sequence has the same length, the emission log-probabilities of
+  // all sequences can be computed in one pass.
+  bool sameLength = true;
+  const size_t length = dataSeq[0].n_cols;
+  for (size_t n = 1; n < dataSeq.size(); ++n)
+  {
+    if (dataSeq[n].n_cols != length)
+    {
+      sameLength = false;
+      break;
+    }
+  }
+
+  if (sameLength && length > 0)
+  {
+    arma::mat allLogProbs;
+    StackedEmissionLogProbs(dataSeq, allLogProbs);
+
+    #pragma omp parallel default(shared)
+    {
+      // Per-thread forward-pass workspace, reused across sequences.
+      arma::mat forwardLog;
+      arma::vec logScales;
+
+      #pragma omp for
+      for (omp_size_t n = 0; n < (omp_size_t) dataSeq.size(); ++n)
+      {
+        arma::mat seqLogProbs = allLogProbs.rows(n * length,
+            (n + 1) * length - 1);
+        Forward(dataSeq[n], logScales, forwardLog, seqLogProbs);
+        logLikelihoods[n] = accu(logScales);
+      }
+    }
+  }
+  else
+  {
+    #pragma omp parallel default(shared)
+    {
+      // Per-thread workspace, reused across sequences.
+      arma::mat forwardLog;
+      arma::vec logScales;
+      arma::mat logProbs;
+
+      #pragma omp for
+      for (omp_size_t n = 0; n < (omp_size_t) dataSeq.size(); ++n)
+      {
+        logProbs.set_size(dataSeq[n].n_cols, states);
+        for (size_t i = 0; i < states; ++i)
+        {
+          arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+          emission[i].LogProbability(dataSeq[n], alias);
+        }
+
+        Forward(dataSeq[n], logScales, forwardLog, logProbs);
+        logLikelihoods[n] = accu(logScales);
+      }
+    }
+  }
+}
+
 /**
  * Compute the log of the scaling factor of the given emission probability
  * at time t. To calculate the log-likelihood for the whole sequence,
@@ -845,6 +1633,15 @@ void HMM<Distribution>::ConvertToLogSpace() const
   if (recalculateTransition)
   {
     logTransition = log(transitionProxy);
+
+    // Also rebuild the sparse view of the transitions, used by beam-pruned
+    // Viterbi: the structure in linear space, plus the logs of the nonzero
+    // values in the order of the value array.
+    sparseTransition = arma::sp_mat(transitionProxy);
+    sparseLogTransition.set_size(sparseTransition.n_nonzero);
+    for (size_t k = 0; k < sparseTransition.n_nonzero; ++k)
+      sparseLogTransition[k] = std::log(sparseTransition.values[k]);
+
     recalculateTransition = false;
   }
 }
@@ -48,6 +48,12 @@ namespace tree {
  * categorical attributes are handled.  As far as the actual splitting goes,
  * the meat of the splitting procedure will be contained in those two classes.
  *
+ * In batch mode, the split statistics of each dimension are updated in
+ * parallel, since the statistics of one dimension are independent of those of
+ * every other dimension.  The tree is not safe for concurrent use: calls to
+ * Train() and Classify() on the same tree must be serialized externally, as
+ * for the other mlpack classifiers.
+ *
  * @tparam FitnessFunction Fitness function to use.
  * @tparam NumericSplitType Technique for splitting numeric features.
  * @tparam CategoricalSplitType Technique for splitting categorical features.
@@ -247,6 +253,19 @@ class HoeffdingTree
   //! Get the splitting dimension (size_t(-1) if no split).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the information on the types of the dimensions.
+  const data::DatasetInfo& DatasetInfo() const { return *datasetInfo; }
+
+  //! Get the split information for a numeric split (only meaningful after
+  //! this node has split on a numeric dimension).
+  const typename NumericSplitType<FitnessFunction>::SplitInfo&
+      NumericSplitInfo() const { return numericSplit; }
+
+  //! Get the split information for a categorical split (only meaningful after
+  //! this node has split on a categorical dimension).
+  const typename CategoricalSplitType<FitnessFunction>::SplitInfo&
+      CategoricalSplitInfo() const { return categoricalSplit; }
+
   //! Get the majority class.
   size_t MajorityClass() const { return majorityClass; }
   //! Modify the majority class.
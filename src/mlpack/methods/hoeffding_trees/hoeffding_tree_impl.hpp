@@ -774,6 +774,11 @@ void HoeffdingTree<
         childMajorities, numericSplit);
   }
 
+  // Build the children into a temporary vector first, so that if a child
+  // constructor throws, the node is left unchanged (still a leaf) instead of
+  // half-split.
+  std::vector<HoeffdingTree*> newChildren;
+
   // We already know what the splitDimension will be.
   for (size_t i = 0; i < childMajorities.n_elem; ++i)
   {
@@ -784,7 +789,7 @@ void HoeffdingTree<
     if (categoricalSplits.size() == 0)
     {
       // Pass a default categorical split.
-      children.push_back(new HoeffdingTree(*datasetInfo, numClasses,
+      newChildren.push_back(new HoeffdingTree(*datasetInfo, numClasses,
           successProbability, maxSamples, checkInterval, minSamples,
           CategoricalSplitType<FitnessFunction>(0, numClasses),
           numericSplits[0], dimensionMappings, false));
@@ -792,7 +797,7 @@ void HoeffdingTree<
     else if (numericSplits.size() == 0)
     {
       // Pass a default numeric split.
-      children.push_back(new HoeffdingTree(*datasetInfo, numClasses,
+      newChildren.push_back(new HoeffdingTree(*datasetInfo, numClasses,
           successProbability, maxSamples, checkInterval, minSamples,
           categoricalSplits[0], NumericSplitType<FitnessFunction>(numClasses),
           dimensionMappings, false));
@@ -800,14 +805,16 @@ void HoeffdingTree<
     else
     {
       // Pass both splits that we already have.
-      children.push_back(new HoeffdingTree(*datasetInfo, numClasses,
+      newChildren.push_back(new HoeffdingTree(*datasetInfo, numClasses,
           successProbability, maxSamples, checkInterval, minSamples,
           categoricalSplits[0], numericSplits[0], dimensionMappings, false));
     }
 
-    children[i]->MajorityClass() = childMajorities[i];
+    newChildren[i]->MajorityClass() = childMajorities[i];
   }
 
+  children.swap(newChildren);
+
   // Eliminate now-unnecessary split information.
   numericSplits.clear();
   categoricalSplits.clear();
@@ -955,8 +962,53 @@ void HoeffdingTree<
     // Don't split if there are fewer than five points.
     size_t oldMaxSamples = maxSamples;
     maxSamples = std::max(size_t(data.n_cols - 1), size_t(5));
-    for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    if (children.size() == 0)
+    {
+      // This node is still a leaf, so the whole batch updates this node's
+      // split statistics.  The statistics of one dimension are entirely
+      // independent of those of every other dimension, so we can shard the
+      // updates across threads by dimension instead of passing the points
+      // through one at a time.
+      #pragma omp parallel for
+      for (omp_size_t i = 0; i < (omp_size_t) data.n_rows; ++i)
+      {
+        const size_t index = dimensionMappings->at(i).second;
+        if (datasetInfo->Type(i) == data::Datatype::categorical)
+        {
+          for (size_t j = 0; j < data.n_cols; ++j)
+            categoricalSplits[index].Train(data(i, j), labels[j]);
+        }
+        else if (datasetInfo->Type(i) == data::Datatype::numeric)
+        {
+          for (size_t j = 0; j < data.n_cols; ++j)
+            numericSplits[index].Train(data(i, j), labels[j]);
+        }
+      }
+      numSamples += data.n_cols;
+
+      // Grab majority class from splits.
+      if (categoricalSplits.size() > 0)
+      {
+        majorityClass = categoricalSplits[0].MajorityClass();
+        majorityProbability = categoricalSplits[0].MajorityProbability();
+      }
+      else
+      {
+        majorityClass = numericSplits[0].MajorityClass();
+        majorityProbability = numericSplits[0].MajorityProbability();
+      }
+
+      // Now that the whole batch has been absorbed, check for a split.
+      if (SplitCheck() > 0)
+        CreateChildren();
+    }
+    else
+    {
+      // This node has already split, so pass the points through one at a time
+      // and let them be routed to the children.
+      for (size_t i = 0; i < data.n_cols; ++i)
+        Train(data.col(i), labels[i]);
+    }
     maxSamples = oldMaxSamples;
 
     // Now, if we did split, find out which points go to which child, and
@@ -0,0 +1,138 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_tree_snapshot.hpp
+ *
+ * A compiled inference snapshot of a binary-numeric Hoeffding tree.  The
+ * HoeffdingTree itself is built for growing: each node is a separate heap
+ * object carrying split statistics, so Classify() chases pointers and
+ * touches far more memory than the few values a descent actually needs.
+ * The snapshot packs the tree into a flat array of 16-byte nodes---split
+ * dimension, threshold, and child index for internal nodes; the majority
+ * class for leaves---with the two children of every node adjacent, so a
+ * serving thread descends through a handful of cache lines.
+ *
+ * Refresh() rebuilds the packed array from the (possibly grown) tree into a
+ * second buffer and publishes it atomically, so a single refresher thread
+ * can keep the snapshot current while other threads keep classifying
+ * against the old version.  Like HoeffdingTree's own single-writer
+ * guarantee, this covers one Refresh() at a time: a new Refresh() must not
+ * begin while a Classify() call that started before the previous Refresh()
+ * could still be running.
+ *
+ * Only trees whose every internal node is a binary split on a numeric
+ * dimension can be compiled (e.g. trees using BinaryDoubleNumericSplit and
+ * no categorical dimensions); use CanCompile() to check.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_TREE_SNAPSHOT_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_TREE_SNAPSHOT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+
+#include "binary_numeric_split.hpp"
+#include "hoeffding_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A flat, read-only copy of a HoeffdingTree for fast classification.
+ *
+ * @tparam HoeffdingTreeType The type of the tree to compile.  Its numeric
+ *      split information must provide SplitPoint() (i.e. binary numeric
+ *      splits).
+ */
+template<typename HoeffdingTreeType = HoeffdingTree<GiniImpurity,
+    BinaryDoubleNumericSplit>>
+class HoeffdingTreeSnapshot
+{
+ public:
+  //! Create an empty snapshot; Classify() predicts class 0 until the first
+  //! Refresh().
+  HoeffdingTreeSnapshot();
+
+  //! Create a snapshot of the given tree (see Refresh()).
+  explicit HoeffdingTreeSnapshot(const HoeffdingTreeType& tree);
+
+  //! Copy the other snapshot's current state.
+  HoeffdingTreeSnapshot(const HoeffdingTreeSnapshot& other);
+
+  //! Make this snapshot a copy of the other snapshot's current state.
+  HoeffdingTreeSnapshot& operator=(const HoeffdingTreeSnapshot& other);
+
+  /**
+   * Check whether the given tree can be compiled: every internal node must
+   * be a two-way split on a numeric dimension.
+   *
+   * @param tree Tree to check.
+   */
+  static bool CanCompile(const HoeffdingTreeType& tree);
+
+  /**
+   * Rebuild the packed representation from the given tree and publish it.
+   * Classify() calls concurrent with the rebuild keep using the previous
+   * snapshot until the new one is complete.
+   *
+   * @param tree Tree to compile.  If CanCompile(tree) is false, a
+   *      std::invalid_argument exception is thrown and the previous snapshot
+   *      stays in place.
+   */
+  void Refresh(const HoeffdingTreeType& tree);
+
+  /**
+   * Classify the given point using the packed tree, returning the predicted
+   * label (the majority class of the leaf the point falls into).
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given points using the packed tree.
+   *
+   * @param data Points to classify.
+   * @param predictions Predicted labels for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  //! Get the number of packed nodes (0 before the first Refresh()).
+  size_t NumNodes() const;
+
+ private:
+  /**
+   * One packed node.  For internal nodes, child holds the index of the left
+   * child (the right child is at child + 1); for leaves, splitDimension is
+   * leafMarker and child holds the majority class.
+   */
+  struct PackedNode
+  {
+    //! The split threshold (unused in leaves).
+    double splitValue;
+    //! The dimension the node splits on, or leafMarker for a leaf.
+    uint32_t splitDimension;
+    //! The index of the left child, or the majority class of a leaf.
+    uint32_t child;
+  };
+
+  //! Marks a packed node as a leaf.
+  static const uint32_t leafMarker = 0xFFFFFFFF;
+
+  //! The two snapshot buffers; Refresh() builds into the inactive one.
+  std::vector<PackedNode> buffers[2];
+  //! The index of the buffer Classify() should read.
+  std::atomic<size_t> activeBuffer;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#include "hoeffding_tree_snapshot_impl.hpp"
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_tree_snapshot_impl.hpp
+ *
+ * Implementation of the compiled Hoeffding tree inference snapshot.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_TREE_SNAPSHOT_IMPL_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_TREE_SNAPSHOT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hoeffding_tree_snapshot.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace tree {
+
+template<typename HoeffdingTreeType>
+HoeffdingTreeSnapshot<HoeffdingTreeType>::HoeffdingTreeSnapshot() :
+    activeBuffer(0)
+{
+  // Nothing to do; Classify() predicts class 0 until the first Refresh().
+}
+
+template<typename HoeffdingTreeType>
+HoeffdingTreeSnapshot<HoeffdingTreeType>::HoeffdingTreeSnapshot(
+    const HoeffdingTreeType& tree) :
+    activeBuffer(0)
+{
+  Refresh(tree);
+}
+
+template<typename HoeffdingTreeType>
+HoeffdingTreeSnapshot<HoeffdingTreeType>::HoeffdingTreeSnapshot(
+    const HoeffdingTreeSnapshot& other) :
+    activeBuffer(0)
+{
+  buffers[0] = other.buffers[other.activeBuffer.load(
+      std::memory_order_acquire)];
+}
+
+template<typename HoeffdingTreeType>
+HoeffdingTreeSnapshot<HoeffdingTreeType>&
+HoeffdingTreeSnapshot<HoeffdingTreeType>::operator=(
+    const HoeffdingTreeSnapshot& other)
+{
+  if (this != &other)
+  {
+    const size_t next = 1 - activeBuffer.load(std::memory_order_relaxed);
+    buffers[next] = other.buffers[other.activeBuffer.load(
+        std::memory_order_acquire)];
+    activeBuffer.store(next, std::memory_order_release);
+  }
+  return *this;
+}
+
+template<typename HoeffdingTreeType>
+bool HoeffdingTreeSnapshot<HoeffdingTreeType>::CanCompile(
+    const HoeffdingTreeType& tree)
+{
+  if (tree.NumChildren() == 0)
+    return true;
+
+  if (tree.NumChildren() != 2 ||
+      tree.DatasetInfo().Type(tree.SplitDimension()) !=
+          data::Datatype::numeric)
+    return false;
+
+  return CanCompile(tree.Child(0)) && CanCompile(tree.Child(1));
+}
+
+template<typename HoeffdingTreeType>
+void HoeffdingTreeSnapshot<HoeffdingTreeType>::Refresh(
+    const HoeffdingTreeType& tree)
+{
+  if (!CanCompile(tree))
+  {
+    throw std::invalid_argument("HoeffdingTreeSnapshot::Refresh(): every "
+        "internal node of the tree must be a binary split on a numeric "
+        "dimension!");
+  }
+
+  // Lay the nodes out in breadth-first order, with the two children of each
+  // internal node adjacent so that only the left child's index is stored.
+  std::vector<PackedNode> packed(1);
+  std::queue<std::pair<const HoeffdingTreeType*, size_t>> frontier;
+  frontier.push(std::make_pair(&tree, (size_t) 0));
+  while (!frontier.empty())
+  {
+    const HoeffdingTreeType* node = frontier.front().first;
+    const size_t index = frontier.front().second;
+    frontier.pop();
+
+    if (node->NumChildren() == 0)
+    {
+      packed[index].splitValue = 0.0;
+      packed[index].splitDimension = leafMarker;
+      packed[index].child = (uint32_t) node->MajorityClass();
+    }
+    else
+    {
+      const size_t left = packed.size();
+      packed.resize(packed.size() + 2);
+      packed[index].splitValue = (double) node->NumericSplitInfo().
+          SplitPoint();
+      packed[index].splitDimension = (uint32_t) node->SplitDimension();
+      packed[index].child = (uint32_t) left;
+      frontier.push(std::make_pair(&node->Child(0), left));
+      frontier.push(std::make_pair(&node->Child(1), left + 1));
+    }
+  }
+
+  // Publish the new snapshot; concurrent readers switch over atomically.
+  const size_t next = 1 - activeBuffer.load(std::memory_order_relaxed);
+  buffers[next].swap(packed);
+  activeBuffer.store(next, std::memory_order_release);
+}
+
+template<typename HoeffdingTreeType>
+template<typename VecType>
+size_t HoeffdingTreeSnapshot<HoeffdingTreeType>::Classify(
+    const VecType& point) const
+{
+  const std::vector<PackedNode>& nodes =
+      buffers[activeBuffer.load(std::memory_order_acquire)];
+  if (nodes.empty())
+    return 0;
+
+  size_t index = 0;
+  while (nodes[index].splitDimension != leafMarker)
+  {
+    const PackedNode& node = nodes[index];
+    // The left child holds the points below the threshold, matching
+    // BinaryNumericSplitInfo::CalculateDirection().
+    index = node.child +
+        ((point[node.splitDimension] < node.splitValue) ? 0 : 1);
+  }
+
+  return nodes[index].child;
+}
+
+template<typename HoeffdingTreeType>
+template<typename MatType>
+void HoeffdingTreeSnapshot<HoeffdingTreeType>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& predictions) const
+{
+  const std::vector<PackedNode>& nodes =
+      buffers[activeBuffer.load(std::memory_order_acquire)];
+  predictions.set_size(data.n_cols);
+  if (nodes.empty())
+  {
+    predictions.zeros();
+    return;
+  }
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    size_t index = 0;
+    while (nodes[index].splitDimension != leafMarker)
+    {
+      const PackedNode& node = nodes[index];
+      index = node.child +
+          ((data(node.splitDimension, i) < node.splitValue) ? 0 : 1);
+    }
+    predictions[i] = nodes[index].child;
+  }
+}
+
+template<typename HoeffdingTreeType>
+size_t HoeffdingTreeSnapshot<HoeffdingTreeType>::NumNodes() const
+{
+  return buffers[activeBuffer.load(std::memory_order_acquire)].size();
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
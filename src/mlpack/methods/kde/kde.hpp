@@ -194,6 +194,38 @@ class KDE
    */
   void Evaluate(MatType querySet, arma::vec& estimations);
 
+  /**
+   * Estimate density of each point in the query set for several candidate
+   * bandwidths at once, using a single traversal.  The tree and the node
+   * distance bounds are bandwidth-independent, so a bandwidth sweep (e.g.
+   * bandwidth tuning) does not need one full traversal per candidate value:
+   * each node combination is scored once and the prune decision is taken per
+   * bandwidth from the shared distance bounds.  The result is stored in the
+   * estimations matrix, with one row per bandwidth and one column per query
+   * point.  Estimations might not be normalized.
+   *
+   * Each candidate bandwidth honors the model's relative and absolute error
+   * tolerances, although pruning is slightly more conservative than running
+   * Evaluate() once per bandwidth.  Monte Carlo estimations are not applied
+   * in this mode.
+   *
+   * - KernelType must be constructible from a bandwidth value.
+   *
+   * - Dimension of each point in the query set must match the dimension of
+   *   each point in the reference set.
+   *
+   * - Use std::move if the query set is no longer needed.
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to get the density of.
+   * @param bandwidths Candidate bandwidth values to evaluate.
+   * @param estimations Matrix which will hold the density of each query point
+   *                    for each bandwidth.
+   */
+  void Evaluate(MatType querySet,
+                const std::vector<double>& bandwidths,
+                arma::mat& estimations);
+
   /**
    * Estimate density of each point in the query set given the data of an
    * already created query tree. The result is stored in an estimations vector.
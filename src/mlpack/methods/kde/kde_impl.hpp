@@ -435,36 +435,215 @@ Evaluate(MatType querySet, arma::vec& estimations)
                                   "referenceSet dimensions don't match");
     }
 
-    // Evaluate.
-    typedef KDERules<MetricType, KernelType, Tree> RuleType;
-    RuleType rules = RuleType(referenceTree->Dataset(),
-                              querySet,
-                              estimations,
-                              relError,
-                              absError,
-                              mcProb,
-                              initialSampleSize,
-                              mcEntryCoef,
-                              mcBreakCoef,
-                              metric,
-                              kernel,
-                              monteCarlo,
-                              false);
+    // Evaluate.  Each query point's traversal is independent, so the loop is
+    // parallelized over query points.  Every thread gets its own rule set
+    // because the rules cache per-traversal state (traversal info and the
+    // last query/reference indices), but the rule sets can all share the
+    // estimations vector: a query point's density and accumulated error are
+    // only ever written by the thread that owns that point.
+    size_t numThreads = 1;
+    #ifdef HAS_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+    #endif
 
-    // Create traverser.
-    SingleTreeTraversalType<RuleType> traverser(rules);
+    typedef KDERules<MetricType, KernelType, Tree> RuleType;
+    std::vector<RuleType> rules;
+    rules.reserve(numThreads);
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      rules.push_back(RuleType(referenceTree->Dataset(),
+                               querySet,
+                               estimations,
+                               relError,
+                               absError,
+                               mcProb,
+                               initialSampleSize,
+                               mcEntryCoef,
+                               mcBreakCoef,
+                               metric,
+                               kernel,
+                               monteCarlo,
+                               false));
+    }
 
     // Traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      size_t threadId = 0;
+      #ifdef HAS_OPENMP
+      threadId = (size_t) omp_get_thread_num();
+      #endif
+
+      SingleTreeTraversalType<RuleType> traverser(rules[threadId]);
+      traverser.Traverse((size_t) i, *referenceTree);
+    }
+
+    estimations /= referenceTree->Dataset().n_cols;
+
+    // Accumulate traversal statistics over all threads.
+    size_t totalScores = 0, totalBaseCases = 0;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      totalScores += rules[t].Scores();
+      totalBaseCases += rules[t].BaseCases();
+    }
+
+    Log::Info << totalScores << " node combinations were scored."
+              << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated."
+              << std::endl;
+  }
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(MatType querySet,
+         const std::vector<double>& bandwidths,
+         arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  // Check there is at least one candidate bandwidth.
+  if (bandwidths.empty())
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: at least one "
+                                "candidate bandwidth is required");
+  }
+
+  // Get estimations matrix ready; one row per bandwidth.
+  estimations.clear();
+  estimations.set_size(bandwidths.size(), querySet.n_cols);
+  estimations.fill(arma::fill::zeros);
+
+  // Check querySet has at least 1 element to evaluate.
+  if (querySet.n_cols == 0)
+  {
+    Log::Warn << "KDE::Evaluate(): querySet is empty, no predictions will "
+              << "be returned" << std::endl;
+    return;
+  }
+
+  // Check whether dimensions match.
+  if (querySet.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: querySet and "
+                                "referenceSet dimensions don't match");
+  }
+
+  // Instantiate one kernel per candidate bandwidth.
+  std::vector<KernelType> kernels;
+  kernels.reserve(bandwidths.size());
+  for (size_t b = 0; b < bandwidths.size(); ++b)
+    kernels.push_back(KernelType(bandwidths[b]));
+
+  typedef KDEMultiKernelRules<MetricType, KernelType, Tree> RuleType;
+
+  if (mode == DUAL_TREE_MODE)
+  {
+    // One dual-tree traversal evaluates every bandwidth.
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+
+    RuleType rules(referenceTree->Dataset(),
+                   queryTree->Dataset(),
+                   estimations,
+                   relError,
+                   absError,
+                   metric,
+                   kernels,
+                   false);
+
+    DualTreeTraversalType<RuleType> traverser(rules);
+    traverser.Traverse(*queryTree, *referenceTree);
+    delete queryTree;
 
     estimations /= referenceTree->Dataset().n_cols;
 
+    // Rearrange if necessary.
+    if (tree::TreeTraits<Tree>::RearrangesDataset)
+    {
+      arma::mat rearrangedEstimations(estimations.n_rows, estimations.n_cols);
+      for (size_t i = 0; i < oldFromNewQueries.size(); ++i)
+        rearrangedEstimations.col(oldFromNewQueries.at(i)) =
+            estimations.col(i);
+      estimations = std::move(rearrangedEstimations);
+    }
+
     Log::Info << rules.Scores() << " node combinations were scored."
               << std::endl;
     Log::Info << rules.BaseCases() << " base cases were calculated."
               << std::endl;
   }
+  else if (mode == SINGLE_TREE_MODE)
+  {
+    // Evaluate.  As in the single-bandwidth case, each thread gets its own
+    // rule set but the estimations matrix is shared: a query point's column
+    // is only ever written by the thread that owns that point.
+    size_t numThreads = 1;
+    #ifdef HAS_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+    #endif
+
+    std::vector<RuleType> rules;
+    rules.reserve(numThreads);
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      rules.push_back(RuleType(referenceTree->Dataset(),
+                               querySet,
+                               estimations,
+                               relError,
+                               absError,
+                               metric,
+                               kernels,
+                               false));
+    }
+
+    // Traverse for each point.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      size_t threadId = 0;
+      #ifdef HAS_OPENMP
+      threadId = (size_t) omp_get_thread_num();
+      #endif
+
+      SingleTreeTraversalType<RuleType> traverser(rules[threadId]);
+      traverser.Traverse((size_t) i, *referenceTree);
+    }
+
+    estimations /= referenceTree->Dataset().n_cols;
+
+    // Accumulate traversal statistics over all threads.
+    size_t totalScores = 0, totalBaseCases = 0;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      totalScores += rules[t].Scores();
+      totalBaseCases += rules[t].BaseCases();
+    }
+
+    Log::Info << totalScores << " node combinations were scored."
+              << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated."
+              << std::endl;
+  }
 }
 
 template<typename KernelType,
@@ -592,41 +771,71 @@ Evaluate(arma::vec& estimations)
     cleanTraverser.Traverse(0, *referenceTree);
   }
 
-  // Evaluate.
+  // Evaluate.  As in the bichromatic case, the single-tree mode gives each
+  // thread its own rule set but shares the estimations vector, since each
+  // query point is only ever touched by the thread that owns it.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+  if (mode == SINGLE_TREE_MODE)
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+
   typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            referenceTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            true);
+  std::vector<RuleType> rules;
+  rules.reserve(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    rules.push_back(RuleType(referenceTree->Dataset(),
+                             referenceTree->Dataset(),
+                             estimations,
+                             relError,
+                             absError,
+                             mcProb,
+                             initialSampleSize,
+                             mcEntryCoef,
+                             mcBreakCoef,
+                             metric,
+                             kernel,
+                             monteCarlo,
+                             true));
+  }
 
   if (mode == DUAL_TREE_MODE)
   {
     // Create traverser.
-    DualTreeTraversalType<RuleType> traverser(rules);
+    DualTreeTraversalType<RuleType> traverser(rules[0]);
     traverser.Traverse(*referenceTree, *referenceTree);
   }
   else if (mode == SINGLE_TREE_MODE)
   {
-    SingleTreeTraversalType<RuleType> traverser(rules);
-    for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0;
+         i < (omp_size_t) referenceTree->Dataset().n_cols; ++i)
+    {
+      size_t threadId = 0;
+      #ifdef HAS_OPENMP
+      threadId = (size_t) omp_get_thread_num();
+      #endif
+
+      SingleTreeTraversalType<RuleType> traverser(rules[threadId]);
+      traverser.Traverse((size_t) i, *referenceTree);
+    }
   }
 
   estimations /= referenceTree->Dataset().n_cols;
   // Rearrange if necessary.
   RearrangeEstimations(*oldFromNewReferences, estimations);
 
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  // Accumulate traversal statistics over all threads.
+  size_t totalScores = 0, totalBaseCases = 0;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    totalScores += rules[t].Scores();
+    totalBaseCases += rules[t].BaseCases();
+  }
+
+  Log::Info << totalScores << " node combinations were scored." << std::endl;
+  Log::Info << totalBaseCases << " base cases were calculated." << std::endl;
 }
 
 template<typename KernelType,
@@ -14,6 +14,9 @@
 #define MLPACK_METHODS_KDE_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
+
+#include <unordered_map>
 
 namespace mlpack {
 namespace kde {
@@ -21,8 +24,15 @@ namespace kde {
 /**
  * A dual-tree traversal Rules class for kernel density estimation.  This
  * contains the Score() and BaseCase() implementations.
+ *
+ * The optional StatsType parameter selects the traversal instrumentation
+ * type; the default compiles to nothing, while tree::TraversalStatistics
+ * records prune counters.
  */
-template<typename MetricType, typename KernelType, typename TreeType>
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType = tree::NullTraversalStatistics>
 class KDERules
 {
  public:
@@ -97,6 +107,11 @@ class KDERules
   //! results.
   size_t MinimumBaseCases() const { return 0; }
 
+  //! Get the traversal instrumentation counters.
+  const StatsType& TraversalStats() const { return travStats; }
+  //! Modify the traversal instrumentation counters.
+  StatsType& TraversalStats() { return travStats; }
+
  private:
   //! Evaluate kernel value of 2 points given their indexes.
   double EvaluateKernel(const size_t queryIndex,
@@ -106,6 +121,13 @@ class KDERules
   double EvaluateKernel(const arma::vec& query,
                         const arma::vec& reference) const;
 
+  //! Evaluate kernel values of a query point against a batch of reference
+  //! points.  The sampled reference columns are gathered into one contiguous
+  //! block so the distance computations vectorize.
+  void EvaluateKernelBatch(const size_t queryIndex,
+                           const arma::uvec& referenceIndices,
+                           arma::vec& kernelValues) const;
+
   //! Calculate depth alpha for some node.
   double CalculateAlpha(TreeType* node);
 
@@ -162,9 +184,303 @@ class KDERules
   constexpr static bool kernelIsGaussian =
       std::is_same<KernelType, kernel::GaussianKernel>::value;
 
+  //! Whether the metric is the Euclidean distance, in which case batched
+  //! kernel evaluations can use vectorized distance computations.
+  constexpr static bool metricIsEuclidean =
+      std::is_same<MetricType, metric::EuclideanDistance>::value;
+
+  //! Absolute error tolerance available for each reference point.
+  const double absErrorTol;
+
+  //! The last query index.
+  size_t lastQueryIndex;
+
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
+  //! Traversal information.
+  TraversalInfoType traversalInfo;
+
+  //! Traversal instrumentation counters (empty unless opted into).
+  mutable StatsType travStats;
+
+  //! The number of base cases.
+  size_t baseCases;
+
+  //! The number of scores.
+  size_t scores;
+};
+
+/**
+ * A traversal Rules class that evaluates kernel density estimations for
+ * several bandwidths in a single traversal.  The tree and the node distance
+ * bounds are bandwidth-independent, so a bandwidth sweep does not need one
+ * traversal per candidate value: each node combination is scored once, the
+ * min/max distance bounds are shared, and the prune decision is taken per
+ * bandwidth from those shared bounds.  A node combination is pruned only when
+ * every bandwidth can be approximated within its error tolerance; the base
+ * case computes the distance once and applies every kernel to it.
+ *
+ * Monte Carlo estimations and the leftover-tolerance relaxation of KDERules
+ * are not applied in this mode, so pruning is slightly more conservative than
+ * a sequence of single-bandwidth traversals, but the results honor the same
+ * relative and absolute error tolerances for every bandwidth.
+ */
+template<typename MetricType, typename KernelType, typename TreeType>
+class KDEMultiKernelRules
+{
+ public:
+  /**
+   * Construct KDEMultiKernelRules.
+   *
+   * @param referenceSet Reference set data.
+   * @param querySet Query set data.
+   * @param densities Matrix where estimations will be written; one row per
+   *                  kernel and one column per query point.
+   * @param relError Relative error tolerance.
+   * @param absError Absolute error tolerance.
+   * @param metric Instantiated metric.
+   * @param kernels Instantiated kernels, one per candidate bandwidth.
+   * @param sameSet True if query and reference sets are the same
+   *                (monochromatic evaluation).
+   */
+  KDEMultiKernelRules(const arma::mat& referenceSet,
+                      const arma::mat& querySet,
+                      arma::mat& densities,
+                      const double relError,
+                      const double absError,
+                      MetricType& metric,
+                      std::vector<KernelType>& kernels,
+                      const bool sameSet);
+
+  //! Base Case.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  //! SingleTree Score.
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  //! SingleTree Rescore.
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  //! Dual-Tree Score.
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Dual-Tree Rescore.
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
+  //! Get traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+
+  //! Modify traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+
+  //! Get the number of scores.
+  size_t Scores() const { return scores; }
+
+  //! Get the minimum number of base cases we need to perform to have
+  //! acceptable results.
+  size_t MinimumBaseCases() const { return 0; }
+
+ private:
+  //! Evaluate every kernel on the shared node distance bounds and decide
+  //! whether all of them can prune.  The per-kernel min/max kernel values are
+  //! left in the scratch vectors for the caller to compute estimations from.
+  bool CanPruneAllKernels(const double minDistance, const double maxDistance);
+
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! Density values; one row per kernel and one column per query point.
+  arma::mat& densities;
+
+  //! Absolute error tolerance.
+  const double absError;
+
+  //! Relative error tolerance.
+  const double relError;
+
+  //! Instantiated metric.
+  MetricType& metric;
+
+  //! Instantiated kernels, one per candidate bandwidth.
+  std::vector<KernelType>& kernels;
+
+  //! Whether reference and query sets are the same.
+  const bool sameSet;
+
   //! Absolute error tolerance available for each reference point.
   const double absErrorTol;
 
+  //! Scratch space for per-kernel values at the minimum node distance.
+  arma::vec maxKernels;
+
+  //! Scratch space for per-kernel values at the maximum node distance.
+  arma::vec minKernels;
+
+  //! The last query index.
+  size_t lastQueryIndex;
+
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
+  //! Traversal information.
+  TraversalInfoType traversalInfo;
+
+  //! The number of base cases.
+  size_t baseCases;
+
+  //! The number of scores.
+  size_t scores;
+};
+
+/**
+ * A traversal Rules class for weighted kernel summations.  It generalizes the
+ * KDE traversal: every reference point carries a (possibly vector-valued)
+ * weight and each query point accumulates the kernel-weighted sum of those
+ * weights, so the same tree machinery that evaluates densities also serves as
+ * a kernel-regression backend (Nadaraya-Watson numerators and denominators,
+ * Gaussian process mean predictions with precomputed coefficients, and so
+ * on).  KDERules is the special case where every weight is 1.
+ *
+ * The pruning mirrors KDERules: a node combination is approximated by the
+ * midpoint kernel value, scaled by the sum of the weights of the reference
+ * descendants, whenever the kernel bound gap is within the per-unit-weight
+ * error tolerance.  With nonnegative weights each accumulated row honors the
+ * relative and absolute error tolerances; with signed weights the guarantee
+ * is on the total variation (the sums of the positive and the negative parts
+ * separately).  Monte Carlo estimations and the leftover-tolerance relaxation
+ * of KDERules are not applied.
+ *
+ * The per-node weight sums are computed on first visit and cached for the
+ * rest of the traversal, so reusing one rules object across the queries of a
+ * single-tree traversal amortizes their cost.
+ */
+template<typename MetricType, typename KernelType, typename TreeType>
+class KDEWeightedSumRules
+{
+ public:
+  /**
+   * Construct KDEWeightedSumRules.
+   *
+   * @param referenceSet Reference set data.
+   * @param querySet Query set data.
+   * @param weights Reference weights; one row per accumulated value and one
+   *                column per reference point, in the same order as
+   *                referenceSet (i.e. already rearranged if the tree
+   *                rearranged the dataset).
+   * @param sums Matrix where the weighted kernel sums will be accumulated;
+   *             one row per weight row and one column per query point.
+   * @param relError Relative error tolerance (per unit of weight).
+   * @param absError Absolute error tolerance.
+   * @param metric Instantiated metric.
+   * @param kernel Instantiated kernel.
+   * @param sameSet True if query and reference sets are the same
+   *                (monochromatic evaluation).
+   */
+  KDEWeightedSumRules(const arma::mat& referenceSet,
+                      const arma::mat& querySet,
+                      const arma::mat& weights,
+                      arma::mat& sums,
+                      const double relError,
+                      const double absError,
+                      MetricType& metric,
+                      KernelType& kernel,
+                      const bool sameSet);
+
+  //! Base Case.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  //! SingleTree Score.
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  //! SingleTree Rescore.
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  //! Dual-Tree Score.
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Dual-Tree Rescore.
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
+  //! Get traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+
+  //! Modify traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+
+  //! Get the number of scores.
+  size_t Scores() const { return scores; }
+
+  //! Get the minimum number of base cases we need to perform to have
+  //! acceptable results.
+  size_t MinimumBaseCases() const { return 0; }
+
+ private:
+  /**
+   * Get the sum of the weights of the descendants of a node, computing and
+   * caching it on the first visit.
+   *
+   * @param node The reference node.
+   * @return The per-row weight sums of the node's descendants.
+   */
+  const arma::vec& NodeWeightSums(TreeType& node);
+
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! Reference weights; one row per accumulated value and one column per
+  //! reference point.
+  const arma::mat& weights;
+
+  //! Weighted kernel sums; one row per weight row and one column per query
+  //! point.
+  arma::mat& sums;
+
+  //! Absolute error tolerance.
+  const double absError;
+
+  //! Relative error tolerance.
+  const double relError;
+
+  //! Instantiated metric.
+  MetricType& metric;
+
+  //! Instantiated kernel.
+  KernelType& kernel;
+
+  //! Whether reference and query sets are the same.
+  const bool sameSet;
+
+  //! Absolute error tolerance available for each unit of weight.
+  double absErrorTol;
+
+  //! Cached per-node descendant weight sums.
+  std::unordered_map<const TreeType*, arma::vec> nodeWeightSums;
+
   //! The last query index.
   size_t lastQueryIndex;
 
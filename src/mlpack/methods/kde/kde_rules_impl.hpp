@@ -22,8 +22,11 @@
 namespace mlpack {
 namespace kde {
 
-template<typename MetricType, typename KernelType, typename TreeType>
-KDERules<MetricType, KernelType, TreeType>::KDERules(
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+KDERules<MetricType, KernelType, TreeType, StatsType>::KDERules(
     const arma::mat& referenceSet,
     const arma::mat& querySet,
     arma::vec& densities,
@@ -65,9 +68,12 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
 }
 
 //! The base case.
-template<typename MetricType, typename KernelType, typename TreeType>
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
 inline force_inline
-double KDERules<MetricType, KernelType, TreeType>::BaseCase(
+double KDERules<MetricType, KernelType, TreeType, StatsType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -90,6 +96,7 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   accumError(queryIndex) += 2 * relError * kernelValue;
 
   ++baseCases;
+  travStats.CountBaseCase();
   lastQueryIndex = queryIndex;
   lastReferenceIndex = referenceIndex;
   traversalInfo.LastBaseCase() = distance;
@@ -97,8 +104,11 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
 }
 
 //! Single-tree scoring function.
-template<typename MetricType, typename KernelType, typename TreeType>
-inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+inline double KDERules<MetricType, KernelType, TreeType, StatsType>::
 Score(const size_t queryIndex, TreeType& referenceNode)
 {
   // Auxiliary variables.
@@ -215,20 +225,27 @@ Score(const size_t queryIndex, TreeType& referenceNode)
         break;
       }
 
-      // Increase the sample size.
+      // Increase the sample size.  Draw the whole batch of random points
+      // first, then evaluate the kernel over the gathered block at once.
+      // The global generator is not thread-safe, so serialize the draws;
+      // the expensive kernel evaluations still run in parallel.
       sample.resize(newSize);
+      arma::uvec sampleIndices(m);
+      #pragma omp critical(KDEMonteCarloSampling)
       for (size_t i = 0; i < m; ++i)
       {
-        // Sample and evaluate random points from the reference node.
         size_t randomPoint;
         if (alreadyDidRefPoint0)
           randomPoint = math::RandInt(1, refNumDesc);
         else
           randomPoint = math::RandInt(0, refNumDesc);
 
-        sample(oldSize + i) =
-            EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
+        sampleIndices(i) = referenceNode.Descendant(randomPoint);
       }
+      arma::vec kernelValues;
+      EvaluateKernelBatch(queryIndex, sampleIndices, kernelValues);
+      sample.subvec(oldSize, newSize - 1) = kernelValues;
+
       meanSample = arma::mean(sample);
       const double stddev = arma::stddev(sample);
       const double mThreshBase =
@@ -288,13 +305,19 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   }
 
   ++scores;
+  travStats.CountScore();
+  if (score == DBL_MAX)
+    travStats.CountScorePrune();
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
   return score;
 }
 
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+inline force_inline double KDERules<MetricType, KernelType, TreeType, StatsType>::
 Rescore(const size_t /* queryIndex */,
         TreeType& /* referenceNode */,
         const double oldScore) const
@@ -304,8 +327,11 @@ Rescore(const size_t /* queryIndex */,
 }
 
 //! Dual-tree scoring function.
-template<typename MetricType, typename KernelType, typename TreeType>
-inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+inline double KDERules<MetricType, KernelType, TreeType, StatsType>::
 Score(TreeType& queryNode, TreeType& referenceNode)
 {
   kde::KDEStat& queryStat = queryNode.Stat();
@@ -432,20 +458,24 @@ Score(TreeType& queryNode, TreeType& referenceNode)
           break;
         }
 
-        // Increase the sample size.
+        // Increase the sample size.  Draw the whole batch of random points
+        // first, then evaluate the kernel over the gathered block at once.
         sample.resize(newSize);
-        for (size_t i = 0; i < m; ++i)
+        arma::uvec sampleIndices(m);
+        for (size_t j = 0; j < m; ++j)
         {
-          // Sample and evaluate random points from the reference node.
           size_t randomPoint;
           if (alreadyDidRefPoint0)
             randomPoint = math::RandInt(1, refNumDesc);
           else
             randomPoint = math::RandInt(0, refNumDesc);
 
-          sample(oldSize + i) =
-              EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
+          sampleIndices(j) = referenceNode.Descendant(randomPoint);
         }
+        arma::vec kernelValues;
+        EvaluateKernelBatch(queryIndex, sampleIndices, kernelValues);
+        sample.subvec(oldSize, newSize - 1) = kernelValues;
+
         meanSample = arma::mean(sample);
         const double stddev = arma::stddev(sample);
         const double mThreshBase =
@@ -511,6 +541,9 @@ Score(TreeType& queryNode, TreeType& referenceNode)
   }
 
   ++scores;
+  travStats.CountScore();
+  if (score == DBL_MAX)
+    travStats.CountScorePrune();
   traversalInfo.LastQueryNode() = &queryNode;
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
@@ -518,8 +551,11 @@ Score(TreeType& queryNode, TreeType& referenceNode)
 }
 
 //! Dual-tree rescore.
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+inline force_inline double KDERules<MetricType, KernelType, TreeType, StatsType>::
 Rescore(TreeType& /*queryNode*/,
         TreeType& /*referenceNode*/,
         const double oldScore) const
@@ -528,8 +564,11 @@ Rescore(TreeType& /*queryNode*/,
   return oldScore;
 }
 
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+inline force_inline double KDERules<MetricType, KernelType, TreeType, StatsType>::
 EvaluateKernel(const size_t queryIndex,
                const size_t referenceIndex) const
 {
@@ -537,15 +576,53 @@ EvaluateKernel(const size_t queryIndex,
                         referenceSet.unsafe_col(referenceIndex));
 }
 
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+inline force_inline double KDERules<MetricType, KernelType, TreeType, StatsType>::
 EvaluateKernel(const arma::vec& query, const arma::vec& reference) const
 {
   return kernel.Evaluate(metric.Evaluate(query, reference));
 }
 
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+inline void KDERules<MetricType, KernelType, TreeType, StatsType>::
+EvaluateKernelBatch(const size_t queryIndex,
+                    const arma::uvec& referenceIndices,
+                    arma::vec& kernelValues) const
+{
+  // Gather the sampled reference points into one contiguous block so that the
+  // distance computations stream over memory instead of chasing scattered
+  // columns.
+  const arma::mat refBlock = referenceSet.cols(referenceIndices);
+  const arma::vec query = querySet.col(queryIndex);
+
+  kernelValues.set_size(referenceIndices.n_elem);
+  if (metricIsEuclidean)
+  {
+    // All the distances of the batch in one vectorized expression.
+    const arma::rowvec distances =
+        arma::sqrt(arma::sum(arma::square(refBlock.each_col() - query), 0));
+    for (size_t i = 0; i < referenceIndices.n_elem; ++i)
+      kernelValues(i) = kernel.Evaluate(distances(i));
+  }
+  else
+  {
+    for (size_t i = 0; i < referenceIndices.n_elem; ++i)
+      kernelValues(i) = kernel.Evaluate(metric.Evaluate(query,
+          refBlock.unsafe_col(i)));
+  }
+}
+
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename StatsType>
+inline force_inline double KDERules<MetricType, KernelType, TreeType, StatsType>::
 CalculateAlpha(TreeType* node)
 {
   KDEStat& stat = node->Stat();
@@ -573,6 +650,511 @@ CalculateAlpha(TreeType* node)
   return stat.MCAlpha();
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+KDEMultiKernelRules<MetricType, KernelType, TreeType>::KDEMultiKernelRules(
+    const arma::mat& referenceSet,
+    const arma::mat& querySet,
+    arma::mat& densities,
+    const double relError,
+    const double absError,
+    MetricType& metric,
+    std::vector<KernelType>& kernels,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    densities(densities),
+    absError(absError),
+    relError(relError),
+    metric(metric),
+    kernels(kernels),
+    sameSet(sameSet),
+    absErrorTol(absError / referenceSet.n_cols),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  maxKernels.set_size(kernels.size());
+  minKernels.set_size(kernels.size());
+}
+
+//! The multi-kernel base case.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiKernelRules<MetricType, KernelType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // If reference and query sets are the same we don't want to compute the
+  // estimation of a point with itself.
+  if (sameSet && (queryIndex == referenceIndex))
+    return 0.0;
+
+  // Avoid duplicated calculations.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0;
+
+  // The distance is computed once and every kernel is applied to it.
+  const double distance = metric.Evaluate(querySet.col(queryIndex),
+                                          referenceSet.col(referenceIndex));
+  for (size_t b = 0; b < kernels.size(); ++b)
+    densities(b, queryIndex) += kernels[b].Evaluate(distance);
+
+  ++baseCases;
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+  traversalInfo.LastBaseCase() = distance;
+  return distance;
+}
+
+//! Multi-kernel single-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiKernelRules<MetricType, KernelType, TreeType>::
+Score(const size_t queryIndex, TreeType& referenceNode)
+{
+  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      lastQueryIndex == queryIndex &&
+      traversalInfo.LastReferenceNode() != NULL &&
+      lastReferenceIndex == referenceNode.Point(0))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    const double furthestDescDist = referenceNode.FurthestDescendantDistance();
+    minDistance = std::max(traversalInfo.LastBaseCase() - furthestDescDist,
+        0.0);
+    maxDistance = traversalInfo.LastBaseCase() + furthestDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = referenceNode.RangeDistance(queryPoint);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+
+    // Check if we are a self-child.
+    if (tree::TreeTraits<TreeType>::HasSelfChildren &&
+        referenceNode.Parent() != NULL &&
+        referenceNode.Parent()->Point(0) == referenceNode.Point(0))
+    {
+      alreadyDidRefPoint0 = true;
+    }
+  }
+
+  if (CanPruneAllKernels(minDistance, maxDistance))
+  {
+    // Every bandwidth can absorb the approximation error of this node, so
+    // each one adds its own midpoint estimate.
+    for (size_t b = 0; b < kernels.size(); ++b)
+    {
+      const double kernelValue = (maxKernels(b) + minKernels(b)) / 2.0;
+
+      if (alreadyDidRefPoint0)
+        densities(b, queryIndex) += (refNumDesc - 1) * kernelValue;
+      else
+        densities(b, queryIndex) += refNumDesc * kernelValue;
+    }
+
+    // Don't explore this tree branch.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiKernelRules<MetricType, KernelType, TreeType>::
+Rescore(const size_t /* queryIndex */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If it's pruned it continues to be pruned.
+  return oldScore;
+}
+
+//! Multi-kernel dual-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiKernelRules<MetricType, KernelType, TreeType>::
+Score(TreeType& queryNode, TreeType& referenceNode)
+{
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      (traversalInfo.LastQueryNode() != NULL) &&
+      (traversalInfo.LastReferenceNode() != NULL) &&
+      (traversalInfo.LastQueryNode()->Point(0) == queryNode.Point(0)) &&
+      (traversalInfo.LastReferenceNode()->Point(0) == referenceNode.Point(0)))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    lastQueryIndex = queryNode.Point(0);
+    lastReferenceIndex = referenceNode.Point(0);
+
+    // Calculate min and max distance.
+    const double refFurtDescDist = referenceNode.FurthestDescendantDistance();
+    const double queryFurtDescDist = queryNode.FurthestDescendantDistance();
+    const double sumFurtDescDist = refFurtDescDist + queryFurtDescDist;
+    minDistance = std::max(traversalInfo.LastBaseCase() - sumFurtDescDist, 0.0);
+    maxDistance = traversalInfo.LastBaseCase() + sumFurtDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = queryNode.RangeDistance(referenceNode);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+  }
+
+  if (CanPruneAllKernels(minDistance, maxDistance))
+  {
+    // Every bandwidth can absorb the approximation error of this node
+    // combination, so each one adds its own midpoint estimate.
+    for (size_t b = 0; b < kernels.size(); ++b)
+    {
+      const double kernelValue = (maxKernels(b) + minKernels(b)) / 2.0;
+
+      for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+      {
+        if (alreadyDidRefPoint0 && i == 0)
+          densities(b, queryNode.Descendant(i)) += (refNumDesc - 1) *
+              kernelValue;
+        else
+          densities(b, queryNode.Descendant(i)) += refNumDesc * kernelValue;
+      }
+    }
+
+    // Prune.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+//! Multi-kernel dual-tree rescore.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiKernelRules<MetricType, KernelType, TreeType>::
+Rescore(TreeType& /* queryNode */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If a branch is pruned then it continues to be pruned.
+  return oldScore;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+bool KDEMultiKernelRules<MetricType, KernelType, TreeType>::
+CanPruneAllKernels(const double minDistance, const double maxDistance)
+{
+  // Take the per-bandwidth prune decisions from the shared distance bounds.
+  // The kernel values are kept in the scratch vectors so that a successful
+  // prune can reuse them for the estimations.
+  bool canPrune = true;
+  for (size_t b = 0; b < kernels.size(); ++b)
+  {
+    maxKernels(b) = kernels[b].Evaluate(minDistance);
+    minKernels(b) = kernels[b].Evaluate(maxDistance);
+    const double bound = maxKernels(b) - minKernels(b);
+
+    // Error tolerance of this bandwidth for the current node combination.
+    const double errorTolerance = absErrorTol + relError * minKernels(b);
+
+    if (bound > 2 * errorTolerance)
+    {
+      canPrune = false;
+      break;
+    }
+  }
+
+  return canPrune;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+KDEWeightedSumRules<MetricType, KernelType, TreeType>::KDEWeightedSumRules(
+    const arma::mat& referenceSet,
+    const arma::mat& querySet,
+    const arma::mat& weights,
+    arma::mat& sums,
+    const double relError,
+    const double absError,
+    MetricType& metric,
+    KernelType& kernel,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    weights(weights),
+    sums(sums),
+    absError(absError),
+    relError(relError),
+    metric(metric),
+    kernel(kernel),
+    sameSet(sameSet),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // The absolute error tolerance is distributed over the weight mass instead
+  // of the number of reference points; the row with the largest mass is the
+  // binding one.
+  const double totalAbsWeight = arma::sum(arma::abs(weights), 1).max();
+  absErrorTol = (totalAbsWeight > 0) ? absError / totalAbsWeight : 0;
+}
+
+//! The weighted summation base case.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEWeightedSumRules<MetricType, KernelType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // If reference and query sets are the same we don't want to compute the
+  // contribution of a point to itself.
+  if (sameSet && (queryIndex == referenceIndex))
+    return 0.0;
+
+  // Avoid duplicated calculations.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0;
+
+  // Calculations.
+  const double distance = metric.Evaluate(querySet.col(queryIndex),
+                                          referenceSet.col(referenceIndex));
+  sums.col(queryIndex) += weights.col(referenceIndex) *
+      kernel.Evaluate(distance);
+
+  ++baseCases;
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+  traversalInfo.LastBaseCase() = distance;
+  return distance;
+}
+
+//! Weighted summation single-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEWeightedSumRules<MetricType, KernelType, TreeType>::
+Score(const size_t queryIndex, TreeType& referenceNode)
+{
+  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      lastQueryIndex == queryIndex &&
+      traversalInfo.LastReferenceNode() != NULL &&
+      lastReferenceIndex == referenceNode.Point(0))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    const double furthestDescDist = referenceNode.FurthestDescendantDistance();
+    minDistance = std::max(traversalInfo.LastBaseCase() - furthestDescDist,
+        0.0);
+    maxDistance = traversalInfo.LastBaseCase() + furthestDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = referenceNode.RangeDistance(queryPoint);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+
+    // Check if we are a self-child.
+    if (tree::TreeTraits<TreeType>::HasSelfChildren &&
+        referenceNode.Parent() != NULL &&
+        referenceNode.Parent()->Point(0) == referenceNode.Point(0))
+    {
+      alreadyDidRefPoint0 = true;
+    }
+  }
+
+  const double maxKernel = kernel.Evaluate(minDistance);
+  const double minKernel = kernel.Evaluate(maxDistance);
+  const double bound = maxKernel - minKernel;
+
+  // Error tolerance per unit of weight for the current combination of query
+  // point and reference node.
+  const double errorTolerance = absErrorTol + relError * minKernel;
+
+  if (bound <= 2 * errorTolerance)
+  {
+    // Every descendant's contribution is approximated by the midpoint kernel
+    // value, so the node contributes its weight sum at that value.
+    const double kernelValue = (maxKernel + minKernel) / 2.0;
+
+    if (alreadyDidRefPoint0)
+    {
+      sums.col(queryIndex) += (NodeWeightSums(referenceNode) -
+          weights.col(referenceNode.Point(0))) * kernelValue;
+    }
+    else
+    {
+      sums.col(queryIndex) += NodeWeightSums(referenceNode) * kernelValue;
+    }
+
+    // Don't explore this tree branch.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEWeightedSumRules<MetricType, KernelType, TreeType>::
+Rescore(const size_t /* queryIndex */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If it's pruned it continues to be pruned.
+  return oldScore;
+}
+
+//! Weighted summation dual-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEWeightedSumRules<MetricType, KernelType, TreeType>::
+Score(TreeType& queryNode, TreeType& referenceNode)
+{
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      (traversalInfo.LastQueryNode() != NULL) &&
+      (traversalInfo.LastReferenceNode() != NULL) &&
+      (traversalInfo.LastQueryNode()->Point(0) == queryNode.Point(0)) &&
+      (traversalInfo.LastReferenceNode()->Point(0) == referenceNode.Point(0)))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    lastQueryIndex = queryNode.Point(0);
+    lastReferenceIndex = referenceNode.Point(0);
+
+    // Calculate min and max distance.
+    const double refFurtDescDist = referenceNode.FurthestDescendantDistance();
+    const double queryFurtDescDist = queryNode.FurthestDescendantDistance();
+    const double sumFurtDescDist = refFurtDescDist + queryFurtDescDist;
+    minDistance = std::max(traversalInfo.LastBaseCase() - sumFurtDescDist, 0.0);
+    maxDistance = traversalInfo.LastBaseCase() + sumFurtDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = queryNode.RangeDistance(referenceNode);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+  }
+
+  const double maxKernel = kernel.Evaluate(minDistance);
+  const double minKernel = kernel.Evaluate(maxDistance);
+  const double bound = maxKernel - minKernel;
+
+  // Error tolerance per unit of weight for the current combination of query
+  // node and reference node.
+  const double errorTolerance = absErrorTol + relError * minKernel;
+
+  if (bound <= 2 * errorTolerance)
+  {
+    // Every descendant's contribution is approximated by the midpoint kernel
+    // value, so the node contributes its weight sum at that value to every
+    // query descendant.
+    const double kernelValue = (maxKernel + minKernel) / 2.0;
+    const arma::vec& nodeWeights = NodeWeightSums(referenceNode);
+
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    {
+      if (alreadyDidRefPoint0 && i == 0)
+      {
+        sums.col(queryNode.Descendant(i)) += (nodeWeights -
+            weights.col(referenceNode.Point(0))) * kernelValue;
+      }
+      else
+      {
+        sums.col(queryNode.Descendant(i)) += nodeWeights * kernelValue;
+      }
+    }
+
+    // Prune.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+//! Weighted summation dual-tree rescore.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEWeightedSumRules<MetricType, KernelType, TreeType>::
+Rescore(TreeType& /* queryNode */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If a branch is pruned then it continues to be pruned.
+  return oldScore;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline const arma::vec&
+KDEWeightedSumRules<MetricType, KernelType, TreeType>::
+NodeWeightSums(TreeType& node)
+{
+  // The sums are computed on the first visit of a node and cached for the
+  // rest of the traversal.
+  auto it = nodeWeightSums.find(&node);
+  if (it != nodeWeightSums.end())
+    return it->second;
+
+  arma::vec nodeSums(weights.n_rows, arma::fill::zeros);
+  for (size_t i = 0; i < node.NumDescendants(); ++i)
+    nodeSums += weights.col(node.Descendant(i));
+
+  return nodeWeightSums.emplace(&node, std::move(nodeSums)).first->second;
+}
+
 //! Clean rules base case.
 template<typename TreeType>
 inline force_inline
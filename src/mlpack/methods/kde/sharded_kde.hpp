@@ -0,0 +1,153 @@
+/**
+ * @file methods/kde/sharded_kde.hpp
+ * @author Ryan Curtin
+ *
+ * A sharded KDE engine with a bounds-aware two-phase reduction.  The
+ * reference set is partitioned into shards, each with its own KDE engine; a
+ * cheap first pass computes per-shard density bounds for every block of query
+ * points from box-to-box distances, and each shard then runs full-accuracy
+ * evaluation only for the query blocks where its contribution can still
+ * affect the requested relative error.  This replaces ad-hoc external
+ * sharding and result summing with a single API whose per-shard layout
+ * matches one-engine-per-node distributed deployments.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_SHARDED_KDE_HPP
+#define MLPACK_METHODS_KDE_SHARDED_KDE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+
+#include "kde.hpp"
+
+namespace mlpack {
+namespace kde {
+
+/**
+ * The ShardedKDE class performs kernel density estimation over a reference
+ * set that is split into contiguous shards, each indexed by its own KDE
+ * engine, and sums the per-shard contributions into one estimate per query
+ * point.
+ *
+ * Instead of every shard doing full-accuracy work, Evaluate() runs in two
+ * phases.  First, for every block of query points and every shard, the
+ * smallest and largest possible kernel value is computed from the minimum and
+ * maximum distance between the block's bounding box and the shard's bounding
+ * box; these give lower and upper bounds on each shard's contribution to the
+ * density of every point in the block.  Second, a shard only evaluates a
+ * block exactly when the width of its contribution interval exceeds that
+ * block's share of the error budget; otherwise the interval's midpoint is
+ * added instead.  Half of the requested relative error tolerance is spent on
+ * these skipped contributions and the other half is passed to the per-shard
+ * engines, so the summed estimate still honors the requested tolerance
+ * (relative to the lower bound of the true density).
+ *
+ * The kernel is assumed to be monotonically decreasing in the distance, the
+ * same assumption the tree-based KDE bounds already make.
+ *
+ * @tparam KernelType Kernel function to use for KDE calculations.
+ * @tparam MetricType Metric to use for KDE calculations; must be an LMetric,
+ *     since bounding boxes are used for the cross-shard bounds.
+ * @tparam MatType Type of data matrix.
+ * @tparam TreeType Type of tree to use for the per-shard engines; must
+ *     satisfy the TreeType policy API.
+ */
+template<typename KernelType = kernel::GaussianKernel,
+         typename MetricType = mlpack::metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class ShardedKDE
+{
+ public:
+  //! Convenience typedef for the per-shard KDE engine.
+  typedef KDE<KernelType, MetricType, MatType, TreeType> KDEType;
+  //! The element type of the data.
+  typedef typename MatType::elem_type ElemType;
+  //! Convenience typedef for the bounding boxes used in the bounds pass.
+  typedef bound::HRectBound<MetricType, ElemType> BoundType;
+
+  /**
+   * Initialize the ShardedKDE object with the given reference set, splitting
+   * it into the given number of contiguous shards and training one KDE
+   * engine per shard.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numShards Number of shards to split the reference set into.
+   * @param relError Maximum relative error tolerance of the summed estimate
+   *     for each query point (relative to the lower bound of the density).
+   * @param kernel Instantiated kernel object.
+   * @param blockSize Number of consecutive query points that share one set
+   *     of per-shard bounds in Evaluate().
+   * @param metric Instantiated metric object.
+   */
+  ShardedKDE(MatType referenceSet,
+             const size_t numShards,
+             const double relError = KDEDefaultParams::relError,
+             KernelType kernel = KernelType(),
+             const size_t blockSize = 64,
+             MetricType metric = MetricType());
+
+  /**
+   * Estimate the density of each point in the query set against the full
+   * reference set, using the two-phase bounds-aware reduction over the
+   * shards.  The estimates use the same normalization as a single KDE engine
+   * trained on the whole reference set.
+   *
+   * @param querySet Set of query points.
+   * @param estimations Vector to store the density estimate of each query
+   *     point in.
+   */
+  void Evaluate(const MatType& querySet, arma::vec& estimations);
+
+  //! Return the number of shards.
+  size_t NumShards() const { return shards.size(); }
+  //! Return the given shard's KDE engine.
+  const KDEType& Shard(const size_t i) const { return shards[i]; }
+  //! Return the relative error tolerance of the summed estimates.
+  double RelativeError() const { return relError; }
+  //! Return the number of query points that share one set of bounds.
+  size_t BlockSize() const { return blockSize; }
+
+  //! Return how many (shard, block) pairs the last Evaluate() call refined
+  //! with a full-accuracy evaluation.
+  size_t RefinedPairs() const { return refinedPairs; }
+  //! Return how many (shard, block) pairs the last Evaluate() call settled
+  //! from the bounds alone.
+  size_t SkippedPairs() const { return skippedPairs; }
+
+ private:
+  //! The per-shard KDE engines.
+  std::vector<KDEType> shards;
+  //! The number of reference points in each shard.
+  std::vector<size_t> shardSizes;
+  //! The bounding box of each shard's reference points.
+  std::vector<BoundType> shardBounds;
+  //! Total number of reference points across all shards.
+  size_t totalPoints;
+
+  //! Instantiated kernel, used for the bounds pass.
+  KernelType kernel;
+  //! Relative error tolerance of the summed estimates.
+  double relError;
+  //! Number of consecutive query points that share one set of bounds.
+  size_t blockSize;
+
+  //! Number of (shard, block) pairs refined by the last Evaluate() call.
+  size_t refinedPairs;
+  //! Number of (shard, block) pairs skipped by the last Evaluate() call.
+  size_t skippedPairs;
+};
+
+} // namespace kde
+} // namespace mlpack
+
+// Include implementation.
+#include "sharded_kde_impl.hpp"
+
+#endif // MLPACK_METHODS_KDE_SHARDED_KDE_HPP
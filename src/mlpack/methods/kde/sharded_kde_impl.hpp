@@ -0,0 +1,180 @@
+/**
+ * @file methods/kde/sharded_kde_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the ShardedKDE class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_SHARDED_KDE_IMPL_HPP
+#define MLPACK_METHODS_KDE_SHARDED_KDE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sharded_kde.hpp"
+
+namespace mlpack {
+namespace kde {
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+ShardedKDE<KernelType, MetricType, MatType, TreeType>::ShardedKDE(
+    MatType referenceSet,
+    const size_t numShards,
+    const double relError,
+    KernelType kernel,
+    const size_t blockSize,
+    MetricType metric) :
+    totalPoints(referenceSet.n_cols),
+    kernel(kernel),
+    relError(relError),
+    blockSize(std::max(blockSize, (size_t) 1)),
+    refinedPairs(0),
+    skippedPairs(0)
+{
+  if (numShards == 0)
+  {
+    throw std::invalid_argument("ShardedKDE(): number of shards must be "
+        "greater than zero!");
+  }
+  if (referenceSet.n_cols == 0)
+  {
+    throw std::invalid_argument("ShardedKDE(): cannot shard an empty "
+        "reference set!");
+  }
+
+  // No shard may be empty, so never use more shards than points.
+  const size_t shardCount = std::min(numShards, (size_t) referenceSet.n_cols);
+
+  shards.reserve(shardCount);
+  shardSizes.reserve(shardCount);
+  shardBounds.reserve(shardCount);
+  for (size_t i = 0; i < shardCount; ++i)
+  {
+    const size_t begin = (referenceSet.n_cols * i) / shardCount;
+    const size_t end = (referenceSet.n_cols * (i + 1)) / shardCount;
+    MatType shardData = referenceSet.cols(begin, end - 1);
+
+    shardSizes.push_back(end - begin);
+    BoundType bound(referenceSet.n_rows);
+    bound |= shardData;
+    shardBounds.push_back(std::move(bound));
+
+    // Half of the error budget is spent on the skipped contributions, so the
+    // per-shard engines get the other half.
+    shards.emplace_back(relError / 2.0, 0.0, kernel, KDEDefaultParams::mode,
+        metric);
+    shards.back().Train(std::move(shardData));
+  }
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedKDE<KernelType, MetricType, MatType, TreeType>::Evaluate(
+    const MatType& querySet,
+    arma::vec& estimations)
+{
+  estimations.zeros(querySet.n_cols);
+  refinedPairs = 0;
+  skippedPairs = 0;
+
+  if (querySet.n_cols == 0)
+    return;
+
+  const size_t numShards = shards.size();
+  const size_t numBlocks = (querySet.n_cols + blockSize - 1) / blockSize;
+
+  // Phase one: bound every shard's contribution to every query block from
+  // the distances between the block's and the shard's bounding boxes.  For a
+  // monotonically decreasing kernel, the kernel value of the minimum
+  // (maximum) distance bounds each reference point's contribution from above
+  // (below).
+  arma::mat upperContrib(numShards, numBlocks);
+  arma::mat lowerContrib(numShards, numBlocks);
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+
+    BoundType blockBound(querySet.n_rows);
+    blockBound |= querySet.cols(begin, end - 1);
+
+    for (size_t j = 0; j < numShards; ++j)
+    {
+      upperContrib(j, b) = shardSizes[j] *
+          kernel.Evaluate(shardBounds[j].MinDistance(blockBound));
+      lowerContrib(j, b) = shardSizes[j] *
+          kernel.Evaluate(shardBounds[j].MaxDistance(blockBound));
+    }
+  }
+
+  // The density of any point in a block is at least the sum of the shard
+  // lower bounds; the skipped-contribution budget of each block is relative
+  // to that.
+  const arma::rowvec totalLower = arma::sum(lowerContrib, 0);
+
+  // Phase two: each shard evaluates only the blocks whose contribution
+  // interval is too wide to settle from the bounds; for all other blocks the
+  // interval midpoint is added.  Every skipped pair contributes at most
+  // (relError / 2) * totalLower / numShards of error, so the skipped error
+  // across all shards stays within half of the tolerance.
+  std::vector<size_t> refinedQueries;
+  for (size_t j = 0; j < numShards; ++j)
+  {
+    refinedQueries.clear();
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) querySet.n_cols);
+
+      const double halfWidth = (upperContrib(j, b) - lowerContrib(j, b)) / 2;
+      const double budget = (relError / 2.0) * totalLower(b) / numShards;
+      if (halfWidth <= budget)
+      {
+        const double midpoint = (upperContrib(j, b) + lowerContrib(j, b)) / 2;
+        for (size_t i = begin; i < end; ++i)
+          estimations[i] += midpoint / totalPoints;
+        ++skippedPairs;
+      }
+      else
+      {
+        for (size_t i = begin; i < end; ++i)
+          refinedQueries.push_back(i);
+        ++refinedPairs;
+      }
+    }
+
+    if (refinedQueries.empty())
+      continue;
+
+    // Gather the refined queries of this shard into one evaluation call.
+    const arma::uvec queryIndices = arma::conv_to<arma::uvec>::from(
+        refinedQueries);
+    MatType shardQueries = querySet.cols(queryIndices);
+
+    arma::vec shardEstimations;
+    shards[j].Evaluate(std::move(shardQueries), shardEstimations);
+
+    // Per-shard estimates are normalized by the shard size; rescale them to
+    // the normalization of the full reference set.
+    const double scale = (double) shardSizes[j] / (double) totalPoints;
+    for (size_t i = 0; i < queryIndices.n_elem; ++i)
+      estimations[queryIndices[i]] += scale * shardEstimations[i];
+  }
+}
+
+} // namespace kde
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_KDE_SHARDED_KDE_IMPL_HPP
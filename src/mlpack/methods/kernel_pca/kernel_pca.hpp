@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/naive_method.hpp>
+#include <mlpack/methods/nystroem_method/kmeans_selection.hpp>
 
 namespace mlpack {
 namespace kpca {
@@ -106,6 +107,47 @@ class KernelPCA
    */
   void Apply(arma::mat& data, const size_t newDimension);
 
+  /**
+   * Compress the kernel expansion into a reduced set of representative
+   * points.  After Apply(), projecting a new point requires one kernel
+   * evaluation per training point; this selects a budgeted number of landmark
+   * points with the given Nystroem point selection policy and fits the given
+   * transformed output on their kernel features by least squares, so that
+   * Transform() only needs `budget` kernel evaluations per point.  An
+   * appended constant feature absorbs the pseudo-centering terms of the full
+   * expansion.
+   *
+   * The returned value is the relative projection error of the reduced
+   * expansion over the training set: the Frobenius norm of the residual
+   * divided by the Frobenius norm of the given transformed data.
+   *
+   * @tparam PointSelectionPolicy The policy used to select the landmark
+   *     points; see the NystroemMethod documentation.
+   * @param data Data matrix that was passed to Apply().
+   * @param transformedData Transformed output that Apply() produced for that
+   *     data matrix.
+   * @param budget Maximum number of representative points to keep.
+   * @return Relative projection error of the reduced expansion on the data.
+   */
+  template<typename PointSelectionPolicy = kernel::KMeansSelection<>>
+  double BuildReducedSet(const arma::mat& data,
+                         const arma::mat& transformedData,
+                         const size_t budget);
+
+  /**
+   * Project new points with the reduced kernel expansion built by
+   * BuildReducedSet().  Each point costs one kernel evaluation per
+   * representative point instead of one per training point.
+   *
+   * @param newData Points to project (one point per column).
+   * @param transformedData Matrix to output the projected points into.
+   */
+  void Transform(const arma::mat& newData, arma::mat& transformedData);
+
+  //! Get the representative points of the reduced expansion (one point per
+  //! column); empty if BuildReducedSet() has not been called.
+  const arma::mat& ReducedPoints() const { return reducedPoints; }
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
   //! Modify the kernel.
@@ -117,11 +159,30 @@ class KernelPCA
   bool& CenterTransformedData() { return centerTransformedData; }
 
  private:
+  /**
+   * Store the landmark points produced by a point selection policy that
+   * returns a materialized matrix (which must be freed).
+   */
+  void SetReducedPoints(const arma::mat& data, const arma::mat* selectedData);
+
+  /**
+   * Store the landmark points produced by a point selection policy that
+   * returns point indices.
+   */
+  void SetReducedPoints(const arma::mat& data,
+                        const arma::Col<size_t>& selectedPoints);
+
   //! The instantiated kernel.
   KernelType kernel;
   //! If true, the data will be scaled (by standard deviation) when Apply() is
   //! run.
   bool centerTransformedData;
+  //! The representative points of the reduced expansion, if one was built.
+  arma::mat reducedPoints;
+  //! Kernel feature coefficients of the reduced expansion.
+  arma::mat reducedCoefficients;
+  //! Per-component offsets of the reduced expansion.
+  arma::vec reducedOffsets;
 }; // class KernelPCA
 
 } // namespace kpca
@@ -17,6 +17,8 @@
 // In case it hasn't already been included.
 #include "kernel_pca.hpp"
 
+#include <mlpack/core/kernels/gram_matrix.hpp>
+
 namespace mlpack {
 namespace kpca {
 
@@ -81,6 +83,97 @@ void KernelPCA<KernelType, KernelRule>::Apply(arma::mat& data,
     data.shed_rows(newDimension, data.n_rows - 1);
 }
 
+//! Compress the kernel expansion into a reduced set of representative points.
+template <typename KernelType, typename KernelRule>
+template <typename PointSelectionPolicy>
+double KernelPCA<KernelType, KernelRule>::BuildReducedSet(
+    const arma::mat& data,
+    const arma::mat& transformedData,
+    const size_t budget)
+{
+  if (budget == 0)
+  {
+    Log::Fatal << "KernelPCA::BuildReducedSet(): budget must be greater than "
+        << "0!" << std::endl;
+  }
+
+  if (transformedData.n_cols != data.n_cols)
+  {
+    Log::Fatal << "KernelPCA::BuildReducedSet(): the transformed data has "
+        << transformedData.n_cols << " points but the data matrix has "
+        << data.n_cols << " points; pass the output of Apply() for the same "
+        << "data!" << std::endl;
+  }
+
+  // Never keep more representative points than there are points.
+  const size_t numPoints = std::min(budget, (size_t) data.n_cols);
+  SetReducedPoints(data, PointSelectionPolicy::Select(data, numPoints));
+
+  // Kernel features of every training point against the representatives.
+  arma::mat semiKernel;
+  kernel::ComputeKernelMatrix(data, reducedPoints, semiKernel, kernel);
+
+  // Fit the transformed output on the representative kernel features by least
+  // squares; the appended constant feature absorbs the pseudo-centering terms
+  // of the full expansion.
+  arma::mat features = arma::join_rows(semiKernel,
+      arma::ones<arma::mat>(data.n_cols, 1));
+  arma::mat coefficients;
+  if (!arma::solve(coefficients, features, arma::trans(transformedData)))
+  {
+    Log::Fatal << "KernelPCA::BuildReducedSet(): least-squares fit of the "
+        << "reduced expansion failed!" << std::endl;
+  }
+
+  reducedCoefficients = coefficients.rows(0, numPoints - 1);
+  reducedOffsets = arma::vectorise(coefficients.row(numPoints));
+
+  // Report the relative projection error of the reduced expansion on the
+  // training set.
+  const double referenceNorm = arma::norm(transformedData, "fro");
+  const double residualNorm = arma::norm(features * coefficients -
+      arma::trans(transformedData), "fro");
+  return (referenceNorm > 0.0) ? (residualNorm / referenceNorm) : 0.0;
+}
+
+//! Project new points with the reduced kernel expansion.
+template <typename KernelType, typename KernelRule>
+void KernelPCA<KernelType, KernelRule>::Transform(const arma::mat& newData,
+                                                  arma::mat& transformedData)
+{
+  if (reducedPoints.n_cols == 0)
+  {
+    Log::Fatal << "KernelPCA::Transform(): no reduced set has been built; "
+        << "call BuildReducedSet() first!" << std::endl;
+  }
+
+  // Each point needs only one kernel evaluation per representative point.
+  arma::mat semiKernel;
+  kernel::ComputeKernelMatrix(newData, reducedPoints, semiKernel, kernel);
+
+  transformedData = arma::trans(semiKernel * reducedCoefficients);
+  transformedData.each_col() += reducedOffsets;
+}
+
+template <typename KernelType, typename KernelRule>
+void KernelPCA<KernelType, KernelRule>::SetReducedPoints(
+    const arma::mat& /* data */,
+    const arma::mat* selectedData)
+{
+  reducedPoints = *selectedData;
+
+  // Clean the memory, as the selection policy expects.
+  delete selectedData;
+}
+
+template <typename KernelType, typename KernelRule>
+void KernelPCA<KernelType, KernelRule>::SetReducedPoints(
+    const arma::mat& data,
+    const arma::Col<size_t>& selectedPoints)
+{
+  reducedPoints = data.cols(arma::conv_to<arma::uvec>::from(selectedPoints));
+}
+
 } // namespace kpca
 } // namespace mlpack
 
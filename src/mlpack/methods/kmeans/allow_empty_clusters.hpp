@@ -49,8 +49,8 @@ class AllowEmptyClusters
   static inline force_inline void EmptyCluster(
       const MatType& /* data */,
       const size_t emptyCluster,
-      const arma::mat& oldCentroids,
-      arma::mat& newCentroids,
+      const arma::Mat<typename MatType::elem_type>& oldCentroids,
+      arma::Mat<typename MatType::elem_type>& newCentroids,
       arma::Col<size_t>& /* clusterCounts */,
       MetricType& /* metric */,
       const size_t /* iteration */)
@@ -330,15 +330,63 @@ visited[node.Descendant(i)] << ".\n";
     node.Stat().LowerBound() -= clusterDistances[centroids.n_cols];
   }
 
+  // If this node was pruned last iteration, its entire subtree was pruned
+  // with it, and the adjusted bounds keep it pruned this iteration, then no
+  // owner below it can change: skip descending into the subtree entirely.
+  // The movement of this iteration is accumulated as pending, and pushed
+  // down to the children when the subtree is next inspected.
+  if (prunedLastIteration && node.Stat().StaticPruned() &&
+      node.Stat().SubtreePruned())
+  {
+    node.Stat().StaticUpperBoundMovement() +=
+        clusterDistances[node.Stat().Owner()];
+    node.Stat().StaticLowerBoundMovement() +=
+        clusterDistances[centroids.n_cols];
+    node.Stat().PendingUpperMovement() +=
+        clusterDistances[node.Stat().Owner()];
+    node.Stat().PendingLowerMovement() +=
+        clusterDistances[centroids.n_cols];
+    return;
+  }
+
+  // If descent below this node was skipped in earlier iterations, the
+  // movement of those iterations has not reached the children yet; apply it
+  // before recursing.  (Every node below a subtree-pruned node is itself
+  // statically pruned, so the stale bounds are all of the pruned kind.)
+  if (node.Stat().PendingUpperMovement() > 0.0 ||
+      node.Stat().PendingLowerMovement() > 0.0)
+  {
+    for (size_t i = 0; i < node.NumChildren(); ++i)
+    {
+      node.Child(i).Stat().UpperBound() +=
+          node.Stat().PendingUpperMovement();
+      node.Child(i).Stat().LowerBound() -=
+          node.Stat().PendingLowerMovement();
+      node.Child(i).Stat().StaticUpperBoundMovement() +=
+          node.Stat().PendingUpperMovement();
+      node.Child(i).Stat().StaticLowerBoundMovement() +=
+          node.Stat().PendingLowerMovement();
+      node.Child(i).Stat().PendingUpperMovement() +=
+          node.Stat().PendingUpperMovement();
+      node.Child(i).Stat().PendingLowerMovement() +=
+          node.Stat().PendingLowerMovement();
+    }
+    node.Stat().PendingUpperMovement() = 0.0;
+    node.Stat().PendingLowerMovement() = 0.0;
+  }
+
   // Recurse into children, and if all the children (and all the points) are
   // pruned, then we can mark this as statically pruned.
   bool allChildrenPruned = true;
+  bool allChildrenSubtreePruned = true;
   for (size_t i = 0; i < node.NumChildren(); ++i)
   {
     UpdateTree(node.Child(i), centroids, unadjustedUpperBound,
         adjustedUpperBound, unadjustedLowerBound, adjustedLowerBound);
     if (!node.Child(i).Stat().StaticPruned())
       allChildrenPruned = false;
+    if (!node.Child(i).Stat().SubtreePruned())
+      allChildrenSubtreePruned = false;
   }
 
   bool allPointsPruned = true;
@@ -461,6 +509,11 @@ visited[node.Descendant(i)] << ".\n";
           clusterDistances[centroids.n_cols];
     }
   }
+
+  // Remember whether everything below this node is pruned, so that later
+  // iterations can skip descending into the subtree while it stays pruned.
+  node.Stat().SubtreePruned() = node.Stat().StaticPruned() &&
+      allChildrenSubtreePruned;
 }
 
 template<typename MetricType,
@@ -615,8 +668,13 @@ void DualTreeKMeans<MetricType, MatType, TreeType>::DecoalesceTree(Tree& node)
   node.Parent() = (Tree*) node.Stat().TrueParent();
   RestoreChildren(node);
 
+  // Statically pruned children were hidden rather than coalesced, so their
+  // subtrees were never modified and do not need to be restored.
   for (size_t i = 0; i < node.NumChildren(); ++i)
-    DecoalesceTree(node.Child(i));
+  {
+    if (!node.Child(i).Stat().StaticPruned())
+      DecoalesceTree(node.Child(i));
+  }
 }
 
 //! Utility function for hiding children in a non-binary tree.
@@ -28,8 +28,11 @@ class DualTreeKMeansStatistic : public
       owner(size_t(-1)),
       pruned(size_t(-1)),
       staticPruned(false),
+      subtreePruned(false),
       staticUpperBoundMovement(0.0),
       staticLowerBoundMovement(0.0),
+      pendingUpperMovement(0.0),
+      pendingLowerMovement(0.0),
       centroid(),
       trueParent(NULL)
   {
@@ -44,8 +47,11 @@ class DualTreeKMeansStatistic : public
       owner(size_t(-1)),
       pruned(size_t(-1)),
       staticPruned(false),
+      subtreePruned(false),
       staticUpperBoundMovement(0.0),
       staticLowerBoundMovement(0.0),
+      pendingUpperMovement(0.0),
+      pendingLowerMovement(0.0),
       trueParent(node.Parent())
   {
     // Empirically calculate the centroid.
@@ -90,12 +96,21 @@ class DualTreeKMeansStatistic : public
   bool StaticPruned() const { return staticPruned; }
   bool& StaticPruned() { return staticPruned; }
 
+  bool SubtreePruned() const { return subtreePruned; }
+  bool& SubtreePruned() { return subtreePruned; }
+
   double StaticUpperBoundMovement() const { return staticUpperBoundMovement; }
   double& StaticUpperBoundMovement() { return staticUpperBoundMovement; }
 
   double StaticLowerBoundMovement() const { return staticLowerBoundMovement; }
   double& StaticLowerBoundMovement() { return staticLowerBoundMovement; }
 
+  double PendingUpperMovement() const { return pendingUpperMovement; }
+  double& PendingUpperMovement() { return pendingUpperMovement; }
+
+  double PendingLowerMovement() const { return pendingLowerMovement; }
+  double& PendingLowerMovement() { return pendingLowerMovement; }
+
   void* TrueParent() const { return trueParent; }
   void*& TrueParent() { return trueParent; }
 
@@ -110,8 +125,15 @@ class DualTreeKMeansStatistic : public
   size_t owner;
   size_t pruned;
   bool staticPruned;
+  //! True if this node and every node below it were statically pruned.
+  bool subtreePruned;
   double staticUpperBoundMovement;
   double staticLowerBoundMovement;
+  //! Centroid movement accumulated while descent below this node was
+  //! skipped; it is pushed down to the children when the subtree is next
+  //! inspected.
+  double pendingUpperMovement;
+  double pendingLowerMovement;
   arma::vec centroid;
   void* trueParent;
   std::vector<void*> trueChildren;
@@ -73,6 +73,9 @@ template<typename MetricType = metric::EuclideanDistance,
 class KMeans
 {
  public:
+  //! The element type of the data (and of the centroids).
+  typedef typename MatType::elem_type ElemType;
+
   /**
    * Create a K-Means object and (optionally) set the parameters which K-Means
    * will be run with.
@@ -125,7 +128,7 @@ class KMeans
    */
   void Cluster(const MatType& data,
                size_t clusters,
-               arma::mat& centroids,
+               arma::Mat<ElemType>& centroids,
                const bool initialGuess = false);
 
   /**
@@ -151,7 +154,7 @@ class KMeans
   void Cluster(const MatType& data,
                const size_t clusters,
                arma::Row<size_t>& assignments,
-               arma::mat& centroids,
+               arma::Mat<ElemType>& centroids,
                const bool initialAssignmentGuess = false,
                const bool initialCentroidGuess = false);
 
@@ -51,7 +51,7 @@ bool GetInitialAssignmentsOrCentroids(
     const MatType& data,
     const size_t clusters,
     arma::Row<size_t>& assignments,
-    arma::mat& /* centroids */,
+    arma::Mat<typename MatType::elem_type>& /* centroids */,
     const typename std::enable_if_t<
         !GivesCentroids<InitialPartitionPolicy>::value>* = 0)
 {
@@ -69,7 +69,7 @@ bool GetInitialAssignmentsOrCentroids(
     const MatType& data,
     const size_t clusters,
     arma::Row<size_t>& /* assignments */,
-    arma::mat& centroids,
+    arma::Mat<typename MatType::elem_type>& centroids,
     const typename std::enable_if_t<
         GivesCentroids<InitialPartitionPolicy>::value>* = 0)
 {
@@ -126,7 +126,7 @@ Cluster(const MatType& data,
         arma::Row<size_t>& assignments,
         const bool initialGuess)
 {
-  arma::mat centroids(data.n_rows, clusters);
+  arma::Mat<ElemType> centroids(data.n_rows, clusters);
   Cluster(data, clusters, assignments, centroids, initialGuess);
 }
 
@@ -147,7 +147,7 @@ void KMeans<
     MatType>::
 Cluster(const MatType& data,
         const size_t clusters,
-        arma::mat& centroids,
+        arma::Mat<ElemType>& centroids,
         const bool initialGuess)
 {
   // Make sure we have more points than clusters.
@@ -192,7 +192,7 @@ Cluster(const MatType& data,
       centroids.zeros(data.n_rows, clusters);
       for (size_t i = 0; i < data.n_cols; ++i)
       {
-        centroids.col(assignments[i]) += arma::vec(data.col(i));
+        centroids.col(assignments[i]) += arma::Col<ElemType>(data.col(i));
         counts[assignments[i]]++;
       }
 
@@ -208,7 +208,7 @@ Cluster(const MatType& data,
   size_t iteration = 0;
 
   LloydStepType<MetricType, MatType> lloydStep(data, metric);
-  arma::mat centroidsOther;
+  arma::Mat<ElemType> centroidsOther;
   double cNorm;
 
   do
@@ -281,7 +281,7 @@ void KMeans<
 Cluster(const MatType& data,
         const size_t clusters,
         arma::Row<size_t>& assignments,
-        arma::mat& centroids,
+        arma::Mat<ElemType>& centroids,
         const bool initialAssignmentGuess,
         const bool initialCentroidGuess)
 {
@@ -299,7 +299,7 @@ Cluster(const MatType& data,
     centroids.zeros(data.n_rows, clusters);
     for (size_t i = 0; i < data.n_cols; ++i)
     {
-      centroids.col(assignments[i]) += arma::vec(data.col(i));
+      centroids.col(assignments[i]) += arma::Col<ElemType>(data.col(i));
       counts[assignments[i]]++;
     }
 
@@ -0,0 +1,285 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ * @author Ryan Curtin
+ *
+ * This file implements the k-means|| (scalable k-means++) initialization
+ * strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This class implements the k-means|| initialization, as described in the
+ * following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, B. and Moseley, B. and Vattani, A. and Kumar, R. and
+ *       Vassilvitskii, S.},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * Where k-means++ makes k sequential passes over the data (one per chosen
+ * center), k-means|| makes only a small constant number of passes: each round
+ * samples roughly 2k candidate centers independently, with each point's
+ * sampling probability proportional to its squared distance from the current
+ * candidate set.  The candidates are then weighted by the number of points
+ * they are closest to, and the weighted candidate set--which is small--is
+ * clustered into the final k centroids.  The distance passes are parallelized
+ * with OpenMP.
+ *
+ * In accordance with mlpack's InitialPartitionPolicy template type, we only
+ * need to implement a constructor and a method to compute the initial
+ * centroids.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  //! Empty constructor, required by the InitialPartitionPolicy type
+  //! definition.
+  KMeansParallelInitialization() { }
+
+  /**
+   * Initialize the centroids matrix using the k-means|| oversampling scheme.
+   *
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  inline static void Cluster(const MatType& data,
+                             const size_t clusters,
+                             arma::mat& centroids)
+  {
+    // Following the paper, we oversample roughly 2k candidates per round, and
+    // a small constant number of rounds is sufficient in practice.
+    const double oversampling = 2.0 * clusters;
+    const size_t rounds = 5;
+
+    // The candidate set, as indices into the dataset.  The first candidate is
+    // sampled uniformly.
+    std::vector<size_t> candidates;
+    candidates.push_back(mlpack::math::RandInt(0, data.n_cols));
+
+    // minDistances[p] holds the squared distance between point p and its
+    // closest candidate.
+    arma::vec minDistances(data.n_cols);
+    UpdateDistances(data, candidates, 0, minDistances, true);
+    double cost = arma::accu(minDistances);
+
+    for (size_t round = 0; round < rounds && cost > 0.0; ++round)
+    {
+      // Sample each point independently with probability proportional to its
+      // squared distance from the candidate set.  The sampling itself is
+      // cheap; the expensive distance update below runs in parallel.
+      const size_t oldSize = candidates.size();
+      for (size_t p = 0; p < data.n_cols; ++p)
+      {
+        if (mlpack::math::Random() < oversampling * minDistances[p] / cost)
+          candidates.push_back(p);
+      }
+
+      UpdateDistances(data, candidates, oldSize, minDistances, false);
+      cost = arma::accu(minDistances);
+    }
+
+    // In the unlikely case that too few candidates were sampled (e.g. tiny
+    // datasets or degenerate duplicated data), fall back to the points
+    // furthest from the candidate set.
+    while (candidates.size() < clusters)
+    {
+      const size_t furthest = (size_t) minDistances.index_max();
+      candidates.push_back(furthest);
+      UpdateDistances(data, candidates, candidates.size() - 1, minDistances,
+          false);
+    }
+
+    // Weight each candidate by the number of points it is closest to.
+    arma::vec weights(candidates.size(), arma::fill::zeros);
+    #pragma omp parallel
+    {
+      arma::vec localWeights(candidates.size(), arma::fill::zeros);
+
+      #pragma omp for
+      for (omp_size_t p = 0; p < (omp_size_t) data.n_cols; ++p)
+      {
+        double minDistance = std::numeric_limits<double>::max();
+        size_t closest = 0;
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+          const double distance =
+              mlpack::metric::SquaredEuclideanDistance::Evaluate(data.col(p),
+              data.col(candidates[i]));
+          if (distance < minDistance)
+          {
+            minDistance = distance;
+            closest = i;
+          }
+        }
+        localWeights[closest] += 1.0;
+      }
+
+      #pragma omp critical(KMeansParallelWeights)
+      {
+        weights += localWeights;
+      }
+    }
+
+    // Gather the candidate set into a dense matrix and recluster it, with
+    // weights, into the final k centroids.  The candidate set has roughly
+    // 2k * rounds points, so this step is cheap.
+    arma::mat candidateSet(data.n_rows, candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i)
+      candidateSet.col(i) = arma::vec(data.col(candidates[i]));
+
+    WeightedRecluster(candidateSet, weights, clusters, centroids);
+  }
+
+ private:
+  /**
+   * Update the minimum squared distance of every point to the candidate set,
+   * considering only the candidates added at index `firstNew` or later.  If
+   * `reset` is true, the distances are initialized rather than minimized.
+   */
+  template<typename MatType>
+  inline static void UpdateDistances(const MatType& data,
+                                     const std::vector<size_t>& candidates,
+                                     const size_t firstNew,
+                                     arma::vec& minDistances,
+                                     const bool reset)
+  {
+    #pragma omp parallel for
+    for (omp_size_t p = 0; p < (omp_size_t) data.n_cols; ++p)
+    {
+      double minDistance = reset ? std::numeric_limits<double>::max() :
+          minDistances[p];
+      for (size_t i = firstNew; i < candidates.size(); ++i)
+      {
+        const double distance =
+            mlpack::metric::SquaredEuclideanDistance::Evaluate(data.col(p),
+            data.col(candidates[i]));
+        minDistance = std::min(distance, minDistance);
+      }
+      minDistances[p] = minDistance;
+    }
+  }
+
+  /**
+   * Sample an index from the given unnormalized distribution.
+   */
+  inline static size_t SampleFromDistribution(const arma::vec& distribution)
+  {
+    arma::vec cdf = arma::cumsum(distribution);
+    const double sampleValue = mlpack::math::Random() * cdf[cdf.n_elem - 1];
+    const size_t position = (size_t) (std::lower_bound(cdf.begin(), cdf.end(),
+        sampleValue) - cdf.begin());
+    return std::min(position, (size_t) (cdf.n_elem - 1));
+  }
+
+  /**
+   * Cluster the weighted candidate set into k centroids, using weighted
+   * k-means++ seeding followed by weighted Lloyd iterations.
+   */
+  inline static void WeightedRecluster(const arma::mat& candidateSet,
+                                       const arma::vec& weights,
+                                       const size_t clusters,
+                                       arma::mat& centroids)
+  {
+    centroids.set_size(candidateSet.n_rows, clusters);
+
+    // Weighted k-means++ seeding: the first centroid is sampled proportional
+    // to weight alone, and each subsequent one proportional to weight times
+    // squared distance from the chosen centroids.
+    arma::vec candidateDistances(candidateSet.n_cols);
+    candidateDistances.fill(std::numeric_limits<double>::max());
+
+    centroids.col(0) = candidateSet.col(SampleFromDistribution(weights));
+    for (size_t i = 1; i < clusters; ++i)
+    {
+      for (size_t p = 0; p < candidateSet.n_cols; ++p)
+      {
+        const double distance =
+            mlpack::metric::SquaredEuclideanDistance::Evaluate(
+            candidateSet.col(p), centroids.col(i - 1));
+        candidateDistances[p] = std::min(distance, candidateDistances[p]);
+      }
+
+      centroids.col(i) = candidateSet.col(SampleFromDistribution(
+          weights % candidateDistances));
+    }
+
+    // A few weighted Lloyd iterations over the candidate set.
+    const size_t maxIterations = 10;
+    arma::Col<size_t> assignments(candidateSet.n_cols);
+    for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+    {
+      bool changed = false;
+      for (size_t p = 0; p < candidateSet.n_cols; ++p)
+      {
+        double minDistance = std::numeric_limits<double>::max();
+        size_t closest = 0;
+        for (size_t j = 0; j < clusters; ++j)
+        {
+          const double distance =
+              mlpack::metric::SquaredEuclideanDistance::Evaluate(
+              candidateSet.col(p), centroids.col(j));
+          if (distance < minDistance)
+          {
+            minDistance = distance;
+            closest = j;
+          }
+        }
+
+        if (iteration == 0 || assignments[p] != closest)
+        {
+          assignments[p] = closest;
+          changed = true;
+        }
+      }
+
+      if (!changed)
+        break;
+
+      // Recompute the weighted centroids; empty clusters keep their previous
+      // centroid.
+      for (size_t j = 0; j < clusters; ++j)
+      {
+        arma::vec sum(candidateSet.n_rows, arma::fill::zeros);
+        double weightSum = 0.0;
+        for (size_t p = 0; p < candidateSet.n_cols; ++p)
+        {
+          if (assignments[p] == j)
+          {
+            sum += weights[p] * candidateSet.col(p);
+            weightSum += weights[p];
+          }
+        }
+
+        if (weightSum > 0.0)
+          centroids.col(j) = sum / weightSum;
+      }
+    }
+  }
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -48,8 +48,8 @@ class MaxVarianceNewCluster
   template<typename MetricType, typename MatType>
   void EmptyCluster(const MatType& data,
                     const size_t emptyCluster,
-                    const arma::mat& oldCentroids,
-                    arma::mat& newCentroids,
+                    const arma::Mat<typename MatType::elem_type>& oldCentroids,
+                    arma::Mat<typename MatType::elem_type>& newCentroids,
                     arma::Col<size_t>& clusterCounts,
                     MetricType& metric,
                     const size_t iteration);
@@ -69,7 +69,7 @@ class MaxVarianceNewCluster
   //! Called when we are on a new iteration.
   template<typename MetricType, typename MatType>
   void Precalculate(const MatType& data,
-                    const arma::mat& oldCentroids,
+                    const arma::Mat<typename MatType::elem_type>& oldCentroids,
                     arma::Col<size_t>& clusterCounts,
                     MetricType& metric);
 };
@@ -24,8 +24,8 @@ namespace kmeans {
 template<typename MetricType, typename MatType>
 void MaxVarianceNewCluster::EmptyCluster(const MatType& data,
                                          const size_t emptyCluster,
-                                         const arma::mat& oldCentroids,
-                                         arma::mat& newCentroids,
+                                         const arma::Mat<typename MatType::elem_type>& oldCentroids,
+                                         arma::Mat<typename MatType::elem_type>& newCentroids,
                                          arma::Col<size_t>& clusterCounts,
                                          MetricType& metric,
                                          const size_t iteration)
@@ -66,10 +66,11 @@ void MaxVarianceNewCluster::EmptyCluster(const MatType& data,
   newCentroids.col(maxVarCluster) *= (double(clusterCounts[maxVarCluster]) /
       double(clusterCounts[maxVarCluster] - 1));
   newCentroids.col(maxVarCluster) -= (1.0 / (clusterCounts[maxVarCluster] -
-      1.0)) * arma::vec(data.col(furthestPoint));
+      1.0)) * arma::Col<typename MatType::elem_type>(data.col(furthestPoint));
   clusterCounts[maxVarCluster]--;
   clusterCounts[emptyCluster]++;
-  newCentroids.col(emptyCluster) = arma::vec(data.col(furthestPoint));
+  newCentroids.col(emptyCluster) =
+      arma::Col<typename MatType::elem_type>(data.col(furthestPoint));
   assignments[furthestPoint] = emptyCluster;
 
   // Modify the variances, as necessary.
@@ -113,7 +114,7 @@ void MaxVarianceNewCluster::serialize(Archive& /* ar */,
 
 template<typename MetricType, typename MatType>
 void MaxVarianceNewCluster::Precalculate(const MatType& data,
-                                         const arma::mat& oldCentroids,
+                                         const arma::Mat<typename MatType::elem_type>& oldCentroids,
                                          arma::Col<size_t>& clusterCounts,
                                          MetricType& metric)
 {
@@ -0,0 +1,138 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of mini-batch k-means (Sculley, 2010) as a Lloyd step
+ * policy.  Each iteration processes only a sampled batch of points, so it is
+ * far cheaper than a full Lloyd step on large datasets, at the cost of an
+ * approximate solution.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of a single iteration of the mini-batch k-means
+ * algorithm:
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, D.},
+ *   booktitle={Proceedings of the 19th International Conference on the World
+ *       Wide Web (WWW '10)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * Each iteration samples a batch of points, assigns each sampled point to its
+ * nearest center, and then moves each center towards its assigned samples
+ * with a per-center learning rate that decays with the total number of points
+ * the center has absorbed.  Convergence is checked against a fixed holdout
+ * sample drawn by reservoir sampling at construction time: when the holdout
+ * inertia stops improving for several consecutive iterations, the iteration
+ * signals convergence.  The full dataset is never scanned after construction,
+ * so the result is approximate, but on large datasets it typically reaches
+ * comparable inertia in a small fraction of the time of a full Lloyd step.
+ *
+ * This class is meant to be used as the LloydStepType policy of the KMeans
+ * class:
+ *
+ * @code
+ * KMeans<metric::EuclideanDistance, SampleInitialization,
+ *     MaxVarianceNewCluster, MiniBatchKMeans> kmeans;
+ * @endcode
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  //! The element type of the data (and of the centroids).
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   * The batch size defaults to 1% of the dataset (but at least 1000 points,
+   * and no more than the whole dataset), and the holdout sample used for
+   * convergence checking is drawn here with one reservoir pass.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  MiniBatchKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single iteration of mini-batch k-means, updating the given
+   * centroids into the newCentroids matrix.  Note that the counts returned
+   * are cumulative over all iterations, not per-batch: a cluster is reported
+   * empty only if no sampled point has ever been assigned to it, since with
+   * small batches a cluster can easily receive no points in one batch without
+   * being empty.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Cumulative number of sampled points assigned to each
+   *      cluster.
+   */
+  double Iterate(const arma::Mat<ElemType>& centroids,
+                 arma::Mat<ElemType>& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the number of consecutive non-improving iterations allowed before
+  //! convergence is signaled.
+  size_t MaxNoImprovement() const { return maxNoImprovement; }
+  //! Modify the number of consecutive non-improving iterations allowed.
+  size_t& MaxNoImprovement() { return maxNoImprovement; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of points sampled per iteration.
+  size_t batchSize;
+  //! Number of consecutive non-improving iterations allowed.
+  size_t maxNoImprovement;
+
+  //! Fixed holdout sample used for convergence checking.
+  arma::uvec holdoutIndices;
+  //! Cumulative number of sampled points assigned to each center; the
+  //! per-center learning rate is the reciprocal of this.
+  arma::Col<size_t> centerCounts;
+  //! Best holdout inertia seen so far.
+  double bestHoldoutInertia;
+  //! Number of consecutive iterations without holdout improvement.
+  size_t noImprovementCount;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of mini-batch k-means (Sculley, 2010) as a Lloyd step
+ * policy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(std::min((size_t) dataset.n_cols,
+        std::max((size_t) 1000, (size_t) (dataset.n_cols / 100)))),
+    maxNoImprovement(10),
+    bestHoldoutInertia(DBL_MAX),
+    noImprovementCount(0),
+    distanceCalculations(0)
+{
+  // Draw the fixed holdout sample used for convergence checking with a single
+  // reservoir pass over the dataset.
+  const size_t holdoutSize = std::min((size_t) dataset.n_cols, (size_t) 2048);
+  holdoutIndices.set_size(holdoutSize);
+  for (size_t i = 0; i < holdoutSize; ++i)
+    holdoutIndices[i] = i;
+  for (size_t i = holdoutSize; i < dataset.n_cols; ++i)
+  {
+    const size_t j = math::RandInt(0, i + 1);
+    if (j < holdoutSize)
+      holdoutIndices[j] = i;
+  }
+}
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::Mat<ElemType>& centroids,
+    arma::Mat<ElemType>& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // On the first iteration (or if the number of clusters changed), start the
+  // per-center learning rate schedule and the convergence state over.
+  if (centerCounts.n_elem != centroids.n_cols)
+  {
+    centerCounts.zeros(centroids.n_cols);
+    bestHoldoutInertia = DBL_MAX;
+    noImprovementCount = 0;
+  }
+
+  newCentroids = centroids;
+
+  // Sample the batch and assign each sampled point to its nearest center.
+  // The assignments are made against the centers as they were at the start of
+  // the iteration, following Sculley's formulation.
+  arma::uvec batch(batchSize);
+  arma::Col<size_t> assignments(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    batch[i] = math::RandInt(0, dataset.n_cols);
+
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(dataset.col(batch[i]),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+  distanceCalculations += batchSize * centroids.n_cols;
+
+  // Apply a gradient step per sampled point, with a per-center learning rate
+  // that decays with the total number of points the center has absorbed.
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const size_t cluster = assignments[i];
+    const double eta = 1.0 / (double) (++centerCounts[cluster]);
+    newCentroids.col(cluster) = (1.0 - eta) * newCentroids.col(cluster) +
+        eta * dataset.col(batch[i]);
+  }
+
+  // Report cumulative counts; with small batches a per-batch count of zero
+  // does not mean the cluster is empty.
+  counts = centerCounts;
+
+  // Movement of the centers this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  // Sampled convergence check: compute the inertia of the holdout sample
+  // under the new centers, and track how long it has been since it improved.
+  double holdoutInertia = 0.0;
+  for (size_t i = 0; i < holdoutIndices.n_elem; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < newCentroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(dataset.col(holdoutIndices[i]),
+          newCentroids.unsafe_col(j));
+      minDistance = std::min(minDistance, distance);
+    }
+    holdoutInertia += std::pow(minDistance, 2.0);
+  }
+  distanceCalculations += holdoutIndices.n_elem * newCentroids.n_cols;
+
+  if (holdoutInertia < bestHoldoutInertia)
+  {
+    bestHoldoutInertia = holdoutInertia;
+    noImprovementCount = 0;
+  }
+  else
+  {
+    ++noImprovementCount;
+  }
+
+  // If the holdout inertia has stalled, signal convergence.
+  if (noImprovementCount >= maxNoImprovement)
+    return 0.0;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
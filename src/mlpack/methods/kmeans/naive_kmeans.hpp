@@ -15,6 +15,7 @@
 #ifndef MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -32,6 +33,9 @@ template<typename MetricType, typename MatType>
 class NaiveKMeans
 {
  public:
+  //! The element type of the data (and of the centroids).
+  typedef typename MatType::elem_type ElemType;
+
   /**
    * Construct the NaiveKMeans object with the given dataset and metric.
    *
@@ -50,13 +54,28 @@ class NaiveKMeans
    * @param newCentroids New cluster centroids.
    * @param counts Number of points in each cluster at the end of the iteration.
    */
-  double Iterate(const arma::mat& centroids,
-                 arma::mat& newCentroids,
+  double Iterate(const arma::Mat<ElemType>& centroids,
+                 arma::Mat<ElemType>& newCentroids,
                  arma::Col<size_t>& counts);
 
   size_t DistanceCalculations() const { return distanceCalculations; }
 
  private:
+  /**
+   * Assign points to centroids and accumulate the new centroids, computing
+   * distances one tile (block of points by all centroids) at a time with the
+   * GEMM formulation of the squared Euclidean distance.  This vectorizes
+   * across centroids and reuses loaded point data, and is used in place of
+   * the pairwise loop when MetricType is the Euclidean distance.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids Matrix to accumulate unnormalized centroids into.
+   * @param counts Number of points assigned to each cluster.
+   */
+  void IterateBlocked(const arma::Mat<ElemType>& centroids,
+                      arma::Mat<ElemType>& newCentroids,
+                      arma::Col<size_t>& counts);
+
   //! The dataset.
   const MatType& dataset;
   //! The instantiated metric.
@@ -19,6 +19,8 @@
 // In case it hasn't been included yet.
 #include "naive_kmeans.hpp"
 
+#include <mlpack/core/util/deterministic_mode.hpp>
+
 namespace mlpack {
 namespace kmeans {
 
@@ -32,51 +34,116 @@ NaiveKMeans<MetricType, MatType>::NaiveKMeans(const MatType& dataset,
 
 // Run a single iteration.
 template<typename MetricType, typename MatType>
-double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
-                                                 arma::mat& newCentroids,
-                                                 arma::Col<size_t>& counts)
+double NaiveKMeans<MetricType, MatType>::Iterate(
+    const arma::Mat<ElemType>& centroids,
+    arma::Mat<ElemType>& newCentroids,
+    arma::Col<size_t>& counts)
 {
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
 
-  // Find the closest centroid to each point and update the new centroids.
-  // Computed in parallel over the complete dataset
-  #pragma omp parallel
+  // For the Euclidean distance, the assignment step can be computed one tile
+  // (a block of points against all centroids) at a time with a matrix
+  // product, which vectorizes across centroids instead of evaluating the
+  // metric one pair at a time.
+  if (std::is_same<MetricType, metric::EuclideanDistance>::value)
   {
-    // The current state of the K-means is private for each thread
-    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
-        arma::fill::zeros);
-    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    IterateBlocked(centroids, newCentroids, counts);
+  }
+  else if (util::DeterministicMode())
+  {
+    // Deterministic mode: the dataset is split into a fixed number of
+    // contiguous chunks, each accumulating into its own partial state, and
+    // the partials are combined in a fixed pairwise order, so the result
+    // does not depend on the number of threads or on the run-to-run
+    // schedule.
+    const size_t numChunks = std::max((size_t) 1,
+        std::min((size_t) dataset.n_cols, util::deterministicChunks));
+    std::vector<arma::Mat<ElemType>> partialCentroids(numChunks,
+        arma::Mat<ElemType>(centroids.n_rows, centroids.n_cols,
+            arma::fill::zeros));
+    std::vector<arma::Col<size_t>> partialCounts(numChunks,
+        arma::Col<size_t>(centroids.n_cols, arma::fill::zeros));
 
-    #pragma omp for
-    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
     {
-      // Find the closest centroid to this point.
-      double minDistance = std::numeric_limits<double>::infinity();
-      size_t closestCluster = centroids.n_cols; // Invalid value.
-
-      for (size_t j = 0; j < centroids.n_cols; ++j)
+      const size_t chunkBegin = (dataset.n_cols * c) / numChunks;
+      const size_t chunkEnd = (dataset.n_cols * (c + 1)) / numChunks;
+      for (size_t i = chunkBegin; i < chunkEnd; ++i)
       {
-        const double distance = metric.Evaluate(dataset.col(i),
-            centroids.unsafe_col(j));
-        if (distance < minDistance)
+        // Find the closest centroid to this point.
+        double minDistance = std::numeric_limits<double>::infinity();
+        size_t closestCluster = centroids.n_cols; // Invalid value.
+
+        for (size_t j = 0; j < centroids.n_cols; ++j)
         {
-          minDistance = distance;
-          closestCluster = j;
+          const double distance = metric.Evaluate(dataset.col(i),
+              centroids.unsafe_col(j));
+          if (distance < minDistance)
+          {
+            minDistance = distance;
+            closestCluster = j;
+          }
         }
-      }
 
-      Log::Assert(closestCluster != centroids.n_cols);
+        Log::Assert(closestCluster != centroids.n_cols);
 
-      // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.unsafe_col(closestCluster) += dataset.col(i);
-      localCounts(closestCluster)++;
+        partialCentroids[c].unsafe_col(closestCluster) += dataset.col(i);
+        partialCounts[c](closestCluster)++;
+      }
     }
-    // Combine calculated state from each thread
-    #pragma omp critical
+
+    util::PairwiseReduce(partialCentroids);
+    util::PairwiseReduce(partialCounts);
+    newCentroids = std::move(partialCentroids[0]);
+    counts = std::move(partialCounts[0]);
+  }
+  else
+  {
+    // Find the closest centroid to each point and update the new centroids.
+    // Computed in parallel over the complete dataset
+    #pragma omp parallel
     {
-      newCentroids += localCentroids;
-      counts += localCounts;
+      // The current state of the K-means is private for each thread
+      arma::Mat<ElemType> localCentroids(centroids.n_rows, centroids.n_cols,
+          arma::fill::zeros);
+      arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+
+      // The static schedule gives each thread the same contiguous column
+      // range as util::ShardedFirstTouch(), so on NUMA machines threads read
+      // the pages they first-touched from local memory.
+      #pragma omp for schedule(static)
+      for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
+      {
+        // Find the closest centroid to this point.
+        double minDistance = std::numeric_limits<double>::infinity();
+        size_t closestCluster = centroids.n_cols; // Invalid value.
+
+        for (size_t j = 0; j < centroids.n_cols; ++j)
+        {
+          const double distance = metric.Evaluate(dataset.col(i),
+              centroids.unsafe_col(j));
+          if (distance < minDistance)
+          {
+            minDistance = distance;
+            closestCluster = j;
+          }
+        }
+
+        Log::Assert(closestCluster != centroids.n_cols);
+
+        // We now have the minimum distance centroid index.  Update that
+        // centroid.
+        localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+        localCounts(closestCluster)++;
+      }
+      // Combine calculated state from each thread
+      #pragma omp critical
+      {
+        newCentroids += localCentroids;
+        counts += localCounts;
+      }
     }
   }
 
@@ -99,6 +166,113 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   return std::sqrt(cNorm);
 }
 
+template<typename MetricType, typename MatType>
+void NaiveKMeans<MetricType, MatType>::IterateBlocked(
+    const arma::Mat<ElemType>& centroids,
+    arma::Mat<ElemType>& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // For the assignment step only the argmin over centroids matters, so with
+  //   d^2(x, c) = ||x||^2 + ||c||^2 - 2 x^T c
+  // the ||x||^2 term is constant per point and can be dropped; we compare
+  //   ||c||^2 - 2 x^T c
+  // across centroids, with the cross products of a whole block of points
+  // computed as one matrix product.
+  const arma::Col<ElemType> centroidNorms =
+      arma::sum(arma::square(centroids), 0).t();
+  const size_t blockSize = 64;
+  const size_t blocks = (dataset.n_cols + blockSize - 1) / blockSize;
+
+  if (util::DeterministicMode())
+  {
+    // Deterministic mode: the blocks are split into a fixed number of
+    // contiguous chunks, each accumulating into its own partial state, and
+    // the partials are combined in a fixed pairwise order, so the result
+    // does not depend on the number of threads or on the run-to-run
+    // schedule.
+    const size_t numChunks = std::max((size_t) 1,
+        std::min(blocks, util::deterministicChunks));
+    std::vector<arma::Mat<ElemType>> partialCentroids(numChunks,
+        arma::Mat<ElemType>(centroids.n_rows, centroids.n_cols,
+            arma::fill::zeros));
+    std::vector<arma::Col<size_t>> partialCounts(numChunks,
+        arma::Col<size_t>(centroids.n_cols, arma::fill::zeros));
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+    {
+      for (size_t block = (blocks * c) / numChunks;
+           block < (blocks * (c + 1)) / numChunks; ++block)
+      {
+        const size_t begin = block * blockSize;
+        const size_t end = std::min((size_t) dataset.n_cols,
+            begin + blockSize) - 1;
+
+        // Cross products of the block against all centroids; direct
+        // initialization handles the conversion if the dataset is sparse.
+        const arma::Mat<ElemType> dots(arma::trans(centroids) *
+            dataset.cols(begin, end));
+
+        for (size_t i = begin; i <= end; ++i)
+        {
+          const arma::Col<ElemType> scores = centroidNorms -
+              2.0 * dots.col(i - begin);
+          const size_t closestCluster = (size_t) scores.index_min();
+
+          partialCentroids[c].unsafe_col(closestCluster) += dataset.col(i);
+          partialCounts[c](closestCluster)++;
+        }
+      }
+    }
+
+    util::PairwiseReduce(partialCentroids);
+    util::PairwiseReduce(partialCounts);
+    newCentroids = std::move(partialCentroids[0]);
+    counts = std::move(partialCounts[0]);
+    return;
+  }
+
+  #pragma omp parallel
+  {
+    // The current state of the K-means is private for each thread
+    arma::Mat<ElemType> localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+
+    // Static schedule: each thread gets a contiguous range of blocks (and so
+    // of columns), keeping the reads node-local on NUMA machines when the
+    // dataset was first-touched with util::ShardedFirstTouch().
+    #pragma omp for schedule(static)
+    for (omp_size_t block = 0; block < (omp_size_t) blocks; ++block)
+    {
+      const size_t begin = block * blockSize;
+      const size_t end = std::min((size_t) dataset.n_cols,
+          begin + blockSize) - 1;
+
+      // Cross products of the block against all centroids; direct
+      // initialization handles the conversion if the dataset is sparse.
+      const arma::Mat<ElemType> dots(arma::trans(centroids) *
+          dataset.cols(begin, end));
+
+      for (size_t i = begin; i <= end; ++i)
+      {
+        const arma::Col<ElemType> scores = centroidNorms -
+            2.0 * dots.col(i - begin);
+        const size_t closestCluster = (size_t) scores.index_min();
+
+        localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+        localCounts(closestCluster)++;
+      }
+    }
+    // Combine calculated state from each thread
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+}
+
 } // namespace kmeans
 } // namespace mlpack
 
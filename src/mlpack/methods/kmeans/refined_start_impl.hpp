@@ -26,16 +26,20 @@ void RefinedStart::Cluster(const MatType& data,
                            const size_t clusters,
                            arma::mat& centroids) const
 {
-  // This will hold the sampled datasets.
   const size_t numPoints = size_t(percentage * data.n_cols);
-  MatType sampledData(data.n_rows, numPoints);
-  // vector<bool> is packed so each bool is 1 bit.
-  std::vector<bool> pointsUsed(data.n_cols, false);
   arma::mat sampledCentroids(data.n_rows, samplings * clusters);
 
-  for (size_t i = 0; i < samplings; ++i)
+  // The samplings are independent of each other, so they are run as parallel
+  // jobs, each writing into its own block of sampledCentroids.  The random
+  // draws come from the calling thread's random stream (math::RandGen()), so
+  // the jobs do not contend on the global generator.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) samplings; ++i)
   {
     // First, assemble the sampled dataset.
+    MatType sampledData(data.n_rows, numPoints);
+    // vector<bool> is packed so each bool is 1 bit.
+    std::vector<bool> pointsUsed(data.n_cols, false);
     size_t curSample = 0;
     while (curSample < numPoints)
     {
@@ -56,15 +60,16 @@ void RefinedStart::Cluster(const MatType& data,
     // the cluster with maximum variance.  This is not *exactly* what the paper
     // implements, but it is quite similar, and we'll call it "good enough".
     KMeans<> kmeans;
-    kmeans.Cluster(sampledData, clusters, centroids);
+    arma::mat sampleCentroids;
+    kmeans.Cluster(sampledData, clusters, sampleCentroids);
 
     // Store the sampled centroids.
-    sampledCentroids.cols(i * clusters, (i + 1) * clusters - 1) = centroids;
-
-    pointsUsed.assign(data.n_cols, false);
+    sampledCentroids.cols(i * clusters, (i + 1) * clusters - 1) =
+        sampleCentroids;
   }
 
-  // Now, we run k-means on the sampled centroids to get our final clusters.
+  // Now, we run k-means on the sampled centroids to get our final clusters;
+  // the Lloyd iterations inside KMeans are themselves parallel.
   KMeans<> kmeans;
   kmeans.Cluster(sampledCentroids, clusters, centroids);
 }
@@ -79,9 +84,11 @@ void RefinedStart::Cluster(const MatType& data,
   arma::mat centroids;
   Cluster(data, clusters, centroids);
 
-  // Turn the final centroids into assignments.
+  // Turn the final centroids into assignments; the points are independent,
+  // so they are assigned in parallel.
   assignments.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
     // Find the closest centroid to this point.
     double minDistance = std::numeric_limits<double>::infinity();
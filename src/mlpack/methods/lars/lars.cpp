@@ -11,6 +11,8 @@
  */
 #include "lars.hpp"
 #include <mlpack/core/util/log.hpp>
+
+#include <algorithm>
 #include <mlpack/core/util/timers.hpp>
 
 using namespace mlpack;
@@ -26,7 +28,9 @@ LARS::LARS(const bool useCholesky,
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    screening(false),
+    gramCacheBudget(0)
 { /* Nothing left to do. */ }
 
 LARS::LARS(const bool useCholesky,
@@ -40,7 +44,9 @@ LARS::LARS(const bool useCholesky,
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    screening(false),
+    gramCacheBudget(0)
 { /* Nothing left to do */ }
 
 LARS::LARS(const arma::mat& data,
@@ -80,6 +86,10 @@ LARS::LARS(const LARS& other) :
     elasticNet(other.elasticNet),
     lambda2(other.lambda2),
     tolerance(other.tolerance),
+    screening(other.screening),
+    gramCacheBudget(other.gramCacheBudget),
+    gramCache(other.gramCache),
+    gramCacheOrder(other.gramCacheOrder),
     betaPath(other.betaPath),
     lambdaPath(other.lambdaPath),
     activeSet(other.activeSet),
@@ -102,6 +112,10 @@ LARS::LARS(LARS&& other) :
     elasticNet(other.elasticNet),
     lambda2(other.lambda2),
     tolerance(other.tolerance),
+    screening(other.screening),
+    gramCacheBudget(other.gramCacheBudget),
+    gramCache(std::move(other.gramCache)),
+    gramCacheOrder(std::move(other.gramCacheOrder)),
     betaPath(std::move(other.betaPath)),
     lambdaPath(std::move(other.lambdaPath)),
     activeSet(std::move(other.activeSet)),
@@ -128,6 +142,10 @@ LARS& LARS::operator=(const LARS& other)
   elasticNet = other.elasticNet;
   lambda2 = other.lambda2;
   tolerance = other.tolerance;
+  screening = other.screening;
+  gramCacheBudget = other.gramCacheBudget;
+  gramCache = other.gramCache;
+  gramCacheOrder = other.gramCacheOrder;
   betaPath = other.betaPath;
   lambdaPath = other.lambdaPath;
   activeSet = other.activeSet;
@@ -153,6 +171,10 @@ LARS& LARS::operator=(LARS&& other)
   elasticNet = other.elasticNet;
   lambda2 = other.lambda2;
   tolerance = other.tolerance;
+  screening = other.screening;
+  gramCacheBudget = other.gramCacheBudget;
+  gramCache = std::move(other.gramCache);
+  gramCacheOrder = std::move(other.gramCacheOrder);
   betaPath = std::move(other.betaPath);
   lambdaPath = std::move(other.lambdaPath);
   activeSet = std::move(other.activeSet);
@@ -175,6 +197,8 @@ double LARS::Train(const arma::mat& matX,
   ignoreSet.clear();
   isIgnored.clear();
   matUtriCholFactor.reset();
+  gramCache.clear();
+  gramCacheOrder.clear();
 
   // Update values in case lambda1 or lambda2 changed.
   lasso = (lambda1 != 0);
@@ -228,8 +252,11 @@ double LARS::Train(const arma::mat& matX,
   }
 
   // Compute the Gram matrix.  If this is the elastic net problem, we will add
-  // lambda2 * I_n to the matrix.
-  if (matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
+  // lambda2 * I_n to the matrix.  When a Gram cache budget is set, the full
+  // matrix is never formed; the columns the solver needs are computed on
+  // demand by GramColumn() instead.
+  if (gramCacheBudget == 0 &&
+      matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
   {
     // In this case, matGram should reference matGramInternal.
     matGramInternal = trans(dataRef) * dataRef;
@@ -238,18 +265,104 @@ double LARS::Train(const arma::mat& matX,
       matGramInternal += lambda2 * arma::eye(dataRef.n_cols, dataRef.n_cols);
   }
 
+  // Sequential strong rule screening state.  While screening, only the
+  // candidate dimensions are touched each step; the correlations of the
+  // excluded dimensions go stale and are refreshed (with a KKT check) by
+  // rescreen() every time the path reaches the current screening target.
+  std::vector<size_t> candidateSet;
+  std::vector<bool> isCandidate(dataRef.n_cols, false);
+  double screenTargetLambda = 0.0;
+  bool screenWarned = false;
+
+  auto rescreen = [&](const double lambdaCur, const bool initial)
+  {
+    // Refresh the exact correlations of every dimension; this is the only
+    // full pass over the data while screening.
+    corr = vecXTy - trans(dataRef) * yHat;
+    if (elasticNet)
+      corr -= lambda2 * beta;
+
+    // Check the excluded dimensions against the KKT conditions: none of them
+    // should have been able to enter the path before now.  Violations of the
+    // strong rule are rare but possible.
+    if (!initial && !screenWarned)
+    {
+      for (size_t j = 0; j < dataRef.n_cols; ++j)
+      {
+        if (!isActive[j] && !isIgnored[j] && !isCandidate[j] &&
+            (fabs(corr(j)) > lambdaCur + tolerance))
+        {
+          Log::Warn << "LARS::Train(): strong rule screening excluded "
+              << "dimension " << j << " too early; the path computed so far "
+              << "is approximate." << std::endl;
+          screenWarned = true;
+          break;
+        }
+      }
+    }
+
+    // Aim the rule at a target further down the path; the sequential strong
+    // rule keeps every dimension j with |corr_j| >= 2 * target - current,
+    // which (heuristically) covers all dimensions that can become active
+    // before the path reaches the target.  The threshold is based on the
+    // actual maximum correlation of the eligible dimensions, so the next
+    // dimension to enter always survives the screen; a target of 0.9 * max
+    // prunes everything below 0.8 * max while amortizing each full refresh
+    // over the steps taken until the target is reached.
+    double inactiveMax = 0.0;
+    for (size_t j = 0; j < dataRef.n_cols; ++j)
+    {
+      if (!isActive[j] && !isIgnored[j] && (fabs(corr(j)) > inactiveMax))
+        inactiveMax = fabs(corr(j));
+    }
+
+    screenTargetLambda = inactiveMax * 0.9;
+    const double thresh = 2.0 * screenTargetLambda - inactiveMax;
+
+    candidateSet.clear();
+    for (size_t j = 0; j < dataRef.n_cols; ++j)
+    {
+      isCandidate[j] = (!isActive[j] && !isIgnored[j] &&
+          (fabs(corr(j)) >= thresh));
+      if (isCandidate[j])
+        candidateSet.push_back(j);
+    }
+  };
+
+  if (screening)
+    rescreen(maxCorr, true);
+
   // Main loop.
   while (((activeSet.size() + ignoreSet.size()) < dataRef.n_cols) &&
          (maxCorr > tolerance))
   {
-    // Compute the maximum correlation among inactive dimensions.
+    // Compute the maximum correlation among inactive dimensions.  While
+    // screening, only the candidates that survived the strong rule need to be
+    // scanned.
     maxCorr = 0;
-    for (size_t i = 0; i < dataRef.n_cols; ++i)
+    if (screening)
+    {
+      if (candidateSet.empty())
+        rescreen(lambdaPath.back(), false);
+
+      for (size_t i = 0; i < candidateSet.size(); ++i)
+      {
+        if (fabs(corr(candidateSet[i])) > maxCorr)
+        {
+          maxCorr = fabs(corr(candidateSet[i]));
+          changeInd = candidateSet[i];
+        }
+      }
+    }
+    else
     {
-      if ((!isActive[i]) && (!isIgnored[i]) && (fabs(corr(i)) > maxCorr))
+      for (size_t i = 0; i < dataRef.n_cols; ++i)
       {
-        maxCorr = fabs(corr(i));
-        changeInd = i;
+        if ((!isActive[i]) && (!isIgnored[i]) && (fabs(corr(i)) > maxCorr))
+        {
+          maxCorr = fabs(corr(i));
+          changeInd = i;
+        }
       }
     }
 
@@ -257,20 +370,39 @@ double LARS::Train(const arma::mat& matX,
     {
       if (useCholesky)
       {
-        // vec newGramCol = vec(activeSet.size());
-        // for (size_t i = 0; i < activeSet.size(); ++i)
-        // {
-        //   newGramCol[i] = dot(matX.col(activeSet[i]), matX.col(changeInd));
-        // }
-        // This is equivalent to the above 5 lines.
-        arma::vec newGramCol = matGram->elem(changeInd * dataRef.n_cols +
-            arma::conv_to<arma::uvec>::from(activeSet));
-
-        CholeskyInsert((*matGram)(changeInd, changeInd), newGramCol);
+        if (gramCacheBudget > 0)
+        {
+          const arma::vec& gramCol = GramColumn(dataRef, changeInd);
+          arma::vec newGramCol = gramCol.elem(
+              arma::conv_to<arma::uvec>::from(activeSet));
+
+          CholeskyInsert(gramCol(changeInd), newGramCol);
+        }
+        else
+        {
+          // vec newGramCol = vec(activeSet.size());
+          // for (size_t i = 0; i < activeSet.size(); ++i)
+          // {
+          //   newGramCol[i] = dot(matX.col(activeSet[i]),
+          //       matX.col(changeInd));
+          // }
+          // This is equivalent to the above 5 lines.
+          arma::vec newGramCol = matGram->elem(changeInd * dataRef.n_cols +
+              arma::conv_to<arma::uvec>::from(activeSet));
+
+          CholeskyInsert((*matGram)(changeInd, changeInd), newGramCol);
+        }
       }
 
-      // Add variable to active set.
+      // Add variable to active set (and remove it from the candidates, if we
+      // are screening).
       Activate(changeInd);
+      if (screening)
+      {
+        isCandidate[changeInd] = false;
+        candidateSet.erase(std::find(candidateSet.begin(), candidateSet.end(),
+            changeInd));
+      }
     }
 
     // Compute signs of correlations.
@@ -325,9 +457,26 @@ double LARS::Train(const arma::mat& matX,
     else
     {
       arma::mat matGramActive = arma::mat(activeSet.size(), activeSet.size());
-      for (size_t i = 0; i < activeSet.size(); ++i)
+      if (gramCacheBudget > 0)
+      {
         for (size_t j = 0; j < activeSet.size(); ++j)
-          matGramActive(i, j) = (*matGram)(activeSet[i], activeSet[j]);
+        {
+          const arma::vec& gramCol = GramColumn(dataRef, activeSet[j]);
+          for (size_t i = 0; i < activeSet.size(); ++i)
+            matGramActive(i, j) = gramCol(activeSet[i]);
+
+          // The cached columns hold the raw Gram matrix; the elastic net term
+          // is only present on the diagonal of the precomputed matrix.
+          if (elasticNet)
+            matGramActive(j, j) += lambda2;
+        }
+      }
+      else
+      {
+        for (size_t i = 0; i < activeSet.size(); ++i)
+          for (size_t j = 0; j < activeSet.size(); ++j)
+            matGramActive(i, j) = (*matGram)(activeSet[i], activeSet[j]);
+      }
 
       // Check for singularity.
       arma::mat matS = s * arma::ones<arma::mat>(1, activeSet.size());
@@ -359,25 +508,78 @@ double LARS::Train(const arma::mat& matX,
     double gamma = maxCorr / normalization;
 
     // If not all variables are active.
+    arma::vec candidateDirCorrs;
     if ((activeSet.size() + ignoreSet.size()) < dataRef.n_cols)
     {
-      // Compute correlations with direction.
-      for (size_t ind = 0; ind < dataRef.n_cols; ind++)
+      if (screening)
       {
-        if (isActive[ind] || isIgnored[ind])
-          continue;
-
-        const double dirCorr = dot(dataRef.col(ind), yHatDirection);
-        const double val1 = (maxCorr - corr(ind)) / (normalization - dirCorr);
-        const double val2 = (maxCorr + corr(ind)) / (normalization + dirCorr);
-        if ((val1 > 0.0) && (val1 < gamma))
-           gamma = val1;
-        if ((val2 > 0.0) && (val2 < gamma))
-           gamma = val2;
-        // Handle edge case where the largest actually is equal to 0.
-        if (std::max(val1, val2) == 0.0)
+        // Only the candidates that survived the strong rule can enter the
+        // path before the next rescreen, so only their correlations with the
+        // direction are needed.  This is the hot loop on wide data, so it is
+        // computed in parallel; the direction correlations are kept so the
+        // candidate correlations can be updated in place afterwards.
+        candidateDirCorrs.set_size(candidateSet.size());
+        bool gammaIsZero = false;
+
+        #pragma omp parallel
+        {
+          double localGamma = gamma;
+          bool localZero = false;
+
+          #pragma omp for
+          for (omp_size_t i = 0; i < (omp_size_t) candidateSet.size(); ++i)
+          {
+            const size_t ind = candidateSet[i];
+            const double dirCorr = dot(dataRef.col(ind), yHatDirection);
+            candidateDirCorrs[i] = dirCorr;
+
+            const double val1 = (maxCorr - corr(ind)) /
+                (normalization - dirCorr);
+            const double val2 = (maxCorr + corr(ind)) /
+                (normalization + dirCorr);
+            if ((val1 > 0.0) && (val1 < localGamma))
+              localGamma = val1;
+            if ((val2 > 0.0) && (val2 < localGamma))
+              localGamma = val2;
+            // Handle edge case where the largest actually is equal to 0.
+            if (std::max(val1, val2) == 0.0)
+              localZero = true;
+          }
+
+          #pragma omp critical
+          {
+            if (localGamma < gamma)
+              gamma = localGamma;
+            if (localZero)
+              gammaIsZero = true;
+          }
+        }
+
+        if (gammaIsZero)
           gamma = 0.0;
       }
+      else
+      {
+        // Compute correlations with direction.
+        for (size_t ind = 0; ind < dataRef.n_cols; ind++)
+        {
+          if (isActive[ind] || isIgnored[ind])
+            continue;
+
+          const double dirCorr = dot(dataRef.col(ind), yHatDirection);
+          const double val1 = (maxCorr - corr(ind)) /
+              (normalization - dirCorr);
+          const double val2 = (maxCorr + corr(ind)) /
+              (normalization + dirCorr);
+          if ((val1 > 0.0) && (val1 < gamma))
+             gamma = val1;
+          if ((val2 > 0.0) && (val2 < gamma))
+             gamma = val2;
+          // Handle edge case where the largest actually is equal to 0.
+          if (std::max(val1, val2) == 0.0)
+            gamma = 0.0;
+        }
+      }
     }
 
     // Bound gamma according to LASSO.
@@ -414,6 +616,20 @@ double LARS::Train(const arma::mat& matX,
       beta(activeSet[i]) += gamma * betaDirection(i);
     }
 
+    // While screening, the correlations are updated in place instead of
+    // recomputed: the candidates move by their correlation with the
+    // direction, and the active dimensions all move by the equiangular step
+    // (X_j^T yHatDirection = normalization * s_j for active j, with the
+    // elastic net term folded in).  The correlations of the excluded
+    // dimensions stay stale until the next rescreen.
+    if (screening)
+    {
+      for (size_t i = 0; i < candidateSet.size(); ++i)
+        corr(candidateSet[i]) -= gamma * candidateDirCorrs[i];
+      for (size_t i = 0; i < activeSet.size(); ++i)
+        corr(activeSet[i]) -= gamma * normalization * s(i);
+    }
+
     // Sanity check to make sure the kicked out dimension is actually zero.
     if (lassocond)
     {
@@ -429,12 +645,24 @@ double LARS::Train(const arma::mat& matX,
       if (useCholesky)
         CholeskyDelete(changeInd);
 
+      // A dimension that leaves the active set sits exactly at the current
+      // correlation bound, so while screening it always rejoins the
+      // candidates.
+      if (screening)
+      {
+        isCandidate[activeSet[changeInd]] = true;
+        candidateSet.push_back(activeSet[changeInd]);
+      }
+
       Deactivate(changeInd);
     }
 
-    corr = vecXTy - trans(dataRef) * yHat;
-    if (elasticNet)
-      corr -= lambda2 * beta;
+    if (!screening)
+    {
+      corr = vecXTy - trans(dataRef) * yHat;
+      if (elasticNet)
+        corr -= lambda2 * beta;
+    }
 
     double curLambda = 0;
     for (size_t i = 0; i < activeSet.size(); ++i)
@@ -444,6 +672,11 @@ double LARS::Train(const arma::mat& matX,
 
     lambdaPath.push_back(curLambda);
 
+    // The strong rule only covers the path down to the screening target;
+    // once we pass it, refresh the correlations and rebuild the candidates.
+    if (screening && curLambda < screenTargetLambda)
+      rescreen(curLambda, false);
+
     // Time to stop for LASSO?
     if (lasso)
     {
@@ -499,6 +732,35 @@ void LARS::Ignore(const size_t varInd)
   ignoreSet.push_back(varInd);
 }
 
+const arma::vec& LARS::GramColumn(const arma::mat& dataRef,
+                                  const size_t varInd)
+{
+  std::map<size_t, arma::vec>::iterator it = gramCache.find(varInd);
+  if (it == gramCache.end())
+  {
+    // Evict the least recently used columns until the new one fits; the
+    // budget always admits at least one column.
+    const size_t maxCols = std::max((size_t) 1,
+        gramCacheBudget / (dataRef.n_cols * sizeof(double)));
+    while (gramCache.size() >= maxCols)
+    {
+      gramCache.erase(gramCacheOrder.back());
+      gramCacheOrder.pop_back();
+    }
+
+    arma::vec col = trans(dataRef) * dataRef.col(varInd);
+    it = gramCache.insert(std::make_pair(varInd, std::move(col))).first;
+    gramCacheOrder.push_front(varInd);
+  }
+  else
+  {
+    gramCacheOrder.remove(varInd);
+    gramCacheOrder.push_front(varInd);
+  }
+
+  return it->second;
+}
+
 void LARS::ComputeYHatDirection(const arma::mat& matX,
                                 const arma::vec& betaDirection,
                                 arma::vec& yHatDirection)
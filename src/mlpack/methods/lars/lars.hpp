@@ -26,6 +26,9 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include <list>
+#include <map>
+
 namespace mlpack {
 namespace regression {
 
@@ -269,6 +272,26 @@ class LARS
   //! Modify the tolerance for maximum correlation during training.
   double& Tolerance() { return tolerance; }
 
+  //! Get whether sequential strong rule screening is used during training.
+  bool Screening() const { return screening; }
+  //! Modify whether sequential strong rule screening is used during training.
+  //! When enabled, each step of the path only considers the candidate
+  //! dimensions that survive the strong rule, and the correlations of the
+  //! excluded dimensions are refreshed (with a KKT check) whenever the path
+  //! passes the screening target.  This is a heuristic: strong rule
+  //! violations are rare but possible, and are reported with a warning.
+  //! Intended for very wide data where a full pass per step is infeasible.
+  bool& Screening() { return screening; }
+
+  //! Get the memory budget (in bytes) of the on-demand Gram column cache.
+  size_t GramCacheBudget() const { return gramCacheBudget; }
+  //! Modify the memory budget (in bytes) of the on-demand Gram column cache.
+  //! When nonzero, the full Gram matrix is never formed; instead the columns
+  //! needed by the solver are computed on demand and kept in a cache with
+  //! least-recently-used eviction, bounded by this budget.  Use this when the
+  //! d x d Gram matrix does not fit in memory.
+  size_t& GramCacheBudget() { return gramCacheBudget; }
+
   //! Access the set of active dimensions.
   const std::vector<size_t>& ActiveSet() const { return activeSet; }
 
@@ -334,6 +357,21 @@ class LARS
   //! Tolerance for main loop.
   double tolerance;
 
+  //! Whether to use sequential strong rule screening during training.
+  bool screening;
+
+  //! Memory budget (in bytes) for the on-demand Gram column cache; 0 means
+  //! the full Gram matrix is used instead.
+  size_t gramCacheBudget;
+
+  //! On-demand cache of Gram matrix columns; only used when gramCacheBudget
+  //! is nonzero.  This is rebuildable state and is not serialized.
+  std::map<size_t, arma::vec> gramCache;
+
+  //! Usage order of the cached Gram columns; most recently used at the
+  //! front.
+  std::list<size_t> gramCacheOrder;
+
   //! Solution path.
   std::vector<arma::vec> betaPath;
 
@@ -375,6 +413,16 @@ class LARS
    */
   void Ignore(const size_t varInd);
 
+  /**
+   * Return the changeInd'th column of the Gram matrix, computing it on demand
+   * and caching it under the configured memory budget (LRU eviction).  Only
+   * used when gramCacheBudget is nonzero.
+   *
+   * @param dataRef Row-major data matrix (each column is a dimension).
+   * @param varInd Index of the Gram column to return.
+   */
+  const arma::vec& GramColumn(const arma::mat& dataRef, const size_t varInd);
+
   // compute "equiangular" direction in output space
   void ComputeYHatDirection(const arma::mat& matX,
                             const arma::vec& betaDirection,
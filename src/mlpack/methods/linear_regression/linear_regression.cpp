@@ -46,46 +46,114 @@ double LinearRegression::Train(const arma::mat& predictors,
                                const arma::rowvec& weights,
                                const bool intercept)
 {
-  this->intercept = intercept;
-
   /*
    * We want to calculate the a_i coefficients of:
    * \sum_{i=0}^n (a_i * x_i^i)
-   * In order to get the intercept value, we will add a row of ones.
+   * The intercept corresponds to an implicit row of ones, which AddChunk()
+   * accounts for without materializing it.
+   *
+   * We accumulate the normal equations over column blocks in parallel and
+   * then solve a * (X X^T) = y X^T.  The total runtime of this should be
+   * O(d^2 N) + O(d^3) + O(dN), and the data is never copied.
    */
+  xtx.reset();
+  xty.reset();
+  AddChunk(predictors, responses, weights, intercept);
+  SolveNormalEquations();
+  return ComputeError(predictors, responses);
+}
 
-  // We store the number of rows and columns of the predictors.
-  // Reminder: Armadillo stores the data transposed from how we think of it,
-  //           that is, columns are actually rows (see: column major order).
-  const size_t nCols = predictors.n_cols;
+void LinearRegression::AddChunk(const arma::mat& predictors,
+                                const arma::rowvec& responses,
+                                const arma::rowvec& weights,
+                                const bool intercept)
+{
+  // If an intercept is fit, index 0 of the accumulators corresponds to the
+  // implicit all-ones row.
+  const size_t dims = predictors.n_rows + (intercept ? 1 : 0);
+  const size_t offset = intercept ? 1 : 0;
+  if (xtx.n_rows != dims)
+  {
+    this->intercept = intercept;
+    xtx.zeros(dims, dims);
+    xty.zeros(dims);
+  }
 
-  arma::mat p = predictors;
-  arma::rowvec r = responses;
+  const size_t blockSize = 4096;
+  const size_t blocks = (predictors.n_cols + blockSize - 1) / blockSize;
 
-  // Here we add the row of ones to the predictors.
-  // The intercept is not penalized. Add an "all ones" row to design and set
-  // intercept = false to get a penalized intercept.
-  if (intercept)
+  #pragma omp parallel
   {
-    p.insert_rows(0, arma::ones<arma::mat>(1, nCols));
+    // Each thread accumulates its own partial sums, which are merged at the
+    // end; the small d x d products vectorize well and each block is only
+    // read once.
+    arma::mat localXtx(dims, dims, arma::fill::zeros);
+    arma::vec localXty(dims, arma::fill::zeros);
+
+    #pragma omp for
+    for (omp_size_t block = 0; block < (omp_size_t) blocks; ++block)
+    {
+      const size_t begin = block * blockSize;
+      const size_t end = std::min((size_t) predictors.n_cols,
+          begin + blockSize) - 1;
+
+      if (weights.n_elem > 0)
+      {
+        // Scale the block by the square-rooted weights; the scaled ones row
+        // contributes the weights themselves.
+        const arma::rowvec w = sqrt(weights.subvec(begin, end));
+        const arma::mat pb = predictors.cols(begin, end).each_row() % w;
+        const arma::rowvec rb = w % responses.subvec(begin, end);
+
+        localXtx.submat(offset, offset, dims - 1, dims - 1) += pb * pb.t();
+        localXty.subvec(offset, dims - 1) += pb * rb.t();
+        if (intercept)
+        {
+          localXtx(0, 0) += dot(w, w);
+          localXtx(arma::span(0, 0), arma::span(offset, dims - 1)) +=
+              (pb * w.t()).t();
+          localXty(0) += dot(w, rb);
+        }
+      }
+      else
+      {
+        const arma::mat& pb = predictors;
+
+        localXtx.submat(offset, offset, dims - 1, dims - 1) +=
+            pb.cols(begin, end) * pb.cols(begin, end).t();
+        localXty.subvec(offset, dims - 1) += pb.cols(begin, end) *
+            responses.subvec(begin, end).t();
+        if (intercept)
+        {
+          localXtx(0, 0) += (end - begin + 1);
+          localXtx(arma::span(0, 0), arma::span(offset, dims - 1)) +=
+              sum(pb.cols(begin, end), 1).t();
+          localXty(0) += accu(responses.subvec(begin, end));
+        }
+      }
+    }
+
+    #pragma omp critical
+    {
+      xtx += localXtx;
+      xty += localXty;
+    }
   }
+}
 
-  if (weights.n_elem > 0)
+void LinearRegression::SolveNormalEquations()
+{
+  if (xtx.n_rows == 0)
   {
-    p = p * diagmat(sqrt(weights));
-    r = sqrt(weights) % responses;
+    Log::Fatal << "LinearRegression::SolveNormalEquations(): no accumulated "
+        << "data; call Train() or AddChunk() first!" << std::endl;
   }
 
-  // Convert to this form:
-  // a * (X X^T) = y X^T.
-  // Then we'll use Armadillo to solve it.
-  // The total runtime of this should be O(d^2 N) + O(d^3) + O(dN).
-  // (assuming the SVD is used to solve it)
-  arma::mat cov = p * p.t() +
-      lambda * arma::eye<arma::mat>(p.n_rows, p.n_rows);
+  // Only the upper triangle of the accumulated X X^T is authoritative.
+  const arma::mat cov = arma::symmatu(xtx) +
+      lambda * arma::eye<arma::mat>(xtx.n_rows, xtx.n_rows);
 
-  parameters = arma::solve(cov, p * r.t());
-  return ComputeError(predictors, responses);
+  parameters = arma::solve(cov, xty);
 }
 
 void LinearRegression::Predict(const arma::mat& points,
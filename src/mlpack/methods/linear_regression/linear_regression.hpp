@@ -95,6 +95,33 @@ class LinearRegression
                const arma::rowvec& weights,
                const bool intercept = true);
 
+  /**
+   * Accumulate the normal equations (X X^T and X y^T) of the given column
+   * chunk into the model, without solving.  The accumulation is blocked and
+   * runs in parallel, and neither the chunk nor the implicit intercept row is
+   * ever copied, so arbitrarily large datasets can be streamed through one
+   * chunk at a time; call SolveNormalEquations() after the last chunk.  The
+   * first chunk fixes the dimensionality and the intercept setting; Train()
+   * resets the accumulated state.
+   *
+   * @param predictors X, a chunk of data points (one point per column).
+   * @param responses y, the responses of the points in the chunk.
+   * @param weights Observation weights (empty for unweighted learning).
+   * @param intercept Whether or not to fit an intercept term.
+   */
+  void AddChunk(const arma::mat& predictors,
+                const arma::rowvec& responses,
+                const arma::rowvec& weights = arma::rowvec(),
+                const bool intercept = true);
+
+  /**
+   * Solve the normal equations accumulated by AddChunk() (with the ridge
+   * term, if lambda is set) and store the result in the parameters.  The
+   * accumulated state is kept, so further chunks can be added and the system
+   * solved again.
+   */
+  void SolveNormalEquations();
+
   /**
    * Calculate y_i for each data point in points.
    *
@@ -162,6 +189,13 @@ class LinearRegression
 
   //! Indicates whether first parameter is intercept.
   bool intercept;
+
+  //! Accumulated X X^T of the chunks seen so far (upper triangle is
+  //! authoritative).  Rebuildable state; not serialized.
+  arma::mat xtx;
+
+  //! Accumulated X y^T of the chunks seen so far.
+  arma::vec xty;
 };
 
 } // namespace regression
@@ -17,6 +17,8 @@
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
 
+#include <map>
+
 // In case it hasn't been included yet.
 #include "linear_svm_function.hpp"
 
@@ -215,8 +217,7 @@ double LinearSVMFunction<MatType>::Evaluate(
   {
     scores = parameters.rows(0, dataset.n_rows - 1).t()
         * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
   }
 
   arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
@@ -444,7 +445,7 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   {
     scores = parameters.rows(0, dataset.n_rows - 1).t()
         * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, dataset.n_cols);
+        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
   }
 
   arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
@@ -480,7 +481,7 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   gradient += lambda * parameters;
 
   // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin.cols(firstId, lastId), 0.0, DBL_MAX));
+  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
   loss /= batchSize;
 
   // Adding the regularization term.
@@ -490,6 +491,330 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   return cost;
 }
 
+/**
+ * Sparse-data specializations.  The generic batch implementations above are
+ * correct for arma::sp_mat data, but they form several dense intermediates
+ * (the transposed data product, the repmat() of the bias term and the dense
+ * regularization contribution) whose size depends on the number of
+ * dimensions.  For very high-dimensional sparse data these intermediates
+ * dominate memory usage.  The specializations below compute the scores and
+ * the gradient by iterating over the nonzero entries of the batch only, so
+ * an update costs time proportional to the number of nonzeros involved
+ * (times the number of classes) plus a single pass over the parameters for
+ * the regularization term.
+ */
+template <>
+template <typename GradType>
+void LinearSVMFunction<arma::sp_mat>::Gradient(
+    const arma::mat& parameters,
+    const size_t firstId,
+    GradType& gradient,
+    const size_t batchSize)
+{
+  // Scores for each class, accumulated from the nonzero entries of each
+  // point in the batch.
+  arma::mat scores(numClasses, batchSize);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
+  {
+    if (fitIntercept)
+      scores.col(i) = parameters.row(dataset.n_rows).t();
+    else
+      scores.col(i).zeros();
+
+    for (arma::sp_mat::const_iterator it = dataset.begin_col(firstId + i);
+         it != dataset.end_col(firstId + i); ++it)
+      scores.col(i) += (*it) * parameters.row(it.row()).t();
+  }
+
+  // The contribution of each point to the gradient, as in the generic
+  // implementation; this matrix is small (numClasses x batchSize).
+  arma::mat difference(numClasses, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    // The label of the point is the row of the only nonzero entry in the
+    // ground truth column.
+    const size_t label = groundTruth.begin_col(firstId + i).row();
+
+    double positives = 0.0;
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      const double margin = scores(c, i) - scores(label, i) +
+          ((c == label) ? 0.0 : delta);
+      difference(c, i) = (margin > 0) ? 1.0 : 0.0;
+      positives += difference(c, i);
+    }
+    difference(label, i) = -positives;
+  }
+  difference /= batchSize;
+
+  // Accumulate the data term into per-thread sparse buffers keyed by the
+  // feature rows the batch actually touches, so that the parallel section
+  // writes memory proportional to the batch nonzeros rather than the model
+  // size, and no synchronization is needed until the merge.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+  numThreads = (size_t) omp_get_max_threads();
+  #endif
+  std::vector<std::map<size_t, arma::vec> > threadBuffers(numThreads);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
+  {
+    size_t threadId = 0;
+    #ifdef HAS_OPENMP
+    threadId = (size_t) omp_get_thread_num();
+    #endif
+    std::map<size_t, arma::vec>& buffer = threadBuffers[threadId];
+
+    for (arma::sp_mat::const_iterator it = dataset.begin_col(firstId + i);
+         it != dataset.end_col(firstId + i); ++it)
+    {
+      arma::vec& entry = buffer[it.row()];
+      if (entry.n_elem == 0)
+        entry.zeros(numClasses);
+      entry += (*it) * difference.col(i);
+    }
+
+    if (fitIntercept)
+    {
+      arma::vec& entry = buffer[dataset.n_rows];
+      if (entry.n_elem == 0)
+        entry.zeros(numClasses);
+      entry += difference.col(i);
+    }
+  }
+
+  // Start from the regularization term, then merge the per-thread buffers;
+  // only the touched feature rows are written.
+  gradient = lambda * parameters;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    for (std::map<size_t, arma::vec>::const_iterator it =
+         threadBuffers[t].begin(); it != threadBuffers[t].end(); ++it)
+    {
+      for (size_t c = 0; c < numClasses; ++c)
+        gradient(it->first, c) += it->second[c];
+    }
+  }
+}
+
+/**
+ * When the gradient itself is sparse (as with ensmallen's ParallelSGD), the
+ * dense regularization term would densify it, costing one entry per
+ * dimension per update.  Instead the gradient is assembled in triplet form
+ * from the nonzero entries of the batch, and the regularization is applied
+ * lazily: only the coordinates that are active in the batch are decayed.
+ * Coordinates that do not appear in any point of the batch receive no
+ * decay---the standard trade-off for sparse updates; with lambda = 0 the
+ * result is exact.
+ */
+template <>
+template <>
+inline void LinearSVMFunction<arma::sp_mat>::Gradient(
+    const arma::mat& parameters,
+    const size_t firstId,
+    arma::sp_mat& gradient,
+    const size_t batchSize)
+{
+  // Scores for each class, accumulated from the nonzero entries of each
+  // point in the batch.
+  arma::mat scores(numClasses, batchSize);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
+  {
+    if (fitIntercept)
+      scores.col(i) = parameters.row(dataset.n_rows).t();
+    else
+      scores.col(i).zeros();
+
+    for (arma::sp_mat::const_iterator it = dataset.begin_col(firstId + i);
+         it != dataset.end_col(firstId + i); ++it)
+      scores.col(i) += (*it) * parameters.row(it.row()).t();
+  }
+
+  // The contribution of each point to the gradient.
+  arma::mat difference(numClasses, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const size_t label = groundTruth.begin_col(firstId + i).row();
+
+    double positives = 0.0;
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      const double margin = scores(c, i) - scores(label, i) +
+          ((c == label) ? 0.0 : delta);
+      difference(c, i) = (margin > 0) ? 1.0 : 0.0;
+      positives += difference(c, i);
+    }
+    difference(label, i) = -positives;
+  }
+  difference /= batchSize;
+
+  // Assemble the gradient in triplet form; duplicate locations are summed by
+  // the batch constructor (as in GetGroundTruthMatrix()), and zero-valued
+  // entries are dropped.
+  const size_t batchNonzeros = dataset.col_ptrs[firstId + batchSize] -
+      dataset.col_ptrs[firstId];
+  const size_t entries = numClasses *
+      (batchNonzeros + (fitIntercept ? batchSize : 0));
+  arma::umat locations(2, entries);
+  arma::vec values(entries);
+
+  size_t loc = 0;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    for (arma::sp_mat::const_iterator it = dataset.begin_col(firstId + i);
+         it != dataset.end_col(firstId + i); ++it)
+    {
+      for (size_t c = 0; c < numClasses; ++c)
+      {
+        locations(0, loc) = it.row();
+        locations(1, loc) = c;
+        values(loc) = (*it) * difference(c, i);
+        ++loc;
+      }
+    }
+
+    if (fitIntercept)
+    {
+      for (size_t c = 0; c < numClasses; ++c)
+      {
+        locations(0, loc) = dataset.n_rows;
+        locations(1, loc) = c;
+        values(loc) = difference(c, i);
+        ++loc;
+      }
+    }
+  }
+
+  gradient = arma::sp_mat(true, locations, values, parameters.n_rows,
+      parameters.n_cols, true, true);
+
+  if (lambda != 0.0)
+  {
+    // Decay the active coordinates.  Writing a nonzero value through the
+    // iterator does not change the sparsity structure.
+    for (arma::sp_mat::iterator it = gradient.begin(); it != gradient.end();
+         ++it)
+    {
+      const double value = (*it) + lambda * parameters(it.row(), it.col());
+      if (value != 0.0)
+        (*it) = value;
+    }
+  }
+}
+
+//! Simultaneously evaluate the hinge loss and its gradient for a given batch,
+//! iterating over the nonzero entries of the batch only.
+template <>
+template <typename GradType>
+double LinearSVMFunction<arma::sp_mat>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t firstId,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  // Scores for each class, accumulated from the nonzero entries of each
+  // point in the batch.
+  arma::mat scores(numClasses, batchSize);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
+  {
+    if (fitIntercept)
+      scores.col(i) = parameters.row(dataset.n_rows).t();
+    else
+      scores.col(i).zeros();
+
+    for (arma::sp_mat::const_iterator it = dataset.begin_col(firstId + i);
+         it != dataset.end_col(firstId + i); ++it)
+      scores.col(i) += (*it) * parameters.row(it.row()).t();
+  }
+
+  // The contribution of each point to the gradient, along with the hinge
+  // loss accumulated from the positive margins.
+  double loss = 0.0;
+  arma::mat difference(numClasses, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const size_t label = groundTruth.begin_col(firstId + i).row();
+
+    double positives = 0.0;
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      const double margin = scores(c, i) - scores(label, i) +
+          ((c == label) ? 0.0 : delta);
+      if (margin > 0)
+      {
+        difference(c, i) = 1.0;
+        positives += 1.0;
+        loss += margin;
+      }
+      else
+      {
+        difference(c, i) = 0.0;
+      }
+    }
+    difference(label, i) = -positives;
+  }
+  difference /= batchSize;
+  loss /= batchSize;
+
+  // Accumulate the data term into per-thread sparse buffers keyed by the
+  // touched feature rows, as in the Gradient() specialization above.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+  numThreads = (size_t) omp_get_max_threads();
+  #endif
+  std::vector<std::map<size_t, arma::vec> > threadBuffers(numThreads);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
+  {
+    size_t threadId = 0;
+    #ifdef HAS_OPENMP
+    threadId = (size_t) omp_get_thread_num();
+    #endif
+    std::map<size_t, arma::vec>& buffer = threadBuffers[threadId];
+
+    for (arma::sp_mat::const_iterator it = dataset.begin_col(firstId + i);
+         it != dataset.end_col(firstId + i); ++it)
+    {
+      arma::vec& entry = buffer[it.row()];
+      if (entry.n_elem == 0)
+        entry.zeros(numClasses);
+      entry += (*it) * difference.col(i);
+    }
+
+    if (fitIntercept)
+    {
+      arma::vec& entry = buffer[dataset.n_rows];
+      if (entry.n_elem == 0)
+        entry.zeros(numClasses);
+      entry += difference.col(i);
+    }
+  }
+
+  // Start from the regularization term, then merge the per-thread buffers;
+  // only the touched feature rows are written.
+  gradient = lambda * parameters;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    for (std::map<size_t, arma::vec>::const_iterator it =
+         threadBuffers[t].begin(); it != threadBuffers[t].end(); ++it)
+    {
+      for (size_t c = 0; c < numClasses; ++c)
+        gradient(it->first, c) += it->second[c];
+    }
+  }
+
+  // Adding the regularization term.
+  const double regularization = 0.5 * lambda *
+      arma::dot(parameters, parameters);
+
+  return loss + regularization;
+}
+
 template <typename MatType>
 size_t LinearSVMFunction<MatType>::NumFunctions() const
 {
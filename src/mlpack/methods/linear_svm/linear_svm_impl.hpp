@@ -18,6 +18,9 @@
 namespace mlpack {
 namespace svm {
 
+//! Number of columns scored as one unit of parallel work in batch Classify().
+static const size_t svmClassifyBlockSize = 1024;
+
 template <typename MatType>
 template <typename OptimizerType, typename... CallbackTypes>
 LinearSVM<MatType>::LinearSVM(
@@ -171,15 +174,31 @@ void LinearSVM<MatType>::Classify(
 {
   util::CheckSameDimensionality(data, FeatureSize(), "LinearSVM::Classify()");
 
-  if (fitIntercept)
-  {
-    scores = parameters.rows(0, parameters.n_rows - 2).t() * data
-        + arma::repmat(parameters.row(parameters.n_rows - 1).t(), 1,
-        data.n_cols);
-  }
-  else
+  scores.set_size(parameters.n_cols, data.n_cols);
+
+  // Score one block of columns per unit of parallel work; every block writes
+  // to its own part of the output matrix.
+  const size_t blocks =
+      (data.n_cols + svmClassifyBlockSize - 1) / svmClassifyBlockSize;
+  #pragma omp parallel for default(shared)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
   {
-    scores = parameters.t() * data;
+    const size_t begin = b * svmClassifyBlockSize;
+    const size_t end = std::min(begin + svmClassifyBlockSize,
+        (size_t) data.n_cols) - 1;
+
+    if (fitIntercept)
+    {
+      scores.cols(begin, end) =
+          parameters.rows(0, parameters.n_rows - 2).t() *
+              data.cols(begin, end) +
+          arma::repmat(parameters.row(parameters.n_rows - 1).t(), 1,
+              end - begin + 1);
+    }
+    else
+    {
+      scores.cols(begin, end) = parameters.t() * data.cols(begin, end);
+    }
   }
 }
 
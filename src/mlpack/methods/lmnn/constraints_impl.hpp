@@ -143,6 +143,10 @@ void Constraints<MetricType>::TargetNeighbors(arma::Mat<size_t>& outputMatrix,
     // Calculate Target Neighbors.
     subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
+    // The batch contains no point of this class; don't build a tree for it.
+    if (subIndexSame.n_elem == 0)
+      continue;
+
     // Perform KNN search with same class points as both reference
     // set and query set.
     knn.Train(dataset.cols(indexSame[i]));
@@ -266,6 +270,10 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
     // Calculate impostors.
     subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
+    // The batch contains no point of this class; don't build a tree for it.
+    if (subIndexSame.n_elem == 0)
+      continue;
+
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -315,6 +323,10 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
     // Calculate impostors.
     subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
+    // The batch contains no point of this class; don't build a tree for it.
+    if (subIndexSame.n_elem == 0)
+      continue;
+
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -348,9 +360,6 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
   arma::Mat<size_t> neighbors;
   arma::mat distances;
 
@@ -363,6 +372,17 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
     subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
         uniqueLabels[i]);
 
+    // No point of this class violated its bound, so the reference tree for
+    // this class does not need to be built at all.
+    if (subIndexSame.n_elem == 0)
+      continue;
+
+    // Building a tree over the reference set costs more than a linear scan
+    // when only a handful of queries survived the bounds, so fall back to
+    // brute-force search in that case.
+    KNN knn(subIndexSame.n_elem < std::log2(indexDiff[i].n_elem) ?
+        neighbor::NAIVE_MODE : neighbor::DUAL_TREE_MODE);
+
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -226,6 +226,10 @@ class LMNNFunction
   arma::mat maxImpNorm;
   //! Holds previous transformation matrix. Used for L-BFGS like optimizer.
   arma::mat transformationOld;
+  //! Holds the transformation matrix under which the impostors were last
+  //! recomputed.  The impostor pruning bounds measure drift against this
+  //! matrix, so they stay valid across several optimizer steps.
+  arma::mat transformationImp;
   //! Holds previous transformation matrices.
   std::vector<arma::mat> oldTransformationMatrices;
   //! Holds number of points which are using each transformation matrix.
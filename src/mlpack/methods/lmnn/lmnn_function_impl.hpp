@@ -226,6 +226,10 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
 
   if (!transformationOld.is_empty() && iteration++ % range == 0)
   {
+    // The stored impostors are only stale by the total drift of the
+    // transformation since they were last recomputed, not by the last step.
+    const double impDiff = arma::norm(transformation - transformationImp);
+
     if (impBounds)
     {
       // Track number of data points to use for impostors calculatiom.
@@ -233,28 +237,36 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
 
       for (size_t i = 0; i < dataset.n_cols; ++i)
       {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
+        if (impDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
             norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
         {
           points(numPoints++) = i;
         }
       }
 
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
+      // Re-calculate impostors of points whose bound is violated.  If no
+      // bound is violated (e.g. a line search re-evaluating the same
+      // transformation), no search trees need to be built at all.
+      if (numPoints > 0)
+      {
+        constraint.Impostors(impostors, distance,
+            transformedDataset, labels, norm, points, numPoints);
+      }
     }
-    else
+    else if (impDiff > 0)
     {
       // Re-calculate impostors on transformed dataset.
       constraint.Impostors(impostors, distance, transformedDataset, labels,
           norm);
     }
+
+    transformationImp = transformation;
   }
   else if (iteration++ % range == 0)
   {
     // Re-calculate impostors on transformed dataset.
     constraint.Impostors(impostors, distance, transformedDataset, labels, norm);
+    transformationImp = transformation;
   }
 
   for (size_t i = 0; i < dataset.n_cols; ++i)
@@ -373,9 +385,13 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
       }
     }
 
-    // Re-calculate impostors on transformed dataset.
-    constraint.Impostors(impostors, distance,
-        transformedDataset, labels, norm, points, numPoints);
+    // Re-calculate impostors of points whose bound is violated; if none is,
+    // no search trees need to be built at all.
+    if (numPoints > 0)
+    {
+      constraint.Impostors(impostors, distance,
+          transformedDataset, labels, norm, points, numPoints);
+    }
   }
   else if (iteration++ % range == 0)
   {
@@ -480,6 +496,10 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
     // Calculate norm of change in transformation.
     transformationDiff = arma::norm(transformation - transformationOld);
 
+    // The stored impostors are only stale by the total drift of the
+    // transformation since they were last recomputed, not by the last step.
+    const double impDiff = arma::norm(transformation - transformationImp);
+
     if (impBounds)
     {
       // Track number of data points to use for impostors calculatiom.
@@ -487,29 +507,37 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
 
       for (size_t i = 0; i < dataset.n_cols; ++i)
       {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
+        if (impDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
             norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
         {
           points(numPoints++) = i;
         }
       }
 
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
+      // Re-calculate impostors of points whose bound is violated.  If no
+      // bound is violated (e.g. a line search re-evaluating the same
+      // transformation), no search trees need to be built at all.
+      if (numPoints > 0)
+      {
+        constraint.Impostors(impostors, distance,
+            transformedDataset, labels, norm, points, numPoints);
+      }
     }
-    else
+    else if (impDiff > 0)
     {
       // Re-calculate impostors on transformed dataset.
       constraint.Impostors(impostors, distance, transformedDataset, labels,
           norm);
     }
+
+    transformationImp = transformation;
   }
   else if (iteration++ % range == 0)
   {
       // Re-calculate impostors on transformed dataset.
       constraint.Impostors(impostors, distance, transformedDataset, labels,
           norm);
+      transformationImp = transformation;
   }
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
@@ -633,9 +661,13 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
       }
     }
 
-    // Re-calculate impostors on transformed dataset.
-    constraint.Impostors(impostors, distance,
-        transformedDataset, labels, norm, points, numPoints);
+    // Re-calculate impostors of points whose bound is violated; if none is,
+    // no search trees need to be built at all.
+    if (numPoints > 0)
+    {
+      constraint.Impostors(impostors, distance,
+          transformedDataset, labels, norm, points, numPoints);
+    }
   }
   else if (iteration++ % range == 0)
   {
@@ -755,6 +787,10 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
 
   if (!transformationOld.is_empty() && iteration++ % range == 0)
   {
+    // The stored impostors are only stale by the total drift of the
+    // transformation since they were last recomputed, not by the last step.
+    const double impDiff = arma::norm(transformation - transformationImp);
+
     if (impBounds)
     {
       // Track number of data points to use for impostors calculatiom.
@@ -762,29 +798,37 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
 
       for (size_t i = 0; i < dataset.n_cols; ++i)
       {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
+        if (impDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
             norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
         {
           points(numPoints++) = i;
         }
       }
 
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
+      // Re-calculate impostors of points whose bound is violated.  If no
+      // bound is violated (e.g. a line search re-evaluating the same
+      // transformation), no search trees need to be built at all.
+      if (numPoints > 0)
+      {
+        constraint.Impostors(impostors, distance,
+            transformedDataset, labels, norm, points, numPoints);
+      }
     }
-    else
+    else if (impDiff > 0)
     {
       // Re-calculate impostors on transformed dataset.
       constraint.Impostors(impostors, distance, transformedDataset, labels,
           norm);
     }
+
+    transformationImp = transformation;
   }
   else if (iteration++ % range == 0)
   {
       // Re-calculate impostors on transformed dataset.
       constraint.Impostors(impostors, distance, transformedDataset, labels,
           norm);
+      transformationImp = transformation;
   }
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
@@ -915,9 +959,13 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
       }
     }
 
-    // Re-calculate impostors on transformed dataset.
-    constraint.Impostors(impostors, distance,
-        transformedDataset, labels, norm, points, numPoints);
+    // Re-calculate impostors of points whose bound is violated; if none is,
+    // no search trees need to be built at all.
+    if (numPoints > 0)
+    {
+      constraint.Impostors(impostors, distance,
+          transformedDataset, labels, norm, points, numPoints);
+    }
   }
   else if (iteration++ % range == 0)
   {
@@ -39,6 +39,9 @@ template<typename MatType = arma::mat>
 class LogisticRegression
 {
  public:
+  //! The element type of the data (and of the learned parameters).
+  typedef typename MatType::elem_type ElemType;
+
   /**
    * Construct the LogisticRegression class with the given labeled training
    * data.  This will train the model.  Optionally, specify lambda, which is the
@@ -76,7 +79,7 @@ class LogisticRegression
    */
   LogisticRegression(const MatType& predictors,
                      const arma::Row<size_t>& responses,
-                     const arma::rowvec& initialPoint,
+                     const arma::Row<ElemType>& initialPoint,
                      const double lambda = 0);
 
   /**
@@ -159,10 +162,67 @@ class LogisticRegression
                OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Incrementally train the model on a new batch of data.  The batch is
+   * appended to an internal buffer of previously seen points; on every call,
+   * the instance weights of the buffered points are multiplied by the given
+   * decay factor, and points whose weight falls below 1e-4 are dropped, so
+   * that the buffer tracks a decayed window of the stream.  The optimization
+   * warm-starts from the current parameters, so frequent small retrains
+   * converge in a few iterations instead of rediscovering the solution from
+   * scratch.  With decay = 1, every previously seen point keeps full weight.
+   *
+   * The buffered data is not serialized with the model, so incremental
+   * training state does not survive a save/load round trip.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors New batch of training points.
+   * @param responses Outputs for the new batch of training points.
+   * @param decay Multiplicative decay applied to the weights of previously
+   *      seen points on each call; must be in (0, 1].
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error)
+   */
+  template<typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
+  double IncrementalTrain(const MatType& predictors,
+                          const arma::Row<size_t>& responses,
+                          const double decay = 1.0,
+                          CallbackTypes&&... callbacks);
+
+  /**
+   * Incrementally train the model on a new batch of data, with the given
+   * instantiated optimizer.  Passing the same optimizer instance on every
+   * call keeps its configuration under the caller's control across retrains.
+   * See the other IncrementalTrain() overload for the buffering and decay
+   * semantics.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors New batch of training points.
+   * @param responses Outputs for the new batch of training points.
+   * @param decay Multiplicative decay applied to the weights of previously
+   *      seen points on each call; must be in (0, 1].
+   * @param optimizer Instantiated optimizer with instantiated error function.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error)
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double IncrementalTrain(const MatType& predictors,
+                          const arma::Row<size_t>& responses,
+                          const double decay,
+                          OptimizerType& optimizer,
+                          CallbackTypes&&... callbacks);
+
+  //! Return the number of points currently buffered for incremental training.
+  size_t BufferedPoints() const { return bufferedPredictors.n_cols; }
+
   //! Return the parameters (the b vector).
-  const arma::rowvec& Parameters() const { return parameters; }
+  const arma::Row<ElemType>& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
-  arma::rowvec& Parameters() { return parameters; }
+  arma::Row<ElemType>& Parameters() { return parameters; }
 
   //! Return the lambda value for L2-regularization.
   const double& Lambda() const { return lambda; }
@@ -206,7 +266,7 @@ class LogisticRegression
    * @param probabilities Class probabilities for each point (output).
    */
   void Classify(const MatType& dataset,
-                arma::mat& probabilities) const;
+                arma::Mat<ElemType>& probabilities) const;
 
   /**
    * Compute the accuracy of the model on the given predictors and responses,
@@ -243,9 +303,16 @@ class LogisticRegression
 
  private:
   //! Vector of trained parameters (size: dimensionality plus one).
-  arma::rowvec parameters;
+  arma::Row<ElemType> parameters;
   //! L2-regularization penalty parameter.
   double lambda;
+  //! Points buffered for incremental training, oldest first.  Not serialized,
+  //! since it is training state, not part of the model.
+  MatType bufferedPredictors;
+  //! Responses of the buffered points.
+  arma::Row<size_t> bufferedResponses;
+  //! Decayed instance weights of the buffered points.
+  arma::Row<ElemType> bufferedWeights;
 };
 
 } // namespace regression
@@ -30,6 +30,11 @@ template<typename MatType = arma::mat>
 class LogisticRegressionFunction
 {
  public:
+  //! The element type of the data; the optimization runs in this precision.
+  typedef typename MatType::elem_type ElemType;
+  //! The (dense) type of the parameters and gradients.
+  typedef arma::Mat<ElemType> DenseMatType;
+
   /**
    * Creates the LogisticRegressionFunction.
    *
@@ -51,6 +56,15 @@ class LogisticRegressionFunction
   //! Return the vector of responses.
   const arma::Row<size_t>& Responses() const { return responses; }
 
+  //! Return the instance weights (empty if the objective is unweighted).
+  const arma::Row<ElemType>& InstanceWeights() const { return instanceWeights; }
+  //! Modify the instance weights.  If set, the vector must hold one weight
+  //! per point in the predictors, and each point's contribution to the
+  //! objective and gradient is multiplied by its weight.  An empty vector
+  //! means every point has unit weight.  The regularization term is not
+  //! affected by the weights.
+  arma::Row<ElemType>& InstanceWeights() { return instanceWeights; }
+
   /**
   * Shuffle the order of function visitation.  This may be called by the optimizer.
   */
@@ -67,7 +81,7 @@ class LogisticRegressionFunction
    *
    * @param parameters Vector of logistic regression parameters.
    */
-  double Evaluate(const arma::mat& parameters) const;
+  double Evaluate(const DenseMatType& parameters) const;
 
   /**
    * Evaluate the logistic regression log-likelihood function with the given
@@ -86,7 +100,7 @@ class LogisticRegressionFunction
    * @param batchSize Number of points to be passed at a time to use for
    *     objective function evaluation.
    */
-  double Evaluate(const arma::mat& parameters,
+  double Evaluate(const DenseMatType& parameters,
                   const size_t begin,
                   const size_t batchSize = 1) const;
 
@@ -97,7 +111,8 @@ class LogisticRegressionFunction
    * @param parameters Vector of logistic regression parameters.
    * @param gradient Vector to output gradient into.
    */
-  void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
+  void Gradient(const DenseMatType& parameters,
+                DenseMatType& gradient) const;
 
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
@@ -113,7 +128,7 @@ class LogisticRegressionFunction
    *     function gradient evaluation.
    */
   template<typename GradType>
-  void Gradient(const arma::mat& parameters,
+  void Gradient(const DenseMatType& parameters,
                 const size_t begin,
                 GradType& gradient,
                 const size_t batchSize = 1) const;
@@ -129,7 +144,7 @@ class LogisticRegressionFunction
    *    be computed.
    * @param gradient Sparse matrix to output gradient into.
    */
-  void PartialGradient(const arma::mat& parameters,
+  void PartialGradient(const DenseMatType& parameters,
                        const size_t j,
                        arma::sp_mat& gradient) const;
 
@@ -138,7 +153,7 @@ class LogisticRegressionFunction
    * log-likelihood function simultaneously with the given parameters.
    */
   template<typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters,
+  double EvaluateWithGradient(const DenseMatType& parameters,
                               GradType& gradient) const;
 
   /**
@@ -147,7 +162,7 @@ class LogisticRegressionFunction
    * the given batch size from a given point in the dataset.
    */
   template<typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters,
+  double EvaluateWithGradient(const DenseMatType& parameters,
                               const size_t begin,
                               GradType& gradient,
                               const size_t batchSize = 1) const;
@@ -165,6 +180,8 @@ class LogisticRegressionFunction
   //! The vector of responses to the input data points.  This is an alias until
   //! shuffling is done.
   arma::Row<size_t> responses;
+  //! Per-point weights of the objective; empty means unit weights.
+  arma::Row<ElemType> instanceWeights;
   //! The regularization parameter for L2-regularization.
   double lambda;
 };
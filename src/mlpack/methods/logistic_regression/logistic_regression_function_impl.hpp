@@ -50,7 +50,18 @@ void LogisticRegressionFunction<MatType>::Shuffle()
   MatType newPredictors;
   arma::Row<size_t> newResponses;
 
-  math::ShuffleData(predictors, responses, newPredictors, newResponses);
+  if (instanceWeights.n_elem > 0)
+  {
+    // The weights have to be permuted along with the points.
+    arma::Row<ElemType> newWeights;
+    math::ShuffleData(predictors, responses, instanceWeights, newPredictors,
+        newResponses, newWeights);
+    instanceWeights = std::move(newWeights);
+  }
+  else
+  {
+    math::ShuffleData(predictors, responses, newPredictors, newResponses);
+  }
 
   // If we are an alias, make sure we don't write to the original data.
   math::ClearAlias(predictors);
@@ -67,7 +78,7 @@ void LogisticRegressionFunction<MatType>::Shuffle()
  */
 template<typename MatType>
 double LogisticRegressionFunction<MatType>::Evaluate(
-    const arma::mat& parameters) const
+    const DenseMatType& parameters) const
 {
   // The objective function is the log-likelihood function (w is the parameters
   // vector for the model; y is the responses; x is the predictors; sig() is the
@@ -84,7 +95,7 @@ double LogisticRegressionFunction<MatType>::Evaluate(
 
   // Calculate vectors of sigmoids.  The intercept term is parameters(0, 0) and
   // does not need to be multiplied by any of the predictors.
-  const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+  const arma::Row<ElemType> sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) * predictors)));
 
   // Assemble full objective function.  Often the objective function and the
@@ -93,9 +104,12 @@ double LogisticRegressionFunction<MatType>::Evaluate(
   // terms for computational efficiency.  Note that the conversion causes some
   // copy and slowdown, but this is so negligible compared to the rest of the
   // calculation it is not worth optimizing for.
-  const double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoid %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  const arma::Row<ElemType> logLikelihoods = arma::log(1.0 -
+      arma::conv_to<arma::Row<ElemType>>::from(responses) + sigmoid %
+      (2 * arma::conv_to<arma::Row<ElemType>>::from(responses) - 1.0));
+  const double result = (instanceWeights.n_elem > 0) ?
+      arma::accu(instanceWeights % logLikelihoods) :
+      arma::accu(logLikelihoods);
 
   // Invert the result, because it's a minimization.
   return regularization - result;
@@ -107,7 +121,7 @@ double LogisticRegressionFunction<MatType>::Evaluate(
  */
 template<typename MatType>
 double LogisticRegressionFunction<MatType>::Evaluate(
-                  const arma::mat& parameters,
+                  const DenseMatType& parameters,
                   const size_t begin,
                   const size_t batchSize) const
 {
@@ -118,15 +132,19 @@ double LogisticRegressionFunction<MatType>::Evaluate(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+  const arma::Row<ElemType> sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) *
       predictors.cols(begin, begin + batchSize - 1))));
 
   // Compute the objective for the given batch size from a given point.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
+  arma::Row<ElemType> respD = arma::conv_to<arma::Row<ElemType>>::from(responses.subvec(begin,
       begin + batchSize - 1));
-  const double result = arma::accu(arma::log(1.0 - respD + sigmoid %
-      (2 * respD - 1.0)));
+  const arma::Row<ElemType> logLikelihoods = arma::log(1.0 - respD + sigmoid %
+      (2 * respD - 1.0));
+  const double result = (instanceWeights.n_elem > 0) ?
+      arma::accu(instanceWeights.subvec(begin, begin + batchSize - 1) %
+          logLikelihoods) :
+      arma::accu(logLikelihoods);
 
   // Invert the result, because it's a minimization.
   return regularization - result;
@@ -135,20 +153,26 @@ double LogisticRegressionFunction<MatType>::Evaluate(
 //! Evaluate the gradient of the logistic regression objective function.
 template<typename MatType>
 void LogisticRegressionFunction<MatType>::Gradient(
-    const arma::mat& parameters,
-    arma::mat& gradient) const
+    const DenseMatType& parameters,
+    DenseMatType& gradient) const
 {
   // Regularization term.
-  arma::mat regularization;
+  DenseMatType regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
 
-  const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
+  const arma::Row<ElemType> sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
       - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
 
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::Row<ElemType> diffs = sigmoids -
+      arma::conv_to<arma::Row<ElemType>>::from(responses);
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights;
+
   gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient[0] = arma::accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = diffs * predictors.t() +
+      regularization;
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
@@ -156,27 +180,32 @@ void LogisticRegressionFunction<MatType>::Gradient(
 template<typename MatType>
 template<typename GradType>
 void LogisticRegressionFunction<MatType>::Gradient(
-                const arma::mat& parameters,
+                const DenseMatType& parameters,
                 const size_t begin,
                 GradType& gradient,
                 const size_t batchSize) const
 {
   // Regularization term.
-  arma::mat regularization;
+  DenseMatType regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1)
       / predictors.n_cols * batchSize;
 
-  const arma::rowvec exponents = parameters(0, 0) +
+  const arma::Row<ElemType> exponents = parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) *
       predictors.cols(begin, begin + batchSize - 1);
   // Calculating the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
+  const arma::Row<ElemType> sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
+
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::Row<ElemType> diffs = sigmoids -
+      arma::conv_to<arma::Row<ElemType>>::from(responses.subvec(begin,
+      begin + batchSize - 1));
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights.subvec(begin, begin + batchSize - 1);
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
+  gradient[0] = arma::accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = diffs *
       predictors.cols(begin, begin + batchSize - 1).t() + regularization;
 }
 
@@ -186,12 +215,14 @@ void LogisticRegressionFunction<MatType>::Gradient(
  */
 template <typename MatType>
 void LogisticRegressionFunction<MatType>::PartialGradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     const size_t j,
     arma::sp_mat& gradient) const
 {
-  const arma::rowvec diffs = responses - (1 / (1 + arma::exp(-parameters(0, 0)
+  arma::Row<ElemType> diffs = responses - (1 / (1 + arma::exp(-parameters(0, 0)
       - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights;
 
   gradient.set_size(arma::size(parameters));
 
@@ -209,11 +240,11 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
 template<typename MatType>
 template<typename GradType>
 double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     GradType& gradient) const
 {
   // Regularization term.
-  arma::mat regularization = lambda *
+  DenseMatType regularization = lambda *
       parameters.tail_cols(parameters.n_elem - 1);
 
   const double objectiveRegularization = lambda / 2.0 *
@@ -221,18 +252,27 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+  const arma::Row<ElemType> sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) * predictors)));
 
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::Row<ElemType> diffs = sigmoids -
+      arma::conv_to<arma::Row<ElemType>>::from(responses);
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights;
+
   gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient[0] = arma::accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = diffs * predictors.t() +
+      regularization;
 
   // Now compute the objective function using the sigmoids.
-  double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoids %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  const arma::Row<ElemType> logLikelihoods = arma::log(1.0 -
+      arma::conv_to<arma::Row<ElemType>>::from(responses) + sigmoids %
+      (2 * arma::conv_to<arma::Row<ElemType>>::from(responses) - 1.0));
+  const double result = (instanceWeights.n_elem > 0) ?
+      arma::accu(instanceWeights % logLikelihoods) :
+      arma::accu(logLikelihoods);
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
@@ -241,13 +281,13 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
 template<typename MatType>
 template<typename GradType>
 double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     const size_t begin,
     GradType& gradient,
     const size_t batchSize) const
 {
   // Regularization term.
-  arma::mat regularization =
+  DenseMatType regularization =
       lambda * parameters.tail_cols(parameters.n_elem - 1) / predictors.n_cols *
       batchSize;
 
@@ -257,22 +297,302 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+  const arma::Row<ElemType> sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) *
       predictors.cols(begin, begin + batchSize - 1))));
 
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::Row<ElemType> diffs = sigmoids -
+      arma::conv_to<arma::Row<ElemType>>::from(responses.subvec(begin,
+      begin + batchSize - 1));
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights.subvec(begin, begin + batchSize - 1);
+
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
+  gradient[0] = arma::accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = diffs *
       predictors.cols(begin, begin + batchSize - 1).t() + regularization;
 
+  // Now compute the objective function using the sigmoids.
+  arma::Row<ElemType> respD = arma::conv_to<arma::Row<ElemType>>::from(responses.subvec(begin,
+      begin + batchSize - 1));
+  const arma::Row<ElemType> logLikelihoods = arma::log(1.0 - respD + sigmoids %
+      (2 * respD - 1.0));
+  const double result = (instanceWeights.n_elem > 0) ?
+      arma::accu(instanceWeights.subvec(begin, begin + batchSize - 1) %
+          logLikelihoods) :
+      arma::accu(logLikelihoods);
+
+  // Invert the result, because it's a minimization.
+  return objectiveRegularization - result;
+}
+
+/**
+ * Sparse-data specializations.  The generic implementations above are correct
+ * for arma::sp_mat predictors, but the expression (sigmoids - responses) *
+ * predictors.t() materializes a transposed copy of the predictors on every
+ * call, and the regularization temporary is a dense vector with one element
+ * per dimension.  For very high-dimensional sparse data (e.g. text features),
+ * those intermediates dominate memory usage.  The specializations below
+ * iterate over the nonzero entries of the predictors directly, so a gradient
+ * evaluation costs time proportional to the number of nonzeros involved plus
+ * a single pass over the parameters for the regularization term.
+ */
+template<>
+inline void LogisticRegressionFunction<arma::sp_mat>::Gradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
+{
+  // This sparse product costs O(nonzeros); no transposed copy is needed.
+  const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
+      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::rowvec diffs = sigmoids -
+      arma::conv_to<arma::rowvec>::from(responses);
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights;
+
+  // Start from the regularization term, then accumulate the data term from
+  // the nonzero entries of each point.
+  gradient.set_size(arma::size(parameters));
+  gradient[0] = arma::accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = lambda *
+      parameters.tail_cols(parameters.n_elem - 1);
+
+  for (arma::sp_mat::const_iterator it = predictors.begin();
+       it != predictors.end(); ++it)
+  {
+    gradient[it.row() + 1] += diffs[it.col()] * (*it);
+  }
+}
+
+//! Evaluate the gradient of the logistic regression objective function for a
+//! given batch size, iterating over the nonzero entries of the batch only.
+template<>
+template<typename GradType>
+void LogisticRegressionFunction<arma::sp_mat>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  // Calculate the sigmoid function values from the nonzero entries of each
+  // point in the batch.
+  arma::rowvec sigmoids(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    double exponent = parameters(0, 0);
+    for (arma::sp_mat::const_iterator it = predictors.begin_col(begin + i);
+         it != predictors.end_col(begin + i); ++it)
+      exponent += parameters[it.row() + 1] * (*it);
+    sigmoids[i] = 1.0 / (1.0 + std::exp(-exponent));
+  }
+
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::rowvec diffs = sigmoids -
+      arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
+      begin + batchSize - 1));
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights.subvec(begin, begin + batchSize - 1);
+
+  gradient.set_size(parameters.n_rows, parameters.n_cols);
+  gradient[0] = arma::accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = lambda *
+      parameters.tail_cols(parameters.n_elem - 1) / predictors.n_cols *
+      batchSize;
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    for (arma::sp_mat::const_iterator it = predictors.begin_col(begin + i);
+         it != predictors.end_col(begin + i); ++it)
+      gradient[it.row() + 1] += diffs[i] * (*it);
+  }
+}
+
+/**
+ * When the gradient itself is sparse (as with ensmallen's ParallelSGD), the
+ * dense regularization term would densify it, costing one entry per dimension
+ * per update.  Instead the gradient is assembled in triplet form from the
+ * nonzero entries of the batch, and the regularization is applied lazily:
+ * only the coordinates that are active in the batch are decayed.  Coordinates
+ * that do not appear in any point of the batch receive no decay---the
+ * standard trade-off for sparse updates; with lambda = 0 the result is exact.
+ */
+template<>
+template<>
+inline void LogisticRegressionFunction<arma::sp_mat>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::sp_mat& gradient,
+    const size_t batchSize) const
+{
+  // Calculate the sigmoid function values from the nonzero entries of each
+  // point in the batch.
+  arma::rowvec sigmoids(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    double exponent = parameters(0, 0);
+    for (arma::sp_mat::const_iterator it = predictors.begin_col(begin + i);
+         it != predictors.end_col(begin + i); ++it)
+      exponent += parameters[it.row() + 1] * (*it);
+    sigmoids[i] = 1.0 / (1.0 + std::exp(-exponent));
+  }
+
+  // Assemble the gradient in triplet form; duplicate locations are summed by
+  // the batch constructor (as in LinearSVMFunction::GetGroundTruthMatrix()).
+  const size_t batchNonzeros = predictors.col_ptrs[begin + batchSize] -
+      predictors.col_ptrs[begin];
+  arma::umat locations(2, batchNonzeros + 1);
+  arma::vec values(batchNonzeros + 1);
+
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::rowvec diffs = sigmoids -
+      arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
+      begin + batchSize - 1));
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights.subvec(begin, begin + batchSize - 1);
+
+  // The intercept term.
+  locations(0, 0) = 0;
+  locations(1, 0) = 0;
+  values(0) = arma::accu(diffs);
+
+  size_t loc = 1;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    for (arma::sp_mat::const_iterator it = predictors.begin_col(begin + i);
+         it != predictors.end_col(begin + i); ++it)
+    {
+      locations(0, loc) = 0;
+      locations(1, loc) = it.row() + 1;
+      values(loc) = diffs[i] * (*it);
+      ++loc;
+    }
+  }
+
+  gradient = arma::sp_mat(true, locations, values, parameters.n_rows,
+      parameters.n_cols, true, true);
+
+  if (lambda != 0.0)
+  {
+    // Decay the active coordinates.  Writing a nonzero value through the
+    // iterator does not change the sparsity structure.
+    const double scale = lambda * batchSize / (double) predictors.n_cols;
+    for (arma::sp_mat::iterator it = gradient.begin(); it != gradient.end();
+         ++it)
+    {
+      if (it.col() == 0)
+        continue; // The intercept is not regularized.
+
+      const double value = (*it) + scale * parameters[it.col()];
+      if (value != 0.0)
+        (*it) = value;
+    }
+  }
+}
+
+//! Simultaneously evaluate the objective function and its gradient, without
+//! materializing a transposed copy of the sparse predictors.
+template<>
+template<typename GradType>
+double LogisticRegressionFunction<arma::sp_mat>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    GradType& gradient) const
+{
+  const double objectiveRegularization = lambda / 2.0 *
+      arma::dot(parameters.tail_cols(parameters.n_elem - 1),
+                parameters.tail_cols(parameters.n_elem - 1));
+
+  // Calculate the sigmoid function values with a sparse product.
+  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::rowvec diffs = sigmoids -
+      arma::conv_to<arma::rowvec>::from(responses);
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights;
+
+  gradient.set_size(arma::size(parameters));
+  gradient[0] = arma::accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = lambda *
+      parameters.tail_cols(parameters.n_elem - 1);
+
+  for (arma::sp_mat::const_iterator it = predictors.begin();
+       it != predictors.end(); ++it)
+  {
+    gradient[it.row() + 1] += diffs[it.col()] * (*it);
+  }
+
+  // Now compute the objective function using the sigmoids.
+  const arma::rowvec logLikelihoods = arma::log(1.0 -
+      arma::conv_to<arma::rowvec>::from(responses) + sigmoids %
+      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0));
+  const double result = (instanceWeights.n_elem > 0) ?
+      arma::accu(instanceWeights % logLikelihoods) :
+      arma::accu(logLikelihoods);
+
+  // Invert the result, because it's a minimization.
+  return objectiveRegularization - result;
+}
+
+//! Simultaneously evaluate the objective function and its gradient for a
+//! given batch size, iterating over the nonzero entries of the batch only.
+template<>
+template<typename GradType>
+double LogisticRegressionFunction<arma::sp_mat>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  const double objectiveRegularization = lambda *
+      (batchSize / (2.0 * predictors.n_cols)) *
+      arma::dot(parameters.tail_cols(parameters.n_elem - 1),
+                parameters.tail_cols(parameters.n_elem - 1));
+
+  // Calculate the sigmoid function values from the nonzero entries of each
+  // point in the batch.
+  arma::rowvec sigmoids(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    double exponent = parameters(0, 0);
+    for (arma::sp_mat::const_iterator it = predictors.begin_col(begin + i);
+         it != predictors.end_col(begin + i); ++it)
+      exponent += parameters[it.row() + 1] * (*it);
+    sigmoids[i] = 1.0 / (1.0 + std::exp(-exponent));
+  }
+
+  // Each point's residual is scaled by its weight, if weights are in use.
+  arma::rowvec diffs = sigmoids -
+      arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
+      begin + batchSize - 1));
+  if (instanceWeights.n_elem > 0)
+    diffs %= instanceWeights.subvec(begin, begin + batchSize - 1);
+
+  gradient.set_size(parameters.n_rows, parameters.n_cols);
+  gradient[0] = arma::accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = lambda *
+      parameters.tail_cols(parameters.n_elem - 1) / predictors.n_cols *
+      batchSize;
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    for (arma::sp_mat::const_iterator it = predictors.begin_col(begin + i);
+         it != predictors.end_col(begin + i); ++it)
+      gradient[it.row() + 1] += diffs[i] * (*it);
+  }
+
   // Now compute the objective function using the sigmoids.
   arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
       begin + batchSize - 1));
-  const double result = arma::accu(arma::log(1.0 - respD + sigmoids %
-      (2 * respD - 1.0)));
+  const arma::rowvec logLikelihoods = arma::log(1.0 - respD + sigmoids %
+      (2 * respD - 1.0));
+  const double result = (instanceWeights.n_elem > 0) ?
+      arma::accu(instanceWeights.subvec(begin, begin + batchSize - 1) %
+          logLikelihoods) :
+      arma::accu(logLikelihoods);
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
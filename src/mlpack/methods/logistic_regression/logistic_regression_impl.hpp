@@ -20,6 +20,13 @@
 namespace mlpack {
 namespace regression {
 
+//! Size (in columns) of one unit of parallel work in batch Classify().
+static const size_t lrClassifyBlockSize = 1024;
+
+//! Smallest decayed weight a point may have before it is dropped from the
+//! incremental training buffer.
+static const double lrMinIncrementalWeight = 1e-4;
+
 template<typename MatType>
 LogisticRegression<MatType>::LogisticRegression(
     const MatType& predictors,
@@ -34,7 +41,7 @@ template<typename MatType>
 LogisticRegression<MatType>::LogisticRegression(
     const MatType& predictors,
     const arma::Row<size_t>& responses,
-    const arma::rowvec& initialPoint,
+    const arma::Row<ElemType>& initialPoint,
     const double lambda) :
     parameters(initialPoint),
     lambda(lambda)
@@ -46,7 +53,7 @@ template<typename MatType>
 LogisticRegression<MatType>::LogisticRegression(
     const size_t dimensionality,
     const double lambda) :
-    parameters(arma::rowvec(dimensionality + 1, arma::fill::zeros)),
+    parameters(arma::Row<ElemType>(dimensionality + 1, arma::fill::zeros)),
     lambda(lambda)
 {
   // No training to do here.
@@ -88,7 +95,7 @@ double LogisticRegression<MatType>::Train(
 
   // Set size of parameters vector according to the input data received.
   if (parameters.n_elem != predictors.n_rows + 1)
-    parameters = arma::rowvec(predictors.n_rows + 1, arma::fill::zeros);
+    parameters = arma::Row<ElemType>(predictors.n_rows + 1, arma::fill::zeros);
 
   const double out = optimizer.Optimize(errorFunction, parameters,
       callbacks...);
@@ -99,6 +106,99 @@ double LogisticRegression<MatType>::Train(
   return out;
 }
 
+template<typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+double LogisticRegression<MatType>::IncrementalTrain(
+    const MatType& predictors,
+    const arma::Row<size_t>& responses,
+    const double decay,
+    CallbackTypes&&... callbacks)
+{
+  OptimizerType optimizer;
+  return IncrementalTrain(predictors, responses, decay, optimizer,
+      callbacks...);
+}
+
+template<typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+double LogisticRegression<MatType>::IncrementalTrain(
+    const MatType& predictors,
+    const arma::Row<size_t>& responses,
+    const double decay,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  if (decay <= 0.0 || decay > 1.0)
+  {
+    Log::Fatal << "LogisticRegression::IncrementalTrain(): decay must be in "
+        << "(0, 1]!" << std::endl;
+  }
+
+  // Age the buffered points.  The buffer is ordered oldest first and every
+  // point starts with unit weight, so the points whose weights fall below the
+  // floor form a prefix of the buffer.
+  if (bufferedWeights.n_elem > 0)
+  {
+    bufferedWeights *= decay;
+
+    size_t firstKept = 0;
+    while (firstKept < bufferedWeights.n_elem &&
+        bufferedWeights[firstKept] < lrMinIncrementalWeight)
+      ++firstKept;
+
+    if (firstKept == bufferedWeights.n_elem)
+    {
+      bufferedPredictors.set_size(predictors.n_rows, 0);
+      bufferedResponses.set_size(0);
+      bufferedWeights.set_size(0);
+    }
+    else if (firstKept > 0)
+    {
+      bufferedPredictors = MatType(bufferedPredictors.cols(firstKept,
+          bufferedPredictors.n_cols - 1));
+      bufferedResponses = bufferedResponses.subvec(firstKept,
+          bufferedResponses.n_elem - 1);
+      bufferedWeights = bufferedWeights.subvec(firstKept,
+          bufferedWeights.n_elem - 1);
+    }
+  }
+
+  // Append the new batch with unit weights.
+  if (bufferedPredictors.n_cols == 0)
+  {
+    bufferedPredictors = predictors;
+    bufferedResponses = responses;
+    bufferedWeights.ones(predictors.n_cols);
+  }
+  else
+  {
+    bufferedPredictors = arma::join_rows(bufferedPredictors, predictors);
+    bufferedResponses = arma::join_rows(bufferedResponses, responses);
+    bufferedWeights = arma::join_rows(bufferedWeights,
+        arma::Row<ElemType>(predictors.n_cols, arma::fill::ones));
+  }
+
+  LogisticRegressionFunction<MatType> errorFunction(bufferedPredictors,
+      bufferedResponses, lambda);
+  errorFunction.InstanceWeights() = bufferedWeights;
+
+  // The stored parameters warm-start the optimization, unless the
+  // dimensionality of the data changed.
+  if (parameters.n_elem != bufferedPredictors.n_rows + 1)
+  {
+    parameters = arma::Row<ElemType>(bufferedPredictors.n_rows + 1,
+        arma::fill::zeros);
+  }
+
+  const double out = optimizer.Optimize(errorFunction, parameters,
+      callbacks...);
+
+  Log::Info << "LogisticRegression::IncrementalTrain(): final objective of "
+      << "trained model is " << out << "." << std::endl;
+
+  return out;
+}
+
 template<typename MatType>
 template<typename VecType>
 size_t LogisticRegression<MatType>::Classify(const VecType& point,
@@ -115,24 +215,52 @@ void LogisticRegression<MatType>::Classify(const MatType& dataset,
                                            arma::Row<size_t>& labels,
                                            const double decisionBoundary) const
 {
-  // Calculate sigmoid function for each point.  The (1.0 - decisionBoundary)
-  // term correctly sets an offset so that floor() returns 0 or 1 correctly.
-  labels = arma::conv_to<arma::Row<size_t>>::from((1.0 /
-      (1.0 + arma::exp(-parameters(0) -
-      parameters.tail_cols(parameters.n_elem - 1) * dataset))) +
-      (1.0 - decisionBoundary));
+  labels.set_size(dataset.n_cols);
+
+  // Calculate sigmoid function for each point, one block of columns per unit
+  // of parallel work.  The (1.0 - decisionBoundary) term correctly sets an
+  // offset so that floor() returns 0 or 1 correctly.
+  const size_t blocks =
+      (dataset.n_cols + lrClassifyBlockSize - 1) / lrClassifyBlockSize;
+  #pragma omp parallel for default(shared)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+  {
+    const size_t begin = b * lrClassifyBlockSize;
+    const size_t end = std::min(begin + lrClassifyBlockSize,
+        (size_t) dataset.n_cols) - 1;
+
+    labels.subvec(begin, end) = arma::conv_to<arma::Row<size_t>>::from((1.0 /
+        (1.0 + arma::exp(-parameters(0) -
+        parameters.tail_cols(parameters.n_elem - 1) *
+            dataset.cols(begin, end)))) + (1.0 - decisionBoundary));
+  }
 }
 
 template<typename MatType>
 void LogisticRegression<MatType>::Classify(const MatType& dataset,
-                                           arma::mat& probabilities) const
+                                           arma::Mat<ElemType>& probabilities) const
 {
   // Set correct size of output matrix.
   probabilities.set_size(2, dataset.n_cols);
 
-  probabilities.row(1) = 1.0 / (1.0 + arma::exp(-parameters(0) -
-      parameters.tail_cols(parameters.n_elem - 1) * dataset));
-  probabilities.row(0) = 1.0 - probabilities.row(1);
+  // Each block of columns is a unit of parallel work; the blocks write to
+  // disjoint parts of the output.
+  const size_t blocks =
+      (dataset.n_cols + lrClassifyBlockSize - 1) / lrClassifyBlockSize;
+  #pragma omp parallel for default(shared)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+  {
+    const size_t begin = b * lrClassifyBlockSize;
+    const size_t end = std::min(begin + lrClassifyBlockSize,
+        (size_t) dataset.n_cols) - 1;
+
+    probabilities(arma::span(1, 1), arma::span(begin, end)) = 1.0 /
+        (1.0 + arma::exp(-parameters(0) -
+        parameters.tail_cols(parameters.n_elem - 1) *
+            dataset.cols(begin, end)));
+    probabilities(arma::span(0, 0), arma::span(begin, end)) = 1.0 -
+        probabilities(arma::span(1, 1), arma::span(begin, end));
+  }
 }
 
 template<typename MatType>
@@ -141,7 +269,7 @@ double LogisticRegression<MatType>::ComputeError(
     const arma::Row<size_t>& responses) const
 {
   // Construct a new error function.
-  LogisticRegressionFunction<> newErrorFunction(predictors, responses,
+  LogisticRegressionFunction<MatType> newErrorFunction(predictors, responses,
       lambda);
 
   return newErrorFunction.Evaluate(parameters);
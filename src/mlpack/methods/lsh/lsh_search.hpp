@@ -196,6 +196,19 @@ class LSHSearch
              const size_t bucketSize = 500,
              const arma::cube& projection = arma::cube());
 
+  /**
+   * Insert new reference points into a trained model without rebuilding the
+   * hash tables.  Each new point is hashed with the existing projections,
+   * offsets, and second-level hash weights, and appended to the buckets it
+   * falls into; buckets grow geometrically (up to the bucket size cap, if
+   * one is set), so a small refresh of the reference set costs time
+   * proportional to the number of new points rather than a full Train().
+   * The model must have been trained before new points can be inserted.
+   *
+   * @param newPoints Points to add to the reference set.
+   */
+  void InsertPoints(const MatType& newPoints);
+
   /**
    * Compute the nearest neighbors of the points in the given query set and
    * store the output in the given matrices.  The matrices will be set to the
@@ -275,6 +288,16 @@ class LSHSearch
   //! Modify the number of distance evaluations performed.
   size_t& DistanceEvaluations() { return distanceEvaluations; }
 
+  //! Get the global probe budget (see GlobalProbeBudget() below).
+  size_t GlobalProbeBudget() const { return globalProbeBudget; }
+  //! Modify the global probe budget.  When nonzero, the probing bins of all
+  //! searched tables are ranked together by their perturbation score and only
+  //! the budgeted number of most promising bins are probed, instead of
+  //! probing every table's full sequence.  Each table's own bucket has score
+  //! zero, so primary buckets are preferred while the budget covers them.
+  //! Zero (the default) disables the global ranking.
+  size_t& GlobalProbeBudget() { return globalProbeBudget; }
+
   //! Return the reference dataset.
   const MatType& ReferenceSet() const { return referenceSet; }
 
@@ -306,6 +329,20 @@ class LSHSearch
   }
 
  private:
+  /**
+   * Hash every column of the given data into each of the tables and then into
+   * a bucket of the second hash table, producing one second-level key per
+   * (table, point) pair.  This is the hashing step shared by Train() (which
+   * hashes the whole reference set) and InsertPoints() (which hashes only the
+   * new points).
+   *
+   * @param data Points to hash (one per column).
+   * @param secondHashVectors Matrix to store the keys in; it will be set to
+   *    size numTables x data.n_cols.
+   */
+  void HashToSecondLevel(const MatType& data,
+                         arma::Mat<size_t>& secondHashVectors) const;
+
   /**
    * This function takes a query and hashes it into each of the hash tables to
    * get keys for the query and then the key is hashed to a bucket of the second
@@ -386,6 +423,26 @@ class LSHSearch
                                 const size_t T,
                                 arma::mat& additionalProbingBins) const;
 
+  /**
+   * Overload of GetAdditionalProbingBins() that additionally reports the
+   * perturbation score of each probing bin, so that the bins of different
+   * tables can be ranked against each other (used by the global probe
+   * budget).
+   *
+   * @param queryCode vector containing the numProj-dimensional query code.
+   * @param queryCodeNotFloored vector containing the projection location of
+   *    the query.
+   * @param T number of additional probing bins.
+   * @param additionalProbingBins matrix. Each column will hold one additional
+   *    bin.
+   * @param binScores vector to store the score of each probing bin in.
+   */
+  void GetAdditionalProbingBins(const arma::vec& queryCode,
+                                const arma::vec& queryCodeNotFloored,
+                                const size_t T,
+                                arma::mat& additionalProbingBins,
+                                arma::vec& binScores) const;
+
   /**
    * Returns the score of a perturbation vector generated by perturbation set A.
    * The score of a pertubation set (vector) is the sum of scores of the
@@ -465,6 +522,11 @@ class LSHSearch
   //! The number of distance evaluations.
   size_t distanceEvaluations;
 
+  //! The global probe budget; 0 means every probing bin of every searched
+  //! table is visited (the classic behavior).  This is a search-time knob and
+  //! is not serialized with the model.
+  size_t globalProbeBudget;
+
   //! Candidate represents a possible candidate neighbor (distance, index).
   typedef std::pair<double, size_t> Candidate;
 
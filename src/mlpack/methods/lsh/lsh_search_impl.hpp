@@ -32,7 +32,8 @@ LSHSearch(MatType referenceSet,
   hashWidth(hashWidthIn),
   secondHashSize(secondHashSize),
   bucketSize(bucketSize),
-  distanceEvaluations(0)
+  distanceEvaluations(0),
+  globalProbeBudget(0)
 {
   // Pass work to training function.
   Train(std::move(referenceSet), numProj, numTables, hashWidthIn,
@@ -52,7 +53,8 @@ LSHSearch(MatType referenceSet,
   hashWidth(hashWidthIn),
   secondHashSize(secondHashSize),
   bucketSize(bucketSize),
-  distanceEvaluations(0)
+  distanceEvaluations(0),
+  globalProbeBudget(0)
 {
   // Pass work to training function.
   Train(std::move(referenceSet), numProj, numTables, hashWidthIn,
@@ -67,7 +69,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch() :
     hashWidth(0),
     secondHashSize(99901),
     bucketSize(500),
-    distanceEvaluations(0)
+    distanceEvaluations(0),
+    globalProbeBudget(0)
 {
 }
 
@@ -86,7 +89,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashTable(other.secondHashTable),
     bucketContentSize(other.bucketContentSize),
     bucketRowInHashTable(other.bucketRowInHashTable),
-    distanceEvaluations(other.distanceEvaluations)
+    distanceEvaluations(other.distanceEvaluations),
+    globalProbeBudget(other.globalProbeBudget)
 {
   // Nothing to do.
 }
@@ -106,7 +110,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashTable(std::move(other.secondHashTable)),
     bucketContentSize(std::move(other.bucketContentSize)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
-    distanceEvaluations(other.distanceEvaluations)
+    distanceEvaluations(other.distanceEvaluations),
+    globalProbeBudget(other.globalProbeBudget)
 {
   // Reset other model to defaults.
   other.numProj = 0;
@@ -115,6 +120,7 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
   other.secondHashSize = 99901;
   other.bucketSize = 500;
   other.distanceEvaluations = 0;
+  other.globalProbeBudget = 0;
 }
 
 // Copy operator.
@@ -135,6 +141,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   bucketContentSize = other.bucketContentSize;
   bucketRowInHashTable = other.bucketRowInHashTable;
   distanceEvaluations = other.distanceEvaluations;
+  globalProbeBudget = other.globalProbeBudget;
 
   return *this;
 }
@@ -157,6 +164,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   bucketContentSize = std::move(other.bucketContentSize);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
   distanceEvaluations = other.distanceEvaluations;
+  globalProbeBudget = other.globalProbeBudget;
 
   // Reset other model to defaults.
   other.numProj = 0;
@@ -253,50 +261,11 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
         "tables provided must be equal to numProj");
   }
 
-  // We will store the second hash vectors in this matrix; the second hash
-  // vector for table i will be held in row i.  We have to use int and not
-  // size_t, otherwise negative numbers are cast to 0.
-  arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
-
-  for (size_t i = 0; i < numTables; ++i)
-  {
-    // Step IV: create the 'numProj'-dimensional key for each point in each
-    // table.
-
-    // The following code performs the task of hashing each point to a
-    // 'numProj'-dimensional integer key.  Hence you get a ('numProj' x
-    // 'referenceSet.n_cols') key matrix.
-    //
-    // For a single table, let the 'numProj' projections be denoted by 'proj_i'
-    // and the corresponding offset be 'offset_i'.  Then the key of a single
-    // point is obtained as:
-    // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
-    arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1,
-                                       this->referenceSet.n_cols);
-    arma::mat hashMat = projections.slice(i).t() * (this->referenceSet);
-    hashMat += offsetMat;
-    hashMat /= hashWidth;
-
-    // Step V: Putting the points in the 'secondHashTable' by hashing the key.
-    // Now we hash every key, point ID to its corresponding bucket.  We must
-    // also normalize the hashes to the range [0, secondHashSize).
-    arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
-    for (size_t j = 0; j < unmodVector.n_elem; ++j)
-    {
-      double shs = (double) secondHashSize; // Convenience cast.
-      if (unmodVector[j] >= 0.0)
-      {
-        const size_t key = size_t(fmod(unmodVector[j], shs));
-        secondHashVectors(i, j) = key;
-      }
-      else
-      {
-        const double mod = fmod(-unmodVector[j], shs);
-        const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
-        secondHashVectors(i, j) = key;
-      }
-    }
-  }
+  // Steps IV and V: create the 'numProj'-dimensional key for each point in
+  // each table, and hash each key to a bucket of the second hash table.  The
+  // second hash vector for table i will be held in row i.
+  arma::Mat<size_t> secondHashVectors;
+  HashToSecondLevel(this->referenceSet, secondHashVectors);
 
   // Now, using the hash vectors for each table, count the number of rows we
   // have in the second hash table.
@@ -349,6 +318,107 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
             << std::endl;
 }
 
+// Hash every column of the given data into a second-level key per table.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::HashToSecondLevel(
+    const MatType& data,
+    arma::Mat<size_t>& secondHashVectors) const
+{
+  secondHashVectors.set_size(numTables, data.n_cols);
+
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    // The following code performs the task of hashing each point to a
+    // 'numProj'-dimensional integer key.  Hence you get a ('numProj' x
+    // 'data.n_cols') key matrix.
+    //
+    // For a single table, let the 'numProj' projections be denoted by 'proj_i'
+    // and the corresponding offset be 'offset_i'.  Then the key of a single
+    // point is obtained as:
+    // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
+    arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1, data.n_cols);
+    arma::mat hashMat = projections.slice(i).t() * data;
+    hashMat += offsetMat;
+    hashMat /= hashWidth;
+
+    // Now we hash every key to its corresponding bucket.  We must also
+    // normalize the hashes to the range [0, secondHashSize).
+    arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
+    for (size_t j = 0; j < unmodVector.n_elem; ++j)
+    {
+      double shs = (double) secondHashSize; // Convenience cast.
+      if (unmodVector[j] >= 0.0)
+      {
+        const size_t key = size_t(fmod(unmodVector[j], shs));
+        secondHashVectors(i, j) = key;
+      }
+      else
+      {
+        const double mod = fmod(-unmodVector[j], shs);
+        const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
+        secondHashVectors(i, j) = key;
+      }
+    }
+  }
+}
+
+// Insert new reference points into the existing hash tables.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::InsertPoints(const MatType& newPoints)
+{
+  if (referenceSet.n_cols == 0 || projections.n_slices == 0)
+    throw std::invalid_argument("LSHSearch::InsertPoints(): model must be "
+        "trained before points can be inserted; call Train() first!");
+
+  util::CheckSameDimensionality(newPoints, referenceSet,
+      "LSHSearch::InsertPoints()", "new points");
+
+  const size_t oldCols = referenceSet.n_cols;
+
+  // Hash the new points with the existing projections, offsets, and second
+  // hash weights; the existing tables are left untouched.
+  arma::Mat<size_t> secondHashVectors;
+  HashToSecondLevel(newPoints, secondHashVectors);
+
+  referenceSet = arma::join_rows(referenceSet, newPoints);
+
+  const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
+
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    {
+      const size_t hashInd = secondHashVectors(i, j);
+
+      // Start a new row for a bucket we have not seen before.
+      if (bucketRowInHashTable[hashInd] == secondHashSize)
+      {
+        bucketRowInHashTable[hashInd] = secondHashTable.size();
+        secondHashTable.push_back(arma::Col<size_t>());
+        bucketContentSize.resize(secondHashTable.size());
+      }
+
+      const size_t index = bucketRowInHashTable[hashInd];
+
+      // Enforce the maximum bucket size, exactly as Train() does.
+      if (bucketContentSize[index] >= effectiveBucketSize)
+        continue;
+
+      // Grow the bucket's storage geometrically when it is full, so a
+      // sequence of insertions into the same bucket costs amortized constant
+      // copies.
+      if (bucketContentSize[index] == secondHashTable[index].n_elem)
+      {
+        const size_t newCapacity = std::min(effectiveBucketSize,
+            std::max<size_t>(2 * secondHashTable[index].n_elem, 4));
+        secondHashTable[index].resize(newCapacity);
+      }
+
+      secondHashTable[index](bucketContentSize[index]++) = oldCols + j;
+    }
+  }
+}
+
 // Base case where the query set is the reference set.  (So, we can't return
 // ourselves as the nearest neighbor.)
 template<typename SortPolicy, typename MatType>
@@ -526,6 +596,21 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
     const arma::vec& queryCodeNotFloored,
     const size_t T,
     arma::mat& additionalProbingBins) const
+{
+  // The scores are not needed; compute and discard them.
+  arma::vec binScores;
+  GetAdditionalProbingBins(queryCode, queryCodeNotFloored, T,
+      additionalProbingBins, binScores);
+}
+
+// Compute additional probing bins for a query, and report their scores.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
+    const arma::vec& queryCode,
+    const arma::vec& queryCodeNotFloored,
+    const size_t T,
+    arma::mat& additionalProbingBins,
+    arma::vec& binScores) const
 {
   // No additional bins requested. Our work is done.
   if (T == 0)
@@ -533,6 +618,7 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
 
   // Each column of additionalProbingBins is the code of a bin.
   additionalProbingBins.set_size(numProj, T);
+  binScores.set_size(T);
 
   // Copy the query's code, then in the end we will  add/subtract according
   // to perturbations we calculated.
@@ -588,6 +674,7 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
 
     // Add or subtract 1 to dimension corresponding to minimum score.
     additionalProbingBins(positions[minloc], 0) += actions[minloc];
+    binScores(0) = minscore;
     if (T == 1)
       return; // Done if asked for only 1 code.
 
@@ -613,6 +700,7 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
 
     // Add or subtract 1 to create second-lowest scoring vector.
     additionalProbingBins(positions[minloc2], 1) += actions[minloc2];
+    binScores(1) = minscore2;
     return;
   }
 
@@ -662,9 +750,11 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
   for (size_t pvec = 0; pvec < T; ++pvec)
   {
     std::vector<bool> Ai;
+    double AiScore = 0.0;
     do
     {
       // Get the perturbation set corresponding to the minimum score.
+      AiScore = minHeap.top().first;
       Ai = perturbationSets[ minHeap.top().second ];
       minHeap.pop(); // .top() returns, .pop() removes
 
@@ -694,6 +784,7 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
     } while (!PerturbationValid(Ai)); // Discard invalid perturbations
 
     // Found valid perturbation set Ai. Construct perturbation vector from set.
+    binScores(pvec) = AiScore;
     for (size_t pos = 0; pos < Ai.size(); ++pos)
     {
       // If Ai[pos] is marked, add action to probing vector.
@@ -746,6 +837,13 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
   for (size_t i = 0; i < numTablesToSearch; ++i)
     hashMat(0, i) = (hashMat(0, i) % secondHashSize);
 
+  // Scores of every probing bin; each table's primary bin scores 0 (it is
+  // the bin the query itself hashed to).  Only needed for the global probe
+  // budget.
+  arma::mat probeScores;
+  if (globalProbeBudget > 0)
+    probeScores.zeros(T + 1, numTablesToSearch);
+
   // Compute hash codes of additional probing bins.
   if (T > 0)
   {
@@ -753,10 +851,15 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     {
       // Construct this table's probing sequence of length T.
       arma::mat additionalProbingBins;
+      arma::vec binScores;
       GetAdditionalProbingBins(allProjInTables.unsafe_col(i),
                                 queryCodesNotFloored.unsafe_col(i),
                                 T,
-                                additionalProbingBins);
+                                additionalProbingBins,
+                                binScores);
+
+      if (globalProbeBudget > 0)
+        probeScores(arma::span(1, T), i) = binScores;
 
       // Map each probing bin to a bin in secondHashTable (just like we did for
       // the primary hash table).
@@ -768,12 +871,35 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     }
   }
 
+  // With a global probe budget, rank the probing bins of all tables together
+  // by their perturbation score and keep only the budgeted number of most
+  // promising bins; a query's neighbors are most likely in the bins whose
+  // perturbations have the lowest scores, regardless of which table they
+  // belong to.  This spends the probing effort where it matters instead of
+  // probing every table's full sequence.
+  std::vector<bool> probeKept((T + 1) * numTablesToSearch, true);
+  if (globalProbeBudget > 0 &&
+      globalProbeBudget < (T + 1) * numTablesToSearch)
+  {
+    // vectorise() is column-major, so index (p + i * (T + 1)) corresponds to
+    // probe p of table i -- the same layout as probeKept.
+    const arma::uvec scoreOrder = arma::sort_index(
+        arma::vectorise(probeScores));
+
+    std::fill(probeKept.begin(), probeKept.end(), false);
+    for (size_t j = 0; j < globalProbeBudget; ++j)
+      probeKept[scoreOrder[j]] = true;
+  }
+
   // Count number of points hashed in the same bucket as the query.
   size_t maxNumPoints = 0;
   for (size_t i = 0; i < numTablesToSearch; ++i)
   {
     for (size_t p = 0; p < T + 1; ++p)
     {
+      if (!probeKept[p + i * (T + 1)])
+        continue;
+
       const size_t hashInd = hashMat(p, i); // find query's bucket
       const size_t tableRow = bucketRowInHashTable[hashInd];
       if (tableRow < secondHashSize)
@@ -804,6 +930,9 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     {
       for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
       {
+        if (!probeKept[p + i * (T + 1)])
+          continue;
+
         // get the sequence code
         size_t hashInd = hashMat(p, i);
         size_t tableRow = bucketRowInHashTable[hashInd];
@@ -836,6 +965,9 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     {
       for (size_t p = 0; p < T + 1; ++p)
       {
+        if (!probeKept[p + i * (T + 1)])
+          continue;
+
         const size_t hashInd =  hashMat(p, i); // Find the query's bucket.
         const size_t tableRow = bucketRowInHashTable[hashInd];
 
@@ -1042,8 +1174,49 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(secondHashSize));
   ar(CEREAL_NVP(secondHashWeights));
   ar(CEREAL_NVP(bucketSize));
-  ar(CEREAL_NVP(secondHashTable));
-  ar(CEREAL_NVP(bucketContentSize));
+
+  // The second hash table is stored in a compact contiguous layout: the
+  // filled prefix of every row, concatenated into one vector with a
+  // row-offset directory.  Loading then costs two contiguous reads instead of
+  // one allocation and read per bucket, and slack capacity left behind by
+  // InsertPoints() is not written out.  The bucket content sizes are implied
+  // by consecutive offsets, so they are not stored separately.
+  arma::Col<size_t> rowOffsets;
+  arma::Col<size_t> flatTable;
+  if (cereal::is_saving<Archive>())
+  {
+    rowOffsets.set_size(secondHashTable.size() + 1);
+    rowOffsets[0] = 0;
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+      rowOffsets[i + 1] = rowOffsets[i] + bucketContentSize[i];
+
+    flatTable.set_size(rowOffsets[secondHashTable.size()]);
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+      for (size_t j = 0; j < bucketContentSize[i]; ++j)
+        flatTable[rowOffsets[i] + j] = secondHashTable[i](j);
+  }
+
+  ar(CEREAL_NVP(rowOffsets));
+  ar(CEREAL_NVP(flatTable));
+
+  if (cereal::is_loading<Archive>())
+  {
+    const size_t numRows = (rowOffsets.n_elem == 0) ? 0 :
+        (size_t) rowOffsets.n_elem - 1;
+
+    secondHashTable.clear();
+    secondHashTable.resize(numRows);
+    bucketContentSize.zeros(numRows);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+      const size_t length = rowOffsets[i + 1] - rowOffsets[i];
+      bucketContentSize[i] = length;
+      if (length > 0)
+        secondHashTable[i] = flatTable.subvec(rowOffsets[i],
+            rowOffsets[i + 1] - 1);
+    }
+  }
+
   ar(CEREAL_NVP(bucketRowInHashTable));
   ar(CEREAL_NVP(distanceEvaluations));
 }
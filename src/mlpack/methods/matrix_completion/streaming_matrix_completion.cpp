@@ -0,0 +1,182 @@
+/**
+ * @file methods/matrix_completion/streaming_matrix_completion.cpp
+ *
+ * Implementation of the out-of-core low rank matrix completion solver.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "streaming_matrix_completion.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace mlpack {
+namespace matrix_completion {
+
+StreamingMatrixCompletion::StreamingMatrixCompletion(
+    const size_t m,
+    const size_t n,
+    const std::string& tripletsFile,
+    const size_t r,
+    const size_t blockSize,
+    const size_t maxIterations,
+    const double stepSize,
+    const double lambda) :
+    m(m),
+    n(n),
+    tripletsFile(tripletsFile),
+    numEntries(0),
+    blockSize(blockSize),
+    maxIterations(maxIterations),
+    stepSize(stepSize),
+    lambda(lambda)
+{
+  if (blockSize == 0)
+  {
+    throw std::invalid_argument("StreamingMatrixCompletion::"
+        "StreamingMatrixCompletion(): block size must be positive!");
+  }
+
+  CheckTripletFile();
+
+  // Small random factors; only these stay resident during recovery.
+  u = arma::randu<arma::mat>(m, r) / std::sqrt((double) r);
+  v = arma::randu<arma::mat>(n, r) / std::sqrt((double) r);
+}
+
+void StreamingMatrixCompletion::CheckTripletFile()
+{
+  std::ifstream stream(tripletsFile.c_str(),
+      std::ios::binary | std::ios::ate);
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "StreamingMatrixCompletion::StreamingMatrixCompletion(): cannot "
+        << "open triplet file '" << tripletsFile << "'!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const std::streamoff bytes = stream.tellg();
+  if (bytes <= 0 || bytes % sizeof(Triplet) != 0)
+  {
+    std::ostringstream oss;
+    oss << "StreamingMatrixCompletion::StreamingMatrixCompletion(): triplet "
+        << "file '" << tripletsFile << "' is empty or its size is not a "
+        << "multiple of the record size!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  numEntries = bytes / sizeof(Triplet);
+}
+
+void StreamingMatrixCompletion::Recover()
+{
+  const size_t numBlocks = (numEntries + blockSize - 1) / blockSize;
+
+  // Block visiting order, reshuffled before each pass.
+  arma::uvec blockOrder = arma::linspace<arma::uvec>(0, numBlocks - 1,
+      numBlocks);
+
+  std::vector<Triplet> block(blockSize);
+
+  for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+  {
+    blockOrder = arma::shuffle(blockOrder);
+
+    std::ifstream stream(tripletsFile.c_str(), std::ios::binary);
+    if (!stream.is_open())
+    {
+      std::ostringstream oss;
+      oss << "StreamingMatrixCompletion::Recover(): cannot open triplet "
+          << "file '" << tripletsFile << "'!";
+      throw std::runtime_error(oss.str());
+    }
+
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t first = blockOrder(b) * blockSize;
+      const size_t count = std::min(blockSize, numEntries - first);
+
+      stream.seekg(first * sizeof(Triplet));
+      stream.read((char*) block.data(), count * sizeof(Triplet));
+      if (!stream)
+      {
+        std::ostringstream oss;
+        oss << "StreamingMatrixCompletion::Recover(): short read from "
+            << "triplet file '" << tripletsFile << "'!";
+        throw std::runtime_error(oss.str());
+      }
+
+      UpdateBlock(block, count);
+    }
+  }
+}
+
+void StreamingMatrixCompletion::Recover(arma::mat& recovered)
+{
+  Recover();
+  recovered = u * v.t();
+}
+
+void StreamingMatrixCompletion::UpdateBlock(std::vector<Triplet>& block,
+                                            const size_t count)
+{
+  // Shuffle the entries within the block.
+  const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+      count - 1, count));
+
+  // The factor rows are updated without locks; threads only collide when
+  // they process entries of the same row (or column) at the same instant,
+  // which is rare and merely makes those updates approximate.
+  #pragma omp parallel for
+  for (omp_size_t k = 0; k < (omp_size_t) count; ++k)
+  {
+    const Triplet& entry = block[order(k)];
+    if (entry.row >= m || entry.col >= n)
+      continue; // Out-of-range record; skip it.
+
+    const double error = entry.value -
+        arma::dot(u.row(entry.row), v.row(entry.col));
+
+    const arma::rowvec uRow = u.row(entry.row);
+    u.row(entry.row) +=
+        stepSize * (error * v.row(entry.col) - lambda * uRow);
+    v.row(entry.col) +=
+        stepSize * (error * uRow - lambda * v.row(entry.col));
+  }
+}
+
+void StreamingMatrixCompletion::WriteTriplets(const arma::umat& indices,
+                                              const arma::vec& values,
+                                              const std::string& tripletsFile)
+{
+  if (indices.n_rows != 2 || indices.n_cols != values.n_elem)
+  {
+    throw std::invalid_argument("StreamingMatrixCompletion::WriteTriplets(): "
+        "indices must be [2 x p] and values must be length p!");
+  }
+
+  std::ofstream stream(tripletsFile.c_str(), std::ios::binary);
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "StreamingMatrixCompletion::WriteTriplets(): cannot open triplet "
+        << "file '" << tripletsFile << "' for writing!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    Triplet entry;
+    entry.row = indices(0, i);
+    entry.col = indices(1, i);
+    entry.value = values(i);
+    stream.write((const char*) &entry, sizeof(Triplet));
+  }
+}
+
+} // namespace matrix_completion
+} // namespace mlpack
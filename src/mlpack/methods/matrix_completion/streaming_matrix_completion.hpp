@@ -0,0 +1,190 @@
+/**
+ * @file methods/matrix_completion/streaming_matrix_completion.hpp
+ *
+ * An out-of-core low rank matrix completion solver that streams the observed
+ * entries from disk and keeps only the factor matrices resident.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_STREAMING_MATRIX_COMPLETION_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_STREAMING_MATRIX_COMPLETION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace matrix_completion {
+
+/**
+ * This class solves low rank matrix completion problems whose constraint sets
+ * do not fit in memory.  Where MatrixCompletion hands all observed entries to
+ * the in-memory SDP solver, this class keeps only the two factor matrices of
+ * X = U V^T resident and streams the observed entries from a binary triplet
+ * file on disk: each pass reads the file in blocks, visits the blocks in a
+ * freshly shuffled order, shuffles the entries within each block, and updates
+ * the factor rows with parallel stochastic gradient steps (the races between
+ * threads touching the same row are rare and benign, as in Hogwild).
+ *
+ * The triplet file holds one record per observed entry: the row index and
+ * column index as 64-bit unsigned integers followed by the value as a double,
+ * all in native byte order.  WriteTriplets() produces this format from the
+ * index/value representation used by MatrixCompletion.
+ *
+ * An example of how to use this class is shown below:
+ *
+ * @code
+ * size_t m, n;         // Size of unknown matrix.
+ * arma::umat indices;  // Contains the known indices [2 x n_entries].
+ * arma::vec values;    // Contains the known values [n_entries].
+ * arma::mat recovered; // Will contain the completed matrix.
+ *
+ * StreamingMatrixCompletion::WriteTriplets(indices, values, "entries.bin");
+ *
+ * StreamingMatrixCompletion mc(m, n, "entries.bin", 5);
+ * mc.Recover(recovered);
+ * @endcode
+ *
+ * @see MatrixCompletion
+ */
+class StreamingMatrixCompletion
+{
+ public:
+  /**
+   * Construct a streaming matrix completion problem.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param tripletsFile Name of the binary triplet file holding the observed
+   *    entries.
+   * @param r Rank of the factorization.
+   * @param blockSize Number of entries read and processed per block.
+   * @param maxIterations Number of passes over the triplet file.
+   * @param stepSize Step size of the stochastic updates.
+   * @param lambda Regularization weight of the factor rows.
+   */
+  StreamingMatrixCompletion(const size_t m,
+                            const size_t n,
+                            const std::string& tripletsFile,
+                            const size_t r,
+                            const size_t blockSize = 1048576,
+                            const size_t maxIterations = 25,
+                            const double stepSize = 0.01,
+                            const double lambda = 0.01);
+
+  /**
+   * Stream the observed entries and fit the factor matrices.  Only the
+   * factors are kept in memory; the completed matrix is never formed.
+   */
+  void Recover();
+
+  /**
+   * Stream the observed entries, fit the factor matrices and form the
+   * completed matrix.  This is only sensible when the completed matrix
+   * itself fits in memory; for larger problems call Recover() and evaluate
+   * single entries with Predict().
+   *
+   * @param recovered Will contain the completed matrix.
+   */
+  void Recover(arma::mat& recovered);
+
+  /**
+   * Evaluate a single entry of the completed matrix from the factors.
+   *
+   * @param i Row of the entry.
+   * @param j Column of the entry.
+   */
+  double Predict(const size_t i, const size_t j) const
+  {
+    return arma::dot(u.row(i), v.row(j));
+  }
+
+  /**
+   * Write the given observed entries to a binary triplet file in the format
+   * expected by this class.
+   *
+   * @param indices Matrix containing the indices of the known entries (must
+   *    be [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   * @param tripletsFile Name of the file to write.
+   */
+  static void WriteTriplets(const arma::umat& indices,
+                            const arma::vec& values,
+                            const std::string& tripletsFile);
+
+  //! Get the left factor matrix (m x r).
+  const arma::mat& U() const { return u; }
+  //! Get the right factor matrix (n x r).
+  const arma::mat& V() const { return v; }
+
+  //! Get the number of entries read and processed per block.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of entries read and processed per block.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get the number of passes over the triplet file.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the number of passes over the triplet file.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the step size of the stochastic updates.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size of the stochastic updates.
+  double& StepSize() { return stepSize; }
+
+  //! Get the regularization weight of the factor rows.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization weight of the factor rows.
+  double& Lambda() { return lambda; }
+
+ private:
+  //! One record of the triplet file.
+  struct Triplet
+  {
+    arma::u64 row;
+    arma::u64 col;
+    double value;
+  };
+
+  /**
+   * Process one block of entries: shuffle them and apply parallel stochastic
+   * gradient updates to the factor rows.
+   *
+   * @param block The entries of the block.
+   * @param count Number of valid entries in the block.
+   */
+  void UpdateBlock(std::vector<Triplet>& block, const size_t count);
+
+  //! Validate the triplet file and count its entries.
+  void CheckTripletFile();
+
+  //! Number of rows in original matrix.
+  size_t m;
+  //! Number of columns in original matrix.
+  size_t n;
+  //! Name of the binary triplet file holding the observed entries.
+  std::string tripletsFile;
+  //! Number of observed entries in the triplet file.
+  size_t numEntries;
+
+  //! Number of entries read and processed per block.
+  size_t blockSize;
+  //! Number of passes over the triplet file.
+  size_t maxIterations;
+  //! Step size of the stochastic updates.
+  double stepSize;
+  //! Regularization weight of the factor rows.
+  double lambda;
+
+  //! Left factor matrix (m x r).
+  arma::mat u;
+  //! Right factor matrix (n x r).
+  arma::mat v;
+};
+
+} // namespace matrix_completion
+} // namespace mlpack
+
+#endif
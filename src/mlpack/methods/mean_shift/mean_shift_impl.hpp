@@ -212,29 +212,72 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
+  // Initial centroids are the seeds themselves.
   for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    allCentroids.col(i) = pSeeds->col(i);
+
+  // All seeds start active; a seed leaves the active set when it converges,
+  // when its window turns out to be empty, or when the iteration limit is
+  // reached.  Each iteration issues one batched range search for every active
+  // seed at once, so the reference tree (built once above) is traversed a
+  // single time per iteration instead of once per seed, and the per-seed
+  // kernel-weighted mean updates are independent and run in parallel.
+  std::vector<size_t> activeSeeds(pSeeds->n_cols);
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    activeSeeds[i] = i;
+
+  size_t completedIterations = 0;
+  while (!activeSeeds.empty() &&
+      (completedIterations < maxIterations || forceConvergence))
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    // Gather the active centroids into one query set.
+    arma::mat queries(allCentroids.n_rows, activeSeeds.size());
+    for (size_t a = 0; a < activeSeeds.size(); ++a)
+      queries.col(a) = allCentroids.col(activeSeeds[a]);
+
+    rangeSearcher.Search(queries, validRadius, neighbors, distances);
+
+    // Per-seed outcome of this iteration: 0 means the seed is still
+    // shifting, 1 means it converged, and 2 means its window was empty.
+    std::vector<char> status(activeSeeds.size(), 0);
+
+    #pragma omp parallel for
+    for (omp_size_t a = 0; a < (omp_size_t) activeSeeds.size(); ++a)
     {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      const size_t i = activeSeeds[a];
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+      if (neighbors[a].size() == 0) // There are no points in the cluster.
+      {
+        status[a] = 2;
+        continue;
+      }
 
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
+      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      if (!CalculateCentroid(data, neighbors[a], distances[a], newCentroid))
         newCentroid = allCentroids.unsafe_col(i);
 
       // If the mean shift vector is small enough, it has converged.
       if (metric::EuclideanDistance::Evaluate(newCentroid,
           allCentroids.unsafe_col(i)) < 1e-3 * radius)
+      {
+        status[a] = 1;
+      }
+      else
+      {
+        // Update the centroid.
+        allCentroids.col(i) = newCentroid;
+      }
+    }
+
+    // Fold the converged seeds into the centroid list serially, since the
+    // duplicate test reads and grows the shared list.
+    std::vector<size_t> stillActive;
+    for (size_t a = 0; a < activeSeeds.size(); ++a)
+    {
+      const size_t i = activeSeeds[a];
+
+      if (status[a] == 1)
       {
         // Determine if the new centroid is duplicate with old ones.
         bool isDuplicated = false;
@@ -251,14 +294,15 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
 
         if (!isDuplicated)
           centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
-
-        // Get out of the loop.
-        break;
       }
-
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+      else if (status[a] == 0)
+      {
+        stillActive.push_back(i);
+      }
     }
+
+    activeSeeds.swap(stillActive);
+    completedIterations++;
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -108,6 +108,12 @@ class NaiveBayesClassifier
    * classes, either re-initialize or call Means(), Variances(), and
    * Probabilities() individually to set them to the right size.
    *
+   * The incremental algorithm consumes the data as one chunk: the sufficient
+   * statistics of the chunk are computed with a parallel reduction over the
+   * classes and merged into the existing model, so data can be streamed
+   * through repeated calls to this overload in batches of columns instead of
+   * one point at a time.
+   *
    * @param data The dataset to train on.
    * @param labels The labels for the dataset.
    * @param numClasses The numbe of classes in the dataset.
@@ -232,8 +238,9 @@ class NaiveBayesClassifier
 
   /**
    * Compute the unnormalized posterior log probability of given points (log
-   * likelihood). Results are returned as arma::mat, and each column represents
-   * a point, each row represents log likelihood of a class.
+   * likelihood).  Each column of the result represents a point and each row
+   * represents the log likelihood of a class; all classes are scored for the
+   * whole block of points with two matrix products.
    *
    * @param data Set of points to compute posterior log probability for.
    * @param logLikelihoods Matrix to store log likelihoods in.
@@ -109,24 +109,60 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   // for each of the features with respect to each of the labels.
   if (incremental)
   {
-    // Use incremental algorithm.
-    // Fist, de-normalize probabilities.
+    // Use the batched incremental algorithm: compute the sufficient statistics
+    // of this chunk for each class independently (and in parallel), then merge
+    // them into the existing model with the standard formulas for combining
+    // the statistics of two samples.
+    // First, de-normalize probabilities back to class counts.
     probabilities *= trainingPoints;
 
+    // Gather the columns belonging to each class, so that each class can be
+    // reduced independently.
+    std::vector<std::vector<arma::uword>> classCols(numClasses);
     for (size_t j = 0; j < data.n_cols; ++j)
-    {
-      const size_t label = labels[j];
-      ++probabilities[label];
+      classCols[labels[j]].push_back(j);
 
-      arma::vec delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
-    }
-
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
+    #pragma omp parallel for
+    for (omp_size_t c = 0; c < (omp_size_t) numClasses; ++c)
     {
-      if (probabilities[i] > 2)
-        variances.col(i) /= (probabilities[i] - 1);
+      const std::vector<arma::uword>& cols = classCols[c];
+      if (cols.empty())
+        continue;
+
+      // Two-pass mean and sum of squared deviations for this class's part of
+      // the chunk.
+      arma::Col<ElemType> chunkMean(data.n_rows, arma::fill::zeros);
+      for (size_t j = 0; j < cols.size(); ++j)
+        chunkMean += data.col(cols[j]);
+      chunkMean /= (ElemType) cols.size();
+
+      arma::Col<ElemType> chunkM2(data.n_rows, arma::fill::zeros);
+      for (size_t j = 0; j < cols.size(); ++j)
+      {
+        const arma::Col<ElemType> delta = data.col(cols[j]) - chunkMean;
+        chunkM2 += arma::square(delta);
+      }
+
+      // Merge the chunk statistics into the running model.  The stored
+      // variances are sample variances, so de-normalize them back to sums of
+      // squared deviations before merging.
+      const double oldCount = probabilities[c];
+      const double chunkCount = (double) cols.size();
+      const double totalCount = oldCount + chunkCount;
+
+      arma::Col<ElemType> m2(variances.col(c));
+      if (oldCount > 1)
+        m2 *= (oldCount - 1);
+
+      const arma::Col<ElemType> delta = chunkMean - means.col(c);
+      means.col(c) += delta * (chunkCount / totalCount);
+      m2 += chunkM2 + arma::square(delta) *
+          (oldCount * chunkCount / totalCount);
+      if (totalCount > 1)
+        m2 /= (totalCount - 1);
+
+      variances.col(c) = m2;
+      probabilities[c] = totalCount;
     }
   }
   else
@@ -171,8 +207,13 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   // Add epsilon to prevent log of zero.
   variances += epsilon;
 
-  probabilities /= data.n_cols;
   trainingPoints += data.n_cols;
+  // In the incremental case the class counts cover every point seen so far,
+  // not just this chunk.
+  if (incremental)
+    probabilities /= trainingPoints;
+  else
+    probabilities /= data.n_cols;
 }
 
 template<typename ModelMatType>
@@ -210,24 +251,22 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = arma::log(arma::repmat(probabilities, 1, data.n_cols));
-  ModelMatType invVar = 1.0 / variances;
-
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
-
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
-  {
-    // This is an adaptation of gmm::phi() for the case where the covariance is
-    // a diagonal matrix.
-    ModelMatType diffs = data - arma::repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = arma::sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * log(2 * M_PI) - 0.5 *
-        arma::accu(arma::log(variances.col(i))) + exponents);
-  }
+  // Expanding the squared deviation in the Gaussian log-density,
+  //   -0.5 * (x - m)^2 / v = -0.5 * x^2 / v + x * (m / v) - 0.5 * m^2 / v,
+  // lets the likelihoods of every class for every point be computed with two
+  // matrix products instead of a pass over the data per class.  The terms
+  // that do not depend on the point are folded into one constant per class:
+  // the class prior, the Gaussian normalization term, and -0.5 * m^2 / v.
+  const ModelMatType invVar = 1.0 / variances;
+  const arma::Col<ElemType> classConstants =
+      arma::log(arma::vectorise(probabilities)) -
+      (data.n_rows / 2.0) * std::log(2 * M_PI) -
+      0.5 * arma::sum(arma::log(variances), 0).t() -
+      0.5 * arma::sum(arma::square(means) % invVar, 0).t();
+
+  logLikelihoods = (means % invVar).t() * data -
+      0.5 * (invVar.t() * (data % data));
+  logLikelihoods.each_col() += classConstants;
 }
 
 template<typename ModelMatType>
@@ -86,6 +86,16 @@ class NCA
   const OptimizerType& Optimizer() const { return optimizer; }
   OptimizerType& Optimizer() { return optimizer; }
 
+  //! Get the number of candidate neighbors sampled per point (0 means the
+  //! exact objective is used).
+  size_t NumSamples() const { return errorFunction.NumSamples(); }
+  //! Modify the number of candidate neighbors sampled per point.  When
+  //! nonzero, each stochastic objective and gradient evaluation estimates the
+  //! softmax over that many uniformly drawn candidates instead of all n
+  //! points, so an epoch costs O(n * NumSamples()) instead of O(n^2).  Only
+  //! meaningful with stochastic optimizers such as SGD.
+  size_t& NumSamples() { return errorFunction.NumSamples(); }
+
  private:
   //! Dataset reference.
   const arma::mat& dataset;
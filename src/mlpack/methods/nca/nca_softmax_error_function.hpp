@@ -81,6 +81,10 @@ class SoftmaxErrorFunction
    * functions, and here, only one of those constituent objective functions is
    * returned.
    *
+   * If NumSamples() is nonzero, the softmax of each point is estimated over
+   * that many uniformly drawn candidate neighbors instead of all n points,
+   * reducing the cost per point from O(n) to O(NumSamples()).
+   *
    * @param covariance Covariance matrix of Mahalanobis distance.
    * @param begin Index of the initial point to use for objective function.
    * @param batchSize Number of points to use for objective function.
@@ -108,6 +112,10 @@ class SoftmaxErrorFunction
    * The type of the gradient parameter is a template
    * argument to allow the computation of a sparse gradient.
    *
+   * If NumSamples() is nonzero, the gradient of each point is estimated over
+   * that many uniformly drawn candidate neighbors instead of all n points,
+   * reducing the cost per point from O(n) to O(NumSamples()).
+   *
    * @tparam GradType The type of the gradient out-param.
    * @param covariance Covariance matrix of Mahalanobis distance.
    * @param begin Index of the initial point to use for objective function.
@@ -131,6 +139,15 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of candidate neighbors sampled per point (0 means the
+  //! exact objective is computed).
+  size_t NumSamples() const { return numSamples; }
+  //! Modify the number of candidate neighbors sampled per point (0 means the
+  //! exact objective is computed).  Sampling only affects the separable
+  //! Evaluate() and Gradient() overloads, so it is useful with stochastic
+  //! optimizers like SGD; the non-separable overloads stay exact.
+  size_t& NumSamples() { return numSamples; }
+
  private:
   //! The dataset.  This is an alias until Shuffle() is called.
   arma::mat dataset;
@@ -151,6 +168,10 @@ class SoftmaxErrorFunction
   //! Evaluate() and Gradient().
   arma::vec denominators;
 
+  //! Number of candidate neighbors to sample per point in the separable
+  //! overloads; 0 means the full softmax is computed.
+  size_t numSamples;
+
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
 
@@ -29,6 +29,7 @@ SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     dataset(math::MakeAlias(const_cast<arma::mat&>(dataset), false)),
     labels(math::MakeAlias(const_cast<arma::Row<size_t>&>(labels), false)),
     metric(metric),
+    numSamples(0),
     precalculated(false)
 { /* nothing to do */ }
 
@@ -72,6 +73,49 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
   double numerator = 0;
   double result = 0;
 
+  // If candidate sampling is enabled, estimate p_i over a random candidate
+  // set instead of scanning all points.  The sampling factor
+  // (n - 1) / numSamples scales the numerator and the denominator alike, so
+  // it cancels in the ratio and the estimate needs no correction.  Only the
+  // needed columns are stretched, so the cost is O(batchSize * numSamples).
+  if (numSamples > 0 && numSamples < dataset.n_cols - 1)
+  {
+    for (size_t i = begin; i < begin + batchSize; ++i)
+    {
+      const arma::vec stretchedI = coordinates * dataset.col(i);
+
+      numerator = 0;
+      denominator = 0;
+      for (size_t s = 0; s < numSamples; ++s)
+      {
+        // Draw a candidate other than the point itself.
+        size_t k = math::RandInt(dataset.n_cols - 1);
+        if (k >= i)
+          ++k;
+
+        const arma::vec stretchedK = coordinates * dataset.col(k);
+        const double eval = std::exp(-metric.Evaluate(stretchedI, stretchedK));
+
+        // If they are in the same class, update the numerator.
+        if (labels[i] == labels[k])
+          numerator += eval;
+
+        denominator += eval;
+      }
+
+      if (denominator == 0.0)
+      {
+        Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
+        continue;
+      }
+
+      result += -(numerator / denominator); // Negate because the optimizer is
+                                            // a minimizer.
+    }
+
+    return result;
+  }
+
   // It's quicker to do this now than one point at a time later.
   stretchedDataset = coordinates * dataset;
   for (size_t i = begin; i < begin + batchSize; ++i)
@@ -172,6 +216,62 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
 
   gradient.zeros(coordinates.n_rows, coordinates.n_rows);
 
+  // If candidate sampling is enabled, estimate the gradient of each point
+  // over a random candidate set instead of scanning all points.  As in the
+  // sampled Evaluate(), the sampling factor cancels when the terms are
+  // divided by the sampled denominator, so no correction is needed.
+  if (numSamples > 0 && numSamples < dataset.n_cols - 1)
+  {
+    for (size_t i = begin; i < begin + batchSize; ++i)
+    {
+      const arma::vec stretchedI = coordinates * dataset.col(i);
+
+      numerator = 0;
+      denominator = 0;
+
+      firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
+      secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
+
+      for (size_t s = 0; s < numSamples; ++s)
+      {
+        // Draw a candidate other than the point itself.
+        size_t k = math::RandInt(dataset.n_cols - 1);
+        if (k >= i)
+          ++k;
+
+        const arma::vec stretchedK = coordinates * dataset.col(k);
+        const double eval = std::exp(-metric.Evaluate(stretchedI, stretchedK));
+
+        // For x_ik we are not using stretched points.
+        GradType x_ik = dataset.col(i) - dataset.col(k);
+        if (labels[i] == labels[k])
+        {
+          numerator += eval;
+          secondTerm += eval * x_ik * trans(x_ik);
+        }
+
+        denominator += eval;
+        firstTerm += eval * x_ik * trans(x_ik);
+      }
+
+      if (denominator == 0)
+      {
+        Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
+        continue;
+      }
+
+      const double p = numerator / denominator;
+      firstTerm /= denominator;
+      secondTerm /= denominator;
+
+      // Assemble the estimated gradient contribution of this point; we negate
+      // it because our optimizer is a minimizer.
+      gradient += -2 * coordinates * (p * firstTerm - secondTerm);
+    }
+
+    return;
+  }
+
   // Compute the stretched dataset.
   stretchedDataset = coordinates * dataset;
   for (size_t i = begin; i < begin + batchSize; ++i)
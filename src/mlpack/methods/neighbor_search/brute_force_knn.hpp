@@ -0,0 +1,90 @@
+/**
+ * @file methods/neighbor_search/brute_force_knn.hpp
+ * @author Ryan Curtin
+ *
+ * A blocked brute-force k-nearest-neighbor engine for dense data.  In low
+ * dimensions (roughly eight or fewer) neither tree pruning nor the pairwise
+ * base-case loop of NAIVE_MODE pays off: the former spends its time on
+ * bookkeeping and the latter cannot use the matrix-multiply units.  This
+ * engine instead tiles the query and reference sets into cache-sized blocks
+ * and computes each distance block with the identity
+ *
+ *   ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y,
+ *
+ * so that the dominant cost is a dense matrix product that Armadillo hands to
+ * BLAS, followed by a streaming top-k selection over each block.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_BRUTE_FORCE_KNN_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_BRUTE_FORCE_KNN_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The BruteForceKNN class performs exact neighbor search with blocked dense
+ * linear algebra instead of pairwise distance loops.  It supports only the
+ * Euclidean metric (the blocked formulation depends on the inner-product
+ * expansion of the squared L2 distance).
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ */
+template<typename SortPolicy = NearestNeighborSort>
+class BruteForceKNN
+{
+ public:
+  /**
+   * Search for the k exact neighbors of every column of the query set,
+   * storing the results ordered best-first according to the sort policy.
+   *
+   * @param referenceSet Set of reference points.
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store neighbor indices in.
+   * @param distances Matrix to store neighbor distances in.
+   * @param sameSet If true, the query and reference sets are taken to be the
+   *      same, and a query point will not return itself in the results.
+   */
+  static void Search(const arma::mat& referenceSet,
+                     const arma::mat& querySet,
+                     const size_t k,
+                     arma::Mat<size_t>& neighbors,
+                     arma::mat& distances,
+                     const bool sameSet = false);
+
+  /**
+   * Search for the k exact neighbors of every point in the reference set
+   * itself (monochromatic search); a point is never its own neighbor.
+   *
+   * @param referenceSet Set of reference points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store neighbor indices in.
+   * @param distances Matrix to store neighbor distances in.
+   */
+  static void Search(const arma::mat& referenceSet,
+                     const size_t k,
+                     arma::Mat<size_t>& neighbors,
+                     arma::mat& distances);
+
+ private:
+  //! Number of query points per tile; one tile's distance block should stay
+  //! resident in L2 cache.
+  static const size_t queryBlockSize = 256;
+  //! Number of reference points per tile.
+  static const size_t refBlockSize = 1024;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "brute_force_knn_impl.hpp"
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file methods/neighbor_search/brute_force_knn_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the blocked brute-force neighbor search engine.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_BRUTE_FORCE_KNN_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_BRUTE_FORCE_KNN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "brute_force_knn.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy>
+void BruteForceKNN<SortPolicy>::Search(const arma::mat& referenceSet,
+                                       const arma::mat& querySet,
+                                       const size_t k,
+                                       arma::Mat<size_t>& neighbors,
+                                       arma::mat& distances,
+                                       const bool sameSet)
+{
+  if (k > referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referenceSet.n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  neighbors.fill(referenceSet.n_cols);
+  distances.fill(SortPolicy::WorstDistance());
+
+  // Squared norms of every point; computed once, reused by every block.
+  const arma::rowvec refNorms = arma::sum(arma::square(referenceSet), 0);
+  const arma::rowvec queryNorms = arma::sum(arma::square(querySet), 0);
+
+  const size_t numQueryBlocks =
+      (querySet.n_cols + queryBlockSize - 1) / queryBlockSize;
+
+  // Query blocks are independent; process them in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numQueryBlocks; ++block)
+  {
+    const size_t qStart = block * queryBlockSize;
+    const size_t qEnd =
+        std::min(qStart + queryBlockSize, (size_t) querySet.n_cols) - 1;
+    const size_t numBlockQueries = qEnd - qStart + 1;
+
+    for (size_t rStart = 0; rStart < referenceSet.n_cols;
+         rStart += refBlockSize)
+    {
+      const size_t rEnd =
+          std::min(rStart + refBlockSize, (size_t) referenceSet.n_cols) - 1;
+
+      // The core of the engine: one dense matrix product gives all the
+      // cross-products of the tile, and the squared distances follow from
+      // the norm expansion.  Rounding can push tiny distances slightly
+      // negative, so clamp before taking the square root.
+      arma::mat distBlock = -2.0 *
+          (querySet.cols(qStart, qEnd).t() * referenceSet.cols(rStart, rEnd));
+      distBlock.each_row() += refNorms.subvec(rStart, rEnd);
+      distBlock.each_col() += queryNorms.subvec(qStart, qEnd).t();
+      distBlock = arma::sqrt(arma::clamp(distBlock, 0.0, DBL_MAX));
+
+      // Streaming top-k selection: fold this tile's distances into the
+      // per-query candidate lists (kept sorted best-first).
+      for (size_t q = 0; q < numBlockQueries; ++q)
+      {
+        const size_t queryIndex = qStart + q;
+
+        for (size_t r = 0; r <= rEnd - rStart; ++r)
+        {
+          const size_t refIndex = rStart + r;
+          if (sameSet && (queryIndex == refIndex))
+            continue;
+
+          const double dist = distBlock(q, r);
+          if (!SortPolicy::IsBetter(dist, distances(k - 1, queryIndex)))
+            continue;
+
+          // Insert into the sorted candidate list.
+          size_t pos = k - 1;
+          while (pos > 0 &&
+                 SortPolicy::IsBetter(dist, distances(pos - 1, queryIndex)))
+          {
+            distances(pos, queryIndex) = distances(pos - 1, queryIndex);
+            neighbors(pos, queryIndex) = neighbors(pos - 1, queryIndex);
+            --pos;
+          }
+          distances(pos, queryIndex) = dist;
+          neighbors(pos, queryIndex) = refIndex;
+        }
+      }
+    }
+  }
+}
+
+template<typename SortPolicy>
+void BruteForceKNN<SortPolicy>::Search(const arma::mat& referenceSet,
+                                       const size_t k,
+                                       arma::Mat<size_t>& neighbors,
+                                       arma::mat& distances)
+{
+  if (k >= referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than or equal to the "
+        << "number of points in the reference set (" << referenceSet.n_cols
+        << ") and no query set has been provided.";
+    throw std::invalid_argument(ss.str());
+  }
+
+  Search(referenceSet, referenceSet, k, neighbors, distances, true);
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file methods/neighbor_search/hnsw_index.hpp
+ * @author Ryan Curtin
+ *
+ * A hierarchical navigable small world (HNSW) graph index for approximate
+ * nearest neighbor search.  Unlike the tree-based indexes in mlpack, the HNSW
+ * index is a layered proximity graph: each point is inserted incrementally and
+ * linked to its approximate nearest neighbors on every layer it belongs to,
+ * and queries descend through the layers with a beam search whose width (the
+ * 'ef' parameter) trades accuracy for speed.
+ *
+ * For more information, see the following paper.
+ *
+ * @code
+ * @article{malkov2018efficient,
+ *   title={Efficient and robust approximate nearest neighbor search using
+ *       hierarchical navigable small world graphs},
+ *   author={Malkov, Yu A. and Yashunin, D. A.},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={42},
+ *   number={4},
+ *   pages={824--836},
+ *   year={2018}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_HNSW_INDEX_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_HNSW_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+#include <queue>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The HNSWIndex class implements approximate k-nearest-neighbor search with a
+ * hierarchical navigable small world graph.  The graph is built incrementally
+ * (one point at a time), so the index also supports appending new points after
+ * construction.  Search is approximate: recall is controlled by the beam
+ * width parameter ef, which can be set per-index via Ef().
+ *
+ * Note that graph-based search always looks for the *nearest* neighbors; this
+ * class cannot be used for furthest neighbor search.
+ *
+ * @tparam MetricType The metric to use for distance computations.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat>
+class HNSWIndex
+{
+ public:
+  /**
+   * Construct an empty HNSW index.  Points can be added afterwards with
+   * Train() or Insert().
+   *
+   * @param maxNeighbors Maximum number of links per node on the upper layers
+   *      (the 'M' parameter); the bottom layer allows twice as many.
+   * @param efConstruction Beam width used during graph construction.
+   * @param ef Default beam width used during search.
+   */
+  HNSWIndex(const size_t maxNeighbors = 16,
+            const size_t efConstruction = 200,
+            const size_t ef = 64);
+
+  /**
+   * Build the index on the given reference set, replacing any points already
+   * held.  The points are inserted incrementally in column order.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Insert a single point into the index and return its index (which is the
+   * column it occupies in the held dataset).
+   *
+   * @param point Point to insert.
+   */
+  template<typename VecType>
+  size_t Insert(const VecType& point);
+
+  /**
+   * Search for the k approximate nearest neighbors of every column of the
+   * query set.  Results are stored in the given matrices, ordered from
+   * nearest to furthest; if fewer than k points can be reached in the graph,
+   * the remaining entries are filled with SIZE_MAX and DBL_MAX.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store neighbor indices in.
+   * @param distances Matrix to store neighbor distances in.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Search for the k approximate nearest neighbors of every point in the
+   * index itself (monochromatic search).  A point is never returned as its
+   * own neighbor.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store neighbor indices in.
+   * @param distances Matrix to store neighbor distances in.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  //! Get the dataset held by the index.
+  const MatType& Dataset() const { return dataset; }
+
+  //! Get the search beam width.
+  size_t Ef() const { return ef; }
+  //! Modify the search beam width.
+  size_t& Ef() { return ef; }
+
+  //! Get the maximum number of links per node on the upper layers.
+  size_t MaxNeighbors() const { return maxNeighbors; }
+
+  //! Get the construction beam width.
+  size_t EfConstruction() const { return efConstruction; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! A (distance, point index) pair; ordered by distance.
+  typedef std::pair<double, size_t> Candidate;
+
+  //! Pick a random level for a new node.
+  size_t RandomLevel() const;
+
+  /**
+   * Greedy beam search on one layer: starting from the given entry point,
+   * expand the efLocal closest unvisited nodes until no improvement is
+   * possible, and return the efLocal best candidates found (closest first).
+   */
+  template<typename VecType>
+  void SearchLayer(const VecType& query,
+                   const size_t entry,
+                   const size_t efLocal,
+                   const size_t level,
+                   std::vector<Candidate>& result) const;
+
+  //! The common search path: beam search with the given width.
+  void SearchInternal(const MatType& querySet,
+                      const size_t k,
+                      const size_t efLocal,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances) const;
+
+  //! Link a new node into one layer, capping neighbor lists.
+  template<typename VecType>
+  void LinkNode(const VecType& point,
+                const size_t index,
+                const size_t level,
+                const std::vector<Candidate>& candidates);
+
+  //! Insert the point in the given column of the dataset into the graph.
+  void InsertIntoGraph(const size_t index);
+
+  //! The points held by the index (points are columns).
+  MatType dataset;
+
+  //! Maximum links per node above the bottom layer.
+  size_t maxNeighbors;
+  //! Beam width used during construction.
+  size_t efConstruction;
+  //! Default beam width used during search.
+  size_t ef;
+
+  //! Level scaling factor (1 / ln(maxNeighbors)).
+  double levelMult;
+
+  //! Adjacency lists: links[i][l] holds the neighbors of point i on layer l.
+  std::vector<std::vector<std::vector<size_t>>> links;
+
+  //! The entry point of the top layer (undefined if the index is empty).
+  size_t entryPoint;
+
+  //! The instantiated metric.
+  MetricType metric;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "hnsw_index_impl.hpp"
+
+#endif
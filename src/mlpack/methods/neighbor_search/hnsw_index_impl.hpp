@@ -0,0 +1,341 @@
+/**
+ * @file methods/neighbor_search/hnsw_index_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the HNSWIndex class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_HNSW_INDEX_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_HNSW_INDEX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hnsw_index.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename MetricType, typename MatType>
+HNSWIndex<MetricType, MatType>::HNSWIndex(const size_t maxNeighbors,
+                                          const size_t efConstruction,
+                                          const size_t ef) :
+    maxNeighbors(std::max(maxNeighbors, (size_t) 2)),
+    efConstruction(std::max(efConstruction, (size_t) 1)),
+    ef(std::max(ef, (size_t) 1)),
+    levelMult(1.0 / std::log((double) std::max(maxNeighbors, (size_t) 2))),
+    entryPoint(0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename MatType>
+void HNSWIndex<MetricType, MatType>::Train(MatType referenceSet)
+{
+  dataset = std::move(referenceSet);
+  links.clear();
+  links.resize(dataset.n_cols);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    InsertIntoGraph(i);
+}
+
+template<typename MetricType, typename MatType>
+template<typename VecType>
+size_t HNSWIndex<MetricType, MatType>::Insert(const VecType& point)
+{
+  const size_t index = dataset.n_cols;
+  dataset.insert_cols(index, point);
+  links.resize(dataset.n_cols);
+  InsertIntoGraph(index);
+  return index;
+}
+
+template<typename MetricType, typename MatType>
+size_t HNSWIndex<MetricType, MatType>::RandomLevel() const
+{
+  // (1 - Random()) lies in (0, 1], so the logarithm is finite.
+  const size_t level =
+      (size_t) std::floor(-std::log(1.0 - math::Random()) * levelMult);
+
+  // Clamp absurd draws so the layer stack stays small.
+  return std::min(level, (size_t) 32);
+}
+
+template<typename MetricType, typename MatType>
+template<typename VecType>
+void HNSWIndex<MetricType, MatType>::SearchLayer(
+    const VecType& query,
+    const size_t entry,
+    const size_t efLocal,
+    const size_t level,
+    std::vector<Candidate>& result) const
+{
+  // Candidates to expand, closest first.
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      std::greater<Candidate>> frontier;
+  // The best efLocal results found so far, furthest first.
+  std::priority_queue<Candidate> best;
+  std::vector<bool> visited(dataset.n_cols, false);
+
+  const double entryDist = metric.Evaluate(query, dataset.col(entry));
+  frontier.push(std::make_pair(entryDist, entry));
+  best.push(std::make_pair(entryDist, entry));
+  visited[entry] = true;
+
+  while (!frontier.empty())
+  {
+    const Candidate current = frontier.top();
+    frontier.pop();
+
+    // Every remaining candidate is at least this far away, so if the result
+    // set is full and closer, the search has converged.
+    if ((best.size() >= efLocal) && (current.first > best.top().first))
+      break;
+
+    const std::vector<size_t>& curLinks = links[current.second][level];
+    for (size_t j = 0; j < curLinks.size(); ++j)
+    {
+      const size_t neighbor = curLinks[j];
+      if (visited[neighbor])
+        continue;
+      visited[neighbor] = true;
+
+      const double dist = metric.Evaluate(query, dataset.col(neighbor));
+      if ((best.size() < efLocal) || (dist < best.top().first))
+      {
+        frontier.push(std::make_pair(dist, neighbor));
+        best.push(std::make_pair(dist, neighbor));
+        if (best.size() > efLocal)
+          best.pop();
+      }
+    }
+  }
+
+  // Unload the results, closest first.
+  result.resize(best.size());
+  for (size_t i = result.size(); i > 0; --i)
+  {
+    result[i - 1] = best.top();
+    best.pop();
+  }
+}
+
+template<typename MetricType, typename MatType>
+template<typename VecType>
+void HNSWIndex<MetricType, MatType>::LinkNode(
+    const VecType& /* point */,
+    const size_t index,
+    const size_t level,
+    const std::vector<Candidate>& candidates)
+{
+  // The bottom layer holds the actual neighborhood structure, so it is
+  // allowed twice as many links.
+  const size_t cap = (level == 0) ? (2 * maxNeighbors) : maxNeighbors;
+
+  // Link the new node to its closest candidates.  (This is the simple
+  // closest-first selection; the diversity heuristic of the HNSW paper could
+  // be swapped in here.)
+  for (size_t i = 0; i < candidates.size() && i < maxNeighbors; ++i)
+  {
+    const size_t neighbor = candidates[i].second;
+    if (neighbor == index)
+      continue;
+
+    links[index][level].push_back(neighbor);
+    links[neighbor][level].push_back(index);
+
+    // If the neighbor's list overflowed, keep only its closest links.
+    std::vector<size_t>& neighborLinks = links[neighbor][level];
+    if (neighborLinks.size() > cap)
+    {
+      std::vector<Candidate> ranked(neighborLinks.size());
+      for (size_t j = 0; j < neighborLinks.size(); ++j)
+      {
+        ranked[j] = std::make_pair(metric.Evaluate(
+            dataset.col(neighbor), dataset.col(neighborLinks[j])),
+            neighborLinks[j]);
+      }
+      std::sort(ranked.begin(), ranked.end());
+
+      neighborLinks.resize(cap);
+      for (size_t j = 0; j < cap; ++j)
+        neighborLinks[j] = ranked[j].second;
+    }
+  }
+}
+
+template<typename MetricType, typename MatType>
+void HNSWIndex<MetricType, MatType>::InsertIntoGraph(const size_t index)
+{
+  const size_t level = RandomLevel();
+  links[index].resize(level + 1);
+
+  // The first point becomes the entry point of the graph.
+  if (index == 0)
+  {
+    entryPoint = index;
+    return;
+  }
+
+  const arma::vec point = dataset.col(index);
+  const size_t maxLevel = links[entryPoint].size() - 1;
+  const size_t topLinkLevel = std::min(level, maxLevel);
+
+  // Greedily descend through the layers above the new node's top level.
+  size_t current = entryPoint;
+  double currentDist = metric.Evaluate(point, dataset.col(current));
+  for (size_t l = maxLevel; l > topLinkLevel; --l)
+  {
+    bool changed = true;
+    while (changed)
+    {
+      changed = false;
+      const std::vector<size_t>& curLinks = links[current][l];
+      for (size_t j = 0; j < curLinks.size(); ++j)
+      {
+        const double dist = metric.Evaluate(point, dataset.col(curLinks[j]));
+        if (dist < currentDist)
+        {
+          current = curLinks[j];
+          currentDist = dist;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  // Link the new node on every layer it belongs to, reusing the closest
+  // candidate of each layer as the entry point of the next one down.
+  for (size_t l = topLinkLevel + 1; l-- > 0; )
+  {
+    std::vector<Candidate> candidates;
+    SearchLayer(point, current, efConstruction, l, candidates);
+    LinkNode(point, index, l, candidates);
+    current = candidates[0].second;
+  }
+
+  // If the new node drew a level above the current top layer, it becomes the
+  // new entry point.
+  if (level > maxLevel)
+    entryPoint = index;
+}
+
+template<typename MetricType, typename MatType>
+void HNSWIndex<MetricType, MatType>::Search(const MatType& querySet,
+                                            const size_t k,
+                                            arma::Mat<size_t>& neighbors,
+                                            arma::mat& distances) const
+{
+  SearchInternal(querySet, k, std::max(ef, k), neighbors, distances);
+}
+
+template<typename MetricType, typename MatType>
+void HNSWIndex<MetricType, MatType>::SearchInternal(
+    const MatType& querySet,
+    const size_t k,
+    const size_t efLocal,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances) const
+{
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  neighbors.fill(SIZE_MAX);
+  distances.fill(DBL_MAX);
+
+  if (dataset.n_cols == 0)
+    return;
+
+  // Queries are independent; process them in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    const arma::vec query = querySet.col(i);
+
+    // Greedily descend from the top layer to layer 1.
+    size_t current = entryPoint;
+    double currentDist = metric.Evaluate(query, dataset.col(current));
+    for (size_t l = links[entryPoint].size() - 1; l > 0; --l)
+    {
+      bool changed = true;
+      while (changed)
+      {
+        changed = false;
+        const std::vector<size_t>& curLinks = links[current][l];
+        for (size_t j = 0; j < curLinks.size(); ++j)
+        {
+          const double dist = metric.Evaluate(query, dataset.col(curLinks[j]));
+          if (dist < currentDist)
+          {
+            current = curLinks[j];
+            currentDist = dist;
+            changed = true;
+          }
+        }
+      }
+    }
+
+    // Beam search on the bottom layer.
+    std::vector<Candidate> candidates;
+    SearchLayer(query, current, efLocal, 0, candidates);
+
+    for (size_t j = 0; j < k && j < candidates.size(); ++j)
+    {
+      distances(j, i) = candidates[j].first;
+      neighbors(j, i) = candidates[j].second;
+    }
+  }
+}
+
+template<typename MetricType, typename MatType>
+void HNSWIndex<MetricType, MatType>::Search(const size_t k,
+                                            arma::Mat<size_t>& neighbors,
+                                            arma::mat& distances) const
+{
+  // Search for one extra neighbor (with a correspondingly wider beam), then
+  // strip each point from its own results.
+  arma::Mat<size_t> rawNeighbors;
+  arma::mat rawDistances;
+  SearchInternal(dataset, k + 1, std::max(ef, k + 1), rawNeighbors,
+      rawDistances);
+
+  neighbors.set_size(k, dataset.n_cols);
+  distances.set_size(k, dataset.n_cols);
+  neighbors.fill(SIZE_MAX);
+  distances.fill(DBL_MAX);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    size_t pos = 0;
+    for (size_t j = 0; j < rawNeighbors.n_rows && pos < k; ++j)
+    {
+      if (rawNeighbors(j, i) == i || rawNeighbors(j, i) == SIZE_MAX)
+        continue;
+
+      neighbors(pos, i) = rawNeighbors(j, i);
+      distances(pos, i) = rawDistances(j, i);
+      ++pos;
+    }
+  }
+}
+
+template<typename MetricType, typename MatType>
+template<typename Archive>
+void HNSWIndex<MetricType, MatType>::serialize(Archive& ar,
+                                               const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(dataset));
+  ar(CEREAL_NVP(maxNeighbors));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(ef));
+  ar(CEREAL_NVP(levelMult));
+  ar(CEREAL_NVP(links));
+  ar(CEREAL_NVP(entryPoint));
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
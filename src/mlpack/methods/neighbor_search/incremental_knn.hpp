@@ -0,0 +1,342 @@
+/**
+ * @file methods/neighbor_search/incremental_knn.hpp
+ * @author Ryan Curtin
+ *
+ * An updatable k-nearest-neighbor index: an immutable kd-tree index plus a
+ * small delta buffer of inserted points and a tombstone set of deleted
+ * points, with a (possibly background) rebuild that folds the deltas back
+ * into the tree.  This lets a KNN service absorb streaming updates without
+ * rebuilding the tree on every change.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_INCREMENTAL_KNN_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_INCREMENTAL_KNN_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <future>
+#include <unordered_set>
+
+#include "neighbor_search.hpp"
+#include "typedef.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * IncrementalKNN provides exact k-nearest-neighbor search over a point set
+ * that changes over time.  BinarySpaceTree stores its points contiguously
+ * and cannot be mutated in place, so instead of rebuilding the whole tree on
+ * every change, the index is kept in three parts:
+ *
+ *  - a frozen kd-tree index (a KNN object) over a snapshot of the points;
+ *  - a delta buffer of points inserted since the snapshot, searched by brute
+ *    force (the buffer is small by construction); and
+ *  - a tombstone set of deleted points, filtered out of tree results.
+ *
+ * Every point has a stable id: points from the initial set keep their column
+ * index, and Insert() returns the id of the new point.  Search() results are
+ * reported in these ids and always reflect all inserts and deletes so far.
+ *
+ * When the deltas exceed a configurable fraction of the indexed points, the
+ * index rebuilds the tree from the live points and clears the deltas.  The
+ * rebuild can also be started explicitly on a background thread with
+ * RebuildAsync(); queries keep being served from the old tree and the delta
+ * buffer until the new tree is ready, and the swap happens on the next call
+ * into the index.  The object itself is not internally synchronized: calls
+ * into it must be externally serialized, as with the rest of mlpack.
+ */
+class IncrementalKNN
+{
+ public:
+  /**
+   * Construct the index over an initial reference set.  Point i of the
+   * reference set gets id i.
+   *
+   * @param referenceSet Initial set of points to index.
+   * @param rebuildRatio Rebuild the tree when the number of buffered inserts
+   *     plus tombstones exceeds this fraction of the indexed points.
+   */
+  IncrementalKNN(const arma::mat& referenceSet,
+                 const double rebuildRatio = 0.05) :
+      points(referenceSet),
+      rebuildRatio(rebuildRatio)
+  {
+    treeIds.resize(referenceSet.n_cols);
+    for (size_t i = 0; i < referenceSet.n_cols; ++i)
+      treeIds[i] = i;
+
+    if (referenceSet.n_cols > 0)
+      searcher.reset(new KNN(referenceSet));
+  }
+
+  ~IncrementalKNN()
+  {
+    // A background rebuild may still reference our point store.
+    if (pending.valid())
+      pending.wait();
+  }
+
+  /**
+   * Insert a point, returning its id.  The point lands in the delta buffer
+   * and is immediately visible to searches; a rebuild is started when the
+   * deltas grow past the rebuild ratio.
+   *
+   * @param point Point to insert.
+   */
+  size_t Insert(const arma::vec& point)
+  {
+    Absorb();
+
+    const size_t id = points.n_cols;
+    points.insert_cols(points.n_cols, point);
+    bufferIds.push_back(id);
+
+    MaybeRebuild();
+    return id;
+  }
+
+  /**
+   * Delete the point with the given id.  Buffered points are dropped
+   * outright; indexed points are tombstoned until the next rebuild.
+   *
+   * @param id Id of the point to delete.
+   */
+  void Delete(const size_t id)
+  {
+    Absorb();
+
+    for (size_t i = 0; i < bufferIds.size(); ++i)
+    {
+      if (bufferIds[i] == id)
+      {
+        bufferIds.erase(bufferIds.begin() + i);
+        return;
+      }
+    }
+
+    deleted.insert(id);
+    MaybeRebuild();
+  }
+
+  /**
+   * Search for the k nearest neighbors of each query point among the live
+   * points, writing ids into neighbors and distances into distances.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to find; must not exceed NumPoints().
+   * @param neighbors Matrix to store neighbor ids in (k x numQueries).
+   * @param distances Matrix to store neighbor distances in.
+   */
+  void Search(const arma::mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances)
+  {
+    Absorb();
+
+    if (k > NumPoints())
+    {
+      Log::Fatal << "IncrementalKNN::Search(): requested " << k << " neighbors"
+          << " but only " << NumPoints() << " points are live!" << std::endl;
+    }
+
+    // Ask the tree for enough extra neighbors to survive tombstone
+    // filtering; every tombstone can displace at most one result.
+    arma::Mat<size_t> treeNeighbors;
+    arma::mat treeDistances;
+    const size_t treeK = std::min(k + deleted.size(), treeIds.size());
+    if (searcher && treeK > 0)
+      searcher->Search(querySet, treeK, treeNeighbors, treeDistances);
+
+    neighbors.set_size(k, querySet.n_cols);
+    distances.set_size(k, querySet.n_cols);
+
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
+      // Merge the filtered tree results with a brute-force scan of the delta
+      // buffer, keeping the k best overall.
+      neighbors.col(q).fill(SIZE_MAX);
+      distances.col(q).fill(DBL_MAX);
+
+      if (searcher && treeK > 0)
+      {
+        for (size_t j = 0; j < treeK; ++j)
+        {
+          const size_t id = treeIds[treeNeighbors(j, q)];
+          if (deleted.count(id) == 0)
+            InsertResult(neighbors.colptr(q), distances.colptr(q), k, id,
+                treeDistances(j, q));
+        }
+      }
+
+      for (size_t i = 0; i < bufferIds.size(); ++i)
+      {
+        const double dist = metric::EuclideanDistance::Evaluate(
+            querySet.col(q), points.col(bufferIds[i]));
+        InsertResult(neighbors.colptr(q), distances.colptr(q), k,
+            bufferIds[i], dist);
+      }
+    }
+  }
+
+  /**
+   * Rebuild the tree from the live points, folding the delta buffer in and
+   * clearing the tombstones.  Blocks until done.
+   */
+  void Rebuild()
+  {
+    if (pending.valid())
+      pending.wait();
+    Absorb();
+
+    StartRebuild();
+    Absorb();
+  }
+
+  /**
+   * Start a rebuild on a background thread.  Queries keep being served from
+   * the current tree and delta buffer; the new tree is swapped in by the
+   * next call into the index after the build finishes.  Points inserted or
+   * deleted while the rebuild runs stay in the deltas across the swap.
+   */
+  void RebuildAsync()
+  {
+    if (pending.valid())
+      return; // A rebuild is already running.
+
+    StartRebuild();
+  }
+
+  //! Get the number of live points in the index.
+  size_t NumPoints() const
+  { return treeIds.size() - deleted.size() + bufferIds.size(); }
+
+  //! Get the number of points currently in the delta buffer.
+  size_t BufferSize() const { return bufferIds.size(); }
+
+  //! Get the number of tombstoned points awaiting a rebuild.
+  size_t TombstoneCount() const { return deleted.size(); }
+
+ private:
+  //! The result of a (possibly background) rebuild.
+  struct RebuildResult
+  {
+    std::unique_ptr<KNN> searcher;
+    std::vector<size_t> treeIds;
+    size_t bufferAbsorbed;
+    std::unordered_set<size_t> deletedAbsorbed;
+  };
+
+  //! Snapshot the live points and kick off the tree build.
+  void StartRebuild()
+  {
+    // The snapshot contains the current tree's live points plus the current
+    // delta buffer; anything added or removed later stays in the deltas.
+    std::vector<size_t> liveIds;
+    liveIds.reserve(NumPoints());
+    for (size_t i = 0; i < treeIds.size(); ++i)
+      if (deleted.count(treeIds[i]) == 0)
+        liveIds.push_back(treeIds[i]);
+    for (size_t i = 0; i < bufferIds.size(); ++i)
+      liveIds.push_back(bufferIds[i]);
+
+    // The snapshot matrix is held through a shared_ptr so the (C++11)
+    // by-value lambda capture does not copy it again.
+    std::shared_ptr<arma::mat> liveSet(
+        new arma::mat(points.n_rows, liveIds.size()));
+    for (size_t i = 0; i < liveIds.size(); ++i)
+      liveSet->col(i) = points.col(liveIds[i]);
+
+    const size_t bufferAbsorbed = bufferIds.size();
+    const std::unordered_set<size_t> deletedAbsorbed = deleted;
+
+    pending = std::async(std::launch::async,
+        [liveSet, liveIds, bufferAbsorbed, deletedAbsorbed]() -> RebuildResult
+        {
+          RebuildResult result;
+          if (liveSet->n_cols > 0)
+            result.searcher.reset(new KNN(std::move(*liveSet)));
+          result.treeIds = liveIds;
+          result.bufferAbsorbed = bufferAbsorbed;
+          result.deletedAbsorbed = deletedAbsorbed;
+          return result;
+        });
+  }
+
+  //! Swap in a finished rebuild, if one is ready.
+  void Absorb()
+  {
+    if (!pending.valid() || pending.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready)
+      return;
+
+    RebuildResult result = pending.get();
+    searcher = std::move(result.searcher);
+    treeIds = std::move(result.treeIds);
+
+    // The absorbed prefix of the buffer is now in the tree; absorbed
+    // tombstones were excluded from it entirely.
+    bufferIds.erase(bufferIds.begin(),
+        bufferIds.begin() + result.bufferAbsorbed);
+    for (const size_t id : result.deletedAbsorbed)
+      deleted.erase(id);
+  }
+
+  //! Start a background rebuild if the deltas have outgrown the threshold.
+  void MaybeRebuild()
+  {
+    if (pending.valid())
+      return;
+
+    if ((double) (bufferIds.size() + deleted.size()) >
+        rebuildRatio * std::max<size_t>(treeIds.size(), 1))
+      StartRebuild();
+  }
+
+  //! Insert a candidate into a fixed-size sorted result column.
+  static void InsertResult(size_t* neighbors,
+                           double* distances,
+                           const size_t k,
+                           const size_t id,
+                           const double dist)
+  {
+    if (dist >= distances[k - 1])
+      return;
+
+    size_t j = k - 1;
+    while (j > 0 && distances[j - 1] > dist)
+    {
+      distances[j] = distances[j - 1];
+      neighbors[j] = neighbors[j - 1];
+      --j;
+    }
+    distances[j] = dist;
+    neighbors[j] = id;
+  }
+
+  //! Append-only store of every point ever inserted, indexed by id.
+  arma::mat points;
+  //! Rebuild when the deltas exceed this fraction of the indexed points.
+  double rebuildRatio;
+
+  //! The frozen tree index over the last snapshot (NULL if empty).
+  std::unique_ptr<KNN> searcher;
+  //! Id of each point in the searcher's reference set, by reference column.
+  std::vector<size_t> treeIds;
+  //! Ids of points inserted since the last snapshot.
+  std::vector<size_t> bufferIds;
+  //! Ids of deleted points still present in the tree.
+  std::unordered_set<size_t> deleted;
+
+  //! An in-flight background rebuild, if any.
+  std::future<RebuildResult> pending;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file methods/neighbor_search/inverted_index_knn.hpp
+ * @author Ryan Curtin
+ *
+ * An exact k-nearest-neighbor engine for very sparse data (e.g. TF-IDF
+ * vectors), built on an inverted index over the nonzero entries of the
+ * reference set.  Space-partitioning trees offer no useful pruning in the
+ * very high dimensionalities where such data lives, and densifying the data
+ * for brute-force search is often impossible outright.  With the squared
+ * Euclidean distance expanded as
+ *
+ *   ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y,
+ *
+ * only reference points sharing at least one nonzero dimension with the query
+ * have a nonzero cross term, and the inverted index enumerates exactly those;
+ * every other reference point sits at the distance given by the norms alone,
+ * so the exact k-nearest set can be completed from a norm-sorted list of the
+ * untouched references.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_INVERTED_INDEX_KNN_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_INVERTED_INDEX_KNN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The InvertedIndexKNN class performs exact nearest neighbor search on sparse
+ * data under the Euclidean metric.  The cost of a query is proportional to
+ * the number of reference nonzeros in the dimensions where the query itself
+ * is nonzero, not to the size of the reference set, which makes it the right
+ * backend when both sets are a fraction of a percent dense.
+ */
+class InvertedIndexKNN
+{
+ public:
+  /**
+   * Construct the index over the given reference set.  The reference set is
+   * copied; the inverted index stores one entry per nonzero of the set.
+   *
+   * @param referenceSet Sparse set of reference points.
+   */
+  InvertedIndexKNN(const arma::sp_mat& referenceSet);
+
+  /**
+   * Search for the k exact nearest neighbors of every column of the query
+   * set, storing the results ordered best-first.
+   *
+   * @param querySet Sparse set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store neighbor indices in.
+   * @param distances Matrix to store neighbor distances in.
+   */
+  void Search(const arma::sp_mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Search for the k exact nearest neighbors of every point in the reference
+   * set itself (monochromatic search); a point is never its own neighbor.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store neighbor indices in.
+   * @param distances Matrix to store neighbor distances in.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  //! Get the reference set.
+  const arma::sp_mat& ReferenceSet() const { return referenceSet; }
+
+ private:
+  /**
+   * Perform the search; the query and reference sets are taken to be the same
+   * set if sameSet is true.
+   */
+  void SearchInternal(const arma::sp_mat& querySet,
+                      const size_t k,
+                      const bool sameSet,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances) const;
+
+  //! The reference set.
+  arma::sp_mat referenceSet;
+
+  //! Offset of each dimension's posting list in indexPoints/indexValues;
+  //! dimension d occupies positions [indexOffsets[d], indexOffsets[d + 1]).
+  arma::uvec indexOffsets;
+  //! Reference point index of each posting, grouped by dimension.
+  arma::uvec indexPoints;
+  //! Value of each posting.
+  arma::vec indexValues;
+
+  //! Squared norm of each reference point.
+  arma::vec refNorms;
+  //! Reference point indices sorted by ascending squared norm; used to
+  //! complete the neighbor set from references with no shared nonzeros.
+  arma::uvec normOrder;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "inverted_index_knn_impl.hpp"
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * @file methods/neighbor_search/inverted_index_knn_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the InvertedIndexKNN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_INVERTED_INDEX_KNN_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_INVERTED_INDEX_KNN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "inverted_index_knn.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace neighbor {
+
+inline InvertedIndexKNN::InvertedIndexKNN(const arma::sp_mat& referenceSet) :
+    referenceSet(referenceSet)
+{
+  const size_t dims = this->referenceSet.n_rows;
+  const size_t nnz = this->referenceSet.n_nonzero;
+
+  // Count the postings of each dimension and accumulate the squared norms in
+  // one pass over the nonzeros.
+  arma::uvec counts(dims, arma::fill::zeros);
+  refNorms.zeros(this->referenceSet.n_cols);
+  for (arma::sp_mat::const_iterator it = this->referenceSet.begin();
+       it != this->referenceSet.end(); ++it)
+  {
+    counts[it.row()]++;
+    refNorms[it.col()] += (*it) * (*it);
+  }
+
+  indexOffsets.set_size(dims + 1);
+  indexOffsets[0] = 0;
+  for (size_t d = 0; d < dims; ++d)
+    indexOffsets[d + 1] = indexOffsets[d] + counts[d];
+
+  // Fill the posting lists; the column-major order of the nonzero iteration
+  // leaves each list sorted by reference index.
+  indexPoints.set_size(nnz);
+  indexValues.set_size(nnz);
+  arma::uvec cursor(indexOffsets.head(dims));
+  for (arma::sp_mat::const_iterator it = this->referenceSet.begin();
+       it != this->referenceSet.end(); ++it)
+  {
+    const size_t pos = cursor[it.row()]++;
+    indexPoints[pos] = it.col();
+    indexValues[pos] = (*it);
+  }
+
+  normOrder = arma::stable_sort_index(refNorms);
+}
+
+inline void InvertedIndexKNN::Search(const arma::sp_mat& querySet,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances) const
+{
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    Log::Fatal << "InvertedIndexKNN::Search(): dimensionality of query set ("
+        << querySet.n_rows << ") does not match dimensionality of reference "
+        << "set (" << referenceSet.n_rows << ")!" << std::endl;
+  }
+
+  SearchInternal(querySet, k, false, neighbors, distances);
+}
+
+inline void InvertedIndexKNN::Search(const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances) const
+{
+  SearchInternal(referenceSet, k, true, neighbors, distances);
+}
+
+inline void InvertedIndexKNN::SearchInternal(const arma::sp_mat& querySet,
+                                             const size_t k,
+                                             const bool sameSet,
+                                             arma::Mat<size_t>& neighbors,
+                                             arma::mat& distances) const
+{
+  const size_t available = sameSet ? referenceSet.n_cols - 1 :
+      referenceSet.n_cols;
+  if (k > available)
+  {
+    Log::Fatal << "InvertedIndexKNN::Search(): requested value of k (" << k
+        << ") is greater than the number of available reference points ("
+        << available << ")!" << std::endl;
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Candidate represents a possible candidate neighbor (squared distance,
+  // index); the worst candidate sits on top of the queue.
+  typedef std::pair<double, size_t> Candidate;
+
+  #pragma omp parallel default(shared)
+  {
+    // Per-thread accumulators.  The stamps mark which entries of dots belong
+    // to the current query, so only the touched entries are ever reset.
+    arma::vec dots(referenceSet.n_cols);
+    arma::uvec stamps(referenceSet.n_cols, arma::fill::zeros);
+    std::vector<size_t> touched;
+
+    #pragma omp for
+    for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
+    {
+      const size_t stamp = (size_t) q + 1;
+      touched.clear();
+
+      // Accumulate the cross products over the posting lists of the query's
+      // nonzero dimensions; only references sharing a nonzero dimension with
+      // the query are ever visited.
+      double queryNorm = 0.0;
+      for (arma::sp_mat::const_iterator it = querySet.begin_col(q);
+           it != querySet.end_col(q); ++it)
+      {
+        const double qv = (*it);
+        queryNorm += qv * qv;
+
+        const size_t d = it.row();
+        for (size_t pos = indexOffsets[d]; pos < indexOffsets[d + 1]; ++pos)
+        {
+          const size_t r = indexPoints[pos];
+          if (stamps[r] != stamp)
+          {
+            stamps[r] = stamp;
+            dots[r] = 0.0;
+            touched.push_back(r);
+          }
+          dots[r] += qv * indexValues[pos];
+        }
+      }
+
+      // Score the touched references exactly.
+      std::priority_queue<Candidate> pqueue;
+      for (size_t j = 0; j < touched.size(); ++j)
+      {
+        const size_t r = touched[j];
+        if (sameSet && r == (size_t) q)
+          continue;
+
+        const double distSq = std::max(queryNorm + refNorms[r] -
+            2.0 * dots[r], 0.0);
+        if (pqueue.size() < k)
+          pqueue.push(std::make_pair(distSq, r));
+        else if (distSq < pqueue.top().first)
+        {
+          pqueue.pop();
+          pqueue.push(std::make_pair(distSq, r));
+        }
+      }
+
+      // Complete the neighbor set from the untouched references: their cross
+      // term is exactly zero, so their squared distance is the sum of the
+      // norms, which is nondecreasing in norm order.
+      for (size_t j = 0; j < normOrder.n_elem; ++j)
+      {
+        const size_t r = normOrder[j];
+        if (stamps[r] == stamp || (sameSet && r == (size_t) q))
+          continue;
+
+        const double distSq = queryNorm + refNorms[r];
+        if (pqueue.size() < k)
+        {
+          pqueue.push(std::make_pair(distSq, r));
+        }
+        else if (distSq < pqueue.top().first)
+        {
+          pqueue.pop();
+          pqueue.push(std::make_pair(distSq, r));
+        }
+        else
+        {
+          // Every remaining untouched reference is at least this far away.
+          break;
+        }
+      }
+
+      // Store the results, best first.
+      for (size_t j = 1; j <= k; ++j)
+      {
+        neighbors(k - j, q) = pqueue.top().second;
+        distances(k - j, q) = std::sqrt(pqueue.top().first);
+        pqueue.pop();
+      }
+    }
+  }
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * @file methods/neighbor_search/k_selection.hpp
+ *
+ * Defines the KSelectionSet class, which maintains the k best candidate
+ * neighbors of every query point, using flat sorted arrays for small k and
+ * binary heaps for large k.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_K_SELECTION_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_K_SELECTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <queue>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The KSelectionSet holds, for every query point, the k best candidate
+ * neighbors found so far, ordered by the given SortPolicy (e.g.
+ * NearestNeighborSort or FurthestNeighborSort).
+ *
+ * For small k the candidates of each query point are kept in a sorted flat
+ * array, stored contiguously for all query points: an insertion attempt is
+ * a single comparison against the k-th best distance, and an accepted
+ * candidate is placed with a short shift of at most k elements, which the
+ * compiler can vectorize.  This avoids the branchy heap operations of
+ * std::priority_queue, which only pay off once k grows past the point where
+ * O(k) shifting loses to O(log k) sifting; above the threshold a per-query
+ * binary heap is used instead.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ */
+template<typename SortPolicy>
+class KSelectionSet
+{
+ public:
+  /**
+   * Construct the candidate sets for the given number of query points.  Each
+   * set is initialized with k candidates at the worst possible distance.
+   *
+   * @param k Number of neighbors to keep for each query point.
+   * @param numQueries Number of query points.
+   */
+  KSelectionSet(const size_t k, const size_t numQueries);
+
+  /**
+   * Return the distance of the k-th best candidate of the given query point
+   * (the pruning bound: a new candidate must beat this to be kept).
+   *
+   * @param queryIndex Index of the query point.
+   */
+  double Worst(const size_t queryIndex) const;
+
+  /**
+   * Attempt to insert a candidate into the set of the given query point.
+   * The candidate is kept only if it is better than the current k-th best.
+   *
+   * @param queryIndex Index of the query point.
+   * @param neighbor Index of the candidate reference point.
+   * @param distance Distance from the query point to the candidate.
+   * @return true if the candidate was kept.
+   */
+  bool Insert(const size_t queryIndex,
+              const size_t neighbor,
+              const double distance);
+
+  /**
+   * Store the candidates of every query point into the given matrices, best
+   * candidate first.  When the heap representation is used this empties the
+   * heaps, so it may only be called once.
+   *
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  template<typename ElemType>
+  void GetResults(arma::Mat<size_t>& neighbors,
+                  arma::Mat<ElemType>& distances);
+
+  //! Get the number of neighbors kept for each query point.
+  size_t K() const { return k; }
+
+  //! For k at or below this threshold, flat sorted arrays are used.
+  static const size_t flatThreshold = 32;
+
+ private:
+  //! Candidate represents a possible candidate neighbor (distance, index).
+  typedef std::pair<double, size_t> Candidate;
+
+  //! Compare two candidates based on the distance.
+  struct CandidateCmp {
+    bool operator()(const Candidate& c1, const Candidate& c2)
+    {
+      return !SortPolicy::IsBetter(c2.first, c1.first);
+    };
+  };
+
+  //! Use a priority queue to represent the list of candidate neighbors.
+  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
+      CandidateList;
+
+  //! Number of neighbors kept for each query point.
+  size_t k;
+
+  //! Whether the flat representation is in use (k <= flatThreshold).
+  bool useFlat;
+
+  //! Flat representation: column i holds the candidate distances of query
+  //! point i, best first.
+  arma::mat flatDistances;
+
+  //! Flat representation: column i holds the candidate indices of query
+  //! point i, best first.
+  arma::Mat<size_t> flatIndices;
+
+  //! Heap representation: one priority queue per query point.
+  std::vector<CandidateList> heaps;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "k_selection_impl.hpp"
+
+#endif // MLPACK_METHODS_NEIGHBOR_SEARCH_K_SELECTION_HPP
@@ -0,0 +1,130 @@
+/**
+ * @file methods/neighbor_search/k_selection_impl.hpp
+ *
+ * Implementation of the KSelectionSet class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_K_SELECTION_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_K_SELECTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "k_selection.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy>
+KSelectionSet<SortPolicy>::KSelectionSet(const size_t k,
+                                         const size_t numQueries) :
+    k(k),
+    useFlat(k <= flatThreshold)
+{
+  if (useFlat)
+  {
+    flatDistances.set_size(k, numQueries);
+    flatDistances.fill(SortPolicy::WorstDistance());
+    flatIndices.set_size(k, numQueries);
+    flatIndices.fill(size_t() - 1);
+  }
+  else
+  {
+    const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
+        size_t() - 1);
+
+    std::vector<Candidate> vect(k, def);
+    CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+    heaps.reserve(numQueries);
+    for (size_t i = 0; i < numQueries; ++i)
+      heaps.push_back(pqueue);
+  }
+}
+
+template<typename SortPolicy>
+inline double KSelectionSet<SortPolicy>::Worst(const size_t queryIndex) const
+{
+  if (useFlat)
+    return flatDistances(k - 1, queryIndex);
+  else
+    return heaps[queryIndex].top().first;
+}
+
+template<typename SortPolicy>
+inline force_inline bool KSelectionSet<SortPolicy>::Insert(
+    const size_t queryIndex,
+    const size_t neighbor,
+    const double distance)
+{
+  if (useFlat)
+  {
+    double* dist = flatDistances.colptr(queryIndex);
+    if (SortPolicy::IsBetter(dist[k - 1], distance))
+      return false;
+
+    // Shift the worse candidates down one slot; the arrays are contiguous,
+    // so the compiler can vectorize these copies.
+    size_t* idx = flatIndices.colptr(queryIndex);
+    size_t i = k - 1;
+    while (i > 0 && !SortPolicy::IsBetter(dist[i - 1], distance))
+    {
+      dist[i] = dist[i - 1];
+      idx[i] = idx[i - 1];
+      --i;
+    }
+
+    dist[i] = distance;
+    idx[i] = neighbor;
+    return true;
+  }
+  else
+  {
+    CandidateList& pqueue = heaps[queryIndex];
+    Candidate c = std::make_pair(distance, neighbor);
+
+    if (CandidateCmp()(c, pqueue.top()))
+    {
+      pqueue.pop();
+      pqueue.push(c);
+      return true;
+    }
+    return false;
+  }
+}
+
+template<typename SortPolicy>
+template<typename ElemType>
+void KSelectionSet<SortPolicy>::GetResults(arma::Mat<size_t>& neighbors,
+                                           arma::Mat<ElemType>& distances)
+{
+  const size_t numQueries = useFlat ? flatDistances.n_cols : heaps.size();
+  neighbors.set_size(k, numQueries);
+  distances.set_size(k, numQueries);
+
+  if (useFlat)
+  {
+    neighbors = flatIndices;
+    distances = arma::conv_to<arma::Mat<ElemType> >::from(flatDistances);
+  }
+  else
+  {
+    for (size_t i = 0; i < numQueries; ++i)
+    {
+      CandidateList& pqueue = heaps[i];
+      for (size_t j = 1; j <= k; ++j)
+      {
+        neighbors(k - j, i) = pqueue.top().second;
+        distances(k - j, i) = pqueue.top().first;
+        pqueue.pop();
+      }
+    }
+  }
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_NEIGHBOR_SEARCH_K_SELECTION_IMPL_HPP
@@ -114,6 +114,9 @@ PARAM_INT_IN("leaf_size", "Leaf size for tree building (used for kd-trees, vp "
     "trees, random projection trees, UB trees, R trees, R* trees, X trees, "
     "Hilbert R trees, R+ trees, R++ trees, spill trees, and octrees).", "l",
     20);
+PARAM_FLAG("auto_leaf_size", "If specified, automatically select the leaf "
+    "size by timing sampled queries on a subsample of the reference set at "
+    "several candidate leaf sizes; overrides 'leaf_size'.", "L");
 PARAM_DOUBLE_IN("tau", "Overlapping size (only valid for spill trees).", "u",
     0);
 PARAM_DOUBLE_IN("rho", "Balance threshold (only valid for spill trees).", "b",
@@ -267,6 +270,11 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     arma::mat referenceSet = std::move(params.Get<arma::mat>("reference"));
 
+    // Calibrate the leaf size on a subsample before the full tree build, if
+    // requested.
+    if (params.Has("auto_leaf_size"))
+      knn->AutoTuneLeafSize(timers, referenceSet, searchMode, epsilon);
+
     knn->BuildModel(timers, std::move(referenceSet), searchMode, epsilon);
   }
   else
@@ -129,7 +129,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
   // Build the tree on the empty dataset, if necessary.
   if (mode != NAIVE_MODE)
   {
-    referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+    referenceTree = BuildTree<Tree>(std::move(MatType()),
         oldFromNewReferences);
     referenceSet = &referenceTree->Dataset();
   }
@@ -280,7 +280,7 @@ NeighborSearch<SortPolicy,
   if (!other.referenceTree)
     delete other.referenceSet;
 
-  other.referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+  other.referenceTree = BuildTree<Tree>(std::move(MatType()),
       other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
@@ -390,7 +390,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     const MatType& querySet,
     const size_t k,
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances)
+    arma::Mat<ElemType>& distances)
 {
   if (k > referenceSet->n_cols)
   {
@@ -411,14 +411,14 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   // To avoid an extra copy, we will store the neighbors and distances in a
   // separate matrix.
   arma::Mat<size_t>* neighborPtr = &neighbors;
-  arma::mat* distancePtr = &distances;
+  arma::Mat<ElemType>* distancePtr = &distances;
 
   // Mapping is only necessary if the tree rearranges points.
   if (tree::TreeTraits<Tree>::RearrangesDataset)
   {
     if (searchMode == DUAL_TREE_MODE)
     {
-      distancePtr = new arma::mat; // Query indices need to be mapped.
+      distancePtr = new arma::Mat<ElemType>; // Query indices need mapping.
       neighborPtr = new arma::Mat<size_t>;
     }
     else if (!oldFromNewReferences.empty())
@@ -450,25 +450,58 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case SINGLE_TREE_MODE:
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
-
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Query points are independent, so they can be processed in parallel.
+      // Each thread gets its own helper object (and thus its own candidate
+      // lists and traversal state), and we remember which thread handled each
+      // query point so the results can be gathered afterwards.
+      size_t numThreads = 1;
+      #ifdef HAS_OPENMP
+      numThreads = (size_t) omp_get_max_threads();
+      #endif
+
+      std::vector<RuleType> rules;
+      rules.reserve(numThreads);
+      for (size_t t = 0; t < numThreads; ++t)
+        rules.push_back(RuleType(*referenceSet, querySet, k, metric, epsilon));
+
+      std::vector<size_t> queryOwner(querySet.n_cols, 0);
+
+      // Have each thread traverse for its share of the query points.
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+      {
+        size_t threadId = 0;
+        #ifdef HAS_OPENMP
+        threadId = (size_t) omp_get_thread_num();
+        #endif
+
+        SingleTreeTraversalType<RuleType> traverser(rules[threadId]);
+        traverser.Traverse((size_t) i, *referenceTree);
+        queryOwner[i] = threadId;
+      }
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      // Gather the results: each query point's candidates live in the rule
+      // set belonging to the thread that processed it.
+      arma::Mat<size_t> threadNeighbors(k, querySet.n_cols);
+      arma::Mat<ElemType> threadDistances(k, querySet.n_cols);
+      for (size_t t = 0; t < numThreads; ++t)
+      {
+        scores += rules[t].Scores();
+        baseCases += rules[t].BaseCases();
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+        rules[t].GetResults(threadNeighbors, threadDistances);
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+        {
+          if (queryOwner[i] == t)
+          {
+            neighborPtr->col(i) = threadNeighbors.col(i);
+            distancePtr->col(i) = threadDistances.col(i);
+          }
+        }
+      }
 
-      rules.GetResults(*neighborPtr, *distancePtr);
+      Log::Info << scores << " node combinations were scored." << std::endl;
+      Log::Info << baseCases << " base cases were calculated." << std::endl;
       break;
     }
     case DUAL_TREE_MODE:
@@ -595,7 +628,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     Tree& queryTree,
     const size_t k,
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances,
+    arma::Mat<ElemType>& distances,
     bool sameSet)
 {
   if (k > referenceSet->n_cols)
@@ -675,7 +708,7 @@ void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
 DualTreeTraversalType, SingleTreeTraversalType>::Search(
     const size_t k,
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances)
+    arma::Mat<ElemType>& distances)
 {
   if (k > referenceSet->n_cols)
   {
@@ -697,13 +730,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   scores = 0;
 
   arma::Mat<size_t>* neighborPtr = &neighbors;
-  arma::mat* distancePtr = &distances;
+  arma::Mat<ElemType>* distancePtr = &distances;
 
   if (!oldFromNewReferences.empty() &&
       tree::TreeTraits<Tree>::RearrangesDataset)
   {
     // We will always need to rearrange in this case.
-    distancePtr = new arma::mat;
+    distancePtr = new arma::Mat<ElemType>;
     neighborPtr = new arma::Mat<size_t>;
   }
 
@@ -14,6 +14,12 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+#include <mlpack/core/tree/tree_traits.hpp>
+
+#include "k_selection.hpp"
+#include "sort_policies/nearest_neighbor_sort.hpp"
 
 #include <queue>
 
@@ -30,8 +36,15 @@ namespace neighbor {
  * @tparam SortPolicy The sort policy for distances.
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam StatsType Traversal instrumentation counters; the default
+ *     tree::NullTraversalStatistics compiles to nothing, and
+ *     tree::TraversalStatistics records scores, prunes by reason, base cases
+ *     and bound tightenings (see core/tree/traversal_statistics.hpp).
  */
-template<typename SortPolicy, typename MetricType, typename TreeType>
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType = tree::NullTraversalStatistics>
 class NeighborSearchRules
 {
  public:
@@ -61,7 +74,8 @@ class NeighborSearchRules
    * @param distances Matrix storing distances of neighbors for each query
    *     point.
    */
-  void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
+  void GetResults(arma::Mat<size_t>& neighbors,
+                  arma::Mat<typename TreeType::Mat::elem_type>& distances);
 
   /**
    * Get the distance from the query point to the reference point.
@@ -161,6 +175,11 @@ class NeighborSearchRules
   //! results.  This is only needed in defeatist search mode.
   size_t MinimumBaseCases() const { return k; }
 
+  //! Get the traversal instrumentation counters.
+  const StatsType& TraversalStats() const { return travStats; }
+  //! Modify the traversal instrumentation counters.
+  StatsType& TraversalStats() { return travStats; }
+
  protected:
   //! The reference set.
   const typename TreeType::Mat& referenceSet;
@@ -168,23 +187,9 @@ class NeighborSearchRules
   //! The query set.
   const typename TreeType::Mat& querySet;
 
-  //! Candidate represents a possible candidate neighbor (distance, index).
-  typedef std::pair<double, size_t> Candidate;
-
-  //! Compare two candidates based on the distance.
-  struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2)
-    {
-      return !SortPolicy::IsBetter(c2.first, c1.first);
-    };
-  };
-
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-      CandidateList;
-
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point; uses flat sorted arrays for
+  //! small k and binary heaps for large k.
+  KSelectionSet<SortPolicy> candidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -214,6 +219,10 @@ class NeighborSearchRules
   //! traversal before each call to Score().
   TraversalInfoType traversalInfo;
 
+  //! Instrumentation counters (empty unless StatsType records them); mutable
+  //! because prunes are also counted in the const Rescore() methods.
+  mutable StatsType travStats;
+
   /**
    * Recalculate the bound for a given query node.
    */
@@ -229,6 +238,32 @@ class NeighborSearchRules
   void InsertNeighbor(const size_t queryIndex,
                       const size_t neighbor,
                       const double distance);
+
+  /**
+   * Whether BaseCase() may cascade the distance evaluation, abandoning a
+   * candidate once its partial distance over a prefix of the dimensions
+   * exceeds the current k-th best distance.  This requires a metric whose
+   * per-dimension contributions only grow the distance (an LMetric), a sort
+   * policy for which exceeding the bound disqualifies the candidate (nearest
+   * neighbor search), and a tree whose traversal does not reuse the base case
+   * result as a centroid-to-centroid bound (so abandoned—and thus
+   * underestimated—distances never loosen the node bounds).
+   */
+  static const bool cascadeBaseCase =
+      bound::meta::IsLMetric<MetricType>::Value &&
+      std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      !tree::TreeTraits<TreeType>::FirstPointIsCentroid;
+
+  //! Evaluate the base case distance with cascaded early abandoning against
+  //! the current k-th best distance of the query point.
+  double EvaluateBaseCase(const size_t queryIndex,
+                          const size_t referenceIndex,
+                          std::true_type /* cascade */);
+
+  //! Evaluate the base case distance in full.
+  double EvaluateBaseCase(const size_t queryIndex,
+                          const size_t referenceIndex,
+                          std::false_type /* cascade */);
 };
 
 } // namespace neighbor
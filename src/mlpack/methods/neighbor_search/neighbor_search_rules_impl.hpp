@@ -19,8 +19,11 @@
 namespace mlpack {
 namespace neighbor {
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
-NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::NeighborSearchRules(
     const typename TreeType::Mat& referenceSet,
     const typename TreeType::Mat& querySet,
     const size_t k,
@@ -29,6 +32,7 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
+    candidates(k, querySet.n_cols),
     k(k),
     metric(metric),
     sameSet(sameSet),
@@ -44,44 +48,28 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
   traversalInfo.LastQueryNode() = (TreeType*) this;
   traversalInfo.LastReferenceNode() = (TreeType*) this;
 
-  // Let's build the list of candidate neighbors for each query point.
-  // It will be initialized with k candidates: (WorstDistance, size_t() - 1)
-  // The list of candidates will be updated when visiting new points with the
-  // BaseCase() method.
-  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
-      size_t() - 1);
-
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
-
-  candidates.reserve(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+  // The candidate sets were initialized by the KSelectionSet constructor
+  // with k candidates per query point: (WorstDistance, size_t() - 1).  They
+  // will be updated when visiting new points with the BaseCase() method.
 }
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
-void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::GetResults(
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances)
+    arma::Mat<typename TreeType::Mat::elem_type>& distances)
 {
-  neighbors.set_size(k, querySet.n_cols);
-  distances.set_size(k, querySet.n_cols);
-
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-  {
-    CandidateList& pqueue = candidates[i];
-    for (size_t j = 1; j <= k; ++j)
-    {
-      neighbors(k - j, i) = pqueue.top().second;
-      distances(k - j, i) = pqueue.top().first;
-      pqueue.pop();
-    }
-  }
+  candidates.GetResults(neighbors, distances);
 };
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
 inline force_inline // Absolutely MUST be inline so optimizations can happen.
-double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+double NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::
 BaseCase(const size_t queryIndex, const size_t referenceIndex)
 {
   // If the datasets are the same, then this search is only using one dataset
@@ -93,9 +81,16 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return lastBaseCase;
 
-  double distance = metric.Evaluate(querySet.col(queryIndex),
-                                    referenceSet.col(referenceIndex));
+  // When the metric and sort policy allow it, the evaluation is cascaded:
+  // the distance accumulates over a prefix of the dimensions and the
+  // candidate is abandoned once the partial distance already exceeds the
+  // current k-th best distance.  An abandoned evaluation returns a lower
+  // bound on the true distance that exceeds the k-th best distance, so
+  // InsertNeighbor() correctly rejects the candidate.
+  double distance = EvaluateBaseCase(queryIndex, referenceIndex,
+      std::integral_constant<bool, cascadeBaseCase>());
   ++baseCases;
+  travStats.CountBaseCase();
 
   InsertNeighbor(queryIndex, referenceIndex, distance);
 
@@ -107,12 +102,44 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return distance;
 }
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline force_inline // Absolutely MUST be inline so optimizations can happen.
+double NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::
+EvaluateBaseCase(const size_t queryIndex,
+                 const size_t referenceIndex,
+                 std::true_type /* cascade */)
+{
+  return MetricType::EvaluateEarlyAbandon(querySet.col(queryIndex),
+      referenceSet.col(referenceIndex), candidates.Worst(queryIndex));
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline force_inline // Absolutely MUST be inline so optimizations can happen.
+double NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::
+EvaluateBaseCase(const size_t queryIndex,
+                 const size_t referenceIndex,
+                 std::false_type /* cascade */)
+{
+  return metric.Evaluate(querySet.col(queryIndex),
+      referenceSet.col(referenceIndex));
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline double NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::Score(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
   ++scores; // Count number of Score() calls.
+  travStats.CountScore();
   double distance;
   if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
   {
@@ -143,31 +170,43 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = candidates.Worst(queryIndex);
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ?
-      SortPolicy::ConvertToScore(distance) : DBL_MAX;
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return SortPolicy::ConvertToScore(distance);
+
+  travStats.CountScorePrune();
+  return DBL_MAX;
 }
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
-inline size_t NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline size_t NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::
 GetBestChild(const size_t queryIndex, TreeType& referenceNode)
 {
   ++scores;
   return SortPolicy::GetBestChild(querySet.col(queryIndex), referenceNode);
 }
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
-inline size_t NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline size_t NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::
 GetBestChild(const TreeType& queryNode, TreeType& referenceNode)
 {
   ++scores;
   return SortPolicy::GetBestChild(queryNode, referenceNode);
 }
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline double NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::Rescore(
     const size_t queryIndex,
     TreeType& /* referenceNode */,
     const double oldScore) const
@@ -179,18 +218,26 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = candidates.Worst(queryIndex);
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return oldScore;
+
+  travStats.CountRescorePrune();
+  return DBL_MAX;
 }
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline double NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::Score(
     TreeType& queryNode,
     TreeType& referenceNode)
 {
   ++scores; // Count number of Score() calls.
+  travStats.CountScore();
 
   // Update our bound.
   const double bestDistance = CalculateBound(queryNode);
@@ -290,6 +337,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
       // There isn't any need to set the traversal information because no
       // descendant combinations will be visited, and those are the only
       // combinations that would depend on the traversal information.
+      travStats.CountScorePrune();
       return DBL_MAX;
     }
   }
@@ -342,12 +390,16 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     // There isn't any need to set the traversal information because no
     // descendant combinations will be visited, and those are the only
     // combinations that would depend on the traversal information.
+    travStats.CountScorePrune();
     return DBL_MAX;
   }
 }
 
-template<typename SortPolicy, typename MetricType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline double NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::Rescore(
     TreeType& queryNode,
     TreeType& /* referenceNode */,
     const double oldScore) const
@@ -360,13 +412,20 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   // Update our bound.
   const double bestDistance = CalculateBound(queryNode);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return oldScore;
+
+  travStats.CountRescorePrune();
+  return DBL_MAX;
 }
 
 // Calculate the bound for a given query node in its current state and update
 // it.
-template<typename SortPolicy, typename MetricType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline double NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::
     CalculateBound(TreeType& queryNode) const
 {
   // This is an adapted form of the B(N_q) function in the paper
@@ -402,7 +461,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double distance = candidates[queryNode.Point(i)].top().first;
+    const double distance = candidates.Worst(queryNode.Point(i));
     if (SortPolicy::IsBetter(worstDistance, distance))
       worstDistance = distance;
     if (SortPolicy::IsBetter(distance, bestPointDistance))
@@ -490,21 +549,18 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
  * @param neighbor Index of reference point which is being inserted.
  * @param distance Distance from query point to reference point.
  */
-template<typename SortPolicy, typename MetricType, typename TreeType>
-inline void NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+template<typename SortPolicy,
+         typename MetricType,
+         typename TreeType,
+         typename StatsType>
+inline void NeighborSearchRules<SortPolicy, MetricType, TreeType, StatsType>::
 InsertNeighbor(
     const size_t queryIndex,
     const size_t neighbor,
     const double distance)
 {
-  CandidateList& pqueue = candidates[queryIndex];
-  Candidate c = std::make_pair(distance, neighbor);
-
-  if (CandidateCmp()(c, pqueue.top()))
-  {
-    pqueue.pop();
-    pqueue.push(c);
-  }
+  if (candidates.Insert(queryIndex, neighbor, distance))
+    travStats.CountBoundTightening();
 }
 
 } // namespace neighbor
@@ -22,6 +22,11 @@
 #include <mlpack/core/tree/spill_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
 #include "neighbor_search.hpp"
+#include "hnsw_index.hpp"
+#include "brute_force_knn.hpp"
+
+#include <cereal/types/unordered_set.hpp>
+#include <unordered_set>
 
 namespace mlpack {
 namespace neighbor {
@@ -49,6 +54,10 @@ class NSWrapperBase
   //! Return a reference to the dataset.
   virtual const arma::mat& Dataset() const = 0;
 
+  //! Reconstruct the reference set in its original (pre-tree-build) column
+  //! order, so that column i holds the point with result index i.
+  virtual void OriginalDataset(arma::mat& dataset) const = 0;
+
   //! Get the search mode.
   virtual NeighborSearchMode SearchMode() const = 0;
   //! Modify the search modem
@@ -121,6 +130,24 @@ class NSWrapper : public NSWrapperBase
   //! Get a reference to the reference set.
   const arma::mat& Dataset() const { return ns.ReferenceSet(); }
 
+  //! Reconstruct the reference set in its original column order, undoing any
+  //! permutation applied during tree building.
+  virtual void OriginalDataset(arma::mat& dataset) const
+  {
+    const std::vector<size_t>& oldFromNew = ns.OldFromNewReferences();
+    if (oldFromNew.size() == ns.ReferenceSet().n_cols)
+    {
+      dataset.set_size(ns.ReferenceSet().n_rows, ns.ReferenceSet().n_cols);
+      for (size_t i = 0; i < ns.ReferenceSet().n_cols; ++i)
+        dataset.col(oldFromNew[i]) = ns.ReferenceSet().col(i);
+    }
+    else
+    {
+      // The tree type does not rearrange the dataset.
+      dataset = ns.ReferenceSet();
+    }
+  }
+
   //! Get the search mode.
   NeighborSearchMode SearchMode() const { return ns.SearchMode(); }
   //! Modify the search mode.
@@ -329,6 +356,185 @@ class SpillNSWrapper :
                    arma::mat>::template DefeatistSingleTreeTraverser>::ns;
 };
 
+/**
+ * The HNSWWrapper class wraps the HNSWIndex graph index so that it can be
+ * selected through NSModel like any of the tree types.  Because the index is
+ * a proximity graph and not a space tree, the search mode is ignored (graph
+ * search is always an approximate greedy traversal), and only nearest
+ * neighbor search is meaningful.
+ */
+template<typename SortPolicy>
+class HNSWWrapper : public NSWrapperBase
+{
+ public:
+  //! Construct the HNSWWrapper.
+  HNSWWrapper(const NeighborSearchMode searchMode,
+              const double epsilon) :
+      searchMode(searchMode),
+      epsilon(epsilon)
+  {
+    // Nothing to do.
+  }
+
+  //! Destruct the HNSWWrapper.
+  virtual ~HNSWWrapper() { }
+
+  //! Return a copy of the HNSWWrapper.
+  virtual HNSWWrapper* Clone() const { return new HNSWWrapper(*this); }
+
+  //! Get a reference to the reference set.
+  const arma::mat& Dataset() const { return index.Dataset(); }
+
+  //! The graph index never rearranges the dataset.
+  virtual void OriginalDataset(arma::mat& dataset) const
+  { dataset = index.Dataset(); }
+
+  //! Get the search mode.  (The graph index ignores this, but it is kept so
+  //! the NSModel interface stays uniform.)
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode.
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Get epsilon, the approximation parameter.  (Unused by graph search;
+  //! approximation is controlled by the index's ef parameter.)
+  double Epsilon() const { return epsilon; }
+  //! Modify epsilon.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the beam width used during search.
+  size_t Ef() const { return index.Ef(); }
+  //! Modify the beam width used during search.
+  size_t& Ef() { return index.Ef(); }
+
+  //! Build the graph index on the given reference set.
+  virtual void Train(util::Timers& timers,
+                     arma::mat&& referenceSet,
+                     const size_t leafSize,
+                     const double tau,
+                     const double rho);
+
+  //! Perform bichromatic neighbor search.
+  virtual void Search(util::Timers& timers,
+                      arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t leafSize,
+                      const double rho);
+
+  //! Perform monochromatic neighbor search.
+  virtual void Search(util::Timers& timers,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances);
+
+  //! Serialize the graph index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(searchMode));
+    ar(CEREAL_NVP(epsilon));
+    ar(CEREAL_NVP(index));
+  }
+
+ protected:
+  //! The graph index we are wrapping.
+  HNSWIndex<metric::EuclideanDistance, arma::mat> index;
+
+  //! The search mode (kept only for interface uniformity).
+  NeighborSearchMode searchMode;
+  //! The approximation parameter (kept only for interface uniformity).
+  double epsilon;
+};
+
+/**
+ * The BruteForceNSWrapper class wraps the blocked brute-force engine
+ * (BruteForceKNN) so that it can be selected through NSModel.  There is no
+ * index structure at all: training just stores the reference set, and every
+ * search runs the blocked dense kernel.  This is the right choice for
+ * low-dimensional data where tree overhead does not pay off.
+ */
+template<typename SortPolicy>
+class BruteForceNSWrapper : public NSWrapperBase
+{
+ public:
+  //! Construct the BruteForceNSWrapper.
+  BruteForceNSWrapper(const NeighborSearchMode searchMode,
+                      const double epsilon) :
+      searchMode(searchMode),
+      epsilon(epsilon)
+  {
+    // Nothing to do.
+  }
+
+  //! Destruct the BruteForceNSWrapper.
+  virtual ~BruteForceNSWrapper() { }
+
+  //! Return a copy of the BruteForceNSWrapper.
+  virtual BruteForceNSWrapper* Clone() const
+  {
+    return new BruteForceNSWrapper(*this);
+  }
+
+  //! Get a reference to the reference set.
+  const arma::mat& Dataset() const { return dataset; }
+
+  //! The brute-force engine never rearranges the dataset.
+  virtual void OriginalDataset(arma::mat& datasetOut) const
+  { datasetOut = dataset; }
+
+  //! Get the search mode.  (The engine is always exhaustive, but the mode is
+  //! kept so the NSModel interface stays uniform.)
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode.
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Get epsilon.  (Unused: the engine is exact.)
+  double Epsilon() const { return epsilon; }
+  //! Modify epsilon.
+  double& Epsilon() { return epsilon; }
+
+  //! Store the reference set.  (No index is built.)
+  virtual void Train(util::Timers& timers,
+                     arma::mat&& referenceSet,
+                     const size_t leafSize,
+                     const double tau,
+                     const double rho);
+
+  //! Perform bichromatic neighbor search.
+  virtual void Search(util::Timers& timers,
+                      arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t leafSize,
+                      const double rho);
+
+  //! Perform monochromatic neighbor search.
+  virtual void Search(util::Timers& timers,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances);
+
+  //! Serialize the wrapper.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(searchMode));
+    ar(CEREAL_NVP(epsilon));
+    ar(CEREAL_NVP(dataset));
+  }
+
+ protected:
+  //! The reference set (there is no index to hold).
+  arma::mat dataset;
+
+  //! The search mode (kept only for interface uniformity).
+  NeighborSearchMode searchMode;
+  //! The approximation parameter (kept only for interface uniformity).
+  double epsilon;
+};
+
 /**
  * The NSModel class provides an easy way to serialize a model, abstracts away
  * the different types of trees, and also reflects the NeighborSearch API.  This
@@ -360,7 +566,9 @@ class NSModel
     MAX_RP_TREE,
     SPILL_TREE,
     UB_TREE,
-    OCTREE
+    OCTREE,
+    HNSW,
+    BRUTE_FORCE
   };
 
  private:
@@ -382,6 +590,28 @@ class NSModel
    */
   NSWrapperBase* nSearch;
 
+  //! Reference points added since the last flush; searched by brute force and
+  //! merged into every query.  (Stored in the model's coordinate space, i.e.
+  //! already projected if a random basis is in use.)
+  arma::mat bufferPoints;
+
+  //! Indices of reference points that have been removed.  Removed points stay
+  //! in the tree as tombstones (so that all other indices remain stable) and
+  //! are filtered out of search results.
+  std::unordered_set<size_t> removedPoints;
+
+  //! Flush the buffered points into the tree when the buffer exceeds this
+  //! fraction of the indexed reference set.
+  double flushRatio;
+
+  //! Insert a candidate into a fixed-size result column kept sorted according
+  //! to the sort policy.
+  static void InsertNeighbor(size_t* neighbors,
+                             double* distances,
+                             const size_t k,
+                             const size_t index,
+                             const double distance);
+
  public:
   /**
    * Initialize the NSModel with the given type and whether or not a random
@@ -463,12 +693,73 @@ class NSModel
   void InitializeModel(const NeighborSearchMode searchMode,
                        const double epsilon);
 
-  //! Build the reference tree.
+  //! Build the reference tree.  This discards any buffered updates.
   void BuildModel(util::Timers& timers,
                   arma::mat&& referenceSet,
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
+  /**
+   * Add a reference point to the model without rebuilding the tree, returning
+   * the index the point will have in search results.  The point is buffered
+   * into a side pool that is searched by brute force and merged into every
+   * query; when the pool outgrows FlushRatio() times the size of the indexed
+   * set, it is flushed into the tree automatically.
+   *
+   * @param timers Timers to use (a flush may trigger a tree build).
+   * @param point Point to add.
+   */
+  size_t AddPoint(util::Timers& timers, const arma::vec& point);
+
+  /**
+   * Remove the reference point with the given index.  The point stays in the
+   * tree as a tombstone, so all other indices remain stable, but it will not
+   * appear in any further search results.
+   *
+   * @param index Index of the point to remove.
+   */
+  void RemovePoint(const size_t index);
+
+  /**
+   * Rebuild the reference tree over the indexed points plus the buffered
+   * pool, emptying the pool.  Point indices are unchanged: buffered points
+   * keep the indices that AddPoint() returned.
+   *
+   * @param timers Timers to use for the tree build.
+   */
+  void FlushUpdates(util::Timers& timers);
+
+  //! Get the number of buffered (not yet flushed) reference points.
+  size_t NumBufferedPoints() const { return bufferPoints.n_cols; }
+  //! Get the number of removed (tombstoned) reference points.
+  size_t NumRemovedPoints() const { return removedPoints.size(); }
+
+  //! Get the buffer flush ratio.
+  double FlushRatio() const { return flushRatio; }
+  //! Modify the buffer flush ratio.
+  double& FlushRatio() { return flushRatio; }
+
+  /**
+   * Automatically select the leaf size before building the model.  A handful
+   * of sampled queries are timed against a subsample of the reference set at
+   * several candidate leaf sizes (8 to 128), the fastest candidate is kept in
+   * LeafSize() and reported, and the calibration cost is recorded under the
+   * "leaf_size_tuning" timer.  For tree types that do not take a leaf size,
+   * and for naive search, this is a no-op.
+   *
+   * @param timers Timers for the calibration step.
+   * @param referenceSet Reference set the model will be built on.
+   * @param searchMode Search mode the model will be used with.
+   * @param epsilon Approximation parameter the model will be used with.
+   * @param k Number of neighbors to use for the sampled queries.
+   * @return The selected leaf size.
+   */
+  size_t AutoTuneLeafSize(util::Timers& timers,
+                          const arma::mat& referenceSet,
+                          const NeighborSearchMode searchMode,
+                          const double epsilon = 0,
+                          const size_t k = 3);
+
   //! Perform neighbor search.  The query set will be reordered.
   void Search(util::Timers& timers,
               arma::mat&& querySet,
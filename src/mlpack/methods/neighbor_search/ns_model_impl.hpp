@@ -237,6 +237,85 @@ void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
   }
 }
 
+//! Build the graph index on the given reference set.
+template<typename SortPolicy>
+void HNSWWrapper<SortPolicy>::Train(util::Timers& timers,
+                                    arma::mat&& referenceSet,
+                                    const size_t /* leafSize */,
+                                    const double /* tau */,
+                                    const double /* rho */)
+{
+  timers.Start("tree_building");
+  index.Train(std::move(referenceSet));
+  timers.Stop("tree_building");
+}
+
+//! Perform bichromatic neighbor search with the graph index.
+template<typename SortPolicy>
+void HNSWWrapper<SortPolicy>::Search(util::Timers& timers,
+                                     arma::mat&& querySet,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances,
+                                     const size_t /* leafSize */,
+                                     const double /* rho */)
+{
+  timers.Start("computing_neighbors");
+  index.Search(querySet, k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Perform monochromatic neighbor search with the graph index.
+template<typename SortPolicy>
+void HNSWWrapper<SortPolicy>::Search(util::Timers& timers,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances)
+{
+  timers.Start("computing_neighbors");
+  index.Search(k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Store the reference set; the brute-force engine builds no index.
+template<typename SortPolicy>
+void BruteForceNSWrapper<SortPolicy>::Train(util::Timers& /* timers */,
+                                            arma::mat&& referenceSet,
+                                            const size_t /* leafSize */,
+                                            const double /* tau */,
+                                            const double /* rho */)
+{
+  dataset = std::move(referenceSet);
+}
+
+//! Perform bichromatic neighbor search with the blocked dense kernel.
+template<typename SortPolicy>
+void BruteForceNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                             arma::mat&& querySet,
+                                             const size_t k,
+                                             arma::Mat<size_t>& neighbors,
+                                             arma::mat& distances,
+                                             const size_t /* leafSize */,
+                                             const double /* rho */)
+{
+  timers.Start("computing_neighbors");
+  BruteForceKNN<SortPolicy>::Search(dataset, querySet, k, neighbors,
+      distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Perform monochromatic neighbor search with the blocked dense kernel.
+template<typename SortPolicy>
+void BruteForceNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                             const size_t k,
+                                             arma::Mat<size_t>& neighbors,
+                                             arma::mat& distances)
+{
+  timers.Start("computing_neighbors");
+  BruteForceKNN<SortPolicy>::Search(dataset, k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
 /**
  * Initialize the NSModel with the given type and whether or not a random
  * basis should be used.
@@ -248,7 +327,8 @@ NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
     leafSize(20),
     tau(0.0),
     rho(0.7),
-    nSearch(NULL)
+    nSearch(NULL),
+    flushRatio(0.05)
 {
   // Nothing to do.
 }
@@ -261,7 +341,10 @@ NSModel<SortPolicy>::NSModel(const NSModel& other) :
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
-    nSearch(other.nSearch->Clone())
+    nSearch(other.nSearch->Clone()),
+    bufferPoints(other.bufferPoints),
+    removedPoints(other.removedPoints),
+    flushRatio(other.flushRatio)
 {
   // Nothing to do.
 }
@@ -274,7 +357,10 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
-    nSearch(other.nSearch)
+    nSearch(other.nSearch),
+    bufferPoints(std::move(other.bufferPoints)),
+    removedPoints(std::move(other.removedPoints)),
+    flushRatio(other.flushRatio)
 {
   // Reset parameters of the other model.
   other.treeType = TreeTypes::KD_TREE;
@@ -283,6 +369,8 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.tau = 0.0;
   other.rho = 0.7;
   other.nSearch = NULL;
+  other.removedPoints.clear();
+  other.flushRatio = 0.05;
 }
 
 template<typename SortPolicy>
@@ -299,6 +387,9 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
     tau = other.tau;
     rho = other.rho;
     nSearch = other.nSearch->Clone();
+    bufferPoints = other.bufferPoints;
+    removedPoints = other.removedPoints;
+    flushRatio = other.flushRatio;
   }
 
   return *this;
@@ -318,6 +409,9 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     tau = other.tau;
     rho = other.rho;
     nSearch = other.nSearch;
+    bufferPoints = std::move(other.bufferPoints);
+    removedPoints = std::move(other.removedPoints);
+    flushRatio = other.flushRatio;
 
     // Reset parameters of the other model.
     other.treeType = TreeTypes::KD_TREE;
@@ -326,6 +420,8 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     other.tau = 0.0;
     other.rho = 0.7;
     other.nSearch = NULL;
+    other.removedPoints.clear();
+    other.flushRatio = 0.05;
   }
 
   return *this;
@@ -349,6 +445,9 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(leafSize));
   ar(CEREAL_NVP(tau));
   ar(CEREAL_NVP(rho));
+  ar(CEREAL_NVP(bufferPoints));
+  ar(CEREAL_NVP(removedPoints));
+  ar(CEREAL_NVP(flushRatio));
 
   // This should never happen, but just in case, be clean with memory.
   if (cereal::is_loading<Archive>())
@@ -467,6 +566,20 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
         ar(CEREAL_NVP(typedSearch));
         break;
       }
+    case HNSW:
+      {
+        HNSWWrapper<SortPolicy>& typedSearch =
+            dynamic_cast<HNSWWrapper<SortPolicy>&>(*nSearch);
+        ar(CEREAL_NVP(typedSearch));
+        break;
+      }
+    case BRUTE_FORCE:
+      {
+        BruteForceNSWrapper<SortPolicy>& typedSearch =
+            dynamic_cast<BruteForceNSWrapper<SortPolicy>&>(*nSearch);
+        ar(CEREAL_NVP(typedSearch));
+        break;
+      }
   }
 }
 
@@ -569,6 +682,12 @@ void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
       nSearch = new LeafSizeNSWrapper<SortPolicy, tree::Octree>(searchMode,
           epsilon);
       break;
+    case HNSW:
+      nSearch = new HNSWWrapper<SortPolicy>(searchMode, epsilon);
+      break;
+    case BRUTE_FORCE:
+      nSearch = new BruteForceNSWrapper<SortPolicy>(searchMode, epsilon);
+      break;
   }
 }
 
@@ -618,6 +737,10 @@ void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
   if (searchMode != NAIVE_MODE)
     Log::Info << "Building reference tree..." << std::endl;
 
+  // A full build discards any buffered updates.
+  bufferPoints.clear();
+  removedPoints.clear();
+
   InitializeModel(searchMode, epsilon);
   nSearch->Train(timers, std::move(referenceSet), leafSize, tau, rho);
 
@@ -625,6 +748,167 @@ void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
     Log::Info << "Tree built." << std::endl;
 }
 
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::AutoTuneLeafSize(
+    util::Timers& timers,
+    const arma::mat& referenceSet,
+    const NeighborSearchMode searchMode,
+    const double epsilon,
+    const size_t k)
+{
+  // Leaf size only affects the trees that take one, and does not matter at
+  // all for naive search.
+  const bool usesLeafSize = (treeType == KD_TREE ||
+                             treeType == BALL_TREE ||
+                             treeType == SPILL_TREE ||
+                             treeType == VP_TREE ||
+                             treeType == RP_TREE ||
+                             treeType == MAX_RP_TREE ||
+                             treeType == UB_TREE ||
+                             treeType == OCTREE);
+  if (!usesLeafSize || searchMode == NAIVE_MODE || referenceSet.n_cols < 2)
+    return leafSize;
+
+  timers.Start("leaf_size_tuning");
+
+  // Calibrate on a subsample of the reference set and a handful of sampled
+  // queries, so the step costs seconds even on large datasets.
+  const size_t numRefSamples = std::min((size_t) referenceSet.n_cols,
+      (size_t) 5000);
+  const size_t numQueries = std::min((size_t) referenceSet.n_cols,
+      (size_t) 256);
+  const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+      referenceSet.n_cols - 1, referenceSet.n_cols));
+  const arma::mat refSample = referenceSet.cols(order.head(numRefSamples));
+  const arma::mat querySample = referenceSet.cols(order.tail(numQueries));
+  const size_t tuneK = std::min(k, (size_t) refSample.n_cols);
+
+  const size_t candidates[] = { 8, 16, 32, 64, 128 };
+  double bestTime = DBL_MAX;
+  size_t bestLeafSize = leafSize;
+  for (size_t c = 0; c < sizeof(candidates) / sizeof(candidates[0]); ++c)
+  {
+    // Build and query a throwaway model on the subsample.  Its timers are
+    // kept local so they do not pollute the caller's aggregates.
+    util::Timers tuneTimers;
+    NSModel<SortPolicy> tuneModel(treeType, false);
+    tuneModel.LeafSize() = candidates[c];
+    tuneModel.Tau() = tau;
+    tuneModel.Rho() = rho;
+    arma::mat refCopy(refSample);
+    tuneModel.BuildModel(tuneTimers, std::move(refCopy), searchMode, epsilon);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    arma::mat queryCopy(querySample);
+    arma::wall_clock clock;
+    clock.tic();
+    tuneModel.Search(tuneTimers, std::move(queryCopy), tuneK, neighbors,
+        distances);
+    const double queryTime = clock.toc();
+
+    Log::Info << "Leaf size " << candidates[c] << ": " << queryTime
+        << "s for " << numQueries << " sampled queries." << std::endl;
+
+    if (queryTime < bestTime)
+    {
+      bestTime = queryTime;
+      bestLeafSize = candidates[c];
+    }
+  }
+
+  timers.Stop("leaf_size_tuning");
+
+  leafSize = bestLeafSize;
+  Log::Info << "Auto-tuned leaf size: " << leafSize << "." << std::endl;
+  return leafSize;
+}
+
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::AddPoint(util::Timers& timers,
+                                     const arma::vec& point)
+{
+  // Keep the buffer in the model's coordinate space.
+  const arma::vec mappedPoint = randomBasis ? arma::vec(q * point) : point;
+
+  const size_t index = Dataset().n_cols + bufferPoints.n_cols;
+  if (bufferPoints.n_cols == 0)
+    bufferPoints = mappedPoint;
+  else
+    bufferPoints.insert_cols(bufferPoints.n_cols, mappedPoint);
+
+  // Flush once the pool outgrows its share of the indexed set.
+  if ((double) bufferPoints.n_cols >
+      flushRatio * std::max<size_t>(Dataset().n_cols, 1))
+    FlushUpdates(timers);
+
+  return index;
+}
+
+template<typename SortPolicy>
+void NSModel<SortPolicy>::RemovePoint(const size_t index)
+{
+  if (index >= Dataset().n_cols + bufferPoints.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "NSModel::RemovePoint(): index " << index << " out of range (the "
+        << "model holds " << (Dataset().n_cols + bufferPoints.n_cols)
+        << " points)!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  removedPoints.insert(index);
+}
+
+template<typename SortPolicy>
+void NSModel<SortPolicy>::FlushUpdates(util::Timers& timers)
+{
+  if (bufferPoints.n_cols == 0)
+    return;
+
+  Log::Info << "Flushing " << bufferPoints.n_cols << " buffered points into "
+      << "the reference tree..." << std::endl;
+
+  // The buffered points are already in the model's coordinate space, so the
+  // tree is rebuilt directly instead of through BuildModel(), which would
+  // compute and apply a new random basis.  Tombstoned points stay in the
+  // tree so that all other indices remain stable; the old reference set is
+  // reconstructed in its original column order for the same reason.
+  arma::mat newReferenceSet;
+  nSearch->OriginalDataset(newReferenceSet);
+  newReferenceSet.insert_cols(newReferenceSet.n_cols, bufferPoints);
+  bufferPoints.clear();
+
+  const NeighborSearchMode searchMode = SearchMode();
+  const double epsilon = Epsilon();
+
+  InitializeModel(searchMode, epsilon);
+  nSearch->Train(timers, std::move(newReferenceSet), leafSize, tau, rho);
+
+  Log::Info << "Tree built." << std::endl;
+}
+
+template<typename SortPolicy>
+void NSModel<SortPolicy>::InsertNeighbor(size_t* neighbors,
+                                         double* distances,
+                                         const size_t k,
+                                         const size_t index,
+                                         const double distance)
+{
+  if (!SortPolicy::IsBetter(distance, distances[k - 1]))
+    return;
+
+  size_t pos = k - 1;
+  while (pos > 0 && SortPolicy::IsBetter(distance, distances[pos - 1]))
+  {
+    distances[pos] = distances[pos - 1];
+    neighbors[pos] = neighbors[pos - 1];
+    --pos;
+  }
+  distances[pos] = distance;
+  neighbors[pos] = index;
+}
+
 //! Perform neighbor search.  The query set will be reordered.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::Search(util::Timers& timers,
@@ -660,8 +944,87 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
       break;
   }
 
-  nSearch->Search(timers, std::move(querySet), k, neighbors, distances,
-      leafSize, rho);
+  // With no pending updates, hand the search to the wrapper directly.
+  if (bufferPoints.n_cols == 0 && removedPoints.empty())
+  {
+    nSearch->Search(timers, std::move(querySet), k, neighbors, distances,
+        leafSize, rho);
+    return;
+  }
+
+  const size_t livePoints =
+      Dataset().n_cols + bufferPoints.n_cols - removedPoints.size();
+  if (k > livePoints)
+  {
+    std::ostringstream oss;
+    oss << "NSModel::Search(): requested " << k << " neighbors, but only "
+        << livePoints << " reference points are live!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Scan the buffered pool by brute force before the tree search, which
+  // consumes the query set.
+  timers.Start("searching_buffered_points");
+  arma::Mat<size_t> poolNeighbors(k, querySet.n_cols);
+  arma::mat poolDistances(k, querySet.n_cols);
+  poolNeighbors.fill(SIZE_MAX);
+  poolDistances.fill(SortPolicy::WorstDistance());
+
+  const size_t datasetSize = Dataset().n_cols;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < bufferPoints.n_cols; ++j)
+    {
+      const size_t index = datasetSize + j;
+      if (removedPoints.count(index) > 0)
+        continue;
+
+      const double distance = metric::EuclideanDistance::Evaluate(
+          querySet.col(i), bufferPoints.col(j));
+      InsertNeighbor(poolNeighbors.colptr(i), poolDistances.colptr(i), k,
+          index, distance);
+    }
+  }
+  timers.Stop("searching_buffered_points");
+
+  // Ask the tree for enough extra neighbors to survive tombstone filtering;
+  // every tombstone can displace at most one result.
+  const size_t numQueries = querySet.n_cols;
+  const size_t treeK = std::min(k + removedPoints.size(), Dataset().n_cols);
+  arma::Mat<size_t> treeNeighbors;
+  arma::mat treeDistances;
+  if (treeK > 0)
+  {
+    nSearch->Search(timers, std::move(querySet), treeK, treeNeighbors,
+        treeDistances, leafSize, rho);
+  }
+
+  // Merge the filtered tree results with the pool results.
+  neighbors.set_size(k, numQueries);
+  distances.set_size(k, numQueries);
+  neighbors.fill(SIZE_MAX);
+  distances.fill(SortPolicy::WorstDistance());
+  for (size_t i = 0; i < numQueries; ++i)
+  {
+    for (size_t j = 0; j < treeK; ++j)
+    {
+      if (removedPoints.count(treeNeighbors(j, i)) > 0)
+        continue;
+
+      InsertNeighbor(neighbors.colptr(i), distances.colptr(i), k,
+          treeNeighbors(j, i), treeDistances(j, i));
+    }
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (poolNeighbors(j, i) == SIZE_MAX)
+        break;
+
+      InsertNeighbor(neighbors.colptr(i), distances.colptr(i), k,
+          poolNeighbors(j, i), poolDistances(j, i));
+    }
+  }
 }
 
 //! Perform neighbor search.
@@ -694,7 +1057,48 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
     Log::Info << "Maximum of " << Epsilon() * 100 << "% relative error."
         << std::endl;
 
-  nSearch->Search(timers, k, neighbors, distances);
+  // Monochromatic search treats the indexed set as the query set, so fold any
+  // buffered points into the tree first.
+  if (bufferPoints.n_cols > 0)
+    FlushUpdates(timers);
+
+  if (removedPoints.empty())
+  {
+    nSearch->Search(timers, k, neighbors, distances);
+    return;
+  }
+
+  const size_t livePoints = Dataset().n_cols - removedPoints.size();
+  if (k >= livePoints)
+  {
+    std::ostringstream oss;
+    oss << "NSModel::Search(): requested " << k << " neighbors, but only "
+        << livePoints << " reference points are live!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Ask the tree for enough extra neighbors to survive tombstone filtering.
+  const size_t treeK =
+      std::min(k + removedPoints.size(), Dataset().n_cols - 1);
+  arma::Mat<size_t> treeNeighbors;
+  arma::mat treeDistances;
+  nSearch->Search(timers, treeK, treeNeighbors, treeDistances);
+
+  neighbors.set_size(k, treeNeighbors.n_cols);
+  distances.set_size(k, treeNeighbors.n_cols);
+  neighbors.fill(SIZE_MAX);
+  distances.fill(SortPolicy::WorstDistance());
+  for (size_t i = 0; i < treeNeighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < treeK; ++j)
+    {
+      if (removedPoints.count(treeNeighbors(j, i)) > 0)
+        continue;
+
+      InsertNeighbor(neighbors.colptr(i), distances.colptr(i), k,
+          treeNeighbors(j, i), treeDistances(j, i));
+    }
+  }
 }
 
 //! Get the name of the tree type.
@@ -733,6 +1137,10 @@ std::string NSModel<SortPolicy>::TreeName() const
       return "UB tree";
     case OCTREE:
       return "octree";
+    case HNSW:
+      return "HNSW graph";
+    case BRUTE_FORCE:
+      return "blocked brute-force";
     default:
       return "unknown tree";
   }
@@ -0,0 +1,132 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search.hpp
+ * @author Ryan Curtin
+ *
+ * A sharded neighbor search engine: the reference set is partitioned into
+ * shards, each with its own tree, and queries are answered by searching the
+ * shards in turn and merging their top-k results in-library.  Before a shard
+ * is searched, queries whose current k'th-best result already beats the bound
+ * of the shard's root node are pruned from that shard entirely.  This replaces
+ * ad-hoc external sharding and result merging with a single API, and the
+ * per-shard layout matches one-tree-per-node distributed deployments.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The ShardedNeighborSearch class performs distance-based neighbor search
+ * over a reference set that is split into contiguous shards, each indexed by
+ * its own tree.  Search() runs over the shards sequentially, so that results
+ * found in earlier shards tighten the candidate bounds used to prune later
+ * shards: a query is not sent to a shard at all if the best possible distance
+ * to the shard's root node cannot improve the query's current k'th-best
+ * result.  Results are merged into a single globally-indexed top-k list.
+ *
+ * The class intentionally mirrors the NeighborSearch interface; each shard is
+ * a complete NeighborSearch engine, so all of its search modes are available.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = mlpack::metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class ShardedNeighborSearch
+{
+ public:
+  //! Convenience typedef for the per-shard search engine.
+  typedef NeighborSearch<SortPolicy, MetricType, MatType, TreeType> SearchType;
+  //! Convenience typedef for the per-shard tree.
+  typedef typename SearchType::Tree Tree;
+  //! The element type of the data (and of the returned distances).
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Initialize the ShardedNeighborSearch object with the given reference set,
+   * splitting it into the given number of contiguous shards and building one
+   * tree per shard.  The neighbor indices returned by Search() refer to
+   * columns of the reference set given here.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numShards Number of shards to split the reference set into.
+   * @param mode Neighbor search mode for the per-shard searches.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param metric An optional instance of the MetricType class.
+   */
+  ShardedNeighborSearch(MatType referenceSet,
+                        const size_t numShards,
+                        const NeighborSearchMode mode = DUAL_TREE_MODE,
+                        const double epsilon = 0,
+                        const MetricType metric = MetricType());
+
+  /**
+   * For each point in the query set, compute the k best neighbors across all
+   * shards and store the merged output in the given matrices.  The matrices
+   * will be set to the size of n columns by k rows, where n is the number of
+   * points in the query set.  Neighbor indices refer to columns of the full
+   * reference set.
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances);
+
+  //! Return the number of shards.
+  size_t NumShards() const { return shards.size(); }
+  //! Return the given shard's search engine.
+  const SearchType& Shard(const size_t i) const { return shards[i]; }
+  //! Return the index of the first reference point of the given shard.
+  size_t ShardOffset(const size_t i) const { return shardOffsets[i]; }
+
+ private:
+  /**
+   * Insert the given candidate into the merged result list of the given
+   * query, shifting worse results down.  The candidate must be known to be
+   * better than the query's current worst kept result.
+   */
+  void InsertNeighbor(arma::Mat<size_t>& neighbors,
+                      arma::Mat<ElemType>& distances,
+                      const size_t queryIndex,
+                      const size_t neighbor,
+                      const ElemType distance) const;
+
+  //! The per-shard search engines.
+  std::vector<SearchType> shards;
+  //! The index of each shard's first point in the full reference set.
+  std::vector<size_t> shardOffsets;
+  //! Total number of reference points across all shards.
+  size_t totalPoints;
+  //! The mode used by the per-shard searches; in naive mode no trees exist,
+  //! so root-bound shard pruning is disabled.
+  NeighborSearchMode searchMode;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "sharded_neighbor_search_impl.hpp"
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the ShardedNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sharded_neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+ShardedNeighborSearch(MatType referenceSet,
+                      const size_t numShards,
+                      const NeighborSearchMode mode,
+                      const double epsilon,
+                      const MetricType metric) :
+    totalPoints(referenceSet.n_cols),
+    searchMode(mode)
+{
+  if (numShards == 0)
+  {
+    Log::Fatal << "ShardedNeighborSearch::ShardedNeighborSearch(): number of "
+        << "shards must be greater than 0!" << std::endl;
+  }
+
+  // Never create empty shards if there are fewer points than shards.
+  const size_t shardCount = std::min(numShards, totalPoints);
+
+  shards.reserve(shardCount);
+  shardOffsets.reserve(shardCount);
+  for (size_t s = 0; s < shardCount; ++s)
+  {
+    const size_t begin = (s * totalPoints) / shardCount;
+    const size_t end = ((s + 1) * totalPoints) / shardCount;
+
+    shardOffsets.push_back(begin);
+    MatType shardData = referenceSet.cols(begin, end - 1);
+    shards.emplace_back(std::move(shardData), mode, epsilon, metric);
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances)
+{
+  if (k > totalPoints)
+  {
+    Log::Fatal << "Requested value of k (" << k << ") is greater than the "
+        << "total number of reference points across all shards ("
+        << totalPoints << ")." << std::endl;
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  neighbors.fill(size_t() - 1);
+  distances.set_size(k, querySet.n_cols);
+  distances.fill(SortPolicy::WorstDistance());
+
+  // Reused across shards.
+  std::vector<size_t> activeQueries;
+  arma::Mat<size_t> shardNeighbors;
+  arma::Mat<ElemType> shardDistances;
+
+  for (size_t s = 0; s < shards.size(); ++s)
+  {
+    // Distance-bounded shard pruning: a query whose current k'th-best result
+    // is already better than the best possible distance to this shard's root
+    // node cannot improve here, so it is not sent to the shard at all.  In
+    // naive mode there is no tree to take a bound from, so every query is
+    // searched in every shard.
+    activeQueries.clear();
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
+      if (searchMode != NAIVE_MODE)
+      {
+        const double bound = SortPolicy::BestPointToNodeDistance(
+            querySet.col(q), &shards[s].ReferenceTree());
+        if (!SortPolicy::IsBetter(bound, distances(k - 1, q)))
+          continue;
+      }
+
+      activeQueries.push_back(q);
+    }
+
+    if (activeQueries.empty())
+      continue;
+
+    // A shard may hold fewer than k points; then it can only contribute that
+    // many candidates.
+    const size_t shardK = std::min(k, shards[s].ReferenceSet().n_cols);
+
+    if (activeQueries.size() == querySet.n_cols)
+    {
+      shards[s].Search(querySet, shardK, shardNeighbors, shardDistances);
+    }
+    else
+    {
+      // Gather the still-active queries into a contiguous set.
+      MatType activeSet(querySet.n_rows, activeQueries.size());
+      for (size_t j = 0; j < activeQueries.size(); ++j)
+        activeSet.col(j) = querySet.col(activeQueries[j]);
+
+      shards[s].Search(activeSet, shardK, shardNeighbors, shardDistances);
+    }
+
+    // Merge the shard's results into the global top-k lists, mapping the
+    // shard-local neighbor indices back to full reference set indices.
+    for (size_t j = 0; j < activeQueries.size(); ++j)
+    {
+      const size_t q = activeQueries[j];
+      for (size_t i = 0; i < shardK; ++i)
+      {
+        // The shard's candidates are sorted best-first, so once one fails to
+        // improve the query's worst kept result, none of the rest can.
+        if (!SortPolicy::IsBetter(shardDistances(i, j), distances(k - 1, q)))
+          break;
+
+        InsertNeighbor(neighbors, distances, q,
+            shardOffsets[s] + shardNeighbors(i, j), shardDistances(i, j));
+      }
+    }
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+InsertNeighbor(arma::Mat<size_t>& neighbors,
+               arma::Mat<ElemType>& distances,
+               const size_t queryIndex,
+               const size_t neighbor,
+               const ElemType distance) const
+{
+  // Find the insertion position; the caller guarantees the candidate beats
+  // the worst kept result, so this always terminates inside the list.
+  size_t pos = 0;
+  while (!SortPolicy::IsBetter(distance, distances(pos, queryIndex)))
+    ++pos;
+
+  // Shift worse results down and insert.
+  for (size_t r = distances.n_rows - 1; r > pos; --r)
+  {
+    distances(r, queryIndex) = distances(r - 1, queryIndex);
+    neighbors(r, queryIndex) = neighbors(r - 1, queryIndex);
+  }
+
+  distances(pos, queryIndex) = distance;
+  neighbors(pos, queryIndex) = neighbor;
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
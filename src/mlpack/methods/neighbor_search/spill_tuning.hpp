@@ -0,0 +1,176 @@
+/**
+ * @file methods/neighbor_search/spill_tuning.hpp
+ * @author Ryan Curtin
+ *
+ * Auto-tuning of spill tree overlap parameters for defeatist neighbor
+ * search.  Given a recall target and a sample of queries, this sweeps
+ * (tau, rho) configurations with the existing DefeatistKNN machinery,
+ * measures recall against the exact neighbors, and returns the cheapest
+ * configuration that meets the target together with its runtime counters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_TUNING_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_TUNING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/spill_tree.hpp>
+
+#include "neighbor_search.hpp"
+#include "typedef.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * One measured defeatist search configuration.  The counters come straight
+ * from the search that measured the configuration, so they can also be
+ * logged in production to watch for recall drift: a rising base-case count
+ * or falling recall on a fixed probe set means the overlap no longer fits
+ * the data.
+ */
+struct SpillSearchConfig
+{
+  //! Overlap buffer width of the spill tree.
+  double tau;
+  //! Balance threshold of the spill tree.
+  double rho;
+  //! Fraction of the true k nearest neighbors found on the query sample.
+  double recall;
+  //! Number of base cases evaluated over the whole query sample.
+  size_t baseCases;
+  //! Number of node scores evaluated over the whole query sample.
+  size_t scores;
+};
+
+/**
+ * Sweep spill tree overlap configurations for defeatist nearest-neighbor
+ * search and return the cheapest one that reaches the given recall target on
+ * the given query sample.  If no configuration reaches the target, the one
+ * with the highest recall is returned.  Cost is measured in base cases plus
+ * scores, which tracks wall time but is deterministic.
+ *
+ * If no candidate grids are given, rho is fixed at its 0.7 default and tau
+ * is swept over fractions of the data scale (estimated from sampled pairwise
+ * distances), from no overlap up to a fifth of the scale.
+ *
+ * @param referenceSet Points to index.
+ * @param querySample Representative sample of query points.
+ * @param k Number of neighbors that searches will request.
+ * @param recallTarget Desired fraction of true neighbors found (e.g. 0.95).
+ * @param taus Candidate overlap widths (optional).
+ * @param rhos Candidate balance thresholds (optional).
+ * @param profiles If non-NULL, every measured configuration is appended.
+ */
+inline SpillSearchConfig TuneDefeatistSpill(
+    const arma::mat& referenceSet,
+    const arma::mat& querySample,
+    const size_t k,
+    const double recallTarget,
+    std::vector<double> taus = std::vector<double>(),
+    std::vector<double> rhos = std::vector<double>(),
+    std::vector<SpillSearchConfig>* profiles = NULL)
+{
+  typedef tree::SPTree<metric::EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> SpillTreeType;
+
+  // Compute the exact neighbors once; recall is measured against these.
+  KNN exact(referenceSet);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  exact.Search(querySample, k, exactNeighbors, exactDistances);
+
+  if (taus.empty())
+  {
+    // Estimate the data scale from sampled pairwise distances, and sweep tau
+    // over fractions of it; tau = 0 is plain defeatist search.
+    double scale = 0.0;
+    const size_t pairs = std::min<size_t>(100, referenceSet.n_cols / 2);
+    for (size_t i = 0; i < pairs; ++i)
+    {
+      scale += metric::EuclideanDistance::Evaluate(
+          referenceSet.col(math::RandInt(referenceSet.n_cols)),
+          referenceSet.col(math::RandInt(referenceSet.n_cols)));
+    }
+    scale /= std::max<size_t>(pairs, 1);
+
+    const double fractions[] = { 0.0, 0.01, 0.025, 0.05, 0.1, 0.2 };
+    for (size_t i = 0; i < 6; ++i)
+      taus.push_back(fractions[i] * scale);
+  }
+
+  if (rhos.empty())
+    rhos.push_back(0.7);
+
+  SpillSearchConfig best;
+  best.tau = taus[0];
+  best.rho = rhos[0];
+  best.recall = -1.0;
+  best.baseCases = 0;
+  best.scores = 0;
+  bool bestMeetsTarget = false;
+
+  for (size_t r = 0; r < rhos.size(); ++r)
+  {
+    for (size_t t = 0; t < taus.size(); ++t)
+    {
+      SpillTreeType tree(referenceSet, taus[t], 20 /* maxLeafSize */,
+          rhos[r]);
+      DefeatistKNN<tree::SPTree> searcher(std::move(tree), SINGLE_TREE_MODE);
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      searcher.Search(querySample, k, neighbors, distances);
+
+      // Recall: fraction of true neighbors present in the returned lists.
+      size_t hits = 0;
+      for (size_t q = 0; q < querySample.n_cols; ++q)
+      {
+        for (size_t j = 0; j < k; ++j)
+        {
+          for (size_t m = 0; m < k; ++m)
+          {
+            if (neighbors(m, q) == exactNeighbors(j, q))
+            {
+              ++hits;
+              break;
+            }
+          }
+        }
+      }
+
+      SpillSearchConfig config;
+      config.tau = taus[t];
+      config.rho = rhos[r];
+      config.recall = (double) hits / (double) (k * querySample.n_cols);
+      config.baseCases = searcher.BaseCases();
+      config.scores = searcher.Scores();
+
+      if (profiles)
+        profiles->push_back(config);
+
+      const bool meetsTarget = (config.recall >= recallTarget);
+      const size_t cost = config.baseCases + config.scores;
+      const size_t bestCost = best.baseCases + best.scores;
+
+      // Prefer configurations that meet the target; among those, take the
+      // cheapest.  If none meet it, keep the highest recall seen.
+      if ((meetsTarget && (!bestMeetsTarget || cost < bestCost)) ||
+          (!meetsTarget && !bestMeetsTarget && config.recall > best.recall))
+      {
+        best = config;
+        bestMeetsTarget = meetsTarget;
+      }
+    }
+  }
+
+  return best;
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -37,6 +37,16 @@ typedef NeighborSearch<NearestNeighborSort, metric::EuclideanDistance> KNN;
  */
 typedef NeighborSearch<FurthestNeighborSort, metric::EuclideanDistance> KFN;
 
+/**
+ * The SparseKNN class is the k-nearest-neighbors method on sparse data; the
+ * data is never densified.  It returns L2 distances (Euclidean distances) for
+ * each of the k nearest neighbors.  For data that is only a fraction of a
+ * percent dense (and therefore typically very high-dimensional, where tree
+ * pruning is ineffective), consider InvertedIndexKNN instead.
+ */
+typedef NeighborSearch<NearestNeighborSort, metric::EuclideanDistance,
+    arma::sp_mat> SparseKNN;
+
 /**
  * The DefeatistKNN class is the k-nearest-neighbors method considering
  * defeatist search. It returns L2 distances (Euclidean distances) for each of
@@ -16,6 +16,8 @@
 // In case it hasn't been included yet.
 #include "nystroem_method.hpp"
 
+#include <mlpack/core/kernels/gram_matrix.hpp>
+
 namespace mlpack {
 namespace kernel {
 
@@ -35,18 +37,12 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      miniKernel(i, j) = kernel.Evaluate(selectedData->col(i),
-                                         selectedData->col(j));
+  // Assemble the mini-kernel matrix (symmetric) and the semi-kernel matrix
+  // with the interactions between the selected data and all points, tile by
+  // tile and in parallel.
+  ComputeKernelMatrix(*selectedData, miniKernel, kernel);
+  ComputeKernelMatrix(data, *selectedData, semiKernel, kernel);
 
-  // Construct semi-kernel matrix with interactions between selected data and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         selectedData->col(j));
   // Clean the memory.
   delete selectedData;
 }
@@ -57,22 +53,14 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-  {
-    for (size_t j = 0; j < rank; ++j)
-    {
-      miniKernel(i, j) = kernel.Evaluate(data.col(selectedPoints(i)),
-                                         data.col(selectedPoints(j)));
-    }
-  }
-
-  // Construct semi-kernel matrix with interactions between selected points and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         data.col(selectedPoints(j)));
+  // Materialize the selected columns once, then assemble the mini-kernel
+  // matrix (symmetric) and the semi-kernel matrix with the interactions
+  // between the selected points and all points, tile by tile and in
+  // parallel.
+  const arma::mat selectedData = data.cols(arma::conv_to<arma::uvec>::from(
+      selectedPoints));
+  ComputeKernelMatrix(selectedData, miniKernel, kernel);
+  ComputeKernelMatrix(data, selectedData, semiKernel, kernel);
 }
 
 template<typename KernelType, typename PointSelectionPolicy>
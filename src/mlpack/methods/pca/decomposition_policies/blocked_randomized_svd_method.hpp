@@ -0,0 +1,112 @@
+/**
+ * @file methods/pca/decomposition_policies/blocked_randomized_svd_method.hpp
+ *
+ * Implementation of the blocked randomized SVD method for use in the
+ * Principal Components Analysis method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_BLOCKED_RANDOMIZED_SVD_METHOD_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_BLOCKED_RANDOMIZED_SVD_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/randomized_svd/blocked_randomized_svd.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * Implementation of the blocked randomized SVD policy.
+ */
+class BlockedRandomizedSVDPolicy
+{
+ public:
+  /**
+   * Use the blocked randomized SVD method to perform the principal components
+   * analysis (PCA).
+   *
+   * @param oversampling Number of sketch columns beyond the requested rank
+   *        (Default: 10).
+   * @param maxIterations Number of subspace iterations (Default: 2).
+   * @param blockSize Number of sketch columns per panel block; 0 means a
+   *        default panel width is used (Default: 0).
+   */
+  BlockedRandomizedSVDPolicy(const size_t oversampling = 10,
+                             const size_t maxIterations = 2,
+                             const size_t blockSize = 0) :
+      oversampling(oversampling),
+      maxIterations(maxIterations),
+      blockSize(blockSize)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided data set using the
+   * blocked randomized SVD.
+   *
+   * @param data Data matrix.
+   * @param centeredData Centered data matrix.
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  void Apply(const arma::mat& data,
+             const arma::mat& centeredData,
+             arma::mat& transformedData,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t rank)
+  {
+    // This matrix will store the right singular vectors; we do not need them.
+    arma::mat v;
+
+    // Do singular value decomposition using the blocked randomized SVD
+    // algorithm.
+    svd::BlockedRandomizedSVD bsvd(oversampling, maxIterations, blockSize);
+    bsvd.Apply(data, eigvec, eigVal, v, rank);
+
+    // Now we must square the singular values to get the eigenvalues.
+    // In addition we must divide by the number of points, because the
+    // covariance matrix is X * X' / (N - 1).
+    eigVal %= eigVal / (data.n_cols - 1);
+
+    // Project the samples to the principals.
+    transformedData = arma::trans(eigvec) * centeredData;
+  }
+
+  //! Get the number of extra sketch columns.
+  size_t Oversampling() const { return oversampling; }
+  //! Modify the number of extra sketch columns.
+  size_t& Oversampling() { return oversampling; }
+
+  //! Get the number of subspace iterations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the number of subspace iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of sketch columns per panel block.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of sketch columns per panel block.
+  size_t& BlockSize() { return blockSize; }
+
+ private:
+  //! Locally stored number of extra sketch columns.
+  size_t oversampling;
+
+  //! Locally stored number of subspace iterations.
+  size_t maxIterations;
+
+  //! Locally stored number of sketch columns per panel block.
+  size_t blockSize;
+};
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * @file methods/pca/decomposition_policies/incremental_svd_method.hpp
+ *
+ * Implementation of the incremental (streaming) SVD method for use in the
+ * Principal Components Analysis method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_INCREMENTAL_SVD_METHOD_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_INCREMENTAL_SVD_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * Implementation of the incremental SVD policy.  The data is consumed in
+ * column batches, and a rank-k SVD of everything seen so far is maintained
+ * via sequential low-rank updates:
+ *
+ * @code
+ * @inproceedings{brand2002incremental,
+ *   title     = {Incremental singular value decomposition of uncertain data
+ *                with missing values},
+ *   author    = {Brand, Matthew},
+ *   booktitle = {European Conference on Computer Vision},
+ *   pages     = {707--720},
+ *   year      = {2002}
+ * }
+ * @endcode
+ *
+ * For each batch, only the current basis (d x k), the batch itself and a
+ * small (k + b) x (k + b) matrix are in flight, so the working memory is
+ * O(d * (k + b)) regardless of the number of points.  Each truncation step
+ * discards the spectrum beyond rank k, so the result is an approximation
+ * unless k covers the full spectrum.  UpdateSVD() is public, so callers that
+ * stream their batches from disk can maintain the running decomposition
+ * directly without ever forming the data matrix.
+ */
+class IncrementalSVDPolicy
+{
+ public:
+  /**
+   * Use the incremental SVD method to perform the principal components
+   * analysis (PCA).
+   *
+   * @param batchSize Number of columns consumed per sequential update
+   *        (Default: 256).
+   */
+  IncrementalSVDPolicy(const size_t batchSize = 256) :
+      batchSize(batchSize)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided data set using the
+   * incremental SVD.
+   *
+   * @param data Data matrix.
+   * @param centeredData Centered data matrix.
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  void Apply(const arma::mat& data,
+             const arma::mat& centeredData,
+             arma::mat& transformedData,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t rank)
+  {
+    arma::mat u;
+    arma::vec s;
+
+    // Consume the centered data in column batches, maintaining the running
+    // rank-k SVD.
+    size_t offset = 0;
+    while (offset < centeredData.n_cols)
+    {
+      const size_t last = std::min(offset + batchSize,
+          (size_t) centeredData.n_cols) - 1;
+      UpdateSVD(u, s, centeredData.cols(offset, last), rank);
+      offset = last + 1;
+    }
+
+    eigvec = u;
+
+    // Now we must square the singular values to get the eigenvalues.
+    // In addition we must divide by the number of points, because the
+    // covariance matrix is X * X' / (N - 1).
+    eigVal = s % s / (data.n_cols - 1);
+
+    // Project the samples to the principals.
+    transformedData = arma::trans(eigvec) * centeredData;
+  }
+
+  /**
+   * Fold one batch of (centered) columns into the running rank-k SVD.  An
+   * empty basis is initialized from the first batch.
+   *
+   * @param u Left singular vectors of everything seen so far (d x k).
+   * @param s Singular values of everything seen so far.
+   * @param batch Batch of columns to fold in.
+   * @param rank Rank of the maintained decomposition.
+   */
+  static void UpdateSVD(arma::mat& u,
+                        arma::vec& s,
+                        const arma::mat& batch,
+                        const size_t rank)
+  {
+    if (u.n_cols == 0)
+    {
+      // First batch: initialize the basis from its truncated SVD.
+      arma::mat v;
+      arma::svd_econ(u, s, v, batch);
+      if (s.n_elem > rank)
+      {
+        u = u.cols(0, rank - 1);
+        s = s.subvec(0, rank - 1);
+      }
+      return;
+    }
+
+    // Split the batch into its projection onto the current basis and the
+    // orthonormalized residual that leaves the basis.
+    const arma::mat projection = u.t() * batch;
+    arma::mat residualBasis, residual;
+    arma::qr_econ(residualBasis, residual, batch - u * projection);
+
+    // Assemble the small middle matrix
+    //     [ diag(s)  projection ]
+    //     [    0      residual  ]
+    // whose SVD rotates the expanded basis onto the updated one.
+    const size_t r = s.n_elem;
+    arma::mat middle(r + residualBasis.n_cols, r + batch.n_cols,
+        arma::fill::zeros);
+    middle.submat(0, 0, r - 1, r - 1) = arma::diagmat(s);
+    middle.submat(0, r, r - 1, r + batch.n_cols - 1) = projection;
+    middle.submat(r, r, r + residualBasis.n_cols - 1,
+        r + batch.n_cols - 1) = residual;
+
+    arma::mat uMiddle, vMiddle;
+    arma::vec sMiddle;
+    arma::svd_econ(uMiddle, sMiddle, vMiddle, middle);
+
+    // Rotate the expanded basis and truncate back to rank k.
+    const size_t keep = std::min(rank, (size_t) sMiddle.n_elem);
+    u = arma::join_rows(u, residualBasis) * uMiddle.cols(0, keep - 1);
+    s = sMiddle.subvec(0, keep - 1);
+  }
+
+  //! Get the number of columns consumed per sequential update.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of columns consumed per sequential update.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! Locally stored number of columns consumed per sequential update.
+  size_t batchSize;
+};
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
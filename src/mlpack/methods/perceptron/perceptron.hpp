@@ -127,6 +127,29 @@ class Perceptron
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get the number of epochs between full sweeps over the data (1 means
+  //! every epoch is a full sweep; see FullSweepInterval() for details).
+  size_t FullSweepInterval() const { return fullSweepInterval; }
+  /**
+   * Modify the number of epochs between full sweeps over the data.  When set
+   * to a value n greater than 1, Train() runs in active-set mode: a full
+   * sweep builds a shortlist of the points that were misclassified or
+   * correctly classified with margin at most ActiveSetMargin(), the following
+   * n - 1 epochs re-check only that shortlist, and then another full sweep
+   * refreshes it.  Convergence is only ever declared by a full sweep that
+   * makes no mistakes, so the learned separator is still exact; the active
+   * epochs simply skip points that are classified with large margins and
+   * almost never trigger updates.
+   */
+  size_t& FullSweepInterval() { return fullSweepInterval; }
+
+  //! Get the margin below which correctly classified points stay on the
+  //! active shortlist (in score units; 0 keeps only misclassified points).
+  double ActiveSetMargin() const { return activeSetMargin; }
+  //! Modify the margin below which correctly classified points stay on the
+  //! active shortlist.
+  double& ActiveSetMargin() { return activeSetMargin; }
+
   //! Get the number of classes this perceptron has been trained for.
   size_t NumClasses() const { return weights.n_cols; }
 
@@ -141,9 +164,27 @@ class Perceptron
   arma::vec& Biases() { return biases; }
 
  private:
+  /**
+   * Compute the classification margin of the given score column: the score
+   * of the correct class minus the best score of any other class (negative
+   * if the point is misclassified).
+   *
+   * @param scores Column of per-class scores for one point.
+   * @param label Correct class of the point.
+   */
+  static double Margin(const arma::vec& scores, const size_t label);
+
   //! The maximum number of iterations during training.
   size_t maxIterations;
 
+  //! Number of epochs between full sweeps over the data during training; a
+  //! value greater than 1 enables active-set epochs.
+  size_t fullSweepInterval = 1;
+
+  //! Margin below which correctly classified points stay on the active
+  //! shortlist.
+  double activeSetMargin = 0.0;
+
   /**
    * Stores the weights for each of the input class labels.  Each column
    * corresponds to the weights for one class label, and each row corresponds to
@@ -145,53 +145,151 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     wip.Initialize(weights, biases, data.n_rows, numClasses);
   }
 
-  size_t j, i = 0;
+  size_t i = 0;
   bool converged = false;
-  size_t tempLabel;
-  arma::uword maxIndexRow = 0, maxIndexCol = 0;
-  arma::mat tempLabelMat;
+  arma::uword maxIndex = 0;
 
   LearnPolicy LP;
 
   const bool hasWeights = (instanceWeights.n_elem > 0);
 
+  // Indices re-checked during active-set epochs; rebuilt by every full sweep.
+  std::vector<size_t> activeSet;
+  size_t epochsUntilFullSweep = 0;
+
+  // During a full sweep, points are scored in chunks with a single matrix
+  // product per chunk; the not-yet-visited part of a chunk only has to be
+  // rescored when a mistake triggers a weight update.
+  const size_t chunkSize = 256;
+  arma::mat scores;
+
   while ((i < maxIterations) && (!converged))
   {
     // This outer loop is for each iteration, and we use the 'converged'
     // variable for noting whether or not convergence has been reached.
     ++i;
-    converged = true;
 
-    // Now this inner loop is for going through the dataset in each iteration.
-    for (j = 0; j < data.n_cols; ++j)
+    if (epochsUntilFullSweep == 0 || activeSet.empty())
     {
-      // Multiply for each variable and check whether the current weight vector
-      // correctly classifies this.
-      tempLabelMat = weights.t() * data.col(j) + biases;
+      // Full sweep over the whole dataset; this is the only place where
+      // convergence can be declared, and it rebuilds the active shortlist of
+      // misclassified and near-margin points.
+      activeSet.clear();
+      converged = true;
+
+      for (size_t start = 0; start < (size_t) data.n_cols; start += chunkSize)
+      {
+        const size_t last =
+            std::min(start + chunkSize, (size_t) data.n_cols) - 1;
+        scores = weights.t() * data.cols(start, last);
+        scores.each_col() += biases;
+
+        for (size_t j = start; j <= last; ++j)
+        {
+          const arma::vec pointScores = scores.col(j - start);
+          pointScores.max(maxIndex);
+
+          // Check whether prediction is correct.
+          if (maxIndex != labels(0, j))
+          {
+            // Due to incorrect prediction, convergence set to false.
+            converged = false;
 
-      tempLabelMat.max(maxIndexRow, maxIndexCol);
+            // Send maxIndex for knowing which weight to update, send j to
+            // know the value of the vector to update it with.
+            if (hasWeights)
+              LP.UpdateWeights(data.col(j), weights, biases, maxIndex,
+                  labels(0, j), instanceWeights(j));
+            else
+              LP.UpdateWeights(data.col(j), weights, biases, maxIndex,
+                  labels(0, j));
+            activeSet.push_back(j);
 
-      // Check whether prediction is correct.
-      if (maxIndexRow != labels(0, j))
+            // The update invalidates the precomputed scores of the points of
+            // this chunk that have not been visited yet.
+            if (j < last)
+            {
+              scores.cols(j - start + 1, last - start) =
+                  weights.t() * data.cols(j + 1, last);
+              scores.cols(j - start + 1, last - start).each_col() += biases;
+            }
+          }
+          else if (Margin(pointScores, labels(0, j)) <= activeSetMargin)
+          {
+            activeSet.push_back(j);
+          }
+        }
+      }
+
+      epochsUntilFullSweep = (fullSweepInterval > 1) ?
+          (fullSweepInterval - 1) : 0;
+    }
+    else
+    {
+      // Active-set epoch: re-check only the shortlisted points.  Points that
+      // are now classified beyond the margin drop off the shortlist.
+      --epochsUntilFullSweep;
+      bool anyMistake = false;
+      std::vector<size_t> stillActive;
+
+      for (size_t k = 0; k < activeSet.size(); ++k)
       {
-        // Due to incorrect prediction, convergence set to false.
-        converged = false;
-        tempLabel = labels(0, j);
-
-        // Send maxIndexRow for knowing which weight to update, send j to know
-        // the value of the vector to update it with.  Send tempLabel to know
-        // the correct class.
-        if (hasWeights)
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow, tempLabel,
-              instanceWeights(j));
-        else
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
-              tempLabel);
+        const size_t j = activeSet[k];
+        const arma::vec pointScores = weights.t() * data.col(j) + biases;
+        pointScores.max(maxIndex);
+
+        if (maxIndex != labels(0, j))
+        {
+          anyMistake = true;
+
+          if (hasWeights)
+            LP.UpdateWeights(data.col(j), weights, biases, maxIndex,
+                labels(0, j), instanceWeights(j));
+          else
+            LP.UpdateWeights(data.col(j), weights, biases, maxIndex,
+                labels(0, j));
+          stillActive.push_back(j);
+        }
+        else if (Margin(pointScores, labels(0, j)) <= activeSetMargin)
+        {
+          stillActive.push_back(j);
+        }
       }
+
+      activeSet.swap(stillActive);
+
+      // If the whole shortlist was clean there is nothing left to learn from
+      // it; refresh it with a full sweep on the next epoch.
+      if (!anyMistake)
+        epochsUntilFullSweep = 0;
     }
   }
 }
 
+//! Compute the classification margin of the given score column.
+template<
+    typename LearnPolicy,
+    typename WeightInitializationPolicy,
+    typename MatType
+>
+double Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Margin(
+    const arma::vec& scores,
+    const size_t label)
+{
+  // With a single class there is no competing score to measure against.
+  if (scores.n_elem <= 1)
+    return DBL_MAX;
+
+  double bestOther = -DBL_MAX;
+  for (size_t c = 0; c < scores.n_elem; ++c)
+  {
+    if (c != label)
+      bestOther = std::max(bestOther, scores(c));
+  }
+
+  return scores(label) - bestOther;
+}
+
 //! Serialize the perceptron.
 template<typename LearnPolicy,
          typename WeightInitializationPolicy,
@@ -201,9 +299,11 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::serialize(
     Archive& ar,
     const uint32_t /* version */)
 {
-  // We just need to serialize the maximum number of iterations, the weights,
-  // and the biases.
+  // We just need to serialize the training parameters, the weights, and the
+  // biases.
   ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(fullSweepInterval));
+  ar(CEREAL_NVP(activeSetMargin));
   ar(CEREAL_NVP(weights));
   ar(CEREAL_NVP(biases));
 }
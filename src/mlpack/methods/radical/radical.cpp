@@ -24,20 +24,33 @@ Radical::Radical(const double noiseStdDev,
                  const size_t replicates,
                  const size_t angles,
                  const size_t sweeps,
-                 const size_t m) :
+                 const size_t m,
+                 const size_t batchSize) :
     noiseStdDev(noiseStdDev),
     replicates(replicates),
     angles(angles),
     sweeps(sweeps),
-    m(m)
+    m(m),
+    batchSize(batchSize)
 {
   // Nothing to do here.
 }
 
 void Radical::CopyAndPerturb(mat& xNew, const mat& x) const
 {
-  xNew = repmat(x, replicates, 1) + noiseStdDev * randn(replicates * x.n_rows,
-      x.n_cols);
+  if ((batchSize > 0) && (batchSize < x.n_rows))
+  {
+    // Stochastic mode: estimate the objective on a random minibatch of the
+    // points instead of all of them.
+    const uvec selected = randperm(x.n_rows, batchSize);
+    xNew = repmat(x.rows(selected), replicates, 1) + noiseStdDev *
+        randn(replicates * batchSize, x.n_cols);
+  }
+  else
+  {
+    xNew = repmat(x, replicates, 1) + noiseStdDev * randn(replicates * x.n_rows,
+        x.n_cols);
+  }
 }
 
 
@@ -70,13 +83,23 @@ double Radical::DoRadical2D(const mat& matX, util::Timers& timers)
   CopyAndPerturb(perturbed, matX);
   timers.Stop("radical_copy_and_perturb");
 
+  return BestAngle(perturbed, candidate, 0.0, M_PI / 2.0);
+}
+
+
+double Radical::BestAngle(const mat& perturbedX,
+                          mat& candidateY,
+                          const double thetaMin,
+                          const double thetaMax) const
+{
   mat::fixed<2, 2> matJacobi;
 
   vec values(angles);
 
   for (size_t i = 0; i < angles; ++i)
   {
-    const double theta = (i / (double) angles) * M_PI / 2.0;
+    const double theta = thetaMin + (i / (double) angles) *
+        (thetaMax - thetaMin);
     const double cosTheta = cos(theta);
     const double sinTheta = sin(theta);
 
@@ -85,16 +108,16 @@ double Radical::DoRadical2D(const mat& matX, util::Timers& timers)
     matJacobi(0, 1) = sinTheta;
     matJacobi(1, 1) = cosTheta;
 
-    candidate = perturbed * matJacobi;
-    vec candidateY1 = candidate.unsafe_col(0);
-    vec candidateY2 = candidate.unsafe_col(1);
+    candidateY = perturbedX * matJacobi;
+    vec candidateY1 = candidateY.unsafe_col(0);
+    vec candidateY2 = candidateY.unsafe_col(1);
 
     values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
   }
 
   uword indOpt = 0;
   values.min(indOpt); // we ignore the return value; we don't care about it
-  return (indOpt / (double) angles) * M_PI / 2.0;
+  return thetaMin + (indOpt / (double) angles) * (thetaMax - thetaMin);
 }
 
 
@@ -112,9 +135,15 @@ void Radical::DoRadical(const mat& matXT,
   timers.Stop("radical_transpose_data");
 
   // If m was not specified, initialize m as recommended in
-  // (Learned-Miller and Fisher, 2003).
+  // (Learned-Miller and Fisher, 2003), using the minibatch size in stochastic
+  // mode.
   if (m < 1)
-    m = floor(sqrt((double) matX.n_rows));
+  {
+    if ((batchSize > 0) && (batchSize < matX.n_rows))
+      m = floor(sqrt((double) batchSize));
+    else
+      m = floor(sqrt((double) matX.n_rows));
+  }
 
   const size_t nDims = matX.n_cols;
   const size_t nPoints = matX.n_rows;
@@ -135,42 +164,81 @@ void Radical::DoRadical(const mat& matXT,
   timers.Start("radical_do_radical");
   matW = matWhitening;
 
-  mat matYSubspace(nPoints, 2);
+  // Each pair's last optimal rotation angle; in stochastic mode, sweeps after
+  // the first warm-start from it.
+  mat thetaOpts(nDims, nDims, fill::zeros);
 
-  mat matJ = eye(nDims, nDims);
+  // A sweep rotates every pair of dimensions.  A rotation of the pair (i, j)
+  // only reads and writes columns i and j of matY, so pairs sharing no
+  // dimension are independent.  The round-robin tournament schedule partitions
+  // all pairs into rounds of mutually disjoint pairs, which can then be
+  // rotated concurrently.  When nDims is odd, a dummy dimension is added and
+  // its pairings are skipped.
+  const size_t players = (nDims % 2 == 0) ? nDims : nDims + 1;
 
   for (size_t sweepNum = 0; sweepNum < sweeps; sweepNum++)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
 
-    for (size_t i = 0; i < nDims - 1; ++i)
+    // In stochastic mode, refine each pair's angle inside a window centered
+    // on its previous optimum; the window halves every sweep while the number
+    // of candidate angles stays the same, so the angular resolution improves
+    // as the sweeps converge.
+    const bool warmStart = (batchSize > 0) && (sweepNum > 0);
+    const double halfWidth = (M_PI / 4.0) / std::pow(2.0, (double) sweepNum);
+
+    for (size_t round = 0; round < players - 1; ++round)
     {
-      for (size_t j = i + 1; j < nDims; ++j)
+      #pragma omp parallel for default(shared)
+      for (omp_size_t k = 0; k < (omp_size_t) (players / 2); ++k)
       {
+        // Compute this round's k'th pair from the tournament schedule: the
+        // last player is fixed and the others rotate around it.
+        size_t i, j;
+        if (k == 0)
+        {
+          i = players - 1;
+          j = round;
+        }
+        else
+        {
+          i = (round + k) % (players - 1);
+          j = (round + players - 1 - k) % (players - 1);
+        }
+
+        // Skip pairings with the dummy dimension.
+        if (i >= nDims || j >= nDims)
+          continue;
+
+        if (i > j)
+          std::swap(i, j);
+
         Log::Debug << "RADICAL 2D on dimensions " << i << " and " << j << "."
             << std::endl;
 
+        mat matYSubspace(nPoints, 2);
         matYSubspace.col(0) = matY.col(i);
         matYSubspace.col(1) = matY.col(j);
 
-        const double thetaOpt = DoRadical2D(matYSubspace, timers);
+        mat perturbedLocal, candidateLocal;
+        CopyAndPerturb(perturbedLocal, matYSubspace);
+
+        const double thetaCenter = thetaOpts(i, j);
+        const double thetaOpt = warmStart ?
+            BestAngle(perturbedLocal, candidateLocal,
+                thetaCenter - halfWidth, thetaCenter + halfWidth) :
+            BestAngle(perturbedLocal, candidateLocal, 0.0, M_PI / 2.0);
+        thetaOpts(i, j) = thetaOpt;
 
         const double cosThetaOpt = cos(thetaOpt);
         const double sinThetaOpt = sin(thetaOpt);
 
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
-
-        matY *= matJ;
-
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+        // Apply the rotation to columns i and j of matY; this is equivalent
+        // to multiplying matY by the Jacobi rotation matrix of thetaOpt, but
+        // costs O(nPoints) instead of O(nPoints * nDims^2).
+        const vec yI = matY.col(i);
+        matY.col(i) = cosThetaOpt * yI - sinThetaOpt * matY.col(j);
+        matY.col(j) = sinThetaOpt * yI + cosThetaOpt * matY.col(j);
       }
     }
   }
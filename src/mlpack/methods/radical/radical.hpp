@@ -56,12 +56,15 @@ class Radical
    * @param sweeps Number of sweeps.  Each sweep calls Radical2D once for each
    *    pair of dimensions
    * @param m The variable m from Vasicek's m-spacing estimator of entropy.
+   * @param batchSize Number of points to sample per objective estimate during
+   *    Radical2D; 0 means all points are used (the exact objective).
    */
   Radical(const double noiseStdDev = 0.175,
           const size_t replicates = 30,
           const size_t angles = 150,
           const size_t sweeps = 0,
-          const size_t m = 0);
+          const size_t m = 0,
+          const size_t batchSize = 0);
 
   /**
    * Run RADICAL.
@@ -89,7 +92,9 @@ class Radical
   /**
    * Make replicates of each data point (the number of replicates is set in
    * either the constructor or with Replicates()) and perturb data with Gaussian
-   * noise with standard deviation noiseStdDev.
+   * noise with standard deviation noiseStdDev.  If BatchSize() is nonzero and
+   * smaller than the number of points, only a random minibatch of the points
+   * is replicated.
    */
   void CopyAndPerturb(arma::mat& xNew, const arma::mat& x) const;
 
@@ -97,6 +102,18 @@ class Radical
   double DoRadical2D(const arma::mat& matX,
                      util::Timers& timers = IO::GetTimers());
 
+  /**
+   * Brute-force search for the rotation angle minimizing the entropy
+   * objective over the window [thetaMin, thetaMax), given already-perturbed
+   * two-dimensional data.  The candidateY matrix is scratch space for the
+   * rotated candidates, so concurrent calls must pass distinct scratch
+   * matrices.
+   */
+  double BestAngle(const arma::mat& perturbedX,
+                   arma::mat& candidateY,
+                   const double thetaMin,
+                   const double thetaMax) const;
+
   //! Get the standard deviation of the additive Gaussian noise.
   double NoiseStdDev() const { return noiseStdDev; }
   //! Modify the standard deviation of the additive Gaussian noise.
@@ -117,6 +134,16 @@ class Radical
   //! Modify the number of sweeps.
   size_t& Sweeps() { return sweeps; }
 
+  //! Get the number of points sampled per objective estimate (0 means all
+  //! points are used).
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points sampled per objective estimate.  When
+  //! nonzero, each Radical2D objective is estimated on a random minibatch of
+  //! this many points, and each sweep after the first refines each pair's
+  //! rotation inside a window centered on its previous optimum, with the
+  //! window halving every sweep.
+  size_t& BatchSize() { return batchSize; }
+
  private:
   //! Standard deviation of the Gaussian noise added to the replicates of
   //! the data points during Radical2D.
@@ -135,6 +162,10 @@ class Radical
   //! Value of m to use for Vasicek's m-spacing estimator of entropy.
   size_t m;
 
+  //! Number of points to sample per objective estimate during Radical2D; 0
+  //! means all points are used.
+  size_t batchSize;
+
   //! Internal matrix, held as member variable to prevent memory reallocations.
   arma::mat perturbed;
   //! Internal matrix, held as member variable to prevent memory reallocations.
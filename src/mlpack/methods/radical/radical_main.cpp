@@ -76,6 +76,8 @@ PARAM_INT_IN("angles", "Number of angles to consider in brute-force search "
     "during Radical2D.", "a", 150);
 PARAM_INT_IN("sweeps", "Number of sweeps; each sweep calls Radical2D once for "
     "each pair of dimensions.", "S", 0);
+PARAM_INT_IN("batch_size", "Number of points to sample per objective estimate "
+    "in Radical2D; 0 means all points are used.", "b", 0);
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 PARAM_FLAG("objective", "If set, an estimate of the final objective function "
     "is printed.", "O");
@@ -108,6 +110,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       "number of angles must be positive");
   RequireParamValue<int>(params, "sweeps", [](int x) { return x >= 0; }, true,
       "number of sweeps must be 0 or greater");
+  RequireParamValue<int>(params, "batch_size", [](int x) { return x >= 0; },
+      true, "batch size must be 0 or greater");
 
   // Load the data.
   mat matX = std::move(params.Get<mat>("input"));
@@ -117,6 +121,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   size_t nReplicates = params.Get<int>("replicates");
   size_t nAngles = params.Get<int>("angles");
   size_t nSweeps = params.Get<int>("sweeps");
+  size_t batchSize = params.Get<int>("batch_size");
 
   if (nSweeps == 0)
   {
@@ -124,7 +129,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   }
 
   // Run RADICAL.
-  Radical rad(noiseStdDev, nReplicates, nAngles, nSweeps);
+  Radical rad(noiseStdDev, nReplicates, nAngles, nSweeps, 0, batchSize);
   mat matY;
   mat matW;
   rad.DoRadical(matX, matY, matW, timers);
@@ -13,11 +13,16 @@
 #ifndef MLPACK_METHODS_RANDOM_FOREST_BOOTSTRAP_HPP
 #define MLPACK_METHODS_RANDOM_FOREST_BOOTSTRAP_HPP
 
+#include <mlpack/core/math/random.hpp>
+
 namespace mlpack {
 namespace tree {
 
 /**
  * Given a dataset, create another dataset via bootstrap sampling, with labels.
+ * The sample indices are drawn from the given generator, so concurrent
+ * callers (e.g. the trees of a random forest) can pass independently seeded
+ * generators and get independent samples.
  */
 template<bool UseWeights,
          typename MatType,
@@ -28,7 +33,8 @@ void Bootstrap(const MatType& dataset,
                const WeightsType& weights,
                MatType& bootstrapDataset,
                LabelsType& bootstrapLabels,
-               WeightsType& bootstrapWeights)
+               WeightsType& bootstrapWeights,
+               std::mt19937& rng)
 {
   bootstrapDataset.set_size(dataset.n_rows, dataset.n_cols);
   bootstrapLabels.set_size(labels.n_elem);
@@ -36,14 +42,65 @@ void Bootstrap(const MatType& dataset,
     bootstrapWeights.set_size(weights.n_elem);
 
   // Random sampling with replacement.
-  arma::uvec indices = arma::randi<arma::uvec>(dataset.n_cols,
-      arma::distr_param(0, dataset.n_cols - 1));
+  std::uniform_int_distribution<arma::uword> indexDist(0, dataset.n_cols - 1);
+  arma::uvec indices(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    indices[i] = indexDist(rng);
   bootstrapDataset = dataset.cols(indices);
   bootstrapLabels = labels.cols(indices);
   if (UseWeights)
     bootstrapWeights = weights.cols(indices);
 }
 
+/**
+ * Given a dataset, create another dataset via bootstrap sampling, with labels,
+ * using the global random number generator.
+ */
+template<bool UseWeights,
+         typename MatType,
+         typename LabelsType,
+         typename WeightsType>
+void Bootstrap(const MatType& dataset,
+               const LabelsType& labels,
+               const WeightsType& weights,
+               MatType& bootstrapDataset,
+               LabelsType& bootstrapLabels,
+               WeightsType& bootstrapWeights)
+{
+  Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
+      bootstrapLabels, bootstrapWeights, math::randGen);
+}
+
+/**
+ * Compute per-point multiplicity weights for a bootstrap sample of the given
+ * dataset, without materializing the sample: bootstrapWeights[i] is set to the
+ * number of times point i was drawn, multiplied by the point's given weight if
+ * UseWeights is true.  Training a weighted tree on the original dataset with
+ * these weights is equivalent to training an unweighted tree on the
+ * materialized bootstrap sample, but avoids copying the dataset once per tree.
+ * (Note that constraints counted in points, like the minimum leaf size, then
+ * also count points that were drawn zero times.)
+ */
+template<bool UseWeights, typename MatType, typename WeightsType>
+void WeightedBootstrap(const MatType& dataset,
+                       const WeightsType& weights,
+                       arma::rowvec& bootstrapWeights,
+                       std::mt19937& rng)
+{
+  bootstrapWeights.zeros(dataset.n_cols);
+
+  // Random sampling with replacement.
+  std::uniform_int_distribution<arma::uword> indexDist(0, dataset.n_cols - 1);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    bootstrapWeights[indexDist(rng)] += 1.0;
+
+  if (UseWeights)
+  {
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      bootstrapWeights[i] *= weights[i];
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -12,6 +12,7 @@
 #ifndef MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_HPP
 #define MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_HPP
 
+#include <mlpack/core/util/thread_pool.hpp>
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 #include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
 #include "bootstrap.hpp"
@@ -35,12 +36,19 @@ namespace tree {
  *   publisher={Springer}
  * }
  * @endcode
+ *
+ * If UseWeightedBootstrap is true, the bootstrap sample of each tree is not
+ * materialized; instead the tree is trained on the original dataset with
+ * per-point multiplicity weights (the number of times each point was drawn).
+ * This is statistically equivalent but avoids copying the dataset once per
+ * tree, which matters for large datasets.
  */
 template<typename FitnessFunction = GiniGain,
          typename DimensionSelectionType = MultipleRandomDimensionSelect,
          template<typename> class NumericSplitType = BestBinaryNumericSplit,
          template<typename> class CategoricalSplitType = AllCategoricalSplit,
-         bool UseBootstrap = true>
+         bool UseBootstrap = true,
+         bool UseWeightedBootstrap = false>
 class RandomForest
 {
  public:
@@ -442,6 +450,22 @@ using ExtraTrees = RandomForest<FitnessFunction,
                                 CategoricalSplitType,
                                 false>;
 
+/**
+ * Convenience typedef for a random forest that represents its bootstrap
+ * samples as per-point multiplicity weights over the original dataset instead
+ * of materialized dataset copies.
+ */
+template<typename FitnessFunction = GiniGain,
+         typename DimensionSelectionType = MultipleRandomDimensionSelect,
+         template<typename> class NumericSplitType = BestBinaryNumericSplit,
+         template<typename> class CategoricalSplitType = AllCategoricalSplit>
+using WeightedBootstrapRandomForest = RandomForest<FitnessFunction,
+                                                   DimensionSelectionType,
+                                                   NumericSplitType,
+                                                   CategoricalSplitType,
+                                                   true,
+                                                   true>;
+
 } // namespace tree
 } // namespace mlpack
 
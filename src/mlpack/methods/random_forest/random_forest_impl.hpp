@@ -23,14 +23,16 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::RandomForest() :
     avgGain(0.0)
 {
@@ -42,7 +44,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 RandomForest<
@@ -50,7 +53,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::RandomForest(const MatType& dataset,
                 const arma::Row<size_t>& labels,
                 const size_t numClasses,
@@ -74,7 +78,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 RandomForest<
@@ -82,7 +87,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
                 const arma::Row<size_t>& labels,
@@ -106,7 +112,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 RandomForest<
@@ -114,7 +121,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::RandomForest(const MatType& dataset,
                 const arma::Row<size_t>& labels,
                 const size_t numClasses,
@@ -138,7 +146,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 RandomForest<
@@ -146,7 +155,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
                 const arma::Row<size_t>& labels,
@@ -170,7 +180,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 double RandomForest<
@@ -178,7 +189,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Train(const MatType& dataset,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -202,7 +214,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 double RandomForest<
@@ -210,7 +223,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -234,7 +248,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 double RandomForest<
@@ -242,7 +257,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Train(const MatType& dataset,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -266,7 +282,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 double RandomForest<
@@ -274,7 +291,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -298,7 +316,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename VecType>
 size_t RandomForest<
@@ -306,7 +325,8 @@ size_t RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Classify(const VecType& point) const
 {
   // Pass off to another Classify() overload.
@@ -322,7 +342,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename VecType>
 void RandomForest<
@@ -330,7 +351,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Classify(const VecType& point,
             size_t& prediction,
             arma::vec& probabilities) const
@@ -369,7 +391,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 void RandomForest<
@@ -377,7 +400,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Classify(const MatType& data,
             arma::Row<size_t>& predictions) const
 {
@@ -404,7 +428,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename MatType>
 void RandomForest<
@@ -412,7 +437,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Classify(const MatType& data,
             arma::Row<size_t>& predictions,
             arma::mat& probabilities) const
@@ -442,7 +468,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<typename Archive>
 void RandomForest<
@@ -450,7 +477,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::serialize(Archive& ar, const uint32_t /* version */)
 {
   size_t numTrees;
@@ -474,7 +502,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    bool UseBootstrap
+    bool UseBootstrap,
+    bool UseWeightedBootstrap
 >
 template<bool UseWeights, bool UseDatasetInfo, typename MatType>
 double RandomForest<
@@ -482,7 +511,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    UseBootstrap
+    UseBootstrap,
+    UseWeightedBootstrap
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -504,24 +534,60 @@ double RandomForest<
   // Convert avgGain to total gain.
   double totalGain = avgGain * oldNumTrees;
 
-  // Train each tree individually.
-  #pragma omp parallel for reduction( + : totalGain)
-  for (omp_size_t i = 0; i < numTrees; ++i)
+  // Draw a seed for each tree serially, so that the trees can construct
+  // independent random streams for their bootstrap samples inside the
+  // parallel loop instead of racing on (or replicating) shared generator
+  // state.
+  std::vector<uint32_t> treeSeeds(numTrees);
+  for (size_t i = 0; i < numTrees; ++i)
+    treeSeeds[i] = (uint32_t) math::randGen();
+
+  // Train each tree individually, submitting one task per tree to the
+  // process-wide thread pool.  If this Train() call itself runs inside a
+  // pool task (for example, parallel cross-validation over forests), the
+  // tasks run inline and the machine is not oversubscribed.  The random
+  // dimension selection inside the trees draws through math::RandGen(),
+  // which gives every pool worker its own registered stream (see
+  // math::RandStreamId()), so those draws do not contend either.
+  arma::vec treeGains(numTrees);
+  util::ParallelFor(0, numTrees, [&](const size_t i)
   {
     MatType bootstrapDataset;
     arma::Row<size_t> bootstrapLabels;
     arma::rowvec bootstrapWeights;
     if (UseBootstrap)
     {
-      Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-          bootstrapLabels, bootstrapWeights);
+      std::mt19937 rng(treeSeeds[i]);
+      if (UseWeightedBootstrap)
+      {
+        // Represent the bootstrap sample as per-point multiplicity weights
+        // over the original dataset instead of materializing a copy of it.
+        WeightedBootstrap<UseWeights>(dataset, weights, bootstrapWeights, rng);
+      }
+      else
+      {
+        Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
+            bootstrapLabels, bootstrapWeights, rng);
+      }
     }
 
-    if (UseWeights)
+    if (UseBootstrap && UseWeightedBootstrap)
+    {
+      // The bootstrap sample is expressed as point weights, so the tree is
+      // trained through the weighted path on the original dataset.
+      treeGains[i] = UseDatasetInfo ?
+          trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
+              numClasses, bootstrapWeights, minimumLeafSize, minimumGainSplit,
+              maximumDepth, dimensionSelector) :
+          trees[oldNumTrees + i].Train(dataset, labels, numClasses,
+              bootstrapWeights, minimumLeafSize, minimumGainSplit,
+              maximumDepth, dimensionSelector);
+    }
+    else if (UseWeights)
     {
       if (UseDatasetInfo)
       {
-        totalGain += UseBootstrap ?
+        treeGains[i] = UseBootstrap ?
             trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
                 bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
                 minimumGainSplit, maximumDepth, dimensionSelector) :
@@ -531,7 +597,7 @@ double RandomForest<
       }
       else
       {
-        totalGain += UseBootstrap ?
+        treeGains[i] = UseBootstrap ?
             trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
                 numClasses, bootstrapWeights, minimumLeafSize,
                 minimumGainSplit, maximumDepth, dimensionSelector) :
@@ -544,7 +610,7 @@ double RandomForest<
     {
       if (UseDatasetInfo)
       {
-        totalGain += UseBootstrap ?
+        treeGains[i] = UseBootstrap ?
             trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
                 bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
                 maximumDepth, dimensionSelector) :
@@ -554,7 +620,7 @@ double RandomForest<
       }
       else
       {
-        totalGain += UseBootstrap ?
+        treeGains[i] = UseBootstrap ?
             trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
                 numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
                 dimensionSelector) :
@@ -563,7 +629,9 @@ double RandomForest<
                 dimensionSelector);
       }
     }
-  }
+  });
+
+  totalGain += arma::accu(treeGains);
 
   avgGain = totalGain / trees.size();
   return avgGain;
@@ -0,0 +1,354 @@
+/**
+ * @file methods/randomized_svd/blocked_randomized_svd.hpp
+ *
+ * An implementation of the blocked, parallel randomized SVD method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_RANDOMIZED_SVD_BLOCKED_RANDOMIZED_SVD_HPP
+#define MLPACK_METHODS_RANDOMIZED_SVD_BLOCKED_RANDOMIZED_SVD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * Blocked randomized SVD is a variant of the randomized SVD method (see
+ * RandomizedSVD) tuned for large matrices: the sketch and the subspace
+ * iterations are computed over panel blocks of the random matrix, with the
+ * independent panels (or, for sparse inputs, the independent output columns)
+ * distributed across an OpenMP team.  The oversampling of the sketch beyond
+ * the requested rank and the number of subspace iterations are configurable,
+ * so accuracy can be traded against the number of passes over the data.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Halko2011,
+ *   author  = {Halko, N. and Martinsson, P. G. and Tropp, J. A.},
+ *   title   = {Finding Structure with Randomness: Probabilistic Algorithms for
+                Constructing Approximate Matrix Decompositions},
+ *   journal = {SIAM Rev.},
+ *   volume  = {53},
+ *   year    = {2011},
+ * }
+ * @endcode
+ *
+ * An example of how to use the interface is shown below:
+ *
+ * @code
+ * arma::sp_mat data; // Large sparse rating matrix.
+ *
+ * const size_t rank = 200; // Rank used for the decomposition.
+ *
+ * // Make a BlockedRandomizedSVD object with 20 extra sketch columns and two
+ * // subspace iterations.
+ * BlockedRandomizedSVD bSVD(20, 2);
+ *
+ * arma::mat u, v;
+ * arma::vec s;
+ *
+ * // Use the Apply() method to get a factorization.
+ * bSVD.Apply(data, u, s, v, rank);
+ * @endcode
+ *
+ * @see RandomizedSVD
+ */
+class BlockedRandomizedSVD
+{
+ public:
+  /**
+   * Create object for the blocked randomized SVD method.
+   *
+   * @param oversampling Number of sketch columns beyond the requested rank;
+   *        more oversampling gives a more accurate subspace at the cost of
+   *        larger panels (Default: 10).
+   * @param maxIterations Number of subspace iterations; each iteration is two
+   *        additional passes over the data (Default: 2).
+   * @param blockSize Number of sketch columns per panel block; 0 means a
+   *        default panel width is used (Default: 0).
+   * @param eps The eps coefficient to avoid division by zero (numerical
+   *        stability).
+   */
+  BlockedRandomizedSVD(const size_t oversampling = 10,
+                       const size_t maxIterations = 2,
+                       const size_t blockSize = 0,
+                       const double eps = 1e-7) :
+      oversampling(oversampling),
+      maxIterations(maxIterations),
+      blockSize(blockSize),
+      eps(eps)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Center the data to apply Principal Component Analysis on given sparse
+   * matrix dataset using the blocked randomized SVD.
+   *
+   * @param data Sparse data matrix.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param rank Rank of the approximation.
+   */
+  void Apply(const arma::sp_mat& data,
+             arma::mat& u,
+             arma::vec& s,
+             arma::mat& v,
+             const size_t rank)
+  {
+    // Center the data into a temporary matrix for sparse matrix.
+    arma::sp_mat rowMean = arma::sum(data, 1) / data.n_cols;
+
+    Apply(data, u, s, v, rank, rowMean);
+  }
+
+  /**
+   * Center the data to apply Principal Component Analysis on given matrix
+   * dataset using the blocked randomized SVD.
+   *
+   * @param data Data matrix.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param rank Rank of the approximation.
+   */
+  void Apply(const arma::mat& data,
+             arma::mat& u,
+             arma::vec& s,
+             arma::mat& v,
+             const size_t rank)
+  {
+    // Center the data into a temporary matrix.
+    arma::mat rowMean = arma::sum(data, 1) / data.n_cols + eps;
+
+    Apply(data, u, s, v, rank, rowMean);
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided matrix data set
+   * using the blocked randomized SVD.
+   *
+   * @param data Data matrix.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param rank Rank of the approximation.
+   * @param rowMean Centered mean value matrix.
+   */
+  template<typename MatType>
+  void Apply(const MatType& data,
+             arma::mat& u,
+             arma::vec& s,
+             arma::mat& v,
+             const size_t rank,
+             const MatType& rowMean)
+  {
+    // The mean correction below is a rank-one update, so the mean is kept
+    // dense regardless of the input type.
+    const arma::mat mean(rowMean);
+
+    // The sketch cannot be wider than the matrix itself.
+    const size_t sketchSize = std::min(rank + oversampling,
+        std::min(data.n_rows, data.n_cols));
+
+    // Sketch the column space: Q = (A - mean * 1^T) * omega.
+    arma::mat omega = arma::randn<arma::mat>(data.n_cols, sketchSize);
+    arma::mat Q, R, Z;
+    Multiply(data, omega, Q);
+    Q -= mean * (arma::ones(1, data.n_cols) * omega);
+    arma::qr_econ(Q, R, Q);
+
+    // Subspace iteration over the sketched basis; each half-sweep is computed
+    // in panel blocks and re-orthonormalized.
+    for (size_t i = 0; i < maxIterations; ++i)
+    {
+      MultiplyTranspose(data, Q, Z);
+      Z -= arma::ones(data.n_cols, 1) * (mean.t() * Q);
+      arma::qr_econ(Z, R, Z);
+
+      Multiply(data, Z, Q);
+      Q -= mean * (arma::ones(1, data.n_cols) * Z);
+      arma::qr_econ(Q, R, Q);
+    }
+
+    // Project the centered data onto the basis and decompose the small
+    // projected matrix: B = Q^T * (A - mean * 1^T).
+    MultiplyTranspose(data, Q, Z);
+    arma::mat B = Z.t();
+    B -= (Q.t() * mean) * arma::ones(1, data.n_cols);
+
+    arma::mat uB;
+    arma::svd_econ(uB, s, v, B);
+    u = Q * uB;
+
+    // Truncate the oversampled decomposition to the requested rank.
+    if (rank < s.n_elem)
+    {
+      u = u.cols(0, rank - 1);
+      s = s.subvec(0, rank - 1);
+      v = v.cols(0, rank - 1);
+    }
+  }
+
+  //! Get the number of extra sketch columns.
+  size_t Oversampling() const { return oversampling; }
+  //! Modify the number of extra sketch columns.
+  size_t& Oversampling() { return oversampling; }
+
+  //! Get the number of subspace iterations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the number of subspace iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of sketch columns per panel block.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of sketch columns per panel block.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get the value used for decomposition stability.
+  double Epsilon() const { return eps; }
+  //! Modify the value used for decomposition stability.
+  double& Epsilon() { return eps; }
+
+ private:
+  /**
+   * Compute out = data * other over column panels of other, with the
+   * independent panels distributed across the OpenMP team.
+   *
+   * @param data Dense data matrix.
+   * @param other Dense matrix with few (sketch-sized) columns.
+   * @param out Resulting product.
+   */
+  void Multiply(const arma::mat& data,
+                const arma::mat& other,
+                arma::mat& out)
+  {
+    const size_t block = (blockSize == 0) ? (size_t) defaultBlockSize : blockSize;
+    const size_t blocks = (other.n_cols + block - 1) / block;
+    out.set_size(data.n_rows, other.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+    {
+      const size_t first = b * block;
+      const size_t last = std::min(first + block,
+          (size_t) other.n_cols) - 1;
+      out.cols(first, last) = data * other.cols(first, last);
+    }
+  }
+
+  /**
+   * Compute out = data * other for a sparse data matrix; the output columns
+   * are independent, so they are distributed across the OpenMP team and each
+   * is accumulated from the CSC arrays directly.
+   *
+   * @param data Sparse data matrix.
+   * @param other Dense matrix with few (sketch-sized) columns.
+   * @param out Resulting product.
+   */
+  void Multiply(const arma::sp_mat& data,
+                const arma::mat& other,
+                arma::mat& out)
+  {
+    out.zeros(data.n_rows, other.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t j = 0; j < (omp_size_t) other.n_cols; ++j)
+    {
+      for (arma::uword c = 0; c < data.n_cols; ++c)
+      {
+        const double scale = other(c, j);
+        if (scale == 0)
+          continue;
+
+        for (arma::uword pos = data.col_ptrs[c];
+             pos < data.col_ptrs[c + 1]; ++pos)
+        {
+          out(data.row_indices[pos], j) += data.values[pos] * scale;
+        }
+      }
+    }
+  }
+
+  /**
+   * Compute out = data^T * other over column panels of other, with the
+   * independent panels distributed across the OpenMP team.
+   *
+   * @param data Dense data matrix.
+   * @param other Dense matrix with few (sketch-sized) columns.
+   * @param out Resulting product.
+   */
+  void MultiplyTranspose(const arma::mat& data,
+                         const arma::mat& other,
+                         arma::mat& out)
+  {
+    const size_t block = (blockSize == 0) ? (size_t) defaultBlockSize : blockSize;
+    const size_t blocks = (other.n_cols + block - 1) / block;
+    out.set_size(data.n_cols, other.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+    {
+      const size_t first = b * block;
+      const size_t last = std::min(first + block,
+          (size_t) other.n_cols) - 1;
+      out.cols(first, last) = data.t() * other.cols(first, last);
+    }
+  }
+
+  /**
+   * Compute out = data^T * other for a sparse data matrix; each output row
+   * depends on one column of the sparse matrix only, so the rows are
+   * distributed across the OpenMP team and read from the CSC arrays directly.
+   *
+   * @param data Sparse data matrix.
+   * @param other Dense matrix with few (sketch-sized) columns.
+   * @param out Resulting product.
+   */
+  void MultiplyTranspose(const arma::sp_mat& data,
+                         const arma::mat& other,
+                         arma::mat& out)
+  {
+    out.zeros(data.n_cols, other.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t c = 0; c < (omp_size_t) data.n_cols; ++c)
+    {
+      for (arma::uword pos = data.col_ptrs[c];
+           pos < data.col_ptrs[c + 1]; ++pos)
+      {
+        const arma::uword row = data.row_indices[pos];
+        const double value = data.values[pos];
+        for (arma::uword j = 0; j < other.n_cols; ++j)
+          out(c, j) += value * other(row, j);
+      }
+    }
+  }
+
+  //! Panel width used when no block size is given.
+  enum { defaultBlockSize = 32 };
+
+  //! Locally stored number of extra sketch columns.
+  size_t oversampling;
+
+  //! Locally stored number of subspace iterations.
+  size_t maxIterations;
+
+  //! Locally stored number of sketch columns per panel block.
+  size_t blockSize;
+
+  //! The value used for numerical stability.
+  double eps;
+};
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file methods/range_search/grid_range_search.hpp
+ * @author Ryan Curtin
+ *
+ * A uniform-grid range search engine for low-dimensional data.  Instead of
+ * building a tree, the reference points are bucketed into a grid whose cell
+ * width matches the search radius, so that an epsilon-neighborhood query only
+ * has to scan the 3^d cells surrounding the query point (9 cells in two
+ * dimensions, 27 in three).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/math/range.hpp>
+
+#include <unordered_map>
+
+namespace mlpack {
+namespace range {
+
+/**
+ * The GridRangeSearch class performs epsilon-neighborhood queries with a
+ * uniform grid.  Because the cell width must match the search radius, the
+ * grid is built lazily on the first call to Search() and rebuilt whenever the
+ * radius changes; Train() only stores the reference set.
+ *
+ * The class implements the subset of the RangeSearch interface that DBSCAN
+ * uses, so it can be plugged in as the RangeSearchType policy:
+ *
+ * @code
+ * DBSCAN<range::GridRangeSearch<>> dbscan(epsilon, minPoints);
+ * @endcode
+ *
+ * This engine is intended for low-dimensional data (roughly two to four
+ * dimensions): the number of cells scanned per query grows as 3^d, so for
+ * higher-dimensional data a tree-based RangeSearch will be faster.
+ *
+ * @tparam MetricType The metric to use for distance computations.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat>
+class GridRangeSearch
+{
+ public:
+  /**
+   * Construct the GridRangeSearch object with an optional instantiated
+   * metric.
+   *
+   * @param metric Instantiated metric.
+   */
+  GridRangeSearch(const MetricType metric = MetricType());
+
+  /**
+   * Set the reference set to be searched.  The grid itself is built at search
+   * time, when the search radius is known.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, storing the indices and distances of the results in the given
+   * output vectors.
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances for which points are considered
+   *      neighbors; the upper bound of the range is used as the grid cell
+   *      width.
+   * @param neighbors Vector of vectors to store the neighbor indices in.
+   * @param distances Vector of vectors to store the neighbor distances in.
+   */
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
+ private:
+  /**
+   * Bucket the reference points into a grid with the given cell width.
+   */
+  void BuildGrid(const double cellWidth);
+
+  /**
+   * Compute the linearized key of the cell with the given integer
+   * coordinates.  Returns false if the coordinates fall outside of the grid,
+   * in which case the cell is empty.
+   */
+  bool CellKey(const std::vector<long long>& coords, size_t& key) const;
+
+  //! The reference set.
+  MatType referenceSet;
+
+  //! The instantiated metric.
+  MetricType metric;
+
+  //! The cell width the current grid was built with (0 if no grid is built).
+  double builtWidth;
+
+  //! The minimum corner of the grid.
+  arma::vec gridMin;
+
+  //! The number of cells in each dimension.
+  std::vector<size_t> cellCounts;
+
+  //! Maps a linearized cell key to the indices of the points in the cell.
+  std::unordered_map<size_t, std::vector<size_t>> cells;
+};
+
+} // namespace range
+} // namespace mlpack
+
+// Include implementation.
+#include "grid_range_search_impl.hpp"
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * @file methods/range_search/grid_range_search_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the uniform-grid range search engine.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "grid_range_search.hpp"
+
+namespace mlpack {
+namespace range {
+
+template<typename MetricType, typename MatType>
+GridRangeSearch<MetricType, MatType>::GridRangeSearch(const MetricType metric) :
+    metric(metric),
+    builtWidth(0.0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::Train(MatType referenceSet)
+{
+  this->referenceSet = std::move(referenceSet);
+  // Invalidate any existing grid.
+  builtWidth = 0.0;
+  cells.clear();
+
+  if (this->referenceSet.n_rows > 4)
+  {
+    Log::Warn << "GridRangeSearch::Train(): data has "
+        << this->referenceSet.n_rows << " dimensions; each query will scan "
+        << "3^" << this->referenceSet.n_rows << " grid cells, so a tree-based "
+        << "RangeSearch is likely to be faster." << std::endl;
+  }
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::BuildGrid(const double cellWidth)
+{
+  cells.clear();
+  builtWidth = cellWidth;
+
+  gridMin = arma::min(referenceSet, 1);
+  const arma::vec gridMax = arma::max(referenceSet, 1);
+
+  cellCounts.resize(referenceSet.n_rows);
+  for (size_t d = 0; d < referenceSet.n_rows; ++d)
+    cellCounts[d] = (size_t) ((gridMax[d] - gridMin[d]) / cellWidth) + 1;
+
+  // Bucket every reference point.  The linearized keys may wrap around for
+  // extremely fine grids; that only merges the points of two distant cells
+  // into one bucket, and the distance check at search time filters them out.
+  std::vector<long long> coords(referenceSet.n_rows);
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    for (size_t d = 0; d < referenceSet.n_rows; ++d)
+      coords[d] = (long long) ((referenceSet(d, i) - gridMin[d]) / cellWidth);
+
+    size_t key;
+    CellKey(coords, key); // Reference points always fall inside the grid.
+    cells[key].push_back(i);
+  }
+}
+
+template<typename MetricType, typename MatType>
+bool GridRangeSearch<MetricType, MatType>::CellKey(
+    const std::vector<long long>& coords,
+    size_t& key) const
+{
+  key = 0;
+  for (size_t d = 0; d < cellCounts.size(); ++d)
+  {
+    if (coords[d] < 0 || coords[d] >= (long long) cellCounts[d])
+      return false;
+
+    key = key * cellCounts[d] + (size_t) coords[d];
+  }
+
+  return true;
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  if (referenceSet.n_cols == 0 || querySet.n_cols == 0)
+    return;
+
+  if (range.Hi() <= 0.0)
+    throw std::invalid_argument("GridRangeSearch::Search(): the upper bound "
+        "of the search range must be positive, since it is used as the grid "
+        "cell width");
+
+  // (Re)build the grid if the radius changed since the last search.
+  if (builtWidth != range.Hi())
+    BuildGrid(range.Hi());
+
+  const size_t dims = referenceSet.n_rows;
+
+  // Query points are independent, so search them in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
+  {
+    // Compute the cell coordinates of the query point; these may fall outside
+    // of the grid for bichromatic searches.
+    std::vector<long long> base(dims), coords(dims);
+    for (size_t d = 0; d < dims; ++d)
+      base[d] = (long long) std::floor((querySet(d, q) - gridMin[d]) /
+          builtWidth);
+
+    // Enumerate all 3^d cells adjacent to the query's cell with an odometer
+    // over the per-dimension offsets {-1, 0, 1}.
+    std::vector<long long> offset(dims, -1);
+    while (true)
+    {
+      for (size_t d = 0; d < dims; ++d)
+        coords[d] = base[d] + offset[d];
+
+      size_t key;
+      if (CellKey(coords, key))
+      {
+        const typename std::unordered_map<size_t,
+            std::vector<size_t>>::const_iterator it = cells.find(key);
+        if (it != cells.end())
+        {
+          for (size_t j = 0; j < it->second.size(); ++j)
+          {
+            const size_t index = it->second[j];
+            const double distance = metric.Evaluate(querySet.col(q),
+                referenceSet.col(index));
+            if (range.Contains(distance))
+            {
+              neighbors[q].push_back(index);
+              distances[q].push_back(distance);
+            }
+          }
+        }
+      }
+
+      // Advance the odometer.
+      size_t d = 0;
+      while (d < dims && ++offset[d] > 1)
+      {
+        offset[d] = -1;
+        ++d;
+      }
+      if (d == dims)
+        break;
+    }
+  }
+}
+
+} // namespace range
+} // namespace mlpack
+
+#endif
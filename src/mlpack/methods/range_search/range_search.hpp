@@ -17,6 +17,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include "range_search_stat.hpp"
+#include "range_search_sink.hpp"
 
 namespace mlpack {
 namespace range /** Range-search routines. */ {
@@ -268,6 +269,49 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, streaming each result to the given sink instead of collecting
+   * the results in a vector-of-vectors.  The sink must implement
+   *
+   * @code
+   * void Insert(const size_t queryIndex,
+   *             const size_t referenceIndex,
+   *             const double distance);
+   * void Finish();
+   * @endcode
+   *
+   * (see range_search_sink.hpp for ready-made sinks).  Each result is a
+   * (query index, reference index, distance) triple; results arrive in no
+   * particular order, and indices refer to the original (unrearranged)
+   * datasets.  sink.Finish() is called before this method returns, so the
+   * memory used by the search is controlled entirely by the sink---with
+   * BlockRangeResultSink and a callback that spills blocks to disk, queries
+   * with arbitrarily many results run in bounded memory.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param sink Sink to deliver results to.
+   */
+  template<typename SinkType>
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              SinkType& sink);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set (which was passed to the constructor), streaming each result to the
+   * given sink.  This means that the query set and the reference set are the
+   * same; a query point is not returned in its own results.  See the other
+   * streaming Search() overload for the sink interface and the result
+   * semantics.
+   *
+   * @param range Range of distances in which to search.
+   * @param sink Sink to deliver results to.
+   */
+  template<typename SinkType>
+  void Search(const math::Range& range, SinkType& sink);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -635,6 +635,158 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename SinkType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    SinkType& sink)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Search()", "query set");
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+  {
+    sink.Finish();
+    return;
+  }
+
+  // Indices are mapped back to the original datasets as results are delivered
+  // to the sink, so no temporary result storage is needed.
+  const std::vector<size_t>* referenceMap =
+      (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  // Create the helper object for the traversal.
+  typedef RangeSearchStreamingRules<MetricType, Tree, SinkType> RuleType;
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  if (naive)
+  {
+    RuleType rules(*referenceSet, querySet, range, sink, metric, false, NULL,
+        referenceMap);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases += (querySet.n_cols * referenceSet->n_cols);
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    RuleType rules(*referenceSet, querySet, range, sink, metric, false, NULL,
+        referenceMap);
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree; its mapping is applied as results are delivered.
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    const std::vector<size_t>* queryMap =
+        tree::TreeTraits<Tree>::RearrangesDataset ? &oldFromNewQueries : NULL;
+
+    // Create the traverser.
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, sink, metric,
+        false, queryMap, referenceMap);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+
+  // Flush any buffered results.
+  sink.Finish();
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename SinkType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    SinkType& sink)
+{
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+  {
+    sink.Finish();
+    return;
+  }
+
+  // Here, we will use the reference set as the query set, so both index
+  // mappings are the reference mapping.
+  const std::vector<size_t>* referenceMap =
+      (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  // Create the helper object for the traversal.
+  typedef RangeSearchStreamingRules<MetricType, Tree, SinkType> RuleType;
+  RuleType rules(*referenceSet, *referenceSet, range, sink, metric,
+      true /* don't return the query in the results */, referenceMap,
+      referenceMap);
+
+  if (naive)
+  {
+    // The naive brute-force solution.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
+    scores = 0;
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Create the traverser.
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+
+  // Flush any buffered results.
+  sink.Finish();
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
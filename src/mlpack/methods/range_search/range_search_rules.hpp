@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace range {
@@ -23,8 +24,12 @@ namespace range {
  *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam StatsType Traversal instrumentation type; the default compiles to
+ *      nothing, while tree::TraversalStatistics records prune counters.
  */
-template<typename MetricType, typename TreeType>
+template<typename MetricType,
+         typename TreeType,
+         typename StatsType = tree::NullTraversalStatistics>
 class RangeSearchRules
 {
  public:
@@ -121,6 +126,11 @@ class RangeSearchRules
   //! results.
   size_t MinimumBaseCases() const { return 0; }
 
+  //! Get the traversal instrumentation counters.
+  const StatsType& TraversalStats() const { return travStats; }
+  //! Modify the traversal instrumentation counters.
+  StatsType& TraversalStats() { return travStats; }
+
  private:
   //! The reference set.
   const arma::mat& referenceSet;
@@ -156,12 +166,183 @@ class RangeSearchRules
 
   TraversalInfoType traversalInfo;
 
+  //! Traversal instrumentation counters (empty unless opted into).
+  mutable StatsType travStats;
+
   //! The number of base cases.
   size_t baseCases;
   //! THe number of scores.
   size_t scores;
 };
 
+/**
+ * The RangeSearchStreamingRules class implements the same pruning logic as
+ * RangeSearchRules, but instead of collecting results in a vector-of-vectors,
+ * it delivers each result to a sink object as it is found.  The sink must
+ * implement
+ *
+ * @code
+ * void Insert(const size_t queryIndex,
+ *             const size_t referenceIndex,
+ *             const double distance);
+ * @endcode
+ *
+ * (see range_search_sink.hpp for implementations), so the memory used by the
+ * search is controlled by the sink rather than growing with the number of
+ * results.  Because tree building may rearrange the datasets, the rules can
+ * optionally be given old-from-new index mappings for the query and reference
+ * sets; indices are translated before they reach the sink, so no results need
+ * to be buffered for remapping.
+ *
+ * @tparam MetricType The metric to use for computation.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam SinkType The type of the result sink.
+ */
+template<typename MetricType, typename TreeType, typename SinkType>
+class RangeSearchStreamingRules
+{
+ public:
+  /**
+   * Construct the RangeSearchStreamingRules object.  This is usually done from
+   * within the RangeSearch class at search time.
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param sink Sink to deliver results to.
+   * @param metric Instantiated metric.
+   * @param sameSet If true, the query and reference set are taken to be the
+   *      same, and a query point will not return itself in the results.
+   * @param queryMap If non-NULL, mapping applied to query indices before they
+   *      are delivered to the sink.
+   * @param referenceMap If non-NULL, mapping applied to reference indices
+   *      before they are delivered to the sink.
+   */
+  RangeSearchStreamingRules(const arma::mat& referenceSet,
+                            const arma::mat& querySet,
+                            const math::Range& range,
+                            SinkType& sink,
+                            MetricType& metric,
+                            const bool sameSet = false,
+                            const std::vector<size_t>* queryMap = NULL,
+                            const std::vector<size_t>* referenceMap = NULL);
+
+  /**
+   * Compute the base case between the given query point and reference point.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceIndex Index of reference point.
+   */
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  /**
+   * Get the score for recursion order.  A low score indicates priority for
+   * recursion, while DBL_MAX indicates that the node should not be recursed
+   * into at all (it should be pruned).
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   */
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  /**
+   * Re-evaluate the score for recursion order.  A low score indicates priority
+   * for recursion, while DBL_MAX indicates that the node should not be recursed
+   * into at all (it should be pruned).
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   * @param oldScore Old score produced by Score() (or Rescore()).
+   */
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  /**
+   * Get the score for recursion order.  A low score indicates priority for
+   * recursion, while DBL_MAX indicates that the node should not be recursed
+   * into at all (it should be pruned).
+   *
+   * @param queryNode Candidate query node to recurse into.
+   * @param referenceNode Candidate reference node to recurse into.
+   */
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  /**
+   * Re-evaluate the score for recursion order.  A low score indicates priority
+   * for recursion, while DBL_MAX indicates that the node should not be recursed
+   * into at all (it should be pruned).
+   *
+   * @param queryNode Candidate query node to recurse into.
+   * @param referenceNode Candidate reference node to recurse into.
+   * @param oldScore Old score produced by Score() (or Rescore()).
+   */
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+  //! Get the number of scores (that is, calls to RangeDistance()).
+  size_t Scores() const { return scores; }
+
+  //! Get the minimum number of base cases we need to perform to have acceptable
+  //! results.
+  size_t MinimumBaseCases() const { return 0; }
+
+ private:
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! The range of distances for which we are searching.
+  const math::Range& range;
+
+  //! The sink results are delivered to.
+  SinkType& sink;
+
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! If true, the query and reference set are taken to be the same.
+  bool sameSet;
+
+  //! Mapping applied to query indices before delivery (NULL for identity).
+  const std::vector<size_t>* queryMap;
+  //! Mapping applied to reference indices before delivery (NULL for identity).
+  const std::vector<size_t>* referenceMap;
+
+  //! The last query index.
+  size_t lastQueryIndex;
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
+  //! Deliver a single result to the sink, applying the index mappings.
+  void InsertResult(const size_t queryIndex,
+                    const size_t referenceIndex,
+                    const double distance);
+
+  //! Deliver all the points in the given node to the sink as results for the
+  //! given query point.  If the base case has already been calculated, we make
+  //! sure to not deliver that point twice.
+  void AddResult(const size_t queryIndex,
+                 TreeType& referenceNode);
+
+  TraversalInfoType traversalInfo;
+
+  //! The number of base cases.
+  size_t baseCases;
+  //! The number of scores.
+  size_t scores;
+};
+
 } // namespace range
 } // namespace mlpack
 
@@ -18,8 +18,8 @@
 namespace mlpack {
 namespace range {
 
-template<typename MetricType, typename TreeType>
-RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
+template<typename MetricType, typename TreeType, typename StatsType>
+RangeSearchRules<MetricType, TreeType, StatsType>::RangeSearchRules(
     const arma::mat& referenceSet,
     const arma::mat& querySet,
     const math::Range& range,
@@ -44,9 +44,9 @@ RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
 
 //! The base case.  Evaluate the distance between the two points and add to the
 //! results if necessary.
-template<typename MetricType, typename TreeType>
+template<typename MetricType, typename TreeType, typename StatsType>
 inline force_inline
-double RangeSearchRules<MetricType, TreeType>::BaseCase(
+double RangeSearchRules<MetricType, TreeType, StatsType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -61,6 +61,7 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
       referenceSet.unsafe_col(referenceIndex));
   ++baseCases;
+  travStats.CountBaseCase();
 
   // Update last indices, so we don't accidentally perform a base case twice.
   lastQueryIndex = queryIndex;
@@ -70,14 +71,15 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   {
     neighbors[queryIndex].push_back(referenceIndex);
     distances[queryIndex].push_back(distance);
+    travStats.CountBoundTightening();
   }
 
   return distance;
 }
 
 //! Single-tree scoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
+template<typename MetricType, typename TreeType, typename StatsType>
+double RangeSearchRules<MetricType, TreeType, StatsType>::Score(const size_t queryIndex,
                                                      TreeType& referenceNode)
 {
   // We must get the minimum and maximum distances and store them in this
@@ -117,16 +119,21 @@ double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
     distances = referenceNode.RangeDistance(querySet.unsafe_col(queryIndex));
     ++scores;
   }
+  travStats.CountScore();
 
   // If the ranges do not overlap, prune this node.
   if (!distances.Contains(range))
+  {
+    travStats.CountScorePrune();
     return DBL_MAX;
+  }
 
   // In this case, all of the points in the reference node will be part of the
   // results.
   if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
   {
     AddResult(queryIndex, referenceNode);
+    travStats.CountScorePrune();
     return DBL_MAX; // We don't need to go any deeper.
   }
 
@@ -136,8 +143,8 @@ double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
 }
 
 //! Single-tree rescoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Rescore(
+template<typename MetricType, typename TreeType, typename StatsType>
+double RangeSearchRules<MetricType, TreeType, StatsType>::Rescore(
     const size_t /* queryIndex */,
     TreeType& /* referenceNode */,
     const double oldScore) const
@@ -147,8 +154,8 @@ double RangeSearchRules<MetricType, TreeType>::Rescore(
 }
 
 //! Dual-tree scoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
+template<typename MetricType, typename TreeType, typename StatsType>
+double RangeSearchRules<MetricType, TreeType, StatsType>::Score(TreeType& queryNode,
                                                      TreeType& referenceNode)
 {
   math::Range distances;
@@ -187,10 +194,14 @@ double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
     distances = referenceNode.RangeDistance(queryNode);
     ++scores;
   }
+  travStats.CountScore();
 
   // If the ranges do not overlap, prune this node.
   if (!distances.Contains(range))
+  {
+    travStats.CountScorePrune();
     return DBL_MAX;
+  }
 
   // In this case, all of the points in the reference node will be part of all
   // the results for each point in the query node.
@@ -198,6 +209,7 @@ double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
   {
     for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
       AddResult(queryNode.Descendant(i), referenceNode);
+    travStats.CountScorePrune();
     return DBL_MAX; // We don't need to go any deeper.
   }
 
@@ -209,8 +221,8 @@ double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
 }
 
 //! Dual-tree rescoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Rescore(
+template<typename MetricType, typename TreeType, typename StatsType>
+double RangeSearchRules<MetricType, TreeType, StatsType>::Rescore(
     TreeType& /* queryNode */,
     TreeType& /* referenceNode */,
     const double oldScore) const
@@ -221,8 +233,8 @@ double RangeSearchRules<MetricType, TreeType>::Rescore(
 
 //! Add all the points in the given node to the results for the given query
 //! point.
-template<typename MetricType, typename TreeType>
-void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
+template<typename MetricType, typename TreeType, typename StatsType>
+void RangeSearchRules<MetricType, TreeType, StatsType>::AddResult(const size_t queryIndex,
                                                        TreeType& referenceNode)
 {
   // Some types of trees calculate the base case evaluation before Score() is
@@ -259,6 +271,254 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
   }
 }
 
+template<typename MetricType, typename TreeType, typename SinkType>
+RangeSearchStreamingRules<MetricType, TreeType, SinkType>::
+RangeSearchStreamingRules(
+    const arma::mat& referenceSet,
+    const arma::mat& querySet,
+    const math::Range& range,
+    SinkType& sink,
+    MetricType& metric,
+    const bool sameSet,
+    const std::vector<size_t>* queryMap,
+    const std::vector<size_t>* referenceMap) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    range(range),
+    sink(sink),
+    metric(metric),
+    sameSet(sameSet),
+    queryMap(queryMap),
+    referenceMap(referenceMap),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+//! Deliver a single result to the sink, applying the index mappings.
+template<typename MetricType, typename TreeType, typename SinkType>
+inline force_inline
+void RangeSearchStreamingRules<MetricType, TreeType, SinkType>::InsertResult(
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double distance)
+{
+  sink.Insert((queryMap != NULL) ? (*queryMap)[queryIndex] : queryIndex,
+      (referenceMap != NULL) ? (*referenceMap)[referenceIndex] :
+          referenceIndex,
+      distance);
+}
+
+//! The base case.  Evaluate the distance between the two points and deliver to
+//! the sink if necessary.
+template<typename MetricType, typename TreeType, typename SinkType>
+inline force_inline
+double RangeSearchStreamingRules<MetricType, TreeType, SinkType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // If the datasets are the same, don't return the point as in its own range.
+  if (sameSet && (queryIndex == referenceIndex))
+    return 0.0;
+
+  // If we have just performed this base case, don't do it again.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0; // No value to return... this shouldn't do anything bad.
+
+  const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
+      referenceSet.unsafe_col(referenceIndex));
+  ++baseCases;
+
+  // Update last indices, so we don't accidentally perform a base case twice.
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+
+  if (range.Contains(distance))
+    InsertResult(queryIndex, referenceIndex, distance);
+
+  return distance;
+}
+
+//! Single-tree scoring function.
+template<typename MetricType, typename TreeType, typename SinkType>
+double RangeSearchStreamingRules<MetricType, TreeType, SinkType>::Score(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  // We must get the minimum and maximum distances and store them in this
+  // object.
+  math::Range distances;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
+  {
+    // In this situation, we calculate the base case.  So we should check to be
+    // sure we haven't already done that.
+    double baseCase;
+    if (tree::TreeTraits<TreeType>::HasSelfChildren &&
+        (referenceNode.Parent() != NULL) &&
+        (referenceNode.Point(0) == referenceNode.Parent()->Point(0)))
+    {
+      // If the tree has self-children and this is a self-child, the base case
+      // was already calculated.
+      baseCase = referenceNode.Parent()->Stat().LastDistance();
+      lastQueryIndex = queryIndex;
+      lastReferenceIndex = referenceNode.Point(0);
+    }
+    else
+    {
+      // We must calculate the base case by hand.
+      baseCase = BaseCase(queryIndex, referenceNode.Point(0));
+    }
+
+    // This may be possibly loose for non-ball bound trees.
+    distances.Lo() = baseCase - referenceNode.FurthestDescendantDistance();
+    distances.Hi() = baseCase + referenceNode.FurthestDescendantDistance();
+
+    // Update last distance calculation.
+    referenceNode.Stat().LastDistance() = baseCase;
+  }
+  else
+  {
+    distances = referenceNode.RangeDistance(querySet.unsafe_col(queryIndex));
+    ++scores;
+  }
+
+  // If the ranges do not overlap, prune this node.
+  if (!distances.Contains(range))
+    return DBL_MAX;
+
+  // In this case, all of the points in the reference node will be part of the
+  // results.
+  if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
+  {
+    AddResult(queryIndex, referenceNode);
+    return DBL_MAX; // We don't need to go any deeper.
+  }
+
+  // Otherwise the score doesn't matter.  Recursion order is irrelevant in
+  // range search.
+  return 0.0;
+}
+
+//! Single-tree rescoring function.
+template<typename MetricType, typename TreeType, typename SinkType>
+double RangeSearchStreamingRules<MetricType, TreeType, SinkType>::Rescore(
+    const size_t /* queryIndex */,
+    TreeType& /* referenceNode */,
+    const double oldScore) const
+{
+  // If it wasn't pruned before, it isn't pruned now.
+  return oldScore;
+}
+
+//! Dual-tree scoring function.
+template<typename MetricType, typename TreeType, typename SinkType>
+double RangeSearchStreamingRules<MetricType, TreeType, SinkType>::Score(
+    TreeType& queryNode,
+    TreeType& referenceNode)
+{
+  math::Range distances;
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
+  {
+    // It is possible that the base case has already been calculated.
+    double baseCase = 0.0;
+    if ((traversalInfo.LastQueryNode() != NULL) &&
+        (traversalInfo.LastReferenceNode() != NULL) &&
+        (traversalInfo.LastQueryNode()->Point(0) == queryNode.Point(0)) &&
+        (traversalInfo.LastReferenceNode()->Point(0) == referenceNode.Point(0)))
+    {
+      baseCase = traversalInfo.LastBaseCase();
+
+      // Make sure that if BaseCase() is called, we don't duplicate results.
+      lastQueryIndex = queryNode.Point(0);
+      lastReferenceIndex = referenceNode.Point(0);
+    }
+    else
+    {
+      // We must calculate the base case.
+      baseCase = BaseCase(queryNode.Point(0), referenceNode.Point(0));
+    }
+
+    distances.Lo() = baseCase - queryNode.FurthestDescendantDistance()
+        - referenceNode.FurthestDescendantDistance();
+    distances.Hi() = baseCase + queryNode.FurthestDescendantDistance()
+        + referenceNode.FurthestDescendantDistance();
+
+    // Update the last distances performed for the query and reference node.
+    traversalInfo.LastBaseCase() = baseCase;
+  }
+  else
+  {
+    // Just perform the calculation.
+    distances = referenceNode.RangeDistance(queryNode);
+    ++scores;
+  }
+
+  // If the ranges do not overlap, prune this node.
+  if (!distances.Contains(range))
+    return DBL_MAX;
+
+  // In this case, all of the points in the reference node will be part of all
+  // the results for each point in the query node.
+  if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
+  {
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+      AddResult(queryNode.Descendant(i), referenceNode);
+    return DBL_MAX; // We don't need to go any deeper.
+  }
+
+  // Otherwise the score doesn't matter.  Recursion order is irrelevant in range
+  // search.
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  return 0.0;
+}
+
+//! Dual-tree rescoring function.
+template<typename MetricType, typename TreeType, typename SinkType>
+double RangeSearchStreamingRules<MetricType, TreeType, SinkType>::Rescore(
+    TreeType& /* queryNode */,
+    TreeType& /* referenceNode */,
+    const double oldScore) const
+{
+  // If it wasn't pruned before, it isn't pruned now.
+  return oldScore;
+}
+
+//! Deliver all the points in the given node to the sink as results for the
+//! given query point.
+template<typename MetricType, typename TreeType, typename SinkType>
+void RangeSearchStreamingRules<MetricType, TreeType, SinkType>::AddResult(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  // Some types of trees calculate the base case evaluation before Score() is
+  // called, so if the base case has already been calculated, then we must avoid
+  // adding that point to the results again.
+  size_t baseCaseMod = 0;
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      (queryIndex == lastQueryIndex) &&
+      (referenceNode.Point(0) == lastReferenceIndex))
+  {
+    baseCaseMod = 1;
+  }
+
+  for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
+  {
+    if ((&referenceSet == &querySet) &&
+        (queryIndex == referenceNode.Descendant(i)))
+      continue;
+
+    const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
+        referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
+
+    InsertResult(queryIndex, referenceNode.Descendant(i), distance);
+  }
+}
+
 } // namespace range
 } // namespace mlpack
 
@@ -0,0 +1,252 @@
+/**
+ * @file methods/range_search/range_search_sink.hpp
+ *
+ * Result sinks for streaming range search.  Instead of collecting results in
+ * a vector-of-vectors (one heap allocation per query point, and unbounded
+ * memory when the search radius is large), these sinks receive each result as
+ * it is found and store it in flat preallocated arrays: BlockRangeResultSink
+ * hands fixed-size blocks to a user callback (which may write them to disk),
+ * and CSRRangeResultSink assembles a compressed sparse row layout in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_SINK_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_SINK_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace range {
+
+/**
+ * A result sink that buffers range search results in a fixed-capacity block
+ * of flat arrays and hands each full block to a user-supplied callback.  The
+ * memory used by the search is bounded by the block size no matter how many
+ * results the query produces, so arbitrarily dense range queries can be
+ * answered in constant memory---the callback may stream each block to disk,
+ * aggregate it, or discard it.
+ *
+ * The callback is invoked as
+ *
+ * @code
+ * flush(queryIndices, referenceIndices, distances, count);
+ * @endcode
+ *
+ * where the first `count` entries of each array form the block: result i of
+ * the block is the pair (queryIndices[i], referenceIndices[i]) at distance
+ * distances[i].  The arrays are reused between blocks, so the callback must
+ * copy anything it wants to keep.
+ *
+ * After the last Insert(), Finish() must be called to flush the partially
+ * filled final block; the streaming RangeSearch::Search() overloads do this
+ * before returning.
+ *
+ * @tparam FlushFunction Type of the callback to hand full blocks to.
+ */
+template<typename FlushFunction>
+class BlockRangeResultSink
+{
+ public:
+  /**
+   * Construct the sink with the given block capacity and flush callback.
+   *
+   * @param blockSize Number of results to buffer before flushing a block.
+   * @param flush Callback to hand full blocks to.
+   */
+  BlockRangeResultSink(const size_t blockSize, FlushFunction flush) :
+      queryIndices(blockSize),
+      referenceIndices(blockSize),
+      distances(blockSize),
+      count(0),
+      numResults(0),
+      numFlushes(0),
+      flush(flush)
+  {
+    if (blockSize == 0)
+      throw std::invalid_argument("block size must be greater than 0");
+  }
+
+  //! Add a single result to the current block, flushing it if it is full.
+  void Insert(const size_t queryIndex,
+              const size_t referenceIndex,
+              const double distance)
+  {
+    queryIndices[count] = queryIndex;
+    referenceIndices[count] = referenceIndex;
+    distances[count] = distance;
+
+    if (++count == queryIndices.n_elem)
+      FlushBlock();
+  }
+
+  //! Flush the partially filled final block (if any results are buffered).
+  void Finish()
+  {
+    if (count > 0)
+      FlushBlock();
+  }
+
+  //! Get the total number of results inserted so far.
+  size_t NumResults() const { return numResults; }
+  //! Get the number of blocks handed to the callback so far.
+  size_t NumFlushes() const { return numFlushes; }
+
+ private:
+  //! Hand the current block to the callback and reset it.
+  void FlushBlock()
+  {
+    flush(queryIndices, referenceIndices, distances, count);
+    numResults += count;
+    count = 0;
+    ++numFlushes;
+  }
+
+  //! Query indices of the buffered results.
+  arma::uvec queryIndices;
+  //! Reference indices of the buffered results.
+  arma::uvec referenceIndices;
+  //! Distances of the buffered results.
+  arma::vec distances;
+
+  //! Number of valid results in the current block.
+  size_t count;
+  //! Total number of results inserted.
+  size_t numResults;
+  //! Number of blocks flushed.
+  size_t numFlushes;
+
+  //! The callback to hand full blocks to.
+  FlushFunction flush;
+};
+
+/**
+ * Convenience function to construct a BlockRangeResultSink without spelling
+ * out the callback type (useful with lambdas).
+ *
+ * @param blockSize Number of results to buffer before flushing a block.
+ * @param flush Callback to hand full blocks to.
+ */
+template<typename FlushFunction>
+BlockRangeResultSink<FlushFunction> MakeBlockRangeResultSink(
+    const size_t blockSize, FlushFunction flush)
+{
+  return BlockRangeResultSink<FlushFunction>(blockSize, flush);
+}
+
+/**
+ * A result sink that assembles range search results into a compressed sparse
+ * row (CSR) layout: one offsets array of length (number of queries + 1), and
+ * one flat array each for the reference indices and distances.  Results for
+ * query i occupy positions [Offsets()[i], Offsets()[i + 1]) of Neighbors()
+ * and Distances(), in no particular order.
+ *
+ * Unlike the vector-of-vectors interface, this performs no per-query heap
+ * allocations: results are appended to flat arrays that grow geometrically,
+ * and Finish() groups them by query with a counting sort.  Peak memory during
+ * Finish() is about twice the size of the final result arrays.
+ */
+class CSRRangeResultSink
+{
+ public:
+  /**
+   * Construct the sink for the given number of query points.
+   *
+   * @param numQueries Number of query points of the search.
+   * @param initialCapacity Initial capacity of the result arrays.
+   */
+  CSRRangeResultSink(const size_t numQueries,
+                     const size_t initialCapacity = 1024) :
+      numQueries(numQueries),
+      stagedQueries(std::max(initialCapacity, size_t(1))),
+      stagedNeighbors(std::max(initialCapacity, size_t(1))),
+      stagedDistances(std::max(initialCapacity, size_t(1))),
+      numResults(0)
+  { /* Nothing to do. */ }
+
+  //! Append a single result to the staging arrays.
+  void Insert(const size_t queryIndex,
+              const size_t referenceIndex,
+              const double distance)
+  {
+    if (numResults == stagedQueries.n_elem)
+    {
+      // Grow the staging arrays geometrically.
+      stagedQueries.resize(2 * numResults);
+      stagedNeighbors.resize(2 * numResults);
+      stagedDistances.resize(2 * numResults);
+    }
+
+    stagedQueries[numResults] = queryIndex;
+    stagedNeighbors[numResults] = referenceIndex;
+    stagedDistances[numResults] = distance;
+    ++numResults;
+  }
+
+  //! Group the staged results by query point into the CSR arrays.  Called by
+  //! the streaming RangeSearch::Search() overloads before returning.
+  void Finish()
+  {
+    // Count the results of each query point, then turn the counts into
+    // offsets by a prefix sum.
+    offsets.zeros(numQueries + 1);
+    for (size_t i = 0; i < numResults; ++i)
+      ++offsets[stagedQueries[i] + 1];
+    for (size_t i = 1; i <= numQueries; ++i)
+      offsets[i] += offsets[i - 1];
+
+    // Place each staged result at its query's cursor.
+    arma::uvec cursors(offsets.head(numQueries));
+    neighbors.set_size(numResults);
+    distances.set_size(numResults);
+    for (size_t i = 0; i < numResults; ++i)
+    {
+      const size_t position = cursors[stagedQueries[i]]++;
+      neighbors[position] = stagedNeighbors[i];
+      distances[position] = stagedDistances[i];
+    }
+
+    // The staging arrays are no longer needed.
+    stagedQueries.reset();
+    stagedNeighbors.reset();
+    stagedDistances.reset();
+  }
+
+  //! Get the offsets array (valid after Finish()); entry i is the position of
+  //! the first result of query i in Neighbors() and Distances().
+  const arma::uvec& Offsets() const { return offsets; }
+  //! Get the flat array of reference indices (valid after Finish()).
+  const arma::uvec& Neighbors() const { return neighbors; }
+  //! Get the flat array of distances (valid after Finish()).
+  const arma::vec& Distances() const { return distances; }
+
+  //! Get the total number of results inserted.
+  size_t NumResults() const { return numResults; }
+
+ private:
+  //! Number of query points.
+  size_t numQueries;
+
+  //! Staged query indices (first numResults entries are valid).
+  arma::uvec stagedQueries;
+  //! Staged reference indices (first numResults entries are valid).
+  arma::uvec stagedNeighbors;
+  //! Staged distances (first numResults entries are valid).
+  arma::vec stagedDistances;
+  //! Number of results inserted so far.
+  size_t numResults;
+
+  //! CSR offsets (length numQueries + 1; built by Finish()).
+  arma::uvec offsets;
+  //! CSR reference indices (built by Finish()).
+  arma::uvec neighbors;
+  //! CSR distances (built by Finish()).
+  arma::vec distances;
+};
+
+} // namespace range
+} // namespace mlpack
+
+#endif
@@ -262,6 +262,35 @@ class RASearch
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Compute the rank approximate nearest neighbors of each query point in the
+   * query set, sharing sampled reference candidates between nearby query
+   * points.  The query set is grouped by building a coarse query tree (in the
+   * same way dual-tree search does); each leaf of that tree forms one batch of
+   * co-located query points.  A common pool of reference samples is drawn once
+   * and reused by every batch, and each batch only tops the pool up with
+   * enough additional distinct samples to reach the per-query sample count; a
+   * shared stamp array acts as the dedup bitmap that keeps the pool and the
+   * top-up disjoint.  Every query point therefore still evaluates the same
+   * number of distinct, uniformly drawn reference candidates as independent
+   * sampling would use, so the (tau, alpha) rank guarantee is unchanged, but
+   * co-located query points no longer re-draw overlapping candidate sets.
+   *
+   * This is useful when the query set contains many clusters of nearby points
+   * (e.g. cohorts scored together): the closer the queries in a batch, the
+   * larger the fraction of candidate evaluations that is shared.
+   *
+   * @param querySet Set of query points (can be a single point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void SearchBatched(const MatType& querySet,
+                     const size_t k,
+                     arma::Mat<size_t>& neighbors,
+                     arma::mat& distances);
+
   /**
    * Compute the rank approximate nearest neighbors of each point in the
    * pre-built query tree and store the output in the given matrices. The
@@ -422,6 +422,175 @@ Search(const MatType& querySet,
   }
 }
 
+/**
+ * Computes the best neighbors for batches of co-located query points, sharing
+ * sampled reference candidates within (and partially across) batches.
+ */
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RASearch<SortPolicy, MetricType, MatType, TreeType>::
+SearchBatched(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances)
+{
+  if (k > referenceSet->n_cols)
+  {
+    std::stringstream ss;
+    ss << "requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referenceSet->n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // This will hold mappings for query points.
+  std::vector<size_t> oldFromNewQueries;
+
+  // The batch tree rearranges the query points (and if we built the reference
+  // tree ourselves, the reference indices need mapping too), so the results
+  // are stored in temporary matrices and mapped back at the end.
+  arma::Mat<size_t>* neighborPtr = &neighbors;
+  arma::mat* distancePtr = &distances;
+
+  if (tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    distancePtr = new arma::mat;
+    neighborPtr = new arma::Mat<size_t>;
+  }
+
+  neighborPtr->set_size(k, querySet.n_cols);
+  distancePtr->set_size(k, querySet.n_cols);
+
+  // Build a coarse tree on the query set; each leaf groups co-located query
+  // points into one batch.
+  Tree* queryTree = aux::BuildTree<Tree>(const_cast<MatType&>(querySet),
+      oldFromNewQueries);
+
+  // Sampling is done here, not in the rules, so naive is passed as false.
+  typedef RASearchRules<SortPolicy, MetricType, Tree> RuleType;
+  RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, tau, alpha,
+      false, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
+
+  // Every query point must see this many distinct uniformly drawn candidates
+  // for the (tau, alpha) rank guarantee to hold.
+  const size_t numSamples = RAUtil::MinimumSamplesReqd(referenceSet->n_cols,
+      k, tau, alpha);
+
+  // Half of the samples are drawn once and shared by every batch; each batch
+  // tops up the rest itself.  The stamp array acts as the shared dedup
+  // bitmap: it marks which reference points a batch has already drawn, so
+  // that the union of the shared pool and the top-up always consists of
+  // numSamples distinct reference points.
+  const size_t numShared = numSamples / 2;
+  arma::uvec sharedSamples;
+  math::ObtainDistinctSamples(0, referenceSet->n_cols, numShared,
+      sharedSamples);
+
+  arma::Col<size_t> sampleStamp =
+      arma::zeros<arma::Col<size_t> >(referenceSet->n_cols);
+  const size_t sharedMark = std::numeric_limits<size_t>::max();
+  for (size_t j = 0; j < sharedSamples.n_elem; ++j)
+    sampleStamp[sharedSamples[j]] = sharedMark;
+
+  // Walk the query tree and process each leaf as one batch.
+  std::vector<Tree*> nodeStack;
+  nodeStack.push_back(queryTree);
+  std::vector<size_t> batchSamples;
+  batchSamples.reserve(numSamples);
+  size_t batchId = 0;
+  size_t totalDrawn = sharedSamples.n_elem;
+
+  while (!nodeStack.empty())
+  {
+    Tree* node = nodeStack.back();
+    nodeStack.pop_back();
+
+    if (!node->IsLeaf())
+    {
+      for (size_t i = 0; i < node->NumChildren(); ++i)
+        nodeStack.push_back(&node->Child(i));
+      continue;
+    }
+
+    ++batchId;
+
+    // Assemble the candidate set for this batch: the shared pool plus enough
+    // fresh distinct samples to reach numSamples.  Draws that collide with
+    // the pool (or with earlier top-up draws of this batch) are rejected and
+    // redrawn, so the union remains a uniform draw of numSamples distinct
+    // reference points.
+    batchSamples.assign(sharedSamples.begin(), sharedSamples.end());
+    while (batchSamples.size() < numSamples)
+    {
+      const size_t needed = numSamples - batchSamples.size();
+      arma::uvec draw;
+      math::ObtainDistinctSamples(0, referenceSet->n_cols,
+          std::min(needed + numShared, (size_t) referenceSet->n_cols), draw);
+
+      for (size_t j = 0; j < draw.n_elem && batchSamples.size() < numSamples;
+          ++j)
+      {
+        const size_t ref = (size_t) draw[j];
+        if (sampleStamp[ref] == sharedMark || sampleStamp[ref] == batchId)
+          continue;
+
+        sampleStamp[ref] = batchId;
+        batchSamples.push_back(ref);
+        ++totalDrawn;
+      }
+    }
+
+    // Run the base case on every (query point, candidate) pair in the batch.
+    for (size_t i = 0; i < node->NumPoints(); ++i)
+      for (size_t j = 0; j < batchSamples.size(); ++j)
+        rules.BaseCase(node->Point(i), batchSamples[j]);
+  }
+
+  Log::Info << "Batched sampling complete: " << batchId << " batches; "
+      << totalDrawn << " samples drawn instead of "
+      << (numSamples * querySet.n_cols) << " for per-query sampling."
+      << std::endl;
+
+  rules.GetResults(*neighborPtr, *distancePtr);
+
+  delete queryTree;
+
+  // Map points back to original indices, if necessary.
+  if (tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    neighbors.set_size(k, querySet.n_cols);
+    distances.set_size(k, querySet.n_cols);
+
+    for (size_t i = 0; i < distances.n_cols; ++i)
+    {
+      // Map distances (copy a column).
+      const size_t queryMapping = oldFromNewQueries[i];
+      distances.col(queryMapping) = distancePtr->col(i);
+
+      if (treeOwner)
+      {
+        // Map indices of neighbors too.
+        for (size_t j = 0; j < distances.n_rows; ++j)
+        {
+          neighbors(j, queryMapping) =
+              oldFromNewReferences[(*neighborPtr)(j, i)];
+        }
+      }
+      else
+      {
+        neighbors.col(queryMapping) = neighborPtr->col(i);
+      }
+    }
+
+    // Finished with temporary matrices.
+    delete neighborPtr;
+    delete distancePtr;
+  }
+}
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -0,0 +1,135 @@
+/**
+ * @file methods/reinforcement_learning/environment/vectorized_environment.hpp
+ *
+ * This file is the implementation of VectorizedEnvironment class, which steps
+ * several copies of an environment together so the policy network can be
+ * evaluated with one batched forward pass per step.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Interface for stepping a batch of environment copies in lockstep.  Running
+ * a network Predict() on a batch of one observation per step wastes the
+ * network's throughput; this wrapper keeps N independent copies of an
+ * environment, stacks their encoded states into one dimension x N
+ * observation matrix, and steps all of them from a vector of actions, so the
+ * training loop can do a single batched forward pass per step:
+ *
+ * @code
+ * VectorizedEnvironment<CartPole> envs(8);
+ * arma::mat actionValues;
+ * network.Predict(envs.Observations(), actionValues);
+ * // ... select one action per column ...
+ * envs.Step(actions, rewards, terminals);
+ * @endcode
+ *
+ * An environment copy that reaches a terminal state is reset automatically;
+ * the corresponding entry of the terminal vector is set and its column of
+ * the observation matrix holds the new initial state.
+ *
+ * @tparam EnvironmentType The type of reinforcement learning task.
+ */
+template<typename EnvironmentType>
+class VectorizedEnvironment
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  /**
+   * Construct a batch of environment copies.
+   *
+   * @param numEnvs Number of environment copies to step together.
+   * @param environment The environment prototype to copy.
+   */
+  VectorizedEnvironment(const size_t numEnvs,
+                        EnvironmentType environment = EnvironmentType()) :
+      environments(numEnvs, environment),
+      states(numEnvs),
+      observations(StateType::dimension, numEnvs)
+  {
+    Reset();
+  }
+
+  /**
+   * Reset every environment copy to a fresh initial state.
+   */
+  void Reset()
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      states[i] = environments[i].InitialSample();
+      observations.col(i) = states[i].Encode();
+    }
+  }
+
+  /**
+   * Step all environment copies with the given actions.  Copies that reach a
+   * terminal state are reset, so the observation matrix always holds valid
+   * states for the next action selection.
+   *
+   * @param actions One action per environment copy.
+   * @param rewards The reward of each copy for this step.
+   * @param terminals Indicate whether the corresponding copy terminated (and
+   *        was reset) during this step.
+   */
+  void Step(const std::vector<ActionType>& actions,
+            arma::rowvec& rewards,
+            arma::irowvec& terminals)
+  {
+    rewards.set_size(environments.size());
+    terminals.set_size(environments.size());
+
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      StateType nextState;
+      rewards(i) = environments[i].Sample(states[i], actions[i], nextState);
+
+      const bool isEnd = environments[i].IsTerminal(nextState);
+      terminals(i) = isEnd;
+      states[i] = isEnd ? environments[i].InitialSample() : nextState;
+      observations.col(i) = states[i].Encode();
+    }
+  }
+
+  //! Get the stacked encoded states, one column per environment copy.
+  const arma::mat& Observations() const { return observations; }
+
+  //! Get the current state of the i-th environment copy.
+  const StateType& State(const size_t i) const { return states[i]; }
+
+  //! Get the i-th environment copy.
+  EnvironmentType& Environment(const size_t i) { return environments[i]; }
+
+  //! Get the number of environment copies.
+  size_t NumEnvs() const { return environments.size(); }
+
+ private:
+  //! Locally-stored environment copies.
+  std::vector<EnvironmentType> environments;
+
+  //! Locally-stored current state of each copy.
+  std::vector<StateType> states;
+
+  //! Locally-stored stacked encoded states.
+  arma::mat observations;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
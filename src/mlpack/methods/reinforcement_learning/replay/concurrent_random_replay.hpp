@@ -0,0 +1,325 @@
+/**
+ * @file methods/reinforcement_learning/replay/concurrent_random_replay.hpp
+ *
+ * This file is an implementation of random experience replay with lock-free
+ * insertion, for setups where several actor threads feed one replay buffer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_CONCURRENT_RANDOM_REPLAY_HPP
+#define MLPACK_METHODS_RL_REPLAY_CONCURRENT_RANDOM_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+#include <cassert>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of random experience replay with concurrent insertion.
+ *
+ * The buffer exposes the same interface as RandomReplay, so agents like
+ * QLearning and SAC can use it unchanged, but Store() may be called from many
+ * actor threads at once without a mutex: each call claims a ring slot with a
+ * single atomic fetch-and-add and publishes the written transition through a
+ * per-slot sequence counter (a seqlock).  Sample() gathers the requested
+ * batch directly into the contiguous output matrices and retries any column
+ * whose slot was concurrently overwritten, so sampled transitions are always
+ * consistent.
+ *
+ * Two restrictions follow from the design.  With nSteps > 1 the n-step
+ * window is trajectory state, so each actor must own its own window;
+ * multi-threaded insertion into one buffer is supported for nSteps == 1.
+ * Sampling scales with the number of retries, which stays negligible as long
+ * as the capacity is much larger than the write rate between two samples.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @phdthesis{lin1993reinforcement,
+ *  title  = {Reinforcement learning for robots using neural networks},
+ *  author = {Lin, Long-Ji},
+ *  year   = {1993},
+ *  school = {Fujitsu Laboratories Ltd}
+ * }
+ * @endcode
+ *
+ * @tparam EnvironmentType Desired task.
+ */
+template <typename EnvironmentType>
+class ConcurrentRandomReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  struct Transition
+  {
+    StateType state;
+    ActionType action;
+    double reward;
+    StateType nextState;
+    bool isEnd;
+  };
+
+  ConcurrentRandomReplay():
+      batchSize(0),
+      capacity(0),
+      head(0),
+      nSteps(0)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of concurrent random experience replay class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of examples.
+   * @param nSteps Number of steps to look in the future.
+   * @param dimension The dimension of an encoded state.
+   */
+  ConcurrentRandomReplay(const size_t batchSize,
+                         const size_t capacity,
+                         const size_t nSteps = 1,
+                         const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      capacity(capacity),
+      head(0),
+      nSteps(nSteps),
+      states(dimension, capacity),
+      actions(capacity),
+      rewards(capacity),
+      nextStates(dimension, capacity),
+      isTerminal(capacity),
+      slotSequences(new std::atomic<size_t>[capacity])
+  {
+    for (size_t i = 0; i < capacity; ++i)
+      slotSequences[i].store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * Store the given experience.  Safe to call from several threads at once
+   * when nSteps == 1.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(StateType state,
+             ActionType action,
+             double reward,
+             StateType nextState,
+             bool isEnd,
+             const double& discount)
+  {
+    if (nSteps > 1)
+    {
+      // The n-step window is per-trajectory state and therefore only valid
+      // with a single actor thread.
+      nStepBuffer.push_back({state, action, reward, nextState, isEnd});
+
+      // Single step transition is not ready.
+      if (nStepBuffer.size() < nSteps)
+        return;
+
+      // To keep the queue size fixed to nSteps.
+      if (nStepBuffer.size() > nSteps)
+        nStepBuffer.pop_front();
+
+      // Before moving ahead, lets confirm if our fixed size buffer works.
+      assert(nStepBuffer.size() == nSteps);
+
+      // Make a n-step transition.
+      GetNStepInfo(reward, nextState, isEnd, discount);
+
+      state = nStepBuffer.front().state;
+      action = nStepBuffer.front().action;
+    }
+
+    // Claim a ring slot; this is the only point of contention between
+    // writers.
+    const size_t slot =
+        head.fetch_add(1, std::memory_order_relaxed) % capacity;
+
+    // Acquire the slot's seqlock (sequence becomes odd); a concurrent writer
+    // that wrapped around onto the same slot makes us spin until it is done.
+    std::atomic<size_t>& sequence = slotSequences[slot];
+    size_t current = sequence.load(std::memory_order_relaxed);
+    while ((current & 1) || !sequence.compare_exchange_weak(current,
+        current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      current = sequence.load(std::memory_order_relaxed);
+    }
+
+    states.col(slot) = state.Encode();
+    actions[slot] = action;
+    rewards(slot) = reward;
+    nextStates.col(slot) = nextState.Encode();
+    isTerminal(slot) = isEnd;
+
+    // Publish the transition (sequence becomes even again).
+    sequence.store(current + 2, std::memory_order_release);
+  }
+
+  /**
+   * Get the reward, next state and terminal boolean for nth step.
+   *
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void GetNStepInfo(double& reward,
+                    StateType& nextState,
+                    bool& isEnd,
+                    const double& discount)
+  {
+    reward = nStepBuffer.back().reward;
+    nextState = nStepBuffer.back().nextState;
+    isEnd = nStepBuffer.back().isEnd;
+
+    // Should start from the second last transition in buffer.
+    for (int i = nStepBuffer.size() - 2; i >= 0; i--)
+    {
+      bool iE = nStepBuffer[i].isEnd;
+      reward = nStepBuffer[i].reward + discount * reward * (1 - iE);
+      if (iE)
+      {
+        nextState = nStepBuffer[i].nextState;
+        isEnd = iE;
+      }
+    }
+  }
+
+  /**
+   * Sample some experiences.  The batch is gathered with one pass into the
+   * contiguous output matrices; a column whose slot is overwritten while it
+   * is being read is retried.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              std::vector<ActionType>& sampledActions,
+              arma::rowvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::irowvec& isTerminal)
+  {
+    const size_t upperBound = std::min(
+        head.load(std::memory_order_acquire), capacity);
+    arma::uvec sampledIndices = arma::randi<arma::uvec>(
+        batchSize, arma::distr_param(0, upperBound - 1));
+
+    sampledStates.set_size(states.n_rows, batchSize);
+    sampledRewards.set_size(batchSize);
+    sampledNextStates.set_size(nextStates.n_rows, batchSize);
+    isTerminal.set_size(batchSize);
+
+    for (size_t t = 0; t < sampledIndices.n_rows; t++)
+    {
+      const size_t slot = sampledIndices[t];
+      std::atomic<size_t>& sequence = slotSequences[slot];
+      ActionType sampledAction;
+
+      for (;;)
+      {
+        const size_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1)
+          continue; // A writer holds the slot.
+
+        sampledStates.col(t) = states.col(slot);
+        sampledAction = actions[slot];
+        sampledRewards(t) = rewards(slot);
+        sampledNextStates.col(t) = nextStates.col(slot);
+        isTerminal(t) = this->isTerminal(slot);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+          break; // The slot was not overwritten while we read it.
+      }
+
+      sampledActions.push_back(sampledAction);
+    }
+  }
+
+  /**
+   * Get the number of transitions in the memory.
+   *
+   * @return Actual used memory size
+   */
+  size_t Size()
+  {
+    return std::min(head.load(std::memory_order_acquire), capacity);
+  }
+
+  /**
+   * Update the priorities of transitions and Update the gradients.
+   *
+   * @param * (target) The learned value
+   * @param * (sampledActions) Agent's sampled action
+   * @param * (nextActionValues) Agent's next action
+   * @param * (gradients) The model's gradients
+   */
+  void Update(arma::mat /* target */,
+              std::vector<ActionType> /* sampledActions */,
+              arma::mat /* nextActionValues */,
+              arma::mat& /* gradients */)
+  {
+    /* Do nothing for random replay. */
+  }
+
+  //! Get the number of steps for n-step agent.
+  const size_t& NSteps() const { return nSteps; }
+
+ private:
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! Locally-stored total memory limit.
+  size_t capacity;
+
+  //! Number of transitions ever stored; the next slot is head % capacity.
+  std::atomic<size_t> head;
+
+  //! Locally-stored number of steps to look into the future.
+  size_t nSteps;
+
+  //! Locally-stored buffer containing n consecutive steps.
+  std::deque<Transition> nStepBuffer;
+
+  //! Locally-stored encoded previous states.
+  arma::mat states;
+
+  //! Locally-stored previous actions.
+  std::vector<ActionType> actions;
+
+  //! Locally-stored previous rewards.
+  arma::rowvec rewards;
+
+  //! Locally-stored encoded previous next states.
+  arma::mat nextStates;
+
+  //! Locally-stored termination information of previous experience.
+  arma::irowvec isTerminal;
+
+  //! Per-slot sequence counters; odd means a writer holds the slot.
+  std::unique_ptr<std::atomic<size_t>[]> slotSequences;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
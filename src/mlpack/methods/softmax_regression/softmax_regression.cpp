@@ -12,9 +12,35 @@
 
 #include "softmax_regression.hpp"
 
+#include <algorithm>
+
 namespace mlpack {
 namespace regression {
 
+//! Number of columns handled as one unit of parallel work in the batch
+//! Classify() overloads.
+static const size_t classifyBlockSize = 1024;
+
+//! Compute the raw class scores (logits) of the given block of columns.
+static void BlockScores(const arma::mat& parameters,
+                        const bool fitIntercept,
+                        const arma::mat& dataset,
+                        const size_t begin,
+                        const size_t end,
+                        arma::mat& scores)
+{
+  if (fitIntercept)
+  {
+    // Avoid materializing [1; data]: add the intercept column separately.
+    scores = arma::repmat(parameters.col(0), 1, end - begin + 1) +
+        parameters.cols(1, parameters.n_cols - 1) * dataset.cols(begin, end);
+  }
+  else
+  {
+    scores = parameters * dataset.cols(begin, end);
+  }
+}
+
 SoftmaxRegression::
 SoftmaxRegression(const size_t inputSize,
                   const size_t numClasses,
@@ -31,29 +57,88 @@ void SoftmaxRegression::Classify(const arma::mat& dataset,
                                  arma::Row<size_t>& labels)
     const
 {
-  arma::mat probabilities;
-  Classify(dataset, probabilities);
+  util::CheckSameDimensionality(dataset, FeatureSize(),
+      "SoftmaxRegression::Classify()");
 
-  // Prepare necessary data.
-  labels.zeros(dataset.n_cols);
-  double maxProbability = 0;
+  labels.set_size(dataset.n_cols);
 
-  // For each test input.
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // The softmax does not change the order of the class scores, so the label
+  // is the argmax of the raw scores; exponentiation and normalization are
+  // skipped.  The scores are computed one block of columns at a time, with
+  // the blocks handled in parallel.
+  const size_t blocks =
+      (dataset.n_cols + classifyBlockSize - 1) / classifyBlockSize;
+  #pragma omp parallel for default(shared)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
   {
-    // For each class.
-    for (size_t j = 0; j < numClasses; ++j)
+    const size_t begin = b * classifyBlockSize;
+    const size_t end = std::min(begin + classifyBlockSize,
+        (size_t) dataset.n_cols) - 1;
+
+    arma::mat scores;
+    BlockScores(parameters, fitIntercept, dataset, begin, end, scores);
+
+    for (size_t i = begin; i <= end; ++i)
     {
-      // If a higher class probability is encountered, change prediction.
-      if (probabilities(j, i) > maxProbability)
+      arma::uword maxIndex = 0;
+      scores.col(i - begin).max(maxIndex);
+      labels(i) = (size_t) maxIndex;
+    }
+  }
+}
+
+void SoftmaxRegression::Classify(const arma::mat& dataset,
+                                 const size_t k,
+                                 arma::Mat<size_t>& labels,
+                                 arma::mat& scores)
+    const
+{
+  util::CheckSameDimensionality(dataset, FeatureSize(),
+      "SoftmaxRegression::Classify()");
+  if (k == 0 || k > numClasses)
+  {
+    throw std::invalid_argument("SoftmaxRegression::Classify(): k must be "
+        "between 1 and the number of classes!");
+  }
+
+  labels.set_size(k, dataset.n_cols);
+  scores.set_size(k, dataset.n_cols);
+
+  const size_t blocks =
+      (dataset.n_cols + classifyBlockSize - 1) / classifyBlockSize;
+  #pragma omp parallel for default(shared)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+  {
+    const size_t begin = b * classifyBlockSize;
+    const size_t end = std::min(begin + classifyBlockSize,
+        (size_t) dataset.n_cols) - 1;
+
+    arma::mat blockScores;
+    BlockScores(parameters, fitIntercept, dataset, begin, end, blockScores);
+
+    std::vector<size_t> order(numClasses);
+    for (size_t i = begin; i <= end; ++i)
+    {
+      // Select the top k classes on the raw scores.
+      const double* col = blockScores.colptr(i - begin);
+      for (size_t j = 0; j < numClasses; ++j)
+        order[j] = j;
+      std::partial_sort(order.begin(), order.begin() + k, order.end(),
+          [col](const size_t a, const size_t b) { return col[a] > col[b]; });
+
+      // Only the normalizer and the k reported probabilities are
+      // exponentiated; shifting by the largest score keeps this stable.
+      double expSum = 0.0;
+      for (size_t j = 0; j < numClasses; ++j)
+        expSum += std::exp(col[j] - col[order[0]]);
+      const double logSumExp = col[order[0]] + std::log(expSum);
+
+      for (size_t j = 0; j < k; ++j)
       {
-        maxProbability = probabilities(j, i);
-        labels(i) = j;
+        labels(j, i) = order[j];
+        scores(j, i) = std::exp(col[order[j]] - logSumExp);
       }
     }
-
-    // Set maximum probability to zero for the next input.
-    maxProbability = 0;
   }
 }
 
@@ -66,11 +151,14 @@ void SoftmaxRegression::Classify(const arma::mat& dataset,
 
   // Prepare necessary data.
   labels.zeros(dataset.n_cols);
-  double maxProbability = 0;
 
-  // For each test input.
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // For each test input; the columns are independent, so they are handled in
+  // parallel.
+  #pragma omp parallel for default(shared)
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
+    double maxProbability = 0;
+
     // For each class.
     for (size_t j = 0; j < numClasses; ++j)
     {
@@ -81,9 +169,6 @@ void SoftmaxRegression::Classify(const arma::mat& dataset,
         labels(i) = j;
       }
     }
-
-    // Set maximum probability to zero for the next input.
-    maxProbability = 0;
   }
 }
 
@@ -94,27 +179,27 @@ void SoftmaxRegression::Classify(const arma::mat& dataset,
   util::CheckSameDimensionality(dataset, FeatureSize(),
       "SoftmaxRegression::Classify()");
 
-  // Calculate the probabilities for each test input.
-  arma::mat hypothesis;
-  if (fitIntercept)
-  {
-    // In order to add the intercept term, we should compute following matrix:
-    //     [1; data] = arma::join_cols(ones(1, data.n_cols), data)
-    //     hypothesis = arma::exp(parameters * [1; data]).
-    //
-    // Since the cost of join maybe high due to the copy of original data,
-    // split the hypothesis computation to two components.
-    hypothesis = arma::exp(
-      arma::repmat(parameters.col(0), 1, dataset.n_cols) +
-      parameters.cols(1, parameters.n_cols - 1) * dataset);
-  }
-  else
+  probabilities.set_size(numClasses, dataset.n_cols);
+
+  // Calculate the probabilities for each test input, one block of columns at
+  // a time; each thread keeps its own hypothesis workspace and writes into a
+  // disjoint part of the output.
+  const size_t blocks =
+      (dataset.n_cols + classifyBlockSize - 1) / classifyBlockSize;
+  #pragma omp parallel for default(shared)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
   {
-    hypothesis = arma::exp(parameters * dataset);
-  }
+    const size_t begin = b * classifyBlockSize;
+    const size_t end = std::min(begin + classifyBlockSize,
+        (size_t) dataset.n_cols) - 1;
+
+    arma::mat hypothesis;
+    BlockScores(parameters, fitIntercept, dataset, begin, end, hypothesis);
+    hypothesis = arma::exp(hypothesis);
 
-  probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
-                                            numClasses, 1);
+    probabilities.cols(begin, end) = hypothesis /
+        arma::repmat(arma::sum(hypothesis, 0), numClasses, 1);
+  }
 }
 
 double SoftmaxRegression::ComputeAccuracy(
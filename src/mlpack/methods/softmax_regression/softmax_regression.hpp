@@ -119,13 +119,32 @@ class SoftmaxRegression
                     CallbackTypes&&... callbacks);
   /**
    * Classify the given points, returning the predicted labels for each point.
-   * The function calculates the probabilities for every class, given a data
-   * point. It then chooses the class which has the highest probability among
-   * all.
+   * The softmax is monotone in the raw class scores, so the label is computed
+   * as the argmax of the scores directly; exponentiation and normalization
+   * are skipped entirely.  Use the overload that returns probabilities if you
+   * need them.
    * @param dataset Set of points to classify.
    * @param labels Predicted labels for each point.
    */
   void Classify(const arma::mat& dataset, arma::Row<size_t>& labels) const;
+
+  /**
+   * Classify the given points, returning the k highest-probability classes
+   * and their probabilities for each point, in decreasing order of
+   * probability.  The selection happens on the raw class scores; only the
+   * normalizer and the k reported probabilities are computed in
+   * exponentiated form, so the full probability matrix is never materialized.
+   *
+   * @param dataset Matrix of data points to be classified.
+   * @param k Number of classes to report per point (between 1 and
+   *      NumClasses()).
+   * @param labels The k predicted labels for each point, most probable first.
+   * @param scores Probabilities of the k predicted labels for each point.
+   */
+  void Classify(const arma::mat& dataset,
+                const size_t k,
+                arma::Mat<size_t>& labels,
+                arma::mat& scores) const;
   /**
    * Classify the given point. The predicted class label is returned.
    * The function calculates the probabilites for every class, given the point.
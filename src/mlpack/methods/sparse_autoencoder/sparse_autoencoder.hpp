@@ -57,8 +57,11 @@ namespace nn {
  * @endcode
  *
  * This implementation allows the use of arbitrary mlpack optimizers via the
- * OptimizerType template parameter.
- *
+ * OptimizerType template parameter.  Since SparseAutoencoderFunction is
+ * separable, minibatch optimizers such as ens::StandardSGD may also be used;
+ * in that mode the sparsity penalty is computed against a running estimate of
+ * the mean hidden activations, so each minibatch only feeds forward its own
+ * points and the full dataset is never held in activation memory at once.
  */
 class SparseAutoencoder
 {
@@ -26,10 +26,15 @@ SparseAutoencoderFunction::SparseAutoencoderFunction(const arma::mat& data,
     hiddenSize(hiddenSize),
     lambda(lambda),
     beta(beta),
-    rho(rho)
+    rho(rho),
+    rhoEstimateDecay(0.9)
 {
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
+
+  // Until Shuffle() is called, minibatches visit the points in dataset order.
+  visitationOrder = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 }
 
 /** Initializes the parameter weights if the initial point is not passed to the
@@ -208,3 +213,134 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / data.n_cols;
   gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / data.n_cols).t();
 }
+
+/** Evaluates the objective function on a minibatch of points.
+  */
+double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters,
+                                           const size_t begin,
+                                           const size_t batchSize) const
+{
+  // Compute the limits for the parameters w1, w2, b1 and b2.
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  // Gather the columns of the minibatch in visitation order.
+  const arma::mat batch = data.cols(visitationOrder.subvec(begin,
+      begin + batchSize - 1));
+
+  arma::mat hiddenLayer, outputLayer;
+
+  // Compute activations of the hidden and output layers for the minibatch.
+  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * batch +
+      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, batchSize),
+      hiddenLayer);
+
+  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
+      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, batchSize),
+      outputLayer);
+
+  const arma::mat diff = outputLayer - batch;
+
+  // The running estimate stands in for the full-data mean activations; before
+  // the first minibatch gradient has been seen, fall back to the activations
+  // of this minibatch.
+  arma::vec rhoCap;
+  if (rhoEstimate.n_elem == hiddenSize)
+    rhoCap = rhoEstimate;
+  else
+    rhoCap = arma::vec(arma::sum(hiddenLayer, 1)) / batchSize;
+
+  // Calculate squared L2-norms of w1 and w2.
+  const double wL2SquaredNorm =
+      arma::accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
+      parameters.submat(0, 0, l3 - 1, l2 - 1));
+
+  // The terms are scaled so that the minibatch costs of one epoch sum to the
+  // full-batch objective: the reconstruction error of the minibatch is
+  // divided by the full number of points, and the regularization and sparsity
+  // terms carry the fraction of the points seen in this minibatch.
+  const double sumOfSquaresError = 0.5 * arma::accu(diff % diff) /
+      data.n_cols;
+  const double weightDecay = 0.5 * lambda * wL2SquaredNorm * batchSize /
+      data.n_cols;
+  const double klDivergence = beta * arma::accu(rho * arma::log(rho / rhoCap) +
+      (1 - rho) * arma::log((1 - rho) / (1 - rhoCap))) * batchSize /
+      data.n_cols;
+
+  return sumOfSquaresError + weightDecay + klDivergence;
+}
+
+/** Calculates and stores the gradient values on a minibatch of points.
+  */
+void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
+                                         const size_t begin,
+                                         const size_t batchSize,
+                                         arma::mat& gradient) const
+{
+  // Compute the limits for the parameters w1, w2, b1 and b2.
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  // Gather the columns of the minibatch in visitation order.
+  const arma::mat batch = data.cols(visitationOrder.subvec(begin,
+      begin + batchSize - 1));
+
+  arma::mat hiddenLayer, outputLayer;
+
+  // Compute activations of the hidden and output layers for the minibatch.
+  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * batch +
+      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, batchSize),
+      hiddenLayer);
+
+  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
+      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, batchSize),
+      outputLayer);
+
+  // Fold the mean activations of this minibatch into the running estimate.
+  // The estimate is what the sparsity penalty pulls towards rho, so each
+  // minibatch only has to feed forward its own points.
+  const arma::vec batchRhoCap = arma::vec(arma::sum(hiddenLayer, 1)) /
+      batchSize;
+  if (rhoEstimate.n_elem != hiddenSize)
+    rhoEstimate = batchRhoCap;
+  else
+  {
+    rhoEstimate = rhoEstimateDecay * rhoEstimate +
+        (1 - rhoEstimateDecay) * batchRhoCap;
+  }
+
+  const arma::mat diff = outputLayer - batch;
+
+  arma::mat klDivGrad, delOut, delHid;
+
+  // The delta values are computed as in the full-batch Gradient() overload,
+  // except that the sparsity adjustment uses the running activation estimate.
+  klDivGrad = beta * (-(rho / rhoEstimate) + (1 - rho) / (1 - rhoEstimate));
+  delOut = diff % outputLayer % (1 - outputLayer);
+  delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
+      arma::repmat(klDivGrad, 1, batchSize)) % hiddenLayer %
+      (1 - hiddenLayer);
+
+  gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
+
+  // As in the minibatch Evaluate() overload, the terms are scaled so that the
+  // minibatch gradients of one epoch sum to the full-batch gradient.
+  const double scale = (double) batchSize / data.n_cols;
+
+  gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * batch.t() / data.n_cols +
+      lambda * scale * parameters.submat(0, 0, l1 - 1, l2 - 1);
+  gradient.submat(l1, 0, l3 - 1, l2 - 1) =
+      (delOut * hiddenLayer.t() / data.n_cols +
+      lambda * scale * parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
+  gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / data.n_cols;
+  gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / data.n_cols).t();
+}
+
+/** Shuffles the order in which minibatches visit the points.
+  */
+void SparseAutoencoderFunction::Shuffle()
+{
+  visitationOrder = arma::shuffle(visitationOrder);
+}
@@ -70,6 +70,52 @@ class SparseAutoencoderFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
 
+  /**
+   * Evaluates the objective function on a minibatch of batchSize points
+   * starting at index begin (in the current visitation order).  This makes the
+   * function separable, so it can be given to minibatch optimizers like SGD,
+   * and the full dataset never needs to be fed forward at once.  The sparsity
+   * term is computed against the running estimate of the mean hidden
+   * activations (see RhoEstimate()), since a single minibatch is too noisy an
+   * estimate of them; the reconstruction, regularization and sparsity terms
+   * are scaled so that the batch costs of one epoch sum to the full-batch
+   * objective.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the minibatch.
+   * @param batchSize Number of points in the minibatch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
+  /**
+   * Evaluates the gradient of the objective function on a minibatch of
+   * batchSize points starting at index begin (in the current visitation
+   * order).  The running estimate of the mean hidden activations is updated
+   * with the activations of this minibatch before the sparsity term of the
+   * gradient is computed.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the minibatch.
+   * @param batchSize Number of points in the minibatch.
+   * @param gradient Matrix where gradient values will be stored.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                const size_t batchSize,
+                arma::mat& gradient) const;
+
+  /**
+   * Shuffle the visitation order of the points.  The data matrix itself is
+   * held by reference and is never modified or copied; only the order in which
+   * minibatches gather columns changes.
+   */
+  void Shuffle();
+
+  //! Return the number of points in the dataset.
+  size_t NumFunctions() const { return data.n_cols; }
+
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
    * function of a real number 'x' is [1 / (1 + exp(-x))].
@@ -145,6 +191,25 @@ class SparseAutoencoderFunction
     return rho;
   }
 
+  //! Sets the decay of the running mean hidden activation estimate.
+  void RhoEstimateDecay(const double decay)
+  {
+    this->rhoEstimateDecay = decay;
+  }
+
+  //! Gets the decay of the running mean hidden activation estimate.
+  double RhoEstimateDecay() const
+  {
+    return rhoEstimateDecay;
+  }
+
+  //! Gets the running estimate of the mean hidden activations, as maintained
+  //! by the minibatch Gradient() overload (empty until the first minibatch).
+  const arma::vec& RhoEstimate() const
+  {
+    return rhoEstimate;
+  }
+
  private:
   //! The matrix of data points.
   const arma::mat& data;
@@ -160,6 +225,14 @@ class SparseAutoencoderFunction
   double beta;
   //! Sparsity parameter.
   double rho;
+  //! Order in which minibatches gather the columns of the data matrix.
+  arma::uvec visitationOrder;
+  //! Running estimate of the mean hidden activations, used for the sparsity
+  //! term in the minibatch overloads.  Mutable so that the (const) minibatch
+  //! Gradient() can maintain it.
+  mutable arma::vec rhoEstimate;
+  //! Decay of the running mean hidden activation estimate.
+  double rhoEstimateDecay;
 };
 
 } // namespace nn
@@ -22,13 +22,15 @@ SparseCoding::SparseCoding(
     const double lambda2,
     const size_t maxIterations,
     const double objTolerance,
-    const double newtonTolerance) :
+    const double newtonTolerance,
+    const size_t batchSize) :
     atoms(atoms),
     lambda1(lambda1),
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    batchSize(batchSize)
 {
   // Nothing to do.
 }
@@ -40,12 +42,14 @@ void SparseCoding::Encode(const arma::mat& data, arma::mat& codes)
   arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
 
+  // The coding problems of different points are independent, so solve them
+  // across threads.  Each thread builds its own LARS object (and thus its own
+  // workspace); the precomputed Gram matrix is only read, so all threads can
+  // share it.
+  #pragma omp parallel for default(shared)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
     bool useCholesky = true;
     regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
 
@@ -140,6 +140,8 @@ class SparseCoding
    *     will terminate.
    * @param newtonTolerance Tolerance for the Newton's method dictionary
    *     optimization step.
+   * @param batchSize Number of points to sample per dictionary update; 0 means
+   *     the full dataset is used every iteration.
    * @param initializer The initializer to use.
    */
   template<typename DictionaryInitializer = DataDependentRandomInitializer>
@@ -150,6 +152,7 @@ class SparseCoding
                const size_t maxIterations = 0,
                const double objTolerance = 0.01,
                const double newtonTolerance = 1e-6,
+               const size_t batchSize = 0,
                const DictionaryInitializer& initializer =
                    DictionaryInitializer());
 
@@ -168,16 +171,23 @@ class SparseCoding
    *     will terminate.
    * @param newtonTolerance Tolerance for the Newton's method dictionary
    *     optimization step.
+   * @param batchSize Number of points to sample per dictionary update; 0 means
+   *     the full dataset is used every iteration.
    */
   SparseCoding(const size_t atoms = 0,
                const double lambda1 = 0,
                const double lambda2 = 0,
                const size_t maxIterations = 0,
                const double objTolerance = 0.01,
-               const double newtonTolerance = 1e-6);
+               const double newtonTolerance = 1e-6,
+               const size_t batchSize = 0);
 
   /**
-   * Train the sparse coding model on the given dataset.
+   * Train the sparse coding model on the given dataset.  If BatchSize() is
+   * nonzero, each iteration codes only a random minibatch of the data and
+   * updates the dictionary from it; in that mode maxIterations must be
+   * nonzero, since the noisy minibatch objective cannot be used to check
+   * convergence.
    * @return The final objective value.
    */
   template<typename DictionaryInitializer = DataDependentRandomInitializer>
@@ -254,6 +264,12 @@ class SparseCoding
   //! Modify the tolerance for Newton's method (dictionary optimization step).
   double& NewtonTolerance() { return newtonTolerance; }
 
+  //! Get the number of points sampled per dictionary update (0 means the full
+  //! dataset is used).
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points sampled per dictionary update.
+  size_t& BatchSize() { return batchSize; }
+
   //! Serialize the sparse coding model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -276,6 +292,9 @@ class SparseCoding
   double objTolerance;
   //! Tolerance for Newton's method (dictionary training).
   double newtonTolerance;
+  //! Number of points sampled per dictionary update; 0 means the full dataset
+  //! is used.  Not serialized, since it only affects training.
+  size_t batchSize;
 };
 
 } // namespace sparse_coding
@@ -28,13 +28,15 @@ SparseCoding::SparseCoding(
     const size_t maxIterations,
     const double objTolerance,
     const double newtonTolerance,
+    const size_t batchSize,
     const DictionaryInitializer& initializer) :
     atoms(atoms),
     lambda1(lambda1),
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    batchSize(batchSize)
 {
   Train(data, initializer);
 }
@@ -51,6 +53,49 @@ double SparseCoding::Train(
 
   double lastObjVal = DBL_MAX;
 
+  if ((batchSize > 0) && (batchSize < data.n_cols))
+  {
+    // Minibatch mode: each iteration codes a random minibatch of the data and
+    // updates the dictionary from it alone.  The minibatch objective is too
+    // noisy to check convergence against objTolerance, so we run for exactly
+    // maxIterations iterations.
+    if (maxIterations == 0)
+    {
+      Log::Fatal << "SparseCoding::Train(): maxIterations must be nonzero "
+          << "when a batch size is set, since convergence cannot be checked "
+          << "on minibatch objectives!" << std::endl;
+    }
+
+    arma::mat batchCodes;
+    for (size_t t = 1; t != maxIterations + 1; ++t)
+    {
+      Log::Info << "Iteration " << t << " of " << maxIterations << "."
+          << std::endl;
+
+      const arma::uvec batch = arma::randperm(data.n_cols, batchSize);
+      const arma::mat batchData = data.cols(batch);
+
+      // Code the minibatch, then take a dictionary step on it.
+      Encode(batchData, batchCodes);
+      const arma::uvec adjacencies = find(batchCodes);
+      OptimizeDictionary(batchData, batchCodes, adjacencies);
+
+      Log::Info << "  Sparsity level: " << 100.0 *
+          ((double) (adjacencies.n_elem)) / ((double) (atoms * batchSize))
+          << "%." << std::endl;
+      Log::Info << "  Minibatch objective value: "
+          << Objective(batchData, batchCodes) << "." << std::endl;
+    }
+
+    // Perform a final full coding pass to report the objective on all points.
+    arma::mat codes;
+    Encode(data, codes);
+    lastObjVal = Objective(data, codes);
+    Log::Info << "Final objective value: " << lastObjVal << "." << std::endl;
+
+    return lastObjVal;
+  }
+
   // Take the initial coding step, which has to happen before entering the main
   // optimization loop.
   Log::Info << "Initial coding step." << std::endl;
@@ -117,6 +117,8 @@ PARAM_DOUBLE_IN("objective_tolerance", "Tolerance for convergence of the "
     "objective function.", "o", 0.01);
 PARAM_DOUBLE_IN("newton_tolerance", "Tolerance for convergence of Newton "
     "method.", "w", 1e-6);
+PARAM_INT_IN("batch_size", "Number of points to sample per dictionary update; "
+    "0 means the full dataset is used every iteration.", "b", 0);
 
 // Load/save a model.
 PARAM_MODEL_IN(SparseCoding, "input_model", "File containing input sparse "
@@ -164,6 +166,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "training", false }}, "normalize");
   ReportIgnoredParam(params, {{ "training", false }}, "objective_tolerance");
   ReportIgnoredParam(params, {{ "training", false }}, "newton_tolerance");
+  ReportIgnoredParam(params, {{ "training", false }}, "batch_size");
 
   RequireParamValue<int>(params, "atoms", [](int x) { return x > 0; }, true,
       "number of atoms must be positive");
@@ -181,6 +184,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   RequireParamValue<double>(params, "newton_tolerance",
       [](double x) { return x >= 0.0; }, true,
       "Newton method tolerance must be nonnegative");
+  RequireParamValue<int>(params, "batch_size", [](int x) { return x >= 0; },
+      true, "batch size must be nonnegative");
 
   // Do we have an existing model?
   SparseCoding* sc;
@@ -207,6 +212,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     sc->Atoms() = (size_t) params.Get<int>("atoms");
     sc->ObjTolerance() = params.Get<double>("objective_tolerance");
     sc->NewtonTolerance() = params.Get<double>("newton_tolerance");
+    sc->BatchSize() = (size_t) params.Get<int>("batch_size");
 
     // Inform the user if we are overwriting their model.
     timers.Start("sparse_coding");
@@ -0,0 +1,136 @@
+/**
+ * @file methods/xgboost/xgb_tree.hpp
+ * @author Rishabh Garg
+ * @author Ryan Curtin
+ *
+ * A single regression tree of the gradient boosting ensemble, trained on
+ * first- and second-order gradient statistics with histogram split search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGB_TREE_HPP
+#define MLPACK_METHODS_XGBOOST_XGB_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ensemble {
+
+/**
+ * An XGBTree is one tree of a gradient boosting ensemble.  It is a binary
+ * regression tree fit to per-point first-order gradients and second-order
+ * hessians, as in the XGBoost algorithm: every leaf outputs the regularized
+ * Newton step -G / (H + lambda) for the points it covers, and splits are
+ * chosen to maximize
+ *
+ *   0.5 * (G_L^2 / (H_L + lambda) + G_R^2 / (H_R + lambda)
+ *       - G^2 / (H + lambda))
+ *
+ * where G and H are sums of gradients and hessians.  Candidate thresholds are
+ * the edges of 256 equal-width histogram bins per dimension, and the search
+ * over candidate dimensions is parallelized with OpenMP.
+ *
+ * The trained tree is stored in contiguous arrays (split dimension,
+ * threshold, child indices, leaf values), so prediction walks flat arrays and
+ * the model serializes compactly.
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   author = {Chen, Tianqi and Guestrin, Carlos},
+ *   title = {{XGBoost}: A Scalable Tree Boosting System},
+ *   booktitle = {Proceedings of the 22nd ACM SIGKDD International Conference
+ *       on Knowledge Discovery and Data Mining (KDD '16)},
+ *   pages = {785--794},
+ *   year = {2016}
+ * }
+ * @endcode
+ */
+class XGBTree
+{
+ public:
+  /**
+   * Construct an empty tree; it returns nothing useful until Train() is
+   * called.
+   */
+  XGBTree() { }
+
+  /**
+   * Train the tree on the given gradient statistics.
+   *
+   * @param data Dataset the gradients were computed on.
+   * @param gradients First-order gradient of the loss for each point.
+   * @param hessians Second-order gradient of the loss for each point.
+   * @param dimensions Candidate split dimensions (e.g. a column subsample).
+   * @param maximumDepth Maximum depth of the tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param minimumGainSplit Minimum gain required to make a split.
+   * @param lambda L2 regularization on the leaf values.
+   * @param alpha L1 regularization on the leaf values.
+   * @param leafScale Factor the leaf values are scaled by (the boosting
+   *      learning rate); folding it into the leaves makes prediction a plain
+   *      sum over trees.
+   */
+  template<typename MatType>
+  void Train(const MatType& data,
+             const arma::vec& gradients,
+             const arma::vec& hessians,
+             const arma::Col<size_t>& dimensions,
+             const size_t maximumDepth,
+             const size_t minimumLeafSize,
+             const double minimumGainSplit,
+             const double lambda,
+             const double alpha,
+             const double leafScale);
+
+  /**
+   * Predict the output value for the given point.
+   *
+   * @param point Point to predict the value of.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  /**
+   * Predict the output values for the given points.
+   *
+   * @param data Set of points to predict the values of.
+   * @param predictions This will be filled with the prediction of each point.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  //! Get the number of nodes in the tree.
+  size_t NumNodes() const { return leafValues.n_elem; }
+
+  //! Serialize the tree.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The dimension each internal node splits on (unused for leaves).
+  arma::Col<size_t> splitDimensions;
+  //! The split threshold of each internal node; points with a value strictly
+  //! less than the threshold go left.
+  arma::vec thresholds;
+  //! The index of each node's left child; 0 denotes a leaf, since the root
+  //! can never be a child.
+  arma::Col<size_t> leftChildren;
+  //! The index of each node's right child (unused for leaves).
+  arma::Col<size_t> rightChildren;
+  //! The output value of each leaf node.
+  arma::vec leafValues;
+
+  //! Apply the L1 regularization to a gradient sum.
+  static double ApplyL1(const double sumGradients, const double alpha);
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+// Include implementation.
+#include "xgb_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * @file methods/xgboost/xgb_tree_impl.hpp
+ * @author Rishabh Garg
+ * @author Ryan Curtin
+ *
+ * Implementation of the XGBTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGB_TREE_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGB_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgb_tree.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+inline double XGBTree::ApplyL1(const double sumGradients, const double alpha)
+{
+  if (sumGradients > alpha)
+    return sumGradients - alpha;
+  else if (sumGradients < -alpha)
+    return sumGradients + alpha;
+
+  return 0;
+}
+
+template<typename MatType>
+void XGBTree::Train(const MatType& data,
+                    const arma::vec& gradients,
+                    const arma::vec& hessians,
+                    const arma::Col<size_t>& dimensions,
+                    const size_t maximumDepth,
+                    const size_t minimumLeafSize,
+                    const double minimumGainSplit,
+                    const double lambda,
+                    const double alpha,
+                    const double leafScale)
+{
+  const size_t numBins = 256;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // The tree is grown into these growable arrays and copied into the fixed
+  // members at the end.
+  std::vector<size_t> nodeSplitDimensions, nodeLeftChildren, nodeRightChildren;
+  std::vector<double> nodeThresholds, nodeValues;
+
+  // Work items for nodes that still have to be processed.
+  struct NodeTask
+  {
+    size_t node;
+    size_t depth;
+    arma::uvec points;
+  };
+  std::vector<NodeTask> stack;
+
+  // Create the root node, covering all points.
+  nodeSplitDimensions.push_back(0);
+  nodeLeftChildren.push_back(0);
+  nodeRightChildren.push_back(0);
+  nodeThresholds.push_back(0.0);
+  nodeValues.push_back(0.0);
+  stack.push_back(NodeTask{0, 0,
+      arma::linspace<arma::uvec>(0, data.n_cols - 1, data.n_cols)});
+
+  while (!stack.empty())
+  {
+    NodeTask task = std::move(stack.back());
+    stack.pop_back();
+    const arma::uvec& points = task.points;
+
+    const double sumG = arma::accu(gradients.elem(points));
+    const double sumH = arma::accu(hessians.elem(points));
+
+    // Every node gets a leaf value; it is only used if the node stays a leaf.
+    nodeValues[task.node] = -leafScale * ApplyL1(sumG, alpha) /
+        (sumH + lambda);
+
+    // Check whether we can split at all.
+    if ((maximumDepth != 0 && task.depth + 1 >= maximumDepth) ||
+        (points.n_elem < 2 * minimum))
+      continue;
+
+    const double parentScore = std::pow(ApplyL1(sumG, alpha), 2) /
+        (sumH + lambda);
+
+    // Search the candidate dimensions for the best histogram split.  Each
+    // thread keeps its own best split, and the results are merged afterwards;
+    // ties are broken towards the smaller dimension so the result does not
+    // depend on the number of threads.
+    double bestGain = minimumGainSplit;
+    size_t bestDimension = 0;
+    double bestThreshold = 0.0;
+    bool improved = false;
+
+    #pragma omp parallel
+    {
+      double localBestGain = minimumGainSplit;
+      size_t localBestDimension = 0;
+      double localBestThreshold = 0.0;
+      bool localImproved = false;
+
+      #pragma omp for nowait
+      for (omp_size_t j = 0; j < (omp_size_t) dimensions.n_elem; ++j)
+      {
+        const size_t dim = dimensions[j];
+
+        // Find the range of the dimension over the node's points.
+        double minValue = (double) data(dim, points[0]);
+        double maxValue = minValue;
+        for (size_t p = 1; p < points.n_elem; ++p)
+        {
+          const double value = (double) data(dim, points[p]);
+          minValue = std::min(minValue, value);
+          maxValue = std::max(maxValue, value);
+        }
+        if (minValue == maxValue)
+          continue; // The dimension is constant; we can't split on it.
+
+        const double binWidth = (maxValue - minValue) / (double) numBins;
+
+        // Accumulate per-bin gradient statistics in one pass.
+        arma::vec binG(numBins, arma::fill::zeros);
+        arma::vec binH(numBins, arma::fill::zeros);
+        arma::Col<size_t> binCounts(numBins, arma::fill::zeros);
+        for (size_t p = 0; p < points.n_elem; ++p)
+        {
+          const size_t bin = std::min(
+              (size_t) (((double) data(dim, points[p]) - minValue) / binWidth),
+              numBins - 1);
+          binG[bin] += gradients[points[p]];
+          binH[bin] += hessians[points[p]];
+          ++binCounts[bin];
+        }
+
+        // Scan the bin boundaries.
+        double leftG = 0.0, leftH = 0.0;
+        size_t leftCount = 0;
+        for (size_t bin = 0; bin + 1 < numBins; ++bin)
+        {
+          leftG += binG[bin];
+          leftH += binH[bin];
+          leftCount += binCounts[bin];
+
+          if (binCounts[bin] == 0)
+            continue; // No new candidate threshold.
+          if ((leftCount < minimum) || (points.n_elem - leftCount < minimum))
+            continue;
+
+          const double rightG = sumG - leftG;
+          const double rightH = sumH - leftH;
+          const double gain = 0.5 *
+              (std::pow(ApplyL1(leftG, alpha), 2) / (leftH + lambda) +
+               std::pow(ApplyL1(rightG, alpha), 2) / (rightH + lambda) -
+               parentScore);
+
+          if (gain > localBestGain)
+          {
+            localBestGain = gain;
+            localBestDimension = dim;
+            localBestThreshold = minValue + binWidth * (bin + 1);
+            localImproved = true;
+          }
+        }
+      }
+
+      #pragma omp critical (XGBTreeSplit)
+      {
+        if (localImproved && ((localBestGain > bestGain) ||
+            (localBestGain == bestGain && improved &&
+             localBestDimension < bestDimension) ||
+            (localBestGain == bestGain && !improved)))
+        {
+          bestGain = localBestGain;
+          bestDimension = localBestDimension;
+          bestThreshold = localBestThreshold;
+          improved = true;
+        }
+      }
+    }
+
+    if (!improved)
+      continue; // No split improves on the minimum gain; stay a leaf.
+
+    // Partition the node's points.
+    size_t leftCount = 0;
+    for (size_t p = 0; p < points.n_elem; ++p)
+      if ((double) data(bestDimension, points[p]) < bestThreshold)
+        ++leftCount;
+
+    arma::uvec leftPoints(leftCount);
+    arma::uvec rightPoints(points.n_elem - leftCount);
+    size_t leftIndex = 0, rightIndex = 0;
+    for (size_t p = 0; p < points.n_elem; ++p)
+    {
+      if ((double) data(bestDimension, points[p]) < bestThreshold)
+        leftPoints[leftIndex++] = points[p];
+      else
+        rightPoints[rightIndex++] = points[p];
+    }
+
+    // Turn the node into an internal node and enqueue its children.
+    const size_t leftNode = nodeValues.size();
+    const size_t rightNode = leftNode + 1;
+    for (size_t c = 0; c < 2; ++c)
+    {
+      nodeSplitDimensions.push_back(0);
+      nodeLeftChildren.push_back(0);
+      nodeRightChildren.push_back(0);
+      nodeThresholds.push_back(0.0);
+      nodeValues.push_back(0.0);
+    }
+
+    nodeSplitDimensions[task.node] = bestDimension;
+    nodeThresholds[task.node] = bestThreshold;
+    nodeLeftChildren[task.node] = leftNode;
+    nodeRightChildren[task.node] = rightNode;
+
+    stack.push_back(NodeTask{leftNode, task.depth + 1, std::move(leftPoints)});
+    stack.push_back(NodeTask{rightNode, task.depth + 1,
+        std::move(rightPoints)});
+  }
+
+  splitDimensions = arma::Col<size_t>(nodeSplitDimensions);
+  thresholds = arma::vec(nodeThresholds);
+  leftChildren = arma::Col<size_t>(nodeLeftChildren);
+  rightChildren = arma::Col<size_t>(nodeRightChildren);
+  leafValues = arma::vec(nodeValues);
+}
+
+template<typename VecType>
+double XGBTree::Predict(const VecType& point) const
+{
+  size_t node = 0;
+  while (leftChildren[node] != 0)
+  {
+    node = ((double) point[splitDimensions[node]] < thresholds[node]) ?
+        leftChildren[node] : rightChildren[node];
+  }
+
+  return leafValues[node];
+}
+
+template<typename MatType>
+void XGBTree::Predict(const MatType& data, arma::rowvec& predictions) const
+{
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    predictions[i] = Predict(data.col(i));
+}
+
+template<typename Archive>
+void XGBTree::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(splitDimensions));
+  ar(CEREAL_NVP(thresholds));
+  ar(CEREAL_NVP(leftChildren));
+  ar(CEREAL_NVP(rightChildren));
+  ar(CEREAL_NVP(leafValues));
+}
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
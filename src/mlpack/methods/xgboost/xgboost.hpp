@@ -0,0 +1,201 @@
+/**
+ * @file methods/xgboost/xgboost.hpp
+ * @author Rishabh Garg
+ * @author Ryan Curtin
+ *
+ * The XGBoost class: second-order gradient boosted decision trees for
+ * classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "xgb_tree.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+/**
+ * The XGBoost class implements second-order gradient boosting with the
+ * softmax loss for classification.  Each boosting iteration fits one XGBTree
+ * per class to the first- and second-order gradients of the loss at the
+ * current scores, optionally on a random subsample of the dimensions (column
+ * subsampling), and adds the trees' outputs to the scores scaled by the
+ * learning rate (shrinkage).
+ *
+ * The prediction interface follows the same conventions as RandomForest:
+ * Classify() overloads for single points and for matrices, optionally
+ * returning class probabilities, and the model can be serialized.
+ *
+ * For more information, see the following paper.
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   author = {Chen, Tianqi and Guestrin, Carlos},
+ *   title = {{XGBoost}: A Scalable Tree Boosting System},
+ *   booktitle = {Proceedings of the 22nd ACM SIGKDD International Conference
+ *       on Knowledge Discovery and Data Mining (KDD '16)},
+ *   pages = {785--794},
+ *   year = {2016}
+ * }
+ * @endcode
+ */
+class XGBoost
+{
+ public:
+  /**
+   * Construct the XGBoost object without training.  Be sure to call Train()
+   * before calling Classify()!
+   */
+  XGBoost();
+
+  /**
+   * Construct the XGBoost object and train the model on the given data.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param numIterations Number of boosting iterations (each iteration adds
+   *      one tree per class).
+   * @param learningRate Shrinkage applied to each tree's output.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param minimumGainSplit Minimum gain for a split to be accepted.
+   * @param lambda L2 regularization on the leaf values.
+   * @param alpha L1 regularization on the leaf values.
+   * @param featureFraction Fraction of dimensions each tree may split on.
+   */
+  template<typename MatType>
+  XGBoost(const MatType& data,
+          const arma::Row<size_t>& labels,
+          const size_t numClasses,
+          const size_t numIterations = 100,
+          const double learningRate = 0.1,
+          const size_t maximumDepth = 6,
+          const size_t minimumLeafSize = 10,
+          const double minimumGainSplit = 0.0,
+          const double lambda = 1.0,
+          const double alpha = 0.0,
+          const double featureFraction = 1.0);
+
+  /**
+   * Train the model on the given data, discarding any previously trained
+   * model.  The average softmax loss over the training set after the last
+   * iteration is returned.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param numIterations Number of boosting iterations (each iteration adds
+   *      one tree per class).
+   * @param learningRate Shrinkage applied to each tree's output.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param minimumGainSplit Minimum gain for a split to be accepted.
+   * @param lambda L2 regularization on the leaf values.
+   * @param alpha L1 regularization on the leaf values.
+   * @param featureFraction Fraction of dimensions each tree may split on.
+   * @return The average training loss after the final iteration.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const size_t numIterations = 100,
+               const double learningRate = 0.1,
+               const size_t maximumDepth = 6,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 0.0,
+               const double lambda = 1.0,
+               const double alpha = 0.0,
+               const double featureFraction = 1.0);
+
+  /**
+   * Predict the class of the given point.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Predict the class of the given point and compute class probabilities.
+   *
+   * @param point Point to classify.
+   * @param prediction This will be set to the predicted class.
+   * @param probabilities This will be filled with class probabilities.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of each point in the given dataset.
+   *
+   * @param data Dataset to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning
+   * the class probabilities for each point.
+   *
+   * @param data Dataset to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities This will be filled with class probabilities for
+   *      each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of classes the model was trained on.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the number of trees in the model.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Access a tree in the model.
+  const XGBTree& Tree(const size_t i) const { return trees[i]; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The number of classes in the model.
+  size_t numClasses;
+  //! The trees of the ensemble, in iteration-major order: tree i belongs to
+  //! class (i % numClasses).
+  std::vector<XGBTree> trees;
+
+  /**
+   * Compute the raw (pre-softmax) scores of all trees for the given points.
+   */
+  template<typename MatType>
+  void Scores(const MatType& data, arma::mat& scores) const;
+
+  /**
+   * Turn a matrix of raw scores (one column per point) into softmax
+   * probabilities, in place.
+   */
+  static void Softmax(arma::mat& scores);
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+// Include implementation.
+#include "xgboost_impl.hpp"
+
+#endif
@@ -0,0 +1,232 @@
+/**
+ * @file methods/xgboost/xgboost_impl.hpp
+ * @author Rishabh Garg
+ * @author Ryan Curtin
+ *
+ * Implementation of the XGBoost class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgboost.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+inline XGBoost::XGBoost() : numClasses(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+XGBoost::XGBoost(const MatType& data,
+                 const arma::Row<size_t>& labels,
+                 const size_t numClasses,
+                 const size_t numIterations,
+                 const double learningRate,
+                 const size_t maximumDepth,
+                 const size_t minimumLeafSize,
+                 const double minimumGainSplit,
+                 const double lambda,
+                 const double alpha,
+                 const double featureFraction) :
+    numClasses(numClasses)
+{
+  Train(data, labels, numClasses, numIterations, learningRate, maximumDepth,
+      minimumLeafSize, minimumGainSplit, lambda, alpha, featureFraction);
+}
+
+template<typename MatType>
+double XGBoost::Train(const MatType& data,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const size_t numIterations,
+                      const double learningRate,
+                      const size_t maximumDepth,
+                      const size_t minimumLeafSize,
+                      const double minimumGainSplit,
+                      const double lambda,
+                      const double alpha,
+                      const double featureFraction)
+{
+  if (featureFraction <= 0.0 || featureFraction > 1.0)
+  {
+    throw std::invalid_argument("XGBoost::Train(): featureFraction must be in "
+        "(0, 1]!");
+  }
+
+  this->numClasses = numClasses;
+  trees.clear();
+  trees.reserve(numIterations * numClasses);
+
+  const size_t dims = data.n_rows;
+  const size_t numSampledDims = (featureFraction >= 1.0) ? dims :
+      std::max((size_t) 1, (size_t) (featureFraction * dims));
+
+  // The raw scores of the model for every training point; the softmax of a
+  // column gives the class probabilities of that point.
+  arma::mat scores(numClasses, data.n_cols, arma::fill::zeros);
+  arma::mat probabilities;
+
+  arma::vec gradients(data.n_cols), hessians(data.n_cols);
+  arma::rowvec treePredictions;
+  std::vector<size_t> dimensionPool(dims);
+  for (size_t d = 0; d < dims; ++d)
+    dimensionPool[d] = d;
+
+  for (size_t iteration = 0; iteration < numIterations; ++iteration)
+  {
+    probabilities = scores;
+    Softmax(probabilities);
+
+    for (size_t k = 0; k < numClasses; ++k)
+    {
+      // Second-order gradients of the softmax loss with respect to the score
+      // of class k.
+      for (size_t i = 0; i < data.n_cols; ++i)
+      {
+        const double p = probabilities(k, i);
+        gradients[i] = p - ((labels[i] == k) ? 1.0 : 0.0);
+        // Keep the hessian bounded away from zero for numerical stability.
+        hessians[i] = std::max(p * (1.0 - p), 1e-6);
+      }
+
+      // Column subsampling: draw the tree's candidate dimensions without
+      // replacement with a partial Fisher-Yates shuffle.
+      arma::Col<size_t> dimensions(numSampledDims);
+      for (size_t d = 0; d < numSampledDims; ++d)
+      {
+        const size_t swap = d + math::RandInt(dims - d);
+        std::swap(dimensionPool[d], dimensionPool[swap]);
+        dimensions[d] = dimensionPool[d];
+      }
+
+      XGBTree tree;
+      tree.Train(data, gradients, hessians, dimensions, maximumDepth,
+          minimumLeafSize, minimumGainSplit, lambda, alpha, learningRate);
+
+      // The learning rate is already folded into the leaf values.
+      tree.Predict(data, treePredictions);
+      scores.row(k) += treePredictions;
+      trees.push_back(std::move(tree));
+    }
+  }
+
+  // Compute the average softmax loss over the training set.
+  probabilities = scores;
+  Softmax(probabilities);
+  double loss = 0.0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+    loss -= std::log(std::max(probabilities(labels[i], i), 1e-300));
+
+  return loss / data.n_cols;
+}
+
+template<typename VecType>
+size_t XGBoost::Classify(const VecType& point) const
+{
+  // Pass off to another Classify() overload.
+  size_t prediction;
+  arma::vec probabilities;
+  Classify(point, prediction, probabilities);
+
+  return prediction;
+}
+
+template<typename VecType>
+void XGBoost::Classify(const VecType& point,
+                       size_t& prediction,
+                       arma::vec& probabilities) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    probabilities.clear();
+    prediction = 0;
+
+    throw std::invalid_argument("XGBoost::Classify(): no model trained!");
+  }
+
+  arma::vec scores(numClasses, arma::fill::zeros);
+  for (size_t t = 0; t < trees.size(); ++t)
+    scores[t % numClasses] += trees[t].Predict(point);
+
+  // Softmax over the scores.
+  scores -= scores.max();
+  probabilities = arma::exp(scores);
+  probabilities /= arma::accu(probabilities);
+
+  arma::uword maxIndex = 0;
+  probabilities.max(maxIndex);
+  prediction = (size_t) maxIndex;
+}
+
+template<typename MatType>
+void XGBoost::Classify(const MatType& data,
+                       arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void XGBoost::Classify(const MatType& data,
+                       arma::Row<size_t>& predictions,
+                       arma::mat& probabilities) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+    probabilities.clear();
+
+    throw std::invalid_argument("XGBoost::Classify(): no model trained!");
+  }
+
+  Scores(data, probabilities);
+  Softmax(probabilities);
+
+  predictions.set_size(data.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    predictions[i] = probabilities.col(i).index_max();
+}
+
+template<typename MatType>
+void XGBoost::Scores(const MatType& data, arma::mat& scores) const
+{
+  scores.zeros(numClasses, data.n_cols);
+
+  arma::rowvec treePredictions;
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    trees[t].Predict(data, treePredictions);
+    scores.row(t % numClasses) += treePredictions;
+  }
+}
+
+inline void XGBoost::Softmax(arma::mat& scores)
+{
+  // Shift by the column maxima for numerical stability.
+  scores.each_row() -= arma::max(scores, 0);
+  scores = arma::exp(scores);
+  scores.each_row() /= arma::sum(scores, 0);
+}
+
+template<typename Archive>
+void XGBoost::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numClasses));
+  ar(CEREAL_NVP(trees));
+}
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
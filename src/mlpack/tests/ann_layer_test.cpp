@@ -5605,3 +5605,290 @@ TEST_CASE("GradientInstanceNormLayerTest", "[ANNLayerTest]")
 
   REQUIRE(pass);
 }
+
+/**
+ * Test that the int8 QuantizedLinear layer approximates the floating-point
+ * Linear layer it was built from.
+ */
+TEST_CASE("QuantizedLinearLayerTest", "[ANNLayerTest]")
+{
+  arma::mat weight = arma::randn(8, 10);
+  arma::mat bias = arma::randn(8, 1);
+  arma::mat input = arma::randn(10, 32);
+
+  // Reference result from the floating-point affine transformation.
+  arma::mat reference = weight * input;
+  reference.each_col() += bias;
+
+  QuantizedLinear<> layer(weight, bias);
+  REQUIRE(layer.InputSize() == 10);
+  REQUIRE(layer.OutputSize() == 8);
+
+  arma::mat output;
+  layer.Forward(input, output);
+  REQUIRE(output.n_rows == reference.n_rows);
+  REQUIRE(output.n_cols == reference.n_cols);
+
+  // With per-channel weight scales and per-column input scales, the
+  // quantization error of each output element is bounded by the scales times
+  // the accumulation length; check against a conservative version of that
+  // bound.
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    const double inputScale = arma::abs(input.col(j)).max() / 127;
+    for (size_t c = 0; c < output.n_rows; ++c)
+    {
+      const double weightScale = arma::abs(weight.row(c)).max() / 127;
+      const double errorBound = input.n_rows * (inputScale *
+          arma::abs(weight.row(c)).max() + weightScale *
+          arma::abs(input.col(j)).max());
+      REQUIRE(std::abs(output(c, j) - reference(c, j)) <= errorBound);
+    }
+  }
+
+  // In practice the error stays far below the worst-case bound.
+  REQUIRE(arma::abs(output - reference).max() < 0.5);
+
+  // A zero input column must produce exactly the bias.
+  arma::mat zeroInput = arma::zeros(10, 1), zeroOutput;
+  layer.Forward(zeroInput, zeroOutput);
+  CheckMatrices(zeroOutput, bias);
+
+  // A bias of the wrong length must be rejected.
+  REQUIRE_THROWS_AS(QuantizedLinear<>(weight, arma::mat(3, 1)),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the Bf16Linear layer closely approximates the floating-point
+ * Linear layer it was built from.
+ */
+TEST_CASE("Bf16LinearLayerTest", "[ANNLayerTest]")
+{
+  // Use more than one 32-row weight panel so that the ragged last panel is
+  // exercised too.
+  arma::mat weight = arma::randn(40, 10);
+  arma::mat bias = arma::randn(40, 1);
+  arma::mat input = arma::randn(10, 32);
+
+  // Reference result from the floating-point affine transformation.
+  arma::mat reference = weight * input;
+  reference.each_col() += bias;
+
+  Bf16Linear<> layer(weight, bias);
+  REQUIRE(layer.InputSize() == 10);
+  REQUIRE(layer.OutputSize() == 40);
+
+  arma::mat output;
+  layer.Forward(input, output);
+  REQUIRE(output.n_rows == reference.n_rows);
+  REQUIRE(output.n_cols == reference.n_cols);
+
+  // Rounding a weight to bfloat16 changes it by at most 2^-8 of its
+  // magnitude, so each output element is off by at most the accumulation
+  // length times that relative error (plus a much smaller float32
+  // accumulation term, absorbed by the constant here).
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    for (size_t c = 0; c < output.n_rows; ++c)
+    {
+      const double errorBound = 2.0 * input.n_rows * std::pow(2.0, -8) *
+          arma::abs(weight.row(c)).max() * arma::abs(input.col(j)).max();
+      REQUIRE(std::abs(output(c, j) - reference(c, j)) <= errorBound);
+    }
+  }
+
+  // bfloat16 keeps far more precision than int8, so the result should be
+  // much closer than the quantized path.
+  REQUIRE(arma::abs(output - reference).max() < 0.05);
+
+  // A zero input must produce the bias (up to single-precision rounding).
+  arma::mat zeroInput = arma::zeros(10, 1), zeroOutput;
+  layer.Forward(zeroInput, zeroOutput);
+  CheckMatrices(zeroOutput, bias);
+
+  // A bias of the wrong length must be rejected.
+  REQUIRE_THROWS_AS(Bf16Linear<>(weight, arma::mat(3, 1)),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the BlockSparseLinear pruning pass zeroes the right blocks and
+ * that the block-skipping forward pass matches the dense result on the pruned
+ * weights.
+ */
+TEST_CASE("BlockSparseLinearLayerTest", "[ANNLayerTest]")
+{
+  // Dimensions that are not multiples of the block size, so the ragged edge
+  // blocks are exercised too.
+  arma::mat weight = arma::randn(43, 29);
+  arma::mat bias = arma::randn(43, 1);
+  arma::mat input = arma::randn(29, 32);
+  const size_t blockSize = 8;
+
+  // Scale some blocks down so that a threshold separates them cleanly, then
+  // prune at that threshold.
+  weight.submat(0, 0, 7, 7) *= 1e-6;
+  weight.submat(16, 8, 23, 15) *= 1e-6;
+  weight.submat(40, 24, 42, 28) *= 1e-6;
+  const size_t numPruned =
+      BlockSparseLinear<>::Prune(weight, blockSize, 1e-3);
+  REQUIRE(numPruned == 3);
+  REQUIRE(arma::accu(arma::abs(weight.submat(0, 0, 7, 7))) == 0.0);
+  REQUIRE(arma::accu(arma::abs(weight.submat(40, 24, 42, 28))) == 0.0);
+
+  // Reference result from the dense affine transformation on the pruned
+  // weights.
+  arma::mat reference = weight * input;
+  reference.each_col() += bias;
+
+  BlockSparseLinear<> layer(weight, bias, blockSize);
+  REQUIRE(layer.InputSize() == 29);
+  REQUIRE(layer.OutputSize() == 43);
+  REQUIRE(layer.BlockSize() == blockSize);
+  REQUIRE(layer.NumBlocks() == 24); // ceil(43 / 8) * ceil(29 / 8).
+  REQUIRE(layer.NumNonzeroBlocks() == layer.NumBlocks() - numPruned);
+  REQUIRE(layer.BlockSparsity() ==
+      Approx((double) numPruned / layer.NumBlocks()));
+
+  arma::mat output;
+  layer.Forward(input, output);
+  REQUIRE(output.n_rows == reference.n_rows);
+  REQUIRE(output.n_cols == reference.n_cols);
+
+  // Only the accumulation order differs from the dense product.
+  CheckMatrices(output, reference, 1e-10);
+
+  // A zero input must produce exactly the bias.
+  arma::mat zeroInput = arma::zeros(29, 1), zeroOutput;
+  layer.Forward(zeroInput, zeroOutput);
+  CheckMatrices(zeroOutput, bias);
+
+  // A bias of the wrong length and a zero block size must be rejected.
+  REQUIRE_THROWS_AS(BlockSparseLinear<>(weight, arma::mat(3, 1), blockSize),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(BlockSparseLinear<>(weight, bias, 0),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the FusedElementwise layer matches a deterministic-mode
+ * BatchNorm -> ReLU -> Dropout chain applied layer by layer.
+ */
+TEST_CASE("FusedElementwiseLayerTest", "[ANNLayerTest]")
+{
+  arma::mat input = arma::randn(5, 16);
+
+  // Train a BatchNorm layer on the input so the running statistics and the
+  // gamma/beta parameters are nontrivial.
+  BatchNorm<> batchNorm(input.n_rows);
+  batchNorm.Reset();
+  batchNorm.Parameters().rows(0, input.n_rows - 1) += 0.5 *
+      arma::randu(input.n_rows, 1);
+  batchNorm.Parameters().rows(input.n_rows, 2 * input.n_rows - 1) =
+      arma::randn(input.n_rows, 1);
+
+  arma::mat trainingOutput;
+  batchNorm.Deterministic() = false;
+  batchNorm.Forward(input, trainingOutput);
+
+  // Reference result from applying the chain layer by layer in deterministic
+  // mode; the dropout stage is the identity at inference time.
+  arma::mat reference;
+  batchNorm.Deterministic() = true;
+  batchNorm.Forward(input, reference);
+  reference.transform([](double x) { return std::max(x, 0.0); });
+
+  FusedElementwise<> fused =
+      FusedElementwise<>::FromBatchNorm(batchNorm, true);
+  REQUIRE(fused.InputSize() == input.n_rows);
+  REQUIRE(fused.ApplyReLU() == true);
+
+  arma::mat output;
+  fused.Forward(input, output);
+  CheckMatrices(output, reference, 1e-8);
+
+  // Without the ReLU, the fused layer must match the batch normalization
+  // exactly.
+  batchNorm.Forward(input, reference);
+  FusedElementwise<> affineOnly =
+      FusedElementwise<>::FromBatchNorm(batchNorm, false);
+  affineOnly.Forward(input, output);
+  CheckMatrices(output, reference, 1e-8);
+
+  // Mismatched scale and shift lengths must be rejected.
+  REQUIRE_THROWS_AS(FusedElementwise<>(arma::ones<arma::vec>(3),
+      arma::ones<arma::vec>(4), true), std::invalid_argument);
+}
+
+/**
+ * The flat-GEMM Linear3D implementation must match an explicit per-slice
+ * computation of the forward pass, the backward pass and the gradient.
+ */
+TEST_CASE("Linear3DPerSliceEquivalenceTest", "[ANNLayerTest]")
+{
+  const size_t inSize = 5;
+  const size_t outSize = 3;
+  const size_t nPoints = 7;
+  const size_t batchSize = 4;
+
+  Linear3D<> module(inSize, outSize);
+  module.Reset();
+  module.Parameters().randu();
+
+  const arma::mat weight = module.Weight();
+  const arma::vec bias = module.Bias();
+
+  const arma::mat input = arma::randu(inSize * nPoints, batchSize);
+  const arma::mat error = arma::randu(outSize * nPoints, batchSize);
+
+  // Forward pass, one slice at a time.
+  arma::mat expectedOutput(outSize * nPoints, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    arma::mat inputSlice(const_cast<arma::mat&>(input).colptr(i), inSize,
+        nPoints, false, false);
+    arma::mat z = weight * inputSlice;
+    z.each_col() += bias;
+    expectedOutput.col(i) = arma::vectorise(z);
+  }
+
+  arma::mat output;
+  module.Forward(input, output);
+  CheckMatrices(output, expectedOutput, 1e-10);
+
+  // Backward pass, one slice at a time.
+  arma::mat expectedDelta(inSize * nPoints, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    arma::mat errorSlice(const_cast<arma::mat&>(error).colptr(i), outSize,
+        nPoints, false, false);
+    expectedDelta.col(i) = arma::vectorise(weight.t() * errorSlice);
+  }
+
+  arma::mat delta;
+  module.Backward(input, error, delta);
+  CheckMatrices(delta, expectedDelta, 1e-10);
+
+  // Gradient, one slice at a time.
+  arma::mat dW(outSize, inSize, arma::fill::zeros);
+  arma::vec dB(outSize, arma::fill::zeros);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    arma::mat inputSlice(const_cast<arma::mat&>(input).colptr(i), inSize,
+        nPoints, false, false);
+    arma::mat errorSlice(const_cast<arma::mat&>(error).colptr(i), outSize,
+        nPoints, false, false);
+    dW += errorSlice * inputSlice.t();
+    dB += arma::sum(errorSlice, 1);
+  }
+  arma::mat expectedGradient(outSize * inSize + outSize, 1);
+  expectedGradient.submat(0, 0, outSize * inSize - 1, 0) =
+      arma::vectorise(dW);
+  expectedGradient.submat(outSize * inSize, 0, expectedGradient.n_elem - 1, 0)
+      = dB;
+
+  arma::mat gradient;
+  module.Gradient(input, error, gradient);
+  CheckMatrices(gradient, expectedGradient, 1e-10);
+}
@@ -14,6 +14,8 @@
 #include <mlpack/methods/ann/visitor/bias_set_visitor.hpp>
 #include <mlpack/methods/ann/visitor/weight_set_visitor.hpp>
 #include <mlpack/methods/ann/visitor/reset_visitor.hpp>
+#include <mlpack/methods/ann/visitor/restore_output_parameter_visitor.hpp>
+#include <mlpack/methods/ann/visitor/store_output_parameter_visitor.hpp>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -233,3 +235,57 @@ TEST_CASE("WeightSizeVisitorTestForMultiheadAttentionLayer", "[ANNVisitorTest]")
 
   CheckCorrectnessOfWeightSize(MultiheadAttentionLayer);
 }
+
+/**
+ * Test that StoreOutputParameterVisitor and RestoreOutputParameterVisitor
+ * behave like the save/load visitors but reuse the workspace in place.
+ */
+TEST_CASE("StoreRestoreOutputParameterVisitorTest", "[ANNVisitorTest]")
+{
+  LayerTypes<> sigmoid = new SigmoidLayer<>();
+
+  std::vector<arma::mat> workspace;
+  size_t position = 0;
+
+  // Store the output parameters of two "timesteps".
+  arma::mat firstOutput = arma::randu(5, 3);
+  boost::apply_visitor(OutputParameterVisitor(), sigmoid) = firstOutput;
+  boost::apply_visitor(StoreOutputParameterVisitor(workspace, position),
+      sigmoid);
+
+  arma::mat secondOutput = arma::randu(5, 3);
+  boost::apply_visitor(OutputParameterVisitor(), sigmoid) = secondOutput;
+  boost::apply_visitor(StoreOutputParameterVisitor(workspace, position),
+      sigmoid);
+
+  REQUIRE(position == 2);
+  REQUIRE(workspace.size() == 2);
+
+  // Restore in LIFO order, like the BPTT backward pass.
+  boost::apply_visitor(RestoreOutputParameterVisitor(workspace, position),
+      sigmoid);
+  CheckMatrices(boost::apply_visitor(OutputParameterVisitor(), sigmoid),
+      secondOutput);
+
+  boost::apply_visitor(RestoreOutputParameterVisitor(workspace, position),
+      sigmoid);
+  CheckMatrices(boost::apply_visitor(OutputParameterVisitor(), sigmoid),
+      firstOutput);
+
+  REQUIRE(position == 0);
+
+  // Unlike the load visitor, restoring keeps the workspace entries alive,
+  // and storing again overwrites them without growing the workspace.
+  REQUIRE(workspace.size() == 2);
+  const double* firstEntryMemory = workspace[0].memptr();
+
+  boost::apply_visitor(OutputParameterVisitor(), sigmoid) = secondOutput;
+  boost::apply_visitor(StoreOutputParameterVisitor(workspace, position),
+      sigmoid);
+
+  REQUIRE(workspace.size() == 2);
+  REQUIRE(workspace[0].memptr() == firstEntryMemory);
+  CheckMatrices(workspace[0], secondOutput);
+
+  boost::apply_visitor(DeleteVisitor(), sigmoid);
+}
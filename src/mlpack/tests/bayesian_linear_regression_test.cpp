@@ -193,3 +193,70 @@ TEST_CASE("EqualtoRidge", "[BayesianLinearRegressionTest]")
 
   REQUIRE(trial <= 3);
 }
+
+// Sliding a window with AddPoint()/RemovePoint() and calling Retrain() must
+// give the same model as a full Train() on the window's data.
+TEST_CASE("IncrementalSlidingWindowTest", "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  size_t nDims = 10, nPoints = 120, window = 100;
+
+  GenerateProblem(matX, y, nPoints, nDims, 0.5);
+
+  // Train on the initial window, then slide it to the end one point at a
+  // time.
+  BayesianLinearRegression incremental(false, false);
+  incremental.Train(matX.cols(0, window - 1), y.subvec(0, window - 1));
+
+  for (size_t i = window; i < nPoints; ++i)
+  {
+    incremental.RemovePoint(matX.col(i - window), y[i - window]);
+    incremental.AddPoint(matX.col(i), y[i]);
+    incremental.Retrain();
+  }
+
+  // Reference: a fresh fit on the final window.
+  BayesianLinearRegression batch(false, false);
+  batch.Train(matX.cols(nPoints - window, nPoints - 1),
+      y.subvec(nPoints - window, nPoints - 1));
+
+  // Both fits stop on the same relative tolerance, so agreement is checked
+  // a little looser than the stopping criterion.
+  REQUIRE(incremental.Alpha() == Approx(batch.Alpha()).epsilon(5e-3));
+  REQUIRE(incremental.Beta() == Approx(batch.Beta()).epsilon(5e-3));
+  for (size_t i = 0; i < nDims; ++i)
+    REQUIRE(incremental.Omega()[i] == Approx(batch.Omega()[i]).margin(1e-4));
+
+  // Predictions (with uncertainties) from both models must agree.
+  arma::rowvec predIncremental, predBatch, stdIncremental, stdBatch;
+  incremental.Predict(matX, predIncremental, stdIncremental);
+  batch.Predict(matX, predBatch, stdBatch);
+  for (size_t i = 0; i < nPoints; ++i)
+  {
+    REQUIRE(predIncremental[i] == Approx(predBatch[i]).margin(1e-4));
+    REQUIRE(stdIncremental[i] == Approx(stdBatch[i]).margin(1e-4));
+  }
+}
+
+// Building the statistics purely from AddPoint() must match Train().
+TEST_CASE("IncrementalFromScratchTest", "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  size_t nDims = 8, nPoints = 60;
+
+  GenerateProblem(matX, y, nPoints, nDims, 0.5);
+
+  BayesianLinearRegression incremental(false, false);
+  for (size_t i = 0; i < nPoints; ++i)
+    incremental.AddPoint(matX.col(i), y[i]);
+  const double rmseIncremental = incremental.Retrain();
+
+  BayesianLinearRegression batch(false, false);
+  const double rmseBatch = batch.Train(matX, y);
+
+  REQUIRE(rmseIncremental == Approx(rmseBatch).epsilon(1e-5));
+  for (size_t i = 0; i < nDims; ++i)
+    REQUIRE(incremental.Omega()[i] == Approx(batch.Omega()[i]).margin(1e-6));
+}
@@ -14,6 +14,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/cf/cf.hpp>
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/parallel_als_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/regularized_svd_method.hpp>
@@ -32,6 +33,7 @@
 #include <mlpack/methods/cf/interpolation_policies/average_interpolation.hpp>
 #include <mlpack/methods/cf/interpolation_policies/similarity_interpolation.hpp>
 #include <mlpack/methods/cf/interpolation_policies/regression_interpolation.hpp>
+#include <mlpack/methods/cf/cf_model.hpp>
 
 #include <iostream>
 
@@ -553,6 +555,15 @@ TEST_CASE("CFGetRecommendationsAllUsersNMFTest", "[CFTest]")
   GetRecommendationsAllUsers<NMFPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for parallel ALS.
+ */
+TEST_CASE("CFGetRecommendationsAllUsersParallelALSTest", "[CFTest]")
+{
+  GetRecommendationsAllUsers<ParallelALSPolicy>();
+}
+
 /**
  * Make sure that correct number of recommendations are generated when query
  * set for SVD Complete Incremental method.
@@ -761,6 +772,12 @@ TEST_CASE("CFPredictNMFTest", "[CFTest]")
   CFPredict<NMFPolicy>();
 }
 
+// Make sure that Predict() is returning reasonable results for parallel ALS.
+TEST_CASE("CFPredictParallelALSTest", "[CFTest]")
+{
+  CFPredict<ParallelALSPolicy>();
+}
+
 /**
  * Make sure that Predict() is returning reasonable results for SVD Complete
  * Incremental method.
@@ -1237,3 +1254,260 @@ TEST_CASE("CFPredictRegressionInterpolation", "[CFTest]")
             EuclideanSearch,
             RegressionInterpolation>(2.2);
 }
+
+/**
+ * Make sure that folding in a new user appends a latent vector and ratings,
+ * and that the model can be refactorized afterwards.
+ */
+TEST_CASE("CFFoldInUserTest", "[CFTest]")
+{
+  NMFPolicy decomposition;
+
+  // Load GroupLens data.
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<NMFPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  const size_t numUsers = c.Decomposition().H().n_cols;
+  const size_t numItems = c.Decomposition().W().n_rows;
+
+  // Fold in a new user with a handful of ratings.
+  arma::Col<size_t> items("0 1 2 3 4");
+  arma::vec ratings("5 4 3 4 5");
+  const size_t newUser = c.FoldInUser(items, ratings);
+
+  REQUIRE(newUser == numUsers);
+  REQUIRE(c.Decomposition().H().n_cols == numUsers + 1);
+  REQUIRE(c.CleanedData().n_cols == numUsers + 1);
+  REQUIRE(c.FoldInPending() == true);
+
+  // The folded-in user's predictions must be well defined.
+  for (size_t i = 0; i < 5; ++i)
+    REQUIRE(std::isfinite(c.Predict(newUser, i)));
+
+  // Recommendations must be generated for the new user too.
+  arma::Mat<size_t> recommendations;
+  arma::Col<size_t> users(1);
+  users(0) = newUser;
+  c.GetRecommendations(3, recommendations, users);
+  REQUIRE(recommendations.n_rows == 3);
+  REQUIRE(recommendations.n_cols == 1);
+
+  // Now fold in a new item rated by a few users.
+  arma::Col<size_t> raters("0 1 2");
+  arma::vec itemRatings("4 4 4");
+  const size_t newItem = c.FoldInItem(raters, itemRatings);
+
+  REQUIRE(newItem == numItems);
+  REQUIRE(c.Decomposition().W().n_rows == numItems + 1);
+  REQUIRE(c.CleanedData().n_rows == numItems + 1);
+
+  // A batch refactorization incorporates the new user and item.
+  c.Refactorize(5, 1e-5, true);
+  REQUIRE(c.FoldInPending() == false);
+  REQUIRE(std::isfinite(c.Predict(newUser, newItem)));
+}
+
+/**
+ * Fold-in with inconsistent input sizes must be rejected.
+ */
+TEST_CASE("CFFoldInValidationTest", "[CFTest]")
+{
+  NMFPolicy decomposition;
+
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<NMFPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  arma::Col<size_t> items("0 1 2");
+  arma::vec ratings("5 4");
+  REQUIRE_THROWS_AS(c.FoldInUser(items, ratings), std::invalid_argument);
+  REQUIRE_THROWS_AS(c.FoldInItem(items, ratings), std::invalid_argument);
+  REQUIRE(c.FoldInPending() == false);
+}
+
+/**
+ * Make sure that a materialized neighbor cache gives the same predictions
+ * and recommendations as a fresh neighbor search, and that it is invalidated
+ * by retraining.
+ */
+TEST_CASE("CFNeighborCacheTest", "[CFTest]")
+{
+  NMFPolicy decomposition;
+
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<NMFPolicy> c(dataset, decomposition, 5, 5, 30);
+  REQUIRE(c.NeighborCacheValid() == false);
+
+  // Uncached results first.
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(3, recommendations);
+  arma::vec predictions(10);
+  for (size_t i = 0; i < 10; ++i)
+    predictions(i) = c.Predict(i, i);
+
+  c.BuildNeighborCache();
+  REQUIRE(c.NeighborCacheValid() == true);
+
+  // The cache holds exactly the neighborhoods the fresh search would
+  // compute, so the results must be identical.
+  arma::Mat<size_t> cachedRecommendations;
+  c.GetRecommendations(3, cachedRecommendations);
+  for (size_t i = 0; i < recommendations.n_elem; ++i)
+    REQUIRE(recommendations(i) == cachedRecommendations(i));
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(c.Predict(i, i) == Approx(predictions(i)).epsilon(1e-10));
+
+  // A folded-in user is not covered by the cache; predictions for them fall
+  // back to a fresh search until the cache is refreshed.
+  arma::Col<size_t> items("0 1 2 3 4");
+  arma::vec ratings("5 4 3 4 5");
+  const size_t newUser = c.FoldInUser(items, ratings);
+  REQUIRE(c.NeighborCacheValid() == true);
+  REQUIRE(std::isfinite(c.Predict(newUser, 0)));
+
+  arma::Col<size_t> newUsers(1);
+  newUsers(0) = newUser;
+  c.UpdateNeighborCache(newUsers);
+  REQUIRE(std::isfinite(c.Predict(newUser, 0)));
+
+  // Retraining invalidates the cache.
+  c.Train(dataset, decomposition, 5, 1e-5, true);
+  REQUIRE(c.NeighborCacheValid() == false);
+}
+
+/**
+ * Make sure the hot (serving) and cold (training) parts of a CFType model can
+ * be serialized independently, and that loading both parts reconstructs the
+ * full model.
+ */
+TEST_CASE("CFHotColdSerializationTest", "[CFTest]")
+{
+  NMFPolicy decomposition;
+
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<NMFPolicy> c(dataset, decomposition, 5, 5, 30);
+  c.BuildNeighborCache();
+
+  // Save the two parts to separate archives.
+  std::ostringstream hotStream, coldStream;
+  {
+    cereal::BinaryOutputArchive hotAr(hotStream);
+    c.SerializeHot(hotAr);
+    cereal::BinaryOutputArchive coldAr(coldStream);
+    c.SerializeCold(coldAr);
+  }
+
+  // A serving instance loads only the hot part: the item factors and the
+  // neighbor cache are available, but the user factors are not.
+  CFType<NMFPolicy> serving;
+  {
+    std::istringstream hotIn(hotStream.str());
+    cereal::BinaryInputArchive hotAr(hotIn);
+    serving.SerializeHot(hotAr);
+  }
+
+  REQUIRE(serving.NumUsersForSimilarity() == c.NumUsersForSimilarity());
+  REQUIRE(serving.Rank() == c.Rank());
+  REQUIRE(serving.NeighborCacheValid() == true);
+  CheckMatrices(serving.Decomposition().W(), c.Decomposition().W());
+  REQUIRE(serving.Decomposition().H().n_elem == 0);
+  REQUIRE(serving.CleanedData().n_nonzero == 0);
+
+  // Loading the cold part on top reconstructs the full model.
+  {
+    std::istringstream coldIn(coldStream.str());
+    cereal::BinaryInputArchive coldAr(coldIn);
+    serving.SerializeCold(coldAr);
+  }
+
+  CheckMatrices(serving.Decomposition().H(), c.Decomposition().H());
+  REQUIRE(serving.CleanedData().n_nonzero == c.CleanedData().n_nonzero);
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(serving.Predict(i, i) == Approx(c.Predict(i, i)).epsilon(1e-10));
+}
+
+/**
+ * Make sure partitioned serialization also works through the type-erased
+ * CFModel wrapper, including loading the hot and cold parts into the same
+ * model one after the other.
+ */
+TEST_CASE("CFModelHotColdSerializationTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFModel m;
+  m.DecompositionType() = CFModel::NMF;
+  m.NormalizationType() = CFModel::NO_NORMALIZATION;
+  m.Train(dataset, 5, 5, 30, 1e-5, false);
+
+  typedef CFWrapper<NMFPolicy, NoNormalization> WrapperType;
+  WrapperType& trained = dynamic_cast<WrapperType&>(*m.CF());
+
+  std::ostringstream hotStream, coldStream;
+  {
+    cereal::BinaryOutputArchive hotAr(hotStream);
+    m.SerializeHot(hotAr);
+    cereal::BinaryOutputArchive coldAr(coldStream);
+    m.SerializeCold(coldAr);
+  }
+
+  // The hot part alone must initialize a wrapper of the right type and fill
+  // in the item factors.
+  CFModel serving;
+  {
+    std::istringstream hotIn(hotStream.str());
+    cereal::BinaryInputArchive hotAr(hotIn);
+    serving.SerializeHot(hotAr);
+  }
+
+  REQUIRE(serving.DecompositionType() == CFModel::NMF);
+  REQUIRE(serving.NormalizationType() == CFModel::NO_NORMALIZATION);
+  WrapperType& hotLoaded = dynamic_cast<WrapperType&>(*serving.CF());
+  CheckMatrices(hotLoaded.CF().Decomposition().W(),
+      trained.CF().Decomposition().W());
+  REQUIRE(hotLoaded.CF().Decomposition().H().n_elem == 0);
+
+  // Loading the cold part must reuse the wrapper the hot part initialized,
+  // completing the model instead of wiping it.
+  {
+    std::istringstream coldIn(coldStream.str());
+    cereal::BinaryInputArchive coldAr(coldIn);
+    serving.SerializeCold(coldAr);
+  }
+
+  WrapperType& fullLoaded = dynamic_cast<WrapperType&>(*serving.CF());
+  CheckMatrices(fullLoaded.CF().Decomposition().W(),
+      trained.CF().Decomposition().W());
+  CheckMatrices(fullLoaded.CF().Decomposition().H(),
+      trained.CF().Decomposition().H());
+
+  arma::Mat<size_t> combinations(2, 10);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    combinations(0, i) = i;
+    combinations(1, i) = i;
+  }
+  arma::vec predictions, servingPredictions;
+  m.Predict(EUCLIDEAN_SEARCH, AVERAGE_INTERPOLATION, combinations,
+      predictions);
+  serving.Predict(EUCLIDEAN_SEARCH, AVERAGE_INTERPOLATION, combinations,
+      servingPredictions);
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+  {
+    REQUIRE(servingPredictions(i) ==
+        Approx(predictions(i)).epsilon(1e-10));
+  }
+}
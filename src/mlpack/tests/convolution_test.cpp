@@ -15,7 +15,9 @@
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/autotuned_convolution.hpp>
 
 #include "serialization.hpp"
 #include "catch.hpp"
@@ -140,6 +142,10 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   Convolution2DMethodTest<NaiveConvolution<ValidConvolution> >(input, filter,
       output);
 
+  // Perform the convolution using the im2col unrolling and a matrix product.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input, filter,
+      output);
+
   // Perform the convolution trough fft.
   Convolution2DMethodTest<FFTConvolution<ValidConvolution> >(input, filter,
       output);
@@ -148,6 +154,10 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution with whichever rule the autotuner binds.
+  Convolution2DMethodTest<AutotunedConvolution<ValidConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -177,6 +187,10 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output);
 
+  // Perform the convolution using the im2col unrolling and a matrix product.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output);
+
   // Perform the convolution trough fft.
   Convolution2DMethodTest<FFTConvolution<FullConvolution> >(input, filter,
       output);
@@ -185,6 +199,10 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution with whichever rule the autotuner binds.
+  Convolution2DMethodTest<AutotunedConvolution<FullConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -222,6 +240,10 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   Convolution3DMethodTest<NaiveConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
 
+  // Perform the convolution using the im2col unrolling and a matrix product.
+  Convolution3DMethodTest<Im2ColConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   Convolution3DMethodTest<FFTConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
@@ -230,6 +252,10 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution with whichever rule the autotuner binds.
+  Convolution3DMethodTest<AutotunedConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -271,6 +297,10 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   Convolution3DMethodTest<NaiveConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
 
+  // Perform the convolution using the im2col unrolling and a matrix product.
+  Convolution3DMethodTest<Im2ColConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   Convolution3DMethodTest<FFTConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
@@ -279,6 +309,10 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution with whichever rule the autotuner binds.
+  Convolution3DMethodTest<AutotunedConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -313,6 +347,10 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   ConvolutionMethodBatchTest<NaiveConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
 
+  // Perform the convolution using the im2col unrolling and a matrix product.
+  ConvolutionMethodBatchTest<Im2ColConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   ConvolutionMethodBatchTest<FFTConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
@@ -321,6 +359,10 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution with whichever rule the autotuner binds.
+  ConvolutionMethodBatchTest<AutotunedConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -359,6 +401,10 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   ConvolutionMethodBatchTest<NaiveConvolution<FullConvolution> >(input,
       filterCube, outputCube);
 
+  // Perform the convolution using the im2col unrolling and a matrix product.
+  ConvolutionMethodBatchTest<Im2ColConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   ConvolutionMethodBatchTest<FFTConvolution<FullConvolution> >(input,
       filterCube, outputCube);
@@ -367,4 +413,45 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution with whichever rule the autotuner binds.
+  ConvolutionMethodBatchTest<AutotunedConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+}
+
+/**
+ * Test that the im2col convolution matches the naive convolution for strided
+ * and dilated filter application.
+ */
+TEST_CASE("Im2ColStridedDilatedConvolutionTest", "[ConvolutionTest]")
+{
+  arma::mat input(16, 16, arma::fill::randu);
+  arma::mat filter(3, 3, arma::fill::randu);
+
+  for (size_t stride = 1; stride <= 2; ++stride)
+  {
+    for (size_t dilation = 1; dilation <= 2; ++dilation)
+    {
+      arma::mat naiveOutput, im2colOutput;
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter,
+          naiveOutput, stride, stride, dilation, dilation);
+      Im2ColConvolution<ValidConvolution>::Convolution(input, filter,
+          im2colOutput, stride, stride, dilation, dilation);
+
+      REQUIRE(naiveOutput.n_rows == im2colOutput.n_rows);
+      REQUIRE(naiveOutput.n_cols == im2colOutput.n_cols);
+      for (size_t i = 0; i < naiveOutput.n_elem; ++i)
+        REQUIRE(naiveOutput[i] == Approx(im2colOutput[i]).epsilon(1e-10));
+
+      NaiveConvolution<FullConvolution>::Convolution(input, filter,
+          naiveOutput, stride, stride, dilation, dilation);
+      Im2ColConvolution<FullConvolution>::Convolution(input, filter,
+          im2colOutput, stride, stride, dilation, dilation);
+
+      REQUIRE(naiveOutput.n_rows == im2colOutput.n_rows);
+      REQUIRE(naiveOutput.n_cols == im2colOutput.n_cols);
+      for (size_t i = 0; i < naiveOutput.n_elem; ++i)
+        REQUIRE(naiveOutput[i] == Approx(im2colOutput[i]).epsilon(1e-10));
+    }
+  }
 }
@@ -13,6 +13,7 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/cv/metrics/accuracy.hpp>
+#include <mlpack/core/cv/metrics/classification_metrics.hpp>
 #include <mlpack/core/cv/metrics/f1.hpp>
 #include <mlpack/core/cv/metrics/mse.hpp>
 #include <mlpack/core/cv/metrics/precision.hpp>
@@ -779,3 +780,161 @@ TEST_CASE("SilhouetteScoreTest", "[CVTest]")
   double silhouetteScore = SilhouetteScore::Overall(X, labels, metric);
   REQUIRE(silhouetteScore == Approx(0.1121684822489150).epsilon(1e-7));
 }
+
+/**
+ * Parallel fold execution must give the same scores as the sequential loop,
+ * and the memory-budget knob must cap (but never zero out) concurrency.
+ */
+TEST_CASE("KFoldCVParallelEvaluationTest", "[CVTest]")
+{
+  // A noisy linear relationship; LinearRegression training is deterministic,
+  // so serial and parallel fold execution must agree exactly.
+  arma::mat data = arma::randu<arma::mat>(5, 500);
+  arma::rowvec responses = 3.0 * data.row(0) - 2.0 * data.row(3) +
+      0.01 * arma::randu<arma::rowvec>(500);
+
+  KFoldCV<LinearRegression, MSE> serialCV(10, data, responses, false);
+  const double serialScore = serialCV.Evaluate();
+
+  KFoldCV<LinearRegression, MSE> parallelCV(10, data, responses, false);
+  parallelCV.Parallel() = true;
+  REQUIRE(parallelCV.Evaluate() == Approx(serialScore).epsilon(1e-10));
+
+  // The knobs must not change the result, only the concurrency.
+  KFoldCV<LinearRegression, MSE> cappedCV(10, data, responses, false);
+  cappedCV.Parallel() = true;
+  cappedCV.MaxConcurrentFolds() = 2;
+  // Budget for roughly one fold's training subset.
+  cappedCV.MemoryBudget() = 5 * 450 * sizeof(double);
+  REQUIRE(cappedCV.Evaluate() == Approx(serialScore).epsilon(1e-10));
+
+  // The trained model must still be available afterwards.
+  REQUIRE_NOTHROW(parallelCV.Model());
+}
+
+/**
+ * The in-place Shuffle() must keep the extended matrices consistent: an
+ * exactly fittable linear relationship must still be fit perfectly by every
+ * fold after shuffling, for both even and uneven bin sizes.
+ */
+TEST_CASE("KFoldCVInPlaceShuffleTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 103);
+  arma::rowvec responses = 2.0 * data.row(0) - data.row(1) + 4.0;
+
+  // k = 5 gives uneven bins (103 = 4 * 20 + 23); k = 2 has no duplicated
+  // prefix at all.
+  for (size_t k = 2; k <= 5; k += 3)
+  {
+    KFoldCV<LinearRegression, MSE> cv(k, data, responses, false);
+    cv.Shuffle();
+    // If the shuffle left the duplicated prefix stale or mixed up columns
+    // between data and responses, some fold would no longer fit exactly.
+    REQUIRE(cv.Evaluate() == Approx(0.0).margin(1e-10));
+  }
+}
+
+/**
+ * Test that the one-pass composite metric agrees with the individual metric
+ * classes for binary classification, and check its MCC value by hand.
+ */
+TEST_CASE("ClassificationMetricsBinaryTest", "[CVTest]")
+{
+  // Using the same data for training and testing.
+  arma::mat data = arma::linspace<arma::rowvec>(1.0, 10.0, 10);
+
+  // Labels that will be considered as "ground truth".
+  arma::Row<size_t> labels("0 0 1 0 0  1 0 1 0 1");
+
+  // Labels that make the data linearly separable. These labels will be
+  // predicted in response to the data since we use them for training.
+  arma::Row<size_t> predictedLabels("0 0 0 0 0  1 1 1 1 1");
+
+  LogisticRegression<> lr(data, predictedLabels);
+
+  ClassificationMetrics<Binary>::Summary summary =
+      ClassificationMetrics<Binary>::Measure(lr, data, labels);
+
+  REQUIRE(summary.accuracy
+          == Approx(Accuracy::Evaluate(lr, data, labels)).epsilon(1e-7));
+  REQUIRE(summary.precision
+          == Approx(Precision<Binary>::Evaluate(lr, data, labels)).epsilon(
+              1e-7));
+  REQUIRE(summary.recall
+          == Approx(Recall<Binary>::Evaluate(lr, data, labels)).epsilon(1e-7));
+  REQUIRE(summary.f1
+          == Approx(F1<Binary>::Evaluate(lr, data, labels)).epsilon(1e-7));
+
+  // tp = 3, tn = 4, fp = 2, fn = 1.
+  double expectedMCC = (3.0 * 4 - 2.0 * 1) /
+      std::sqrt((3.0 + 2) * (3.0 + 1) * (4.0 + 2) * (4.0 + 1));
+  REQUIRE(summary.mcc == Approx(expectedMCC).epsilon(1e-7));
+
+  // Evaluate() exposes the F1 value of the summary.
+  REQUIRE(ClassificationMetrics<Binary>::Evaluate(lr, data, labels)
+          == Approx(summary.f1).epsilon(1e-7));
+}
+
+/**
+ * Test that the one-pass composite metric agrees with the individual metric
+ * classes for multiclass classification under both averaging strategies.
+ */
+TEST_CASE("ClassificationMetricsMulticlassTest", "[CVTest]")
+{
+  // Using the same data for training and testing.
+  arma::mat data = arma::linspace<arma::rowvec>(1.0, 12.0, 12);
+
+  // Labels that will be considered as "ground truth".
+  arma::Row<size_t> labels("0 1  0 1  2 2 1 2  3 3 3 3");
+
+  // These labels should be predicted in response to the data since we use them
+  // for training.
+  arma::Row<size_t> predictedLabels("0 0  1 1  2 2 2 2  3 3 3 3");
+  size_t numClasses = 4;
+
+  NaiveBayesClassifier<> nb(data, predictedLabels, numClasses);
+
+  ClassificationMetrics<Micro>::Summary micro =
+      ClassificationMetrics<Micro>::Measure(nb, data, labels);
+  REQUIRE(micro.accuracy
+          == Approx(Accuracy::Evaluate(nb, data, labels)).epsilon(1e-7));
+  REQUIRE(micro.precision
+          == Approx(Precision<Micro>::Evaluate(nb, data, labels)).epsilon(
+              1e-7));
+  REQUIRE(micro.recall
+          == Approx(Recall<Micro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+  REQUIRE(micro.f1
+          == Approx(F1<Micro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+
+  ClassificationMetrics<Macro>::Summary macro =
+      ClassificationMetrics<Macro>::Measure(nb, data, labels);
+  REQUIRE(macro.precision
+          == Approx(Precision<Macro>::Evaluate(nb, data, labels)).epsilon(
+              1e-7));
+  REQUIRE(macro.recall
+          == Approx(Recall<Macro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+  REQUIRE(macro.f1
+          == Approx(F1<Macro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+
+  // The multiclass MCC does not depend on the averaging strategy.
+  REQUIRE(micro.mcc == Approx(macro.mcc).epsilon(1e-7));
+  REQUIRE(micro.mcc >= -1.0);
+  REQUIRE(micro.mcc <= 1.0);
+}
+
+/**
+ * Test k-fold cross-validation with the one-pass composite metric.
+ */
+TEST_CASE("KFoldCVClassificationMetricsTest", "[CVTest]")
+{
+  // Each fold will be filled with this easily separable dataset.
+  arma::mat data("0 1 100 101  0 1 100 101");
+  arma::Row<size_t> labels("0 0 1 1  0 0 1 1");
+  size_t numClasses = 2;
+
+  // 2-fold cross-validation, no shuffling; each half is classified perfectly.
+  KFoldCV<NaiveBayesClassifier<>, ClassificationMetrics<Binary>> cv(2, data,
+      labels, numClasses, false);
+
+  REQUIRE(cv.Evaluate() == Approx(1.0).epsilon(1e-7));
+}
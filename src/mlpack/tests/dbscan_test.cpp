@@ -306,3 +306,72 @@ TEST_CASE("RandomPointSelectionTest", "[DBSCANTest]")
   // The number of assignments returned should be the same as points.
   REQUIRE(assignments.n_elem == points.n_cols);
 }
+
+TEST_CASE("GridRangeSearchTest", "[DBSCANTest]")
+{
+  // The grid-based range search must return exactly the same neighbors as a
+  // naive scan.
+  arma::mat points(3, 500, arma::fill::randu);
+  const double epsilon = 0.12;
+
+  GridRangeSearch<> grid;
+  grid.Train(points);
+
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<double>> distances;
+  grid.Search(points, math::Range(0.0, epsilon), neighbors, distances);
+
+  metric::EuclideanDistance metric;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    // Compute the neighbors naively.
+    std::vector<size_t> naiveNeighbors;
+    for (size_t j = 0; j < points.n_cols; ++j)
+    {
+      if (metric.Evaluate(points.col(i), points.col(j)) <= epsilon)
+        naiveNeighbors.push_back(j);
+    }
+
+    REQUIRE(neighbors[i].size() == naiveNeighbors.size());
+
+    std::vector<size_t> gridNeighbors(neighbors[i]);
+    std::sort(gridNeighbors.begin(), gridNeighbors.end());
+    for (size_t j = 0; j < naiveNeighbors.size(); ++j)
+      REQUIRE(gridNeighbors[j] == naiveNeighbors[j]);
+  }
+}
+
+TEST_CASE("GridDBSCANTest", "[DBSCANTest]")
+{
+  // DBSCAN with the grid-based range search must produce the same clustering
+  // as DBSCAN with the default tree-based range search.
+  arma::mat points(2, 800, arma::fill::randu);
+  // Spread the points into a few groups.
+  for (size_t i = 0; i < points.n_cols; ++i)
+    points(0, i) += 3.0 * (i % 4);
+
+  DBSCAN<> d(0.1, 5);
+  DBSCAN<GridRangeSearch<>> gridD(0.1, 5);
+
+  arma::Row<size_t> assignments, gridAssignments;
+  const size_t clusters = d.Cluster(points, assignments);
+  const size_t gridClusters = gridD.Cluster(points, gridAssignments);
+
+  REQUIRE(clusters == gridClusters);
+
+  // The clusterings must be identical up to a relabeling of the clusters.
+  std::vector<size_t> labelMap(clusters, SIZE_MAX);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (assignments[i] == SIZE_MAX)
+    {
+      REQUIRE(gridAssignments[i] == SIZE_MAX);
+      continue;
+    }
+
+    REQUIRE(gridAssignments[i] != SIZE_MAX);
+    if (labelMap[assignments[i]] == SIZE_MAX)
+      labelMap[assignments[i]] = gridAssignments[i];
+    REQUIRE(labelMap[assignments[i]] == gridAssignments[i]);
+  }
+}
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/decision_tree/decision_tree_regressor.hpp>
+#include <mlpack/methods/decision_tree/binary_categorical_split.hpp>
 #include <mlpack/methods/decision_tree/mad_gain.hpp>
 #include <mlpack/methods/decision_tree/mse_gain.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
@@ -1100,3 +1101,136 @@ TEST_CASE("WeightedDecisionTreeMADGainTest", "[DecisionTreeRegressorTest]")
   double rmse = RMSE(predictions, testResponses);
   REQUIRE(rmse < 6.5);
 }
+
+/**
+ * Check that the BinaryCategoricalSplit will find the optimal two-way grouping
+ * of categories on an obviously splittable dimension.  MSEGain provides the
+ * optimized binary scan forms, so this exercises the optimized overload.
+ */
+TEST_CASE("BinaryCategoricalSplitSimpleSplitTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors = {0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3};
+  arma::rowvec responses = {5, 5, 5, 100, 100, 100, 100, 100, 100, 5, 5, 5};
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  double splitInfo;
+  BinaryCategoricalSplit<MSEGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MSEGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain = BinaryCategoricalSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, predictors, 4, responses, weights, 3, 1e-7, splitInfo, aux, f);
+  const double weightedGain =
+      BinaryCategoricalSplit<MSEGain>::SplitIfBetter<true>(bestGain,
+      predictors, 4, responses, weights, 3, 1e-7, splitInfo, aux, f);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // The categories can be perfectly grouped into two children, so the gain
+  // should be 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  REQUIRE(gain == weightedGain);
+
+  // Make sure that splitInfo now holds the number of children (always 2).
+  REQUIRE((size_t) splitInfo == 2);
+
+  // Categories 0 and 3 (mean response 5) must go to one child, and categories
+  // 1 and 2 (mean response 100) to the other.
+  REQUIRE(aux.CategoryDirections().n_elem == 4);
+  REQUIRE(aux.CategoryDirections()[0] == aux.CategoryDirections()[3]);
+  REQUIRE(aux.CategoryDirections()[1] == aux.CategoryDirections()[2]);
+  REQUIRE(aux.CategoryDirections()[0] != aux.CategoryDirections()[1]);
+}
+
+/**
+ * Check that the BinaryCategoricalSplit works with MADGain too, which does not
+ * provide the optimized binary scan forms and so exercises the generic
+ * overload.
+ */
+TEST_CASE("BinaryCategoricalSplitMADGainSplitTest",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors = {0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3};
+  arma::rowvec responses = {5, 5, 5, 100, 100, 100, 100, 100, 100, 5, 5, 5};
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  double splitInfo;
+  BinaryCategoricalSplit<MADGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MADGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain = BinaryCategoricalSplit<MADGain>::SplitIfBetter<false>(
+      bestGain, predictors, 4, responses, weights, 3, 1e-7, splitInfo, aux, f);
+
+  // Make sure that a split was made, and that it is perfect.
+  REQUIRE(gain > bestGain);
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+  REQUIRE((size_t) splitInfo == 2);
+  REQUIRE(aux.CategoryDirections()[0] == aux.CategoryDirections()[3]);
+  REQUIRE(aux.CategoryDirections()[1] == aux.CategoryDirections()[2]);
+  REQUIRE(aux.CategoryDirections()[0] != aux.CategoryDirections()[1]);
+}
+
+/**
+ * Make sure that BinaryCategoricalSplit respects the minimum number of samples
+ * required to split.
+ */
+TEST_CASE("BinaryCategoricalSplitMinSamplesTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors = {0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3};
+  arma::rowvec responses = {5, 5, 5, 100, 100, 100, 100, 100, 100, 5, 5, 5};
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  double splitInfo;
+  BinaryCategoricalSplit<MSEGain>::AuxiliarySplitInfo aux;
+
+  // No prefix grouping can put at least 7 of the 12 points in both children.
+  MSEGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain = BinaryCategoricalSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, predictors, 4, responses, weights, 7, 1e-7, splitInfo, aux, f);
+
+  // Make sure it's not split.
+  REQUIRE(gain == DBL_MAX);
+}
+
+/**
+ * Test that we can build a decision tree that uses BinaryCategoricalSplit on a
+ * simple categorical dataset.
+ */
+TEST_CASE("BinaryCategoricalSplitBuildTest_", "[DecisionTreeRegressorTest]")
+{
+  arma::mat d;
+  arma::rowvec r;
+  data::DatasetInfo di;
+  MockCategoricalData(d, r, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::rowvec trainingResponses = r.subvec(0, 1999);
+  arma::rowvec testResponses = r.subvec(2000, 3999);
+
+  // Build the tree.
+  DecisionTreeRegressor<MSEGain, BestBinaryNumericSplit,
+      BinaryCategoricalSplit> tree(trainingData, di, trainingResponses, 10);
+
+  // Now evaluate the quality of predictions.
+  arma::rowvec predictions;
+  tree.Predict(testData, predictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+
+  // Make sure we get reasonable rmse.
+  const double rmse = RMSE(predictions, testResponses);
+  REQUIRE(rmse < 1.05);
+}
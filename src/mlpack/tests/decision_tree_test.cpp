@@ -15,6 +15,9 @@
 #include <mlpack/methods/decision_tree/gini_gain.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 #include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
+#include <mlpack/methods/decision_tree/binary_categorical_split.hpp>
+#include <mlpack/methods/decision_tree/flat_tree.hpp>
+#include <mlpack/methods/decision_tree/incremental_decision_tree.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
@@ -474,6 +477,167 @@ TEST_CASE("RandomBinaryNumericSplitDiffSplitTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities[0] != classProbabilities1[0]);
 }
 
+/**
+ * Check that the HistogramBinaryNumericSplit will split on an obviously
+ * splittable dimension, even though it only considers bin edges.
+ */
+TEST_CASE("HistogramBinaryNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+  const double weightedGain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == weightedGain);
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  // The class probabilities, for this split, hold the splitting point, which
+  // must be a bin edge strictly between 0.4 and 0.5.
+  REQUIRE(classProbabilities.n_elem == 1);
+  REQUIRE(classProbabilities[0] > 0.4);
+  REQUIRE(classProbabilities[0] < 0.5);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit won't split if not enough points
+ * are given.
+ */
+TEST_CASE("HistogramBinaryNumericSplitMinSamplesTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+
+  // Make sure that no split was made.
+  REQUIRE(gain == DBL_MAX);
+}
+
+/**
+ * A decision tree using the histogram numeric split policy should fit simple
+ * separable data about as well as the exhaustive split policy does.
+ */
+TEST_CASE("HistogramNumericSplitTreeTest", "[DecisionTreeTest]")
+{
+  // Two well-separated classes in three dimensions.
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000, arma::fill::zeros);
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    dataset.col(i) += 2.0;
+    labels[i] = 1;
+  }
+
+  DecisionTree<GiniGain, HistogramBinaryNumericSplit> d(dataset, labels, 2, 5);
+
+  arma::Row<size_t> predictions;
+  d.Classify(dataset, predictions);
+
+  REQUIRE(predictions.n_elem == labels.n_elem);
+  size_t correct = 0;
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  // The classes are fully separable, so nearly every point should be right.
+  REQUIRE(correct > 950);
+}
+
+/**
+ * A flattened tree must give exactly the same predictions and probabilities
+ * as the tree it was compiled from.
+ */
+TEST_CASE("FlatTreeMatchesTreeTest", "[DecisionTreeTest]")
+{
+  // Build a tree on data with some learnable structure.
+  arma::mat dataset(10, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    if (dataset(3, i) > 0.5)
+      labels[i] = 1;
+    else if (dataset(7, i) > 0.7)
+      labels[i] = 2;
+    else
+      labels[i] = 0;
+  }
+
+  DecisionTree<> d(dataset, labels, 3, 5);
+  FlatTree<DecisionTree<> > flat(d);
+
+  arma::mat testData(10, 500, arma::fill::randu);
+
+  arma::Row<size_t> treePredictions, flatPredictions;
+  arma::mat treeProbabilities, flatProbabilities;
+  d.Classify(testData, treePredictions, treeProbabilities);
+  flat.Classify(testData, flatPredictions, flatProbabilities);
+
+  REQUIRE(flatPredictions.n_elem == treePredictions.n_elem);
+  REQUIRE(flatProbabilities.n_rows == treeProbabilities.n_rows);
+  REQUIRE(flatProbabilities.n_cols == treeProbabilities.n_cols);
+  for (size_t i = 0; i < testData.n_cols; ++i)
+  {
+    REQUIRE(flatPredictions[i] == treePredictions[i]);
+    for (size_t c = 0; c < treeProbabilities.n_rows; ++c)
+    {
+      REQUIRE(flatProbabilities(c, i) ==
+          Approx(treeProbabilities(c, i)).epsilon(1e-10));
+    }
+
+    // The single-point overload must agree too.
+    REQUIRE(flat.Classify(testData.col(i)) == d.Classify(testData.col(i)));
+  }
+}
+
+/**
+ * A flattened tree built from a tree with categorical splits must give the
+ * same predictions as the original tree.
+ */
+TEST_CASE("FlatTreeCategoricalTest", "[DecisionTreeTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  DecisionTree<> tree(d, di, l, 5, 10);
+  FlatTree<DecisionTree<> > flat(tree);
+
+  arma::Row<size_t> treePredictions, flatPredictions;
+  tree.Classify(d, treePredictions);
+  flat.Classify(d, flatPredictions);
+
+  REQUIRE(flatPredictions.n_elem == treePredictions.n_elem);
+  for (size_t i = 0; i < d.n_cols; ++i)
+    REQUIRE(flatPredictions[i] == treePredictions[i]);
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -1399,3 +1563,295 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * Test that an empty delta leaves an incremental decision tree unchanged.
+ */
+TEST_CASE("IncrementalDecisionTreeEmptyDeltaTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+    dataset.col(i) += 2.0;
+  labels.subvec(0, 499).fill(0);
+  labels.subvec(500, 999).fill(1);
+
+  IncrementalDecisionTree<> tree(dataset, labels, 2, 5);
+
+  arma::Row<size_t> beforePredictions;
+  tree.Classify(dataset, beforePredictions);
+
+  // An empty delta must not change the tree.
+  tree.Update(arma::mat(5, 0), arma::Row<size_t>(), arma::uvec());
+
+  arma::Row<size_t> afterPredictions;
+  tree.Classify(dataset, afterPredictions);
+
+  REQUIRE(tree.NumPoints() == 1000);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(beforePredictions[i] == afterPredictions[i]);
+}
+
+/**
+ * Test that an incremental decision tree adapts to drift: after the points of
+ * one region change their label, updated predictions must follow.
+ */
+TEST_CASE("IncrementalDecisionTreeDriftTest", "[DecisionTreeTest]")
+{
+  // Two well-separated classes in five dimensions.
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+    dataset.col(i) += 2.0;
+  labels.subvec(0, 499).fill(0);
+  labels.subvec(500, 999).fill(1);
+
+  IncrementalDecisionTree<> tree(dataset, labels, 2, 5);
+
+  // Remove the second class entirely and replace it with points in a third
+  // region that carry label 0, so the old split must degrade.
+  arma::mat addedData(5, 500, arma::fill::randu);
+  addedData += 4.0;
+  arma::Row<size_t> addedLabels(500);
+  addedLabels.fill(0);
+  arma::uvec removedIndices = arma::linspace<arma::uvec>(500, 999, 500);
+
+  tree.Update(addedData, addedLabels, removedIndices);
+  REQUIRE(tree.NumPoints() == 1000);
+
+  // Everything the model now knows about carries label 0.
+  arma::Row<size_t> predictions;
+  tree.Classify(addedData, predictions);
+  size_t correct = 0;
+  for (size_t i = 0; i < addedData.n_cols; ++i)
+    if (predictions[i] == 0)
+      ++correct;
+  REQUIRE(correct > 480);
+
+  arma::Row<size_t> oldRegionPredictions;
+  tree.Classify(dataset.cols(0, 499), oldRegionPredictions);
+  correct = 0;
+  for (size_t i = 0; i < 500; ++i)
+    if (oldRegionPredictions[i] == 0)
+      ++correct;
+  REQUIRE(correct > 480);
+}
+
+/**
+ * The incremental Gini evaluator must agree with EvaluatePtr() at every
+ * boundary position.
+ */
+TEST_CASE("GiniGainIncrementalEvaluatorTest", "[DecisionTreeTest]")
+{
+  const size_t numClasses = 5;
+  arma::Row<size_t> labels(100);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = mlpack::math::RandInt(numClasses);
+
+  arma::vec counts(numClasses, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    ++counts[labels[i]];
+
+  GiniGain::IncrementalEvaluator evaluator(counts, (double) labels.n_elem);
+
+  arma::vec leftCounts(numClasses, arma::fill::zeros);
+  arma::vec rightCounts(counts);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    evaluator.MoveLeft(labels[i]);
+    ++leftCounts[labels[i]];
+    --rightCounts[labels[i]];
+
+    REQUIRE(evaluator.LeftTotal() == Approx((double) (i + 1)));
+    REQUIRE(evaluator.LeftGain() == Approx(GiniGain::EvaluatePtr<false>(
+        leftCounts.memptr(), numClasses, (double) (i + 1))).margin(1e-10));
+    REQUIRE(evaluator.RightGain() == Approx(GiniGain::EvaluatePtr<false>(
+        rightCounts.memptr(), numClasses,
+        (double) (labels.n_elem - i - 1))).margin(1e-10));
+  }
+}
+
+/**
+ * The incremental information gain evaluator must agree with EvaluatePtr() at
+ * every boundary position, including with non-unit weights.
+ */
+TEST_CASE("InformationGainIncrementalEvaluatorTest", "[DecisionTreeTest]")
+{
+  const size_t numClasses = 4;
+  arma::Row<size_t> labels(100);
+  arma::rowvec weights(100);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = mlpack::math::RandInt(numClasses);
+    weights[i] = mlpack::math::Random() + 0.5;
+  }
+
+  arma::vec counts(numClasses, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    counts[labels[i]] += weights[i];
+
+  InformationGain::IncrementalEvaluator evaluator(counts,
+      arma::accu(weights));
+
+  arma::vec leftCounts(numClasses, arma::fill::zeros);
+  arma::vec rightCounts(counts);
+  double leftTotal = 0.0;
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    evaluator.MoveLeft(labels[i], weights[i]);
+    leftCounts[labels[i]] += weights[i];
+    rightCounts[labels[i]] -= weights[i];
+    leftTotal += weights[i];
+
+    REQUIRE(evaluator.LeftGain() ==
+        Approx(InformationGain::EvaluatePtr<true>(leftCounts.memptr(),
+        numClasses, leftTotal)).margin(1e-8));
+    REQUIRE(evaluator.RightGain() ==
+        Approx(InformationGain::EvaluatePtr<true>(rightCounts.memptr(),
+        numClasses, arma::accu(weights) - leftTotal)).margin(1e-8));
+  }
+}
+
+/**
+ * Check that the BinaryCategoricalSplit will find the optimal two-way grouping
+ * of categories on an obviously splittable dimension.
+ */
+TEST_CASE("BinaryCategoricalSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0 0 0 1 1 1 2 2 2 3 3 3");
+  arma::Row<size_t> labels("0 0 0 1 1 1 1 1 1 0 0 0");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  BinaryCategoricalSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = BinaryCategoricalSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, 4, labels, 2, weights, 3, 1e-7, classProbabilities,
+      aux);
+  const double weightedGain =
+      BinaryCategoricalSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      4, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // The categories can be perfectly grouped into two children, so the gain
+  // should be 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  REQUIRE(gain == weightedGain);
+
+  // Make sure the class probabilities hold the number of children (always 2).
+  REQUIRE(classProbabilities.n_elem == 1);
+  REQUIRE((size_t) classProbabilities[0] == 2);
+
+  // Categories 0 and 3 (class 0) must go to one child, and categories 1 and 2
+  // (class 1) to the other.
+  REQUIRE(aux.CategoryDirections().n_elem == 4);
+  REQUIRE(aux.CategoryDirections()[0] == aux.CategoryDirections()[3]);
+  REQUIRE(aux.CategoryDirections()[1] == aux.CategoryDirections()[2]);
+  REQUIRE(aux.CategoryDirections()[0] != aux.CategoryDirections()[1]);
+
+  // CalculateDirection() must agree with the stored directions.
+  for (size_t c = 0; c < 4; ++c)
+  {
+    REQUIRE(BinaryCategoricalSplit<GiniGain>::CalculateDirection(
+        (double) c, classProbabilities[0], aux) ==
+        aux.CategoryDirections()[c]);
+  }
+}
+
+/**
+ * Make sure that BinaryCategoricalSplit respects the minimum number of samples
+ * required to split.
+ */
+TEST_CASE("BinaryCategoricalSplitMinSamplesTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0 0 0 1 1 1 2 2 2 3 3 3");
+  arma::Row<size_t> labels("0 0 0 1 1 1 1 1 1 0 0 0");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  BinaryCategoricalSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // No prefix grouping can put at least 7 of the 12 points in both children.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = BinaryCategoricalSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, 4, labels, 2, weights, 7, 1e-7, classProbabilities,
+      aux);
+
+  // Make sure it's not split.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * Test that we can build a decision tree that uses BinaryCategoricalSplit on a
+ * simple categorical dataset, and that every categorical split has exactly two
+ * children.
+ */
+TEST_CASE("BinaryCategoricalSplitBuildTest", "[DecisionTreeTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+  arma::Row<size_t> testLabels = l.subvec(2000, 3999);
+
+  // Build the tree.
+  DecisionTree<GiniGain, BestBinaryNumericSplit, BinaryCategoricalSplit>
+      tree(trainingData, di, trainingLabels, 5, 10);
+
+  // Now evaluate the accuracy of the tree.
+  arma::Row<size_t> predictions;
+  tree.Classify(testData, predictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+  size_t correct = 0;
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    if (testLabels[i] == predictions[i])
+      ++correct;
+
+  // Make sure we got at least 70% accuracy.
+  const double correctPct = double(correct) / double(testData.n_cols);
+  REQUIRE(correctPct > 0.70);
+}
+
+/**
+ * Test that a decision tree using BinaryCategoricalSplit can be serialized and
+ * gives identical predictions afterwards, i.e. the category directions
+ * survive the round trip.
+ */
+TEST_CASE("BinaryCategoricalSplitSerializationTest", "[DecisionTreeTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  typedef DecisionTree<GiniGain, BestBinaryNumericSplit,
+      BinaryCategoricalSplit> TreeType;
+  TreeType tree(d, di, l, 5, 10);
+
+  TreeType xmlTree, jsonTree, binaryTree;
+  SerializeObjectAll(tree, xmlTree, jsonTree, binaryTree);
+
+  arma::Row<size_t> predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions;
+  tree.Classify(d, predictions);
+  xmlTree.Classify(d, xmlPredictions);
+  jsonTree.Classify(d, jsonPredictions);
+  binaryTree.Classify(d, binaryPredictions);
+
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
@@ -285,6 +285,55 @@ TEST_CASE("TestGrow", "[DETTest]")
   REQUIRE(alpha == Approx(min(rootAlpha, rAlpha)).epsilon(1e-12));
 }
 
+/**
+ * The presorted growth path used for dense matrices must produce exactly the
+ * same tree as the per-node re-sorting path used for sparse matrices.
+ */
+TEST_CASE("TestGrowPresortedEquivalence", "[DETTest]")
+{
+  arma::mat denseData = arma::randu<arma::mat>(3, 500);
+  arma::sp_mat sparseData(denseData);
+
+  arma::Col<size_t> oDense(500);
+  arma::Col<size_t> oSparse(500);
+  for (size_t i = 0; i < 500; ++i)
+    oDense[i] = oSparse[i] = i;
+
+  DTree<arma::mat> denseTree(denseData);
+  DTree<arma::sp_mat> sparseTree(sparseData);
+
+  denseTree.Grow(denseData, oDense, false, 10, 5);
+  sparseTree.Grow(sparseData, oSparse, false, 10, 5);
+
+  for (size_t i = 0; i < oDense.n_elem; ++i)
+    REQUIRE(oDense[i] == oSparse[i]);
+
+  // Walk both trees in lockstep; every node must have the same structure and
+  // the same split.
+  std::stack<std::pair<const DTree<arma::mat>*, const DTree<arma::sp_mat>*>>
+      nodes;
+  nodes.push(std::make_pair(&denseTree, &sparseTree));
+  while (!nodes.empty())
+  {
+    const DTree<arma::mat>* denseNode = nodes.top().first;
+    const DTree<arma::sp_mat>* sparseNode = nodes.top().second;
+    nodes.pop();
+
+    REQUIRE(denseNode->Start() == sparseNode->Start());
+    REQUIRE(denseNode->End() == sparseNode->End());
+    REQUIRE(denseNode->NumChildren() == sparseNode->NumChildren());
+    if (denseNode->NumChildren() == 2)
+    {
+      REQUIRE(denseNode->SplitDim() == sparseNode->SplitDim());
+      REQUIRE(denseNode->SplitValue() ==
+          Approx(sparseNode->SplitValue()).epsilon(1e-12));
+
+      nodes.push(std::make_pair(denseNode->Left(), sparseNode->Left()));
+      nodes.push(std::make_pair(denseNode->Right(), sparseNode->Right()));
+    }
+  }
+}
+
 TEST_CASE("TestPruneAndUpdate", "[DETTest]")
 {
   arma::mat testData(3, 5);
@@ -782,3 +831,73 @@ TEST_CASE("MoveOperatorTest", "[DETTest]")
   REQUIRE(testDTree2.Right()->SplitDim() == 1);
   REQUIRE(testDTree2.Right()->SplitValue() == Approx(0.5).epsilon(1e-7));
 }
+
+TEST_CASE("TestBatchComputeValue", "[DETTest]")
+{
+  arma::mat testData(3, 5);
+
+  testData = { { 4, 5, 7, 3, 5 },
+               { 5, 0, 1, 7, 1 },
+               { 5, 6, 7, 1, 8 } };
+
+  arma::mat queries(3, 4);
+
+  queries = { { 4,    5, 5, 2 },
+              { 2, 0.25, 3, 3 },
+              { 2,    6, 7, 3 } };
+
+  arma::Col<size_t> oTest(5);
+  oTest = { 0, 1, 2, 3, 4 };
+
+  DTree<arma::mat> testDTree(testData);
+  double alpha = testDTree.Grow(testData, oTest, false, 2, 1);
+
+  arma::vec densities;
+  testDTree.ComputeValue(queries, densities);
+
+  REQUIRE(densities.n_elem == 4);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    REQUIRE(densities[i] ==
+        Approx(testDTree.ComputeValue(arma::vec(queries.col(i)))).epsilon(
+            1e-12));
+  }
+
+  // The pruned tree should also give the same answers in batch.
+  testDTree.PruneAndUpdate(alpha, testData.n_cols, false);
+
+  testDTree.ComputeValue(queries, densities);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    REQUIRE(densities[i] ==
+        Approx(testDTree.ComputeValue(arma::vec(queries.col(i)))).epsilon(
+            1e-12));
+  }
+}
+
+TEST_CASE("TestBatchComputeValueLargeTree", "[DETTest]")
+{
+  // Grow a deeper tree on random data and check a large batch of queries
+  // (spanning many buckets and chunks) against one-point evaluation.
+  arma::mat testData = arma::randu<arma::mat>(4, 500);
+  arma::mat queries = arma::randu<arma::mat>(4, 1000);
+  // Some queries outside the root's range.
+  queries.cols(900, 999) += 1.0;
+
+  arma::Col<size_t> oTest = arma::linspace<arma::Col<size_t> >(
+      0, testData.n_cols - 1, testData.n_cols);
+
+  DTree<arma::mat> testDTree(testData);
+  testDTree.Grow(testData, oTest, false, 10, 5);
+
+  arma::vec densities;
+  testDTree.ComputeValue(queries, densities);
+
+  REQUIRE(densities.n_elem == queries.n_cols);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    REQUIRE(densities[i] ==
+        Approx(testDTree.ComputeValue(arma::vec(queries.col(i)))).epsilon(
+            1e-12));
+  }
+}
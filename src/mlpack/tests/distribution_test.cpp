@@ -88,6 +88,26 @@ TEST_CASE("DiscreteDistributionRandomTest", "[DistributionTest]")
   REQUIRE(actualProb(2) == Approx(0.1).epsilon(0.08));
 }
 
+/**
+ * Make sure the sampling tables are rebuilt when the probabilities change
+ * between draws.
+ */
+TEST_CASE("DiscreteDistributionRandomRebuildTest", "[DistributionTest]")
+{
+  DiscreteDistribution d(arma::Col<size_t>("3"));
+
+  d.Probabilities() = "0.3 0.6 0.1";
+
+  // Draw once so that the sampling tables are built for these probabilities.
+  d.Random();
+
+  // Now change the distribution and make sure the draws follow the new one.
+  d.Probabilities() = "0.0 0.0 1.0";
+
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE((size_t) (d.Random()[0] + 0.5) == 2);
+}
+
 /**
  * Make sure we can estimate from observations correctly.
  */
@@ -1544,3 +1564,78 @@ TEST_CASE("DiagonalGaussianWeightedParametersReductionTest",
     REQUIRE(d1.Covariance()(i) == Approx(d2.Covariance()(i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure we initialize a sparse discrete distribution over a huge
+ * vocabulary correctly; the uniform distribution is represented entirely by
+ * the tail.
+ */
+TEST_CASE("SparseDiscreteDistributionConstructorTest", "[DistributionTest]")
+{
+  SparseDiscreteDistribution d(1000000);
+
+  REQUIRE(d.Dimensionality() == 1);
+  REQUIRE(d.NumObservations() == 1000000);
+  REQUIRE(d.StoredProbabilities().size() == 0);
+  REQUIRE(d.Probability("42") == Approx(1e-6).epsilon(1e-7));
+  REQUIRE(d.Probability("999999") == Approx(1e-6).epsilon(1e-7));
+
+  const arma::vec obs = d.Random();
+  REQUIRE(obs[0] >= 0);
+  REQUIRE(obs[0] < 1000000);
+}
+
+/**
+ * Make sure sparse discrete distribution training only stores the observed
+ * symbols, matches the empirical frequencies, and keeps a nonzero smoothed
+ * tail that makes the total mass sum to one.
+ */
+TEST_CASE("SparseDiscreteDistributionTrainTest", "[DistributionTest]")
+{
+  SparseDiscreteDistribution d(100000);
+  arma::mat obs("0 0 1 3 3 3");
+
+  d.Train(obs);
+
+  REQUIRE(d.StoredProbabilities().size() == 3);
+  REQUIRE(d.Probability("0") == Approx(2.0 / 6.0).epsilon(1e-6));
+  REQUIRE(d.Probability("1") == Approx(1.0 / 6.0).epsilon(1e-6));
+  REQUIRE(d.Probability("3") == Approx(3.0 / 6.0).epsilon(1e-6));
+
+  // Unseen symbols keep a small nonzero probability.
+  REQUIRE(d.TailProbability() > 0.0);
+  REQUIRE(d.Probability("99999") == Approx(d.TailProbability()));
+
+  // The stored mass and the tail mass sum to one.
+  double total = d.TailProbability() * (100000 - 3);
+  for (const std::pair<const size_t, double>& p : d.StoredProbabilities())
+    total += p.second;
+  REQUIRE(total == Approx(1.0).epsilon(1e-10));
+}
+
+/**
+ * Make sure the top-k cap keeps the heaviest symbols and folds the mass of
+ * the dropped symbols into the tail.
+ */
+TEST_CASE("SparseDiscreteDistributionTopKTest", "[DistributionTest]")
+{
+  SparseDiscreteDistribution d(1000, 2);
+  arma::mat obs("5 5 5 5 7 7 7 9 9 11");
+
+  d.Train(obs);
+
+  // Only the two heaviest symbols are stored, with their exact empirical
+  // probabilities.
+  REQUIRE(d.StoredProbabilities().size() == 2);
+  REQUIRE(d.Probability("5") == Approx(0.4).epsilon(1e-6));
+  REQUIRE(d.Probability("7") == Approx(0.3).epsilon(1e-6));
+
+  // The dropped symbols share the remaining mass with the rest of the tail.
+  REQUIRE(d.Probability("9") == Approx(0.3 / 998).epsilon(1e-6));
+  REQUIRE(d.Probability("9") == Approx(d.Probability("500")).epsilon(1e-10));
+
+  double total = d.TailProbability() * (1000 - 2);
+  for (const std::pair<const size_t, double>& p : d.StoredProbabilities())
+    total += p.second;
+  REQUIRE(total == Approx(1.0).epsilon(1e-10));
+}
@@ -274,3 +274,77 @@ TEST_CASE("EMSTBallTreeTest", "[EMSTTest]")
     REQUIRE(bstResults(2, i) == Approx(ballResults(2, i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Test that UnionFind::Flatten() compresses every path and does not change
+ * the component structure.
+ */
+TEST_CASE("UnionFindFlattenTest", "[EMSTTest]")
+{
+  UnionFind connections(10);
+
+  // Build a chain of unions.
+  connections.Union(0, 1);
+  connections.Union(1, 2);
+  connections.Union(3, 4);
+  connections.Union(2, 3);
+  connections.Union(7, 8);
+
+  // Record components before flattening.
+  arma::Col<size_t> before(10);
+  for (size_t i = 0; i < 10; ++i)
+    before[i] = connections.Find(i);
+
+  connections.Flatten();
+
+  // Components must be unchanged.
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(connections.Find(i) == before[i]);
+
+  // Points 0 through 4 are one component; 7 and 8 another; the rest are
+  // singletons.
+  for (size_t i = 1; i < 5; ++i)
+    REQUIRE(connections.Find(i) == connections.Find(0));
+  REQUIRE(connections.Find(7) == connections.Find(8));
+  REQUIRE(connections.Find(5) == 5);
+  REQUIRE(connections.Find(6) == 6);
+  REQUIRE(connections.Find(9) == 9);
+  REQUIRE(connections.Find(0) != connections.Find(7));
+}
+
+/**
+ * Test the dual-tree method against the naive computation on clustered data,
+ * where whole subtrees merge into one component after the first rounds; this
+ * exercises the lazy per-round cleanup that skips descending into
+ * single-component subtrees.
+ */
+TEST_CASE("DualTreeVsNaiveClusteredData", "[EMSTTest]")
+{
+  // Five tight, well-separated clusters: after the early Boruvka rounds each
+  // cluster is a single component and its subtree is never descended again.
+  arma::mat inputData(3, 500);
+  for (size_t i = 0; i < inputData.n_cols; ++i)
+  {
+    inputData.col(i) = 0.05 * arma::randn<arma::vec>(3);
+    inputData(0, i) += 20.0 * (i % 5);
+  }
+
+  arma::mat dualData = inputData;
+  arma::mat naiveData = inputData;
+
+  DualTreeBoruvka<> dtb(dualData);
+  arma::mat dualResults;
+  dtb.ComputeMST(dualResults);
+
+  DualTreeBoruvka<> dtbNaive(naiveData, true);
+  arma::mat naiveResults;
+  dtbNaive.ComputeMST(naiveResults);
+
+  REQUIRE(dualResults.n_cols == naiveResults.n_cols);
+  for (size_t i = 0; i < dualResults.n_cols; ++i)
+  {
+    REQUIRE(dualResults(0, i) == naiveResults(0, i));
+    REQUIRE(dualResults(1, i) == naiveResults(1, i));
+    REQUIRE(dualResults(2, i) == Approx(naiveResults(2, i)).epsilon(1e-7));
+  }
+}
@@ -1141,3 +1141,65 @@ TEST_CASE("CopyAssignmentTest", "[FastMKSTest]")
       REQUIRE(newKernels[i] == Approx(0.0).margin(1e-5));
   }
 }
+
+/**
+ * The batched dot-product path used by naive mode must match a scalar kernel
+ * scan, both for the plain dot product and the normalized (cosine) case.
+ */
+TEST_CASE("NaiveDotProductBatchTest", "[FastMKSTest]")
+{
+  arma::mat data = arma::randn(6, 300);
+  arma::mat querySet = arma::randn(6, 80);
+  const size_t k = 5;
+
+  // Linear kernel, bichromatic.
+  {
+    LinearKernel lk;
+    FastMKS<LinearKernel> naive(data, lk, false, true);
+
+    arma::Mat<size_t> indices;
+    arma::mat kernels;
+    naive.Search(querySet, k, indices, kernels);
+
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
+      arma::vec evals(data.n_cols);
+      for (size_t r = 0; r < data.n_cols; ++r)
+        evals[r] = LinearKernel::Evaluate(querySet.col(q), data.col(r));
+
+      arma::uvec order = arma::sort_index(evals, "descend");
+      for (size_t j = 0; j < k; ++j)
+      {
+        REQUIRE(indices(j, q) == order[j]);
+        REQUIRE(kernels(j, q) == Approx(evals[order[j]]).epsilon(1e-10));
+      }
+    }
+  }
+
+  // Cosine distance, monochromatic; a point must not return itself.
+  {
+    CosineDistance cd;
+    FastMKS<CosineDistance> naive(data, cd, false, true);
+
+    arma::Mat<size_t> indices;
+    arma::mat kernels;
+    naive.Search(k, indices, kernels);
+
+    for (size_t q = 0; q < data.n_cols; ++q)
+    {
+      arma::vec evals(data.n_cols);
+      for (size_t r = 0; r < data.n_cols; ++r)
+      {
+        evals[r] = (q == r) ? -DBL_MAX :
+            CosineDistance::Evaluate(data.col(q), data.col(r));
+      }
+
+      arma::uvec order = arma::sort_index(evals, "descend");
+      for (size_t j = 0; j < k; ++j)
+      {
+        REQUIRE(indices(j, q) == order[j]);
+        REQUIRE(kernels(j, q) == Approx(evals[order[j]]).epsilon(1e-7));
+      }
+    }
+  }
+}
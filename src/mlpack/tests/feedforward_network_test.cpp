@@ -14,7 +14,9 @@
 
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/ann/async_batch_pipeline.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/static_network.hpp>
 
 #include <ensmallen.hpp>
 
@@ -1145,3 +1147,295 @@ TEST_CASE("FFNCheckInputShapeTest", "[FeedForwardNetworkTest]")
 
   REQUIRE_THROWS_AS(model.Train(trainData, trainLabels, opt), std::logic_error);
 }
+
+/**
+ * Test that batched prediction gives the same results independently of the
+ * batch size, and that a frozen network still predicts correctly.
+ */
+TEST_CASE("FFNPredictBatchSizeAndFreezeTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // The labels should be between 0 and numClasses.
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols /* 1 epoch */, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  // The predictions should not depend on the batch size.
+  arma::mat predictions, predictionsSmallBatch;
+  model.Predict(trainData, predictions);
+  model.Predict(trainData, predictionsSmallBatch, 1);
+  CheckMatrices(predictions, predictionsSmallBatch);
+
+  // A frozen network should give the same predictions.
+  model.Freeze();
+  arma::mat predictionsFrozen;
+  model.Predict(trainData, predictionsFrozen);
+  CheckMatrices(predictions, predictionsFrozen);
+
+  // Training again after freezing should still work.
+  ens::RMSProp opt2(0.01, 32, 0.88, 1e-8, trainData.n_cols /* 1 epoch */, -1);
+  double objVal = model.Train(trainData, trainLabels, opt2);
+  REQUIRE(std::isfinite(objVal) == true);
+}
+
+/**
+ * Test that gathering the layer buffers into the contiguous workspace does
+ * not change the results, and that the workspace tracks its high-water mark.
+ */
+TEST_CASE("FFNWorkspaceTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // The labels should be between 0 and numClasses.
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols /* 1 epoch */, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  // After training, the layer buffers live in the contiguous workspace.
+  REQUIRE(model.WorkspaceSize() > 0);
+  REQUIRE(model.WorkspacePeak() >= model.WorkspaceSize());
+
+  // Changing the batch size resizes the buffers and rebuilds the workspace;
+  // the predictions must not change.
+  arma::mat predictions, predictionsLargeBatch;
+  model.Predict(trainData, predictions, 16);
+  model.Predict(trainData, predictionsLargeBatch, 256);
+  CheckMatrices(predictions, predictionsLargeBatch);
+
+  // Freezing releases the delta buffers, so the workspace shrinks but the
+  // high-water mark is kept.
+  const size_t peak = model.WorkspacePeak();
+  model.Freeze();
+  REQUIRE(model.WorkspaceSize() < peak);
+  REQUIRE(model.WorkspacePeak() == peak);
+
+  arma::mat predictionsFrozen;
+  model.Predict(trainData, predictionsFrozen, 16);
+  CheckMatrices(predictions, predictionsFrozen);
+}
+
+/**
+ * Test that the data-parallel minibatch gradient matches the serial one.
+ */
+TEST_CASE("FFNDataParallelGradientTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // The labels should be between 0 and numClasses.
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols /* 1 epoch */, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  // Splitting the minibatch across threads must give the same objective and
+  // gradient as the serial evaluation (up to summation order).
+  arma::mat serialGradient, parallelGradient;
+  const double serialObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, serialGradient, 64);
+
+  model.TrainingThreads() = 4;
+  const double parallelObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, parallelGradient, 64);
+
+  REQUIRE(serialObjective == Approx(parallelObjective).epsilon(1e-7));
+  CheckMatrices(serialGradient, parallelGradient);
+
+  // Training with the data-parallel mode enabled should still converge to a
+  // finite objective.
+  ens::RMSProp opt2(0.01, 32, 0.88, 1e-8, trainData.n_cols /* 1 epoch */, -1);
+  const double objVal = model.Train(trainData, trainLabels, opt2);
+  REQUIRE(std::isfinite(objVal) == true);
+}
+
+/**
+ * Test that a StaticNetwork with the same architecture and parameters as a
+ * trained FFN produces the same predictions.
+ */
+TEST_CASE("StaticNetworkTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // The labels should be between 0 and numClasses.
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols /* 1 epoch */, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  // Build a compile-time-typed network with the same architecture and hand it
+  // the trained weights.
+  StaticNetwork<Linear<>, SigmoidLayer<>, Linear<>, LogSoftMax<> > network(
+      Linear<>(trainData.n_rows, 8), SigmoidLayer<>(), Linear<>(8, 3),
+      LogSoftMax<>());
+
+  REQUIRE(network.WeightSize() == model.Parameters().n_elem);
+  network.Parameters(model.Parameters());
+
+  // The predictions of both networks must be identical.
+  arma::mat ffnPredictions, staticPredictions;
+  model.Predict(trainData, ffnPredictions);
+  network.Predict(trainData, staticPredictions);
+  CheckMatrices(ffnPredictions, staticPredictions);
+
+  // A parameter vector of the wrong size must be rejected.
+  arma::mat wrongParameters(network.WeightSize() + 1, 1, arma::fill::zeros);
+  REQUIRE_THROWS_AS(network.Parameters(wrongParameters),
+      std::invalid_argument);
+}
+
+/**
+ * The AsyncBatchPipeline must be equivalent to evaluating the network on the
+ * batches directly.
+ */
+TEST_CASE("AsyncBatchPipelineEquivalenceTest", "[FeedForwardNetworkTest]")
+{
+  const size_t numBatches = 5;
+  const size_t batchSize = 16;
+
+  arma::mat dataset(10, numBatches * batchSize, arma::fill::randu);
+  arma::mat labels = arma::floor(2 * arma::randu<arma::mat>(1,
+      dataset.n_cols));
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(dataset.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  auto producer = [&](const size_t batch,
+                      arma::mat& predictors,
+                      arma::mat& responses)
+  {
+    predictors = dataset.cols(batch * batchSize, (batch + 1) * batchSize - 1);
+    responses = labels.cols(batch * batchSize, (batch + 1) * batchSize - 1);
+  };
+
+  AsyncBatchPipeline<FFN<NegativeLogLikelihood<> >, decltype(producer)>
+      pipeline(model, producer, numBatches, batchSize);
+
+  REQUIRE(pipeline.NumFunctions() == dataset.n_cols);
+
+  for (size_t batch = 0; batch < numBatches; ++batch)
+  {
+    const arma::mat batchData = dataset.cols(batch * batchSize,
+        (batch + 1) * batchSize - 1);
+    const arma::mat batchLabels = labels.cols(batch * batchSize,
+        (batch + 1) * batchSize - 1);
+
+    const double objective = pipeline.Evaluate(model.Parameters(),
+        batch * batchSize, batchSize);
+    REQUIRE(objective ==
+        Approx(model.Evaluate(batchData, batchLabels)).epsilon(1e-10));
+
+    arma::mat gradient;
+    const double gradObjective = pipeline.EvaluateWithGradient(
+        model.Parameters(), batch * batchSize, gradient, batchSize);
+
+    arma::mat results, refGradient;
+    model.Forward(batchData, results);
+    const double refObjective = model.Backward(batchData, batchLabels,
+        refGradient);
+
+    REQUIRE(gradObjective == Approx(refObjective).epsilon(1e-10));
+    CheckMatrices(gradient, refGradient);
+  }
+}
+
+/**
+ * Train a network through the AsyncBatchPipeline with SGD and make sure it
+ * learns, with the sequentially visited batches served from the prefetched
+ * buffer.
+ */
+TEST_CASE("AsyncBatchPipelineTrainTest", "[FeedForwardNetworkTest]")
+{
+  const size_t numBatches = 8;
+  const size_t batchSize = 32;
+
+  // Two well-separated classes.
+  arma::mat dataset(10, numBatches * batchSize, arma::fill::randu);
+  dataset.cols(dataset.n_cols / 2, dataset.n_cols - 1) += 3.0;
+  arma::mat labels = arma::zeros(1, dataset.n_cols);
+  labels.cols(labels.n_cols / 2, labels.n_cols - 1).fill(1);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(dataset.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  auto producer = [&](const size_t batch,
+                      arma::mat& predictors,
+                      arma::mat& responses)
+  {
+    predictors = dataset.cols(batch * batchSize, (batch + 1) * batchSize - 1);
+    responses = labels.cols(batch * batchSize, (batch + 1) * batchSize - 1);
+  };
+
+  AsyncBatchPipeline<FFN<NegativeLogLikelihood<> >, decltype(producer)>
+      pipeline(model, producer, numBatches, batchSize);
+
+  ens::SGD<> optimizer(0.05, batchSize, 30 * dataset.n_cols, -100);
+  optimizer.Optimize(pipeline, model.Parameters());
+
+  // With shuffling disabled by default only the first batch of an epoch can
+  // miss, so most batches must have been served from the prefetched buffer.
+  REQUIRE(pipeline.PrefetchHits() > pipeline.PrefetchMisses());
+
+  arma::mat predictionTemp;
+  model.Predict(dataset, predictionTemp);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < predictionTemp.n_cols; ++i)
+  {
+    const size_t prediction = arma::as_scalar(arma::find(
+        arma::max(predictionTemp.col(i)) == predictionTemp.col(i), 1));
+    if (prediction == (size_t) labels(i))
+      ++correct;
+  }
+
+  REQUIRE((double) correct / dataset.n_cols >= 0.9);
+}
@@ -2109,3 +2109,442 @@ TEST_CASE("DiagonalGMMHMMLoadSaveTest", "[HMMTest]")
     }
   }
 }
+
+/**
+ * Ensure that incremental (stepwise) Baum-Welch training tracks the
+ * parameters of a simple Gaussian HMM when the data arrives in batches.
+ */
+TEST_CASE("GaussianHMMIncrementalTrainTest", "[HMMTest]")
+{
+  // Two well-separated emission Gaussians, one per state.
+  GaussianDistribution g1("5.0 5.0", "1.0 0.0; 0.0 1.0");
+  GaussianDistribution g2("-5.0 -5.0", "1.0 0.0; 0.0 1.0");
+
+  arma::vec initial("1 0");
+  arma::mat transition("0.75 0.25; 0.25 0.75");
+
+  std::vector<GaussianDistribution> emission;
+  emission.push_back(g1);
+  emission.push_back(g2);
+
+  HMM<GaussianDistribution> trueHMM(initial, transition, emission);
+
+  // Generate sequences from the true model.
+  std::vector<arma::mat> sequences(40);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    trueHMM.Generate(250, sequences[i], states);
+  }
+
+  // Start from a perturbed model and feed the sequences in small batches.
+  std::vector<GaussianDistribution> guessEmission;
+  guessEmission.push_back(GaussianDistribution("4.0 4.0",
+      "1.0 0.0; 0.0 1.0"));
+  guessEmission.push_back(GaussianDistribution("-4.0 -4.0",
+      "1.0 0.0; 0.0 1.0"));
+
+  HMM<GaussianDistribution> hmm(arma::vec("0.5 0.5"),
+      arma::mat("0.5 0.5; 0.5 0.5"), guessEmission);
+
+  for (size_t batchStart = 0; batchStart < sequences.size(); batchStart += 5)
+  {
+    std::vector<arma::mat> batch(sequences.begin() + batchStart,
+        sequences.begin() + batchStart + 5);
+    hmm.TrainIncremental(batch);
+  }
+
+  // The transition matrix should be recovered reasonably well.
+  for (size_t row = 0; row < 2; ++row)
+    for (size_t col = 0; col < 2; ++col)
+      REQUIRE(hmm.Transition()(row, col) ==
+          Approx(transition(row, col)).margin(0.07));
+
+  // The emission means should match the true Gaussians (in some order).
+  const bool firstIsG1 =
+      (arma::norm(hmm.Emission()[0].Mean() - g1.Mean()) <
+       arma::norm(hmm.Emission()[0].Mean() - g2.Mean()));
+  const arma::vec mean0 = firstIsG1 ? g1.Mean() : g2.Mean();
+  const arma::vec mean1 = firstIsG1 ? g2.Mean() : g1.Mean();
+
+  REQUIRE(arma::norm(hmm.Emission()[0].Mean() - mean0) < 0.3);
+  REQUIRE(arma::norm(hmm.Emission()[1].Mean() - mean1) < 0.3);
+}
+
+/**
+ * The checkpointed Viterbi decoder must produce exactly the same state
+ * sequence and log-likelihood as the standard one.
+ */
+TEST_CASE("HMMPredictCheckpointedTest", "[HMMTest]")
+{
+  // Two well-separated Gaussian states with a known transition matrix.
+  std::vector<GaussianDistribution> emission;
+  emission.push_back(GaussianDistribution("5.0 5.0", "1.0 0.0; 0.0 1.0"));
+  emission.push_back(GaussianDistribution("-5.0 -5.0", "1.0 0.0; 0.0 1.0"));
+
+  HMM<GaussianDistribution> hmm(arma::vec("0.6 0.4"),
+      arma::mat("0.75 0.25; 0.25 0.75"), emission);
+
+  // Try a few sequence lengths, including ones that do not divide evenly
+  // into sqrt(T)-sized blocks and the degenerate length-1 case.
+  const size_t lengths[] = { 1, 2, 97, 500 };
+  for (size_t l = 0; l < 4; ++l)
+  {
+    arma::mat sequence;
+    arma::Row<size_t> trueStates;
+    hmm.Generate(lengths[l], sequence, trueStates);
+
+    arma::Row<size_t> predicted, predictedCheckpointed;
+    const double loglik = hmm.Predict(sequence, predicted);
+    const double loglikCheckpointed =
+        hmm.PredictCheckpointed(sequence, predictedCheckpointed);
+
+    REQUIRE(loglik == Approx(loglikCheckpointed).epsilon(1e-10));
+    for (size_t t = 0; t < lengths[l]; ++t)
+      REQUIRE(predicted[t] == predictedCheckpointed[t]);
+  }
+}
+
+/**
+ * The batched Predict() and LogLikelihood() overloads must agree with the
+ * single-sequence versions, both on same-length batches (which take the
+ * stacked-cube fast path) and on mixed-length batches.
+ */
+TEST_CASE("HMMBatchPredictLogLikelihoodTest", "[HMMTest]")
+{
+  // Two well-separated Gaussian states with a known transition matrix.
+  std::vector<GaussianDistribution> emission;
+  emission.push_back(GaussianDistribution("5.0 5.0", "1.0 0.0; 0.0 1.0"));
+  emission.push_back(GaussianDistribution("-5.0 -5.0", "1.0 0.0; 0.0 1.0"));
+
+  HMM<GaussianDistribution> hmm(arma::vec("0.6 0.4"),
+      arma::mat("0.75 0.25; 0.25 0.75"), emission);
+
+  // First a batch where every sequence has the same length, then one with
+  // mixed lengths.
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    std::vector<arma::mat> sequences(50);
+    for (size_t n = 0; n < sequences.size(); ++n)
+    {
+      const size_t length = (trial == 0) ? 30 : (1 + (n % 40));
+      arma::Row<size_t> trueStates;
+      hmm.Generate(length, sequences[n], trueStates);
+    }
+
+    std::vector<arma::Row<size_t>> stateSeqs;
+    arma::vec viterbiLogliks;
+    hmm.Predict(sequences, stateSeqs, viterbiLogliks);
+
+    arma::vec logliks;
+    hmm.LogLikelihood(sequences, logliks);
+
+    REQUIRE(stateSeqs.size() == sequences.size());
+    REQUIRE(viterbiLogliks.n_elem == sequences.size());
+    REQUIRE(logliks.n_elem == sequences.size());
+
+    for (size_t n = 0; n < sequences.size(); ++n)
+    {
+      arma::Row<size_t> singleStates;
+      const double singleViterbi = hmm.Predict(sequences[n], singleStates);
+
+      REQUIRE(viterbiLogliks[n] == Approx(singleViterbi).epsilon(1e-10));
+      for (size_t t = 0; t < sequences[n].n_cols; ++t)
+        REQUIRE(stateSeqs[n][t] == singleStates[t]);
+
+      REQUIRE(logliks[n] ==
+          Approx(hmm.LogLikelihood(sequences[n])).epsilon(1e-10));
+    }
+  }
+}
+
+/**
+ * Make sure the bulk Generate() overload draws sequences from the same model
+ * as the one-sequence version: train a new HMM on the generated batch and
+ * check the recovered parameters.
+ */
+TEST_CASE("DiscreteHMMBulkGenerateTest", "[HMMTest]")
+{
+  // 6 emissions, 4 states.  Random transition and emission probability.
+  arma::vec initial("1 0 0 0");
+  arma::mat transition(4, 4);
+  std::vector<DiscreteDistribution> emission(4);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    emission[i].Probabilities() = arma::randu<arma::vec>(6);
+    emission[i].Probabilities() /= accu(emission[i].Probabilities());
+  }
+
+  transition.randu();
+
+  // Normalize matrix.
+  for (size_t col = 0; col < 4; col++)
+    transition.col(col) /= accu(transition.col(col));
+
+  // Create HMM object.
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  // Generate all of the sequences in one call.
+  const size_t numSeq = 400;
+  const size_t numObs = 3000;
+  arma::cube dataSequences;
+  arma::Mat<size_t> stateSequences;
+  hmm.Generate(numObs, numSeq, dataSequences, stateSequences);
+
+  REQUIRE(dataSequences.n_rows == 1);
+  REQUIRE(dataSequences.n_cols == numObs);
+  REQUIRE(dataSequences.n_slices == numSeq);
+  REQUIRE(stateSequences.n_rows == numSeq);
+  REQUIRE(stateSequences.n_cols == numObs);
+
+  // Now we will calculate the full probabilities.
+  std::vector<arma::mat> sequences(numSeq);
+  std::vector<arma::Row<size_t> > states(numSeq);
+  for (size_t i = 0; i < numSeq; ++i)
+  {
+    sequences[i] = dataSequences.slice(i);
+    states[i] = stateSequences.row(i);
+  }
+
+  HMM<DiscreteDistribution> hmm2(4, 6);
+  hmm2.Train(sequences, states);
+
+  // Check that training gives the same result.
+  REQUIRE(arma::norm(hmm.Transition() - hmm2.Transition()) < 0.02);
+
+  for (size_t row = 0; row < 6; row++)
+  {
+    arma::vec obs(1);
+    obs[0] = row;
+    for (size_t col = 0; col < 4; col++)
+    {
+      REQUIRE(hmm.Emission()[col].Probability(obs) -
+          hmm2.Emission()[col].Probability(obs) == Approx(0.0).margin(0.02));
+    }
+  }
+}
+
+/**
+ * Make sure the log-likelihoods accumulated during bulk generation match a
+ * separate scoring pass with LogLikelihood().
+ */
+TEST_CASE("HMMBulkGenerateLogLikelihoodTest", "[HMMTest]")
+{
+  // Random transition and emission probability, 3 states, 5 emissions.
+  arma::vec initial = arma::randu<arma::vec>(3);
+  initial /= accu(initial);
+  arma::mat transition = arma::randu<arma::mat>(3, 3);
+  for (size_t col = 0; col < 3; col++)
+    transition.col(col) /= accu(transition.col(col));
+  std::vector<DiscreteDistribution> emission(3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    emission[i].Probabilities() = arma::randu<arma::vec>(5);
+    emission[i].Probabilities() /= accu(emission[i].Probabilities());
+  }
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  arma::cube dataSequences;
+  arma::Mat<size_t> stateSequences;
+  arma::vec logLikelihoods;
+  hmm.Generate(50, 20, dataSequences, stateSequences, logLikelihoods, 1);
+
+  REQUIRE(logLikelihoods.n_elem == 20);
+  for (size_t s = 0; s < 20; ++s)
+  {
+    REQUIRE(logLikelihoods[s] ==
+        Approx(hmm.LogLikelihood(dataSequences.slice(s))).epsilon(1e-10));
+  }
+}
+
+/**
+ * The same check for a Gaussian HMM, to make sure the fused scoring is not
+ * specific to discrete emissions.
+ */
+TEST_CASE("GaussianHMMBulkGenerateLogLikelihoodTest", "[HMMTest]")
+{
+  // Two 2-dimensional well-separated output Gaussians.
+  HMM<GaussianDistribution> hmm(2, GaussianDistribution(2));
+  hmm.Initial() = arma::vec("0.5 0.5");
+  hmm.Transition() = arma::mat("0.7 0.4; 0.3 0.6");
+  hmm.Emission()[0] = GaussianDistribution("0.0 0.0", "1.0 0.0; 0.0 1.0");
+  hmm.Emission()[1] = GaussianDistribution("5.0 5.0", "1.5 0.5; 0.5 1.0");
+
+  arma::cube dataSequences;
+  arma::Mat<size_t> stateSequences;
+  arma::vec logLikelihoods;
+  hmm.Generate(100, 10, dataSequences, stateSequences, logLikelihoods);
+
+  for (size_t s = 0; s < 10; ++s)
+  {
+    REQUIRE(logLikelihoods[s] ==
+        Approx(hmm.LogLikelihood(dataSequences.slice(s))).epsilon(1e-10));
+  }
+}
+
+/**
+ * Make sure an HMM with sparse discrete emissions gives the same
+ * log-likelihoods and state predictions as an HMM with dense discrete
+ * emissions when both carry the same parameters.
+ */
+TEST_CASE("SparseDiscreteHMMEquivalenceTest", "[HMMTest]")
+{
+  arma::vec initial("0.6 0.4");
+  arma::mat transition("0.7 0.3; 0.3 0.7");
+
+  // Strictly positive emission probabilities, so the sparse distribution
+  // stores every symbol and no smoothing is applied.
+  std::vector<arma::vec> emissionProbs(2);
+  emissionProbs[0] = arma::vec("0.5 0.25 0.15 0.1");
+  emissionProbs[1] = arma::vec("0.1 0.15 0.25 0.5");
+
+  std::vector<DiscreteDistribution> denseEmission;
+  std::vector<SparseDiscreteDistribution> sparseEmission;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    denseEmission.push_back(DiscreteDistribution(
+        std::vector<arma::vec>(1, emissionProbs[i])));
+    sparseEmission.push_back(SparseDiscreteDistribution(
+        std::vector<arma::vec>(1, emissionProbs[i])));
+  }
+
+  HMM<DiscreteDistribution> denseHmm(initial, transition, denseEmission);
+  HMM<SparseDiscreteDistribution> sparseHmm(initial, transition,
+      sparseEmission);
+
+  arma::mat observations("0 1 2 3 3 2 1 0 0 3 1 2");
+
+  REQUIRE(sparseHmm.LogLikelihood(observations) ==
+      Approx(denseHmm.LogLikelihood(observations)).epsilon(1e-7));
+
+  arma::Row<size_t> denseStates, sparseStates;
+  denseHmm.Predict(observations, denseStates);
+  sparseHmm.Predict(observations, sparseStates);
+  for (size_t t = 0; t < observations.n_cols; ++t)
+    REQUIRE(sparseStates[t] == denseStates[t]);
+}
+
+/**
+ * Train an HMM with sparse discrete emissions over a large vocabulary with
+ * labeled data, and make sure the estimated emission probabilities match the
+ * empirical per-state frequencies while unobserved symbols stay feasible.
+ */
+TEST_CASE("SparseDiscreteHMMLabeledTrainTest", "[HMMTest]")
+{
+  // Two states over a vocabulary far larger than the observed symbols.
+  const size_t vocabSize = 100000;
+  HMM<SparseDiscreteDistribution> hmm(2,
+      SparseDiscreteDistribution(vocabSize));
+
+  // State 0 emits low symbols; state 1 emits high symbols.
+  std::vector<arma::mat> observations;
+  std::vector<arma::Row<size_t>> states;
+  observations.push_back("0 0 1 50000 50000 50001 0 1 1 50001");
+  states.push_back("0 0 0 1 1 1 0 0 0 1");
+  observations.push_back("1 0 50000 50001 50000 0 0 1 50001 50000");
+  states.push_back("0 0 1 1 1 0 0 0 1 1");
+
+  hmm.Train(observations, states);
+
+  // State 0 saw symbol 0 six times and symbol 1 five times.
+  REQUIRE(hmm.Emission()[0].Probability("0") ==
+      Approx(6.0 / 11.0).epsilon(1e-5));
+  REQUIRE(hmm.Emission()[0].Probability("1") ==
+      Approx(5.0 / 11.0).epsilon(1e-5));
+
+  // State 1 saw symbol 50000 five times and symbol 50001 four times.
+  REQUIRE(hmm.Emission()[1].Probability("50000") ==
+      Approx(5.0 / 9.0).epsilon(1e-5));
+  REQUIRE(hmm.Emission()[1].Probability("50001") ==
+      Approx(4.0 / 9.0).epsilon(1e-5));
+
+  // Unseen symbols keep a tiny nonzero probability, so scoring new data
+  // cannot collapse to -inf.
+  REQUIRE(hmm.Emission()[0].Probability("99999") > 0.0);
+  REQUIRE(hmm.LogLikelihood(arma::mat("0 99999 1")) >
+      -std::numeric_limits<double>::infinity());
+}
+
+/**
+ * With a beam wide enough that no state is ever pruned, beam-pruned Viterbi
+ * must reproduce exact Viterbi: same state sequence and same log-likelihood.
+ */
+TEST_CASE("HMMPredictBeamWideBeamTest", "[HMMTest]")
+{
+  // Two well-separated Gaussian states with a known transition matrix.
+  std::vector<GaussianDistribution> emission;
+  emission.push_back(GaussianDistribution("5.0 5.0", "1.0 0.0; 0.0 1.0"));
+  emission.push_back(GaussianDistribution("-5.0 -5.0", "1.0 0.0; 0.0 1.0"));
+
+  HMM<GaussianDistribution> hmm(arma::vec("0.6 0.4"),
+      arma::mat("0.75 0.25; 0.25 0.75"), emission);
+
+  const size_t lengths[] = { 1, 2, 97, 500 };
+  for (size_t l = 0; l < 4; ++l)
+  {
+    arma::mat sequence;
+    arma::Row<size_t> trueStates;
+    hmm.Generate(lengths[l], sequence, trueStates);
+
+    arma::Row<size_t> predicted, predictedBeam;
+    const double loglik = hmm.Predict(sequence, predicted);
+    const double loglikBeam = hmm.PredictBeam(sequence, predictedBeam, 50.0);
+
+    REQUIRE(loglik == Approx(loglikBeam).epsilon(1e-10));
+    for (size_t t = 0; t < lengths[l]; ++t)
+      REQUIRE(predicted[t] == predictedBeam[t]);
+  }
+
+  // A negative beam width is invalid.
+  arma::mat sequence;
+  arma::Row<size_t> trueStates, predictedBeam;
+  hmm.Generate(10, sequence, trueStates);
+  REQUIRE_THROWS_AS(hmm.PredictBeam(sequence, predictedBeam, -1.0),
+      std::invalid_argument);
+}
+
+/**
+ * On a sparse-transition model with clearly distinguishable states, even a
+ * zero-width beam (only the per-step best survives) recovers the exact
+ * Viterbi path, and the pruned search never follows a zero-probability
+ * transition.
+ */
+TEST_CASE("HMMPredictBeamSparseTransitionTest", "[HMMTest]")
+{
+  // A four-state ring: each state can only stay or advance to the next, so
+  // most of the transition matrix is zero.  The emissions are far apart, so
+  // the observations pin down the true states.
+  arma::mat transition = arma::zeros<arma::mat>(4, 4);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    transition(i, i) = 0.6;
+    transition((i + 1) % 4, i) = 0.4;
+  }
+
+  std::vector<GaussianDistribution> emission;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    emission.push_back(GaussianDistribution(
+        arma::vec { 10.0 * i }, arma::mat { 0.5 }));
+  }
+
+  HMM<GaussianDistribution> hmm(arma::vec("1 0 0 0"), transition, emission);
+
+  arma::mat sequence;
+  arma::Row<size_t> trueStates;
+  hmm.Generate(300, sequence, trueStates);
+
+  arma::Row<size_t> predicted, predictedBeam;
+  const double loglik = hmm.Predict(sequence, predicted);
+  const double loglikBeam = hmm.PredictBeam(sequence, predictedBeam, 0.0);
+
+  REQUIRE(loglik == Approx(loglikBeam).epsilon(1e-10));
+  for (size_t t = 0; t < 300; ++t)
+    REQUIRE(predicted[t] == predictedBeam[t]);
+
+  // Every consecutive pair in the returned sequence must be a transition
+  // with nonzero probability.
+  for (size_t t = 1; t < 300; ++t)
+    REQUIRE(transition(predictedBeam[t], predictedBeam[t - 1]) > 0.0);
+}
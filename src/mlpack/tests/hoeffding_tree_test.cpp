@@ -16,6 +16,7 @@
 #include <mlpack/methods/hoeffding_trees/hoeffding_categorical_split.hpp>
 #include <mlpack/methods/hoeffding_trees/binary_numeric_split.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree_model.hpp>
+#include <mlpack/methods/hoeffding_trees/hoeffding_tree_snapshot.hpp>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -1526,3 +1527,184 @@ TEST_CASE("HoeffdingTreeEmptyConstructorTrainTest", "[HoeffdingTreeTest]")
   REQUIRE_NOTHROW(ht.Train(data, labels, false, true, 2));
   REQUIRE_NOTHROW(ht.Train(data2, info, labels2, false, 3));
 }
+
+/**
+ * Classify after every single training point.  This exercises the split
+ * publication order: the tree must always answer with a valid class and
+ * probability, whether we catch it just before or just after a split.
+ */
+TEST_CASE("HoeffdingTreeInterleavedTrainClassifyTest", "[HoeffdingTreeTest]")
+{
+  // Generate data.
+  arma::mat dataset(3, 9000);
+  arma::Row<size_t> labels(9000);
+  data::DatasetInfo info(3); // All features are numeric.
+  for (size_t i = 0; i < 9000; i += 3)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random();
+    dataset(2, i) = mlpack::math::Random();
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random();
+    dataset(1, i + 1) = mlpack::math::Random() - 1.0;
+    dataset(2, i + 1) = mlpack::math::Random() + 0.5;
+    labels[i + 1] = 2;
+
+    dataset(0, i + 2) = mlpack::math::Random();
+    dataset(1, i + 2) = mlpack::math::Random() + 1.0;
+    dataset(2, i + 2) = mlpack::math::Random() + 0.8;
+    labels[i + 2] = 1;
+  }
+
+  HoeffdingTree<> tree(info, 3);
+  for (size_t i = 0; i < 9000; ++i)
+  {
+    tree.Train(dataset.col(i), labels[i]);
+
+    // Every answer must be a valid class with a valid probability.
+    size_t prediction;
+    double probability;
+    tree.Classify(dataset.col(i), prediction, probability);
+    REQUIRE(prediction < 3);
+    REQUIRE(probability >= 0.0);
+    REQUIRE(probability <= 1.0);
+  }
+
+  // The tree should have split, and should classify reasonably.
+  REQUIRE(tree.NumChildren() > 0);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+  size_t correct = 0;
+  for (size_t i = 0; i < 9000; ++i)
+    if (labels[i] == predictions[i])
+      ++correct;
+
+  REQUIRE(correct > 6000);
+}
+
+/**
+ * A compiled snapshot of a binary-numeric Hoeffding tree must make exactly
+ * the same predictions as the tree it was built from.
+ */
+TEST_CASE("HoeffdingTreeSnapshotMatchesTreeTest", "[HoeffdingTreeTest]")
+{
+  // Three numeric dimensions; the second separates the classes.
+  arma::mat dataset(3, 9000);
+  arma::Row<size_t> labels(9000);
+  data::DatasetInfo info(3);
+  for (size_t i = 0; i < 9000; i += 3)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random();
+    dataset(2, i) = mlpack::math::Random();
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random();
+    dataset(1, i + 1) = mlpack::math::Random() - 1.0;
+    dataset(2, i + 1) = mlpack::math::Random() + 0.5;
+    labels[i + 1] = 2;
+
+    dataset(0, i + 2) = mlpack::math::Random();
+    dataset(1, i + 2) = mlpack::math::Random() + 1.0;
+    dataset(2, i + 2) = mlpack::math::Random() + 0.8;
+    labels[i + 2] = 1;
+  }
+
+  typedef HoeffdingTree<GiniImpurity, BinaryDoubleNumericSplit> TreeType;
+  TreeType tree(dataset, info, labels, 3, false);
+  REQUIRE(tree.NumChildren() > 0);
+
+  REQUIRE(HoeffdingTreeSnapshot<TreeType>::CanCompile(tree));
+  HoeffdingTreeSnapshot<TreeType> snapshot(tree);
+  REQUIRE(snapshot.NumNodes() == tree.NumDescendants() + 1);
+
+  // Single-point and batch classification must match the tree exactly.
+  arma::Row<size_t> treePredictions, snapshotPredictions;
+  tree.Classify(dataset, treePredictions);
+  snapshot.Classify(dataset, snapshotPredictions);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(snapshotPredictions[i] == treePredictions[i]);
+    REQUIRE(snapshot.Classify(dataset.col(i)) == treePredictions[i]);
+  }
+}
+
+/**
+ * Refresh() must pick up growth of the tree, and the snapshot must keep
+ * serving the old version until then.
+ */
+TEST_CASE("HoeffdingTreeSnapshotRefreshTest", "[HoeffdingTreeTest]")
+{
+  arma::mat dataset(2, 6000);
+  arma::Row<size_t> labels(6000);
+  data::DatasetInfo info(2);
+  for (size_t i = 0; i < 6000; i += 2)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random();
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random() + 3.0;
+    dataset(1, i + 1) = mlpack::math::Random();
+    labels[i + 1] = 1;
+  }
+
+  typedef HoeffdingTree<GiniImpurity, BinaryDoubleNumericSplit> TreeType;
+  TreeType tree(info, 2);
+
+  // Snapshot the untrained tree: a single leaf.
+  HoeffdingTreeSnapshot<TreeType> snapshot(tree);
+  REQUIRE(snapshot.NumNodes() == 1);
+
+  // Train; the tree grows but the snapshot stays a single leaf until it is
+  // refreshed.
+  for (size_t i = 0; i < 6000; ++i)
+    tree.Train(dataset.col(i), labels[i]);
+  REQUIRE(tree.NumChildren() > 0);
+  REQUIRE(snapshot.NumNodes() == 1);
+
+  snapshot.Refresh(tree);
+  REQUIRE(snapshot.NumNodes() == tree.NumDescendants() + 1);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(snapshot.Classify(dataset.col(i)) == tree.Classify(dataset.col(i)));
+}
+
+/**
+ * An empty snapshot predicts class 0, and a tree with a categorical split
+ * cannot be compiled.
+ */
+TEST_CASE("HoeffdingTreeSnapshotEdgeCaseTest", "[HoeffdingTreeTest]")
+{
+  typedef HoeffdingTree<GiniImpurity, BinaryDoubleNumericSplit> TreeType;
+
+  HoeffdingTreeSnapshot<TreeType> empty;
+  REQUIRE(empty.NumNodes() == 0);
+  arma::vec point(2, arma::fill::randu);
+  REQUIRE(empty.Classify(point) == 0);
+
+  // One categorical dimension that perfectly determines the label; the tree
+  // will make a three-way categorical split, which cannot be packed.
+  data::DatasetInfo info(1);
+  info.MapString<double>("a", 0);
+  info.MapString<double>("b", 0);
+  info.MapString<double>("c", 0);
+  arma::mat dataset(1, 3000);
+  arma::Row<size_t> labels(3000);
+  for (size_t i = 0; i < 3000; i += 3)
+  {
+    dataset(0, i) = 0.0;
+    labels[i] = 0;
+    dataset(0, i + 1) = 1.0;
+    labels[i + 1] = 1;
+    dataset(0, i + 2) = 2.0;
+    labels[i + 2] = 2;
+  }
+
+  TreeType categoricalTree(dataset, info, labels, 3, false);
+  REQUIRE(categoricalTree.NumChildren() > 0);
+  REQUIRE(!HoeffdingTreeSnapshot<TreeType>::CanCompile(categoricalTree));
+  HoeffdingTreeSnapshot<TreeType> snapshot;
+  REQUIRE_THROWS_AS(snapshot.Refresh(categoricalTree), std::invalid_argument);
+}
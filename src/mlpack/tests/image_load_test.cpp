@@ -156,4 +156,32 @@ TEST_CASE("ImageInfoSerialization", "[ImageLoadTest]")
   REQUIRE(info.Quality() == binaryInfo.Quality());
 }
 
+/**
+ * A batch containing an image of a different size must record the failure and
+ * return false, while still decoding the well-sized images.
+ */
+TEST_CASE("LoadVectorImageSizeMismatchTest", "[ImageLoadTest]")
+{
+  // Write a 5x5x3 image; the reference test_image.png is 50x50x3.
+  data::ImageInfo smallInfo(5, 5, 3, 90);
+  arma::Mat<unsigned char> smallImage =
+      arma::randi<arma::Mat<unsigned char>>(5 * 5 * 3, 1);
+  REQUIRE(data::Save("mismatch_test.bmp", smallImage, smallInfo, false)
+      == true);
+
+  arma::Mat<unsigned char> matrix;
+  data::ImageInfo info;
+  std::vector<std::string> files =
+      {"test_image.png", "mismatch_test.bmp", "test_image.png"};
+  REQUIRE(data::Load(files, matrix, info, false) == false);
+
+  // The well-sized images must still have been decoded into their columns.
+  REQUIRE(matrix.n_rows == 50 * 50 * 3);
+  REQUIRE(matrix.n_cols == 3);
+  for (size_t i = 0; i < matrix.n_rows; ++i)
+    REQUIRE(matrix(i, 0) == matrix(i, 2));
+
+  remove("mismatch_test.bmp");
+}
+
 #endif // HAS_STB.
@@ -313,3 +313,157 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * The fused multi-dimension overloads must give the same results as imputing
+ * the same dimensions one at a time, for every strategy.  (The dimensions do
+ * not interact: each dimension's statistics come from its own row only, so
+ * the sequential result is the reference.)
+ */
+TEST_CASE("FusedImputationTest", "[ImputationTest]")
+{
+  // A dataset with missing entries (zeros) in dimensions 0 and 2.
+  arma::mat input(5, 100, arma::fill::randu);
+  input += 1.0; // Make sure no entry is 0 by accident.
+  for (size_t i = 0; i < input.n_cols; i += 7)
+    input(0, i) = 0.0;
+  for (size_t i = 3; i < input.n_cols; i += 11)
+    input(2, i) = 0.0;
+
+  const std::vector<size_t> dims = { 0, 2 };
+  const std::vector<double> mappedValues = { 0.0, 0.0 };
+
+  // Mean imputation.
+  {
+    arma::mat fused(input), sequential(input);
+    MeanImputation<double> imputer;
+    imputer.Impute(fused, mappedValues, dims, true);
+    imputer.Impute(sequential, 0.0, 0, true);
+    imputer.Impute(sequential, 0.0, 2, true);
+    CheckMatrices(fused, sequential);
+  }
+
+  // Median imputation.
+  {
+    arma::mat fused(input), sequential(input);
+    MedianImputation<double> imputer;
+    imputer.Impute(fused, mappedValues, dims, true);
+    imputer.Impute(sequential, 0.0, 0, true);
+    imputer.Impute(sequential, 0.0, 2, true);
+    CheckMatrices(fused, sequential);
+  }
+
+  // Custom imputation.
+  {
+    arma::mat fused(input), sequential(input);
+    CustomImputation<double> imputer(99.0);
+    imputer.Impute(fused, mappedValues, dims, true);
+    imputer.Impute(sequential, 0.0, 0, true);
+    imputer.Impute(sequential, 0.0, 2, true);
+    CheckMatrices(fused, sequential);
+  }
+
+  // Listwise deletion.
+  {
+    arma::mat fused(input), sequential(input);
+    ListwiseDeletion<double> imputer;
+    imputer.Impute(fused, mappedValues, dims, true);
+    imputer.Impute(sequential, 0.0, 0, true);
+    imputer.Impute(sequential, 0.0, 2, true);
+    CheckMatrices(fused, sequential);
+  }
+
+  // The row-major overloads must agree with the column-major ones.
+  {
+    arma::mat fused(input), rowMajor(input.t());
+    MeanImputation<double> imputer;
+    imputer.Impute(fused, mappedValues, dims, true);
+    imputer.Impute(rowMajor, mappedValues, dims, false);
+    CheckMatrices(fused, arma::mat(rowMajor.t()));
+  }
+}
+
+/**
+ * The fused Impute() overload of the Imputer must unmap the missing value of
+ * every requested dimension and give the same result as one call per
+ * dimension.
+ */
+TEST_CASE("DatasetMapperFusedImputerTest", "[ImputationTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "a, 2, 3"  << endl;
+  f << "5, 6, a"  << endl;
+  f << "a, 9, 10" << endl;
+  f.close();
+
+  arma::mat input;
+  MissingPolicy policy({"a"});
+  DatasetMapper<MissingPolicy> info(policy);
+  REQUIRE(data::Load("test_file.csv", input, info) == true);
+
+  arma::mat sequential(input);
+
+  MeanImputation<double> strategy;
+  Imputer<double,
+          DatasetMapper<MissingPolicy>,
+          MeanImputation<double>> imputer(info, strategy);
+  imputer.Impute(input, "a", std::vector<size_t>({ 0, 2 }));
+  imputer.Impute(sequential, "a", 0);
+  imputer.Impute(sequential, "a", 2);
+
+  CheckMatrices(input, sequential);
+
+  // Remove the file.
+  remove("test_file.csv");
+}
+
+/**
+ * Accumulating the statistics of a dataset chunk by chunk and then applying
+ * them chunk by chunk must give the same result as fused mean imputation of
+ * the whole dataset at once.
+ */
+TEST_CASE("ChunkedMeanImputationTest", "[ImputationTest]")
+{
+  arma::mat input(4, 90, arma::fill::randu);
+  input += 1.0;
+  for (size_t i = 0; i < input.n_cols; i += 5)
+    input(1, i) = 0.0;
+  for (size_t i = 2; i < input.n_cols; i += 9)
+    input(3, i) = 0.0;
+
+  const std::vector<size_t> dims = { 1, 3 };
+  const std::vector<double> mappedValues = { 0.0, 0.0 };
+
+  // The reference: fused imputation of the whole matrix.
+  arma::mat reference(input);
+  MeanImputation<double> imputer;
+  imputer.Impute(reference, mappedValues, dims, true);
+
+  // First pass: accumulate the statistics of each chunk.
+  MeanImputation<double> chunked;
+  const size_t chunkSize = 30;
+  for (size_t begin = 0; begin < input.n_cols; begin += chunkSize)
+  {
+    arma::mat chunk = input.cols(begin, begin + chunkSize - 1);
+    chunked.Accumulate(chunk, mappedValues, dims, true);
+  }
+
+  // Second pass: rewrite the missing entries of each chunk.
+  arma::mat result(4, 90);
+  for (size_t begin = 0; begin < input.n_cols; begin += chunkSize)
+  {
+    arma::mat chunk = input.cols(begin, begin + chunkSize - 1);
+    chunked.Apply(chunk, mappedValues, dims, true);
+    result.cols(begin, begin + chunkSize - 1) = chunk;
+  }
+
+  CheckMatrices(reference, result);
+
+  // After Reset(), the statistics start over.
+  chunked.Reset();
+  chunked.Accumulate(input, mappedValues, dims, true);
+  arma::mat again(input);
+  chunked.Apply(again, mappedValues, dims, true);
+  CheckMatrices(reference, again);
+}
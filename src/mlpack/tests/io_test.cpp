@@ -26,6 +26,7 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/server_mode.hpp>
 
 #include "catch.hpp"
 
@@ -1291,3 +1292,68 @@ TEST_CASE("CppNameTest", "[IOTest]")
   REQUIRE(p.Parameters().at("help").cppType == "bool");
   REQUIRE(p.Parameters().at("double").cppType == "double");
 }
+
+/**
+ * Ensure the zero-copy enforcement modes do nothing, warn, or throw when a
+ * binding conversion reports a hidden copy.
+ */
+TEST_CASE("ZeroCopyEnforcementTest", "[IOTest]")
+{
+  const util::Params::ZeroCopyMode oldMode = util::Params::ZeroCopyEnforcement();
+
+  util::Params::ZeroCopyEnforcement() = util::Params::ZERO_COPY_OFF;
+  REQUIRE_NOTHROW(util::Params::ReportConversionCopy("test copy", 1024));
+
+  util::Params::ZeroCopyEnforcement() = util::Params::ZERO_COPY_WARN;
+  REQUIRE_NOTHROW(util::Params::ReportConversionCopy("test copy", 1024));
+
+  util::Params::ZeroCopyEnforcement() = util::Params::ZERO_COPY_FAIL;
+  REQUIRE_THROWS_AS(util::Params::ReportConversionCopy("test copy", 1024),
+      std::runtime_error);
+
+  util::Params::ZeroCopyEnforcement() = oldMode;
+}
+
+/**
+ * The server-mode model cache must hand back stored pointers by filename,
+ * reload on a type mismatch, and report ownership correctly.
+ */
+TEST_CASE("ServerModelCacheTest", "[IOTest]")
+{
+  using bindings::cli::ModelCache;
+
+  REQUIRE(ModelCache::Get<arma::mat>("cache_test.bin") == NULL);
+
+  arma::mat* model = new arma::mat(5, 5, arma::fill::randu);
+  ModelCache::Put("cache_test.bin", model);
+  REQUIRE(ModelCache::Get<arma::mat>("cache_test.bin") == model);
+  REQUIRE(ModelCache::Owns(model));
+
+  // The same filename requested as a different type must miss.
+  REQUIRE(ModelCache::Get<arma::vec>("cache_test.bin") == NULL);
+
+  ModelCache::Clear();
+  REQUIRE(ModelCache::Get<arma::mat>("cache_test.bin") == NULL);
+  REQUIRE(!ModelCache::Owns(model));
+}
+
+/**
+ * Request lines must split on whitespace, with double quotes grouping tokens
+ * that contain spaces.
+ */
+TEST_CASE("ServerTokenizeRequestLineTest", "[IOTest]")
+{
+  using bindings::cli::TokenizeRequestLine;
+
+  std::vector<std::string> tokens =
+      TokenizeRequestLine("--query q.csv -k 5");
+  REQUIRE(tokens.size() == 4);
+  REQUIRE(tokens[0] == "--query");
+  REQUIRE(tokens[3] == "5");
+
+  tokens = TokenizeRequestLine("  --input \"a file.csv\"\t-v ");
+  REQUIRE(tokens.size() == 3);
+  REQUIRE(tokens[1] == "a file.csv");
+
+  REQUIRE(TokenizeRequestLine("").empty());
+}
@@ -10,6 +10,7 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/kde/kde.hpp>
+#include <mlpack/methods/kde/sharded_kde.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
@@ -1297,3 +1298,372 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Test that the parallel single-tree evaluation matches brute force results
+ * for both bichromatic and monochromatic evaluation.  The query set is large
+ * enough for every thread to own several query points.
+ */
+TEST_CASE("ParallelSingleTreeKDETest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 500);
+  arma::mat query = arma::randu(2, 400);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double kernelBandwidth = 0.3;
+  const double relError = 0.04;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  // Bichromatic single-tree KDE.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(relError, 0.0, kernel, KDEMode::SINGLE_TREE_MODE, metric);
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(bfEstimations[i] == Approx(treeEstimations[i]).epsilon(relError));
+
+  // Monochromatic single-tree KDE.  The monochromatic evaluation never
+  // computes the estimation of a point with itself, so remove the
+  // self-contribution from the brute force results.
+  arma::vec bfMonoEstimations = arma::vec(reference.n_cols, arma::fill::zeros);
+  arma::vec treeMonoEstimations;
+  BruteForceKDE<GaussianKernel>(reference,
+                                reference,
+                                bfMonoEstimations,
+                                kernel);
+  bfMonoEstimations -= kernel.Evaluate(0.0) / reference.n_cols;
+  kde.Evaluate(treeMonoEstimations);
+
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    REQUIRE(bfMonoEstimations[i] ==
+        Approx(treeMonoEstimations[i]).epsilon(relError));
+  }
+}
+
+/**
+ * Test multi-bandwidth dual-tree evaluation against brute force results for
+ * each candidate bandwidth.
+ */
+TEST_CASE("MultiBandwidthKDEBruteForceTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 300);
+  arma::mat query = arma::randu(2, 100);
+  const std::vector<double> bandwidths = {0.1, 0.2, 0.4, 0.8};
+  const double relError = 0.05;
+
+  // One dual-tree traversal for all candidate bandwidths.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(relError, 0.0, GaussianKernel(), KDEMode::DUAL_TREE_MODE, metric);
+  kde.Train(reference);
+  arma::mat treeEstimations;
+  kde.Evaluate(query, bandwidths, treeEstimations);
+
+  REQUIRE(treeEstimations.n_rows == bandwidths.size());
+  REQUIRE(treeEstimations.n_cols == query.n_cols);
+
+  // Each row must match a brute force evaluation with that bandwidth.
+  for (size_t b = 0; b < bandwidths.size(); ++b)
+  {
+    arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+    GaussianKernel kernel(bandwidths[b]);
+    BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+    for (size_t i = 0; i < query.n_cols; ++i)
+    {
+      REQUIRE(bfEstimations[i] ==
+          Approx(treeEstimations(b, i)).epsilon(relError));
+    }
+  }
+}
+
+/**
+ * Test multi-bandwidth single-tree evaluation against brute force results for
+ * each candidate bandwidth.
+ */
+TEST_CASE("MultiBandwidthSingleKDEBruteForceTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 300);
+  arma::mat query = arma::randu(2, 100);
+  const std::vector<double> bandwidths = {0.2, 0.3, 0.6};
+  const double relError = 0.04;
+
+  // One single-tree traversal per query point for all candidate bandwidths.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(relError, 0.0, GaussianKernel(), KDEMode::SINGLE_TREE_MODE, metric);
+  kde.Train(reference);
+  arma::mat treeEstimations;
+  kde.Evaluate(query, bandwidths, treeEstimations);
+
+  for (size_t b = 0; b < bandwidths.size(); ++b)
+  {
+    arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+    GaussianKernel kernel(bandwidths[b]);
+    BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+    for (size_t i = 0; i < query.n_cols; ++i)
+    {
+      REQUIRE(bfEstimations[i] ==
+          Approx(treeEstimations(b, i)).epsilon(relError));
+    }
+  }
+}
+
+/**
+ * Test that the multi-bandwidth evaluation throws on invalid input.
+ */
+TEST_CASE("MultiBandwidthKDEInvalidInputTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 50);
+  arma::mat query = arma::randu(2, 10);
+  arma::mat estimations;
+
+  // Untrained model.
+  KDE<> untrained;
+  REQUIRE_THROWS_AS(
+      untrained.Evaluate(query, std::vector<double>({0.5}), estimations),
+      std::runtime_error);
+
+  // Empty bandwidth list.
+  KDE<> kde;
+  kde.Train(reference);
+  REQUIRE_THROWS_AS(
+      kde.Evaluate(query, std::vector<double>(), estimations),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the sharded two-phase KDE reduction matches brute force results
+ * within the requested relative error.
+ */
+TEST_CASE("ShardedKDEBruteForceTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 400);
+  arma::mat query = arma::randu(2, 100);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec shardedEstimations;
+  const double kernelBandwidth = 0.2;
+  const double relError = 0.05;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  // Sharded KDE.
+  metric::EuclideanDistance metric;
+  ShardedKDE<GaussianKernel,
+             metric::EuclideanDistance,
+             arma::mat,
+             tree::KDTree>
+      sharded(reference, 4, relError, kernel, 16, metric);
+
+  REQUIRE(sharded.NumShards() == 4);
+
+  sharded.Evaluate(query, shardedEstimations);
+
+  // Check whether results are equal.
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    REQUIRE(bfEstimations[i] ==
+        Approx(shardedEstimations[i]).epsilon(relError));
+  }
+
+  // Every (shard, block) pair was either refined or settled from bounds.
+  const size_t numBlocks = (query.n_cols + 15) / 16;
+  REQUIRE(sharded.RefinedPairs() + sharded.SkippedPairs() ==
+      sharded.NumShards() * numBlocks);
+}
+
+/**
+ * Test that the cross-shard bounds actually prune per-shard work when the
+ * shards are well separated from most of the queries.
+ */
+TEST_CASE("ShardedKDEPruningTest", "[KDETest]")
+{
+  // Two well-separated clusters of reference points; queries near the first
+  // cluster get a negligible contribution from the second one.
+  arma::mat reference = arma::randu(2, 400);
+  reference.cols(200, 399) += 50.0;
+  arma::mat query = arma::randu(2, 100);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec shardedEstimations;
+  const double kernelBandwidth = 0.5;
+  const double relError = 0.05;
+
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  // Two shards, matching the two clusters.
+  ShardedKDE<> sharded(reference, 2, relError, kernel, 16);
+  sharded.Evaluate(query, shardedEstimations);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    REQUIRE(bfEstimations[i] ==
+        Approx(shardedEstimations[i]).epsilon(relError));
+  }
+
+  // The far shard should have been settled from the bounds alone for every
+  // block: its contribution interval collapses to (nearly) zero.
+  REQUIRE(sharded.SkippedPairs() >= (query.n_cols + 15) / 16);
+}
+
+/**
+ * Test that invalid sharded KDE arguments throw.
+ */
+TEST_CASE("ShardedKDEInvalidArgumentsTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 50);
+  GaussianKernel kernel(0.2);
+
+  REQUIRE_THROWS_AS(ShardedKDE<>(reference, 0, 0.05, kernel),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ShardedKDE<>(arma::mat(2, 0), 2, 0.05, kernel),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the single-tree weighted kernel summation matches the brute-force
+ * weighted sums within the relative error tolerance.
+ */
+TEST_CASE("KDEWeightedSumSingleTreeTest", "[KDETest]")
+{
+  const double relError = 0.05;
+  arma::mat reference = arma::randu(2, 300);
+  arma::mat query = arma::randu(2, 100);
+
+  // One row of regression targets and one row of ones, as in a
+  // Nadaraya-Watson numerator/denominator pair.
+  arma::mat weights(2, reference.n_cols);
+  weights.row(0) = arma::randu<arma::rowvec>(reference.n_cols);
+  weights.row(1).ones();
+
+  GaussianKernel kernel(0.3);
+  EuclideanDistance metric;
+
+  // Brute-force weighted sums.
+  arma::mat exactSums(weights.n_rows, query.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    for (size_t j = 0; j < reference.n_cols; ++j)
+    {
+      exactSums.col(i) += weights.col(j) *
+          kernel.Evaluate(metric.Evaluate(query.col(i), reference.col(j)));
+    }
+  }
+
+  // Build the reference tree and rearrange the weights to match its dataset.
+  typedef KDTree<EuclideanDistance, kde::KDEStat, arma::mat> Tree;
+  std::vector<size_t> oldFromNewReferences;
+  Tree referenceTree(reference, oldFromNewReferences, 2);
+  arma::mat rearrangedWeights(weights.n_rows, weights.n_cols);
+  for (size_t i = 0; i < oldFromNewReferences.size(); ++i)
+    rearrangedWeights.col(i) = weights.col(oldFromNewReferences[i]);
+
+  typedef KDEWeightedSumRules<EuclideanDistance, GaussianKernel, Tree>
+      RuleType;
+  arma::mat sums(weights.n_rows, query.n_cols, arma::fill::zeros);
+  RuleType rules(referenceTree.Dataset(), query, rearrangedWeights, sums,
+      relError, 0.0, metric, kernel, false);
+
+  Tree::SingleTreeTraverser<RuleType> traverser(rules);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    traverser.Traverse(i, referenceTree);
+
+  // The weights are nonnegative, so every row honors the relative error
+  // tolerance.
+  for (size_t i = 0; i < query.n_cols; ++i)
+    for (size_t r = 0; r < weights.n_rows; ++r)
+      REQUIRE(sums(r, i) == Approx(exactSums(r, i)).epsilon(relError));
+}
+
+/**
+ * Test that the dual-tree weighted kernel summation produces accurate
+ * Nadaraya-Watson regression predictions.
+ */
+TEST_CASE("KDEWeightedSumDualTreeTest", "[KDETest]")
+{
+  const double relError = 0.02;
+  arma::mat reference = arma::randu(2, 400);
+  arma::mat query = arma::randu(2, 150);
+
+  // Predict a smooth function of the position.
+  arma::mat weights(2, reference.n_cols);
+  weights.row(0) = arma::sin(reference.row(0)) % arma::cos(reference.row(1));
+  weights.row(0) += 2.0; // Keep the targets (and thus the weights) positive.
+  weights.row(1).ones();
+
+  GaussianKernel kernel(0.2);
+  EuclideanDistance metric;
+
+  // Brute-force weighted sums.
+  arma::mat exactSums(weights.n_rows, query.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    for (size_t j = 0; j < reference.n_cols; ++j)
+    {
+      exactSums.col(i) += weights.col(j) *
+          kernel.Evaluate(metric.Evaluate(query.col(i), reference.col(j)));
+    }
+  }
+
+  // Build both trees and rearrange the weights to match the reference tree.
+  typedef KDTree<EuclideanDistance, kde::KDEStat, arma::mat> Tree;
+  std::vector<size_t> oldFromNewQueries, oldFromNewReferences;
+  Tree queryTree(query, oldFromNewQueries, 2);
+  Tree referenceTree(reference, oldFromNewReferences, 2);
+  arma::mat rearrangedWeights(weights.n_rows, weights.n_cols);
+  for (size_t i = 0; i < oldFromNewReferences.size(); ++i)
+    rearrangedWeights.col(i) = weights.col(oldFromNewReferences[i]);
+
+  typedef KDEWeightedSumRules<EuclideanDistance, GaussianKernel, Tree>
+      RuleType;
+  arma::mat treeSums(weights.n_rows, query.n_cols, arma::fill::zeros);
+  RuleType rules(referenceTree.Dataset(), queryTree.Dataset(),
+      rearrangedWeights, treeSums, relError, 0.0, metric, kernel, false);
+
+  Tree::DualTreeTraverser<RuleType> traverser(rules);
+  traverser.Traverse(queryTree, referenceTree);
+
+  // Undo the query tree rearrangement.
+  arma::mat sums(weights.n_rows, query.n_cols);
+  for (size_t i = 0; i < oldFromNewQueries.size(); ++i)
+    sums.col(oldFromNewQueries[i]) = treeSums.col(i);
+
+  // Each sum honors the relative error tolerance, so the Nadaraya-Watson
+  // prediction (numerator over denominator) is accurate as well.
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    REQUIRE(sums(0, i) == Approx(exactSums(0, i)).epsilon(relError));
+    REQUIRE(sums(1, i) == Approx(exactSums(1, i)).epsilon(relError));
+
+    const double prediction = sums(0, i) / sums(1, i);
+    const double exactPrediction = exactSums(0, i) / exactSums(1, i);
+    REQUIRE(prediction == Approx(exactPrediction).epsilon(3 * relError));
+  }
+}
@@ -147,3 +147,80 @@ TEST_CASE("CircleTransformationTestNystroem", "[KernelPCATest]")
   REQUIRE(ranges[0].Contains(ranges[2]) == false);
   REQUIRE(ranges[1].Contains(ranges[2]) == false);
 }
+
+/**
+ * The reduced-set transform should reproduce the projection of the training
+ * points well enough to keep the three rings linearly separable, using far
+ * fewer kernel evaluations per point than the full expansion.
+ */
+TEST_CASE("KernelPCAReducedSetTransformTest", "[KernelPCATest]")
+{
+  // The dataset, which will have three concentric rings in three dimensions.
+  arma::mat dataset;
+
+  // Now, there are 750 points centered at the origin with unit variance.
+  dataset.randn(3, 750);
+  dataset *= 0.05;
+
+  // Take the second 250 points and spread them away from the origin.
+  for (size_t i = 250; i < 500; ++i)
+  {
+    // Push the point away from the origin by 2.
+    const double pointNorm = norm(dataset.col(i), 2);
+
+    dataset(0, i) += 2.0 * (dataset(0, i) / pointNorm);
+    dataset(1, i) += 2.0 * (dataset(1, i) / pointNorm);
+    dataset(2, i) += 2.0 * (dataset(2, i) / pointNorm);
+  }
+
+  // Take the third 500 points and spread them away from the origin.
+  for (size_t i = 500; i < 750; ++i)
+  {
+    // Push the point away from the origin by 5.
+    const double pointNorm = norm(dataset.col(i), 2);
+
+    dataset(0, i) += 5.0 * (dataset(0, i) / pointNorm);
+    dataset(1, i) += 5.0 * (dataset(1, i) / pointNorm);
+    dataset(2, i) += 5.0 * (dataset(2, i) / pointNorm);
+  }
+
+  // Perform the full KPCA transformation down to one dimension, keeping the
+  // dataset intact.
+  KernelPCA<GaussianKernel> p;
+  arma::mat transformed;
+  arma::vec eigval;
+  arma::mat eigvec;
+  p.Apply(dataset, transformed, eigval, eigvec, 1);
+  transformed.shed_rows(1, transformed.n_rows - 1);
+
+  // Compress the expansion from 750 training points to 100 representatives.
+  const double error = p.BuildReducedSet(dataset, transformed, 100);
+
+  REQUIRE(p.ReducedPoints().n_cols == 100);
+  REQUIRE(error >= 0.0);
+  REQUIRE(error < 0.5);
+
+  // Project the points through the reduced expansion.
+  arma::mat reducedTransformed;
+  p.Transform(dataset, reducedTransformed);
+
+  REQUIRE(reducedTransformed.n_rows == 1);
+  REQUIRE(reducedTransformed.n_cols == dataset.n_cols);
+
+  // The projections of the rings must still be linearly separable.
+  Range ranges[3];
+  ranges[0] = Range();
+  ranges[1] = Range();
+  ranges[2] = Range();
+
+  for (size_t i = 0; i < 250; ++i)
+    ranges[0] |= reducedTransformed(0, i);
+  for (size_t i = 250; i < 500; ++i)
+    ranges[1] |= reducedTransformed(0, i);
+  for (size_t i = 500; i < 750; ++i)
+    ranges[2] |= reducedTransformed(0, i);
+
+  REQUIRE(ranges[0].Contains(ranges[1]) == false);
+  REQUIRE(ranges[0].Contains(ranges[2]) == false);
+  REQUIRE(ranges[1].Contains(ranges[2]) == false);
+}
@@ -20,6 +20,8 @@
 #include <mlpack/core/kernels/spherical_kernel.hpp>
 #include <mlpack/core/kernels/pspectrum_string_kernel.hpp>
 #include <mlpack/core/kernels/cauchy_kernel.hpp>
+#include <mlpack/core/kernels/triangular_kernel.hpp>
+#include <mlpack/core/kernels/gram_matrix.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 
@@ -632,3 +634,138 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * The batched kernel evaluation must agree with the pairwise evaluation for
+ * every kernel that advertises it.
+ */
+template<typename KernelType>
+void CheckBatchEvaluate(KernelType& kernel,
+                        const arma::mat& queries,
+                        const arma::mat& references)
+{
+  arma::mat results;
+  kernel.Evaluate(queries, references, results);
+
+  REQUIRE(results.n_rows == queries.n_cols);
+  REQUIRE(results.n_cols == references.n_cols);
+
+  for (size_t j = 0; j < references.n_cols; ++j)
+  {
+    for (size_t i = 0; i < queries.n_cols; ++i)
+    {
+      const double expected = kernel.Evaluate(arma::vec(queries.col(i)),
+          arma::vec(references.col(j)));
+      REQUIRE(results(i, j) == Approx(expected).margin(1e-10));
+    }
+  }
+}
+
+TEST_CASE("KernelBatchEvaluateTest", "[KernelTest]")
+{
+  arma::mat queries(8, 15, arma::fill::randn);
+  arma::mat references(8, 20, arma::fill::randn);
+
+  GaussianKernel gaussian(1.3);
+  CheckBatchEvaluate(gaussian, queries, references);
+
+  LaplacianKernel laplacian(0.7);
+  CheckBatchEvaluate(laplacian, queries, references);
+
+  CauchyKernel cauchy(2.0);
+  CheckBatchEvaluate(cauchy, queries, references);
+
+  EpanechnikovKernel epanechnikov(4.0);
+  CheckBatchEvaluate(epanechnikov, queries, references);
+
+  SphericalKernel spherical(3.5);
+  CheckBatchEvaluate(spherical, queries, references);
+
+  TriangularKernel triangular(5.0);
+  CheckBatchEvaluate(triangular, queries, references);
+
+  LinearKernel linear;
+  CheckBatchEvaluate(linear, queries, references);
+
+  PolynomialKernel polynomial(3.0, 0.5);
+  CheckBatchEvaluate(polynomial, queries, references);
+
+  HyperbolicTangentKernel tanhKernel(0.5, 0.25);
+  CheckBatchEvaluate(tanhKernel, queries, references);
+
+  CosineDistance cosine;
+  CheckBatchEvaluate(cosine, queries, references);
+
+  // A zero query must give zero cosine distance against everything, as in
+  // the pairwise overload.
+  queries.col(0).zeros();
+  CheckBatchEvaluate(cosine, queries, references);
+}
+
+//! A pairwise-only kernel, to exercise the tile fallback path of
+//! ComputeKernelMatrix().
+struct PairwiseOnlyKernel
+{
+  template<typename VecTypeA, typename VecTypeB>
+  double Evaluate(const VecTypeA& a, const VecTypeB& b) const
+  {
+    return std::pow(arma::dot(a, b) + 1.0, 2.0);
+  }
+};
+
+/**
+ * The tiled kernel matrix construction must agree with the direct double
+ * loop, for batched kernels and for pairwise-only kernels, and for tile
+ * sizes that do and do not divide the number of points.
+ */
+TEST_CASE("ComputeKernelMatrixTest", "[KernelTest]")
+{
+  arma::mat data(6, 50, arma::fill::randn);
+  arma::mat references(6, 23, arma::fill::randn);
+
+  GaussianKernel gaussian(1.5);
+  PairwiseOnlyKernel pairwiseOnly;
+
+  for (size_t blockSize = 7; blockSize <= 64; blockSize *= 4)
+  {
+    // Symmetric construction.
+    arma::mat gaussianGram, pairwiseGram;
+    ComputeKernelMatrix(data, gaussianGram, gaussian, blockSize);
+    ComputeKernelMatrix(data, pairwiseGram, pairwiseOnly, blockSize);
+
+    REQUIRE(gaussianGram.n_rows == data.n_cols);
+    REQUIRE(gaussianGram.n_cols == data.n_cols);
+
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      for (size_t i = 0; i < data.n_cols; ++i)
+      {
+        REQUIRE(gaussianGram(i, j) == Approx(gaussian.Evaluate(
+            arma::vec(data.col(i)), arma::vec(data.col(j)))).margin(1e-10));
+        REQUIRE(pairwiseGram(i, j) == Approx(pairwiseOnly.Evaluate(
+            data.col(i), data.col(j))).margin(1e-10));
+      }
+    }
+
+    // Rectangular construction.
+    arma::mat gaussianCross, pairwiseCross;
+    ComputeKernelMatrix(data, references, gaussianCross, gaussian, blockSize);
+    ComputeKernelMatrix(data, references, pairwiseCross, pairwiseOnly,
+        blockSize);
+
+    REQUIRE(gaussianCross.n_rows == data.n_cols);
+    REQUIRE(gaussianCross.n_cols == references.n_cols);
+
+    for (size_t j = 0; j < references.n_cols; ++j)
+    {
+      for (size_t i = 0; i < data.n_cols; ++i)
+      {
+        REQUIRE(gaussianCross(i, j) == Approx(gaussian.Evaluate(
+            arma::vec(data.col(i)),
+            arma::vec(references.col(j)))).margin(1e-10));
+        REQUIRE(pairwiseCross(i, j) == Approx(pairwiseOnly.Evaluate(
+            data.col(i), references.col(j))).margin(1e-10));
+      }
+    }
+  }
+}
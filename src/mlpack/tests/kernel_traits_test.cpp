@@ -55,3 +55,34 @@ TEST_CASE("IsNormalizedTest", "[KernelTraitsTest]")
   REQUIRE((bool) KernelTraits<PolynomialKernel>::IsNormalized == false);
   REQUIRE((bool) KernelTraits<PSpectrumStringKernel>::IsNormalized == false);
 }
+
+TEST_CASE("SupportsBatchEvaluationTest", "[KernelTraitsTest]")
+{
+  // If the type is not a valid kernel, it should be false (default value).
+  REQUIRE((bool) KernelTraits<int>::SupportsBatchEvaluation == false);
+
+  // Kernels with a batched Evaluate() overload.
+  REQUIRE((bool) KernelTraits<CosineDistance>::SupportsBatchEvaluation ==
+      true);
+  REQUIRE((bool) KernelTraits<EpanechnikovKernel>::SupportsBatchEvaluation ==
+      true);
+  REQUIRE((bool) KernelTraits<GaussianKernel>::SupportsBatchEvaluation ==
+      true);
+  REQUIRE((bool) KernelTraits<LaplacianKernel>::SupportsBatchEvaluation ==
+      true);
+  REQUIRE((bool) KernelTraits<SphericalKernel>::SupportsBatchEvaluation ==
+      true);
+  REQUIRE((bool) KernelTraits<TriangularKernel>::SupportsBatchEvaluation ==
+      true);
+  REQUIRE((bool) KernelTraits<CauchyKernel>::SupportsBatchEvaluation == true);
+  REQUIRE((bool) KernelTraits<LinearKernel>::SupportsBatchEvaluation == true);
+  REQUIRE((bool) KernelTraits<PolynomialKernel>::SupportsBatchEvaluation ==
+      true);
+  REQUIRE(
+      (bool) KernelTraits<HyperbolicTangentKernel>::SupportsBatchEvaluation ==
+      true);
+
+  // Kernels without a batched overload.
+  REQUIRE((bool) KernelTraits<PSpectrumStringKernel>::SupportsBatchEvaluation
+      == false);
+}
@@ -561,3 +561,33 @@ TEST_CASE("KFNDualBallTreeTest", "[KFNTest]")
     REQUIRE(ballDistances(i) == Approx(kdDistances(i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Test that the large-k heap-based candidate sets give the same results as
+ * the naive search.  k above the KSelectionSet flat threshold exercises the
+ * binary heap fallback; a small k exercises the flat sorted arrays.
+ */
+TEST_CASE("KFNKSelectionFallbackTest", "[KFNTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 200);
+
+  for (size_t k : { (size_t) 8, (size_t) 40 })
+  {
+    KFN kfn(dataset);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    kfn.Search(k, neighbors, distances);
+
+    KFN naive(dataset, NAIVE_MODE);
+    arma::Mat<size_t> naiveNeighbors;
+    arma::mat naiveDistances;
+    naive.Search(k, naiveNeighbors, naiveDistances);
+
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(neighbors[i] == naiveNeighbors[i]);
+      REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+    }
+  }
+}
@@ -25,6 +25,8 @@
 
 #include "catch.hpp"
 #include <mlpack/methods/kmeans/kill_empty_clusters.hpp>
+#include <mlpack/methods/kmeans/mini_batch_kmeans.hpp>
+#include <mlpack/methods/kmeans/kmeans_parallel_initialization.hpp>
 
 using namespace mlpack;
 using namespace mlpack::kmeans;
@@ -735,6 +737,42 @@ TEST_CASE("DTNNTest", "[KMeansTest]")
   }
 }
 
+/**
+ * On well-separated clusters the dual-tree algorithm spends most of its
+ * iterations with nearly the whole tree statically pruned, which exercises
+ * the frozen-subtree skipping in UpdateTree(); the results must still match
+ * the naive algorithm exactly.
+ */
+TEST_CASE("DTNNStaticPrunedConvergenceTest", "[KMeansTest]")
+{
+  // Five well-separated Gaussians.
+  arma::mat dataset(4, 1000);
+  dataset.randn();
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    dataset.col(i) += 10.0 * arma::ones<arma::vec>(4) * (double) (i % 5);
+
+  const size_t k = 5;
+  arma::mat centroids(4, k);
+  centroids.randu();
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+  KMeans<metric::EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      DefaultDualTreeKMeans> dtnn;
+  arma::Row<size_t> dtnnAssignments;
+  arma::mat dtnnCentroids(centroids);
+  dtnn.Cluster(dataset, k, dtnnAssignments, dtnnCentroids, false, true);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(assignments[i] == dtnnAssignments[i]);
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    REQUIRE(naiveCentroids[i] == Approx(dtnnCentroids[i]).epsilon(1e-7));
+}
+
 TEST_CASE("DTNNCoverTreeTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -800,3 +838,259 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+/**
+ * Make sure the mini-batch Lloyd policy recovers well-separated clusters.
+ * The result is stochastic, so we only check that each true cluster center is
+ * matched by exactly one learned centroid.
+ */
+TEST_CASE("MiniBatchKMeansTest", "[KMeansTest]")
+{
+  // Three well-separated Gaussian clusters.
+  arma::mat dataset(2, 3000);
+  arma::mat means("0.0 10.0 -10.0; 0.0 10.0 10.0");
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    dataset.col(i) = means.col(i % 3) + 0.5 * arma::randn<arma::vec>(2);
+
+  KMeans<metric::EuclideanDistance, SampleInitialization,
+      MaxVarianceNewCluster, MiniBatchKMeans> kmeans;
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  kmeans.Cluster(dataset, 3, assignments, centroids);
+
+  // Every true mean must be matched by exactly one centroid.
+  std::vector<bool> used(3, false);
+  for (size_t j = 0; j < 3; ++j)
+  {
+    size_t matches = 0;
+    for (size_t i = 0; i < 3; ++i)
+    {
+      if (metric::EuclideanDistance::Evaluate(centroids.col(i),
+          means.col(j)) < 1.0)
+      {
+        REQUIRE(!used[i]);
+        used[i] = true;
+        ++matches;
+      }
+    }
+    REQUIRE(matches == 1);
+  }
+}
+
+/**
+ * The blocked (GEMM-based) assignment path used by NaiveKMeans for the
+ * Euclidean distance must produce the same iteration result as a plain
+ * pairwise assignment.
+ */
+TEST_CASE("NaiveKMeansBlockedIterationTest", "[KMeansTest]")
+{
+  arma::mat dataset(20, 1037); // Not a multiple of the block size.
+  dataset.randu();
+  arma::mat centroids(20, 6);
+  centroids.randu();
+
+  metric::EuclideanDistance metric;
+  NaiveKMeans<metric::EuclideanDistance, arma::mat> lloyd(dataset, metric);
+
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+  lloyd.Iterate(centroids, newCentroids, counts);
+
+  // Compute the same iteration by brute force.
+  arma::mat bruteCentroids(20, 6, arma::fill::zeros);
+  arma::Col<size_t> bruteCounts(6, arma::fill::zeros);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closest = 6;
+    for (size_t j = 0; j < 6; ++j)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          dataset.col(i), centroids.col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closest = j;
+      }
+    }
+
+    bruteCentroids.col(closest) += dataset.col(i);
+    bruteCounts(closest)++;
+  }
+  for (size_t j = 0; j < 6; ++j)
+    if (bruteCounts(j) != 0)
+      bruteCentroids.col(j) /= bruteCounts(j);
+
+  for (size_t j = 0; j < 6; ++j)
+  {
+    REQUIRE(counts(j) == bruteCounts(j));
+    for (size_t d = 0; d < 20; ++d)
+      REQUIRE(newCentroids(d, j) == Approx(bruteCentroids(d, j)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that the k-means|| initialization strategy returns decent initial
+ * cluster estimates.  This uses the same dataset and distortion bound as the
+ * k-means++ test above, since k-means|| approximates k-means++ seeding.
+ */
+TEST_CASE("KMeansParallelInitializationTest", "[KMeansTest]")
+{
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  KMeansParallelInitialization k;
+  arma::mat resultingCentroids;
+  k.Cluster(data, 5, resultingCentroids);
+
+  REQUIRE(resultingCentroids.n_rows == 3);
+  REQUIRE(resultingCentroids.n_cols == 5);
+
+  // Calculate resulting assignments.
+  arma::Row<size_t> assignments(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double bestDist = DBL_MAX;
+    for (size_t j = 0; j < 5; ++j)
+    {
+      const double dist = metric::EuclideanDistance::Evaluate(data.col(i),
+          resultingCentroids.col(j));
+      if (dist < bestDist)
+      {
+        bestDist = dist;
+        assignments[i] = j;
+      }
+    }
+  }
+
+  // Calculate sum of distances from centroid means; the bound is the same as
+  // for the k-means++ test.
+  double distortion = 0;
+  for (size_t i = 0; i < 3000; ++i)
+    distortion += metric::EuclideanDistance::Evaluate(data.col(i),
+        resultingCentroids.col(assignments[i]));
+
+  REQUIRE(distortion < 14500.0);
+}
+
+/**
+ * Make sure k-means works on float32 data, with float32 centroids.
+ */
+TEST_CASE("KMeansFMatTest", "[KMeansTest]")
+{
+  // Three well-separated clusters.
+  arma::fmat data(2, 300, arma::fill::randn);
+  data.cols(100, 199) += 20.0;
+  data.cols(200, 299) -= 20.0;
+
+  KMeans<metric::EuclideanDistance, SampleInitialization,
+      MaxVarianceNewCluster, NaiveKMeans, arma::fmat> kmeans;
+  arma::Row<size_t> assignments;
+  arma::fmat centroids;
+  kmeans.Cluster(data, 3, assignments, centroids);
+
+  REQUIRE(centroids.n_cols == 3);
+  // All points in one true cluster must share an assignment.
+  for (size_t i = 1; i < 100; ++i)
+    REQUIRE(assignments[i] == assignments[0]);
+  for (size_t i = 101; i < 200; ++i)
+    REQUIRE(assignments[i] == assignments[100]);
+  for (size_t i = 201; i < 300; ++i)
+    REQUIRE(assignments[i] == assignments[200]);
+}
+
+
+/**
+ * The fixed pairwise reduction must combine partials into the exact full
+ * reduction for integer data, in a thread-count-independent order.
+ */
+TEST_CASE("PairwiseReduceTest", "[KMeansTest]")
+{
+  std::vector<arma::Col<size_t>> partials;
+  arma::Col<size_t> expected(4, arma::fill::zeros);
+  for (size_t i = 0; i < 7; ++i)
+  {
+    arma::Col<size_t> partial(4);
+    partial.fill(i + 1);
+    expected += partial;
+    partials.push_back(std::move(partial));
+  }
+
+  util::PairwiseReduce(partials);
+
+  for (size_t d = 0; d < 4; ++d)
+    REQUIRE(partials[0](d) == expected(d));
+}
+
+/**
+ * In deterministic mode, repeated NaiveKMeans iterations over the same input
+ * must produce bitwise identical results, for both the blocked Euclidean
+ * path and the generic metric path, and the results must still agree with
+ * the default mode up to floating-point reduction order.
+ */
+TEST_CASE("NaiveKMeansDeterministicModeTest", "[KMeansTest]")
+{
+  arma::mat dataset(10, 2053); // Not a multiple of block or chunk sizes.
+  dataset.randu();
+  arma::mat centroids(10, 5);
+  centroids.randu();
+
+  arma::mat defaultCentroids, firstCentroids, secondCentroids;
+  arma::Col<size_t> defaultCounts, firstCounts, secondCounts;
+
+  // Euclidean (blocked) path.
+  {
+    metric::EuclideanDistance metric;
+    NaiveKMeans<metric::EuclideanDistance, arma::mat> lloyd(dataset, metric);
+
+    lloyd.Iterate(centroids, defaultCentroids, defaultCounts);
+
+    util::DeterministicMode(true);
+    lloyd.Iterate(centroids, firstCentroids, firstCounts);
+    lloyd.Iterate(centroids, secondCentroids, secondCounts);
+    util::DeterministicMode(false);
+  }
+
+  REQUIRE(arma::all(firstCounts == secondCounts));
+  // Bitwise reproducibility: not just approximate equality.
+  for (size_t i = 0; i < firstCentroids.n_elem; ++i)
+    REQUIRE(firstCentroids[i] == secondCentroids[i]);
+
+  REQUIRE(arma::all(firstCounts == defaultCounts));
+  for (size_t i = 0; i < firstCentroids.n_elem; ++i)
+    REQUIRE(firstCentroids[i] == Approx(defaultCentroids[i]).epsilon(1e-10));
+
+  // Generic metric path.
+  {
+    metric::ManhattanDistance metric;
+    NaiveKMeans<metric::ManhattanDistance, arma::mat> lloyd(dataset, metric);
+
+    lloyd.Iterate(centroids, defaultCentroids, defaultCounts);
+
+    util::DeterministicMode(true);
+    lloyd.Iterate(centroids, firstCentroids, firstCounts);
+    lloyd.Iterate(centroids, secondCentroids, secondCounts);
+    util::DeterministicMode(false);
+  }
+
+  REQUIRE(arma::all(firstCounts == secondCounts));
+  for (size_t i = 0; i < firstCentroids.n_elem; ++i)
+    REQUIRE(firstCentroids[i] == secondCentroids[i]);
+
+  REQUIRE(arma::all(firstCounts == defaultCounts));
+  for (size_t i = 0; i < firstCentroids.n_elem; ++i)
+    REQUIRE(firstCentroids[i] == Approx(defaultCentroids[i]).epsilon(1e-10));
+}
@@ -12,8 +12,15 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/incremental_knn.hpp>
+#include <mlpack/methods/neighbor_search/inverted_index_knn.hpp>
+#include <mlpack/methods/neighbor_search/sharded_neighbor_search.hpp>
+#include <mlpack/methods/neighbor_search/spill_tuning.hpp>
+#include <mlpack/core/tree/budgeted_single_tree_traverser.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
+
+#include <map>
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
 
@@ -1832,3 +1839,877 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(arma::accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * Test that IncrementalKNN stays exact through a stream of inserts and
+ * deletes, across both delta-buffer serving and explicit rebuilds.
+ */
+TEST_CASE("IncrementalKNNStreamingTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 200);
+  IncrementalKNN index(dataset);
+
+  // Track the live points ourselves for the brute-force reference.
+  std::map<size_t, arma::vec> live;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    live[i] = dataset.col(i);
+
+  // Delete some points and insert some new ones.
+  for (size_t i = 0; i < 200; i += 7)
+  {
+    index.Delete(i);
+    live.erase(i);
+  }
+  for (size_t i = 0; i < 25; ++i)
+  {
+    arma::vec point = arma::randu<arma::vec>(5);
+    const size_t id = index.Insert(point);
+    live[id] = point;
+  }
+
+  arma::mat querySet = arma::randu<arma::mat>(5, 30);
+  const size_t k = 5;
+
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    index.Search(querySet, k, neighbors, distances);
+
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
+      // Brute force over the live points.
+      std::vector<std::pair<double, size_t>> all;
+      for (std::map<size_t, arma::vec>::const_iterator it = live.begin();
+           it != live.end(); ++it)
+      {
+        all.push_back(std::make_pair(metric::EuclideanDistance::Evaluate(
+            querySet.col(q), it->second), it->first));
+      }
+      std::sort(all.begin(), all.end());
+
+      for (size_t j = 0; j < k; ++j)
+      {
+        REQUIRE(distances(j, q) == Approx(all[j].first).epsilon(1e-7));
+        REQUIRE(neighbors(j, q) == all[j].second);
+      }
+    }
+
+    // Second pass runs against the compacted tree with empty deltas.
+    index.Rebuild();
+    REQUIRE(index.BufferSize() == 0);
+    REQUIRE(index.TombstoneCount() == 0);
+  }
+}
+
+/**
+ * Test the spill tree defeatist auto-tuner: the sweep must measure sane
+ * recalls and counters, and a generous tau grid must reach perfect recall.
+ */
+TEST_CASE("TuneDefeatistSpillTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 500);
+  arma::mat querySample = arma::randu<arma::mat>(8, 40);
+  const size_t k = 3;
+
+  std::vector<SpillSearchConfig> profiles;
+  SpillSearchConfig config = TuneDefeatistSpill(dataset, querySample, k, 0.8,
+      std::vector<double>(), std::vector<double>(), &profiles);
+
+  REQUIRE(profiles.size() >= 6);
+  for (size_t i = 0; i < profiles.size(); ++i)
+  {
+    REQUIRE(profiles[i].recall >= 0.0);
+    REQUIRE(profiles[i].recall <= 1.0);
+    REQUIRE(profiles[i].baseCases > 0);
+  }
+
+  // A tau far larger than any neighbor distance must give perfect recall.
+  std::vector<double> bigTau(1, 10.0);
+  SpillSearchConfig perfect = TuneDefeatistSpill(dataset, querySample, k,
+      1.0, bigTau);
+  REQUIRE(perfect.recall == Approx(1.0));
+
+  // The chosen configuration is either on target or the best achievable.
+  double maxRecall = 0.0;
+  for (size_t i = 0; i < profiles.size(); ++i)
+    maxRecall = std::max(maxRecall, profiles[i].recall);
+  REQUIRE(config.recall >= std::min(0.8, maxRecall));
+}
+
+/**
+ * Test the opt-in traversal instrumentation: counters must be populated and
+ * self-consistent, and the instrumented search must give the same results as
+ * the uninstrumented one.
+ */
+TEST_CASE("KNNTraversalStatisticsTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+  arma::mat querySet = arma::randu<arma::mat>(5, 50);
+  const size_t k = 3;
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  std::vector<size_t> oldFromNewRefs, oldFromNewQueries;
+  TreeType referenceTree(dataset, oldFromNewRefs);
+  TreeType queryTree(querySet, oldFromNewQueries);
+
+  metric::EuclideanDistance metric;
+  arma::Mat<size_t> neighbors(k, querySet.n_cols);
+  arma::mat distances(k, querySet.n_cols);
+
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType,
+      TraversalStatistics> RuleType;
+  RuleType rules(referenceTree.Dataset(), queryTree.Dataset(), k, metric,
+      0.0, false);
+
+  TreeType::DualTreeTraverser<RuleType> traverser(rules);
+  traverser.Traverse(queryTree, referenceTree);
+  rules.GetResults(neighbors, distances);
+
+  const TraversalStatistics& stats = rules.TraversalStats();
+
+  // The legacy counters and the instrumentation must agree.
+  REQUIRE(stats.NumBaseCases() == rules.BaseCases());
+  REQUIRE(stats.NumScores() == rules.Scores());
+
+  // Each query point needs at least k insertions into its candidate list.
+  REQUIRE(stats.NumBoundTightenings() >= k * querySet.n_cols);
+  REQUIRE(stats.NumBoundTightenings() <= stats.NumBaseCases());
+
+  // Pruning must have happened somewhere, and no more prunes than scores.
+  REQUIRE(stats.NumScorePrunes() + stats.NumRescorePrunes() > 0);
+  REQUIRE(stats.NumScorePrunes() <= stats.NumScores());
+
+  // The instrumented search must match the plain one.
+  KNN knn(dataset);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  knn.Search(querySet, k, exactNeighbors, exactDistances);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    const size_t unmappedQ = oldFromNewQueries[q];
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(oldFromNewRefs[neighbors(j, q)] ==
+          exactNeighbors(j, unmappedQ));
+      REQUIRE(distances(j, q) ==
+          Approx(exactDistances(j, unmappedQ)).epsilon(1e-10));
+    }
+  }
+
+  // Reset must zero everything.
+  rules.TraversalStats().Reset();
+  REQUIRE(rules.TraversalStats().NumScores() == 0);
+  REQUIRE(rules.TraversalStats().NumBaseCases() == 0);
+}
+
+/**
+ * Test the HNSW graph index: with a generous beam width the approximate
+ * results should almost always agree with exact search, and incremental
+ * insertion must leave the index searchable.
+ */
+TEST_CASE("HNSWIndexRecallTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 600);
+  arma::mat querySet = arma::randu<arma::mat>(8, 50);
+  const size_t k = 5;
+
+  HNSWIndex<> index(16, 200, 200);
+  index.Train(dataset);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  index.Search(querySet, k, neighbors, distances);
+
+  KNN exact(dataset);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  exact.Search(querySet, k, exactNeighbors, exactDistances);
+
+  size_t found = 0;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      // Distances must be correct and sorted even when a neighbor differs.
+      REQUIRE(distances(j, i) == Approx(metric::EuclideanDistance::Evaluate(
+          querySet.col(i), dataset.col(neighbors(j, i)))).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+
+      for (size_t l = 0; l < k; ++l)
+      {
+        if (neighbors(j, i) == exactNeighbors(l, i))
+        {
+          ++found;
+          break;
+        }
+      }
+    }
+  }
+
+  // With ef = 200 on 600 points the recall should be very high.
+  const double recall = (double) found / (double) (k * querySet.n_cols);
+  REQUIRE(recall >= 0.9);
+
+  // Incremental insertion: a newly added point must be findable.
+  arma::vec newPoint = arma::randu<arma::vec>(8);
+  const size_t newIndex = index.Insert(newPoint);
+  REQUIRE(newIndex == dataset.n_cols);
+
+  arma::Mat<size_t> oneNeighbor;
+  arma::mat oneDistance;
+  index.Search(arma::mat(newPoint), 1, oneNeighbor, oneDistance);
+  REQUIRE(oneNeighbor(0, 0) == newIndex);
+  REQUIRE(oneDistance(0, 0) == Approx(0.0).margin(1e-10));
+}
+
+/**
+ * Test that the HNSW index is selectable through NSModel.
+ */
+TEST_CASE("NSModelHNSWTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(6, 400);
+  arma::mat querySet = arma::randu<arma::mat>(6, 20);
+  const size_t k = 3;
+
+  util::Timers timers;
+  NSModel<NearestNeighborSort> model(NSModel<NearestNeighborSort>::HNSW,
+      false);
+  model.BuildModel(timers, arma::mat(dataset), GREEDY_SINGLE_TREE_MODE, 0.0);
+  REQUIRE(model.TreeName() == "HNSW graph");
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model.Search(timers, arma::mat(querySet), k, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == querySet.n_cols);
+
+  // All results must be valid indices with correct distances.
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(neighbors(j, i) < dataset.n_cols);
+      REQUIRE(distances(j, i) == Approx(metric::EuclideanDistance::Evaluate(
+          querySet.col(i), dataset.col(neighbors(j, i)))).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Test that the blocked brute-force engine agrees exactly with NeighborSearch
+ * in naive mode, for both bichromatic and monochromatic search, including
+ * dataset sizes that do not divide the block sizes evenly.
+ */
+TEST_CASE("BruteForceKNNTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 1537);
+  arma::mat querySet = arma::randu<arma::mat>(5, 311);
+  const size_t k = 7;
+
+  arma::Mat<size_t> neighbors, exactNeighbors;
+  arma::mat distances, exactDistances;
+
+  BruteForceKNN<>::Search(dataset, querySet, k, neighbors, distances);
+
+  KNN naive(dataset, NAIVE_MODE);
+  naive.Search(querySet, k, exactNeighbors, exactDistances);
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(neighbors(j, i) == exactNeighbors(j, i));
+      REQUIRE(distances(j, i) == Approx(exactDistances(j, i)).epsilon(1e-7));
+    }
+  }
+
+  // Monochromatic search: no point may be its own neighbor.
+  BruteForceKNN<>::Search(dataset, k, neighbors, distances);
+  naive.Search(k, exactNeighbors, exactDistances);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(neighbors(j, i) != i);
+      REQUIRE(distances(j, i) == Approx(exactDistances(j, i)).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Test that the blocked brute-force engine is selectable through NSModel.
+ */
+TEST_CASE("NSModelBruteForceTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 500);
+  arma::mat querySet = arma::randu<arma::mat>(4, 40);
+  const size_t k = 3;
+
+  util::Timers timers;
+  NSModel<NearestNeighborSort> model(
+      NSModel<NearestNeighborSort>::BRUTE_FORCE, false);
+  model.BuildModel(timers, arma::mat(dataset), NAIVE_MODE, 0.0);
+  REQUIRE(model.TreeName() == "blocked brute-force");
+
+  arma::Mat<size_t> neighbors, exactNeighbors;
+  arma::mat distances, exactDistances;
+  model.Search(timers, arma::mat(querySet), k, neighbors, distances);
+
+  KNN naive(dataset, NAIVE_MODE);
+  naive.Search(querySet, k, exactNeighbors, exactDistances);
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(neighbors(j, i) == exactNeighbors(j, i));
+      REQUIRE(distances(j, i) == Approx(exactDistances(j, i)).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Test incremental updates of NSModel: added points must show up in search
+ * results immediately, removed points must disappear, and flushing the buffer
+ * into the tree must not change either the results or the point indices.
+ */
+TEST_CASE("NSModelIncrementalUpdateTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 300);
+  arma::mat querySet = arma::randu<arma::mat>(5, 60);
+  arma::mat addedSet = arma::randu<arma::mat>(5, 25);
+  const size_t k = 5;
+
+  util::Timers timers;
+  NSModel<NearestNeighborSort> model(
+      NSModel<NearestNeighborSort>::TreeTypes::KD_TREE, false);
+  model.FlushRatio() = 1.0; // Keep the pool buffered for this test.
+  arma::mat referenceCopy(referenceSet);
+  model.BuildModel(timers, std::move(referenceCopy), DUAL_TREE_MODE);
+
+  // Add new points; they must get consecutive indices.
+  for (size_t i = 0; i < addedSet.n_cols; ++i)
+  {
+    const size_t index = model.AddPoint(timers, addedSet.col(i));
+    REQUIRE(index == referenceSet.n_cols + i);
+  }
+  REQUIRE(model.NumBufferedPoints() == addedSet.n_cols);
+
+  // Remove some indexed points and one buffered point.
+  model.RemovePoint(3);
+  model.RemovePoint(17);
+  model.RemovePoint(referenceSet.n_cols + 2);
+
+  // Compute the expected results by brute force over the live points.  Note
+  // that KD-tree building does not change result indices (the model unmaps
+  // them), so indices refer to the original column order.
+  arma::mat fullSet(referenceSet);
+  fullSet.insert_cols(fullSet.n_cols, addedSet);
+  arma::Mat<size_t> expectedNeighbors(k, querySet.n_cols);
+  arma::mat expectedDistances(k, querySet.n_cols);
+  expectedDistances.fill(DBL_MAX);
+  expectedNeighbors.fill(SIZE_MAX);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < fullSet.n_cols; ++j)
+    {
+      if (j == 3 || j == 17 || j == referenceSet.n_cols + 2)
+        continue;
+
+      const double dist = metric::EuclideanDistance::Evaluate(
+          querySet.col(i), fullSet.col(j));
+      if (dist >= expectedDistances(k - 1, i))
+        continue;
+
+      size_t pos = k - 1;
+      while (pos > 0 && dist < expectedDistances(pos - 1, i))
+      {
+        expectedDistances(pos, i) = expectedDistances(pos - 1, i);
+        expectedNeighbors(pos, i) = expectedNeighbors(pos - 1, i);
+        --pos;
+      }
+      expectedDistances(pos, i) = dist;
+      expectedNeighbors(pos, i) = j;
+    }
+  }
+
+  // Search with the buffered pool.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(querySet);
+  model.Search(timers, std::move(queryCopy), k, neighbors, distances);
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(neighbors(j, i) == expectedNeighbors(j, i));
+      REQUIRE(distances(j, i) == Approx(expectedDistances(j, i)).epsilon(1e-7));
+    }
+  }
+
+  // Flush the pool into the tree; indices and results must not change.
+  model.FlushUpdates(timers);
+  REQUIRE(model.NumBufferedPoints() == 0);
+  REQUIRE(model.Dataset().n_cols == fullSet.n_cols);
+
+  queryCopy = querySet;
+  model.Search(timers, std::move(queryCopy), k, neighbors, distances);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(neighbors(j, i) == expectedNeighbors(j, i));
+      REQUIRE(distances(j, i) == Approx(expectedDistances(j, i)).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Neighbor search on float32 data must return the same neighbors as the
+ * double-precision search, with float32 distances.
+ */
+TEST_CASE("KNNFMatTest", "[KNNTest]")
+{
+  arma::mat data(5, 500, arma::fill::randu);
+  arma::fmat floatData = arma::conv_to<arma::fmat>::from(data);
+
+  KNN exact(data);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  exact.Search(5, neighbors, distances);
+
+  NeighborSearch<NearestNeighborSort, metric::EuclideanDistance, arma::fmat>
+      floatSearch(floatData);
+  arma::Mat<size_t> floatNeighbors;
+  arma::fmat floatDistances;
+  floatSearch.Search(5, floatNeighbors, floatDistances);
+
+  REQUIRE(floatNeighbors.n_cols == neighbors.n_cols);
+  size_t sameNeighbors = 0;
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    if (neighbors[i] == floatNeighbors[i])
+      ++sameNeighbors;
+    REQUIRE((double) floatDistances[i] ==
+        Approx(distances[i]).epsilon(1e-4).margin(1e-5));
+  }
+  // Ties may resolve differently in single precision, but nearly all
+  // neighbors must agree.
+  REQUIRE(sameNeighbors > 0.99 * neighbors.n_elem);
+}
+
+
+/**
+ * The sharded engine must return exactly the same neighbors and distances as
+ * a single NeighborSearch over the full reference set, with indices mapped
+ * back to the full set.
+ */
+TEST_CASE("KNNShardedSearchTest", "[KNNTest]")
+{
+  arma::mat referenceData(5, 1000, arma::fill::randu);
+  arma::mat queryData(5, 150, arma::fill::randu);
+
+  KNN exact(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  exact.Search(queryData, 7, neighbors, distances);
+
+  ShardedNeighborSearch<> sharded(referenceData, 10);
+  arma::Mat<size_t> shardedNeighbors;
+  arma::mat shardedDistances;
+  sharded.Search(queryData, 7, shardedNeighbors, shardedDistances);
+
+  REQUIRE(sharded.NumShards() == 10);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(shardedNeighbors[i] == neighbors[i]);
+    REQUIRE(shardedDistances[i] == Approx(distances[i]).epsilon(1e-10));
+  }
+}
+
+/**
+ * Sharded search must still be correct when k exceeds the size of individual
+ * shards, and in naive mode (where no shard pruning is possible).
+ */
+TEST_CASE("KNNShardedSmallShardTest", "[KNNTest]")
+{
+  arma::mat referenceData(3, 50, arma::fill::randu);
+
+  KNN exact(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  exact.Search(referenceData, 20, neighbors, distances);
+
+  // 10 shards of 5 points each; each shard holds fewer points than k.
+  ShardedNeighborSearch<> sharded(referenceData, 10);
+  arma::Mat<size_t> shardedNeighbors;
+  arma::mat shardedDistances;
+  sharded.Search(referenceData, 20, shardedNeighbors, shardedDistances);
+
+  ShardedNeighborSearch<> shardedNaive(referenceData, 10, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  shardedNaive.Search(referenceData, 20, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(shardedNeighbors[i] == neighbors[i]);
+    REQUIRE(shardedDistances[i] == Approx(distances[i]).epsilon(1e-10));
+    REQUIRE(naiveNeighbors[i] == neighbors[i]);
+    REQUIRE(naiveDistances[i] == Approx(distances[i]).epsilon(1e-10));
+  }
+}
+
+/**
+ * In high dimensions the base cases dominate and the cascaded (early
+ * abandoning) distance evaluation kicks in; the results must still be exactly
+ * the ones brute-force distance computation gives.
+ */
+TEST_CASE("KNNHighDimensionalCascadeTest", "[KNNTest]")
+{
+  arma::mat dataset(800, 300, arma::fill::randu);
+
+  KNN knn(dataset);
+
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree;
+  arma::mat distancesTree;
+  knn.Search(5, neighborsTree, distancesTree);
+
+  arma::Mat<size_t> neighborsNaive;
+  arma::mat distancesNaive;
+  naive.Search(5, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+
+  // Check the reported distances against directly computed ones.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      const double trueDist = metric::EuclideanDistance::Evaluate(
+          dataset.col(i), dataset.col(neighborsTree(j, i)));
+      REQUIRE(distancesTree(j, i) == Approx(trueDist).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * The inverted-index engine must return exactly the same neighbors as dense
+ * brute-force search, both bichromatically and monochromatically.  The
+ * reference set deliberately contains empty columns and a query with no
+ * shared nonzero dimensions so that the norm-ordered completion path is
+ * exercised.
+ */
+TEST_CASE("InvertedIndexKNNTest", "[KNNTest]")
+{
+  arma::sp_mat referenceDataset;
+  referenceDataset.sprandu(90, 500, 0.05);
+  referenceDataset.col(17).zeros(); // An empty reference point.
+  arma::sp_mat queryDataset;
+  queryDataset.sprandu(90, 150, 0.1);
+  queryDataset.col(3).zeros(); // A query with no nonzeros at all.
+
+  arma::mat denseReference(referenceDataset);
+  arma::mat denseQuery(queryDataset);
+
+  InvertedIndexKNN index(referenceDataset);
+  KNN naive(denseReference, NAIVE_MODE);
+
+  // Bichromatic search.
+  arma::Mat<size_t> neighbors, naiveNeighbors;
+  arma::mat distances, naiveDistances;
+  index.Search(queryDataset, 10, neighbors, distances);
+  naive.Search(denseQuery, 10, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < naiveNeighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < naiveNeighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, i) == naiveNeighbors(j, i));
+      REQUIRE(distances(j, i) ==
+          Approx(naiveDistances(j, i)).epsilon(1e-7).margin(1e-10));
+    }
+  }
+
+  // Monochromatic search.
+  index.Search(10, neighbors, distances);
+  naive.Search(10, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < naiveNeighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < naiveNeighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, i) == naiveNeighbors(j, i));
+      REQUIRE(distances(j, i) ==
+          Approx(naiveDistances(j, i)).epsilon(1e-7).margin(1e-10));
+    }
+  }
+}
+
+/**
+ * With an unlimited budget, the budgeted best-first traverser is an exact
+ * pruning traversal, so its results must match naive search.
+ */
+TEST_CASE("KNNBudgetedTraverserExactTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+  arma::mat querySet = arma::randu<arma::mat>(5, 50);
+  const size_t k = 3;
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  std::vector<size_t> oldFromNewRefs;
+  TreeType referenceTree(dataset, oldFromNewRefs);
+
+  metric::EuclideanDistance metric;
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      RuleType;
+  RuleType rules(referenceTree.Dataset(), querySet, k, metric);
+
+  tree::BudgetedSingleTreeTraverser<TreeType, RuleType> traverser(rules);
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    traverser.Traverse(q, referenceTree);
+    // No budget limit was given, so the frontier must be exhausted.
+    REQUIRE(traverser.Exhausted());
+  }
+
+  arma::Mat<size_t> neighbors(k, querySet.n_cols);
+  arma::mat distances(k, querySet.n_cols);
+  rules.GetResults(neighbors, distances);
+
+  // Compare against naive search.
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(querySet, k, naiveNeighbors, naiveDistances);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(oldFromNewRefs[neighbors(j, q)] == naiveNeighbors(j, q));
+      REQUIRE(distances(j, q) ==
+          Approx(naiveDistances(j, q)).epsilon(1e-10));
+    }
+  }
+}
+
+/**
+ * Resuming a query with more budget must reuse the previous frontier: a
+ * traversal that is started with a tiny budget and then resumed to exhaustion
+ * must give exactly the same results as a single unlimited traversal.
+ */
+TEST_CASE("KNNBudgetedTraverserResumeTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+  arma::mat querySet = arma::randu<arma::mat>(5, 50);
+  const size_t k = 3;
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  std::vector<size_t> oldFromNewRefs;
+  TreeType referenceTree(dataset, oldFromNewRefs);
+
+  metric::EuclideanDistance metric;
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      RuleType;
+  RuleType rules(referenceTree.Dataset(), querySet, k, metric);
+
+  tree::BudgetedSingleTreeTraverser<TreeType, RuleType> traverser(rules);
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    // Start with a single node visit, then resume in small increments until
+    // the frontier is exhausted.
+    traverser.Traverse(q, referenceTree, 1);
+    while (!traverser.Exhausted())
+      traverser.Resume(5);
+  }
+
+  arma::Mat<size_t> neighbors(k, querySet.n_cols);
+  arma::mat distances(k, querySet.n_cols);
+  rules.GetResults(neighbors, distances);
+
+  // An unlimited traversal must give the same results.
+  RuleType exactRules(referenceTree.Dataset(), querySet, k, metric);
+  tree::BudgetedSingleTreeTraverser<TreeType, RuleType>
+      exactTraverser(exactRules);
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+    exactTraverser.Traverse(q, referenceTree);
+
+  arma::Mat<size_t> exactNeighbors(k, querySet.n_cols);
+  arma::mat exactDistances(k, querySet.n_cols);
+  exactRules.GetResults(exactNeighbors, exactDistances);
+
+  CheckMatrices(neighbors, exactNeighbors);
+  CheckMatrices(distances, exactDistances);
+}
+
+/**
+ * The node-visit budget must be respected, and spending more budget must not
+ * make the candidate neighbors worse.
+ */
+TEST_CASE("KNNBudgetedTraverserBudgetTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+  arma::mat querySet = arma::randu<arma::mat>(5, 10);
+  const size_t k = 3;
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  std::vector<size_t> oldFromNewRefs;
+  TreeType referenceTree(dataset, oldFromNewRefs);
+
+  metric::EuclideanDistance metric;
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      RuleType;
+  RuleType rules(referenceTree.Dataset(), querySet, k, metric);
+
+  tree::BudgetedSingleTreeTraverser<TreeType, RuleType> traverser(rules);
+
+  // A budget of 4 node visits on a fresh traverser.
+  traverser.Traverse(0, referenceTree, 4);
+  REQUIRE(traverser.NumVisited() <= 4);
+
+  // Resuming may only increase the visit count.
+  const size_t visitedBefore = traverser.NumVisited();
+  traverser.Resume(std::numeric_limits<size_t>::max());
+  REQUIRE(traverser.Exhausted());
+  REQUIRE(traverser.NumVisited() >= visitedBefore);
+
+  // Run the same partial traversal on a second rule set; since the candidate
+  // lists are only ever tightened, spending more budget may only improve the
+  // best candidate distance.
+  RuleType partialRules(referenceTree.Dataset(), querySet, k, metric);
+  tree::BudgetedSingleTreeTraverser<TreeType, RuleType>
+      partialTraverser(partialRules);
+  partialTraverser.Traverse(0, referenceTree, 4);
+
+  arma::Mat<size_t> neighbors(k, querySet.n_cols);
+  arma::mat distances(k, querySet.n_cols);
+  arma::Mat<size_t> partialNeighbors(k, querySet.n_cols);
+  arma::mat partialDistances(k, querySet.n_cols);
+  rules.GetResults(neighbors, distances);
+  partialRules.GetResults(partialNeighbors, partialDistances);
+
+  REQUIRE(distances(0, 0) <= partialDistances(0, 0));
+}
+
+/**
+ * Test that the large-k heap-based candidate sets give the same results as
+ * the naive search.  k above the KSelectionSet flat threshold exercises the
+ * binary heap fallback; a small k exercises the flat sorted arrays.
+ */
+TEST_CASE("KNNKSelectionFallbackTest", "[KNNTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 200);
+
+  for (size_t k : { (size_t) 8, (size_t) 40 })
+  {
+    KNN knn(dataset);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    knn.Search(k, neighbors, distances);
+
+    KNN naive(dataset, NAIVE_MODE);
+    arma::Mat<size_t> naiveNeighbors;
+    arma::mat naiveDistances;
+    naive.Search(k, naiveNeighbors, naiveDistances);
+
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(neighbors[i] == naiveNeighbors[i]);
+      REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Test that automatic leaf size tuning selects one of the candidate sizes for
+ * leaf-size trees, keeps the model usable, and is a no-op for tree types that
+ * do not take a leaf size.
+ */
+TEST_CASE("KNNModelAutoTuneLeafSizeTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  util::Timers timers;
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+
+  KNNModel model(KNNModel::TreeTypes::KD_TREE, false);
+  const size_t selected = model.AutoTuneLeafSize(timers, referenceData,
+      DUAL_TREE_MODE);
+
+  // The selected leaf size is one of the candidates and is kept in the model.
+  REQUIRE(model.LeafSize() == selected);
+  REQUIRE((selected == 8 || selected == 16 || selected == 32 ||
+           selected == 64 || selected == 128));
+
+  // The model builds and searches normally afterwards.
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(timers, std::move(referenceCopy), DUAL_TREE_MODE);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model.Search(timers, 3, neighbors, distances);
+  REQUIRE(neighbors.n_cols == referenceData.n_cols);
+
+  // Cover trees take no leaf size, so tuning must not change anything.
+  KNNModel coverModel(KNNModel::TreeTypes::COVER_TREE, false);
+  const size_t oldLeafSize = coverModel.LeafSize();
+  REQUIRE(coverModel.AutoTuneLeafSize(timers, referenceData, DUAL_TREE_MODE) ==
+      oldLeafSize);
+
+  // Naive search does not depend on the leaf size either.
+  KNNModel naiveModel(KNNModel::TreeTypes::KD_TREE, false);
+  const size_t naiveLeafSize = naiveModel.LeafSize();
+  REQUIRE(naiveModel.AutoTuneLeafSize(timers, referenceData, NAIVE_MODE) ==
+      naiveLeafSize);
+}
+
+/**
+ * A flat-loaded kd-tree must be directly usable for neighbor search, with
+ * its statistics rebuilt on load.
+ */
+TEST_CASE("KNNFlatTreeSearchTest", "[KNNTest]")
+{
+  typedef KNN::Tree TreeType;
+
+  arma::mat dataset(5, 300, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew);
+
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  tree.SaveFlat(stream);
+  TreeType* loaded = TreeType::LoadFlat(stream);
+
+  KNN original(std::move(tree));
+  KNN fromFlat(std::move(*loaded));
+  delete loaded;
+
+  arma::Mat<size_t> neighbors, flatNeighbors;
+  arma::mat distances, flatDistances;
+  original.Search(3, neighbors, distances);
+  fromFlat.Search(3, flatNeighbors, flatDistances);
+
+  CheckMatrices(distances, flatDistances);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+    REQUIRE(neighbors[i] == flatNeighbors[i]);
+}
@@ -737,3 +737,101 @@ TEST_CASE("RAModelTest", "[KRANNTest]")
     }
   }
 }
+
+// Test the correctness and guarantees of batched rank-approximate search,
+// which shares sampled candidates between co-located query points.
+TEST_CASE("BatchedGuaranteeTest", "[KRANNTest]")
+{
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  arma::mat refData;
+  arma::mat queryData;
+
+  if (!data::Load("rann_test_r_3_900.csv", refData))
+    FAIL("Cannot load dataset rann_test_r_3_900.csv");
+  if (!data::Load("rann_test_q_3_100.csv", queryData))
+    FAIL("Cannot load dataset rann_test_q_3_100.csv");
+
+  RASearch<> rsRann(refData, true, false, 1.0);
+
+  arma::mat qrRanks;
+  if (!data::Load("rann_test_qr_ranks.csv", qrRanks, false, false))
+    FAIL("Cannot load dataset rann_test_qr_ranks.csv");
+
+  size_t numRounds = 1000;
+  arma::Col<size_t> numSuccessRounds(queryData.n_cols);
+  numSuccessRounds.fill(0);
+
+  // 1% of 900 is 9, so the rank is expected to be less than 10.
+  size_t expectedRankErrorUB = 10;
+
+  for (size_t rounds = 0; rounds < numRounds; rounds++)
+  {
+    rsRann.SearchBatched(queryData, 1, neighbors, distances);
+
+    for (size_t i = 0; i < queryData.n_cols; ++i)
+      if (qrRanks(i, neighbors(0, i)) < expectedRankErrorUB)
+        numSuccessRounds[i]++;
+
+    neighbors.reset();
+    distances.reset();
+  }
+
+  // Find the 95%-tile threshold so that 95% of the queries should pass this
+  // threshold.
+  size_t threshold = floor(numRounds *
+      (0.95 - (1.96 * sqrt(0.95 * 0.05 / numRounds))));
+  size_t numQueriesFail = 0;
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+    if (numSuccessRounds[i] < threshold)
+      numQueriesFail++;
+
+  Log::Warn << "RANN-BS: RANN guarantee fails on " << numQueriesFail
+      << " queries." << endl;
+
+  // assert that at most 5% of the queries fall out of this threshold
+  // 5% of 100 queries is 5.
+  size_t maxNumQueriesFail = 6;
+
+  REQUIRE(numQueriesFail < maxNumQueriesFail);
+}
+
+// When a batched search is run against a tree-mode RASearch object, the
+// reference indices must be mapped back through the tree permutation, exactly
+// as dual-tree search does.
+TEST_CASE("BatchedSearchMappingTest", "[KRANNTest]")
+{
+  arma::mat refData;
+  arma::mat queryData;
+
+  if (!data::Load("rann_test_r_3_900.csv", refData))
+    FAIL("Cannot load dataset rann_test_r_3_900.csv");
+  if (!data::Load("rann_test_q_3_100.csv", queryData))
+    FAIL("Cannot load dataset rann_test_q_3_100.csv");
+
+  // Tree-mode object: reference points are rearranged during tree building,
+  // so returned indices must refer to the original reference matrix.
+  RASearch<> rann(refData, false, false, 5.0);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  rann.SearchBatched(queryData, 2, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 2);
+  REQUIRE(neighbors.n_cols == queryData.n_cols);
+
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, i) < refData.n_cols);
+
+      // The returned distance must match the distance to the point the mapped
+      // index refers to in the original reference matrix.
+      const double dist = metric::EuclideanDistance::Evaluate(
+          queryData.col(i), refData.col(neighbors(j, i)));
+      REQUIRE(distances(j, i) == Approx(dist).epsilon(1e-10));
+    }
+  }
+}
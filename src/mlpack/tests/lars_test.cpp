@@ -469,3 +469,91 @@ TEST_CASE("LARSCopyConstructorTest", "[LARSTest]")
   // The output of both models should be the same.
   CheckMatrices(predictions, predictionsFromCopiedModel);
 }
+
+/**
+ * Make sure that strong rule screening gives the same solution path as the
+ * unscreened algorithm.
+ */
+TEST_CASE("ScreeningMatchesFullPathTest", "[LARSTest]")
+{
+  for (size_t useCholesky = 0; useCholesky < 2; ++useCholesky)
+  {
+    arma::mat X;
+    arma::rowvec y;
+    GenerateProblem(X, y, 100, 50);
+
+    arma::vec sortedAbsCorr = sort(abs(X * y.t()));
+    const double lambda1 = sortedAbsCorr(25);
+
+    LARS plain((bool) useCholesky, lambda1, 0.0);
+    arma::vec betaRef;
+    plain.Train(X, y, betaRef);
+
+    LARS screened((bool) useCholesky, lambda1, 0.0);
+    screened.Screening() = true;
+    arma::vec beta;
+    screened.Train(X, y, beta);
+
+    for (size_t j = 0; j < beta.n_elem; ++j)
+      REQUIRE(beta(j) == Approx(betaRef(j)).margin(1e-8));
+  }
+}
+
+/**
+ * The on-demand Gram column cache must give the same solution as the
+ * precomputed Gram matrix, for both solvers and with a budget small enough to
+ * force evictions.
+ */
+TEST_CASE("GramCacheMatchesFullGramTest", "[LARSTest]")
+{
+  for (size_t useCholesky = 0; useCholesky < 2; ++useCholesky)
+  {
+    arma::mat X;
+    arma::rowvec y;
+    GenerateProblem(X, y, 100, 50);
+
+    arma::vec sortedAbsCorr = sort(abs(X * y.t()));
+    const double lambda1 = sortedAbsCorr(25);
+    const double lambda2 = lambda1 / 2;
+
+    LARS plain((bool) useCholesky, lambda1, lambda2);
+    arma::vec betaRef;
+    plain.Train(X, y, betaRef);
+
+    LARS cached((bool) useCholesky, lambda1, lambda2);
+    // Room for eight Gram columns only.
+    cached.GramCacheBudget() = 8 * 50 * sizeof(double);
+    arma::vec beta;
+    cached.Train(X, y, beta);
+
+    for (size_t j = 0; j < beta.n_elem; ++j)
+      REQUIRE(beta(j) == Approx(betaRef(j)).margin(1e-8));
+  }
+}
+
+/**
+ * Screening and the Gram column cache compose; this is the intended
+ * configuration for very wide data.
+ */
+TEST_CASE("ScreeningWithGramCacheTest", "[LARSTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, 50, 500);
+
+  arma::vec sortedAbsCorr = sort(abs(X * y.t()));
+  const double lambda1 = sortedAbsCorr(450);
+
+  LARS plain(true, lambda1, 0.0);
+  arma::vec betaRef;
+  plain.Train(X, y, betaRef);
+
+  LARS wide(true, lambda1, 0.0);
+  wide.Screening() = true;
+  wide.GramCacheBudget() = 16 * 500 * sizeof(double);
+  arma::vec beta;
+  wide.Train(X, y, beta);
+
+  for (size_t j = 0; j < beta.n_elem; ++j)
+    REQUIRE(beta(j) == Approx(betaRef(j)).margin(1e-8));
+}
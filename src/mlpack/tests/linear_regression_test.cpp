@@ -266,3 +266,48 @@ TEST_CASE("LinearRegressionTrainReturnObjective", "[LinearRegressionTest]")
 
   REQUIRE(std::isfinite(error) == true);
 }
+
+/**
+ * Streaming the data through AddChunk() and solving must give the same
+ * parameters as a single Train() call, with and without weights.
+ */
+TEST_CASE("LinearRegressionChunkedTrainTest", "[LinearRegressionTest]")
+{
+  arma::mat predictors = arma::randn(10, 1000);
+  arma::rowvec responses = arma::randn(1, 1000);
+  arma::rowvec weights = arma::randu(1, 1000) + 0.1;
+
+  for (size_t weighted = 0; weighted < 2; ++weighted)
+  {
+    for (size_t intercept = 0; intercept < 2; ++intercept)
+    {
+      const arma::rowvec& w = weighted ? weights : arma::rowvec();
+
+      LinearRegression full;
+      full.Lambda() = 0.5;
+      full.Train(predictors, responses, w, (bool) intercept);
+
+      // Stream the same data through in three uneven chunks.
+      LinearRegression chunked;
+      chunked.Lambda() = 0.5;
+      const size_t splits[4] = { 0, 300, 801, 1000 };
+      for (size_t chunk = 0; chunk < 3; ++chunk)
+      {
+        const size_t begin = splits[chunk], end = splits[chunk + 1] - 1;
+        chunked.AddChunk(predictors.cols(begin, end),
+            responses.subvec(begin, end),
+            weighted ? arma::rowvec(weights.subvec(begin, end)) :
+                arma::rowvec(),
+            (bool) intercept);
+      }
+      chunked.SolveNormalEquations();
+
+      REQUIRE(full.Parameters().n_elem == chunked.Parameters().n_elem);
+      for (size_t i = 0; i < full.Parameters().n_elem; ++i)
+      {
+        REQUIRE(full.Parameters()[i] ==
+            Approx(chunked.Parameters()[i]).margin(1e-8));
+      }
+    }
+  }
+}
@@ -892,6 +892,107 @@ TEST_CASE("LinearSVMSparseLBFGSTest", "[LinearSVMTest]")
   }
 }
 
+/**
+ * Test that the sparse-data specializations of the batch Gradient() and
+ * EvaluateWithGradient() give the same results as the generic dense
+ * implementation, and that a sparse gradient stays sparse.
+ */
+TEST_CASE("LinearSVMSparseGradientTest", "[LinearSVMTest]")
+{
+  // Create a random dataset.
+  arma::sp_mat dataset;
+  dataset.sprandu(50, 300, 0.1);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = math::RandInt(0, 3);
+
+  LinearSVMFunction<arma::mat> svmf(denseDataset, labels, 3, 0.5, 1.0);
+  LinearSVMFunction<arma::sp_mat> svmfSparse(dataset, labels, 3, 0.5, 1.0);
+
+  arma::mat parameters;
+  parameters.randu(50, 3);
+
+  // Check a batch gradient.
+  arma::mat gradient, sparseGradient;
+  svmf.Gradient(parameters, 30, gradient, 20);
+  svmfSparse.Gradient(parameters, 30, sparseGradient, 20);
+
+  REQUIRE(gradient.n_elem == sparseGradient.n_elem);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx(sparseGradient[i]).margin(1e-10));
+
+  // Check a batch gradient along with the objective.
+  const double objective = svmf.EvaluateWithGradient(parameters, 30, gradient,
+      20);
+  const double sparseObjective = svmfSparse.EvaluateWithGradient(parameters,
+      30, sparseGradient, 20);
+
+  REQUIRE(objective == Approx(sparseObjective).epsilon(1e-10));
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx(sparseGradient[i]).margin(1e-10));
+
+  // With no regularization, a gradient computed into a sparse matrix is
+  // exact, and its nonzero entries are restricted to the features active in
+  // the batch.
+  LinearSVMFunction<arma::mat> svmfNoReg(denseDataset, labels, 3, 0.0, 1.0);
+  LinearSVMFunction<arma::sp_mat> svmfSparseNoReg(dataset, labels, 3, 0.0,
+      1.0);
+
+  arma::sp_mat spGradient;
+  svmfNoReg.Gradient(parameters, 30, gradient, 20);
+  svmfSparseNoReg.Gradient(parameters, 30, spGradient, 20);
+
+  REQUIRE(gradient.n_elem == spGradient.n_elem);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx((double) spGradient[i]).margin(1e-10));
+
+  const arma::sp_mat batch = dataset.cols(30, 49);
+  REQUIRE(spGradient.n_nonzero <= 3 * batch.n_nonzero);
+}
+
+/**
+ * The sparse-data batch gradient must also match the generic implementation
+ * when an intercept is fit, since the intercept row is accumulated separately
+ * from the feature rows.
+ */
+TEST_CASE("LinearSVMSparseGradientInterceptTest", "[LinearSVMTest]")
+{
+  // Create a random dataset.
+  arma::sp_mat dataset;
+  dataset.sprandu(50, 300, 0.1);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = math::RandInt(0, 3);
+
+  LinearSVMFunction<arma::mat> svmf(denseDataset, labels, 3, 0.5, 1.0, true);
+  LinearSVMFunction<arma::sp_mat> svmfSparse(dataset, labels, 3, 0.5, 1.0,
+      true);
+
+  arma::mat parameters;
+  parameters.randu(51, 3);
+
+  // Check a batch gradient.
+  arma::mat gradient, sparseGradient;
+  svmf.Gradient(parameters, 30, gradient, 20);
+  svmfSparse.Gradient(parameters, 30, sparseGradient, 20);
+
+  REQUIRE(gradient.n_elem == sparseGradient.n_elem);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx(sparseGradient[i]).margin(1e-10));
+
+  // Check a batch gradient along with the objective.
+  const double objective = svmf.EvaluateWithGradient(parameters, 30, gradient,
+      20);
+  const double sparseObjective = svmfSparse.EvaluateWithGradient(parameters,
+      30, sparseGradient, 20);
+
+  REQUIRE(objective == Approx(sparseObjective).epsilon(1e-10));
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx(sparseGradient[i]).margin(1e-10));
+}
+
 /**
  * Test training of linear svm for multiple classes on a complex gaussian
  * dataset using L-BFGS optimizer.
@@ -1196,3 +1297,56 @@ TEST_CASE("LinearSVMCallbackTest", "[LinearSVMTest]")
 
   REQUIRE(cb.calledEndOptimization == true);
 }
+
+/**
+ * Test that batch classification of more points than fit in one column block
+ * gives the same results as classifying each point on its own.
+ */
+TEST_CASE("LinearSVMClassifyBlockedBatchTest", "[LinearSVMTest]")
+{
+  // More points than one batch-classification block holds.
+  const size_t points = 3000;
+  const size_t inputSize = 5;
+  const size_t numClasses = 3;
+  const double lambda = 0.5;
+
+  // Generate three-Gaussian dataset.
+  arma::mat identity = arma::eye<arma::mat>(5, 5);
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0 2.0 2.0"), identity);
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0 2.0 2.0"), identity);
+  GaussianDistribution g3(arma::vec("3.0 2.0 7.0 0.0 5.0"), identity);
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+
+  for (size_t i = 0; i < points; ++i)
+  {
+    if (i % 3 == 0)
+    {
+      data.col(i) = g1.Random();
+      labels(i) = 0;
+    }
+    else if (i % 3 == 1)
+    {
+      data.col(i) = g2.Random();
+      labels(i) = 1;
+    }
+    else
+    {
+      data.col(i) = g3.Random();
+      labels(i) = 2;
+    }
+  }
+
+  // Train linear svm object.
+  LinearSVM<arma::mat> lsvm(data, labels, numClasses, lambda);
+
+  arma::Row<size_t> predictions;
+  arma::mat scores;
+  lsvm.Classify(data, predictions, scores);
+
+  REQUIRE(scores.n_cols == points);
+
+  for (size_t i = 0; i < points; ++i)
+    REQUIRE(lsvm.Classify(data.col(i)) == predictions(i));
+}
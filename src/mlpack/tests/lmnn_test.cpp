@@ -732,3 +732,56 @@ TEST_CASE("LMNNFunctionGradientTest4", "[LMNNTest]")
     CheckGradient(lmnnfn, coordinates);
   }
 }
+
+/**
+ * The subset overload of Impostors() should agree with the full
+ * recomputation for the points it is asked about, including when the subset
+ * is small enough to use the brute-force fallback and contains no point of
+ * some classes.
+ */
+TEST_CASE("LMNNImpostorsSubsetTest", "[LMNNTest]")
+{
+  const size_t k = 3;
+
+  arma::mat dataset(5, 200, arma::fill::randu);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels[i] = i % 4;
+
+  Constraints<> constraint(dataset, labels, k);
+
+  // Calculate norm of datapoints.
+  arma::vec norm(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    norm(i) = arma::norm(dataset.col(i));
+  }
+
+  // Compute impostors over the whole dataset.
+  arma::Mat<size_t> impostors(k, dataset.n_cols, arma::fill::zeros);
+  arma::mat distances(k, dataset.n_cols, arma::fill::zeros);
+  constraint.Impostors(impostors, distances, dataset, labels, norm);
+
+  // Now recompute a handful of points via the subset overload; the chosen
+  // points all belong to classes 0 and 1, so classes 2 and 3 are skipped.
+  arma::uvec points(dataset.n_cols, arma::fill::zeros);
+  points(0) = 0;
+  points(1) = 1;
+  points(2) = 4;
+  const size_t numPoints = 3;
+
+  arma::Mat<size_t> subImpostors(k, dataset.n_cols, arma::fill::zeros);
+  arma::mat subDistances(k, dataset.n_cols, arma::fill::zeros);
+  constraint.Impostors(subImpostors, subDistances, dataset, labels, norm,
+      points, numPoints);
+
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(subImpostors(j, points(i)) == impostors(j, points(i)));
+      REQUIRE(subDistances(j, points(i)) ==
+          Approx(distances(j, points(i))).epsilon(1e-10));
+    }
+  }
+}
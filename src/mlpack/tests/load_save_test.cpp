@@ -2504,3 +2504,353 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * Make sure MMapMatrix gives a zero-copy view of a raw binary column-major
+ * file that matches the original data.
+ */
+TEST_CASE("MMapMatrixTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(10, 50);
+
+  // Write the raw column-major element data to disk.
+  fstream f;
+  f.open("test_mmap.bin", fstream::out | fstream::binary);
+  f.write((const char*) test.memptr(), test.n_elem * sizeof(double));
+  f.close();
+
+  data::MMapMatrix<double> m("test_mmap.bin", 10, 50);
+  REQUIRE(m.IsOpen());
+
+  arma::mat alias = m.Matrix();
+  REQUIRE(alias.n_rows == 10);
+  REQUIRE(alias.n_cols == 50);
+  // The alias must point directly at the mapping, not a copy.
+  REQUIRE(alias.memptr() != test.memptr());
+
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(alias[i] == Approx(test[i]).epsilon(1e-10));
+
+  m.Close();
+  remove("test_mmap.bin");
+}
+
+/**
+ * Make sure MMapMatrix fails cleanly on missing or truncated files.
+ */
+TEST_CASE("MMapMatrixFailureTest", "[LoadSaveTest]")
+{
+  data::MMapMatrix<double> m;
+  REQUIRE(m.Open("nonexistent_mmap_file.bin", 10, 10) == false);
+  REQUIRE(m.IsOpen() == false);
+
+  // A file that is too small for the requested dimensions must be rejected.
+  fstream f;
+  f.open("test_mmap_small.bin", fstream::out | fstream::binary);
+  double d = 1.0;
+  f.write((const char*) &d, sizeof(double));
+  f.close();
+
+  REQUIRE(m.Open("test_mmap_small.bin", 10, 10) == false);
+  REQUIRE(m.IsOpen() == false);
+
+  remove("test_mmap_small.bin");
+}
+
+/**
+ * Test round-tripping a matrix through the mlpack binary dataset format.
+ */
+TEST_CASE("BinaryDatasetRoundTripTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(8, 120);
+
+  REQUIRE(data::SaveBinaryDataset<double>("test_dataset.mlds", test) == true);
+
+  arma::mat loaded;
+  REQUIRE(data::LoadBinaryDataset<double>("test_dataset.mlds", loaded) ==
+      true);
+
+  REQUIRE(loaded.n_rows == test.n_rows);
+  REQUIRE(loaded.n_cols == test.n_cols);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(loaded[i] == Approx(test[i]).epsilon(1e-10));
+
+  remove("test_dataset.mlds");
+}
+
+/**
+ * Test loading only a range of dimensions from a binary dataset file.
+ */
+TEST_CASE("BinaryDatasetDimensionRangeTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(8, 120);
+
+  REQUIRE(data::SaveBinaryDataset<double>("test_dataset.mlds", test) == true);
+
+  arma::mat loaded;
+  REQUIRE(data::LoadBinaryDataset<double>("test_dataset.mlds", loaded, 2, 5) ==
+      true);
+
+  REQUIRE(loaded.n_rows == 4);
+  REQUIRE(loaded.n_cols == test.n_cols);
+  for (size_t r = 0; r < 4; ++r)
+    for (size_t c = 0; c < test.n_cols; ++c)
+      REQUIRE(loaded(r, c) == Approx(test(r + 2, c)).epsilon(1e-10));
+
+  // Out-of-range dimensions must be rejected.
+  REQUIRE(data::LoadBinaryDataset<double>("test_dataset.mlds", loaded, 5, 20)
+      == false);
+
+  remove("test_dataset.mlds");
+}
+
+/**
+ * Test that DatasetMapper metadata survives a binary dataset round trip.
+ */
+TEST_CASE("BinaryDatasetMapperTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(3, 10);
+
+  DatasetInfo info(3);
+  info.Type(1) = Datatype::categorical;
+  info.MapString<double>("hello", 1);
+  info.MapString<double>("goodbye", 1);
+
+  REQUIRE(data::SaveBinaryDataset<double>("test_dataset.mlds", test, &info) ==
+      true);
+
+  arma::mat loaded;
+  DatasetInfo loadedInfo;
+  REQUIRE(data::LoadBinaryDataset<double>("test_dataset.mlds", loaded,
+      &loadedInfo) == true);
+
+  REQUIRE(loadedInfo.Dimensionality() == 3);
+  REQUIRE(loadedInfo.Type(1) == Datatype::categorical);
+  REQUIRE(loadedInfo.NumMappings(1) == 2);
+  REQUIRE(loadedInfo.UnmapString(0, 1) == "hello");
+
+  remove("test_dataset.mlds");
+}
+
+/**
+ * Test that StreamingDataSource yields the right batches, in order, and can
+ * be rewound for a second epoch.
+ */
+TEST_CASE("StreamingDataSourceTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(5, 23);
+  arma::rowvec labels = arma::randu<arma::rowvec>(23);
+
+  fstream f;
+  f.open("test_stream.bin", fstream::out | fstream::binary);
+  f.write((const char*) test.memptr(), test.n_elem * sizeof(double));
+  f.close();
+  f.open("test_stream_labels.bin", fstream::out | fstream::binary);
+  f.write((const char*) labels.memptr(), labels.n_elem * sizeof(double));
+  f.close();
+
+  data::StreamingDataSource<double> source("test_stream.bin", 5, 23,
+      "test_stream_labels.bin", 10);
+
+  for (size_t epoch = 0; epoch < 2; ++epoch)
+  {
+    arma::mat batch;
+    arma::rowvec batchLabels;
+    size_t col = 0;
+    while (source.NextBatch(batch, batchLabels))
+    {
+      REQUIRE(batch.n_rows == 5);
+      REQUIRE(batch.n_cols == batchLabels.n_elem);
+      for (size_t c = 0; c < batch.n_cols; ++c, ++col)
+      {
+        for (size_t r = 0; r < 5; ++r)
+          REQUIRE(batch(r, c) == Approx(test(r, col)).epsilon(1e-10));
+        REQUIRE(batchLabels[c] == Approx(labels[col]).epsilon(1e-10));
+      }
+    }
+
+    // The last batch must be the 3-point remainder, and all points seen.
+    REQUIRE(col == 23);
+    source.Reset();
+  }
+
+  remove("test_stream.bin");
+  remove("test_stream_labels.bin");
+}
+
+/**
+ * Test bulk MapTokens(): IDs must match one-at-a-time MapString() mapping,
+ * and mapping a second chunk (a "delta") must leave existing IDs untouched.
+ */
+TEST_CASE("DatasetMapperMapTokensTest", "[LoadSaveTest]")
+{
+  DatasetInfo info(1);
+
+  std::vector<std::string> chunk1 = { "a", "b", "a", "c" };
+  arma::vec mapped1;
+  info.MapTokens(chunk1, 0, mapped1);
+
+  REQUIRE(info.Type(0) == Datatype::categorical);
+  REQUIRE(info.NumMappings(0) == 3);
+  REQUIRE(mapped1[0] == mapped1[2]);
+  REQUIRE(mapped1[0] != mapped1[1]);
+
+  // Map a delta containing old and new strings; old IDs must be stable.
+  std::vector<std::string> chunk2 = { "c", "d", "a" };
+  arma::vec mapped2;
+  info.MapTokens(chunk2, 0, mapped2);
+
+  REQUIRE(info.NumMappings(0) == 4);
+  REQUIRE(mapped2[0] == mapped1[3]); // "c" keeps its ID.
+  REQUIRE(mapped2[2] == mapped1[0]); // "a" keeps its ID.
+}
+
+/**
+ * Test that a DatasetMapper can be serialized, resumed, and extended with new
+ * mappings without disturbing the old ones.
+ */
+TEST_CASE("DatasetMapperResumeTest", "[LoadSaveTest]")
+{
+  DatasetInfo info(1);
+  info.MapString<double>("first", 0);
+  info.MapString<double>("second", 0);
+
+  std::stringstream ss;
+  {
+    cereal::BinaryOutputArchive ar(ss);
+    ar(cereal::make_nvp("info", info));
+  }
+
+  DatasetInfo resumed;
+  {
+    cereal::BinaryInputArchive ar(ss);
+    ar(cereal::make_nvp("info", resumed));
+  }
+
+  // Continue mapping with the resumed mapper.
+  std::vector<std::string> delta = { "second", "third" };
+  arma::vec mapped;
+  resumed.MapTokens(delta, 0, mapped);
+
+  REQUIRE(resumed.NumMappings(0) == 3);
+  REQUIRE(mapped[0] == 1);
+  REQUIRE(mapped[1] == 2);
+  REQUIRE(resumed.UnmapString(0, 0) == "first");
+}
+
+/**
+ * Test that a model saved with SaveMappedModel() loads as an alias over the
+ * file mapping, with identical contents, and that ordinary binary
+ * serialization still round-trips.
+ */
+TEST_CASE("MappedModelTest", "[LoadSaveTest]")
+{
+  // Use a logistic regression model as a representative parameter holder.
+  arma::mat weights = arma::randu<arma::mat>(64, 512);
+
+  REQUIRE(data::SaveMappedModel("test_mapped_model.bin", weights) == true);
+
+  data::MappedModelRegion region;
+  arma::mat loaded;
+  REQUIRE(data::LoadMappedModel("test_mapped_model.bin", loaded, region) ==
+      true);
+
+  REQUIRE(loaded.n_rows == weights.n_rows);
+  REQUIRE(loaded.n_cols == weights.n_cols);
+  for (size_t i = 0; i < weights.n_elem; ++i)
+    REQUIRE(loaded[i] == Approx(weights[i]).epsilon(1e-10));
+
+#ifndef _WIN32
+  // The loaded matrix must alias the mapping, not a heap copy.
+  REQUIRE((const unsigned char*) loaded.memptr() >= region.Base());
+  REQUIRE((const unsigned char*) loaded.memptr() <
+      region.Base() + region.Length());
+  // The payload must be page-aligned for sharing.
+  REQUIRE(((uintptr_t) loaded.memptr() % 4096) == ((uintptr_t) region.Base() %
+      4096));
+#endif
+
+  // Matrices must be released before the mapping is closed.
+  loaded.reset();
+  region.Close();
+  remove("test_mapped_model.bin");
+}
+
+/**
+ * Make sure the fast decimal parse path in ConvertToken() agrees with
+ * strtod() on representative tokens, and that hard tokens still convert.
+ */
+TEST_CASE("ConvertTokenFastParseTest", "[LoadSaveTest]")
+{
+  LoadCSV loader;
+
+  const std::vector<std::string> tokens = {
+    "0", "1", "-1", "+3", "3.25", "-0.001", "1e5", "-2.5E-3", "12345.6789",
+    // These fall off the fast path (too many digits / huge exponent) and
+    // must still parse correctly via strtod().
+    "1.2345678901234567890123", "1e300", "-1e-300",
+    "inf", "-inf", "nan"
+  };
+
+  for (const std::string& token : tokens)
+  {
+    double val;
+    REQUIRE(loader.ConvertToken(val, token) == true);
+    const double expected = strtod(token.c_str(), NULL);
+    if (std::isnan(expected))
+      REQUIRE(std::isnan(val));
+    else
+      REQUIRE(val == expected);
+  }
+
+  // Garbage must still be rejected.
+  double val;
+  REQUIRE(loader.ConvertToken(val, std::string("abc")) == false);
+}
+
+/**
+ * The fused load-transform overload must give the same result as loading and
+ * then transforming in a separate pass, both on the CSV path (transform
+ * applied during parsing) and on the binary path (in-place pass).
+ */
+TEST_CASE("FusedLoadTransformTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "0.1, 0.6, 0.3, 0.9" << endl;
+  f << "0.8, 0.2, 0.7, 0.4" << endl;
+  f.close();
+
+  // Binarization fused into the CSV parse.
+  arma::mat plain, fused, reference;
+  REQUIRE(data::Load("test_file.csv", plain) == true);
+  REQUIRE(data::Load("test_file.csv", fused,
+      data::BinarizeTransform(0.5)) == true);
+
+  data::Binarize<double>(plain, reference, 0.5);
+  CheckMatrices(fused, reference);
+
+  // Clamping fused into the CSV parse.
+  REQUIRE(data::Load("test_file.csv", fused,
+      data::ClampTransform(0.25, 0.75)) == true);
+  for (size_t i = 0; i < fused.n_elem; ++i)
+  {
+    REQUIRE(fused[i] >= 0.25);
+    REQUIRE(fused[i] <= 0.75);
+    if (plain[i] >= 0.25 && plain[i] <= 0.75)
+      REQUIRE(fused[i] == Approx(plain[i]).epsilon(1e-7));
+  }
+
+  // A user-supplied lambda on the binary path (in-place pass after load).
+  REQUIRE(data::Save("test_file.bin", plain) == true);
+  REQUIRE(data::Load("test_file.bin", fused,
+      data::MakeElementTransform([](const double x)
+      { return std::log1p(x); })) == true);
+
+  reference = plain;
+  reference.transform([](const double x) { return std::log1p(x); });
+  CheckMatrices(fused, reference);
+
+  remove("test_file.csv");
+  remove("test_file.bin");
+}
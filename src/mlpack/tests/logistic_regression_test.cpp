@@ -11,6 +11,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/core/util/training_session.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
 #include <ensmallen.hpp>
 
@@ -835,6 +836,84 @@ TEST_CASE("LogisticRegressionSparseSGDTest", "[LogisticRegressionTest]")
         Approx(lrSparse.Parameters()[i]).epsilon(1e-5));
 }
 
+/**
+ * Test that the sparse-data specializations of Gradient() and
+ * EvaluateWithGradient() give the same results as the generic dense
+ * implementation.
+ */
+TEST_CASE("LogisticRegressionSparseGradientTest", "[LogisticRegressionTest]")
+{
+  // Create a random dataset.
+  arma::sp_mat dataset;
+  dataset.sprandu(50, 300, 0.1);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<> lrf(denseDataset, labels, 0.5);
+  LogisticRegressionFunction<arma::sp_mat> lrfSparse(dataset, labels, 0.5);
+
+  arma::rowvec parameters;
+  parameters.randu(51);
+
+  // Check the full gradient.
+  arma::mat gradient, sparseGradient;
+  lrf.Gradient(parameters, gradient);
+  lrfSparse.Gradient(parameters, sparseGradient);
+
+  REQUIRE(gradient.n_elem == sparseGradient.n_elem);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx(sparseGradient[i]).margin(1e-10));
+
+  // Check a batch gradient along with the objective.
+  const double objective = lrf.EvaluateWithGradient(parameters, 30, gradient,
+      20);
+  const double sparseObjective = lrfSparse.EvaluateWithGradient(parameters, 30,
+      sparseGradient, 20);
+
+  REQUIRE(objective == Approx(sparseObjective).epsilon(1e-10));
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx(sparseGradient[i]).margin(1e-10));
+}
+
+/**
+ * Test that a batch gradient computed into a sparse matrix stays sparse and
+ * matches the dense gradient.  With lambda = 0 the sparse result is exact;
+ * its nonzero entries are restricted to the features active in the batch.
+ */
+TEST_CASE("LogisticRegressionSparseGradientSparseOutputTest",
+          "[LogisticRegressionTest]")
+{
+  // Create a random dataset.
+  arma::sp_mat dataset;
+  dataset.sprandu(50, 300, 0.1);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<> lrf(denseDataset, labels, 0.0);
+  LogisticRegressionFunction<arma::sp_mat> lrfSparse(dataset, labels, 0.0);
+
+  arma::rowvec parameters;
+  parameters.randu(51);
+
+  arma::mat gradient;
+  arma::sp_mat sparseGradient;
+  lrf.Gradient(parameters, 10, gradient, 25);
+  lrfSparse.Gradient(parameters, 10, sparseGradient, 25);
+
+  REQUIRE(gradient.n_elem == sparseGradient.n_elem);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx((double) sparseGradient[i]).margin(1e-10));
+
+  // The sparse gradient must not be densified: at most one entry per nonzero
+  // of the batch, plus the intercept term.
+  const arma::sp_mat batch = dataset.cols(10, 34);
+  REQUIRE(sparseGradient.n_nonzero <= batch.n_nonzero + 1);
+}
+
 /**
  * Test multi-point classification (Classify()).
  */
@@ -1081,3 +1160,222 @@ TEST_CASE("IncrementalTraining", "[LogisticRegressionTest]")
 
   REQUIRE(acc == Approx(100.0).epsilon(0.03)); // 3% error tolerance.
 }
+
+/**
+ * Test that logistic regression works end-to-end on float32 data: training,
+ * classification, and probabilities all in arma::fmat precision.
+ */
+TEST_CASE("LogisticRegressionFMatTest", "[LogisticRegressionTest]")
+{
+  // Very simple fake dataset with two separated Gaussians.
+  arma::fmat data(2, 200, arma::fill::randn);
+  arma::Row<size_t> responses(200);
+  for (size_t i = 100; i < 200; ++i)
+  {
+    data.col(i) += 6.0;
+    responses[i] = 1;
+  }
+
+  LogisticRegression<arma::fmat> lr(data, responses);
+
+  // The learned parameters must be single-precision.
+  REQUIRE((std::is_same<decltype(lr.Parameters()),
+      const arma::Row<float>&>::value));
+
+  REQUIRE(lr.ComputeAccuracy(data, responses) > 95.0);
+
+  arma::fmat probabilities;
+  lr.Classify(data, probabilities);
+  REQUIRE(probabilities.n_rows == 2);
+  REQUIRE(probabilities.n_cols == 200);
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(probabilities(0, i) + probabilities(1, i) ==
+        Approx(1.0).epsilon(1e-5));
+}
+
+
+/**
+ * Test that classifying a batch spanning several column blocks gives the same
+ * results as classifying every point individually.
+ */
+TEST_CASE("ClassifyBlockedBatchTest", "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset with more points than one
+  // batch-classification block holds.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 3000);
+  arma::Row<size_t> responses(3000);
+  for (size_t i = 0; i < 1500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 1500; i < 3000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  // Now train a logistic regression object on it.
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  lr.Train<>(data, responses);
+
+  arma::Row<size_t> predictions;
+  lr.Classify(data, predictions);
+
+  arma::mat probabilities;
+  lr.Classify(data, probabilities);
+
+  REQUIRE(predictions.n_elem == data.n_cols);
+  REQUIRE(probabilities.n_cols == data.n_cols);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(lr.Classify(data.col(i)) == predictions[i]);
+    REQUIRE(probabilities(0, i) + probabilities(1, i) ==
+        Approx(1.0).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that incremental training over several batches separates two Gaussians
+ * just like a single Train() call on the full dataset would.
+ */
+TEST_CASE("LogisticRegressionIncrementalTrainTest", "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  // Feed the dataset in as four batches of 250 points.
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  for (size_t b = 0; b < 4; ++b)
+  {
+    const arma::mat batch = data.cols(250 * b, 250 * b + 249);
+    const arma::Row<size_t> batchResponses = responses.subvec(250 * b,
+        250 * b + 249);
+    lr.IncrementalTrain(batch, batchResponses);
+  }
+
+  // With the default decay of 1, no point is ever dropped.
+  REQUIRE(lr.BufferedPoints() == 1000);
+
+  // Ensure that the error is close to zero.
+  const double acc = lr.ComputeAccuracy(data, responses);
+  REQUIRE(acc == Approx(100.0).epsilon(0.003)); // 0.3% error tolerance.
+}
+
+/**
+ * Test that decayed incremental training forgets stale points, so the model
+ * can track a label flip in the stream.
+ */
+TEST_CASE("LogisticRegressionIncrementalDecayTest", "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 500);
+  arma::Row<size_t> responses(500);
+  for (size_t i = 0; i < 250; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 250; i < 500; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  lr.IncrementalTrain(data, responses);
+
+  // Now the concept flips: the labels of the two Gaussians are swapped.  With
+  // a decay of 0.005 per call, the stale batch falls below the weight floor
+  // after two more calls and is dropped from the buffer.
+  arma::Row<size_t> flipped = 1 - responses;
+  for (size_t call = 0; call < 2; ++call)
+  {
+    for (size_t i = 0; i < 250; ++i)
+      data.col(i) = g1.Random();
+    for (size_t i = 250; i < 500; ++i)
+      data.col(i) = g2.Random();
+
+    lr.IncrementalTrain(data, flipped, 0.005);
+  }
+
+  // Only the two post-flip batches remain buffered.
+  REQUIRE(lr.BufferedPoints() == 1000);
+
+  // The model must have adapted to the flipped labels.
+  for (size_t i = 0; i < 250; ++i)
+    data.col(i) = g1.Random();
+  for (size_t i = 250; i < 500; ++i)
+    data.col(i) = g2.Random();
+
+  const double acc = lr.ComputeAccuracy(data, flipped);
+  REQUIRE(acc == Approx(100.0).epsilon(0.006)); // 0.6% error tolerance.
+}
+
+/**
+ * Test that a TrainingSession can be used to run several Train() calls on the
+ * same model with one optimizer object, and that the session's optimizer can
+ * be reconfigured between calls.
+ */
+TEST_CASE("LogisticRegressionTrainingSessionTest", "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  util::TrainingSession<LogisticRegression<>, ens::L_BFGS> session(lr);
+
+  // Several retrains through the session must all use the same optimizer
+  // object, and the model must end up well trained.
+  double objective = session.Train(data, responses);
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    const double retrainObjective = session.Train(data, responses);
+    // Warm retrains on the same data may not make the objective much worse.
+    REQUIRE(retrainObjective <= objective + 1e-5);
+    objective = retrainObjective;
+  }
+
+  // Ensure that the model was trained to high accuracy.
+  REQUIRE(session.Model().ComputeAccuracy(data, responses) > 98.0);
+
+  // The optimizer is owned by the session and can be reconfigured in place.
+  session.Optimizer().MaxIterations() = 5;
+  REQUIRE(session.Optimizer().MaxIterations() == 5);
+  session.Train(data, responses);
+}
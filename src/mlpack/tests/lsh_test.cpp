@@ -12,6 +12,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
+#include "serialization.hpp"
 
 #include <mlpack/methods/lsh/lsh_search.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
@@ -991,3 +992,159 @@ TEST_CASE("SparseLSHTest", "[LSHTest]")
     REQUIRE(!std::isnan(sparseDistances[i]));
   }
 }
+
+/**
+ * Test the global probe budget for query-directed multiprobe LSH.  With a
+ * budget large enough to cover every probing bin the results must be
+ * identical to the unbudgeted search, and a smaller budget must not examine
+ * more candidates than the unbudgeted search.
+ */
+TEST_CASE("MultiprobeGlobalBudgetTest", "[LSHTest]")
+{
+  const size_t numTables = 10;
+  const size_t numProj = 10;
+  const size_t numQueries = 50;
+  const size_t k = 4;
+  const size_t T = 5;
+
+  arma::mat rdata = arma::randu<arma::mat>(10, 1000);
+  arma::mat qdata = arma::randu<arma::mat>(10, numQueries);
+
+  LSHSearch<> lshTest(rdata, numProj, numTables);
+
+  // Baseline: multiprobe search without a budget.
+  arma::Mat<size_t> neighborsFull;
+  arma::mat distancesFull;
+  lshTest.Search(qdata, k, neighborsFull, distancesFull, 0, T);
+  const size_t fullEvaluations = lshTest.DistanceEvaluations();
+
+  // A budget covering every probing bin must not change the results.
+  lshTest.DistanceEvaluations() = 0;
+  lshTest.GlobalProbeBudget() = numTables * (T + 1);
+  arma::Mat<size_t> neighborsBudget;
+  arma::mat distancesBudget;
+  lshTest.Search(qdata, k, neighborsBudget, distancesBudget, 0, T);
+
+  REQUIRE(arma::all(arma::vectorise(neighborsBudget == neighborsFull)));
+
+  // A smaller budget must visit at most as many candidates, and primary
+  // buckets (score 0) are preferred, so results should remain sensible.
+  lshTest.DistanceEvaluations() = 0;
+  lshTest.GlobalProbeBudget() = numTables + T;
+  arma::Mat<size_t> neighborsSmall;
+  arma::mat distancesSmall;
+  lshTest.Search(qdata, k, neighborsSmall, distancesSmall, 0, T);
+
+  REQUIRE(lshTest.DistanceEvaluations() <= fullEvaluations);
+}
+
+/**
+ * Test incremental insertion of reference points.  A query identical to an
+ * inserted point hashes to the same bucket of every table as the point
+ * itself, so (with no bucket size cap) the point is always among the
+ * candidates and must be returned at distance zero.
+ */
+TEST_CASE("LSHIncrementalInsertTest", "[LSHTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(10, 500);
+  // Offset the new points so each is its own unambiguous nearest neighbor.
+  arma::mat newPoints = arma::randu<arma::mat>(10, 50) + 2.0;
+
+  // No bucket size limit, so no insertion can be dropped.
+  LSHSearch<> lsh(referenceData, 5, 10, 0.0, 99901, 0);
+  lsh.InsertPoints(newPoints);
+
+  REQUIRE(lsh.ReferenceSet().n_cols == 550);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(newPoints, 1, neighbors, distances);
+
+  for (size_t j = 0; j < newPoints.n_cols; ++j)
+  {
+    REQUIRE(neighbors(0, j) == 500 + j);
+    REQUIRE(distances(0, j) == Approx(0.0).margin(1e-10));
+  }
+
+  // A second batch must keep working on the grown tables.
+  arma::mat morePoints = arma::randu<arma::mat>(10, 25) - 2.0;
+  lsh.InsertPoints(morePoints);
+  REQUIRE(lsh.ReferenceSet().n_cols == 575);
+
+  lsh.Search(morePoints, 1, neighbors, distances);
+  for (size_t j = 0; j < morePoints.n_cols; ++j)
+  {
+    REQUIRE(neighbors(0, j) == 550 + j);
+    REQUIRE(distances(0, j) == Approx(0.0).margin(1e-10));
+  }
+
+  // Inserting into an untrained model is an error.
+  LSHSearch<> empty;
+  REQUIRE_THROWS_AS(empty.InsertPoints(newPoints), std::invalid_argument);
+}
+
+/**
+ * Test that the bucket size cap is still enforced by incremental insertion:
+ * no bucket may ever hold more entries than the cap.
+ */
+TEST_CASE("LSHIncrementalInsertBucketCapTest", "[LSHTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 300);
+  arma::mat newPoints = arma::randu<arma::mat>(5, 300);
+
+  const size_t cap = 10;
+  LSHSearch<> lsh(referenceData, 4, 8, 0.0, 997, cap);
+  lsh.InsertPoints(newPoints);
+
+  const std::vector<arma::Col<size_t>>& table = lsh.SecondHashTable();
+  for (size_t i = 0; i < table.size(); ++i)
+    REQUIRE(table[i].n_elem <= cap);
+
+  // Searching the grown model must still produce valid output.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(newPoints, 3, neighbors, distances);
+  REQUIRE(neighbors.n_cols == newPoints.n_cols);
+}
+
+/**
+ * Test that a model grown with InsertPoints() survives serialization: the
+ * compact table layout stores only the filled prefix of every bucket, so a
+ * reloaded model must return identical search results.
+ */
+TEST_CASE("LSHCompactSerializationTest", "[LSHTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 400);
+  arma::mat newPoints = arma::randu<arma::mat>(8, 40);
+
+  LSHSearch<> lsh(referenceData, 5, 10, 0.0, 99901, 0);
+  lsh.InsertPoints(newPoints);
+
+  LSHSearch<> xmlLsh, jsonLsh, binaryLsh;
+  SerializeObjectAll(lsh, xmlLsh, jsonLsh, binaryLsh);
+
+  // The reloaded buckets hold exactly the filled prefixes of the originals.
+  REQUIRE(lsh.SecondHashTable().size() == binaryLsh.SecondHashTable().size());
+  for (size_t i = 0; i < lsh.SecondHashTable().size(); ++i)
+  {
+    const arma::Col<size_t>& reloaded = binaryLsh.SecondHashTable()[i];
+    REQUIRE(reloaded.n_elem <= lsh.SecondHashTable()[i].n_elem);
+    for (size_t j = 0; j < reloaded.n_elem; ++j)
+      REQUIRE(reloaded[j] == lsh.SecondHashTable()[i][j]);
+  }
+
+  // Search results must match the original model exactly.
+  arma::mat querySet = arma::randu<arma::mat>(8, 30);
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+
+  lsh.Search(querySet, 3, neighbors, distances);
+  xmlLsh.Search(querySet, 3, xmlNeighbors, xmlDistances);
+  jsonLsh.Search(querySet, 3, jsonNeighbors, jsonDistances);
+  binaryLsh.Search(querySet, 3, binaryNeighbors, binaryDistances);
+
+  REQUIRE(arma::all(arma::vectorise(neighbors == xmlNeighbors)));
+  REQUIRE(arma::all(arma::vectorise(neighbors == jsonNeighbors)));
+  REQUIRE(arma::all(arma::vectorise(neighbors == binaryNeighbors)));
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+}
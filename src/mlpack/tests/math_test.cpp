@@ -10,6 +10,10 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core/math/clamp.hpp>
+#include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/math/ccov.hpp>
+#include <mlpack/core/math/fast_math.hpp>
+#include <mlpack/core/math/multiply_slices.hpp>
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/core/math/range.hpp>
 #include "catch.hpp"
@@ -1006,3 +1010,334 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * Verify that AccuLog() agrees with the direct computation, including the
+ * all -inf case and the float instantiation.
+ */
+TEST_CASE("AccuLogTest", "[MathTest]")
+{
+  arma::vec x(100, arma::fill::randn);
+  x *= 10.0;
+
+  REQUIRE(AccuLog(x) == Approx(std::log(arma::accu(arma::exp(
+      x - x.max()))) + x.max()).epsilon(1e-10));
+
+  // A vector of -inf values must sum to -inf.
+  arma::vec infs(5);
+  infs.fill(-std::numeric_limits<double>::infinity());
+  REQUIRE(AccuLog(infs) == -std::numeric_limits<double>::infinity());
+
+  // The float instantiation must work too, within float tolerance.
+  arma::fvec xf = arma::conv_to<arma::fvec>::from(x);
+  REQUIRE(AccuLog(xf) == Approx((float) AccuLog(x)).epsilon(1e-4));
+}
+
+/**
+ * Verify that LogSumExp() and LogSumExpT() agree with per-row and per-column
+ * AccuLog(), in both the fresh and in-place variants, and that -inf rows are
+ * handled.
+ */
+TEST_CASE("LogSumExpTest", "[MathTest]")
+{
+  arma::mat x(20, 30, arma::fill::randn);
+  x *= 5.0;
+
+  arma::vec rowResults, colResults;
+  math::LogSumExp(x, rowResults);
+  math::LogSumExpT(x, colResults);
+
+  REQUIRE(rowResults.n_elem == x.n_rows);
+  REQUIRE(colResults.n_elem == x.n_cols);
+
+  for (size_t i = 0; i < x.n_rows; ++i)
+  {
+    REQUIRE(rowResults[i] ==
+        Approx(AccuLog(arma::vec(x.row(i).t()))).epsilon(1e-10));
+  }
+  for (size_t j = 0; j < x.n_cols; ++j)
+  {
+    REQUIRE(colResults[j] ==
+        Approx(AccuLog(arma::vec(x.col(j)))).epsilon(1e-10));
+  }
+
+  // The in-place variants must add the previous y values to the sums.
+  arma::vec inPlaceRows(x.n_rows, arma::fill::randn);
+  arma::vec inPlaceCols(x.n_cols, arma::fill::randn);
+  const arma::vec oldRows = inPlaceRows;
+  const arma::vec oldCols = inPlaceCols;
+  math::LogSumExp<arma::mat, true>(x, inPlaceRows);
+  math::LogSumExpT<arma::mat, true>(x, inPlaceCols);
+
+  for (size_t i = 0; i < x.n_rows; ++i)
+  {
+    arma::vec joined(x.n_cols + 1);
+    joined.subvec(0, x.n_cols - 1) = x.row(i).t();
+    joined[x.n_cols] = oldRows[i];
+    REQUIRE(inPlaceRows[i] == Approx(AccuLog(joined)).epsilon(1e-10));
+  }
+  for (size_t j = 0; j < x.n_cols; ++j)
+  {
+    arma::vec joined(x.n_rows + 1);
+    joined.subvec(0, x.n_rows - 1) = x.col(j);
+    joined[x.n_rows] = oldCols[j];
+    REQUIRE(inPlaceCols[j] == Approx(AccuLog(joined)).epsilon(1e-10));
+  }
+
+  // Rows and columns of -inf values must produce -inf, not NaN.
+  x.row(3).fill(-std::numeric_limits<double>::infinity());
+  x.col(7).fill(-std::numeric_limits<double>::infinity());
+  math::LogSumExp(x, rowResults);
+  math::LogSumExpT(x, colResults);
+  REQUIRE(rowResults[3] == -std::numeric_limits<double>::infinity());
+  REQUIRE(colResults[7] == -std::numeric_limits<double>::infinity());
+}
+
+/**
+ * The parallel gather and the in-place cycle walk must both produce exactly
+ * input.cols(ordering), including for permutations with fixed points and for
+ * orderings that select a subset of the columns.
+ */
+TEST_CASE("ApplyColumnPermutationTest", "[MathTest]")
+{
+  arma::mat data(11, 57, arma::fill::randn);
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      data.n_cols - 1, data.n_cols));
+  // Force a fixed point by swapping the value 5 into position 5; the
+  // ordering stays a permutation.
+  const arma::uword pos = arma::as_scalar(arma::find(ordering == 5, 1));
+  std::swap(ordering[5], ordering[pos]);
+
+  const arma::mat expected = data.cols(ordering);
+
+  arma::mat gathered;
+  math::ApplyColumnPermutation(data, ordering, gathered);
+  CheckMatrices(gathered, expected);
+
+  arma::mat inPlace = data;
+  math::ApplyColumnPermutationInPlace(inPlace, ordering);
+  CheckMatrices(inPlace, expected);
+
+  // A subset ordering must produce a matrix with that many columns.
+  arma::mat subset;
+  math::ApplyColumnPermutation(data, ordering.subvec(0, 9), subset);
+  REQUIRE(subset.n_cols == 10);
+  CheckMatrices(subset, arma::mat(data.cols(ordering.subvec(0, 9))));
+
+  // Row vectors (e.g. labels) work too.
+  arma::Row<size_t> labels =
+      arma::linspace<arma::Row<size_t> >(0, data.n_cols - 1, data.n_cols);
+  arma::Row<size_t> shuffledLabels = labels;
+  math::ApplyColumnPermutationInPlace(shuffledLabels, ordering);
+  for (size_t i = 0; i < ordering.n_elem; ++i)
+    REQUIRE(shuffledLabels[i] == labels[ordering[i]]);
+}
+
+/**
+ * Per-thread random streams must be deterministic under a fixed master seed,
+ * distinct between threads, and the thread-0 stream must still be the global
+ * generator, so single-threaded sequences are unchanged.
+ */
+TEST_CASE("PerThreadRandomStreamTest", "[MathTest]")
+{
+  // Stream seed derivation is deterministic and separates streams.
+  REQUIRE(DeriveStreamSeed(1337, 1) == DeriveStreamSeed(1337, 1));
+  REQUIRE(DeriveStreamSeed(1337, 1) != DeriveStreamSeed(1337, 2));
+  REQUIRE(DeriveStreamSeed(1337, 1) != DeriveStreamSeed(1338, 1));
+
+  // Outside a parallel region, RandGen() is the global generator.
+  REQUIRE(&RandGen() == &randGen);
+
+  // Two runs from the same master seed must produce identical per-thread
+  // first draws, and different threads must produce different draws.
+  const size_t maxStreams = 64;
+  std::vector<double> first(maxStreams, -1.0), second(maxStreams, -1.0);
+
+  RandomSeed(1337);
+  #pragma omp parallel
+  {
+    size_t tid = 0;
+    #ifdef HAS_OPENMP
+      tid = (size_t) omp_get_thread_num();
+    #endif
+    const double draw = Random();
+    if (tid < maxStreams)
+      first[tid] = draw;
+  }
+
+  RandomSeed(1337);
+  #pragma omp parallel
+  {
+    size_t tid = 0;
+    #ifdef HAS_OPENMP
+      tid = (size_t) omp_get_thread_num();
+    #endif
+    const double draw = Random();
+    if (tid < maxStreams)
+      second[tid] = draw;
+  }
+
+  for (size_t i = 0; i < maxStreams; ++i)
+  {
+    if (first[i] == -1.0)
+      continue;
+
+    REQUIRE(first[i] == Approx(second[i]).epsilon(1e-15));
+    for (size_t j = i + 1; j < maxStreams; ++j)
+    {
+      if (second[j] != -1.0)
+        REQUIRE(first[i] != second[j]);
+    }
+  }
+
+  // Reseeding must change the streams.
+  RandomSeed(4242);
+  REQUIRE(Random() != first[0]);
+}
+
+/**
+ * All transpose combinations of the slice multiplications must match the
+ * per-slice reference products.
+ */
+TEST_CASE("MultiplySlicesTest", "[MathTest]")
+{
+  const size_t slices = 9;
+  arma::cube a(4, 6, slices, arma::fill::randn);
+  arma::cube b(6, 5, slices, arma::fill::randn);
+  arma::mat m(4, 6, arma::fill::randn);
+
+  // Cube-cube, all transpose combinations.
+  arma::cube z = MultiplyCube2Cube(a, b);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(a.slice(i) * b.slice(i)));
+
+  arma::cube at(6, 4, slices, arma::fill::randn);
+  z = MultiplyCube2Cube(at, b, true, false);
+  for (size_t i = 0; i < slices; ++i)
+  {
+    CheckMatrices(arma::mat(z.slice(i)),
+        arma::mat(at.slice(i).t() * b.slice(i)));
+  }
+
+  arma::cube bt(5, 6, slices, arma::fill::randn);
+  z = MultiplyCube2Cube(a, bt, false, true);
+  for (size_t i = 0; i < slices; ++i)
+  {
+    CheckMatrices(arma::mat(z.slice(i)),
+        arma::mat(a.slice(i) * bt.slice(i).t()));
+  }
+
+  z = MultiplyCube2Cube(at, bt, true, true);
+  for (size_t i = 0; i < slices; ++i)
+  {
+    CheckMatrices(arma::mat(z.slice(i)),
+        arma::mat(at.slice(i).t() * bt.slice(i).t()));
+  }
+
+  // Matrix-cube, including the flattened single-multiplication paths.
+  z = MultiplyMat2Cube(m, b);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(m * b.slice(i)));
+
+  arma::mat mt(6, 4, arma::fill::randn);
+  z = MultiplyMat2Cube(mt, b, true, false);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(mt.t() * b.slice(i)));
+
+  z = MultiplyMat2Cube(m, bt, false, true);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(m * bt.slice(i).t()));
+
+  z = MultiplyMat2Cube(mt, bt, true, true);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(mt.t() * bt.slice(i).t()));
+
+  // Cube-matrix.
+  arma::mat n(6, 5, arma::fill::randn);
+  z = MultiplyCube2Mat(a, n);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(a.slice(i) * n));
+
+  z = MultiplyCube2Mat(at, n, true, false);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(at.slice(i).t() * n));
+
+  arma::mat nt(5, 6, arma::fill::randn);
+  z = MultiplyCube2Mat(a, nt, false, true);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(a.slice(i) * nt.t()));
+
+  z = MultiplyCube2Mat(at, nt, true, true);
+  for (size_t i = 0; i < slices; ++i)
+    CheckMatrices(arma::mat(z.slice(i)), arma::mat(at.slice(i).t() * nt.t()));
+}
+
+/**
+ * The fused blocked ColumnCovariance() must agree with cov(trans(X)) for
+ * both normalization types, including block-boundary sizes and the
+ * single-column case.
+ */
+TEST_CASE("ColumnCovarianceFusedTest", "[MathTest]")
+{
+  // Sizes around the 256-column panel boundary.
+  const size_t sizes[4] = { 10, 255, 256, 300 };
+  for (size_t s = 0; s < 4; ++s)
+  {
+    arma::mat x(7, sizes[s], arma::fill::randn);
+    x.each_col() += 10.0 * arma::vec(7, arma::fill::randu);
+
+    const arma::mat expected0 = arma::cov(x.t(), 0);
+    const arma::mat expected1 = arma::cov(x.t(), 1);
+
+    const arma::mat actual0 = math::ColumnCovariance(x, 0);
+    const arma::mat actual1 = math::ColumnCovariance(x, 1);
+
+    REQUIRE(arma::norm(actual0 - expected0, "fro") <=
+        1e-10 * arma::norm(expected0, "fro"));
+    REQUIRE(arma::norm(actual1 - expected1, "fro") <=
+        1e-10 * arma::norm(expected1, "fro"));
+  }
+}
+
+/**
+ * FastExp() and FastLog() must stay within ~1e-7 relative error of libm over
+ * a wide range of inputs, and must match libm exactly on the edge cases.
+ */
+TEST_CASE("FastExpLogTest", "[MathTest]")
+{
+  // Scalar accuracy over a wide span of magnitudes.
+  for (double x = -700.0; x <= 700.0; x += 0.37)
+  {
+    const double expected = std::exp(x);
+    REQUIRE(math::FastExp(x) ==
+        Approx(expected).epsilon(1e-7).margin(1e-300));
+  }
+
+  for (double x = 1e-300; x <= 1e300; x *= 17.3)
+  {
+    REQUIRE(math::FastLog(x) == Approx(std::log(x)).epsilon(1e-7));
+  }
+
+  // Edge cases behave like libm.
+  REQUIRE(math::FastExp(-1000.0) == 0.0);
+  REQUIRE(std::isinf(math::FastExp(1000.0)));
+  REQUIRE(std::isinf(math::FastLog(0.0)));
+  REQUIRE(std::isnan(math::FastLog(-1.0)));
+  REQUIRE(math::FastExp(0.0) == Approx(1.0).epsilon(1e-12));
+  REQUIRE(math::FastLog(1.0) == Approx(0.0).margin(1e-12));
+
+  // Elementwise overloads and the policy classes agree with the scalars.
+  arma::mat x(20, 30, arma::fill::randn);
+  x *= 5.0;
+
+  arma::mat fastExp, exactExp;
+  math::ApproxExpLog::Exp(x, fastExp);
+  math::ExactExpLog::Exp(x, exactExp);
+  REQUIRE(arma::abs((fastExp - exactExp) / exactExp).max() < 1e-7);
+
+  arma::mat positive = arma::abs(x) + 0.01;
+  arma::mat fastLog, exactLog;
+  math::ApproxExpLog::Log(positive, fastLog);
+  math::ExactExpLog::Log(positive, exactLog);
+  REQUIRE(arma::abs(fastLog - exactLog).max() < 1e-7);
+}
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/matrix_completion/matrix_completion.hpp>
+#include <mlpack/methods/matrix_completion/streaming_matrix_completion.hpp>
 
 #include "catch.hpp"
 
@@ -60,3 +61,63 @@ TEST_CASE("UniformMatrixCompletionSDP", "[MatrixCompletionTest]")
        Approx(Xorig(indices(0, i), indices(1, i))).epsilon(1e-7));
   }
 }
+
+/**
+ * The streaming solver should recover the observed entries of the same low
+ * rank matrix used above, while reading them from disk in blocks.
+ */
+TEST_CASE("UniformMatrixCompletionStreaming", "[MatrixCompletionTest]")
+{
+  arma::mat Xorig;
+  arma::umat indices;
+  arma::vec values;
+
+  if (!data::Load("completion_X.csv", Xorig, false, false))
+    FAIL("Cannot load dataset completion_X.csv");
+  if (!data::Load("completion_indices.csv", indices, false, false))
+    FAIL("Cannot load dataset completion_indices.csv");
+
+  values.set_size(indices.n_cols);
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    values(i) = Xorig(indices(0, i), indices(1, i));
+  }
+
+  const std::string tripletsFile = "completion_triplets.bin";
+  StreamingMatrixCompletion::WriteTriplets(indices, values, tripletsFile);
+
+  // A small block size, so each pass is split into many shuffled blocks.
+  arma::mat recovered;
+  StreamingMatrixCompletion mc(Xorig.n_rows, Xorig.n_cols, tripletsFile, 5,
+      64, 400, 0.05, 0.001);
+  mc.Recover(recovered);
+
+  remove(tripletsFile.c_str());
+
+  // The stochastic solver only fits the observed entries; check those.
+  double squaredError = 0.0;
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    const double error = recovered(indices(0, i), indices(1, i)) -
+        Xorig(indices(0, i), indices(1, i));
+    squaredError += error * error;
+  }
+  const double rmse = std::sqrt(squaredError / indices.n_cols);
+  REQUIRE(rmse == Approx(0.0).margin(0.05));
+}
+
+/**
+ * A missing or malformed triplet file must be rejected.
+ */
+TEST_CASE("StreamingMatrixCompletionValidation", "[MatrixCompletionTest]")
+{
+  REQUIRE_THROWS_AS(
+      StreamingMatrixCompletion(10, 10, "nonexistent_triplets.bin", 2),
+      std::invalid_argument);
+
+  arma::umat indices(3, 2, arma::fill::zeros);
+  arma::vec values(2, arma::fill::zeros);
+  REQUIRE_THROWS_AS(
+      StreamingMatrixCompletion::WriteTriplets(indices, values, "bad.bin"),
+      std::invalid_argument);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file tests/memory_tracker_test.cpp
+ *
+ * Tests for the opt-in memory instrumentation layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/memory_tracker.hpp>
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+/**
+ * Allocations must be counted globally and attributed to the innermost tag,
+ * and the dump must be valid-looking JSON containing both.
+ */
+TEST_CASE("MemoryTrackerCountersTest", "[MemoryTrackerTest]")
+{
+  MemoryTracker::Clear();
+  MemoryTracker::EnabledFlag() = true;
+
+  void* first;
+  void* second;
+  {
+    MemoryTracker::ScopedTag tag("test_subsystem");
+    first = MemoryTracker::Allocate(4096);
+    second = MemoryTracker::Allocate(1024);
+  }
+
+  REQUIRE(MemoryTracker::CurrentBytes() == 5120);
+  REQUIRE(MemoryTracker::PeakBytes() >= 5120);
+
+  MemoryTracker::Free(second, 1024);
+  REQUIRE(MemoryTracker::CurrentBytes() == 4096);
+  // The peak doesn't decrease.
+  REQUIRE(MemoryTracker::PeakBytes() >= 5120);
+
+  const std::string dump = MemoryTracker::Dump();
+  REQUIRE(dump.find("\"test_subsystem\"") != std::string::npos);
+  REQUIRE(dump.find("\"peak_bytes\"") != std::string::npos);
+  REQUIRE(dump.find("\"allocations\": 2") != std::string::npos);
+
+  MemoryTracker::Free(first, 4096);
+  REQUIRE(MemoryTracker::CurrentBytes() == 0);
+
+  MemoryTracker::EnabledFlag() = false;
+  MemoryTracker::Clear();
+}
+
+/**
+ * A timer scope must record the allocation high-water mark reached while it
+ * was running.
+ */
+TEST_CASE("MemoryTrackerTimerScopeTest", "[MemoryTrackerTest]")
+{
+  MemoryTracker::Clear();
+  MemoryTracker::EnabledFlag() = true;
+
+  MemoryTracker::TimerScopeStart("phase");
+  void* mem = MemoryTracker::Allocate(1 << 20);
+  MemoryTracker::Free(mem, 1 << 20);
+  MemoryTracker::TimerScopeStop("phase");
+
+  const std::string dump = MemoryTracker::Dump();
+  REQUIRE(dump.find("\"phase\"") != std::string::npos);
+
+  // The scope's peak must reflect the transient megabyte even though the
+  // memory was already released when the scope ended.
+  const size_t pos = dump.find("\"phase\"");
+  const std::string tail = dump.substr(pos);
+  REQUIRE(tail.find("\"peak_bytes\": 1048576") != std::string::npos);
+
+  MemoryTracker::EnabledFlag() = false;
+  MemoryTracker::Clear();
+}
+
+/**
+ * On Linux the OS probes must report a plausible resident set size; on
+ * platforms without procfs they must return 0 rather than failing.
+ */
+TEST_CASE("MemoryTrackerRSSProbeTest", "[MemoryTrackerTest]")
+{
+  const uint64_t current = MemoryTracker::CurrentRSS();
+  const uint64_t peak = MemoryTracker::PeakRSS();
+  if (current > 0)
+    REQUIRE(peak >= current);
+}
@@ -358,3 +358,152 @@ TEST_CASE("BLEUScoreTest", "[MetricTest]")
         Approx(expectedPrecision[i]).epsilon(1e-4));
   }
 }
+
+/**
+ * The one-to-many LMetric evaluation must agree with the pairwise evaluation
+ * for the specialized and the generic powers.
+ */
+TEST_CASE("LMetricOneToManyTest", "[MetricTest]")
+{
+  arma::vec point(10, arma::fill::randn);
+  arma::mat block(10, 25, arma::fill::randn);
+
+  ManhattanDistance l1;
+  EuclideanDistance l2;
+  SquaredEuclideanDistance sl2;
+  LMetric<3> l3;
+
+  arma::vec l1Results, l2Results, sl2Results, l3Results;
+  l1.Evaluate(point, block, l1Results);
+  l2.Evaluate(point, block, l2Results);
+  sl2.Evaluate(point, block, sl2Results);
+  l3.Evaluate(point, block, l3Results);
+
+  REQUIRE(l1Results.n_elem == block.n_cols);
+  REQUIRE(l2Results.n_elem == block.n_cols);
+  REQUIRE(sl2Results.n_elem == block.n_cols);
+  REQUIRE(l3Results.n_elem == block.n_cols);
+
+  for (size_t j = 0; j < block.n_cols; ++j)
+  {
+    const arma::vec other = block.col(j);
+    REQUIRE(l1Results(j) == Approx(l1.Evaluate(point, other)).epsilon(1e-7));
+    REQUIRE(l2Results(j) == Approx(l2.Evaluate(point, other)).epsilon(1e-7));
+    REQUIRE(sl2Results(j) == Approx(sl2.Evaluate(point, other)).epsilon(1e-7));
+    REQUIRE(l3Results(j) == Approx(l3.Evaluate(point, other)).epsilon(1e-7));
+  }
+}
+
+/**
+ * The tightened L1/L2 kernels must keep working for sparse operands.
+ */
+TEST_CASE("LMetricSparseOperandTest", "[MetricTest]")
+{
+  arma::sp_vec a;
+  a.sprandu(50, 1, 0.3);
+  arma::sp_vec b;
+  b.sprandu(50, 1, 0.3);
+
+  const arma::vec da(a);
+  const arma::vec db(b);
+
+  ManhattanDistance l1;
+  EuclideanDistance l2;
+  SquaredEuclideanDistance sl2;
+
+  REQUIRE(l1.Evaluate(a, b) == Approx(l1.Evaluate(da, db)).epsilon(1e-7));
+  REQUIRE(l2.Evaluate(a, b) == Approx(l2.Evaluate(da, db)).epsilon(1e-7));
+  REQUIRE(sl2.Evaluate(a, b) == Approx(sl2.Evaluate(da, db)).epsilon(1e-7));
+}
+
+/**
+ * Within the bound, EvaluateEarlyAbandon() must return the exact distance;
+ * above it, it must return a lower bound on the distance that exceeds the
+ * bound.
+ */
+TEST_CASE("LMetricEarlyAbandonTest", "[MetricTest]")
+{
+  // Use enough dimensions that several bound checks happen.
+  arma::vec a(300, arma::fill::randn);
+  arma::vec b(300, arma::fill::randn);
+
+  ManhattanDistance l1;
+  EuclideanDistance l2;
+  SquaredEuclideanDistance sl2;
+  LMetric<3> l3;
+  ChebyshevDistance linf;
+
+  const double l1Dist = l1.Evaluate(a, b);
+  const double l2Dist = l2.Evaluate(a, b);
+  const double sl2Dist = sl2.Evaluate(a, b);
+  const double l3Dist = l3.Evaluate(a, b);
+  const double linfDist = linf.Evaluate(a, b);
+
+  // A bound above the distance must not change the result.
+  REQUIRE(l1.EvaluateEarlyAbandon(a, b, 2.0 * l1Dist) ==
+      Approx(l1Dist).epsilon(1e-7));
+  REQUIRE(l2.EvaluateEarlyAbandon(a, b, 2.0 * l2Dist) ==
+      Approx(l2Dist).epsilon(1e-7));
+  REQUIRE(sl2.EvaluateEarlyAbandon(a, b, 2.0 * sl2Dist) ==
+      Approx(sl2Dist).epsilon(1e-7));
+  REQUIRE(l3.EvaluateEarlyAbandon(a, b, 2.0 * l3Dist) ==
+      Approx(l3Dist).epsilon(1e-7));
+  REQUIRE(linf.EvaluateEarlyAbandon(a, b, 2.0 * linfDist) ==
+      Approx(linfDist).epsilon(1e-7));
+
+  // A bound below the distance must give an abandoned result that still
+  // exceeds the bound but does not exceed the true distance.
+  const double abandoned = l2.EvaluateEarlyAbandon(a, b, 0.25 * l2Dist);
+  REQUIRE(abandoned > 0.25 * l2Dist);
+  REQUIRE(abandoned <= l2Dist * (1.0 + 1e-7));
+
+  const double abandonedInf = linf.EvaluateEarlyAbandon(a, b, 0.5 * linfDist);
+  REQUIRE(abandonedInf > 0.5 * linfDist);
+  REQUIRE(abandonedInf <= linfDist * (1.0 + 1e-7));
+
+  // An infinite bound is the plain evaluation.
+  REQUIRE(l2.EvaluateEarlyAbandon(a, b, DBL_MAX) ==
+      Approx(l2Dist).epsilon(1e-7));
+}
+
+/**
+ * The merge-based sparse kernels must agree with the dense evaluation for
+ * sparse matrix column views (the form the tree base cases use), including
+ * columns with disjoint supports and empty columns.
+ */
+TEST_CASE("LMetricSparseMergeTest", "[MetricTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(200, 12, 0.05);
+  data.col(4).zeros(); // An empty point.
+  // Two points with disjoint supports.
+  data.col(5).zeros();
+  data.col(6).zeros();
+  for (size_t i = 0; i < 200; i += 10)
+    data(i, 5) = 1.0;
+  for (size_t i = 5; i < 200; i += 10)
+    data(i, 6) = 1.0;
+
+  const arma::mat dense(data);
+
+  ManhattanDistance l1;
+  EuclideanDistance l2;
+  SquaredEuclideanDistance sl2;
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      const double dl1 = l1.Evaluate(dense.col(i), dense.col(j));
+      const double dl2 = l2.Evaluate(dense.col(i), dense.col(j));
+      const double dsl2 = sl2.Evaluate(dense.col(i), dense.col(j));
+
+      REQUIRE(l1.Evaluate(data.col(i), data.col(j)) ==
+          Approx(dl1).epsilon(1e-7).margin(1e-12));
+      REQUIRE(l2.Evaluate(data.col(i), data.col(j)) ==
+          Approx(dl2).epsilon(1e-7).margin(1e-12));
+      REQUIRE(sl2.Evaluate(data.col(i), data.col(j)) ==
+          Approx(dsl2).epsilon(1e-7).margin(1e-12));
+    }
+  }
+}
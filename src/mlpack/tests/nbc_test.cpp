@@ -398,3 +398,70 @@ TEST_CASE("NaiveBayesClassifierHighDimensionsTest", "[NBCTest]")
   for (size_t i = 0; i < calcVec.n_cols; ++i)
     REQUIRE(calcVec(i) == testLabels(i));
 }
+
+/**
+ * Streaming the training set through Train() in column chunks must give the
+ * same model as training incrementally on the whole set at once.
+ */
+TEST_CASE("SeparateTrainChunkedIncrementalTest", "[NBCTest]")
+{
+  const char* trainFilename = "trainSet.csv";
+  size_t classes = 2;
+
+  arma::mat trainData;
+  if (!data::Load(trainFilename, trainData))
+    FAIL("Cannot load dataset");
+
+  // Get the labels out.
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    labels[i] = trainData(trainData.n_rows - 1, i);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  // Use epsilon = 0 so that the variance regularizer, which is applied once
+  // per Train() call, does not skew the comparison.
+  NaiveBayesClassifier<> nbc(trainData, labels, classes, true, 0.0);
+
+  // Stream the data through in three uneven chunks.
+  NaiveBayesClassifier<> nbcChunked(trainData.n_rows, classes, 0.0);
+  const size_t splits[4] = { 0, trainData.n_cols / 3,
+      (2 * trainData.n_cols) / 3 + 1, trainData.n_cols };
+  for (size_t chunk = 0; chunk < 3; ++chunk)
+  {
+    const arma::mat chunkData = trainData.cols(splits[chunk],
+        splits[chunk + 1] - 1);
+    const arma::Row<size_t> chunkLabels = labels.subvec(splits[chunk],
+        splits[chunk + 1] - 1);
+    nbcChunked.Train(chunkData, chunkLabels, classes, true);
+  }
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+  {
+    if (std::abs(nbc.Means()[i]) < 1e-5)
+      REQUIRE(nbcChunked.Means()[i] == Approx(0.0).margin(1e-5));
+    else
+      REQUIRE(nbc.Means()[i] == Approx(nbcChunked.Means()[i]).epsilon(1e-7));
+  }
+
+  for (size_t i = 0; i < nbc.Variances().n_elem; ++i)
+  {
+    if (std::abs(nbc.Variances()[i]) < 1e-5)
+      REQUIRE(nbcChunked.Variances()[i] == Approx(0.0).margin(1e-5));
+    else
+    {
+      REQUIRE(nbc.Variances()[i] ==
+          Approx(nbcChunked.Variances()[i]).epsilon(1e-7));
+    }
+  }
+
+  for (size_t i = 0; i < nbc.Probabilities().n_elem; ++i)
+  {
+    if (std::abs(nbc.Probabilities()[i]) < 1e-5)
+      REQUIRE(nbcChunked.Probabilities()[i] == Approx(0.0).margin(1e-5));
+    else
+    {
+      REQUIRE(nbc.Probabilities()[i] ==
+          Approx(nbcChunked.Probabilities()[i]).epsilon(1e-7));
+    }
+  }
+}
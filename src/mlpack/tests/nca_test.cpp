@@ -318,3 +318,59 @@ TEST_CASE("NCALBFGSSimpleDataset", "[NCATesT]")
   // norm is close to 0.
   REQUIRE(arma::norm(finalGradient, 2) < 1e-6);
 }
+
+/**
+ * If the number of sampled candidates is at least the number of possible
+ * neighbors, the sampled separable objective must fall back to the exact
+ * computation.
+ */
+TEST_CASE("SoftmaxSampledObjectiveFallback", "[NCATesT]")
+{
+  // Useful but simple dataset with six points and two classes.
+  arma::mat data           = "-0.1 -0.1 -0.1  0.1  0.1  0.1;"
+                             " 1.0  0.0 -1.0  1.0  0.0 -1.0 ";
+  arma::Row<size_t> labels = " 0    0    0    1    1    1   ";
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sefExact(data, labels);
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sefSampled(data, labels);
+  sefSampled.NumSamples() = 10; // More than the five possible candidates.
+
+  arma::mat coordinates = arma::eye<arma::mat>(2, 2);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(sefSampled.Evaluate(coordinates, i, 1) ==
+        Approx(sefExact.Evaluate(coordinates, i, 1)).epsilon(1e-12));
+  }
+}
+
+/**
+ * SGD with the sampled objective should still learn a transformation that
+ * improves the exact objective.
+ */
+TEST_CASE("NCASampledSGDSimpleDataset", "[NCATesT]")
+{
+  // Useful but simple dataset with six points and two classes.
+  arma::mat data           = "-0.1 -0.1 -0.1  0.1  0.1  0.1;"
+                             " 1.0  0.0 -1.0  1.0  0.0 -1.0 ";
+  arma::Row<size_t> labels = " 0    0    0    1    1    1   ";
+
+  NCA<SquaredEuclideanDistance> nca(data, labels);
+  nca.NumSamples() = 3;
+  nca.Optimizer().StepSize() = 0.3;
+  nca.Optimizer().MaxIterations() = 300000;
+  nca.Optimizer().Tolerance() = 0;
+  nca.Optimizer().Shuffle() = true;
+
+  arma::mat outputMatrix;
+  nca.LearnDistance(outputMatrix);
+
+  // Ensure that the exact objective function is better now.
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+
+  const double initObj = sef.Evaluate(arma::eye<arma::mat>(2, 2));
+  const double finalObj = sef.Evaluate(outputMatrix);
+
+  // The sampled gradient is noisy, so we only require improvement, not
+  // optimality.
+  REQUIRE(finalObj < initObj);
+}
@@ -16,6 +16,9 @@
 #include <mlpack/methods/amf/update_rules/nmf_mult_div.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
+#include <mlpack/methods/amf/update_rules/nmf_mult_dist_delta.hpp>
+#include <mlpack/methods/amf/termination_policies/reconstruction_residue_termination.hpp>
+#include <mlpack/methods/amf/termination_policies/sampled_residue_termination.hpp>
 
 #include "catch.hpp"
 
@@ -304,3 +307,128 @@ TEST_CASE("NonNegNMFALSTest", "[NMFTest]")
   REQUIRE((arma::all(arma::vectorise(w) >= 0)
       && arma::all(arma::vectorise(h) >= 0)));
 }
+
+/**
+ * A warm-started refactorization of a slightly changed matrix with
+ * delta-aware updates should reconstruct the new matrix well while only
+ * recomputing the changed rows and columns.
+ */
+TEST_CASE("NMFWarmStartDeltaTest", "[NMFTest]")
+{
+  mat w = randu<mat>(20, 4);
+  mat h = randu<mat>(4, 30);
+  mat v = w * h;
+  size_t r = 4;
+
+  // Factorize the original matrix from scratch.
+  AMF<> nmf;
+  mat oldW, oldH;
+  nmf.Apply(v, r, oldW, oldH);
+
+  // Perturb a handful of entries, as a daily refresh would.
+  mat v2 = v;
+  v2(3, 5) += 0.1;
+  v2(10, 20) += 0.1;
+  v2(3, 20) += 0.1;
+
+  arma::uvec changedRows, changedCols;
+  NMFMultiplicativeDistanceDeltaUpdate::FindChangedEntries(v, v2,
+      changedRows, changedCols);
+  REQUIRE(changedRows.n_elem == 2);
+  REQUIRE(changedCols.n_elem == 2);
+
+  // Refactorize warm-started from the previous factors, recomputing only the
+  // changed coordinates, and terminating on the reconstruction residual.
+  ReconstructionResidueTermination<mat> termination(1e-3, 500);
+  GivenInitialization init(oldW, oldH);
+  NMFMultiplicativeDistanceDeltaUpdate update(changedRows, changedCols);
+  AMF<ReconstructionResidueTermination<mat>,
+      GivenInitialization,
+      NMFMultiplicativeDistanceDeltaUpdate> warmNmf(termination, init, update);
+
+  mat newW, newH;
+  warmNmf.Apply(v2, r, newW, newH);
+
+  const double error = arma::norm(v2 - newW * newH, "fro") /
+      arma::norm(v2, "fro");
+  REQUIRE(error == Approx(0.0).margin(0.05));
+
+  // The untouched rows of W and columns of H must be exactly the
+  // warm-started values.
+  for (size_t i = 0; i < oldW.n_rows; ++i)
+  {
+    if (i == 3 || i == 10)
+      continue;
+    REQUIRE(arma::norm(newW.row(i) - oldW.row(i), "fro") ==
+        Approx(0.0).margin(1e-12));
+  }
+  for (size_t j = 0; j < oldH.n_cols; ++j)
+  {
+    if (j == 5 || j == 20)
+      continue;
+    REQUIRE(arma::norm(newH.col(j) - oldH.col(j), "fro") ==
+        Approx(0.0).margin(1e-12));
+  }
+
+  // Mismatched sizes must be rejected.
+  mat tooSmall = randu<mat>(5, 5);
+  REQUIRE_THROWS_AS(NMFMultiplicativeDistanceDeltaUpdate::FindChangedEntries(
+      v, tooSmall, changedRows, changedCols), std::invalid_argument);
+}
+
+/**
+ * Check that the sampled residue termination policy converges to a
+ * factorization of quality comparable to the exact tolerance check, while its
+ * reservoir holds fewer entries than the matrix has nonzeros.
+ */
+TEST_CASE("NMFSampledResidueTerminationTest", "[NMFTest]")
+{
+  mat w = randu<mat>(20, 4);
+  mat h = randu<mat>(4, 30);
+  mat v = w * h;
+  size_t r = 4;
+
+  // Reservoir of 100 entries; the matrix has 600 observed entries.
+  SampledResidueTermination<mat> srt(1e-5, 10000, 100);
+  AMF<SampledResidueTermination<mat>, RandomAcolInitialization<> > nmf(srt);
+  nmf.Apply(v, r, w, h);
+
+  REQUIRE(nmf.TerminationPolicy().SampleSize() == 100);
+
+  mat wh = w * h;
+  REQUIRE(arma::norm(v - wh, "fro") / arma::norm(v, "fro") ==
+      Approx(0.0).margin(0.05));
+}
+
+/**
+ * The sampled residue termination policy on a sparse matrix: the reservoir
+ * must only hold observed entries, and the factorization must still converge.
+ */
+TEST_CASE("SparseNMFSampledResidueTerminationTest", "[NMFTest]")
+{
+  mat w, h;
+  sp_mat v;
+  v.sprandu(20, 30, 0.3);
+  mat dv(v);
+  size_t r = 4;
+
+  SampledResidueTermination<sp_mat> srt(1e-5, 10000, 50);
+  AMF<SampledResidueTermination<sp_mat>, RandomAcolInitialization<> >
+      nmf(srt);
+  nmf.Apply(v, r, w, h);
+
+  // The reservoir cannot hold more entries than the matrix has nonzeros, and
+  // with 50 requested it should be full.
+  REQUIRE(nmf.TerminationPolicy().SampleSize() == 50);
+
+  // The sparse matrix is mostly zero, so only a loose reconstruction check
+  // over the observed entries makes sense here.
+  mat wh = w * h;
+  double sum = 0.0;
+  for (sp_mat::const_iterator it = v.begin(); it != v.end(); ++it)
+  {
+    const double error = (*it) - wh(it.row(), it.col());
+    sum += error * error;
+  }
+  REQUIRE(std::sqrt(sum / v.n_nonzero) == Approx(0.0).margin(0.35));
+}
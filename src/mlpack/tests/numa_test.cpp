@@ -0,0 +1,134 @@
+/**
+ * @file tests/numa_test.cpp
+ *
+ * Tests for the NUMA placement and pinning helpers.  A single-node machine
+ * (or a platform without pinning support) is a valid configuration, so the
+ * tests check the partitioning and first-touch contracts, which hold
+ * everywhere, and only exercise the pinning paths for absence of failure.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/numa.hpp>
+#include <mlpack/core/util/thread_pool.hpp>
+
+#include <atomic>
+
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+/**
+ * There is always at least one NUMA node, and the cached probe must be
+ * stable across calls.
+ */
+TEST_CASE("NumNumaNodesTest", "[NUMATest]")
+{
+  const size_t numNodes = NumNumaNodes();
+  REQUIRE(numNodes >= 1);
+  REQUIRE(NumNumaNodes() == numNodes);
+}
+
+/**
+ * The column shards must be contiguous, in order, and cover the column
+ * range exactly, for team sizes both smaller and larger than the number of
+ * columns.
+ */
+TEST_CASE("ColumnShardPartitionTest", "[NUMATest]")
+{
+  const size_t totals[] = { 1, 7, 100, 1000 };
+  const size_t teams[] = { 1, 2, 3, 16, 1500 };
+
+  for (const size_t totalCols : totals)
+  {
+    for (const size_t numShards : teams)
+    {
+      size_t expectedBegin = 0;
+      for (size_t shard = 0; shard < numShards; ++shard)
+      {
+        size_t begin, end;
+        ColumnShard(totalCols, shard, numShards, begin, end);
+        REQUIRE(begin == expectedBegin);
+        REQUIRE(end >= begin);
+        expectedBegin = end;
+      }
+      REQUIRE(expectedBegin == totalCols);
+    }
+  }
+}
+
+/**
+ * The thread-to-node map must assign contiguous blocks of threads to
+ * increasing nodes and use every node of the machine.
+ */
+TEST_CASE("NumaNodeOfThreadTest", "[NUMATest]")
+{
+  const size_t numNodes = NumNumaNodes();
+  const size_t numThreads = 4 * numNodes;
+
+  size_t lastNode = 0;
+  for (size_t thread = 0; thread < numThreads; ++thread)
+  {
+    const size_t node = NumaNodeOfThread(thread, numThreads);
+    REQUIRE(node < numNodes);
+    REQUIRE(node >= lastNode); // Blocks are contiguous and increasing.
+    lastNode = node;
+  }
+  REQUIRE(lastNode == numNodes - 1);
+}
+
+/**
+ * The first-touch helpers must produce a zero matrix of the requested size,
+ * including for empty and single-column matrices.
+ */
+TEST_CASE("FirstTouchContractTest", "[NUMATest]")
+{
+  arma::mat sharded;
+  ShardedFirstTouch(sharded, 50, 437);
+  REQUIRE(sharded.n_rows == 50);
+  REQUIRE(sharded.n_cols == 437);
+  REQUIRE(arma::accu(arma::abs(sharded)) == Approx(0.0).margin(1e-50));
+
+  arma::mat interleaved;
+  InterleavedFirstTouch(interleaved, 5000, 13);
+  REQUIRE(interleaved.n_rows == 5000);
+  REQUIRE(interleaved.n_cols == 13);
+  REQUIRE(arma::accu(arma::abs(interleaved)) == Approx(0.0).margin(1e-50));
+
+  // Degenerate sizes must not crash.
+  arma::mat empty;
+  ShardedFirstTouch(empty, 10, 0);
+  REQUIRE(empty.n_cols == 0);
+  InterleavedFirstTouch(empty, 0, 10);
+  REQUIRE(empty.n_rows == 0);
+
+  arma::fmat single;
+  ShardedFirstTouch(single, 3, 1);
+  REQUIRE(single.n_cols == 1);
+}
+
+/**
+ * Pinning must never crash, and the pool must keep executing tasks after a
+ * pinning attempt (which reports false on single-node machines).
+ */
+TEST_CASE("PinWorkersToNumaNodesTest", "[NUMATest]")
+{
+  ThreadPool& pool = ThreadPool::Get();
+  const bool pinned = pool.PinWorkersToNumaNodes();
+  if (NumNumaNodes() <= 1)
+    REQUIRE(pinned == false);
+
+  std::atomic<size_t> counter(0);
+  TaskGroup group;
+  for (size_t i = 0; i < 200; ++i)
+    group.Run([&counter]() { ++counter; });
+  group.Wait();
+  REQUIRE(counter.load() == 200);
+
+  // Pinning the calling thread to a nonexistent node must be declined.
+  REQUIRE(PinThreadToNumaNode(NumNumaNodes() + 1000) == false);
+}
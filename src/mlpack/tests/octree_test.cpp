@@ -16,6 +16,8 @@
 #include "test_catch_tools.hpp"
 #include "serialization.hpp"
 
+#include <stack>
+
 using namespace mlpack;
 using namespace mlpack::math;
 using namespace mlpack::tree;
@@ -346,3 +348,114 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+// Check, recursively, that the children of each node partition its columns
+// contiguously and that every node's bound contains its points.
+template<typename TreeType>
+void CheckMortonStructure(const TreeType& node)
+{
+  if (node.NumChildren() == 0)
+    return;
+
+  size_t expected = node.Child(0).Begin();
+  REQUIRE(expected == node.Begin());
+  size_t total = 0;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
+    REQUIRE(node.Child(i).Begin() == expected);
+    expected += node.Child(i).Count();
+    total += node.Child(i).Count();
+
+    for (size_t j = 0; j < node.Child(i).Count(); ++j)
+    {
+      REQUIRE(node.Child(i).Bound().Contains(
+          node.Dataset().col(node.Child(i).Begin() + j)));
+    }
+
+    CheckMortonStructure(node.Child(i));
+  }
+  REQUIRE(total == node.Count());
+}
+
+/**
+ * Build an octree with the Morton-sort constructor and check the structural
+ * invariants, the point mapping, and the leaf sizes.
+ */
+TEST_CASE("MortonBuildTest", "[OctreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 500);
+
+  std::vector<size_t> oldFromNew;
+  Octree<>* tree = Octree<>::BuildMorton(dataset, oldFromNew, 10);
+
+  REQUIRE(tree->NumDescendants() == dataset.n_cols);
+  REQUIRE(oldFromNew.size() == dataset.n_cols);
+
+  // The sorted dataset must be a permutation of the original.
+  std::vector<bool> seen(dataset.n_cols, false);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(!seen[oldFromNew[i]]);
+    seen[oldFromNew[i]] = true;
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+      REQUIRE(tree->Dataset()(d, i) == Approx(dataset(d, oldFromNew[i])));
+  }
+
+  CheckMortonStructure(*tree);
+
+  // With random data and 21 bits of resolution per dimension, every leaf
+  // must respect the maximum leaf size.
+  std::stack<const Octree<>*> stack;
+  stack.push(tree);
+  while (!stack.empty())
+  {
+    const Octree<>* node = stack.top();
+    stack.pop();
+    if (node->NumChildren() == 0)
+      REQUIRE(node->Count() <= 10);
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      stack.push(&node->Child(i));
+  }
+
+  delete tree;
+}
+
+/**
+ * The Morton build must produce the same space partition as the recursive
+ * build: the multiset of leaf sizes and the node count must match on data
+ * with no points near split planes.
+ */
+TEST_CASE("MortonBuildMatchesRecursiveTest", "[OctreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(2, 300);
+
+  std::vector<size_t> oldFromNew, recursiveMap;
+  Octree<>* morton = Octree<>::BuildMorton(dataset, oldFromNew, 5);
+  Octree<> recursive(dataset, recursiveMap, 5);
+
+  // Collect sorted leaf sizes of both trees.
+  std::vector<size_t> mortonLeaves, recursiveLeaves;
+  std::stack<const Octree<>*> stack;
+  stack.push(morton);
+  stack.push(&recursive);
+  size_t mortonNodes = 0, recursiveNodes = 0;
+  while (!stack.empty())
+  {
+    const Octree<>* node = stack.top();
+    stack.pop();
+    // Accumulate into the right tree's tally by checking the root dataset.
+    const bool isMorton = (&node->Dataset() == &morton->Dataset());
+    (isMorton ? mortonNodes : recursiveNodes)++;
+    if (node->NumChildren() == 0)
+      (isMorton ? mortonLeaves : recursiveLeaves).push_back(node->Count());
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      stack.push(&node->Child(i));
+  }
+
+  std::sort(mortonLeaves.begin(), mortonLeaves.end());
+  std::sort(recursiveLeaves.begin(), recursiveLeaves.end());
+  REQUIRE(mortonNodes == recursiveNodes);
+  REQUIRE(mortonLeaves == recursiveLeaves);
+
+  delete morton;
+}
@@ -230,3 +230,73 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Test that the sparse-destination overload produces the same encoding as
+ * the dense overload.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::mat input;
+  input = "1 1 -1 -1 -1 -1 1 1;"
+          "-1 1 -1 -1 -1 -1 1 -1;"
+          "1 1 -1 -1 -1 -1 1 1;"
+          "3 3 5 5 5 7 3 7;"
+          "1 1 -1 -1 -1 -1 1 1;";
+
+  arma::Col<size_t> indices("1 3");
+
+  arma::mat denseOutput;
+  data::OneHotEncoding(input, indices, denseOutput);
+
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == denseOutput.n_rows);
+  REQUIRE(sparseOutput.n_cols == denseOutput.n_cols);
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+
+  // With no indices to encode, the input must pass through unchanged.
+  arma::sp_mat passthrough;
+  data::OneHotEncoding(input, arma::Col<size_t>(), passthrough);
+  CheckMatrices(input, arma::mat(passthrough));
+}
+
+/**
+ * Test that the fused one-hot CSV loader produces the same result as loading
+ * the mapped matrix and then one-hot encoding it.
+ */
+TEST_CASE("OneHotEncodingFusedLoadTest", "[OneHotEncodingTest]")
+{
+  fstream f;
+  f.open("test_fused.csv", fstream::out);
+  f << "1, 2, hello" << endl;
+  f << "3, 4, goodbye" << endl;
+  f << "5, 6, coffee" << endl;
+  f << "7, 8, confusion" << endl;
+  f << "9, 10, hello" << endl;
+  f << "11, 12, confusion" << endl;
+  f << "13, 14, confusion" << endl;
+  f.close();
+
+  // Load and encode in one pass; the mapped-integer matrix is never built.
+  arma::mat fusedOutput;
+  DatasetInfo fusedInfo;
+  LoadCSV loader("test_fused.csv");
+  loader.LoadOneHotCSV(fusedOutput, fusedInfo);
+
+  // Reference: load the mapped matrix, then encode it.
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test_fused.csv", matrix, info))
+    FAIL("Cannot load dataset test_fused.csv");
+  arma::mat output;
+  data::OneHotEncoding(matrix, output, info);
+
+  remove("test_fused.csv");
+
+  REQUIRE(fusedInfo.Type(2) == Datatype::categorical);
+  REQUIRE(fusedOutput.n_rows == output.n_rows);
+  REQUIRE(fusedOutput.n_cols == output.n_cols);
+  CheckMatrices(fusedOutput, output);
+}
@@ -14,6 +14,8 @@
 #include <mlpack/methods/pca/pca.hpp>
 #include <mlpack/methods/pca/decomposition_policies/exact_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
+#include <mlpack/methods/pca/decomposition_policies/blocked_randomized_svd_method.hpp>
+#include <mlpack/methods/pca/decomposition_policies/incremental_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_block_krylov_method.hpp>
 
@@ -204,6 +206,26 @@ TEST_CASE("ArmaComparisonRandomizedPCATest", "[PCATest]")
   ArmaComparisonPCA<RandomizedSVDPolicy>();
 }
 
+/**
+ * Compare the output of our blocked randomized-SVD PCA implementation with
+ * Armadillo's.
+ */
+TEST_CASE("ArmaComparisonBlockedRandomizedPCATest", "[PCATest]")
+{
+  ArmaComparisonPCA<BlockedRandomizedSVDPolicy>();
+}
+
+/**
+ * Compare the output of our incremental (streaming) PCA implementation with
+ * Armadillo's.  The data rank is covered by the maintained rank, so the
+ * sequential updates are exact here.
+ */
+TEST_CASE("ArmaComparisonIncrementalPCATest", "[PCATest]")
+{
+  IncrementalSVDPolicy decomposition(100);
+  ArmaComparisonPCA<IncrementalSVDPolicy>(false, decomposition);
+}
+
 /**
  * Test that dimensionality reduction with exact-svd PCA works the same way
  * MATLAB does (which should be correct!).
@@ -233,6 +255,26 @@ TEST_CASE("RandomizedPCADimensionalityReductionTest", "[PCATest]")
   PCADimensionalityReduction<RandomizedSVDPolicy>();
 }
 
+/**
+ * Test that dimensionality reduction with blocked randomized-svd PCA works
+ * the same way MATLAB does (which should be correct!).
+ */
+TEST_CASE("BlockedRandomizedPCADimensionalityReductionTest", "[PCATest]")
+{
+  PCADimensionalityReduction<BlockedRandomizedSVDPolicy>();
+}
+
+/**
+ * Test that dimensionality reduction with incremental (streaming) PCA works
+ * the same way MATLAB does (which should be correct!).
+ */
+TEST_CASE("IncrementalPCADimensionalityReductionTest", "[PCATest]")
+{
+  // Two-column batches, so the running SVD is updated multiple times.
+  IncrementalSVDPolicy decomposition(2);
+  PCADimensionalityReduction<IncrementalSVDPolicy>(false, decomposition);
+}
+
 /**
  * Test that dimensionality reduction with QUIC-SVD PCA works the same way
  * as the Exact-SVD PCA method.
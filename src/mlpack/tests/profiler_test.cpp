@@ -0,0 +1,72 @@
+/**
+ * @file tests/profiler_test.cpp
+ *
+ * Tests for the hierarchical self-profiler.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+// Enable the profiling macro in this translation unit regardless of the
+// build configuration.
+#define MLPACK_ENABLE_PROFILING
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/profiler.hpp>
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+/**
+ * Nested scopes must be attributed to their parents and aggregated across
+ * repeated entries.
+ */
+TEST_CASE("ProfilerNestedScopesTest", "[ProfilerTest]")
+{
+  Profiler::Clear();
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    MLPACK_PROFILE_SCOPE("outer");
+    for (size_t j = 0; j < 4; ++j)
+    {
+      MLPACK_PROFILE_SCOPE("inner");
+    }
+  }
+
+  const std::string report = Profiler::Report();
+  REQUIRE(report.find("outer") != std::string::npos);
+  REQUIRE(report.find("inner") != std::string::npos);
+  REQUIRE(report.find("3 calls") != std::string::npos);
+  REQUIRE(report.find("12 calls") != std::string::npos);
+  // "inner" is a child of "outer", so it carries a share of its parent.
+  REQUIRE(report.find("% of parent") != std::string::npos);
+
+  Profiler::Clear();
+  REQUIRE(Profiler::Report().empty());
+}
+
+/**
+ * The same scope name under different parents must be reported separately,
+ * and scopes on different threads must be merged by path.
+ */
+TEST_CASE("ProfilerThreadMergeTest", "[ProfilerTest]")
+{
+  Profiler::Clear();
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < 8; ++i)
+  {
+    MLPACK_PROFILE_SCOPE("work");
+    MLPACK_PROFILE_SCOPE("step");
+  }
+
+  const std::string report = Profiler::Report();
+  REQUIRE(report.find("work") != std::string::npos);
+  REQUIRE(report.find("8 calls") != std::string::npos);
+
+  Profiler::Clear();
+}
@@ -56,3 +56,44 @@ TEST_CASE("Radical_Test_Radical3D", "[RadicalTest]")
   // Larger tolerance is sometimes needed.
   REQUIRE(valBest == Approx(valEst).epsilon(0.02));
 }
+
+TEST_CASE("Radical_Test_Radical3DStochastic", "[RadicalTest]")
+{
+  mat matX;
+  if (!data::Load("data_3d_mixed.txt", matX))
+    FAIL("Cannot load dataset data_3d_mixed.txt");
+
+  // Estimate each rotation on minibatches of a quarter of the points.
+  Radical rad(0.175, 5, 100, matX.n_rows - 1, 0, 250);
+
+  mat matY;
+  mat matW;
+  rad.DoRadical(matX, matY, matW);
+
+  mat matYT = trans(matY);
+  double valEst = 0;
+
+  for (uword i = 0; i < matYT.n_cols; ++i)
+  {
+    vec y = vec(matYT.col(i));
+    valEst += rad.Vasicek(y);
+  }
+
+  mat matS;
+  if (!data::Load("data_3d_ind.txt", matS))
+    FAIL("Cannot load dataset data_3d_ind.txt");
+  rad.DoRadical(matS, matY, matW);
+
+  matYT = trans(matY);
+  double valBest = 0;
+
+  for (uword i = 0; i < matYT.n_cols; ++i)
+  {
+    vec y = vec(matYT.col(i));
+    valBest += rad.Vasicek(y);
+  }
+
+  // The stochastic estimates are noisier, so allow a larger tolerance than
+  // the exact test above.
+  REQUIRE(valBest == Approx(valEst).epsilon(0.05));
+}
@@ -12,6 +12,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/random_forest/random_forest.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
+#include <mlpack/methods/decision_tree/flat_tree.hpp>
 
 #include "serialization.hpp"
 #include "test_catch_tools.hpp"
@@ -94,6 +95,84 @@ TEST_CASE("BootstrapWeightsTest", "[RandomForestTest]")
   }
 }
 
+/**
+ * Make sure bootstrap sampling with explicit generators is reproducible for
+ * equal seeds and independent for different seeds.
+ */
+TEST_CASE("BootstrapSeededGeneratorTest", "[RandomForestTest]")
+{
+  arma::mat dataset(1, 1000);
+  dataset.row(0) = arma::linspace<arma::rowvec>(1000, 1999, 1000);
+  arma::Row<size_t> labels(1000);
+  labels.fill(1); // Don't care about the labels.
+  arma::rowvec weights; // Unused.
+
+  arma::mat bootstrapDataset1, bootstrapDataset2, bootstrapDataset3;
+  arma::Row<size_t> bootstrapLabels;
+  arma::rowvec bootstrapWeights;
+
+  std::mt19937 rng1(1234), rng2(1234), rng3(4321);
+  Bootstrap<false>(dataset, labels, weights, bootstrapDataset1,
+      bootstrapLabels, bootstrapWeights, rng1);
+  Bootstrap<false>(dataset, labels, weights, bootstrapDataset2,
+      bootstrapLabels, bootstrapWeights, rng2);
+  Bootstrap<false>(dataset, labels, weights, bootstrapDataset3,
+      bootstrapLabels, bootstrapWeights, rng3);
+
+  // Equal seeds must give exactly the same sample.
+  CheckMatrices(bootstrapDataset1, bootstrapDataset2);
+
+  // Different seeds should (with overwhelming probability) give a different
+  // sample.
+  bool identical = true;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (bootstrapDataset1[i] != bootstrapDataset3[i])
+    {
+      identical = false;
+      break;
+    }
+  }
+  REQUIRE(!identical);
+}
+
+/**
+ * A flattened forest must give the same predictions and probabilities as the
+ * forest it was compiled from.
+ */
+TEST_CASE("FlatForestMatchesForestTest", "[RandomForestTest]")
+{
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    labels[i] = (dataset(2, i) + dataset(4, i) > 1.0) ? 1 : 0;
+
+  RandomForest<> rf(dataset, labels, 2, 10 /* trees */, 5);
+  FlatForest<RandomForest<> > flat(rf);
+
+  REQUIRE(flat.NumTrees() == rf.NumTrees());
+
+  arma::mat testData(5, 300, arma::fill::randu);
+
+  arma::Row<size_t> forestPredictions, flatPredictions;
+  arma::mat forestProbabilities, flatProbabilities;
+  rf.Classify(testData, forestPredictions, forestProbabilities);
+  flat.Classify(testData, flatPredictions, flatProbabilities);
+
+  REQUIRE(flatPredictions.n_elem == forestPredictions.n_elem);
+  REQUIRE(flatProbabilities.n_rows == forestProbabilities.n_rows);
+  REQUIRE(flatProbabilities.n_cols == forestProbabilities.n_cols);
+  for (size_t i = 0; i < testData.n_cols; ++i)
+  {
+    REQUIRE(flatPredictions[i] == forestPredictions[i]);
+    for (size_t c = 0; c < forestProbabilities.n_rows; ++c)
+    {
+      REQUIRE(flatProbabilities(c, i) ==
+          Approx(forestProbabilities(c, i)).epsilon(1e-10));
+    }
+  }
+}
+
 /**
  * Make sure an empty forest cannot predict.
  */
@@ -609,3 +688,61 @@ TEST_CASE("ExtraTreesAccuracyTest", "[RandomForestTest]")
 
   REQUIRE(accuracy >= 0.91);
 }
+
+/**
+ * Test that WeightedBootstrap() produces multiplicity weights that sum to the
+ * number of points, and that point weights scale the multiplicities.
+ */
+TEST_CASE("WeightedBootstrapMultiplicityTest", "[RandomForestTest]")
+{
+  arma::mat dataset(5, 1000, arma::fill::randu);
+
+  arma::rowvec ignoredWeights;
+  arma::rowvec bootstrapWeights;
+  std::mt19937 rng(100);
+  WeightedBootstrap<false>(dataset, ignoredWeights, bootstrapWeights, rng);
+
+  REQUIRE(bootstrapWeights.n_elem == dataset.n_cols);
+  REQUIRE(arma::accu(bootstrapWeights) == Approx(1000.0));
+  for (size_t i = 0; i < bootstrapWeights.n_elem; ++i)
+    REQUIRE(bootstrapWeights[i] >= 0.0);
+
+  // When weights are used, the multiplicities are scaled by the point
+  // weights; with the same seed the drawn multiplicities are identical.
+  arma::rowvec pointWeights(1000);
+  pointWeights.fill(0.5);
+  arma::rowvec scaledWeights;
+  std::mt19937 rng2(100);
+  WeightedBootstrap<true>(dataset, pointWeights, scaledWeights, rng2);
+
+  for (size_t i = 0; i < scaledWeights.n_elem; ++i)
+    REQUIRE(scaledWeights[i] == Approx(0.5 * bootstrapWeights[i]).margin(1e-10));
+}
+
+/**
+ * Test that a random forest trained with weighted (non-materializing)
+ * bootstrap samples learns a simple separable problem.
+ */
+TEST_CASE("WeightedBootstrapRandomForestTest", "[RandomForestTest]")
+{
+  // Two well-separated classes in five dimensions.
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+    dataset.col(i) += 2.0;
+  labels.subvec(0, 499).fill(0);
+  labels.subvec(500, 999).fill(1);
+
+  WeightedBootstrapRandomForest<> rf(dataset, labels, 2, 20 /* trees */, 5);
+
+  arma::Row<size_t> predictions;
+  rf.Classify(dataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  // The classes are fully separable.
+  REQUIRE(correct > 950);
+}
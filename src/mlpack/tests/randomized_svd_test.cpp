@@ -12,6 +12,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/randomized_svd/randomized_svd.hpp>
+#include <mlpack/methods/randomized_svd/blocked_randomized_svd.hpp>
 
 #include "catch.hpp"
 
@@ -60,3 +61,74 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * The reconstruction and singular value error of the blocked randomized SVD
+ * should be small, also when the panels are narrower than the sketch.
+ */
+TEST_CASE("BlockedRandomizedSVDReconstructionError", "[RandomizedSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(3, 20);
+  arma::mat V = arma::randn<arma::mat>(10, 3);
+
+  arma::mat R;
+  arma::qr_econ(U, R, U);
+  arma::qr_econ(V, R, V);
+
+  arma::mat s = arma::diagmat(arma::vec("1 0.1 0.01"));
+
+  arma::mat data = arma::trans(U * arma::diagmat(s) * V.t());
+
+  // Center the data into a temporary matrix.
+  arma::mat centeredData;
+  math::Center(data, centeredData);
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2, s3;
+
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  // Use a panel block narrower than the sketch, so the blocked code path is
+  // exercised with more than one panel.
+  svd::BlockedRandomizedSVD bSVD(5, 10, 2);
+  bSVD.Apply(data, U2, s2, V2, 3);
+
+  // Use the same amount of data for the compariosn (matrix rank).
+  s3 = s1.subvec(0, s2.n_elem - 1);
+
+  // The sigular value error should be small.
+  double error = arma::norm(s2 - s3, "frob") / arma::norm(s2, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+
+  // The relative reconstruction error should be small.
+  error = arma::norm(centeredData - reconstruct, "frob") /
+      arma::norm(centeredData, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+}
+
+/**
+ * The blocked randomized SVD of a sparse matrix should match the singular
+ * values of the dense decomposition of the same (centered) data.
+ */
+TEST_CASE("BlockedRandomizedSVDSparseTest", "[RandomizedSVDTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(100, 1000, 0.3);
+
+  arma::mat centeredData;
+  math::Center(arma::mat(data), centeredData);
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  svd::BlockedRandomizedSVD bSVD(10, 10);
+  bSVD.Apply(data, U2, s2, V2, 10);
+
+  const double error = arma::norm(s1.subvec(0, s2.n_elem - 1) - s2, "frob") /
+      arma::norm(s2, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-3));
+}
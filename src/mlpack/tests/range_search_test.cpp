@@ -1718,3 +1718,195 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+/**
+ * Make sure the streaming Search() overload with a BlockRangeResultSink
+ * delivers exactly the same results as the vector-of-vectors interface, in
+ * every search mode.
+ */
+TEST_CASE("BlockRangeResultSinkTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 400);
+  arma::mat queryData;
+  queryData.randu(3, 150);
+  const Range range(0.2, 0.7);
+
+  // Compute the reference results with the vector-of-vectors interface.
+  RangeSearch<> exact(referenceData);
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  exact.Search(queryData, range, neighbors, distances);
+  vector<vector<pair<double, size_t>>> sortedExact;
+  SortResults(neighbors, distances, sortedExact);
+
+  size_t numExact = 0;
+  for (size_t i = 0; i < sortedExact.size(); ++i)
+    numExact += sortedExact[i].size();
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    const bool naive = (mode == 0);
+    const bool single = (mode == 1);
+    RangeSearch<> rs(referenceData, naive, single);
+
+    // Collect the streamed blocks back into per-query result lists.
+    vector<vector<pair<double, size_t>>> streamed(queryData.n_cols);
+    auto sink = MakeBlockRangeResultSink(64,
+        [&](const arma::uvec& queryIndices,
+            const arma::uvec& referenceIndices,
+            const arma::vec& blockDistances,
+            const size_t count)
+        {
+          for (size_t i = 0; i < count; ++i)
+          {
+            streamed[queryIndices[i]].push_back(
+                make_pair(blockDistances[i], referenceIndices[i]));
+          }
+        });
+
+    rs.Search(queryData, range, sink);
+
+    REQUIRE(sink.NumResults() == numExact);
+    REQUIRE(sink.NumFlushes() >= (numExact / 64));
+
+    for (size_t i = 0; i < streamed.size(); ++i)
+    {
+      sort(streamed[i].begin(), streamed[i].end());
+      REQUIRE(streamed[i].size() == sortedExact[i].size());
+      for (size_t j = 0; j < streamed[i].size(); ++j)
+      {
+        REQUIRE(streamed[i][j].second == sortedExact[i][j].second);
+        REQUIRE(streamed[i][j].first ==
+            Approx(sortedExact[i][j].first).epsilon(1e-7));
+      }
+    }
+  }
+}
+
+/**
+ * Make sure the monochromatic streaming Search() overload with a
+ * CSRRangeResultSink produces the same results as the vector-of-vectors
+ * interface, laid out as offsets plus flat arrays.
+ */
+TEST_CASE("CSRRangeResultSinkTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 500);
+  const Range range(0.1, 0.6);
+
+  // Compute the reference results with the vector-of-vectors interface.
+  RangeSearch<> exact(referenceData);
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  exact.Search(range, neighbors, distances);
+  vector<vector<pair<double, size_t>>> sortedExact;
+  SortResults(neighbors, distances, sortedExact);
+
+  RangeSearch<> rs(referenceData);
+  CSRRangeResultSink sink(referenceData.n_cols);
+  rs.Search(range, sink);
+
+  REQUIRE(sink.Offsets().n_elem == referenceData.n_cols + 1);
+  REQUIRE(sink.Offsets()[referenceData.n_cols] == sink.NumResults());
+  REQUIRE(sink.Neighbors().n_elem == sink.NumResults());
+  REQUIRE(sink.Distances().n_elem == sink.NumResults());
+
+  for (size_t i = 0; i < referenceData.n_cols; ++i)
+  {
+    const size_t begin = sink.Offsets()[i];
+    const size_t end = sink.Offsets()[i + 1];
+    REQUIRE(end - begin == sortedExact[i].size());
+
+    // Results within a query's slice arrive in no particular order.
+    vector<pair<double, size_t>> slice;
+    for (size_t j = begin; j < end; ++j)
+      slice.push_back(make_pair(sink.Distances()[j], sink.Neighbors()[j]));
+    sort(slice.begin(), slice.end());
+
+    for (size_t j = 0; j < slice.size(); ++j)
+    {
+      REQUIRE(slice[j].second == sortedExact[i][j].second);
+      REQUIRE(slice[j].first ==
+          Approx(sortedExact[i][j].first).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Demonstrate spilling streamed blocks to disk: write each block to a binary
+ * file from the flush callback, then read the file back and check that it
+ * holds exactly the expected results.
+ */
+TEST_CASE("BlockRangeResultSinkDiskSpillTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 300);
+  arma::mat queryData;
+  queryData.randu(3, 100);
+  const Range range(0.0, 0.5);
+
+  // Compute the reference results with the vector-of-vectors interface.
+  RangeSearch<> exact(referenceData);
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  exact.Search(queryData, range, neighbors, distances);
+  vector<vector<pair<double, size_t>>> sortedExact;
+  SortResults(neighbors, distances, sortedExact);
+
+  // Spill each block to disk as raw (query, reference, distance) triples.
+  const string filename = "range_search_spill_test.bin";
+  {
+    ofstream spill(filename, ios::binary);
+    REQUIRE(spill.is_open());
+
+    RangeSearch<> rs(referenceData);
+    auto sink = MakeBlockRangeResultSink(32,
+        [&](const arma::uvec& queryIndices,
+            const arma::uvec& referenceIndices,
+            const arma::vec& blockDistances,
+            const size_t count)
+        {
+          for (size_t i = 0; i < count; ++i)
+          {
+            const uint64_t query = queryIndices[i];
+            const uint64_t reference = referenceIndices[i];
+            const double distance = blockDistances[i];
+            spill.write((const char*) &query, sizeof(query));
+            spill.write((const char*) &reference, sizeof(reference));
+            spill.write((const char*) &distance, sizeof(distance));
+          }
+        });
+
+    rs.Search(queryData, range, sink);
+  }
+
+  // Read the spilled results back and compare against the exact results.
+  vector<vector<pair<double, size_t>>> spilled(queryData.n_cols);
+  {
+    ifstream spill(filename, ios::binary);
+    REQUIRE(spill.is_open());
+
+    uint64_t query, reference;
+    double distance;
+    while (spill.read((char*) &query, sizeof(query)))
+    {
+      REQUIRE((bool) spill.read((char*) &reference, sizeof(reference)));
+      REQUIRE((bool) spill.read((char*) &distance, sizeof(distance)));
+      spilled[query].push_back(make_pair(distance, (size_t) reference));
+    }
+  }
+  remove(filename.c_str());
+
+  for (size_t i = 0; i < spilled.size(); ++i)
+  {
+    sort(spilled[i].begin(), spilled[i].end());
+    REQUIRE(spilled[i].size() == sortedExact[i].size());
+    for (size_t j = 0; j < spilled[i].size(); ++j)
+    {
+      REQUIRE(spilled[i][j].second == sortedExact[i][j].second);
+      REQUIRE(spilled[i][j].first ==
+          Approx(sortedExact[i][j].first).epsilon(1e-7));
+    }
+  }
+}
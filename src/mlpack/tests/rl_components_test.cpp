@@ -20,7 +20,9 @@
 #include <mlpack/methods/reinforcement_learning/environment/continuous_double_pole_cart.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/acrobot.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/pendulum.hpp>
+#include <mlpack/methods/reinforcement_learning/environment/vectorized_environment.hpp>
 #include <mlpack/methods/reinforcement_learning/replay/random_replay.hpp>
+#include <mlpack/methods/reinforcement_learning/replay/concurrent_random_replay.hpp>
 #include <mlpack/methods/reinforcement_learning/policy/greedy_policy.hpp>
 
 #include "catch.hpp"
@@ -271,6 +273,105 @@ TEST_CASE("RandomReplayTest", "[RLComponentsTest]")
   }
 }
 
+/**
+ * Construct a vectorized environment and check that stepping all copies in
+ * lockstep works, including the automatic reset of terminated copies.
+ */
+TEST_CASE("VectorizedEnvironmentTest", "[RLComponentsTest]")
+{
+  CartPole task(5 /* maxSteps */);
+  VectorizedEnvironment<CartPole> envs(4, task);
+
+  REQUIRE(envs.NumEnvs() == 4);
+  REQUIRE(envs.Observations().n_rows == CartPole::State::dimension);
+  REQUIRE(envs.Observations().n_cols == 4);
+
+  std::vector<CartPole::Action> actions(4);
+  for (size_t i = 0; i < 4; ++i)
+    actions[i].action = CartPole::Action::actions::forward;
+
+  arma::rowvec rewards;
+  arma::irowvec terminals;
+
+  // The step limit is not reached yet, so no copy terminates.
+  for (size_t step = 0; step < 4; ++step)
+  {
+    envs.Step(actions, rewards, terminals);
+    REQUIRE(rewards.n_elem == 4);
+    REQUIRE(arma::all(rewards == 1.0));
+    REQUIRE(arma::accu(terminals) == 0);
+  }
+
+  // The fifth step hits the step limit of every copy; all of them terminate
+  // and are reset, so the observations hold fresh initial states and further
+  // steps keep working.
+  envs.Step(actions, rewards, terminals);
+  REQUIRE(arma::accu(terminals) == 4);
+  REQUIRE(arma::abs(envs.Observations()).max() <= 0.05 + 1e-12);
+
+  envs.Step(actions, rewards, terminals);
+  REQUIRE(arma::accu(terminals) == 0);
+}
+
+/**
+ * Construct a concurrent random replay instance and check that it behaves
+ * like the single-threaded buffer, also when many threads store at once.
+ */
+TEST_CASE("ConcurrentRandomReplayTest", "[RLComponentsTest]")
+{
+  ConcurrentRandomReplay<MountainCar> replay(1, 3);
+  MountainCar env;
+  MountainCar::State state = env.InitialSample();
+  MountainCar::Action action;
+  action.action = MountainCar::Action::actions::forward;
+  MountainCar::State nextState;
+  double reward = env.Sample(state, action, nextState);
+  replay.Store(state, action, reward, nextState, env.IsTerminal(nextState),
+      0.9);
+  arma::mat sampledState;
+  std::vector<MountainCar::Action> sampledAction;
+  arma::rowvec sampledReward;
+  arma::mat sampledNextState;
+  arma::irowvec sampledTerminal;
+
+  //! So far there should be only one record in the memory
+  replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+      sampledTerminal);
+
+  CheckMatrices(state.Encode(), sampledState);
+  REQUIRE(sampledAction.size() == 1);
+  REQUIRE(action.action == sampledAction[0].action);
+  REQUIRE(reward == Approx(arma::as_scalar(sampledReward)).epsilon(1e-7));
+  CheckMatrices(nextState.Encode(), sampledNextState);
+  REQUIRE(false == arma::as_scalar(sampledTerminal));
+  REQUIRE(1 == replay.Size());
+
+  //! Store the same record from many threads at once; every sampled
+  //! transition must still be one of the stored ones, i.e. consistent.
+  ConcurrentRandomReplay<MountainCar> sharedReplay(10, 50);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < 200; ++i)
+  {
+    sharedReplay.Store(state, action, reward, nextState,
+        env.IsTerminal(nextState), 0.9);
+  }
+
+  REQUIRE(50 == sharedReplay.Size());
+
+  sampledAction.clear();
+  sharedReplay.Sample(sampledState, sampledAction, sampledReward,
+      sampledNextState, sampledTerminal);
+
+  REQUIRE(sampledAction.size() == 10);
+  for (size_t t = 0; t < 10; ++t)
+  {
+    CheckMatrices(state.Encode(), arma::mat(sampledState.col(t)));
+    CheckMatrices(nextState.Encode(), arma::mat(sampledNextState.col(t)));
+    REQUIRE(action.action == sampledAction[t].action);
+    REQUIRE(reward == Approx(sampledReward(t)).epsilon(1e-7));
+  }
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
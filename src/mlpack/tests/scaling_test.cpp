@@ -172,3 +172,84 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Test that the single-pass statistics of StandardScaler and MinMaxScaler
+ * match the full-matrix Armadillo computations.
+ */
+TEST_CASE("SinglePassFitTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randn(5, 100);
+
+  data::StandardScaler standard;
+  standard.Fit(input);
+  CheckMatrices(standard.ItemMean(), arma::vec(arma::mean(input, 1)), 1e-10);
+  CheckMatrices(standard.ItemStdDev(),
+      arma::vec(arma::stddev(input, 1, 1)), 1e-10);
+
+  data::MinMaxScaler minmax;
+  minmax.Fit(input);
+  CheckMatrices(minmax.ItemMin(), arma::vec(arma::min(input, 1)), 1e-10);
+  CheckMatrices(minmax.ItemMax(), arma::vec(arma::max(input, 1)), 1e-10);
+}
+
+/**
+ * Test the in-place Transform() and InverseTransform() overloads.
+ */
+TEST_CASE("InPlaceTransformTest", "[ScalingTest]")
+{
+  data::StandardScaler standard;
+  standard.Fit(dataset);
+  standard.Transform(dataset, scaleddataset);
+
+  temp = dataset;
+  standard.Transform(temp);
+  CheckMatrices(temp, scaleddataset);
+  standard.InverseTransform(temp);
+  CheckMatrices(temp, dataset);
+
+  data::MinMaxScaler minmax;
+  minmax.Fit(dataset);
+  minmax.Transform(dataset, scaleddataset);
+
+  temp = dataset;
+  minmax.Transform(temp);
+  CheckMatrices(temp, scaleddataset);
+  minmax.InverseTransform(temp);
+  CheckMatrices(temp, dataset);
+}
+
+/**
+ * Test that the fused load-scale path produces the same matrix as loading
+ * and then calling Transform().
+ */
+TEST_CASE("FusedLoadScaleTest", "[ScalingTest]")
+{
+  fstream f;
+  f.open("fused_scale.csv", fstream::out);
+  f << "1, 2" << endl;
+  f << "3, 6" << endl;
+  f << "5, 10" << endl;
+  f.close();
+
+  // CSV lines are points, so the fitted dataset is the transpose.
+  arma::mat raw = "1 2;"
+                  "3 6;"
+                  "5 10;";
+  arma::mat points = raw.t();
+
+  data::StandardScaler scale;
+  scale.Fit(points);
+  arma::mat expectedPoints;
+  scale.Transform(points, expectedPoints);
+
+  // Load and scale in one pass; the loader works in line-major layout.
+  LoadCSV loader;
+  fstream in("fused_scale.csv", fstream::in);
+  arma::mat loaded;
+  REQUIRE(loader.LoadNumericCSV(loaded, in, scale));
+  in.close();
+  remove("fused_scale.csv");
+
+  CheckMatrices(loaded, arma::mat(expectedPoints.t()));
+}
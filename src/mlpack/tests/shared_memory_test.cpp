@@ -0,0 +1,87 @@
+/**
+ * @file tests/shared_memory_test.cpp
+ *
+ * Tests for the shared-memory model handoff.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/shared_memory.hpp>
+#include <mlpack/core/dists/gaussian_distribution.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+/**
+ * Opening a segment that does not exist must throw, on every platform.
+ */
+TEST_CASE("SharedMemoryMissingSegmentTest", "[SharedMemoryTest]")
+{
+  REQUIRE_THROWS_AS(SharedMemoryView("mlpack-test-shm-does-not-exist"),
+      std::runtime_error);
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+
+/**
+ * A written payload must come back byte-for-byte through a zero-copy view,
+ * and removal must make the segment disappear.
+ */
+TEST_CASE("SharedMemoryRoundTripTest", "[SharedMemoryTest]")
+{
+  const std::string segment = "mlpack-test-shm-roundtrip";
+  const std::string payload = "sixteen bytes of arbitrary model payload";
+
+  WriteSharedMemory(segment, payload);
+  {
+    SharedMemoryView view(segment);
+    REQUIRE(view.Size() == payload.size());
+    REQUIRE(std::string(view.Data(), view.Size()) == payload);
+  }
+
+  // Rewriting must replace the old contents and size exactly.
+  WriteSharedMemory(segment, "short");
+  {
+    SharedMemoryView view(segment);
+    REQUIRE(view.Size() == 5);
+    REQUIRE(std::string(view.Data(), view.Size()) == "short");
+  }
+
+  REQUIRE(RemoveSharedMemory(segment) == true);
+  REQUIRE_THROWS_AS(SharedMemoryView(segment), std::runtime_error);
+  REQUIRE(RemoveSharedMemory(segment) == false);
+}
+
+/**
+ * A model offered to shared memory must be adopted identically by a fresh
+ * object, as it would be by a separate process mapping the same segment.
+ */
+TEST_CASE("SharedMemoryModelHandoffTest", "[SharedMemoryTest]")
+{
+  const std::string segment = "mlpack-test-shm-model";
+
+  arma::vec mean("2.5 -1.0 0.5");
+  arma::mat covariance = arma::eye<arma::mat>(3, 3) * 1.7;
+  distribution::GaussianDistribution model(mean, covariance);
+
+  OfferToSharedMemory(model, segment, "model");
+
+  distribution::GaussianDistribution adopted;
+  AdoptFromSharedMemory(adopted, segment, "model");
+
+  CheckMatrices(model.Mean(), adopted.Mean());
+  CheckMatrices(model.Covariance(), adopted.Covariance());
+
+  // Adopting with an empty payload segment must fail cleanly.
+  RemoveSharedMemory(segment);
+  REQUIRE_THROWS_AS(AdoptFromSharedMemory(adopted, segment, "model"),
+      std::runtime_error);
+}
+
+#endif
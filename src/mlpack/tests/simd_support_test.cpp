@@ -0,0 +1,59 @@
+/**
+ * @file tests/simd_support_test.cpp
+ *
+ * Tests for the runtime SIMD capability probe and the function
+ * multiversioning macro.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/simd_support.hpp>
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+namespace {
+
+// A multiversioned function: the resolver must pick a working body on every
+// machine, including ones where the macro expands to nothing.
+MLPACK_TARGET_CLONES
+double SumOfSquares(const arma::vec& v)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < v.n_elem; ++i)
+    sum += v[i] * v[i];
+  return sum;
+}
+
+} // namespace
+
+/**
+ * The probe must return a valid level, and the same one on every call.
+ */
+TEST_CASE("SimdLevelProbeTest", "[SimdSupportTest]")
+{
+  const SimdLevel level = HighestSimdLevel();
+  REQUIRE(level >= SIMD_BASELINE);
+  REQUIRE(level <= SIMD_AVX512);
+  REQUIRE(HighestSimdLevel() == level);
+
+  // Every level has a printable name.
+  REQUIRE(SimdLevelName(SIMD_BASELINE) == "baseline");
+  REQUIRE(SimdLevelName(SIMD_AVX) == "AVX");
+  REQUIRE(SimdLevelName(SIMD_AVX2) == "AVX2");
+  REQUIRE(SimdLevelName(SIMD_AVX512) == "AVX-512");
+}
+
+/**
+ * A function marked with MLPACK_TARGET_CLONES must resolve and compute
+ * correctly.
+ */
+TEST_CASE("TargetClonesResolutionTest", "[SimdSupportTest]")
+{
+  arma::vec v = arma::linspace<arma::vec>(1, 100, 100);
+  REQUIRE(SumOfSquares(v) == Approx(338350.0).epsilon(1e-10));
+}
@@ -674,3 +674,91 @@ TEST_CASE("SoftmaxRegressionComputeProbabilitiesAndLabelsTest",
     REQUIRE(testLabels(i) == labels(i));
   }
 }
+
+TEST_CASE("SoftmaxRegressionLabelOnlyFastPathTest", "[SoftmaxRegressionTest]")
+{
+  // The label-only Classify() overload skips the probability computation, so
+  // make sure it agrees exactly with the argmax of the probabilities, with
+  // and without an intercept.
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    const bool fitIntercept = (trial == 1);
+
+    arma::mat data = arma::randu<arma::mat>(4, 1500);
+    arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(1500,
+        arma::distr_param(0, 5));
+
+    SoftmaxRegression sr(data, labels, 6, 0.01, fitIntercept);
+
+    arma::mat probabilities;
+    sr.Classify(data, probabilities);
+
+    arma::Row<size_t> fastLabels;
+    sr.Classify(data, fastLabels);
+
+    REQUIRE(fastLabels.n_elem == data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      arma::uword maxIndex = 0;
+      probabilities.col(i).max(maxIndex);
+      REQUIRE(fastLabels(i) == (size_t) maxIndex);
+    }
+  }
+}
+
+TEST_CASE("SoftmaxRegressionTopKTest", "[SoftmaxRegressionTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 1000);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(1000,
+      arma::distr_param(0, 5));
+
+  SoftmaxRegression sr(data, labels, 6, 0.01);
+
+  arma::mat probabilities;
+  sr.Classify(data, probabilities);
+
+  // With k equal to the number of classes the scores are the full softmax.
+  arma::Mat<size_t> topLabels;
+  arma::mat topScores;
+  sr.Classify(data, 6, topLabels, topScores);
+
+  REQUIRE(topLabels.n_rows == 6);
+  REQUIRE(topLabels.n_cols == data.n_cols);
+  REQUIRE(topScores.n_rows == 6);
+  REQUIRE(topScores.n_cols == data.n_cols);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(arma::sum(topScores.col(i)) == Approx(1.0).epsilon(1e-7));
+    for (size_t j = 0; j < 6; ++j)
+    {
+      // Scores must be in decreasing order and match the probability of the
+      // reported class.
+      if (j > 0)
+        REQUIRE(topScores(j, i) <= topScores(j - 1, i));
+      REQUIRE(topScores(j, i) ==
+          Approx(probabilities(topLabels(j, i), i)).epsilon(1e-7));
+    }
+  }
+
+  // A smaller k must report the head of the same ranking.
+  arma::Mat<size_t> top3Labels;
+  arma::mat top3Scores;
+  sr.Classify(data, 3, top3Labels, top3Scores);
+
+  REQUIRE(top3Labels.n_rows == 3);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(top3Labels(j, i) == topLabels(j, i));
+      REQUIRE(top3Scores(j, i) == Approx(topScores(j, i)).epsilon(1e-7));
+    }
+  }
+
+  // Invalid k values must be rejected.
+  REQUIRE_THROWS_AS(sr.Classify(data, 0, topLabels, topScores),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(sr.Classify(data, 7, topLabels, topScores),
+      std::invalid_argument);
+}
@@ -274,3 +274,98 @@ TEST_CASE("SparseAutoencoderFunctionGradient", "[SparseAutoencoderTest]")
     }
   }
 }
+
+TEST_CASE("SparseAutoencoderFunctionSeparableEvaluate",
+          "[SparseAutoencoderTest]")
+{
+  const size_t points = 1000;
+  const size_t vSize = 20;
+  const size_t hSize = 10;
+  const size_t l2 = vSize;
+  const size_t l3 = 2 * hSize;
+
+  // Initialize a random dataset.
+  arma::mat data;
+  data.randu(vSize, points);
+
+  // The KL divergence term is left out, since the minibatch overload computes
+  // it from the running activation estimate rather than the minibatch itself;
+  // the reconstruction and regularization terms of the minibatches of one
+  // epoch must sum exactly to the full-batch objective.
+  SparseAutoencoderFunction saf(data, vSize, hSize, 20, 0);
+
+  // Create a random set of parameters.
+  arma::mat parameters;
+  parameters.randu(l3 + 1, l2 + 1);
+
+  const size_t batchSize = 128;
+  double batchSum = 0.0;
+  for (size_t begin = 0; begin < points; begin += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize, points - begin);
+    batchSum += saf.Evaluate(parameters, begin, effectiveBatchSize);
+  }
+
+  REQUIRE(batchSum == Approx(saf.Evaluate(parameters)).epsilon(1e-10));
+}
+
+TEST_CASE("SparseAutoencoderFunctionSeparableGradient",
+          "[SparseAutoencoderTest]")
+{
+  const size_t points = 500;
+  const size_t vSize = 20;
+  const size_t hSize = 10;
+  const size_t l2 = vSize;
+  const size_t l3 = 2 * hSize;
+
+  // Initialize a random dataset.
+  arma::mat data;
+  data.randu(vSize, points);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize, 20, 20);
+
+  // Create a random set of parameters.
+  arma::mat parameters;
+  parameters.randu(l3 + 1, l2 + 1);
+
+  // A minibatch covering the whole dataset initializes the running activation
+  // estimate to the exact full-data mean activations, so its gradient must
+  // match the full-batch gradient exactly.
+  arma::mat batchGradient, fullGradient;
+  saf.Gradient(parameters, 0, points, batchGradient);
+  saf.Gradient(parameters, fullGradient);
+
+  CheckMatrices(batchGradient, fullGradient);
+
+  // A second pass with the same parameters leaves the estimate unchanged.
+  saf.Gradient(parameters, 0, points, batchGradient);
+  CheckMatrices(batchGradient, fullGradient);
+}
+
+TEST_CASE("SparseAutoencoderSGDTrainingTest", "[SparseAutoencoderTest]")
+{
+  const size_t points = 200;
+  const size_t vSize = 10;
+  const size_t hSize = 5;
+
+  // Initialize a dataset with correlated dimensions, so that there is
+  // structure for the autoencoder to learn.
+  arma::mat data(vSize, points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    const double base = math::Random();
+    for (size_t j = 0; j < vSize; ++j)
+      data(j, i) = base + 0.05 * math::Random();
+  }
+
+  SparseAutoencoderFunction saf(data, vSize, hSize);
+  arma::mat parameters = saf.GetInitialPoint();
+  const double initialObjective = saf.Evaluate(parameters);
+
+  // Train with minibatch SGD; this exercises the separable API, including
+  // Shuffle() and the running activation estimate.
+  ens::StandardSGD sgd(0.2, 20, 50 * points, 1e-10);
+  sgd.Optimize(saf, parameters);
+
+  REQUIRE(saf.Evaluate(parameters) < initialObjective);
+}
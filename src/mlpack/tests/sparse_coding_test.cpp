@@ -137,6 +137,46 @@ TEST_CASE("SparseCodingTestDictionaryStep", "[SparseCodingTest]")
   REQUIRE(normGradient == Approx(0.0).margin(tol));
 }
 
+TEST_CASE("SparseCodingMinibatchTrainingTest", "[SparseCodingTest]")
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  // Train with minibatch dictionary updates of a quarter of the points.
+  SparseCoding sc(nAtoms, lambda1, 0.0, 10, 0.01, 1e-6, nPoints / 4);
+  const double objVal = sc.Train(X);
+
+  // The minibatch-trained dictionary should encode the full dataset better
+  // than the initial dictionary does.
+  SparseCoding scInit(nAtoms, lambda1);
+  DataDependentRandomInitializer::Initialize(X, nAtoms, scInit.Dictionary());
+  mat initCodes;
+  scInit.Encode(X, initCodes);
+  const double initObjVal = scInit.Objective(X, initCodes);
+
+  REQUIRE(objVal < initObjVal);
+
+  // Each code must still satisfy the LASSO optimality conditions for the
+  // trained dictionary.
+  mat Z;
+  sc.Encode(X, Z);
+  mat D = sc.Dictionary();
+
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    vec errCorr = trans(D) * (D * Z.unsafe_col(i) - X.unsafe_col(i));
+    SCVerifyCorrectness(Z.unsafe_col(i), errCorr, lambda1);
+  }
+}
+
 TEST_CASE("SerializationTest", "[SparseCodingTest]")
 {
   mat X = randu<mat>(100, 100);
@@ -434,3 +434,82 @@ TEST_CASE("SplitLabeledDataResultField", "[SplitDataTest]")
   CheckFields(input, inputConcat);
   CheckFields(label, labelConcat);
 }
+
+/**
+ * Check that SplitInPlace() returns aliases over the input memory and
+ * preserves all points under shuffling.
+ */
+TEST_CASE("SplitInPlaceTest", "[SplitDataTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 20);
+  const arma::mat original = data;
+
+  arma::mat trainData, testData;
+  SplitInPlace(data, trainData, testData, 0.25);
+
+  REQUIRE(trainData.n_cols == 15);
+  REQUIRE(testData.n_cols == 5);
+
+  // Both outputs must alias the input's memory, not copies.
+  REQUIRE(trainData.memptr() == data.memptr());
+  REQUIRE(testData.memptr() == data.memptr() + 15 * data.n_rows);
+
+  // Every original column must appear exactly once in the shuffled input.
+  for (size_t i = 0; i < original.n_cols; ++i)
+  {
+    size_t found = 0;
+    for (size_t j = 0; j < data.n_cols; ++j)
+      if (arma::approx_equal(data.col(j), original.col(i), "absdiff", 1e-15))
+        ++found;
+    REQUIRE(found == 1);
+  }
+}
+
+/**
+ * Check that the ordered SplitInPlace() fast path moves no data at all.
+ */
+TEST_CASE("SplitInPlaceOrderedTest", "[SplitDataTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 10);
+  const arma::mat original = data;
+
+  arma::mat trainData, testData;
+  SplitInPlace(data, trainData, testData, 0.2, false);
+
+  // The input must be untouched, and the aliases must match its halves.
+  CheckMatrices(data, original);
+  CheckMatrices(trainData, arma::mat(original.cols(0, 7)));
+  CheckMatrices(testData, arma::mat(original.cols(8, 9)));
+  REQUIRE(trainData.memptr() == data.memptr());
+}
+
+/**
+ * Check that the labeled SplitInPlace() permutes labels in lockstep with the
+ * data.
+ */
+TEST_CASE("SplitInPlaceLabeledTest", "[SplitDataTest]")
+{
+  arma::mat data(1, 12);
+  arma::Row<size_t> labels(12);
+  for (size_t i = 0; i < 12; ++i)
+  {
+    data(0, i) = (double) i;
+    labels[i] = i;
+  }
+
+  arma::mat trainData, testData;
+  arma::Row<size_t> trainLabels, testLabels;
+  SplitInPlace(data, labels, trainData, testData, trainLabels, testLabels,
+      0.25);
+
+  REQUIRE(trainData.n_cols == 9);
+  REQUIRE(testLabels.n_elem == 3);
+
+  // Labels must still match their points after the in-place shuffle.
+  for (size_t i = 0; i < 12; ++i)
+    REQUIRE((size_t) data(0, i) == labels[i]);
+  for (size_t i = 0; i < 9; ++i)
+    REQUIRE((size_t) trainData(0, i) == trainLabels[i]);
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE((size_t) testData(0, i) == testLabels[i]);
+}
@@ -12,6 +12,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/amf/amf.hpp>
 #include <mlpack/methods/amf/update_rules/svd_batch_learning.hpp>
+#include <mlpack/methods/amf/update_rules/svd_hogwild_learning.hpp>
 #include <mlpack/methods/amf/init_rules/random_init.hpp>
 #include <mlpack/methods/amf/init_rules/average_init.hpp>
 #include <mlpack/methods/amf/termination_policies/validation_rmse_termination.hpp>
@@ -41,6 +42,23 @@ TEST_CASE("SVDBatchConvergenceElementTest", "[SVDBatchTest]")
           amf.TerminationPolicy().MaxIterations());
 }
 
+/**
+ * Make sure the Hogwild SGD learning is converging.
+ */
+TEST_CASE("SVDHogwildConvergenceElementTest", "[SVDBatchTest]")
+{
+  sp_mat data;
+  data.sprandn(100, 100, 0.2);
+  AMF<SimpleToleranceTermination<sp_mat>,
+      AverageInitialization,
+      SVDHogwildLearning> amf;
+  mat m1, m2;
+  amf.Apply(data, 2, m1, m2);
+
+  REQUIRE(amf.TerminationPolicy().Iteration() !=
+          amf.TerminationPolicy().MaxIterations());
+}
+
 //! This is used to ensure we start from the same initial point.
 class SpecificRandomInitialization
 {
@@ -0,0 +1,185 @@
+/**
+ * @file tests/thread_pool_test.cpp
+ *
+ * Tests for the process-wide thread pool and task groups.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/thread_pool.hpp>
+
+#include <atomic>
+
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+/**
+ * Every task submitted to a group must run exactly once before Wait()
+ * returns.
+ */
+TEST_CASE("TaskGroupRunsAllTasksTest", "[ThreadPoolTest]")
+{
+  std::atomic<size_t> counter(0);
+
+  TaskGroup group;
+  for (size_t i = 0; i < 1000; ++i)
+    group.Run([&counter]() { ++counter; });
+  group.Wait();
+
+  REQUIRE(counter.load() == 1000);
+}
+
+/**
+ * Tasks submitted from inside a pool task must run inline on the same
+ * worker, so nested parallel sections never grow the thread count.
+ */
+TEST_CASE("TaskGroupNestedTasksRunInlineTest", "[ThreadPoolTest]")
+{
+  // Skip the check if the pool runs everything inline anyway.
+  if (ThreadPool::Get().NumThreads() == 0)
+    return;
+
+  // Catch assertions are not thread-safe, so the tasks only count
+  // violations and the checks happen after Wait().
+  std::atomic<size_t> inner(0);
+  std::atomic<size_t> notInWorker(0);
+  std::atomic<size_t> nestedQueued(0);
+
+  TaskGroup outerGroup;
+  for (size_t i = 0; i < 8; ++i)
+  {
+    outerGroup.Run([&inner, &notInWorker, &nestedQueued]()
+    {
+      if (!ThreadPool::InWorker())
+        ++notInWorker;
+
+      const std::thread::id outerThread = std::this_thread::get_id();
+      TaskGroup innerGroup;
+      for (size_t j = 0; j < 8; ++j)
+      {
+        innerGroup.Run([&inner, &nestedQueued, outerThread]()
+        {
+          ++inner;
+          // Inline execution means we never left the outer task's thread.
+          if (std::this_thread::get_id() != outerThread)
+            ++nestedQueued;
+        });
+      }
+      innerGroup.Wait();
+    });
+  }
+  outerGroup.Wait();
+
+  REQUIRE(inner.load() == 64);
+  REQUIRE(notInWorker.load() == 0);
+  REQUIRE(nestedQueued.load() == 0);
+}
+
+/**
+ * ParallelFor() must visit every index of the range exactly once, for ranges
+ * smaller and larger than the number of workers.
+ */
+TEST_CASE("ParallelForCoverageTest", "[ThreadPoolTest]")
+{
+  for (size_t n = 0; n < 70; n += 7)
+  {
+    // Each index is visited by exactly one task, and distinct elements are
+    // distinct memory locations, so plain writes are race-free here.
+    std::vector<size_t> visits(n, 0);
+
+    ParallelFor(0, n, [&visits](const size_t i) { ++visits[i]; });
+
+    for (size_t i = 0; i < n; ++i)
+      REQUIRE(visits[i] == 1);
+  }
+}
+
+/**
+ * An exception thrown by a task must be rethrown by Wait() in the waiting
+ * thread, and must not take down the pool: later submissions still work.
+ */
+TEST_CASE("TaskGroupExceptionPropagationTest", "[ThreadPoolTest]")
+{
+  TaskGroup group;
+  group.Run([]() { throw std::runtime_error("task failed"); });
+  REQUIRE_THROWS_AS(group.Wait(), std::runtime_error);
+
+  std::atomic<size_t> counter(0);
+  TaskGroup laterGroup;
+  for (size_t i = 0; i < 100; ++i)
+    laterGroup.Run([&counter]() { ++counter; });
+  laterGroup.Wait();
+  REQUIRE(counter.load() == 100);
+}
+
+/**
+ * With the pool resized to zero workers every task must run inline in the
+ * submitting thread, and resizing back up must restore queued execution.
+ */
+TEST_CASE("ThreadPoolResizeTest", "[ThreadPoolTest]")
+{
+  const size_t oldNumThreads = ThreadPool::Get().NumThreads();
+
+  ThreadPool::Get().Resize(0);
+  REQUIRE(ThreadPool::Get().NumThreads() == 0);
+
+  const std::thread::id mainThread = std::this_thread::get_id();
+  size_t inlineRuns = 0;
+  TaskGroup group;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    // With no workers the task runs before Run() returns, so unsynchronized
+    // access to inlineRuns is fine.
+    group.Run([&inlineRuns, mainThread]()
+    {
+      if (std::this_thread::get_id() == mainThread)
+        ++inlineRuns;
+    });
+  }
+  group.Wait();
+  REQUIRE(inlineRuns == 10);
+
+  ThreadPool::Get().Resize(2);
+  REQUIRE(ThreadPool::Get().NumThreads() == 2);
+
+  std::atomic<size_t> counter(0);
+  TaskGroup pooledGroup;
+  for (size_t i = 0; i < 100; ++i)
+    pooledGroup.Run([&counter]() { ++counter; });
+  pooledGroup.Wait();
+  REQUIRE(counter.load() == 100);
+
+  // Restore the default configuration for the other tests.
+  ThreadPool::Get().Resize(oldNumThreads);
+}
+
+/**
+ * Every pool worker must have a registered random stream, so tasks that draw
+ * random numbers (e.g. random dimension selection during forest training) use
+ * independent per-worker generators instead of racing on the global one.
+ */
+TEST_CASE("PoolWorkerRandomStreamTest", "[ThreadPoolTest]")
+{
+  std::atomic<size_t> unregisteredWorkerTasks(0);
+
+  TaskGroup group;
+  for (size_t i = 0; i < 500; ++i)
+  {
+    group.Run([&unregisteredWorkerTasks]()
+    {
+      // Tasks run inline in a non-worker thread legitimately use stream 0
+      // (the global generator); tasks on a worker must not.
+      if (ThreadPool::InWorker() && math::RandStreamId() == 0)
+        ++unregisteredWorkerTasks;
+      (void) math::RandInt(100);
+    });
+  }
+  group.Wait();
+
+  REQUIRE(unregisteredWorkerTasks.load() == 0);
+}
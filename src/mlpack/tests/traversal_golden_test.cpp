@@ -0,0 +1,194 @@
+/**
+ * @file tests/traversal_golden_test.cpp
+ *
+ * Golden-statistics regression harness for tree traversals.  Wall-clock
+ * benchmarks hide algorithmic regressions behind machine noise; the traversal
+ * counters of the rule classes do not.  These tests run the canonical
+ * traversals on fixed-seed clustered datasets and fail when the base-case or
+ * prune counts regress past recorded ceilings.
+ *
+ * The ceilings are expressed as fractions of the brute-force pair count
+ * rather than as absolute counts: exact counts shift with the random stream
+ * and with tree-building details, but the regressions this harness exists to
+ * catch -- a broken bound making a traversal degenerate towards brute force
+ * -- change the fractions by an order of magnitude.  Each ceiling is several
+ * times the fraction observed when it was recorded, so a failure here means a
+ * real pruning regression, not noise.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/kde/kde.hpp>
+#include <mlpack/methods/emst/dtb.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::neighbor;
+using namespace mlpack::metric;
+using namespace mlpack::tree;
+using namespace mlpack::kde;
+using namespace mlpack::kernel;
+using namespace mlpack::emst;
+
+/**
+ * Build a deterministic clustered dataset: points drawn tightly around
+ * well-separated cluster centers, so that every pruning-based traversal has
+ * ample structure to exploit.
+ */
+arma::mat GoldenClusteredDataset(const size_t dims,
+                                 const size_t points,
+                                 const size_t seed)
+{
+  math::RandomSeed(seed);
+
+  const size_t clusters = 5;
+  arma::mat centers(dims, clusters, arma::fill::randu);
+  centers *= 10.0;
+
+  arma::mat dataset(dims, points);
+  for (size_t i = 0; i < points; ++i)
+    dataset.col(i) = centers.col(i % clusters) +
+        0.1 * arma::randn<arma::vec>(dims);
+
+  return dataset;
+}
+
+/**
+ * Golden statistics for the dual-tree KNN traversal on a kd-tree.
+ */
+TEST_CASE("KNNDualTreeGoldenStatistics", "[TraversalGoldenTest]")
+{
+  const arma::mat dataset = GoldenClusteredDataset(3, 1200, 42);
+  const arma::mat querySet = GoldenClusteredDataset(3, 300, 43);
+  const size_t k = 5;
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  std::vector<size_t> oldFromNewRefs, oldFromNewQueries;
+  TreeType referenceTree(dataset, oldFromNewRefs);
+  TreeType queryTree(querySet, oldFromNewQueries);
+
+  EuclideanDistance metric;
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType,
+      TraversalStatistics> RuleType;
+  RuleType rules(referenceTree.Dataset(), queryTree.Dataset(), k, metric,
+      0.0, false);
+
+  TreeType::DualTreeTraverser<RuleType> traverser(rules);
+  traverser.Traverse(queryTree, referenceTree);
+
+  const TraversalStatistics& stats = rules.TraversalStats();
+  const size_t bruteForcePairs = dataset.n_cols * querySet.n_cols;
+
+  // Golden ceiling: recorded runs evaluate a few percent of the pairs; a
+  // quarter of them means the bounds have regressed.
+  REQUIRE(stats.NumBaseCases() <= bruteForcePairs / 4);
+
+  // Pruning must be doing real work, and the results must be populated.
+  REQUIRE(stats.NumScorePrunes() + stats.NumRescorePrunes() >= 10);
+  REQUIRE(stats.NumBoundTightenings() >= k * querySet.n_cols);
+}
+
+/**
+ * Golden statistics for the single-tree KNN traversal on a kd-tree.
+ */
+TEST_CASE("KNNSingleTreeGoldenStatistics", "[TraversalGoldenTest]")
+{
+  const arma::mat dataset = GoldenClusteredDataset(3, 1200, 42);
+  const arma::mat querySet = GoldenClusteredDataset(3, 300, 43);
+  const size_t k = 5;
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  std::vector<size_t> oldFromNewRefs;
+  TreeType referenceTree(dataset, oldFromNewRefs);
+
+  EuclideanDistance metric;
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType,
+      TraversalStatistics> RuleType;
+  RuleType rules(referenceTree.Dataset(), querySet, k, metric, 0.0, false);
+
+  TreeType::SingleTreeTraverser<RuleType> traverser(rules);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    traverser.Traverse(i, referenceTree);
+
+  const TraversalStatistics& stats = rules.TraversalStats();
+  const size_t bruteForcePairs = dataset.n_cols * querySet.n_cols;
+
+  // Golden ceiling: the single-tree traversal prunes a little less than the
+  // dual-tree one, but must still stay well under brute force.
+  REQUIRE(stats.NumBaseCases() <= (3 * bruteForcePairs) / 10);
+
+  REQUIRE(stats.NumScorePrunes() + stats.NumRescorePrunes() >= 10);
+  REQUIRE(stats.NumBoundTightenings() >= k * querySet.n_cols);
+}
+
+/**
+ * Golden statistics for the dual-tree KDE traversal.
+ */
+TEST_CASE("KDEDualTreeGoldenStatistics", "[TraversalGoldenTest]")
+{
+  const arma::mat dataset = GoldenClusteredDataset(2, 800, 44);
+  const arma::mat querySet = GoldenClusteredDataset(2, 200, 45);
+
+  typedef KDTree<EuclideanDistance, KDEStat, arma::mat> TreeType;
+
+  std::vector<size_t> oldFromNewRefs, oldFromNewQueries;
+  TreeType referenceTree(dataset, oldFromNewRefs);
+  TreeType queryTree(querySet, oldFromNewQueries);
+
+  EuclideanDistance metric;
+  GaussianKernel kernel(0.5);
+  arma::vec estimations(querySet.n_cols, arma::fill::zeros);
+
+  typedef KDERules<EuclideanDistance, GaussianKernel, TreeType,
+      TraversalStatistics> RuleType;
+  RuleType rules(referenceTree.Dataset(), queryTree.Dataset(), estimations,
+      0.05, 0.0, 0.95, 100, 3.0, 0.4, metric, kernel, false, false);
+
+  TreeType::DualTreeTraverser<RuleType> traverser(rules);
+  traverser.Traverse(queryTree, referenceTree);
+
+  const TraversalStatistics& stats = rules.TraversalStats();
+  const size_t bruteForcePairs = dataset.n_cols * querySet.n_cols;
+
+  // Golden ceiling: with 5% relative error on well-separated clusters, whole
+  // node combinations are approximated without descending to base cases;
+  // reaching half the pairs means the error bounds have regressed.
+  REQUIRE(stats.NumBaseCases() <= bruteForcePairs / 2);
+
+  REQUIRE(stats.NumScorePrunes() + stats.NumRescorePrunes() >= 10);
+
+  // The traversal must have produced usable (nonzero) density estimates.
+  REQUIRE(arma::all(estimations > 0.0));
+}
+
+/**
+ * Golden statistics for the dual-tree Boruvka (EMST) computation.
+ */
+TEST_CASE("DTBGoldenStatistics", "[TraversalGoldenTest]")
+{
+  arma::mat dataset = GoldenClusteredDataset(3, 1000, 46);
+  const size_t points = dataset.n_cols;
+
+  DualTreeBoruvka<> dtb(dataset);
+  arma::mat results;
+  dtb.ComputeMST(results);
+
+  // The computation runs O(log n) Boruvka rounds; a brute-force round alone
+  // costs points^2 base cases.  Recorded runs stay far below one brute-force
+  // round in total, so reaching it means the bounds have regressed.
+  REQUIRE(dtb.BaseCases() <= points * points);
+  REQUIRE(dtb.Scores() > 0);
+
+  // A complete spanning tree must have been emitted.
+  REQUIRE(results.n_cols == points - 1);
+}
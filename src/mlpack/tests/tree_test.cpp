@@ -15,6 +15,8 @@
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/core/tree/parallel_dual_tree_traverser.hpp>
+#include <mlpack/core/tree/composite_rules.hpp>
 
 #include <queue>
 #include <stack>
@@ -214,6 +216,44 @@ TEST_CASE("HRectBoundMinDistancePoint", "[TreeTest]")
   REQUIRE(b.MinDistance(point) == Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Ensure that the batched bound-to-point minimum distance computation gives
+ * the same results as the scalar version, for metrics with and without the
+ * root taken.
+ */
+TEST_CASE("HRectBoundMinDistancesBatch", "[TreeTest]")
+{
+  arma::mat points(8, 200, arma::fill::randu);
+  points = 6.0 * points - 3.0;
+
+  HRectBound<EuclideanDistance> b(8);
+  HRectBound<LMetric<2, false>> bSquared(8);
+  HRectBound<ManhattanDistance> bManhattan(8);
+  for (size_t d = 0; d < 8; ++d)
+  {
+    const Range r(-1.0 + 0.1 * d, 1.0 + 0.2 * d);
+    b[d] = r;
+    bSquared[d] = r;
+    bManhattan[d] = r;
+  }
+
+  arma::vec distances, distancesSquared, distancesManhattan;
+  b.MinDistances(points, distances);
+  bSquared.MinDistances(points, distancesSquared);
+  bManhattan.MinDistances(points, distancesManhattan);
+
+  REQUIRE(distances.n_elem == points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(distances[i] ==
+        Approx(b.MinDistance(points.col(i))).margin(1e-10));
+    REQUIRE(distancesSquared[i] ==
+        Approx(bSquared.MinDistance(points.col(i))).margin(1e-10));
+    REQUIRE(distancesManhattan[i] ==
+        Approx(bManhattan.MinDistance(points.col(i))).margin(1e-10));
+  }
+}
+
 /**
  * Ensure that we calculate the correct minimum distance between a bound and
  * another bound.
@@ -2287,3 +2327,595 @@ TEST_CASE("CoverTreeDescendantTest", "[TreeTest]")
   // using the recursive function above.
   CheckDescendants(&tree);
 }
+
+/**
+ * Test that a frozen FlatTree gives exactly the brute-force k-nearest
+ * neighbors (in the tree's reordered point indices).
+ */
+TEST_CASE("FlatTreeKNNTest", "[TreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+  arma::mat querySet = arma::randu<arma::mat>(5, 40);
+
+  // Build a kd-tree (the dataset is copied and reordered inside).
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(dataset);
+  FlatTree<KDTree<EuclideanDistance, EmptyStatistic, arma::mat>> frozen(tree);
+
+  const size_t k = 4;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  frozen.Search(querySet, k, neighbors, distances);
+
+  // Compare against brute force over the reordered dataset.
+  const arma::mat& reordered = tree.Dataset();
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::vec dists(reordered.n_cols);
+    for (size_t i = 0; i < reordered.n_cols; ++i)
+      dists[i] = metric::EuclideanDistance::Evaluate(querySet.col(q),
+          reordered.col(i));
+
+    arma::uvec order = arma::sort_index(dists);
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, q) == Approx(dists[order[j]]).epsilon(1e-7));
+      REQUIRE(neighbors(j, q) == order[j]);
+    }
+  }
+}
+
+/**
+ * A minimal dual-tree rule set for testing traversers: counts, for every
+ * query point, the number of reference points within a fixed radius.
+ */
+template<typename TreeType>
+class RangeCountRules
+{
+ public:
+  RangeCountRules(const arma::mat& querySet,
+                  const arma::mat& referenceSet,
+                  const double radius) :
+      querySet(querySet),
+      referenceSet(referenceSet),
+      radius(radius),
+      counts(querySet.n_cols, 0)
+  { }
+
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex)
+  {
+    const double distance = metric::EuclideanDistance::Evaluate(
+        querySet.col(queryIndex), referenceSet.col(referenceIndex));
+    if (distance <= radius)
+      ++counts[queryIndex];
+    return distance;
+  }
+
+  double Score(const size_t queryIndex, TreeType& referenceNode)
+  {
+    const double minDistance =
+        referenceNode.MinDistance(querySet.col(queryIndex));
+    return (minDistance > radius) ? DBL_MAX : minDistance;
+  }
+
+  double Score(TreeType& queryNode, TreeType& referenceNode)
+  {
+    const double minDistance = queryNode.MinDistance(referenceNode);
+    return (minDistance > radius) ? DBL_MAX : minDistance;
+  }
+
+  double Rescore(const size_t /* queryIndex */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const { return oldScore; }
+
+  double Rescore(TreeType& /* queryNode */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const { return oldScore; }
+
+  typedef TraversalInfo<TreeType> TraversalInfoType;
+
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! The per-query counts of in-range reference points.
+  const std::vector<size_t>& Counts() const { return counts; }
+
+ private:
+  const arma::mat& querySet;
+  const arma::mat& referenceSet;
+  const double radius;
+  std::vector<size_t> counts;
+  TraversalInfoType traversalInfo;
+};
+
+/**
+ * Test that the parallel dual-tree traversal engine visits every (query,
+ * reference) pair exactly once: the per-rule range counts, summed over all
+ * rule instances, must match brute force.
+ */
+TEST_CASE("ParallelDualTreeTraverserTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat referenceSet = arma::randu<arma::mat>(4, 500);
+  arma::mat querySet = arma::randu<arma::mat>(4, 350);
+  const double radius = 0.4;
+
+  TreeType referenceTree(referenceSet);
+  TreeType queryTree(querySet);
+
+  // One rule instance per potential worker; each is built over the full
+  // (reordered) query set, and each query point ends up counted in exactly
+  // one instance.
+  std::vector<RangeCountRules<TreeType>> rules(4,
+      RangeCountRules<TreeType>(queryTree.Dataset(), referenceTree.Dataset(),
+          radius));
+
+  ParallelDualTreeTraverser<TreeType, RangeCountRules<TreeType>>
+      traverser(rules);
+  traverser.Traverse(queryTree, referenceTree);
+
+  // The query subtree assignments must partition the query points.
+  size_t assignedPoints = 0;
+  for (const std::pair<TreeType*, size_t>& a : traverser.QueryAssignments())
+    assignedPoints += a.first->NumDescendants();
+  REQUIRE(assignedPoints == querySet.n_cols);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    size_t bruteCount = 0;
+    for (size_t r = 0; r < referenceSet.n_cols; ++r)
+    {
+      if (metric::EuclideanDistance::Evaluate(queryTree.Dataset().col(q),
+          referenceTree.Dataset().col(r)) <= radius)
+        ++bruteCount;
+    }
+
+    size_t treeCount = 0;
+    for (size_t t = 0; t < rules.size(); ++t)
+      treeCount += rules[t].Counts()[q];
+
+    REQUIRE(treeCount == bruteCount);
+  }
+}
+
+/**
+ * Test that a FlatTree built with the tree's oldFromNew mapping emits
+ * original dataset indices directly, with no unmapping pass.
+ */
+TEST_CASE("FlatTreeUnmappedKNNTest", "[TreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(6, 400);
+  arma::mat querySet = arma::randu<arma::mat>(6, 50);
+
+  std::vector<size_t> oldFromNew;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(dataset,
+      oldFromNew);
+  FlatTree<KDTree<EuclideanDistance, EmptyStatistic, arma::mat>>
+      frozen(tree, oldFromNew);
+
+  const size_t k = 5;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  frozen.Search(querySet, k, neighbors, distances);
+
+  // Compare against brute force over the original (unordered) dataset; the
+  // emitted indices must already be original indices.
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::vec dists(dataset.n_cols);
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      dists[i] = metric::EuclideanDistance::Evaluate(querySet.col(q),
+          dataset.col(i));
+
+    arma::uvec order = arma::sort_index(dists);
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, q) == Approx(dists[order[j]]).epsilon(1e-7));
+      REQUIRE(neighbors(j, q) == order[j]);
+    }
+  }
+}
+
+/**
+ * A dual-tree rule set that counts in-range reference points exactly, but
+ * folds inclusion prunes into its result: when a reference node lies entirely
+ * inside the radius, its descendant count is added and the node is pruned.
+ * This mimics rules (like KDE) whose prunes carry a contribution, so it
+ * detects any adapter that keeps dispatching base cases to a rule after it
+ * has pruned.
+ */
+template<typename TreeType>
+class InclusionCountRules
+{
+ public:
+  InclusionCountRules(const arma::mat& querySet,
+                      const arma::mat& referenceSet,
+                      const double radius) :
+      querySet(querySet),
+      referenceSet(referenceSet),
+      radius(radius),
+      counts(querySet.n_cols, 0)
+  { }
+
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex)
+  {
+    const double distance = metric::EuclideanDistance::Evaluate(
+        querySet.col(queryIndex), referenceSet.col(referenceIndex));
+    if (distance <= radius)
+      ++counts[queryIndex];
+    return distance;
+  }
+
+  double Score(const size_t queryIndex, TreeType& referenceNode)
+  {
+    const math::Range distances =
+        referenceNode.RangeDistance(querySet.col(queryIndex));
+
+    if (distances.Lo() > radius)
+      return DBL_MAX; // Exclusion prune: nothing in range.
+
+    if (distances.Hi() <= radius)
+    {
+      // Inclusion prune: every descendant is in range.
+      counts[queryIndex] += referenceNode.NumDescendants();
+      return DBL_MAX;
+    }
+
+    return distances.Lo();
+  }
+
+  double Score(TreeType& queryNode, TreeType& referenceNode)
+  {
+    const math::Range distances = queryNode.RangeDistance(referenceNode);
+
+    if (distances.Lo() > radius)
+      return DBL_MAX; // Exclusion prune: nothing in range.
+
+    if (distances.Hi() <= radius)
+    {
+      // Inclusion prune: every reference descendant is in range of every
+      // query descendant.
+      for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+        counts[queryNode.Descendant(i)] += referenceNode.NumDescendants();
+      return DBL_MAX;
+    }
+
+    return distances.Lo();
+  }
+
+  double Rescore(const size_t /* queryIndex */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const { return oldScore; }
+
+  double Rescore(TreeType& /* queryNode */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const { return oldScore; }
+
+  typedef TraversalInfo<TreeType> TraversalInfoType;
+
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! The per-query counts of in-range reference points.
+  const std::vector<size_t>& Counts() const { return counts; }
+
+ private:
+  const arma::mat& querySet;
+  const arma::mat& referenceSet;
+  const double radius;
+  std::vector<size_t> counts;
+  TraversalInfoType traversalInfo;
+};
+
+/**
+ * Test the composite rule adapter: two range-count rule sets with different
+ * radii, one of which folds contributions into its prunes, fused into a
+ * single dual-tree traversal.  Both must produce exactly the brute-force
+ * counts; the inclusion-prune rule in particular verifies that a rule stops
+ * receiving base cases below a combination it pruned.
+ */
+TEST_CASE("CompositeRulesFusedTraversalTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat referenceSet = arma::randu<arma::mat>(4, 400);
+  arma::mat querySet = arma::randu<arma::mat>(4, 250);
+  const double radiusA = 0.3;
+  const double radiusB = 0.45;
+
+  TreeType referenceTree(referenceSet);
+  TreeType queryTree(querySet);
+
+  RangeCountRules<TreeType> rulesA(queryTree.Dataset(),
+      referenceTree.Dataset(), radiusA);
+  InclusionCountRules<TreeType> rulesB(queryTree.Dataset(),
+      referenceTree.Dataset(), radiusB);
+
+  typedef CompositeRules<RangeCountRules<TreeType>,
+      InclusionCountRules<TreeType>> CompositeType;
+  CompositeType composite(rulesA, rulesB);
+
+  TreeType::DualTreeTraverser<CompositeType> traverser(composite);
+  traverser.Traverse(queryTree, referenceTree);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    size_t bruteCountA = 0, bruteCountB = 0;
+    for (size_t r = 0; r < referenceSet.n_cols; ++r)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          queryTree.Dataset().col(q), referenceTree.Dataset().col(r));
+      if (distance <= radiusA)
+        ++bruteCountA;
+      if (distance <= radiusB)
+        ++bruteCountB;
+    }
+
+    REQUIRE(rulesA.Counts()[q] == bruteCountA);
+    REQUIRE(rulesB.Counts()[q] == bruteCountB);
+  }
+}
+
+/**
+ * Test the three-way split partition on duplicate-heavy data.  Many points
+ * share the exact split value, so the on-plane run must be distributed
+ * between the children rather than piled onto one side; the oldFromNew
+ * mapping must remain a permutation that matches the rearranged dataset,
+ * and tree-based search must agree exactly with brute force.
+ */
+TEST_CASE("ThreeWaySplitDuplicateHeavyTest", "[TreeTest]")
+{
+  math::RandomSeed(std::time(NULL));
+
+  // Build a dataset in which half of the values in every dimension are drawn
+  // from a small set of repeated levels, so split planes frequently pass
+  // through long runs of identical coordinates.
+  arma::mat dataset(5, 600);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      if ((i + d) % 2 == 0)
+        dataset(d, i) = (double) (i % 4); // Repeated levels: 0, 1, 2, 3.
+      else
+        dataset(d, i) = 4.0 * math::Random();
+    }
+  }
+
+  const arma::mat original = dataset;
+
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> KDTreeType;
+  typedef MeanSplitKDTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      MeanTreeType;
+
+  // Check the mapping for both split policies.
+  {
+    arma::mat kdData = original;
+    std::vector<size_t> oldFromNew;
+    KDTreeType tree(kdData, oldFromNew);
+
+    REQUIRE(oldFromNew.size() == original.n_cols);
+    std::vector<bool> seen(original.n_cols, false);
+    for (size_t i = 0; i < oldFromNew.size(); ++i)
+    {
+      REQUIRE(oldFromNew[i] < original.n_cols);
+      REQUIRE(seen[oldFromNew[i]] == false);
+      seen[oldFromNew[i]] = true;
+
+      // The rearranged column must be the original column it maps to.
+      for (size_t d = 0; d < original.n_rows; ++d)
+        REQUIRE(tree.Dataset()(d, i) == original(d, oldFromNew[i]));
+    }
+  }
+
+  {
+    arma::mat meanData = original;
+    std::vector<size_t> oldFromNew;
+    MeanTreeType tree(meanData, oldFromNew);
+
+    REQUIRE(oldFromNew.size() == original.n_cols);
+    std::vector<bool> seen(original.n_cols, false);
+    for (size_t i = 0; i < oldFromNew.size(); ++i)
+    {
+      REQUIRE(oldFromNew[i] < original.n_cols);
+      REQUIRE(seen[oldFromNew[i]] == false);
+      seen[oldFromNew[i]] = true;
+
+      for (size_t d = 0; d < original.n_rows; ++d)
+        REQUIRE(tree.Dataset()(d, i) == original(d, oldFromNew[i]));
+    }
+  }
+
+  // Tree-based search on the duplicate-heavy data must agree with brute
+  // force.
+  arma::mat searchData = original;
+  std::vector<size_t> oldFromNew;
+  KDTreeType tree(searchData, oldFromNew);
+  FlatTree<KDTreeType> frozen(tree, oldFromNew);
+
+  arma::mat querySet = arma::randu<arma::mat>(5, 60) * 4.0;
+
+  const size_t k = 5;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  frozen.Search(querySet, k, neighbors, distances);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::vec dists(original.n_cols);
+    for (size_t i = 0; i < original.n_cols; ++i)
+      dists[i] = metric::EuclideanDistance::Evaluate(querySet.col(q),
+          original.col(i));
+
+    arma::uvec order = arma::sort_index(dists);
+    for (size_t j = 0; j < k; ++j)
+      REQUIRE(distances(j, q) == Approx(dists[order[j]]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that the compact bound conservatively encloses the exact bound: it
+ * must contain every point it was grown with, and its minimum (maximum)
+ * distances must never exceed (fall below) those of an HRectBound grown with
+ * the same points, while staying within the narrow rounding slack.
+ */
+TEST_CASE("CompactHRectBoundConservativeTest", "[TreeTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(8, 300) * 10.0 - 5.0;
+
+  HRectBound<EuclideanDistance> exactBound(data.n_rows);
+  CompactHRectBound<EuclideanDistance> compactBound(data.n_rows);
+  exactBound |= data;
+  compactBound |= data;
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(compactBound.Contains(data.col(i)));
+
+  // The compact ranges enclose the exact ones, with only rounding slack.
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    REQUIRE(compactBound[d].Lo() <= exactBound[d].Lo());
+    REQUIRE(compactBound[d].Hi() >= exactBound[d].Hi());
+    REQUIRE(compactBound[d].Lo() ==
+        Approx(exactBound[d].Lo()).epsilon(1e-5));
+    REQUIRE(compactBound[d].Hi() ==
+        Approx(exactBound[d].Hi()).epsilon(1e-5));
+  }
+
+  // Point-to-bound distances: the compact minimum is a valid lower bound and
+  // the compact maximum a valid upper bound.
+  arma::mat queries = arma::randu<arma::mat>(8, 100) * 20.0 - 10.0;
+  for (size_t q = 0; q < queries.n_cols; ++q)
+  {
+    const double exactMin = exactBound.MinDistance(queries.col(q));
+    const double exactMax = exactBound.MaxDistance(queries.col(q));
+    const double compactMin = compactBound.MinDistance(queries.col(q));
+    const double compactMax = compactBound.MaxDistance(queries.col(q));
+
+    REQUIRE(compactMin <= exactMin + 1e-12);
+    REQUIRE(compactMax >= exactMax - 1e-12);
+    REQUIRE(compactMin == Approx(exactMin).epsilon(1e-4).margin(1e-4));
+    REQUIRE(compactMax == Approx(exactMax).epsilon(1e-4).margin(1e-4));
+
+    const math::Range r = compactBound.RangeDistance(queries.col(q));
+    REQUIRE(r.Lo() == Approx(compactMin).epsilon(1e-10));
+    REQUIRE(r.Hi() == Approx(compactMax).epsilon(1e-10));
+  }
+
+  // Bound-to-bound distances behave the same way.
+  arma::mat otherData = arma::randu<arma::mat>(8, 200) * 10.0 + 4.0;
+  HRectBound<EuclideanDistance> exactOther(otherData.n_rows);
+  CompactHRectBound<EuclideanDistance> compactOther(otherData.n_rows);
+  exactOther |= otherData;
+  compactOther |= otherData;
+
+  REQUIRE(compactBound.MinDistance(compactOther) <=
+      exactBound.MinDistance(exactOther) + 1e-12);
+  REQUIRE(compactBound.MaxDistance(compactOther) >=
+      exactBound.MaxDistance(exactOther) - 1e-12);
+
+  // Merging bounds must also be conservative.
+  CompactHRectBound<EuclideanDistance> merged(compactBound);
+  merged |= compactOther;
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(merged.Contains(data.col(i)));
+  for (size_t i = 0; i < otherData.n_cols; ++i)
+    REQUIRE(merged.Contains(otherData.col(i)));
+}
+
+/**
+ * Test that a kd-tree built with compact bounds returns exact neighbors: the
+ * narrowed bounds may only weaken pruning, never cause a false prune.
+ */
+TEST_CASE("CompactKDTreeSearchTest", "[TreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(6, 500);
+  arma::mat querySet = arma::randu<arma::mat>(6, 60);
+
+  typedef CompactKDTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+
+  std::vector<size_t> oldFromNew;
+  arma::mat treeData = dataset;
+  TreeType tree(treeData, oldFromNew);
+  FlatTree<TreeType> frozen(tree, oldFromNew);
+
+  const size_t k = 5;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  frozen.Search(querySet, k, neighbors, distances);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::vec dists(dataset.n_cols);
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      dists[i] = metric::EuclideanDistance::Evaluate(querySet.col(q),
+          dataset.col(i));
+
+    arma::uvec order = arma::sort_index(dists);
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, q) == Approx(dists[order[j]]).epsilon(1e-7));
+      REQUIRE(neighbors(j, q) == order[j]);
+    }
+  }
+}
+
+/**
+ * A kd-tree written with SaveFlat() and read back with LoadFlat() must be
+ * structurally identical to the original and answer queries the same way.
+ */
+TEST_CASE("BinarySpaceTreeFlatSerializationTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(8, 500, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew);
+
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  tree.SaveFlat(stream);
+
+  TreeType* loaded = TreeType::LoadFlat(stream);
+  REQUIRE(loaded != NULL);
+
+  // Compare the two trees node by node.
+  std::stack<std::pair<const TreeType*, const TreeType*>> nodes;
+  nodes.push(std::make_pair(&tree, (const TreeType*) loaded));
+  while (!nodes.empty())
+  {
+    const TreeType* a = nodes.top().first;
+    const TreeType* b = nodes.top().second;
+    nodes.pop();
+
+    REQUIRE(a->Begin() == b->Begin());
+    REQUIRE(a->Count() == b->Count());
+    REQUIRE(a->ParentDistance() ==
+        Approx(b->ParentDistance()).margin(1e-15));
+    REQUIRE(a->FurthestDescendantDistance() ==
+        Approx(b->FurthestDescendantDistance()).margin(1e-15));
+    REQUIRE(a->Bound().Dim() == b->Bound().Dim());
+    for (size_t d = 0; d < a->Bound().Dim(); ++d)
+    {
+      REQUIRE(a->Bound()[d].Lo() == Approx(b->Bound()[d].Lo()).margin(1e-15));
+      REQUIRE(a->Bound()[d].Hi() == Approx(b->Bound()[d].Hi()).margin(1e-15));
+    }
+
+    REQUIRE((a->Left() == NULL) == (b->Left() == NULL));
+    REQUIRE((a->Right() == NULL) == (b->Right() == NULL));
+    if (a->Left() != NULL)
+      nodes.push(std::make_pair(a->Left(), b->Left()));
+    if (a->Right() != NULL)
+      nodes.push(std::make_pair(a->Right(), b->Right()));
+  }
+
+  // The loaded tree owns a copy of the (rearranged) dataset.
+  CheckMatrices(tree.Dataset(), loaded->Dataset());
+
+  delete loaded;
+
+  // A stream that does not hold a flat tree must be rejected.
+  std::stringstream garbage(std::ios::in | std::ios::out | std::ios::binary);
+  garbage << "this is not a flat tree";
+  REQUIRE_THROWS_AS(TreeType::LoadFlat(garbage), std::runtime_error);
+}
@@ -47,3 +47,55 @@ TEST_CASE("TestUnion", "[UnionFindTest]")
   REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
   REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
+
+/**
+ * Run a random sequence of Union() and Find() calls against a trivial
+ * reference implementation (a flat label array relabeled on every union), to
+ * check the packed parent/rank layout and the path-splitting Find().
+ */
+TEST_CASE("TestRandomSequenceAgainstReference", "[UnionFindTest]")
+{
+  static const size_t testSize = 500;
+  UnionFind testUnionFind(testSize);
+  arma::Col<size_t> labels(testSize);
+  for (size_t i = 0; i < testSize; ++i)
+    labels[i] = i;
+
+  for (size_t step = 0; step < 2000; ++step)
+  {
+    const size_t x = math::RandInt(testSize);
+    const size_t y = math::RandInt(testSize);
+
+    testUnionFind.Union(x, y);
+    const size_t oldLabel = labels[y];
+    for (size_t i = 0; i < testSize; ++i)
+      if (labels[i] == oldLabel)
+        labels[i] = labels[x];
+
+    // Spot-check a few pairs.
+    for (size_t check = 0; check < 5; ++check)
+    {
+      const size_t a = math::RandInt(testSize);
+      const size_t b = math::RandInt(testSize);
+      REQUIRE((testUnionFind.Find(a) == testUnionFind.Find(b)) ==
+          (labels[a] == labels[b]));
+    }
+  }
+}
+
+/**
+ * A long chain of unions must not build a long path: after the chain, every
+ * Find() must agree, including when queried from the deep end first.
+ */
+TEST_CASE("TestChainedUnions", "[UnionFindTest]")
+{
+  static const size_t testSize = 1000;
+  UnionFind testUnionFind(testSize);
+
+  for (size_t i = 1; i < testSize; ++i)
+    testUnionFind.Union(i - 1, i);
+
+  const size_t root = testUnionFind.Find(testSize - 1);
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(testUnionFind.Find(i) == root);
+}
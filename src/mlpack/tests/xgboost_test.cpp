@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/xgboost/loss_functions/sse_loss.hpp>
+#include <mlpack/methods/xgboost/xgboost.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
@@ -64,3 +65,131 @@ TEST_CASE("SSEGainTest", "[XGBTest]")
   SSELoss Loss;
   REQUIRE(Loss.Evaluate<false>(input, weights) == gain);
 }
+
+/**
+ * Test that XGBoost can learn a simple separable two-class problem.
+ */
+TEST_CASE("XGBoostSimpleClassificationTest", "[XGBTest]")
+{
+  // Two well-separated classes in five dimensions.
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+    dataset.col(i) += 2.0;
+  labels.subvec(0, 499).fill(0);
+  labels.subvec(500, 999).fill(1);
+
+  XGBoost xgb(dataset, labels, 2, 20 /* iterations */);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  xgb.Classify(dataset, predictions, probabilities);
+
+  REQUIRE(predictions.n_elem == dataset.n_cols);
+  REQUIRE(probabilities.n_rows == 2);
+  REQUIRE(probabilities.n_cols == dataset.n_cols);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (predictions[i] == labels[i])
+      ++correct;
+
+    // The class probabilities of each point must sum to one.
+    REQUIRE(arma::accu(probabilities.col(i)) == Approx(1.0).epsilon(1e-7));
+  }
+
+  // The classes are fully separable.
+  REQUIRE(correct > 950);
+
+  // The single-point overload must agree with the batch overload.
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(xgb.Classify(dataset.col(i)) == predictions[i]);
+}
+
+/**
+ * Test that XGBoost works on a multiclass problem with column subsampling and
+ * that more boosting iterations do not hurt training accuracy.
+ */
+TEST_CASE("XGBoostMulticlassTest", "[XGBTest]")
+{
+  arma::mat dataset(4, 900, arma::fill::randu);
+  arma::Row<size_t> labels(900);
+  for (size_t i = 0; i < 900; ++i)
+  {
+    labels[i] = i / 300;
+    dataset(1, i) += 2.0 * (i / 300);
+  }
+
+  XGBoost xgb;
+  const double loss = xgb.Train(dataset, labels, 3, 25, 0.2, 4, 5, 0.0, 1.0,
+      0.0, 0.75 /* featureFraction */);
+
+  // The training loss should be small for separable data.
+  REQUIRE(loss < 0.5);
+  REQUIRE(xgb.NumTrees() == 25 * 3);
+
+  arma::Row<size_t> predictions;
+  xgb.Classify(dataset, predictions);
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  REQUIRE(correct > 850);
+}
+
+/**
+ * Test that an untrained XGBoost model refuses to classify.
+ */
+TEST_CASE("XGBoostEmptyClassifyTest", "[XGBTest]")
+{
+  XGBoost xgb; // No training.
+
+  arma::mat points(10, 100, arma::fill::randu);
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  size_t prediction;
+  arma::vec pointProbabilities;
+
+  REQUIRE_THROWS_AS(xgb.Classify(points, predictions), std::invalid_argument);
+  REQUIRE_THROWS_AS(xgb.Classify(points.col(0)), std::invalid_argument);
+  REQUIRE_THROWS_AS(xgb.Classify(points, predictions, probabilities),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(xgb.Classify(points.col(0), prediction,
+      pointProbabilities), std::invalid_argument);
+}
+
+/**
+ * Test that an XGBoost model gives the same predictions after serialization.
+ */
+TEST_CASE("XGBoostSerializationTest", "[XGBTest]")
+{
+  arma::mat dataset(5, 500, arma::fill::randu);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 250; i < 500; ++i)
+    dataset.col(i) += 1.5;
+  labels.subvec(0, 249).fill(0);
+  labels.subvec(250, 499).fill(1);
+
+  XGBoost xgb(dataset, labels, 2, 10);
+
+  arma::Row<size_t> beforePredictions;
+  arma::mat beforeProbabilities;
+  xgb.Classify(dataset, beforePredictions, beforeProbabilities);
+
+  XGBoost xmlXgb, jsonXgb, binaryXgb;
+  SerializeObjectAll(xgb, xmlXgb, jsonXgb, binaryXgb);
+
+  arma::Row<size_t> xmlPredictions, jsonPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, jsonProbabilities, binaryProbabilities;
+
+  xmlXgb.Classify(dataset, xmlPredictions, xmlProbabilities);
+  jsonXgb.Classify(dataset, jsonPredictions, jsonProbabilities);
+  binaryXgb.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(beforePredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+  CheckMatrices(beforeProbabilities, xmlProbabilities, jsonProbabilities,
+      binaryProbabilities);
+}